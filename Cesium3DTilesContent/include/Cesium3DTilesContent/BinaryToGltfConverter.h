@@ -19,9 +19,6 @@ public:
       const AssetFetcher& assetFetcher);
 
 private:
-  static GltfConverterResult convertImmediate(
-      const gsl::span<const std::byte>& gltfBinary,
-      const CesiumGltfReader::GltfReaderOptions& options);
   static CesiumGltfReader::GltfReader _gltfReader;
 };
 } // namespace Cesium3DTilesContent
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Library.h"
+
+#include <Cesium3DTilesContent/GltfConverterResult.h>
+#include <Cesium3DTilesContent/GltfConverters.h>
+#include <CesiumAsync/Future.h>
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfReader/GltfReader.h>
+#include <CesiumGltfWriter/GltfWriter.h>
+
+#include <gsl/span>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesContent {
+/**
+ * @brief A cache of the models converted from tile content, stored in a
+ * database, so that content that was already converted doesn't need to be
+ * decoded again when it is loaded again, even by another run of the
+ * application.
+ *
+ * Caching the responses, for example with a
+ * {@link CesiumAsync::CachingAssetAccessor}, saves requesting content again,
+ * but each time that it is loaded it is still gunzipped, its Draco and
+ * meshopt data decoded, its images decoded or transcoded, and its b3dm, i3dm
+ * or pnts upgraded to glTF. This cache stores the result of all of that,
+ * with its buffers and the pixels of its images, so that it can be read back
+ * with almost no work.
+ *
+ * The models are keyed by a hash of the content and by the options it is
+ * converted with, see {@link computeKey}, so a model that changes on the
+ * server is not stale and caches with different options don't get in the way
+ * of each other. The key doesn't cover the files that the content refers to,
+ * such as the external glTF of an i3dm. The entries are stored in an
+ * {@link CesiumAsync::ICacheDatabase}, which may be the one that the
+ * responses are cached in, and are pruned with it.
+ *
+ * All methods are thread-safe, as long as the database is.
+ */
+class CESIUM3DTILESCONTENT_API DecodedModelCache {
+public:
+  /**
+   * @brief Creates a cache that stores the models in the given database.
+   *
+   * @param pDatabase The database to store the models in.
+   * @param maximumAge How long each model is kept after it is stored. The
+   * database removes the models that are older when it is pruned.
+   */
+  DecodedModelCache(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase,
+      std::chrono::seconds maximumAge = std::chrono::hours(24 * 30));
+
+  /**
+   * @brief Converts tile content to a model with the given converter, unless
+   * the {@link AssetFetcher::pDecodedModelCache} already has the model
+   * converted from the same content with the same options.
+   *
+   * A model that is converted without errors is stored in the cache. If the
+   * asset fetcher has no cache, this just calls the converter.
+   *
+   * @param converter The converter for the content.
+   * @param content The content.
+   * @param options The options to read glTF with.
+   * @param assetFetcher The asset fetcher to pass to the converter.
+   * @return A future that resolves to the converted or cached model.
+   */
+  static CesiumAsync::Future<GltfConverterResult> convert(
+      GltfConverters::ConverterFunction converter,
+      const gsl::span<const std::byte>& content,
+      const CesiumGltfReader::GltfReaderOptions& options,
+      const AssetFetcher& assetFetcher);
+
+  /**
+   * @brief Computes the key of the model converted from the given content.
+   *
+   * The key combines the size and a hash of the content with the options that
+   * change how it is converted: the KTX2 transcode targets, the maximum
+   * texture size, whether texture transforms are applied, whether batch
+   * tables are converted, whether point clouds are kept quantized, and the
+   * tile transform that i3dm content with east-north-up rotations depends on.
+   *
+   * @param content The content.
+   * @param options The options to read glTF with.
+   * @param assetFetcher The asset fetcher that the content is converted with.
+   * @return The key.
+   */
+  static std::string computeKey(
+      const gsl::span<const std::byte>& content,
+      const CesiumGltfReader::GltfReaderOptions& options,
+      const AssetFetcher& assetFetcher);
+
+  /**
+   * @brief Finds the model stored with the given key.
+   *
+   * @param key The key, see {@link computeKey}.
+   * @return The model, or std::nullopt if there is none or it can't be read.
+   */
+  std::optional<CesiumGltf::Model> find(const std::string& key) const;
+
+  /**
+   * @brief Stores a model with the given key.
+   *
+   * @param key The key, see {@link computeKey}.
+   * @param model The model.
+   * @return Whether the model was stored.
+   */
+  bool store(const std::string& key, const CesiumGltf::Model& model) const;
+
+  /**
+   * @brief Writes a model, including the data of its buffers and the pixels
+   * of its images, in the binary format that the cache stores.
+   *
+   * The format starts with a header, followed by the glTF JSON, then the data
+   * of each buffer and then the properties and pixels of each image. Each
+   * part begins at a multiple of 8 bytes, so that the buffers and pixels can
+   * be used where they are once the format is in memory.
+   *
+   * @param model The model.
+   * @return The bytes, or an empty vector if the model can't be written.
+   */
+  std::vector<std::byte> write(const CesiumGltf::Model& model) const;
+
+  /**
+   * @brief Reads a model written by {@link write}.
+   *
+   * @param data The bytes.
+   * @return The model, or std::nullopt if the bytes aren't a valid model.
+   */
+  std::optional<CesiumGltf::Model>
+  read(const gsl::span<const std::byte>& data) const;
+
+private:
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pDatabase;
+  std::chrono::seconds _maximumAge;
+  CesiumGltfReader::GltfReader _reader;
+  CesiumGltfWriter::GltfWriter _writer;
+};
+} // namespace Cesium3DTilesContent
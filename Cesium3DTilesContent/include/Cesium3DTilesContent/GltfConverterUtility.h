@@ -5,6 +5,7 @@
 #include <CesiumAsync/IAssetRequest.h>
 #include <CesiumGltf/AccessorView.h>
 #include <CesiumGltf/PropertyTransformations.h>
+#include <CesiumUtility/Allocator.h>
 #include <CesiumUtility/ErrorList.h>
 
 #include <glm/fwd.hpp>
@@ -77,8 +78,10 @@ parseArrayValueDVec3(const rapidjson::Value& arrayValue);
 std::optional<glm::dvec3>
 parseArrayValueDVec3(const rapidjson::Document& document, const char* name);
 
-int32_t
-createBufferInGltf(CesiumGltf::Model& gltf, std::vector<std::byte> buffer = {});
+int32_t createBufferInGltf(
+    CesiumGltf::Model& gltf,
+    CesiumUtility::ByteVector buffer = CesiumUtility::ByteVector(
+        CesiumUtility::AllocationCategory::GltfBuffer));
 
 int32_t createBufferViewInGltf(
     CesiumGltf::Model& gltf,
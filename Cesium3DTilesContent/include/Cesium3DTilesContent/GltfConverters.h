@@ -3,18 +3,22 @@
 #include "Library.h"
 
 #include <Cesium3DTilesContent/GltfConverterResult.h>
+#include <Cesium3DTilesContent/GltfModelCache.h>
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumGltfReader/GltfReader.h>
 
 #include <gsl/span>
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 
 namespace Cesium3DTilesContent {
 
+class DecodedModelCache;
+
 struct AssetFetcherResult {
   std::vector<std::byte> bytes;
   CesiumUtility::ErrorList errorList;
@@ -45,6 +49,42 @@ struct CESIUM3DTILESCONTENT_API AssetFetcher {
   const std::string baseUrl;
   glm::dmat4 tileTransform; // For ENU transforms in i3dm
   const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders;
+
+  /**
+   * @brief Whether to convert the batch tables of b3dm and pnts content to
+   * `EXT_structural_metadata`. If false, batch tables are skipped without
+   * being parsed.
+   */
+  bool convertBatchTables = true;
+
+  /**
+   * @brief Whether to keep the `POSITION_QUANTIZED` and `NORMAL_OCT16P`
+   * attributes of pnts content encoded, instead of decoding them to floats.
+   *
+   * Quantized positions are stored as unsigned shorts, as allowed by the
+   * `KHR_mesh_quantization` extension, and the node that holds the point cloud
+   * has the transform that dequantizes them. Oct-encoded normals are stored as
+   * two normalized unsigned bytes per point in the `_OCT_ENCODED_NORMAL`
+   * attribute instead of `NORMAL`, which the renderer must decode like
+   * {@link CesiumUtility::AttributeCompression::octDecode} does, after mapping
+   * the components from `[0, 1]` to `[-1, 1]`.
+   *
+   * Positions and normals decoded from Draco are always floats.
+   */
+  bool keepPointCloudsQuantized = false;
+
+  /**
+   * @brief The cache of the models instanced by i3dm content, if any. See
+   * {@link GltfModelCache}.
+   */
+  std::shared_ptr<GltfModelCache> pGltfModelCache;
+
+  /**
+   * @brief The cache of the models converted from tile content, if any. The
+   * converters don't use it themselves, see
+   * {@link DecodedModelCache::convert}.
+   */
+  std::shared_ptr<DecodedModelCache> pDecodedModelCache;
 };
 
 /**
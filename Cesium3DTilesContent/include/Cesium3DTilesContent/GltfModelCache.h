@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Library.h"
+
+#include <CesiumGltf/Model.h>
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Cesium3DTilesContent {
+/**
+ * @brief A cache of the glTF models instanced by i3dm content, keyed by the
+ * content of their glTF or glb files.
+ *
+ * Instanced 3D Model tiles often instance the same model, such as a tree or a
+ * lamp post, either by embedding the same glb or by referring to the same
+ * URL. With a cache in {@link AssetFetcher::pGltfModelCache}, each distinct
+ * model is only parsed and decoded once, and the other tiles copy it.
+ *
+ * The models are identified by their whole content rather than by their URL,
+ * so identical embedded models are shared too, and a model that changes on the
+ * server is not stale. A cache must only be used with one set of
+ * {@link CesiumGltfReader::GltfReaderOptions}, because the cached models are
+ * the result of reading them with those options.
+ *
+ * All methods are thread-safe.
+ */
+class CESIUM3DTILESCONTENT_API GltfModelCache {
+public:
+  /**
+   * @brief Creates an empty cache.
+   *
+   * @param maximumModels The number of models to keep. When a model is added
+   * to a full cache, the least recently used one is removed.
+   */
+  explicit GltfModelCache(size_t maximumModels = 64);
+
+  /**
+   * @brief Finds the model read from the given content.
+   *
+   * @param content The content of the glTF or glb file.
+   * @return The model, or nullptr if it isn't in the cache.
+   */
+  std::shared_ptr<const CesiumGltf::Model>
+  find(const gsl::span<const std::byte>& content);
+
+  /**
+   * @brief Adds the model read from the given content. If the cache already
+   * has a model for this content, it is kept.
+   *
+   * @param content The content of the glTF or glb file.
+   * @param pModel The model.
+   */
+  void add(
+      std::vector<std::byte>&& content,
+      const std::shared_ptr<const CesiumGltf::Model>& pModel);
+
+  /**
+   * @brief Gets the number of models in the cache.
+   */
+  size_t size() const;
+
+private:
+  struct Entry {
+    std::vector<std::byte> content;
+    std::shared_ptr<const CesiumGltf::Model> pModel;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  EntryList::iterator findEntry(const gsl::span<const std::byte>& content);
+
+  size_t _maximumModels;
+  mutable std::mutex _mutex;
+  // The most recently used entries come first.
+  EntryList _entries;
+  std::unordered_multimap<size_t, EntryList::iterator> _entriesByHash;
+};
+} // namespace Cesium3DTilesContent
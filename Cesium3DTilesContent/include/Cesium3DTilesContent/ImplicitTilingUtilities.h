@@ -20,6 +20,11 @@ namespace Cesium3DTiles {
 struct BoundingVolume;
 }
 
+namespace CesiumUtility {
+class BaseUri;
+class UriTemplate;
+} // namespace CesiumUtility
+
 namespace Cesium3DTilesContent {
 
 /**
@@ -149,6 +154,44 @@ public:
       const std::string& urlTemplate,
       const CesiumGeometry::OctreeTileID& octreeID);
 
+  /**
+   * @brief Resolves a templatized implicit tiling URL with a quadtree tile ID,
+   * from a base URL and a template that were parsed in advance.
+   *
+   * This gives the same URL as the overload that takes strings, but it can be
+   * much faster when resolving the URLs of many tiles.
+   *
+   * @param baseUrl The base URL that is used to resolve the urlTemplate if it
+   * is a relative path.
+   * @param urlTemplate The templatized URL.
+   * @param quadtreeID The quadtree ID to use in resolving the parameters in the
+   * URL template.
+   * @return The resolved URL.
+   */
+  static std::string resolveUrl(
+      const CesiumUtility::BaseUri& baseUrl,
+      const CesiumUtility::UriTemplate& urlTemplate,
+      const CesiumGeometry::QuadtreeTileID& quadtreeID);
+
+  /**
+   * @brief Resolves a templatized implicit tiling URL with an octree tile ID,
+   * from a base URL and a template that were parsed in advance.
+   *
+   * This gives the same URL as the overload that takes strings, but it can be
+   * much faster when resolving the URLs of many tiles.
+   *
+   * @param baseUrl The base URL that is used to resolve the urlTemplate if it
+   * is a relative path.
+   * @param urlTemplate The templatized URL.
+   * @param octreeID The octree ID to use in resolving the parameters in the
+   * URL template.
+   * @return The resolved URL.
+   */
+  static std::string resolveUrl(
+      const CesiumUtility::BaseUri& baseUrl,
+      const CesiumUtility::UriTemplate& urlTemplate,
+      const CesiumGeometry::OctreeTileID& octreeID);
+
   /**
    * @brief Computes the denominator for a given implicit tile level.
    *
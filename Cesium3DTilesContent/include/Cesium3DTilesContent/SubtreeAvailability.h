@@ -82,6 +82,9 @@ public:
    * @param subtreeUrl The URL from which to retrieve the subtree file.
    * @param requestHeaders HTTP headers to include in the request for the
    * subtree file.
+   * @param loadMetadataBuffers Whether to load the external buffers that no
+   * availability refers to. See
+   * {@link Cesium3DTilesReader::SubtreeFileReader::getLoadMetadataBuffers}.
    * @return A future that resolves to a `SubtreeAvailability` instance for the
    * subtree file, or std::nullopt if something goes wrong.
    */
@@ -92,7 +95,8 @@ public:
       const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::string& subtreeUrl,
-      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders);
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+      bool loadMetadataBuffers = true);
 
   /**
    * @brief An AvailibilityView that indicates that either all tiles are
@@ -353,6 +357,54 @@ public:
    */
   bool isSubtreeAvailable(uint64_t relativeSubtreeMortonId) const noexcept;
 
+  /**
+   * @brief Determines which children of a given tile in the subtree are
+   * available.
+   *
+   * The children of a tile are adjacent in the availability bitstream, so this
+   * reads all of them at once rather than computing the Morton index of each
+   * child and reading its bit separately.
+   *
+   * @param relativeTileLevel The level of the parent tile, relative to the root
+   * of the subtree.
+   * @param relativeTileMortonId The Morton ID of the parent tile. See
+   * {@link ImplicitTilingUtilities::computeRelativeMortonIndex}.
+   * @return A mask in which bit `i` is set if the child with the Morton ID
+   * `relativeTileMortonId * childCount + i` is available, where `childCount`
+   * is 4 for a quadtree and 8 for an octree.
+   */
+  uint8_t getAvailableChildTiles(
+      uint32_t relativeTileLevel,
+      uint64_t relativeTileMortonId) const noexcept;
+
+  /**
+   * @brief Determines which children of a given tile in the subtree have
+   * available content.
+   *
+   * @param relativeTileLevel The level of the parent tile, relative to the root
+   * of the subtree.
+   * @param relativeTileMortonId The Morton ID of the parent tile. See
+   * {@link ImplicitTilingUtilities::computeRelativeMortonIndex}.
+   * @param contentId The ID of the content to query.
+   * @return A mask of the children, as in {@link getAvailableChildTiles}.
+   */
+  uint8_t getAvailableChildContents(
+      uint32_t relativeTileLevel,
+      uint64_t relativeTileMortonId,
+      uint64_t contentId) const noexcept;
+
+  /**
+   * @brief Determines which children of a given tile on the last level of the
+   * subtree are the roots of available child subtrees.
+   *
+   * @param relativeTileMortonId The Morton ID of the parent tile, which must be
+   * on the last level of this subtree. See
+   * {@link ImplicitTilingUtilities::computeRelativeMortonIndex}.
+   * @return A mask of the children, as in {@link getAvailableChildTiles}.
+   */
+  uint8_t
+  getAvailableChildSubtrees(uint64_t relativeTileMortonId) const noexcept;
+
   /**
    * @brief Sets the availability state of the child quadtree rooted at the
    * given tile.
@@ -402,6 +454,18 @@ public:
       uint64_t relativeSubtreeMortonId,
       bool isAvailable) noexcept;
 
+  /**
+   * @brief Reduces the memory used by this instance to what it needs to query
+   * and modify availability.
+   *
+   * Bitstreams whose bits are all the same are replaced by a constant, and the
+   * others are copied into a single buffer, once for each buffer view even if
+   * several availabilities refer to it. Everything else in the subtree, such as
+   * its metadata, is discarded, so the subtree returned by {@link getSubtree}
+   * afterward only has the availability.
+   */
+  void compact() noexcept;
+
   /**
    * @brief Gets the subtree that this instance queries and modifies.
    */
@@ -420,6 +484,15 @@ private:
       AvailabilityView& availabilityView,
       bool isAvailable) noexcept;
 
+  uint8_t getAvailableChildren(
+      uint32_t relativeChildLevel,
+      uint64_t relativeTileMortonId,
+      const AvailabilityView& availabilityView) const noexcept;
+
+  void convertConstantAvailabilityToBitstream(
+      uint64_t numberOfTiles,
+      AvailabilityView& availabilityView) noexcept;
+
   bool isAvailableUsingBufferView(
       uint64_t numOfTilesFromRootToParentLevel,
       uint64_t relativeTileMortonId,
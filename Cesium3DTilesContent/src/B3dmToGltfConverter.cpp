@@ -179,6 +179,7 @@ void convertB3dmMetadataToGltfStructuralMetadata(
     const gsl::span<const std::byte>& b3dmBinary,
     const B3dmHeader& header,
     uint32_t headerLength,
+    bool convertBatchTable,
     GltfConverterResult& result) {
   if (result.model && header.featureTableJsonByteLength > 0) {
     CesiumGltf::Model& gltf = result.model.value();
@@ -194,7 +195,7 @@ void convertB3dmMetadataToGltfStructuralMetadata(
     const int64_t batchTableLength =
         header.batchTableBinaryByteLength + header.batchTableJsonByteLength;
 
-    if (batchTableLength > 0) {
+    if (batchTableLength > 0 && convertBatchTable) {
       const gsl::span<const std::byte> batchTableJsonData = b3dmBinary.subspan(
           static_cast<size_t>(batchTableStart),
           header.batchTableJsonByteLength);
@@ -247,16 +248,20 @@ CesiumAsync::Future<GltfConverterResult> B3dmToGltfConverter::convert(
              headerLength,
              options,
              assetFetcher)
-      .thenImmediately(
-          [b3dmBinary, header, headerLength](GltfConverterResult&& glbResult) {
-            if (!glbResult.errors) {
-              convertB3dmMetadataToGltfStructuralMetadata(
-                  b3dmBinary,
-                  header,
-                  headerLength,
-                  glbResult);
-            }
-            return std::move(glbResult);
-          });
+      .thenImmediately([b3dmBinary,
+                        header,
+                        headerLength,
+                        convertBatchTable = assetFetcher.convertBatchTables](
+                           GltfConverterResult&& glbResult) {
+        if (!glbResult.errors) {
+          convertB3dmMetadataToGltfStructuralMetadata(
+              b3dmBinary,
+              header,
+              headerLength,
+              convertBatchTable,
+              glbResult);
+        }
+        return std::move(glbResult);
+      });
 }
 } // namespace Cesium3DTilesContent
@@ -15,8 +15,10 @@
 
 #include <limits>
 #include <map>
+#include <string_view>
 #include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 using namespace CesiumGltf;
 using namespace Cesium3DTilesContent::CesiumImpl;
@@ -386,31 +388,51 @@ public:
    * This is helpful for when a property contains a sentinel value as non-null
    * data; the sentinel value can then be removed from consideration.
    */
-  void removeSentinelValues(CesiumUtility::JsonValue value) noexcept {
-    if (value.isNumber()) {
-      // Don't try to use string as sentinels for numbers.
-      _canUseNullStringSentinel = false;
+  void removeSentinelValues(int64_t value) noexcept {
+    // Don't try to use string as sentinels for numbers.
+    _canUseNullStringSentinel = false;
 
-      if (value.isInt64()) {
-        auto intValue = value.getInt64();
-        _canUseZeroSentinel &= (intValue != 0);
-        _canUseNegativeOneSentinel &= (intValue != -1);
-      } else if (value.isUint64()) {
-        _canUseZeroSentinel &= (value.getUint64() != 0);
-        // Since the value is truly a uint64, -1 cannot be used.
-        _canUseNegativeOneSentinel = false;
-      }
-    } else if (value.isString()) {
-      // Don't try to use numbers as sentinels for strings.
-      _canUseZeroSentinel = false;
-      _canUseNegativeOneSentinel = false;
-
-      auto stringValue = value.getString();
-      if (stringValue == "null") {
-        _canUseNullStringSentinel = false;
-      }
+    _canUseZeroSentinel &= (value != 0);
+    _canUseNegativeOneSentinel &= (value != -1);
+  }
+
+  /**
+   * Removes any sentinel values that are incompatible with a uint64 value, or
+   * that equal it.
+   */
+  void removeSentinelValues(uint64_t value) noexcept {
+    // Don't try to use string as sentinels for numbers.
+    _canUseNullStringSentinel = false;
+
+    _canUseZeroSentinel &= (value != 0);
+    // Since the value is truly a uint64, -1 cannot be used.
+    _canUseNegativeOneSentinel = false;
+  }
+
+  /**
+   * Removes any sentinel values that are incompatible with a string value, or
+   * that equal it.
+   */
+  void removeSentinelValues(const std::string_view& value) noexcept {
+    // Don't try to use numbers as sentinels for strings.
+    _canUseZeroSentinel = false;
+    _canUseNegativeOneSentinel = false;
+
+    if (value == "null") {
+      _canUseNullStringSentinel = false;
     }
   }
+
+  /**
+   * Whether no further values can change the type of the property or its
+   * sentinel value. This is the case once the property is known to be a
+   * string property that cannot use the "null" sentinel, so the remaining
+   * values don't need to be examined.
+   */
+  bool isSettled() const noexcept {
+    return std::holds_alternative<MaskedType>(_type) && isIncompatible() &&
+           !_canUseNullStringSentinel;
+  }
 };
 
 struct BinaryProperty {
@@ -495,18 +517,13 @@ bool isInRangeForUnsignedInteger(uint64_t value) noexcept {
 }
 
 template <typename OffsetType>
-void copyStringBuffer(
-    const rapidjson::StringBuffer& rapidjsonStrBuffer,
-    const std::vector<uint64_t>& rapidjsonOffsets,
-    std::vector<std::byte>& buffer,
-    std::vector<std::byte>& offsetBuffer) {
-  buffer.resize(rapidjsonStrBuffer.GetLength());
-  std::memcpy(buffer.data(), rapidjsonStrBuffer.GetString(), buffer.size());
-
-  offsetBuffer.resize(sizeof(OffsetType) * rapidjsonOffsets.size());
+void copyStringOffsets(
+    const std::vector<uint64_t>& offsets,
+    ByteVector& offsetBuffer) {
+  offsetBuffer.resize(sizeof(OffsetType) * offsets.size());
   OffsetType* offset = reinterpret_cast<OffsetType*>(offsetBuffer.data());
-  for (size_t i = 0; i < rapidjsonOffsets.size(); ++i) {
-    offset[i] = static_cast<OffsetType>(rapidjsonOffsets[i]);
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    offset[i] = static_cast<OffsetType>(offsets[i]);
   }
 }
 
@@ -588,6 +605,10 @@ template <typename TValueGetter>
 CompatibleTypes findCompatibleTypes(const TValueGetter& propertyValue) {
   CompatibleTypes compatibleTypes;
   for (auto it = propertyValue.begin(); it != propertyValue.end(); ++it) {
+    if (compatibleTypes.isSettled()) {
+      break;
+    }
+
     if (it->IsBool()) {
       // Don't allow booleans to be converted to numeric 0 or 1.
       MaskedType booleanType(false);
@@ -646,7 +667,8 @@ CompatibleTypes findCompatibleTypes(const TValueGetter& propertyValue) {
     // If this is a string, check that the value does not equal one of the
     // possible sentinel values.
     if (it->IsString()) {
-      compatibleTypes.removeSentinelValues(it->GetString());
+      compatibleTypes.removeSentinelValues(
+          std::string_view(it->GetString(), it->GetStringLength()));
     }
   }
 
@@ -660,7 +682,7 @@ CompatibleTypes findCompatibleTypes(const TValueGetter& propertyValue) {
   return compatibleTypes;
 }
 
-int32_t addBufferToGltf(Model& gltf, std::vector<std::byte>&& buffer) {
+int32_t addBufferToGltf(Model& gltf, ByteVector&& buffer) {
   const size_t gltfBufferIndex = gltf.buffers.size();
   Buffer& gltfBuffer = gltf.buffers.emplace_back();
   gltfBuffer.byteLength = static_cast<int64_t>(buffer.size());
@@ -683,74 +705,63 @@ void updateExtensionWithJsonStringProperty(
     PropertyTableProperty& propertyTableProperty,
     const TValueGetter& propertyValue) {
 
+  // The strings are appended directly to the buffer of the property, and
+  // only values that aren't strings are serialized by rapidjson first.
+  ByteVector buffer(AllocationCategory::GltfBuffer);
   rapidjson::StringBuffer rapidjsonStrBuffer;
-  std::vector<uint64_t> rapidjsonOffsets;
-  rapidjsonOffsets.reserve(static_cast<size_t>(propertyTable.count + 1));
-  rapidjsonOffsets.emplace_back(0);
+  std::vector<uint64_t> offsets;
+  offsets.reserve(static_cast<size_t>(propertyTable.count + 1));
+  offsets.emplace_back(0);
 
   std::optional<std::string> noDataValue;
   if (classProperty.noData) {
     noDataValue = classProperty.noData->getString();
   }
 
+  auto appendBytes = [&buffer](const char* pData, size_t size) {
+    const std::byte* pBytes = reinterpret_cast<const std::byte*>(pData);
+    buffer.insert(buffer.end(), pBytes, pBytes + size);
+  };
+
   auto it = propertyValue.begin();
   for (int64_t i = 0; i < propertyTable.count; ++i) {
     if (it == propertyValue.end()) {
-      rapidjsonOffsets.emplace_back(rapidjsonStrBuffer.GetLength());
+      offsets.emplace_back(buffer.size());
       continue;
     }
     if (!it->IsString() || (it->IsNull() && !noDataValue)) {
       // Everything else that is not string will be serialized by json
+      rapidjsonStrBuffer.Clear();
       rapidjson::Writer<rapidjson::StringBuffer> writer(rapidjsonStrBuffer);
       it->Accept(writer);
+      appendBytes(rapidjsonStrBuffer.GetString(), rapidjsonStrBuffer.GetSize());
     } else {
       // Because serialized string json will add double quotations in the
       // buffer which is not needed by us, we will manually add the string to
       // the buffer
-      const auto& rapidjsonStr = it->IsNull() ? *noDataValue : it->GetString();
-      rapidjsonStrBuffer.Reserve(it->GetStringLength());
-      for (rapidjson::SizeType j = 0; j < it->GetStringLength(); ++j) {
-        rapidjsonStrBuffer.PutUnsafe(rapidjsonStr[j]);
-      }
+      appendBytes(it->GetString(), it->GetStringLength());
     }
 
-    rapidjsonOffsets.emplace_back(rapidjsonStrBuffer.GetLength());
+    offsets.emplace_back(buffer.size());
     ++it;
   }
 
-  const uint64_t totalSize = rapidjsonOffsets.back();
-  std::vector<std::byte> buffer;
-  std::vector<std::byte> offsetBuffer;
+  const uint64_t totalSize = offsets.back();
+  ByteVector offsetBuffer(AllocationCategory::GltfBuffer);
   if (isInRangeForUnsignedInteger<uint8_t>(totalSize)) {
-    copyStringBuffer<uint8_t>(
-        rapidjsonStrBuffer,
-        rapidjsonOffsets,
-        buffer,
-        offsetBuffer);
+    copyStringOffsets<uint8_t>(offsets, offsetBuffer);
     propertyTableProperty.stringOffsetType =
         PropertyTableProperty::StringOffsetType::UINT8;
   } else if (isInRangeForUnsignedInteger<uint16_t>(totalSize)) {
-    copyStringBuffer<uint16_t>(
-        rapidjsonStrBuffer,
-        rapidjsonOffsets,
-        buffer,
-        offsetBuffer);
+    copyStringOffsets<uint16_t>(offsets, offsetBuffer);
     propertyTableProperty.stringOffsetType =
         PropertyTableProperty::StringOffsetType::UINT16;
   } else if (isInRangeForUnsignedInteger<uint32_t>(totalSize)) {
-    copyStringBuffer<uint32_t>(
-        rapidjsonStrBuffer,
-        rapidjsonOffsets,
-        buffer,
-        offsetBuffer);
+    copyStringOffsets<uint32_t>(offsets, offsetBuffer);
     propertyTableProperty.stringOffsetType =
         PropertyTableProperty::StringOffsetType::UINT32;
   } else {
-    copyStringBuffer<uint64_t>(
-        rapidjsonStrBuffer,
-        rapidjsonOffsets,
-        buffer,
-        offsetBuffer);
+    copyStringOffsets<uint64_t>(offsets, offsetBuffer);
     propertyTableProperty.stringOffsetType =
         PropertyTableProperty::StringOffsetType::UINT64;
   }
@@ -778,7 +789,7 @@ void updateExtensionWithJsonScalarProperty(
   // Create a new buffer for this property.
   const size_t byteLength =
       sizeof(T) * static_cast<size_t>(propertyTable.count);
-  std::vector<std::byte> buffer(byteLength);
+  ByteVector buffer(byteLength, AllocationCategory::GltfBuffer);
 
   T* p = reinterpret_cast<T*>(buffer.data());
   auto it = propertyValue.begin();
@@ -808,8 +819,10 @@ void updateExtensionWithJsonBooleanProperty(
     const TValueGetter& propertyValue) {
   assert(propertyValue.size() >= propertyTable.count);
 
-  std::vector<std::byte> buffer(static_cast<size_t>(
-      glm::ceil(static_cast<double>(propertyTable.count) / 8.0)));
+  ByteVector buffer(
+      static_cast<size_t>(
+          glm::ceil(static_cast<double>(propertyTable.count) / 8.0)),
+      AllocationCategory::GltfBuffer);
   auto it = propertyValue.begin();
   for (rapidjson::SizeType i = 0;
        i < static_cast<rapidjson::SizeType>(propertyTable.count);
@@ -832,8 +845,8 @@ template <
     typename OffsetType,
     typename TValueGetter>
 void copyVariableLengthScalarArraysToBuffers(
-    std::vector<std::byte>& valueBuffer,
-    std::vector<std::byte>& offsetBuffer,
+    ByteVector& valueBuffer,
+    ByteVector& offsetBuffer,
     size_t numOfElements,
     const PropertyTable& propertyTable,
     const TValueGetter& propertyValue) {
@@ -882,7 +895,9 @@ void updateScalarArrayProperty(
     const size_t arrayCount = static_cast<size_t>(arrayType.minArrayCount);
     const size_t numOfValues =
         static_cast<size_t>(propertyTable.count) * arrayCount;
-    std::vector<std::byte> valueBuffer(sizeof(ValueType) * numOfValues);
+    ByteVector valueBuffer(
+        sizeof(ValueType) * numOfValues,
+        AllocationCategory::GltfBuffer);
     ValueType* value = reinterpret_cast<ValueType*>(valueBuffer.data());
     auto it = propertyValue.begin();
     for (int64_t i = 0; i < propertyTable.count; ++i) {
@@ -912,8 +927,8 @@ void updateScalarArrayProperty(
   }
 
   PropertyComponentType offsetType = PropertyComponentType::None;
-  std::vector<std::byte> valueBuffer;
-  std::vector<std::byte> offsetBuffer;
+  ByteVector valueBuffer(AllocationCategory::GltfBuffer);
+  ByteVector offsetBuffer(AllocationCategory::GltfBuffer);
   const uint64_t maxOffsetValue = totalNumElements * sizeof(ValueType);
   if (isInRangeForUnsignedInteger<uint8_t>(maxOffsetValue)) {
     copyVariableLengthScalarArraysToBuffers<TRapidjson, ValueType, uint8_t>(
@@ -958,8 +973,8 @@ void updateScalarArrayProperty(
 
 template <typename OffsetType, typename TValueGetter>
 void copyStringsToBuffers(
-    std::vector<std::byte>& valueBuffer,
-    std::vector<std::byte>& offsetBuffer,
+    ByteVector& valueBuffer,
+    ByteVector& offsetBuffer,
     size_t totalByteLength,
     size_t numOfString,
     const PropertyTable& propertyTable,
@@ -993,7 +1008,7 @@ void copyStringsToBuffers(
 
 template <typename OffsetType, typename TValueGetter>
 void copyArrayOffsetsForStringArraysToBuffer(
-    std::vector<std::byte>& offsetBuffer,
+    ByteVector& offsetBuffer,
     const PropertyTable& propertyTable,
     const TValueGetter& propertyValue) {
   OffsetType prevOffset = 0;
@@ -1037,8 +1052,8 @@ void updateStringArrayProperty(
 
   const uint64_t totalByteLength =
       totalCharCount * sizeof(rapidjson::Value::Ch);
-  std::vector<std::byte> valueBuffer;
-  std::vector<std::byte> stringOffsetBuffer;
+  ByteVector valueBuffer(AllocationCategory::GltfBuffer);
+  ByteVector stringOffsetBuffer(AllocationCategory::GltfBuffer);
   PropertyComponentType stringOffsetType = PropertyComponentType::None;
   if (isInRangeForUnsignedInteger<uint8_t>(totalByteLength)) {
     copyStringsToBuffers<uint8_t>(
@@ -1096,7 +1111,7 @@ void updateStringArrayProperty(
   // For string arrays, arrayOffsets indexes into the stringOffsets buffer,
   // the size of which is the number of stringElements + 1. This determines
   // the component type of the array offsets.
-  std::vector<std::byte> arrayOffsetBuffer;
+  ByteVector arrayOffsetBuffer(AllocationCategory::GltfBuffer);
   PropertyComponentType arrayOffsetType = PropertyComponentType::None;
   if (isInRangeForUnsignedInteger<uint8_t>(stringCount + 1)) {
     copyArrayOffsetsForStringArraysToBuffer<uint8_t>(
@@ -1132,8 +1147,8 @@ void updateStringArrayProperty(
 
 template <typename OffsetType, typename TValueGetter>
 void copyVariableLengthBooleanArraysToBuffers(
-    std::vector<std::byte>& valueBuffer,
-    std::vector<std::byte>& offsetBuffer,
+    ByteVector& valueBuffer,
+    ByteVector& offsetBuffer,
     size_t numOfElements,
     const PropertyTable& propertyTable,
     const TValueGetter& propertyValue) {
@@ -1187,7 +1202,7 @@ void updateBooleanArrayProperty(
         static_cast<size_t>(propertyTable.count) * arrayCount;
     const size_t totalByteLength = static_cast<size_t>(
         glm::ceil(static_cast<double>(numOfElements) / 8.0));
-    std::vector<std::byte> valueBuffer(totalByteLength);
+    ByteVector valueBuffer(totalByteLength, AllocationCategory::GltfBuffer);
     size_t currentIndex = 0;
     auto it = propertyValue.begin();
     for (int64_t i = 0; i < propertyTable.count; ++i) {
@@ -1219,8 +1234,8 @@ void updateBooleanArrayProperty(
     ++it;
   }
 
-  std::vector<std::byte> valueBuffer;
-  std::vector<std::byte> offsetBuffer;
+  ByteVector valueBuffer(AllocationCategory::GltfBuffer);
+  ByteVector offsetBuffer(AllocationCategory::GltfBuffer);
   PropertyComponentType offsetType = PropertyComponentType::None;
   if (isInRangeForUnsignedInteger<uint8_t>(numOfElements + 1)) {
     copyVariableLengthBooleanArraysToBuffers<uint8_t>(
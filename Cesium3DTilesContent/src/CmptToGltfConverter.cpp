@@ -3,6 +3,8 @@
 
 #include <spdlog/fmt/fmt.h>
 
+#include <vector>
+
 namespace Cesium3DTilesContent {
 namespace {
 struct CmptHeader {
@@ -20,6 +22,38 @@ struct InnerHeader {
 
 static_assert(sizeof(CmptHeader) == 16);
 static_assert(sizeof(InnerHeader) == 12);
+
+// Converts an inner tile in a worker thread, so that the inner tiles of a
+// composite are converted concurrently. The AssetFetcher refers to objects
+// that only live as long as the call to convert, so a copy of them is kept
+// with the task.
+CesiumAsync::Future<GltfConverterResult> convertInWorkerThread(
+    const gsl::span<const std::byte>& innerData,
+    const CesiumGltfReader::GltfReaderOptions& options,
+    const AssetFetcher& assetFetcher) {
+  return assetFetcher.asyncSystem.runInWorkerThread(
+      [innerData,
+       options,
+       asyncSystem = assetFetcher.asyncSystem,
+       pAssetAccessor = assetFetcher.pAssetAccessor,
+       baseUrl = assetFetcher.baseUrl,
+       tileTransform = assetFetcher.tileTransform,
+       requestHeaders = assetFetcher.requestHeaders,
+       convertBatchTables = assetFetcher.convertBatchTables,
+       keepPointCloudsQuantized = assetFetcher.keepPointCloudsQuantized,
+       pGltfModelCache = assetFetcher.pGltfModelCache]() {
+        AssetFetcher innerAssetFetcher{
+            asyncSystem,
+            pAssetAccessor,
+            baseUrl,
+            tileTransform,
+            requestHeaders};
+        innerAssetFetcher.convertBatchTables = convertBatchTables;
+        innerAssetFetcher.keepPointCloudsQuantized = keepPointCloudsQuantized;
+        innerAssetFetcher.pGltfModelCache = pGltfModelCache;
+        return GltfConverters::convert(innerData, options, innerAssetFetcher);
+      });
+}
 } // namespace
 
 CesiumAsync::Future<GltfConverterResult> CmptToGltfConverter::convert(
@@ -55,7 +89,7 @@ CesiumAsync::Future<GltfConverterResult> CmptToGltfConverter::convert(
     return assetFetcher.asyncSystem.createResolvedFuture(std::move(result));
   }
 
-  std::vector<CesiumAsync::Future<GltfConverterResult>> innerTiles;
+  std::vector<gsl::span<const std::byte>> innerTilesData;
   uint32_t pos = sizeof(CmptHeader);
 
   for (uint32_t i = 0; i < pHeader->tilesLength && pos < pHeader->byteLength;
@@ -79,12 +113,11 @@ CesiumAsync::Future<GltfConverterResult> CmptToGltfConverter::convert(
 
     pos += pInner->byteLength;
 
-    innerTiles.emplace_back(
-        GltfConverters::convert(innerData, options, assetFetcher));
+    innerTilesData.emplace_back(innerData);
   }
 
   uint32_t tilesLength = pHeader->tilesLength;
-  if (innerTiles.empty()) {
+  if (innerTilesData.empty()) {
     if (tilesLength > 0) {
       result.errors.emplaceWarning(
           "Composite tile does not contain any loadable inner "
@@ -93,22 +126,39 @@ CesiumAsync::Future<GltfConverterResult> CmptToGltfConverter::convert(
     return assetFetcher.asyncSystem.createResolvedFuture(std::move(result));
   }
 
+  // The other inner tiles are converted in worker threads while the first one
+  // is converted in this thread.
+  std::vector<CesiumAsync::Future<GltfConverterResult>> innerTiles;
+  innerTiles.reserve(innerTilesData.size());
+  for (size_t i = 1; i < innerTilesData.size(); ++i) {
+    innerTiles.emplace_back(
+        convertInWorkerThread(innerTilesData[i], options, assetFetcher));
+  }
+  innerTiles.insert(
+      innerTiles.begin(),
+      GltfConverters::convert(innerTilesData[0], options, assetFetcher));
+
   return assetFetcher.asyncSystem.all(std::move(innerTiles))
       .thenImmediately([](std::vector<GltfConverterResult>&& innerResults) {
         if (innerResults.size() == 1) {
-          return innerResults[0];
+          return std::move(innerResults[0]);
         }
         GltfConverterResult cmptResult;
+        std::vector<CesiumGltf::Model> innerModels;
+        innerModels.reserve(innerResults.size());
         for (auto& innerTile : innerResults) {
           if (innerTile.model) {
             if (cmptResult.model) {
-              cmptResult.model->merge(std::move(*innerTile.model));
+              innerModels.emplace_back(std::move(*innerTile.model));
             } else {
               cmptResult.model = std::move(innerTile.model);
             }
           }
           cmptResult.errors.merge(innerTile.errors);
         }
+        if (cmptResult.model) {
+          cmptResult.model->mergeAll(innerModels);
+        }
         return cmptResult;
       });
 }
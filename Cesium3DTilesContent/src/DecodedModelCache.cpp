@@ -0,0 +1,341 @@
+#include <Cesium3DTilesContent/DecodedModelCache.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/CacheItem.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <utility>
+
+using namespace CesiumGltf;
+
+namespace Cesium3DTilesContent {
+namespace {
+constexpr char MAGIC[4] = {'C', 'D', 'M', 'C'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t ALIGNMENT = 8;
+
+struct Header {
+  char magic[4];
+  uint32_t version;
+  uint64_t jsonByteLength;
+  uint32_t bufferCount;
+  uint32_t imageCount;
+};
+
+struct ImageHeader {
+  int32_t width;
+  int32_t height;
+  int32_t channels;
+  int32_t bytesPerChannel;
+  int32_t compressedPixelFormat;
+  uint32_t mipCount;
+  int64_t sizeBytes;
+  uint64_t pixelByteLength;
+};
+
+struct MipPosition {
+  uint64_t byteOffset;
+  uint64_t byteSize;
+};
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+
+uint64_t hashBytes(const std::byte* pData, size_t size, uint64_t hash) {
+  // 64-bit FNV-1a, which is the same on every platform, unlike std::hash.
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<uint64_t>(pData[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+template <typename T>
+void appendValue(std::vector<std::byte>& output, const T& value) {
+  const size_t offset = output.size();
+  output.resize(offset + sizeof(T));
+  std::memcpy(output.data() + offset, &value, sizeof(T));
+}
+
+void appendPadded(
+    std::vector<std::byte>& output,
+    const std::byte* pData,
+    size_t size) {
+  output.insert(output.end(), pData, pData + size);
+  output.resize((output.size() + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT);
+}
+
+class Cursor {
+public:
+  explicit Cursor(const gsl::span<const std::byte>& data) : _data(data) {}
+
+  template <typename T> bool readValue(T& value) {
+    if (this->_data.size() - this->_offset < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, this->_data.data() + this->_offset, sizeof(T));
+    this->_offset += sizeof(T);
+    return true;
+  }
+
+  std::optional<gsl::span<const std::byte>> readPadded(uint64_t size) {
+    const size_t remaining = this->_data.size() - this->_offset;
+    if (size > remaining) {
+      return std::nullopt;
+    }
+    gsl::span<const std::byte> result =
+        this->_data.subspan(this->_offset, static_cast<size_t>(size));
+    const size_t padded = static_cast<size_t>(
+        (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT);
+    this->_offset += std::min(padded, remaining);
+    return result;
+  }
+
+private:
+  gsl::span<const std::byte> _data;
+  size_t _offset = 0;
+};
+} // namespace
+
+DecodedModelCache::DecodedModelCache(
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase,
+    std::chrono::seconds maximumAge)
+    : _pDatabase(pDatabase), _maximumAge(maximumAge), _reader(), _writer() {}
+
+CesiumAsync::Future<GltfConverterResult> DecodedModelCache::convert(
+    GltfConverters::ConverterFunction converter,
+    const gsl::span<const std::byte>& content,
+    const CesiumGltfReader::GltfReaderOptions& options,
+    const AssetFetcher& assetFetcher) {
+  std::shared_ptr<DecodedModelCache> pCache = assetFetcher.pDecodedModelCache;
+  if (!pCache) {
+    return converter(content, options, assetFetcher);
+  }
+
+  std::string key = computeKey(content, options, assetFetcher);
+  std::optional<Model> maybeModel = pCache->find(key);
+  if (maybeModel) {
+    GltfConverterResult result;
+    result.model = std::move(maybeModel);
+    return assetFetcher.asyncSystem.createResolvedFuture(std::move(result));
+  }
+
+  return converter(content, options, assetFetcher)
+      .thenImmediately([pCache = std::move(pCache), key = std::move(key)](
+                           GltfConverterResult&& result) {
+        if (result.model && !result.errors) {
+          pCache->store(key, *result.model);
+        }
+        return std::move(result);
+      });
+}
+
+std::string DecodedModelCache::computeKey(
+    const gsl::span<const std::byte>& content,
+    const CesiumGltfReader::GltfReaderOptions& options,
+    const AssetFetcher& assetFetcher) {
+  const uint64_t contentHash =
+      hashBytes(content.data(), content.size(), FNV_OFFSET_BASIS);
+
+  const Ktx2TranscodeTargets& targets = options.ktx2TranscodeTargets;
+  const int32_t settings[] = {
+      static_cast<int32_t>(targets.ETC1S_R),
+      static_cast<int32_t>(targets.ETC1S_RG),
+      static_cast<int32_t>(targets.ETC1S_RGB),
+      static_cast<int32_t>(targets.ETC1S_RGBA),
+      static_cast<int32_t>(targets.UASTC_R),
+      static_cast<int32_t>(targets.UASTC_RG),
+      static_cast<int32_t>(targets.UASTC_RGB),
+      static_cast<int32_t>(targets.UASTC_RGBA),
+      options.maximumTextureSize,
+      options.applyTextureTransform ? 1 : 0,
+      assetFetcher.convertBatchTables ? 1 : 0,
+      assetFetcher.keepPointCloudsQuantized ? 1 : 0};
+  uint64_t optionsHash = hashBytes(
+      reinterpret_cast<const std::byte*>(settings),
+      sizeof(settings),
+      FNV_OFFSET_BASIS);
+  optionsHash = hashBytes(
+      reinterpret_cast<const std::byte*>(&assetFetcher.tileTransform),
+      sizeof(assetFetcher.tileTransform),
+      optionsHash);
+
+  return "cesium-decoded-model:" + std::to_string(VERSION) + ":" +
+         std::to_string(content.size()) + ":" + std::to_string(contentHash) +
+         ":" + std::to_string(optionsHash);
+}
+
+std::optional<Model> DecodedModelCache::find(const std::string& key) const {
+  std::shared_ptr<const CesiumAsync::CacheItem> pItem =
+      this->_pDatabase->getSharedEntry(key);
+  if (!pItem || pItem->expiryTime < std::time(nullptr)) {
+    return std::nullopt;
+  }
+
+  return this->read(pItem->cacheResponse.data);
+}
+
+bool DecodedModelCache::store(const std::string& key, const Model& model)
+    const {
+  const std::vector<std::byte> data = this->write(model);
+  if (data.empty()) {
+    return false;
+  }
+
+  const std::time_t expiryTime =
+      std::time(nullptr) + static_cast<std::time_t>(this->_maximumAge.count());
+  return this->_pDatabase->storeEntry(
+      key,
+      expiryTime,
+      key,
+      "GET",
+      CesiumAsync::HttpHeaders{},
+      200,
+      CesiumAsync::HttpHeaders{},
+      data);
+}
+
+std::vector<std::byte> DecodedModelCache::write(const Model& model) const {
+  const CesiumGltfWriter::GltfWriterResult json =
+      this->_writer.writeGltf(model);
+  if (!json.errors.empty() ||
+      model.buffers.size() > std::numeric_limits<uint32_t>::max() ||
+      model.images.size() > std::numeric_limits<uint32_t>::max()) {
+    return {};
+  }
+
+  size_t totalSize = sizeof(Header) + json.gltfBytes.size() + ALIGNMENT;
+  for (const Buffer& buffer : model.buffers) {
+    totalSize += sizeof(uint64_t) + buffer.cesium.data.size() + ALIGNMENT;
+  }
+  for (const Image& image : model.images) {
+    totalSize += sizeof(ImageHeader) +
+                 image.cesium.mipPositions.size() * sizeof(MipPosition) +
+                 image.cesium.pixelData.size() + ALIGNMENT;
+  }
+
+  std::vector<std::byte> output;
+  output.reserve(totalSize);
+
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.jsonByteLength = json.gltfBytes.size();
+  header.bufferCount = static_cast<uint32_t>(model.buffers.size());
+  header.imageCount = static_cast<uint32_t>(model.images.size());
+  appendValue(output, header);
+  appendPadded(output, json.gltfBytes.data(), json.gltfBytes.size());
+
+  for (const Buffer& buffer : model.buffers) {
+    appendValue(output, static_cast<uint64_t>(buffer.cesium.data.size()));
+    appendPadded(output, buffer.cesium.data.data(), buffer.cesium.data.size());
+  }
+
+  for (const Image& image : model.images) {
+    const ImageCesium& cesium = image.cesium;
+    ImageHeader imageHeader{};
+    imageHeader.width = cesium.width;
+    imageHeader.height = cesium.height;
+    imageHeader.channels = cesium.channels;
+    imageHeader.bytesPerChannel = cesium.bytesPerChannel;
+    imageHeader.compressedPixelFormat =
+        static_cast<int32_t>(cesium.compressedPixelFormat);
+    imageHeader.mipCount = static_cast<uint32_t>(cesium.mipPositions.size());
+    imageHeader.sizeBytes = cesium.sizeBytes;
+    imageHeader.pixelByteLength = cesium.pixelData.size();
+    appendValue(output, imageHeader);
+    for (const ImageCesiumMipPosition& mip : cesium.mipPositions) {
+      appendValue(output, MipPosition{mip.byteOffset, mip.byteSize});
+    }
+    appendPadded(output, cesium.pixelData.data(), cesium.pixelData.size());
+  }
+
+  return output;
+}
+
+std::optional<Model>
+DecodedModelCache::read(const gsl::span<const std::byte>& data) const {
+  Cursor cursor(data);
+  Header header;
+  if (!cursor.readValue(header) ||
+      std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != VERSION) {
+    return std::nullopt;
+  }
+
+  std::optional<gsl::span<const std::byte>> maybeJson =
+      cursor.readPadded(header.jsonByteLength);
+  if (!maybeJson) {
+    return std::nullopt;
+  }
+
+  // Everything was already decoded when the model was stored, so the JSON is
+  // read as it is.
+  CesiumGltfReader::GltfReaderOptions options;
+  options.decodeDataUrls = false;
+  options.decodeEmbeddedImages = false;
+  options.decodeDraco = false;
+  options.decodeMeshOptData = false;
+  options.dequantizeMeshData = false;
+  options.applyTextureTransform = false;
+  CesiumGltfReader::GltfReaderResult result =
+      this->_reader.readGltf(*maybeJson, options);
+  if (!result.model || !result.errors.empty() ||
+      result.model->buffers.size() != header.bufferCount ||
+      result.model->images.size() != header.imageCount) {
+    return std::nullopt;
+  }
+
+  Model& model = *result.model;
+  for (Buffer& buffer : model.buffers) {
+    uint64_t byteLength;
+    if (!cursor.readValue(byteLength)) {
+      return std::nullopt;
+    }
+    std::optional<gsl::span<const std::byte>> maybeData =
+        cursor.readPadded(byteLength);
+    if (!maybeData) {
+      return std::nullopt;
+    }
+    buffer.cesium.data.assign(maybeData->begin(), maybeData->end());
+  }
+
+  for (Image& image : model.images) {
+    ImageHeader imageHeader;
+    if (!cursor.readValue(imageHeader)) {
+      return std::nullopt;
+    }
+
+    ImageCesium& cesium = image.cesium;
+    cesium.width = imageHeader.width;
+    cesium.height = imageHeader.height;
+    cesium.channels = imageHeader.channels;
+    cesium.bytesPerChannel = imageHeader.bytesPerChannel;
+    cesium.compressedPixelFormat = static_cast<GpuCompressedPixelFormat>(
+        imageHeader.compressedPixelFormat);
+    cesium.sizeBytes = imageHeader.sizeBytes;
+
+    cesium.mipPositions.clear();
+    for (uint32_t i = 0; i < imageHeader.mipCount; ++i) {
+      MipPosition mip;
+      if (!cursor.readValue(mip)) {
+        return std::nullopt;
+      }
+      cesium.mipPositions.push_back(ImageCesiumMipPosition{
+          static_cast<size_t>(mip.byteOffset),
+          static_cast<size_t>(mip.byteSize)});
+    }
+
+    std::optional<gsl::span<const std::byte>> maybePixels =
+        cursor.readPadded(imageHeader.pixelByteLength);
+    if (!maybePixels) {
+      return std::nullopt;
+    }
+    cesium.pixelData.assign(maybePixels->begin(), maybePixels->end());
+  }
+
+  return std::move(model);
+}
+} // namespace Cesium3DTilesContent
@@ -77,7 +77,7 @@ parseArrayValueDVec3(const rapidjson::Document& document, const char* name) {
   return {};
 }
 
-int32_t createBufferInGltf(Model& gltf, std::vector<std::byte> buffer) {
+int32_t createBufferInGltf(Model& gltf, CesiumUtility::ByteVector buffer) {
   size_t bufferId = gltf.buffers.size();
   Buffer& gltfBuffer = gltf.buffers.emplace_back();
   gltfBuffer.byteLength = static_cast<int32_t>(buffer.size());
@@ -0,0 +1,76 @@
+#include <Cesium3DTilesContent/GltfModelCache.h>
+
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+namespace Cesium3DTilesContent {
+namespace {
+size_t hashContent(const gsl::span<const std::byte>& content) {
+  return std::hash<std::string_view>()(std::string_view(
+      reinterpret_cast<const char*>(content.data()),
+      content.size()));
+}
+} // namespace
+
+GltfModelCache::GltfModelCache(size_t maximumModels)
+    : _maximumModels(std::max(maximumModels, size_t(1))) {}
+
+std::shared_ptr<const CesiumGltf::Model>
+GltfModelCache::find(const gsl::span<const std::byte>& content) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  auto it = this->findEntry(content);
+  if (it == this->_entries.end()) {
+    return nullptr;
+  }
+
+  this->_entries.splice(this->_entries.begin(), this->_entries, it);
+  return it->pModel;
+}
+
+void GltfModelCache::add(
+    std::vector<std::byte>&& content,
+    const std::shared_ptr<const CesiumGltf::Model>& pModel) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (!pModel || this->findEntry(content) != this->_entries.end()) {
+    return;
+  }
+
+  const size_t hash = hashContent(content);
+  this->_entries.emplace_front(Entry{std::move(content), pModel});
+  this->_entriesByHash.emplace(hash, this->_entries.begin());
+
+  while (this->_entries.size() > this->_maximumModels) {
+    auto last = std::prev(this->_entries.end());
+    auto range = this->_entriesByHash.equal_range(hashContent(last->content));
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == last) {
+        this->_entriesByHash.erase(it);
+        break;
+      }
+    }
+    this->_entries.erase(last);
+  }
+}
+
+size_t GltfModelCache::size() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_entries.size();
+}
+
+GltfModelCache::EntryList::iterator
+GltfModelCache::findEntry(const gsl::span<const std::byte>& content) {
+  auto range = this->_entriesByHash.equal_range(hashContent(content));
+  for (auto it = range.first; it != range.second; ++it) {
+    const std::vector<std::byte>& entryContent = it->second->content;
+    if (std::equal(
+            entryContent.begin(),
+            entryContent.end(),
+            content.begin(),
+            content.end())) {
+      return it->second;
+    }
+  }
+  return this->_entries.end();
+}
+} // namespace Cesium3DTilesContent
@@ -2,6 +2,7 @@
 
 #include <Cesium3DTilesContent/BinaryToGltfConverter.h>
 #include <Cesium3DTilesContent/GltfConverterUtility.h>
+#include <Cesium3DTilesContent/GltfModelCache.h>
 #include <Cesium3DTilesContent/I3dmToGltfConverter.h>
 #include <CesiumGeospatial/LocalHorizontalCoordinateSystem.h>
 #include <CesiumGltf/AccessorUtility.h>
@@ -16,11 +17,14 @@
 #include <glm/gtx/matrix_decompose.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <numeric>
 #include <optional>
 #include <set>
+#include <vector>
 
 using namespace CesiumGltf;
 
@@ -164,6 +168,36 @@ glm::quat rotationFromUpRight(const glm::vec3& up, const glm::vec3& right) {
   return upRot * rightRot;
 }
 
+// Reads the instanced glTF, or copies it from the cache of the asset fetcher.
+CesiumAsync::Future<GltfConverterResult> convertInstancedGltf(
+    const gsl::span<const std::byte>& gltfBinary,
+    const CesiumGltfReader::GltfReaderOptions& options,
+    const AssetFetcher& assetFetcher) {
+  const std::shared_ptr<GltfModelCache>& pCache = assetFetcher.pGltfModelCache;
+  if (!pCache) {
+    return BinaryToGltfConverter::convert(gltfBinary, options, assetFetcher);
+  }
+
+  if (std::shared_ptr<const Model> pModel = pCache->find(gltfBinary)) {
+    GltfConverterResult result;
+    result.model = *pModel;
+    return assetFetcher.asyncSystem.createResolvedFuture(std::move(result));
+  }
+
+  std::vector<std::byte> content(gltfBinary.begin(), gltfBinary.end());
+  auto future = BinaryToGltfConverter::convert(content, options, assetFetcher);
+  return std::move(future).thenImmediately(
+      [pCache, content = std::move(content)](
+          GltfConverterResult&& result) mutable {
+        if (result.model && !result.errors.hasErrors()) {
+          pCache->add(
+              std::move(content),
+              std::make_shared<const Model>(*result.model));
+        }
+        return std::move(result);
+      });
+}
+
 struct ConvertedI3dm {
   GltfConverterResult gltfResult;
   DecodedInstances decodedInstances;
@@ -470,7 +504,7 @@ CesiumAsync::Future<ConvertedI3dm> convertI3dmContent(
                 return assetFetcher.asyncSystem.createResolvedFuture(
                     std::move(errorResult));
               }
-              return BinaryToGltfConverter::convert(
+              return convertInstancedGltf(
                   assetFetcherResult.bytes,
                   options,
                   assetFetcher);
@@ -483,7 +517,7 @@ CesiumAsync::Future<ConvertedI3dm> convertI3dmContent(
           return convertedI3dm;
         });
   } else {
-    return BinaryToGltfConverter::convert(gltfData, options, assetFetcher)
+    return convertInstancedGltf(gltfData, options, assetFetcher)
         .thenImmediately([convertedI3dm = std::move(convertedI3dm)](
                              GltfConverterResult&& converterResult) mutable {
           if (converterResult.model)
@@ -622,14 +656,14 @@ void copyInstanceToBuffer(
     const glm::dvec3& position,
     const glm::dquat& rotation,
     const glm::dvec3& scale,
-    std::vector<std::byte>& bufferData,
+    CesiumUtility::ByteVector& bufferData,
     size_t i) {
   copyInstanceToBuffer(position, rotation, scale, &bufferData[i * totalStride]);
 }
 
 void copyInstanceToBuffer(
     const glm::dmat4& instanceTransform,
-    std::vector<std::byte>& bufferData,
+    CesiumUtility::ByteVector& bufferData,
     size_t i) {
   glm::dvec3 position, scale, skew;
   glm::dquat rotation;
@@ -638,6 +672,72 @@ void copyInstanceToBuffer(
   copyInstanceToBuffer(position, rotation, scale, bufferData, i);
 }
 
+// Gets the linear part of a transform if it only permutes and flips the axes,
+// like the transforms between y-up and z-up do.
+std::optional<glm::dmat3> getAxisPermutation(const glm::dmat4& transform) {
+  if (transform[0][3] != 0.0 || transform[1][3] != 0.0 ||
+      transform[2][3] != 0.0 || transform[3][3] != 1.0) {
+    return std::nullopt;
+  }
+
+  glm::dmat3 result(0.0);
+  for (glm::length_t column = 0; column < 3; ++column) {
+    int32_t axisCount = 0;
+    for (glm::length_t row = 0; row < 3; ++row) {
+      const double value = transform[column][row];
+      if (std::abs(value) < CesiumUtility::Math::Epsilon10) {
+        continue;
+      }
+      if (std::abs(std::abs(value) - 1.0) >= CesiumUtility::Math::Epsilon10) {
+        return std::nullopt;
+      }
+      result[column][row] = value > 0.0 ? 1.0 : -1.0;
+      ++axisCount;
+    }
+    if (axisCount != 1) {
+      return std::nullopt;
+    }
+  }
+
+  if (glm::determinant(result) == 0.0) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+// Copies the instances to the buffer in the coordinates of a node, when the
+// transform from the node to the tile only permutes and flips the axes and
+// then translates. The rotation and scale of each instance can then be
+// expressed in the node's coordinates directly, instead of composing a matrix
+// for each instance and decomposing it again.
+void copyInstancesToBuffer(
+    const DecodedInstances& decodedInstances,
+    const glm::dmat3& axisPermutation,
+    const glm::dvec3& translation,
+    std::byte* pData) {
+  const glm::dmat3 inverseAxisPermutation = glm::transpose(axisPermutation);
+  const glm::dmat3 scalePermutation(
+      glm::abs(inverseAxisPermutation[0]),
+      glm::abs(inverseAxisPermutation[1]),
+      glm::abs(inverseAxisPermutation[2]));
+  for (size_t i = 0; i < decodedInstances.positions.size(); ++i) {
+    const glm::dvec3 scale(decodedInstances.scales[i]);
+    const glm::dmat3 rotation =
+        glm::mat3_cast(glm::dquat(decodedInstances.rotations[i]));
+    const glm::dvec3 position =
+        inverseAxisPermutation *
+        (rotation * (scale * translation) +
+         glm::dvec3(decodedInstances.positions[i]) - translation);
+    const glm::dquat localRotation =
+        glm::quat_cast(inverseAxisPermutation * rotation * axisPermutation);
+    copyInstanceToBuffer(
+        position,
+        localRotation,
+        scalePermutation * scale,
+        pData + i * totalStride);
+  }
+}
+
 void instantiateGltfInstances(
     GltfConverterResult& result,
     const DecodedInstances& decodedInstances) {
@@ -672,7 +772,8 @@ void instantiateGltfInstances(
         std::vector<glm::dmat4> modelInstanceTransforms{glm::dmat4(1.0)};
         auto& gpuExt = node.addExtension<ExtensionExtMeshGpuInstancing>();
         gltf.addExtensionRequired(ExtensionExtMeshGpuInstancing::ExtensionName);
-        if (!gpuExt.attributes.empty()) {
+        const bool hasModelInstances = !gpuExt.attributes.empty();
+        if (hasModelInstances) {
           // The model already has instances! We will need to create the outer
           // product of these instances and those coming from i3dm.
           modelInstanceTransforms = getMeshGpuInstancingTransforms(
@@ -699,19 +800,30 @@ void instantiateGltfInstances(
         instanceBuffer.cesium.data.resize(dataBaseOffset + instanceDataSize);
         // Transform instance transform into local glTF coordinate system.
         const glm::dmat4 toTile = upToZ * transform;
-        const glm::dmat4 toTileInv = inverse(toTile);
-        size_t destInstanceIndx = 0;
-        for (unsigned i = 0; i < numInstances; ++i) {
-          const glm::dmat4 instanceTransform =
-              toTileInv * composeInstanceTransform(i, decodedInstances) *
-              toTile;
-          for (const auto& modelInstanceTransform : modelInstanceTransforms) {
-            glm::dmat4 finalTransform =
-                instanceTransform * modelInstanceTransform;
-            copyInstanceToBuffer(
-                finalTransform,
-                instanceBuffer.cesium.data,
-                destInstanceIndx++);
+        const std::optional<glm::dmat3> axisPermutation =
+            getAxisPermutation(toTile);
+        if (!hasModelInstances && axisPermutation) {
+          copyInstancesToBuffer(
+              decodedInstances,
+              *axisPermutation,
+              glm::dvec3(toTile[3]),
+              instanceBuffer.cesium.data.data() + dataBaseOffset);
+        } else {
+          const glm::dmat4 toTileInv = inverse(toTile);
+          size_t destInstanceIndx = 0;
+          for (unsigned i = 0; i < numInstances; ++i) {
+            const glm::dmat4 instanceTransform =
+                toTileInv * composeInstanceTransform(i, decodedInstances) *
+                toTile;
+            for (const auto& modelInstanceTransform :
+                 modelInstanceTransforms) {
+              glm::dmat4 finalTransform =
+                  instanceTransform * modelInstanceTransform;
+              copyInstanceToBuffer(
+                  finalTransform,
+                  instanceBuffer.cesium.data,
+                  destInstanceIndx++);
+            }
           }
         }
         auto posAccessorId = createAccessorInGltf(
@@ -728,7 +840,7 @@ void instantiateGltfInstances(
             gltf,
             instanceBufferViewId,
             Accessor::ComponentType::FLOAT,
-            numInstances,
+            numNewInstances,
             Accessor::Type::VEC4);
         auto& rotAccessor =
             gltf.accessors[static_cast<uint32_t>(rotAccessorId)];
@@ -739,7 +851,7 @@ void instantiateGltfInstances(
             gltf,
             instanceBufferViewId,
             Accessor::ComponentType::FLOAT,
-            numInstances,
+            numNewInstances,
             Accessor::Type::VEC3);
         auto& scaleAccessor =
             gltf.accessors[static_cast<uint32_t>(scaleAccessorId)];
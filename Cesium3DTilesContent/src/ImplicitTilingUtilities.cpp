@@ -10,11 +10,27 @@
 
 #include <libmorton/morton.h>
 
+#include <charconv>
+#include <iterator>
+
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 
 namespace Cesium3DTilesContent {
 
+namespace {
+void appendNumber(std::string& result, uint32_t value) {
+  char buffer[16];
+  const std::to_chars_result converted =
+      std::to_chars(std::begin(buffer), std::end(buffer), value);
+  result.append(buffer, converted.ptr);
+}
+
+// The relative URL of each tile is filled in here, so that its memory is
+// reused for all of the tiles resolved in a thread.
+thread_local std::string relativeUrl;
+} // namespace
+
 std::string ImplicitTilingUtilities::resolveUrl(
     const std::string& baseUrl,
     const std::string& urlTemplate,
@@ -64,6 +80,50 @@ std::string ImplicitTilingUtilities::resolveUrl(
   return CesiumUtility::Uri::resolve(baseUrl, url);
 }
 
+std::string ImplicitTilingUtilities::resolveUrl(
+    const CesiumUtility::BaseUri& baseUrl,
+    const CesiumUtility::UriTemplate& urlTemplate,
+    const QuadtreeTileID& quadtreeID) {
+  urlTemplate.substitute(
+      [&quadtreeID](const std::string& placeholder, std::string& result) {
+        if (placeholder == "level") {
+          appendNumber(result, quadtreeID.level);
+        } else if (placeholder == "x") {
+          appendNumber(result, quadtreeID.x);
+        } else if (placeholder == "y") {
+          appendNumber(result, quadtreeID.y);
+        } else {
+          result.append(placeholder);
+        }
+      },
+      relativeUrl);
+
+  return baseUrl.resolve(relativeUrl);
+}
+
+std::string ImplicitTilingUtilities::resolveUrl(
+    const CesiumUtility::BaseUri& baseUrl,
+    const CesiumUtility::UriTemplate& urlTemplate,
+    const OctreeTileID& octreeID) {
+  urlTemplate.substitute(
+      [&octreeID](const std::string& placeholder, std::string& result) {
+        if (placeholder == "level") {
+          appendNumber(result, octreeID.level);
+        } else if (placeholder == "x") {
+          appendNumber(result, octreeID.x);
+        } else if (placeholder == "y") {
+          appendNumber(result, octreeID.y);
+        } else if (placeholder == "z") {
+          appendNumber(result, octreeID.z);
+        } else {
+          result.append(placeholder);
+        }
+      },
+      relativeUrl);
+
+  return baseUrl.resolve(relativeUrl);
+}
+
 uint64_t ImplicitTilingUtilities::computeMortonIndex(
     const CesiumGeometry::QuadtreeTileID& tileID) {
   return libmorton::morton2D_64_encode(tileID.x, tileID.y);
@@ -8,6 +8,8 @@
 #include <CesiumUtility/AttributeCompression.h>
 #include <CesiumUtility/Math.h>
 
+#include <glm/gtc/matrix_transform.hpp>
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 4127 4018 4804)
@@ -25,7 +27,9 @@
 #include <rapidjson/document.h>
 #include <spdlog/fmt/fmt.h>
 
+#include <array>
 #include <limits>
+#include <vector>
 
 using namespace CesiumGltf;
 using namespace CesiumUtility;
@@ -171,7 +175,7 @@ const std::map<std::string, MetadataProperty::Type> stringToMetadataType{
 struct PntsSemantic {
   uint32_t byteOffset = 0;
   std::optional<int32_t> dracoId;
-  std::vector<std::byte> data;
+  CesiumUtility::ByteVector data{CesiumUtility::AllocationCategory::GltfBuffer};
 };
 
 struct DracoMetadataSemantic {
@@ -199,8 +203,55 @@ template <typename TColor> TColor srgbToLinear(const TColor srgb) {
   }
 }
 
+// The linear values of each possible sRGB channel value of 8-bit and RGB565
+// colors, computed exactly like srgbToLinear does, so that decoding a color
+// doesn't need a pow for each channel.
+struct SrgbToLinearTables {
+  std::array<float, 256> uint8;
+  std::array<float, 32> uint5;
+  std::array<float, 64> uint6;
+};
+
+const SrgbToLinearTables& getSrgbToLinearTables() {
+  static const SrgbToLinearTables tables = []() {
+    SrgbToLinearTables result;
+    for (size_t i = 0; i < result.uint8.size(); ++i) {
+      result.uint8[i] = glm::pow(static_cast<float>(i) / 255.0f, 2.2f);
+    }
+    for (size_t i = 0; i < result.uint5.size(); ++i) {
+      result.uint5[i] =
+          glm::pow(static_cast<float>(i) * (1.0f / 31.0f), 2.2f);
+    }
+    for (size_t i = 0; i < result.uint6.size(); ++i) {
+      result.uint6[i] =
+          glm::pow(static_cast<float>(i) * (1.0f / 63.0f), 2.2f);
+    }
+    return result;
+  }();
+  return tables;
+}
+
+glm::vec3
+srgbToLinear(const glm::u8vec3& srgb, const SrgbToLinearTables& tables) {
+  return glm::vec3(
+      tables.uint8[srgb.x],
+      tables.uint8[srgb.y],
+      tables.uint8[srgb.z]);
+}
+
+glm::vec4
+srgbToLinear(const glm::u8vec4& srgb, const SrgbToLinearTables& tables) {
+  return glm::vec4(
+      tables.uint8[srgb.x],
+      tables.uint8[srgb.y],
+      tables.uint8[srgb.z],
+      static_cast<float>(srgb.w) / 255.0f);
+}
+
 struct PntsContent {
   uint32_t pointsLength = 0;
+  // Whether to keep quantized positions and oct-encoded normals as they are.
+  bool keepQuantized = false;
   std::optional<glm::dvec3> rtcCenter;
   std::optional<glm::dvec3> quantizedVolumeOffset;
   std::optional<glm::dvec3> quantizedVolumeScale;
@@ -209,6 +260,8 @@ struct PntsContent {
 
   PntsSemantic position;
   bool positionQuantized = false;
+  // Whether the position data is still quantized, as padded u16vec4s.
+  bool positionDataQuantized = false;
   // required by glTF spec
   glm::vec3 positionMin = glm::vec3(std::numeric_limits<float>::max());
   glm::vec3 positionMax = glm::vec3(std::numeric_limits<float>::lowest());
@@ -218,6 +271,8 @@ struct PntsContent {
 
   std::optional<PntsSemantic> normal;
   bool normalOctEncoded = false;
+  // Whether the normal data is still oct-encoded, as padded u8vec4s.
+  bool normalDataOctEncoded = false;
 
   std::optional<PntsSemantic> batchId;
   std::optional<MetadataProperty::ComponentType> batchIdComponentType;
@@ -823,11 +878,13 @@ bool validateDracoMetadataAttribute(
 template <typename T>
 void getDracoData(
     const draco::PointAttribute* pAttribute,
-    std::vector<std::byte>& data,
+    CesiumUtility::ByteVector& data,
     const uint32_t pointsLength) {
   const size_t dataElementSize = sizeof(T);
   const size_t databufferByteLength = pointsLength * dataElementSize;
-  data.resize(databufferByteLength);
+  data = CesiumUtility::ByteVector(
+      databufferByteLength,
+      CesiumUtility::AllocationCategory::DracoOutput);
 
   draco::DataBuffer* decodedBuffer = pAttribute->buffer();
   int64_t decodedByteOffset = pAttribute->byte_offset();
@@ -943,8 +1000,10 @@ void decodeDraco(
       return;
     }
 
-    std::vector<std::byte>& positionData = parsedContent.position.data;
-    positionData.resize(pointsLength * sizeof(glm::vec3));
+    CesiumUtility::ByteVector& positionData = parsedContent.position.data;
+    positionData = CesiumUtility::ByteVector(
+        pointsLength * sizeof(glm::vec3),
+        CesiumUtility::AllocationCategory::DracoOutput);
 
     gsl::span<glm::vec3> outPositions(
         reinterpret_cast<glm::vec3*>(positionData.data()),
@@ -969,10 +1028,12 @@ void decodeDraco(
     if (color.dracoId) {
       draco::PointAttribute* pColorAttribute =
           pPointCloud->attribute(color.dracoId.value());
-      std::vector<std::byte>& colorData = parsedContent.color->data;
+      CesiumUtility::ByteVector& colorData = parsedContent.color->data;
       if (parsedContent.colorType == PntsColorType::RGBA &&
           validateDracoAttribute(pColorAttribute, draco::DT_UINT8, 4)) {
-        colorData.resize(pointsLength * sizeof(glm::vec4));
+        colorData = CesiumUtility::ByteVector(
+            pointsLength * sizeof(glm::vec4),
+            CesiumUtility::AllocationCategory::DracoOutput);
 
         gsl::span<glm::vec4> outColors(
             reinterpret_cast<glm::vec4*>(colorData.data()),
@@ -986,12 +1047,14 @@ void decodeDraco(
           const glm::u8vec4 rgbaColor = *reinterpret_cast<const glm::u8vec4*>(
               decodedBuffer->data() + decodedByteOffset +
               decodedByteStride * i);
-          outColors[i] = srgbToLinear(glm::vec4(rgbaColor) / 255.0f);
+          outColors[i] = srgbToLinear(rgbaColor, getSrgbToLinearTables());
         }
       } else if (
           parsedContent.colorType == PntsColorType::RGB &&
           validateDracoAttribute(pColorAttribute, draco::DT_UINT8, 3)) {
-        colorData.resize(pointsLength * sizeof(glm::vec3));
+        colorData = CesiumUtility::ByteVector(
+            pointsLength * sizeof(glm::vec3),
+            CesiumUtility::AllocationCategory::DracoOutput);
 
         gsl::span<glm::vec3> outColors(
             reinterpret_cast<glm::vec3*>(colorData.data()),
@@ -1005,7 +1068,7 @@ void decodeDraco(
           const glm::u8vec3 rgbColor = *reinterpret_cast<const glm::u8vec3*>(
               decodedBuffer->data() + decodedByteOffset +
               decodedByteStride * i);
-          outColors[i] = srgbToLinear(glm::vec3(rgbColor) / 255.0f);
+          outColors[i] = srgbToLinear(rgbColor, getSrgbToLinearTables());
         }
       } else {
         parsedContent.errors.emplaceWarning(
@@ -1087,25 +1150,45 @@ void decodeDraco(
 void parsePositionsFromFeatureTableBinary(
     const gsl::span<const std::byte>& featureTableBinaryData,
     PntsContent& parsedContent) {
-  std::vector<std::byte>& positionData = parsedContent.position.data;
+  CesiumUtility::ByteVector& positionData = parsedContent.position.data;
   if (positionData.size() > 0) {
     // If data isn't empty, it must have been decoded from Draco.
     return;
   }
 
   const uint32_t pointsLength = parsedContent.pointsLength;
-  const size_t positionsByteStride = sizeof(glm::vec3);
+  parsedContent.positionDataQuantized =
+      parsedContent.positionQuantized && parsedContent.keepQuantized;
+  // Vertex attributes must be aligned to 4 bytes, so quantized positions are
+  // padded to a u16vec4.
+  const size_t positionsByteStride = parsedContent.positionDataQuantized
+                                         ? sizeof(glm::u16vec4)
+                                         : sizeof(glm::vec3);
   const size_t positionsByteLength = pointsLength * positionsByteStride;
   positionData.resize(positionsByteLength);
 
-  gsl::span<glm::vec3> outPositions(
-      reinterpret_cast<glm::vec3*>(positionData.data()),
-      pointsLength);
+  if (parsedContent.positionDataQuantized) {
+    // The positions are dequantized by the transform of the node, so the
+    // bounds are in quantized units.
+    const gsl::span<const glm::u16vec3> quantizedPositions(
+        reinterpret_cast<const glm::u16vec3*>(
+            featureTableBinaryData.data() + parsedContent.position.byteOffset),
+        pointsLength);
+    gsl::span<glm::u16vec4> outPositions(
+        reinterpret_cast<glm::u16vec4*>(positionData.data()),
+        pointsLength);
 
-  if (parsedContent.positionQuantized) {
-    // PERFORMANCE_IDEA: In the future, it might be more performant to detect
-    // if the recipient engine can handle dequantization itself, and if so, use
-    // the KHR_mesh_quantization extension to avoid dequantizing here.
+    glm::vec3 positionMin(std::numeric_limits<float>::max());
+    glm::vec3 positionMax(std::numeric_limits<float>::lowest());
+    for (size_t i = 0; i < pointsLength; i++) {
+      const glm::u16vec3 quantizedPosition = quantizedPositions[i];
+      outPositions[i] = glm::u16vec4(quantizedPosition, 0);
+      positionMin = glm::min(positionMin, glm::vec3(quantizedPosition));
+      positionMax = glm::max(positionMax, glm::vec3(quantizedPosition));
+    }
+    parsedContent.positionMin = positionMin;
+    parsedContent.positionMax = positionMax;
+  } else if (parsedContent.positionQuantized) {
     const gsl::span<const glm::u16vec3> quantizedPositions(
         reinterpret_cast<const glm::u16vec3*>(
             featureTableBinaryData.data() + parsedContent.position.byteOffset),
@@ -1117,7 +1200,12 @@ void parsePositionsFromFeatureTableBinary(
         parsedContent.quantizedVolumeOffset.value());
 
     const glm::vec3 quantizedPositionScalar = quantizedVolumeScale / 65535.0f;
+    gsl::span<glm::vec3> outPositions(
+        reinterpret_cast<glm::vec3*>(positionData.data()),
+        pointsLength);
 
+    glm::vec3 positionMin(std::numeric_limits<float>::max());
+    glm::vec3 positionMax(std::numeric_limits<float>::lowest());
     for (size_t i = 0; i < pointsLength; i++) {
       const glm::vec3 quantizedPosition(
           quantizedPositions[i].x,
@@ -1127,11 +1215,11 @@ void parsePositionsFromFeatureTableBinary(
       const glm::vec3 dequantizedPosition =
           quantizedPosition * quantizedPositionScalar + quantizedVolumeOffset;
       outPositions[i] = dequantizedPosition;
-      parsedContent.positionMin =
-          glm::min(parsedContent.positionMin, dequantizedPosition);
-      parsedContent.positionMax =
-          glm::max(parsedContent.positionMax, dequantizedPosition);
+      positionMin = glm::min(positionMin, dequantizedPosition);
+      positionMax = glm::max(positionMax, dequantizedPosition);
     }
+    parsedContent.positionMin = positionMin;
+    parsedContent.positionMax = positionMax;
   } else {
     // The position accessor min / max is required by the glTF spec, so
     // use a for loop instead of std::memcpy.
@@ -1139,12 +1227,19 @@ void parsePositionsFromFeatureTableBinary(
         reinterpret_cast<const glm::vec3*>(
             featureTableBinaryData.data() + parsedContent.position.byteOffset),
         pointsLength);
+    gsl::span<glm::vec3> outPositions(
+        reinterpret_cast<glm::vec3*>(positionData.data()),
+        pointsLength);
+    glm::vec3 positionMin(std::numeric_limits<float>::max());
+    glm::vec3 positionMax(std::numeric_limits<float>::lowest());
     for (size_t i = 0; i < pointsLength; i++) {
       const glm::vec3 position = positions[i];
       outPositions[i] = position;
-      parsedContent.positionMin = glm::min(parsedContent.positionMin, position);
-      parsedContent.positionMax = glm::max(parsedContent.positionMax, position);
+      positionMin = glm::min(positionMin, position);
+      positionMax = glm::max(positionMax, position);
     }
+    parsedContent.positionMin = positionMin;
+    parsedContent.positionMax = positionMax;
   }
 }
 
@@ -1152,7 +1247,7 @@ void parseColorsFromFeatureTableBinary(
     const gsl::span<const std::byte>& featureTableBinaryData,
     PntsContent& parsedContent) {
   PntsSemantic& color = parsedContent.color.value();
-  std::vector<std::byte>& colorData = color.data;
+  CesiumUtility::ByteVector& colorData = color.data;
   if (colorData.size() > 0) {
     // If data isn't empty, it must have been decoded from Draco.
     return;
@@ -1165,6 +1260,7 @@ void parseColorsFromFeatureTableBinary(
   const size_t colorsByteLength = pointsLength * colorsByteStride;
   colorData.resize(colorsByteLength);
 
+  const SrgbToLinearTables& tables = getSrgbToLinearTables();
   if (parsedContent.colorType == PntsColorType::RGBA) {
     const gsl::span<const glm::u8vec4> rgbaColors(
         reinterpret_cast<const glm::u8vec4*>(
@@ -1175,8 +1271,7 @@ void parseColorsFromFeatureTableBinary(
         pointsLength);
 
     for (size_t i = 0; i < pointsLength; i++) {
-      glm::vec4 normalizedColor = glm::vec4(rgbaColors[i]) / 255.0f;
-      outColors[i] = srgbToLinear(normalizedColor);
+      outColors[i] = srgbToLinear(rgbaColors[i], tables);
     }
   } else if (parsedContent.colorType == PntsColorType::RGB) {
     const gsl::span<const glm::u8vec3> rgbColors(
@@ -1188,8 +1283,7 @@ void parseColorsFromFeatureTableBinary(
         pointsLength);
 
     for (size_t i = 0; i < pointsLength; i++) {
-      glm::vec3 normalizedColor = glm::vec3(rgbColors[i]) / 255.0f;
-      outColors[i] = srgbToLinear(normalizedColor);
+      outColors[i] = srgbToLinear(rgbColors[i], tables);
     }
   } else if (parsedContent.colorType == PntsColorType::RGB565) {
 
@@ -1201,11 +1295,16 @@ void parseColorsFromFeatureTableBinary(
         reinterpret_cast<glm::vec3*>(colorData.data()),
         pointsLength);
 
+    // Look up the linear value of each channel directly, instead of decoding
+    // the normalized sRGB channels first.
+    constexpr uint16_t mask5 = (1 << 5) - 1;
+    constexpr uint16_t mask6 = (1 << 6) - 1;
     for (size_t i = 0; i < pointsLength; i++) {
       const uint16_t compressedColor = compressedColors[i];
-      glm::vec3 decompressedColor =
-          glm::vec3(AttributeCompression::decodeRGB565(compressedColor));
-      outColors[i] = srgbToLinear(decompressedColor);
+      outColors[i] = glm::vec3(
+          tables.uint5[static_cast<size_t>(compressedColor >> 11)],
+          tables.uint6[static_cast<size_t>((compressedColor >> 5) & mask6)],
+          tables.uint5[static_cast<size_t>(compressedColor & mask5)]);
     }
   }
 }
@@ -1214,18 +1313,36 @@ void parseNormalsFromFeatureTableBinary(
     const gsl::span<const std::byte>& featureTableBinaryData,
     PntsContent& parsedContent) {
   PntsSemantic& normal = parsedContent.normal.value();
-  std::vector<std::byte>& normalData = normal.data;
+  CesiumUtility::ByteVector& normalData = normal.data;
   if (normalData.size() > 0) {
     // If data isn't empty, it must have been decoded from Draco.
     return;
   }
 
   const uint32_t pointsLength = parsedContent.pointsLength;
-  const size_t normalsByteStride = sizeof(glm::vec3);
+  parsedContent.normalDataOctEncoded =
+      parsedContent.normalOctEncoded && parsedContent.keepQuantized;
+  // Vertex attributes must be aligned to 4 bytes, so oct-encoded normals are
+  // padded to a u8vec4.
+  const size_t normalsByteStride = parsedContent.normalDataOctEncoded
+                                       ? sizeof(glm::u8vec4)
+                                       : sizeof(glm::vec3);
   const size_t normalsByteLength = pointsLength * normalsByteStride;
   normalData.resize(normalsByteLength);
 
-  if (parsedContent.normalOctEncoded) {
+  if (parsedContent.normalDataOctEncoded) {
+    const gsl::span<const glm::u8vec2> encodedNormals(
+        reinterpret_cast<const glm::u8vec2*>(
+            featureTableBinaryData.data() + normal.byteOffset),
+        pointsLength);
+    gsl::span<glm::u8vec4> outNormals(
+        reinterpret_cast<glm::u8vec4*>(normalData.data()),
+        pointsLength);
+
+    for (size_t i = 0; i < pointsLength; i++) {
+      outNormals[i] = glm::u8vec4(encodedNormals[i], 0, 0);
+    }
+  } else if (parsedContent.normalOctEncoded) {
     const gsl::span<const glm::u8vec2> encodedNormals(
         reinterpret_cast<const glm::u8vec2*>(
             featureTableBinaryData.data() + normal.byteOffset),
@@ -1235,12 +1352,7 @@ void parseNormalsFromFeatureTableBinary(
         reinterpret_cast<glm::vec3*>(normalData.data()),
         pointsLength);
 
-    for (size_t i = 0; i < pointsLength; i++) {
-      const glm::u8vec2 encodedNormal = encodedNormals[i];
-      outNormals[i] = glm::vec3(CesiumUtility::AttributeCompression::octDecode(
-          encodedNormal.x,
-          encodedNormal.y));
-    }
+    AttributeCompression::octDecode(encodedNormals, outNormals);
   } else {
     std::memcpy(
         normalData.data(),
@@ -1253,7 +1365,7 @@ void parseBatchIdsFromFeatureTableBinary(
     const gsl::span<const std::byte>& featureTableBinaryData,
     PntsContent& parsedContent) {
   PntsSemantic& batchId = parsedContent.batchId.value();
-  std::vector<std::byte>& batchIdData = batchId.data;
+  CesiumUtility::ByteVector& batchIdData = batchId.data;
   if (batchIdData.size() > 0) {
     // If data isn't empty, it must have been decoded from Draco.
     return;
@@ -1301,7 +1413,7 @@ void parseFeatureTableBinary(
   }
 }
 
-int32_t createBufferInGltf(Model& gltf, std::vector<std::byte>&& buffer) {
+int32_t createBufferInGltf(Model& gltf, CesiumUtility::ByteVector&& buffer) {
   size_t bufferId = gltf.buffers.size();
   Buffer& gltfBuffer = gltf.buffers.emplace_back();
   gltfBuffer.byteLength = static_cast<int32_t>(buffer.size());
@@ -1345,7 +1457,9 @@ int32_t createAccessorInGltf(
 
 void addPositionsToGltf(PntsContent& parsedContent, Model& gltf) {
   const int64_t count = static_cast<int64_t>(parsedContent.pointsLength);
-  const int64_t byteStride = static_cast<int64_t>(sizeof(glm ::vec3));
+  const bool isQuantized = parsedContent.positionDataQuantized;
+  const int64_t byteStride = static_cast<int64_t>(
+      isQuantized ? sizeof(glm::u16vec4) : sizeof(glm ::vec3));
   const int64_t byteLength = static_cast<int64_t>(byteStride * count);
   int32_t bufferId =
       createBufferInGltf(gltf, std::move(parsedContent.position.data));
@@ -1354,7 +1468,8 @@ void addPositionsToGltf(PntsContent& parsedContent, Model& gltf) {
   int32_t accessorId = createAccessorInGltf(
       gltf,
       bufferViewId,
-      Accessor::ComponentType::FLOAT,
+      isQuantized ? Accessor::ComponentType::UNSIGNED_SHORT
+                  : Accessor::ComponentType::FLOAT,
       count,
       Accessor::Type::VEC3);
 
@@ -1372,6 +1487,20 @@ void addPositionsToGltf(PntsContent& parsedContent, Model& gltf) {
 
   MeshPrimitive& primitive = gltf.meshes[0].primitives[0];
   primitive.attributes.emplace("POSITION", accessorId);
+
+  if (isQuantized) {
+    // Dequantize the positions with the transform of the node.
+    const glm::dvec3 quantizedVolumeScale =
+        parsedContent.quantizedVolumeScale.value() / 65535.0;
+    glm::dmat4 transform = CesiumGeometry::Transforms::Z_UP_TO_Y_UP;
+    transform = glm::translate(
+        transform, parsedContent.quantizedVolumeOffset.value());
+    transform = glm::scale(transform, quantizedVolumeScale);
+    std::memcpy(gltf.nodes[0].matrix.data(), &transform, sizeof(glm::dmat4));
+
+    gltf.addExtensionUsed("KHR_mesh_quantization");
+    gltf.addExtensionRequired("KHR_mesh_quantization");
+  }
 }
 
 void addColorsToGltf(PntsContent& parsedContent, Model& gltf) {
@@ -1413,21 +1542,34 @@ void addNormalsToGltf(PntsContent& parsedContent, Model& gltf) {
   PntsSemantic& normal = parsedContent.normal.value();
 
   const int64_t count = static_cast<int64_t>(parsedContent.pointsLength);
-  const int64_t byteStride = static_cast<int64_t>(sizeof(glm ::vec3));
+  const bool isOctEncoded = parsedContent.normalDataOctEncoded;
+  const int64_t byteStride = static_cast<int64_t>(
+      isOctEncoded ? sizeof(glm::u8vec4) : sizeof(glm ::vec3));
   const int64_t byteLength = static_cast<int64_t>(byteStride * count);
 
   int32_t bufferId = createBufferInGltf(gltf, std::move(normal.data));
   int32_t bufferViewId =
       createBufferViewInGltf(gltf, bufferId, byteLength, byteStride);
-  int32_t accessorId = createAccessorInGltf(
-      gltf,
-      bufferViewId,
-      Accessor::ComponentType::FLOAT,
-      count,
-      Accessor::Type::VEC3);
 
   MeshPrimitive& primitive = gltf.meshes[0].primitives[0];
-  primitive.attributes.emplace("NORMAL", accessorId);
+  if (isOctEncoded) {
+    int32_t accessorId = createAccessorInGltf(
+        gltf,
+        bufferViewId,
+        Accessor::ComponentType::UNSIGNED_BYTE,
+        count,
+        Accessor::Type::VEC2);
+    gltf.accessors[static_cast<uint32_t>(accessorId)].normalized = true;
+    primitive.attributes.emplace("_OCT_ENCODED_NORMAL", accessorId);
+  } else {
+    int32_t accessorId = createAccessorInGltf(
+        gltf,
+        bufferViewId,
+        Accessor::ComponentType::FLOAT,
+        count,
+        Accessor::Type::VEC3);
+    primitive.attributes.emplace("NORMAL", accessorId);
+  }
 }
 
 void addBatchIdsToGltf(PntsContent& parsedContent, CesiumGltf::Model& gltf) {
@@ -1551,10 +1693,13 @@ void convertPntsContentToGltf(
     const gsl::span<const std::byte>& pntsBinary,
     const PntsHeader& header,
     uint32_t headerLength,
+    bool convertBatchTable,
+    bool keepQuantized,
     GltfConverterResult& result) {
   if (header.featureTableJsonByteLength > 0 &&
       header.featureTableBinaryByteLength > 0) {
     PntsContent parsedContent;
+    parsedContent.keepQuantized = keepQuantized;
 
     const gsl::span<const std::byte> featureTableJsonData =
         pntsBinary.subspan(headerLength, header.featureTableJsonByteLength);
@@ -1573,7 +1718,7 @@ void convertPntsContentToGltf(
                                     header.featureTableJsonByteLength +
                                     header.featureTableBinaryByteLength;
     rapidjson::Document batchTableJson;
-    if (header.batchTableJsonByteLength > 0) {
+    if (header.batchTableJsonByteLength > 0 && convertBatchTable) {
       const gsl::span<const std::byte> batchTableJsonData = pntsBinary.subspan(
           static_cast<size_t>(batchTableStart),
           header.batchTableJsonByteLength);
@@ -1587,7 +1732,7 @@ void convertPntsContentToGltf(
             header.featureTableBinaryByteLength);
 
     gsl::span<const std::byte> batchTableBinaryData;
-    if (header.batchTableBinaryByteLength > 0) {
+    if (header.batchTableBinaryByteLength > 0 && convertBatchTable) {
       batchTableBinaryData = pntsBinary.subspan(
           static_cast<size_t>(
               batchTableStart + header.batchTableJsonByteLength),
@@ -1639,7 +1784,13 @@ CesiumAsync::Future<GltfConverterResult> PntsToGltfConverter::convert(
   uint32_t headerLength = 0;
   parsePntsHeader(pntsBinary, header, headerLength, result);
   if (!result.errors) {
-    convertPntsContentToGltf(pntsBinary, header, headerLength, result);
+    convertPntsContentToGltf(
+        pntsBinary,
+        header,
+        headerLength,
+        assetFetcher.convertBatchTables,
+        assetFetcher.keepPointCloudsQuantized,
+        result);
   }
 
   return assetFetcher.asyncSystem.createResolvedFuture(std::move(result));
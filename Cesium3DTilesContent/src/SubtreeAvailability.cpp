@@ -12,6 +12,7 @@
 #include <gsl/span>
 #include <rapidjson/document.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <optional>
 #include <string>
@@ -72,6 +73,68 @@ std::optional<SubtreeAvailability::AvailabilityView> parseAvailabilityView(
   return std::nullopt;
 }
 
+// The mask of all of the children of a tile when their availability is a
+// constant.
+uint8_t getChildMask(uint32_t childCount, bool isAvailable) noexcept {
+  return isAvailable ? uint8_t((1U << childCount) - 1U) : uint8_t(0);
+}
+
+// Reads the availability of the children of a tile, which are adjacent in the
+// bitstream starting at the given bit. Bits past the end of the bitstream are
+// read as unavailable, as when reading a single tile.
+uint8_t readChildMask(
+    gsl::span<const std::byte> bitstream,
+    uint64_t firstBitIndex,
+    uint32_t childCount) noexcept {
+  // There are at most eight children, so they span at most two bytes.
+  const uint64_t byteIndex = firstBitIndex / 8;
+  uint32_t window = 0;
+  if (byteIndex < bitstream.size()) {
+    window = uint32_t(bitstream[byteIndex]);
+    if (byteIndex + 1 < bitstream.size()) {
+      window |= uint32_t(bitstream[byteIndex + 1]) << 8;
+    }
+  }
+
+  return uint8_t((window >> (firstBitIndex % 8)) & ((1U << childCount) - 1U));
+}
+
+// Gets the value of the first bits of a bitstream if they're all the same.
+// Bits past the end of the bitstream are read as unavailable.
+std::optional<bool> getUniformValue(
+    gsl::span<const std::byte> bitstream,
+    uint64_t bitCount) noexcept {
+  const bool value =
+      !bitstream.empty() && (bitstream[0] & std::byte(1)) == std::byte(1);
+  const std::byte expected = value ? std::byte(0xFF) : std::byte(0x00);
+
+  const uint64_t fullByteCount = bitCount / 8;
+  if (value && fullByteCount > bitstream.size()) {
+    return std::nullopt;
+  }
+
+  const uint64_t byteCount =
+      std::min(fullByteCount, uint64_t(bitstream.size()));
+  for (uint64_t i = 0; i < byteCount; ++i) {
+    if (bitstream[i] != expected) {
+      return std::nullopt;
+    }
+  }
+
+  const uint64_t remainingBitCount = bitCount % 8;
+  if (remainingBitCount > 0) {
+    const std::byte last = fullByteCount < bitstream.size()
+                               ? bitstream[fullByteCount]
+                               : std::byte(0x00);
+    const std::byte mask = std::byte((1U << remainingBitCount) - 1U);
+    if (((last ^ expected) & mask) != std::byte(0x00)) {
+      return std::nullopt;
+    }
+  }
+
+  return value;
+}
+
 } // namespace
 
 /*static*/ std::optional<SubtreeAvailability> SubtreeAvailability::fromSubtree(
@@ -145,8 +208,10 @@ SubtreeAvailability::loadSubtree(
     const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::string& subtreeUrl,
-    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders) {
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+    bool loadMetadataBuffers) {
   auto pReader = std::make_shared<SubtreeFileReader>();
+  pReader->setLoadMetadataBuffers(loadMetadataBuffers);
   return pReader->load(asyncSystem, pAssetAccessor, subtreeUrl, requestHeaders)
       .thenInMainThread(
           [pLogger, subtreeUrl, subdivisionScheme, levelsInSubtree, pReader](
@@ -371,16 +436,57 @@ bool SubtreeAvailability::isSubtreeAvailable(
       checkSubtreeID));
 }
 
-namespace {
+uint8_t SubtreeAvailability::getAvailableChildTiles(
+    uint32_t relativeTileLevel,
+    uint64_t relativeTileMortonId) const noexcept {
+  return this->getAvailableChildren(
+      relativeTileLevel + 1,
+      relativeTileMortonId,
+      this->_tileAvailability);
+}
+
+uint8_t SubtreeAvailability::getAvailableChildContents(
+    uint32_t relativeTileLevel,
+    uint64_t relativeTileMortonId,
+    uint64_t contentId) const noexcept {
+  if (contentId >= this->_contentAvailability.size())
+    return 0;
+  return this->getAvailableChildren(
+      relativeTileLevel + 1,
+      relativeTileMortonId,
+      this->_contentAvailability[contentId]);
+}
+
+uint8_t SubtreeAvailability::getAvailableChildSubtrees(
+    uint64_t relativeTileMortonId) const noexcept {
+  // The subtree bitstream only holds the level after the last one of this
+  // subtree, so it starts with the first child subtree.
+  const uint64_t numOfTilesInLevel =
+      uint64_t(1) << (this->_powerOf2 * this->_levelsInSubtree);
+  const uint64_t firstChildMortonId = relativeTileMortonId << this->_powerOf2;
+  if (firstChildMortonId >= numOfTilesInLevel) {
+    return 0;
+  }
 
-void convertConstantAvailabilityToBitstream(
-    Subtree& subtree,
+  const SubtreeConstantAvailability* constantAvailability =
+      std::get_if<SubtreeConstantAvailability>(&this->_subtreeAvailability);
+  if (constantAvailability) {
+    return getChildMask(this->_childCount, constantAvailability->constant);
+  }
+
+  const SubtreeBufferViewAvailability* bufferViewAvailability =
+      std::get_if<SubtreeBufferViewAvailability>(&this->_subtreeAvailability);
+  return readChildMask(
+      bufferViewAvailability->view,
+      firstChildMortonId,
+      this->_childCount);
+}
+
+void SubtreeAvailability::convertConstantAvailabilityToBitstream(
     uint64_t numberOfTiles,
-    SubtreeAvailability::AvailabilityView& availabilityView) {
-  const SubtreeAvailability::SubtreeConstantAvailability*
-      pConstantAvailability =
-          std::get_if<SubtreeAvailability::SubtreeConstantAvailability>(
-              &availabilityView);
+    AvailabilityView& availabilityView) noexcept {
+  const SubtreeConstantAvailability* pConstantAvailability =
+      std::get_if<SubtreeConstantAvailability>(&availabilityView);
   if (!pConstantAvailability)
     return;
 
@@ -390,6 +496,7 @@ void convertConstantAvailabilityToBitstream(
   if (numberOfBytes * 8 < numberOfTiles)
     ++numberOfBytes;
 
+  Subtree& subtree = this->_subtree;
   BufferView& bufferView = subtree.bufferViews.emplace_back();
   bufferView.buffer = 0;
   bufferView.byteLength = int64_t(numberOfBytes);
@@ -410,18 +517,36 @@ void convertConstantAvailabilityToBitstream(
   bufferView.byteOffset = start;
   buffer.byteLength = end;
 
+  const std::byte* pOldBegin = buffer.cesium.data.data();
+  const std::byte* pOldEnd = pOldBegin + buffer.cesium.data.size();
   buffer.cesium.data.resize(
       size_t(buffer.byteLength),
       oldValue ? std::byte(0xFF) : std::byte(0x00));
 
-  gsl::span<std::byte> view(
-      buffer.cesium.data.data() + start,
-      buffer.cesium.data.data() + end);
+  // Growing the buffer may have moved the bitstreams already in it.
+  std::byte* pNewBegin = buffer.cesium.data.data();
+  if (pNewBegin != pOldBegin) {
+    auto rebase = [pOldBegin, pOldEnd, pNewBegin](AvailabilityView& view) {
+      SubtreeBufferViewAvailability* pBitstream =
+          std::get_if<SubtreeBufferViewAvailability>(&view);
+      if (pBitstream && pBitstream->view.data() >= pOldBegin &&
+          pBitstream->view.data() < pOldEnd) {
+        pBitstream->view = gsl::span<std::byte>(
+            pNewBegin + (pBitstream->view.data() - pOldBegin),
+            pBitstream->view.size());
+      }
+    };
+    rebase(this->_tileAvailability);
+    rebase(this->_subtreeAvailability);
+    for (AvailabilityView& contentAvailability : this->_contentAvailability) {
+      rebase(contentAvailability);
+    }
+  }
+
+  gsl::span<std::byte> view(pNewBegin + start, pNewBegin + end);
   availabilityView = SubtreeAvailability::SubtreeBufferViewAvailability{view};
 }
 
-} // namespace
-
 void SubtreeAvailability::setSubtreeAvailable(
     uint64_t relativeSubtreeMortonId,
     bool isAvailable) noexcept {
@@ -435,8 +560,7 @@ void SubtreeAvailability::setSubtreeAvailable(
       uint64_t numberOfTilesInNextLevel =
           uint64_t(1) << (this->_powerOf2 * this->_levelsInSubtree);
 
-      convertConstantAvailabilityToBitstream(
-          this->_subtree,
+      this->convertConstantAvailabilityToBitstream(
           numberOfTilesInNextLevel,
           this->_subtreeAvailability);
     }
@@ -471,6 +595,114 @@ void SubtreeAvailability::setSubtreeAvailable(
       isAvailable);
 }
 
+void SubtreeAvailability::compact() noexcept {
+  const uint64_t numberOfTilesInNextLevel =
+      uint64_t(1) << (this->_powerOf2 * this->_levelsInSubtree);
+  const uint64_t numberOfTilesInSubtree =
+      (numberOfTilesInNextLevel - 1U) / (this->_childCount - 1U);
+
+  // The bitstreams that are kept, each of which is copied once no matter how
+  // many availabilities refer to it.
+  std::vector<gsl::span<std::byte>> bitstreams;
+  std::vector<int64_t> byteOffsets;
+  int64_t byteLength = 0;
+
+  Subtree compacted;
+  auto compactView = [&](AvailabilityView& view,
+                         Availability& availability,
+                         uint64_t numberOfTiles) {
+    SubtreeBufferViewAvailability* pBitstream =
+        std::get_if<SubtreeBufferViewAvailability>(&view);
+    if (pBitstream) {
+      std::optional<bool> maybeValue =
+          getUniformValue(pBitstream->view, numberOfTiles);
+      if (maybeValue) {
+        view = SubtreeConstantAvailability{*maybeValue};
+        pBitstream = nullptr;
+      }
+    }
+
+    if (!pBitstream) {
+      availability.constant =
+          std::get<SubtreeConstantAvailability>(view).constant
+              ? Availability::Constant::AVAILABLE
+              : Availability::Constant::UNAVAILABLE;
+      return;
+    }
+
+    auto it = std::find_if(
+        bitstreams.begin(),
+        bitstreams.end(),
+        [pBitstream](const gsl::span<std::byte>& bitstream) {
+          return bitstream.data() == pBitstream->view.data() &&
+                 bitstream.size() == pBitstream->view.size();
+        });
+    if (it == bitstreams.end()) {
+      // Align each bitstream to a multiple of 8 bytes, as required by the
+      // spec.
+      byteLength += (8 - byteLength % 8) % 8;
+      byteOffsets.emplace_back(byteLength);
+      byteLength += int64_t(pBitstream->view.size());
+      it = bitstreams.insert(bitstreams.end(), pBitstream->view);
+    }
+
+    availability.bitstream = int64_t(it - bitstreams.begin());
+  };
+
+  compactView(
+      this->_tileAvailability,
+      compacted.tileAvailability,
+      numberOfTilesInSubtree);
+  compactView(
+      this->_subtreeAvailability,
+      compacted.childSubtreeAvailability,
+      numberOfTilesInNextLevel);
+  for (AvailabilityView& contentAvailability : this->_contentAvailability) {
+    compactView(
+        contentAvailability,
+        compacted.contentAvailability.emplace_back(),
+        numberOfTilesInSubtree);
+  }
+
+  if (!bitstreams.empty()) {
+    Buffer& buffer = compacted.buffers.emplace_back();
+    buffer.byteLength = byteLength;
+    buffer.cesium.data.resize(size_t(byteLength));
+
+    for (size_t i = 0; i < bitstreams.size(); ++i) {
+      BufferView& bufferView = compacted.bufferViews.emplace_back();
+      bufferView.buffer = 0;
+      bufferView.byteOffset = byteOffsets[i];
+      bufferView.byteLength = int64_t(bitstreams[i].size());
+      std::copy(
+          bitstreams[i].begin(),
+          bitstreams[i].end(),
+          buffer.cesium.data.begin() + byteOffsets[i]);
+    }
+  }
+
+  // Point the bitstreams at their copies before the originals are freed.
+  auto rebind = [&](AvailabilityView& view, const Availability& availability) {
+    SubtreeBufferViewAvailability* pBitstream =
+        std::get_if<SubtreeBufferViewAvailability>(&view);
+    if (pBitstream) {
+      const BufferView& bufferView =
+          compacted.bufferViews[size_t(*availability.bitstream)];
+      pBitstream->view = gsl::span<std::byte>(
+          compacted.buffers[0].cesium.data.data() + bufferView.byteOffset,
+          size_t(bufferView.byteLength));
+    }
+  };
+
+  rebind(this->_tileAvailability, compacted.tileAvailability);
+  rebind(this->_subtreeAvailability, compacted.childSubtreeAvailability);
+  for (size_t i = 0; i < this->_contentAvailability.size(); ++i) {
+    rebind(this->_contentAvailability[i], compacted.contentAvailability[i]);
+  }
+
+  this->_subtree = std::move(compacted);
+}
+
 bool SubtreeAvailability::isAvailable(
     uint32_t relativeTileLevel,
     uint64_t relativeTileMortonId,
@@ -496,6 +728,34 @@ bool SubtreeAvailability::isAvailable(
       availabilityView);
 }
 
+uint8_t SubtreeAvailability::getAvailableChildren(
+    uint32_t relativeChildLevel,
+    uint64_t relativeTileMortonId,
+    const AvailabilityView& availabilityView) const noexcept {
+  const uint64_t numOfTilesInLevel = uint64_t(1)
+                                     << (this->_powerOf2 * relativeChildLevel);
+  const uint64_t firstChildMortonId = relativeTileMortonId << this->_powerOf2;
+  if (firstChildMortonId >= numOfTilesInLevel) {
+    return 0;
+  }
+
+  const SubtreeConstantAvailability* constantAvailability =
+      std::get_if<SubtreeConstantAvailability>(&availabilityView);
+  if (constantAvailability) {
+    return getChildMask(this->_childCount, constantAvailability->constant);
+  }
+
+  const uint64_t numOfTilesFromRootToParentLevel =
+      (numOfTilesInLevel - 1U) / (this->_childCount - 1U);
+
+  const SubtreeBufferViewAvailability* bufferViewAvailability =
+      std::get_if<SubtreeBufferViewAvailability>(&availabilityView);
+  return readChildMask(
+      bufferViewAvailability->view,
+      numOfTilesFromRootToParentLevel + firstChildMortonId,
+      this->_childCount);
+}
+
 void SubtreeAvailability::setAvailable(
     uint32_t relativeTileLevel,
     uint64_t relativeTileMortonId,
@@ -513,8 +773,7 @@ void SubtreeAvailability::setAvailable(
       uint64_t numberOfTilesInSubtree =
           (numberOfTilesInNextLevel - 1U) / (this->_childCount - 1U);
 
-      convertConstantAvailabilityToBitstream(
-          this->_subtree,
+      this->convertConstantAvailabilityToBitstream(
           numberOfTilesInSubtree,
           availabilityView);
     }
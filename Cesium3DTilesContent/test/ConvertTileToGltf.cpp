@@ -1,6 +1,7 @@
 #include "ConvertTileToGltf.h"
 
 #include <Cesium3DTilesContent/B3dmToGltfConverter.h>
+#include <Cesium3DTilesContent/CmptToGltfConverter.h>
 #include <Cesium3DTilesContent/I3dmToGltfConverter.h>
 #include <Cesium3DTilesContent/PntsToGltfConverter.h>
 #include <CesiumNativeTests/FileAccessor.h>
@@ -25,8 +26,10 @@ AssetFetcher ConvertTileToGltf::makeAssetFetcher(const std::string& baseUrl) {
 
 GltfConverterResult ConvertTileToGltf::fromB3dm(
     const std::filesystem::path& filePath,
-    const CesiumGltfReader::GltfReaderOptions& options) {
+    const CesiumGltfReader::GltfReaderOptions& options,
+    bool convertBatchTables) {
   AssetFetcher assetFetcher = makeAssetFetcher("");
+  assetFetcher.convertBatchTables = convertBatchTables;
   auto bytes = readFile(filePath);
   auto future = B3dmToGltfConverter::convert(bytes, options, assetFetcher);
   return future.wait();
@@ -34,8 +37,12 @@ GltfConverterResult ConvertTileToGltf::fromB3dm(
 
 GltfConverterResult ConvertTileToGltf::fromPnts(
     const std::filesystem::path& filePath,
-    const CesiumGltfReader::GltfReaderOptions& options) {
+    const CesiumGltfReader::GltfReaderOptions& options,
+    bool convertBatchTables,
+    bool keepPointCloudsQuantized) {
   AssetFetcher assetFetcher = makeAssetFetcher("");
+  assetFetcher.convertBatchTables = convertBatchTables;
+  assetFetcher.keepPointCloudsQuantized = keepPointCloudsQuantized;
   auto bytes = readFile(filePath);
   auto future = PntsToGltfConverter::convert(bytes, options, assetFetcher);
   return future.wait();
@@ -43,11 +50,21 @@ GltfConverterResult ConvertTileToGltf::fromPnts(
 
 GltfConverterResult ConvertTileToGltf::fromI3dm(
     const std::filesystem::path& filePath,
-    const CesiumGltfReader::GltfReaderOptions& options) {
+    const CesiumGltfReader::GltfReaderOptions& options,
+    const std::shared_ptr<GltfModelCache>& pGltfModelCache) {
   AssetFetcher assetFetcher = makeAssetFetcher("");
+  assetFetcher.pGltfModelCache = pGltfModelCache;
   auto bytes = readFile(filePath);
   auto future = I3dmToGltfConverter::convert(bytes, options, assetFetcher);
   return future.wait();
 }
 
+GltfConverterResult ConvertTileToGltf::fromCmpt(
+    const std::vector<std::byte>& bytes,
+    const CesiumGltfReader::GltfReaderOptions& options) {
+  AssetFetcher assetFetcher = makeAssetFetcher("");
+  auto future = CmptToGltfConverter::convert(bytes, options, assetFetcher);
+  return future.wait();
+}
+
 } // namespace Cesium3DTilesContent
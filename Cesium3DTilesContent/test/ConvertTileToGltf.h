@@ -6,6 +6,7 @@
 #include <CesiumNativeTests/readFile.h>
 
 #include <filesystem>
+#include <vector>
 
 namespace Cesium3DTilesContent {
 
@@ -13,12 +14,19 @@ class ConvertTileToGltf {
 public:
   static GltfConverterResult fromB3dm(
       const std::filesystem::path& filePath,
-      const CesiumGltfReader::GltfReaderOptions& options = {});
+      const CesiumGltfReader::GltfReaderOptions& options = {},
+      bool convertBatchTables = true);
   static GltfConverterResult fromPnts(
       const std::filesystem::path& filePath,
-      const CesiumGltfReader::GltfReaderOptions& options = {});
+      const CesiumGltfReader::GltfReaderOptions& options = {},
+      bool convertBatchTables = true,
+      bool keepPointCloudsQuantized = false);
   static GltfConverterResult fromI3dm(
       const std::filesystem::path& filePath,
+      const CesiumGltfReader::GltfReaderOptions& options = {},
+      const std::shared_ptr<GltfModelCache>& pGltfModelCache = nullptr);
+  static GltfConverterResult fromCmpt(
+      const std::vector<std::byte>& bytes,
       const CesiumGltfReader::GltfReaderOptions& options = {});
 
 private:
@@ -0,0 +1,73 @@
+#include "ConvertTileToGltf.h"
+
+#include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <CesiumNativeTests/readFile.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+using namespace Cesium3DTilesContent;
+using namespace CesiumGltf;
+
+namespace {
+std::vector<std::byte>
+createCmpt(const std::vector<std::vector<std::byte>>& tiles) {
+  std::vector<std::byte> cmpt(16);
+  for (const std::vector<std::byte>& tile : tiles) {
+    cmpt.insert(cmpt.end(), tile.begin(), tile.end());
+  }
+
+  const uint32_t header[3]{
+      1,
+      static_cast<uint32_t>(cmpt.size()),
+      static_cast<uint32_t>(tiles.size())};
+  std::memcpy(cmpt.data(), "cmpt", 4);
+  std::memcpy(cmpt.data() + 4, header, sizeof(header));
+  return cmpt;
+}
+} // namespace
+
+TEST_CASE("CmptToGltfConverter") {
+  registerAllTileContentTypes();
+
+  std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testFilePath = testFilePath / "BatchTables" / "batchedWithJson.b3dm";
+  const std::vector<std::byte> b3dm = readFile(testFilePath);
+
+  GltfConverterResult single = ConvertTileToGltf::fromB3dm(testFilePath);
+  REQUIRE(single.model);
+
+  SECTION("merges the models of all inner tiles") {
+    GltfConverterResult result =
+        ConvertTileToGltf::fromCmpt(createCmpt({b3dm, b3dm, b3dm, b3dm}));
+    REQUIRE(result.model);
+    CHECK(!result.errors.hasErrors());
+    CHECK(result.model->meshes.size() == 4 * single.model->meshes.size());
+    CHECK(result.model->nodes.size() == 4 * single.model->nodes.size());
+    CHECK(
+        result.model->accessors.size() == 4 * single.model->accessors.size());
+    CHECK(result.model->buffers.size() == 4 * single.model->buffers.size());
+  }
+
+  SECTION("returns the model of a single inner tile unchanged") {
+    GltfConverterResult result =
+        ConvertTileToGltf::fromCmpt(createCmpt({b3dm}));
+    REQUIRE(result.model);
+    CHECK(result.model->meshes.size() == single.model->meshes.size());
+    CHECK(result.model->accessors.size() == single.model->accessors.size());
+  }
+
+  SECTION("reports a composite without inner tiles") {
+    std::vector<std::byte> cmpt = createCmpt({});
+    const uint32_t tilesLength = 1;
+    std::memcpy(cmpt.data() + 12, &tilesLength, sizeof(tilesLength));
+
+    GltfConverterResult result = ConvertTileToGltf::fromCmpt(cmpt);
+    CHECK(!result.model);
+    CHECK(!result.errors.warnings.empty());
+  }
+}
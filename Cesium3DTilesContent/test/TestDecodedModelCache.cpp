@@ -0,0 +1,195 @@
+#include <Cesium3DTilesContent/B3dmToGltfConverter.h>
+#include <Cesium3DTilesContent/DecodedModelCache.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumNativeTests/FileAccessor.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesContent;
+using namespace CesiumAsync;
+using namespace CesiumGltf;
+using namespace CesiumNativeTests;
+
+namespace {
+class MockCacheDatabase : public ICacheDatabase {
+public:
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override {
+    auto it = this->entries.find(key);
+    if (it == this->entries.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    this->entries.insert_or_assign(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(
+                HttpHeaders(requestHeaders),
+                std::string(requestMethod),
+                std::string(url)),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    return true;
+  }
+
+  virtual bool prune() override { return true; }
+
+  virtual bool clearAll() override {
+    this->entries.clear();
+    return true;
+  }
+
+  std::map<std::string, CacheItem> entries;
+};
+
+int conversionCount = 0;
+
+Future<GltfConverterResult> countingB3dmConverter(
+    const gsl::span<const std::byte>& content,
+    const CesiumGltfReader::GltfReaderOptions& options,
+    const AssetFetcher& assetFetcher) {
+  ++conversionCount;
+  return B3dmToGltfConverter::convert(content, options, assetFetcher);
+}
+} // namespace
+
+TEST_CASE("DecodedModelCache") {
+  std::shared_ptr<MockCacheDatabase> pDatabase =
+      std::make_shared<MockCacheDatabase>();
+  std::shared_ptr<DecodedModelCache> pCache =
+      std::make_shared<DecodedModelCache>(pDatabase);
+
+  SECTION("reads back the buffers and images that it writes") {
+    Model model;
+    Buffer& buffer = model.buffers.emplace_back();
+    buffer.byteLength = 5;
+    buffer.cesium.data = {
+        std::byte(1),
+        std::byte(2),
+        std::byte(3),
+        std::byte(4),
+        std::byte(5)};
+    model.bufferViews.emplace_back().byteLength = 5;
+
+    Image& image = model.images.emplace_back();
+    image.cesium.width = 2;
+    image.cesium.height = 1;
+    image.cesium.channels = 3;
+    image.cesium.compressedPixelFormat = GpuCompressedPixelFormat::ETC2_RGBA;
+    image.cesium.mipPositions = {{0, 4}, {4, 2}};
+    image.cesium.pixelData.resize(6, std::byte(7));
+    image.cesium.sizeBytes = 100;
+
+    std::vector<std::byte> data = pCache->write(model);
+    REQUIRE(!data.empty());
+
+    std::optional<Model> maybeModel = pCache->read(data);
+    REQUIRE(maybeModel);
+    REQUIRE(maybeModel->buffers.size() == 1);
+    CHECK(maybeModel->buffers[0].byteLength == 5);
+    CHECK(maybeModel->buffers[0].cesium.data == buffer.cesium.data);
+    REQUIRE(maybeModel->bufferViews.size() == 1);
+    CHECK(maybeModel->bufferViews[0].byteLength == 5);
+
+    REQUIRE(maybeModel->images.size() == 1);
+    const ImageCesium& readImage = maybeModel->images[0].cesium;
+    CHECK(readImage.width == 2);
+    CHECK(readImage.height == 1);
+    CHECK(readImage.channels == 3);
+    CHECK(
+        readImage.compressedPixelFormat == GpuCompressedPixelFormat::ETC2_RGBA);
+    REQUIRE(readImage.mipPositions.size() == 2);
+    CHECK(readImage.mipPositions[1].byteOffset == 4);
+    CHECK(readImage.mipPositions[1].byteSize == 2);
+    CHECK(readImage.pixelData.size() == 6);
+    CHECK(readImage.sizeBytes == 100);
+
+    data.resize(data.size() - 8);
+    CHECK(!pCache->read(data));
+  }
+
+  SECTION("only converts content with the same options once") {
+    const std::filesystem::path testFilePath =
+        std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) /
+        "BatchTables" / "batchedWithBatchTable-draco.b3dm";
+    const std::vector<std::byte> content = readFile(testFilePath);
+
+    AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+    std::vector<IAssetAccessor::THeader> requestHeaders;
+    AssetFetcher assetFetcher(
+        asyncSystem,
+        std::make_shared<FileAccessor>(),
+        "",
+        glm::dmat4(1.0),
+        requestHeaders);
+    assetFetcher.pDecodedModelCache = pCache;
+    CesiumGltfReader::GltfReaderOptions options;
+
+    conversionCount = 0;
+    GltfConverterResult converted =
+        DecodedModelCache::convert(
+            countingB3dmConverter,
+            content,
+            options,
+            assetFetcher)
+            .wait();
+    REQUIRE(converted.model);
+    CHECK(conversionCount == 1);
+    CHECK(pDatabase->entries.size() == 1);
+
+    GltfConverterResult cached =
+        DecodedModelCache::convert(
+            countingB3dmConverter,
+            content,
+            options,
+            assetFetcher)
+            .wait();
+    REQUIRE(cached.model);
+    CHECK(conversionCount == 1);
+    CHECK(cached.model->meshes.size() == converted.model->meshes.size());
+    CHECK(cached.model->accessors.size() == converted.model->accessors.size());
+    REQUIRE(cached.model->buffers.size() == converted.model->buffers.size());
+    for (size_t i = 0; i < cached.model->buffers.size(); ++i) {
+      CHECK(
+          cached.model->buffers[i].cesium.data.size() ==
+          converted.model->buffers[i].cesium.data.size());
+    }
+
+    assetFetcher.convertBatchTables = false;
+    DecodedModelCache::convert(
+        countingB3dmConverter,
+        content,
+        options,
+        assetFetcher)
+        .wait();
+    CHECK(conversionCount == 2);
+    CHECK(pDatabase->entries.size() == 2);
+  }
+}
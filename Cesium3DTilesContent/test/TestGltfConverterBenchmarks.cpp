@@ -0,0 +1,116 @@
+#include <Cesium3DTilesContent/B3dmToGltfConverter.h>
+#include <Cesium3DTilesContent/CmptToGltfConverter.h>
+#include <Cesium3DTilesContent/GltfConverters.h>
+#include <Cesium3DTilesContent/I3dmToGltfConverter.h>
+#include <Cesium3DTilesContent/PntsToGltfConverter.h>
+#include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumNativeTests/DecodeBenchmark.h>
+#include <CesiumNativeTests/FileAccessor.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+
+#include <catch2/catch.hpp>
+#include <glm/mat4x4.hpp>
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesContent;
+using namespace CesiumAsync;
+using namespace CesiumGltfReader;
+using namespace CesiumNativeTests;
+
+namespace {
+using Converter = Future<GltfConverterResult> (*)(
+    const gsl::span<const std::byte>&,
+    const GltfReaderOptions&,
+    const AssetFetcher&);
+
+std::vector<std::byte> readTestData(const std::filesystem::path& path) {
+  return readFile(
+      std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) / path);
+}
+
+DecodeBenchmarkItem createItem(
+    const std::string& name,
+    std::vector<std::byte>&& data,
+    Converter convert) {
+  return DecodeBenchmarkItem{
+      name,
+      std::move(data),
+      [convert](const std::vector<std::byte>& tile) {
+        AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+        std::vector<IAssetAccessor::THeader> requestHeaders;
+        AssetFetcher assetFetcher(
+            asyncSystem,
+            std::make_shared<FileAccessor>(),
+            "",
+            glm::dmat4(1.0),
+            requestHeaders);
+        GltfConverterResult result =
+            convert(tile, GltfReaderOptions(), assetFetcher).wait();
+        return result.model && !result.errors.hasErrors();
+      }};
+}
+
+// Puts the given tiles in a composite tile.
+std::vector<std::byte>
+createCmpt(const std::vector<std::vector<std::byte>>& tiles) {
+  std::vector<std::byte> cmpt(16);
+  for (const std::vector<std::byte>& tile : tiles) {
+    cmpt.insert(cmpt.end(), tile.begin(), tile.end());
+  }
+
+  const uint32_t header[3]{
+      1,
+      static_cast<uint32_t>(cmpt.size()),
+      static_cast<uint32_t>(tiles.size())};
+  std::memcpy(cmpt.data(), "cmpt", 4);
+  std::memcpy(cmpt.data() + 4, header, sizeof(header));
+  return cmpt;
+}
+} // namespace
+
+TEST_CASE("Benchmark converting tiles to glTF", "[.][benchmark]") {
+  registerAllTileContentTypes();
+
+  benchmarkDecoding(
+      {createItem(
+           "b3dm, batchedWithJson.b3dm",
+           readTestData("BatchTables/batchedWithJson.b3dm"),
+           B3dmToGltfConverter::convert),
+       createItem(
+           "b3dm with Draco, batchedWithBatchTable-draco.b3dm",
+           readTestData("BatchTables/batchedWithBatchTable-draco.b3dm"),
+           B3dmToGltfConverter::convert),
+       createItem(
+           "i3dm, instancedWithBatchTable.i3dm",
+           readTestData(
+               "i3dm/InstancedWithBatchTable/instancedWithBatchTable.i3dm"),
+           I3dmToGltfConverter::convert),
+       createItem(
+           "pnts, pointCloudRGB.pnts",
+           readTestData("PointCloud/pointCloudRGB.pnts"),
+           PntsToGltfConverter::convert),
+       createItem(
+           "pnts, pointCloudQuantized.pnts",
+           readTestData("PointCloud/pointCloudQuantized.pnts"),
+           PntsToGltfConverter::convert),
+       createItem(
+           "pnts with Draco, pointCloudDraco.pnts",
+           readTestData("PointCloud/pointCloudDraco.pnts"),
+           PntsToGltfConverter::convert),
+       createItem(
+           "cmpt of a pnts and a b3dm",
+           createCmpt(
+               {readTestData("PointCloud/pointCloudRGB.pnts"),
+                readTestData("BatchTables/batchedWithJson.b3dm")}),
+           CmptToGltfConverter::convert)});
+}
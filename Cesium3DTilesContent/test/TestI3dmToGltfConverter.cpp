@@ -5,6 +5,9 @@
 #include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
 
 #include <catch2/catch.hpp>
+#include <glm/geometric.hpp>
+
+#include <memory>
 
 using namespace Cesium3DTilesContent;
 using namespace CesiumGltf;
@@ -69,6 +72,38 @@ TEST_CASE("I3dmToGltfConverter") {
     CHECK(rotations.size() == 25);
   }
 
+  SECTION("shares the conversion of identical models through a cache") {
+    std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
+    testFilePath = testFilePath / "i3dm" / "InstancedOrientation" /
+                   "instancedOrientation.i3dm";
+
+    auto pCache = std::make_shared<GltfModelCache>();
+    GltfConverterResult first =
+        ConvertTileToGltf::fromI3dm(testFilePath, {}, pCache);
+    REQUIRE(first.model);
+    CHECK(pCache->size() == 1);
+
+    GltfConverterResult second =
+        ConvertTileToGltf::fromI3dm(testFilePath, {}, pCache);
+    REQUIRE(second.model);
+    CHECK(pCache->size() == 1);
+    CHECK(second.model->meshes.size() == first.model->meshes.size());
+
+    ExtensionExtMeshGpuInstancing* pExtension =
+        second.model->nodes[0].getExtension<ExtensionExtMeshGpuInstancing>();
+    REQUIRE(pExtension);
+
+    auto rotationIt = pExtension->attributes.find("ROTATION");
+    REQUIRE(rotationIt != pExtension->attributes.end());
+
+    AccessorView<glm::fvec4> rotations(*second.model, rotationIt->second);
+    REQUIRE(rotations.status() == AccessorViewStatus::Valid);
+    REQUIRE(rotations.size() == 25);
+    for (int64_t i = 0; i < rotations.size(); ++i) {
+      CHECK(glm::length(rotations[i]) == Approx(1.0f));
+    }
+  }
+
   SECTION("reports an error if the glTF is v1, which is unsupported") {
     std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
     testFilePath =
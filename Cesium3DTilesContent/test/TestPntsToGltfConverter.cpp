@@ -2,10 +2,12 @@
 
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/HttpHeaders.h>
+#include <CesiumGeometry/Transforms.h>
 #include <CesiumGltf/ExtensionCesiumRTC.h>
 #include <CesiumGltf/ExtensionExtMeshFeatures.h>
 #include <CesiumGltf/ExtensionKhrMaterialsUnlit.h>
 #include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumUtility/AttributeCompression.h>
 #include <CesiumUtility/Math.h>
 
 #include <catch2/catch.hpp>
@@ -22,7 +24,7 @@ using namespace CesiumUtility;
 
 template <typename Type>
 static void checkBufferContents(
-    const std::vector<std::byte>& buffer,
+    const CesiumUtility::ByteVector& buffer,
     const std::vector<Type>& expected,
     [[maybe_unused]] const double epsilon = Math::Epsilon6) {
   REQUIRE(buffer.size() == expected.size() * sizeof(Type));
@@ -689,6 +691,108 @@ TEST_CASE("Converts point cloud with oct-encoded normals to glTF") {
   checkBufferContents<glm::vec3>(normalBuffer.cesium.data, expectedNormals);
 }
 
+TEST_CASE("Keeps point cloud attributes quantized if requested") {
+  std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testFilePath = testFilePath / "PointCloud";
+  const size_t pointsLength = 8;
+
+  SECTION("Quantized positions") {
+    GltfConverterResult result = ConvertTileToGltf::fromPnts(
+        testFilePath / "pointCloudQuantized.pnts",
+        {},
+        true,
+        true);
+    REQUIRE(result.model);
+    Model& gltf = *result.model;
+    CHECK(gltf.isExtensionUsed("KHR_mesh_quantization"));
+    CHECK(gltf.isExtensionRequired("KHR_mesh_quantization"));
+
+    MeshPrimitive& primitive = gltf.meshes[0].primitives[0];
+    const Accessor& accessor = gltf.accessors[static_cast<size_t>(
+        primitive.attributes.at("POSITION"))];
+    CHECK(accessor.componentType == Accessor::ComponentType::UNSIGNED_SHORT);
+    CHECK(accessor.type == Accessor::Type::VEC3);
+    CHECK(!accessor.normalized);
+
+    const BufferView& bufferView =
+        gltf.bufferViews[static_cast<size_t>(accessor.bufferView)];
+    CHECK(bufferView.byteStride == int64_t(sizeof(glm::u16vec4)));
+    const CesiumUtility::ByteVector& data =
+        gltf.buffers[static_cast<size_t>(bufferView.buffer)].cesium.data;
+    REQUIRE(data.size() == pointsLength * sizeof(glm::u16vec4));
+    const glm::u16vec4* pPositions =
+        reinterpret_cast<const glm::u16vec4*>(data.data());
+
+    glm::dmat4 transform;
+    std::memcpy(&transform, gltf.nodes[0].matrix.data(), sizeof(glm::dmat4));
+    transform = CesiumGeometry::Transforms::Y_UP_TO_Z_UP * transform;
+
+    const std::vector<glm::dvec3> expectedPositions = {
+        glm::dvec3(1215010.39, -4736313.38, 4081601.7),
+        glm::dvec3(1215015.23, -4736312.13, 4081601.7),
+        glm::dvec3(1215009.59, -4736310.26, 4081605.53),
+        glm::dvec3(1215014.43, -4736309.02, 4081605.53),
+        glm::dvec3(1215011.34, -4736317.08, 4081604.92),
+        glm::dvec3(1215016.18, -4736315.84, 4081604.92),
+        glm::dvec3(1215010.54, -4736313.97, 4081608.74),
+        glm::dvec3(1215015.38, -4736312.73, 4081608.74)};
+    for (size_t i = 0; i < pointsLength; ++i) {
+      const glm::dvec3 position =
+          glm::dvec3(transform * glm::dvec4(glm::dvec3(pPositions[i]), 1.0));
+      CHECK(Math::equalsEpsilon(position, expectedPositions[i], 0.0, 0.01));
+      for (glm::length_t j = 0; j < 3; ++j) {
+        CHECK(accessor.min[static_cast<size_t>(j)] <= pPositions[i][j]);
+        CHECK(accessor.max[static_cast<size_t>(j)] >= pPositions[i][j]);
+      }
+    }
+  }
+
+  SECTION("Oct-encoded normals") {
+    GltfConverterResult result = ConvertTileToGltf::fromPnts(
+        testFilePath / "pointCloudNormalsOctEncoded.pnts",
+        {},
+        true,
+        true);
+    REQUIRE(result.model);
+    Model& gltf = *result.model;
+
+    MeshPrimitive& primitive = gltf.meshes[0].primitives[0];
+    CHECK(primitive.attributes.find("NORMAL") == primitive.attributes.end());
+    const Accessor& accessor = gltf.accessors[static_cast<size_t>(
+        primitive.attributes.at("_OCT_ENCODED_NORMAL"))];
+    CHECK(accessor.componentType == Accessor::ComponentType::UNSIGNED_BYTE);
+    CHECK(accessor.type == Accessor::Type::VEC2);
+    CHECK(accessor.normalized);
+
+    Material& material = gltf.materials[0];
+    CHECK(!material.hasExtension<ExtensionKhrMaterialsUnlit>());
+
+    const BufferView& bufferView =
+        gltf.bufferViews[static_cast<size_t>(accessor.bufferView)];
+    CHECK(bufferView.byteStride == int64_t(sizeof(glm::u8vec4)));
+    const CesiumUtility::ByteVector& data =
+        gltf.buffers[static_cast<size_t>(bufferView.buffer)].cesium.data;
+    REQUIRE(data.size() == pointsLength * sizeof(glm::u8vec4));
+    const glm::u8vec4* pNormals =
+        reinterpret_cast<const glm::u8vec4*>(data.data());
+
+    const std::vector<glm::dvec3> expectedNormals = {
+        glm::dvec3(-0.9856477, 0.1634960, 0.0420418),
+        glm::dvec3(-0.5901730, 0.5359042, 0.6037402),
+        glm::dvec3(-0.5674310, -0.7817938, -0.2584963),
+        glm::dvec3(-0.5861990, -0.7179291, 0.3754308),
+        glm::dvec3(-0.8519385, -0.1283743, -0.5076620),
+        glm::dvec3(0.7587127, 0.1254564, 0.6392304),
+        glm::dvec3(0.1354662, -0.2292506, -0.9638947),
+        glm::dvec3(-0.0656172, 0.9640687, 0.2574214)};
+    for (size_t i = 0; i < pointsLength; ++i) {
+      const glm::dvec3 normal =
+          AttributeCompression::octDecode(pNormals[i].x, pNormals[i].y);
+      CHECK(Math::equalsEpsilon(normal, expectedNormals[i], Math::Epsilon6));
+    }
+  }
+}
+
 std::set<int32_t>
 getUniqueBufferIds(const std::vector<BufferView>& bufferViews) {
   std::set<int32_t> result;
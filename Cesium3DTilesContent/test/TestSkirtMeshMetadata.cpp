@@ -261,4 +261,46 @@ TEST_CASE("Test converting gltf extras to skirt mesh metadata") {
       REQUIRE(SkirtMeshMetadata::parseFromGltfExtras(extras) == std::nullopt);
     }
   }
+
+  SECTION("Gltf Extras without baked skirts") {
+    SkirtMeshMetadata skirtMeshMetadata =
+        *SkirtMeshMetadata::parseFromGltfExtras(
+            {{"skirtMeshMetadata", gltfSkirtMeshMetadata}});
+    REQUIRE(skirtMeshMetadata.hasBakedSkirts);
+
+    skirtMeshMetadata.hasBakedSkirts = false;
+    skirtMeshMetadata.westEdgeIndices = {0, 3, 6};
+    skirtMeshMetadata.southEdgeIndices = {2, 1, 0};
+    skirtMeshMetadata.eastEdgeIndices = {8, 5, 2};
+    skirtMeshMetadata.northEdgeIndices = {6, 7, 8};
+    JsonValue::Object extras =
+        SkirtMeshMetadata::createGltfExtras(skirtMeshMetadata);
+
+    SECTION("has the edge indices") {
+      std::optional<SkirtMeshMetadata> parsed =
+          SkirtMeshMetadata::parseFromGltfExtras(extras);
+      REQUIRE(parsed);
+      REQUIRE(!parsed->hasBakedSkirts);
+      REQUIRE(parsed->westEdgeIndices == skirtMeshMetadata.westEdgeIndices);
+      REQUIRE(parsed->southEdgeIndices == skirtMeshMetadata.southEdgeIndices);
+      REQUIRE(parsed->eastEdgeIndices == skirtMeshMetadata.eastEdgeIndices);
+      REQUIRE(parsed->northEdgeIndices == skirtMeshMetadata.northEdgeIndices);
+    }
+
+    SECTION("missing edge indices field") {
+      JsonValue::Object& gltfSkirt =
+          std::get<JsonValue::Object>(extras["skirtMeshMetadata"].value);
+      gltfSkirt.erase("eastEdgeIndices");
+
+      REQUIRE(SkirtMeshMetadata::parseFromGltfExtras(extras) == std::nullopt);
+    }
+
+    SECTION("edge indices field has negative index") {
+      JsonValue::Object& gltfSkirt =
+          std::get<JsonValue::Object>(extras["skirtMeshMetadata"].value);
+      gltfSkirt["northEdgeIndices"] = JsonValue::Array{6, -7, 8};
+
+      REQUIRE(SkirtMeshMetadata::parseFromGltfExtras(extras) == std::nullopt);
+    }
+  }
 }
@@ -1,5 +1,6 @@
 #include <Cesium3DTiles/Subtree.h>
 #include <Cesium3DTilesContent/SubtreeAvailability.h>
+#include <Cesium3DTilesReader/SubtreeFileReader.h>
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumGeometry/QuadtreeTileID.h>
 #include <CesiumNativeTests/SimpleAssetAccessor.h>
@@ -14,6 +15,10 @@
 #include <rapidjson/writer.h>
 
 #include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 using namespace Cesium3DTiles;
@@ -786,3 +791,230 @@ TEST_CASE("SubtreeAvailability modifications") {
         QuadtreeTileID(5, 31, 31)));
   }
 }
+
+TEST_CASE("SubtreeAvailability child masks") {
+  const ImplicitTileSubdivisionScheme scheme = GENERATE(
+      ImplicitTileSubdivisionScheme::Quadtree,
+      ImplicitTileSubdivisionScheme::Octree);
+  const uint32_t childCount =
+      scheme == ImplicitTileSubdivisionScheme::Quadtree ? 4U : 8U;
+  const uint32_t powerOf2 =
+      scheme == ImplicitTileSubdivisionScheme::Quadtree ? 2U : 3U;
+  const uint32_t levels = 3;
+
+  std::optional<SubtreeAvailability> maybeAvailability =
+      SubtreeAvailability::createEmpty(scheme, levels);
+  REQUIRE(maybeAvailability);
+  SubtreeAvailability& availability = *maybeAvailability;
+
+  auto checkMasks = [&]() {
+    for (uint32_t level = 0; level < levels; ++level) {
+      const uint64_t tileCount = uint64_t(1) << (powerOf2 * level);
+      for (uint64_t mortonId = 0; mortonId < tileCount; ++mortonId) {
+        uint8_t expectedTiles = 0;
+        uint8_t expectedContents = 0;
+        uint8_t expectedSubtrees = 0;
+        for (uint32_t i = 0; i < childCount; ++i) {
+          const uint64_t childMortonId = (mortonId << powerOf2) + i;
+          const uint8_t bit = uint8_t(1U << i);
+          if (availability.isTileAvailable(level + 1, childMortonId)) {
+            expectedTiles |= bit;
+          }
+          if (availability.isContentAvailable(level + 1, childMortonId, 0)) {
+            expectedContents |= bit;
+          }
+          if (level + 1 == levels &&
+              availability.isSubtreeAvailable(childMortonId)) {
+            expectedSubtrees |= bit;
+          }
+        }
+
+        CHECK(
+            availability.getAvailableChildTiles(level, mortonId) ==
+            expectedTiles);
+        CHECK(
+            availability.getAvailableChildContents(level, mortonId, 0) ==
+            expectedContents);
+        if (level + 1 == levels) {
+          CHECK(
+              availability.getAvailableChildSubtrees(mortonId) ==
+              expectedSubtrees);
+        }
+      }
+    }
+
+    // Content IDs that don't exist have no available children.
+    CHECK(availability.getAvailableChildContents(0, 0, 1) == 0);
+  };
+
+  SECTION("with constant availability") { checkMasks(); }
+
+  SECTION("with availability in bitstreams") {
+    // An irregular pattern, so that the children of a tile straddle bytes.
+    for (uint32_t level = 0; level <= levels; ++level) {
+      const uint64_t tileCount = uint64_t(1) << (powerOf2 * level);
+      for (uint64_t mortonId = 0; mortonId < tileCount; ++mortonId) {
+        if (level < levels) {
+          availability.setTileAvailable(level, mortonId, mortonId % 3 != 1);
+          availability.setContentAvailable(
+              level,
+              mortonId,
+              0,
+              mortonId % 5 < 2);
+        } else {
+          availability.setSubtreeAvailable(mortonId, mortonId % 7 < 3);
+        }
+      }
+    }
+
+    checkMasks();
+  }
+}
+
+TEST_CASE("SubtreeAvailability::compact") {
+  // Two levels of a quadtree, with a buffer that also has other data in it.
+  Subtree subtree;
+  std::vector<std::byte>& data = subtree.buffers.emplace_back().cesium.data;
+  data.resize(18, std::byte(0xAB));
+  subtree.buffers[0].byteLength = int64_t(data.size());
+
+  // The tiles 0, 1 and 4 are available.
+  data[8] = std::byte(0x13);
+  // No child subtrees are available.
+  data[16] = data[17] = std::byte(0x00);
+
+  const std::vector<std::pair<int64_t, int64_t>> bufferViewRanges{
+      {0, 8},
+      {8, 1},
+      {16, 2}};
+  for (const auto& [byteOffset, byteLength] : bufferViewRanges) {
+    BufferView& bufferView = subtree.bufferViews.emplace_back();
+    bufferView.buffer = 0;
+    bufferView.byteOffset = byteOffset;
+    bufferView.byteLength = byteLength;
+  }
+
+  // The tile and content availability share a buffer view.
+  subtree.tileAvailability.bitstream = 1;
+  subtree.contentAvailability.emplace_back().bitstream = 1;
+  subtree.childSubtreeAvailability.bitstream = 2;
+  subtree.propertyTables.emplace_back();
+
+  std::optional<SubtreeAvailability> maybeAvailability =
+      SubtreeAvailability::fromSubtree(
+          ImplicitTileSubdivisionScheme::Quadtree,
+          2,
+          std::move(subtree));
+  REQUIRE(maybeAvailability);
+  SubtreeAvailability& availability = *maybeAvailability;
+
+  auto getAvailability = [&availability]() {
+    std::vector<bool> result;
+    for (uint32_t level = 0; level < 2; ++level) {
+      for (uint64_t mortonId = 0; mortonId < (uint64_t(1) << (2 * level));
+           ++mortonId) {
+        result.push_back(availability.isTileAvailable(level, mortonId));
+        result.push_back(availability.isContentAvailable(level, mortonId, 0));
+      }
+    }
+    for (uint64_t mortonId = 0; mortonId < 16; ++mortonId) {
+      result.push_back(availability.isSubtreeAvailable(mortonId));
+    }
+    return result;
+  };
+
+  const std::vector<bool> expected = getAvailability();
+  availability.compact();
+  CHECK(getAvailability() == expected);
+
+  const Subtree& compacted = availability.getSubtree();
+  REQUIRE(compacted.buffers.size() == 1);
+  CHECK(compacted.buffers[0].cesium.data.size() == 1);
+  REQUIRE(compacted.bufferViews.size() == 1);
+  CHECK(compacted.tileAvailability.bitstream == 0);
+  REQUIRE(compacted.contentAvailability.size() == 1);
+  CHECK(compacted.contentAvailability[0].bitstream == 0);
+  CHECK(
+      compacted.childSubtreeAvailability.constant ==
+      Availability::Constant::UNAVAILABLE);
+  CHECK(compacted.propertyTables.empty());
+
+  SECTION("can still be modified") {
+    // Turning the constant back into a bitstream grows the buffer that the
+    // other bitstreams are in.
+    availability.setSubtreeAvailable(5, true);
+
+    std::vector<bool> expectedAfterModification = expected;
+    expectedAfterModification[expected.size() - 16 + 5] = true;
+    CHECK(getAvailability() == expectedAfterModification);
+  }
+}
+
+TEST_CASE("SubtreeFileReader loads external buffers") {
+  // The second buffer is only used by metadata, and the first and last
+  // buffers have the same URI.
+  const std::string subtreeJson = R"({
+    "buffers": [
+      {"uri": "availability.bin", "byteLength": 1},
+      {"uri": "metadata.bin", "byteLength": 8},
+      {"uri": "availability.bin", "byteLength": 1}
+    ],
+    "bufferViews": [
+      {"buffer": 0, "byteOffset": 0, "byteLength": 1},
+      {"buffer": 1, "byteOffset": 0, "byteLength": 8},
+      {"buffer": 2, "byteOffset": 0, "byteLength": 1}
+    ],
+    "tileAvailability": {"bitstream": 0},
+    "contentAvailability": [{"bitstream": 2}],
+    "childSubtreeAvailability": {"constant": 0}
+  })";
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+  auto addRequest = [&requests](
+                        const std::string& url,
+                        std::vector<std::byte>&& data) {
+    requests.emplace(
+        url,
+        std::make_shared<SimpleAssetRequest>(
+            "GET",
+            url,
+            CesiumAsync::HttpHeaders{},
+            std::make_unique<SimpleAssetResponse>(
+                uint16_t(200),
+                "doesn't matter",
+                CesiumAsync::HttpHeaders{},
+                std::move(data))));
+  };
+
+  const std::byte* pJsonBegin =
+      reinterpret_cast<const std::byte*>(subtreeJson.data());
+  addRequest(
+      "subtree.json",
+      std::vector<std::byte>(pJsonBegin, pJsonBegin + subtreeJson.size()));
+  addRequest("availability.bin", std::vector<std::byte>(1, std::byte(0x13)));
+
+  Cesium3DTilesReader::SubtreeFileReader reader;
+  const bool loadMetadataBuffers = GENERATE(true, false);
+  reader.setLoadMetadataBuffers(loadMetadataBuffers);
+  if (loadMetadataBuffers) {
+    addRequest("metadata.bin", std::vector<std::byte>(8, std::byte(0xAB)));
+  }
+
+  auto pAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(requests));
+  CesiumAsync::AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+
+  CesiumJsonReader::ReadJsonResult<Subtree> result = waitForFuture(
+      asyncSystem,
+      reader.load(asyncSystem, pAssetAccessor, "subtree.json"));
+  REQUIRE(result.value);
+  CHECK(result.errors.empty());
+
+  const std::vector<Buffer>& buffers = result.value->buffers;
+  REQUIRE(buffers.size() == 3);
+  CHECK(buffers[0].cesium.data == std::vector<std::byte>(1, std::byte(0x13)));
+  CHECK(buffers[2].cesium.data == buffers[0].cesium.data);
+  CHECK(
+      buffers[1].cesium.data.size() ==
+      (loadMetadataBuffers ? size_t(8) : size_t(0)));
+}
@@ -15,6 +15,7 @@
 #include <spdlog/sinks/ringbuffer_sink.h>
 #include <spdlog/spdlog.h>
 
+#include <chrono>
 #include <filesystem>
 #include <set>
 
@@ -754,6 +755,49 @@ TEST_CASE("Convert binary B3DM batch table to EXT_structural_metadata") {
   }
 }
 
+TEST_CASE("Skips batch tables if convertBatchTables is false") {
+  std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
+
+  SECTION("B3DM") {
+    GltfConverterResult result = ConvertTileToGltf::fromB3dm(
+        testFilePath / "BatchTables" / "batchedWithJson.b3dm",
+        {},
+        false);
+    REQUIRE(!result.errors);
+    REQUIRE(result.model);
+
+    const Model& gltf = *result.model;
+    CHECK(!gltf.getExtension<ExtensionModelExtStructuralMetadata>());
+    CHECK(!gltf.isExtensionUsed(
+        ExtensionModelExtStructuralMetadata::ExtensionName));
+    CHECK(!gltf.isExtensionUsed(ExtensionExtMeshFeatures::ExtensionName));
+
+    for (const Mesh& mesh : gltf.meshes) {
+      for (const MeshPrimitive& primitive : mesh.primitives) {
+        CHECK(!primitive.getExtension<ExtensionExtMeshFeatures>());
+        CHECK(primitive.attributes.count("_BATCHID") == 1);
+      }
+    }
+  }
+
+  SECTION("PNTS") {
+    GltfConverterResult result = ConvertTileToGltf::fromPnts(
+        testFilePath / "PointCloud" / "pointCloudBatched.pnts",
+        {},
+        false);
+    REQUIRE(!result.errors);
+    REQUIRE(result.model);
+
+    const Model& gltf = *result.model;
+    CHECK(!gltf.getExtension<ExtensionModelExtStructuralMetadata>());
+    REQUIRE(gltf.meshes.size() == 1);
+    REQUIRE(gltf.meshes[0].primitives.size() == 1);
+    const MeshPrimitive& primitive = gltf.meshes[0].primitives[0];
+    CHECK(!primitive.getExtension<ExtensionExtMeshFeatures>());
+    CHECK(primitive.attributes.count("POSITION") == 1);
+  }
+}
+
 TEST_CASE("Converts batched PNTS batch table to EXT_structural_metadata") {
   std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
   testFilePath = testFilePath / "PointCloud" / "pointCloudBatched.pnts";
@@ -2847,3 +2891,120 @@ TEST_CASE("3DTILES_batch_table_hierarchy with parentCounts values != 1 is "
   CHECK(propertyTable.classProperty == "default");
   REQUIRE(propertyTable.properties.size() == 0);
 }
+
+static void createLargeBatchTable(
+    int64_t featureCount,
+    rapidjson::Document& featureTableJson,
+    rapidjson::Document& batchTableJson) {
+  featureTableJson.SetObject();
+  featureTableJson.AddMember(
+      "BATCH_LENGTH",
+      featureCount,
+      featureTableJson.GetAllocator());
+
+  batchTableJson.SetObject();
+  rapidjson::Document::AllocatorType& allocator =
+      batchTableJson.GetAllocator();
+  rapidjson::Value heights(rapidjson::kArrayType);
+  rapidjson::Value floors(rapidjson::kArrayType);
+  rapidjson::Value names(rapidjson::kArrayType);
+  rapidjson::Value flags(rapidjson::kArrayType);
+  rapidjson::Value mixed(rapidjson::kArrayType);
+  for (int64_t i = 0; i < featureCount; ++i) {
+    heights.PushBack(0.5 * static_cast<double>(i), allocator);
+    floors.PushBack(i % 100, allocator);
+
+    const std::string name = "Building " + std::to_string(i % 1000);
+    names.PushBack(
+        rapidjson::Value(
+            name.c_str(),
+            static_cast<rapidjson::SizeType>(name.size()),
+            allocator),
+        allocator);
+
+    flags.PushBack(i % 3 == 0, allocator);
+
+    if (i % 2 == 0) {
+      mixed.PushBack(i, allocator);
+    } else {
+      mixed.PushBack("value", allocator);
+    }
+  }
+
+  batchTableJson.AddMember("height", heights, allocator);
+  batchTableJson.AddMember("floors", floors, allocator);
+  batchTableJson.AddMember("name", names, allocator);
+  batchTableJson.AddMember("flag", flags, allocator);
+  batchTableJson.AddMember("mixed", mixed, allocator);
+}
+
+TEST_CASE("Converts large JSON batch tables") {
+  const int64_t featureCount = 20000;
+  rapidjson::Document featureTableJson;
+  rapidjson::Document batchTableJson;
+  createLargeBatchTable(featureCount, featureTableJson, batchTableJson);
+
+  Model model;
+  ErrorList errors = BatchTableToGltfStructuralMetadata::convertFromB3dm(
+      featureTableJson,
+      batchTableJson,
+      gsl::span<const std::byte>(),
+      model);
+  CHECK(errors.errors.empty());
+  CHECK(errors.warnings.empty());
+
+  const ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  REQUIRE(pMetadata);
+  REQUIRE(pMetadata->propertyTables.size() == 1);
+  REQUIRE(pMetadata->propertyTables[0].properties.size() == 5);
+
+  PropertyTableView view(model, pMetadata->propertyTables[0]);
+  REQUIRE(view.status() == PropertyTableViewStatus::Valid);
+
+  PropertyTablePropertyView<float> heights =
+      view.getPropertyView<float>("height");
+  PropertyTablePropertyView<int8_t> floors =
+      view.getPropertyView<int8_t>("floors");
+  PropertyTablePropertyView<std::string_view> names =
+      view.getPropertyView<std::string_view>("name");
+  PropertyTablePropertyView<bool> flags = view.getPropertyView<bool>("flag");
+  PropertyTablePropertyView<std::string_view> mixed =
+      view.getPropertyView<std::string_view>("mixed");
+  REQUIRE(heights.status() == PropertyTablePropertyViewStatus::Valid);
+  REQUIRE(floors.status() == PropertyTablePropertyViewStatus::Valid);
+  REQUIRE(names.status() == PropertyTablePropertyViewStatus::Valid);
+  REQUIRE(flags.status() == PropertyTablePropertyViewStatus::Valid);
+  REQUIRE(mixed.status() == PropertyTablePropertyViewStatus::Valid);
+
+  for (int64_t i = 0; i < featureCount; ++i) {
+    REQUIRE(heights.getRaw(i) == 0.5f * static_cast<float>(i));
+    REQUIRE(floors.getRaw(i) == static_cast<int8_t>(i % 100));
+    REQUIRE(names.getRaw(i) == "Building " + std::to_string(i % 1000));
+    REQUIRE(flags.getRaw(i) == (i % 3 == 0));
+    REQUIRE(mixed.getRaw(i) == (i % 2 == 0 ? std::to_string(i) : "value"));
+  }
+}
+
+TEST_CASE("Benchmark JSON batch table conversion", "[!benchmark]") {
+  const int64_t featureCount = 200000;
+  rapidjson::Document featureTableJson;
+  rapidjson::Document batchTableJson;
+  createLargeBatchTable(featureCount, featureTableJson, batchTableJson);
+
+  Model model;
+  const auto start = std::chrono::steady_clock::now();
+  BatchTableToGltfStructuralMetadata::convertFromB3dm(
+      featureTableJson,
+      batchTableJson,
+      gsl::span<const std::byte>(),
+      model);
+  const std::chrono::duration<double, std::milli> time =
+      std::chrono::steady_clock::now() - start;
+
+  REQUIRE(model.getExtension<ExtensionModelExtStructuralMetadata>());
+  WARN(
+      "Converting " << featureCount << " features with "
+                    << batchTableJson.MemberCount() << " properties took "
+                    << time.count() << "ms");
+}
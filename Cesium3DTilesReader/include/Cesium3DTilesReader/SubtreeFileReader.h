@@ -37,6 +37,21 @@ public:
    */
   const CesiumJsonReader::JsonReaderOptions& getOptions() const;
 
+  /**
+   * @brief Gets whether external buffers that no availability refers to, such
+   * as those that only hold metadata, are loaded.
+   *
+   * When this is false, only the external buffers that hold availability are
+   * requested, and the others are left empty. The default is true.
+   */
+  bool getLoadMetadataBuffers() const noexcept;
+
+  /**
+   * @brief Sets whether external buffers that no availability refers to are
+   * loaded. See {@link getLoadMetadataBuffers}.
+   */
+  void setLoadMetadataBuffers(bool value) noexcept;
+
   /**
    * @brief Asynchronously loads a subtree from a URL.
    *
@@ -102,6 +117,7 @@ private:
       const noexcept;
 
   SubtreeReader _reader;
+  bool _loadMetadataBuffers;
 };
 
 } // namespace Cesium3DTilesReader
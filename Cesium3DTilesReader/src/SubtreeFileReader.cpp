@@ -2,13 +2,18 @@
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumUtility/Uri.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 using namespace Cesium3DTiles;
 using namespace CesiumAsync;
 using namespace CesiumJsonReader;
 
 namespace Cesium3DTilesReader {
 
-SubtreeFileReader::SubtreeFileReader() : _reader() {}
+SubtreeFileReader::SubtreeFileReader()
+    : _reader(), _loadMetadataBuffers(true) {}
 
 CesiumJsonReader::JsonReaderOptions& SubtreeFileReader::getOptions() {
   return this->_reader.getOptions();
@@ -19,6 +24,14 @@ SubtreeFileReader::getOptions() const {
   return this->_reader.getOptions();
 }
 
+bool SubtreeFileReader::getLoadMetadataBuffers() const noexcept {
+  return this->_loadMetadataBuffers;
+}
+
+void SubtreeFileReader::setLoadMetadataBuffers(bool value) noexcept {
+  this->_loadMetadataBuffers = value;
+}
+
 Future<ReadJsonResult<Cesium3DTiles::Subtree>> SubtreeFileReader::load(
     const AsyncSystem& asyncSystem,
     const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
@@ -213,38 +226,69 @@ CesiumAsync::Future<ReadJsonResult<Subtree>> SubtreeFileReader::loadJson(
 namespace {
 
 struct RequestedSubtreeBuffer {
-  size_t index;
+  // The buffers that have the requested URL.
+  std::vector<size_t> indices;
   std::vector<std::byte> data;
 };
 
 CesiumAsync::Future<RequestedSubtreeBuffer> requestBuffer(
     const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
     const CesiumAsync::AsyncSystem& asyncSystem,
-    size_t bufferIdx,
-    std::string&& subtreeUrl,
+    std::vector<size_t>&& bufferIndices,
+    const std::string& bufferUrl,
     const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders) {
-  return pAssetAccessor->get(asyncSystem, subtreeUrl, requestHeaders)
+  return pAssetAccessor->get(asyncSystem, bufferUrl, requestHeaders)
       .thenInWorkerThread(
-          [bufferIdx](
-              std::shared_ptr<CesiumAsync::IAssetRequest>&& pCompletedRequest) {
+          [bufferIndices = std::move(bufferIndices)](
+              std::shared_ptr<CesiumAsync::IAssetRequest>&&
+                  pCompletedRequest) mutable {
             const CesiumAsync::IAssetResponse* pResponse =
                 pCompletedRequest->response();
             if (!pResponse) {
-              return RequestedSubtreeBuffer{bufferIdx, {}};
+              return RequestedSubtreeBuffer{std::move(bufferIndices), {}};
             }
 
             uint16_t statusCode = pResponse->statusCode();
             if (statusCode != 0 && (statusCode < 200 || statusCode >= 300)) {
-              return RequestedSubtreeBuffer{bufferIdx, {}};
+              return RequestedSubtreeBuffer{std::move(bufferIndices), {}};
             }
 
             const gsl::span<const std::byte>& data = pResponse->data();
             return RequestedSubtreeBuffer{
-                bufferIdx,
+                std::move(bufferIndices),
                 std::vector<std::byte>(data.begin(), data.end())};
           });
 }
 
+void markAvailabilityBuffer(
+    const Availability& availability,
+    const Subtree& subtree,
+    std::vector<bool>& isBufferNeeded) {
+  int64_t bufferViewIndex = -1;
+  if (availability.bitstream) {
+    bufferViewIndex = *availability.bitstream;
+  } else {
+    // Older subtrees use bufferView instead of bitstream.
+    auto bufferViewIt = availability.unknownProperties.find("bufferView");
+    if (bufferViewIt != availability.unknownProperties.end()) {
+      bufferViewIndex =
+          bufferViewIt->second.getSafeNumberOrDefault<int64_t>(-1);
+    }
+  }
+
+  if (bufferViewIndex < 0 ||
+      bufferViewIndex >= static_cast<int64_t>(subtree.bufferViews.size())) {
+    return;
+  }
+
+  const int64_t bufferIndex =
+      subtree.bufferViews[size_t(bufferViewIndex)].buffer;
+  if (bufferIndex >= 0 &&
+      bufferIndex < static_cast<int64_t>(isBufferNeeded.size())) {
+    isBufferNeeded[size_t(bufferIndex)] = true;
+  }
+}
+
 } // namespace
 
 Future<ReadJsonResult<Subtree>> SubtreeFileReader::postprocess(
@@ -257,41 +301,81 @@ Future<ReadJsonResult<Subtree>> SubtreeFileReader::postprocess(
     return asyncSystem.createResolvedFuture(std::move(loaded));
   }
 
-  // Load any external buffers
-  std::vector<Future<RequestedSubtreeBuffer>> bufferRequests;
-  const std::vector<Buffer>& buffers = loaded.value->buffers;
-  for (size_t i = 0; i < buffers.size(); ++i) {
-    const Buffer& buffer = buffers[i];
-    if (buffer.uri && !buffer.uri->empty()) {
-      std::string bufferUrl = CesiumUtility::Uri::resolve(url, *buffer.uri);
+  const Subtree& subtree = *loaded.value;
+  std::vector<bool> isBufferNeeded(
+      subtree.buffers.size(),
+      this->_loadMetadataBuffers);
+  if (!this->_loadMetadataBuffers) {
+    markAvailabilityBuffer(subtree.tileAvailability, subtree, isBufferNeeded);
+    markAvailabilityBuffer(
+        subtree.childSubtreeAvailability,
+        subtree,
+        isBufferNeeded);
+    for (const Availability& availability : subtree.contentAvailability) {
+      markAvailabilityBuffer(availability, subtree, isBufferNeeded);
+    }
+  }
+
+  // Find the distinct URLs of the external buffers, so that each is requested
+  // once.
+  std::vector<std::string> bufferUrls;
+  std::vector<std::vector<size_t>> bufferIndices;
+  for (size_t i = 0; i < subtree.buffers.size(); ++i) {
+    const Buffer& buffer = subtree.buffers[i];
+    if (!isBufferNeeded[i] || !buffer.uri || buffer.uri->empty()) {
+      continue;
+    }
+
+    std::string bufferUrl = CesiumUtility::Uri::resolve(url, *buffer.uri);
+    auto it = std::find(bufferUrls.begin(), bufferUrls.end(), bufferUrl);
+    if (it == bufferUrls.end()) {
+      bufferUrls.emplace_back(std::move(bufferUrl));
+      bufferIndices.emplace_back().emplace_back(i);
+    } else {
+      bufferIndices[size_t(it - bufferUrls.begin())].emplace_back(i);
+    }
+  }
+
+  if (!bufferUrls.empty()) {
+    // Start all of the requests before waiting for any of them.
+    std::vector<Future<RequestedSubtreeBuffer>> bufferRequests;
+    bufferRequests.reserve(bufferUrls.size());
+    for (size_t i = 0; i < bufferUrls.size(); ++i) {
       bufferRequests.emplace_back(requestBuffer(
           pAssetAccessor,
           asyncSystem,
-          i,
-          std::move(bufferUrl),
+          std::move(bufferIndices[i]),
+          bufferUrls[i],
           requestHeaders));
     }
-  }
 
-  if (!bufferRequests.empty()) {
     return asyncSystem.all(std::move(bufferRequests))
-        .thenInMainThread(
+        .thenInWorkerThread(
             [loaded = std::move(loaded)](std::vector<RequestedSubtreeBuffer>&&
                                              completedBuffers) mutable {
               for (RequestedSubtreeBuffer& completedBuffer : completedBuffers) {
-                Buffer& buffer = loaded.value->buffers[completedBuffer.index];
-                if (buffer.byteLength >
-                    static_cast<int64_t>(completedBuffer.data.size())) {
-                  loaded.warnings.emplace_back(fmt::format(
-                      "Buffer byteLength ({}) is greater than the size of the "
-                      "downloaded resource ({} bytes). The byteLength will be "
-                      "updated to match.",
-                      buffer.byteLength,
-                      completedBuffer.data.size()));
-                  buffer.byteLength =
-                      static_cast<int64_t>(completedBuffer.data.size());
+                for (size_t j = 0; j < completedBuffer.indices.size(); ++j) {
+                  Buffer& buffer =
+                      loaded.value->buffers[completedBuffer.indices[j]];
+                  if (buffer.byteLength >
+                      static_cast<int64_t>(completedBuffer.data.size())) {
+                    loaded.warnings.emplace_back(fmt::format(
+                        "Buffer byteLength ({}) is greater than the size of "
+                        "the downloaded resource ({} bytes). The byteLength "
+                        "will be updated to match.",
+                        buffer.byteLength,
+                        completedBuffer.data.size()));
+                    buffer.byteLength =
+                        static_cast<int64_t>(completedBuffer.data.size());
+                  }
+
+                  // Only the last buffer with the URL can take the data.
+                  if (j + 1 < completedBuffer.indices.size()) {
+                    buffer.cesium.data = completedBuffer.data;
+                  } else {
+                    buffer.cesium.data = std::move(completedBuffer.data);
+                  }
                 }
-                buffer.cesium.data = std::move(completedBuffer.data);
               }
 
               return std::move(loaded);
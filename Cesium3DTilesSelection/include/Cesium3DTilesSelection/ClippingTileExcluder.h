@@ -0,0 +1,112 @@
+#pragma once
+
+#include "ITileExcluder.h"
+#include "Library.h"
+
+#include <CesiumGeometry/Plane.h>
+#include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+
+#include <optional>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief When provided to {@link TilesetOptions::excluders}, skips the tiles
+ * that are entirely clipped away by a set of clipping planes and clipping
+ * polygons, so that they are neither loaded nor visited.
+ *
+ * Renderers clip the tiles that are partly clipped away, for example in a
+ * shader. A point is clipped away if it is behind any of the planes, that is,
+ * on the side opposite to its normal, or if it is inside any of the polygons.
+ * With inverted polygons, a point is clipped away if it is outside all of them
+ * instead.
+ *
+ * The planes are in the same coordinates as the bounding volumes of the
+ * tiles, usually Earth-centered, Earth-fixed. The polygons are tested against
+ * the globe rectangles of the tiles, see {@link estimateGlobeRectangle}.
+ *
+ * The planes and polygons can't be changed once the excluder is constructed,
+ * so it may be tested from any thread. To clip differently, replace it in
+ * {@link TilesetOptions::excluders}.
+ */
+class CESIUM3DTILESSELECTION_API ClippingTileExcluder : public ITileExcluder {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param planes The clipping planes.
+   * @param polygons The clipping polygons.
+   * @param invertPolygons Whether the outside of the polygons is clipped away,
+   * rather than their inside.
+   */
+  ClippingTileExcluder(
+      std::vector<CesiumGeometry::Plane> planes,
+      std::vector<CesiumGeospatial::CartographicPolygon> polygons = {},
+      bool invertPolygons = false);
+
+  /**
+   * @brief Determines whether a tile is entirely clipped away.
+   *
+   * @param tile The tile to check.
+   * @return true if the tile should be excluded because it is entirely clipped
+   * away.
+   */
+  virtual bool shouldExclude(const Tile& tile) const noexcept override;
+
+  /**
+   * @brief Determines whether a tile is entirely clipped away and therefore
+   * should be excluded, or entirely kept so that its descendants are included
+   * without testing them.
+   *
+   * @param tile The tile to check.
+   * @return How the tile and its descendants are excluded.
+   */
+  virtual TileExclusion evaluateTile(const Tile& tile) const noexcept override;
+
+  /**
+   * @brief Determines whether a tile that is not excluded may still be partly
+   * clipped away, so that its renderer needs to clip it.
+   *
+   * This is conservative: a tile whose bounding volume crosses a plane or the
+   * edge of a polygon is reported as partly clipped, even if its content is
+   * not.
+   *
+   * @param tile The tile to check.
+   * @return true if the tile is partly clipped away.
+   */
+  bool isPartiallyClipped(const Tile& tile) const noexcept;
+
+  /**
+   * @brief Gets the clipping planes.
+   */
+  const std::vector<CesiumGeometry::Plane>& getPlanes() const noexcept {
+    return this->_planes;
+  }
+
+  /**
+   * @brief Gets the clipping polygons.
+   */
+  const std::vector<CesiumGeospatial::CartographicPolygon>&
+  getPolygons() const noexcept {
+    return this->_polygons;
+  }
+
+  /**
+   * @brief Gets whether the outside of the polygons is clipped away, rather
+   * than their inside.
+   */
+  bool getInvertPolygons() const noexcept { return this->_invertPolygons; }
+
+private:
+  std::vector<CesiumGeometry::Plane> _planes;
+  std::vector<CesiumGeospatial::CartographicPolygon> _polygons;
+  bool _invertPolygons;
+
+  // The union of the bounding rectangles of the polygons, so that tiles far
+  // from all of them are decided without testing each polygon.
+  std::optional<CesiumGeospatial::GlobeRectangle> _polygonsRectangle;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -11,6 +11,8 @@
 #include <gsl/span>
 
 #include <any>
+#include <cstddef>
+#include <cstdint>
 
 namespace CesiumAsync {
 class AsyncSystem;
@@ -38,6 +40,46 @@ struct TileLoadResultAndRenderResources {
   void* pRenderResources{nullptr};
 };
 
+/**
+ * @brief A raster overlay tile to attach to a geometry tile, see
+ * {@link IPrepareRendererResources::attachRasterInMainThreadBatch}.
+ *
+ * The fields are the parameters of
+ * {@link IPrepareRendererResources::attachRasterInMainThread}.
+ */
+struct RasterAttachment {
+  /**
+   * @brief The geometry tile.
+   */
+  const Tile* pTile{nullptr};
+
+  /**
+   * @brief The ID of the overlay texture coordinate set to use.
+   */
+  int32_t overlayTextureCoordinateID{0};
+
+  /**
+   * @brief The raster overlay tile to add.
+   */
+  const CesiumRasterOverlays::RasterOverlayTile* pRasterTile{nullptr};
+
+  /**
+   * @brief The renderer resources for the raster tile, as created and
+   * returned by `prepareRasterInMainThread`.
+   */
+  void* pMainThreadRendererResources{nullptr};
+
+  /**
+   * @brief The translation to apply to the texture coordinates.
+   */
+  glm::dvec2 translation{0.0, 0.0};
+
+  /**
+   * @brief The scale to apply to the texture coordinates.
+   */
+  glm::dvec2 scale{1.0, 1.0};
+};
+
 /**
  * @brief When implemented for a rendering engine, allows renderer resources to
  * be created and destroyed under the control of a {@link Tileset}.
@@ -59,6 +101,12 @@ public:
    * @brief Prepares renderer resources for the given tile. This method is
    * invoked in the load thread.
    *
+   * This is also called for a tile that is already loaded when texture
+   * coordinates are added to its content for a raster overlay that was added
+   * after the tile was loaded. The tile keeps its current renderer resources
+   * until those from this call are prepared by {@link prepareInMainThread},
+   * and then they are passed to {@link free}.
+   *
    * @param asyncSystem The AsyncSystem used to do work in threads.
    * @param tileLoadResult The tile data loaded so far.
    * @param transform The tile's transformation.
@@ -95,6 +143,31 @@ public:
    */
   virtual void* prepareInMainThread(Tile& tile, void* pLoadThreadResult) = 0;
 
+  /**
+   * @brief Further prepares the renderer resources of several tiles at once.
+   *
+   * This is called instead of {@link prepareInMainThread} if
+   * {@link TilesetOptions::mainThreadPreparationBatchSize} is greater than
+   * zero, with the tiles whose main-thread preparation is due in this frame,
+   * so that a renderer can batch its uploads and scene changes. The default
+   * implementation calls {@link prepareInMainThread} for each tile.
+   *
+   * @param tiles The tiles to prepare.
+   * @param loadThreadResults The value returned from
+   * {@link prepareInLoadThread} for each tile.
+   * @param mainThreadResults Receives the value that
+   * {@link prepareInMainThread} would return for each tile.
+   */
+  virtual void prepareInMainThreadBatch(
+      gsl::span<Tile* const> tiles,
+      gsl::span<void* const> loadThreadResults,
+      gsl::span<void*> mainThreadResults) {
+    for (size_t i = 0; i < tiles.size(); ++i) {
+      mainThreadResults[i] =
+          this->prepareInMainThread(*tiles[i], loadThreadResults[i]);
+    }
+  }
+
   /**
    * @brief Frees previously-prepared renderer resources.
    *
@@ -114,6 +187,32 @@ public:
       void* pLoadThreadResult,
       void* pMainThreadResult) noexcept = 0;
 
+  /**
+   * @brief Gets the number of bytes used by the renderer resources of a tile,
+   * such as its vertex buffers and textures in GPU memory.
+   *
+   * This is called from the thread that called {@link Tileset::updateView},
+   * right after {@link prepareInMainThread}. The size counts toward
+   * {@link Tileset::getTotalDataBytes}, and so toward
+   * {@link TilesetOptions::maximumCachedBytes}, until the tile is unloaded.
+   * It should not include the glTF data that is counted already, unless the
+   * renderer also changes the sizes of the glTF images. The default
+   * implementation returns 0.
+   *
+   * The renderer can report the size of a raster overlay tile by setting
+   * `CesiumGltf::ImageCesium::sizeBytes` in {@link prepareRasterInLoadThread}.
+   *
+   * @param tile The tile the resources were prepared for.
+   * @param pMainThreadResult The result returned by
+   * {@link prepareInMainThread}.
+   * @returns The size of the renderer resources in bytes.
+   */
+  virtual int64_t getRenderResourcesByteSize(
+      [[maybe_unused]] const Tile& tile,
+      [[maybe_unused]] void* pMainThreadResult) const noexcept {
+    return 0;
+  }
+
   /**
    * @brief Attaches a raster overlay tile to a geometry tile.
    *
@@ -142,6 +241,33 @@ public:
       const glm::dvec2& translation,
       const glm::dvec2& scale) = 0;
 
+  /**
+   * @brief Attaches several raster overlay tiles to their geometry tiles at
+   * once.
+   *
+   * This is called instead of {@link attachRasterInMainThread} if
+   * {@link TilesetOptions::mainThreadPreparationBatchSize} is greater than
+   * zero, with the raster overlay tiles that became ready during a
+   * {@link Tileset::updateView}. It is called before that update returns,
+   * and before any of these raster tiles is detached again. The default
+   * implementation calls {@link attachRasterInMainThread} for each
+   * attachment.
+   *
+   * @param attachments The raster overlay tiles to attach.
+   */
+  virtual void
+  attachRasterInMainThreadBatch(gsl::span<const RasterAttachment> attachments) {
+    for (const RasterAttachment& attachment : attachments) {
+      this->attachRasterInMainThread(
+          *attachment.pTile,
+          attachment.overlayTextureCoordinateID,
+          *attachment.pRasterTile,
+          attachment.pMainThreadRendererResources,
+          attachment.translation,
+          attachment.scale);
+    }
+  }
+
   /**
    * @brief Detaches a raster overlay tile from a geometry tile.
    *
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+class Tile;
+
+/**
+ * @brief An interface that decides which cached tiles are unloaded first when
+ * provided in {@link TilesetOptions::evictionPolicy}.
+ *
+ * A tileset unloads cached tiles when the total size of its loaded data is
+ * greater than {@link TilesetOptions::maximumCachedBytes}, and when
+ * {@link Tileset::evictForMemoryPressure} is called.
+ */
+class ITileEvictionPolicy {
+public:
+  virtual ~ITileEvictionPolicy() = default;
+
+  /**
+   * @brief Orders the tiles that may be unloaded.
+   *
+   * The tiles are unloaded in the order they have in `candidates` after this
+   * call, until the tileset's data fits within its limit. A tile that is
+   * removed from `candidates` is kept.
+   *
+   * @param candidates The tiles that may be unloaded, from least to most
+   * recently used. This never includes tiles that were rendered in the last
+   * frame or that are fading out.
+   * @param renderedTiles The tiles rendered in the last frame.
+   */
+  virtual void orderEvictionCandidates(
+      std::vector<Tile*>& candidates,
+      const std::vector<Tile*>& renderedTiles) = 0;
+};
+
+} // namespace Cesium3DTilesSelection
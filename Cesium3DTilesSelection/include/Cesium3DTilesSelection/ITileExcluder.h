@@ -4,6 +4,28 @@ namespace Cesium3DTilesSelection {
 
 class Tile;
 
+/**
+ * @brief The outcome of testing a tile with an {@link ITileExcluder}.
+ */
+enum class TileExclusion {
+  /**
+   * @brief The tile and all of its descendants are excluded.
+   */
+  Excluded,
+
+  /**
+   * @brief The tile is included, but its descendants must be tested on their
+   * own.
+   */
+  Included,
+
+  /**
+   * @brief The tile and all of its descendants are included, so the excluder
+   * doesn't need to be asked about the descendants again this frame.
+   */
+  IncludedWithDescendants
+};
+
 /**
  * @brief An interface that allows tiles to be excluded from loading and
  * rendering when provided in {@link TilesetOptions::excluders}.
@@ -26,6 +48,29 @@ public:
    * @return false if this tile should be included.
    */
   virtual bool shouldExclude(const Tile& tile) const noexcept = 0;
+
+  /**
+   * @brief Determines whether a given tile should be excluded, and whether the
+   * same holds for all of its descendants.
+   *
+   * The {@link Tileset} calls this instead of {@link shouldExclude}. When it
+   * returns {@link TileExclusion::IncludedWithDescendants}, the excluder is not
+   * called again for the descendants of the tile until the next frame, so it
+   * may only be returned when every descendant would be included, too. The
+   * bounding volume of a tile encloses those of its descendants, so this holds
+   * for a tile whose bounding volume is entirely clear of what is excluded.
+   *
+   * The default implementation only reports whether the tile itself is
+   * included, with {@link shouldExclude}.
+   *
+   * @param tile The tile to test.
+   * @return Whether the tile, and maybe all of its descendants, is excluded or
+   * included.
+   */
+  virtual TileExclusion evaluateTile(const Tile& tile) const noexcept {
+    return this->shouldExclude(tile) ? TileExclusion::Excluded
+                                     : TileExclusion::Included;
+  }
 };
 
 } // namespace Cesium3DTilesSelection
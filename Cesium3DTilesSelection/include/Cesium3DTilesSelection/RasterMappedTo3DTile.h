@@ -8,6 +8,7 @@
 #include <CesiumUtility/IntrusivePointer.h>
 
 #include <memory>
+#include <vector>
 
 namespace Cesium3DTilesSelection {
 
@@ -51,11 +52,17 @@ public:
    * geometry.
    * @param textureCoordinateIndex The index of the texture coordinates to use
    * with this mapped raster overlay.
+   * @param pTargetRasterTile A more detailed {@link RasterOverlayTile} to load
+   * and map once `pRasterTile` is loaded, or `nullptr`. If it is given,
+   * `pRasterTile` is only attached temporarily, like the tile of an ancestor.
+   * See {@link CesiumRasterOverlays::RasterOverlayOptions::loadProgressively}.
    */
   RasterMappedTo3DTile(
-      const CesiumUtility::IntrusivePointer<
-          CesiumRasterOverlays::RasterOverlayTile>& pRasterTile,
-      int32_t textureCoordinateIndex);
+      CesiumUtility::IntrusivePointer<CesiumRasterOverlays::RasterOverlayTile>
+          pRasterTile,
+      int32_t textureCoordinateIndex,
+      CesiumUtility::IntrusivePointer<CesiumRasterOverlays::RasterOverlayTile>
+          pTargetRasterTile = nullptr);
 
   /**
    * @brief Returns a {@link RasterOverlayTile} that is currently loading.
@@ -160,10 +167,18 @@ public:
    * @param prepareRendererResources The IPrepareRendererResources used to
    * create render resources for raster overlay
    * @param tile The owner tile.
+   * @param pPendingAttachments If not `nullptr`, the raster tile is attached
+   * by adding it to this list, to be passed to
+   * {@link IPrepareRendererResources::attachRasterInMainThreadBatch} later,
+   * instead of with
+   * {@link IPrepareRendererResources::attachRasterInMainThread}. A raster tile
+   * that is detached while it is still in the list is removed from it.
    * @return The {@link MoreDetailAvailable} state.
    */
-  CesiumRasterOverlays::RasterOverlayTile::MoreDetailAvailable
-  update(IPrepareRendererResources& prepareRendererResources, Tile& tile);
+  CesiumRasterOverlays::RasterOverlayTile::MoreDetailAvailable update(
+      IPrepareRendererResources& prepareRendererResources,
+      Tile& tile,
+      std::vector<RasterAttachment>* pPendingAttachments = nullptr);
 
   bool isMoreDetailAvailable() const noexcept;
 
@@ -232,11 +247,17 @@ private:
       _pLoadingTile;
   CesiumUtility::IntrusivePointer<CesiumRasterOverlays::RasterOverlayTile>
       _pReadyTile;
+  // The tile to load after the loading tile, when loading progressively.
+  CesiumUtility::IntrusivePointer<CesiumRasterOverlays::RasterOverlayTile>
+      _pTargetTile;
   int32_t _textureCoordinateID;
   glm::dvec2 _translation;
   glm::dvec2 _scale;
   AttachmentState _state;
   bool _originalFailed;
+  // Whether the ready tile was loaded for this mapping, rather than borrowed
+  // from an ancestor.
+  bool _readyTileIsOwn;
 };
 
 } // namespace Cesium3DTilesSelection
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Library.h"
+#include "RasterOverlayTileProviderPool.h"
 #include "TilesetExternals.h"
 
 #include <CesiumRasterOverlays/RasterOverlay.h>
@@ -26,6 +27,10 @@ namespace Cesium3DTilesSelection {
  * for each raster overlay that had been added. The raster overlay tile provider
  * instances will be passed to the {@link RasterOverlayTile} instances that
  * they create when the tiles are updated.
+ *
+ * If the externals have a
+ * {@link TilesetExternals::pRasterOverlayTileProviderPool}, an overlay that is
+ * also in another collection of the pool shares its tile provider with it.
  */
 class CESIUM3DTILESSELECTION_API RasterOverlayCollection final {
 public:
@@ -206,6 +211,7 @@ private:
 
   Tile::LoadedLinkedList* _pLoadedTiles;
   TilesetExternals _externals;
+  std::shared_ptr<RasterOverlayTileProviderPool> _pTileProviderPool;
   CesiumUtility::IntrusivePointer<OverlayList> _pOverlays;
   CESIUM_TRACE_DECLARE_TRACK_SET(_loadingSlots, "Raster Overlay Loading Slot");
 };
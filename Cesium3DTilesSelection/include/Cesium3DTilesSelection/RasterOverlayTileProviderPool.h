@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Library.h"
+#include "TilesetExternals.h"
+
+#include <CesiumAsync/SharedFuture.h>
+#include <CesiumRasterOverlays/RasterOverlay.h>
+#include <CesiumUtility/IntrusivePointer.h>
+
+#include <cstddef>
+#include <unordered_map>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The {@link CesiumRasterOverlays::RasterOverlayTileProvider} instances
+ * of the raster overlays that are used by one or more
+ * {@link RasterOverlayCollection} instances.
+ *
+ * When the same {@link CesiumRasterOverlays::RasterOverlay} is added to the
+ * collections of several tilesets that share a pool, through
+ * {@link TilesetExternals::pRasterOverlayTileProviderPool}, only one tile
+ * provider is created for it. The tilesets then share its cache of images,
+ * its throttling of loads, and its credits, so that the same images aren't
+ * downloaded and decoded once for each tileset.
+ *
+ * A tile provider is created with the externals of the collection that first
+ * uses its overlay, so the tilesets that share a pool must use the same asset
+ * accessor, async system, renderer resources, and credit system.
+ *
+ * The pool must only be used from the main thread.
+ */
+class CESIUM3DTILESSELECTION_API RasterOverlayTileProviderPool final {
+public:
+  /**
+   * @brief Gets the tile provider of an overlay, creating it if it isn't in
+   * the pool yet.
+   *
+   * Each call must be matched by a call to {@link releaseTileProvider}. The
+   * tile provider remains in the pool until then.
+   *
+   * @param pOverlay The overlay. This may not be `nullptr`.
+   * @param externals The externals with which to create the tile provider.
+   * @return A future that resolves to the tile provider, or to the details of
+   * the failure to create it.
+   */
+  CesiumAsync::SharedFuture<
+      CesiumRasterOverlays::RasterOverlay::CreateTileProviderResult>
+  getTileProvider(
+      const CesiumUtility::IntrusivePointer<
+          CesiumRasterOverlays::RasterOverlay>& pOverlay,
+      const TilesetExternals& externals);
+
+  /**
+   * @brief Releases a tile provider obtained from {@link getTileProvider}.
+   *
+   * When the tile provider of an overlay has been released as many times as
+   * it was obtained, it is removed from the pool.
+   *
+   * @param overlay The overlay.
+   */
+  void releaseTileProvider(
+      const CesiumRasterOverlays::RasterOverlay& overlay) noexcept;
+
+  /**
+   * @brief Gets the number of overlays whose tile providers are in the pool.
+   */
+  size_t size() const noexcept { return this->_entries.size(); }
+
+private:
+  struct Entry {
+    CesiumUtility::IntrusivePointer<CesiumRasterOverlays::RasterOverlay>
+        pOverlay;
+    CesiumAsync::SharedFuture<
+        CesiumRasterOverlays::RasterOverlay::CreateTileProviderResult>
+        tileProvider;
+    size_t users;
+  };
+
+  std::unordered_map<const CesiumRasterOverlays::RasterOverlay*, Entry>
+      _entries;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -3,8 +3,11 @@
 #include "ITileExcluder.h"
 #include "Library.h"
 
+#include <CesiumGeospatial/GlobeRectangle.h>
 #include <CesiumUtility/IntrusivePointer.h>
 
+#include <optional>
+
 namespace CesiumRasterOverlays {
 class RasterizedPolygonsOverlay;
 }
@@ -40,6 +43,19 @@ public:
    */
   virtual bool shouldExclude(const Tile& tile) const noexcept override;
 
+  /**
+   * @brief Determines whether a given tile is entirely inside a polygon and
+   * therefore should be excluded, or entirely outside all of them so that its
+   * descendants are included without testing them.
+   *
+   * With an inverted selection, the roles of the inside and the outside of the
+   * polygons are swapped.
+   *
+   * @param tile The tile to check.
+   * @return How the tile and its descendants are excluded.
+   */
+  virtual TileExclusion evaluateTile(const Tile& tile) const noexcept override;
+
   /**
    * @brief Gets the overlay defining the polygons.
    */
@@ -49,6 +65,10 @@ private:
   CesiumUtility::IntrusivePointer<
       const CesiumRasterOverlays::RasterizedPolygonsOverlay>
       _pOverlay;
+
+  // The union of the bounding rectangles of the polygons, so that tiles far
+  // from all of them are decided without testing each polygon.
+  std::optional<CesiumGeospatial::GlobeRectangle> _polygonsRectangle;
 };
 
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <CesiumGeospatial/Cartographic.h>
+
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The result of sampling the heights of a tileset with
+ * {@link Tileset::sampleHeightMostDetailed}.
+ */
+struct SampleHeightResult {
+  /**
+   * @brief The positions with their heights replaced by the sampled heights.
+   *
+   * The positions are in the same order as the positions that were sampled.
+   * The height of a position that could not be sampled is left unchanged.
+   */
+  std::vector<CesiumGeospatial::Cartographic> positions;
+
+  /**
+   * @brief Whether the height of the position at the same index in
+   * {@link positions} was sampled.
+   *
+   * A height is not sampled when a vertical line through the position
+   * doesn't intersect the tileset.
+   */
+  std::vector<bool> sampleSuccess;
+
+  /**
+   * @brief Warnings that came up while the heights were sampled, such as tiles
+   * that failed to load.
+   */
+  std::vector<std::string> warnings;
+};
+
+} // namespace Cesium3DTilesSelection
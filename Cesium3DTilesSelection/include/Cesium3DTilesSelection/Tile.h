@@ -8,6 +8,7 @@
 #include "TileRefine.h"
 #include "TileSelectionState.h"
 
+#include <CesiumGeospatial/EllipsoidalOccluder.h>
 #include <CesiumUtility/DoublyLinkedList.h>
 
 #include <glm/common.hpp>
@@ -15,6 +16,7 @@
 #include <gsl/span>
 
 #include <atomic>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -221,6 +223,9 @@ public:
    */
   void setBoundingVolume(const BoundingVolume& value) noexcept {
     this->_boundingVolume = value;
+    this->_cullingVolume.isValid = false;
+    this->_horizonCullingPoint.isValid = false;
+    this->invalidateCachedViewEvaluation();
   }
 
   /**
@@ -270,6 +275,7 @@ public:
    */
   void setGeometricError(double value) noexcept {
     this->_geometricError = value;
+    this->invalidateCachedViewEvaluation();
   }
 
   /**
@@ -309,6 +315,7 @@ public:
    */
   void setUnconditionallyRefine() noexcept {
     this->_geometricError = std::numeric_limits<double>::infinity();
+    this->invalidateCachedViewEvaluation();
   }
 
   /**
@@ -331,7 +338,10 @@ public:
    *
    * @param value The refinement strategy.
    */
-  void setRefine(TileRefine value) noexcept { this->_refine = value; }
+  void setRefine(TileRefine value) noexcept {
+    this->_refine = value;
+    this->invalidateCachedViewEvaluation();
+  }
 
   /**
    * @brief Gets the transformation matrix for this tile.
@@ -430,7 +440,8 @@ public:
 
   /**
    * @brief Determines the number of bytes in this tile's geometry and texture
-   * data.
+   * data, including its renderer resources once they have been prepared in
+   * the main thread.
    */
   int64_t computeByteSize() const noexcept;
 
@@ -507,6 +518,43 @@ private:
   void
   setContentShouldContinueUpdating(bool shouldContentContinueUpdating) noexcept;
 
+  /**
+   * @brief Discards the cached view evaluation of this tile and of its parent,
+   * whose culling may depend on this tile's bounding volume.
+   */
+  void invalidateCachedViewEvaluation() noexcept;
+
+  /**
+   * @brief Builds the compact copies of the children's culling volumes if
+   * they're missing or out of date.
+   */
+  void updateChildCullingVolumes();
+
+  struct CachedCullingVolume;
+
+  /**
+   * @brief Gets the box and sphere that stand in for this tile's bounding
+   * volume when culling it, computing them if they're missing or out of date.
+   */
+  const CachedCullingVolume& updateCullingVolume();
+
+  /**
+   * @brief Gets the point that stands in for this tile's bounding volume when
+   * culling it against the horizon, computing it if it's missing or out of
+   * date.
+   *
+   * @returns The point, or `std::nullopt` if the bounding volume can't be
+   * culled against the horizon.
+   */
+  const std::optional<CesiumGeospatial::HorizonCullingPoint>&
+  updateHorizonCullingPoint();
+
+  /**
+   * @brief Removes the children of this tile and returns them. The children
+   * are created again by the loader the next time this tile is updated.
+   */
+  std::vector<Tile> takeChildTiles() noexcept;
+
   // Position in bounding-volume hierarchy.
   Tile* _pParent;
   std::vector<Tile> _children;
@@ -534,7 +582,68 @@ private:
   // mapped raster overlay
   std::vector<RasterMappedTo3DTile> _rasterTiles;
 
+  // View-dependent values computed by the Tileset the last time this tile was
+  // visited. They are reused for as long as the views stay within the
+  // tolerance of the view epoch they were computed in, see
+  // TilesetOptions::enableViewEvaluationCaching. An epoch of 0 is never valid.
+  struct CachedViewEvaluation {
+    uint64_t viewEpoch = 0;
+    double tilePriority = 0.0;
+    double largestSse = 0.0;
+    // Negative until computed, which is only done when it's needed.
+    double screenCoverage = -1.0;
+    bool visibleFromCamera = false;
+    bool visibleInFog = false;
+    bool visibleAboveHorizon = false;
+  };
+  CachedViewEvaluation _cachedViewEvaluation;
+
+  // A box and an enclosing sphere that stand in for the bounding volume when
+  // culling it, so that the traversal doesn't dispatch on the kind of the
+  // volume or derive a box from it every time the tile is visited. Computed on
+  // demand by updateCullingVolume and discarded whenever the bounding volume
+  // changes.
+  struct CachedCullingVolume {
+    bool isValid = false;
+    CesiumGeometry::OrientedBoundingBox box{glm::dvec3(0.0), glm::dmat3(1.0)};
+    CesiumGeometry::BoundingSphere sphere{glm::dvec3(0.0), 0.0};
+  };
+  CachedCullingVolume _cullingVolume;
+
+  // Compact, contiguous copies of the children's culling volumes, so that
+  // culling this tile with its children's bounds streams through memory
+  // instead of striding across whole Tile objects. Built on demand by
+  // updateChildCullingVolumes and discarded whenever a child's bounds change.
+  struct ChildCullingVolumes {
+    bool isValid = false;
+    bool anyUnconditionallyRefine = false;
+    std::vector<CesiumGeometry::OrientedBoundingBox> boxes;
+    std::vector<CesiumGeometry::BoundingSphere> spheres;
+  };
+  ChildCullingVolumes _childCullingVolumes;
+
+  // The point that stands in for the bounding volume when culling it against
+  // the horizon of the ellipsoid. Computed on demand by
+  // updateHorizonCullingPoint and discarded whenever the bounding volume
+  // changes.
+  struct CachedHorizonCullingPoint {
+    bool isValid = false;
+    std::optional<CesiumGeospatial::HorizonCullingPoint> point;
+  };
+  CachedHorizonCullingPoint _horizonCullingPoint;
+
+  // The excluders that the Tileset, in the excluder epoch it was visited in,
+  // found to include this tile and all of its descendants. The bit of an
+  // excluder is its index in TilesetOptions::excluders, so that the children
+  // of this tile skip those excluders. An epoch of 0 is never valid.
+  struct CachedExclusion {
+    uint64_t excluderEpoch = 0;
+    uint64_t includedExcluders = 0;
+  };
+  CachedExclusion _cachedExclusion;
+
   friend class TilesetContentManager;
+  friend class Tileset;
   friend class MockTilesetContentManagerTestFixture;
 
 public:
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Library.h"
+#include "TileTriangleIndex.h"
 #include "TilesetMetadata.h"
 
 #include <CesiumGeospatial/Projection.h>
@@ -8,6 +9,7 @@
 #include <CesiumRasterOverlays/RasterOverlayDetails.h>
 #include <CesiumUtility/CreditSystem.h>
 
+#include <cstdint>
 #include <memory>
 #include <variant>
 #include <vector>
@@ -97,6 +99,23 @@ public:
    */
   void setModel(CesiumGltf::Model&& model);
 
+  /**
+   * @brief Get the {@link TileTriangleIndex} of the glTF model, which is
+   * used to find where rays hit the content.
+   *
+   * @return The index, or nullptr if it hasn't been built yet.
+   */
+  const TileTriangleIndex* getTriangleIndex() const noexcept;
+
+  /**
+   * @brief Set the {@link TileTriangleIndex} of the glTF model. Setting the
+   * model clears the index.
+   *
+   * @param pTriangleIndex The index of the glTF model of the content
+   */
+  void setTriangleIndex(
+      std::shared_ptr<const TileTriangleIndex> pTriangleIndex) noexcept;
+
   /**
    * @brief Get the {@link RasterOverlayDetails} which is the result of generating raster overlay UVs for the glTF model
    *
@@ -172,6 +191,22 @@ public:
    */
   void setRenderResources(void* pRenderResources) noexcept;
 
+  /**
+   * @brief Get the number of bytes used by the render resources, as reported
+   * by {@link IPrepareRendererResources::getRenderResourcesByteSize}.
+   *
+   * @return The size of the render resources in bytes
+   */
+  int64_t getRenderResourcesByteSize() const noexcept;
+
+  /**
+   * @brief Set the number of bytes used by the render resources. Not to be
+   * used by clients.
+   *
+   * @param bytes The size of the render resources in bytes
+   */
+  void setRenderResourcesByteSize(int64_t bytes) noexcept;
+
   /**
    * @brief Get the fade percentage that this tile during an LOD transition.
    *
@@ -194,7 +229,9 @@ public:
 
 private:
   CesiumGltf::Model _model;
+  std::shared_ptr<const TileTriangleIndex> _pTriangleIndex;
   void* _pRenderResources;
+  int64_t _renderResourcesByteSize;
   CesiumRasterOverlays::RasterOverlayDetails _rasterOverlayDetails;
   std::vector<CesiumUtility::Credit> _credits;
   float _lodTransitionFadePercentage;
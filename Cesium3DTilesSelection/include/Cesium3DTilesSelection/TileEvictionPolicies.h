@@ -0,0 +1,94 @@
+#pragma once
+
+#include "ITileEvictionPolicy.h"
+#include "Library.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief Unloads the least recently used tiles first. This is what a tileset
+ * does when {@link TilesetOptions::evictionPolicy} is not set.
+ */
+class CESIUM3DTILESSELECTION_API LruTileEvictionPolicy
+    : public ITileEvictionPolicy {
+public:
+  /**
+   * @brief Keeps the candidates in least-recently-used order.
+   */
+  virtual void orderEvictionCandidates(
+      std::vector<Tile*>& candidates,
+      const std::vector<Tile*>& renderedTiles) override;
+};
+
+/**
+ * @brief Unloads first the tiles that free the most memory for the least cost
+ * of loading them again.
+ *
+ * Each candidate is ranked by its size in bytes divided by its reload cost.
+ * Candidates with the same rank keep their least-recently-used order.
+ */
+class CESIUM3DTILESSELECTION_API CostAwareTileEvictionPolicy
+    : public ITileEvictionPolicy {
+public:
+  /**
+   * @brief A function that estimates the relative cost of loading a tile
+   * again, such as the expected latency of its server. Must be positive.
+   */
+  using ReloadCostFunction = std::function<double(const Tile& tile)>;
+
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param reloadCost The reload cost of each tile. If empty, all tiles have
+   * the same cost, so the largest tiles are unloaded first.
+   */
+  explicit CostAwareTileEvictionPolicy(ReloadCostFunction reloadCost = {});
+
+  /**
+   * @brief Orders the candidates by bytes freed per unit of reload cost,
+   * highest first.
+   */
+  virtual void orderEvictionCandidates(
+      std::vector<Tile*>& candidates,
+      const std::vector<Tile*>& renderedTiles) override;
+
+private:
+  ReloadCostFunction _reloadCost;
+};
+
+/**
+ * @brief Never unloads the ancestors of rendered tiles, so that zooming out
+ * or losing a rendered tile has something to fall back on.
+ *
+ * This matters most for {@link Tileset::evictForMemoryPressure}, which also
+ * considers tiles that were visited in the last frame but not rendered.
+ */
+class CESIUM3DTILESSELECTION_API AncestorPinningTileEvictionPolicy
+    : public ITileEvictionPolicy {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param pPolicy The policy that orders the candidates that aren't pinned,
+   * or nullptr to keep them in least-recently-used order.
+   */
+  explicit AncestorPinningTileEvictionPolicy(
+      const std::shared_ptr<ITileEvictionPolicy>& pPolicy = nullptr);
+
+  /**
+   * @brief Removes the ancestors of the rendered tiles from the candidates,
+   * then orders the rest with the wrapped policy.
+   */
+  virtual void orderEvictionCandidates(
+      std::vector<Tile*>& candidates,
+      const std::vector<Tile*>& renderedTiles) override;
+
+private:
+  std::shared_ptr<ITileEvictionPolicy> _pPolicy;
+};
+
+} // namespace Cesium3DTilesSelection
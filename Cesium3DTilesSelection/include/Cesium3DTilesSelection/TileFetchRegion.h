@@ -0,0 +1,74 @@
+#pragma once
+
+#include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The region of a tileset, and the level of detail within it, whose
+ * tiles are fetched by {@link Tileset::fetchRegion}.
+ */
+struct TileFetchRegion {
+  /**
+   * @brief The rectangle that the tiles must overlap.
+   */
+  CesiumGeospatial::GlobeRectangle rectangle =
+      CesiumGeospatial::GlobeRectangle::MAXIMUM;
+
+  /**
+   * @brief The polygons that the tiles must overlap, in addition to the
+   * {@link rectangle}, or an empty list to fetch the whole rectangle.
+   */
+  std::vector<CesiumGeospatial::CartographicPolygon> polygons;
+
+  /**
+   * @brief The geometric error, in meters, at which tiles are no longer
+   * refined.
+   *
+   * The tiles of a region are fetched from the root down to, and including,
+   * the first tiles whose geometric error is at most this much. This is the
+   * geometric error that a view would render with a given maximum
+   * screen-space error from a given distance.
+   */
+  double maximumGeometricError = 0.0;
+
+  /**
+   * @brief The number of levels below the root tile, at most, whose tiles are
+   * fetched.
+   *
+   * The levels of the tiles of external tilesets, and of the subtrees of
+   * implicit tilesets, count the same as the other tiles.
+   */
+  uint32_t maximumLevel = 32;
+};
+
+/**
+ * @brief The result of fetching the tiles of a region with
+ * {@link Tileset::fetchRegion}.
+ */
+struct TileFetchResult {
+  /**
+   * @brief The number of tiles in the region whose content was loaded,
+   * including tiles without content.
+   */
+  size_t tilesLoaded = 0;
+
+  /**
+   * @brief The number of tiles in the region whose content failed to load.
+   */
+  size_t tilesFailed = 0;
+
+  /**
+   * @brief Warnings that came up while the tiles were fetched, such as the
+   * tileset being destroyed first.
+   */
+  std::vector<std::string> warnings;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Library.h"
+#include "TileUrl.h"
 
 #include <CesiumGeometry/OctreeTileID.h>
 #include <CesiumGeometry/QuadtreeTileID.h>
@@ -20,8 +21,9 @@ namespace Cesium3DTilesSelection {
  * Depending on the exact type of the tile and its contents, this
  * identifier may have different forms:
  *
- * * A `std::string`: This is an explicitly-described tile and
- *   the ID is the URL of the tile's content.
+ * * A {@link TileUrl}: This is an explicitly-described tile and
+ *   the ID is the URL of the tile's content, or an empty URL if the
+ *   tile has no content.
  * * A {@link CesiumGeometry::QuadtreeTileID}: This is an implicit
  *   tile in the quadtree. The URL of the tile's content is formed
  *   by instantiating the context's template URL with this ID.
@@ -33,7 +35,7 @@ namespace Cesium3DTilesSelection {
  *   the parent tile's content.
  */
 typedef std::variant<
-    std::string,
+    TileUrl,
     CesiumGeometry::QuadtreeTileID,
     CesiumGeometry::OctreeTileID,
     CesiumGeometry::UpsampledQuadtreeNode>
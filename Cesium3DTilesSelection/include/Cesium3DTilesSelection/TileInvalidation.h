@@ -0,0 +1,43 @@
+#pragma once
+
+#include "TileID.h"
+
+#include <CesiumGeospatial/GlobeRectangle.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The tiles whose content is reloaded by
+ * {@link Tileset::invalidateTiles}.
+ *
+ * A tile is invalidated if it matches any of the criteria.
+ */
+struct TileInvalidation {
+  /**
+   * @brief The IDs of the tiles to invalidate.
+   */
+  std::vector<TileID> tileIDs;
+
+  /**
+   * @brief Patterns that the string IDs of the tiles to invalidate are matched
+   * against.
+   *
+   * The string ID of a tile is the URI of its content, as it is given in the
+   * tileset JSON. In a pattern, `*` matches any sequence of characters, and
+   * every other character only matches itself. For example,
+   * `sites/north/*.b3dm` matches all b3dm tiles under `sites/north/`.
+   */
+  std::vector<std::string> urlPatterns;
+
+  /**
+   * @brief The rectangle that the bounding volumes of the tiles to invalidate
+   * overlap, if any.
+   */
+  std::optional<CesiumGeospatial::GlobeRectangle> rectangle;
+};
+
+} // namespace Cesium3DTilesSelection
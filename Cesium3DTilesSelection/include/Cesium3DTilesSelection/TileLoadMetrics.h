@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Library.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief A stage of loading the content of a tile, which is measured by
+ * {@link TileLoadMetrics}.
+ */
+enum class TileLoadStage {
+  /**
+   * @brief Waiting for the asset accessor to complete a request for a tile,
+   * which includes reading it from a cache. Measured for each request.
+   */
+  Request,
+
+  /**
+   * @brief Waiting for a decode slot after a response arrived, see
+   * {@link TilesetOptions::maximumSimultaneousTileDecodes}. Measured for each
+   * request.
+   */
+  DecodeQueue,
+
+  /**
+   * @brief Decoding the content by the loader of the tileset, from the time
+   * the last response was handed to it until it returns the content. This
+   * includes parsing the glTF and decoding its Draco or meshopt compressed
+   * meshes and its images.
+   */
+  Decode,
+
+  /**
+   * @brief Resolving the external buffers and images of the glTF of a tile
+   * and post-processing it in a worker thread, such as generating normals or
+   * building the triangle index.
+   */
+  PostProcess,
+
+  /**
+   * @brief Running {@link IPrepareRendererResources::prepareInLoadThread}.
+   */
+  PrepareInLoadThread,
+
+  /**
+   * @brief Waiting in the main thread load queue, from the time a tile's
+   * content is loaded until the main thread part of its load begins.
+   */
+  MainThreadQueue,
+
+  /**
+   * @brief Finishing the load in the main thread, which is mostly running
+   * {@link IPrepareRendererResources::prepareInMainThread}.
+   */
+  PrepareInMainThread,
+
+  /**
+   * @brief The whole worker thread part of a load, from the time it starts
+   * until its result is applied to the tile in the main thread.
+   */
+  Load
+};
+
+/**
+ * @brief A histogram of the time taken by one {@link TileLoadStage}.
+ *
+ * The bounds of the buckets grow by powers of two, from 16 microseconds for
+ * the first to about a minute for the last but one. The last bucket counts
+ * everything that took longer.
+ */
+struct CESIUM3DTILESSELECTION_API TileLoadLatencyHistogram {
+  /**
+   * @brief The number of buckets.
+   */
+  static constexpr size_t BucketCount = 24;
+
+  /**
+   * @brief Gets the index of the bucket that counts the given latency.
+   */
+  static size_t getBucket(int64_t microseconds) noexcept;
+
+  /**
+   * @brief Gets the latency, in milliseconds, below which the latencies that
+   * are counted by the given bucket are. This is infinity for the last bucket.
+   */
+  static double getBucketUpperBoundMilliseconds(size_t bucket) noexcept;
+
+  /**
+   * @brief The number of latencies that were counted by each bucket.
+   */
+  std::array<uint64_t, BucketCount> buckets{};
+
+  /**
+   * @brief The number of latencies that were recorded.
+   */
+  uint64_t count = 0;
+
+  /**
+   * @brief The sum of the latencies that were recorded, in microseconds.
+   */
+  uint64_t totalMicroseconds = 0;
+
+  /**
+   * @brief Computes the mean of the latencies, in milliseconds, or 0.0 if
+   * none were recorded.
+   */
+  double computeMeanMilliseconds() const noexcept;
+
+  /**
+   * @brief Estimates a percentile of the latencies, in milliseconds, as the
+   * upper bound of the bucket that the percentile falls in.
+   *
+   * @param fraction The percentile, from 0.0 to 1.0. For example, 0.95
+   * estimates the latency that 95% of the recorded latencies are below.
+   * @return The estimated latency, or 0.0 if none were recorded.
+   */
+  double computePercentileMilliseconds(double fraction) const noexcept;
+};
+
+/**
+ * @brief Measurements of where the time goes when the tiles of a
+ * {@link Tileset} are loaded, see {@link Tileset::getTileLoadMetrics}.
+ *
+ * The measurements accumulate over the lifetime of the tileset. Use
+ * {@link computeDifference} to get the measurements of a single frame or any
+ * other period.
+ */
+struct CESIUM3DTILESSELECTION_API TileLoadMetrics {
+  /**
+   * @brief The number of {@link TileLoadStage} values.
+   */
+  static constexpr size_t StageCount = size_t(TileLoadStage::Load) + 1;
+
+  /**
+   * @brief The latencies of each stage, indexed by {@link TileLoadStage}.
+   */
+  std::array<TileLoadLatencyHistogram, StageCount> latencies{};
+
+  /**
+   * @brief The number of bytes of content received by the requests for
+   * tiles.
+   */
+  uint64_t bytesReceived = 0;
+
+  /**
+   * @brief Gets the latencies of the given stage.
+   */
+  const TileLoadLatencyHistogram&
+  getLatencies(TileLoadStage stage) const noexcept {
+    return this->latencies[size_t(stage)];
+  }
+
+  /**
+   * @brief Computes the measurements that were made since the given earlier
+   * measurements of the same tileset.
+   */
+  TileLoadMetrics
+  computeDifference(const TileLoadMetrics& earlier) const noexcept;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -6,12 +6,14 @@
 #include <CesiumAsync/IAssetRequest.h>
 #include <CesiumGeometry/Axis.h>
 #include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/VertexLayout.h>
 #include <CesiumRasterOverlays/RasterOverlayDetails.h>
 
 #include <functional>
 #include <memory>
 #include <optional>
 #include <variant>
+#include <vector>
 
 namespace Cesium3DTilesSelection {
 
@@ -121,6 +123,30 @@ struct CESIUM3DTILESSELECTION_API TileLoadResult {
    */
   TileLoadResultState state;
 
+  /**
+   * @brief The result of evaluating
+   * {@link TilesetContentOptions::featureFilter} for the glTF content, with an
+   * element for each property table of its `EXT_structural_metadata`
+   * extension. Each element has a value for each feature of the table, which
+   * is true if the feature matches the filter. This is empty if there is no
+   * filter.
+   */
+  std::vector<std::vector<bool>> featureMasks{};
+
+  /**
+   * @brief The {@link TileTriangleIndex} of the glTF content, which is built
+   * in a worker thread when
+   * {@link TilesetContentOptions::buildTriangleIndex} is true.
+   */
+  std::shared_ptr<const TileTriangleIndex> pTriangleIndex{};
+
+  /**
+   * @brief The primitives of the glTF content, packed in the layout of
+   * {@link TilesetContentOptions::vertexLayout} in a worker thread. This is
+   * empty if there is no layout.
+   */
+  std::vector<CesiumGltfContent::PackedMeshPrimitive> packedPrimitives{};
+
   /**
    * @brief Create a result with Failed state
    *
@@ -136,6 +162,16 @@ struct CESIUM3DTILESSELECTION_API TileLoadResult {
    */
   static TileLoadResult createRetryLaterResult(
       std::shared_ptr<CesiumAsync::IAssetRequest> pCompletedRequest);
+
+  /**
+   * @brief Create a result with Success state and empty content, for content
+   * that was fetched but not decoded, see
+   * {@link TilesetContentOptions::skipContentDecoding}.
+   *
+   * @param pCompletedRequest The request that fetched the content
+   */
+  static TileLoadResult createFetchedResult(
+      std::shared_ptr<CesiumAsync::IAssetRequest> pCompletedRequest);
 };
 
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+
+/**
+ * @brief Where a ray hits the content of a tileset, as found by
+ * {@link Tileset::intersectRay}.
+ */
+struct TileRayIntersection {
+  /**
+   * @brief The tile whose content is hit.
+   */
+  Tile* pTile;
+
+  /**
+   * @brief The distance in meters from the origin of the ray to the hit.
+   */
+  double distance;
+
+  /**
+   * @brief The position of the hit, in ECEF coordinates.
+   */
+  glm::dvec3 position;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Library.h"
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace CesiumGeometry {
+class Ray;
+}
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief A bounding volume hierarchy over the triangles of the model of a
+ * tile, for finding where rays hit the model without testing every triangle.
+ *
+ * The hierarchy is split with the surface area heuristic and stored as a flat
+ * array of nodes. The triangles are transformed to ECEF coordinates when the
+ * index is built, so the index stays valid only as long as the model and the
+ * transform of the tile don't change. Skirts are left out.
+ */
+class CESIUM3DTILESSELECTION_API TileTriangleIndex {
+public:
+  /**
+   * @brief Builds the index of a model.
+   *
+   * @param model The model.
+   * @param transform The transform of the tile of the model.
+   */
+  TileTriangleIndex(
+      const CesiumGltf::Model& model,
+      const glm::dmat4& transform);
+
+  /**
+   * @brief Computes the closest intersection of a ray and the triangles.
+   *
+   * Both sides of the triangles are hit.
+   *
+   * @param ray The ray, in ECEF coordinates.
+   * @return The distance along the ray to the closest intersection, or
+   * `std::nullopt` if the ray doesn't hit any triangle.
+   */
+  std::optional<double>
+  intersectRay(const CesiumGeometry::Ray& ray) const noexcept;
+
+  /**
+   * @brief Gets the number of indexed triangles.
+   */
+  size_t getTriangleCount() const noexcept;
+
+  /**
+   * @brief Gets the number of nodes in the hierarchy.
+   */
+  size_t getNodeCount() const noexcept;
+
+private:
+  // A node covers either triangles [first, first + count) when count isn't 0,
+  // or the nodes first and first + 1.
+  struct Node {
+    glm::dvec3 minimum;
+    glm::dvec3 maximum;
+    uint32_t first;
+    uint32_t count;
+  };
+
+  using Triangle = std::array<glm::dvec3, 3>;
+
+  void build(uint32_t nodeIndex, uint32_t begin, uint32_t end, uint32_t depth);
+
+  std::vector<Triangle> _triangles;
+  std::vector<Node> _nodes;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The URL of the content of an explicitly-described tile, as it
+ * appears in the tileset JSON, see {@link TileID}.
+ *
+ * The URLs of the tiles of large tilesets are mostly the same: most of them
+ * start with the same directories, and many end with the same query
+ * parameters, such as a session key. A URL created by a {@link TileUrlPool}
+ * shares those parts with the other URLs of the pool, so that each tile only
+ * stores the name of its content. The full URL is put together by
+ * {@link toString} when it is needed, such as for a request.
+ *
+ * A URL that is constructed from a string on its own doesn't share anything.
+ * Copies are cheap, and two URLs are equal if their strings are, whether or
+ * not they come from the same pool.
+ */
+class CESIUM3DTILESSELECTION_API TileUrl {
+public:
+  /**
+   * @brief Constructs an empty URL.
+   */
+  TileUrl() noexcept = default;
+
+  /**
+   * @brief Constructs a URL that doesn't share its parts with other URLs.
+   */
+  TileUrl(std::string_view url);
+
+  /** @copydoc TileUrl(std::string_view) */
+  TileUrl(const std::string& url) : TileUrl(std::string_view(url)) {}
+
+  /** @copydoc TileUrl(std::string_view) */
+  TileUrl(const char* url) : TileUrl(std::string_view(url)) {}
+
+  /** @brief Copies a URL, sharing its parts with the copy. */
+  TileUrl(const TileUrl& rhs) noexcept;
+
+  /** @brief Moves a URL. */
+  TileUrl(TileUrl&& rhs) noexcept;
+
+  ~TileUrl() noexcept;
+
+  /** @brief Copies a URL, sharing its parts with the copy. */
+  TileUrl& operator=(const TileUrl& rhs) noexcept;
+
+  /** @brief Moves a URL. */
+  TileUrl& operator=(TileUrl&& rhs) noexcept;
+
+  /**
+   * @brief Puts together the full URL.
+   */
+  std::string toString() const;
+
+  /**
+   * @brief Returns whether the URL is empty, as it is for the tiles without
+   * content.
+   */
+  bool empty() const noexcept;
+
+  /**
+   * @brief Gets the length of the full URL.
+   */
+  size_t size() const noexcept;
+
+  /**
+   * @brief Compares the full strings of two URLs.
+   */
+  bool operator==(const TileUrl& rhs) const noexcept;
+
+  /**
+   * @brief Compares the full strings of two URLs.
+   */
+  bool operator!=(const TileUrl& rhs) const noexcept {
+    return !(*this == rhs);
+  }
+
+private:
+  // A reference-counted, immutable piece of a URL, whose characters are
+  // allocated along with it.
+  struct Segment;
+
+  static const Segment* createSegment(std::string_view text);
+  static void addReference(const Segment* pSegment) noexcept;
+  static void releaseReference(const Segment* pSegment) noexcept;
+  static std::string_view getText(const Segment* pSegment) noexcept;
+
+  // Takes over a reference to each segment.
+  TileUrl(
+      const Segment* pPrefix,
+      const Segment* pName,
+      const Segment* pQuery) noexcept;
+
+  // The path up to and including its last slash, the rest of the path, and
+  // the query and fragment. Any of them is nullptr if it's empty.
+  const Segment* _pPrefix = nullptr;
+  const Segment* _pName = nullptr;
+  const Segment* _pQuery = nullptr;
+
+  friend class TileUrlPool;
+  friend struct std::hash<TileUrl>;
+};
+
+/**
+ * @brief Creates {@link TileUrl} instances that share the directories and the
+ * query parameters of their URLs.
+ *
+ * The shared parts stay in the pool for as long as it exists, and in the URLs
+ * for as long as they exist, so URLs may outlive their pool.
+ *
+ * This class is thread-safe.
+ */
+class CESIUM3DTILESSELECTION_API TileUrlPool {
+public:
+  TileUrlPool() = default;
+  ~TileUrlPool() noexcept;
+
+  TileUrlPool(const TileUrlPool&) = delete;
+  TileUrlPool& operator=(const TileUrlPool&) = delete;
+
+  /**
+   * @brief Creates a URL that shares its directories and query parameters
+   * with the other URLs of this pool.
+   */
+  TileUrl create(std::string_view url);
+
+  /**
+   * @brief Gets the number of distinct shared parts in this pool.
+   */
+  size_t getSharedSegmentCount() const;
+
+private:
+  // Adds a reference to the pooled segment of the text, creating it first if
+  // needed.
+  const TileUrl::Segment* share(std::string_view text);
+
+  mutable std::mutex _mutex;
+
+  // Each segment is held by a reference, and its key views its text.
+  std::unordered_map<std::string_view, const TileUrl::Segment*> _segments;
+};
+
+} // namespace Cesium3DTilesSelection
+
+namespace std {
+
+/**
+ * @brief A hash function for {@link Cesium3DTilesSelection::TileUrl} objects.
+ */
+template <> struct hash<Cesium3DTilesSelection::TileUrl> {
+
+  /**
+   * @brief Hashes the full string of the URL without putting it together, so
+   * that equal URLs have the same hash whether or not they come from the same
+   * pool.
+   */
+  CESIUM3DTILESSELECTION_API size_t
+  operator()(const Cesium3DTilesSelection::TileUrl& url) const noexcept;
+};
+} // namespace std
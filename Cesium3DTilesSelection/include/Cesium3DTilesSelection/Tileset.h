@@ -2,7 +2,12 @@
 
 #include "Library.h"
 #include "RasterOverlayCollection.h"
+#include "SampleHeightResult.h"
 #include "Tile.h"
+#include "TileFetchRegion.h"
+#include "TileInvalidation.h"
+#include "TileLoadMetrics.h"
+#include "TileRayIntersection.h"
 #include "TilesetContentLoader.h"
 #include "TilesetExternals.h"
 #include "TilesetLoadFailureDetails.h"
@@ -11,17 +16,30 @@
 #include "ViewUpdateResult.h"
 
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/TaskPriority.h>
+#include <CesiumGeometry/Ray.h>
+#include <CesiumGeospatial/Cartographic.h>
 #include <CesiumUtility/IntrusivePointer.h>
 
+#include <gsl/span>
 #include <rapidjson/fwd.h>
 
+#include <chrono>
+#include <list>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
+class SoftwareOcclusionBuffer;
 class TilesetContentManager;
+class TilesetFetchRequest;
+class TilesetGroup;
+class TilesetHeightQuery;
+class TilesetHeightRequest;
 class TilesetMetadata;
 
 /**
@@ -48,8 +66,13 @@ public:
 
   /**
    * @brief Constructs a new instance with a given `tileset.json` URL.
+   *
+   * The URL may also be that of a 3D Tiles archive, with a `.3tz`
+   * extension. Its files are then read with range requests, without
+   * downloading the whole archive.
+   *
    * @param externals The external interfaces to use.
-   * @param url The URL of the `tileset.json`.
+   * @param url The URL of the `tileset.json`, or of a `.3tz` archive.
    * @param options Additional options for the tileset.
    */
   Tileset(
@@ -157,6 +180,25 @@ public:
   /** @copydoc Tileset::getRootTile() */
   const Tile* getRootTile() const noexcept;
 
+  /**
+   * @brief Finds a tile of this tileset by its {@link TileID}.
+   *
+   * This only finds tiles if {@link TilesetOptions::enableTileIndex} was set
+   * when this tileset was constructed, and only the tiles that currently
+   * exist. Child tiles are created as they are needed, and may be discarded
+   * again, see {@link TilesetOptions::enableSubtreePruning}. Tiles without
+   * content, whose ID is an empty string, are never found. If several tiles
+   * have the same ID, one of them is returned.
+   *
+   * @param tileID The ID of the tile to find.
+   * @return The tile, or `nullptr` if there is no such tile or the index is
+   * not enabled.
+   */
+  Tile* findTile(const TileID& tileID) noexcept;
+
+  /** @copydoc Tileset::findTile */
+  const Tile* findTile(const TileID& tileID) const noexcept;
+
   /**
    * @brief Returns the {@link RasterOverlayCollection} of this tileset.
    */
@@ -170,6 +212,13 @@ public:
    * loading and ready to be rendered before returning the function. This method
    * is significantly slower than {@link Tileset::updateView} and should only be
    * used for capturing movie or non-realtime situation.
+   *
+   * While it waits, the tiles load without the limits of
+   * {@link TilesetOptions::maximumSimultaneousTileLoads},
+   * {@link TilesetOptions::maximumSimultaneousTileDecodes} and the main-thread
+   * time limits, and the tileset is only traversed again once a tile has
+   * finished loading.
+   *
    * @param frustums The {@link ViewState}s that the view should be updated for
    * @returns The set of tiles to render in the updated view. This value is only
    * valid until the next call to `updateView` or until the tileset is
@@ -181,6 +230,9 @@ public:
   /**
    * @brief Updates this view, returning the set of tiles to render in this
    * view.
+   *
+   * If this tileset is in a {@link TilesetGroup}, tile loads are not started
+   * and cached tiles are not unloaded until {@link TilesetGroup::updateLoads}.
    * @param frustums The {@link ViewState}s that the view should be updated for
    * @param deltaTime The amount of time that has passed since the last call to
    * updateView, in seconds.
@@ -191,11 +243,72 @@ public:
   const ViewUpdateResult&
   updateView(const std::vector<ViewState>& frustums, float deltaTime = 0.0f);
 
+  /**
+   * @brief Sets the views from which this tileset is expected to be seen in
+   * the near future, such as points further along a known camera path.
+   *
+   * During each subsequent {@link updateView}, the tiles that would be needed
+   * to render these views are queued for loading as well. They are loaded
+   * after all of the tiles that are needed for the current views, so that
+   * the latency of fetching them is hidden by the time the camera arrives.
+   * The predicted views do not affect which tiles are rendered.
+   *
+   * The views remain in effect until this method is called again. Pass an
+   * empty vector to stop prefetching.
+   *
+   * @param frustums The {@link ViewState}s that are expected in the future.
+   */
+  void setPredictedViews(const std::vector<ViewState>& frustums);
+
+  /**
+   * @brief Gets the views set by {@link setPredictedViews}.
+   */
+  const std::vector<ViewState>& getPredictedViews() const noexcept {
+    return this->_predictedViews;
+  }
+
+  /**
+   * @brief Sets secondary views, such as the cascades of a shadow map, that
+   * are rendered from the tiles that are already loaded.
+   *
+   * During each subsequent {@link updateView}, the tiles to render for each of
+   * these views are selected into
+   * {@link ViewUpdateResult::renderOnlyViewTiles}. Unlike the views passed to
+   * {@link updateView}, these never queue tiles for loading and don't affect
+   * load priorities, so that a wide shadow view doesn't cause full-detail
+   * loads of tiles the camera can't see. Where the loaded tiles aren't
+   * detailed enough, the nearest loaded ancestor is selected instead.
+   *
+   * The views remain in effect until this method is called again. Pass an
+   * empty vector to stop selecting tiles for them.
+   *
+   * @param frustums The {@link ViewState}s to select loaded tiles for.
+   */
+  void setRenderOnlyViews(const std::vector<ViewState>& frustums);
+
+  /**
+   * @brief Gets the views set by {@link setRenderOnlyViews}.
+   */
+  const std::vector<ViewState>& getRenderOnlyViews() const noexcept {
+    return this->_renderOnlyViews;
+  }
+
   /**
    * @brief Gets the total number of tiles that are currently loaded.
    */
   int32_t getNumberOfTilesLoaded() const;
 
+  /**
+   * @brief Gets measurements of how long the stages of loading the tiles of
+   * this tileset have taken, and how many bytes were received.
+   *
+   * The measurements accumulate over the lifetime of the tileset. Getting them
+   * only copies a few hundred counters, so it may be done every frame, and
+   * {@link TileLoadMetrics::computeDifference} gives the measurements since
+   * the previous frame.
+   */
+  TileLoadMetrics getTileLoadMetrics() const;
+
   /**
    * @brief Estimate the percentage of the tiles for the current view that have
    * been loaded.
@@ -212,9 +325,28 @@ public:
   /**
    * @brief Gets the total number of bytes of tile and raster overlay data that
    * are currently loaded.
+   *
+   * This includes the renderer resources of the tiles, as reported by
+   * {@link IPrepareRendererResources::getRenderResourcesByteSize}.
    */
   int64_t getTotalDataBytes() const noexcept;
 
+  /**
+   * @brief Unloads cached tiles right away, for example when the application
+   * is warned that the system is running low on memory.
+   *
+   * Unlike the unloading that happens in {@link updateView}, this ignores
+   * {@link TilesetOptions::tileCacheUnloadTimeLimit}, and it may also unload
+   * tiles that were visited in the last frame but not rendered. Tiles that
+   * were rendered in the last frame, tiles that are fading out, and the root
+   * tile are kept. The tiles are unloaded in the order decided by
+   * {@link TilesetOptions::evictionPolicy}.
+   *
+   * @param targetBytes Unloading stops once the total size of the loaded data
+   * is no more than this many bytes.
+   */
+  void evictForMemoryPressure(int64_t targetBytes = 0);
+
   /**
    * @brief Gets the {@link TilesetMetadata} associated with the main or
    * external tileset.json that contains a given tile. If the metadata is not
@@ -258,6 +390,109 @@ public:
    */
   CesiumAsync::Future<const TilesetMetadata*> loadMetadata();
 
+  /**
+   * @brief Asynchronously samples the heights of this tileset at the most
+   * detailed level of detail.
+   *
+   * The height at each position is where a vertical line through the
+   * position, along the normal of the WGS84 ellipsoid, first hits the
+   * tileset from above. The positions are sampled together in the following
+   * calls to {@link updateView}: the most detailed tiles that any of them
+   * needs are loaded once through the usual load queues, whatever the views
+   * are, and the triangles of each tile are indexed once for all of the
+   * positions that need the tile. The tiles are kept loaded until the heights
+   * are sampled.
+   *
+   * The returned future resolves in the main thread. If this tileset is
+   * destroyed first, the future resolves with no heights sampled.
+   *
+   * @param positions The positions, whose heights are ignored.
+   * @return A future that resolves to the positions with their sampled
+   * heights.
+   */
+  CesiumAsync::Future<SampleHeightResult> sampleHeightMostDetailed(
+      gsl::span<const CesiumGeospatial::Cartographic> positions);
+
+  /**
+   * @brief Asynchronously fetches the tiles of a region, down to a level of
+   * detail, such as to fill the cache of the
+   * {@link TilesetExternals::pAssetAccessor} before going offline.
+   *
+   * The tiles are found and loaded in the following calls to
+   * {@link updateView}, whatever the views are: every tile that overlaps the
+   * region is loaded through the usual load queues, after the tiles needed by
+   * the views, until the tiles whose geometric error is small enough. As many
+   * tiles load at once as {@link TilesetOptions::maximumSimultaneousTileLoads}
+   * allows, so a higher limit fetches faster. With
+   * {@link TilesetContentOptions::skipContentDecoding}, the content of the
+   * tiles is only fetched, not decoded, and no renderer resources are
+   * prepared for it. Tiles that aren't needed by the views may be unloaded
+   * again once the region is fetched.
+   *
+   * The returned future resolves in the main thread. If this tileset is
+   * destroyed first, the future resolves with a warning.
+   *
+   * @param region The region and the level of detail to fetch.
+   * @return A future that resolves once the tiles of the region are loaded or
+   * have failed to load.
+   */
+  CesiumAsync::Future<TileFetchResult>
+  fetchRegion(const TileFetchRegion& region);
+
+  /**
+   * @brief Fetches the tiles of a region, as {@link fetchRegion} does, and
+   * waits for them.
+   *
+   * This calls {@link updateView} with no views until the tiles are fetched,
+   * ticking the {@link TilesetExternals::pAssetAccessor} between the calls, so
+   * it is meant for tools without a render loop, such as one that warms a
+   * cache. As with {@link updateViewOffline}, the tiles are loaded by this
+   * tileset on its own, even if it is in a {@link TilesetGroup}.
+   *
+   * @param region The region and the level of detail to fetch.
+   * @return The result of fetching the tiles.
+   */
+  TileFetchResult fetchRegionOffline(const TileFetchRegion& region);
+
+  /**
+   * @brief Reloads the content of some of the tiles of this tileset, such as
+   * after it changed on the server, and keeps all other tiles loaded.
+   *
+   * The content of the matching tiles is unloaded right away, so the
+   * {@link ViewUpdateResult} of the last call to {@link updateView} must not
+   * be used to render them anymore. Tiles that are still loading are unloaded
+   * once their loads end. The tiles load again as soon as they are needed,
+   * and until then their ancestors are rendered in their place. These loads
+   * ask the server whether the content changed even if it is in the cache of
+   * a {@link CesiumAsync::CachingAssetAccessor}, by sending the request with a
+   * `Cache-Control: no-cache` header.
+   *
+   * Only the tiles whose parents have been created can be found. Tiles with
+   * external tilesets or without content are not reloaded.
+   *
+   * @param invalidation The tiles to reload.
+   * @return The number of tiles whose content is reloaded.
+   */
+  size_t invalidateTiles(const TileInvalidation& invalidation);
+
+  /**
+   * @brief Finds the closest point where a ray hits the content that was
+   * selected for rendering by the last call to {@link updateView}.
+   *
+   * Below the root tile, only the tiles whose bounding volumes the ray passes
+   * through are tested, nearest first, against the
+   * {@link TileTriangleIndex} of their content. An
+   * index that wasn't built when its tile was loaded, see
+   * {@link TilesetContentOptions::buildTriangleIndex}, is built now and kept
+   * with the tile.
+   *
+   * @param ray The ray, in ECEF coordinates.
+   * @return The closest hit, or `std::nullopt` if the ray doesn't hit any of
+   * the rendered content.
+   */
+  std::optional<TileRayIntersection>
+  intersectRay(const CesiumGeometry::Ray& ray);
+
 private:
   /**
    * @brief The result of traversing one branch of the tile hierarchy.
@@ -321,6 +556,22 @@ private:
     std::vector<double> fogDensities;
     int32_t lastFrameNumber;
     int32_t currentFrameNumber;
+
+    /**
+     * @brief The view epoch whose cached tile evaluations may be reused, or 0
+     * if they may not be reused this frame.
+     */
+    uint64_t viewEpoch;
+  };
+
+  /**
+   * @brief The nearest ancestor of a tile that is loaded, or will be loaded
+   * this frame, which {@link TilesetOptions::skipLevelOfDetail} measures the
+   * skipped levels from.
+   */
+  struct SkipLevelOfDetailAncestor {
+    uint32_t depth = 0;
+    double largestSse = 0.0;
   };
 
   TraversalDetails _renderLeaf(
@@ -341,6 +592,7 @@ private:
       size_t workerThreadLoadQueueIndex,
       size_t mainThreadLoadQueueIndex,
       bool queuedForLoad,
+      bool skipped,
       double tilePriority);
   TileOcclusionState
   _checkOcclusion(const Tile& tile, const FrameState& frameState);
@@ -350,6 +602,7 @@ private:
       uint32_t depth,
       bool meetsSse,
       bool ancestorMeetsSse,
+      const SkipLevelOfDetailAncestor& skipAncestor,
       Tile& tile,
       double tilePriority,
       ViewUpdateResult& result);
@@ -361,32 +614,71 @@ private:
     bool culled = false;
   };
 
+  /**
+   * @brief The view-dependent evaluation of a single tile.
+   *
+   * Computing this does not modify the tile or the tileset, so it may be done
+   * in a worker thread while the tile hierarchy is not otherwise being
+   * modified.
+   */
+  struct TileViewEvaluation {
+    double tilePriority = 0.0;
+    CullResult cullResult{};
+    bool meetsSse = false;
+
+    // The work done for this evaluation, see ViewUpdateResult.
+    uint32_t screenSpaceErrorEvaluations = 0;
+    uint32_t cullingTests = 0;
+  };
+
   // TODO: abstract these into a composable culling interface.
-  void _frustumCull(
+  bool _isVisibleFromAnyCamera(
       const Tile& tile,
+      const Tile::CachedCullingVolume& cullingVolume,
       const FrameState& frameState,
       bool cullWithChildrenBounds,
-      CullResult& cullResult);
-  void _fogCull(
+      uint32_t& cullingTests) const;
+  void _frustumCull(bool visibleFromCamera, CullResult& cullResult)
+      const noexcept;
+  void _fogCull(bool visibleInFog, CullResult& cullResult) const noexcept;
+  void _horizonCull(bool visibleAboveHorizon, CullResult& cullResult)
+      const noexcept;
+  void _softwareOcclusionCull(
+      const CesiumGeometry::OrientedBoundingBox& boundingBox,
+      CullResult& cullResult,
+      uint32_t& cullingTests) const;
+  bool _meetsSse(double largestSse, bool culled) const noexcept;
+
+  void _prepareTileForVisit(Tile& tile, CullResult& cullResult);
+  bool _isTileExcluded(Tile& tile) const noexcept;
+  void _evaluateTile(
       const FrameState& frameState,
-      const std::vector<double>& distances,
-      CullResult& cullResult);
-  bool _meetsSse(
-      const std::vector<ViewState>& frustums,
-      const Tile& tile,
-      const std::vector<double>& distances,
-      bool culled) const noexcept;
+      Tile& tile,
+      std::vector<double>& distances,
+      TileViewEvaluation& evaluation) const;
+  std::vector<TileViewEvaluation>
+  _evaluateChildrenInParallel(const FrameState& frameState, Tile& tile);
 
   TraversalDetails _visitTileIfNeeded(
       const FrameState& frameState,
       uint32_t depth,
       bool ancestorMeetsSse,
+      const SkipLevelOfDetailAncestor& skipAncestor,
+      Tile& tile,
+      ViewUpdateResult& result);
+  TraversalDetails _visitEvaluatedTile(
+      const FrameState& frameState,
+      uint32_t depth,
+      bool ancestorMeetsSse,
+      const SkipLevelOfDetailAncestor& skipAncestor,
       Tile& tile,
+      const TileViewEvaluation& evaluation,
       ViewUpdateResult& result);
   TraversalDetails _visitVisibleChildrenNearToFar(
       const FrameState& frameState,
       uint32_t depth,
       bool ancestorMeetsSse,
+      const SkipLevelOfDetailAncestor& skipAncestor,
       Tile& tile,
       ViewUpdateResult& result);
 
@@ -411,16 +703,71 @@ private:
       double tilePriority,
       bool queuedForLoad);
 
+  void _updateEffectiveMaximumScreenSpaceError(size_t tilesRenderedLastFrame);
+
+  void _prefetchPredictedViews(
+      int32_t currentFrameNumber,
+      ViewUpdateResult& result);
+  void _prefetchTile(
+      const FrameState& frameState,
+      const std::unordered_set<const Tile*>& queuedTiles,
+      Tile& tile,
+      double parentSse,
+      uint32_t& cullingTests);
+
+  void _selectTilesForRenderOnlyViews(ViewUpdateResult& result);
+  bool _selectLoadedTiles(
+      const FrameState& frameState,
+      Tile& tile,
+      std::vector<Tile*>& tiles,
+      uint32_t& cullingTests);
+
+  void _addExternalTilesetPrefetchCandidates(
+      const FrameState& frameState,
+      Tile& tile);
+  void _prefetchExternalTilesets();
+
+  void _processHeightRequests();
+  bool _findHeightQueryCandidates(
+      TilesetHeightRequest& request,
+      TilesetHeightQuery& query,
+      std::unordered_set<const Tile*>& queuedTiles,
+      Tile& tile);
+
+  void _processFetchRequests();
+  void _processTileInvalidations();
+  bool _fetchRegionTiles(
+      TilesetFetchRequest& request,
+      std::unordered_set<const Tile*>& queuedTiles,
+      Tile& tile,
+      uint32_t level);
+
   void _processWorkerThreadLoadQueue();
+  void _loadRasterOverlayTiles();
   void _processMainThreadLoadQueue();
-
-  void _unloadCachedTiles(double timeBudget) noexcept;
+  void _dispatchMainThreadTasksWithinBudget();
+
+  void _unloadCachedTiles(int64_t maximumBytes, double timeBudget) noexcept;
+  void _evictTiles(
+      std::vector<Tile*>& candidates,
+      int64_t targetBytes,
+      std::chrono::system_clock::time_point end) noexcept;
+  void _pruneUnusedSubtrees(int32_t currentFrameNumber);
+  void _discardChildTiles(Tile& tile);
   void _markTileVisited(Tile& tile) noexcept;
 
   void _updateLodTransitions(
       const FrameState& frameState,
       float deltaTime,
-      ViewUpdateResult& result) const noexcept;
+      ViewUpdateResult& result) noexcept;
+  void _addTileToRenderList(
+      Tile& tile,
+      const TileSelectionState& lastFrameSelectionState,
+      int32_t lastFrameNumber,
+      ViewUpdateResult& result);
+  void _updateRenderListChanges(
+      int32_t currentFrameNumber,
+      ViewUpdateResult& result) noexcept;
 
   TilesetExternals _externals;
   CesiumAsync::AsyncSystem _asyncSystem;
@@ -430,6 +777,29 @@ private:
   int32_t _previousFrameNumber;
   ViewUpdateResult _updateResult;
 
+  // The maximum screen-space error that tiles are selected with, see
+  // TilesetOptions::screenSpaceErrorGovernor.
+  double _effectiveMaximumScreenSpaceError;
+
+  // The views, fog densities and options that cached tile evaluations in the
+  // current view epoch were computed with.
+  uint64_t _viewEpoch;
+  std::vector<ViewState> _viewEpochFrustums;
+  std::vector<double> _viewEpochFogDensities;
+  bool _viewEpochRenderTilesUnderCamera;
+  std::optional<FoveatedScreenSpaceErrorOptions>
+      _viewEpochFoveatedScreenSpaceError;
+
+  // Incremented every frame, when the excluders are told about the new frame,
+  // so that what they decided for the tiles last frame isn't reused.
+  uint64_t _excluderEpoch;
+
+  uint64_t _updateViewEpoch(
+      const std::vector<ViewState>& frustums,
+      const std::vector<double>& fogDensities);
+
+  void _updateSoftwareOcclusionBuffers(const std::vector<ViewState>& frustums);
+
   enum class TileLoadPriorityGroup {
     /**
      * @brief Low priority tiles that aren't needed right now, but
@@ -437,18 +807,24 @@ private:
      */
     Preload = 0,
 
+    /**
+     * @brief Low priority tiles that aren't needed right now, but are needed
+     * to render one of the views set by {@link setPredictedViews}.
+     */
+    Prefetch = 1,
+
     /**
      * @brief Medium priority tiles that are needed to render the current view
      * the appropriate level-of-detail.
      */
-    Normal = 1,
+    Normal = 2,
 
     /**
      * @brief High priority tiles that are causing extra detail to be rendered
      * in the scene, potentially creating a performance problem and aliasing
      * artifacts.
      */
-    Urgent = 2
+    Urgent = 3
   };
 
   struct TileLoadTask {
@@ -479,11 +855,70 @@ private:
       else
         return this->group > rhs.group;
     }
+
+    /**
+     * @brief The priority of the worker-thread work done to load the tile,
+     * which is ordered the same way.
+     */
+    CesiumAsync::TaskPriority getTaskPriority() const noexcept {
+      return CesiumAsync::TaskPriority{
+          static_cast<int32_t>(this->group),
+          this->priority};
+    }
   };
 
   std::vector<TileLoadTask> _mainThreadLoadQueue;
   std::vector<TileLoadTask> _workerThreadLoadQueue;
 
+  // Tiles visited this frame whose children's subtrees may be discarded, see
+  // TilesetOptions::enableSubtreePruning.
+  std::vector<Tile*> _subtreePruningCandidates;
+
+  std::vector<ViewState> _predictedViews;
+  std::vector<ViewState> _renderOnlyViews;
+
+  // The views that tiles were selected for last frame, after combining stereo
+  // pairs, see TilesetOptions::combineStereoViews.
+  std::vector<ViewState> _combinedViews;
+
+  // Tiles with children that were visited for the predicted views or for the
+  // height and fetch requests this frame. Their subtrees must not be
+  // discarded, because the load queues may refer to their descendants.
+  std::unordered_set<const Tile*> _prefetchedTiles;
+
+  // The unloaded children of the tiles rendered this frame that may refer to
+  // an external tileset, with their distances to the nearest view, see
+  // TilesetOptions::externalTilesetPrefetchCount.
+  std::vector<std::pair<double, Tile*>> _externalTilesetPrefetchCandidates;
+
+  // The requests of sampleHeightMostDetailed that aren't complete yet.
+  std::list<TilesetHeightRequest> _heightRequests;
+
+  // The requests of fetchRegion that aren't complete yet.
+  std::list<TilesetFetchRequest> _fetchRequests;
+
+  // The invalidated tiles that were still loading, and are to be unloaded
+  // once their loads end.
+  std::vector<Tile*> _invalidatedTiles;
+
+  // The rendered tiles that may not have finished fading in, which are the
+  // only ones whose fade percentages are updated. A tile is added when it is
+  // added to the render list without having been rendered last frame, or while
+  // its content is still loading. Every other rendered tile is fully faded in.
+  std::unordered_set<Tile*> _tilesFadingIn;
+
+  // The render list of the previous frame. Its storage is swapped with the
+  // render list of each frame, so that neither is reallocated.
+  std::vector<Tile*> _previousTilesToRender;
+
+  // Tiles that are loading and were asked for again this frame, see
+  // TilesetOptions::cancelUnneededTileLoads.
+  std::unordered_set<const Tile*> _loadingTilesStillNeeded;
+
+  // The depth buffer of each current view, see
+  // TilesetOptions::enableSoftwareOcclusionCulling. Empty if it's disabled.
+  std::vector<SoftwareOcclusionBuffer> _softwareOcclusionBuffers;
+
   Tile::LoadedLinkedList _loadedTiles;
 
   // Holds computed distances, to avoid allocating them on the heap during tile
@@ -494,6 +929,9 @@ private:
   // scratch variable so that it can allocate only when growing bigger.
   std::vector<const TileOcclusionRendererProxy*> _childOcclusionProxies;
 
+  // The group that loads and unloads this tileset's tiles, if any.
+  TilesetGroup* _pGroup;
+
   CesiumUtility::IntrusivePointer<TilesetContentManager>
       _pTilesetContentManager;
 
@@ -509,6 +947,8 @@ private:
 
   Tileset(const Tileset& rhs) = delete;
   Tileset& operator=(const Tileset& rhs) = delete;
+
+  friend class TilesetGroup;
 };
 
 } // namespace Cesium3DTilesSelection
@@ -9,15 +9,18 @@
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/ThreadPool.h>
 #include <CesiumGeometry/Axis.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumRasterOverlays/RasterOverlayDetails.h>
 
 #include <spdlog/logger.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
@@ -37,6 +40,10 @@ struct CESIUM3DTILESSELECTION_API TileLoadInput {
    * @param pLogger The logger that will be used
    * @param requestHeaders The request headers that will be attached to the
    * request.
+   * @param pCanceled The flag that is set when the load is canceled, or
+   * nullptr if it can't be canceled.
+   * @param decodeThreadPool The thread pool in which to decode the content,
+   * if not the worker threads.
    */
   TileLoadInput(
       const Tile& tile,
@@ -44,7 +51,10 @@ struct CESIUM3DTILESSELECTION_API TileLoadInput {
       const CesiumAsync::AsyncSystem& asyncSystem,
       const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
       const std::shared_ptr<spdlog::logger>& pLogger,
-      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders);
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+      const std::shared_ptr<const std::atomic<bool>>& pCanceled = nullptr,
+      const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool =
+          std::nullopt);
 
   /**
    * @brief The tile that the {@link TilesetContentLoader} will request the server for the content.
@@ -76,8 +86,74 @@ struct CESIUM3DTILESSELECTION_API TileLoadInput {
    * @brief The request headers that will be attached to the request.
    */
   const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders;
+
+  /**
+   * @brief A flag that is set, from the main thread, when the tile is no
+   * longer needed and its load is canceled. May be nullptr.
+   *
+   * Loaders should keep a copy of this pointer and check the flag before
+   * starting expensive work, such as decoding the content, after a request
+   * completes. If it is set, they should return
+   * {@link TileLoadResult::createRetryLaterResult} instead, so that the tile
+   * can be loaded again if it's needed later.
+   */
+  std::shared_ptr<const std::atomic<bool>> pCanceled;
+
+  /**
+   * @brief The thread pool in which to do CPU-heavy decoding, or
+   * `std::nullopt` to decode in the worker threads. See
+   * {@link TilesetExternals::decodeThreadPool}.
+   *
+   * Loaders should use {@link runInDecodeThread} and
+   * {@link thenInDecodeThread} for such work.
+   */
+  std::optional<CesiumAsync::ThreadPool> decodeThreadPool;
 };
 
+/**
+ * @brief Runs CPU-heavy decoding in the given thread pool, or in a worker
+ * thread if there is none.
+ *
+ * @param asyncSystem The async system.
+ * @param decodeThreadPool The thread pool for decoding, if any.
+ * @param f The function to run.
+ * @return A future that resolves after the function completes.
+ */
+template <typename Func>
+auto runInDecodeThread(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool,
+    Func&& f) {
+  if (decodeThreadPool) {
+    return asyncSystem.runInThreadPool(
+        *decodeThreadPool,
+        std::forward<Func>(f));
+  }
+  return asyncSystem.runInWorkerThread(std::forward<Func>(f));
+}
+
+/**
+ * @brief Continues a future with CPU-heavy decoding in the given thread pool,
+ * or in a worker thread if there is none.
+ *
+ * @param decodeThreadPool The thread pool for decoding, if any.
+ * @param future The future to continue.
+ * @param f The continuation function.
+ * @return A future that resolves after the function completes.
+ */
+template <typename T, typename Func>
+auto thenInDecodeThread(
+    const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool,
+    CesiumAsync::Future<T>&& future,
+    Func&& f) {
+  if (decodeThreadPool) {
+    return std::move(future).thenInThreadPool(
+        *decodeThreadPool,
+        std::forward<Func>(f));
+  }
+  return std::move(future).thenInWorkerThread(std::forward<Func>(f));
+}
+
 /**
  * @brief Store the result of creating tile's children after
  * invoking {@link TilesetContentLoader::createTileChildren}
@@ -135,5 +211,44 @@ public:
    * @return The {@link TileChildrenResult} that stores the tile's children
    */
   virtual TileChildrenResult createTileChildren(const Tile& tile) = 0;
+
+  /**
+   * @brief Takes back the children of a tile that are being discarded.
+   *
+   * This is called when the tileset discards the children of a tile that can
+   * be recreated later with {@link createTileChildren}. Loaders that create
+   * children frequently may reuse the storage of the given children. The
+   * default implementation simply destroys them.
+   *
+   * @param children The discarded children.
+   */
+  virtual void releaseTileChildren(std::vector<Tile>&& children);
+
+  /**
+   * @brief Returns whether the children of the given tile can be discarded
+   * and created again later with {@link createTileChildren}.
+   *
+   * This is only asked about tiles whose loader is this loader. The default
+   * implementation returns false, which means the children are kept for the
+   * lifetime of the tileset.
+   *
+   * @param tile The tile whose children may be discarded.
+   * @return Whether the children of the tile can be recreated.
+   */
+  virtual bool canRecreateTileChildren(const Tile& tile) const noexcept;
+
+  /**
+   * @brief Returns whether the content of the given tile, which hasn't been
+   * loaded yet, is expected to be an external tileset.
+   *
+   * This is only asked about tiles whose loader is this loader, to decide
+   * which tiles to load ahead of time, see
+   * {@link TilesetOptions::externalTilesetPrefetchCount}. The default
+   * implementation returns false.
+   *
+   * @param tile The tile whose content isn't loaded.
+   * @return Whether the content of the tile is likely an external tileset.
+   */
+  virtual bool mayHaveExternalTileset(const Tile& tile) const noexcept;
 };
 } // namespace Cesium3DTilesSelection
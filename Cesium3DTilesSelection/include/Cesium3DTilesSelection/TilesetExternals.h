@@ -5,20 +5,28 @@
 #include "spdlog-cesium.h"
 
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/ThreadPool.h>
 
 #include <memory>
+#include <optional>
 
 namespace CesiumAsync {
 class IAssetAccessor;
+class ICacheDatabase;
 class ITaskProcessor;
 } // namespace CesiumAsync
 
+namespace CesiumGltfReader {
+class SharedImageCache;
+}
+
 namespace CesiumUtility {
 class CreditSystem;
 }
 
 namespace Cesium3DTilesSelection {
 class IPrepareRendererResources;
+class RasterOverlayTileProviderPool;
 
 /**
  * @brief External interfaces used by a {@link Tileset}.
@@ -69,6 +77,70 @@ public:
    */
   std::shared_ptr<TileOcclusionRendererProxyPool> pTileOcclusionProxyPool =
       nullptr;
+
+  /**
+   * @brief A thread pool for the CPU-heavy work of loading tiles: decoding
+   * tile content, including Draco meshes and images, transcoding KTX2 images,
+   * and upsampling tiles for raster overlays.
+   *
+   * Keeping that work out of the worker threads of the {@link asyncSystem}
+   * means that long decodes can't delay the short continuations that run
+   * there, and each can be sized for the host CPU. If not specified, the
+   * decoding runs in the worker threads, too.
+   */
+  std::optional<CesiumAsync::ThreadPool> decodeThreadPool = std::nullopt;
+
+  /**
+   * @brief A database in which to keep a compact binary skeleton of each
+   * tileset JSON that is loaded, such as a {@link CesiumAsync::SqliteCache}.
+   *
+   * The skeleton holds the tile hierarchy that was created from the JSON, and
+   * is stored with the `ETag` of the JSON's response. When a later response
+   * has the same `ETag`, the tiles are created from the skeleton instead of
+   * by parsing the JSON again, which is much faster for large tilesets. If not
+   * specified, the JSON is always parsed.
+   */
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pTilesetSkeletonCache =
+      nullptr;
+
+  /**
+   * @brief A database in which to keep the responses of the Cesium ion
+   * endpoint API, such as a {@link CesiumAsync::SqliteCache}.
+   *
+   * The response of an asset's endpoint gives the URL of its tileset and the
+   * access token to load it with. When a response from an earlier session is
+   * still in the database, a tileset of that asset starts loading right away
+   * instead of waiting for the API, and the endpoint is requested again in
+   * the background before its access token expires. Responses are kept for
+   * an hour, which is about as long as their access tokens are valid. If not
+   * specified, the endpoint is requested on every startup.
+   */
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pIonEndpointCache = nullptr;
+
+  /**
+   * @brief A pool of raster overlay tile providers to share between the
+   * tilesets that use these externals.
+   *
+   * When the same {@link CesiumRasterOverlays::RasterOverlay} is added to the
+   * overlays of several of those tilesets, they share one tile provider, with
+   * its cache of images and its throttling of loads, instead of each loading
+   * the same images. If not specified, each tileset creates its own tile
+   * providers.
+   */
+  std::shared_ptr<RasterOverlayTileProviderPool>
+      pRasterOverlayTileProviderPool = nullptr;
+
+  /**
+   * @brief A cache of the external images of the glTF content of tiles, to
+   * share between the tilesets that use these externals.
+   * Each image that tiles refer to by URL is then only fetched and decoded
+   * once, however many tiles refer to it, and the image in each tile's model
+   * has the same {@link CesiumGltfReader::SharedImage::key} in its extras, so
+   * that the renderer can share its texture. If not specified, each tile
+   * fetches and decodes its own images.
+   */
+  std::shared_ptr<CesiumGltfReader::SharedImageCache> pSharedImageCache =
+      nullptr;
 };
 
 } // namespace Cesium3DTilesSelection
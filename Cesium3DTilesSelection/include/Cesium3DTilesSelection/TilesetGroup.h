@@ -0,0 +1,138 @@
+#pragma once
+
+#include "Library.h"
+#include "ViewState.h"
+#include "ViewUpdateResult.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class Tileset;
+
+/**
+ * @brief Options for a {@link TilesetGroup}.
+ */
+struct CESIUM3DTILESSELECTION_API TilesetGroupOptions {
+  /**
+   * @brief The maximum number of tiles that may be loaded at once by all of the
+   * tilesets in the group together.
+   *
+   * This takes the place of
+   * {@link TilesetOptions::maximumSimultaneousTileLoads} of each tileset.
+   */
+  uint32_t maximumSimultaneousTileLoads = 20;
+
+  /**
+   * @brief The maximum number of bytes that may be cached by all of the
+   * tilesets in the group together.
+   *
+   * This takes the place of {@link TilesetOptions::maximumCachedBytes} of each
+   * tileset. When the group is over budget, the tilesets that use the most
+   * memory unload their cached tiles first.
+   */
+  int64_t maximumCachedBytes = 512 * 1024 * 1024;
+};
+
+/**
+ * @brief A group of tilesets that are shown in the same scene, which share
+ * their tile loads and their memory budget.
+ *
+ * Each tileset selects its tiles as usual, but instead of loading them and
+ * unloading cached tiles on its own, the group loads the most important tiles
+ * of all the tilesets together, and keeps the cached tiles of all of them
+ * within one budget. To keep one heavy tileset from starving the others, the
+ * most important load of each tileset always comes first.
+ *
+ * The group does not own its tilesets. A tileset leaves its group when it's
+ * destroyed, and the tilesets of a group leave it when the group is destroyed.
+ */
+class CESIUM3DTILESSELECTION_API TilesetGroup final {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param options The options for the group.
+   */
+  explicit TilesetGroup(
+      const TilesetGroupOptions& options = TilesetGroupOptions());
+
+  /**
+   * @brief Destroys the group, and removes its tilesets from it.
+   */
+  ~TilesetGroup() noexcept;
+
+  TilesetGroup(const TilesetGroup& rhs) = delete;
+  TilesetGroup& operator=(const TilesetGroup& rhs) = delete;
+
+  /**
+   * @brief Gets the options of this group.
+   */
+  const TilesetGroupOptions& getOptions() const noexcept {
+    return this->_options;
+  }
+
+  /** @copydoc TilesetGroup::getOptions() const */
+  TilesetGroupOptions& getOptions() noexcept { return this->_options; }
+
+  /**
+   * @brief Adds a tileset to this group, removing it from any other group it
+   * is in.
+   */
+  void addTileset(Tileset& tileset);
+
+  /**
+   * @brief Removes a tileset from this group. It loads and unloads its tiles
+   * on its own again.
+   */
+  void removeTileset(Tileset& tileset) noexcept;
+
+  /**
+   * @brief Gets the tilesets in this group, in the order they were added.
+   */
+  const std::vector<Tileset*>& getTilesets() const noexcept {
+    return this->_tilesets;
+  }
+
+  /**
+   * @brief Updates the view of every tileset in this group, then loads and
+   * unloads the tiles of all of them together.
+   *
+   * This is the same as calling {@link Tileset::updateView} on each tileset
+   * with the same views, followed by {@link updateLoads}.
+   *
+   * @param frustums The {@link ViewState}s that the view should be updated for.
+   * @param deltaTime The amount of time that has passed since the last call to
+   * updateView, in seconds.
+   * @returns The results of the tilesets, in the same order as
+   * {@link getTilesets}. They are only valid until the next update of the
+   * tilesets, or until they are destroyed.
+   */
+  const std::vector<const ViewUpdateResult*>&
+  updateView(const std::vector<ViewState>& frustums, float deltaTime = 0.0f);
+
+  /**
+   * @brief Loads the tiles that the tilesets in this group need, and unloads
+   * cached tiles until the group is within its memory budget.
+   *
+   * Call this once per frame after updating the views of all of the tilesets,
+   * if they are updated individually, for example with different views.
+   */
+  void updateLoads();
+
+  /**
+   * @brief Gets the total number of bytes of tile and raster overlay data that
+   * are currently loaded by all of the tilesets in this group.
+   */
+  int64_t getTotalDataBytes() const noexcept;
+
+private:
+  void _processWorkerThreadLoadQueues();
+  void _unloadCachedTiles();
+
+  TilesetGroupOptions _options;
+  std::vector<Tileset*> _tilesets;
+  std::vector<const ViewUpdateResult*> _results;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -2,8 +2,15 @@
 
 #include "Library.h"
 
+#include <Cesium3DTilesContent/DecodedModelCache.h>
+#include <Cesium3DTilesContent/GltfModelCache.h>
+#include <CesiumAsync/AdaptiveConcurrencyLimit.h>
 #include <CesiumGltf/Ktx2TranscodeTargets.h>
+#include <CesiumGltf/PropertyTableFilter.h>
+#include <CesiumGltfContent/VertexLayout.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -12,6 +19,7 @@
 
 namespace Cesium3DTilesSelection {
 
+class ITileEvictionPolicy;
 class ITileExcluder;
 class TilesetLoadFailureDetails;
 
@@ -28,6 +36,21 @@ struct CESIUM3DTILESSELECTION_API TilesetContentOptions {
    */
   bool enableWaterMask = false;
 
+  /**
+   * @brief Whether to add skirts to the meshes of terrain tiles.
+   *
+   * Skirts hide the cracks between neighboring tiles of different levels of
+   * detail. If this is false, the skirt vertices and triangles are left out of
+   * the meshes, which makes them smaller, and the renderer is expected to
+   * generate the skirts itself, for example in a shader. The vertices on each
+   * edge of a tile, and the height of its skirts, are then listed in the
+   * {@link CesiumGltfContent::SkirtMeshMetadata} in the extras of the
+   * primitives.
+   *
+   * Currently only applicable for quantized-mesh tilesets.
+   */
+  bool bakeSkirts = true;
+
   /**
    * @brief Whether to generate smooth normals when normals are missing in the
    * original Gltf.
@@ -40,12 +63,167 @@ struct CESIUM3DTILESSELECTION_API TilesetContentOptions {
    */
   bool generateMissingNormalsSmooth = false;
 
+  /**
+   * @brief Whether to reorder the triangles and vertices of the loaded meshes
+   * so that they render faster on the GPU.
+   *
+   * This costs some time on the worker thread for each loaded tile. See
+   * {@link CesiumGltfContent::GltfUtilities::optimizeMeshes}.
+   */
+  bool optimizeMeshes = false;
+
+  /**
+   * @brief How much the meshes of the loaded tiles may be simplified, as a
+   * fraction of the geometric error of each tile.
+   *
+   * When this is greater than 0, the meshes of a tile are simplified in the
+   * worker thread that loads it, so that the surface moves by at most this
+   * factor times the tile's geometric error. This helps tilesets whose
+   * tiles are far denser than their geometric error needs, such as those
+   * converted from CAD models. Leaf tiles, whose geometric error is usually
+   * 0, keep their full detail. The simplified meshes replace the loaded ones,
+   * so they are kept with the tile's content. See
+   * {@link CesiumGltfContent::GltfUtilities::simplifyMeshes}.
+   */
+  double meshSimplificationFactor = 0.0;
+
+  /**
+   * @brief Whether to merge the primitives of the loaded meshes that can be
+   * drawn together, so that each tile takes fewer draw calls.
+   *
+   * See {@link CesiumGltfContent::GltfUtilities::mergePrimitives}.
+   */
+  bool mergePrimitives = false;
+
+  /**
+   * @brief Whether to reorder the points of the loaded point clouds by level
+   * of detail, so that drawing only a part of them still covers the whole
+   * tile.
+   *
+   * A renderer can then draw a number of points proportional to how much the
+   * tile's screen-space error is below the maximum, instead of all of them.
+   * See {@link CesiumGltfContent::GltfUtilities::orderPointsForLevelOfDetail}.
+   * The geometric error of each tile, which can also be used to attenuate the
+   * size of its points, is in the `Cesium3DTiles_GeometricError` property of
+   * the extras of the loaded model.
+   */
+  bool orderPointsForLevelOfDetail = false;
+
+  /**
+   * @brief A filter to evaluate for the features of each property table of
+   * the loaded tiles.
+   *
+   * The result is computed on the worker thread that loads a tile and is
+   * stored in {@link TileLoadResult::featureMasks}, so that it is ready when
+   * {@link IPrepareRendererResources::prepareInLoadThread} is called.
+   */
+  std::optional<CesiumGltf::PropertyTableFilter> featureFilter;
+
+  /**
+   * @brief Whether to build the {@link TileTriangleIndex} of each loaded tile
+   * in the worker thread that loads it.
+   *
+   * Otherwise the index is built in the main thread the first time that
+   * {@link Tileset::intersectRay} or {@link Tileset::sampleHeightMostDetailed}
+   * needs it. This must be true for those to work when
+   * {@link TilesetOptions::releaseGltfDataAfterUpload} is set, because the
+   * positions are no longer available by then.
+   */
+  bool buildTriangleIndex = false;
+
+  /**
+   * @brief The layout to pack the vertices and indices of each loaded tile in,
+   * in the worker thread that loads it.
+   *
+   * The packed primitives are stored in
+   * {@link TileLoadResult::packedPrimitives}, so that
+   * {@link IPrepareRendererResources::prepareInLoadThread} can upload them as
+   * they are instead of converting the glTF accessors itself. See
+   * {@link CesiumGltfContent::VertexLayout::packModel}. Set
+   * {@link TilesetOptions::releaseGltfDataAfterUpload} to also free the glTF
+   * buffers once the renderer resources have been created.
+   */
+  std::optional<CesiumGltfContent::VertexLayout> vertexLayout;
+
+  /**
+   * @brief How many levels above the bottom of a subtree of an implicit
+   * tileset a tile must be for the loading of its content to also start
+   * loading the child subtrees below it.
+   *
+   * The child subtrees are otherwise only loaded when the tiles at their roots
+   * are loaded, which delays those tiles by a request. Only child subtrees
+   * that the subtree marks as available are loaded. Set this to 0 to disable
+   * prefetching child subtrees.
+   */
+  uint32_t subtreePrefetchLevels = 1;
+
+  /**
+   * @brief The largest number of subtrees of an implicit tileset that may be
+   * loading at once for a prefetch, see {@link subtreePrefetchLevels}.
+   *
+   * Subtrees that are needed to load a tile are always loaded. Prefetched
+   * subtrees are requested at a lower priority than any tile.
+   */
+  uint32_t maximumSimultaneousSubtreeLoads = 4;
+
+  /**
+   * @brief Whether to create the tiles of a tileset JSON only when they are
+   * needed.
+   *
+   * Otherwise all tiles of a tileset JSON are created when it is loaded, which
+   * takes a long time and a lot of memory for a tileset JSON with millions of
+   * tiles. If this is true, only the root tile is created up front, and the
+   * children of each tile are created from the JSON, which is kept in memory,
+   * the first time that the tile is visited. Children that haven't been visited
+   * for a while may then be discarded again, see
+   * {@link TilesetOptions::enableSubtreePruning}. The
+   * {@link TilesetExternals::pTilesetSkeletonCache} isn't used in this case.
+   */
+  bool createChildTilesLazily = false;
+
+  /**
+   * @brief Whether to start fetching the content of the root tile of a
+   * tileset JSON, and of the children of that tile, as soon as the JSON is
+   * parsed.
+   *
+   * Otherwise the requests for their content only start when the first
+   * traversal of the tileset selects them to be loaded, one frame or more
+   * after the JSON is parsed. This shortens the time to the first tiles that
+   * are shown, at the cost of content that is fetched but might not be
+   * needed, such as children that turn out to be outside of the view. Content
+   * that was fetched early is used by the first load of its tile, as long as
+   * the tile is loaded with the same request headers.
+   */
+  bool prefetchRootTileContent = false;
+
+  /**
+   * @brief Whether to only fetch the content of tiles, without decoding it.
+   *
+   * This is for a tileset whose tiles are fetched to fill a cache, such as
+   * with {@link Tileset::fetchRegion}, rather than rendered. The loaders still
+   * parse what they need to create the children of tiles (external tilesets,
+   * the subtrees of implicit tilesets, and the availability of quantized-mesh
+   * terrain), but the other content is left as it was fetched, and the tiles
+   * get empty content, so no renderer resources are prepared for them. The
+   * images and buffers that glTF content refers to aren't fetched.
+   */
+  bool skipContentDecoding = false;
+
   /**
    * @brief For each possible input transmission format, this struct names
    * the ideal target gpu-compressed pixel format to transcode to.
    */
   CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets;
 
+  /**
+   * @brief The largest width or height of a texture of tile content, or 0 to
+   * load textures at their full size.
+   *
+   * Larger textures are reduced while they are loaded. See
+   * {@link CesiumGltfReader::GltfReaderOptions::maximumTextureSize}.
+   */
+  int32_t maximumTextureSize = 0;
+
   /**
    * @brief Whether or not to transform texture coordinates during load when
    * textures have the `KHR_texture_transform` extension. Set this to false if
@@ -53,6 +231,63 @@ struct CESIUM3DTILESSELECTION_API TilesetContentOptions {
    * shader.
    */
   bool applyTextureTransform = true;
+
+  /**
+   * @brief Whether to convert the batch tables of b3dm and pnts tiles to the
+   * `EXT_structural_metadata` extension.
+   *
+   * Set this to false when the metadata of these tiles isn't needed, such as
+   * when a tileset is only rendered. Their batch tables are then not even
+   * parsed, which saves the time and memory of converting them. Feature IDs are
+   * left in the `_BATCHID` attribute.
+   */
+  bool convertBatchTables = true;
+
+  /**
+   * @brief Whether to keep the quantized positions and oct-encoded normals of
+   * pnts tiles as they are, instead of decoding them to floats.
+   *
+   * This saves the time of decoding them and most of the memory they use, but
+   * the renderer must support the `KHR_mesh_quantization` extension and
+   * decode the normals in its shaders. See
+   * {@link Cesium3DTilesContent::AssetFetcher::keepPointCloudsQuantized}.
+   */
+  bool keepPointCloudsQuantized = false;
+
+  /**
+   * @brief A cache of the models instanced by i3dm tiles, so that the tiles
+   * that instance the same model only parse and decode it once.
+   *
+   * This is empty by default. A cache can be shared by tilesets with the same
+   * content options. See {@link Cesium3DTilesContent::GltfModelCache}.
+   */
+  std::shared_ptr<Cesium3DTilesContent::GltfModelCache> pGltfModelCache;
+
+  /**
+   * @brief A cache of the models converted from the content of tiles, so that
+   * content that is loaded again, even by another run of the application, is
+   * read back instead of being decoded and converted again.
+   *
+   * This is empty by default. The cache is usually stored in the same
+   * database as the responses of a {@link CesiumAsync::CachingAssetAccessor}.
+   * It only covers the conversion of the content, so the post-processing that
+   * the other content options ask for, such as generating normals, is still
+   * done for each load. See {@link Cesium3DTilesContent::DecodedModelCache}.
+   */
+  std::shared_ptr<Cesium3DTilesContent::DecodedModelCache> pDecodedModelCache;
+
+  /**
+   * @brief The number of models upsampled from parent tiles, for raster
+   * overlays or for terrain without more detailed tiles, that each tileset
+   * keeps after the tiles that use them are unloaded.
+   *
+   * When such a tile is loaded again, its model is copied from the cache
+   * instead of being upsampled from its parent again, which helps when the
+   * camera moves back and forth over the same area. The cached models are not
+   * counted in {@link Tileset::getTotalDataBytes}. The default of 0 disables
+   * the cache.
+   */
+  size_t maximumCachedUpsampledModels = 0;
 };
 
 /**
@@ -69,6 +304,112 @@ struct CESIUM3DTILESSELECTION_API FogDensityAtHeight {
   double fogDensity;
 };
 
+/**
+ * @brief Options for relaxing the screen-space error of tiles away from the
+ * center of each view.
+ *
+ * @see TilesetOptions::foveatedScreenSpaceError
+ */
+struct CESIUM3DTILESSELECTION_API FoveatedScreenSpaceErrorOptions {
+  /**
+   * @brief The size of the cone around the view direction within which tiles
+   * are refined to the full level-of-detail.
+   *
+   * This is a fraction of the angle between the view direction and the
+   * corners of the view, between 0.0 and 1.0. Beyond the cone, the
+   * screen-space error of tiles falls off linearly until it reaches
+   * {@link minimumScreenSpaceErrorFactor} at the corners of the view.
+   */
+  double coneSize = 0.25;
+
+  /**
+   * @brief The factor, between 0.0 and 1.0, by which the screen-space error of
+   * tiles at the edges of the view is multiplied.
+   *
+   * A value of 0.5 lets tiles in the periphery of the view have twice the
+   * {@link TilesetOptions::maximumScreenSpaceError} before they are refined.
+   */
+  double minimumScreenSpaceErrorFactor = 0.5;
+};
+
+/**
+ * @brief Options for adjusting the screen-space error of a {@link Tileset}
+ * every frame to stay within a budget.
+ *
+ * Each budget is optional; the screen-space error is governed by whichever
+ * of the given budgets is most used. If no budget is given, the screen-space
+ * error stays at its initial value.
+ *
+ * @see TilesetOptions::screenSpaceErrorGovernor
+ */
+struct CESIUM3DTILESSELECTION_API ScreenSpaceErrorGovernorOptions {
+  /**
+   * @brief The maximum number of tiles to render each frame.
+   */
+  std::optional<uint32_t> maximumTilesRendered;
+
+  /**
+   * @brief The maximum number of bytes of tile and raster overlay data to keep
+   * loaded, as reported by {@link Tileset::getTotalDataBytes}.
+   */
+  std::optional<int64_t> maximumDataBytes;
+
+  /**
+   * @brief The maximum number of tiles to be loading at once.
+   */
+  std::optional<int32_t> maximumTilesLoading;
+
+  /**
+   * @brief The smallest screen-space error the governor may choose.
+   */
+  double minimumScreenSpaceError = 16.0;
+
+  /**
+   * @brief The largest screen-space error the governor may choose.
+   */
+  double maximumScreenSpaceError = 64.0;
+
+  /**
+   * @brief How quickly the screen-space error changes, as a fraction of its
+   * current value per frame.
+   */
+  double adjustmentRate = 0.05;
+
+  /**
+   * @brief The fraction of each budget below which the screen-space error is
+   * lowered again.
+   *
+   * The screen-space error is raised while any budget is exceeded, and lowered
+   * while all budgets are used less than this fraction. In between, it is left
+   * unchanged, so that it does not oscillate around a budget.
+   */
+  double recoveryThreshold = 0.9;
+};
+
+/**
+ * @brief How the tiles that are waiting to be loaded are ordered.
+ *
+ * @see TilesetOptions::tileLoadPriorityMode
+ */
+enum class TileLoadPriorityMode {
+  /**
+   * @brief Tiles that are closer to the camera and to the center of the view
+   * are loaded first.
+   */
+  Distance,
+
+  /**
+   * @brief Tiles that reduce the screen-space error the most, over the largest
+   * part of the view, are loaded first.
+   *
+   * The screen-space error that a tile reduces is the one of its parent, which
+   * is rendered or would be rendered in its place. Tiles with no renderable
+   * ancestor, which would leave a hole in the view until they're loaded, are
+   * loaded before all others.
+   */
+  ScreenSpaceErrorDeficit
+};
+
 /**
  * @brief Additional options for configuring a {@link Tileset}.
  */
@@ -94,12 +435,112 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   double maximumScreenSpaceError = 16.0;
 
+  /**
+   * @brief Relaxes the screen-space error of tiles away from the center of
+   * each view, if set.
+   *
+   * Tiles near the view direction are refined to the full
+   * {@link maximumScreenSpaceError}, while tiles in the periphery stop
+   * refining earlier. This reduces the number of tiles that are loaded and
+   * rendered for wide fields of view and head-mounted displays, where the
+   * periphery is rarely looked at directly.
+   *
+   * By default, the screen-space error is the same across the whole view.
+   */
+  std::optional<FoveatedScreenSpaceErrorOptions> foveatedScreenSpaceError;
+
+  /**
+   * @brief Adjusts the maximum screen-space error every frame to keep the
+   * tileset within a budget, if set.
+   *
+   * This replaces tuning {@link maximumScreenSpaceError} by hand for each
+   * device. While set, the tileset raises the maximum screen-space error when
+   * a budget is exceeded and lowers it again when there is room, within the
+   * configured range. {@link maximumScreenSpaceError} is then only the
+   * starting value. The value chosen for each frame is reported in
+   * {@link ViewUpdateResult::maximumScreenSpaceError}.
+   */
+  std::optional<ScreenSpaceErrorGovernorOptions> screenSpaceErrorGovernor;
+
   /**
    * @brief The maximum number of tiles that may simultaneously be in the
    * process of loading.
+   *
+   * If {@link maximumSimultaneousTileDecodes} is set, this only limits the
+   * tiles that are fetching their content. Tiles that are decoding it, or
+   * waiting to, don't count.
+   *
+   * This is ignored while the tileset is in a {@link TilesetGroup}, see
+   * {@link TilesetGroupOptions::maximumSimultaneousTileLoads}.
    */
   uint32_t maximumSimultaneousTileLoads = 20;
 
+  /**
+   * @brief The maximum number of tiles that may simultaneously decode and
+   * post-process their content, or 0 for no separate limit.
+   *
+   * This stage covers everything after the content is fetched: parsing the
+   * tile format and glTF, decoding meshes and images, and
+   * {@link IPrepareRendererResources::prepareInLoadThread}. Tiles whose content
+   * arrives while the limit is reached wait for another tile to finish.
+   *
+   * Use a limit close to the number of worker threads when the content comes
+   * from a fast local cache and loading is bound by the CPU. A larger
+   * {@link maximumSimultaneousTileLoads} then keeps more requests outstanding
+   * on slow networks without oversubscribing the CPU.
+   */
+  uint32_t maximumSimultaneousTileDecodes = 0;
+
+  /**
+   * @brief Adapts the number of tiles that may simultaneously be loading to
+   * the latency and throughput of their requests, or `std::nullopt` to always
+   * use {@link maximumSimultaneousTileLoads}.
+   *
+   * A fixed limit is a guess: a fast connection could serve many more
+   * requests at once, while on a slow one too many requests delay the ones
+   * that matter most. While set, {@link maximumSimultaneousTileLoads} is only
+   * the starting value, and
+   * {@link TilesetContentOptions::maximumSimultaneousSubtreeLoads} is scaled
+   * by the same factor as the adapted limit. The limits used in each frame are
+   * reported in the {@link ViewUpdateResult}.
+   *
+   * As with {@link maximumSimultaneousTileLoads}, this is ignored while the
+   * tileset is in a {@link TilesetGroup}.
+   */
+  std::optional<CesiumAsync::AdaptiveConcurrencyLimitOptions>
+      adaptiveLoadConcurrency;
+
+  /**
+   * @brief How the tiles that are waiting to be loaded are ordered.
+   *
+   * With {@link TileLoadPriorityMode::Distance}, far-away tiles that are
+   * badly under-refined wait behind nearby tiles that are almost good enough.
+   * {@link TileLoadPriorityMode::ScreenSpaceErrorDeficit} reaches an
+   * acceptable quality sooner after the camera jumps to a new location.
+   */
+  TileLoadPriorityMode tileLoadPriorityMode = TileLoadPriorityMode::Distance;
+
+  /**
+   * @brief Whether to cancel the loads of tiles that are no longer needed.
+   *
+   * When this is true, a tile that is still loading but that the traversal
+   * did not ask for in the current frame has the rest of its load canceled.
+   * Its response is not decoded and no renderer resources are prepared for it.
+   * This saves a lot of work while the camera moves quickly, at the cost of
+   * requesting the tile again if it becomes needed soon after.
+   */
+  bool cancelUnneededTileLoads = true;
+
+  /**
+   * @brief Whether to measure the time spent in each phase of
+   * {@link Tileset::updateView}, which is reported in the
+   * {@link ViewUpdateResult}.
+   *
+   * Measuring reads the clock a few times per frame, which is cheap but not
+   * free, so it's off by default.
+   */
+  bool measureViewUpdateTimes = false;
+
   /**
    * @brief The maximum number of subtrees that may simultaneously be in the
    * process of loading.
@@ -122,6 +563,21 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   bool preloadSiblings = true;
 
+  /**
+   * @brief The number of external tilesets whose JSON is loaded before it is
+   * needed.
+   *
+   * When a tile is rendered without being refined, its children aren't
+   * loaded, so the JSON of any external tileset among them, such as one of
+   * the blocks of a city that each have their own tileset JSON, is only
+   * requested once the tile is refined. If this is greater than 0, up to this
+   * number of the children of rendered tiles that refer to an external
+   * tileset are loaded each frame, nearest to the views first, at the lowest
+   * priority. The loads run in parallel like any others, up to
+   * {@link maximumSimultaneousTileLoads}.
+   */
+  uint32_t externalTilesetPrefetchCount = 0;
+
   /**
    * @brief The number of loading descendant tiles that is considered "too
    * many". If a tile has too many loading descendants, that tile will be loaded
@@ -147,6 +603,48 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   bool forbidHoles = false;
 
+  /**
+   * @brief Skip levels of detail when refining replace-refined tiles.
+   *
+   * Normally, every level between the root and the tiles that meet the
+   * {@link maximumScreenSpaceError} is loaded on the way down. With this
+   * enabled, once a tile meets the {@link baseScreenSpaceError}, only the
+   * tiles that meet the maximum screen-space error and a few levels in between
+   * them are loaded, see {@link skipLevels} and
+   * {@link skipScreenSpaceErrorFactor}. The loaded ancestors are rendered in
+   * place of tiles that are not loaded yet. This greatly reduces the number of
+   * tiles that are loaded on deep tilesets, at the cost of coarser fallbacks
+   * while the camera moves.
+   */
+  bool skipLevelOfDetail = false;
+
+  /**
+   * @brief The screen-space error that a tile must meet before levels of
+   * detail below it are skipped, see {@link skipLevelOfDetail}.
+   *
+   * Tiles with a larger screen-space error are always loaded, so that the
+   * whole tileset can be rendered at this coarse level of detail.
+   */
+  double baseScreenSpaceError = 1024.0;
+
+  /**
+   * @brief The minimum number of levels to skip when loading tiles with
+   * {@link skipLevelOfDetail}.
+   *
+   * A tile is only loaded as a fallback if it's more than this many levels
+   * below its nearest loaded ancestor.
+   */
+  uint32_t skipLevels = 1;
+
+  /**
+   * @brief The factor by which the screen-space error must shrink before a
+   * tile is loaded as a fallback with {@link skipLevelOfDetail}.
+   *
+   * A tile is only loaded as a fallback if its screen-space error is smaller
+   * than that of its nearest loaded ancestor divided by this factor.
+   */
+  double skipScreenSpaceErrorFactor = 16.0;
+
   /**
    * @brief Enable culling of tiles against the frustum.
    */
@@ -168,11 +666,42 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   bool delayRefinementForOcclusion = true;
 
+  /**
+   * @brief Enable culling of tiles that are hidden behind the ground, found
+   * without waiting for the renderer.
+   *
+   * The tiles that were rendered in the last frame are rasterized into a
+   * coarse depth buffer for each view, and tiles that are entirely behind them
+   * are culled in the same frame. Each rendered tile with a bounding region
+   * occludes with the solid ground below the region's minimum height, so
+   * this is only correct for tilesets whose tiles cover their whole bounding
+   * region, such as terrain, and while the camera is above the ground.
+   *
+   * This has no effect while {@link enableLodTransitionPeriod} is true.
+   */
+  bool enableSoftwareOcclusionCulling = false;
+
+  /**
+   * @brief The width, in pixels, of the depth buffer used by
+   * {@link enableSoftwareOcclusionCulling}. Its height follows from the
+   * aspect ratio of the view.
+   */
+  uint32_t softwareOcclusionBufferWidth = 128;
+
   /**
    * @brief Enable culling of tiles that cannot be seen through atmospheric fog.
    */
   bool enableFogCulling = true;
 
+  /**
+   * @brief Enable culling of tiles that are hidden below the horizon of the
+   * globe.
+   *
+   * Only tiles with bounding regions or S2 cell bounding volumes are culled,
+   * and never when the camera is below the surface of the ellipsoid.
+   */
+  bool enableHorizonCulling = true;
+
   /**
    * @brief Whether culled tiles should be refined until they meet
    * culledScreenSpaceError.
@@ -202,9 +731,59 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    * total number of loaded bytes is greater than this value, tiles will be
    * unloaded until the total is under this number or until only required tiles
    * remain, whichever comes first.
+   *
+   * The total is the one reported by {@link Tileset::getTotalDataBytes}.
+   *
+   * This is ignored while the tileset is in a {@link TilesetGroup}, see
+   * {@link TilesetGroupOptions::maximumCachedBytes}.
    */
   int64_t maximumCachedBytes = 512 * 1024 * 1024;
 
+  /**
+   * @brief Decides which cached tiles are unloaded first when the total size
+   * of the loaded data is greater than {@link maximumCachedBytes}.
+   *
+   * If nullptr, the least recently used tiles are unloaded first.
+   */
+  std::shared_ptr<ITileEvictionPolicy> evictionPolicy;
+
+  /**
+   * @brief The maximum number of bytes of unloaded tile content to keep in
+   * memory, compressed, or 0 to keep none.
+   *
+   * When a tile is unloaded, for example because the tileset uses more than
+   * {@link maximumCachedBytes}, its post-processed glTF is compressed in a
+   * worker thread and kept. If the tile is needed again, its content is
+   * decompressed instead of being requested and decoded again, and only the
+   * renderer resources are prepared again. Once the compressed content takes
+   * more than this many bytes, the tiles that were unloaded longest ago are
+   * dropped.
+   *
+   * The content of tiles whose glTF data was released, see
+   * {@link releaseGltfDataAfterUpload}, can't be kept. These bytes are not
+   * part of {@link Tileset::getTotalDataBytes}.
+   */
+  int64_t maximumHibernatedBytes = 0;
+
+  /**
+   * @brief Whether to free the glTF buffer and image data of a tile once its
+   * renderer resources have been prepared in the main thread.
+   *
+   * The rest of the glTF, such as its accessors, materials, metadata and the
+   * bounds of its primitives, is kept. Use this only if the renderer doesn't
+   * need the glTF data after
+   * {@link IPrepareRendererResources::prepareInMainThread}, for example for
+   * picking or height queries. The data of tiles with raster overlays is
+   * always kept, because their children may be upsampled from it.
+   *
+   * Once a tile finishes loading while the tileset has raster overlays, the
+   * data of every tile loaded after it is kept too, so that overlays can be
+   * removed and added again without reloading tiles. Tiles that released
+   * their data before are reloaded when an overlay that needs new texture
+   * coordinates is added.
+   */
+  bool releaseGltfDataAfterUpload = false;
+
   /**
    * @brief A table that maps the camera height above the ellipsoid to a fog
    * density. Tiles that are in full fog are culled. The density of the fog
@@ -276,6 +855,18 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   float lodTransitionLength = 1.0f;
 
+  /**
+   * @brief Whether to report the changes to the render list in each
+   * {@link ViewUpdateResult}.
+   *
+   * If this is true, {@link ViewUpdateResult::tilesAddedToRenderList} and
+   * {@link ViewUpdateResult::tilesRemovedFromRenderList} list the tiles that
+   * joined and left {@link ViewUpdateResult::tilesToRenderThisFrame} since
+   * the previous frame, so that a client can update its scene without
+   * comparing the whole render lists itself.
+   */
+  bool reportRenderListChanges = false;
+
   /**
    * @brief Whether to kick descendants while a tile is still fading in.
    *
@@ -305,6 +896,166 @@ struct CESIUM3DTILESSELECTION_API TilesetOptions {
    */
   double tileCacheUnloadTimeLimit = 0.0;
 
+  /**
+   * @brief A soft limit on how long (in milliseconds) to spend on all of the
+   * deferrable main-thread work of the tileset each frame (each call to
+   * Tileset::updateView). A value of 0.0 indicates that there is no such limit.
+   *
+   * When set, this takes the place of {@link mainThreadLoadingTimeLimit} and
+   * {@link tileCacheUnloadTimeLimit}, and also covers attaching raster overlay
+   * tiles and dispatching main-thread continuations, such as those of
+   * completed tile and raster overlay loads. The work is done in order of
+   * importance: attaching raster overlays to the tiles being visited, the
+   * main-thread part of tile loading in tile priority order, unloading cached
+   * tiles, and then the continuations. Work that doesn't fit is carried over to
+   * the next frame. Each kind of work except raster attachment makes at least
+   * a little progress every frame, even when the budget is used up.
+   *
+   * This avoids long frames when many tiles finish loading at once.
+   */
+  double mainThreadTimeLimit = 0.0;
+
+  /**
+   * @brief The largest number of tiles whose main-thread loading is done with
+   * each call to {@link IPrepareRendererResources::prepareInMainThreadBatch},
+   * or 0 to prepare each tile with its own call to
+   * {@link IPrepareRendererResources::prepareInMainThread}.
+   *
+   * When this is greater than zero, the tiles that are ready are prepared in
+   * batches of up to this many at the end of each Tileset::updateView, and
+   * the main-thread time limits are checked after each batch rather than
+   * after each tile. The raster overlay tiles attached during the update are
+   * also passed to a single call to
+   * {@link IPrepareRendererResources::attachRasterInMainThreadBatch}. This
+   * lets a renderer amortize the cost of each upload or scene change.
+   */
+  uint32_t mainThreadPreparationBatchSize = 0;
+
+  /**
+   * @brief Whether to evaluate the children of large tiles in worker threads
+   * during tile selection.
+   *
+   * When enabled, and a tile being refined has at least
+   * {@link parallelTraversalMinimumChildren} children, the view-dependent
+   * work for those children (distance computation, frustum and fog culling,
+   * and screen-space error) is shared between the calling thread and the
+   * worker threads of the tileset's {@link CesiumAsync::AsyncSystem}. The
+   * calling thread evaluates any children that no worker has started on, so
+   * it never waits for tasks that are still queued. Content updates, tile
+   * excluders, and the recursive selection itself still run in the calling
+   * thread, and the children are visited in their original order, so tiles
+   * are selected, and ordered for unloading, as with this option disabled.
+   *
+   * This is most effective for tilesets with very wide levels, such as
+   * city-scale photogrammetry with hundreds of children under the root.
+   */
+  bool enableParallelTraversal = false;
+
+  /**
+   * @brief The minimum number of children a tile must have for those children
+   * to be evaluated in worker threads.
+   *
+   * Only applicable when {@link enableParallelTraversal} is true. Dispatching
+   * work to other threads has a fixed cost, so narrow tiles are better
+   * evaluated in the calling thread.
+   */
+  uint32_t parallelTraversalMinimumChildren = 128;
+
+  /**
+   * @brief Whether to reuse the view-dependent evaluation of tiles across
+   * frames while the views don't change.
+   *
+   * When enabled, the distances, frustum and fog visibility, screen-space
+   * error, and load priority computed for each visited tile are kept with the
+   * tile, and reused by subsequent calls to {@link Tileset::updateView} for as
+   * long as every view stays within
+   * {@link viewEvaluationCachePositionTolerance} of the views they were
+   * computed with and the tile's bounding volume, geometric error,
+   * refinement, and children are unchanged. Changes to the culling and
+   * screen-space error options take effect immediately.
+   *
+   * This substantially reduces the cost of tile selection when the camera is
+   * idle, which is common in kiosk-style applications.
+   */
+  bool enableViewEvaluationCaching = false;
+
+  /**
+   * @brief How far, in meters, a camera may move away from the position at
+   * which cached tile evaluations were computed before they are discarded.
+   *
+   * Only applicable when {@link enableViewEvaluationCaching} is true. With the
+   * default of 0.0, cached evaluations are only reused while the camera
+   * position is exactly unchanged. A larger value lets a slowly moving camera
+   * reuse evaluations at the cost of small inaccuracies in culling and
+   * level-of-detail selection. The camera orientation, field of view, and
+   * viewport size must always be unchanged.
+   */
+  double viewEvaluationCachePositionTolerance = 0.0;
+
+  /**
+   * @brief Whether to select tiles for a pair of views, such as the two eyes
+   * of a stereo headset, with a single view that contains both.
+   *
+   * When enabled, each pair of consecutive views passed to
+   * {@link Tileset::updateView} that look in nearly the same direction with
+   * the same field of view, and whose positions are no more than
+   * {@link maximumStereoViewSeparation} apart, is replaced by one view. It is
+   * placed just behind the midpoint of the two, so that its frustum contains
+   * both of theirs. This halves the culling and screen-space error work of
+   * the traversal.
+   *
+   * Because the combined view is slightly farther from every tile than the
+   * nearer of the two, its screen-space errors are slightly smaller. For an
+   * eye separation of a few centimeters the difference is negligible except
+   * for tiles right in front of the camera.
+   */
+  bool combineStereoViews = false;
+
+  /**
+   * @brief The largest distance, in meters, between the positions of two
+   * views that are combined into one.
+   *
+   * Only applicable when {@link combineStereoViews} is true.
+   */
+  double maximumStereoViewSeparation = 0.5;
+
+  /**
+   * @brief Whether to discard the child tiles of subtrees that have gone
+   * unused for a while, rather than just their content.
+   *
+   * Some loaders, such as the ones for implicit tilesets, create a tile's
+   * children on demand from data they keep anyway. Without this option, those
+   * children stay in memory forever once created, even after their content is
+   * unloaded. When enabled, a subtree whose root has not been visited for
+   * {@link subtreePruningFrameCount} frames, and whose tiles all have their
+   * content unloaded, is discarded. It is created again the next time its root
+   * is visited.
+   *
+   * This bounds the memory used by the tile hierarchy itself when flying
+   * over very large implicit tilesets for a long time.
+   */
+  bool enableSubtreePruning = false;
+
+  /**
+   * @brief The number of frames a subtree must go unvisited before its tiles
+   * may be discarded.
+   *
+   * Only applicable when {@link enableSubtreePruning} is true. Values smaller
+   * than 1 are treated as 1.
+   */
+  int32_t subtreePruningFrameCount = 600;
+
+  /**
+   * @brief Whether to keep an index of the tiles by their {@link TileID}, so
+   * that {@link Tileset::findTile} can find them without walking the tile
+   * hierarchy.
+   *
+   * The index is updated as child tiles are created and discarded, which
+   * takes a little time and memory for each tile. This option is only read
+   * when the tileset is constructed.
+   */
+  bool enableTileIndex = false;
+
   /**
    * @brief Options for configuring the parsing of a {@link Tileset}'s content
    * and construction of Gltf models.
@@ -10,6 +10,7 @@
 #include <glm/mat3x3.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 #include <vector>
 
@@ -113,6 +114,58 @@ public:
   bool
   isBoundingVolumeVisible(const BoundingVolume& boundingVolume) const noexcept;
 
+  /**
+   * @brief Returns whether a volume that is bounded by both the given box and
+   * the given sphere is visible for this camera.
+   *
+   * The box is only tested against the planes that cut through the sphere, so
+   * this is faster than testing the box alone for volumes that are far from
+   * the edges of the frustum, and gives the same result.
+   *
+   * @param boundingBox The box around the volume.
+   * @param boundingSphere A sphere that encloses the box.
+   * @return Whether the volume is visible.
+   */
+  bool isBoundingVolumeVisible(
+      const CesiumGeometry::OrientedBoundingBox& boundingBox,
+      const CesiumGeometry::BoundingSphere& boundingSphere) const noexcept;
+
+  /**
+   * @brief Returns whether any of the given {@link BoundingVolume}s is visible
+   * for this camera.
+   *
+   * This is equivalent to calling {@link isBoundingVolumeVisible} for each
+   * volume, but boxes, regions, and spheres are culled in batches with
+   * {@link CesiumGeometry::BatchCulling}, which is considerably faster when
+   * there are many volumes.
+   *
+   * @param boundingVolumes The bounding volumes to test.
+   * @return Whether at least one of the bounding volumes is visible.
+   */
+  bool isAnyBoundingVolumeVisible(
+      gsl::span<const BoundingVolume* const> boundingVolumes) const noexcept;
+
+  /**
+   * @brief Returns whether any of the given boxes is visible for this camera.
+   *
+   * @param boundingBoxes The boxes to test.
+   * @return Whether at least one of the boxes is visible.
+   */
+  bool isAnyBoundingVolumeVisible(
+      gsl::span<const CesiumGeometry::OrientedBoundingBox> boundingBoxes)
+      const noexcept;
+
+  /**
+   * @brief Returns whether any of the given spheres is visible for this
+   * camera.
+   *
+   * @param boundingSpheres The spheres to test.
+   * @return Whether at least one of the spheres is visible.
+   */
+  bool isAnyBoundingVolumeVisible(
+      gsl::span<const CesiumGeometry::BoundingSphere> boundingSpheres)
+      const noexcept;
+
   /**
    * @brief Computes the squared distance to the given {@link BoundingVolume}.
    *
@@ -39,6 +39,59 @@ public:
    */
   std::unordered_set<Tile*> tilesFadingOut;
 
+  /**
+   * @brief The tiles in {@link tilesToRenderThisFrame} that were not in it
+   * the previous frame, if {@link TilesetOptions::reportRenderListChanges} is
+   * true.
+   */
+  std::vector<Tile*> tilesAddedToRenderList;
+
+  /**
+   * @brief The tiles that were in {@link tilesToRenderThisFrame} the previous
+   * frame and are not in it anymore, if
+   * {@link TilesetOptions::reportRenderListChanges} is true.
+   *
+   * These are reported regardless of whether they are fading out.
+   */
+  std::vector<Tile*> tilesRemovedFromRenderList;
+
+  /**
+   * @brief The tiles in {@link tilesToRenderThisFrame} that are still fading
+   * in, if {@link TilesetOptions::enableLodTransitionPeriod} is true.
+   *
+   * The tiles that have finished fading in are left out, so that a client only
+   * needs to update the tiles in this list, with the percentage at the same
+   * index in {@link fadingInPercentages}.
+   */
+  std::vector<Tile*> fadingInTiles;
+
+  /**
+   * @brief The LOD transition fade percentage of each tile in
+   * {@link fadingInTiles}.
+   */
+  std::vector<float> fadingInPercentages;
+
+  /**
+   * @brief The tiles in {@link tilesFadingOut}, in a contiguous array.
+   */
+  std::vector<Tile*> fadingOutTiles;
+
+  /**
+   * @brief The LOD transition fade percentage of each tile in
+   * {@link fadingOutTiles}.
+   */
+  std::vector<float> fadingOutPercentages;
+
+  /**
+   * @brief The tiles to render for each of the views set by
+   * {@link Tileset::setRenderOnlyViews}, in the same order.
+   *
+   * These are selected from the tiles that are already loaded, so a view may
+   * get a coarser tile than it would with a full update, but never a hole
+   * that a loaded ancestor could fill.
+   */
+  std::vector<std::vector<Tile*>> renderOnlyViewTiles;
+
   /**
    * @brief The number of tiles in the worker thread load queue.
    */
@@ -49,6 +102,45 @@ public:
    */
   int32_t mainThreadTileLoadQueueLength = 0;
 
+  /**
+   * @brief The number of tiles that were allowed to be loading at the same
+   * time this frame.
+   *
+   * This is {@link TilesetOptions::maximumSimultaneousTileLoads} unless
+   * {@link TilesetOptions::adaptiveLoadConcurrency} is set. It's 0 while the
+   * tileset is in a {@link TilesetGroup}, which starts the loads instead.
+   */
+  uint32_t maximumSimultaneousTileLoads = 0;
+
+  /**
+   * @brief The number of subtrees that were allowed to be loading at the same
+   * time for a prefetch this frame.
+   *
+   * This is {@link TilesetContentOptions::maximumSimultaneousSubtreeLoads}
+   * unless {@link TilesetOptions::adaptiveLoadConcurrency} is set. It's 0 while
+   * the tileset is in a {@link TilesetGroup}.
+   */
+  uint32_t maximumSimultaneousSubtreeLoads = 0;
+
+  /**
+   * @brief The number of tiles that each raster overlay was allowed to be
+   * loading at the same time this frame, in the order of
+   * {@link RasterOverlayCollection::getTileProviders}.
+   *
+   * These adapt to the network if the `adaptiveLoadConcurrency` of the
+   * {@link CesiumRasterOverlays::RasterOverlayOptions} of the overlay is set.
+   */
+  std::vector<uint32_t> maximumSimultaneousRasterOverlayTileLoads;
+
+  /**
+   * @brief The maximum screen-space error that tiles were selected with this
+   * frame.
+   *
+   * This is {@link TilesetOptions::maximumScreenSpaceError} unless
+   * {@link TilesetOptions::screenSpaceErrorGovernor} is set.
+   */
+  double maximumScreenSpaceError = 0.0;
+
   //! @cond Doxygen_Suppress
   uint32_t tilesVisited = 0;
   uint32_t culledTilesVisited = 0;
@@ -59,6 +151,55 @@ public:
   uint32_t maxDepthVisited = 0;
   //! @endcond
 
+  /**
+   * @brief The number of times the screen-space error of a tile was computed
+   * for a view this frame, rather than taken from an earlier frame with the
+   * same views.
+   */
+  uint32_t screenSpaceErrorEvaluations = 0;
+
+  /**
+   * @brief The number of times a tile was tested against the frustum, the fog,
+   * the horizon or the software occlusion buffer of a view this frame, rather
+   * than taking the result from an earlier frame with the same views.
+   *
+   * This includes the tests of the traversals for the predicted and the
+   * render-only views. A test isn't counted if it's skipped because the tile
+   * is already known to be visible in another view, or because there's no fog
+   * or horizon culling point to test it against.
+   */
+  uint32_t cullingTests = 0;
+
+  /**
+   * @brief The number of bytes of tile content that were unloaded because the
+   * cache was full, or by {@link Tileset::evictForMemoryPressure}, since this
+   * frame began.
+   */
+  int64_t bytesEvicted = 0;
+
+  /**
+   * @name Timings
+   * @brief The time spent in each phase of the update, in milliseconds.
+   *
+   * These are only measured when
+   * {@link TilesetOptions::measureViewUpdateTimes} is true, and are 0.0
+   * otherwise. The worker thread load queue of a tileset in a
+   * {@link TilesetGroup} is processed by the group, so it's not measured. Its
+   * cached tiles are unloaded by the group too, and that time is added here.
+   */
+  //! @{
+  /** @brief Traversing the tiles to select the tiles to render and load. */
+  double traversalTime = 0.0;
+  /** @brief Starting the loads of the tiles in the worker thread queue. */
+  double workerThreadLoadQueueTime = 0.0;
+  /** @brief Finishing the loads of the tiles in the main thread queue. */
+  double mainThreadLoadQueueTime = 0.0;
+  /** @brief Unloading cached tiles that are no longer needed. */
+  double unloadCachedTilesTime = 0.0;
+  /** @brief Updating the fading of tiles in level of detail transitions. */
+  double lodTransitionTime = 0.0;
+  //! @}
+
   int32_t frameNumber = 0;
 };
 
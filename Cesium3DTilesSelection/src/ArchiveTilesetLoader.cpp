@@ -0,0 +1,694 @@
+#include "ArchiveTilesetLoader.h"
+
+#include "TilesetJsonLoader.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/HttpHeaders.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumUtility/Gunzip.h>
+#include <CesiumUtility/Uri.h>
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+using namespace CesiumAsync;
+
+namespace Cesium3DTilesSelection {
+
+struct TilesetArchive {
+  // A file in the archive, from its header in the central directory.
+  struct Entry {
+    uint64_t localHeaderOffset;
+    uint64_t compressedSize;
+    uint64_t uncompressedSize;
+    uint16_t compressionMethod;
+    uint16_t extraFieldLength;
+  };
+
+  // The URL from which the archive is read.
+  std::string url;
+
+  // The URL of the directory in which the files of the archive appear to be,
+  // ending with a slash.
+  std::string baseUrl;
+
+  // The files of the archive, by their paths within it.
+  std::unordered_map<std::string, Entry> entries;
+
+  // The whole archive, if the server ignored the request for its end.
+  std::optional<std::vector<std::byte>> wholeArchive;
+};
+
+namespace {
+const uint32_t localFileHeaderSignature = 0x04034b50;
+const uint32_t centralDirectoryHeaderSignature = 0x02014b50;
+const uint32_t endOfCentralDirectorySignature = 0x06054b50;
+const uint32_t zip64EndOfCentralDirectoryLocatorSignature = 0x07064b50;
+const uint32_t zip64EndOfCentralDirectorySignature = 0x06064b50;
+const uint16_t zip64ExtraFieldID = 0x0001;
+
+const size_t localFileHeaderSize = 30;
+const size_t centralDirectoryHeaderSize = 46;
+const size_t endOfCentralDirectorySize = 22;
+const size_t zip64EndOfCentralDirectoryLocatorSize = 20;
+const size_t zip64EndOfCentralDirectorySize = 56;
+
+const uint16_t storedCompressionMethod = 0;
+const uint16_t deflateCompressionMethod = 8;
+
+// The end of an archive with the longest possible comment, which includes
+// all of the records that locate the central directory.
+const uint64_t archiveTailSize =
+    zip64EndOfCentralDirectorySize + zip64EndOfCentralDirectoryLocatorSize +
+    endOfCentralDirectorySize + 0xffff;
+
+template <typename T>
+T readLittleEndian(const gsl::span<const std::byte>& data, size_t offset) {
+  T value = 0;
+  for (size_t i = sizeof(T); i > 0; --i) {
+    value = static_cast<T>(
+        static_cast<T>(value << 8) | std::to_integer<T>(data[offset + i - 1]));
+  }
+  return value;
+}
+
+struct CentralDirectoryLocation {
+  uint64_t offset;
+  uint64_t size;
+};
+
+// Finds the central directory from the end of the archive, which starts at
+// the given offset within it.
+std::optional<CentralDirectoryLocation>
+findCentralDirectory(const gsl::span<const std::byte>& tail, uint64_t offset) {
+  if (tail.size() < endOfCentralDirectorySize) {
+    return std::nullopt;
+  }
+
+  // The record is followed by a comment of any length, so search backward for
+  // its signature.
+  size_t end = tail.size() - endOfCentralDirectorySize;
+  while (readLittleEndian<uint32_t>(tail, end) !=
+         endOfCentralDirectorySignature) {
+    if (end == 0) {
+      return std::nullopt;
+    }
+    --end;
+  }
+
+  const uint64_t size = readLittleEndian<uint32_t>(tail, end + 12);
+  const uint64_t start = readLittleEndian<uint32_t>(tail, end + 16);
+  if (size != 0xffffffff && start != 0xffffffff) {
+    return CentralDirectoryLocation{start, size};
+  }
+
+  // In a zip64 archive, the record is preceded by a locator of the zip64
+  // record, which has the real size and offset.
+  if (end < zip64EndOfCentralDirectoryLocatorSize) {
+    return std::nullopt;
+  }
+  const size_t locator = end - zip64EndOfCentralDirectoryLocatorSize;
+  if (readLittleEndian<uint32_t>(tail, locator) !=
+      zip64EndOfCentralDirectoryLocatorSignature) {
+    return std::nullopt;
+  }
+
+  const uint64_t zip64End = readLittleEndian<uint64_t>(tail, locator + 8);
+  if (zip64End < offset ||
+      zip64End - offset + zip64EndOfCentralDirectorySize > tail.size()) {
+    return std::nullopt;
+  }
+  const size_t zip64Record = static_cast<size_t>(zip64End - offset);
+  if (readLittleEndian<uint32_t>(tail, zip64Record) !=
+      zip64EndOfCentralDirectorySignature) {
+    return std::nullopt;
+  }
+
+  return CentralDirectoryLocation{
+      readLittleEndian<uint64_t>(tail, zip64Record + 48),
+      readLittleEndian<uint64_t>(tail, zip64Record + 40)};
+}
+
+bool parseCentralDirectory(
+    const gsl::span<const std::byte>& data,
+    std::unordered_map<std::string, TilesetArchive::Entry>& entries) {
+  size_t header = 0;
+  while (header + centralDirectoryHeaderSize <= data.size()) {
+    if (readLittleEndian<uint32_t>(data, header) !=
+        centralDirectoryHeaderSignature) {
+      return false;
+    }
+
+    TilesetArchive::Entry entry;
+    entry.compressionMethod = readLittleEndian<uint16_t>(data, header + 10);
+    entry.compressedSize = readLittleEndian<uint32_t>(data, header + 20);
+    entry.uncompressedSize = readLittleEndian<uint32_t>(data, header + 24);
+    const size_t nameLength = readLittleEndian<uint16_t>(data, header + 28);
+    entry.extraFieldLength = readLittleEndian<uint16_t>(data, header + 30);
+    const size_t commentLength = readLittleEndian<uint16_t>(data, header + 32);
+    entry.localHeaderOffset = readLittleEndian<uint32_t>(data, header + 42);
+
+    const size_t name = header + centralDirectoryHeaderSize;
+    const size_t extra = name + nameLength;
+    const size_t extraEnd = extra + entry.extraFieldLength;
+    const size_t next = extraEnd + commentLength;
+    if (next > data.size()) {
+      return false;
+    }
+
+    // Sizes and offsets that don't fit in their fields are in the zip64 extra
+    // field instead, in this order.
+    size_t field = extra;
+    while (field + 4 <= extraEnd) {
+      const uint16_t id = readLittleEndian<uint16_t>(data, field);
+      size_t value = field + 4;
+      const size_t fieldEnd =
+          value + readLittleEndian<uint16_t>(data, field + 2);
+      if (fieldEnd > extraEnd) {
+        break;
+      }
+
+      if (id == zip64ExtraFieldID) {
+        for (uint64_t* pValue :
+             {&entry.uncompressedSize,
+              &entry.compressedSize,
+              &entry.localHeaderOffset}) {
+          if (*pValue == 0xffffffff && value + 8 <= fieldEnd) {
+            *pValue = readLittleEndian<uint64_t>(data, value);
+            value += 8;
+          }
+        }
+      }
+
+      field = fieldEnd;
+    }
+
+    std::string path(
+        reinterpret_cast<const char*>(data.data() + name),
+        nameLength);
+    if (!path.empty() && path.back() != '/') {
+      entries.emplace(std::move(path), entry);
+    }
+
+    header = next;
+  }
+
+  return header == data.size();
+}
+
+std::optional<uint64_t> getContentRangeStart(const HttpHeaders& headers) {
+  HttpHeaders::const_iterator it = headers.find("Content-Range");
+  const std::string unit = "bytes ";
+  if (it == headers.end() || it->second.compare(0, unit.size(), unit) != 0) {
+    return std::nullopt;
+  }
+
+  const char* pStart = it->second.c_str() + unit.size();
+  char* pEnd = nullptr;
+  const unsigned long long start = std::strtoull(pStart, &pEnd, 10);
+  if (pEnd == pStart || *pEnd != '-') {
+    return std::nullopt;
+  }
+  return static_cast<uint64_t>(start);
+}
+
+// Bytes read from the archive, which are empty if the read failed. The
+// request keeps the bytes alive, and if the read failed, it has the reason.
+struct ArchiveRead {
+  std::shared_ptr<IAssetRequest> pRequest;
+  gsl::span<const std::byte> data;
+};
+
+bool isFailedRequest(const std::shared_ptr<IAssetRequest>& pRequest) {
+  return pRequest &&
+         (!pRequest->response() || pRequest->response()->statusCode() != 206);
+}
+
+Future<ArchiveRead> readArchiveRange(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const TilesetArchive& archive,
+    uint64_t offset,
+    uint64_t length,
+    const std::vector<IAssetAccessor::THeader>& headers) {
+  if (archive.wholeArchive) {
+    const gsl::span<const std::byte> data(*archive.wholeArchive);
+    if (offset >= data.size()) {
+      return asyncSystem.createResolvedFuture(ArchiveRead{nullptr, {}});
+    }
+    const size_t start = static_cast<size_t>(offset);
+    return asyncSystem.createResolvedFuture(ArchiveRead{
+        nullptr,
+        data.subspan(
+            start,
+            static_cast<size_t>(
+                std::min<uint64_t>(length, data.size() - start)))});
+  }
+
+  return pAssetAccessor
+      ->getRange(asyncSystem, archive.url, offset, length, headers)
+      .thenImmediately([](std::shared_ptr<IAssetRequest>&& pRequest) {
+        gsl::span<const std::byte> data;
+        if (!isFailedRequest(pRequest)) {
+          data = pRequest->response()->data();
+        }
+        return ArchiveRead{std::move(pRequest), data};
+      });
+}
+
+class ArchiveAssetResponse : public IAssetResponse {
+public:
+  ArchiveAssetResponse(uint16_t statusCode, std::vector<std::byte>&& data)
+      : _statusCode(statusCode), _headers(), _data(std::move(data)) {}
+
+  virtual uint16_t statusCode() const noexcept override {
+    return this->_statusCode;
+  }
+
+  virtual std::string contentType() const override { return std::string(); }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const noexcept override {
+    return this->_data;
+  }
+
+private:
+  uint16_t _statusCode;
+  HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+// A request for a file in an archive, as if the file had its own URL.
+class ArchiveAssetRequest : public IAssetRequest {
+public:
+  ArchiveAssetRequest(
+      const std::string& url,
+      const std::vector<IAssetAccessor::THeader>& headers,
+      uint16_t statusCode,
+      std::vector<std::byte>&& data)
+      : _method("GET"),
+        _url(url),
+        _headers(headers.begin(), headers.end()),
+        _response(statusCode, std::move(data)) {}
+
+  virtual const std::string& method() const noexcept override {
+    return this->_method;
+  }
+
+  virtual const std::string& url() const noexcept override {
+    return this->_url;
+  }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_headers;
+  }
+
+  virtual const IAssetResponse* response() const noexcept override {
+    return &this->_response;
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  HttpHeaders _headers;
+  ArchiveAssetResponse _response;
+};
+
+Future<std::shared_ptr<IAssetRequest>> readArchiveFile(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<const TilesetArchive>& pArchive,
+    const std::string& url,
+    const std::string& path,
+    const TilesetArchive::Entry& entry,
+    const std::vector<IAssetAccessor::THeader>& headers) {
+  // The local header of a file almost always has the same name and extra
+  // field as its header in the central directory, so it's read along with
+  // the data.
+  const uint64_t expectedHeaderSize =
+      localFileHeaderSize + path.size() + entry.extraFieldLength;
+
+  return readArchiveRange(
+             asyncSystem,
+             pAssetAccessor,
+             *pArchive,
+             entry.localHeaderOffset,
+             expectedHeaderSize + entry.compressedSize,
+             headers)
+      .thenImmediately(
+          [asyncSystem, pAssetAccessor, pArchive, url, entry, headers](
+              ArchiveRead&& read) -> Future<ArchiveRead> {
+            if (read.data.size() < localFileHeaderSize ||
+                readLittleEndian<uint32_t>(read.data, 0) !=
+                    localFileHeaderSignature) {
+              read.data = {};
+              return asyncSystem.createResolvedFuture(std::move(read));
+            }
+
+            const uint64_t dataOffset =
+                localFileHeaderSize +
+                readLittleEndian<uint16_t>(read.data, 26) +
+                readLittleEndian<uint16_t>(read.data, 28);
+            if (entry.compressedSize == 0) {
+              read.data = {};
+              return asyncSystem.createResolvedFuture(std::move(read));
+            }
+            if (dataOffset + entry.compressedSize <= read.data.size()) {
+              read.data = read.data.subspan(
+                  static_cast<size_t>(dataOffset),
+                  static_cast<size_t>(entry.compressedSize));
+              return asyncSystem.createResolvedFuture(std::move(read));
+            }
+
+            // The local header is longer than expected, so read the data on
+            // its own.
+            return readArchiveRange(
+                asyncSystem,
+                pAssetAccessor,
+                *pArchive,
+                entry.localHeaderOffset + dataOffset,
+                entry.compressedSize,
+                headers);
+          })
+      .thenInWorkerThread(
+          [pArchive, url, entry, headers](
+              ArchiveRead&& read) -> std::shared_ptr<IAssetRequest> {
+            if (isFailedRequest(read.pRequest)) {
+              return std::move(read.pRequest);
+            }
+
+            if (read.data.size() != entry.compressedSize) {
+              throw std::runtime_error(fmt::format(
+                  "Could not read {} from the 3D Tiles archive {}",
+                  url,
+                  pArchive->url));
+            }
+
+            std::vector<std::byte> data;
+            if (entry.compressionMethod == storedCompressionMethod) {
+              data.assign(read.data.begin(), read.data.end());
+            } else if (entry.compressionMethod == deflateCompressionMethod) {
+              if (!CesiumUtility::inflateRaw(
+                      read.data,
+                      data,
+                      static_cast<size_t>(entry.uncompressedSize))) {
+                throw std::runtime_error(fmt::format(
+                    "Could not decompress {} from the 3D Tiles archive {}",
+                    url,
+                    pArchive->url));
+              }
+            } else {
+              throw std::runtime_error(fmt::format(
+                  "{} in the 3D Tiles archive {} has unsupported compression "
+                  "method {}",
+                  url,
+                  pArchive->url,
+                  entry.compressionMethod));
+            }
+
+            return std::make_shared<ArchiveAssetRequest>(
+                url,
+                headers,
+                static_cast<uint16_t>(200),
+                std::move(data));
+          });
+}
+
+// Reads the files of an archive through an asset accessor, and passes
+// requests for any other URL on to it.
+class ArchiveAssetAccessor : public IAssetAccessor {
+public:
+  ArchiveAssetAccessor(
+      const std::shared_ptr<const TilesetArchive>& pArchive,
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor)
+      : _pArchive(pArchive), _pAssetAccessor(pAssetAccessor) {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    const std::string& baseUrl = this->_pArchive->baseUrl;
+    if (url.compare(0, baseUrl.size(), baseUrl) != 0) {
+      return this->_pAssetAccessor->get(asyncSystem, url, headers);
+    }
+
+    const size_t pathEnd = url.find_first_of("?#", baseUrl.size());
+    const std::string path = CesiumUtility::Uri::unescape(
+        url.substr(baseUrl.size(), pathEnd - baseUrl.size()));
+    auto it = this->_pArchive->entries.find(path);
+    if (it == this->_pArchive->entries.end()) {
+      std::shared_ptr<IAssetRequest> pRequest =
+          std::make_shared<ArchiveAssetRequest>(
+              url,
+              headers,
+              static_cast<uint16_t>(404),
+              std::vector<std::byte>());
+      return asyncSystem.createResolvedFuture(std::move(pRequest));
+    }
+
+    return readArchiveFile(
+        asyncSystem,
+        this->_pAssetAccessor,
+        this->_pArchive,
+        url,
+        it->first,
+        it->second,
+        headers);
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override {
+    const std::string& baseUrl = this->_pArchive->baseUrl;
+    if (verb == "GET" && url.compare(0, baseUrl.size(), baseUrl) == 0) {
+      return this->get(asyncSystem, url, headers);
+    }
+    return this->_pAssetAccessor
+        ->request(asyncSystem, verb, url, headers, contentPayload);
+  }
+
+  virtual void tick() noexcept override { this->_pAssetAccessor->tick(); }
+
+private:
+  std::shared_ptr<const TilesetArchive> _pArchive;
+  std::shared_ptr<IAssetAccessor> _pAssetAccessor;
+};
+
+TilesetContentLoaderResult<ArchiveTilesetLoader>
+createErrorResult(std::string&& message, uint16_t statusCode = 200) {
+  TilesetContentLoaderResult<ArchiveTilesetLoader> result;
+  result.errors.emplaceError(std::move(message));
+  result.statusCode = statusCode;
+  return result;
+}
+} // namespace
+
+ArchiveTilesetLoader::ArchiveTilesetLoader(
+    const std::shared_ptr<const TilesetArchive>& pArchive,
+    std::unique_ptr<TilesetContentLoader>&& pAggregatedLoader)
+    : _pArchive{pArchive}, _pAggregatedLoader{std::move(pAggregatedLoader)} {}
+
+CesiumAsync::Future<TileLoadResult>
+ArchiveTilesetLoader::loadTileContent(const TileLoadInput& loadInput) {
+  // The files are read through the asset accessor of this load, which may
+  // hold back responses until the tile can be decoded.
+  std::shared_ptr<IAssetAccessor> pArchiveAccessor =
+      std::make_shared<ArchiveAssetAccessor>(
+          this->_pArchive,
+          loadInput.pAssetAccessor);
+
+  TileLoadInput archiveLoadInput{
+      loadInput.tile,
+      loadInput.contentOptions,
+      loadInput.asyncSystem,
+      pArchiveAccessor,
+      loadInput.pLogger,
+      loadInput.requestHeaders,
+      loadInput.pCanceled,
+      loadInput.decodeThreadPool};
+  return this->_pAggregatedLoader->loadTileContent(archiveLoadInput);
+}
+
+TileChildrenResult ArchiveTilesetLoader::createTileChildren(const Tile& tile) {
+  auto pLoader = tile.getLoader();
+  return pLoader->createTileChildren(tile);
+}
+
+/*static*/ bool ArchiveTilesetLoader::isArchiveUrl(const std::string& url) {
+  const std::string path = CesiumUtility::Uri::getPath(url);
+  const std::string extension = ".3tz";
+  return path.size() >= extension.size() &&
+         std::equal(
+             extension.rbegin(),
+             extension.rend(),
+             path.rbegin(),
+             [](char lhs, char rhs) {
+               return lhs == std::tolower(static_cast<unsigned char>(rhs));
+             });
+}
+
+/*static*/ CesiumAsync::Future<
+    TilesetContentLoaderResult<ArchiveTilesetLoader>>
+ArchiveTilesetLoader::createLoader(
+    const TilesetExternals& externals,
+    const std::string& archiveUrl,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders) {
+  std::vector<IAssetAccessor::THeader> tailHeaders = requestHeaders;
+  tailHeaders.emplace_back(
+      "Range",
+      "bytes=-" + std::to_string(archiveTailSize));
+
+  return externals.pAssetAccessor
+      ->get(externals.asyncSystem, archiveUrl, tailHeaders)
+      .thenInWorkerThread(
+          [externals, archiveUrl, requestHeaders](
+              std::shared_ptr<IAssetRequest>&& pCompletedRequest)
+              -> Future<TilesetContentLoaderResult<ArchiveTilesetLoader>> {
+            const AsyncSystem& asyncSystem = externals.asyncSystem;
+            const IAssetResponse* pResponse = pCompletedRequest->response();
+            if (!pResponse) {
+              return asyncSystem.createResolvedFuture(createErrorResult(
+                  fmt::format(
+                      "Did not receive a valid response for 3D Tiles archive "
+                      "{}",
+                      archiveUrl)));
+            }
+
+            const uint16_t statusCode = pResponse->statusCode();
+            if (statusCode != 0 && (statusCode < 200 || statusCode >= 300)) {
+              return asyncSystem.createResolvedFuture(createErrorResult(
+                  fmt::format(
+                      "Received status code {} for 3D Tiles archive {}",
+                      statusCode,
+                      archiveUrl),
+                  statusCode));
+            }
+
+            // The files of the archive appear to be in a directory named
+            // after it, which keeps the query parameters of the archive.
+            const size_t queryStart = archiveUrl.find('?');
+            std::shared_ptr<TilesetArchive> pArchive =
+                std::make_shared<TilesetArchive>();
+            pArchive->url = archiveUrl;
+            pArchive->baseUrl = archiveUrl.substr(0, queryStart) + "/";
+            const std::string tilesetJsonUrl =
+                pArchive->baseUrl + "tileset.json" +
+                (queryStart == std::string::npos
+                     ? std::string()
+                     : archiveUrl.substr(queryStart));
+
+            gsl::span<const std::byte> tail = pResponse->data();
+            uint64_t tailOffset = 0;
+            if (statusCode == 206) {
+              std::optional<uint64_t> contentRangeStart =
+                  getContentRangeStart(pResponse->headers());
+              if (!contentRangeStart) {
+                return asyncSystem.createResolvedFuture(createErrorResult(
+                    fmt::format(
+                        "Received a partial response without a valid "
+                        "Content-Range for 3D Tiles archive {}",
+                        archiveUrl)));
+              }
+              tailOffset = *contentRangeStart;
+            } else {
+              pArchive->wholeArchive.emplace(tail.begin(), tail.end());
+              tail = *pArchive->wholeArchive;
+            }
+
+            const std::optional<CentralDirectoryLocation> location =
+                findCentralDirectory(tail, tailOffset);
+            if (!location || location->size == 0) {
+              return asyncSystem.createResolvedFuture(createErrorResult(
+                  fmt::format(
+                      "Could not find the central directory of 3D Tiles "
+                      "archive {}",
+                      archiveUrl)));
+            }
+
+            // The central directory of a small archive is in its end, which
+            // has already been read.
+            Future<ArchiveRead> futureCentralDirectory =
+                location->offset >= tailOffset &&
+                        location->offset - tailOffset + location->size <=
+                            tail.size()
+                    ? asyncSystem.createResolvedFuture(ArchiveRead{
+                          std::move(pCompletedRequest),
+                          tail.subspan(
+                              static_cast<size_t>(
+                                  location->offset - tailOffset),
+                              static_cast<size_t>(location->size))})
+                    : readArchiveRange(
+                          asyncSystem,
+                          externals.pAssetAccessor,
+                          *pArchive,
+                          location->offset,
+                          location->size,
+                          requestHeaders);
+
+            return std::move(futureCentralDirectory)
+                .thenInWorkerThread([externals,
+                                     requestHeaders,
+                                     pArchive,
+                                     tilesetJsonUrl,
+                                     size = location->size](
+                                        ArchiveRead&& read) {
+                  if (read.data.size() != size ||
+                      !parseCentralDirectory(read.data, pArchive->entries)) {
+                    return externals.asyncSystem.createResolvedFuture(
+                        createErrorResult(fmt::format(
+                            "Could not read the central directory of 3D Tiles "
+                            "archive {}",
+                            pArchive->url)));
+                  }
+
+                  TilesetExternals archiveExternals = externals;
+                  archiveExternals.pAssetAccessor =
+                      std::make_shared<ArchiveAssetAccessor>(
+                          pArchive,
+                          externals.pAssetAccessor);
+                  return TilesetJsonLoader::createLoader(
+                             archiveExternals,
+                             tilesetJsonUrl,
+                             requestHeaders)
+                      .thenImmediately(
+                          [pArchive, requestHeaders](
+                              TilesetContentLoaderResult<TilesetJsonLoader>&&
+                                  tilesetJsonResult) mutable {
+                            TilesetContentLoaderResult<ArchiveTilesetLoader>
+                                result;
+                            if (!tilesetJsonResult.errors) {
+                              result.pLoader =
+                                  std::make_unique<ArchiveTilesetLoader>(
+                                      pArchive,
+                                      std::move(tilesetJsonResult.pLoader));
+                              result.pRootTile =
+                                  std::move(tilesetJsonResult.pRootTile);
+                              result.credits =
+                                  std::move(tilesetJsonResult.credits);
+                              result.requestHeaders = std::move(requestHeaders);
+                            }
+                            result.errors = std::move(tilesetJsonResult.errors);
+                            result.statusCode = tilesetJsonResult.statusCode;
+                            return result;
+                          });
+                });
+          });
+}
+} // namespace Cesium3DTilesSelection
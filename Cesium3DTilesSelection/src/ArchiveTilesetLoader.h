@@ -0,0 +1,56 @@
+#pragma once
+
+#include "TilesetContentLoaderResult.h"
+
+#include <Cesium3DTilesSelection/TilesetContentLoader.h>
+#include <Cesium3DTilesSelection/TilesetExternals.h>
+#include <CesiumAsync/Future.h>
+#include <CesiumAsync/IAssetAccessor.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+struct TilesetArchive;
+
+/**
+ * @brief Loads a tileset that is packaged as a 3D Tiles archive (`.3tz`),
+ * which is a zip file with the tileset JSON at its root.
+ *
+ * The central directory of the archive is read once, when the loader is
+ * created. After that, each file in the archive is read with a single range
+ * request, so the archive is never downloaded whole (unless the server
+ * ignores range requests, in which case the first response is kept and all
+ * of the files are read from it). The tileset JSON in the archive is loaded
+ * by a {@link TilesetJsonLoader}, which sees the files in the archive as if
+ * they were in a directory at the URL of the archive.
+ */
+class ArchiveTilesetLoader : public TilesetContentLoader {
+public:
+  ArchiveTilesetLoader(
+      const std::shared_ptr<const TilesetArchive>& pArchive,
+      std::unique_ptr<TilesetContentLoader>&& pAggregatedLoader);
+
+  CesiumAsync::Future<TileLoadResult>
+  loadTileContent(const TileLoadInput& loadInput) override;
+
+  TileChildrenResult createTileChildren(const Tile& tile) override;
+
+  /**
+   * @brief Determines whether the given URL is that of a 3D Tiles archive,
+   * from the extension of its path.
+   */
+  static bool isArchiveUrl(const std::string& url);
+
+  static CesiumAsync::Future<TilesetContentLoaderResult<ArchiveTilesetLoader>>
+  createLoader(
+      const TilesetExternals& externals,
+      const std::string& archiveUrl,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders);
+
+private:
+  std::shared_ptr<const TilesetArchive> _pArchive;
+  std::unique_ptr<TilesetContentLoader> _pAggregatedLoader;
+};
+} // namespace Cesium3DTilesSelection
@@ -230,7 +230,7 @@ getOrientedBoundingBoxFromBoundingVolume(const BoundingVolume& boundingVolume) {
 
     OrientedBoundingBox
     operator()(const CesiumGeospatial::S2CellBoundingVolume& s2) const {
-      return s2.computeBoundingRegion().getBoundingBox();
+      return s2.computeOrientedBoundingBox();
     }
   };
 
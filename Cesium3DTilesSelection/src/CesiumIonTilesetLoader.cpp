@@ -5,12 +5,23 @@
 
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumUtility/ErrorList.h>
 #include <CesiumUtility/JsonHelpers.h>
 #include <CesiumUtility/Uri.h>
 
 #include <rapidjson/document.h>
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <optional>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace Cesium3DTilesSelection {
 namespace {
@@ -40,6 +51,145 @@ std::string createEndpointResource(
   return ionUrl;
 }
 
+// The access token of an endpoint response is valid for about an hour, so a
+// stored response isn't used after that.
+const std::time_t endpointResponseLifetime = 60 * 60;
+
+std::string getEndpointCacheKey(const std::string& ionUrl) {
+  return "ion-endpoint " + ionUrl;
+}
+
+void storeEndpointResponse(
+    CesiumAsync::ICacheDatabase& endpointCache,
+    const CesiumAsync::IAssetRequest& completedRequest) {
+  const CesiumAsync::IAssetResponse* pResponse = completedRequest.response();
+  const std::time_t expiryTime =
+      std::time(nullptr) + endpointResponseLifetime;
+  endpointCache.storeEntry(
+      getEndpointCacheKey(completedRequest.url()),
+      expiryTime,
+      completedRequest.url(),
+      completedRequest.method(),
+      CesiumAsync::HttpHeaders{},
+      pResponse->statusCode(),
+      CesiumAsync::HttpHeaders{},
+      pResponse->data());
+}
+
+/**
+ * @brief Marks the stored endpoint response of the given URL as expired, so
+ * that it isn't used again.
+ */
+void expireEndpointResponse(
+    CesiumAsync::ICacheDatabase& endpointCache,
+    const std::string& ionUrl) {
+  endpointCache.storeEntry(
+      getEndpointCacheKey(ionUrl),
+      0,
+      ionUrl,
+      "GET",
+      CesiumAsync::HttpHeaders{},
+      200,
+      CesiumAsync::HttpHeaders{},
+      gsl::span<const std::byte>());
+}
+
+std::optional<std::vector<std::byte>> getStoredEndpointResponse(
+    const CesiumAsync::ICacheDatabase& endpointCache,
+    const std::string& ionUrl) {
+  std::optional<CesiumAsync::CacheItem> cacheItem =
+      endpointCache.getEntry(getEndpointCacheKey(ionUrl));
+  if (!cacheItem ||
+      std::difftime(cacheItem->expiryTime, std::time(nullptr)) <= 0.0) {
+    return std::nullopt;
+  }
+  return std::move(cacheItem->cacheResponse.data);
+}
+
+/**
+ * @brief Parses the JSON of an endpoint response.
+ *
+ * @param data The JSON.
+ * @param errors The errors, when the JSON isn't valid or its asset type isn't
+ * supported.
+ * @return The endpoint if successful
+ */
+std::optional<AssetEndpoint> parseEndpointResponse(
+    const gsl::span<const std::byte>& data,
+    CesiumUtility::ErrorList& errors) {
+  rapidjson::Document ionResponse;
+  ionResponse.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+
+  if (ionResponse.HasParseError()) {
+    errors.emplaceError(fmt::format(
+        "Error when parsing Cesium ion response JSON, error code {} at byte "
+        "offset {}",
+        ionResponse.GetParseError(),
+        ionResponse.GetErrorOffset()));
+    return std::nullopt;
+  }
+
+  AssetEndpoint endpoint;
+  const auto attributionsIt = ionResponse.FindMember("attributions");
+  if (attributionsIt != ionResponse.MemberEnd() &&
+      attributionsIt->value.IsArray()) {
+
+    for (const rapidjson::Value& attribution :
+         attributionsIt->value.GetArray()) {
+      AssetEndpointAttribution& endpointAttribution =
+          endpoint.attributions.emplace_back();
+      const auto html = attribution.FindMember("html");
+      if (html != attribution.MemberEnd() && html->value.IsString()) {
+        endpointAttribution.html = html->value.GetString();
+      }
+      auto collapsible = attribution.FindMember("collapsible");
+      if (collapsible != attribution.MemberEnd() &&
+          collapsible->value.IsBool()) {
+        endpointAttribution.collapsible = collapsible->value.GetBool();
+      }
+    }
+  }
+
+  std::string type =
+      CesiumUtility::JsonHelpers::getStringOrDefault(ionResponse, "type", "");
+  std::string url =
+      CesiumUtility::JsonHelpers::getStringOrDefault(ionResponse, "url", "");
+  std::string accessToken = CesiumUtility::JsonHelpers::getStringOrDefault(
+      ionResponse,
+      "accessToken",
+      "");
+  std::string externalType = CesiumUtility::JsonHelpers::getStringOrDefault(
+      ionResponse,
+      "externalType",
+      "");
+
+  if (!externalType.empty()) {
+    type = externalType;
+    const auto optionsIt = ionResponse.FindMember("options");
+    if (optionsIt != ionResponse.MemberEnd() && optionsIt->value.IsObject()) {
+      url = CesiumUtility::JsonHelpers::getStringOrDefault(
+          optionsIt->value,
+          "url",
+          url);
+    }
+  }
+
+  if (type == "TERRAIN") {
+    // For terrain resources, we need to append `/layer.json` to the end of
+    // the URL.
+    url = CesiumUtility::Uri::resolve(url, "layer.json", true);
+  } else if (type != "3DTILES") {
+    errors.emplaceError(
+        fmt::format("Received unsupported asset response type: {}", type));
+    return std::nullopt;
+  }
+
+  endpoint.type = std::move(type);
+  endpoint.url = std::move(url);
+  endpoint.accessToken = std::move(accessToken);
+  return endpoint;
+}
+
 /**
  * @brief Tries to obtain the `accessToken` from the JSON of the
  * given response.
@@ -68,16 +218,140 @@ std::optional<std::string> getNewAccessToken(
       "");
 }
 
+// Tokens are refreshed a few minutes before they expire, and a refresh that
+// fails is tried again after a minute.
+const std::time_t tokenRefreshMargin = 5 * 60;
+const std::time_t tokenRefreshRetryDelay = 60;
+
+std::optional<std::string> decodeBase64Url(std::string_view encoded) {
+  std::string decoded;
+  decoded.reserve(encoded.size() * 3 / 4);
+
+  uint32_t bits = 0;
+  int32_t bitCount = 0;
+  for (const char c : encoded) {
+    uint32_t value;
+    if (c >= 'A' && c <= 'Z') {
+      value = uint32_t(c - 'A');
+    } else if (c >= 'a' && c <= 'z') {
+      value = uint32_t(c - 'a') + 26;
+    } else if (c >= '0' && c <= '9') {
+      value = uint32_t(c - '0') + 52;
+    } else if (c == '-' || c == '+') {
+      value = 62;
+    } else if (c == '_' || c == '/') {
+      value = 63;
+    } else if (c == '=') {
+      break;
+    } else {
+      return std::nullopt;
+    }
+
+    bits = (bits << 6) | value;
+    bitCount += 6;
+    if (bitCount >= 8) {
+      bitCount -= 8;
+      decoded.push_back(char((bits >> bitCount) & 0xFF));
+    }
+  }
+
+  return decoded;
+}
+
+/**
+ * @brief Reads the `exp` claim of an access token.
+ *
+ * The access tokens of Cesium ion are JSON Web Tokens, whose second part is
+ * the base64url-encoded JSON of their claims.
+ *
+ * @param accessToken The access token
+ * @return The time that the token expires, if it states one
+ */
+std::optional<std::time_t> getTokenExpiryTime(const std::string& accessToken) {
+  const size_t claimsBegin = accessToken.find('.');
+  if (claimsBegin == std::string::npos) {
+    return std::nullopt;
+  }
+  const size_t claimsEnd = accessToken.find('.', claimsBegin + 1);
+  if (claimsEnd == std::string::npos) {
+    return std::nullopt;
+  }
+
+  const std::optional<std::string> claimsJson = decodeBase64Url(
+      std::string_view(accessToken)
+          .substr(claimsBegin + 1, claimsEnd - claimsBegin - 1));
+  if (!claimsJson) {
+    return std::nullopt;
+  }
+
+  rapidjson::Document claims;
+  claims.Parse(claimsJson->data(), claimsJson->size());
+  if (claims.HasParseError() || !claims.IsObject()) {
+    return std::nullopt;
+  }
+
+  const auto expIt = claims.FindMember("exp");
+  if (expIt == claims.MemberEnd() || !expIt->value.IsNumber()) {
+    return std::nullopt;
+  }
+  return static_cast<std::time_t>(expIt->value.GetDouble());
+}
+
+/**
+ * @brief Computes when to refresh an access token.
+ *
+ * @param accessToken The access token
+ * @param isStoredToken Whether the token was stored in an earlier session, so
+ * that it may be about to expire even if it doesn't say when.
+ */
+std::time_t
+getTokenRefreshTime(const std::string& accessToken, bool isStoredToken) {
+  const std::optional<std::time_t> expiryTime =
+      getTokenExpiryTime(accessToken);
+  if (expiryTime) {
+    return *expiryTime - tokenRefreshMargin;
+  }
+  return isStoredToken ? std::time(nullptr)
+                       : std::numeric_limits<std::time_t>::max();
+}
+
+bool isUnauthorized(const TileLoadResult& result) {
+  if (!result.pCompletedRequest) {
+    return false;
+  }
+  const CesiumAsync::IAssetResponse* pResponse =
+      result.pCompletedRequest->response();
+  return pResponse && pResponse->statusCode() == 401;
+}
+
+void setAuthorizationHeader(
+    std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+    const std::string& headerValue) {
+  auto authIt = std::find_if(
+      requestHeaders.begin(),
+      requestHeaders.end(),
+      [](const CesiumAsync::IAssetAccessor::THeader& header) {
+        return header.first == "Authorization";
+      });
+  if (authIt != requestHeaders.end()) {
+    authIt->second = headerValue;
+  } else {
+    requestHeaders.emplace_back("Authorization", headerValue);
+  }
+}
+
 CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
 mainThreadLoadTilesetJsonFromAssetEndpoint(
     const TilesetExternals& externals,
+    const TilesetContentOptions& contentOptions,
     const AssetEndpoint& endpoint,
     int64_t ionAssetID,
     std::string ionAccessToken,
     std::string ionAssetEndpointUrl,
     CesiumIonTilesetLoader::AuthorizationHeaderChangeListener
         headerChangeListener,
-    bool showCreditsOnScreen) {
+    bool showCreditsOnScreen,
+    bool isStoredEndpoint) {
   std::vector<LoaderCreditResult> credits;
   if (externals.pCreditSystem) {
     credits.reserve(endpoint.attributions.size());
@@ -97,13 +371,18 @@ mainThreadLoadTilesetJsonFromAssetEndpoint(
   return TilesetJsonLoader::createLoader(
              externals,
              endpoint.url,
-             requestHeaders)
+             requestHeaders,
+             contentOptions.createChildTilesLazily,
+             contentOptions.prefetchRootTileContent)
       .thenImmediately([credits = std::move(credits),
                         requestHeaders,
                         ionAssetID,
                         ionAccessToken = std::move(ionAccessToken),
                         ionAssetEndpointUrl = std::move(ionAssetEndpointUrl),
-                        headerChangeListener = std::move(headerChangeListener)](
+                        headerChangeListener = std::move(headerChangeListener),
+                        pEndpointCache = externals.pIonEndpointCache,
+                        endpointAccessToken = endpoint.accessToken,
+                        isStoredEndpoint](
                            TilesetContentLoaderResult<TilesetJsonLoader>&&
                                tilesetJsonResult) mutable {
         if (tilesetJsonResult.credits.empty()) {
@@ -122,7 +401,10 @@ mainThreadLoadTilesetJsonFromAssetEndpoint(
               std::move(ionAccessToken),
               std::move(ionAssetEndpointUrl),
               std::move(tilesetJsonResult.pLoader),
-              std::move(headerChangeListener));
+              std::move(headerChangeListener),
+              pEndpointCache,
+              std::move(endpointAccessToken),
+              isStoredEndpoint);
           result.pRootTile = std::move(tilesetJsonResult.pRootTile);
           result.credits = std::move(tilesetJsonResult.credits);
           result.requestHeaders = std::move(requestHeaders);
@@ -143,7 +425,8 @@ mainThreadLoadLayerJsonFromAssetEndpoint(
     std::string ionAssetEndpointUrl,
     CesiumIonTilesetLoader::AuthorizationHeaderChangeListener
         headerChangeListener,
-    bool showCreditsOnScreen) {
+    bool showCreditsOnScreen,
+    bool isStoredEndpoint) {
   std::vector<LoaderCreditResult> credits;
   if (externals.pCreditSystem) {
     credits.reserve(endpoint.attributions.size());
@@ -173,7 +456,10 @@ mainThreadLoadLayerJsonFromAssetEndpoint(
                         ionAssetID,
                         ionAccessToken = std::move(ionAccessToken),
                         ionAssetEndpointUrl = std::move(ionAssetEndpointUrl),
-                        headerChangeListener = std::move(headerChangeListener)](
+                        headerChangeListener = std::move(headerChangeListener),
+                        pEndpointCache = externals.pIonEndpointCache,
+                        endpointAccessToken = endpoint.accessToken,
+                        isStoredEndpoint](
                            TilesetContentLoaderResult<LayerJsonTerrainLoader>&&
                                tilesetJsonResult) mutable {
         if (tilesetJsonResult.credits.empty()) {
@@ -192,7 +478,10 @@ mainThreadLoadLayerJsonFromAssetEndpoint(
               std::move(ionAccessToken),
               std::move(ionAssetEndpointUrl),
               std::move(tilesetJsonResult.pLoader),
-              std::move(headerChangeListener));
+              std::move(headerChangeListener),
+              pEndpointCache,
+              std::move(endpointAccessToken),
+              isStoredEndpoint);
           result.pRootTile = std::move(tilesetJsonResult.pRootTile);
           result.credits = std::move(tilesetJsonResult.credits);
           result.requestHeaders = std::move(requestHeaders);
@@ -203,6 +492,49 @@ mainThreadLoadLayerJsonFromAssetEndpoint(
       });
 }
 
+CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
+mainThreadLoadFromAssetEndpoint(
+    const TilesetExternals& externals,
+    const TilesetContentOptions& contentOptions,
+    const AssetEndpoint& endpoint,
+    int64_t ionAssetID,
+    std::string ionAccessToken,
+    std::string ionAssetEndpointUrl,
+    CesiumIonTilesetLoader::AuthorizationHeaderChangeListener
+        headerChangeListener,
+    bool showCreditsOnScreen,
+    bool isStoredEndpoint) {
+  if (endpoint.type == "TERRAIN") {
+    return mainThreadLoadLayerJsonFromAssetEndpoint(
+        externals,
+        contentOptions,
+        endpoint,
+        ionAssetID,
+        std::move(ionAccessToken),
+        std::move(ionAssetEndpointUrl),
+        std::move(headerChangeListener),
+        showCreditsOnScreen,
+        isStoredEndpoint);
+  } else if (endpoint.type == "3DTILES") {
+    return mainThreadLoadTilesetJsonFromAssetEndpoint(
+        externals,
+        contentOptions,
+        endpoint,
+        ionAssetID,
+        std::move(ionAccessToken),
+        std::move(ionAssetEndpointUrl),
+        std::move(headerChangeListener),
+        showCreditsOnScreen,
+        isStoredEndpoint);
+  }
+
+  TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
+  result.errors.emplaceError(fmt::format(
+      "Received unsupported asset response type: {}",
+      endpoint.type));
+  return externals.asyncSystem.createResolvedFuture(std::move(result));
+}
+
 CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
 mainThreadHandleEndpointResponse(
     const TilesetExternals& externals,
@@ -234,106 +566,69 @@ mainThreadHandleEndpointResponse(
     return externals.asyncSystem.createResolvedFuture(std::move(result));
   }
 
-  const gsl::span<const std::byte> data = pResponse->data();
-
-  rapidjson::Document ionResponse;
-  ionResponse.Parse(reinterpret_cast<const char*>(data.data()), data.size());
-
-  if (ionResponse.HasParseError()) {
-    TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
-    result.errors.emplaceError(fmt::format(
-        "Error when parsing Cesium ion response JSON, error code {} at byte "
-        "offset {}",
-        ionResponse.GetParseError(),
-        ionResponse.GetErrorOffset()));
+  TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
+  std::optional<AssetEndpoint> maybeEndpoint =
+      parseEndpointResponse(pResponse->data(), result.errors);
+  if (!maybeEndpoint) {
     return externals.asyncSystem.createResolvedFuture(std::move(result));
   }
 
-  AssetEndpoint endpoint;
-  if (externals.pCreditSystem) {
-    const auto attributionsIt = ionResponse.FindMember("attributions");
-    if (attributionsIt != ionResponse.MemberEnd() &&
-        attributionsIt->value.IsArray()) {
-
-      for (const rapidjson::Value& attribution :
-           attributionsIt->value.GetArray()) {
-        AssetEndpointAttribution& endpointAttribution =
-            endpoint.attributions.emplace_back();
-        const auto html = attribution.FindMember("html");
-        if (html != attribution.MemberEnd() && html->value.IsString()) {
-          endpointAttribution.html = html->value.GetString();
-        }
-        auto collapsible = attribution.FindMember("collapsible");
-        if (collapsible != attribution.MemberEnd() &&
-            collapsible->value.IsBool()) {
-          endpointAttribution.collapsible = collapsible->value.GetBool();
-        }
-      }
-    }
+  if (externals.pIonEndpointCache) {
+    storeEndpointResponse(*externals.pIonEndpointCache, *pRequest);
   }
 
-  std::string type =
-      CesiumUtility::JsonHelpers::getStringOrDefault(ionResponse, "type", "");
-  std::string url =
-      CesiumUtility::JsonHelpers::getStringOrDefault(ionResponse, "url", "");
-  std::string accessToken = CesiumUtility::JsonHelpers::getStringOrDefault(
-      ionResponse,
-      "accessToken",
-      "");
-  std::string externalType = CesiumUtility::JsonHelpers::getStringOrDefault(
-      ionResponse,
-      "externalType",
-      "");
-
-  if (!externalType.empty()) {
-    type = externalType;
-    const auto optionsIt = ionResponse.FindMember("options");
-    if (optionsIt != ionResponse.MemberEnd() && optionsIt->value.IsObject()) {
-      url = CesiumUtility::JsonHelpers::getStringOrDefault(
-          optionsIt->value,
-          "url",
-          url);
-    }
-  }
+  const AssetEndpoint& endpoint =
+      endpointCache.insert_or_assign(requestUrl, std::move(*maybeEndpoint))
+          .first->second;
+  return mainThreadLoadFromAssetEndpoint(
+      externals,
+      contentOptions,
+      endpoint,
+      ionAssetID,
+      std::move(ionAccessToken),
+      std::move(ionAssetEndpointUrl),
+      std::move(headerChangeListener),
+      showCreditsOnScreen,
+      false);
+}
+} // namespace
 
-  if (type == "TERRAIN") {
-    // For terrain resources, we need to append `/layer.json` to the end of
-    // the URL.
-    url = CesiumUtility::Uri::resolve(url, "layer.json", true);
-    endpoint.type = type;
-    endpoint.url = url;
-    endpoint.accessToken = accessToken;
-    endpointCache[requestUrl] = endpoint;
-    return mainThreadLoadLayerJsonFromAssetEndpoint(
-        externals,
-        contentOptions,
-        endpoint,
-        ionAssetID,
-        std::move(ionAccessToken),
-        std::move(ionAssetEndpointUrl),
-        std::move(headerChangeListener),
-        showCreditsOnScreen);
-  } else if (type == "3DTILES") {
-    endpoint.type = type;
-    endpoint.url = url;
-    endpoint.accessToken = accessToken;
-    endpointCache[requestUrl] = endpoint;
-    return mainThreadLoadTilesetJsonFromAssetEndpoint(
-        externals,
-        endpoint,
-        ionAssetID,
-        std::move(ionAccessToken),
-        std::move(ionAssetEndpointUrl),
-        std::move(headerChangeListener),
-        showCreditsOnScreen);
+/**
+ * @brief The parts of a {@link TileLoadInput} that are needed to request a
+ * tile again after the input itself is gone.
+ */
+struct CesiumIonTilesetLoader::TileReloadInput {
+  explicit TileReloadInput(const TileLoadInput& loadInput)
+      : pTile{&loadInput.tile},
+        pContentOptions{&loadInput.contentOptions},
+        asyncSystem{loadInput.asyncSystem},
+        pAssetAccessor{loadInput.pAssetAccessor},
+        pLogger{loadInput.pLogger},
+        requestHeaders{loadInput.requestHeaders},
+        pCanceled{loadInput.pCanceled},
+        decodeThreadPool{loadInput.decodeThreadPool} {}
+
+  TileLoadInput getLoadInput() const {
+    return TileLoadInput{
+        *this->pTile,
+        *this->pContentOptions,
+        this->asyncSystem,
+        this->pAssetAccessor,
+        this->pLogger,
+        this->requestHeaders,
+        this->pCanceled,
+        this->decodeThreadPool};
   }
 
-  TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
-  result.errors.emplaceError(
-      fmt::format("Received unsupported asset response type: {}", type));
-  return externals.asyncSystem.createResolvedFuture(std::move(result));
-}
-} // namespace
+  const Tile* pTile;
+  const TilesetContentOptions* pContentOptions;
+  CesiumAsync::AsyncSystem asyncSystem;
+  std::shared_ptr<CesiumAsync::IAssetAccessor> pAssetAccessor;
+  std::shared_ptr<spdlog::logger> pLogger;
+  std::vector<CesiumAsync::IAssetAccessor::THeader> requestHeaders;
+  std::shared_ptr<const std::atomic<bool>> pCanceled;
+  std::optional<CesiumAsync::ThreadPool> decodeThreadPool;
+};
 
 CesiumIonTilesetLoader::CesiumIonTilesetLoader(
     int64_t ionAssetID,
@@ -342,20 +637,27 @@ CesiumIonTilesetLoader::CesiumIonTilesetLoader(
     std::unique_ptr<TilesetContentLoader>&& pAggregatedLoader,
     std::function<
         void(const std::string& header, const std::string& headerValue)>&&
-        headerChangeListener)
+        headerChangeListener,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pEndpointCache,
+    std::string&& endpointAccessToken,
+    bool isStoredEndpoint)
     : _refreshTokenState{TokenRefreshState::None},
       _ionAssetID{ionAssetID},
       _ionAccessToken{std::move(ionAccessToken)},
       _ionAssetEndpointUrl{std::move(ionAssetEndpointUrl)},
       _pAggregatedLoader{std::move(pAggregatedLoader)},
-      _headerChangeListener{std::move(headerChangeListener)} {}
+      _headerChangeListener{std::move(headerChangeListener)},
+      _pEndpointCache{pEndpointCache},
+      _endpointAccessToken{std::move(endpointAccessToken)},
+      _refreshTokenFuture{},
+      _tokenVersion{0},
+      _tokenRejected{false},
+      _tokenRefreshTime{
+          getTokenRefreshTime(this->_endpointAccessToken, isStoredEndpoint)} {}
 
 CesiumAsync::Future<TileLoadResult>
 CesiumIonTilesetLoader::loadTileContent(const TileLoadInput& loadInput) {
-  if (this->_refreshTokenState == TokenRefreshState::Loading) {
-    return loadInput.asyncSystem.createResolvedFuture(
-        TileLoadResult::createRetryLaterResult(nullptr));
-  } else if (this->_refreshTokenState == TokenRefreshState::Failed) {
+  if (this->_refreshTokenState == TokenRefreshState::Failed) {
     return loadInput.asyncSystem.createResolvedFuture(
         TileLoadResult::createFailedResult(nullptr));
   }
@@ -364,30 +666,48 @@ CesiumIonTilesetLoader::loadTileContent(const TileLoadInput& loadInput) {
   const auto& pAssetAccessor = loadInput.pAssetAccessor;
   const auto& pLogger = loadInput.pLogger;
 
-  // TODO: the way this is structured, requests already in progress
-  // with the old key might complete after the key has been updated,
-  // and there's nothing here clever enough to avoid refreshing the
-  // key _again_ in that instance.
-  auto refreshTokenInMainThread =
-      [this, pLogger, pAssetAccessor, asyncSystem]() {
-        this->refreshTokenInMainThread(pLogger, pAssetAccessor, asyncSystem);
-      };
+  // The token is refreshed shortly before it expires, while tiles are still
+  // loaded with it, so that they don't fail in the meantime.
+  if (this->_refreshTokenState != TokenRefreshState::Loading &&
+      std::time(nullptr) >= this->_tokenRefreshTime) {
+    this->refreshTokenInMainThread(pLogger, pAssetAccessor, asyncSystem);
+  }
+
+  // A tile that is requested with a token that was rejected fails, too, so it
+  // waits for the new token instead.
+  if (this->_refreshTokenState == TokenRefreshState::Loading &&
+      this->_tokenRejected) {
+    return this->loadTileContentAfterTokenRefresh(TileReloadInput(loadInput));
+  }
 
   return this->_pAggregatedLoader->loadTileContent(loadInput).thenImmediately(
-      [asyncSystem,
-       refreshTokenInMainThread = std::move(refreshTokenInMainThread)](
+      [this,
+       asyncSystem,
+       tokenVersion = this->_tokenVersion,
+       reloadInput = TileReloadInput(loadInput)](
           TileLoadResult&& result) mutable {
-        // check to see if we need to refresh token
-        if (result.pCompletedRequest) {
-          auto response = result.pCompletedRequest->response();
-          if (response->statusCode() == 401) {
-            // retry later
-            result.state = TileLoadResultState::RetryLater;
-            asyncSystem.runInMainThread(std::move(refreshTokenInMainThread));
-          }
+        if (!isUnauthorized(result)) {
+          return asyncSystem.createResolvedFuture(std::move(result));
         }
 
-        return std::move(result);
+        return asyncSystem.runInMainThread(
+            [this,
+             tokenVersion,
+             reloadInput = std::move(reloadInput)]() mutable {
+              // The first tile that is rejected with a token refreshes it. The
+              // others that were requested with the same token wait for the
+              // new one, and those that were requested with an older token
+              // don't need to wait.
+              if (tokenVersion == this->_tokenVersion) {
+                this->_tokenRejected = true;
+                this->refreshTokenInMainThread(
+                    reloadInput.pLogger,
+                    reloadInput.pAssetAccessor,
+                    reloadInput.asyncSystem);
+              }
+              return this->loadTileContentAfterTokenRefresh(
+                  std::move(reloadInput));
+            });
       });
 }
 
@@ -397,6 +717,38 @@ CesiumIonTilesetLoader::createTileChildren(const Tile& tile) {
   return pLoader->createTileChildren(tile);
 }
 
+CesiumAsync::Future<TileLoadResult>
+CesiumIonTilesetLoader::loadTileContentAfterTokenRefresh(
+    TileReloadInput&& reloadInput) {
+  assert(this->_refreshTokenFuture && "The token has never been refreshed");
+
+  return this->_refreshTokenFuture->thenInMainThread(
+      [this,
+       pReloadInput =
+           std::make_shared<TileReloadInput>(std::move(reloadInput))]() {
+        if (this->_refreshTokenState == TokenRefreshState::Failed) {
+          return pReloadInput->asyncSystem.createResolvedFuture(
+              TileLoadResult::createFailedResult(nullptr));
+        }
+
+        // The tile is requested again right away with the new token, rather
+        // than the next time that it is loaded.
+        setAuthorizationHeader(
+            pReloadInput->requestHeaders,
+            "Bearer " + this->_endpointAccessToken);
+        return this->_pAggregatedLoader
+            ->loadTileContent(pReloadInput->getLoadInput())
+            .thenImmediately([pReloadInput](TileLoadResult&& result) {
+              // The new token was rejected, too, so the tile is loaded again
+              // later.
+              if (isUnauthorized(result)) {
+                result.state = TileLoadResultState::RetryLater;
+              }
+              return std::move(result);
+            });
+      });
+}
+
 void CesiumIonTilesetLoader::refreshTokenInMainThread(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
@@ -411,22 +763,33 @@ void CesiumIonTilesetLoader::refreshTokenInMainThread(
       this->_ionAssetID,
       this->_ionAccessToken,
       this->_ionAssetEndpointUrl);
-  pAssetAccessor->get(asyncSystem, url)
-      .thenInMainThread(
-          [this,
-           pLogger](std::shared_ptr<CesiumAsync::IAssetRequest>&& pIonRequest) {
-            const CesiumAsync::IAssetResponse* pIonResponse =
-                pIonRequest->response();
-
-            if (!pIonResponse) {
-              this->_refreshTokenState = TokenRefreshState::Failed;
-              return;
-            }
-
-            uint16_t statusCode = pIonResponse->statusCode();
-            if (statusCode >= 200 && statusCode < 300) {
-              auto accessToken = getNewAccessToken(pIonResponse, pLogger);
-              if (accessToken) {
+  this->_refreshTokenFuture =
+      pAssetAccessor->get(asyncSystem, url)
+          .thenInMainThread(
+              [this, pLogger](
+                  std::shared_ptr<CesiumAsync::IAssetRequest>&& pIonRequest) {
+                const CesiumAsync::IAssetResponse* pIonResponse =
+                    pIonRequest->response();
+
+                std::optional<std::string> accessToken;
+                if (pIonResponse && pIonResponse->statusCode() >= 200 &&
+                    pIonResponse->statusCode() < 300) {
+                  accessToken = getNewAccessToken(pIonResponse, pLogger);
+                }
+
+                if (!accessToken) {
+                  // A token that is about to expire can still be used, so its
+                  // refresh is tried again later. One that was rejected can't.
+                  if (this->_tokenRejected) {
+                    this->_refreshTokenState = TokenRefreshState::Failed;
+                  } else {
+                    this->_refreshTokenState = TokenRefreshState::None;
+                    this->_tokenRefreshTime =
+                        std::time(nullptr) + tokenRefreshRetryDelay;
+                  }
+                  return;
+                }
+
                 this->_headerChangeListener(
                     "Authorization",
                     "Bearer " + *accessToken);
@@ -436,14 +799,18 @@ void CesiumIonTilesetLoader::refreshTokenInMainThread(
                 if (cacheIt != endpointCache.end()) {
                   cacheIt->second.accessToken = accessToken.value();
                 }
+                if (this->_pEndpointCache) {
+                  storeEndpointResponse(*this->_pEndpointCache, *pIonRequest);
+                }
 
+                this->_endpointAccessToken = std::move(*accessToken);
+                ++this->_tokenVersion;
+                this->_tokenRejected = false;
+                this->_tokenRefreshTime =
+                    getTokenRefreshTime(this->_endpointAccessToken, false);
                 this->_refreshTokenState = TokenRefreshState::Done;
-                return;
-              }
-            }
-
-            this->_refreshTokenState = TokenRefreshState::Failed;
-          });
+              })
+          .share();
 }
 
 CesiumAsync::Future<TilesetContentLoaderResult<CesiumIonTilesetLoader>>
@@ -458,72 +825,57 @@ CesiumIonTilesetLoader::createLoader(
   std::string ionUrl =
       createEndpointResource(ionAssetID, ionAccessToken, ionAssetEndpointUrl);
   auto cacheIt = endpointCache.find(ionUrl);
+
+  // An endpoint response that was stored in an earlier session lets the
+  // tileset load without waiting for the ion API. It's requested again once
+  // tiles load.
+  bool isStoredEndpoint = false;
+  if (cacheIt == endpointCache.end() && externals.pIonEndpointCache) {
+    std::optional<std::vector<std::byte>> maybeResponse =
+        getStoredEndpointResponse(*externals.pIonEndpointCache, ionUrl);
+    if (maybeResponse) {
+      CesiumUtility::ErrorList errors;
+      std::optional<AssetEndpoint> maybeEndpoint =
+          parseEndpointResponse(*maybeResponse, errors);
+      if (maybeEndpoint) {
+        cacheIt =
+            endpointCache.insert_or_assign(ionUrl, std::move(*maybeEndpoint))
+                .first;
+        isStoredEndpoint = true;
+      }
+    }
+  }
+
   if (cacheIt != endpointCache.end()) {
-    const auto& endpoint = cacheIt->second;
-    if (endpoint.type == "TERRAIN") {
-      return mainThreadLoadLayerJsonFromAssetEndpoint(
-                 externals,
-                 contentOptions,
-                 endpoint,
-                 ionAssetID,
-                 ionAccessToken,
-                 ionAssetEndpointUrl,
-                 headerChangeListener,
-                 showCreditsOnScreen)
-          .thenInMainThread(
-              [externals,
+    return mainThreadLoadFromAssetEndpoint(
+               externals,
                contentOptions,
+               cacheIt->second,
                ionAssetID,
                ionAccessToken,
                ionAssetEndpointUrl,
                headerChangeListener,
-               showCreditsOnScreen](
-                  TilesetContentLoaderResult<CesiumIonTilesetLoader>&& result) {
-                return refreshTokenIfNeeded(
-                    externals,
-                    contentOptions,
-                    ionAssetID,
-                    ionAccessToken,
-                    ionAssetEndpointUrl,
-                    headerChangeListener,
-                    showCreditsOnScreen,
-                    std::move(result));
-              });
-    } else if (endpoint.type == "3DTILES") {
-      return mainThreadLoadTilesetJsonFromAssetEndpoint(
-                 externals,
-                 endpoint,
-                 ionAssetID,
-                 ionAccessToken,
-                 ionAssetEndpointUrl,
-                 headerChangeListener,
-                 showCreditsOnScreen)
-          .thenInMainThread(
-              [externals,
-               contentOptions,
-               ionAssetID,
-               ionAccessToken,
-               ionAssetEndpointUrl,
-               headerChangeListener,
-               showCreditsOnScreen](
-                  TilesetContentLoaderResult<CesiumIonTilesetLoader>&& result) {
-                return refreshTokenIfNeeded(
-                    externals,
-                    contentOptions,
-                    ionAssetID,
-                    ionAccessToken,
-                    ionAssetEndpointUrl,
-                    headerChangeListener,
-                    showCreditsOnScreen,
-                    std::move(result));
-              });
-    }
-
-    TilesetContentLoaderResult<CesiumIonTilesetLoader> result;
-    result.errors.emplaceError(fmt::format(
-        "Received unsupported asset response type: {}",
-        endpoint.type));
-    return externals.asyncSystem.createResolvedFuture(std::move(result));
+               showCreditsOnScreen,
+               isStoredEndpoint)
+        .thenInMainThread(
+            [externals,
+             contentOptions,
+             ionAssetID,
+             ionAccessToken,
+             ionAssetEndpointUrl,
+             headerChangeListener,
+             showCreditsOnScreen](
+                TilesetContentLoaderResult<CesiumIonTilesetLoader>&& result) {
+              return refreshTokenIfNeeded(
+                  externals,
+                  contentOptions,
+                  ionAssetID,
+                  ionAccessToken,
+                  ionAssetEndpointUrl,
+                  headerChangeListener,
+                  showCreditsOnScreen,
+                  std::move(result));
+            });
   } else {
     return externals.pAssetAccessor->get(externals.asyncSystem, ionUrl)
         .thenInMainThread(
@@ -559,10 +911,14 @@ CesiumIonTilesetLoader::refreshTokenIfNeeded(
     TilesetContentLoaderResult<CesiumIonTilesetLoader>&& result) {
   if (result.errors.hasErrors()) {
     if (result.statusCode == 401) {
-      endpointCache.erase(createEndpointResource(
+      const std::string ionUrl = createEndpointResource(
           ionAssetID,
           ionAccessToken,
-          ionAssetEndpointUrl));
+          ionAssetEndpointUrl);
+      endpointCache.erase(ionUrl);
+      if (externals.pIonEndpointCache) {
+        expireEndpointResponse(*externals.pIonEndpointCache, ionUrl);
+      }
       return CesiumIonTilesetLoader::createLoader(
           externals,
           contentOptions,
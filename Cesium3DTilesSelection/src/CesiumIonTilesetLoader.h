@@ -4,8 +4,13 @@
 
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
 #include <Cesium3DTilesSelection/TilesetExternals.h>
+#include <CesiumAsync/SharedFuture.h>
 
+#include <cstdint>
+#include <ctime>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <string>
 
 namespace Cesium3DTilesSelection {
@@ -21,7 +26,11 @@ public:
       std::string&& ionAccessToken,
       std::string&& ionAssetEndpointUrl,
       std::unique_ptr<TilesetContentLoader>&& pAggregatedLoader,
-      AuthorizationHeaderChangeListener&& headerChangeListener);
+      AuthorizationHeaderChangeListener&& headerChangeListener,
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pEndpointCache =
+          nullptr,
+      std::string&& endpointAccessToken = {},
+      bool isStoredEndpoint = false);
 
   CesiumAsync::Future<TileLoadResult>
   loadTileContent(const TileLoadInput& loadInput) override;
@@ -50,6 +59,11 @@ public:
       TilesetContentLoaderResult<CesiumIonTilesetLoader>&& result);
 
 private:
+  struct TileReloadInput;
+
+  CesiumAsync::Future<TileLoadResult>
+  loadTileContentAfterTokenRefresh(TileReloadInput&& reloadInput);
+
   void refreshTokenInMainThread(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
@@ -61,5 +75,11 @@ private:
   std::string _ionAssetEndpointUrl;
   std::unique_ptr<TilesetContentLoader> _pAggregatedLoader;
   AuthorizationHeaderChangeListener _headerChangeListener;
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pEndpointCache;
+  std::string _endpointAccessToken;
+  std::optional<CesiumAsync::SharedFuture<void>> _refreshTokenFuture;
+  uint32_t _tokenVersion;
+  bool _tokenRejected;
+  std::time_t _tokenRefreshTime;
 };
 } // namespace Cesium3DTilesSelection
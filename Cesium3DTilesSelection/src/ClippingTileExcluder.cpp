@@ -0,0 +1,103 @@
+#include "TileUtilities.h"
+
+#include <Cesium3DTilesSelection/ClippingTileExcluder.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumGeometry/CullingResult.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/BoundingRegionWithLooseFittingHeights.h>
+#include <CesiumGeospatial/S2CellBoundingVolume.h>
+
+#include <utility>
+#include <variant>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace Cesium3DTilesSelection::CesiumImpl;
+
+namespace Cesium3DTilesSelection {
+namespace {
+CullingResult
+intersectPlane(const BoundingVolume& boundingVolume, const Plane& plane) {
+  struct Operation {
+    const Plane& plane;
+
+    CullingResult operator()(const OrientedBoundingBox& boundingBox) noexcept {
+      return boundingBox.intersectPlane(plane);
+    }
+
+    CullingResult operator()(const BoundingRegion& boundingRegion) noexcept {
+      return boundingRegion.intersectPlane(plane);
+    }
+
+    CullingResult operator()(const BoundingSphere& boundingSphere) noexcept {
+      return boundingSphere.intersectPlane(plane);
+    }
+
+    CullingResult operator()(
+        const BoundingRegionWithLooseFittingHeights& boundingRegion) noexcept {
+      return boundingRegion.getBoundingRegion().intersectPlane(plane);
+    }
+
+    CullingResult operator()(const S2CellBoundingVolume& s2Cell) noexcept {
+      return s2Cell.intersectPlane(plane);
+    }
+  };
+
+  return std::visit(Operation{plane}, boundingVolume);
+}
+} // namespace
+
+ClippingTileExcluder::ClippingTileExcluder(
+    std::vector<Plane> planes,
+    std::vector<CartographicPolygon> polygons,
+    bool invertPolygons)
+    : _planes(std::move(planes)),
+      _polygons(std::move(polygons)),
+      _invertPolygons(invertPolygons),
+      _polygonsRectangle(computePolygonsRectangle(this->_polygons)) {}
+
+bool ClippingTileExcluder::shouldExclude(const Tile& tile) const noexcept {
+  return this->evaluateTile(tile) == TileExclusion::Excluded;
+}
+
+TileExclusion
+ClippingTileExcluder::evaluateTile(const Tile& tile) const noexcept {
+  const BoundingVolume& boundingVolume = tile.getBoundingVolume();
+
+  // The tile is only kept entirely if it is in front of every plane.
+  bool keptByPlanes = true;
+  for (const Plane& plane : this->_planes) {
+    const CullingResult result = intersectPlane(boundingVolume, plane);
+    if (result == CullingResult::Outside) {
+      return TileExclusion::Excluded;
+    }
+    keptByPlanes = keptByPlanes && result == CullingResult::Inside;
+  }
+
+  // Without polygons, nothing is clipped away by them, unless they are
+  // inverted, so that everything outside of them is.
+  TileExclusion polygonsExclusion = TileExclusion::IncludedWithDescendants;
+  if (!this->_polygons.empty() || this->_invertPolygons) {
+    polygonsExclusion = evaluatePolygonsExclusion(
+        boundingVolume,
+        this->_polygons,
+        this->_polygonsRectangle,
+        this->_invertPolygons);
+  }
+
+  if (polygonsExclusion == TileExclusion::Excluded) {
+    return TileExclusion::Excluded;
+  }
+  return keptByPlanes &&
+                 polygonsExclusion == TileExclusion::IncludedWithDescendants
+             ? TileExclusion::IncludedWithDescendants
+             : TileExclusion::Included;
+}
+
+bool ClippingTileExcluder::isPartiallyClipped(const Tile& tile) const noexcept {
+  return this->evaluateTile(tile) == TileExclusion::Included;
+}
+
+} // namespace Cesium3DTilesSelection
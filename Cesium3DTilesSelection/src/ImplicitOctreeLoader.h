@@ -1,14 +1,18 @@
 #pragma once
 
+#include "TileChildrenPool.h"
+
 #include <Cesium3DTilesContent/SubtreeAvailability.h>
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
 #include <CesiumGeometry/OctreeTileID.h>
 #include <CesiumGeometry/OrientedBoundingBox.h>
 #include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumUtility/Uri.h>
 
 #include <cmath>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
@@ -35,13 +39,22 @@ public:
         _boundingVolume{std::forward<ImplicitBoundingVolumeType>(volume)},
         _loadedSubtrees(static_cast<size_t>(std::ceil(
             static_cast<float>(availableLevels) /
-            static_cast<float>(subtreeLevels)))) {}
+            static_cast<float>(subtreeLevels)))),
+        _loadingSubtrees(_loadedSubtrees.size()),
+        _numberOfSubtreesLoading{0},
+        _subtreeTileCounts(_loadedSubtrees.size()),
+        _subtreePrefetchLevels{0},
+        _childrenPool(8) {}
 
   CesiumAsync::Future<TileLoadResult>
   loadTileContent(const TileLoadInput& loadInput) override;
 
   TileChildrenResult createTileChildren(const Tile& tile) override;
 
+  void releaseTileChildren(std::vector<Tile>&& children) override;
+
+  bool canRecreateTileChildren(const Tile& tile) const noexcept override;
+
   uint32_t getSubtreeLevels() const noexcept;
 
   uint32_t getAvailableLevels() const noexcept;
@@ -53,14 +66,40 @@ public:
       Cesium3DTilesContent::SubtreeAvailability&& subtreeAvailability);
 
 private:
-  std::string _baseUrl;
-  std::string _contentUrlTemplate;
-  std::string _subtreeUrlTemplate;
+  CesiumAsync::Future<bool> loadSubtree(
+      const CesiumGeometry::OctreeTileID& subtreeID,
+      const TileLoadInput& loadInput);
+
+  void prefetchChildSubtrees(
+      const CesiumGeometry::OctreeTileID& subtreeID,
+      const Cesium3DTilesContent::SubtreeAvailability& subtreeAvailability,
+      const CesiumGeometry::OctreeTileID& tileID,
+      const TileLoadInput& loadInput);
+
+  void retainSubtree(const CesiumGeometry::OctreeTileID& tileID);
+
+  void releaseSubtree(const CesiumGeometry::OctreeTileID& tileID);
+
+  CesiumUtility::BaseUri _baseUrl;
+  CesiumUtility::UriTemplate _contentUrlTemplate;
+  CesiumUtility::UriTemplate _subtreeUrlTemplate;
   uint32_t _subtreeLevels;
   uint32_t _availableLevels;
   ImplicitOctreeBoundingVolume _boundingVolume;
   std::vector<
       std::unordered_map<uint64_t, Cesium3DTilesContent::SubtreeAvailability>>
       _loadedSubtrees;
+  // The subtrees that are being loaded, by level and Morton index like
+  // _loadedSubtrees.
+  std::vector<std::unordered_set<uint64_t>> _loadingSubtrees;
+  size_t _numberOfSubtreesLoading;
+  // The number of tiles created by this loader in each subtree, by level and
+  // Morton index like _loadedSubtrees. A subtree is unloaded once it has no
+  // tiles.
+  std::vector<std::unordered_map<uint64_t, size_t>> _subtreeTileCounts;
+  // The most levels above the bottom of a subtree that child subtrees have been
+  // prefetched from.
+  uint32_t _subtreePrefetchLevels;
+  TileChildrenPool _childrenPool;
 };
 } // namespace Cesium3DTilesSelection
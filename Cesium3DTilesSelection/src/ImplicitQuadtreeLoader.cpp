@@ -2,15 +2,18 @@
 
 #include "logTileLoadResult.h"
 
+#include <Cesium3DTilesContent/DecodedModelCache.h>
 #include <Cesium3DTilesContent/GltfConverters.h>
 #include <Cesium3DTilesContent/ImplicitTilingUtilities.h>
 #include <Cesium3DTilesSelection/Tile.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/TaskPriority.h>
 #include <CesiumGeometry/QuadtreeTileID.h>
 #include <CesiumUtility/Uri.h>
 
 #include <spdlog/logger.h>
 
+#include <algorithm>
 #include <type_traits>
 #include <utility>
 #include <variant>
@@ -19,6 +22,10 @@ using namespace Cesium3DTilesContent;
 
 namespace Cesium3DTilesSelection {
 namespace {
+// Below the priority groups of all tile loads, so that prefetched subtrees only
+// take the requests that no tile is waiting for.
+const CesiumAsync::TaskPriority subtreePrefetchPriority{-1, 0.0};
+
 struct BoundingVolumeSubdivision {
   BoundingVolume operator()(const CesiumGeospatial::BoundingRegion& region) {
     return ImplicitTilingUtilities::computeBoundingVolume(region, this->tileID);
@@ -49,7 +56,8 @@ std::vector<Tile> populateSubtree(
     uint32_t subtreeLevels,
     const CesiumGeometry::QuadtreeTileID& subtreeRootID,
     const Tile& tile,
-    ImplicitQuadtreeLoader& loader) {
+    ImplicitQuadtreeLoader& loader,
+    TileChildrenPool& childrenPool) {
   const CesiumGeometry::QuadtreeTileID& quadtreeID =
       std::get<CesiumGeometry::QuadtreeTileID>(tile.getTileID());
 
@@ -58,50 +66,60 @@ std::vector<Tile> populateSubtree(
     return {};
   }
 
+  // The availability of all of the children is read at once, because they're
+  // adjacent in the bitstreams.
+  const uint64_t relativeTileMortonID =
+      ImplicitTilingUtilities::computeRelativeMortonIndex(
+          subtreeRootID,
+          quadtreeID);
+  const uint32_t relativeChildLevel = relativeTileLevel + 1;
+  const bool childrenAreSubtreeRoots = relativeChildLevel == subtreeLevels;
+  const uint8_t availableChildren =
+      childrenAreSubtreeRoots
+          ? subtreeAvailability.getAvailableChildSubtrees(relativeTileMortonID)
+          : subtreeAvailability.getAvailableChildTiles(
+                relativeTileLevel,
+                relativeTileMortonID);
+  if (availableChildren == 0) {
+    // Don't tie up a block of the pool in a tile that has no children.
+    return {};
+  }
+
+  const uint8_t childrenWithContent =
+      childrenAreSubtreeRoots ? uint8_t(0)
+                              : subtreeAvailability.getAvailableChildContents(
+                                    relativeTileLevel,
+                                    relativeTileMortonID,
+                                    0);
+
   QuadtreeChildren childIDs = ImplicitTilingUtilities::getChildren(quadtreeID);
 
-  std::vector<Tile> children;
-  children.reserve(childIDs.size());
+  std::vector<Tile> children = childrenPool.allocate();
 
   for (const CesiumGeometry::QuadtreeTileID& childID : childIDs) {
-    uint64_t relativeChildMortonID =
-        ImplicitTilingUtilities::computeRelativeMortonIndex(
-            subtreeRootID,
-            childID);
-
-    uint32_t relativeChildLevel = relativeTileLevel + 1;
-    if (relativeChildLevel == subtreeLevels) {
-      if (subtreeAvailability.isSubtreeAvailable(relativeChildMortonID)) {
-        Tile& child = children.emplace_back(&loader);
-        child.setTransform(tile.getTransform());
-        child.setBoundingVolume(
-            subdivideBoundingVolume(childID, loader.getBoundingVolume()));
-        child.setGeometricError(tile.getGeometricError() * 0.5);
-        child.setRefine(tile.getRefine());
-        child.setTileID(childID);
-      }
-    } else {
-      if (subtreeAvailability.isTileAvailable(
-              relativeChildLevel,
-              relativeChildMortonID)) {
-        if (subtreeAvailability.isContentAvailable(
-                relativeChildLevel,
-                relativeChildMortonID,
-                0)) {
-          children.emplace_back(&loader);
-        } else {
-          children.emplace_back(&loader, TileEmptyContent{});
-        }
+    // The last digit of the child's Morton index, which is its bit in the
+    // masks.
+    const uint32_t childIndex = (childID.x & 1U) | ((childID.y & 1U) << 1);
+    const uint8_t childBit = uint8_t(1U << childIndex);
+    if ((availableChildren & childBit) == 0) {
+      continue;
+    }
 
-        Tile& child = children.back();
-        child.setTransform(tile.getTransform());
-        child.setBoundingVolume(
-            subdivideBoundingVolume(childID, loader.getBoundingVolume()));
-        child.setGeometricError(tile.getGeometricError() * 0.5);
-        child.setRefine(tile.getRefine());
-        child.setTileID(childID);
-      }
+    // The content of child subtree roots isn't known until their subtree is
+    // loaded.
+    if (childrenAreSubtreeRoots || (childrenWithContent & childBit) != 0) {
+      children.emplace_back(&loader);
+    } else {
+      children.emplace_back(&loader, TileEmptyContent{});
     }
+
+    Tile& child = children.back();
+    child.setTransform(tile.getTransform());
+    child.setBoundingVolume(
+        subdivideBoundingVolume(childID, loader.getBoundingVolume()));
+    child.setGeometricError(tile.getGeometricError() * 0.5);
+    child.setRefine(tile.getRefine());
+    child.setTileID(childID);
   }
 
   return children;
@@ -114,18 +132,36 @@ CesiumAsync::Future<TileLoadResult> requestTileContent(
     const std::string& tileUrl,
     const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
     CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets,
+    int32_t maximumTextureSize,
     bool applyTextureTransform,
-    const glm::dmat4& tileTransform) {
-  return pAssetAccessor->get(asyncSystem, tileUrl, requestHeaders)
-      .thenInWorkerThread([pLogger,
-                           ktx2TranscodeTargets,
-                           applyTextureTransform,
-                           &asyncSystem,
-                           pAssetAccessor,
-                           tileTransform,
-                           requestHeaders](
-                              std::shared_ptr<CesiumAsync::IAssetRequest>&&
-                                  pCompletedRequest) mutable {
+    bool convertBatchTables,
+    bool keepPointCloudsQuantized,
+    bool skipContentDecoding,
+    const std::shared_ptr<Cesium3DTilesContent::GltfModelCache>&
+        pGltfModelCache,
+    const std::shared_ptr<Cesium3DTilesContent::DecodedModelCache>&
+        pDecodedModelCache,
+    const glm::dmat4& tileTransform,
+    const std::shared_ptr<const std::atomic<bool>>& pCanceled,
+    const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool) {
+  return thenInDecodeThread(
+      decodeThreadPool,
+      pAssetAccessor->get(asyncSystem, tileUrl, requestHeaders),
+      [pLogger,
+       ktx2TranscodeTargets,
+       maximumTextureSize,
+       applyTextureTransform,
+       convertBatchTables,
+       keepPointCloudsQuantized,
+       skipContentDecoding,
+       pGltfModelCache,
+       pDecodedModelCache,
+       &asyncSystem,
+       pAssetAccessor,
+       tileTransform,
+       requestHeaders,
+       pCanceled](std::shared_ptr<CesiumAsync::IAssetRequest>&&
+                      pCompletedRequest) mutable {
         const CesiumAsync::IAssetResponse* pResponse =
             pCompletedRequest->response();
         auto fail = [&]() {
@@ -151,6 +187,19 @@ CesiumAsync::Future<TileLoadResult> requestTileContent(
           return fail();
         }
 
+        if (pCanceled && *pCanceled) {
+          // The tile is no longer needed, so don't spend time decoding it.
+          return asyncSystem.createResolvedFuture(
+              TileLoadResult::createRetryLaterResult(
+                  std::move(pCompletedRequest)));
+        }
+
+        if (skipContentDecoding) {
+          return asyncSystem.createResolvedFuture(
+              TileLoadResult::createFetchedResult(
+                  std::move(pCompletedRequest)));
+        }
+
         // find gltf converter
         const auto& responseData = pResponse->data();
         auto converter = GltfConverters::getConverterByMagic(responseData);
@@ -163,6 +212,7 @@ CesiumAsync::Future<TileLoadResult> requestTileContent(
           // Convert to gltf
           CesiumGltfReader::GltfReaderOptions gltfOptions;
           gltfOptions.ktx2TranscodeTargets = ktx2TranscodeTargets;
+          gltfOptions.maximumTextureSize = maximumTextureSize;
           gltfOptions.applyTextureTransform = applyTextureTransform;
           AssetFetcher assetFetcher{
               asyncSystem,
@@ -170,7 +220,15 @@ CesiumAsync::Future<TileLoadResult> requestTileContent(
               tileUrl,
               tileTransform,
               requestHeaders};
-          return converter(responseData, gltfOptions, assetFetcher)
+          assetFetcher.convertBatchTables = convertBatchTables;
+          assetFetcher.keepPointCloudsQuantized = keepPointCloudsQuantized;
+          assetFetcher.pGltfModelCache = pGltfModelCache;
+          assetFetcher.pDecodedModelCache = pDecodedModelCache;
+          return DecodedModelCache::convert(
+                     converter,
+                     responseData,
+                     gltfOptions,
+                     assetFetcher)
               .thenImmediately([pLogger, tileUrl, pCompletedRequest](
                                    GltfConverterResult&& result) {
                 // Report any errors if there are any
@@ -259,26 +317,16 @@ ImplicitQuadtreeLoader::loadTileContent(const TileLoadInput& loadInput) {
   auto subtreeIt =
       this->_loadedSubtrees[subtreeLevelIdx].find(subtreeMortonIdx);
   if (subtreeIt == this->_loadedSubtrees[subtreeLevelIdx].end()) {
-    // subtree is not loaded, so load it now.
-    std::string subtreeUrl = ImplicitTilingUtilities::resolveUrl(
-        this->_baseUrl,
-        this->_subtreeUrlTemplate,
-        subtreeID);
-    return SubtreeAvailability::loadSubtree(
-               ImplicitTileSubdivisionScheme::Quadtree,
-               this->_subtreeLevels,
-               asyncSystem,
-               pAssetAccessor,
-               pLogger,
-               subtreeUrl,
-               requestHeaders)
-        .thenInMainThread([this, subtreeID](std::optional<SubtreeAvailability>&&
-                                                subtreeAvailability) mutable {
-          if (subtreeAvailability) {
-            this->addSubtreeAvailability(
-                subtreeID,
-                std::move(*subtreeAvailability));
+    if (this->_loadingSubtrees[subtreeLevelIdx].count(subtreeMortonIdx)) {
+      // The subtree is already being loaded, perhaps by a prefetch.
+      return asyncSystem.createResolvedFuture(
+          TileLoadResult::createRetryLaterResult(nullptr));
+    }
 
+    // subtree is not loaded, so load it now.
+    return this->loadSubtree(subtreeID, loadInput)
+        .thenImmediately([](bool loaded) {
+          if (loaded) {
             // tell client to retry later
             return TileLoadResult::createRetryLaterResult(nullptr);
           } else {
@@ -288,6 +336,12 @@ ImplicitQuadtreeLoader::loadTileContent(const TileLoadInput& loadInput) {
         });
   }
 
+  this->prefetchChildSubtrees(
+      subtreeID,
+      subtreeIt->second,
+      *pQuadtreeID,
+      loadInput);
+
   // subtree is available, so check if tile has content or not. If it has, then
   // request it
   if (!subtreeIt->second.isContentAvailable(subtreeID, *pQuadtreeID, 0)) {
@@ -314,8 +368,16 @@ ImplicitQuadtreeLoader::loadTileContent(const TileLoadInput& loadInput) {
       tileUrl,
       requestHeaders,
       contentOptions.ktx2TranscodeTargets,
+      contentOptions.maximumTextureSize,
       contentOptions.applyTextureTransform,
-      tile.getTransform());
+      contentOptions.convertBatchTables,
+      contentOptions.keepPointCloudsQuantized,
+      contentOptions.skipContentDecoding,
+      contentOptions.pGltfModelCache,
+      contentOptions.pDecodedModelCache,
+      tile.getTransform(),
+      loadInput.pCanceled,
+      loadInput.decodeThreadPool);
 }
 
 TileChildrenResult
@@ -346,7 +408,12 @@ ImplicitQuadtreeLoader::createTileChildren(const Tile& tile) {
         this->_subtreeLevels,
         subtreeID,
         tile,
-        *this);
+        *this,
+        this->_childrenPool);
+    for (const Tile& child : children) {
+      this->retainSubtree(
+          std::get<CesiumGeometry::QuadtreeTileID>(child.getTileID()));
+    }
 
     return {std::move(children), TileLoadResultState::Success};
   }
@@ -354,6 +421,26 @@ ImplicitQuadtreeLoader::createTileChildren(const Tile& tile) {
   return {{}, TileLoadResultState::RetryLater};
 }
 
+void ImplicitQuadtreeLoader::releaseTileChildren(std::vector<Tile>&& children) {
+  for (const Tile& child : children) {
+    const CesiumGeometry::QuadtreeTileID* pID =
+        std::get_if<CesiumGeometry::QuadtreeTileID>(&child.getTileID());
+    if (pID) {
+      this->releaseSubtree(*pID);
+    }
+  }
+
+  this->_childrenPool.release(std::move(children));
+}
+
+bool ImplicitQuadtreeLoader::canRecreateTileChildren(
+    const Tile& tile) const noexcept {
+  // Children are created from subtree availability, which is kept as long as
+  // any tile in the subtree exists.
+  return std::holds_alternative<CesiumGeometry::QuadtreeTileID>(
+      tile.getTileID());
+}
+
 uint32_t ImplicitQuadtreeLoader::getSubtreeLevels() const noexcept {
   return this->_subtreeLevels;
 }
@@ -367,6 +454,159 @@ ImplicitQuadtreeLoader::getBoundingVolume() const noexcept {
   return this->_boundingVolume;
 }
 
+CesiumAsync::Future<bool> ImplicitQuadtreeLoader::loadSubtree(
+    const CesiumGeometry::QuadtreeTileID& subtreeID,
+    const TileLoadInput& loadInput) {
+  const uint32_t levelIndex = subtreeID.level / this->_subtreeLevels;
+  const uint64_t subtreeMortonID =
+      ImplicitTilingUtilities::computeMortonIndex(subtreeID);
+  this->_loadingSubtrees[levelIndex].insert(subtreeMortonID);
+  ++this->_numberOfSubtreesLoading;
+
+  std::string subtreeUrl = ImplicitTilingUtilities::resolveUrl(
+      this->_baseUrl,
+      this->_subtreeUrlTemplate,
+      subtreeID);
+  return SubtreeAvailability::loadSubtree(
+             ImplicitTileSubdivisionScheme::Quadtree,
+             this->_subtreeLevels,
+             loadInput.asyncSystem,
+             loadInput.pAssetAccessor,
+             loadInput.pLogger,
+             subtreeUrl,
+             loadInput.requestHeaders,
+             false)
+      .thenInMainThread(
+          [this, subtreeID, levelIndex, subtreeMortonID](
+              std::optional<SubtreeAvailability>&& subtreeAvailability) {
+            this->_loadingSubtrees[levelIndex].erase(subtreeMortonID);
+            --this->_numberOfSubtreesLoading;
+            if (!subtreeAvailability) {
+              return false;
+            }
+
+            // Only the availability is needed to create tiles, so the
+            // metadata buffers weren't loaded either.
+            subtreeAvailability->compact();
+            this->addSubtreeAvailability(
+                subtreeID,
+                std::move(*subtreeAvailability));
+            return true;
+          });
+}
+
+void ImplicitQuadtreeLoader::prefetchChildSubtrees(
+    const CesiumGeometry::QuadtreeTileID& subtreeID,
+    const SubtreeAvailability& subtreeAvailability,
+    const CesiumGeometry::QuadtreeTileID& tileID,
+    const TileLoadInput& loadInput) {
+  const TilesetContentOptions& options = loadInput.contentOptions;
+  const uint32_t levelsToBottom =
+      subtreeID.level + this->_subtreeLevels - tileID.level;
+  const uint32_t childLevelIndex = subtreeID.level / this->_subtreeLevels + 1;
+  if (levelsToBottom > options.subtreePrefetchLevels ||
+      childLevelIndex >= this->_loadedSubtrees.size()) {
+    return;
+  }
+
+  this->_subtreePrefetchLevels =
+      std::max(this->_subtreePrefetchLevels, levelsToBottom);
+
+  CesiumAsync::TaskPriorityScope priorityScope(subtreePrefetchPriority);
+
+  // The descendants of the tile at the level below this subtree, which are the
+  // roots of its child subtrees.
+  const uint32_t childLevel = tileID.level + levelsToBottom;
+  for (uint32_t y = tileID.y << levelsToBottom;
+       y < (tileID.y + 1) << levelsToBottom;
+       ++y) {
+    for (uint32_t x = tileID.x << levelsToBottom;
+         x < (tileID.x + 1) << levelsToBottom;
+         ++x) {
+      if (this->_numberOfSubtreesLoading >=
+          options.maximumSimultaneousSubtreeLoads) {
+        return;
+      }
+
+      const CesiumGeometry::QuadtreeTileID childID(childLevel, x, y);
+      const uint64_t childMortonID =
+          ImplicitTilingUtilities::computeMortonIndex(childID);
+      if (this->_loadedSubtrees[childLevelIndex].count(childMortonID) ||
+          this->_loadingSubtrees[childLevelIndex].count(childMortonID) ||
+          !subtreeAvailability.isSubtreeAvailable(subtreeID, childID)) {
+        continue;
+      }
+
+      this->loadSubtree(childID, loadInput);
+    }
+  }
+}
+
+void ImplicitQuadtreeLoader::retainSubtree(
+    const CesiumGeometry::QuadtreeTileID& tileID) {
+  const CesiumGeometry::QuadtreeTileID subtreeID =
+      ImplicitTilingUtilities::getSubtreeRootID(this->_subtreeLevels, tileID);
+  const uint32_t levelIndex = subtreeID.level / this->_subtreeLevels;
+  if (levelIndex >= this->_subtreeTileCounts.size()) {
+    return;
+  }
+
+  const uint64_t subtreeMortonID =
+      ImplicitTilingUtilities::computeMortonIndex(subtreeID);
+  ++this->_subtreeTileCounts[levelIndex][subtreeMortonID];
+}
+
+void ImplicitQuadtreeLoader::releaseSubtree(
+    const CesiumGeometry::QuadtreeTileID& tileID) {
+  const CesiumGeometry::QuadtreeTileID subtreeID =
+      ImplicitTilingUtilities::getSubtreeRootID(this->_subtreeLevels, tileID);
+  const uint32_t levelIndex = subtreeID.level / this->_subtreeLevels;
+  if (levelIndex >= this->_subtreeTileCounts.size()) {
+    return;
+  }
+
+  std::unordered_map<uint64_t, size_t>& tileCounts =
+      this->_subtreeTileCounts[levelIndex];
+  const uint64_t subtreeMortonID =
+      ImplicitTilingUtilities::computeMortonIndex(subtreeID);
+  auto countIt = tileCounts.find(subtreeMortonID);
+  if (countIt != tileCounts.end() && --countIt->second == 0) {
+    tileCounts.erase(countIt);
+
+    // The root subtree is kept for the root tile, which isn't created by this
+    // loader.
+    if (levelIndex > 0) {
+      this->_loadedSubtrees[levelIndex].erase(subtreeMortonID);
+    }
+  }
+
+  // The descendants of the tile are released before it, so no tile is left
+  // in the child subtrees that were prefetched below it.
+  const uint32_t levelsToBottom =
+      subtreeID.level + this->_subtreeLevels - tileID.level;
+  const uint32_t childLevelIndex = levelIndex + 1;
+  if (levelsToBottom > this->_subtreePrefetchLevels ||
+      childLevelIndex >= this->_loadedSubtrees.size()) {
+    return;
+  }
+
+  const uint32_t childLevel = tileID.level + levelsToBottom;
+  for (uint32_t y = tileID.y << levelsToBottom;
+       y < (tileID.y + 1) << levelsToBottom;
+       ++y) {
+    for (uint32_t x = tileID.x << levelsToBottom;
+         x < (tileID.x + 1) << levelsToBottom;
+         ++x) {
+      const CesiumGeometry::QuadtreeTileID childID(childLevel, x, y);
+      const uint64_t childMortonID =
+          ImplicitTilingUtilities::computeMortonIndex(childID);
+      if (!this->_subtreeTileCounts[childLevelIndex].count(childMortonID)) {
+        this->_loadedSubtrees[childLevelIndex].erase(childMortonID);
+      }
+    }
+  }
+}
+
 void ImplicitQuadtreeLoader::addSubtreeAvailability(
     const CesiumGeometry::QuadtreeTileID& subtreeID,
     SubtreeAvailability&& subtreeAvailability) {
@@ -46,7 +46,13 @@ BoundingVolume createDefaultLooseEarthBoundingVolume(
       BoundingRegion(globeRectangle, -1000.0, 9000.0));
 }
 
-TileLoadResult convertToTileLoadResult(QuantizedMeshLoadResult&& loadResult) {
+TileLoadResult convertToTileLoadResult(
+    QuantizedMeshLoadResult&& loadResult,
+    bool skipContentDecoding) {
+  if (skipContentDecoding && !loadResult.errors) {
+    return TileLoadResult::createFetchedResult(std::move(loadResult.pRequest));
+  }
+
   if (loadResult.errors || !loadResult.model) {
     return TileLoadResult::createFailedResult(loadResult.pRequest);
   }
@@ -640,49 +646,77 @@ Future<QuantizedMeshLoadResult> requestTileContent(
     const BoundingRegion& boundingRegion,
     const LayerJsonTerrainLoader::Layer& layer,
     const std::vector<IAssetAccessor::THeader>& requestHeaders,
-    bool enableWaterMask) {
+    bool enableWaterMask,
+    bool bakeSkirts,
+    bool skipContentDecoding,
+    const std::optional<ThreadPool>& decodeThreadPool) {
   std::string url = resolveTileUrl(tileID, layer);
-  return pAssetAccessor->get(asyncSystem, url, requestHeaders)
-      .thenInWorkerThread(
-          [asyncSystem, pLogger, tileID, boundingRegion, enableWaterMask](
-              std::shared_ptr<IAssetRequest>&& pRequest) {
-            const IAssetResponse* pResponse = pRequest->response();
-            if (!pResponse) {
-              QuantizedMeshLoadResult result;
-              result.errors.emplaceError(fmt::format(
-                  "Did not receive a valid response for tile content {}",
-                  pRequest->url()));
-              result.pRequest = std::move(pRequest);
-              return result;
-            }
+  return thenInDecodeThread(
+      decodeThreadPool,
+      pAssetAccessor->get(asyncSystem, url, requestHeaders),
+      [asyncSystem,
+       pLogger,
+       tileID,
+       boundingRegion,
+       enableWaterMask,
+       bakeSkirts,
+       skipContentDecoding](std::shared_ptr<IAssetRequest>&& pRequest) {
+        const IAssetResponse* pResponse = pRequest->response();
+        if (!pResponse) {
+          QuantizedMeshLoadResult result;
+          result.errors.emplaceError(fmt::format(
+              "Did not receive a valid response for tile content {}",
+              pRequest->url()));
+          result.pRequest = std::move(pRequest);
+          return result;
+        }
 
-            if (pResponse->statusCode() != 0 &&
-                (pResponse->statusCode() < 200 ||
-                 pResponse->statusCode() >= 300)) {
-              QuantizedMeshLoadResult result;
-              result.errors.emplaceError(fmt::format(
-                  "Receive status code {} for tile content {}",
-                  pResponse->statusCode(),
-                  pRequest->url()));
-              result.pRequest = std::move(pRequest);
-              return result;
-            }
+        if (pResponse->statusCode() != 0 &&
+            (pResponse->statusCode() < 200 || pResponse->statusCode() >= 300)) {
+          QuantizedMeshLoadResult result;
+          result.errors.emplaceError(fmt::format(
+              "Receive status code {} for tile content {}",
+              pResponse->statusCode(),
+              pRequest->url()));
+          result.pRequest = std::move(pRequest);
+          return result;
+        }
 
-            return QuantizedMeshLoader::load(
-                tileID,
-                boundingRegion,
-                pRequest->url(),
-                pResponse->data(),
-                enableWaterMask);
-          });
+        if (skipContentDecoding) {
+          // Only the availability in the metadata of the tile is needed, to
+          // create its children.
+          QuantizedMeshMetadataResult metadata =
+              QuantizedMeshLoader::loadMetadata(pResponse->data(), tileID);
+          QuantizedMeshLoadResult result;
+          result.availableTileRectangles = std::move(metadata.availability);
+          result.errors = std::move(metadata.errors);
+          result.pRequest = std::move(pRequest);
+          return result;
+        }
+
+        return QuantizedMeshLoader::load(
+            tileID,
+            boundingRegion,
+            pRequest->url(),
+            pResponse->data(),
+            enableWaterMask,
+            bakeSkirts);
+      });
 }
 
-Future<int> loadTileAvailability(
+// A tile, and the availability loaded from the same tile in underlying
+// layers.
+struct TileAndAvailabilityLoadResult {
+  QuantizedMeshLoadResult tile;
+  std::vector<QuantizedMeshMetadataResult> availabilities;
+};
+
+Future<QuantizedMeshMetadataResult> loadTileAvailability(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const AsyncSystem& asyncSystem,
     const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
     const QuadtreeTileID& tileID,
-    LayerJsonTerrainLoader::Layer& layer,
+    const LayerJsonTerrainLoader::Layer& layer,
     const std::vector<IAssetAccessor::THeader>& requestHeaders) {
   std::string url = resolveTileUrl(tileID, layer);
   return pAssetAccessor->get(asyncSystem, url, requestHeaders)
@@ -702,11 +736,6 @@ Future<int> loadTileAvailability(
             "Failed to load availability data from {}",
             pRequest->url());
         return QuantizedMeshMetadataResult();
-      })
-      .thenInMainThread([&layer,
-                         tileID](QuantizedMeshMetadataResult&& metadata) {
-        addRectangleAvailabilityToLayer(layer, tileID, metadata.availability);
-        return 0;
       });
 }
 } // namespace
@@ -735,8 +764,18 @@ LayerJsonTerrainLoader::loadTileContent(const TileLoadInput& loadInput) {
           TileLoadResult::createFailedResult(nullptr));
     }
 
+    if (contentOptions.skipContentDecoding) {
+      // Upsampled tiles have no content of their own to fetch.
+      return asyncSystem.createResolvedFuture(
+          TileLoadResult::createFetchedResult(nullptr));
+    }
+
     // now do upsampling
-    return upsampleParentTile(tile, asyncSystem);
+    return upsampleParentTile(
+        tile,
+        loadInput.contentOptions,
+        asyncSystem,
+        loadInput.decodeThreadPool);
   }
 
   // Always request the tile from the first layer in which this tile ID is
@@ -759,7 +798,8 @@ LayerJsonTerrainLoader::loadTileContent(const TileLoadInput& loadInput) {
   // create this tile's children, we need to be able to create children
   // that are only available from an underlying layer, and we can only do
   // that if we know they're available.
-  std::vector<Future<int>> availabilityRequests;
+  std::vector<size_t> availabilityLayers;
+  std::vector<Future<QuantizedMeshMetadataResult>> availabilityRequests;
 
   auto it = firstAvailableIt;
   ++it;
@@ -768,6 +808,7 @@ LayerJsonTerrainLoader::loadTileContent(const TileLoadInput& loadInput) {
     if (it->availabilityLevels >= 1 &&
         (int32_t(pQuadtreeTileID->level) % it->availabilityLevels) == 0) {
       if (!isSubtreeLoadedInLayer(*pQuadtreeTileID, *it)) {
+        availabilityLayers.emplace_back(size_t(it - this->_layers.begin()));
         availabilityRequests.emplace_back(loadTileAvailability(
             pLogger,
             asyncSystem,
@@ -799,7 +840,10 @@ LayerJsonTerrainLoader::loadTileContent(const TileLoadInput& loadInput) {
       *pRegion,
       currentLayer,
       requestHeaders,
-      contentOptions.enableWaterMask);
+      contentOptions.enableWaterMask,
+      contentOptions.bakeSkirts,
+      contentOptions.skipContentDecoding,
+      loadInput.decodeThreadPool);
 
   // determine if this tile is at the availability level of the current layer
   // and if we need to add the availability rectangles to the current layer. We
@@ -811,40 +855,62 @@ LayerJsonTerrainLoader::loadTileContent(const TileLoadInput& loadInput) {
         !isSubtreeLoadedInLayer(*pQuadtreeTileID, currentLayer);
   }
 
-  // If this tile has availability data, we need to add it to the layer in the
-  // main thread.
+  // If this tile has availability data, we need to add it to the layers in
+  // the main thread, along with the availability loaded from the underlying
+  // layers.
   if (!availabilityRequests.empty() || shouldCurrLayerLoadAvailability) {
     auto finalFuture =
-        availabilityRequests.empty()
-            ? std::move(futureQuantizedMesh)
-            : asyncSystem.all(std::move(availabilityRequests))
-                  .thenImmediately(
-                      [futureQuantizedMesh = std::move(futureQuantizedMesh)](
-                          std::vector<int>&&) mutable {
-                        return std::move(futureQuantizedMesh);
-                      });
+        asyncSystem.all(std::move(availabilityRequests))
+            .thenImmediately(
+                [futureQuantizedMesh = std::move(futureQuantizedMesh)](
+                    std::vector<QuantizedMeshMetadataResult>&&
+                        availabilities) mutable {
+                  return std::move(futureQuantizedMesh)
+                      .thenImmediately(
+                          [availabilities = std::move(availabilities)](
+                              QuantizedMeshLoadResult&& loadResult) mutable {
+                            return TileAndAvailabilityLoadResult{
+                                std::move(loadResult),
+                                std::move(availabilities)};
+                          });
+                });
 
     return std::move(finalFuture)
         .thenInMainThread([this,
                            asyncSystem,
                            &currentLayer,
                            &tile,
-                           shouldCurrLayerLoadAvailability](
-                              QuantizedMeshLoadResult&& loadResult) {
+                           shouldCurrLayerLoadAvailability,
+                           availabilityLayers = std::move(availabilityLayers),
+                           skipContentDecoding =
+                               contentOptions.skipContentDecoding](
+                              TileAndAvailabilityLoadResult&& loadResults) {
+          QuantizedMeshLoadResult& loadResult = loadResults.tile;
+          const QuadtreeTileID& tileID =
+              std::get<QuadtreeTileID>(tile.getTileID());
+          for (size_t i = 0; i < availabilityLayers.size(); ++i) {
+            addRectangleAvailabilityToLayer(
+                this->_layers[availabilityLayers[i]],
+                tileID,
+                loadResults.availabilities[i].availability);
+          }
+
           if (shouldCurrLayerLoadAvailability) {
-            const QuadtreeTileID& tileID =
-                std::get<QuadtreeTileID>(tile.getTileID());
             addRectangleAvailabilityToLayer(
                 currentLayer,
                 tileID,
                 loadResult.availableTileRectangles);
           }
 
+          this->_availabilityCache.clear();
+
           // if this tile has one of the children that needs to be upsampled, we
           // will need to generate the tile raster overlay UVs in the worker
           // thread based on the projection of the loader since the upsampler
           // needs this UV to do the upsampling
-          auto finalResult = convertToTileLoadResult(std::move(loadResult));
+          auto finalResult = convertToTileLoadResult(
+              std::move(loadResult),
+              skipContentDecoding);
           bool doesTileHaveUpsampledChild = tileHasUpsampledChild(tile);
           if (doesTileHaveUpsampledChild &&
               finalResult.state == TileLoadResultState::Success) {
@@ -869,6 +935,8 @@ LayerJsonTerrainLoader::loadTileContent(const TileLoadInput& loadInput) {
   bool doesTileHaveUpsampledChild = tileHasUpsampledChild(tile);
   return std::move(futureQuantizedMesh)
       .thenImmediately([doesTileHaveUpsampledChild,
+                        skipContentDecoding =
+                            contentOptions.skipContentDecoding,
                         projection = this->_projection,
                         tileTransform = tile.getTransform(),
                         tileBoundingVolume = tile.getBoundingVolume()](
@@ -877,7 +945,9 @@ LayerJsonTerrainLoader::loadTileContent(const TileLoadInput& loadInput) {
         // need to generate its raster overlay UVs in the worker thread based
         // on the projection of the loader since the upsampler needs this UV
         // to do the upsampling
-        auto result = convertToTileLoadResult(std::move(loadResult));
+        auto result = convertToTileLoadResult(
+            std::move(loadResult),
+            skipContentDecoding);
         if (doesTileHaveUpsampledChild &&
             result.state == TileLoadResultState::Success) {
           generateRasterOverlayUVs(
@@ -1004,53 +1074,16 @@ LayerJsonTerrainLoader::createTileChildrenImpl(const Tile& tile) {
 
 bool LayerJsonTerrainLoader::tileIsAvailableInAnyLayer(
     const QuadtreeTileID& tileID) const {
-  for (const Layer& layer : this->_layers) {
-    auto availableState = tileIsAvailableInLayer(tileID, layer);
-    if (availableState == AvailableState::Available) {
-      return true;
-    }
-  }
-
-  return false;
-}
-
-LayerJsonTerrainLoader::AvailableState
-LayerJsonTerrainLoader::tileIsAvailableInLayer(
-    const CesiumGeometry::QuadtreeTileID& tileID,
-    const Layer& layer) const {
-  if (layer.contentAvailability.isTileAvailable(tileID)) {
-    return AvailableState::Available;
-  } else {
-    // this layer doesn't use subtree at all and list
-    // all availability rectanges in the layer.json. So
-    // this tile is not available
-    if (layer.availabilityLevels <= 0) {
-      return AvailableState::NotAvailable;
-    }
-
-    // this tile ID is also a subtree ID. So no need to calc
-    // subtree ID
-    if (int32_t(tileID.level) % layer.availabilityLevels == 0) {
-      if (isSubtreeLoadedInLayer(tileID, layer)) {
-        return AvailableState::NotAvailable;
-      }
-    }
-
-    // calc the subtree ID this tile belongs to and determine it's loaded
-    uint32_t subtreeLevelIdx =
-        tileID.level / uint32_t(layer.availabilityLevels);
-    uint64_t levelLeft = tileID.level % uint32_t(layer.availabilityLevels);
-    uint32_t subtreeLevel =
-        subtreeLevelIdx * uint32_t(layer.availabilityLevels);
-    uint32_t subtreeX = tileID.x >> levelLeft;
-    uint32_t subtreeY = tileID.y >> levelLeft;
-    CesiumGeometry::QuadtreeTileID subtreeID{subtreeLevel, subtreeX, subtreeY};
-    if (isSubtreeLoadedInLayer(subtreeID, layer)) {
-      return AvailableState::NotAvailable;
-    }
-  }
-
-  return AvailableState::Unknown;
+  return this->_availabilityCache.isTileAvailable(
+      tileID,
+      [&layers = this->_layers](const QuadtreeTileID& id) {
+        for (const Layer& layer : layers) {
+          if (layer.contentAvailability.isTileAvailable(id)) {
+            return true;
+          }
+        }
+        return false;
+      });
 }
 
 void LayerJsonTerrainLoader::createChildTile(
@@ -1095,7 +1128,9 @@ void LayerJsonTerrainLoader::createChildTile(
 
 CesiumAsync::Future<TileLoadResult> LayerJsonTerrainLoader::upsampleParentTile(
     const Tile& tile,
-    const CesiumAsync::AsyncSystem& asyncSystem) {
+    const TilesetContentOptions& contentOptions,
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool) {
   const Tile* pParent = tile.getParent();
   const TileContent& parentContent = pParent->getContent();
   const TileRenderContent* pParentRenderContent =
@@ -1128,17 +1163,23 @@ CesiumAsync::Future<TileLoadResult> LayerJsonTerrainLoader::upsampleParentTile(
   // it's totally safe to capture the const ref parent model in the worker
   // thread. The tileset content manager will guarantee that the parent tile
   // will not be unloaded when upsampled tile is on the fly.
+  this->_upsampledModels.setMaximumModels(
+      contentOptions.maximumCachedUpsampledModels);
+
   const CesiumGltf::Model& parentModel = pParentRenderContent->getModel();
-  return asyncSystem.runInWorkerThread(
+  return runInDecodeThread(
+      asyncSystem,
+      decodeThreadPool,
       [&parentModel,
+       pParent,
+       &upsampledModels = this->_upsampledModels,
        boundingVolume = tile.getBoundingVolume(),
        textureCoordinateIndex = index,
        tileID = *pUpsampledTileID]() mutable {
-        auto model = RasterOverlayUtilities::upsampleGltfForRasterOverlays(
+        auto model = upsampledModels.upsample(
+            pParent,
             parentModel,
-            tileID,
-            false,
-            RasterOverlayUtilities::DEFAULT_TEXTURE_COORDINATE_BASE_NAME,
+            tileID.tileID,
             textureCoordinateIndex);
         if (!model) {
           return TileLoadResult::createFailedResult(nullptr);
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "TerrainAvailabilityCache.h"
 #include "TilesetContentLoaderResult.h"
+#include "UpsampledModelCache.h"
 
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
 #include <Cesium3DTilesSelection/TilesetExternals.h>
@@ -25,8 +27,6 @@ namespace Cesium3DTilesSelection {
  * quantized-mesh format.
  */
 class LayerJsonTerrainLoader : public TilesetContentLoader {
-  enum class AvailableState { Available, NotAvailable, Unknown };
-
 public:
   static CesiumAsync::Future<TilesetContentLoaderResult<LayerJsonTerrainLoader>>
   createLoader(
@@ -85,10 +85,6 @@ private:
   bool
   tileIsAvailableInAnyLayer(const CesiumGeometry::QuadtreeTileID& tileID) const;
 
-  AvailableState tileIsAvailableInLayer(
-      const CesiumGeometry::QuadtreeTileID& tileID,
-      const Layer& layer) const;
-
   void createChildTile(
       const Tile& parent,
       std::vector<Tile>& children,
@@ -97,11 +93,18 @@ private:
 
   CesiumAsync::Future<TileLoadResult> upsampleParentTile(
       const Tile& tile,
-      const CesiumAsync::AsyncSystem& asyncSystem);
+      const TilesetContentOptions& contentOptions,
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool);
 
   CesiumGeometry::QuadtreeTilingScheme _tilingScheme;
   CesiumGeospatial::Projection _projection;
   std::vector<Layer> _layers;
+  // Whether tiles are available in any layer, looked up in the rectangles of
+  // the layers once for each block of tiles. Cleared whenever a layer gains
+  // availability.
+  mutable TerrainAvailabilityCache _availabilityCache;
+  UpsampledModelCache _upsampledModels;
 };
 
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,27 @@
+#include "MainThreadBudget.h"
+
+namespace Cesium3DTilesSelection {
+void MainThreadBudget::startFrame(double timeLimit) noexcept {
+  this->_enabled = timeLimit > 0.0;
+  this->_timeLeft = std::chrono::duration<double, std::milli>(timeLimit);
+}
+
+bool MainThreadBudget::hasTimeLeft() const noexcept {
+  return !this->_enabled || this->_timeLeft.count() > 0.0;
+}
+
+MainThreadBudget::Clock::time_point
+MainThreadBudget::getDeadline() const noexcept {
+  const Clock::time_point now = Clock::now();
+  if (this->_timeLeft.count() <= 0.0) {
+    return now;
+  }
+  return now + std::chrono::duration_cast<Clock::duration>(this->_timeLeft);
+}
+
+void MainThreadBudget::charge(Clock::time_point start) noexcept {
+  if (this->_enabled) {
+    this->_timeLeft -= Clock::now() - start;
+  }
+}
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+
+namespace Cesium3DTilesSelection {
+/**
+ * @brief The time left in a frame for the deferrable main-thread work of a
+ * tileset, see {@link TilesetOptions::mainThreadTimeLimit}.
+ *
+ * Each kind of work checks the budget before each item and charges the time
+ * it spent when it's done. Work that doesn't fit is left for the next frame.
+ * When the budget is disabled, there is always time left.
+ */
+class MainThreadBudget {
+public:
+  using Clock = std::chrono::system_clock;
+
+  /**
+   * @brief Starts a new frame.
+   *
+   * @param timeLimit The time, in milliseconds, that may be spent this frame,
+   * or 0.0 to disable the budget.
+   */
+  void startFrame(double timeLimit) noexcept;
+
+  /**
+   * @brief Whether the budget limits the work this frame.
+   */
+  bool isEnabled() const noexcept { return this->_enabled; }
+
+  /**
+   * @brief Whether any time is left this frame. Always true if the budget is
+   * disabled.
+   */
+  bool hasTimeLeft() const noexcept;
+
+  /**
+   * @brief The time at which the budget runs out, if the rest of it is spent
+   * starting now. Only meaningful if the budget is enabled.
+   */
+  Clock::time_point getDeadline() const noexcept;
+
+  /**
+   * @brief Charges the time since the given start time to the budget.
+   */
+  void charge(Clock::time_point start) noexcept;
+
+  /**
+   * @brief Runs the given function and charges the time it takes to the
+   * budget.
+   */
+  template <typename Func> auto run(Func&& f) {
+    struct Charge {
+      MainThreadBudget& budget;
+      Clock::time_point start;
+      ~Charge() { budget.charge(start); }
+    } charge{*this, Clock::now()};
+    return f();
+  }
+
+private:
+  bool _enabled = false;
+  std::chrono::duration<double, std::milli> _timeLeft{0.0};
+};
+} // namespace Cesium3DTilesSelection
@@ -10,6 +10,8 @@
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
 #include <CesiumRasterOverlays/RasterOverlayUtilities.h>
 
+#include <algorithm>
+
 using namespace Cesium3DTilesSelection;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -50,21 +52,50 @@ RasterOverlayTile* findTileOverlay(Tile& tile, const RasterOverlay& overlay) {
 namespace Cesium3DTilesSelection {
 
 RasterMappedTo3DTile::RasterMappedTo3DTile(
-    const CesiumUtility::IntrusivePointer<RasterOverlayTile>& pRasterTile,
-    int32_t textureCoordinateIndex)
-    : _pLoadingTile(pRasterTile),
+    CesiumUtility::IntrusivePointer<RasterOverlayTile> pRasterTile,
+    int32_t textureCoordinateIndex,
+    CesiumUtility::IntrusivePointer<RasterOverlayTile> pTargetRasterTile)
+    : _pLoadingTile(std::move(pRasterTile)),
       _pReadyTile(nullptr),
+      _pTargetTile(std::move(pTargetRasterTile)),
       _textureCoordinateID(textureCoordinateIndex),
       _translation(0.0, 0.0),
       _scale(1.0, 1.0),
       _state(AttachmentState::Unattached),
-      _originalFailed(false) {
+      _originalFailed(false),
+      _readyTileIsOwn(false) {
   assert(this->_pLoadingTile != nullptr);
 }
 
+// Removes an attachment that hasn't been passed to the renderer yet, which
+// then doesn't need to be detached.
+static bool removePendingAttachment(
+    std::vector<RasterAttachment>* pPendingAttachments,
+    const Tile& tile,
+    const RasterOverlayTile& rasterTile) {
+  if (!pPendingAttachments) {
+    return false;
+  }
+
+  auto it = std::find_if(
+      pPendingAttachments->begin(),
+      pPendingAttachments->end(),
+      [&tile, &rasterTile](const RasterAttachment& attachment) {
+        return attachment.pTile == &tile &&
+               attachment.pRasterTile == &rasterTile;
+      });
+  if (it == pPendingAttachments->end()) {
+    return false;
+  }
+
+  pPendingAttachments->erase(it);
+  return true;
+}
+
 RasterOverlayTile::MoreDetailAvailable RasterMappedTo3DTile::update(
     IPrepareRendererResources& prepareRendererResources,
-    Tile& tile) {
+    Tile& tile,
+    std::vector<RasterAttachment>* pPendingAttachments) {
   assert(this->_pLoadingTile != nullptr || this->_pReadyTile != nullptr);
 
   if (this->getState() == AttachmentState::Attached) {
@@ -75,6 +106,24 @@ RasterOverlayTile::MoreDetailAvailable RasterMappedTo3DTile::update(
                : RasterOverlayTile::MoreDetailAvailable::No;
   }
 
+  // If the less detailed tile of a progressive load has failed, load the
+  // detailed one directly.
+  if (this->_pLoadingTile && this->_pTargetTile &&
+      this->_pLoadingTile->getState() == RasterOverlayTile::LoadState::Failed) {
+    this->_pLoadingTile = std::move(this->_pTargetTile);
+  }
+
+  // If the detailed tile of a progressive load has failed, keep the less
+  // detailed one, but don't refine past it.
+  if (this->_pLoadingTile && this->_readyTileIsOwn &&
+      this->_pLoadingTile->getState() == RasterOverlayTile::LoadState::Failed) {
+    this->_originalFailed = true;
+    this->_pLoadingTile = nullptr;
+    if (this->getState() == AttachmentState::TemporarilyAttached) {
+      this->_state = AttachmentState::Attached;
+    }
+  }
+
   // If the loading tile has failed, try its parent's loading tile.
   Tile* pTile = &tile;
   while (this->_pLoadingTile &&
@@ -102,25 +151,35 @@ RasterOverlayTile::MoreDetailAvailable RasterMappedTo3DTile::update(
       this->_pLoadingTile->getState() >= RasterOverlayTile::LoadState::Loaded) {
     // Unattach the old tile
     if (this->_pReadyTile && this->getState() != AttachmentState::Unattached) {
-      prepareRendererResources.detachRasterInMainThread(
-          tile,
-          this->getTextureCoordinateID(),
-          *this->_pReadyTile,
-          this->_pReadyTile->getRendererResources());
+      if (!removePendingAttachment(
+              pPendingAttachments,
+              tile,
+              *this->_pReadyTile)) {
+        prepareRendererResources.detachRasterInMainThread(
+            tile,
+            this->getTextureCoordinateID(),
+            *this->_pReadyTile,
+            this->_pReadyTile->getRendererResources());
+      }
       this->_state = AttachmentState::Unattached;
     }
 
-    // Mark the loading tile ready.
-    this->_pReadyTile = this->_pLoadingTile;
-    this->_pLoadingTile = nullptr;
+    // Mark the loading tile ready, and start loading the detailed tile if this
+    // was the less detailed tile of a progressive load.
+    this->_pReadyTile = std::move(this->_pLoadingTile);
+    this->_pLoadingTile = std::move(this->_pTargetTile);
+    this->_readyTileIsOwn = !this->_originalFailed;
 
     // Compute the translation and scale for the new tile.
     this->computeTranslationAndScale(tile);
   }
 
-  // Find the closest ready ancestor tile.
-  if (this->_pLoadingTile) {
-    CesiumUtility::IntrusivePointer<RasterOverlayTile> pCandidate;
+  // Find the closest ready ancestor tile, unless the ready tile is the less
+  // detailed tile of a progressive load, which fits this tile better.
+  if (this->_pLoadingTile && !this->_readyTileIsOwn) {
+    // A plain pointer while searching, so that only the tile that is found
+    // gains a reference.
+    RasterOverlayTile* pCandidate = nullptr;
 
     pTile = tile.getParent();
     while (pTile) {
@@ -138,11 +197,16 @@ RasterOverlayTile::MoreDetailAvailable RasterMappedTo3DTile::update(
         pCandidate->getState() >= RasterOverlayTile::LoadState::Loaded &&
         this->_pReadyTile != pCandidate) {
       if (this->getState() != AttachmentState::Unattached) {
-        prepareRendererResources.detachRasterInMainThread(
-            tile,
-            this->getTextureCoordinateID(),
-            *this->_pReadyTile,
-            this->_pReadyTile->getRendererResources());
+        if (!removePendingAttachment(
+                pPendingAttachments,
+                tile,
+                *this->_pReadyTile)) {
+          prepareRendererResources.detachRasterInMainThread(
+              tile,
+              this->getTextureCoordinateID(),
+              *this->_pReadyTile,
+              this->_pReadyTile->getRendererResources());
+        }
         this->_state = AttachmentState::Unattached;
       }
 
@@ -158,13 +222,23 @@ RasterOverlayTile::MoreDetailAvailable RasterMappedTo3DTile::update(
       this->getState() == RasterMappedTo3DTile::AttachmentState::Unattached) {
     this->_pReadyTile->loadInMainThread();
 
-    prepareRendererResources.attachRasterInMainThread(
-        tile,
-        this->getTextureCoordinateID(),
-        *this->_pReadyTile,
-        this->_pReadyTile->getRendererResources(),
-        this->getTranslation(),
-        this->getScale());
+    if (pPendingAttachments) {
+      pPendingAttachments->push_back(RasterAttachment{
+          &tile,
+          this->getTextureCoordinateID(),
+          this->_pReadyTile.get(),
+          this->_pReadyTile->getRendererResources(),
+          this->getTranslation(),
+          this->getScale()});
+    } else {
+      prepareRendererResources.attachRasterInMainThread(
+          tile,
+          this->getTextureCoordinateID(),
+          *this->_pReadyTile,
+          this->_pReadyTile->getRendererResources(),
+          this->getTranslation(),
+          this->getScale());
+    }
 
     this->_state = this->_pLoadingTile ? AttachmentState::TemporarilyAttached
                                        : AttachmentState::Attached;
@@ -268,10 +342,24 @@ RasterMappedTo3DTile* addRealTile(
       provider.getTile(rectangle, screenPixels);
   if (!pTile) {
     return nullptr;
-  } else {
-    return &tile.getMappedRasterTiles().emplace_back(
-        RasterMappedTo3DTile(pTile, textureCoordinateIndex));
   }
+
+  const RasterOverlayOptions& options = provider.getOwner().getOptions();
+  if (options.loadProgressively &&
+      pTile->getState() == RasterOverlayTile::LoadState::Unloaded) {
+    IntrusivePointer<RasterOverlayTile> pCoarseTile = provider.getTile(
+        rectangle,
+        screenPixels * options.progressiveLoadingScreenPixelsFactor);
+    if (pCoarseTile) {
+      return &tile.getMappedRasterTiles().emplace_back(RasterMappedTo3DTile(
+          std::move(pCoarseTile),
+          textureCoordinateIndex,
+          std::move(pTile)));
+    }
+  }
+
+  return &tile.getMappedRasterTiles().emplace_back(
+      RasterMappedTo3DTile(std::move(pTile), textureCoordinateIndex));
 }
 
 } // namespace
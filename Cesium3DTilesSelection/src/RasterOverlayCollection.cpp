@@ -31,7 +31,13 @@ const std::vector<CesiumUtility::IntrusivePointer<RasterOverlayTileProvider>>
 RasterOverlayCollection::RasterOverlayCollection(
     Tile::LoadedLinkedList& loadedTiles,
     const TilesetExternals& externals) noexcept
-    : _pLoadedTiles(&loadedTiles), _externals{externals}, _pOverlays(nullptr) {}
+    : _pLoadedTiles(&loadedTiles),
+      _externals{externals},
+      _pTileProviderPool(
+          externals.pRasterOverlayTileProviderPool
+              ? externals.pRasterOverlayTileProviderPool
+              : std::make_shared<RasterOverlayTileProviderPool>()),
+      _pOverlays(nullptr) {}
 
 RasterOverlayCollection::~RasterOverlayCollection() noexcept {
   if (this->_pOverlays) {
@@ -66,14 +72,8 @@ void RasterOverlayCollection::add(
 
   // CESIUM_TRACE_BEGIN_IN_TRACK("createTileProvider");
 
-  CesiumAsync::Future<RasterOverlay::CreateTileProviderResult> future =
-      pOverlay->createTileProvider(
-          this->_externals.asyncSystem,
-          this->_externals.pAssetAccessor,
-          this->_externals.pCreditSystem,
-          this->_externals.pPrepareRendererResources,
-          this->_externals.pLogger,
-          nullptr);
+  CesiumAsync::SharedFuture<RasterOverlay::CreateTileProviderResult> future =
+      this->_pTileProviderPool->getTileProvider(pOverlay, this->_externals);
 
   // Add a placeholder for this overlay to existing geometry tiles.
   forEachTile(*this->_pLoadedTiles, [&](Tile& tile) {
@@ -96,19 +96,9 @@ void RasterOverlayCollection::add(
 
   // This continuation, by capturing pList, keeps the OverlayList from being
   // destroyed. But it does not keep the RasterOverlayCollection itself alive.
-  std::move(future)
-      .catchInMainThread(
-          [](const std::exception& e)
-              -> RasterOverlay::CreateTileProviderResult {
-            return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
-                RasterOverlayLoadType::Unknown,
-                nullptr,
-                fmt::format(
-                    "Error while creating tile provider: {0}",
-                    e.what())});
-          })
-      .thenInMainThread([pOverlay, pList, pLogger = this->_externals.pLogger](
-                            RasterOverlay::CreateTileProviderResult&& result) {
+  future.thenInMainThread(
+      [pOverlay, pList, pLogger = this->_externals.pLogger](
+          const RasterOverlay::CreateTileProviderResult& result) {
         if (result) {
           // Find the overlay's current location in the list.
           // It's possible it has been removed completely.
@@ -181,6 +171,8 @@ void RasterOverlayCollection::remove(
     return;
   }
 
+  this->_pTileProviderPool->releaseTileProvider(*pOverlay);
+
   int64_t index = it - list.overlays.begin();
   list.overlays.erase(list.overlays.begin() + index);
   list.tileProviders.erase(list.tileProviders.begin() + index);
@@ -0,0 +1,59 @@
+#include <Cesium3DTilesSelection/RasterOverlayTileProviderPool.h>
+#include <CesiumRasterOverlays/RasterOverlayLoadFailureDetails.h>
+
+#include <spdlog/fmt/fmt.h>
+
+using namespace CesiumAsync;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace Cesium3DTilesSelection {
+
+SharedFuture<RasterOverlay::CreateTileProviderResult>
+RasterOverlayTileProviderPool::getTileProvider(
+    const IntrusivePointer<RasterOverlay>& pOverlay,
+    const TilesetExternals& externals) {
+  auto it = this->_entries.find(pOverlay.get());
+  if (it != this->_entries.end()) {
+    ++it->second.users;
+    return it->second.tileProvider;
+  }
+
+  SharedFuture<RasterOverlay::CreateTileProviderResult> tileProvider =
+      pOverlay
+          ->createTileProvider(
+              externals.asyncSystem,
+              externals.pAssetAccessor,
+              externals.pCreditSystem,
+              externals.pPrepareRendererResources,
+              externals.pLogger,
+              nullptr)
+          .catchInMainThread(
+              [](const std::exception& e)
+                  -> RasterOverlay::CreateTileProviderResult {
+                return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
+                    RasterOverlayLoadType::Unknown,
+                    nullptr,
+                    fmt::format(
+                        "Error while creating tile provider: {0}",
+                        e.what())});
+              })
+          .share();
+
+  this->_entries.emplace(pOverlay.get(), Entry{pOverlay, tileProvider, 1});
+  return tileProvider;
+}
+
+void RasterOverlayTileProviderPool::releaseTileProvider(
+    const RasterOverlay& overlay) noexcept {
+  auto it = this->_entries.find(&overlay);
+  if (it == this->_entries.end()) {
+    return;
+  }
+
+  if (--it->second.users == 0) {
+    this->_entries.erase(it);
+  }
+}
+
+} // namespace Cesium3DTilesSelection
@@ -6,7 +6,6 @@
 #include <CesiumGeospatial/Projection.h>
 #include <CesiumRasterOverlays/RasterOverlay.h>
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
-#include <CesiumRasterOverlays/RasterOverlayUtilities.h>
 
 #include <cassert>
 #include <variant>
@@ -62,17 +61,23 @@ RasterOverlayUpsampler::loadTileContent(const TileLoadInput& loadInput) {
     }
   }
 
+  this->_upsampledModels.setMaximumModels(
+      loadInput.contentOptions.maximumCachedUpsampledModels);
+
   const CesiumGltf::Model& parentModel = pParentRenderContent->getModel();
-  return loadInput.asyncSystem.runInWorkerThread(
+  return runInDecodeThread(
+      loadInput.asyncSystem,
+      loadInput.decodeThreadPool,
       [&parentModel,
+       pParent,
+       &upsampledModels = this->_upsampledModels,
        transform = loadInput.tile.getTransform(),
        textureCoordinateIndex = index,
        TileID = *pTileID]() mutable {
-        auto model = RasterOverlayUtilities::upsampleGltfForRasterOverlays(
+        auto model = upsampledModels.upsample(
+            pParent,
             parentModel,
-            TileID,
-            false,
-            RasterOverlayUtilities::DEFAULT_TEXTURE_COORDINATE_BASE_NAME,
+            TileID.tileID,
             textureCoordinateIndex);
         if (!model) {
           return TileLoadResult::createFailedResult(nullptr);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "UpsampledModelCache.h"
+
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
 
 namespace Cesium3DTilesSelection {
@@ -9,5 +11,8 @@ public:
   loadTileContent(const TileLoadInput& loadInput) override;
 
   TileChildrenResult createTileChildren(const Tile& tile) override;
+
+private:
+  UpsampledModelCache _upsampledModels;
 };
 } // namespace Cesium3DTilesSelection
@@ -4,23 +4,31 @@
 #include "CesiumRasterOverlays/RasterizedPolygonsOverlay.h"
 #include "TileUtilities.h"
 
+#include <CesiumGeospatial/CartographicPolygon.h>
+
+#include <vector>
+
 using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+using namespace Cesium3DTilesSelection::CesiumImpl;
 
 RasterizedPolygonsTileExcluder::RasterizedPolygonsTileExcluder(
     const CesiumUtility::IntrusivePointer<
         const CesiumRasterOverlays::RasterizedPolygonsOverlay>&
         pOverlay) noexcept
-    : _pOverlay(pOverlay) {}
+    : _pOverlay(pOverlay),
+      _polygonsRectangle(computePolygonsRectangle(pOverlay->getPolygons())) {}
 
 bool RasterizedPolygonsTileExcluder::shouldExclude(
     const Tile& tile) const noexcept {
-  if (this->_pOverlay->getInvertSelection()) {
-    return Cesium3DTilesSelection::CesiumImpl::outsidePolygons(
-        tile.getBoundingVolume(),
-        this->_pOverlay->getPolygons());
-  } else {
-    return Cesium3DTilesSelection::CesiumImpl::withinPolygons(
-        tile.getBoundingVolume(),
-        this->_pOverlay->getPolygons());
-  }
+  return this->evaluateTile(tile) == TileExclusion::Excluded;
+}
+
+TileExclusion RasterizedPolygonsTileExcluder::evaluateTile(
+    const Tile& tile) const noexcept {
+  return evaluatePolygonsExclusion(
+      tile.getBoundingVolume(),
+      this->_pOverlay->getPolygons(),
+      this->_polygonsRectangle,
+      this->_pOverlay->getInvertSelection());
 }
@@ -0,0 +1,284 @@
+#include "SoftwareOcclusionBuffer.h"
+
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumUtility/Math.h>
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace Cesium3DTilesSelection {
+namespace {
+// Points closer to the camera than this, in meters, are not projected.
+constexpr double nearDepth = 1.0;
+
+// Occluders wider or taller than this, in radians, are ignored. The quads
+// that approximate them would cut far into the ground.
+constexpr double maximumOccluderSpan = Math::OnePi / 2.0;
+
+double edgeFunction(
+    const glm::dvec2& a,
+    const glm::dvec2& b,
+    const glm::dvec2& p) noexcept {
+  return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+}
+
+// Whether the polygon with the given vertices turns the same way at every
+// vertex.
+bool isConvex(const std::array<glm::dvec2, 4>& vertices) noexcept {
+  bool anyLeft = false;
+  bool anyRight = false;
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    const double turn = edgeFunction(
+        vertices[i],
+        vertices[(i + 1) % vertices.size()],
+        vertices[(i + 2) % vertices.size()]);
+    anyLeft = anyLeft || turn > 0.0;
+    anyRight = anyRight || turn < 0.0;
+  }
+  return !(anyLeft && anyRight);
+}
+} // namespace
+
+void SoftwareOcclusionBuffer::reset(
+    const ViewState& viewState,
+    uint32_t width) {
+  const glm::dvec2& viewportSize = viewState.getViewportSize();
+  const double aspectRatio =
+      viewportSize.x > 0.0 ? viewportSize.y / viewportSize.x : 1.0;
+
+  this->_position = viewState.getPosition();
+  this->_direction = viewState.getDirection();
+  this->_right =
+      glm::normalize(glm::cross(viewState.getDirection(), viewState.getUp()));
+  this->_up = glm::cross(this->_right, this->_direction);
+  this->_width = std::max(width, 1U);
+  this->_height = std::max(
+      static_cast<uint32_t>(std::lround(this->_width * aspectRatio)),
+      1U);
+  this->_scale = glm::dvec2(
+      0.5 * this->_width /
+          std::tan(0.5 * viewState.getHorizontalFieldOfView()),
+      0.5 * this->_height / std::tan(0.5 * viewState.getVerticalFieldOfView()));
+
+  // A depth of infinity means that nothing covers the pixel.
+  this->_depths.assign(
+      size_t(this->_width) * size_t(this->_height),
+      std::numeric_limits<double>::infinity());
+  this->_hasOccluders = false;
+}
+
+void SoftwareOcclusionBuffer::addOccluder(
+    const BoundingRegion& region,
+    const Ellipsoid& ellipsoid) {
+  const GlobeRectangle& rectangle = region.getRectangle();
+  const double width = rectangle.computeWidth();
+  if (width > maximumOccluderSpan ||
+      rectangle.computeHeight() > maximumOccluderSpan) {
+    return;
+  }
+
+  // The top of the occluder is a quad between the corners of the region at
+  // its minimum height, which is below the curved bottom of the region. But
+  // the edge between the two corners nearest the pole follows a great circle,
+  // which bulges out of the region toward the pole, so move those corners
+  // toward the equator until it doesn't.
+  const double cosHalfWidth = std::cos(0.5 * width);
+  double south = rectangle.getSouth();
+  double north = rectangle.getNorth();
+  if (north > 0.0) {
+    north = std::atan(std::tan(north) * cosHalfWidth);
+  }
+  if (south < 0.0) {
+    south = std::atan(std::tan(south) * cosHalfWidth);
+  }
+  if (south >= north) {
+    return;
+  }
+
+  const double height = region.getMinimumHeight();
+  const double west = rectangle.getWest();
+  const double east = rectangle.getEast();
+  const std::array<Cartographic, 4> corners{
+      Cartographic(west, south, height),
+      Cartographic(east, south, height),
+      Cartographic(east, north, height),
+      Cartographic(west, north, height)};
+
+  std::array<ProjectedPoint, 4> projected;
+  for (size_t i = 0; i < corners.size(); ++i) {
+    if (!this->project(
+            ellipsoid.cartographicToCartesian(corners[i]),
+            projected[i])) {
+      // Occluders that reach behind the camera are ignored.
+      return;
+    }
+  }
+
+  // The quad is made of two triangles, which cover the same pixels as the
+  // whole quad if it's convex on the screen. Otherwise, rasterize them
+  // separately, which leaves pixels along their shared edge uncovered.
+  if (isConvex(
+          {projected[0].screen,
+           projected[1].screen,
+           projected[2].screen,
+           projected[3].screen})) {
+    this->rasterizeConvexPolygon(projected);
+  } else {
+    const std::array<ProjectedPoint, 3> first{
+        projected[0],
+        projected[1],
+        projected[2]};
+    const std::array<ProjectedPoint, 3> second{
+        projected[0],
+        projected[2],
+        projected[3]};
+    this->rasterizeConvexPolygon(first);
+    this->rasterizeConvexPolygon(second);
+  }
+}
+
+bool SoftwareOcclusionBuffer::isOccluded(
+    const BoundingVolume& boundingVolume) const {
+  if (!this->_hasOccluders) {
+    return false;
+  }
+
+  return this->isOccluded(
+      getOrientedBoundingBoxFromBoundingVolume(boundingVolume));
+}
+
+bool SoftwareOcclusionBuffer::isOccluded(const OrientedBoundingBox& box) const {
+  if (!this->_hasOccluders) {
+    return false;
+  }
+
+  const glm::dvec3& center = box.getCenter();
+  const glm::dmat3& halfAxes = box.getHalfAxes();
+
+  glm::dvec2 minimum(std::numeric_limits<double>::max());
+  glm::dvec2 maximum(std::numeric_limits<double>::lowest());
+  double nearest = std::numeric_limits<double>::max();
+  for (int i = 0; i < 8; ++i) {
+    const glm::dvec3 corner = center + ((i & 1) ? halfAxes[0] : -halfAxes[0]) +
+                              ((i & 2) ? halfAxes[1] : -halfAxes[1]) +
+                              ((i & 4) ? halfAxes[2] : -halfAxes[2]);
+    ProjectedPoint point;
+    if (!this->project(corner, point)) {
+      return false;
+    }
+    minimum = glm::min(minimum, point.screen);
+    maximum = glm::max(maximum, point.screen);
+    nearest = std::min(nearest, point.depth);
+  }
+
+  // Test every pixel the box touches that is on the screen.
+  const double width = double(this->_width);
+  const double height = double(this->_height);
+  const double x0 = std::clamp(std::floor(minimum.x), 0.0, width);
+  const double x1 = std::clamp(std::ceil(maximum.x), 0.0, width);
+  const double y0 = std::clamp(std::floor(minimum.y), 0.0, height);
+  const double y1 = std::clamp(std::ceil(maximum.y), 0.0, height);
+  if (x0 >= x1 || y0 >= y1) {
+    return false;
+  }
+
+  for (size_t y = size_t(y0); y < size_t(y1); ++y) {
+    const double* pRow = &this->_depths[y * this->_width];
+    for (size_t x = size_t(x0); x < size_t(x1); ++x) {
+      if (pRow[x] >= nearest) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool SoftwareOcclusionBuffer::project(
+    const glm::dvec3& position,
+    ProjectedPoint& result) const noexcept {
+  const glm::dvec3 toPosition = position - this->_position;
+  const double depth = glm::dot(toPosition, this->_direction);
+  if (depth < nearDepth) {
+    return false;
+  }
+
+  result.screen = glm::dvec2(
+      0.5 * this->_width +
+          this->_scale.x * glm::dot(toPosition, this->_right) / depth,
+      0.5 * this->_height +
+          this->_scale.y * glm::dot(toPosition, this->_up) / depth);
+  result.depth = depth;
+  return true;
+}
+
+void SoftwareOcclusionBuffer::rasterizeConvexPolygon(
+    gsl::span<const ProjectedPoint> points) {
+  auto vertex = [points](size_t i) -> const glm::dvec2& {
+    return points[i % points.size()].screen;
+  };
+
+  double area = 0.0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    area += vertex(i).x * vertex(i + 1).y - vertex(i + 1).x * vertex(i).y;
+  }
+  if (area == 0.0) {
+    return;
+  }
+
+  // Flip the edges of a clockwise polygon so that the inside of every edge is
+  // positive.
+  const double orientation = area > 0.0 ? 1.0 : -1.0;
+  const auto isInside = [&points, &vertex, orientation](const glm::dvec2& p) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      if (orientation * edgeFunction(vertex(i), vertex(i + 1), p) < 0.0) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  glm::dvec2 minimum(std::numeric_limits<double>::max());
+  glm::dvec2 maximum(std::numeric_limits<double>::lowest());
+  // Every point of the polygon is at least this close to the camera.
+  double depth = 0.0;
+  for (const ProjectedPoint& point : points) {
+    minimum = glm::min(minimum, point.screen);
+    maximum = glm::max(maximum, point.screen);
+    depth = std::max(depth, point.depth);
+  }
+
+  const double width = double(this->_width);
+  const double height = double(this->_height);
+  const double x0 = std::clamp(std::floor(minimum.x), 0.0, width);
+  const double x1 = std::clamp(std::ceil(maximum.x), 0.0, width);
+  const double y0 = std::clamp(std::floor(minimum.y), 0.0, height);
+  const double y1 = std::clamp(std::ceil(maximum.y), 0.0, height);
+
+  for (size_t y = size_t(y0); y < size_t(y1); ++y) {
+    double* pRow = &this->_depths[y * this->_width];
+    for (size_t x = size_t(x0); x < size_t(x1); ++x) {
+      // The polygon is convex, so it covers the whole pixel if it covers the
+      // pixel's corners.
+      const glm::dvec2 corner(double(x), double(y));
+      if (isInside(corner) && isInside(corner + glm::dvec2(1.0, 0.0)) &&
+          isInside(corner + glm::dvec2(0.0, 1.0)) &&
+          isInside(corner + glm::dvec2(1.0, 1.0))) {
+        pRow[x] = std::min(pRow[x], depth);
+        this->_hasOccluders = true;
+      }
+    }
+  }
+}
+} // namespace Cesium3DTilesSelection
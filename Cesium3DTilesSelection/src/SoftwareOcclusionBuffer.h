@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <gsl/span>
+
+#include <cstdint>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class ViewState;
+
+/**
+ * @brief A coarse depth buffer, rendered on the CPU, that conservatively
+ * finds tiles that are hidden behind the ground, see
+ * {@link TilesetOptions::enableSoftwareOcclusionCulling}.
+ *
+ * The occluders are the solid ground below the minimum height of bounding
+ * regions whose content covers the whole region, such as terrain tiles. A
+ * pixel is only covered by an occluder if the occluder covers all of it, and
+ * it stores the farthest depth of that occluder, so a bounding volume is only
+ * reported as occluded if it really is.
+ */
+class SoftwareOcclusionBuffer {
+public:
+  /**
+   * @brief Clears the buffer and sets up the view it is rendered for.
+   *
+   * @param viewState The view to render the occluders for.
+   * @param width The width of the buffer in pixels. The height follows from
+   * the aspect ratio of the view.
+   */
+  void reset(const ViewState& viewState, uint32_t width);
+
+  /**
+   * @brief Adds the ground below the minimum height of a region as an
+   * occluder.
+   *
+   * This assumes that the content of the region covers all of it, and that
+   * the camera is above the ground.
+   */
+  void addOccluder(
+      const CesiumGeospatial::BoundingRegion& region,
+      const CesiumGeospatial::Ellipsoid& ellipsoid =
+          CesiumGeospatial::Ellipsoid::WGS84);
+
+  /**
+   * @brief Whether the given bounding volume is entirely hidden by the
+   * occluders.
+   */
+  bool isOccluded(const BoundingVolume& boundingVolume) const;
+
+  /**
+   * @brief Whether the given box is entirely hidden by the occluders.
+   */
+  bool isOccluded(const CesiumGeometry::OrientedBoundingBox& box) const;
+
+  /**
+   * @brief Whether any pixel of the buffer is covered by an occluder.
+   */
+  bool hasOccluders() const noexcept { return this->_hasOccluders; }
+
+  uint32_t getWidth() const noexcept { return this->_width; }
+  uint32_t getHeight() const noexcept { return this->_height; }
+
+private:
+  struct ProjectedPoint {
+    glm::dvec2 screen;
+    double depth;
+  };
+
+  bool
+  project(const glm::dvec3& position, ProjectedPoint& result) const noexcept;
+  void rasterizeConvexPolygon(gsl::span<const ProjectedPoint> points);
+
+  glm::dvec3 _position{0.0};
+  glm::dvec3 _direction{0.0};
+  glm::dvec3 _right{0.0};
+  glm::dvec3 _up{0.0};
+  glm::dvec2 _scale{0.0};
+  uint32_t _width = 0;
+  uint32_t _height = 0;
+  std::vector<double> _depths;
+  bool _hasOccluders = false;
+};
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,15 @@
+#include "TerrainAvailabilityCache.h"
+
+namespace Cesium3DTilesSelection {
+
+TerrainAvailabilityCache::TerrainAvailabilityCache(
+    size_t maximumBlocks) noexcept
+    : _maximumBlocks(maximumBlocks), _blocks() {}
+
+void TerrainAvailabilityCache::clear() noexcept { this->_blocks.clear(); }
+
+size_t TerrainAvailabilityCache::size() const noexcept {
+  return this->_blocks.size();
+}
+
+} // namespace Cesium3DTilesSelection
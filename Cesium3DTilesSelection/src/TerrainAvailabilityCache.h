@@ -0,0 +1,140 @@
+#pragma once
+
+#include <CesiumGeometry/QuadtreeTileID.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief A bit-packed cache of whether the tiles of a quadtree are available
+ * in any layer of a terrain.
+ *
+ * The quadtree is divided into blocks of {@link levelsPerBlock} levels. A
+ * block holds one bit for each of its 85 tiles, which are all looked up in
+ * the layers the first time that any of them is needed. Later lookups of the
+ * tiles of the block are a hash lookup and a bit test, whichever layer the
+ * tiles are in.
+ *
+ * A tile is assumed to be unavailable when its parent is, so the descendants
+ * of unavailable tiles in a block aren't looked up. The cache must be
+ * cleared whenever the availability of a layer changes.
+ *
+ * This class is not thread-safe.
+ */
+class TerrainAvailabilityCache {
+public:
+  /**
+   * @brief The number of levels of each block.
+   */
+  static constexpr uint32_t levelsPerBlock = 4;
+
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param maximumBlocks The number of blocks above which the cache is
+   * cleared, so that it doesn't grow without bound.
+   */
+  explicit TerrainAvailabilityCache(size_t maximumBlocks = 65536) noexcept;
+
+  /**
+   * @brief Determines whether a tile is available in any layer.
+   *
+   * @param tileID The ID of the tile.
+   * @param isAvailable A function that looks up whether a tile ID is
+   * available in any layer, when the block of the tile isn't cached yet.
+   */
+  template <typename IsAvailable>
+  bool isTileAvailable(
+      const CesiumGeometry::QuadtreeTileID& tileID,
+      IsAvailable&& isAvailable) {
+    const uint32_t depth = tileID.level % levelsPerBlock;
+    const CesiumGeometry::QuadtreeTileID blockID(
+        tileID.level - depth,
+        tileID.x >> depth,
+        tileID.y >> depth);
+
+    auto it = this->_blocks.find(blockID);
+    if (it == this->_blocks.end()) {
+      if (this->_blocks.size() >= this->_maximumBlocks) {
+        this->_blocks.clear();
+      }
+      it = this->_blocks.emplace(blockID, computeBlock(blockID, isAvailable))
+               .first;
+    }
+
+    const uint32_t mask = (1U << depth) - 1U;
+    return testBit(
+        it->second,
+        bitIndex(depth, tileID.x & mask, tileID.y & mask));
+  }
+
+  /**
+   * @brief Removes all blocks from the cache.
+   */
+  void clear() noexcept;
+
+  /**
+   * @brief Gets the number of cached blocks.
+   */
+  size_t size() const noexcept;
+
+private:
+  // 1 + 4 + 16 + 64 tiles.
+  using Block = std::array<uint64_t, 2>;
+
+  // The index of the bit of a tile, from its depth in the block and its
+  // column and row relative to the first tile at that depth.
+  static uint32_t bitIndex(uint32_t depth, uint32_t x, uint32_t y) noexcept {
+    const uint32_t firstAtDepth = ((1U << (2 * depth)) - 1U) / 3U;
+    return firstAtDepth + (y << depth) + x;
+  }
+
+  static bool testBit(const Block& block, uint32_t bit) noexcept {
+    return (block[bit / 64] >> (bit % 64)) & 1U;
+  }
+
+  static void setBit(Block& block, uint32_t bit) noexcept {
+    block[bit / 64] |= uint64_t(1) << (bit % 64);
+  }
+
+  template <typename IsAvailable>
+  static Block computeBlock(
+      const CesiumGeometry::QuadtreeTileID& blockID,
+      IsAvailable& isAvailable) {
+    Block block{};
+    if (!isAvailable(blockID)) {
+      return block;
+    }
+    setBit(block, 0);
+
+    for (uint32_t depth = 1; depth < levelsPerBlock; ++depth) {
+      const uint32_t width = 1U << depth;
+      for (uint32_t y = 0; y < width; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+          if (!testBit(block, bitIndex(depth - 1, x >> 1, y >> 1))) {
+            continue;
+          }
+
+          const CesiumGeometry::QuadtreeTileID tileID(
+              blockID.level + depth,
+              (blockID.x << depth) + x,
+              (blockID.y << depth) + y);
+          if (isAvailable(tileID)) {
+            setBit(block, bitIndex(depth, x, y));
+          }
+        }
+      }
+    }
+
+    return block;
+  }
+
+  size_t _maximumBlocks;
+  std::unordered_map<CesiumGeometry::QuadtreeTileID, Block> _blocks;
+};
+
+} // namespace Cesium3DTilesSelection
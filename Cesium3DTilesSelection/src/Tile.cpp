@@ -57,7 +57,12 @@ Tile::Tile(
       _content{std::forward<TileContentArgs>(args)...},
       _pLoader{pLoader},
       _loadState{loadState},
-      _shouldContentContinueUpdating{true} {}
+      _shouldContentContinueUpdating{true},
+      _cachedViewEvaluation(),
+      _cullingVolume(),
+      _childCullingVolumes(),
+      _horizonCullingPoint(),
+      _cachedExclusion() {}
 
 Tile::Tile(Tile&& rhs) noexcept
     : _pParent(rhs._pParent),
@@ -74,7 +79,12 @@ Tile::Tile(Tile&& rhs) noexcept
       _content(std::move(rhs._content)),
       _pLoader{rhs._pLoader},
       _loadState{rhs._loadState},
-      _shouldContentContinueUpdating{rhs._shouldContentContinueUpdating} {
+      _shouldContentContinueUpdating{rhs._shouldContentContinueUpdating},
+      _cachedViewEvaluation(rhs._cachedViewEvaluation),
+      _cullingVolume(rhs._cullingVolume),
+      _childCullingVolumes(std::move(rhs._childCullingVolumes)),
+      _horizonCullingPoint(rhs._horizonCullingPoint),
+      _cachedExclusion(rhs._cachedExclusion) {
   // since children of rhs will have the parent pointed to rhs,
   // we will reparent them to this tile as rhs will be destroyed after this
   for (Tile& tile : this->_children) {
@@ -106,6 +116,11 @@ Tile& Tile::operator=(Tile&& rhs) noexcept {
     this->_pLoader = rhs._pLoader;
     this->_loadState = rhs._loadState;
     this->_shouldContentContinueUpdating = rhs._shouldContentContinueUpdating;
+    this->_cachedViewEvaluation = rhs._cachedViewEvaluation;
+    this->_cullingVolume = rhs._cullingVolume;
+    this->_childCullingVolumes = std::move(rhs._childCullingVolumes);
+    this->_horizonCullingPoint = rhs._horizonCullingPoint;
+    this->_cachedExclusion = rhs._cachedExclusion;
   }
 
   return *this;
@@ -120,6 +135,21 @@ void Tile::createChildTiles(std::vector<Tile>&& children) {
   for (Tile& tile : this->_children) {
     tile.setParent(this);
   }
+
+  // Culling may now use the bounding volumes of the new children.
+  this->_cachedViewEvaluation.viewEpoch = 0;
+  this->_childCullingVolumes.isValid = false;
+}
+
+std::vector<Tile> Tile::takeChildTiles() noexcept {
+  std::vector<Tile> children = std::move(this->_children);
+  this->_children.clear();
+
+  this->_cachedViewEvaluation.viewEpoch = 0;
+  this->_childCullingVolumes.isValid = false;
+  this->_shouldContentContinueUpdating = true;
+
+  return children;
 }
 
 double Tile::getNonZeroGeometricError() const noexcept {
@@ -167,16 +197,23 @@ int64_t Tile::computeByteSize() const noexcept {
     for (const CesiumGltf::Image& image : model.images) {
       const int32_t bufferView = image.bufferView;
       // For images loaded from buffers, subtract the buffer size before adding
-      // the decoded image size.
+      // the decoded image size. The buffer may have been released already.
       if (bufferView >= 0 &&
           bufferView < static_cast<int32_t>(bufferViews.size())) {
-        bytes -= bufferViews[size_t(bufferView)].byteLength;
+        const CesiumGltf::BufferView& view = bufferViews[size_t(bufferView)];
+        if (view.buffer >= 0 &&
+            view.buffer < static_cast<int32_t>(model.buffers.size()) &&
+            !model.buffers[size_t(view.buffer)].cesium.data.empty()) {
+          bytes -= view.byteLength;
+        }
       }
 
       // sizeBytes is set in TilesetContentManager::ContentKindSetter, if not
       // sooner (e.g., by the renderer implementation).
       bytes += image.cesium.sizeBytes;
     }
+
+    bytes += pRenderContent->getRenderResourcesByteSize();
   }
 
   return bytes;
@@ -235,4 +272,78 @@ void Tile::setContentShouldContinueUpdating(
     bool shouldContentContinueUpdating) noexcept {
   this->_shouldContentContinueUpdating = shouldContentContinueUpdating;
 }
+
+void Tile::invalidateCachedViewEvaluation() noexcept {
+  this->_cachedViewEvaluation.viewEpoch = 0;
+  if (this->_pParent) {
+    this->_pParent->_cachedViewEvaluation.viewEpoch = 0;
+    this->_pParent->_childCullingVolumes.isValid = false;
+  }
+}
+
+void Tile::updateChildCullingVolumes() {
+  ChildCullingVolumes& volumes = this->_childCullingVolumes;
+  if (volumes.isValid) {
+    return;
+  }
+
+  volumes.anyUnconditionallyRefine = false;
+  volumes.boxes.clear();
+  volumes.spheres.clear();
+
+  for (Tile& child : this->_children) {
+    volumes.anyUnconditionallyRefine =
+        volumes.anyUnconditionallyRefine || child.getUnconditionallyRefine();
+
+    // Spheres are culled as they are, because their boxes are looser.
+    const BoundingVolume& boundingVolume = child.getBoundingVolume();
+    if (const auto* pSphere = std::get_if<BoundingSphere>(&boundingVolume)) {
+      volumes.spheres.emplace_back(*pSphere);
+    } else {
+      volumes.boxes.emplace_back(child.updateCullingVolume().box);
+    }
+  }
+
+  volumes.isValid = true;
+}
+
+const Tile::CachedCullingVolume& Tile::updateCullingVolume() {
+  CachedCullingVolume& cached = this->_cullingVolume;
+  if (cached.isValid) {
+    return cached;
+  }
+
+  const BoundingVolume& boundingVolume = this->getBoundingVolume();
+  cached.box = getOrientedBoundingBoxFromBoundingVolume(boundingVolume);
+  if (const auto* pSphere = std::get_if<BoundingSphere>(&boundingVolume)) {
+    cached.sphere = *pSphere;
+  } else {
+    cached.sphere = cached.box.toSphere();
+  }
+
+  cached.isValid = true;
+  return cached;
+}
+
+const std::optional<HorizonCullingPoint>& Tile::updateHorizonCullingPoint() {
+  CachedHorizonCullingPoint& cached = this->_horizonCullingPoint;
+  if (cached.isValid) {
+    return cached.point;
+  }
+
+  // Only volumes with exact heights are culled. Tighter heights may come later
+  // for loose-fitting regions, but meanwhile their minimum may be too high.
+  const BoundingVolume& boundingVolume = this->getBoundingVolume();
+  if (const auto* pRegion = std::get_if<BoundingRegion>(&boundingVolume)) {
+    cached.point = EllipsoidalOccluder::computeHorizonCullingPoint(*pRegion);
+  } else if (
+      const auto* pS2 = std::get_if<S2CellBoundingVolume>(&boundingVolume)) {
+    cached.point = EllipsoidalOccluder::computeHorizonCullingPoint(*pS2);
+  } else {
+    cached.point = std::nullopt;
+  }
+
+  cached.isValid = true;
+  return cached.point;
+}
 } // namespace Cesium3DTilesSelection
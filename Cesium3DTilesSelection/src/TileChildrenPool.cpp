@@ -0,0 +1,42 @@
+#include "TileChildrenPool.h"
+
+#include <CesiumUtility/Tracing.h>
+
+namespace Cesium3DTilesSelection {
+TileChildrenPool::TileChildrenPool(
+    size_t blockCapacity,
+    size_t maximumFreeBlocks) noexcept
+    : _blockCapacity(blockCapacity),
+      _maximumFreeBlocks(maximumFreeBlocks),
+      _freeBlocks() {}
+
+std::vector<Tile> TileChildrenPool::allocate() {
+  if (this->_freeBlocks.empty()) {
+    std::vector<Tile> block;
+    block.reserve(this->_blockCapacity);
+    return block;
+  }
+
+  std::vector<Tile> block = std::move(this->_freeBlocks.back());
+  this->_freeBlocks.pop_back();
+  return block;
+}
+
+void TileChildrenPool::release(std::vector<Tile>&& block) {
+  CESIUM_TRACE("TileChildrenPool::release");
+
+  std::vector<Tile> released = std::move(block);
+  if (released.capacity() < this->_blockCapacity ||
+      this->_freeBlocks.size() >= this->_maximumFreeBlocks) {
+    // Let the block be freed.
+    return;
+  }
+
+  released.clear();
+  this->_freeBlocks.emplace_back(std::move(released));
+}
+
+size_t TileChildrenPool::getFreeBlockCount() const noexcept {
+  return this->_freeBlocks.size();
+}
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/Tile.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+/**
+ * @brief A free list of blocks of child tiles.
+ *
+ * Loaders that create the children of the same tiles over and over again,
+ * such as the implicit loaders, take the storage for each new block of
+ * children from the pool. When a block of children is discarded, its storage
+ * is returned to the pool instead of being freed, so flying back and forth
+ * over a dataset does not allocate and free a block for every tile it
+ * refines.
+ *
+ * This class is not thread-safe. Children are only created and discarded in
+ * the main thread.
+ */
+class TileChildrenPool {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param blockCapacity The number of tiles in each block, which is the
+   * maximum number of children of a single tile.
+   * @param maximumFreeBlocks The maximum number of unused blocks kept by the
+   * pool. Blocks released beyond this are freed.
+   */
+  explicit TileChildrenPool(
+      size_t blockCapacity,
+      size_t maximumFreeBlocks = 1024) noexcept;
+
+  /**
+   * @brief Gets an empty block with room for at least the block capacity of
+   * child tiles.
+   */
+  std::vector<Tile> allocate();
+
+  /**
+   * @brief Destroys the tiles in the given block and keeps its storage for a
+   * later call to {@link allocate}.
+   *
+   * @param block The block to release.
+   */
+  void release(std::vector<Tile>&& block);
+
+  /**
+   * @brief Gets the number of unused blocks currently kept by the pool.
+   */
+  size_t getFreeBlockCount() const noexcept;
+
+private:
+  size_t _blockCapacity;
+  size_t _maximumFreeBlocks;
+  std::vector<std::vector<Tile>> _freeBlocks;
+};
+} // namespace Cesium3DTilesSelection
@@ -6,7 +6,9 @@ using namespace CesiumUtility;
 namespace Cesium3DTilesSelection {
 TileRenderContent::TileRenderContent(CesiumGltf::Model&& model)
     : _model{std::move(model)},
+      _pTriangleIndex{},
       _pRenderResources{nullptr},
+      _renderResourcesByteSize{0},
       _rasterOverlayDetails{},
       _credits{},
       _lodTransitionFadePercentage{0.0f} {}
@@ -19,10 +21,21 @@ CesiumGltf::Model& TileRenderContent::getModel() noexcept { return _model; }
 
 void TileRenderContent::setModel(const CesiumGltf::Model& model) {
   _model = model;
+  _pTriangleIndex.reset();
 }
 
 void TileRenderContent::setModel(CesiumGltf::Model&& model) {
   _model = std::move(model);
+  _pTriangleIndex.reset();
+}
+
+const TileTriangleIndex* TileRenderContent::getTriangleIndex() const noexcept {
+  return _pTriangleIndex.get();
+}
+
+void TileRenderContent::setTriangleIndex(
+    std::shared_ptr<const TileTriangleIndex> pTriangleIndex) noexcept {
+  _pTriangleIndex = std::move(pTriangleIndex);
 }
 
 const RasterOverlayDetails&
@@ -68,6 +81,14 @@ void TileRenderContent::setRenderResources(void* pRenderResources) noexcept {
   this->_pRenderResources = pRenderResources;
 }
 
+int64_t TileRenderContent::getRenderResourcesByteSize() const noexcept {
+  return this->_renderResourcesByteSize;
+}
+
+void TileRenderContent::setRenderResourcesByteSize(int64_t bytes) noexcept {
+  this->_renderResourcesByteSize = bytes;
+}
+
 float TileRenderContent::getLodTransitionFadePercentage() const noexcept {
   return _lodTransitionFadePercentage;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "TileLoadMetricsRecorder.h"
+
 #include <Cesium3DTilesSelection/BoundingVolume.h>
 #include <Cesium3DTilesSelection/IPrepareRendererResources.h>
 #include <Cesium3DTilesSelection/Tile.h>
@@ -8,13 +10,17 @@
 #include <Cesium3DTilesSelection/TilesetOptions.h>
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/ThreadPool.h>
 #include <CesiumGeometry/Axis.h>
+#include <CesiumGltfReader/SharedImageCache.h>
 
 #include <gsl/span>
 #include <spdlog/fwd.h>
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
+#include <optional>
 
 namespace Cesium3DTilesSelection {
 struct TileContentLoadInfo {
@@ -48,5 +54,23 @@ struct TileContentLoadInfo {
   glm::dmat4 tileTransform;
 
   TilesetContentOptions contentOptions;
+
+  // Set when the load is canceled, see TileLoadInput::pCanceled.
+  std::shared_ptr<const std::atomic<bool>> pCanceled;
+
+  // The pool for CPU-heavy decoding, see TilesetExternals::decodeThreadPool.
+  std::optional<CesiumAsync::ThreadPool> decodeThreadPool;
+
+  // Records how long the stages of the load take.
+  std::shared_ptr<TileLoadMetricsRecorder> pMetrics;
+
+  // The cache of external images, see TilesetExternals::pSharedImageCache.
+  std::shared_ptr<CesiumGltfReader::SharedImageCache> pSharedImageCache;
+
+  // Set when the content was already post-processed before it hibernated,
+  // see TilesetOptions::maximumHibernatedBytes, so its meshes are final.
+  bool meshesArePostProcessed = false;
+
+  bool isCanceled() const noexcept { return pCanceled && *pCanceled; }
 };
 } // namespace Cesium3DTilesSelection
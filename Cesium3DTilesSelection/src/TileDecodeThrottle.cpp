@@ -0,0 +1,219 @@
+#include "TileDecodeThrottle.h"
+
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+
+#include <cassert>
+#include <utility>
+
+using namespace CesiumAsync;
+
+namespace Cesium3DTilesSelection {
+TileDecodeThrottle::TileDecodeThrottle(
+    uint32_t maximumSimultaneousDecodes) noexcept
+    : _mutex(),
+      _maximumSimultaneousDecodes(maximumSimultaneousDecodes),
+      _tilesDecoding(0),
+      _waitingTiles() {}
+
+void TileDecodeThrottle::setMaximumSimultaneousDecodes(
+    uint32_t maximumSimultaneousDecodes) {
+  std::vector<Promise<void>> granted;
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_maximumSimultaneousDecodes = maximumSimultaneousDecodes;
+    while (!this->_waitingTiles.empty() &&
+           (this->_maximumSimultaneousDecodes == 0 ||
+            this->_tilesDecoding < this->_maximumSimultaneousDecodes)) {
+      granted.emplace_back(std::move(this->_waitingTiles.front()));
+      this->_waitingTiles.pop_front();
+      ++this->_tilesDecoding;
+    }
+  }
+
+  // Resolve outside the lock, because continuations may run right away.
+  for (const Promise<void>& promise : granted) {
+    promise.resolve();
+  }
+}
+
+uint32_t TileDecodeThrottle::getMaximumSimultaneousDecodes() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_maximumSimultaneousDecodes;
+}
+
+Future<void> TileDecodeThrottle::acquire(const AsyncSystem& asyncSystem) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (this->_maximumSimultaneousDecodes == 0 ||
+      this->_tilesDecoding < this->_maximumSimultaneousDecodes) {
+    ++this->_tilesDecoding;
+    return asyncSystem.createResolvedFuture();
+  }
+
+  Promise<void> promise = asyncSystem.createPromise<void>();
+  Future<void> future = promise.getFuture();
+  this->_waitingTiles.emplace_back(std::move(promise));
+  return future;
+}
+
+void TileDecodeThrottle::release() {
+  std::optional<Promise<void>> granted;
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (!this->_waitingTiles.empty() &&
+        (this->_maximumSimultaneousDecodes == 0 ||
+         this->_tilesDecoding <= this->_maximumSimultaneousDecodes)) {
+      // Hand the slot straight to the next tile.
+      granted.emplace(std::move(this->_waitingTiles.front()));
+      this->_waitingTiles.pop_front();
+    } else {
+      --this->_tilesDecoding;
+    }
+  }
+
+  if (granted) {
+    granted->resolve();
+  }
+}
+
+uint32_t TileDecodeThrottle::getNumberOfTilesDecoding() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_tilesDecoding;
+}
+
+uint32_t TileDecodeThrottle::getNumberOfTilesWaiting() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return static_cast<uint32_t>(this->_waitingTiles.size());
+}
+
+TileDecodeSlot::TileDecodeSlot(
+    const std::shared_ptr<TileDecodeThrottle>& pThrottle) noexcept
+    : _pThrottle(pThrottle), _mutex(), _granted() {}
+
+Future<void> TileDecodeSlot::acquire(const AsyncSystem& asyncSystem) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (!this->_granted) {
+    this->_granted = this->_pThrottle->acquire(asyncSystem).share();
+  }
+  return this->_granted->thenImmediately([]() {});
+}
+
+void TileDecodeSlot::release() {
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (!this->_granted) {
+      return;
+    }
+
+    // A load only completes after the responses it requested were handed to
+    // it, which requires the slot to be granted.
+    assert(
+        this->_granted->isReady() &&
+        "A tile load completed while waiting for a decode slot");
+    this->_granted.reset();
+  }
+
+  this->_pThrottle->release();
+}
+
+TileDecodeSlotAssetAccessor::TileDecodeSlotAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<TileDecodeSlot>& pSlot,
+    const std::shared_ptr<TileLoadMetricsRecorder>& pMetrics,
+    const std::shared_ptr<AdaptiveConcurrencyLimit>& pConcurrency)
+    : _pAssetAccessor(pAssetAccessor),
+      _pSlot(pSlot),
+      _pMetrics(pMetrics),
+      _pConcurrency(pConcurrency),
+      _pLastResponseTime(
+          std::make_shared<std::atomic<std::chrono::steady_clock::rep>>(0)) {}
+
+Future<std::shared_ptr<IAssetRequest>> TileDecodeSlotAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->holdUntilDecodeSlot(
+      asyncSystem,
+      this->_pAssetAccessor->get(asyncSystem, url, headers));
+}
+
+Future<std::shared_ptr<IAssetRequest>> TileDecodeSlotAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->holdUntilDecodeSlot(
+      asyncSystem,
+      this->_pAssetAccessor
+          ->request(asyncSystem, verb, url, headers, contentPayload));
+}
+
+void TileDecodeSlotAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+std::optional<std::chrono::steady_clock::time_point>
+TileDecodeSlotAssetAccessor::getLastResponseTime() const noexcept {
+  const std::chrono::steady_clock::rep time =
+      this->_pLastResponseTime->load(std::memory_order_acquire);
+  if (time == 0) {
+    return std::nullopt;
+  }
+  return std::chrono::steady_clock::time_point(
+      std::chrono::steady_clock::duration(time));
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+TileDecodeSlotAssetAccessor::holdUntilDecodeSlot(
+    const AsyncSystem& asyncSystem,
+    Future<std::shared_ptr<IAssetRequest>>&& future) {
+  const std::chrono::steady_clock::time_point requestTime =
+      std::chrono::steady_clock::now();
+  return std::move(future).thenImmediately(
+      [asyncSystem,
+       pSlot = this->_pSlot,
+       pMetrics = this->_pMetrics,
+       pConcurrency = this->_pConcurrency,
+       pLastResponseTime = this->_pLastResponseTime,
+       requestTime](std::shared_ptr<IAssetRequest>&& pCompletedRequest) {
+        const std::chrono::steady_clock::time_point responseTime =
+            std::chrono::steady_clock::now();
+        if (pConcurrency) {
+          pConcurrency->recordResponse(
+              *pCompletedRequest,
+              requestTime,
+              responseTime);
+        }
+        if (pMetrics) {
+          pMetrics->recordLatency(
+              TileLoadStage::Request,
+              responseTime - requestTime);
+          const IAssetResponse* pResponse = pCompletedRequest->response();
+          if (pResponse) {
+            pMetrics->recordBytesReceived(pResponse->data().size());
+          }
+        }
+
+        return pSlot->acquire(asyncSystem).thenImmediately(
+            [pMetrics,
+             pLastResponseTime,
+             responseTime,
+             pCompletedRequest = std::move(pCompletedRequest)]() mutable {
+              const std::chrono::steady_clock::time_point grantedTime =
+                  std::chrono::steady_clock::now();
+              if (pMetrics) {
+                pMetrics->recordLatency(
+                    TileLoadStage::DecodeQueue,
+                    grantedTime - responseTime);
+              }
+              pLastResponseTime->store(
+                  grantedTime.time_since_epoch().count(),
+                  std::memory_order_release);
+              return std::move(pCompletedRequest);
+            });
+      });
+}
+} // namespace Cesium3DTilesSelection
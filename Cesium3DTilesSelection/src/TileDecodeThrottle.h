@@ -0,0 +1,173 @@
+#pragma once
+
+#include "TileLoadMetricsRecorder.h"
+
+#include <CesiumAsync/AdaptiveConcurrencyLimit.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/Promise.h>
+#include <CesiumAsync/SharedFuture.h>
+
+#include <gsl/span>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+/**
+ * @brief Limits how many tiles may decode and post-process their content at
+ * the same time, independently of how many are fetching it.
+ *
+ * A tile holds a decode slot from the moment its first response arrives until
+ * its load completes. Tiles that arrive while every slot is taken wait, in
+ * arrival order, for a slot to be released.
+ *
+ * This class is thread-safe. Slots are acquired from worker threads and
+ * released in the main thread.
+ */
+class TileDecodeThrottle {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param maximumSimultaneousDecodes The number of slots, or 0 for no limit.
+   */
+  explicit TileDecodeThrottle(uint32_t maximumSimultaneousDecodes) noexcept;
+
+  /**
+   * @brief Changes the number of slots. If it grows, waiting tiles are given
+   * the new slots.
+   */
+  void setMaximumSimultaneousDecodes(uint32_t maximumSimultaneousDecodes);
+
+  /**
+   * @brief Gets the number of slots, or 0 if there is no limit.
+   */
+  uint32_t getMaximumSimultaneousDecodes() const;
+
+  /**
+   * @brief Acquires a slot. The returned future resolves once the slot is
+   * granted.
+   */
+  CesiumAsync::Future<void>
+  acquire(const CesiumAsync::AsyncSystem& asyncSystem);
+
+  /**
+   * @brief Releases a granted slot, handing it to the longest-waiting tile, if
+   * any.
+   */
+  void release();
+
+  /**
+   * @brief Gets the number of tiles that hold a slot.
+   */
+  uint32_t getNumberOfTilesDecoding() const;
+
+  /**
+   * @brief Gets the number of tiles that are waiting for a slot.
+   */
+  uint32_t getNumberOfTilesWaiting() const;
+
+private:
+  mutable std::mutex _mutex;
+  uint32_t _maximumSimultaneousDecodes;
+  uint32_t _tilesDecoding;
+  std::deque<CesiumAsync::Promise<void>> _waitingTiles;
+};
+
+/**
+ * @brief The decode slot of a single tile load.
+ *
+ * A tile may issue several requests, such as one for its content and more for
+ * the external buffers of its glTF. Only the first one to complete acquires a
+ * slot from the {@link TileDecodeThrottle}; the others share it, so a tile
+ * never waits for a second slot while holding one.
+ */
+class TileDecodeSlot {
+public:
+  explicit TileDecodeSlot(
+      const std::shared_ptr<TileDecodeThrottle>& pThrottle) noexcept;
+
+  /**
+   * @brief Acquires the slot of this tile, if it doesn't hold it already. The
+   * returned future resolves once the slot is granted.
+   */
+  CesiumAsync::Future<void>
+  acquire(const CesiumAsync::AsyncSystem& asyncSystem);
+
+  /**
+   * @brief Releases the slot of this tile, if it holds one.
+   */
+  void release();
+
+private:
+  std::shared_ptr<TileDecodeThrottle> _pThrottle;
+  std::mutex _mutex;
+  std::optional<CesiumAsync::SharedFuture<void>> _granted;
+};
+
+/**
+ * @brief A decorator for an {@link CesiumAsync::IAssetAccessor} that holds
+ * back the responses for a tile until the tile has a decode slot.
+ *
+ * Loaders decode a response in the continuation of the request, so this
+ * delays decoding without any change to the loaders. For the same reason, it
+ * measures the {@link TileLoadStage::Request} and
+ * {@link TileLoadStage::DecodeQueue} stages if it's given a recorder, and
+ * reports the latency of each response to a
+ * {@link CesiumAsync::AdaptiveConcurrencyLimit} if it's given one.
+ */
+class TileDecodeSlotAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  TileDecodeSlotAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<TileDecodeSlot>& pSlot,
+      const std::shared_ptr<TileLoadMetricsRecorder>& pMetrics = nullptr,
+      const std::shared_ptr<CesiumAsync::AdaptiveConcurrencyLimit>&
+          pConcurrency = nullptr);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Gets the time when the last response was handed to the loader, or
+   * `std::nullopt` if there has been no response yet.
+   */
+  std::optional<std::chrono::steady_clock::time_point>
+  getLastResponseTime() const noexcept;
+
+private:
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  holdUntilDecodeSlot(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>&&
+          future);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  std::shared_ptr<TileDecodeSlot> _pSlot;
+  std::shared_ptr<TileLoadMetricsRecorder> _pMetrics;
+  std::shared_ptr<CesiumAsync::AdaptiveConcurrencyLimit> _pConcurrency;
+  std::shared_ptr<std::atomic<std::chrono::steady_clock::rep>>
+      _pLastResponseTime;
+};
+} // namespace Cesium3DTilesSelection
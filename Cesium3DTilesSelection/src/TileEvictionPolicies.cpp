@@ -0,0 +1,82 @@
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/TileEvictionPolicies.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+namespace Cesium3DTilesSelection {
+
+void LruTileEvictionPolicy::orderEvictionCandidates(
+    [[maybe_unused]] std::vector<Tile*>& candidates,
+    [[maybe_unused]] const std::vector<Tile*>& renderedTiles) {}
+
+CostAwareTileEvictionPolicy::CostAwareTileEvictionPolicy(
+    ReloadCostFunction reloadCost)
+    : _reloadCost(std::move(reloadCost)) {}
+
+void CostAwareTileEvictionPolicy::orderEvictionCandidates(
+    std::vector<Tile*>& candidates,
+    [[maybe_unused]] const std::vector<Tile*>& renderedTiles) {
+  CESIUM_TRACE("CostAwareTileEvictionPolicy::orderEvictionCandidates");
+
+  // Computing a tile's size walks its whole model, so do it once per tile
+  // rather than in the comparison.
+  using RankedTile = std::pair<double, Tile*>;
+  std::vector<RankedTile> ranked;
+  ranked.reserve(candidates.size());
+  for (Tile* pTile : candidates) {
+    const double bytes = static_cast<double>(pTile->computeByteSize());
+    const double reloadCost =
+        this->_reloadCost ? this->_reloadCost(*pTile) : 1.0;
+    ranked.emplace_back(bytes / std::max(reloadCost, 1e-9), pTile);
+  }
+
+  std::stable_sort(
+      ranked.begin(),
+      ranked.end(),
+      [](const RankedTile& a, const RankedTile& b) {
+        return a.first > b.first;
+      });
+
+  for (size_t i = 0; i < ranked.size(); ++i) {
+    candidates[i] = ranked[i].second;
+  }
+}
+
+AncestorPinningTileEvictionPolicy::AncestorPinningTileEvictionPolicy(
+    const std::shared_ptr<ITileEvictionPolicy>& pPolicy)
+    : _pPolicy(pPolicy) {}
+
+void AncestorPinningTileEvictionPolicy::orderEvictionCandidates(
+    std::vector<Tile*>& candidates,
+    const std::vector<Tile*>& renderedTiles) {
+  CESIUM_TRACE("AncestorPinningTileEvictionPolicy::orderEvictionCandidates");
+
+  std::unordered_set<const Tile*> pinned;
+  for (const Tile* pTile : renderedTiles) {
+    for (const Tile* pAncestor = pTile->getParent(); pAncestor != nullptr;
+         pAncestor = pAncestor->getParent()) {
+      if (!pinned.insert(pAncestor).second) {
+        // The rest of the ancestors are already pinned.
+        break;
+      }
+    }
+  }
+
+  candidates.erase(
+      std::remove_if(
+          candidates.begin(),
+          candidates.end(),
+          [&pinned](const Tile* pTile) {
+            return pinned.find(pTile) != pinned.end();
+          }),
+      candidates.end());
+
+  if (this->_pPolicy) {
+    this->_pPolicy->orderEvictionCandidates(candidates, renderedTiles);
+  }
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,125 @@
+#include "TileHibernationCache.h"
+
+#include <CesiumUtility/Gunzip.h>
+
+#include <iterator>
+
+namespace Cesium3DTilesSelection {
+
+TileHibernationCache::TileHibernationCache(int64_t maximumBytes) noexcept
+    : _maximumBytes(maximumBytes),
+      _totalBytes(0),
+      _nextTicket(1),
+      _modelFormat(nullptr),
+      _mutex(),
+      _entries(),
+      _entriesByTile(),
+      _ticketsByTile() {}
+
+void TileHibernationCache::setMaximumBytes(int64_t maximumBytes) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_maximumBytes = maximumBytes;
+  this->trim();
+}
+
+uint64_t TileHibernationCache::beginHibernating(const Tile* pTile) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (this->_maximumBytes <= 0) {
+    return 0;
+  }
+
+  const uint64_t ticket = this->_nextTicket++;
+  this->_ticketsByTile[pTile] = ticket;
+  return ticket;
+}
+
+void TileHibernationCache::finishHibernating(
+    const Tile* pTile,
+    uint64_t ticket,
+    const CesiumGltf::Model& model,
+    std::optional<CesiumRasterOverlays::RasterOverlayDetails>&&
+        rasterOverlayDetails) {
+  // Compress without holding the lock, so that other tiles are compressed at
+  // the same time.
+  auto pContent = std::make_shared<HibernatedTileContent>();
+  const std::vector<std::byte> written = this->_modelFormat.write(model);
+  const bool compressed =
+      !written.empty() &&
+      CesiumUtility::gzip(written, pContent->compressedModel);
+  pContent->compressedModel.shrink_to_fit();
+  pContent->rasterOverlayDetails = std::move(rasterOverlayDetails);
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  auto ticketIt = this->_ticketsByTile.find(pTile);
+  if (ticketIt == this->_ticketsByTile.end() || ticketIt->second != ticket) {
+    return;
+  }
+  this->_ticketsByTile.erase(ticketIt);
+  if (!compressed) {
+    return;
+  }
+
+  auto entryIt = this->_entriesByTile.find(pTile);
+  if (entryIt != this->_entriesByTile.end()) {
+    this->_totalBytes -=
+        int64_t(entryIt->second->second->compressedModel.size());
+    this->_entries.erase(entryIt->second);
+    this->_entriesByTile.erase(entryIt);
+  }
+
+  this->_totalBytes += int64_t(pContent->compressedModel.size());
+  this->_entries.emplace_back(pTile, std::move(pContent));
+  this->_entriesByTile.emplace(pTile, std::prev(this->_entries.end()));
+  this->trim();
+}
+
+std::shared_ptr<const HibernatedTileContent>
+TileHibernationCache::take(const Tile* pTile) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_ticketsByTile.erase(pTile);
+
+  auto entryIt = this->_entriesByTile.find(pTile);
+  if (entryIt == this->_entriesByTile.end()) {
+    return nullptr;
+  }
+
+  std::shared_ptr<const HibernatedTileContent> pContent =
+      std::move(entryIt->second->second);
+  this->_totalBytes -= int64_t(pContent->compressedModel.size());
+  this->_entries.erase(entryIt->second);
+  this->_entriesByTile.erase(entryIt);
+  return pContent;
+}
+
+void TileHibernationCache::remove(const Tile* pTile) noexcept {
+  this->take(pTile);
+}
+
+std::optional<CesiumGltf::Model>
+TileHibernationCache::decompress(const HibernatedTileContent& content) const {
+  std::vector<std::byte> written;
+  if (!CesiumUtility::gunzip(content.compressedModel, written)) {
+    return std::nullopt;
+  }
+  return this->_modelFormat.read(written);
+}
+
+size_t TileHibernationCache::size() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_entries.size();
+}
+
+int64_t TileHibernationCache::getTotalBytes() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_totalBytes;
+}
+
+void TileHibernationCache::trim() {
+  while (!this->_entries.empty() && this->_totalBytes > this->_maximumBytes) {
+    const Entry& oldest = this->_entries.front();
+    this->_totalBytes -= int64_t(oldest.second->compressedModel.size());
+    this->_entriesByTile.erase(oldest.first);
+    this->_entries.pop_front();
+  }
+}
+} // namespace Cesium3DTilesSelection
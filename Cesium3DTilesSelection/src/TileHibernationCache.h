@@ -0,0 +1,147 @@
+#pragma once
+
+#include <Cesium3DTilesContent/DecodedModelCache.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumRasterOverlays/RasterOverlayDetails.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+
+/**
+ * @brief The content of a tile that was unloaded but kept in memory by a
+ * {@link TileHibernationCache}.
+ */
+struct HibernatedTileContent {
+  /**
+   * @brief The post-processed model of the tile, in the format of
+   * {@link Cesium3DTilesContent::DecodedModelCache::write}, gzipped.
+   */
+  std::vector<std::byte> compressedModel;
+
+  /**
+   * @brief The raster overlay details of the tile, if it had any.
+   */
+  std::optional<CesiumRasterOverlays::RasterOverlayDetails>
+      rasterOverlayDetails;
+};
+
+/**
+ * @brief Keeps the content of unloaded tiles in memory, compressed, so that a
+ * tile that is loaded again is decompressed instead of being requested and
+ * decoded again.
+ *
+ * When the tiles take more than the maximum number of bytes, the ones that
+ * were unloaded longest ago are dropped. A tile's content is used at most
+ * once: it is removed when the tile is loaded again.
+ *
+ * The models are compressed in worker threads, so a tile is hibernated in two
+ * steps. {@link beginHibernating} is called in the main thread when the tile
+ * is unloaded, and {@link finishHibernating} in a worker thread once its model
+ * has been compressed. If the tile is taken or removed in between, the
+ * compressed model is dropped, so that it can't be mistaken for the content of
+ * a later load, or of a new tile at the same address.
+ *
+ * This class is thread-safe.
+ */
+class TileHibernationCache {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param maximumBytes The number of compressed bytes to keep, or 0 to keep
+   * none.
+   */
+  explicit TileHibernationCache(int64_t maximumBytes = 0) noexcept;
+
+  /**
+   * @brief Changes the number of compressed bytes to keep. If it shrinks, the
+   * tiles that were unloaded longest ago are dropped.
+   */
+  void setMaximumBytes(int64_t maximumBytes);
+
+  /**
+   * @brief Starts hibernating a tile whose content is being unloaded.
+   *
+   * @param pTile The tile.
+   * @return The ticket to pass to {@link finishHibernating}, or 0 if the
+   * cache keeps no tiles.
+   */
+  uint64_t beginHibernating(const Tile* pTile);
+
+  /**
+   * @brief Compresses the model of a tile and keeps it, unless the tile was
+   * taken or removed since {@link beginHibernating}.
+   *
+   * @param pTile The tile.
+   * @param ticket The ticket returned by {@link beginHibernating}.
+   * @param model The post-processed model of the tile.
+   * @param rasterOverlayDetails The raster overlay details of the tile.
+   */
+  void finishHibernating(
+      const Tile* pTile,
+      uint64_t ticket,
+      const CesiumGltf::Model& model,
+      std::optional<CesiumRasterOverlays::RasterOverlayDetails>&&
+          rasterOverlayDetails);
+
+  /**
+   * @brief Removes and returns the hibernated content of a tile.
+   *
+   * @param pTile The tile.
+   * @return The content, or nullptr if the tile has none, or hasn't finished
+   * hibernating.
+   */
+  std::shared_ptr<const HibernatedTileContent> take(const Tile* pTile);
+
+  /**
+   * @brief Forgets a tile, for example because its content is stale or it is
+   * about to be destroyed.
+   */
+  void remove(const Tile* pTile) noexcept;
+
+  /**
+   * @brief Decompresses the model of hibernated content.
+   *
+   * @return The model, or std::nullopt if it can't be read.
+   */
+  std::optional<CesiumGltf::Model>
+  decompress(const HibernatedTileContent& content) const;
+
+  /**
+   * @brief Gets the number of tiles in the cache.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Gets the number of compressed bytes in the cache.
+   */
+  int64_t getTotalBytes() const;
+
+private:
+  void trim();
+
+  using Entry =
+      std::pair<const Tile*, std::shared_ptr<const HibernatedTileContent>>;
+
+  int64_t _maximumBytes;
+  int64_t _totalBytes;
+  uint64_t _nextTicket;
+  // Only used to write and read models, so it has no database.
+  Cesium3DTilesContent::DecodedModelCache _modelFormat;
+  mutable std::mutex _mutex;
+  // The tiles that were unloaded longest ago come first.
+  std::list<Entry> _entries;
+  std::unordered_map<const Tile*, std::list<Entry>::iterator> _entriesByTile;
+  std::unordered_map<const Tile*, uint64_t> _ticketsByTile;
+};
+} // namespace Cesium3DTilesSelection
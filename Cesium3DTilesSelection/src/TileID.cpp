@@ -10,7 +10,7 @@ TileIdUtilities::createTileIdString(const TileID& tileId) {
 
   struct Operation {
 
-    std::string operator()(const std::string& url) { return url; }
+    std::string operator()(const TileUrl& url) { return url.toString(); }
 
     std::string
     operator()(const CesiumGeometry::QuadtreeTileID& quadtreeTileId) {
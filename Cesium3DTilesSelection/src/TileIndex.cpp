@@ -0,0 +1,122 @@
+#include "TileIndex.h"
+
+#include <Cesium3DTilesSelection/Tile.h>
+
+#include <cstdint>
+#include <variant>
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+// The finalizer of SplitMix64, which spreads the bits of the packed
+// coordinates over the whole hash.
+uint64_t mix(uint64_t value) noexcept {
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+template <typename Map, typename Key>
+void removeFrom(Map& map, const Key& key, const Tile& tile) noexcept {
+  auto [begin, end] = map.equal_range(key);
+  for (auto it = begin; it != end; ++it) {
+    if (it->second == &tile) {
+      map.erase(it);
+      return;
+    }
+  }
+}
+
+template <typename Map, typename Key>
+Tile* findIn(const Map& map, const Key& key) noexcept {
+  auto it = map.find(key);
+  return it == map.end() ? nullptr : it->second;
+}
+} // namespace
+
+size_t TileIndex::Hash::operator()(
+    const CesiumGeometry::QuadtreeTileID& tileID) const noexcept {
+  return static_cast<size_t>(mix(
+      (uint64_t(tileID.x) << 32 | uint64_t(tileID.y)) ^
+      (uint64_t(tileID.level) * 0x9e3779b97f4a7c15ULL)));
+}
+
+size_t TileIndex::Hash::operator()(
+    const CesiumGeometry::OctreeTileID& tileID) const noexcept {
+  return static_cast<size_t>(mix(
+      (uint64_t(tileID.x) << 32 | uint64_t(tileID.y)) ^
+      mix(uint64_t(tileID.z) << 32 | uint64_t(tileID.level))));
+}
+
+void TileIndex::addSubtree(Tile& tile) {
+  const TileID& tileID = tile.getTileID();
+  if (const TileUrl* pUrl = std::get_if<TileUrl>(&tileID)) {
+    if (!pUrl->empty()) {
+      this->_byUrl.emplace(*pUrl, &tile);
+    }
+  } else if (
+      const CesiumGeometry::QuadtreeTileID* pQuadtreeID =
+          std::get_if<CesiumGeometry::QuadtreeTileID>(&tileID)) {
+    this->_byQuadtreeID.emplace(*pQuadtreeID, &tile);
+  } else if (
+      const CesiumGeometry::OctreeTileID* pOctreeID =
+          std::get_if<CesiumGeometry::OctreeTileID>(&tileID)) {
+    this->_byOctreeID.emplace(*pOctreeID, &tile);
+  } else if (
+      const CesiumGeometry::UpsampledQuadtreeNode* pUpsampledNode =
+          std::get_if<CesiumGeometry::UpsampledQuadtreeNode>(&tileID)) {
+    this->_byUpsampledID.emplace(pUpsampledNode->tileID, &tile);
+  }
+
+  for (Tile& child : tile.getChildren()) {
+    this->addSubtree(child);
+  }
+}
+
+void TileIndex::remove(const Tile& tile) noexcept {
+  const TileID& tileID = tile.getTileID();
+  if (const TileUrl* pUrl = std::get_if<TileUrl>(&tileID)) {
+    removeFrom(this->_byUrl, *pUrl, tile);
+  } else if (
+      const CesiumGeometry::QuadtreeTileID* pQuadtreeID =
+          std::get_if<CesiumGeometry::QuadtreeTileID>(&tileID)) {
+    removeFrom(this->_byQuadtreeID, *pQuadtreeID, tile);
+  } else if (
+      const CesiumGeometry::OctreeTileID* pOctreeID =
+          std::get_if<CesiumGeometry::OctreeTileID>(&tileID)) {
+    removeFrom(this->_byOctreeID, *pOctreeID, tile);
+  } else if (
+      const CesiumGeometry::UpsampledQuadtreeNode* pUpsampledNode =
+          std::get_if<CesiumGeometry::UpsampledQuadtreeNode>(&tileID)) {
+    removeFrom(this->_byUpsampledID, pUpsampledNode->tileID, tile);
+  }
+}
+
+Tile* TileIndex::find(const TileID& tileID) const noexcept {
+  if (const TileUrl* pUrl = std::get_if<TileUrl>(&tileID)) {
+    return pUrl->empty() ? nullptr : findIn(this->_byUrl, *pUrl);
+  }
+  if (const CesiumGeometry::QuadtreeTileID* pQuadtreeID =
+          std::get_if<CesiumGeometry::QuadtreeTileID>(&tileID)) {
+    return findIn(this->_byQuadtreeID, *pQuadtreeID);
+  }
+  if (const CesiumGeometry::OctreeTileID* pOctreeID =
+          std::get_if<CesiumGeometry::OctreeTileID>(&tileID)) {
+    return findIn(this->_byOctreeID, *pOctreeID);
+  }
+  if (const CesiumGeometry::UpsampledQuadtreeNode* pUpsampledNode =
+          std::get_if<CesiumGeometry::UpsampledQuadtreeNode>(&tileID)) {
+    return findIn(this->_byUpsampledID, pUpsampledNode->tileID);
+  }
+  return nullptr;
+}
+
+size_t TileIndex::size() const noexcept {
+  return this->_byUrl.size() + this->_byQuadtreeID.size() +
+         this->_byOctreeID.size() + this->_byUpsampledID.size();
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/TileID.h>
+
+#include <cstddef>
+#include <unordered_map>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+
+/**
+ * @brief An index of the tiles of a tileset by their {@link TileID}.
+ *
+ * The index holds pointers to the tiles, so a tile must be removed from it
+ * before it is destroyed or moved. The tiles of a tileset stay in place while
+ * they are part of the tile hierarchy, so the {@link TilesetContentManager}
+ * adds the tiles as their parents' children are created and the
+ * {@link Tileset} removes them before discarding them.
+ *
+ * Tiles without content have an empty URL ID and are not indexed. Several
+ * tiles may have the same ID, such as the implicit tiles of two external
+ * tilesets, in which case any one of them is found.
+ *
+ * This class is not thread-safe. Tiles are only created and discarded in the
+ * main thread.
+ */
+class TileIndex {
+public:
+  /**
+   * @brief Adds the given tile and all of its descendants to the index.
+   */
+  void addSubtree(Tile& tile);
+
+  /**
+   * @brief Removes just the given tile from the index, but not its
+   * descendants.
+   */
+  void remove(const Tile& tile) noexcept;
+
+  /**
+   * @brief Finds a tile with the given ID.
+   *
+   * @return The tile, or nullptr if no tile in the index has this ID.
+   */
+  Tile* find(const TileID& tileID) const noexcept;
+
+  /**
+   * @brief Gets the number of tiles in the index.
+   */
+  size_t size() const noexcept;
+
+private:
+  // Hashes the implicit tile IDs by mixing all of their coordinates, because
+  // the tiles near each other have IDs that only differ in the low bits.
+  struct Hash {
+    size_t operator()(const CesiumGeometry::QuadtreeTileID& tileID) const
+        noexcept;
+    size_t
+    operator()(const CesiumGeometry::OctreeTileID& tileID) const noexcept;
+  };
+
+  // The keys are copies of the URL IDs, which share their characters with
+  // the ID stored in each tile.
+  std::unordered_multimap<TileUrl, Tile*> _byUrl;
+  std::unordered_multimap<CesiumGeometry::QuadtreeTileID, Tile*, Hash>
+      _byQuadtreeID;
+  std::unordered_multimap<CesiumGeometry::OctreeTileID, Tile*, Hash>
+      _byOctreeID;
+  std::unordered_multimap<CesiumGeometry::QuadtreeTileID, Tile*, Hash>
+      _byUpsampledID;
+};
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,77 @@
+#include <Cesium3DTilesSelection/TileLoadMetrics.h>
+
+#include <cmath>
+#include <limits>
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+// The upper bound of the first bucket, in microseconds.
+constexpr int64_t firstBucketUpperBound = 16;
+} // namespace
+
+/*static*/ size_t
+TileLoadLatencyHistogram::getBucket(int64_t microseconds) noexcept {
+  size_t bucket = 0;
+  int64_t upperBound = firstBucketUpperBound;
+  while (bucket < BucketCount - 1 && microseconds >= upperBound) {
+    ++bucket;
+    upperBound *= 2;
+  }
+  return bucket;
+}
+
+/*static*/ double TileLoadLatencyHistogram::getBucketUpperBoundMilliseconds(
+    size_t bucket) noexcept {
+  if (bucket >= BucketCount - 1) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return std::ldexp(double(firstBucketUpperBound), int(bucket)) / 1000.0;
+}
+
+double TileLoadLatencyHistogram::computeMeanMilliseconds() const noexcept {
+  if (this->count == 0) {
+    return 0.0;
+  }
+  return double(this->totalMicroseconds) / double(this->count) / 1000.0;
+}
+
+double TileLoadLatencyHistogram::computePercentileMilliseconds(
+    double fraction) const noexcept {
+  if (this->count == 0) {
+    return 0.0;
+  }
+
+  const double rank = fraction * double(this->count);
+  uint64_t countBelow = 0;
+  for (size_t i = 0; i < BucketCount - 1; ++i) {
+    countBelow += this->buckets[i];
+    if (double(countBelow) >= rank) {
+      return getBucketUpperBoundMilliseconds(i);
+    }
+  }
+
+  // The percentile is in the last bucket, which has no upper bound, so use
+  // its lower bound instead.
+  return getBucketUpperBoundMilliseconds(BucketCount - 2);
+}
+
+TileLoadMetrics TileLoadMetrics::computeDifference(
+    const TileLoadMetrics& earlier) const noexcept {
+  TileLoadMetrics result;
+  for (size_t stage = 0; stage < StageCount; ++stage) {
+    const TileLoadLatencyHistogram& current = this->latencies[stage];
+    const TileLoadLatencyHistogram& previous = earlier.latencies[stage];
+    TileLoadLatencyHistogram& difference = result.latencies[stage];
+    for (size_t i = 0; i < TileLoadLatencyHistogram::BucketCount; ++i) {
+      difference.buckets[i] = current.buckets[i] - previous.buckets[i];
+    }
+    difference.count = current.count - previous.count;
+    difference.totalMicroseconds =
+        current.totalMicroseconds - previous.totalMicroseconds;
+  }
+  result.bytesReceived = this->bytesReceived - earlier.bytesReceived;
+  return result;
+}
+
+} // namespace Cesium3DTilesSelection
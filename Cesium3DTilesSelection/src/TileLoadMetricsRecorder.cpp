@@ -0,0 +1,50 @@
+#include "TileLoadMetricsRecorder.h"
+
+#include <algorithm>
+
+namespace Cesium3DTilesSelection {
+
+void TileLoadMetricsRecorder::recordLatency(
+    TileLoadStage stage,
+    std::chrono::steady_clock::duration latency) noexcept {
+  const int64_t microseconds = std::max(
+      int64_t(0),
+      int64_t(std::chrono::duration_cast<std::chrono::microseconds>(latency)
+                  .count()));
+
+  Histogram& histogram = this->_latencies[size_t(stage)];
+  histogram.buckets[TileLoadLatencyHistogram::getBucket(microseconds)]
+      .fetch_add(1, std::memory_order_relaxed);
+  histogram.count.fetch_add(1, std::memory_order_relaxed);
+  histogram.totalMicroseconds.fetch_add(
+      uint64_t(microseconds),
+      std::memory_order_relaxed);
+}
+
+void TileLoadMetricsRecorder::recordLatencySince(
+    TileLoadStage stage,
+    std::chrono::steady_clock::time_point start) noexcept {
+  this->recordLatency(stage, std::chrono::steady_clock::now() - start);
+}
+
+void TileLoadMetricsRecorder::recordBytesReceived(size_t bytes) noexcept {
+  this->_bytesReceived.fetch_add(uint64_t(bytes), std::memory_order_relaxed);
+}
+
+TileLoadMetrics TileLoadMetricsRecorder::getMetrics() const noexcept {
+  TileLoadMetrics result;
+  for (size_t stage = 0; stage < TileLoadMetrics::StageCount; ++stage) {
+    const Histogram& histogram = this->_latencies[stage];
+    TileLoadLatencyHistogram& copy = result.latencies[stage];
+    for (size_t i = 0; i < TileLoadLatencyHistogram::BucketCount; ++i) {
+      copy.buckets[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+    }
+    copy.count = histogram.count.load(std::memory_order_relaxed);
+    copy.totalMicroseconds =
+        histogram.totalMicroseconds.load(std::memory_order_relaxed);
+  }
+  result.bytesReceived = this->_bytesReceived.load(std::memory_order_relaxed);
+  return result;
+}
+
+} // namespace Cesium3DTilesSelection
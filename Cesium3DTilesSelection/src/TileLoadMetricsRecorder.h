@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/TileLoadMetrics.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium3DTilesSelection {
+/**
+ * @brief Records the {@link TileLoadMetrics} of a tileset.
+ *
+ * This class is thread-safe. Recording only updates a few atomic counters, so
+ * it may be done from any stage of a load without taking a lock.
+ */
+class TileLoadMetricsRecorder {
+public:
+  /**
+   * @brief Records the time taken by a stage of a load.
+   */
+  void recordLatency(
+      TileLoadStage stage,
+      std::chrono::steady_clock::duration latency) noexcept;
+
+  /**
+   * @brief Records the time taken by a stage of a load that began at the given
+   * time and ends now.
+   */
+  void recordLatencySince(
+      TileLoadStage stage,
+      std::chrono::steady_clock::time_point start) noexcept;
+
+  /**
+   * @brief Records the number of bytes received from a request.
+   */
+  void recordBytesReceived(size_t bytes) noexcept;
+
+  /**
+   * @brief Gets a copy of the measurements made so far.
+   */
+  TileLoadMetrics getMetrics() const noexcept;
+
+private:
+  struct Histogram {
+    std::array<std::atomic<uint64_t>, TileLoadLatencyHistogram::BucketCount>
+        buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> totalMicroseconds{0};
+  };
+
+  std::array<Histogram, TileLoadMetrics::StageCount> _latencies{};
+  std::atomic<uint64_t> _bytesReceived{0};
+};
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,448 @@
+#include <Cesium3DTilesSelection/TileTriangleIndex.h>
+#include <CesiumGeometry/IntersectionTests.h>
+#include <CesiumGeometry/Ray.h>
+#include <CesiumGltf/AccessorUtility.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+#include <CesiumGltfContent/SkirtMeshMetadata.h>
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+#include <variant>
+
+using namespace CesiumGeometry;
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+// The fewest triangles that are considered for a split, and the most that a
+// leaf node is allowed to hold even when splitting it doesn't pay off.
+constexpr uint32_t minimumSplitTriangles = 4;
+constexpr uint32_t maximumLeafTriangles = 16;
+
+// The number of buckets that the centroids are sorted into along each axis to
+// evaluate the surface area heuristic.
+constexpr uint32_t binCount = 12;
+
+// The cost of visiting a node relative to that of testing a triangle.
+constexpr double traversalCost = 1.0;
+
+// Deeper than this the nodes are split at the median instead, which keeps the
+// whole tree within the traversal stack even when the surface area heuristic
+// produces a very unbalanced tree.
+constexpr uint32_t maximumHeuristicDepth = 64;
+constexpr size_t stackCapacity = 128;
+
+struct Bounds {
+  glm::dvec3 minimum{std::numeric_limits<double>::max()};
+  glm::dvec3 maximum{std::numeric_limits<double>::lowest()};
+
+  void expand(const glm::dvec3& point) noexcept {
+    this->minimum = glm::min(this->minimum, point);
+    this->maximum = glm::max(this->maximum, point);
+  }
+
+  void expand(const Bounds& bounds) noexcept {
+    this->minimum = glm::min(this->minimum, bounds.minimum);
+    this->maximum = glm::max(this->maximum, bounds.maximum);
+  }
+
+  double computeHalfArea() const noexcept {
+    if (this->minimum.x > this->maximum.x) {
+      return 0.0;
+    }
+    const glm::dvec3 size = this->maximum - this->minimum;
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+  }
+};
+
+struct Bin {
+  Bounds bounds;
+  uint32_t count = 0;
+};
+
+int64_t getFaceCount(int32_t mode, int64_t count) {
+  switch (mode) {
+  case MeshPrimitive::Mode::TRIANGLES:
+    return count / 3;
+  case MeshPrimitive::Mode::TRIANGLE_STRIP:
+  case MeshPrimitive::Mode::TRIANGLE_FAN:
+    return std::max<int64_t>(count - 2, 0);
+  default:
+    return 0;
+  }
+}
+
+std::optional<double> rayEntersBox(
+    const glm::dvec3& origin,
+    const glm::dvec3& inverseDirection,
+    const glm::dvec3& minimum,
+    const glm::dvec3& maximum,
+    double tMaximum) noexcept {
+  double tMin = 0.0;
+  double tMax = tMaximum;
+  for (glm::length_t i = 0; i < 3; ++i) {
+    double t0 = (minimum[i] - origin[i]) * inverseDirection[i];
+    double t1 = (maximum[i] - origin[i]) * inverseDirection[i];
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+
+    // These are NaN when the ray is parallel to the slab and its origin is on
+    // one of the sides, which leaves the bounds unchanged.
+    if (t0 > tMin) {
+      tMin = t0;
+    }
+    if (t1 < tMax) {
+      tMax = t1;
+    }
+    if (tMin > tMax) {
+      return std::nullopt;
+    }
+  }
+  return tMin;
+}
+} // namespace
+
+TileTriangleIndex::TileTriangleIndex(
+    const Model& model,
+    const glm::dmat4& transform)
+    : _triangles(), _nodes() {
+  glm::dmat4 rootTransform = GltfUtilities::applyRtcCenter(model, transform);
+  rootTransform = GltfUtilities::applyGltfUpAxisTransform(model, rootTransform);
+
+  // Reused by all primitives.
+  std::vector<glm::dvec3> positions;
+
+  model.forEachPrimitiveInScene(
+      -1,
+      [this, &rootTransform, &positions](
+          const Model& gltf,
+          const CesiumGltf::Node& /*node*/,
+          const Mesh& /*mesh*/,
+          const MeshPrimitive& primitive,
+          const glm::dmat4& nodeTransform) {
+        const QuantizedPositionAccessorType positionView =
+            getQuantizedPositionAccessorView(gltf, primitive);
+        if (std::visit(StatusFromAccessor{}, positionView) !=
+            AccessorViewStatus::Valid) {
+          return;
+        }
+
+        const IndexAccessorType indexView =
+            getIndexAccessorView(gltf, primitive);
+        const bool hasIndices =
+            !std::holds_alternative<std::monostate>(indexView);
+        if (hasIndices && std::visit(StatusFromAccessor{}, indexView) !=
+                              AccessorViewStatus::Valid) {
+          return;
+        }
+
+        const AccessorDequantization dequantization =
+            getAccessorDequantization(gltf.accessors[static_cast<size_t>(
+                primitive.attributes.at("POSITION"))]);
+        const glm::dmat4 fullTransform = rootTransform * nodeTransform;
+
+        positions.clear();
+        std::visit(
+            [&](const auto& view) {
+              for (int64_t i = 0; i < view.size(); ++i) {
+                positions.emplace_back(glm::dvec3(
+                    fullTransform *
+                    glm::dvec4(dequantization.apply(view[i]), 1.0)));
+              }
+            },
+            positionView);
+
+        const int64_t vertexCount = static_cast<int64_t>(positions.size());
+        int64_t faceBegin = 0;
+        int64_t faceEnd = getFaceCount(
+            primitive.mode,
+            hasIndices ? std::visit(CountFromAccessor{}, indexView)
+                       : vertexCount);
+
+        // Rays that pass near the edges of the tile would hit the skirts.
+        const std::optional<SkirtMeshMetadata> skirtMeshMetadata =
+            SkirtMeshMetadata::parseFromGltfExtras(primitive.extras);
+        if (skirtMeshMetadata &&
+            primitive.mode == MeshPrimitive::Mode::TRIANGLES) {
+          faceBegin = int64_t(skirtMeshMetadata->noSkirtIndicesBegin) / 3;
+          faceEnd = std::min(
+              faceEnd,
+              (int64_t(skirtMeshMetadata->noSkirtIndicesBegin) +
+               int64_t(skirtMeshMetadata->noSkirtIndicesCount)) /
+                  3);
+        }
+
+        for (int64_t face = faceBegin; face < faceEnd; ++face) {
+          const std::array<int64_t, 3> indices = std::visit(
+              IndicesForFaceFromAccessor{face, vertexCount, primitive.mode},
+              indexView);
+          if (std::any_of(
+                  indices.begin(),
+                  indices.end(),
+                  [vertexCount](int64_t index) {
+                    return index < 0 || index >= vertexCount;
+                  })) {
+            continue;
+          }
+
+          this->_triangles.push_back(
+              {positions[size_t(indices[0])],
+               positions[size_t(indices[1])],
+               positions[size_t(indices[2])]});
+        }
+      });
+
+  if (!this->_triangles.empty()) {
+    this->_nodes.emplace_back();
+    this->build(0, 0, static_cast<uint32_t>(this->_triangles.size()), 0);
+  }
+}
+
+std::optional<double>
+TileTriangleIndex::intersectRay(const Ray& ray) const noexcept {
+  if (this->_nodes.empty()) {
+    return std::nullopt;
+  }
+
+  const glm::dvec3& origin = ray.getOrigin();
+  const glm::dvec3 inverseDirection = glm::dvec3(1.0) / ray.getDirection();
+
+  std::optional<double> closest;
+  double tMaximum = std::numeric_limits<double>::max();
+
+  const Node& root = this->_nodes[0];
+  const std::optional<double> rootEntry = rayEntersBox(
+      origin,
+      inverseDirection,
+      root.minimum,
+      root.maximum,
+      tMaximum);
+  if (!rootEntry) {
+    return std::nullopt;
+  }
+
+  // The nodes to visit along with the distances at which the ray enters them.
+  // Each level adds at most one node to the stack.
+  std::array<std::pair<uint32_t, double>, stackCapacity> stack;
+  size_t stackSize = 0;
+  stack[stackSize++] = {0, *rootEntry};
+
+  while (stackSize > 0) {
+    const auto [nodeIndex, entry] = stack[--stackSize];
+    if (entry > tMaximum) {
+      continue;
+    }
+
+    const Node& node = this->_nodes[nodeIndex];
+    if (node.count == 0) {
+      const Node& first = this->_nodes[node.first];
+      const Node& second = this->_nodes[node.first + 1];
+      std::optional<double> firstEntry = rayEntersBox(
+          origin,
+          inverseDirection,
+          first.minimum,
+          first.maximum,
+          tMaximum);
+      std::optional<double> secondEntry = rayEntersBox(
+          origin,
+          inverseDirection,
+          second.minimum,
+          second.maximum,
+          tMaximum);
+
+      // Visit the nearer child first, so that its hits can cull the other.
+      uint32_t nearIndex = node.first;
+      uint32_t farIndex = node.first + 1;
+      if (secondEntry && (!firstEntry || *secondEntry < *firstEntry)) {
+        std::swap(nearIndex, farIndex);
+        std::swap(firstEntry, secondEntry);
+      }
+      if (secondEntry) {
+        stack[stackSize++] = {farIndex, *secondEntry};
+      }
+      if (firstEntry) {
+        stack[stackSize++] = {nearIndex, *firstEntry};
+      }
+      continue;
+    }
+
+    for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+      const Triangle& triangle = this->_triangles[i];
+      const std::optional<double> t = IntersectionTests::rayTriangleParametric(
+          ray,
+          triangle[0],
+          triangle[1],
+          triangle[2]);
+      if (t && *t < tMaximum) {
+        closest = t;
+        tMaximum = *t;
+      }
+    }
+  }
+
+  return closest;
+}
+
+size_t TileTriangleIndex::getTriangleCount() const noexcept {
+  return this->_triangles.size();
+}
+
+size_t TileTriangleIndex::getNodeCount() const noexcept {
+  return this->_nodes.size();
+}
+
+void TileTriangleIndex::build(
+    uint32_t nodeIndex,
+    uint32_t begin,
+    uint32_t end,
+    uint32_t depth) {
+  Bounds bounds;
+  // The sums of the vertices, which are ordered like the centroids.
+  Bounds sumBounds;
+  for (uint32_t i = begin; i < end; ++i) {
+    const Triangle& triangle = this->_triangles[i];
+    for (const glm::dvec3& vertex : triangle) {
+      bounds.expand(vertex);
+    }
+    sumBounds.expand(triangle[0] + triangle[1] + triangle[2]);
+  }
+
+  this->_nodes[nodeIndex].minimum = bounds.minimum;
+  this->_nodes[nodeIndex].maximum = bounds.maximum;
+
+  const uint32_t count = end - begin;
+  const glm::dvec3 extent = sumBounds.maximum - sumBounds.minimum;
+  const bool isDegenerate = extent.x <= 0.0 && extent.y <= 0.0 &&
+                            extent.z <= 0.0;
+  if (count <= minimumSplitTriangles ||
+      (isDegenerate && count <= maximumLeafTriangles)) {
+    this->_nodes[nodeIndex].first = begin;
+    this->_nodes[nodeIndex].count = count;
+    return;
+  }
+
+  uint32_t middle = begin;
+  if (depth < maximumHeuristicDepth && !isDegenerate) {
+    // Find the bucket boundary with the lowest cost according to the surface
+    // area heuristic, among all three axes.
+    double bestCost = std::numeric_limits<double>::max();
+    glm::length_t bestAxis = 0;
+    uint32_t bestSplit = 0;
+
+    for (glm::length_t axis = 0; axis < 3; ++axis) {
+      if (extent[axis] <= 0.0) {
+        continue;
+      }
+
+      std::array<Bin, binCount> bins{};
+      const double scale = double(binCount) / extent[axis];
+      for (uint32_t i = begin; i < end; ++i) {
+        const Triangle& triangle = this->_triangles[i];
+        const double sum = triangle[0][axis] + triangle[1][axis] +
+                           triangle[2][axis];
+        const uint32_t bin = std::min(
+            binCount - 1,
+            static_cast<uint32_t>((sum - sumBounds.minimum[axis]) * scale));
+        ++bins[bin].count;
+        for (const glm::dvec3& vertex : triangle) {
+          bins[bin].bounds.expand(vertex);
+        }
+      }
+
+      // The cost of the triangles to the right of each boundary.
+      std::array<double, binCount> rightCosts{};
+      Bounds right;
+      uint32_t rightCount = 0;
+      for (uint32_t split = binCount - 1; split > 0; --split) {
+        right.expand(bins[split].bounds);
+        rightCount += bins[split].count;
+        rightCosts[split] = right.computeHalfArea() * double(rightCount);
+      }
+
+      Bounds left;
+      uint32_t leftCount = 0;
+      for (uint32_t split = 1; split < binCount; ++split) {
+        left.expand(bins[split - 1].bounds);
+        leftCount += bins[split - 1].count;
+        const double cost =
+            left.computeHalfArea() * double(leftCount) + rightCosts[split];
+        if (leftCount > 0 && leftCount < count && cost < bestCost) {
+          bestCost = cost;
+          bestAxis = axis;
+          bestSplit = split;
+        }
+      }
+    }
+
+    // Keep the triangles in a leaf when they're cheaper to test than to split.
+    const double leafCost = bounds.computeHalfArea() * double(count);
+    const double splitCost =
+        traversalCost * bounds.computeHalfArea() + bestCost;
+    if (bestSplit > 0 && splitCost >= leafCost &&
+        count <= maximumLeafTriangles) {
+      this->_nodes[nodeIndex].first = begin;
+      this->_nodes[nodeIndex].count = count;
+      return;
+    }
+
+    if (bestSplit > 0) {
+      const double scale = double(binCount) / extent[bestAxis];
+      const double minimum = sumBounds.minimum[bestAxis];
+      middle = static_cast<uint32_t>(
+          std::partition(
+              this->_triangles.begin() + begin,
+              this->_triangles.begin() + end,
+              [=](const Triangle& triangle) {
+                const double sum = triangle[0][bestAxis] +
+                                   triangle[1][bestAxis] +
+                                   triangle[2][bestAxis];
+                const uint32_t bin = std::min(
+                    binCount - 1,
+                    static_cast<uint32_t>((sum - minimum) * scale));
+                return bin < bestSplit;
+              }) -
+          this->_triangles.begin());
+    }
+  }
+
+  if (middle == begin) {
+    // Split at the median centroid along the axis in which the centroids are
+    // the most spread out.
+    glm::length_t axis = 0;
+    if (extent.y > extent[axis]) {
+      axis = 1;
+    }
+    if (extent.z > extent[axis]) {
+      axis = 2;
+    }
+
+    middle = begin + count / 2;
+    std::nth_element(
+        this->_triangles.begin() + begin,
+        this->_triangles.begin() + middle,
+        this->_triangles.begin() + end,
+        [axis](const Triangle& a, const Triangle& b) {
+          return a[0][axis] + a[1][axis] + a[2][axis] <
+                 b[0][axis] + b[1][axis] + b[2][axis];
+        });
+  }
+
+  const uint32_t firstChild = static_cast<uint32_t>(this->_nodes.size());
+  this->_nodes.emplace_back();
+  this->_nodes.emplace_back();
+  this->_nodes[nodeIndex].first = firstChild;
+  this->_nodes[nodeIndex].count = 0;
+
+  this->build(firstChild, begin, middle, depth + 1);
+  this->build(firstChild + 1, middle, end, depth + 1);
+}
+
+} // namespace Cesium3DTilesSelection
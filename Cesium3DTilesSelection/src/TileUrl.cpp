@@ -0,0 +1,242 @@
+#include <Cesium3DTilesSelection/TileUrl.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <utility>
+
+namespace Cesium3DTilesSelection {
+
+struct TileUrl::Segment {
+  mutable std::atomic<int32_t> referenceCount;
+  uint32_t size;
+};
+
+namespace {
+// Splits a URL into the path up to and including its last slash, the rest of
+// the path, and the query and fragment.
+struct SplitUrl {
+  std::string_view prefix;
+  std::string_view name;
+  std::string_view query;
+};
+
+SplitUrl splitUrl(std::string_view url) {
+  const size_t queryStart = std::min(url.find_first_of("?#"), url.size());
+  const std::string_view path = url.substr(0, queryStart);
+  const size_t lastSlash = path.rfind('/');
+  const size_t nameStart = lastSlash == std::string_view::npos ? 0
+                                                              : lastSlash + 1;
+  return SplitUrl{
+      path.substr(0, nameStart),
+      path.substr(nameStart),
+      url.substr(queryStart)};
+}
+} // namespace
+
+/*static*/ const TileUrl::Segment*
+TileUrl::createSegment(std::string_view text) {
+  if (text.empty()) {
+    return nullptr;
+  }
+
+  void* pMemory = ::operator new(sizeof(Segment) + text.size());
+  Segment* pSegment = new (pMemory) Segment();
+  pSegment->referenceCount.store(1, std::memory_order_relaxed);
+  pSegment->size = static_cast<uint32_t>(text.size());
+  std::memcpy(
+      reinterpret_cast<char*>(pSegment + 1),
+      text.data(),
+      text.size());
+  return pSegment;
+}
+
+/*static*/ void TileUrl::addReference(const Segment* pSegment) noexcept {
+  if (pSegment) {
+    pSegment->referenceCount.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+/*static*/ void TileUrl::releaseReference(const Segment* pSegment) noexcept {
+  if (pSegment &&
+      pSegment->referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    pSegment->~Segment();
+    ::operator delete(const_cast<Segment*>(pSegment));
+  }
+}
+
+/*static*/ std::string_view
+TileUrl::getText(const Segment* pSegment) noexcept {
+  if (!pSegment) {
+    return std::string_view();
+  }
+  return std::string_view(
+      reinterpret_cast<const char*>(pSegment + 1),
+      pSegment->size);
+}
+
+TileUrl::TileUrl(std::string_view url)
+    : _pPrefix(nullptr), _pName(createSegment(url)), _pQuery(nullptr) {}
+
+TileUrl::TileUrl(
+    const Segment* pPrefix,
+    const Segment* pName,
+    const Segment* pQuery) noexcept
+    : _pPrefix(pPrefix), _pName(pName), _pQuery(pQuery) {}
+
+TileUrl::TileUrl(const TileUrl& rhs) noexcept
+    : _pPrefix(rhs._pPrefix), _pName(rhs._pName), _pQuery(rhs._pQuery) {
+  addReference(this->_pPrefix);
+  addReference(this->_pName);
+  addReference(this->_pQuery);
+}
+
+TileUrl::TileUrl(TileUrl&& rhs) noexcept
+    : _pPrefix(rhs._pPrefix), _pName(rhs._pName), _pQuery(rhs._pQuery) {
+  rhs._pPrefix = nullptr;
+  rhs._pName = nullptr;
+  rhs._pQuery = nullptr;
+}
+
+TileUrl::~TileUrl() noexcept {
+  releaseReference(this->_pPrefix);
+  releaseReference(this->_pName);
+  releaseReference(this->_pQuery);
+}
+
+TileUrl& TileUrl::operator=(const TileUrl& rhs) noexcept {
+  if (this != &rhs) {
+    *this = TileUrl(rhs);
+  }
+  return *this;
+}
+
+TileUrl& TileUrl::operator=(TileUrl&& rhs) noexcept {
+  if (this != &rhs) {
+    std::swap(this->_pPrefix, rhs._pPrefix);
+    std::swap(this->_pName, rhs._pName);
+    std::swap(this->_pQuery, rhs._pQuery);
+  }
+  return *this;
+}
+
+std::string TileUrl::toString() const {
+  std::string result;
+  result.reserve(this->size());
+  result += getText(this->_pPrefix);
+  result += getText(this->_pName);
+  result += getText(this->_pQuery);
+  return result;
+}
+
+bool TileUrl::empty() const noexcept {
+  return !this->_pPrefix && !this->_pName && !this->_pQuery;
+}
+
+size_t TileUrl::size() const noexcept {
+  return getText(this->_pPrefix).size() + getText(this->_pName).size() +
+         getText(this->_pQuery).size();
+}
+
+bool TileUrl::operator==(const TileUrl& rhs) const noexcept {
+  if (this->_pPrefix == rhs._pPrefix && this->_pName == rhs._pName &&
+      this->_pQuery == rhs._pQuery) {
+    return true;
+  }
+  if (this->size() != rhs.size()) {
+    return false;
+  }
+
+  // Compare the parts of both URLs as one string each, without putting them
+  // together.
+  const std::string_view lhsParts[] = {
+      getText(this->_pPrefix),
+      getText(this->_pName),
+      getText(this->_pQuery)};
+  const std::string_view rhsParts[] = {
+      getText(rhs._pPrefix),
+      getText(rhs._pName),
+      getText(rhs._pQuery)};
+  size_t lhsPart = 0;
+  size_t rhsPart = 0;
+  std::string_view lhsText = lhsParts[0];
+  std::string_view rhsText = rhsParts[0];
+  while (true) {
+    while (lhsText.empty() && ++lhsPart < 3) {
+      lhsText = lhsParts[lhsPart];
+    }
+    while (rhsText.empty() && ++rhsPart < 3) {
+      rhsText = rhsParts[rhsPart];
+    }
+    if (lhsText.empty() || rhsText.empty()) {
+      // The sizes are equal, so both ended.
+      return true;
+    }
+
+    const size_t length = std::min(lhsText.size(), rhsText.size());
+    if (lhsText.substr(0, length) != rhsText.substr(0, length)) {
+      return false;
+    }
+    lhsText.remove_prefix(length);
+    rhsText.remove_prefix(length);
+  }
+}
+
+TileUrlPool::~TileUrlPool() noexcept {
+  for (const auto& [text, pSegment] : this->_segments) {
+    TileUrl::releaseReference(pSegment);
+  }
+}
+
+TileUrl TileUrlPool::create(std::string_view url) {
+  const SplitUrl split = splitUrl(url);
+  TileUrl result(nullptr, TileUrl::createSegment(split.name), nullptr);
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  result._pPrefix = this->share(split.prefix);
+  result._pQuery = this->share(split.query);
+  return result;
+}
+
+size_t TileUrlPool::getSharedSegmentCount() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_segments.size();
+}
+
+const TileUrl::Segment* TileUrlPool::share(std::string_view text) {
+  if (text.empty()) {
+    return nullptr;
+  }
+
+  auto it = this->_segments.find(text);
+  if (it == this->_segments.end()) {
+    const TileUrl::Segment* pSegment = TileUrl::createSegment(text);
+    it = this->_segments.emplace(TileUrl::getText(pSegment), pSegment).first;
+  }
+
+  TileUrl::addReference(it->second);
+  return it->second;
+}
+
+} // namespace Cesium3DTilesSelection
+
+namespace std {
+size_t hash<Cesium3DTilesSelection::TileUrl>::operator()(
+    const Cesium3DTilesSelection::TileUrl& url) const noexcept {
+  using Cesium3DTilesSelection::TileUrl;
+
+  // FNV-1a over the characters of all parts, as if they were one string.
+  uint64_t value = 0xcbf29ce484222325ULL;
+  for (const TileUrl::Segment* pSegment :
+       {url._pPrefix, url._pName, url._pQuery}) {
+    for (const char c : TileUrl::getText(pSegment)) {
+      value ^= static_cast<unsigned char>(c);
+      value *= 0x100000001b3ULL;
+    }
+  }
+  return static_cast<size_t>(value);
+}
+} // namespace std
@@ -1,9 +1,11 @@
 #include "TileUtilities.h"
 
+#include <Cesium3DTilesSelection/Tile.h>
 #include <CesiumGeospatial/BoundingRegion.h>
 #include <CesiumGeospatial/BoundingRegionWithLooseFittingHeights.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
 
+#include <memory>
 #include <variant>
 
 using namespace CesiumGeospatial;
@@ -42,6 +44,71 @@ bool outsidePolygons(
       cartographicPolygons);
 }
 
+std::optional<GlobeRectangle> computePolygonsRectangle(
+    const std::vector<CartographicPolygon>& cartographicPolygons) {
+  std::optional<GlobeRectangle> result;
+  for (const CartographicPolygon& polygon : cartographicPolygons) {
+    const std::optional<GlobeRectangle>& polygonRectangle =
+        polygon.getBoundingRectangle();
+    if (!polygonRectangle) {
+      continue;
+    }
+
+    result = result ? result->computeUnion(*polygonRectangle)
+                    : *polygonRectangle;
+  }
+  return result;
+}
+
+TileExclusion evaluatePolygonsExclusion(
+    const BoundingVolume& boundingVolume,
+    const std::vector<CartographicPolygon>& cartographicPolygons,
+    const std::optional<GlobeRectangle>& polygonsRectangle,
+    bool invertSelection) noexcept {
+  const std::optional<GlobeRectangle> maybeRectangle =
+      estimateGlobeRectangle(boundingVolume);
+  if (!maybeRectangle) {
+    return TileExclusion::Included;
+  }
+
+  // A tile that doesn't overlap the bounding rectangle of the polygons is
+  // outside all of them, which is by far the most common case for tilesets that
+  // are much larger than the polygons.
+  bool isOutside = !polygonsRectangle ||
+                   !maybeRectangle->computeIntersection(*polygonsRectangle);
+  if (!isOutside) {
+    isOutside = CartographicPolygon::rectangleIsOutsidePolygons(
+        *maybeRectangle,
+        cartographicPolygons);
+  }
+  const bool isWithin = !isOutside &&
+                        CartographicPolygon::rectangleIsWithinPolygons(
+                            *maybeRectangle,
+                            cartographicPolygons);
+
+  const bool isExcludedSide = invertSelection ? isOutside : isWithin;
+  const bool isIncludedSide = invertSelection ? isWithin : isOutside;
+  if (isExcludedSide) {
+    return TileExclusion::Excluded;
+  }
+  return isIncludedSide ? TileExclusion::IncludedWithDescendants
+                        : TileExclusion::Included;
+}
+
+const TileTriangleIndex* getOrBuildTriangleIndex(Tile& tile) {
+  TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
+  if (!pRenderContent) {
+    return nullptr;
+  }
+
+  if (!pRenderContent->getTriangleIndex()) {
+    pRenderContent->setTriangleIndex(std::make_shared<const TileTriangleIndex>(
+        pRenderContent->getModel(),
+        tile.getTransform()));
+  }
+  return pRenderContent->getTriangleIndex();
+}
+
 } // namespace CesiumImpl
 
 } // namespace Cesium3DTilesSelection
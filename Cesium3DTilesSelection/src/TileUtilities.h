@@ -1,13 +1,18 @@
 #pragma once
 
 #include "Cesium3DTilesSelection/BoundingVolume.h"
+#include "Cesium3DTilesSelection/ITileExcluder.h"
+#include "Cesium3DTilesSelection/TileTriangleIndex.h"
 
 #include <CesiumGeospatial/CartographicPolygon.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
 
+#include <optional>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
+class Tile;
+
 namespace CesiumImpl {
 /**
  * @brief Returns whether the tile is completely inside a polygon.
@@ -32,5 +37,43 @@ bool outsidePolygons(
     const BoundingVolume& boundingVolume,
     const std::vector<CesiumGeospatial::CartographicPolygon>&
         cartographicPolygons) noexcept;
+
+/**
+ * @brief Returns the union of the bounding rectangles of the polygons, or
+ * std::nullopt if none of them has one.
+ */
+std::optional<CesiumGeospatial::GlobeRectangle> computePolygonsRectangle(
+    const std::vector<CesiumGeospatial::CartographicPolygon>&
+        cartographicPolygons);
+
+/**
+ * @brief Determines whether a tile is excluded by polygons that exclude their
+ * inside, or their outside if inverted.
+ *
+ * @param boundingVolume The {@link Cesium3DTilesSelection::BoundingVolume} of the tile.
+ * @param cartographicPolygons The polygons.
+ * @param polygonsRectangle The rectangle returned by
+ * {@link computePolygonsRectangle} for the polygons.
+ * @param invertSelection Whether the outside of the polygons is excluded.
+ * @return {@link TileExclusion::Excluded} if the tile is entirely on the
+ * excluded side, {@link TileExclusion::IncludedWithDescendants} if it is
+ * entirely on the other side, and otherwise {@link TileExclusion::Included}.
+ */
+TileExclusion evaluatePolygonsExclusion(
+    const BoundingVolume& boundingVolume,
+    const std::vector<CesiumGeospatial::CartographicPolygon>&
+        cartographicPolygons,
+    const std::optional<CesiumGeospatial::GlobeRectangle>& polygonsRectangle,
+    bool invertSelection) noexcept;
+
+/**
+ * @brief Returns the {@link Cesium3DTilesSelection::TileTriangleIndex} of the
+ * render content of the tile, building it first if it wasn't built when the
+ * tile was loaded.
+ *
+ * @param tile The tile.
+ * @return The index, or nullptr if the tile doesn't have render content.
+ */
+const TileTriangleIndex* getOrBuildTriangleIndex(Tile& tile);
 } // namespace CesiumImpl
 } // namespace Cesium3DTilesSelection
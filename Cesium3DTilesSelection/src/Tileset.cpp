@@ -1,16 +1,26 @@
+#include "SoftwareOcclusionBuffer.h"
 #include "TileUtilities.h"
 #include "TilesetContentManager.h"
+#include "TilesetFetchRequest.h"
+#include "TilesetHeightQuery.h"
 
+#include <Cesium3DTilesSelection/ITileEvictionPolicy.h>
 #include <Cesium3DTilesSelection/ITileExcluder.h>
 #include <Cesium3DTilesSelection/TileID.h>
 #include <Cesium3DTilesSelection/TileOcclusionRendererProxy.h>
 #include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/TilesetGroup.h>
 #include <Cesium3DTilesSelection/TilesetMetadata.h>
 #include <Cesium3DTilesSelection/spdlog-cesium.h>
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/TaskPriority.h>
+#include <CesiumGeometry/IntersectionTests.h>
 #include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumGeospatial/EllipsoidalOccluder.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
 #include <CesiumRasterOverlays/RasterOverlayTile.h>
+#include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
 #include <CesiumUtility/CreditSystem.h>
 #include <CesiumUtility/Math.h>
 #include <CesiumUtility/ScopeGuard.h>
@@ -18,11 +28,15 @@
 #include <CesiumUtility/joinToString.h>
 
 #include <glm/common.hpp>
+#include <glm/trigonometric.hpp>
 #include <rapidjson/document.h>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <limits>
+#include <mutex>
 #include <unordered_set>
 
 using namespace CesiumAsync;
@@ -33,6 +47,70 @@ using namespace CesiumUtility;
 
 namespace Cesium3DTilesSelection {
 
+namespace {
+// Adds the time until the end of its scope to a time in milliseconds, if
+// TilesetOptions::measureViewUpdateTimes is set.
+class ScopedPhaseTimer {
+public:
+  ScopedPhaseTimer(const TilesetOptions& options, double& milliseconds)
+      : _pMilliseconds(
+            options.measureViewUpdateTimes ? &milliseconds : nullptr),
+        _start() {
+    if (this->_pMilliseconds) {
+      this->_start = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~ScopedPhaseTimer() noexcept {
+    if (this->_pMilliseconds) {
+      const std::chrono::duration<double, std::milli> duration =
+          std::chrono::steady_clock::now() - this->_start;
+      *this->_pMilliseconds += duration.count();
+    }
+  }
+
+  ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+  ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+  double* _pMilliseconds;
+  std::chrono::steady_clock::time_point _start;
+};
+
+// Takes the tasks of a load queue from the most important one on. Only the
+// tasks that are taken are put in order: the queue is made into a heap in
+// linear time, and each task is popped from it in logarithmic time. Usually
+// only a few of the thousands of queued tiles are loaded in a frame, so this
+// is much cheaper than sorting the whole queue. The queue keeps all of its
+// tasks, in no particular order.
+template <typename Task> class PriorityOrderCursor {
+public:
+  explicit PriorityOrderCursor(std::vector<Task>& queue)
+      : _queue(queue), _heapEnd(queue.end()) {
+    std::make_heap(queue.begin(), queue.end(), isLessImportant);
+  }
+
+  // Returns the most important task that wasn't taken yet, or nullptr if all
+  // of them were. The task stays where it is while the cursor is used.
+  Task* next() {
+    if (this->_heapEnd == this->_queue.begin()) {
+      return nullptr;
+    }
+    std::pop_heap(this->_queue.begin(), this->_heapEnd, isLessImportant);
+    --this->_heapEnd;
+    return &*this->_heapEnd;
+  }
+
+private:
+  static bool isLessImportant(const Task& lhs, const Task& rhs) noexcept {
+    return rhs < lhs;
+  }
+
+  std::vector<Task>& _queue;
+  typename std::vector<Task>::iterator _heapEnd;
+};
+} // namespace
+
 Tileset::Tileset(
     const TilesetExternals& externals,
     std::unique_ptr<TilesetContentLoader>&& pCustomLoader,
@@ -42,8 +120,16 @@ Tileset::Tileset(
       _asyncSystem(externals.asyncSystem),
       _options(options),
       _previousFrameNumber(0),
+      _effectiveMaximumScreenSpaceError(options.maximumScreenSpaceError),
+      _viewEpoch(0),
+      _viewEpochFrustums(),
+      _viewEpochFogDensities(),
+      _viewEpochRenderTilesUnderCamera(false),
+      _viewEpochFoveatedScreenSpaceError(),
+      _excluderEpoch(0),
       _distances(),
       _childOcclusionProxies(),
+      _pGroup(nullptr),
       _pTilesetContentManager{new TilesetContentManager(
           _externals,
           _options,
@@ -60,8 +146,16 @@ Tileset::Tileset(
       _asyncSystem(externals.asyncSystem),
       _options(options),
       _previousFrameNumber(0),
+      _effectiveMaximumScreenSpaceError(options.maximumScreenSpaceError),
+      _viewEpoch(0),
+      _viewEpochFrustums(),
+      _viewEpochFogDensities(),
+      _viewEpochRenderTilesUnderCamera(false),
+      _viewEpochFoveatedScreenSpaceError(),
+      _excluderEpoch(0),
       _distances(),
       _childOcclusionProxies(),
+      _pGroup(nullptr),
       _pTilesetContentManager{new TilesetContentManager(
           _externals,
           _options,
@@ -78,8 +172,16 @@ Tileset::Tileset(
       _asyncSystem(externals.asyncSystem),
       _options(options),
       _previousFrameNumber(0),
+      _effectiveMaximumScreenSpaceError(options.maximumScreenSpaceError),
+      _viewEpoch(0),
+      _viewEpochFrustums(),
+      _viewEpochFogDensities(),
+      _viewEpochRenderTilesUnderCamera(false),
+      _viewEpochFoveatedScreenSpaceError(),
+      _excluderEpoch(0),
       _distances(),
       _childOcclusionProxies(),
+      _pGroup(nullptr),
       _pTilesetContentManager{new TilesetContentManager(
           _externals,
           _options,
@@ -89,6 +191,17 @@ Tileset::Tileset(
           ionAssetEndpointUrl)} {}
 
 Tileset::~Tileset() noexcept {
+  if (this->_pGroup) {
+    this->_pGroup->removeTileset(*this);
+  }
+  for (TilesetHeightRequest& request : this->_heightRequests) {
+    request.fail("The tileset was destroyed before the heights were sampled.");
+  }
+  for (TilesetFetchRequest& request : this->_fetchRequests) {
+    request.result.warnings.emplace_back(
+        "The tileset was destroyed before the region was fetched.");
+    request.promise.resolve(std::move(request.result));
+  }
   this->_pTilesetContentManager->unloadAll();
   if (this->_externals.pTileOcclusionProxyPool) {
     this->_externals.pTileOcclusionProxyPool->destroyPool();
@@ -125,6 +238,16 @@ const Tile* Tileset::getRootTile() const noexcept {
   return this->_pTilesetContentManager->getRootTile();
 }
 
+Tile* Tileset::findTile(const TileID& tileID) noexcept {
+  const TileIndex* pIndex = this->_pTilesetContentManager->getTileIndex();
+  return pIndex ? pIndex->find(tileID) : nullptr;
+}
+
+const Tile* Tileset::findTile(const TileID& tileID) const noexcept {
+  const TileIndex* pIndex = this->_pTilesetContentManager->getTileIndex();
+  return pIndex ? pIndex->find(tileID) : nullptr;
+}
+
 RasterOverlayCollection& Tileset::getOverlays() noexcept {
   return this->_pTilesetContentManager->getRasterOverlayCollection();
 }
@@ -182,10 +305,34 @@ static double computeFogDensity(
   return density;
 }
 
+static bool isInRenderList(
+    const Tile& tile,
+    const TileSelectionState& selectionState,
+    int32_t frameNumber) noexcept {
+  const TileSelectionState::Result result =
+      selectionState.getResult(frameNumber);
+  return result == TileSelectionState::Result::Rendered ||
+         (result == TileSelectionState::Result::Refined &&
+          tile.getRefine() == TileRefine::Add);
+}
+
+static void copyFadingOutTiles(ViewUpdateResult& result) {
+  result.fadingOutTiles.clear();
+  result.fadingOutPercentages.clear();
+  for (Tile* pTile : result.tilesFadingOut) {
+    const TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    result.fadingOutTiles.push_back(pTile);
+    result.fadingOutPercentages.push_back(
+        pRenderContent ? pRenderContent->getLodTransitionFadePercentage()
+                       : 1.0f);
+  }
+}
+
 void Tileset::_updateLodTransitions(
     const FrameState& frameState,
     float deltaTime,
-    ViewUpdateResult& result) const noexcept {
+    ViewUpdateResult& result) noexcept {
   if (_options.enableLodTransitionPeriod) {
     // We always fade tiles from 0.0 --> 1.0. Whether the tile is fading in or
     // out is determined by whether the tile is in the tilesToRenderThisFrame
@@ -234,28 +381,111 @@ void Tileset::_updateLodTransitions(
       ++tileIt;
     }
 
-    // Update fade in
-    for (Tile* pTile : result.tilesToRenderThisFrame) {
+    // Update fade in. Only the tiles that started rendering recently can still
+    // be fading in, every other rendered tile is already fully visible.
+    for (auto tileIt = this->_tilesFadingIn.begin();
+         tileIt != this->_tilesFadingIn.end();) {
       TileRenderContent* pRenderContent =
-          pTile->getContent().getRenderContent();
-      if (pRenderContent) {
-        float transitionPercentage =
-            pRenderContent->getLodTransitionFadePercentage();
-        float newTransitionPercentage =
-            glm::min(transitionPercentage + deltaTransitionPercentage, 1.0f);
-        pRenderContent->setLodTransitionFadePercentage(newTransitionPercentage);
+          (*tileIt)->getContent().getRenderContent();
+      if (!pRenderContent || !isInRenderList(
+                                 **tileIt,
+                                 (*tileIt)->getLastSelectionState(),
+                                 frameState.currentFrameNumber)) {
+        tileIt = this->_tilesFadingIn.erase(tileIt);
+        continue;
+      }
+
+      const float newPercentage = glm::min(
+          pRenderContent->getLodTransitionFadePercentage() +
+              deltaTransitionPercentage,
+          1.0f);
+      pRenderContent->setLodTransitionFadePercentage(newPercentage);
+      if (newPercentage >= 1.0f) {
+        tileIt = this->_tilesFadingIn.erase(tileIt);
+      } else {
+        ++tileIt;
       }
     }
   } else {
     // If there are any tiles still fading in, set them to fully visible right
     // away.
-    for (Tile* pTile : result.tilesToRenderThisFrame) {
+    for (Tile* pTile : this->_tilesFadingIn) {
       TileRenderContent* pRenderContent =
           pTile->getContent().getRenderContent();
       if (pRenderContent) {
         pRenderContent->setLodTransitionFadePercentage(1.0f);
       }
     }
+    this->_tilesFadingIn.clear();
+  }
+
+  result.fadingInTiles.clear();
+  result.fadingInPercentages.clear();
+  for (Tile* pTile : this->_tilesFadingIn) {
+    const TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    result.fadingInTiles.push_back(pTile);
+    result.fadingInPercentages.push_back(
+        pRenderContent->getLodTransitionFadePercentage());
+  }
+  copyFadingOutTiles(result);
+}
+
+void Tileset::_addTileToRenderList(
+    Tile& tile,
+    const TileSelectionState& lastFrameSelectionState,
+    int32_t lastFrameNumber,
+    ViewUpdateResult& result) {
+  result.tilesToRenderThisFrame.push_back(&tile);
+
+  const bool wasInRenderList =
+      isInRenderList(tile, lastFrameSelectionState, lastFrameNumber);
+  if (!wasInRenderList && this->_options.reportRenderListChanges) {
+    result.tilesAddedToRenderList.push_back(&tile);
+  }
+
+  // A tile only starts fading in when it starts rendering, or when its content
+  // arrives later.
+  const TileContent& content = tile.getContent();
+  const TileRenderContent* pRenderContent = content.getRenderContent();
+  if (!wasInRenderList || content.isUnknownContent() ||
+      (pRenderContent &&
+       pRenderContent->getLodTransitionFadePercentage() < 1.0f)) {
+    this->_tilesFadingIn.insert(&tile);
+  }
+}
+
+void Tileset::_updateRenderListChanges(
+    int32_t currentFrameNumber,
+    ViewUpdateResult& result) noexcept {
+  std::vector<Tile*>& added = result.tilesAddedToRenderList;
+  std::vector<Tile*>& removed = result.tilesRemovedFromRenderList;
+  removed.clear();
+  if (!this->_options.reportRenderListChanges) {
+    return;
+  }
+
+  // The tiles were added as the traversal reached them, but some of them were
+  // kicked from the render list again in favor of an ancestor.
+  added.erase(
+      std::remove_if(
+          added.begin(),
+          added.end(),
+          [currentFrameNumber](const Tile* pTile) {
+            return !isInRenderList(
+                *pTile,
+                pTile->getLastSelectionState(),
+                currentFrameNumber);
+          }),
+      added.end());
+
+  for (Tile* pTile : this->_previousTilesToRender) {
+    if (!isInRenderList(
+            *pTile,
+            pTile->getLastSelectionState(),
+            currentFrameNumber)) {
+      removed.push_back(pTile);
+    }
   }
 }
 
@@ -264,14 +494,67 @@ Tileset::updateViewOffline(const std::vector<ViewState>& frustums) {
   std::vector<Tile*> tilesSelectedPrevFrame =
       this->_updateResult.tilesToRenderThisFrame;
 
+  // Offline updates load this tileset's tiles on their own, rather than
+  // through its group.
+  TilesetGroup* pGroup = this->_pGroup;
+  this->_pGroup = nullptr;
+  ScopeGuard restoreGroup{[this, pGroup]() { this->_pGroup = pGroup; }};
+
+  // Nothing is rendered until all tiles are loaded, so the limits that keep
+  // frames short don't help here. Every needed tile starts loading as soon as
+  // a traversal asks for it, and the main-thread work isn't spread over
+  // several traversals.
+  const uint32_t maximumSimultaneousTileLoads =
+      this->_options.maximumSimultaneousTileLoads;
+  const uint32_t maximumSimultaneousTileDecodes =
+      this->_options.maximumSimultaneousTileDecodes;
+  const double mainThreadLoadingTimeLimit =
+      this->_options.mainThreadLoadingTimeLimit;
+  const double mainThreadTimeLimit = this->_options.mainThreadTimeLimit;
+  const std::optional<AdaptiveConcurrencyLimitOptions> adaptiveLoadConcurrency =
+      this->_options.adaptiveLoadConcurrency;
+  this->_options.maximumSimultaneousTileLoads =
+      uint32_t(std::numeric_limits<int32_t>::max());
+  this->_options.maximumSimultaneousTileDecodes = 0;
+  this->_options.mainThreadLoadingTimeLimit = 0.0;
+  this->_options.mainThreadTimeLimit = 0.0;
+  this->_options.adaptiveLoadConcurrency.reset();
+  ScopeGuard restoreLimits{[this,
+                            maximumSimultaneousTileLoads,
+                            maximumSimultaneousTileDecodes,
+                            mainThreadLoadingTimeLimit,
+                            mainThreadTimeLimit,
+                            adaptiveLoadConcurrency]() {
+    this->_options.maximumSimultaneousTileLoads = maximumSimultaneousTileLoads;
+    this->_options.maximumSimultaneousTileDecodes =
+        maximumSimultaneousTileDecodes;
+    this->_options.mainThreadLoadingTimeLimit = mainThreadLoadingTimeLimit;
+    this->_options.mainThreadTimeLimit = mainThreadTimeLimit;
+    this->_options.adaptiveLoadConcurrency = adaptiveLoadConcurrency;
+  }};
+
   // TODO: fix the fading for offline case
   // (https://github.com/CesiumGS/cesium-native/issues/549)
   this->updateView(frustums, 0.0f);
-  while (this->_pTilesetContentManager->getNumberOfTilesLoading() > 0 ||
+  int32_t tilesLoading =
+      this->_pTilesetContentManager->getNumberOfTilesLoading();
+  while (tilesLoading > 0 ||
          this->_updateResult.mainThreadTileLoadQueueLength > 0 ||
          this->_updateResult.workerThreadTileLoadQueueLength > 0) {
     this->_externals.pAssetAccessor->tick();
+    this->_asyncSystem.dispatchMainThreadTasks();
+
+    // Tile loads only start in a traversal, so in between the number of tiles
+    // loading can only go down. As long as none of them has finished, another
+    // traversal would select the same tiles, so it's skipped.
+    const int32_t tilesStillLoading =
+        this->_pTilesetContentManager->getNumberOfTilesLoading();
+    if (tilesStillLoading > 0 && tilesStillLoading == tilesLoading) {
+      continue;
+    }
+
     this->updateView(frustums, 0.0f);
+    tilesLoading = this->_pTilesetContentManager->getNumberOfTilesLoading();
   }
 
   this->_updateResult.tilesFadingOut.clear();
@@ -290,26 +573,141 @@ Tileset::updateViewOffline(const std::vector<ViewState>& frustums) {
     }
   }
 
+  // The changes to the render list span all the updates above.
+  if (this->_options.reportRenderListChanges) {
+    const std::unordered_set<Tile*> uniqueTilesSelectedPrevFrame(
+        tilesSelectedPrevFrame.begin(),
+        tilesSelectedPrevFrame.end());
+    this->_updateResult.tilesAddedToRenderList.clear();
+    for (Tile* tile : this->_updateResult.tilesToRenderThisFrame) {
+      if (uniqueTilesSelectedPrevFrame.find(tile) ==
+          uniqueTilesSelectedPrevFrame.end()) {
+        this->_updateResult.tilesAddedToRenderList.push_back(tile);
+      }
+    }
+    this->_updateResult.tilesRemovedFromRenderList.clear();
+    for (Tile* tile : tilesSelectedPrevFrame) {
+      if (uniqueTilesToRenderThisFrame.find(tile) ==
+          uniqueTilesToRenderThisFrame.end()) {
+        this->_updateResult.tilesRemovedFromRenderList.push_back(tile);
+      }
+    }
+  }
+  copyFadingOutTiles(this->_updateResult);
+
   return this->_updateResult;
 }
 
+/**
+ * @brief Replaces each pair of consecutive views that are a stereo pair with
+ * one view whose frustum contains both of theirs.
+ *
+ * Two views are a stereo pair if they look in the same direction, within
+ * about a degree, with the same field of view, from positions no more than
+ * maximumSeparation apart.
+ */
+static const std::vector<ViewState>& combineStereoViews(
+    const std::vector<ViewState>& frustums,
+    double maximumSeparation,
+    std::vector<ViewState>& combined) {
+  const double minimumCosAngle = glm::cos(Math::degreesToRadians(1.0));
+
+  combined.clear();
+  for (size_t i = 0; i < frustums.size(); ++i) {
+    const ViewState& left = frustums[i];
+    if (i + 1 == frustums.size()) {
+      combined.emplace_back(left);
+      break;
+    }
+
+    const ViewState& right = frustums[i + 1];
+    const double cosAngle = glm::clamp(
+        glm::dot(left.getDirection(), right.getDirection()),
+        -1.0,
+        1.0);
+    const double separation =
+        glm::distance(left.getPosition(), right.getPosition());
+    if (cosAngle < minimumCosAngle || separation > maximumSeparation ||
+        !Math::equalsEpsilon(
+            left.getHorizontalFieldOfView(),
+            right.getHorizontalFieldOfView(),
+            Math::Epsilon6) ||
+        !Math::equalsEpsilon(
+            left.getVerticalFieldOfView(),
+            right.getVerticalFieldOfView(),
+            Math::Epsilon6)) {
+      combined.emplace_back(left);
+      continue;
+    }
+
+    // Widening the view by the angle between the two directions, and moving
+    // it back from the midpoint until its sides pass behind both positions,
+    // makes it contain both frustums.
+    const double angle = glm::acos(cosAngle);
+    const double horizontalFieldOfView =
+        glm::min(left.getHorizontalFieldOfView() + angle, Math::OnePi * 0.99);
+    const double verticalFieldOfView =
+        glm::min(left.getVerticalFieldOfView() + angle, Math::OnePi * 0.99);
+    const glm::dvec3 direction =
+        glm::normalize(left.getDirection() + right.getDirection());
+    const double pullBack =
+        0.5 * separation /
+        glm::tan(0.5 * glm::min(horizontalFieldOfView, verticalFieldOfView));
+    combined.emplace_back(ViewState::create(
+        glm::mix(left.getPosition(), right.getPosition(), 0.5) -
+            direction * pullBack,
+        direction,
+        glm::normalize(left.getUp() + right.getUp()),
+        glm::max(left.getViewportSize(), right.getViewportSize()),
+        horizontalFieldOfView,
+        verticalFieldOfView));
+    ++i;
+  }
+
+  return combined;
+}
+
 const ViewUpdateResult&
-Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
+Tileset::updateView(const std::vector<ViewState>& views, float deltaTime) {
   CESIUM_TRACE("Tileset::updateView");
+  const std::vector<ViewState>& frustums =
+      this->_options.combineStereoViews
+          ? combineStereoViews(
+                views,
+                this->_options.maximumStereoViewSeparation,
+                this->_combinedViews)
+          : views;
+
   // Fixup TilesetOptions to ensure lod transitions works correctly.
   _options.enableFrustumCulling =
       _options.enableFrustumCulling && !_options.enableLodTransitionPeriod;
   _options.enableFogCulling =
       _options.enableFogCulling && !_options.enableLodTransitionPeriod;
-
-  this->_asyncSystem.dispatchMainThreadTasks();
+  _options.enableHorizonCulling =
+      _options.enableHorizonCulling && !_options.enableLodTransitionPeriod;
+
+  // With a main-thread budget, continuations are dispatched at the end of the
+  // frame with whatever time the more important work left.
+  MainThreadBudget& mainThreadBudget =
+      this->_pTilesetContentManager->getMainThreadBudget();
+  mainThreadBudget.startFrame(this->_options.mainThreadTimeLimit);
+  if (!mainThreadBudget.isEnabled()) {
+    this->_asyncSystem.dispatchMainThreadTasks();
+  }
 
   const int32_t previousFrameNumber = this->_previousFrameNumber;
   const int32_t currentFrameNumber = previousFrameNumber + 1;
 
   ViewUpdateResult& result = this->_updateResult;
+  this->_updateEffectiveMaximumScreenSpaceError(
+      result.tilesToRenderThisFrame.size());
+  this->_updateSoftwareOcclusionBuffers(frustums);
+
   result.frameNumber = currentFrameNumber;
+  result.maximumScreenSpaceError = this->_effectiveMaximumScreenSpaceError;
+  std::swap(result.tilesToRenderThisFrame, this->_previousTilesToRender);
   result.tilesToRenderThisFrame.clear();
+  result.tilesAddedToRenderList.clear();
   result.tilesVisited = 0;
   result.culledTilesVisited = 0;
   result.tilesCulled = 0;
@@ -317,13 +715,25 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
   result.tilesWaitingForOcclusionResults = 0;
   result.tilesKicked = 0;
   result.maxDepthVisited = 0;
+  result.screenSpaceErrorEvaluations = 0;
+  result.cullingTests = 0;
+  result.bytesEvicted = 0;
+  result.traversalTime = 0.0;
+  result.workerThreadLoadQueueTime = 0.0;
+  result.mainThreadLoadQueueTime = 0.0;
+  result.unloadCachedTilesTime = 0.0;
+  result.lodTransitionTime = 0.0;
 
   if (!_options.enableLodTransitionPeriod) {
     result.tilesFadingOut.clear();
+    result.fadingOutTiles.clear();
+    result.fadingOutPercentages.clear();
   }
 
   Tile* pRootTile = this->getRootTile();
   if (!pRootTile) {
+    this->_dispatchMainThreadTasksWithinBudget();
+    this->_selectTilesForRenderOnlyViews(result);
     return result;
   }
 
@@ -331,9 +741,20 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
        this->_options.excluders) {
     pExcluder->startNewFrame();
   }
+  ++this->_excluderEpoch;
+
+  this->_processTileInvalidations();
+
+  // The raster overlay tiles attached during this update are passed to the
+  // renderer together, once the tiles are finished loading.
+  this->_pTilesetContentManager->beginRasterAttachmentBatch(this->_options);
 
   this->_workerThreadLoadQueue.clear();
   this->_mainThreadLoadQueue.clear();
+  this->_subtreePruningCandidates.clear();
+  this->_prefetchedTiles.clear();
+  this->_loadingTilesStillNeeded.clear();
+  this->_externalTilesetPrefetchCandidates.clear();
 
   std::vector<double> fogDensities(frustums.size());
   std::transform(
@@ -345,22 +766,49 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
         return computeFogDensity(fogDensityTable, frustum);
       });
 
+  const uint64_t viewEpoch = this->_updateViewEpoch(frustums, fogDensities);
+
   FrameState frameState{
       frustums,
       std::move(fogDensities),
       previousFrameNumber,
-      currentFrameNumber};
+      currentFrameNumber,
+      viewEpoch};
 
   if (!frustums.empty()) {
-    this->_visitTileIfNeeded(frameState, 0, false, *pRootTile, result);
+    ScopedPhaseTimer timer(this->_options, result.traversalTime);
+    this->_visitTileIfNeeded(
+        frameState,
+        0,
+        false,
+        SkipLevelOfDetailAncestor{},
+        *pRootTile,
+        result);
   } else {
     result = ViewUpdateResult();
   }
 
+  this->_updateRenderListChanges(currentFrameNumber, result);
+
+  if (!this->_predictedViews.empty()) {
+    this->_prefetchPredictedViews(currentFrameNumber, result);
+  }
+
+  this->_processHeightRequests();
+  this->_processFetchRequests();
+  this->_prefetchExternalTilesets();
+
+  if (this->_options.cancelUnneededTileLoads) {
+    this->_pTilesetContentManager->cancelTileLoadsExcept(
+        this->_loadingTilesStillNeeded);
+  }
+
   result.workerThreadTileLoadQueueLength =
       static_cast<int32_t>(this->_workerThreadLoadQueue.size());
   result.mainThreadTileLoadQueueLength =
       static_cast<int32_t>(this->_mainThreadLoadQueue.size());
+  result.maximumSimultaneousTileLoads = 0;
+  result.maximumSimultaneousSubtreeLoads = 0;
 
   const std::shared_ptr<TileOcclusionRendererProxyPool>& pOcclusionPool =
       this->getExternals().pTileOcclusionProxyPool;
@@ -368,10 +816,27 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
     pOcclusionPool->pruneOcclusionProxyMappings();
   }
 
-  this->_unloadCachedTiles(this->_options.tileCacheUnloadTimeLimit);
-  this->_processWorkerThreadLoadQueue();
+  // Finishing loads comes before unloading cached tiles, so that it gets the
+  // main-thread budget first.
+  // The tilesets of a group start their loads and unload their cached tiles
+  // together, see TilesetGroup::updateLoads.
+  this->_pruneUnusedSubtrees(currentFrameNumber);
+  if (!this->_pGroup) {
+    this->_processWorkerThreadLoadQueue();
+  }
   this->_processMainThreadLoadQueue();
-  this->_updateLodTransitions(frameState, deltaTime, result);
+  if (!this->_pGroup) {
+    this->_unloadCachedTiles(
+        this->_options.maximumCachedBytes,
+        this->_options.tileCacheUnloadTimeLimit);
+  }
+  this->_dispatchMainThreadTasksWithinBudget();
+  this->_pTilesetContentManager->endRasterAttachmentBatch();
+  this->_selectTilesForRenderOnlyViews(result);
+  {
+    ScopedPhaseTimer timer(this->_options, result.lodTransitionTime);
+    this->_updateLodTransitions(frameState, deltaTime, result);
+  }
 
   // aggregate all the credits needed from this tileset for the current frame
   const std::shared_ptr<CreditSystem>& pCreditSystem =
@@ -384,9 +849,7 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
     }
 
     // tileset credit
-    for (const Credit& credit : this->getTilesetCredits()) {
-      pCreditSystem->addCreditToFrame(credit);
-    }
+    pCreditSystem->addCreditsToFrame(this->getTilesetCredits());
 
     // per-raster overlay credit
     const RasterOverlayCollection& overlayCollection =
@@ -407,9 +870,7 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
         const RasterOverlayTile* pRasterOverlayTile =
             mappedRasterTile.getReadyTile();
         if (pRasterOverlayTile != nullptr) {
-          for (const Credit& credit : pRasterOverlayTile->getCredits()) {
-            pCreditSystem->addCreditToFrame(credit);
-          }
+          pCreditSystem->addCreditsToFrame(pRasterOverlayTile->getCredits());
         }
       }
 
@@ -417,9 +878,7 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
       const TileRenderContent* pRenderContent =
           pTile->getContent().getRenderContent();
       if (pRenderContent) {
-        for (const Credit& credit : pRenderContent->getCredits()) {
-          pCreditSystem->addCreditToFrame(credit);
-        }
+        pCreditSystem->addCreditsToFrame(pRenderContent->getCredits());
       }
     }
   }
@@ -428,10 +887,166 @@ Tileset::updateView(const std::vector<ViewState>& frustums, float deltaTime) {
 
   return result;
 }
+
+void Tileset::_updateEffectiveMaximumScreenSpaceError(
+    size_t tilesRenderedLastFrame) {
+  const std::optional<ScreenSpaceErrorGovernorOptions>& governor =
+      this->_options.screenSpaceErrorGovernor;
+  if (!governor) {
+    this->_effectiveMaximumScreenSpaceError =
+        this->_options.maximumScreenSpaceError;
+    return;
+  }
+
+  // Without a budget there is nothing to govern by, so the screen-space error
+  // is left where it is.
+  if (!governor->maximumTilesRendered && !governor->maximumDataBytes &&
+      !governor->maximumTilesLoading) {
+    return;
+  }
+
+  // How much of the most used budget was used last frame.
+  double usage = 0.0;
+  if (governor->maximumTilesRendered) {
+    usage = glm::max(
+        usage,
+        double(tilesRenderedLastFrame) /
+            double(glm::max(*governor->maximumTilesRendered, 1U)));
+  }
+  if (governor->maximumDataBytes) {
+    usage = glm::max(
+        usage,
+        double(this->getTotalDataBytes()) /
+            double(glm::max(*governor->maximumDataBytes, int64_t(1))));
+  }
+  if (governor->maximumTilesLoading) {
+    usage = glm::max(
+        usage,
+        double(this->_pTilesetContentManager->getNumberOfTilesLoading()) /
+            double(glm::max(*governor->maximumTilesLoading, 1)));
+  }
+
+  const double minimumSse = governor->minimumScreenSpaceError;
+  const double maximumSse =
+      glm::max(minimumSse, governor->maximumScreenSpaceError);
+  const double rate = 1.0 + glm::max(governor->adjustmentRate, 0.0);
+
+  double sse = glm::clamp(
+      this->_effectiveMaximumScreenSpaceError,
+      minimumSse,
+      maximumSse);
+  if (usage > 1.0) {
+    sse *= rate;
+  } else if (usage < governor->recoveryThreshold) {
+    sse /= rate;
+  }
+
+  this->_effectiveMaximumScreenSpaceError =
+      glm::clamp(sse, minimumSse, maximumSse);
+}
+
+// ViewState can't be assigned, so the views are replaced by moving a copy.
+void Tileset::setPredictedViews(const std::vector<ViewState>& frustums) {
+  this->_predictedViews = std::vector<ViewState>(frustums);
+}
+
+void Tileset::setRenderOnlyViews(const std::vector<ViewState>& frustums) {
+  this->_renderOnlyViews = std::vector<ViewState>(frustums);
+}
+
+static bool isViewWithinTolerance(
+    const ViewState& viewState,
+    const ViewState& reference,
+    double positionTolerance) noexcept {
+  return glm::distance(viewState.getPosition(), reference.getPosition()) <=
+             positionTolerance &&
+         Math::equalsEpsilon(
+             viewState.getDirection(),
+             reference.getDirection(),
+             Math::Epsilon10) &&
+         Math::equalsEpsilon(
+             viewState.getUp(),
+             reference.getUp(),
+             Math::Epsilon10) &&
+         viewState.getViewportSize() == reference.getViewportSize() &&
+         viewState.getHorizontalFieldOfView() ==
+             reference.getHorizontalFieldOfView() &&
+         viewState.getVerticalFieldOfView() ==
+             reference.getVerticalFieldOfView();
+}
+
+static bool isSameFoveation(
+    const std::optional<FoveatedScreenSpaceErrorOptions>& foveation,
+    const std::optional<FoveatedScreenSpaceErrorOptions>& reference) noexcept {
+  if (!foveation || !reference) {
+    return !foveation && !reference;
+  }
+  return foveation->coneSize == reference->coneSize &&
+         foveation->minimumScreenSpaceErrorFactor ==
+             reference->minimumScreenSpaceErrorFactor;
+}
+
+uint64_t Tileset::_updateViewEpoch(
+    const std::vector<ViewState>& frustums,
+    const std::vector<double>& fogDensities) {
+  if (!this->_options.enableViewEvaluationCaching) {
+    this->_viewEpochFrustums.clear();
+    return 0;
+  }
+
+  const double tolerance = this->_options.viewEvaluationCachePositionTolerance;
+  const bool unchanged =
+      !this->_viewEpochFrustums.empty() &&
+      this->_viewEpochRenderTilesUnderCamera ==
+          this->_options.renderTilesUnderCamera &&
+      isSameFoveation(
+          this->_options.foveatedScreenSpaceError,
+          this->_viewEpochFoveatedScreenSpaceError) &&
+      std::equal(
+          frustums.begin(),
+          frustums.end(),
+          this->_viewEpochFrustums.begin(),
+          this->_viewEpochFrustums.end(),
+          [tolerance](const ViewState& viewState, const ViewState& reference) {
+            return isViewWithinTolerance(viewState, reference, tolerance);
+          }) &&
+      std::equal(
+          fogDensities.begin(),
+          fogDensities.end(),
+          this->_viewEpochFogDensities.begin(),
+          this->_viewEpochFogDensities.end(),
+          [](double fogDensity, double reference) {
+            return Math::equalsEpsilon(fogDensity, reference, Math::Epsilon4);
+          });
+
+  if (!unchanged) {
+    // Start a new epoch, so that every tile is evaluated again. Reference
+    // views are only replaced here, so that a slowly moving camera can't drift
+    // away from the views the cached evaluations were computed with.
+    ++this->_viewEpoch;
+    this->_viewEpochFrustums.clear();
+    this->_viewEpochFrustums.insert(
+        this->_viewEpochFrustums.end(),
+        frustums.begin(),
+        frustums.end());
+    this->_viewEpochFogDensities = fogDensities;
+    this->_viewEpochRenderTilesUnderCamera =
+        this->_options.renderTilesUnderCamera;
+    this->_viewEpochFoveatedScreenSpaceError =
+        this->_options.foveatedScreenSpaceError;
+  }
+
+  return this->_viewEpoch;
+}
+
 int32_t Tileset::getNumberOfTilesLoaded() const {
   return this->_pTilesetContentManager->getNumberOfTilesLoaded();
 }
 
+TileLoadMetrics Tileset::getTileLoadMetrics() const {
+  return this->_pTilesetContentManager->getTileLoadMetrics();
+}
+
 float Tileset::computeLoadProgress() noexcept {
   int32_t queueSizeSum = static_cast<int32_t>(
       this->_updateResult.workerThreadTileLoadQueueLength +
@@ -524,6 +1139,247 @@ CesiumAsync::Future<const TilesetMetadata*> Tileset::loadMetadata() {
       });
 }
 
+CesiumAsync::Future<SampleHeightResult> Tileset::sampleHeightMostDetailed(
+    gsl::span<const Cartographic> positions) {
+  std::vector<TilesetHeightQuery> queries;
+  queries.reserve(positions.size());
+  for (const Cartographic& position : positions) {
+    queries.emplace_back(position);
+  }
+
+  Promise<SampleHeightResult> promise =
+      this->_asyncSystem.createPromise<SampleHeightResult>();
+  this->_heightRequests.emplace_back(
+      TilesetHeightRequest{std::move(queries), promise, false});
+  return promise.getFuture();
+}
+
+CesiumAsync::Future<TileFetchResult>
+Tileset::fetchRegion(const TileFetchRegion& region) {
+  Promise<TileFetchResult> promise =
+      this->_asyncSystem.createPromise<TileFetchResult>();
+  this->_fetchRequests.emplace_back(
+      TilesetFetchRequest{region, promise, TileFetchResult()});
+  return promise.getFuture();
+}
+
+TileFetchResult Tileset::fetchRegionOffline(const TileFetchRegion& region) {
+  Future<TileFetchResult> future = this->fetchRegion(region);
+
+  // As in updateViewOffline, the tiles are loaded by this tileset on its own.
+  TilesetGroup* pGroup = this->_pGroup;
+  this->_pGroup = nullptr;
+  ScopeGuard restoreGroup{[this, pGroup]() { this->_pGroup = pGroup; }};
+
+  const std::vector<ViewState> noViews;
+  this->updateView(noViews, 0.0f);
+  while (!future.isReady()) {
+    if (!this->getRootTile() && this->getRootTileAvailableEvent().isReady()) {
+      // The tileset failed to load, so the request will never complete.
+      TileFetchResult result;
+      result.warnings.emplace_back(
+          "The tileset failed to load, so the region wasn't fetched.");
+      return result;
+    }
+
+    this->_externals.pAssetAccessor->tick();
+    this->updateView(noViews, 0.0f);
+  }
+
+  return future.wait();
+}
+
+namespace {
+// Whether the text matches the pattern, in which '*' matches any sequence of
+// characters.
+bool matchesUrlPattern(const std::string& text, const std::string& pattern) {
+  size_t textPos = 0;
+  size_t patternPos = 0;
+  size_t starPos = std::string::npos;
+  size_t starTextPos = 0;
+  while (textPos < text.size()) {
+    if (patternPos < pattern.size() && pattern[patternPos] == '*') {
+      starPos = patternPos++;
+      starTextPos = textPos;
+    } else if (
+        patternPos < pattern.size() && pattern[patternPos] == text[textPos]) {
+      ++patternPos;
+      ++textPos;
+    } else if (starPos != std::string::npos) {
+      // Let the last star match one more character.
+      patternPos = starPos + 1;
+      textPos = ++starTextPos;
+    } else {
+      return false;
+    }
+  }
+
+  while (patternPos < pattern.size() && pattern[patternPos] == '*') {
+    ++patternPos;
+  }
+  return patternPos == pattern.size();
+}
+
+bool isTileInvalidated(const Tile& tile, const TileInvalidation& invalidation) {
+  const TileID& tileID = tile.getTileID();
+  if (std::find(
+          invalidation.tileIDs.begin(),
+          invalidation.tileIDs.end(),
+          tileID) != invalidation.tileIDs.end()) {
+    return true;
+  }
+
+  const TileUrl* pUrl = std::get_if<TileUrl>(&tileID);
+  if (pUrl && !pUrl->empty() && !invalidation.urlPatterns.empty()) {
+    const std::string url = pUrl->toString();
+    for (const std::string& pattern : invalidation.urlPatterns) {
+      if (matchesUrlPattern(url, pattern)) {
+        return true;
+      }
+    }
+  }
+
+  if (invalidation.rectangle) {
+    const std::optional<GlobeRectangle> maybeRectangle =
+        estimateGlobeRectangle(tile.getBoundingVolume());
+    return !maybeRectangle ||
+           invalidation.rectangle->computeIntersection(*maybeRectangle);
+  }
+
+  return false;
+}
+} // namespace
+
+size_t Tileset::invalidateTiles(const TileInvalidation& invalidation) {
+  CESIUM_TRACE("Tileset::invalidateTiles");
+
+  Tile* pRootTile = this->getRootTile();
+  if (!pRootTile) {
+    return 0;
+  }
+
+  size_t invalidatedCount = 0;
+  std::vector<Tile*> stack{pRootTile};
+  while (!stack.empty()) {
+    Tile* pTile = stack.back();
+    stack.pop_back();
+    for (Tile& child : pTile->getChildren()) {
+      stack.emplace_back(&child);
+    }
+
+    const TileContent& content = pTile->getContent();
+    if (content.isExternalContent() || content.isEmptyContent() ||
+        !isTileInvalidated(*pTile, invalidation)) {
+      continue;
+    }
+
+    ++invalidatedCount;
+    this->_pTilesetContentManager->revalidateNextTileLoad(*pTile);
+    if (pTile->getState() != TileLoadState::Unloaded &&
+        std::find(
+            this->_invalidatedTiles.begin(),
+            this->_invalidatedTiles.end(),
+            pTile) == this->_invalidatedTiles.end()) {
+      this->_invalidatedTiles.emplace_back(pTile);
+    }
+  }
+
+  this->_processTileInvalidations();
+  return invalidatedCount;
+}
+
+void Tileset::_processTileInvalidations() {
+  if (this->_invalidatedTiles.empty()) {
+    return;
+  }
+
+  CESIUM_TRACE("Tileset::_processTileInvalidations");
+
+  // A tile that is loading or being upsampled from can't be unloaded yet, but
+  // it can't be discarded by subtree pruning either, so it stays here until
+  // it can be. Its load is canceled by unloadTileContent. A tile whose load
+  // ended with content that is never unloaded, such as an external tileset,
+  // is dropped.
+  auto it = this->_invalidatedTiles.begin();
+  while (it != this->_invalidatedTiles.end()) {
+    Tile& tile = **it;
+    this->_updateResult.tilesFadingOut.erase(&tile);
+    this->_tilesFadingIn.erase(&tile);
+    if (this->_pTilesetContentManager->unloadTileContent(tile)) {
+      this->_loadedTiles.remove(tile);
+      it = this->_invalidatedTiles.erase(it);
+    } else if (
+        tile.getState() == TileLoadState::ContentLoading ||
+        tile.getState() == TileLoadState::Unloading) {
+      ++it;
+    } else {
+      it = this->_invalidatedTiles.erase(it);
+    }
+  }
+}
+
+// Tests the rendered content of the tile and of its descendants that the ray
+// may hit before the closest hit found so far.
+static void intersectRayWithTile(
+    const Ray& ray,
+    const std::unordered_set<const Tile*>& renderedTiles,
+    Tile& tile,
+    std::optional<TileRayIntersection>& closest) {
+  if (renderedTiles.find(&tile) != renderedTiles.end()) {
+    const TileTriangleIndex* pIndex = CesiumImpl::getOrBuildTriangleIndex(tile);
+    const std::optional<double> t =
+        pIndex ? pIndex->intersectRay(ray) : std::nullopt;
+    if (t && (!closest || *t < closest->distance)) {
+      closest = TileRayIntersection{
+          &tile,
+          *t,
+          ray.getOrigin() + ray.getDirection() * *t};
+    }
+  }
+
+  // The children are tested in the order the ray enters their bounding
+  // volumes, so the ones it enters beyond the closest hit can't be any closer.
+  std::vector<std::pair<double, Tile*>> children;
+  for (Tile& child : tile.getChildren()) {
+    const std::optional<double> entry = IntersectionTests::rayOBBParametric(
+        ray,
+        getOrientedBoundingBoxFromBoundingVolume(child.getBoundingVolume()));
+    if (entry) {
+      children.emplace_back(*entry, &child);
+    }
+  }
+  std::sort(
+      children.begin(),
+      children.end(),
+      [](const std::pair<double, Tile*>& a, const std::pair<double, Tile*>& b) {
+        return a.first < b.first;
+      });
+
+  for (const auto& [entry, pChild] : children) {
+    if (closest && entry > closest->distance) {
+      break;
+    }
+    intersectRayWithTile(ray, renderedTiles, *pChild, closest);
+  }
+}
+
+std::optional<TileRayIntersection> Tileset::intersectRay(const Ray& ray) {
+  CESIUM_TRACE("Tileset::intersectRay");
+
+  Tile* pRootTile = this->getRootTile();
+  if (!pRootTile) {
+    return std::nullopt;
+  }
+
+  const std::unordered_set<const Tile*> renderedTiles(
+      this->_updateResult.tilesToRenderThisFrame.begin(),
+      this->_updateResult.tilesToRenderThisFrame.end());
+
+  std::optional<TileRayIntersection> closest;
+  intersectRayWithTile(ray, renderedTiles, *pRootTile, closest);
+  return closest;
+}
+
 static void markTileNonRendered(
     TileSelectionState::Result lastResult,
     Tile& tile,
@@ -583,28 +1439,17 @@ static void markTileAndChildrenNonRendered(
 }
 
 /**
- * @brief Returns whether a tile with the given bounding volume is visible for
- * the camera.
+ * @brief Returns whether the camera position lies above or below the
+ * given bounding volume.
  *
  * @param viewState The {@link ViewState}
  * @param boundingVolume The bounding volume of the tile
- * @param forceRenderTilesUnderCamera Whether tiles under the camera should
- * always be considered visible and rendered (see
- * {@link Cesium3DTilesSelection::TilesetOptions}).
- * @return Whether the tile is visible according to the current camera
- * configuration
+ * @return Whether the camera's cartographic position is inside the globe
+ * rectangle of the bounding volume
  */
-static bool isVisibleFromCamera(
+static bool isUnderCamera(
     const ViewState& viewState,
-    const BoundingVolume& boundingVolume,
-    bool forceRenderTilesUnderCamera) {
-  if (viewState.isBoundingVolumeVisible(boundingVolume)) {
-    return true;
-  }
-  if (!forceRenderTilesUnderCamera) {
-    return false;
-  }
-
+    const BoundingVolume& boundingVolume) {
   const std::optional<CesiumGeospatial::Cartographic>& position =
       viewState.getPositionCartographic();
 
@@ -635,95 +1480,203 @@ static bool isVisibleInFog(double distance, double fogDensity) noexcept {
   return glm::exp(-(fogScalar * fogScalar)) > 0.0;
 }
 
-void Tileset::_frustumCull(
+bool Tileset::_isVisibleFromAnyCamera(
     const Tile& tile,
+    const Tile::CachedCullingVolume& cullingVolume,
     const FrameState& frameState,
     bool cullWithChildrenBounds,
-    CullResult& cullResult) {
-
-  if (!cullResult.shouldVisit || cullResult.culled) {
-    return;
-  }
-
+    uint32_t& cullingTests) const {
   const std::vector<ViewState>& frustums = frameState.frustums;
+  const bool renderTilesUnderCamera = this->_options.renderTilesUnderCamera;
+
   // Frustum cull using the children's bounds.
   if (cullWithChildrenBounds) {
-    if (std::any_of(
-            frustums.begin(),
-            frustums.end(),
-            [children = tile.getChildren(),
-             renderTilesUnderCamera = this->_options.renderTilesUnderCamera](
-                const ViewState& frustum) {
-              for (const Tile& child : children) {
-                if (isVisibleFromCamera(
-                        frustum,
-                        child.getBoundingVolume(),
-                        renderTilesUnderCamera)) {
-                  return true;
-                }
-              }
-
-              return false;
-            })) {
-      // At least one child is visible in at least one frustum, so don't cull.
-      return;
-    }
-    // Frustum cull based on the actual tile's bounds.
-  } else if (std::any_of(
-                 frustums.begin(),
-                 frustums.end(),
-                 [&boundingVolume = tile.getBoundingVolume(),
-                  renderTilesUnderCamera =
-                      this->_options.renderTilesUnderCamera](
-                     const ViewState& frustum) {
-                   return isVisibleFromCamera(
-                       frustum,
-                       boundingVolume,
-                       renderTilesUnderCamera);
-                 })) {
-    // The tile is visible in at least one frustum, so don't cull.
-    return;
-  }
-
-  // If we haven't returned yet, this tile is frustum culled.
-  cullResult.culled = true;
+    // Visible if at least one child is visible in at least one frustum.
+    return std::any_of(
+        frustums.begin(),
+        frustums.end(),
+        [&volumes = tile._childCullingVolumes,
+         children = tile.getChildren(),
+         renderTilesUnderCamera,
+         &cullingTests](const ViewState& frustum) {
+          ++cullingTests;
+          if (frustum.isAnyBoundingVolumeVisible(volumes.boxes) ||
+              frustum.isAnyBoundingVolumeVisible(volumes.spheres)) {
+            return true;
+          }
 
-  if (this->_options.enableFrustumCulling) {
-    // frustum culling is enabled so we shouldn't visit this off-screen tile
-    cullResult.shouldVisit = false;
+          if (!renderTilesUnderCamera) {
+            return false;
+          }
+          return std::any_of(
+              children.begin(),
+              children.end(),
+              [&frustum](const Tile& child) {
+                return isUnderCamera(frustum, child.getBoundingVolume());
+              });
+        });
   }
+
+  // Frustum cull based on the actual tile's bounds.
+  return std::any_of(
+      frustums.begin(),
+      frustums.end(),
+      [&tile, &cullingVolume, renderTilesUnderCamera, &cullingTests](
+          const ViewState& frustum) {
+        ++cullingTests;
+        if (frustum.isBoundingVolumeVisible(
+                cullingVolume.box,
+                cullingVolume.sphere)) {
+          return true;
+        }
+        if (!renderTilesUnderCamera) {
+          return false;
+        }
+        return isUnderCamera(frustum, tile.getBoundingVolume());
+      });
 }
 
-void Tileset::_fogCull(
-    const FrameState& frameState,
+static bool isVisibleInFogFromAnyCamera(
+    const std::vector<double>& fogDensities,
     const std::vector<double>& distances,
-    CullResult& cullResult) {
+    uint32_t& cullingTests) noexcept {
+  for (size_t i = 0; i < fogDensities.size() && i < distances.size(); ++i) {
+    // Without fog, everything is visible and there's nothing to test.
+    if (fogDensities[i] <= 0.0) {
+      return true;
+    }
 
-  if (!cullResult.shouldVisit || cullResult.culled) {
-    return;
+    ++cullingTests;
+    if (isVisibleInFog(distances[i], fogDensities[i])) {
+      return true;
+    }
   }
 
-  const std::vector<ViewState>& frustums = frameState.frustums;
-  const std::vector<double>& fogDensities = frameState.fogDensities;
+  return false;
+}
 
-  bool isFogCulled = true;
+static bool isAboveHorizonForAnyCamera(
+    const std::optional<HorizonCullingPoint>& point,
+    const std::vector<ViewState>& frustums,
+    uint32_t& cullingTests) noexcept {
+  // Volumes without a horizon culling point are never below the horizon.
+  if (!point) {
+    return true;
+  }
 
-  for (size_t i = 0; i < frustums.size(); ++i) {
-    const double distance = distances[i];
-    const double fogDensity = fogDensities[i];
+  return std::any_of(
+      frustums.begin(),
+      frustums.end(),
+      [&point, &cullingTests](const ViewState& frustum) {
+        ++cullingTests;
+        const EllipsoidalOccluder occluder(
+            Ellipsoid::WGS84,
+            frustum.getPosition());
+        return occluder.isHorizonCullingPointVisible(*point);
+      });
+}
 
-    if (isVisibleInFog(distance, fogDensity)) {
-      isFogCulled = false;
-      break;
-    }
+void Tileset::_frustumCull(
+    bool visibleFromCamera,
+    CullResult& cullResult) const noexcept {
+  if (!cullResult.shouldVisit || cullResult.culled || visibleFromCamera) {
+    return;
+  }
+
+  // If we haven't returned yet, this tile is frustum culled.
+  cullResult.culled = true;
+
+  if (this->_options.enableFrustumCulling) {
+    // frustum culling is enabled so we shouldn't visit this off-screen tile
+    cullResult.shouldVisit = false;
+  }
+}
+
+void Tileset::_fogCull(bool visibleInFog, CullResult& cullResult)
+    const noexcept {
+  if (!cullResult.shouldVisit || cullResult.culled || visibleInFog) {
+    return;
+  }
+
+  // this tile is occluded by fog so it is a culled tile
+  cullResult.culled = true;
+  if (this->_options.enableFogCulling) {
+    // fog culling is enabled so we shouldn't visit this tile
+    cullResult.shouldVisit = false;
+  }
+}
+
+void Tileset::_horizonCull(bool visibleAboveHorizon, CullResult& cullResult)
+    const noexcept {
+  if (!cullResult.shouldVisit || cullResult.culled || visibleAboveHorizon) {
+    return;
+  }
+
+  // this tile is below the horizon so it is a culled tile
+  cullResult.culled = true;
+  if (this->_options.enableHorizonCulling) {
+    // horizon culling is enabled so we shouldn't visit this tile
+    cullResult.shouldVisit = false;
+  }
+}
+
+void Tileset::_softwareOcclusionCull(
+    const OrientedBoundingBox& boundingBox,
+    CullResult& cullResult,
+    uint32_t& cullingTests) const {
+  const std::vector<SoftwareOcclusionBuffer>& buffers =
+      this->_softwareOcclusionBuffers;
+  if (!cullResult.shouldVisit || cullResult.culled || buffers.empty()) {
+    return;
   }
 
-  if (isFogCulled) {
-    // this tile is occluded by fog so it is a culled tile
+  // A tile is only occluded if it's occluded in every view.
+  const bool occluded = std::all_of(
+      buffers.begin(),
+      buffers.end(),
+      [&boundingBox, &cullingTests](const SoftwareOcclusionBuffer& buffer) {
+        ++cullingTests;
+        return buffer.isOccluded(boundingBox);
+      });
+  if (occluded) {
     cullResult.culled = true;
-    if (this->_options.enableFogCulling) {
-      // fog culling is enabled so we shouldn't visit this tile
-      cullResult.shouldVisit = false;
+    cullResult.shouldVisit = false;
+  }
+}
+
+void Tileset::_updateSoftwareOcclusionBuffers(
+    const std::vector<ViewState>& frustums) {
+  std::vector<SoftwareOcclusionBuffer>& buffers =
+      this->_softwareOcclusionBuffers;
+  if (!this->_options.enableSoftwareOcclusionCulling ||
+      this->_options.enableLodTransitionPeriod) {
+    buffers.clear();
+    return;
+  }
+
+  CESIUM_TRACE("Tileset::_updateSoftwareOcclusionBuffers");
+
+  buffers.resize(frustums.size());
+  for (size_t i = 0; i < frustums.size(); ++i) {
+    buffers[i].reset(frustums[i], this->_options.softwareOcclusionBufferWidth);
+  }
+
+  // The tiles rendered in the last frame are still loaded, because the cache
+  // never unloads them.
+  for (const Tile* pTile : this->_updateResult.tilesToRenderThisFrame) {
+    if (pTile->getState() != TileLoadState::Done ||
+        !pTile->isRenderContent()) {
+      continue;
+    }
+
+    const BoundingRegion* pRegion =
+        getBoundingRegionFromBoundingVolume(pTile->getBoundingVolume());
+    if (pRegion == nullptr) {
+      continue;
+    }
+
+    for (SoftwareOcclusionBuffer& buffer : buffers) {
+      buffer.addOccluder(*pRegion);
     }
   }
 }
@@ -776,29 +1729,390 @@ void computeDistances(
       });
 }
 
-bool Tileset::_meetsSse(
+static double computeBoundingRadius(const BoundingVolume& boundingVolume) {
+  struct Operation {
+    double operator()(const OrientedBoundingBox& boundingBox) noexcept {
+      const glm::dmat3& halfAxes = boundingBox.getHalfAxes();
+      return glm::length(halfAxes[0] + halfAxes[1] + halfAxes[2]);
+    }
+
+    double operator()(const BoundingRegion& boundingRegion) noexcept {
+      return (*this)(boundingRegion.getBoundingBox());
+    }
+
+    double operator()(const BoundingSphere& boundingSphere) noexcept {
+      return boundingSphere.getRadius();
+    }
+
+    double operator()(
+        const BoundingRegionWithLooseFittingHeights& boundingRegion) noexcept {
+      return (*this)(boundingRegion.getBoundingRegion().getBoundingBox());
+    }
+
+    double operator()(const S2CellBoundingVolume& s2Cell) noexcept {
+      const glm::dvec3 center = s2Cell.getCenter();
+      double radius = 0.0;
+      for (const glm::dvec3& vertex : s2Cell.getVertices()) {
+        radius = glm::max(radius, glm::distance(center, vertex));
+      }
+      return radius;
+    }
+  };
+
+  return std::visit(Operation{}, boundingVolume);
+}
+
+/**
+ * @brief Computes the factor by which the screen-space error of a tile is
+ * multiplied in the given view, see
+ * {@link TilesetOptions::foveatedScreenSpaceError}.
+ *
+ * The falloff is based on the smallest angle between the view direction and
+ * the tile's bounding sphere, so that no part of a tile near the center of the
+ * view is ever relaxed.
+ */
+static double computeFoveatedScreenSpaceErrorFactor(
+    const ViewState& frustum,
+    const glm::dvec3& center,
+    double radius,
+    const FoveatedScreenSpaceErrorOptions& foveation) noexcept {
+  const glm::dvec3 toCenter = center - frustum.getPosition();
+  const double distanceToCenter = glm::length(toCenter);
+  if (distanceToCenter <= radius) {
+    // The camera is inside the tile's bounding sphere.
+    return 1.0;
+  }
+
+  const double cosAngleToCenter = glm::clamp(
+      glm::dot(toCenter / distanceToCenter, frustum.getDirection()),
+      -1.0,
+      1.0);
+  const double angle = glm::max(
+      glm::acos(cosAngleToCenter) - glm::asin(radius / distanceToCenter),
+      0.0);
+
+  const double tanHalfHorizontal =
+      glm::tan(0.5 * frustum.getHorizontalFieldOfView());
+  const double tanHalfVertical =
+      glm::tan(0.5 * frustum.getVerticalFieldOfView());
+  const double cornerAngle = glm::atan(glm::sqrt(
+      tanHalfHorizontal * tanHalfHorizontal +
+      tanHalfVertical * tanHalfVertical));
+
+  const double coneSize = glm::clamp(foveation.coneSize, 0.0, 1.0);
+  if (coneSize >= 1.0) {
+    return 1.0;
+  }
+
+  const double t =
+      glm::clamp((angle / cornerAngle - coneSize) / (1.0 - coneSize), 0.0, 1.0);
+  return glm::mix(
+      1.0,
+      glm::clamp(foveation.minimumScreenSpaceErrorFactor, 0.0, 1.0),
+      t);
+}
+
+static double computeLargestSse(
     const std::vector<ViewState>& frustums,
     const Tile& tile,
     const std::vector<double>& distances,
-    bool culled) const noexcept {
-
+    const std::optional<FoveatedScreenSpaceErrorOptions>& foveation) {
   double largestSse = 0.0;
 
+  glm::dvec3 center(0.0);
+  double radius = 0.0;
+  if (foveation) {
+    center = getBoundingVolumeCenter(tile.getBoundingVolume());
+    radius = computeBoundingRadius(tile.getBoundingVolume());
+  }
+
   for (size_t i = 0; i < frustums.size() && i < distances.size(); ++i) {
     const ViewState& frustum = frustums[i];
     const double distance = distances[i];
 
     // Does this tile meet the screen-space error?
-    const double sse =
+    double sse =
         frustum.computeScreenSpaceError(tile.getGeometricError(), distance);
+    if (foveation) {
+      sse *= computeFoveatedScreenSpaceErrorFactor(
+          frustum,
+          center,
+          radius,
+          *foveation);
+    }
     if (sse > largestSse) {
       largestSse = sse;
     }
   }
 
+  return largestSse;
+}
+
+/**
+ * @brief Estimates the largest fraction of any of the views that is covered by
+ * a bounding volume.
+ */
+static double computeScreenCoverage(
+    const std::vector<ViewState>& frustums,
+    const BoundingVolume& boundingVolume) {
+  const glm::dvec3 center = getBoundingVolumeCenter(boundingVolume);
+  const double radius = computeBoundingRadius(boundingVolume);
+
+  double largestCoverage = 0.0;
+  for (const ViewState& frustum : frustums) {
+    const double distanceToCenter =
+        glm::distance(center, frustum.getPosition());
+    if (distanceToCenter <= radius) {
+      return 1.0;
+    }
+
+    // Compare the areas of the projections of the bounding sphere and the view
+    // onto a plane at unit distance.
+    const double sinAngularRadius = radius / distanceToCenter;
+    const double tanAngularRadius =
+        sinAngularRadius / glm::sqrt(1.0 - sinAngularRadius * sinAngularRadius);
+    const double viewArea = 4.0 *
+                            glm::tan(0.5 * frustum.getHorizontalFieldOfView()) *
+                            glm::tan(0.5 * frustum.getVerticalFieldOfView());
+    const double coverage =
+        Math::OnePi * tanAngularRadius * tanAngularRadius / viewArea;
+    largestCoverage = glm::max(largestCoverage, glm::min(coverage, 1.0));
+  }
+
+  return largestCoverage;
+}
+
+/**
+ * @brief Computes the load priority of a tile for
+ * {@link TileLoadPriorityMode::ScreenSpaceErrorDeficit}.
+ *
+ * The result is between 0.0 and 1.0, and smaller for tiles that reduce the
+ * screen-space error more, over a larger part of the view. Loading a tile
+ * replaces its parent, so the error that is reduced is the larger of the
+ * parent's and the tile's own.
+ */
+static double computeDeficitPriority(
+    double parentSse,
+    double sse,
+    double maximumScreenSpaceError,
+    double screenCoverage) noexcept {
+  const double deficit = glm::max(parentSse, sse) /
+                         glm::max(maximumScreenSpaceError, Math::Epsilon5);
+  return 1.0 / (1.0 + deficit * screenCoverage);
+}
+
+bool Tileset::_meetsSse(double largestSse, bool culled) const noexcept {
   return culled ? !this->_options.enforceCulledScreenSpaceError ||
                       largestSse < this->_options.culledScreenSpaceError
-                : largestSse < this->_options.maximumScreenSpaceError;
+                : largestSse < this->_effectiveMaximumScreenSpaceError;
+}
+
+void Tileset::_prepareTileForVisit(Tile& tile, CullResult& cullResult) {
+  this->_pTilesetContentManager->updateTileContent(tile, _options);
+
+  // TODO: add cullWithChildrenBounds to the tile excluder interface?
+  if (this->_isTileExcluded(tile)) {
+    cullResult.culled = true;
+    cullResult.shouldVisit = false;
+  }
+}
+
+bool Tileset::_isTileExcluded(Tile& tile) const noexcept {
+  if (this->_options.excluders.empty()) {
+    return false;
+  }
+
+  // The excluders that included the parent along with all of its descendants
+  // this frame don't need to be asked about this tile. The parent is always
+  // visited before its children, so it's up to date unless the tile is
+  // visited on its own.
+  const Tile* pParent = tile.getParent();
+  uint64_t includedExcluders =
+      pParent && pParent->_cachedExclusion.excluderEpoch == this->_excluderEpoch
+          ? pParent->_cachedExclusion.includedExcluders
+          : 0;
+
+  const std::vector<std::shared_ptr<ITileExcluder>>& excluders =
+      this->_options.excluders;
+  for (size_t i = 0; i < excluders.size(); ++i) {
+    // Excluders beyond the bits of the mask are asked about every tile.
+    const uint64_t bit = i < 64 ? uint64_t(1) << i : 0;
+    if ((includedExcluders & bit) != 0) {
+      continue;
+    }
+
+    switch (excluders[i]->evaluateTile(tile)) {
+    case TileExclusion::Excluded:
+      tile._cachedExclusion.excluderEpoch = 0;
+      return true;
+    case TileExclusion::IncludedWithDescendants:
+      includedExcluders |= bit;
+      break;
+    case TileExclusion::Included:
+      break;
+    }
+  }
+
+  tile._cachedExclusion.excluderEpoch = this->_excluderEpoch;
+  tile._cachedExclusion.includedExcluders = includedExcluders;
+  return false;
+}
+
+void Tileset::_evaluateTile(
+    const FrameState& frameState,
+    Tile& tile,
+    std::vector<double>& distances,
+    TileViewEvaluation& evaluation) const {
+  Tile::CachedViewEvaluation& cached = tile._cachedViewEvaluation;
+  const Tile::CachedCullingVolume& cullingVolume = tile.updateCullingVolume();
+
+  // Only the view-dependent measurements are cached. How they're interpreted
+  // depends on the options, which may change from frame to frame.
+  if (frameState.viewEpoch == 0 || cached.viewEpoch != frameState.viewEpoch) {
+    computeDistances(tile, frameState.frustums, distances);
+    cached.tilePriority =
+        computeTilePriority(tile, frameState.frustums, distances);
+    cached.largestSse = computeLargestSse(
+        frameState.frustums,
+        tile,
+        distances,
+        this->_options.foveatedScreenSpaceError);
+    evaluation.screenSpaceErrorEvaluations =
+        static_cast<uint32_t>(frameState.frustums.size());
+    cached.visibleInFog = isVisibleInFogFromAnyCamera(
+        frameState.fogDensities,
+        distances,
+        evaluation.cullingTests);
+    cached.screenCoverage = -1.0;
+
+    // Culling with children bounds will give us incorrect results with Add
+    // refinement, but is a useful optimization for Replace refinement.
+    bool cullWithChildrenBounds =
+        tile.getRefine() == TileRefine::Replace && !tile.getChildren().empty();
+    if (cullWithChildrenBounds) {
+      tile.updateChildCullingVolumes();
+      cullWithChildrenBounds =
+          !tile._childCullingVolumes.anyUnconditionallyRefine;
+    }
+
+    cached.visibleFromCamera = this->_isVisibleFromAnyCamera(
+        tile,
+        cullingVolume,
+        frameState,
+        cullWithChildrenBounds,
+        evaluation.cullingTests);
+    cached.visibleAboveHorizon = isAboveHorizonForAnyCamera(
+        tile.updateHorizonCullingPoint(),
+        frameState.frustums,
+        evaluation.cullingTests);
+    cached.viewEpoch = frameState.viewEpoch;
+  }
+
+  if (this->_options.tileLoadPriorityMode == TileLoadPriorityMode::Distance) {
+    evaluation.tilePriority = cached.tilePriority;
+  } else {
+    if (cached.screenCoverage < 0.0) {
+      cached.screenCoverage =
+          computeScreenCoverage(frameState.frustums, tile.getBoundingVolume());
+    }
+
+    // A tile's parent is always evaluated before the tile in the same frame.
+    const Tile* pParent = tile.getParent();
+    evaluation.tilePriority = computeDeficitPriority(
+        pParent ? pParent->_cachedViewEvaluation.largestSse : 0.0,
+        cached.largestSse,
+        this->_effectiveMaximumScreenSpaceError,
+        cached.screenCoverage);
+  }
+
+  // TODO: abstract culling stages into composable interface?
+  CullResult& cullResult = evaluation.cullResult;
+  this->_frustumCull(cached.visibleFromCamera, cullResult);
+  this->_fogCull(cached.visibleInFog, cullResult);
+  this->_horizonCull(cached.visibleAboveHorizon, cullResult);
+  this->_softwareOcclusionCull(
+      cullingVolume.box,
+      cullResult,
+      evaluation.cullingTests);
+
+  evaluation.meetsSse = this->_meetsSse(cached.largestSse, cullResult.culled);
+}
+
+namespace {
+// The number of tiles evaluated by each task when children are evaluated in
+// parallel. Smaller tasks don't amortize the cost of dispatching them.
+constexpr size_t parallelTraversalTilesPerTask = 64;
+} // namespace
+
+std::vector<Tileset::TileViewEvaluation>
+Tileset::_evaluateChildrenInParallel(const FrameState& frameState, Tile& tile) {
+  CESIUM_TRACE("Tileset::_evaluateChildrenInParallel");
+
+  gsl::span<Tile> children = tile.getChildren();
+  std::vector<TileViewEvaluation> evaluations(children.size());
+
+  // Content updates may create grandchildren and excluders are user code, so
+  // both must happen in this thread, and before the children are evaluated.
+  for (size_t i = 0; i < children.size(); ++i) {
+    this->_prepareTileForVisit(children[i], evaluations[i].cullResult);
+  }
+
+  // The ranges of children are taken in order by this thread and by worker
+  // tasks, so that this thread evaluates all of them itself if no worker task
+  // starts in time. It then only waits for the ranges that workers are
+  // evaluating, never for tasks that are still queued behind other work.
+  // Each range is only written by the thread that took it, and nothing
+  // modifies the tile hierarchy until all of them are done.
+  struct ParallelEvaluation {
+    std::atomic<size_t> nextRange = 0;
+    size_t rangeCount = 0;
+    std::mutex mutex;
+    std::condition_variable rangeFinished;
+    size_t rangesFinished = 0;
+  };
+
+  auto pEvaluation = std::make_shared<ParallelEvaluation>();
+  pEvaluation->rangeCount =
+      (children.size() + parallelTraversalTilesPerTask - 1) /
+      parallelTraversalTilesPerTask;
+
+  // The worker tasks may outlive this function, so they only use its locals
+  // after taking a range, which it waits for.
+  auto evaluateRanges =
+      [this, pEvaluation, &frameState, children, &evaluations]() {
+        std::vector<double> distances;
+        for (size_t range = pEvaluation->nextRange++;
+             range < pEvaluation->rangeCount;
+             range = pEvaluation->nextRange++) {
+          const size_t begin = range * parallelTraversalTilesPerTask;
+          const size_t end =
+              std::min(children.size(), begin + parallelTraversalTilesPerTask);
+          for (size_t i = begin; i < end; ++i) {
+            this->_evaluateTile(
+                frameState,
+                children[i],
+                distances,
+                evaluations[i]);
+          }
+
+          std::lock_guard<std::mutex> lock(pEvaluation->mutex);
+          ++pEvaluation->rangesFinished;
+          pEvaluation->rangeFinished.notify_one();
+        }
+      };
+
+  for (size_t i = 1; i < pEvaluation->rangeCount; ++i) {
+    this->_asyncSystem.runInWorkerThread(evaluateRanges);
+  }
+
+  evaluateRanges();
+
+  std::unique_lock<std::mutex> lock(pEvaluation->mutex);
+  pEvaluation->rangeFinished.wait(lock, [&pEvaluation]() {
+    return pEvaluation->rangesFinished == pEvaluation->rangeCount;
+  });
+
+  return evaluations;
 }
 
 // Visits a tile for possible rendering. When we call this function with a tile:
@@ -811,43 +2125,46 @@ Tileset::TraversalDetails Tileset::_visitTileIfNeeded(
     const FrameState& frameState,
     uint32_t depth,
     bool ancestorMeetsSse,
+    const SkipLevelOfDetailAncestor& skipAncestor,
     Tile& tile,
     ViewUpdateResult& result) {
+  TileViewEvaluation evaluation{};
+  this->_prepareTileForVisit(tile, evaluation.cullResult);
+  this->_evaluateTile(frameState, tile, this->_distances, evaluation);
 
-  std::vector<double>& distances = this->_distances;
-  computeDistances(tile, frameState.frustums, distances);
-  double tilePriority =
-      computeTilePriority(tile, frameState.frustums, distances);
+  return this->_visitEvaluatedTile(
+      frameState,
+      depth,
+      ancestorMeetsSse,
+      skipAncestor,
+      tile,
+      evaluation,
+      result);
+}
 
-  this->_pTilesetContentManager->updateTileContent(tile, _options);
+// Like _visitTileIfNeeded, but the tile has already been prepared for the visit
+// and evaluated against the frustums.
+Tileset::TraversalDetails Tileset::_visitEvaluatedTile(
+    const FrameState& frameState,
+    uint32_t depth,
+    bool ancestorMeetsSse,
+    const SkipLevelOfDetailAncestor& skipAncestor,
+    Tile& tile,
+    const TileViewEvaluation& evaluation,
+    ViewUpdateResult& result) {
+  // The tile is marked as visited here, rather than when it is prepared for
+  // the visit, so that the loaded tiles stay in depth-first order even when
+  // the children of a tile are all prepared before any of them is visited.
   this->_markTileVisited(tile);
 
-  CullResult cullResult{};
-
-  // Culling with children bounds will give us incorrect results with Add
-  // refinement, but is a useful optimization for Replace refinement.
-  bool cullWithChildrenBounds =
-      tile.getRefine() == TileRefine::Replace && !tile.getChildren().empty();
-  for (Tile& child : tile.getChildren()) {
-    if (child.getUnconditionallyRefine()) {
-      cullWithChildrenBounds = false;
-      break;
-    }
-  }
-
-  // TODO: add cullWithChildrenBounds to the tile excluder interface?
-  for (const std::shared_ptr<ITileExcluder>& pExcluder :
-       this->_options.excluders) {
-    if (pExcluder->shouldExclude(tile)) {
-      cullResult.culled = true;
-      cullResult.shouldVisit = false;
-      break;
-    }
+  if (this->_options.enableSubtreePruning && !tile.getChildren().empty()) {
+    this->_subtreePruningCandidates.emplace_back(&tile);
   }
 
-  // TODO: abstract culling stages into composable interface?
-  this->_frustumCull(tile, frameState, cullWithChildrenBounds, cullResult);
-  this->_fogCull(frameState, distances, cullResult);
+  const double tilePriority = evaluation.tilePriority;
+  CullResult cullResult = evaluation.cullResult;
+  result.screenSpaceErrorEvaluations += evaluation.screenSpaceErrorEvaluations;
+  result.cullingTests += evaluation.cullingTests;
 
   if (!cullResult.shouldVisit && tile.getUnconditionallyRefine()) {
     // Unconditionally refined tiles must always be visited in forbidHoles
@@ -896,14 +2213,12 @@ Tileset::TraversalDetails Tileset::_visitTileIfNeeded(
     ++result.culledTilesVisited;
   }
 
-  bool meetsSse =
-      this->_meetsSse(frameState.frustums, tile, distances, cullResult.culled);
-
   return this->_visitTile(
       frameState,
       depth,
-      meetsSse,
+      evaluation.meetsSse,
       ancestorMeetsSse,
+      skipAncestor,
       tile,
       tilePriority,
       result);
@@ -925,7 +2240,11 @@ Tileset::TraversalDetails Tileset::_renderLeaf(
   tile.setLastSelectionState(TileSelectionState(
       frameState.currentFrameNumber,
       TileSelectionState::Result::Rendered));
-  result.tilesToRenderThisFrame.push_back(&tile);
+  this->_addTileToRenderList(
+      tile,
+      lastFrameSelectionState,
+      frameState.lastFrameNumber,
+      result);
 
   addTileToLoadQueue(tile, TileLoadPriorityGroup::Normal, tilePriority);
 
@@ -978,7 +2297,11 @@ Tileset::TraversalDetails Tileset::_renderInnerTile(
   tile.setLastSelectionState(TileSelectionState(
       frameState.currentFrameNumber,
       TileSelectionState::Result::Rendered));
-  result.tilesToRenderThisFrame.push_back(&tile);
+  this->_addTileToRenderList(
+      tile,
+      lastFrameSelectionState,
+      frameState.lastFrameNumber,
+      result);
 
   return Tileset::createTraversalDetailsForSingleTile(
       frameState,
@@ -994,7 +2317,11 @@ bool Tileset::_loadAndRenderAdditiveRefinedTile(
   // If this tile uses additive refinement, we need to render this tile in
   // addition to its children.
   if (tile.getRefine() == TileRefine::Add) {
-    result.tilesToRenderThisFrame.push_back(&tile);
+    this->_addTileToRenderList(
+        tile,
+        tile.getLastSelectionState(),
+        this->_previousFrameNumber,
+        result);
     if (!queuedForLoad)
       addTileToLoadQueue(tile, TileLoadPriorityGroup::Normal, tilePriority);
     return true;
@@ -1014,6 +2341,7 @@ bool Tileset::_kickDescendantsAndRenderTile(
     size_t workerThreadLoadQueueIndex,
     size_t mainThreadLoadQueueIndex,
     bool queuedForLoad,
+    bool skipped,
     double tilePriority) {
   const TileSelectionState lastFrameSelectionState =
       tile.getLastSelectionState();
@@ -1041,7 +2369,11 @@ bool Tileset::_kickDescendantsAndRenderTile(
       renderList.end());
 
   if (tile.getRefine() != Cesium3DTilesSelection::TileRefine::Add) {
-    renderList.push_back(&tile);
+    this->_addTileToRenderList(
+        tile,
+        lastFrameSelectionState,
+        frameState.lastFrameNumber,
+        result);
   }
 
   tile.setLastSelectionState(TileSelectionState(
@@ -1053,14 +2385,14 @@ bool Tileset::_kickDescendantsAndRenderTile(
   // tell the up-level we're only waiting on this tile. Keep doing this until we
   // actually manage to render this tile.
   // Make sure we don't end up waiting on a tile that will _never_ be
-  // renderable.
+  // renderable, or on a tile whose level of detail is skipped.
   const bool wasRenderedLastFrame =
       lastFrameSelectionState.getResult(frameState.lastFrameNumber) ==
       TileSelectionState::Result::Rendered;
   const bool wasReallyRenderedLastFrame =
       wasRenderedLastFrame && tile.isRenderable();
 
-  if (!wasReallyRenderedLastFrame &&
+  if (!wasReallyRenderedLastFrame && !skipped &&
       traversalDetails.notYetRenderableCount >
           this->_options.loadingDescendantLimit &&
       !tile.isExternalContent() && !tile.getUnconditionallyRefine()) {
@@ -1203,6 +2535,7 @@ Tileset::TraversalDetails Tileset::_visitTile(
     bool meetsSse,
     bool ancestorMeetsSse, // Careful: May be modified before being passed to
                            // children!
+    const SkipLevelOfDetailAncestor& skipAncestor,
     Tile& tile,
     double tilePriority,
     ViewUpdateResult& result) {
@@ -1290,6 +2623,7 @@ Tileset::TraversalDetails Tileset::_visitTile(
       if (meetsSse && !ancestorMeetsSse) {
         addTileToLoadQueue(tile, TileLoadPriorityGroup::Normal, tilePriority);
       }
+      this->_addExternalTilesetPrefetchCandidates(frameState, tile);
       return _renderInnerTile(frameState, tile, result);
     }
 
@@ -1314,6 +2648,32 @@ Tileset::TraversalDetails Tileset::_visitTile(
 
   // Refine!
 
+  // When skipping levels of detail, the base of the tileset is always loaded,
+  // but the tiles between it and the ones that meet the SSE are only loaded
+  // every few levels, to fall back on while the ones below them load. Tiles
+  // that are already loaded are kept as fallbacks, too.
+  const double largestSse = tile._cachedViewEvaluation.largestSse;
+  bool skipped = false;
+  SkipLevelOfDetailAncestor childSkipAncestor{depth, largestSse};
+  if (this->_options.skipLevelOfDetail && !meetsSse &&
+      tile.getRefine() == TileRefine::Replace && !unconditionallyRefine) {
+    const bool isBase = tile.getParent() == nullptr ||
+                        largestSse > this->_options.baseScreenSpaceError;
+    const bool reachedSkipThreshold =
+        depth > skipAncestor.depth + this->_options.skipLevels &&
+        largestSse * this->_options.skipScreenSpaceErrorFactor <
+            skipAncestor.largestSse;
+    if (isBase || reachedSkipThreshold) {
+      if (!queuedForLoad) {
+        addTileToLoadQueue(tile, TileLoadPriorityGroup::Normal, tilePriority);
+        queuedForLoad = true;
+      }
+    } else if (!tile.isRenderable()) {
+      skipped = true;
+      childSkipAncestor = skipAncestor;
+    }
+  }
+
   queuedForLoad = _loadAndRenderAdditiveRefinedTile(
                       tile,
                       result,
@@ -1330,6 +2690,7 @@ Tileset::TraversalDetails Tileset::_visitTile(
       frameState,
       depth,
       ancestorMeetsSse,
+      childSkipAncestor,
       tile,
       result);
 
@@ -1363,6 +2724,7 @@ Tileset::TraversalDetails Tileset::_visitTile(
         workerThreadLoadQueueIndex,
         mainThreadLoadQueueIndex,
         queuedForLoad,
+        skipped,
         tilePriority);
   } else {
     if (tile.getRefine() != TileRefine::Add) {
@@ -1373,7 +2735,7 @@ Tileset::TraversalDetails Tileset::_visitTile(
         TileSelectionState::Result::Refined));
   }
 
-  if (this->_options.preloadAncestors && !queuedForLoad) {
+  if (this->_options.preloadAncestors && !queuedForLoad && !skipped) {
     addTileToLoadQueue(tile, TileLoadPriorityGroup::Preload, tilePriority);
   }
 
@@ -1384,113 +2746,845 @@ Tileset::TraversalDetails Tileset::_visitVisibleChildrenNearToFar(
     const FrameState& frameState,
     uint32_t depth,
     bool ancestorMeetsSse,
+    const SkipLevelOfDetailAncestor& skipAncestor,
     Tile& tile,
     ViewUpdateResult& result) {
   TraversalDetails traversalDetails;
 
+  auto accumulate = [&traversalDetails](const TraversalDetails& child) {
+    traversalDetails.allAreRenderable &= child.allAreRenderable;
+    traversalDetails.anyWereRenderedLastFrame |= child.anyWereRenderedLastFrame;
+    traversalDetails.notYetRenderableCount += child.notYetRenderableCount;
+  };
+
   // TODO: actually visit near-to-far, rather than in order of occurrence.
   gsl::span<Tile> children = tile.getChildren();
-  for (Tile& child : children) {
-    const TraversalDetails childTraversal = this->_visitTileIfNeeded(
-        frameState,
-        depth + 1,
-        ancestorMeetsSse,
-        child,
-        result);
-
-    traversalDetails.allAreRenderable &= childTraversal.allAreRenderable;
-    traversalDetails.anyWereRenderedLastFrame |=
-        childTraversal.anyWereRenderedLastFrame;
-    traversalDetails.notYetRenderableCount +=
-        childTraversal.notYetRenderableCount;
+  if (this->_options.enableParallelTraversal &&
+      children.size() >= this->_options.parallelTraversalMinimumChildren) {
+    const std::vector<TileViewEvaluation> evaluations =
+        this->_evaluateChildrenInParallel(frameState, tile);
+    for (size_t i = 0; i < children.size(); ++i) {
+      accumulate(this->_visitEvaluatedTile(
+          frameState,
+          depth + 1,
+          ancestorMeetsSse,
+          skipAncestor,
+          children[i],
+          evaluations[i],
+          result));
+    }
+  } else {
+    for (Tile& child : children) {
+      accumulate(this->_visitTileIfNeeded(
+          frameState,
+          depth + 1,
+          ancestorMeetsSse,
+          skipAncestor,
+          child,
+          result));
+    }
   }
 
   return traversalDetails;
 }
 
-void Tileset::_processWorkerThreadLoadQueue() {
-  CESIUM_TRACE("Tileset::_processWorkerThreadLoadQueue");
-
-  int32_t maximumSimultaneousTileLoads =
-      static_cast<int32_t>(this->_options.maximumSimultaneousTileLoads);
+void Tileset::_prefetchPredictedViews(
+    int32_t currentFrameNumber,
+    ViewUpdateResult& result) {
+  CESIUM_TRACE("Tileset::_prefetchPredictedViews");
 
-  if (this->_pTilesetContentManager->getNumberOfTilesLoading() >=
-      maximumSimultaneousTileLoads) {
+  Tile* pRootTile = this->getRootTile();
+  if (!pRootTile) {
     return;
   }
 
-  std::vector<TileLoadTask>& queue = this->_workerThreadLoadQueue;
-  std::sort(queue.begin(), queue.end());
-
-  for (TileLoadTask& task : queue) {
-    this->_pTilesetContentManager->loadTileContent(*task.pTile, _options);
-    if (this->_pTilesetContentManager->getNumberOfTilesLoading() >=
-        maximumSimultaneousTileLoads) {
-      break;
-    }
+  // Tiles needed by the current views are already queued with a higher
+  // priority, and a tile must not be queued twice.
+  std::unordered_set<const Tile*> queuedTiles;
+  for (const TileLoadTask& task : this->_workerThreadLoadQueue) {
+    queuedTiles.insert(task.pTile);
+  }
+  for (const TileLoadTask& task : this->_mainThreadLoadQueue) {
+    queuedTiles.insert(task.pTile);
   }
-}
-void Tileset::_processMainThreadLoadQueue() {
-  CESIUM_TRACE("Tileset::_processMainThreadLoadQueue");
-  // Process deferred main-thread load tasks with a time budget.
-
-  std::sort(
-      this->_mainThreadLoadQueue.begin(),
-      this->_mainThreadLoadQueue.end());
 
-  double timeBudget = this->_options.mainThreadLoadingTimeLimit;
+  const std::vector<ViewState>& frustums = this->_predictedViews;
+  std::vector<double> fogDensities(frustums.size());
+  std::transform(
+      frustums.begin(),
+      frustums.end(),
+      fogDensities.begin(),
+      [&fogDensityTable =
+           this->_options.fogDensityTable](const ViewState& frustum) -> double {
+        return computeFogDensity(fogDensityTable, frustum);
+      });
 
-  auto start = std::chrono::system_clock::now();
-  auto end =
-      start + std::chrono::milliseconds(static_cast<long long>(timeBudget));
-  for (TileLoadTask& task : this->_mainThreadLoadQueue) {
-    // We double-check that the tile is still in the ContentLoaded state here,
-    // in case something (such as a child that needs to upsample from this
-    // parent) already pushed the tile into the Done state. Because in that
-    // case, calling finishLoading here would assert or crash.
-    if (task.pTile->getState() == TileLoadState::ContentLoaded &&
-        task.pTile->isRenderContent()) {
-      this->_pTilesetContentManager->finishLoading(*task.pTile, this->_options);
-    }
-    auto time = std::chrono::system_clock::now();
-    if (timeBudget > 0.0 && time >= end) {
-      break;
-    }
-  }
+  // The view epoch is 0 because cached evaluations belong to the current
+  // views, not the predicted ones.
+  FrameState frameState{
+      frustums,
+      std::move(fogDensities),
+      currentFrameNumber - 1,
+      currentFrameNumber,
+      0};
 
-  this->_mainThreadLoadQueue.clear();
+  this->_prefetchTile(
+      frameState,
+      queuedTiles,
+      *pRootTile,
+      0.0,
+      result.cullingTests);
 }
 
-void Tileset::_unloadCachedTiles(double timeBudget) noexcept {
-  const int64_t maxBytes = this->getOptions().maximumCachedBytes;
+// Queues the tiles that a traversal for the predicted views would render,
+// without changing the selection state of any tile. Unlike _visitTile, this
+// doesn't need to worry about holes or about what was rendered last frame.
+void Tileset::_prefetchTile(
+    const FrameState& frameState,
+    const std::unordered_set<const Tile*>& queuedTiles,
+    Tile& tile,
+    double parentSse,
+    uint32_t& cullingTests) {
+  // Creates children of implicit tiles as needed. Marking the tile as visited
+  // keeps its content from being unloaded by the cache this frame, and lets it
+  // be unloaded later once it's no longer needed.
+  this->_pTilesetContentManager->updateTileContent(tile, this->_options);
+  this->_markTileVisited(tile);
 
-  const Tile* pRootTile = this->_pTilesetContentManager->getRootTile();
-  Tile* pTile = this->_loadedTiles.head();
+  if (!tile.getChildren().empty()) {
+    this->_prefetchedTiles.insert(&tile);
+  }
+
+  if (this->_isTileExcluded(tile)) {
+    return;
+  }
+
+  const std::vector<ViewState>& frustums = frameState.frustums;
+  std::vector<double>& distances = this->_distances;
+  computeDistances(tile, frustums, distances);
+
+  CullResult cullResult{};
+  this->_frustumCull(
+      this->_isVisibleFromAnyCamera(
+          tile,
+          tile.updateCullingVolume(),
+          frameState,
+          false,
+          cullingTests),
+      cullResult);
+  this->_fogCull(
+      isVisibleInFogFromAnyCamera(
+          frameState.fogDensities,
+          distances,
+          cullingTests),
+      cullResult);
+  this->_horizonCull(
+      isAboveHorizonForAnyCamera(
+          tile.updateHorizonCullingPoint(),
+          frustums,
+          cullingTests),
+      cullResult);
+  if (!cullResult.shouldVisit) {
+    return;
+  }
+
+  const double largestSse = computeLargestSse(
+      frustums,
+      tile,
+      distances,
+      this->_options.foveatedScreenSpaceError);
+  const bool meetsSse = this->_meetsSse(largestSse, cullResult.culled);
+
+  // Additive-refined tiles are rendered along with their children.
+  if (!tile.getUnconditionallyRefine() &&
+      (meetsSse || isLeaf(tile) || tile.getRefine() == TileRefine::Add) &&
+      queuedTiles.find(&tile) == queuedTiles.end()) {
+    const double priority =
+        this->_options.tileLoadPriorityMode == TileLoadPriorityMode::Distance
+            ? computeTilePriority(tile, frustums, distances)
+            : computeDeficitPriority(
+                  parentSse,
+                  largestSse,
+                  this->_effectiveMaximumScreenSpaceError,
+                  computeScreenCoverage(frustums, tile.getBoundingVolume()));
+    this->addTileToLoadQueue(tile, TileLoadPriorityGroup::Prefetch, priority);
+  }
+
+  if (meetsSse && !tile.getUnconditionallyRefine()) {
+    return;
+  }
+
+  for (Tile& child : tile.getChildren()) {
+    this->_prefetchTile(
+        frameState,
+        queuedTiles,
+        child,
+        largestSse,
+        cullingTests);
+  }
+}
+
+void Tileset::_selectTilesForRenderOnlyViews(ViewUpdateResult& result) {
+  std::vector<std::vector<Tile*>>& tilesPerView = result.renderOnlyViewTiles;
+  tilesPerView.resize(this->_renderOnlyViews.size());
+  for (std::vector<Tile*>& tiles : tilesPerView) {
+    tiles.clear();
+  }
+
+  Tile* pRootTile = this->getRootTile();
+  if (!pRootTile) {
+    return;
+  }
+
+  for (size_t i = 0; i < this->_renderOnlyViews.size(); ++i) {
+    const std::vector<ViewState> frustums{this->_renderOnlyViews[i]};
+
+    // The view epoch is 0 because cached evaluations belong to the current
+    // views, not the render-only ones.
+    FrameState frameState{
+        frustums,
+        {computeFogDensity(this->_options.fogDensityTable, frustums[0])},
+        this->_previousFrameNumber,
+        this->_previousFrameNumber + 1,
+        0};
+    this->_selectLoadedTiles(
+        frameState,
+        *pRootTile,
+        tilesPerView[i],
+        result.cullingTests);
+  }
+}
+
+// Selects the tiles to render for a render-only view from the tiles that are
+// already loaded, without queuing any loads. Returns false if nothing could
+// be selected for the tile, so that the caller can fill the hole. Unlike
+// _visitTile, this doesn't change the selection state of any tile.
+bool Tileset::_selectLoadedTiles(
+    const FrameState& frameState,
+    Tile& tile,
+    std::vector<Tile*>& tiles,
+    uint32_t& cullingTests) {
+  if (this->_isTileExcluded(tile)) {
+    return true;
+  }
+
+  const std::vector<ViewState>& frustums = frameState.frustums;
+  std::vector<double>& distances = this->_distances;
+  computeDistances(tile, frustums, distances);
+
+  CullResult cullResult{};
+  this->_frustumCull(
+      this->_isVisibleFromAnyCamera(
+          tile,
+          tile.updateCullingVolume(),
+          frameState,
+          false,
+          cullingTests),
+      cullResult);
+  this->_fogCull(
+      isVisibleInFogFromAnyCamera(
+          frameState.fogDensities,
+          distances,
+          cullingTests),
+      cullResult);
+  this->_horizonCull(
+      isAboveHorizonForAnyCamera(
+          tile.updateHorizonCullingPoint(),
+          frustums,
+          cullingTests),
+      cullResult);
+  if (!cullResult.shouldVisit) {
+    return true;
+  }
+
+  const double largestSse = computeLargestSse(
+      frustums,
+      tile,
+      distances,
+      this->_options.foveatedScreenSpaceError);
+  const bool meetsSse = this->_meetsSse(largestSse, cullResult.culled) &&
+                        !tile.getUnconditionallyRefine();
+
+  // Marking the selected tiles as visited keeps their content from being
+  // unloaded before they are rendered.
+  if (tile.getRefine() == TileRefine::Add) {
+    if (tile.isRenderable() && tile.isRenderContent()) {
+      this->_markTileVisited(tile);
+      tiles.emplace_back(&tile);
+    }
+    if (!meetsSse) {
+      for (Tile& child : tile.getChildren()) {
+        this->_selectLoadedTiles(frameState, child, tiles, cullingTests);
+      }
+    }
+    return true;
+  }
+
+  if (!meetsSse && !isLeaf(tile)) {
+    const size_t firstChildTile = tiles.size();
+    bool childrenSelected = true;
+    for (Tile& child : tile.getChildren()) {
+      childrenSelected =
+          this->_selectLoadedTiles(frameState, child, tiles, cullingTests) &&
+          childrenSelected;
+    }
+    if (childrenSelected) {
+      return true;
+    }
+
+    // Render this tile instead of the children if they would leave a hole.
+    if (!tile.isRenderable()) {
+      return false;
+    }
+    tiles.resize(firstChildTile);
+  } else if (!tile.isRenderable()) {
+    return false;
+  }
+
+  this->_markTileVisited(tile);
+  if (tile.isRenderContent()) {
+    tiles.emplace_back(&tile);
+  }
+  return true;
+}
+
+void Tileset::_addExternalTilesetPrefetchCandidates(
+    const FrameState& frameState,
+    Tile& tile) {
+  if (this->_options.externalTilesetPrefetchCount == 0) {
+    return;
+  }
+
+  for (Tile& child : tile.getChildren()) {
+    const TilesetContentLoader* pLoader = child.getLoader();
+    if (child.getState() != TileLoadState::Unloaded || pLoader == nullptr ||
+        !pLoader->mayHaveExternalTileset(child)) {
+      continue;
+    }
+
+    std::vector<double>& distances = this->_distances;
+    computeDistances(child, frameState.frustums, distances);
+    const auto nearestIt = std::min_element(distances.begin(), distances.end());
+    this->_externalTilesetPrefetchCandidates.emplace_back(
+        nearestIt != distances.end() ? *nearestIt : 0.0,
+        &child);
+  }
+}
+
+// Queues the nearest of the children of rendered tiles that refer to external
+// tilesets, so that their tiles are ready once the rendered tiles are refined.
+void Tileset::_prefetchExternalTilesets() {
+  std::vector<std::pair<double, Tile*>>& candidates =
+      this->_externalTilesetPrefetchCandidates;
+  if (candidates.empty()) {
+    return;
+  }
+
+  CESIUM_TRACE("Tileset::_prefetchExternalTilesets");
+
+  // The predicted views or the height requests may already have queued some of
+  // the candidates, and a tile must not be queued twice.
+  std::unordered_set<const Tile*> queuedTiles;
+  for (const TileLoadTask& task : this->_workerThreadLoadQueue) {
+    queuedTiles.insert(task.pTile);
+  }
+  for (const TileLoadTask& task : this->_mainThreadLoadQueue) {
+    queuedTiles.insert(task.pTile);
+  }
+
+  const size_t count = std::min(
+      candidates.size(),
+      size_t(this->_options.externalTilesetPrefetchCount));
+  std::partial_sort(
+      candidates.begin(),
+      candidates.begin() + std::ptrdiff_t(count),
+      candidates.end(),
+      [](const std::pair<double, Tile*>& lhs,
+         const std::pair<double, Tile*>& rhs) {
+        return lhs.first < rhs.first;
+      });
+
+  for (size_t i = 0; i < count; ++i) {
+    Tile& tile = *candidates[i].second;
+    if (queuedTiles.find(&tile) != queuedTiles.end()) {
+      continue;
+    }
+
+    // Marking the tile as visited lets its content be unloaded later, in case
+    // it turns out not to be an external tileset.
+    this->_markTileVisited(tile);
+    addTileToLoadQueue(
+        tile,
+        TileLoadPriorityGroup::Preload,
+        candidates[i].first);
+  }
+}
+
+void Tileset::_processHeightRequests() {
+  if (this->_heightRequests.empty()) {
+    return;
+  }
+
+  CESIUM_TRACE("Tileset::_processHeightRequests");
+
+  Tile* pRootTile = this->getRootTile();
+  if (!pRootTile) {
+    return;
+  }
+
+  // A tile must not be queued twice, and the tiles of the current and
+  // predicted views are queued already. Tiles needed by several queries are
+  // only queued once.
+  std::unordered_set<const Tile*> queuedTiles;
+  for (const TileLoadTask& task : this->_workerThreadLoadQueue) {
+    queuedTiles.insert(task.pTile);
+  }
+  for (const TileLoadTask& task : this->_mainThreadLoadQueue) {
+    queuedTiles.insert(task.pTile);
+  }
+
+  auto it = this->_heightRequests.begin();
+  while (it != this->_heightRequests.end()) {
+    // The candidates of every query are found even once a query turns out not
+    // to be ready, so that all of the tiles that are needed load at once.
+    bool ready = true;
+    for (TilesetHeightQuery& query : it->queries) {
+      query.candidateTiles.clear();
+      ready = this->_findHeightQueryCandidates(
+                  *it,
+                  query,
+                  queuedTiles,
+                  *pRootTile) &&
+              ready;
+    }
+
+    if (ready) {
+      it->resolve();
+      it = this->_heightRequests.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+// Finds the most detailed tiles whose content the ray of the query may hit,
+// and queues the ones that aren't loaded yet. Returns whether all of them are
+// loaded.
+bool Tileset::_findHeightQueryCandidates(
+    TilesetHeightRequest& request,
+    TilesetHeightQuery& query,
+    std::unordered_set<const Tile*>& queuedTiles,
+    Tile& tile) {
+  if (!IntersectionTests::rayOBBParametric(
+          query.ray,
+          tile.updateCullingVolume().box)) {
+    return true;
+  }
+
+  // As in _prefetchTile, except that the root tile isn't marked as visited
+  // again, because it marks the beginning of the tiles that were visited for
+  // the current views.
+  this->_pTilesetContentManager->updateTileContent(tile, this->_options);
+  if (&tile != this->getRootTile()) {
+    this->_markTileVisited(tile);
+  }
+
+  if (!tile.getChildren().empty()) {
+    this->_prefetchedTiles.insert(&tile);
+  }
+
+  // The content of a tile is needed when it has no children, and when it is
+  // refined by adding its children. Tiles without children may also get some
+  // once they're loaded, as external tilesets do.
+  bool ready = true;
+  if (tile.getChildren().empty() || tile.getRefine() == TileRefine::Add) {
+    const TileLoadState state = tile.getState();
+    if (state == TileLoadState::Done) {
+      if (tile.isRenderContent()) {
+        query.candidateTiles.emplace_back(&tile);
+      }
+    } else if (state == TileLoadState::Failed) {
+      request.anyTileFailed = true;
+    } else {
+      ready = false;
+      if (queuedTiles.insert(&tile).second) {
+        this->addTileToLoadQueue(tile, TileLoadPriorityGroup::Urgent, 0.0);
+      }
+    }
+  }
+
+  // The children of an implicit tile are created once its subtree is loaded.
+  if (tile.getChildren().empty() && tile.shouldContentContinueUpdating()) {
+    ready = false;
+  }
+
+  for (Tile& child : tile.getChildren()) {
+    ready =
+        this->_findHeightQueryCandidates(request, query, queuedTiles, child) &&
+        ready;
+  }
+
+  return ready;
+}
+
+void Tileset::_processFetchRequests() {
+  if (this->_fetchRequests.empty()) {
+    return;
+  }
+
+  CESIUM_TRACE("Tileset::_processFetchRequests");
+
+  Tile* pRootTile = this->getRootTile();
+  if (!pRootTile) {
+    return;
+  }
+
+  // As in _processHeightRequests, a tile must not be queued twice.
+  std::unordered_set<const Tile*> queuedTiles;
+  for (const TileLoadTask& task : this->_workerThreadLoadQueue) {
+    queuedTiles.insert(task.pTile);
+  }
+  for (const TileLoadTask& task : this->_mainThreadLoadQueue) {
+    queuedTiles.insert(task.pTile);
+  }
+
+  auto it = this->_fetchRequests.begin();
+  while (it != this->_fetchRequests.end()) {
+    it->result.tilesLoaded = 0;
+    it->result.tilesFailed = 0;
+    if (this->_fetchRegionTiles(*it, queuedTiles, *pRootTile, 0)) {
+      it->promise.resolve(std::move(it->result));
+      it = this->_fetchRequests.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+namespace {
+bool isTileInRegion(const Tile& tile, const TileFetchRegion& region) {
+  const std::optional<GlobeRectangle> maybeRectangle =
+      estimateGlobeRectangle(tile.getBoundingVolume());
+  if (!maybeRectangle) {
+    // Without a rectangle, the tile can't be ruled out.
+    return true;
+  }
+
+  if (!region.rectangle.computeIntersection(*maybeRectangle)) {
+    return false;
+  }
+
+  return region.polygons.empty() ||
+         !CartographicPolygon::rectangleIsOutsidePolygons(
+             *maybeRectangle,
+             region.polygons);
+}
+} // namespace
+
+// Queues the tiles of the region that aren't loaded yet, coarser tiles first,
+// and counts the ones that are. Returns whether all of them are loaded or
+// have failed.
+bool Tileset::_fetchRegionTiles(
+    TilesetFetchRequest& request,
+    std::unordered_set<const Tile*>& queuedTiles,
+    Tile& tile,
+    uint32_t level) {
+  // Upsampled tiles are made from their parents, so there is nothing to fetch
+  // for them.
+  if (std::holds_alternative<UpsampledQuadtreeNode>(tile.getTileID()) ||
+      !isTileInRegion(tile, request.region)) {
+    return true;
+  }
+
+  // As in _findHeightQueryCandidates.
+  this->_pTilesetContentManager->updateTileContent(tile, this->_options);
+  if (&tile != this->getRootTile()) {
+    this->_markTileVisited(tile);
+  }
+
+  if (!tile.getChildren().empty()) {
+    this->_prefetchedTiles.insert(&tile);
+  }
+
+  bool ready = true;
+  const TileLoadState state = tile.getState();
+  if (state == TileLoadState::Done) {
+    ++request.result.tilesLoaded;
+  } else if (state == TileLoadState::Failed) {
+    ++request.result.tilesFailed;
+  } else {
+    ready = false;
+    if (queuedTiles.insert(&tile).second) {
+      this->addTileToLoadQueue(
+          tile,
+          TileLoadPriorityGroup::Preload,
+          double(level));
+    }
+  }
+
+  if (tile.getGeometricError() <= request.region.maximumGeometricError ||
+      level >= request.region.maximumLevel) {
+    return ready;
+  }
+
+  // The children of an implicit tile are created once its subtree is loaded,
+  // and those of an external tileset once its content is.
+  if (tile.getChildren().empty() && tile.shouldContentContinueUpdating()) {
+    ready = false;
+  }
+
+  for (Tile& child : tile.getChildren()) {
+    ready = this->_fetchRegionTiles(request, queuedTiles, child, level + 1) &&
+            ready;
+  }
+
+  return ready;
+}
+
+void Tileset::_processWorkerThreadLoadQueue() {
+  CESIUM_TRACE("Tileset::_processWorkerThreadLoadQueue");
+  ScopedPhaseTimer timer(
+      this->_options,
+      this->_updateResult.workerThreadLoadQueueTime);
+
+  // The subtree prefetches of implicit loaders read their limit from the
+  // content options while the tiles start loading, so it's adapted for just
+  // that time.
+  this->_pTilesetContentManager->updateLoadConcurrency(this->_options);
+  const uint32_t maximumSimultaneousSubtreeLoads =
+      this->_options.contentOptions.maximumSimultaneousSubtreeLoads;
+  this->_updateResult.maximumSimultaneousTileLoads =
+      this->_pTilesetContentManager->getMaximumSimultaneousTileLoads(
+          this->_options);
+  this->_updateResult.maximumSimultaneousSubtreeLoads =
+      this->_pTilesetContentManager->getMaximumSimultaneousSubtreeLoads(
+          this->_options);
+  this->_options.contentOptions.maximumSimultaneousSubtreeLoads =
+      this->_updateResult.maximumSimultaneousSubtreeLoads;
+  ScopeGuard restoreSubtreeLoads{[this, maximumSimultaneousSubtreeLoads]() {
+    this->_options.contentOptions.maximumSimultaneousSubtreeLoads =
+        maximumSimultaneousSubtreeLoads;
+  }};
+
+  int32_t maximumSimultaneousTileLoads = static_cast<int32_t>(
+      this->_updateResult.maximumSimultaneousTileLoads);
+
+  if (this->_pTilesetContentManager->getNumberOfTilesFetching() <
+      maximumSimultaneousTileLoads) {
+    PriorityOrderCursor<TileLoadTask> cursor(this->_workerThreadLoadQueue);
+    while (TileLoadTask* pTask = cursor.next()) {
+      // The worker-thread work of the load is done in the tile's priority.
+      CesiumAsync::TaskPriorityScope priorityScope(pTask->getTaskPriority());
+      this->_pTilesetContentManager->loadTileContent(*pTask->pTile, _options);
+      if (this->_pTilesetContentManager->getNumberOfTilesFetching() >=
+          maximumSimultaneousTileLoads) {
+        break;
+      }
+    }
+  }
+
+  this->_loadRasterOverlayTiles();
+}
+
+void Tileset::_loadRasterOverlayTiles() {
+  CESIUM_TRACE("Tileset::_loadRasterOverlayTiles");
+
+  // A tileset without a root tile doesn't clear its load queue.
+  if (!this->getRootTile()) {
+    return;
+  }
+
+  // Raster overlay tiles load in the priority of the tiles that need them,
+  // including the tiles that didn't get to start loading their geometry. The
+  // queues of the tile providers are filled again every frame, so the images
+  // of tiles that are no longer needed are dropped.
+  for (const TileLoadTask& task : this->_workerThreadLoadQueue) {
+    for (RasterMappedTo3DTile& mapped : task.pTile->getMappedRasterTiles()) {
+      RasterOverlayTile* pLoading = mapped.getLoadingTile();
+      if (pLoading) {
+        pLoading->getTileProvider().queueTileLoad(
+            *pLoading,
+            task.getTaskPriority());
+      }
+    }
+  }
+
+  const RasterOverlayCollection& overlays =
+      this->_pTilesetContentManager->getRasterOverlayCollection();
+  std::vector<uint32_t>& overlayTileLoads =
+      this->_updateResult.maximumSimultaneousRasterOverlayTileLoads;
+  overlayTileLoads.clear();
+  for (const IntrusivePointer<RasterOverlayTileProvider>& pTileProvider :
+       overlays.getTileProviders()) {
+    pTileProvider->loadQueuedTiles();
+    overlayTileLoads.emplace_back(uint32_t(
+        std::max(pTileProvider->getMaximumSimultaneousTileLoads(), 0)));
+  }
+}
+void Tileset::_processMainThreadLoadQueue() {
+  CESIUM_TRACE("Tileset::_processMainThreadLoadQueue");
+  ScopedPhaseTimer timer(
+      this->_options,
+      this->_updateResult.mainThreadLoadQueueTime);
+  // Process deferred main-thread load tasks with a time budget.
+
+  MainThreadBudget& mainThreadBudget =
+      this->_pTilesetContentManager->getMainThreadBudget();
+  double timeBudget = this->_options.mainThreadLoadingTimeLimit;
+
+  auto start = std::chrono::system_clock::now();
+  auto end =
+      start + std::chrono::milliseconds(static_cast<long long>(timeBudget));
+  if (mainThreadBudget.isEnabled()) {
+    end = mainThreadBudget.getDeadline();
+  }
+  const bool throttled = timeBudget > 0.0 || mainThreadBudget.isEnabled();
+
+  const size_t batchSize = this->_options.mainThreadPreparationBatchSize;
+  std::vector<Tile*> batch;
+  PriorityOrderCursor<TileLoadTask> cursor(this->_mainThreadLoadQueue);
+  while (const TileLoadTask* pTask = cursor.next()) {
+    // We double-check that the tile is still in the ContentLoaded state here,
+    // in case something (such as a child that needs to upsample from this
+    // parent) already pushed the tile into the Done state. Because in that
+    // case, calling finishLoading here would assert or crash.
+    if (pTask->pTile->getState() == TileLoadState::ContentLoaded &&
+        pTask->pTile->isRenderContent()) {
+      if (batchSize == 0) {
+        this->_pTilesetContentManager->finishLoading(
+            *pTask->pTile,
+            this->_options);
+      } else {
+        batch.push_back(pTask->pTile);
+        if (batch.size() < batchSize) {
+          continue;
+        }
+        this->_pTilesetContentManager->finishLoadingBatch(
+            batch,
+            this->_options);
+        batch.clear();
+      }
+    }
+    auto time = std::chrono::system_clock::now();
+    if (throttled && time >= end) {
+      break;
+    }
+  }
+  this->_pTilesetContentManager->finishLoadingBatch(batch, this->_options);
+
+  mainThreadBudget.charge(start);
+  this->_mainThreadLoadQueue.clear();
+}
+
+void Tileset::_dispatchMainThreadTasksWithinBudget() {
+  MainThreadBudget& mainThreadBudget =
+      this->_pTilesetContentManager->getMainThreadBudget();
+  if (!mainThreadBudget.isEnabled()) {
+    return;
+  }
+
+  // At least one task is dispatched, so that loads make progress even when
+  // other work used up the budget. The rest wait for the next frame.
+  auto start = std::chrono::system_clock::now();
+  CesiumAsync::MainThreadDispatchBudget dispatchBudget;
+  dispatchBudget.timeLimit = std::chrono::duration<double, std::milli>(
+                                 mainThreadBudget.getDeadline() - start)
+                                 .count();
+  this->_asyncSystem.dispatchMainThreadTasks(dispatchBudget);
+
+  mainThreadBudget.charge(start);
+}
+
+void Tileset::_unloadCachedTiles(
+    int64_t maximumBytes,
+    double timeBudget) noexcept {
+  if (this->getTotalDataBytes() <= maximumBytes) {
+    return;
+  }
+
+  ScopedPhaseTimer timer(
+      this->_options,
+      this->_updateResult.unloadCachedTilesTime);
+  const Tile* pRootTile = this->_pTilesetContentManager->getRootTile();
 
   // A time budget of 0.0 indicates we shouldn't throttle cache unloads. So set
-  // the end time to the max time_point in that case.
+  // the end time to the max time_point in that case. The main-thread budget,
+  // if there is one, takes precedence.
+  MainThreadBudget& mainThreadBudget =
+      this->_pTilesetContentManager->getMainThreadBudget();
   auto start = std::chrono::system_clock::now();
   auto end = (timeBudget <= 0.0)
                  ? std::chrono::time_point<std::chrono::system_clock>::max()
                  : (start + std::chrono::milliseconds(
                                 static_cast<long long>(timeBudget)));
+  if (mainThreadBudget.isEnabled()) {
+    end = mainThreadBudget.getDeadline();
+  }
 
-  while (this->getTotalDataBytes() > maxBytes) {
-    if (pTile == nullptr || pTile == pRootTile) {
-      // We've either removed all tiles or the next tile is the root.
-      // The root tile marks the beginning of the tiles that were used
-      // for rendering last frame.
-      break;
-    }
-
+  // The root tile marks the beginning of the tiles that were used for
+  // rendering last frame, so only the tiles before it may be unloaded.
+  std::vector<Tile*> candidates;
+  for (Tile* pTile = this->_loadedTiles.head();
+       pTile != nullptr && pTile != pRootTile;
+       pTile = this->_loadedTiles.next(*pTile)) {
     // Don't unload this tile if it is still fading out.
-    if (_updateResult.tilesFadingOut.find(pTile) !=
+    if (_updateResult.tilesFadingOut.find(pTile) ==
         _updateResult.tilesFadingOut.end()) {
-      pTile = this->_loadedTiles.next(*pTile);
+      candidates.emplace_back(pTile);
+    }
+  }
+
+  this->_evictTiles(candidates, maximumBytes, end);
+
+  mainThreadBudget.charge(start);
+}
+
+void Tileset::evictForMemoryPressure(int64_t targetBytes) {
+  CESIUM_TRACE("Tileset::evictForMemoryPressure");
+
+  if (this->getTotalDataBytes() <= targetBytes) {
+    return;
+  }
+
+  const Tile* pRootTile = this->_pTilesetContentManager->getRootTile();
+  const std::unordered_set<const Tile*> rendered(
+      this->_updateResult.tilesToRenderThisFrame.begin(),
+      this->_updateResult.tilesToRenderThisFrame.end());
+
+  std::vector<Tile*> candidates;
+  for (Tile* pTile = this->_loadedTiles.head(); pTile != nullptr;
+       pTile = this->_loadedTiles.next(*pTile)) {
+    if (pTile == pRootTile || rendered.find(pTile) != rendered.end() ||
+        _updateResult.tilesFadingOut.find(pTile) !=
+            _updateResult.tilesFadingOut.end()) {
       continue;
     }
+    candidates.emplace_back(pTile);
+  }
 
-    Tile* pNext = this->_loadedTiles.next(*pTile);
+  this->_evictTiles(
+      candidates,
+      targetBytes,
+      std::chrono::time_point<std::chrono::system_clock>::max());
+}
+
+void Tileset::_evictTiles(
+    std::vector<Tile*>& candidates,
+    int64_t targetBytes,
+    std::chrono::system_clock::time_point end) noexcept {
+  const std::shared_ptr<ITileEvictionPolicy>& pPolicy =
+      this->_options.evictionPolicy;
+  if (pPolicy) {
+    pPolicy->orderEvictionCandidates(
+        candidates,
+        this->_updateResult.tilesToRenderThisFrame);
+  }
+
+  const int64_t bytesBefore = this->getTotalDataBytes();
+  for (Tile* pTile : candidates) {
+    if (this->getTotalDataBytes() <= targetBytes) {
+      break;
+    }
 
     const bool removed =
         this->_pTilesetContentManager->unloadTileContent(*pTile);
@@ -1498,19 +3592,102 @@ void Tileset::_unloadCachedTiles(double timeBudget) noexcept {
       this->_loadedTiles.remove(*pTile);
     }
 
-    pTile = pNext;
-
     auto time = std::chrono::system_clock::now();
     if (time >= end) {
       break;
     }
   }
+  this->_updateResult.bytesEvicted += bytesBefore - this->getTotalDataBytes();
+}
+
+/**
+ * @brief Returns whether all descendants of a tile can be discarded and created
+ * again from the tile's loader.
+ *
+ * That is the case when none of them has any content or raster overlays, none
+ * is fading out, and all of them were created by the given loader.
+ */
+static bool canDiscardDescendants(
+    Tile& tile,
+    const TilesetContentLoader* pLoader,
+    const std::unordered_set<Tile*>& tilesFadingOut) {
+  for (Tile& child : tile.getChildren()) {
+    if (child.getLoader() != pLoader ||
+        child.getState() != TileLoadState::Unloaded ||
+        !child.getMappedRasterTiles().empty() ||
+        tilesFadingOut.find(&child) != tilesFadingOut.end() ||
+        !canDiscardDescendants(child, pLoader, tilesFadingOut)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Tileset::_pruneUnusedSubtrees(int32_t currentFrameNumber) {
+  if (!this->_options.enableSubtreePruning) {
+    return;
+  }
+
+  CESIUM_TRACE("Tileset::_pruneUnusedSubtrees");
+
+  // The occlusion proxy of a tile is only released after it has gone unused
+  // for a whole frame, so a tile must not be discarded any sooner.
+  const int32_t frameCount =
+      glm::max(this->_options.subtreePruningFrameCount, 1);
+
+  // A tile can only be visited after its parent is visited in the same frame,
+  // so the frame number of the root of a subtree tells us when any tile in it
+  // was last visited. The candidates themselves were visited this frame, so
+  // none of them is inside a subtree that gets discarded.
+  for (Tile* pTile : this->_subtreePruningCandidates) {
+    for (Tile& child : pTile->getChildren()) {
+      if (child.getChildren().empty() ||
+          currentFrameNumber - child.getLastSelectionState().getFrameNumber() <=
+              frameCount ||
+          this->_prefetchedTiles.find(&child) !=
+              this->_prefetchedTiles.end()) {
+        continue;
+      }
+
+      const TilesetContentLoader* pLoader = child.getLoader();
+      if (pLoader == nullptr || !pLoader->canRecreateTileChildren(child) ||
+          !canDiscardDescendants(
+              child,
+              pLoader,
+              this->_updateResult.tilesFadingOut)) {
+        continue;
+      }
+
+      this->_discardChildTiles(child);
+    }
+  }
+}
+
+void Tileset::_discardChildTiles(Tile& tile) {
+  for (Tile& child : tile.getChildren()) {
+    this->_discardChildTiles(child);
+    this->_loadedTiles.remove(child);
+    this->_tilesFadingIn.erase(&child);
+    this->_pTilesetContentManager->notifyTileDiscarded(child);
+  }
+
+  tile.getLoader()->releaseTileChildren(tile.takeChildTiles());
 }
 
 void Tileset::_markTileVisited(Tile& tile) noexcept {
   this->_loadedTiles.insertAtTail(tile);
 }
 
+static bool hasRenderableAncestor(const Tile& tile) {
+  for (const Tile* pAncestor = tile.getParent(); pAncestor != nullptr;
+       pAncestor = pAncestor->getParent()) {
+    if (pAncestor->isRenderable()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void Tileset::addTileToLoadQueue(
     Tile& tile,
     TileLoadPriorityGroup priorityGroup,
@@ -1529,11 +3706,31 @@ void Tileset::addTileToLoadQueue(
           [&](const TileLoadTask& task) { return task.pTile == &tile; }) ==
       this->_mainThreadLoadQueue.end());
 
+  if (tile.getState() == TileLoadState::ContentLoading) {
+    // Already loading, but remember that it's still needed so the load isn't
+    // canceled.
+    this->_loadingTilesStillNeeded.insert(&tile);
+    return;
+  }
+
+  std::vector<TileLoadTask>* pQueue = nullptr;
   if (this->_pTilesetContentManager->tileNeedsWorkerThreadLoading(tile)) {
-    this->_workerThreadLoadQueue.push_back({&tile, priorityGroup, priority});
+    pQueue = &this->_workerThreadLoadQueue;
   } else if (this->_pTilesetContentManager->tileNeedsMainThreadLoading(tile)) {
-    this->_mainThreadLoadQueue.push_back({&tile, priorityGroup, priority});
+    pQueue = &this->_mainThreadLoadQueue;
+  } else {
+    return;
+  }
+
+  if (this->_options.tileLoadPriorityMode ==
+          TileLoadPriorityMode::ScreenSpaceErrorDeficit &&
+      !hasRenderableAncestor(tile)) {
+    // Deficit priorities are between 0 and 1, so this tile, which leaves a
+    // hole until it's loaded, goes ahead of every tile that doesn't.
+    priority -= 1.0;
   }
+
+  pQueue->push_back({&tile, priorityGroup, priority});
 }
 
 Tileset::TraversalDetails Tileset::createTraversalDetailsForSingleTile(
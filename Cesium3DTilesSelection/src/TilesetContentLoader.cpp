@@ -1,3 +1,4 @@
+#include <Cesium3DTilesSelection/Tile.h>
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
 
 namespace Cesium3DTilesSelection {
@@ -7,13 +8,17 @@ TileLoadInput::TileLoadInput(
     const CesiumAsync::AsyncSystem& asyncSystem_,
     const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor_,
     const std::shared_ptr<spdlog::logger>& pLogger_,
-    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders_)
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders_,
+    const std::shared_ptr<const std::atomic<bool>>& pCanceled_,
+    const std::optional<CesiumAsync::ThreadPool>& decodeThreadPool_)
     : tile{tile_},
       contentOptions{contentOptions_},
       asyncSystem{asyncSystem_},
       pAssetAccessor{pAssetAccessor_},
       pLogger{pLogger_},
-      requestHeaders{requestHeaders_} {}
+      requestHeaders{requestHeaders_},
+      pCanceled{pCanceled_},
+      decodeThreadPool{decodeThreadPool_} {}
 
 TileLoadResult TileLoadResult::createFailedResult(
     std::shared_ptr<CesiumAsync::IAssetRequest> pCompletedRequest) {
@@ -40,4 +45,31 @@ TileLoadResult TileLoadResult::createRetryLaterResult(
       {},
       TileLoadResultState::RetryLater};
 }
+
+TileLoadResult TileLoadResult::createFetchedResult(
+    std::shared_ptr<CesiumAsync::IAssetRequest> pCompletedRequest) {
+  return TileLoadResult{
+      TileEmptyContent{},
+      CesiumGeometry::Axis::Y,
+      std::nullopt,
+      std::nullopt,
+      std::nullopt,
+      std::move(pCompletedRequest),
+      {},
+      TileLoadResultState::Success};
+}
+
+void TilesetContentLoader::releaseTileChildren(std::vector<Tile>&& children) {
+  std::vector<Tile> discarded = std::move(children);
+}
+
+bool TilesetContentLoader::canRecreateTileChildren(
+    const Tile& /*tile*/) const noexcept {
+  return false;
+}
+
+bool TilesetContentLoader::mayHaveExternalTileset(
+    const Tile& /*tile*/) const noexcept {
+  return false;
+}
 } // namespace Cesium3DTilesSelection
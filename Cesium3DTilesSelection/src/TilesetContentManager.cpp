@@ -1,5 +1,6 @@
 #include "TilesetContentManager.h"
 
+#include "ArchiveTilesetLoader.h"
 #include "CesiumIonTilesetLoader.h"
 #include "LayerJsonTerrainLoader.h"
 #include "TileContentLoadInfo.h"
@@ -8,6 +9,8 @@
 #include <Cesium3DTilesSelection/IPrepareRendererResources.h>
 #include <CesiumAsync/IAssetRequest.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/PropertyTableView.h>
 #include <CesiumGltfContent/GltfUtilities.h>
 #include <CesiumGltfReader/GltfReader.h>
 #include <CesiumRasterOverlays/RasterOverlay.h>
@@ -17,10 +20,14 @@
 #include <CesiumUtility/IntrusivePointer.h>
 #include <CesiumUtility/joinToString.h>
 
+#include <glm/geometric.hpp>
+#include <glm/mat3x3.hpp>
 #include <rapidjson/document.h>
 #include <spdlog/logger.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 
 using namespace CesiumGltfContent;
 using namespace CesiumRasterOverlays;
@@ -63,6 +70,7 @@ struct ContentKindSetter {
     if (rasterOverlayDetails) {
       pRenderContent->setRasterOverlayDetails(std::move(*rasterOverlayDetails));
     }
+    pRenderContent->setTriangleIndex(std::move(pTriangleIndex));
 
     tileContent.setContentKind(std::move(pRenderContent));
   }
@@ -70,6 +78,7 @@ struct ContentKindSetter {
   TileContent& tileContent;
   std::optional<RasterOverlayDetails> rasterOverlayDetails;
   void* pRenderResources;
+  std::shared_ptr<const TileTriangleIndex> pTriangleIndex;
 };
 
 void unloadTileRecursively(
@@ -467,6 +476,24 @@ void calcFittestBoundingRegionForLooseTile(
   }
 }
 
+void evaluateFeatureFilter(
+    TileLoadResult& result,
+    const TileContentLoadInfo& tileLoadInfo) {
+  const CesiumGltf::Model& model =
+      std::get<CesiumGltf::Model>(result.contentKind);
+  const CesiumGltf::ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<CesiumGltf::ExtensionModelExtStructuralMetadata>();
+  if (tileLoadInfo.contentOptions.featureFilter && pMetadata) {
+    result.featureMasks.reserve(pMetadata->propertyTables.size());
+    for (const CesiumGltf::PropertyTable& propertyTable :
+         pMetadata->propertyTables) {
+      result.featureMasks.emplace_back(
+          tileLoadInfo.contentOptions.featureFilter->evaluate(
+              CesiumGltf::PropertyTableView(model, propertyTable)));
+    }
+  }
+}
+
 void postProcessGltfInWorkerThread(
     TileLoadResult& result,
     std::vector<CesiumGeospatial::Projection>&& projections,
@@ -477,11 +504,25 @@ void postProcessGltfInWorkerThread(
     model.extras["Cesium3DTiles_TileUrl"] = result.pCompletedRequest->url();
   }
 
+  // The renderer may need this to attenuate the size of points.
+  model.extras["Cesium3DTiles_GeometricError"] =
+      tileLoadInfo.tileGeometricError;
+
   // have to pass the up axis to extra for backward compatibility
   model.extras["gltfUpAxis"] =
       static_cast<std::underlying_type_t<CesiumGeometry::Axis>>(
           result.glTFUpAxis);
 
+  // The meshes of hibernated content were already merged, simplified and
+  // optimized before it hibernated.
+  const TilesetContentOptions& contentOptions = tileLoadInfo.contentOptions;
+  const bool changeMeshes = !tileLoadInfo.meshesArePostProcessed;
+
+  // Merge the primitives first, so the steps below do less work.
+  if (changeMeshes && contentOptions.mergePrimitives) {
+    GltfUtilities::mergePrimitives(model);
+  }
+
   // calculate raster overlay details
   calcRasterOverlayDetailsInWorkerThread(
       result,
@@ -492,9 +533,45 @@ void postProcessGltfInWorkerThread(
   calcFittestBoundingRegionForLooseTile(result, tileLoadInfo);
 
   // generate missing smooth normal
-  if (tileLoadInfo.contentOptions.generateMissingNormalsSmooth) {
+  if (changeMeshes && contentOptions.generateMissingNormalsSmooth) {
     model.generateMissingNormalsSmooth();
   }
+
+  const double simplificationError = contentOptions.meshSimplificationFactor *
+                                     tileLoadInfo.tileGeometricError;
+  if (changeMeshes && simplificationError > 0.0) {
+    // The geometric error is in the units of the tileset, so undo the scale
+    // of the tile's transform to bring it to the units of the positions.
+    const glm::dmat3 rotationAndScale(tileLoadInfo.tileTransform);
+    const double scale = std::max(
+        {glm::length(rotationAndScale[0]),
+         glm::length(rotationAndScale[1]),
+         glm::length(rotationAndScale[2])});
+    if (scale > 0.0) {
+      GltfUtilities::simplifyMeshes(model, simplificationError / scale);
+    }
+  }
+
+  if (changeMeshes && contentOptions.optimizeMeshes) {
+    GltfUtilities::optimizeMeshes(model);
+  }
+
+  if (changeMeshes && contentOptions.orderPointsForLevelOfDetail) {
+    GltfUtilities::orderPointsForLevelOfDetail(model);
+  }
+
+  evaluateFeatureFilter(result, tileLoadInfo);
+
+  // Index and pack the triangles last, once the meshes are final.
+  if (contentOptions.buildTriangleIndex) {
+    result.pTriangleIndex = std::make_shared<const TileTriangleIndex>(
+        model,
+        tileLoadInfo.tileTransform);
+  }
+
+  if (contentOptions.vertexLayout) {
+    result.packedPrimitives = contentOptions.vertexLayout->packModel(model);
+  }
 }
 
 CesiumAsync::Future<TileLoadResultAndRenderResources>
@@ -507,6 +584,16 @@ postProcessContentInWorkerThread(
       result.state == TileLoadResultState::Success &&
       "This function requires result to be success");
 
+  if (tileLoadInfo.isCanceled()) {
+    return tileLoadInfo.asyncSystem.createResolvedFuture(
+        TileLoadResultAndRenderResources{
+            TileLoadResult::createRetryLaterResult(
+                std::move(result.pCompletedRequest)),
+            nullptr});
+  }
+
+  const std::chrono::steady_clock::time_point postProcessStartTime =
+      std::chrono::steady_clock::now();
   CesiumGltf::Model& model = std::get<CesiumGltf::Model>(result.contentKind);
 
   // Download any external image or buffer urls in the gltf if there are any
@@ -522,76 +609,166 @@ postProcessContentInWorkerThread(
   CesiumGltfReader::GltfReaderOptions gltfOptions;
   gltfOptions.ktx2TranscodeTargets =
       tileLoadInfo.contentOptions.ktx2TranscodeTargets;
+  gltfOptions.maximumTextureSize =
+      tileLoadInfo.contentOptions.maximumTextureSize;
   gltfOptions.applyTextureTransform =
       tileLoadInfo.contentOptions.applyTextureTransform;
+  gltfOptions.pSharedImageCache = tileLoadInfo.pSharedImageCache;
 
   auto asyncSystem = tileLoadInfo.asyncSystem;
   auto pAssetAccessor = tileLoadInfo.pAssetAccessor;
-  return CesiumGltfReader::GltfReader::resolveExternalData(
-             asyncSystem,
-             baseUrl,
-             requestHeaders,
-             pAssetAccessor,
-             gltfOptions,
-             std::move(gltfResult))
-      .thenInWorkerThread(
-          [result = std::move(result),
-           projections = std::move(projections),
-           tileLoadInfo = std::move(tileLoadInfo),
-           rendererOptions](
-              CesiumGltfReader::GltfReaderResult&& gltfResult) mutable {
-            if (!gltfResult.errors.empty()) {
-              if (result.pCompletedRequest) {
-                SPDLOG_LOGGER_ERROR(
-                    tileLoadInfo.pLogger,
-                    "Failed resolving external glTF buffers from {}:\n- {}",
-                    result.pCompletedRequest->url(),
-                    CesiumUtility::joinToString(gltfResult.errors, "\n- "));
-              } else {
-                SPDLOG_LOGGER_ERROR(
-                    tileLoadInfo.pLogger,
-                    "Failed resolving external glTF buffers:\n- {}",
-                    CesiumUtility::joinToString(gltfResult.errors, "\n- "));
-              }
-            }
+  auto decodeThreadPool = tileLoadInfo.decodeThreadPool;
+  return thenInDecodeThread(
+      decodeThreadPool,
+      CesiumGltfReader::GltfReader::resolveExternalData(
+          asyncSystem,
+          baseUrl,
+          requestHeaders,
+          pAssetAccessor,
+          gltfOptions,
+          std::move(gltfResult)),
+      [result = std::move(result),
+       projections = std::move(projections),
+       tileLoadInfo = std::move(tileLoadInfo),
+       rendererOptions,
+       postProcessStartTime](
+          CesiumGltfReader::GltfReaderResult&& gltfResult) mutable {
+        if (!gltfResult.errors.empty()) {
+          if (result.pCompletedRequest) {
+            SPDLOG_LOGGER_ERROR(
+                tileLoadInfo.pLogger,
+                "Failed resolving external glTF buffers from {}:\n- {}",
+                result.pCompletedRequest->url(),
+                CesiumUtility::joinToString(gltfResult.errors, "\n- "));
+          } else {
+            SPDLOG_LOGGER_ERROR(
+                tileLoadInfo.pLogger,
+                "Failed resolving external glTF buffers:\n- {}",
+                CesiumUtility::joinToString(gltfResult.errors, "\n- "));
+          }
+        }
 
-            if (!gltfResult.warnings.empty()) {
-              if (result.pCompletedRequest) {
-                SPDLOG_LOGGER_WARN(
-                    tileLoadInfo.pLogger,
-                    "Warning when resolving external gltf buffers from "
-                    "{}:\n- {}",
-                    result.pCompletedRequest->url(),
-                    CesiumUtility::joinToString(gltfResult.errors, "\n- "));
-              } else {
-                SPDLOG_LOGGER_ERROR(
-                    tileLoadInfo.pLogger,
-                    "Warning resolving external glTF buffers:\n- {}",
-                    CesiumUtility::joinToString(gltfResult.errors, "\n- "));
-              }
-            }
+        if (!gltfResult.warnings.empty()) {
+          if (result.pCompletedRequest) {
+            SPDLOG_LOGGER_WARN(
+                tileLoadInfo.pLogger,
+                "Warning when resolving external gltf buffers from "
+                "{}:\n- {}",
+                result.pCompletedRequest->url(),
+                CesiumUtility::joinToString(gltfResult.errors, "\n- "));
+          } else {
+            SPDLOG_LOGGER_ERROR(
+                tileLoadInfo.pLogger,
+                "Warning resolving external glTF buffers:\n- {}",
+                CesiumUtility::joinToString(gltfResult.errors, "\n- "));
+          }
+        }
 
-            if (!gltfResult.model) {
-              return tileLoadInfo.asyncSystem.createResolvedFuture(
-                  TileLoadResultAndRenderResources{
-                      TileLoadResult::createFailedResult(nullptr),
-                      nullptr});
-            }
+        if (!gltfResult.model) {
+          return tileLoadInfo.asyncSystem.createResolvedFuture(
+              TileLoadResultAndRenderResources{
+                  TileLoadResult::createFailedResult(nullptr),
+                  nullptr});
+        }
 
-            result.contentKind = std::move(*gltfResult.model);
+        if (tileLoadInfo.isCanceled()) {
+          return tileLoadInfo.asyncSystem.createResolvedFuture(
+              TileLoadResultAndRenderResources{
+                  TileLoadResult::createRetryLaterResult(
+                      std::move(result.pCompletedRequest)),
+                  nullptr});
+        }
 
-            postProcessGltfInWorkerThread(
-                result,
-                std::move(projections),
-                tileLoadInfo);
+        result.contentKind = std::move(*gltfResult.model);
 
-            // create render resources
-            return tileLoadInfo.pPrepareRendererResources->prepareInLoadThread(
+        postProcessGltfInWorkerThread(
+            result,
+            std::move(projections),
+            tileLoadInfo);
+
+        const std::chrono::steady_clock::time_point prepareStartTime =
+            std::chrono::steady_clock::now();
+        tileLoadInfo.pMetrics->recordLatency(
+            TileLoadStage::PostProcess,
+            prepareStartTime - postProcessStartTime);
+
+        // create render resources
+        return tileLoadInfo.pPrepareRendererResources
+            ->prepareInLoadThread(
                 tileLoadInfo.asyncSystem,
                 std::move(result),
                 tileLoadInfo.tileTransform,
-                rendererOptions);
-          });
+                rendererOptions)
+            .thenImmediately([pMetrics = tileLoadInfo.pMetrics,
+                              prepareStartTime](
+                                 TileLoadResultAndRenderResources&& pair) {
+              pMetrics->recordLatencySince(
+                  TileLoadStage::PrepareInLoadThread,
+                  prepareStartTime);
+              return std::move(pair);
+            });
+      });
+}
+
+// The up axis that postProcessGltfInWorkerThread put in the extras of a
+// loaded model.
+CesiumGeometry::Axis getUpAxisFromExtras(const CesiumGltf::Model& model) {
+  const auto upAxisIt = model.extras.find("gltfUpAxis");
+  return upAxisIt != model.extras.end()
+             ? static_cast<CesiumGeometry::Axis>(
+                   upAxisIt->second.getSafeNumberOrDefault<int32_t>(
+                       int32_t(CesiumGeometry::Axis::Y)))
+             : CesiumGeometry::Axis::Y;
+}
+
+// Decompresses the content of a hibernated tile in a worker thread, as the
+// result of a load.
+CesiumAsync::Future<TileLoadResult> wakeHibernatedContent(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<TileHibernationCache>& pHibernationCache,
+    const std::shared_ptr<const HibernatedTileContent>& pHibernated) {
+  return asyncSystem.runInWorkerThread([pHibernationCache, pHibernated]() {
+    std::optional<CesiumGltf::Model> model =
+        pHibernationCache->decompress(*pHibernated);
+    if (!model) {
+      return TileLoadResult::createRetryLaterResult(nullptr);
+    }
+
+    const CesiumGeometry::Axis upAxis = getUpAxisFromExtras(*model);
+    return TileLoadResult{
+        std::move(*model),
+        upAxis,
+        std::nullopt,
+        std::nullopt,
+        pHibernated->rasterOverlayDetails,
+        nullptr,
+        {},
+        TileLoadResultState::Success};
+  });
+}
+
+// Whether the buffers of the model still hold their data, rather than having
+// been released by releaseGltfData.
+bool hasGltfData(const CesiumGltf::Model& model) noexcept {
+  return std::all_of(
+      model.buffers.begin(),
+      model.buffers.end(),
+      [](const CesiumGltf::Buffer& buffer) {
+        return buffer.byteLength == 0 || !buffer.cesium.data.empty();
+      });
+}
+
+void releaseGltfData(CesiumGltf::Model& model) noexcept {
+  for (CesiumGltf::Buffer& buffer : model.buffers) {
+    buffer.cesium.data.clear();
+    buffer.cesium.data.shrink_to_fit();
+  }
+
+  for (CesiumGltf::Image& image : model.images) {
+    image.cesium.pixelData.clear();
+    image.cesium.pixelData.shrink_to_fit();
+    image.cesium.sizeBytes = 0;
+  }
 }
 } // namespace
 
@@ -606,6 +783,9 @@ TilesetContentManager::TilesetContentManager(
       _requestHeaders{std::move(requestHeaders)},
       _pLoader{std::move(pLoader)},
       _pRootTile{std::move(pRootTile)},
+      _pTileIndex{
+          tilesetOptions.enableTileIndex ? std::make_unique<TileIndex>()
+                                         : nullptr},
       _userCredit(
           (tilesetOptions.credit && externals.pCreditSystem)
               ? std::optional<Credit>(externals.pCreditSystem->createCredit(
@@ -617,12 +797,28 @@ TilesetContentManager::TilesetContentManager(
       _tileLoadsInProgress{0},
       _loadedTilesCount{0},
       _tilesDataUsed{0},
+      _pDecodeThrottle{std::make_shared<TileDecodeThrottle>(
+          tilesetOptions.maximumSimultaneousTileDecodes)},
+      _pHibernationCache{std::make_shared<TileHibernationCache>(
+          tilesetOptions.maximumHibernatedBytes)},
+      _pLoadMetrics{std::make_shared<TileLoadMetricsRecorder>()},
+      _pLoadConcurrency{nullptr},
+      _contentLoadedTimes{},
+      _tilesMissingOverlayProjections{},
+      _tilesAddingOverlayTextureCoordinates{},
+      _keepGltfDataForRasterOverlays{false},
+      _pendingRasterAttachments{},
+      _batchRasterAttachments{false},
       _destructionCompletePromise{externals.asyncSystem.createPromise<void>()},
       _destructionCompleteFuture{
           this->_destructionCompletePromise.getFuture().share()},
       _rootTileAvailablePromise{externals.asyncSystem.createPromise<void>()},
       _rootTileAvailableFuture{
           this->_rootTileAvailablePromise.getFuture().share()} {
+  if (this->_pTileIndex && this->_pRootTile) {
+    this->_pTileIndex->addSubtree(*this->_pRootTile);
+  }
+
   this->_rootTileAvailablePromise.resolve();
 }
 
@@ -635,6 +831,9 @@ TilesetContentManager::TilesetContentManager(
       _requestHeaders{},
       _pLoader{},
       _pRootTile{},
+      _pTileIndex{
+          tilesetOptions.enableTileIndex ? std::make_unique<TileIndex>()
+                                         : nullptr},
       _userCredit(
           (tilesetOptions.credit && externals.pCreditSystem)
               ? std::optional<Credit>(externals.pCreditSystem->createCredit(
@@ -646,6 +845,18 @@ TilesetContentManager::TilesetContentManager(
       _tileLoadsInProgress{0},
       _loadedTilesCount{0},
       _tilesDataUsed{0},
+      _pDecodeThrottle{std::make_shared<TileDecodeThrottle>(
+          tilesetOptions.maximumSimultaneousTileDecodes)},
+      _pHibernationCache{std::make_shared<TileHibernationCache>(
+          tilesetOptions.maximumHibernatedBytes)},
+      _pLoadMetrics{std::make_shared<TileLoadMetricsRecorder>()},
+      _pLoadConcurrency{nullptr},
+      _contentLoadedTimes{},
+      _tilesMissingOverlayProjections{},
+      _tilesAddingOverlayTextureCoordinates{},
+      _keepGltfDataForRasterOverlays{false},
+      _pendingRasterAttachments{},
+      _batchRasterAttachments{false},
       _destructionCompletePromise{externals.asyncSystem.createPromise<void>()},
       _destructionCompleteFuture{
           this->_destructionCompletePromise.getFuture().share()},
@@ -657,13 +868,39 @@ TilesetContentManager::TilesetContentManager(
 
     CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
 
+    if (ArchiveTilesetLoader::isArchiveUrl(url)) {
+      ArchiveTilesetLoader::createLoader(externals, url, this->_requestHeaders)
+          .thenInMainThread(
+              [thiz, errorCallback = tilesetOptions.loadErrorCallback](
+                  TilesetContentLoaderResult<ArchiveTilesetLoader>&& result) {
+                thiz->notifyTileDoneLoading(result.pRootTile.get());
+                thiz->propagateTilesetContentLoaderResult(
+                    TilesetLoadType::TilesetJson,
+                    errorCallback,
+                    std::move(result));
+                thiz->_rootTileAvailablePromise.resolve();
+              })
+          .catchInMainThread([thiz](std::exception&& e) {
+            thiz->notifyTileDoneLoading(nullptr);
+            SPDLOG_LOGGER_ERROR(
+                thiz->_externals.pLogger,
+                "An unexpected error occurred when loading tile: {}",
+                e.what());
+            thiz->_rootTileAvailablePromise.reject(
+                std::runtime_error("Root tile failed to load."));
+          });
+      return;
+    }
+
     externals.pAssetAccessor
         ->get(externals.asyncSystem, url, this->_requestHeaders)
         .thenInWorkerThread(
             [pLogger = externals.pLogger,
              asyncSystem = externals.asyncSystem,
              pAssetAccessor = externals.pAssetAccessor,
-             contentOptions = tilesetOptions.contentOptions](
+             pSkeletonCache = externals.pTilesetSkeletonCache,
+             contentOptions = tilesetOptions.contentOptions,
+             requestHeaders = this->_requestHeaders](
                 const std::shared_ptr<CesiumAsync::IAssetRequest>&
                     pCompletedRequest) {
               // Check if request is successful
@@ -688,6 +925,29 @@ TilesetContentManager::TilesetContentManager(
                 return asyncSystem.createResolvedFuture(std::move(result));
               }
 
+              // A cached skeleton of a tileset JSON saves parsing it. It holds
+              // all of the tiles, so it isn't used when they are created
+              // lazily.
+              if (pSkeletonCache && !contentOptions.createChildTilesLazily) {
+                std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+                    maybeResult = TilesetJsonLoader::createLoaderFromSkeleton(
+                        pLogger,
+                        *pSkeletonCache,
+                        *pCompletedRequest);
+                if (maybeResult) {
+                  if (contentOptions.prefetchRootTileContent) {
+                    maybeResult->pLoader->prefetchRootContent(
+                        asyncSystem,
+                        pAssetAccessor,
+                        *maybeResult->pRootTile,
+                        requestHeaders);
+                  }
+                  TilesetContentLoaderResult<TilesetContentLoader> result =
+                      std::move(*maybeResult);
+                  return asyncSystem.createResolvedFuture(std::move(result));
+                }
+              }
+
               // Parse Json response
               gsl::span<const std::byte> tilesetJsonBinary = pResponse->data();
               rapidjson::Document tilesetJson;
@@ -708,8 +968,35 @@ TilesetContentManager::TilesetContentManager(
               // and create corresponding loader
               const auto rootIt = tilesetJson.FindMember("root");
               if (rootIt != tilesetJson.MemberEnd()) {
+                TilesetContentLoaderResult<TilesetJsonLoader> jsonResult;
+                if (contentOptions.createChildTilesLazily) {
+                  jsonResult = TilesetJsonLoader::createLazyLoader(
+                      pLogger,
+                      url,
+                      std::move(tilesetJson));
+                } else {
+                  jsonResult = TilesetJsonLoader::createLoader(
+                      pLogger,
+                      url,
+                      tilesetJson);
+                  if (pSkeletonCache) {
+                    TilesetJsonLoader::storeSkeleton(
+                        *pSkeletonCache,
+                        *pCompletedRequest,
+                        tilesetJson,
+                        jsonResult);
+                  }
+                }
+                if (contentOptions.prefetchRootTileContent &&
+                    jsonResult.pLoader && jsonResult.pRootTile) {
+                  jsonResult.pLoader->prefetchRootContent(
+                      asyncSystem,
+                      pAssetAccessor,
+                      *jsonResult.pRootTile,
+                      requestHeaders);
+                }
                 TilesetContentLoaderResult<TilesetContentLoader> result =
-                    TilesetJsonLoader::createLoader(pLogger, url, tilesetJson);
+                    std::move(jsonResult);
                 return asyncSystem.createResolvedFuture(std::move(result));
               } else {
                 const auto formatIt = tilesetJson.FindMember("format");
@@ -774,6 +1061,9 @@ TilesetContentManager::TilesetContentManager(
       _requestHeaders{},
       _pLoader{},
       _pRootTile{},
+      _pTileIndex{
+          tilesetOptions.enableTileIndex ? std::make_unique<TileIndex>()
+                                         : nullptr},
       _userCredit(
           (tilesetOptions.credit && externals.pCreditSystem)
               ? std::optional<Credit>(externals.pCreditSystem->createCredit(
@@ -785,6 +1075,18 @@ TilesetContentManager::TilesetContentManager(
       _tileLoadsInProgress{0},
       _loadedTilesCount{0},
       _tilesDataUsed{0},
+      _pDecodeThrottle{std::make_shared<TileDecodeThrottle>(
+          tilesetOptions.maximumSimultaneousTileDecodes)},
+      _pHibernationCache{std::make_shared<TileHibernationCache>(
+          tilesetOptions.maximumHibernatedBytes)},
+      _pLoadMetrics{std::make_shared<TileLoadMetricsRecorder>()},
+      _pLoadConcurrency{nullptr},
+      _contentLoadedTimes{},
+      _tilesMissingOverlayProjections{},
+      _tilesAddingOverlayTextureCoordinates{},
+      _keepGltfDataForRasterOverlays{false},
+      _pendingRasterAttachments{},
+      _batchRasterAttachments{false},
       _destructionCompletePromise{externals.asyncSystem.createPromise<void>()},
       _destructionCompleteFuture{
           this->_destructionCompletePromise.getFuture().share()},
@@ -853,6 +1155,8 @@ TilesetContentManager::getRootTileAvailableEvent() {
 
 TilesetContentManager::~TilesetContentManager() noexcept {
   assert(this->_tileLoadsInProgress == 0);
+  // There's no point in hibernating tiles that will never be loaded again.
+  this->_pHibernationCache->setMaximumBytes(0);
   this->unloadAll();
 
   this->_destructionCompletePromise.resolve();
@@ -870,8 +1174,15 @@ void TilesetContentManager::loadTileContent(
 
   if (tile.getState() != TileLoadState::Unloaded &&
       tile.getState() != TileLoadState::FailedTemporarily) {
-    // No need to load geometry, but give previously-throttled
-    // raster overlay tiles a chance to load.
+    // No need to load geometry, but a loaded tile may need texture
+    // coordinates for overlays added after it was loaded.
+    if (tile.getState() == TileLoadState::Done &&
+        this->_tilesMissingOverlayProjections.find(&tile) !=
+            this->_tilesMissingOverlayProjections.end()) {
+      this->addRasterOverlayTextureCoordinates(tile, tilesetOptions);
+    }
+
+    // Give previously-throttled raster overlay tiles a chance to load.
     for (RasterMappedTo3DTile& rasterTile : tile.getMappedRasterTiles()) {
       rasterTile.loadThrottled();
     }
@@ -923,6 +1234,8 @@ void TilesetContentManager::loadTileContent(
   // begin loading tile
   notifyTileStartLoading(&tile);
   tile.setState(TileLoadState::ContentLoading);
+  const std::chrono::steady_clock::time_point loadStartTime =
+      std::chrono::steady_clock::now();
 
   TileContentLoadInfo tileLoadInfo{
       this->_externals.asyncSystem,
@@ -932,6 +1245,25 @@ void TilesetContentManager::loadTileContent(
       tilesetOptions.contentOptions,
       tile};
 
+  auto pCanceled = std::make_shared<std::atomic<bool>>(false);
+  this->_tileLoadCancellations[&tile] = pCanceled;
+  tileLoadInfo.pCanceled = pCanceled;
+  tileLoadInfo.decodeThreadPool = this->_externals.decodeThreadPool;
+  tileLoadInfo.pMetrics = this->_pLoadMetrics;
+  tileLoadInfo.pSharedImageCache = this->_externals.pSharedImageCache;
+
+  // Responses are held back until the tile has a decode slot, which separates
+  // fetching the content from decoding it.
+  this->_pDecodeThrottle->setMaximumSimultaneousDecodes(
+      tilesetOptions.maximumSimultaneousTileDecodes);
+  auto pDecodeSlot = std::make_shared<TileDecodeSlot>(this->_pDecodeThrottle);
+  auto pAssetAccessor = std::make_shared<TileDecodeSlotAssetAccessor>(
+      this->_externals.pAssetAccessor,
+      pDecodeSlot,
+      this->_pLoadMetrics,
+      tilesetOptions.adaptiveLoadConcurrency ? this->_pLoadConcurrency
+                                             : nullptr);
+
   TilesetContentLoader* pLoader;
   if (tile.getLoader() == &this->_upsampler) {
     pLoader = &this->_upsampler;
@@ -939,22 +1271,60 @@ void TilesetContentManager::loadTileContent(
     pLoader = this->_pLoader.get();
   }
 
+  // The content of an invalidated tile must not come from a cache without
+  // asking the server first. These headers are kept alive until the loader is
+  // done with them.
+  std::shared_ptr<std::vector<CesiumAsync::IAssetAccessor::THeader>>
+      pRevalidationHeaders;
+  if (this->_tilesToRevalidate.erase(&tile) > 0) {
+    pRevalidationHeaders =
+        std::make_shared<std::vector<CesiumAsync::IAssetAccessor::THeader>>(
+            this->_requestHeaders);
+    pRevalidationHeaders->emplace_back("Cache-Control", "no-cache");
+  }
+
   TileLoadInput loadInput{
       tile,
       tilesetOptions.contentOptions,
       this->_externals.asyncSystem,
-      this->_externals.pAssetAccessor,
+      pAssetAccessor,
       this->_externals.pLogger,
-      this->_requestHeaders};
+      pRevalidationHeaders ? *pRevalidationHeaders : this->_requestHeaders,
+      pCanceled,
+      this->_externals.decodeThreadPool};
+
+  // Hibernated content is decompressed instead of being loaded again. Its
+  // meshes are final, but it may need texture coordinates for new overlays.
+  this->_pHibernationCache->setMaximumBytes(
+      tilesetOptions.maximumHibernatedBytes);
+  std::shared_ptr<const HibernatedTileContent> pHibernated =
+      this->_pHibernationCache->take(&tile);
+  CesiumAsync::Future<TileLoadResult> loadFuture =
+      pHibernated ? wakeHibernatedContent(
+                        this->_externals.asyncSystem,
+                        this->_pHibernationCache,
+                        pHibernated)
+                  : pLoader->loadTileContent(loadInput);
+  tileLoadInfo.meshesArePostProcessed = pHibernated != nullptr;
 
   // Keep the manager alive while the load is in progress.
   CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
 
-  pLoader->loadTileContent(loadInput)
+  std::move(loadFuture)
       .thenImmediately([tileLoadInfo = std::move(tileLoadInfo),
                         projections = std::move(projections),
-                        rendererOptions = tilesetOptions.rendererOptions](
-                           TileLoadResult&& result) mutable {
+                        rendererOptions = tilesetOptions.rendererOptions,
+                        pDecodeSlot,
+                        pAssetAccessor,
+                        pRevalidationHeaders](TileLoadResult&& result) mutable {
+        const std::optional<std::chrono::steady_clock::time_point>
+            lastResponseTime = pAssetAccessor->getLastResponseTime();
+        if (lastResponseTime) {
+          tileLoadInfo.pMetrics->recordLatencySince(
+              TileLoadStage::Decode,
+              *lastResponseTime);
+        }
+
         // the reason we run immediate continuation, instead of in the
         // worker thread, is that the loader may run the task in the main
         // thread. And most often than not, those main thread task is very
@@ -964,8 +1334,13 @@ void TilesetContentManager::loadTileContent(
         // worker thread if the content is a render content
         if (result.state == TileLoadResultState::Success) {
           if (std::holds_alternative<CesiumGltf::Model>(result.contentKind)) {
+            // Content that didn't need a request, such as an upsampled tile,
+            // still needs a slot to be post-processed.
             auto asyncSystem = tileLoadInfo.asyncSystem;
-            return asyncSystem.runInWorkerThread(
+            auto decodeThreadPool = tileLoadInfo.decodeThreadPool;
+            return thenInDecodeThread(
+                decodeThreadPool,
+                pDecodeSlot->acquire(asyncSystem),
                 [result = std::move(result),
                  projections = std::move(projections),
                  tileLoadInfo = std::move(tileLoadInfo),
@@ -983,13 +1358,30 @@ void TilesetContentManager::loadTileContent(
             .createResolvedFuture<TileLoadResultAndRenderResources>(
                 {std::move(result), nullptr});
       })
-      .thenInMainThread([&tile, thiz](TileLoadResultAndRenderResources&& pair) {
+      .thenInMainThread([&tile, thiz, pDecodeSlot, loadStartTime](
+                            TileLoadResultAndRenderResources&& pair) {
+        pDecodeSlot->release();
+        thiz->_tileLoadCancellations.erase(&tile);
         setTileContent(tile, std::move(pair.result), pair.pRenderResources);
 
+        const std::chrono::steady_clock::time_point now =
+            std::chrono::steady_clock::now();
+        thiz->_pLoadMetrics->recordLatency(
+            TileLoadStage::Load,
+            now - loadStartTime);
+        if (tile.getState() == TileLoadState::ContentLoaded &&
+            tile.isRenderContent()) {
+          thiz->_contentLoadedTimes[&tile] = now;
+        }
+
         thiz->notifyTileDoneLoading(&tile);
       })
-      .catchInMainThread([pLogger = this->_externals.pLogger, &tile, thiz](
-                             std::exception&& e) {
+      .catchInMainThread([pLogger = this->_externals.pLogger,
+                          &tile,
+                          thiz,
+                          pDecodeSlot](std::exception&& e) {
+        pDecodeSlot->release();
+        thiz->_tileLoadCancellations.erase(&tile);
         thiz->notifyTileDoneLoading(&tile);
         SPDLOG_LOGGER_ERROR(
             pLogger,
@@ -1001,6 +1393,8 @@ void TilesetContentManager::loadTileContent(
 void TilesetContentManager::updateTileContent(
     Tile& tile,
     const TilesetOptions& tilesetOptions) {
+  const bool hadChildren = !tile.getChildren().empty();
+
   if (tile.getState() == TileLoadState::Unloading) {
     unloadTileContent(tile);
   }
@@ -1024,6 +1418,15 @@ void TilesetContentManager::updateTileContent(
         childrenResult.state == TileLoadResultState::RetryLater;
     tile.setContentShouldContinueUpdating(shouldTileContinueUpdated);
   }
+
+  // All children, whether they come from an external tileset, upsampling or
+  // the loader, are created by one of the steps above, so the new ones are
+  // indexed here once their IDs are final.
+  if (this->_pTileIndex && !hadChildren) {
+    for (Tile& child : tile.getChildren()) {
+      this->_pTileIndex->addSubtree(child);
+    }
+  }
 }
 
 bool TilesetContentManager::unloadTileContent(Tile& tile) {
@@ -1033,6 +1436,9 @@ bool TilesetContentManager::unloadTileContent(Tile& tile) {
   }
 
   if (state == TileLoadState::ContentLoading) {
+    // The tile can't be unloaded while it's loading, but there's no point in
+    // finishing the load either.
+    this->cancelTileLoad(tile);
     return false;
   }
 
@@ -1043,8 +1449,13 @@ bool TilesetContentManager::unloadTileContent(Tile& tile) {
     return false;
   }
 
+  this->_tilesMissingOverlayProjections.erase(&tile);
+
   // Detach raster tiles first so that the renderer's tile free
-  // process doesn't need to worry about them.
+  // process doesn't need to worry about them. The renderer gets the waiting
+  // attachments first, so that it never detaches a raster tile it doesn't
+  // have.
+  this->flushRasterAttachments();
   for (RasterMappedTo3DTile& mapped : tile.getMappedRasterTiles()) {
     mapped.detachFromTile(*this->_externals.pPrepareRendererResources, tile);
   }
@@ -1055,6 +1466,7 @@ bool TilesetContentManager::unloadTileContent(Tile& tile) {
   // is being using by an async upsample operation (checked below).
   switch (state) {
   case TileLoadState::ContentLoaded:
+    this->_contentLoadedTimes.erase(&tile);
     unloadContentLoadedState(tile);
     break;
   case TileLoadState::Done:
@@ -1064,6 +1476,14 @@ bool TilesetContentManager::unloadTileContent(Tile& tile) {
     break;
   }
 
+  // Texture coordinates for overlays may be generated from the tile's
+  // content in another thread, like the upsampling below.
+  if (this->_tilesAddingOverlayTextureCoordinates.find(&tile) !=
+      this->_tilesAddingOverlayTextureCoordinates.end()) {
+    tile.setState(TileLoadState::Unloading);
+    return false;
+  }
+
   // Are any children currently being upsampled from this tile?
   for (const Tile& child : tile.getChildren()) {
     if (child.getState() == TileLoadState::ContentLoading &&
@@ -1080,6 +1500,7 @@ bool TilesetContentManager::unloadTileContent(Tile& tile) {
 
   // If we make it this far, the tile's content will be fully unloaded.
   notifyTileUnloading(&tile);
+  this->hibernateTileContent(tile);
   content.setContentKind(TileUnknownContent{});
   tile.setState(TileLoadState::Unloaded);
   return true;
@@ -1093,6 +1514,34 @@ void TilesetContentManager::unloadAll() {
   }
 }
 
+void TilesetContentManager::cancelTileLoad(const Tile& tile) noexcept {
+  auto it = this->_tileLoadCancellations.find(&tile);
+  if (it == this->_tileLoadCancellations.end()) {
+    return;
+  }
+
+  // A tile that is being upsampled needs its parent's content, so the parent
+  // is still needed even if nothing else asks for it.
+  for (const Tile& child : tile.getChildren()) {
+    if (std::holds_alternative<CesiumGeometry::UpsampledQuadtreeNode>(
+            child.getTileID())) {
+      return;
+    }
+  }
+
+  *it->second = true;
+}
+
+void TilesetContentManager::cancelTileLoadsExcept(
+    const std::unordered_set<const Tile*>& tilesStillNeeded) noexcept {
+  for (const auto& cancellation : this->_tileLoadCancellations) {
+    const Tile* pTile = cancellation.first;
+    if (tilesStillNeeded.find(pTile) == tilesStillNeeded.end()) {
+      this->cancelTileLoad(*pTile);
+    }
+  }
+}
+
 void TilesetContentManager::waitUntilIdle() {
   // Wait for all asynchronous loading to terminate.
   // If you're hanging here, it's most likely caused by _tileLoadsInProgress not
@@ -1124,6 +1573,27 @@ Tile* TilesetContentManager::getRootTile() noexcept {
   return this->_pRootTile.get();
 }
 
+void TilesetContentManager::revalidateNextTileLoad(const Tile& tile) {
+  this->_tilesToRevalidate.insert(&tile);
+  this->_pHibernationCache->remove(&tile);
+}
+
+void TilesetContentManager::notifyTileDiscarded(const Tile& tile) noexcept {
+  this->_tilesToRevalidate.erase(&tile);
+  this->_pHibernationCache->remove(&tile);
+  if (this->_pTileIndex) {
+    this->_pTileIndex->remove(tile);
+  }
+}
+
+TileIndex* TilesetContentManager::getTileIndex() noexcept {
+  return this->_pTileIndex.get();
+}
+
+const TileIndex* TilesetContentManager::getTileIndex() const noexcept {
+  return this->_pTileIndex.get();
+}
+
 const std::vector<CesiumAsync::IAssetAccessor::THeader>&
 TilesetContentManager::getRequestHeaders() const noexcept {
   return this->_requestHeaders;
@@ -1157,6 +1627,23 @@ TilesetContentManager::getTilesetCredits() const noexcept {
   return this->_tilesetCredits;
 }
 
+MainThreadBudget& TilesetContentManager::getMainThreadBudget() noexcept {
+  return this->_mainThreadBudget;
+}
+
+int32_t TilesetContentManager::getNumberOfTilesFetching() const noexcept {
+  if (this->_pDecodeThrottle->getMaximumSimultaneousDecodes() == 0) {
+    return this->_tileLoadsInProgress;
+  }
+
+  const uint32_t decoding =
+      this->_pDecodeThrottle->getNumberOfTilesDecoding() +
+      this->_pDecodeThrottle->getNumberOfTilesWaiting();
+  return std::max(
+      this->_tileLoadsInProgress - static_cast<int32_t>(decoding),
+      0);
+}
+
 int32_t TilesetContentManager::getNumberOfTilesLoading() const noexcept {
   return this->_tileLoadsInProgress;
 }
@@ -1165,6 +1652,53 @@ int32_t TilesetContentManager::getNumberOfTilesLoaded() const noexcept {
   return this->_loadedTilesCount;
 }
 
+TileLoadMetrics TilesetContentManager::getTileLoadMetrics() const noexcept {
+  return this->_pLoadMetrics->getMetrics();
+}
+
+void TilesetContentManager::updateLoadConcurrency(
+    const TilesetOptions& tilesetOptions) {
+  if (!tilesetOptions.adaptiveLoadConcurrency) {
+    return;
+  }
+
+  if (!this->_pLoadConcurrency) {
+    this->_pLoadConcurrency =
+        std::make_shared<CesiumAsync::AdaptiveConcurrencyLimit>(
+            tilesetOptions.maximumSimultaneousTileLoads,
+            *tilesetOptions.adaptiveLoadConcurrency);
+  } else {
+    this->_pLoadConcurrency->setOptions(
+        *tilesetOptions.adaptiveLoadConcurrency);
+  }
+}
+
+uint32_t TilesetContentManager::getMaximumSimultaneousTileLoads(
+    const TilesetOptions& tilesetOptions) const noexcept {
+  if (tilesetOptions.adaptiveLoadConcurrency && this->_pLoadConcurrency) {
+    return this->_pLoadConcurrency->getLimit();
+  }
+  return tilesetOptions.maximumSimultaneousTileLoads;
+}
+
+uint32_t TilesetContentManager::getMaximumSimultaneousSubtreeLoads(
+    const TilesetOptions& tilesetOptions) const noexcept {
+  const uint32_t subtreeLoads =
+      tilesetOptions.contentOptions.maximumSimultaneousSubtreeLoads;
+  if (!tilesetOptions.adaptiveLoadConcurrency || !this->_pLoadConcurrency ||
+      subtreeLoads == 0 || tilesetOptions.maximumSimultaneousTileLoads == 0) {
+    return subtreeLoads;
+  }
+
+  // Prefetched subtrees share the connection with the tiles, so they get
+  // more or fewer requests in the same proportion.
+  const double scale = double(this->_pLoadConcurrency->getLimit()) /
+                       double(tilesetOptions.maximumSimultaneousTileLoads);
+  return std::max(
+      uint32_t(std::lround(double(subtreeLoads) * scale)),
+      uint32_t(1));
+}
+
 int64_t TilesetContentManager::getTotalDataUsed() const noexcept {
   int64_t bytes = this->_tilesDataUsed;
   for (const auto& pTileProvider :
@@ -1180,7 +1714,10 @@ bool TilesetContentManager::tileNeedsWorkerThreadLoading(
   auto state = tile.getState();
   return state == TileLoadState::Unloaded ||
          state == TileLoadState::FailedTemporarily ||
-         anyRasterOverlaysNeedLoading(tile);
+         anyRasterOverlaysNeedLoading(tile) ||
+         (state == TileLoadState::Done &&
+          this->_tilesMissingOverlayProjections.find(&tile) !=
+              this->_tilesMissingOverlayProjections.end());
 }
 
 bool TilesetContentManager::tileNeedsMainThreadLoading(
@@ -1192,8 +1729,92 @@ bool TilesetContentManager::tileNeedsMainThreadLoading(
 void TilesetContentManager::finishLoading(
     Tile& tile,
     const TilesetOptions& tilesetOptions) {
+  const std::chrono::steady_clock::time_point startTime =
+      std::chrono::steady_clock::now();
+  this->beginFinishLoading(tile, tilesetOptions);
+
+  TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
+  void* pWorkerRenderResources = pRenderContent->getRenderResources();
+  void* pMainThreadRenderResources =
+      this->_externals.pPrepareRendererResources->prepareInMainThread(
+          tile,
+          pWorkerRenderResources);
+
+  this->endFinishLoading(
+      tile,
+      tilesetOptions,
+      pMainThreadRenderResources,
+      startTime);
+}
+
+void TilesetContentManager::finishLoadingBatch(
+    gsl::span<Tile* const> tiles,
+    const TilesetOptions& tilesetOptions) {
+  if (tiles.empty()) {
+    return;
+  }
+
+  const std::chrono::steady_clock::time_point startTime =
+      std::chrono::steady_clock::now();
+
+  std::vector<void*> workerRenderResources(tiles.size());
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    this->beginFinishLoading(*tiles[i], tilesetOptions);
+    workerRenderResources[i] =
+        tiles[i]->getContent().getRenderContent()->getRenderResources();
+  }
+
+  std::vector<void*> mainThreadRenderResources(tiles.size(), nullptr);
+  this->_externals.pPrepareRendererResources->prepareInMainThreadBatch(
+      tiles,
+      workerRenderResources,
+      mainThreadRenderResources);
+
+  // Each tile is charged with the time of the whole batch, which it waited
+  // for.
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    this->endFinishLoading(
+        *tiles[i],
+        tilesetOptions,
+        mainThreadRenderResources[i],
+        startTime);
+  }
+}
+
+void TilesetContentManager::beginRasterAttachmentBatch(
+    const TilesetOptions& tilesetOptions) {
+  this->_batchRasterAttachments =
+      tilesetOptions.mainThreadPreparationBatchSize > 0;
+}
+
+void TilesetContentManager::flushRasterAttachments() {
+  if (this->_pendingRasterAttachments.empty()) {
+    return;
+  }
+
+  this->_externals.pPrepareRendererResources->attachRasterInMainThreadBatch(
+      this->_pendingRasterAttachments);
+  this->_pendingRasterAttachments.clear();
+}
+
+void TilesetContentManager::endRasterAttachmentBatch() {
+  this->flushRasterAttachments();
+  this->_batchRasterAttachments = false;
+}
+
+void TilesetContentManager::beginFinishLoading(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions) {
   assert(tile.getState() == TileLoadState::ContentLoaded);
 
+  auto contentLoadedTimeIt = this->_contentLoadedTimes.find(&tile);
+  if (contentLoadedTimeIt != this->_contentLoadedTimes.end()) {
+    this->_pLoadMetrics->recordLatency(
+        TileLoadStage::MainThreadQueue,
+        std::chrono::steady_clock::now() - contentLoadedTimeIt->second);
+    this->_contentLoadedTimes.erase(contentLoadedTimeIt);
+  }
+
   // Run the main thread part of loading.
   TileContent& content = tile.getContent();
   TileRenderContent* pRenderContent = content.getRenderContent();
@@ -1217,15 +1838,46 @@ void TilesetContentManager::finishLoading(
 
     pRenderContent->setCredits(credits);
   }
+}
 
-  void* pWorkerRenderResources = pRenderContent->getRenderResources();
-  void* pMainThreadRenderResources =
-      this->_externals.pPrepareRendererResources->prepareInMainThread(
+void TilesetContentManager::endFinishLoading(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions,
+    void* pMainThreadRenderResources,
+    std::chrono::steady_clock::time_point startTime) {
+  TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
+  pRenderContent->setRenderResources(pMainThreadRenderResources);
+
+  // A tile with raster overlays keeps its glTF data, because its children may
+  // be upsampled from it. Once the tileset has overlays, every tile keeps it,
+  // so that texture coordinates for overlays that are toggled on again can be
+  // added without reloading the tile.
+  if (!this->_overlayCollection.getOverlays().empty()) {
+    this->_keepGltfDataForRasterOverlays = true;
+  }
+
+  if (tilesetOptions.releaseGltfDataAfterUpload &&
+      !this->_keepGltfDataForRasterOverlays &&
+      tile.getMappedRasterTiles().empty()) {
+    const int64_t bytesBefore = tile.computeByteSize();
+    releaseGltfData(pRenderContent->getModel());
+    this->_tilesDataUsed -= bytesBefore - tile.computeByteSize();
+  }
+
+  // The tile's glTF data was counted when it finished loading; add the
+  // renderer's own memory now. It's removed with the rest of the tile's size
+  // when the tile is unloaded.
+  const int64_t renderResourcesBytes =
+      this->_externals.pPrepareRendererResources->getRenderResourcesByteSize(
           tile,
-          pWorkerRenderResources);
+          pMainThreadRenderResources);
+  pRenderContent->setRenderResourcesByteSize(renderResourcesBytes);
+  this->_tilesDataUsed += renderResourcesBytes;
 
-  pRenderContent->setRenderResources(pMainThreadRenderResources);
   tile.setState(TileLoadState::Done);
+  this->_pLoadMetrics->recordLatencySince(
+      TileLoadStage::PrepareInMainThread,
+      startTime);
 
   // This allows the raster tile to be updated and children to be created, if
   // necessary.
@@ -1257,7 +1909,8 @@ void TilesetContentManager::setTileContent(
         ContentKindSetter{
             content,
             std::move(result.rasterOverlayDetails),
-            pWorkerRenderResources},
+            pWorkerRenderResources,
+            std::move(result.pTriangleIndex)},
         std::move(result.contentKind));
 
     if (result.tileInitializer) {
@@ -1278,10 +1931,12 @@ void TilesetContentManager::updateContentLoadedState(
     tile.setUnconditionallyRefine();
     tile.setState(TileLoadState::Done);
   } else if (content.isRenderContent()) {
-    // If the main thread part of render content loading is not throttled,
-    // do it right away. Otherwise we'll do it later in
+    // If the main thread part of render content loading is not throttled or
+    // batched, do it right away. Otherwise we'll do it later in
     // Tileset::_processMainThreadLoadQueue with prioritization and throttling.
-    if (tilesetOptions.mainThreadLoadingTimeLimit <= 0.0) {
+    if (tilesetOptions.mainThreadLoadingTimeLimit <= 0.0 &&
+        tilesetOptions.mainThreadTimeLimit <= 0.0 &&
+        tilesetOptions.mainThreadPreparationBatchSize == 0) {
       finishLoading(tile, tilesetOptions);
     }
   } else if (content.isEmptyContent()) {
@@ -1352,6 +2007,15 @@ void TilesetContentManager::updateDoneState(
       RasterOverlayTile* pLoadingTile = mappedRasterTile.getLoadingTile();
       if (pLoadingTile && pLoadingTile->getState() ==
                               RasterOverlayTile::LoadState::Placeholder) {
+        // The placeholder stays until the tile has the texture coordinates
+        // for the overlay.
+        if (this->_tilesMissingOverlayProjections.find(&tile) !=
+                this->_tilesMissingOverlayProjections.end() ||
+            this->_tilesAddingOverlayTextureCoordinates.find(&tile) !=
+                this->_tilesAddingOverlayTextureCoordinates.end()) {
+          continue;
+        }
+
         RasterOverlayTileProvider* pProvider =
             this->_overlayCollection.findTileProviderForOverlay(
                 pLoadingTile->getOverlay());
@@ -1379,22 +2043,40 @@ void TilesetContentManager::updateDoneState(
 
           if (!missingProjections.empty()) {
             // The mesh doesn't have the right texture coordinates for this
-            // overlay's projection, so we need to kick it back to the unloaded
-            // state to fix that.
-            // In the future, we could add the ability to add the required
-            // texture coordinates without starting over from scratch.
-            unloadTileContent(tile);
-            return;
+            // overlay's projection. They're added in a worker thread while
+            // the tile keeps rendering, unless its glTF data was released, in
+            // which case we need to kick it back to the unloaded state.
+            if (!this->queueRasterOverlayTextureCoordinates(
+                    tile,
+                    std::move(missingProjections))) {
+              unloadTileContent(tile);
+              return;
+            }
           }
         }
 
         continue;
       }
 
+      // Attaching a raster overlay tile can wait for the next frame if this
+      // frame's main-thread budget is spent. Until then, we don't know if
+      // there is more detail.
+      if (mappedRasterTile.getState() !=
+              RasterMappedTo3DTile::AttachmentState::Attached &&
+          !this->_mainThreadBudget.hasTimeLeft()) {
+        skippedUnknown = true;
+        continue;
+      }
+
       const RasterOverlayTile::MoreDetailAvailable moreDetailAvailable =
-          mappedRasterTile.update(
-              *this->_externals.pPrepareRendererResources,
-              tile);
+          this->_mainThreadBudget.run([&]() {
+            return mappedRasterTile.update(
+                *this->_externals.pPrepareRendererResources,
+                tile,
+                this->_batchRasterAttachments
+                    ? &this->_pendingRasterAttachments
+                    : nullptr);
+          });
 
       if (moreDetailAvailable ==
               RasterOverlayTile::MoreDetailAvailable::Unknown &&
@@ -1421,6 +2103,171 @@ void TilesetContentManager::updateDoneState(
   }
 }
 
+bool TilesetContentManager::queueRasterOverlayTextureCoordinates(
+    Tile& tile,
+    std::vector<CesiumGeospatial::Projection>&& projections) {
+  const TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  if (!pRenderContent || !hasGltfData(pRenderContent->getModel())) {
+    return false;
+  }
+
+  this->_tilesMissingOverlayProjections[&tile] = std::move(projections);
+  return true;
+}
+
+void TilesetContentManager::addRasterOverlayTextureCoordinates(
+    Tile& tile,
+    const TilesetOptions& tilesetOptions) {
+  CESIUM_TRACE("TilesetContentManager::addRasterOverlayTextureCoordinates");
+
+  auto it = this->_tilesMissingOverlayProjections.find(&tile);
+  std::vector<CesiumGeospatial::Projection> projections =
+      std::move(it->second);
+  this->_tilesMissingOverlayProjections.erase(it);
+
+  TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
+  assert(pRenderContent && "Only render content has texture coordinates");
+
+  notifyTileStartLoading(&tile);
+  this->_tilesAddingOverlayTextureCoordinates.insert(&tile);
+
+  TileContentLoadInfo tileLoadInfo{
+      this->_externals.asyncSystem,
+      this->_externals.pAssetAccessor,
+      this->_externals.pPrepareRendererResources,
+      this->_externals.pLogger,
+      tilesetOptions.contentOptions,
+      tile};
+
+  // Keep the manager alive while the texture coordinates are generated. The
+  // tile's content can't be unloaded until then, so the worker thread can
+  // read it.
+  CesiumUtility::IntrusivePointer<TilesetContentManager> thiz = this;
+
+  this->_externals.asyncSystem
+      .runInWorkerThread(
+          [pModel = &pRenderContent->getModel(),
+           rasterOverlayDetails = pRenderContent->getRasterOverlayDetails(),
+           projections = std::move(projections),
+           tileLoadInfo = std::move(tileLoadInfo),
+           rendererOptions = tilesetOptions.rendererOptions]() mutable {
+            TileLoadResult result{
+                *pModel,
+                getUpAxisFromExtras(*pModel),
+                std::nullopt,
+                std::nullopt,
+                std::move(rasterOverlayDetails),
+                nullptr,
+                {},
+                TileLoadResultState::Success};
+
+            calcRasterOverlayDetailsInWorkerThread(
+                result,
+                std::move(projections),
+                tileLoadInfo);
+            evaluateFeatureFilter(result, tileLoadInfo);
+
+            return tileLoadInfo.pPrepareRendererResources->prepareInLoadThread(
+                tileLoadInfo.asyncSystem,
+                std::move(result),
+                tileLoadInfo.tileTransform,
+                rendererOptions);
+          })
+      .thenInMainThread([&tile, thiz](TileLoadResultAndRenderResources&& pair) {
+        thiz->_tilesAddingOverlayTextureCoordinates.erase(&tile);
+        --thiz->_tileLoadsInProgress;
+
+        IPrepareRendererResources& prepareRendererResources =
+            *thiz->_externals.pPrepareRendererResources;
+
+        // The tile may have been asked to unload in the meantime, in which
+        // case it is unloaded by its next update.
+        CesiumGltf::Model* pModel =
+            std::get_if<CesiumGltf::Model>(&pair.result.contentKind);
+        TileRenderContent* pRenderContent =
+            tile.getContent().getRenderContent();
+        if (tile.getState() != TileLoadState::Done || !pModel ||
+            !pRenderContent) {
+          prepareRendererResources.free(tile, pair.pRenderResources, nullptr);
+          return;
+        }
+
+        // The raster overlay tiles are attached again to the new renderer
+        // resources by the tile's next update.
+        thiz->flushRasterAttachments();
+        for (RasterMappedTo3DTile& mapped : tile.getMappedRasterTiles()) {
+          mapped.detachFromTile(prepareRendererResources, tile);
+        }
+
+        const int64_t bytesBefore = tile.computeByteSize();
+        prepareRendererResources.free(
+            tile,
+            nullptr,
+            pRenderContent->getRenderResources());
+        pRenderContent->setModel(std::move(*pModel));
+        if (pair.result.rasterOverlayDetails) {
+          pRenderContent->setRasterOverlayDetails(
+              std::move(*pair.result.rasterOverlayDetails));
+        }
+
+        void* pMainThreadRenderResources =
+            prepareRendererResources.prepareInMainThread(
+                tile,
+                pair.pRenderResources);
+        pRenderContent->setRenderResources(pMainThreadRenderResources);
+        pRenderContent->setRenderResourcesByteSize(
+            prepareRendererResources.getRenderResourcesByteSize(
+                tile,
+                pMainThreadRenderResources));
+        thiz->_tilesDataUsed += tile.computeByteSize() - bytesBefore;
+      })
+      .catchInMainThread([pLogger = this->_externals.pLogger, &tile, thiz](
+                             std::exception&& e) {
+        thiz->_tilesAddingOverlayTextureCoordinates.erase(&tile);
+        --thiz->_tileLoadsInProgress;
+        SPDLOG_LOGGER_ERROR(
+            pLogger,
+            "An unexpected error occurred when adding raster overlay texture "
+            "coordinates to a tile: {}",
+            e.what());
+      });
+}
+
+void TilesetContentManager::hibernateTileContent(Tile& tile) {
+  TileRenderContent* pRenderContent = tile.getContent().getRenderContent();
+  if (!pRenderContent || !hasGltfData(pRenderContent->getModel())) {
+    return;
+  }
+
+  const uint64_t ticket = this->_pHibernationCache->beginHibernating(&tile);
+  if (ticket == 0) {
+    return;
+  }
+
+  std::optional<CesiumRasterOverlays::RasterOverlayDetails>
+      rasterOverlayDetails;
+  if (!pRenderContent->getRasterOverlayDetails()
+           .rasterOverlayProjections.empty()) {
+    rasterOverlayDetails =
+        std::move(pRenderContent->getRasterOverlayDetails());
+  }
+
+  // The tile is only used as a key, it's not read in the worker thread.
+  this->_externals.asyncSystem.runInWorkerThread(
+      [pHibernationCache = this->_pHibernationCache,
+       pTile = &tile,
+       ticket,
+       model = std::move(pRenderContent->getModel()),
+       rasterOverlayDetails = std::move(rasterOverlayDetails)]() mutable {
+        pHibernationCache->finishHibernating(
+            pTile,
+            ticket,
+            model,
+            std::move(rasterOverlayDetails));
+      });
+}
+
 void TilesetContentManager::unloadContentLoadedState(Tile& tile) {
   TileContent& content = tile.getContent();
   TileRenderContent* pRenderContent = content.getRenderContent();
@@ -1509,6 +2356,10 @@ void TilesetContentManager::propagateTilesetContentLoaderResult(
     this->_requestHeaders = std::move(result.requestHeaders);
     this->_pLoader = std::move(result.pLoader);
     this->_pRootTile = std::move(result.pRootTile);
+
+    if (this->_pTileIndex && this->_pRootTile) {
+      this->_pTileIndex->addSubtree(*this->_pRootTile);
+    }
   }
 }
 } // namespace Cesium3DTilesSelection
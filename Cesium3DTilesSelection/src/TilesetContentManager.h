@@ -1,6 +1,11 @@
 #pragma once
 
+#include "MainThreadBudget.h"
 #include "RasterOverlayUpsampler.h"
+#include "TileDecodeThrottle.h"
+#include "TileHibernationCache.h"
+#include "TileIndex.h"
+#include "TileLoadMetricsRecorder.h"
 #include "TilesetContentLoaderResult.h"
 
 #include <Cesium3DTilesSelection/RasterOverlayCollection.h>
@@ -10,10 +15,19 @@
 #include <Cesium3DTilesSelection/TilesetExternals.h>
 #include <Cesium3DTilesSelection/TilesetLoadFailureDetails.h>
 #include <Cesium3DTilesSelection/TilesetOptions.h>
+#include <CesiumAsync/AdaptiveConcurrencyLimit.h>
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumGeospatial/Projection.h>
 #include <CesiumUtility/CreditSystem.h>
 #include <CesiumUtility/ReferenceCounted.h>
 
+#include <gsl/span>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
@@ -66,6 +80,24 @@ public:
 
   bool unloadTileContent(Tile& tile);
 
+  /**
+   * @brief Cancels the load of the given tile, if it is currently loading.
+   *
+   * A canceled load skips any remaining decoding and post-processing in the
+   * worker threads. Work that has already completed is kept, so a tile may
+   * still finish loading normally after it is canceled. Otherwise, it ends up
+   * in the {@link TileLoadState::FailedTemporarily} state and can be loaded
+   * again later.
+   */
+  void cancelTileLoad(const Tile& tile) noexcept;
+
+  /**
+   * @brief Cancels the loads of all tiles that are currently loading, except
+   * for the given ones.
+   */
+  void cancelTileLoadsExcept(
+      const std::unordered_set<const Tile*>& tilesStillNeeded) noexcept;
+
   void waitUntilIdle();
 
   /**
@@ -96,16 +128,76 @@ public:
 
   int32_t getNumberOfTilesLoading() const noexcept;
 
+  /**
+   * @brief Gets the number of loading tiles that are still fetching their
+   * content, as opposed to decoding it or waiting to decode it.
+   *
+   * This is the same as {@link getNumberOfTilesLoading} unless
+   * {@link TilesetOptions::maximumSimultaneousTileDecodes} is set.
+   */
+  int32_t getNumberOfTilesFetching() const noexcept;
+
   int32_t getNumberOfTilesLoaded() const noexcept;
 
   int64_t getTotalDataUsed() const noexcept;
 
+  TileLoadMetrics getTileLoadMetrics() const noexcept;
+
+  // Creates the controller of TilesetOptions::adaptiveLoadConcurrency the
+  // first time it's set, and passes it changed options. The responses of tile
+  // loads only adapt the limits while it's set. Called by the Tileset when it
+  // starts its own loads, so not while it's in a TilesetGroup.
+  void updateLoadConcurrency(const TilesetOptions& tilesetOptions);
+
+  // The number of tiles that may be fetching at the same time, which adapts
+  // to the network if TilesetOptions::adaptiveLoadConcurrency is set.
+  uint32_t getMaximumSimultaneousTileLoads(
+      const TilesetOptions& tilesetOptions) const noexcept;
+
+  // The number of subtrees that may be loading at the same time for a
+  // prefetch, which is scaled like the adapted number of tiles.
+  uint32_t getMaximumSimultaneousSubtreeLoads(
+      const TilesetOptions& tilesetOptions) const noexcept;
+
   bool tileNeedsWorkerThreadLoading(const Tile& tile) const noexcept;
   bool tileNeedsMainThreadLoading(const Tile& tile) const noexcept;
 
   // Transition the tile from the ContentLoaded to the Done state.
   void finishLoading(Tile& tile, const TilesetOptions& tilesetOptions);
 
+  // Transition the tiles from the ContentLoaded to the Done state, with one
+  // call to IPrepareRendererResources::prepareInMainThreadBatch.
+  void finishLoadingBatch(
+      gsl::span<Tile* const> tiles,
+      const TilesetOptions& tilesetOptions);
+
+  // Makes the raster overlay tiles that are attached from now on wait in a
+  // list for flushRasterAttachments, when
+  // TilesetOptions::mainThreadPreparationBatchSize is set.
+  void beginRasterAttachmentBatch(const TilesetOptions& tilesetOptions);
+
+  // Flushes the waiting raster overlay tiles, and attaches the ones after
+  // them right away again.
+  void endRasterAttachmentBatch();
+
+  // The budget for this frame's deferrable main-thread work, which includes
+  // attaching raster overlay tiles. It's started by the Tileset each frame.
+  MainThreadBudget& getMainThreadBudget() noexcept;
+
+  // Makes the next load of the tile ask the server whether its content
+  // changed, even if the content is cached, see Tileset::invalidateTiles.
+  void revalidateNextTileLoad(const Tile& tile);
+
+  // Forgets about a tile that the Tileset is about to discard.
+  void notifyTileDiscarded(const Tile& tile) noexcept;
+
+  // The index of the tiles by their IDs, or nullptr if
+  // TilesetOptions::enableTileIndex was not set. New tiles are added by this
+  // class, and removed by notifyTileDiscarded.
+  TileIndex* getTileIndex() noexcept;
+
+  const TileIndex* getTileIndex() const noexcept;
+
 private:
   static void setTileContent(
       Tile& tile,
@@ -117,6 +209,36 @@ private:
 
   void updateDoneState(Tile& tile, const TilesetOptions& tilesetOptions);
 
+  // Passes the waiting raster overlay tiles to
+  // IPrepareRendererResources::attachRasterInMainThreadBatch.
+  void flushRasterAttachments();
+
+  // The parts of finishLoading before and after the renderer's main-thread
+  // preparation.
+  void beginFinishLoading(Tile& tile, const TilesetOptions& tilesetOptions);
+  void endFinishLoading(
+      Tile& tile,
+      const TilesetOptions& tilesetOptions,
+      void* pMainThreadRenderResources,
+      std::chrono::steady_clock::time_point startTime);
+
+  // Queues the generation of texture coordinates for overlay projections
+  // that a tile in the Done state doesn't have yet. Returns false if the
+  // tile's glTF data was released, so it has to be reloaded instead.
+  bool queueRasterOverlayTextureCoordinates(
+      Tile& tile,
+      std::vector<CesiumGeospatial::Projection>&& projections);
+
+  // Generates the queued texture coordinates of the tile in a worker thread,
+  // and replaces its content with the result, without unloading it.
+  void
+  addRasterOverlayTextureCoordinates(Tile& tile, const TilesetOptions& options);
+
+  // Compresses the content of a tile that is being fully unloaded into the
+  // hibernation cache in a worker thread, see
+  // TilesetOptions::maximumHibernatedBytes. Its model is moved out.
+  void hibernateTileContent(Tile& tile);
+
   void unloadContentLoadedState(Tile& tile);
 
   void unloadDoneState(Tile& tile);
@@ -138,6 +260,7 @@ private:
   std::vector<CesiumAsync::IAssetAccessor::THeader> _requestHeaders;
   std::unique_ptr<TilesetContentLoader> _pLoader;
   std::unique_ptr<Tile> _pRootTile;
+  std::unique_ptr<TileIndex> _pTileIndex;
   std::optional<CesiumUtility::Credit> _userCredit;
   std::vector<CesiumUtility::Credit> _tilesetCredits;
   RasterOverlayUpsampler _upsampler;
@@ -145,6 +268,38 @@ private:
   int32_t _tileLoadsInProgress;
   int32_t _loadedTilesCount;
   int64_t _tilesDataUsed;
+  std::unordered_map<const Tile*, std::shared_ptr<std::atomic<bool>>>
+      _tileLoadCancellations;
+  std::unordered_set<const Tile*> _tilesToRevalidate;
+  std::shared_ptr<TileDecodeThrottle> _pDecodeThrottle;
+  std::shared_ptr<TileHibernationCache> _pHibernationCache;
+  std::shared_ptr<TileLoadMetricsRecorder> _pLoadMetrics;
+  std::shared_ptr<CesiumAsync::AdaptiveConcurrencyLimit> _pLoadConcurrency;
+
+  // When the render content of each tile in the ContentLoaded state was
+  // loaded, to measure how long it waits for the main thread.
+  std::unordered_map<const Tile*, std::chrono::steady_clock::time_point>
+      _contentLoadedTimes;
+
+  // The overlay projections that tiles in the Done state need texture
+  // coordinates for, and the tiles whose texture coordinates are being
+  // generated. The tiles are loaded in the order of the worker thread load
+  // queue, as part of the TilesetOptions::maximumSimultaneousTileLoads.
+  std::unordered_map<const Tile*, std::vector<CesiumGeospatial::Projection>>
+      _tilesMissingOverlayProjections;
+  std::unordered_set<const Tile*> _tilesAddingOverlayTextureCoordinates;
+
+  // Set once a tile finishes loading while the tileset has raster overlays.
+  // From then on, TilesetOptions::releaseGltfDataAfterUpload keeps the glTF
+  // data of every tile, so that overlays can be added again without
+  // reloading.
+  bool _keepGltfDataForRasterOverlays;
+
+  // The raster overlay tiles that wait to be attached, while
+  // _batchRasterAttachments is set.
+  std::vector<RasterAttachment> _pendingRasterAttachments;
+  bool _batchRasterAttachments;
+  MainThreadBudget _mainThreadBudget;
 
   CesiumAsync::Promise<void> _destructionCompletePromise;
   CesiumAsync::SharedFuture<void> _destructionCompleteFuture;
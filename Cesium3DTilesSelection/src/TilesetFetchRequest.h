@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/TileFetchRegion.h>
+#include <CesiumAsync/Promise.h>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The fetching of the tiles of a region, see
+ * {@link Tileset::fetchRegion}.
+ */
+class TilesetFetchRequest {
+public:
+  /**
+   * @brief The region whose tiles are fetched.
+   */
+  TileFetchRegion region;
+
+  /**
+   * @brief The promise that is resolved once all tiles of the region are
+   * loaded or have failed.
+   */
+  CesiumAsync::Promise<TileFetchResult> promise;
+
+  /**
+   * @brief The tiles that were counted by the last traversal for this
+   * request.
+   */
+  TileFetchResult result;
+};
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,178 @@
+#include "TilesetContentManager.h"
+
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/TilesetGroup.h>
+#include <CesiumAsync/TaskPriority.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace Cesium3DTilesSelection {
+
+TilesetGroup::TilesetGroup(const TilesetGroupOptions& options)
+    : _options(options), _tilesets(), _results() {}
+
+TilesetGroup::~TilesetGroup() noexcept {
+  for (Tileset* pTileset : this->_tilesets) {
+    pTileset->_pGroup = nullptr;
+  }
+}
+
+void TilesetGroup::addTileset(Tileset& tileset) {
+  if (tileset._pGroup == this) {
+    return;
+  }
+
+  if (tileset._pGroup) {
+    tileset._pGroup->removeTileset(tileset);
+  }
+
+  this->_tilesets.emplace_back(&tileset);
+  tileset._pGroup = this;
+}
+
+void TilesetGroup::removeTileset(Tileset& tileset) noexcept {
+  auto it = std::find(this->_tilesets.begin(), this->_tilesets.end(), &tileset);
+  if (it == this->_tilesets.end()) {
+    return;
+  }
+
+  this->_tilesets.erase(it);
+  tileset._pGroup = nullptr;
+}
+
+const std::vector<const ViewUpdateResult*>& TilesetGroup::updateView(
+    const std::vector<ViewState>& frustums,
+    float deltaTime) {
+  CESIUM_TRACE("TilesetGroup::updateView");
+
+  this->_results.clear();
+  for (Tileset* pTileset : this->_tilesets) {
+    this->_results.emplace_back(&pTileset->updateView(frustums, deltaTime));
+  }
+
+  this->updateLoads();
+
+  return this->_results;
+}
+
+void TilesetGroup::updateLoads() {
+  CESIUM_TRACE("TilesetGroup::updateLoads");
+  this->_processWorkerThreadLoadQueues();
+  this->_unloadCachedTiles();
+}
+
+int64_t TilesetGroup::getTotalDataBytes() const noexcept {
+  int64_t bytes = 0;
+  for (const Tileset* pTileset : this->_tilesets) {
+    bytes += pTileset->getTotalDataBytes();
+  }
+  return bytes;
+}
+
+void TilesetGroup::_processWorkerThreadLoadQueues() {
+  CESIUM_TRACE("TilesetGroup::_processWorkerThreadLoadQueues");
+
+  const int32_t maximumSimultaneousTileLoads =
+      static_cast<int32_t>(this->_options.maximumSimultaneousTileLoads);
+
+  int32_t tilesFetching = 0;
+  for (const Tileset* pTileset : this->_tilesets) {
+    tilesFetching +=
+        pTileset->_pTilesetContentManager->getNumberOfTilesFetching();
+  }
+  if (tilesFetching >= maximumSimultaneousTileLoads) {
+    for (Tileset* pTileset : this->_tilesets) {
+      std::sort(
+          pTileset->_workerThreadLoadQueue.begin(),
+          pTileset->_workerThreadLoadQueue.end());
+      pTileset->_loadRasterOverlayTiles();
+    }
+    return;
+  }
+
+  // The most important load of each tileset comes first, so that one tileset
+  // can't starve the others. The rest follow in order of priority, whichever
+  // tileset they're from.
+  struct GroupLoadTask {
+    bool isMostImportantOfTileset;
+    Tileset* pTileset;
+    const Tileset::TileLoadTask* pTask;
+
+    bool operator<(const GroupLoadTask& rhs) const noexcept {
+      if (this->isMostImportantOfTileset != rhs.isMostImportantOfTileset) {
+        return this->isMostImportantOfTileset;
+      }
+      return *this->pTask < *rhs.pTask;
+    }
+  };
+
+  std::vector<GroupLoadTask> tasks;
+  for (Tileset* pTileset : this->_tilesets) {
+    // A tileset without a root tile doesn't clear its queue.
+    std::vector<Tileset::TileLoadTask>& queue =
+        pTileset->_workerThreadLoadQueue;
+    if (!pTileset->getRootTile() || queue.empty()) {
+      continue;
+    }
+
+    std::sort(queue.begin(), queue.end());
+    for (size_t i = 0; i < queue.size(); ++i) {
+      tasks.emplace_back(GroupLoadTask{i == 0, pTileset, &queue[i]});
+    }
+  }
+
+  std::sort(tasks.begin(), tasks.end());
+
+  for (const GroupLoadTask& task : tasks) {
+    TilesetContentManager& contentManager =
+        *task.pTileset->_pTilesetContentManager;
+    const int32_t before = contentManager.getNumberOfTilesFetching();
+    CesiumAsync::TaskPriorityScope priorityScope(
+        task.pTask->getTaskPriority());
+    contentManager.loadTileContent(*task.pTask->pTile, task.pTileset->_options);
+    tilesFetching += contentManager.getNumberOfTilesFetching() - before;
+    if (tilesFetching >= maximumSimultaneousTileLoads) {
+      break;
+    }
+  }
+
+  for (Tileset* pTileset : this->_tilesets) {
+    pTileset->_loadRasterOverlayTiles();
+  }
+}
+
+void TilesetGroup::_unloadCachedTiles() {
+  CESIUM_TRACE("TilesetGroup::_unloadCachedTiles");
+
+  int64_t totalBytes = this->getTotalDataBytes();
+  if (totalBytes <= this->_options.maximumCachedBytes) {
+    return;
+  }
+
+  // Unload from the tilesets that use the most memory first.
+  std::vector<std::pair<int64_t, Tileset*>> tilesets;
+  tilesets.reserve(this->_tilesets.size());
+  for (Tileset* pTileset : this->_tilesets) {
+    tilesets.emplace_back(pTileset->getTotalDataBytes(), pTileset);
+  }
+  std::sort(
+      tilesets.begin(),
+      tilesets.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+  for (const auto& [bytes, pTileset] : tilesets) {
+    const int64_t excess = totalBytes - this->_options.maximumCachedBytes;
+    if (excess <= 0) {
+      break;
+    }
+
+    pTileset->_unloadCachedTiles(
+        bytes - excess,
+        pTileset->_options.tileCacheUnloadTimeLimit);
+    totalBytes -= bytes - pTileset->getTotalDataBytes();
+  }
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,86 @@
+#include "TilesetHeightQuery.h"
+
+#include "TileUtilities.h"
+
+#include <Cesium3DTilesSelection/Tile.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+
+#include <optional>
+#include <utility>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+
+namespace Cesium3DTilesSelection {
+
+TilesetHeightQuery::TilesetHeightQuery(const Cartographic& position)
+    : inputPosition(position),
+      ray(Ellipsoid::WGS84.cartographicToCartesian(Cartographic(
+              position.longitude,
+              position.latitude,
+              rayOriginHeight)),
+          -Ellipsoid::WGS84.geodeticSurfaceNormal(position)),
+      candidateTiles() {}
+
+void TilesetHeightRequest::resolve() {
+  SampleHeightResult result;
+  result.positions.reserve(this->queries.size());
+  result.sampleSuccess.reserve(this->queries.size());
+
+  for (const TilesetHeightQuery& query : this->queries) {
+    // The content of an additive-refined tile and that of its children may
+    // overlap, so the closest hit of all candidates is the surface.
+    std::optional<double> closest;
+    for (Tile* pTile : query.candidateTiles) {
+      const TileTriangleIndex* pIndex =
+          CesiumImpl::getOrBuildTriangleIndex(*pTile);
+      if (!pIndex) {
+        continue;
+      }
+
+      const std::optional<double> t = pIndex->intersectRay(query.ray);
+      if (t && (!closest || *t < *closest)) {
+        closest = t;
+      }
+    }
+
+    std::optional<Cartographic> hit;
+    if (closest) {
+      hit = Ellipsoid::WGS84.cartesianToCartographic(
+          query.ray.getOrigin() + query.ray.getDirection() * *closest);
+    }
+
+    if (hit) {
+      result.positions.emplace_back(
+          query.inputPosition.longitude,
+          query.inputPosition.latitude,
+          hit->height);
+      result.sampleSuccess.emplace_back(true);
+    } else {
+      result.positions.emplace_back(query.inputPosition);
+      result.sampleSuccess.emplace_back(false);
+    }
+  }
+
+  if (this->anyTileFailed) {
+    result.warnings.emplace_back(
+        "Some of the tiles needed to sample the heights failed to load, so "
+        "some heights may be missing.");
+  }
+
+  this->promise.resolve(std::move(result));
+}
+
+void TilesetHeightRequest::fail(const std::string& warning) {
+  SampleHeightResult result;
+  result.positions.reserve(this->queries.size());
+  for (const TilesetHeightQuery& query : this->queries) {
+    result.positions.emplace_back(query.inputPosition);
+  }
+  result.sampleSuccess.resize(this->queries.size(), false);
+  result.warnings.emplace_back(warning);
+
+  this->promise.resolve(std::move(result));
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/SampleHeightResult.h>
+#include <CesiumAsync/Promise.h>
+#include <CesiumGeometry/Ray.h>
+#include <CesiumGeospatial/Cartographic.h>
+
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+
+/**
+ * @brief The sampling of the height of a tileset at one position, see
+ * {@link Tileset::sampleHeightMostDetailed}.
+ */
+class TilesetHeightQuery {
+public:
+  /**
+   * @brief The height above the ellipsoid that the ray starts at, which is
+   * assumed to be above all of the content of any tileset.
+   */
+  static constexpr double rayOriginHeight = 100000.0;
+
+  /**
+   * @brief Creates the query of a position on the WGS84 ellipsoid.
+   */
+  explicit TilesetHeightQuery(const CesiumGeospatial::Cartographic& position);
+
+  /**
+   * @brief The position whose height is sampled.
+   */
+  CesiumGeospatial::Cartographic inputPosition;
+
+  /**
+   * @brief The ray that points down through the position, along the normal of
+   * the ellipsoid, from {@link rayOriginHeight}.
+   */
+  CesiumGeometry::Ray ray;
+
+  /**
+   * @brief The loaded tiles of the most detail whose content the ray may hit,
+   * found by the last traversal for this query.
+   */
+  std::vector<Tile*> candidateTiles;
+};
+
+/**
+ * @brief A batch of {@link TilesetHeightQuery} instances that are completed
+ * together.
+ */
+class TilesetHeightRequest {
+public:
+  /**
+   * @brief The queries of the positions, in the order they were given.
+   */
+  std::vector<TilesetHeightQuery> queries;
+
+  /**
+   * @brief The promise that is resolved once all queries are complete.
+   */
+  CesiumAsync::Promise<SampleHeightResult> promise;
+
+  /**
+   * @brief Whether any tile that the queries needed failed to load.
+   */
+  bool anyTileFailed = false;
+
+  /**
+   * @brief Samples the heights from the candidate tiles of the queries and
+   * resolves the promise.
+   *
+   * The candidate tiles must be loaded. Each tile keeps the index of its
+   * triangles once it is built, for the later queries that need it.
+   */
+  void resolve();
+
+  /**
+   * @brief Resolves the promise without sampling any heights.
+   *
+   * @param warning The reason the heights weren't sampled.
+   */
+  void fail(const std::string& warning);
+};
+
+} // namespace Cesium3DTilesSelection
@@ -2,14 +2,18 @@
 
 #include "ImplicitOctreeLoader.h"
 #include "ImplicitQuadtreeLoader.h"
+#include "TilesetSkeleton.h"
 #include "logTileLoadResult.h"
 
+#include <Cesium3DTilesContent/DecodedModelCache.h>
 #include <Cesium3DTilesContent/GltfConverters.h>
 #include <Cesium3DTilesReader/GroupMetadataReader.h>
 #include <Cesium3DTilesReader/MetadataEntityReader.h>
 #include <Cesium3DTilesReader/SchemaReader.h>
 #include <Cesium3DTilesSelection/TileID.h>
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/ICacheDatabase.h>
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumGeometry/BoundingSphere.h>
 #include <CesiumGeometry/OrientedBoundingBox.h>
@@ -22,7 +26,12 @@
 #include <rapidjson/document.h>
 #include <spdlog/logger.h>
 
+#include <algorithm>
 #include <cctype>
+#include <ctime>
+#include <optional>
+#include <string_view>
+#include <variant>
 
 using namespace CesiumUtility;
 using namespace Cesium3DTilesContent;
@@ -396,7 +405,8 @@ std::optional<Tile> parseTileJsonRecursively(
     const glm::dmat4& parentTransform,
     TileRefine parentRefine,
     double parentGeometricError,
-    TilesetJsonLoader& currentLoader) {
+    TilesetJsonLoader& currentLoader,
+    bool parseChildren) {
   if (!tileJson.IsObject()) {
     return std::nullopt;
   }
@@ -545,10 +555,12 @@ std::optional<Tile> parseTileJsonRecursively(
     }
   }
 
-  // parse tile's children
+  // parse tile's children, unless they are created lazily by
+  // TilesetJsonLoader::createTileChildren
   std::vector<Tile> childTiles;
   const auto childrenIt = tileJson.FindMember("children");
-  if (childrenIt != tileJson.MemberEnd() && childrenIt->value.IsArray()) {
+  if (parseChildren && childrenIt != tileJson.MemberEnd() &&
+      childrenIt->value.IsArray()) {
     const auto& childrenJson = childrenIt->value;
     childTiles.reserve(childrenJson.Size());
     for (rapidjson::SizeType i = 0; i < childrenJson.Size(); ++i) {
@@ -559,7 +571,8 @@ std::optional<Tile> parseTileJsonRecursively(
           tileTransform,
           tileRefine,
           tileGeometricError,
-          currentLoader);
+          currentLoader,
+          true);
 
       if (maybeChild) {
         childTiles.emplace_back(std::move(*maybeChild));
@@ -569,7 +582,7 @@ std::optional<Tile> parseTileJsonRecursively(
 
   if (contentUri) {
     Tile tile{&currentLoader};
-    tile.setTileID(contentUri);
+    tile.setTileID(currentLoader.getUrlPool().create(contentUri));
     tile.setTransform(tileTransform);
     tile.setBoundingVolume(tileBoundingVolume);
     tile.setViewerRequestVolume(tileViewerRequestVolume);
@@ -594,12 +607,53 @@ std::optional<Tile> parseTileJsonRecursively(
   }
 }
 
+/**
+ * @brief Finds the JSON of a child of a tile that was created by
+ * {@link parseTileJsonRecursively}.
+ *
+ * The children whose JSON is not a valid tile were not created, so they are
+ * skipped when counting up to the index of the child.
+ */
+const rapidjson::Value* findChildTileJson(
+    const rapidjson::Value& tileJson,
+    size_t childIndex,
+    size_t childCount) {
+  const auto childrenIt = tileJson.FindMember("children");
+  if (childrenIt == tileJson.MemberEnd() || !childrenIt->value.IsArray()) {
+    return nullptr;
+  }
+
+  const rapidjson::Value& childrenJson = childrenIt->value;
+  if (childrenJson.Size() == childCount) {
+    return childIndex < childCount
+               ? &childrenJson[rapidjson::SizeType(childIndex)]
+               : nullptr;
+  }
+
+  size_t validChildIndex = 0;
+  for (const rapidjson::Value& childJson : childrenJson.GetArray()) {
+    if (!childJson.IsObject() ||
+        !getBoundingVolumeProperty(childJson, "boundingVolume")) {
+      continue;
+    }
+
+    if (validChildIndex == childIndex) {
+      return &childJson;
+    }
+
+    ++validChildIndex;
+  }
+
+  return nullptr;
+}
+
 TilesetContentLoaderResult<TilesetJsonLoader> parseTilesetJson(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::string& baseUrl,
     const rapidjson::Document& tilesetJson,
     const glm::dmat4& parentTransform,
-    TileRefine parentRefine) {
+    TileRefine parentRefine,
+    bool createChildTilesLazily) {
   std::unique_ptr<Tile> pRootTile;
   auto gltfUpAxis = obtainGltfUpAxis(tilesetJson, pLogger);
   auto pLoader = std::make_unique<TilesetJsonLoader>(baseUrl, gltfUpAxis);
@@ -612,7 +666,8 @@ TilesetContentLoaderResult<TilesetJsonLoader> parseTilesetJson(
         parentTransform,
         parentRefine,
         10000000.0,
-        *pLoader);
+        *pLoader,
+        !createChildTilesLazily);
 
     if (maybeRootTile) {
       pRootTile = std::make_unique<Tile>(std::move(*maybeRootTile));
@@ -665,10 +720,66 @@ void parseTilesetMetadata(
   }
 }
 
+/**
+ * @brief Adds a root tile to represent the tileset JSON itself above the tile
+ * that was created from its `root`, and populates it with the metadata of the
+ * tileset.
+ */
+void addTilesetRootTile(
+    const std::string& tilesetJsonUrl,
+    const rapidjson::Document& tilesetJson,
+    TilesetContentLoaderResult<TilesetJsonLoader>& result) {
+  std::vector<Tile> children;
+  children.emplace_back(std::move(*result.pRootTile));
+
+  result.pRootTile = std::make_unique<Tile>(
+      children[0].getLoader(),
+      std::make_unique<TileExternalContent>());
+
+  result.pRootTile->setTileID("");
+  result.pRootTile->setTransform(children[0].getTransform());
+  result.pRootTile->setBoundingVolume(children[0].getBoundingVolume());
+  result.pRootTile->setUnconditionallyRefine();
+  result.pRootTile->setRefine(children[0].getRefine());
+  result.pRootTile->createChildTiles(std::move(children));
+
+  // Populate the root tile with metadata
+  TileExternalContent* pExternal =
+      result.pRootTile->getContent().getExternalContent();
+  assert(pExternal);
+  if (pExternal) {
+    parseTilesetMetadata(tilesetJsonUrl, tilesetJson, *pExternal);
+  }
+}
+
+// 30 days
+const std::time_t skeletonLifetime = 30 * 24 * 60 * 60;
+
+std::string getSkeletonCacheKey(const std::string& tilesetJsonUrl) {
+  return "tileset-skeleton " + tilesetJsonUrl;
+}
+
+std::optional<std::string>
+getETag(const CesiumAsync::IAssetRequest& completedRequest) {
+  const CesiumAsync::IAssetResponse* pResponse = completedRequest.response();
+  if (!pResponse) {
+    return std::nullopt;
+  }
+
+  const CesiumAsync::HttpHeaders& headers = pResponse->headers();
+  const auto etagIt = headers.find("ETag");
+  if (etagIt == headers.end() || etagIt->second.empty()) {
+    return std::nullopt;
+  }
+
+  return etagIt->second;
+}
+
 TileLoadResult parseExternalTilesetInWorkerThread(
     const glm::dmat4& tileTransform,
     CesiumGeometry::Axis upAxis,
     TileRefine tileRefine,
+    bool createChildTilesLazily,
     const std::shared_ptr<spdlog::logger>& pLogger,
     std::shared_ptr<CesiumAsync::IAssetRequest>&& pCompletedRequest,
     ExternalContentInitializer&& externalContentInitializer) {
@@ -699,7 +810,8 @@ TileLoadResult parseExternalTilesetInWorkerThread(
           tileUrl,
           tilesetJson,
           tileTransform,
-          tileRefine);
+          tileRefine,
+          createChildTilesLazily);
 
   // Populate the root tile with metadata
   parseTilesetMetadata(
@@ -716,6 +828,12 @@ TileLoadResult parseExternalTilesetInWorkerThread(
     return TileLoadResult::createFailedResult(std::move(pCompletedRequest));
   }
 
+  if (createChildTilesLazily) {
+    externalTilesetLoader.pLoader->createChildTilesLazily(
+        pLogger,
+        std::move(tilesetJson));
+  }
+
   externalContentInitializer.pExternalTilesetLoaders =
       std::make_shared<TilesetContentLoaderResult<TilesetJsonLoader>>(
           std::move(externalTilesetLoader));
@@ -737,16 +855,68 @@ TileLoadResult parseExternalTilesetInWorkerThread(
 TilesetJsonLoader::TilesetJsonLoader(
     const std::string& baseUrl,
     CesiumGeometry::Axis upAxis)
-    : _baseUrl{baseUrl}, _upAxis{upAxis}, _children{} {}
+    : _baseUrl{baseUrl},
+      _urlPool{},
+      _upAxis{upAxis},
+      _children{},
+      _pLogger{},
+      _pTilesetJson{},
+      _prefetchedContent{} {}
+
+TilesetJsonLoader::~TilesetJsonLoader() noexcept = default;
+
+void TilesetJsonLoader::prefetchRootContent(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const Tile& rootTile,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders) {
+  auto prefetch = [this, &asyncSystem, &pAssetAccessor, &requestHeaders](
+                      const Tile& tile) {
+    const TileUrl* pUrl = std::get_if<TileUrl>(&tile.getTileID());
+    if (tile.getLoader() != this || !pUrl || pUrl->empty()) {
+      return;
+    }
+
+    std::string resolvedUrl =
+        CesiumUtility::Uri::resolve(this->_baseUrl, pUrl->toString(), true);
+    if (this->_prefetchedContent.find(resolvedUrl) !=
+        this->_prefetchedContent.end()) {
+      return;
+    }
+
+    CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> request =
+        pAssetAccessor->get(asyncSystem, resolvedUrl, requestHeaders);
+    this->_prefetchedContent.emplace(
+        std::move(resolvedUrl),
+        PrefetchedContent{requestHeaders, std::move(request)});
+  };
+
+  // The root tile of the loader only refers to the root of the tileset JSON,
+  // which is the tile that is selected first, followed by its children.
+  for (const Tile& jsonRoot : rootTile.getChildren()) {
+    prefetch(jsonRoot);
+    for (const Tile& child : jsonRoot.getChildren()) {
+      prefetch(child);
+    }
+  }
+}
 
 CesiumAsync::Future<TilesetContentLoaderResult<TilesetJsonLoader>>
 TilesetJsonLoader::createLoader(
     const TilesetExternals& externals,
     const std::string& tilesetJsonUrl,
-    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders) {
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+    bool createChildTilesLazily,
+    bool prefetchRootTileContent) {
+  // The skeleton of a tileset JSON holds all of its tiles, so it isn't used
+  // when they are created lazily.
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pSkeletonCache =
+      createChildTilesLazily ? nullptr : externals.pTilesetSkeletonCache;
   return externals.pAssetAccessor
       ->get(externals.asyncSystem, tilesetJsonUrl, requestHeaders)
-      .thenInWorkerThread([pLogger = externals.pLogger](
+      .thenInWorkerThread([pLogger = externals.pLogger,
+                           pSkeletonCache = std::move(pSkeletonCache),
+                           createChildTilesLazily](
                               const std::shared_ptr<CesiumAsync::IAssetRequest>&
                                   pCompletedRequest) {
         const CesiumAsync::IAssetResponse* pResponse =
@@ -771,6 +941,17 @@ TilesetJsonLoader::createLoader(
           return result;
         }
 
+        if (pSkeletonCache) {
+          std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+              maybeResult = TilesetJsonLoader::createLoaderFromSkeleton(
+                  pLogger,
+                  *pSkeletonCache,
+                  *pCompletedRequest);
+          if (maybeResult) {
+            return std::move(*maybeResult);
+          }
+        }
+
         gsl::span<const std::byte> data = pResponse->data();
 
         rapidjson::Document tilesetJson;
@@ -787,11 +968,43 @@ TilesetJsonLoader::createLoader(
           return result;
         }
 
-        return TilesetJsonLoader::createLoader(
-            pLogger,
-            pCompletedRequest->url(),
-            tilesetJson);
-      });
+        if (createChildTilesLazily) {
+          return TilesetJsonLoader::createLazyLoader(
+              pLogger,
+              pCompletedRequest->url(),
+              std::move(tilesetJson));
+        }
+
+        TilesetContentLoaderResult<TilesetJsonLoader> result =
+            TilesetJsonLoader::createLoader(
+                pLogger,
+                pCompletedRequest->url(),
+                tilesetJson);
+        if (pSkeletonCache) {
+          TilesetJsonLoader::storeSkeleton(
+              *pSkeletonCache,
+              *pCompletedRequest,
+              tilesetJson,
+              result);
+        }
+        return result;
+      })
+      .thenImmediately(
+          [asyncSystem = externals.asyncSystem,
+           pAssetAccessor = externals.pAssetAccessor,
+           requestHeaders,
+           prefetchRootTileContent](
+              TilesetContentLoaderResult<TilesetJsonLoader>&& result) {
+            if (prefetchRootTileContent && result.pLoader &&
+                result.pRootTile) {
+              result.pLoader->prefetchRootContent(
+                  asyncSystem,
+                  pAssetAccessor,
+                  *result.pRootTile,
+                  requestHeaders);
+            }
+            return std::move(result);
+          });
 }
 
 TilesetContentLoaderResult<TilesetJsonLoader> TilesetJsonLoader::createLoader(
@@ -803,34 +1016,122 @@ TilesetContentLoaderResult<TilesetJsonLoader> TilesetJsonLoader::createLoader(
       tilesetJsonUrl,
       tilesetJson,
       glm::dmat4(1.0),
-      TileRefine::Replace);
+      TileRefine::Replace,
+      false);
 
-  // Create a root tile to represent the tileset.json itself.
-  std::vector<Tile> children;
-  children.emplace_back(std::move(*result.pRootTile));
+  addTilesetRootTile(tilesetJsonUrl, tilesetJson, result);
 
-  result.pRootTile = std::make_unique<Tile>(
-      children[0].getLoader(),
-      std::make_unique<TileExternalContent>());
+  return result;
+}
 
-  result.pRootTile->setTileID("");
-  result.pRootTile->setTransform(children[0].getTransform());
-  result.pRootTile->setBoundingVolume(children[0].getBoundingVolume());
-  result.pRootTile->setUnconditionallyRefine();
-  result.pRootTile->setRefine(children[0].getRefine());
-  result.pRootTile->createChildTiles(std::move(children));
+TilesetContentLoaderResult<TilesetJsonLoader>
+TilesetJsonLoader::createLazyLoader(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& tilesetJsonUrl,
+    rapidjson::Document&& tilesetJson) {
+  TilesetContentLoaderResult<TilesetJsonLoader> result = parseTilesetJson(
+      pLogger,
+      tilesetJsonUrl,
+      tilesetJson,
+      glm::dmat4(1.0),
+      TileRefine::Replace,
+      true);
 
-  // Populate the root tile with metadata
-  TileExternalContent* pExternal =
-      result.pRootTile->getContent().getExternalContent();
-  assert(pExternal);
-  if (pExternal) {
-    parseTilesetMetadata(tilesetJsonUrl, tilesetJson, *pExternal);
+  addTilesetRootTile(tilesetJsonUrl, tilesetJson, result);
+
+  result.pLoader->createChildTilesLazily(pLogger, std::move(tilesetJson));
+
+  return result;
+}
+
+std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+TilesetJsonLoader::createLoaderFromSkeleton(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    CesiumAsync::ICacheDatabase& skeletonCache,
+    const CesiumAsync::IAssetRequest& completedRequest) {
+  const std::optional<std::string> etag = getETag(completedRequest);
+  if (!etag) {
+    return std::nullopt;
   }
 
+  const std::string& tilesetJsonUrl = completedRequest.url();
+  const std::optional<CesiumAsync::CacheItem> cacheItem =
+      skeletonCache.getEntry(getSkeletonCacheKey(tilesetJsonUrl));
+  if (!cacheItem) {
+    return std::nullopt;
+  }
+
+  const CesiumAsync::HttpHeaders& cachedHeaders =
+      cacheItem->cacheResponse.headers;
+  const auto etagIt = cachedHeaders.find("ETag");
+  if (etagIt == cachedHeaders.end() || etagIt->second != *etag) {
+    return std::nullopt;
+  }
+
+  std::optional<TilesetSkeleton> skeleton =
+      readTilesetSkeleton(cacheItem->cacheResponse.data);
+  if (!skeleton) {
+    return std::nullopt;
+  }
+
+  auto pLoader = std::make_unique<TilesetJsonLoader>(
+      tilesetJsonUrl,
+      obtainGltfUpAxis(skeleton->tilesetJson, pLogger));
+  std::optional<Tile> rootTile =
+      createTilesFromSkeleton(skeleton->tiles, *pLoader, pLoader->getUrlPool());
+  if (!rootTile) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "Ignoring the invalid cached skeleton of tileset {}",
+        tilesetJsonUrl);
+    return std::nullopt;
+  }
+
+  TilesetContentLoaderResult<TilesetJsonLoader> result{
+      std::move(pLoader),
+      std::make_unique<Tile>(std::move(*rootTile)),
+      std::vector<LoaderCreditResult>{},
+      std::vector<CesiumAsync::IAssetAccessor::THeader>{},
+      ErrorList{}};
+  addTilesetRootTile(tilesetJsonUrl, skeleton->tilesetJson, result);
+
   return result;
 }
 
+void TilesetJsonLoader::storeSkeleton(
+    CesiumAsync::ICacheDatabase& skeletonCache,
+    const CesiumAsync::IAssetRequest& completedRequest,
+    const rapidjson::Document& tilesetJson,
+    const TilesetContentLoaderResult<TilesetJsonLoader>& result) {
+  const std::optional<std::string> etag = getETag(completedRequest);
+  if (!etag || result.errors || !result.pLoader ||
+      result.pLoader->_pTilesetJson || !result.pRootTile ||
+      result.pRootTile->getChildren().size() != 1) {
+    return;
+  }
+
+  const std::optional<std::vector<std::byte>> skeleton = writeTilesetSkeleton(
+      tilesetJson,
+      result.pRootTile->getChildren()[0],
+      *result.pLoader);
+  if (!skeleton) {
+    return;
+  }
+
+  // The ETag alone decides whether a skeleton is still valid, so it may be
+  // kept for much longer than the response itself.
+  const std::time_t expiryTime = std::time(nullptr) + skeletonLifetime;
+  skeletonCache.storeEntry(
+      getSkeletonCacheKey(completedRequest.url()),
+      expiryTime,
+      completedRequest.url(),
+      completedRequest.method(),
+      CesiumAsync::HttpHeaders{},
+      200,
+      CesiumAsync::HttpHeaders{{"ETag", *etag}},
+      *skeleton);
+}
+
 CesiumAsync::Future<TileLoadResult>
 TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
   const Tile& tile = loadInput.tile;
@@ -841,7 +1142,7 @@ TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
   }
 
   // this loader only handles Url ID
-  const std::string* url = std::get_if<std::string>(&tile.getTileID());
+  const TileUrl* url = std::get_if<TileUrl>(&tile.getTileID());
   if (!url) {
     return loadInput.asyncSystem.createResolvedFuture<TileLoadResult>(
         TileLoadResult::createFailedResult(nullptr));
@@ -858,20 +1159,38 @@ TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
   const auto& requestHeaders = loadInput.requestHeaders;
   const auto& contentOptions = loadInput.contentOptions;
   std::string resolvedUrl =
-      CesiumUtility::Uri::resolve(this->_baseUrl, *url, true);
-  return pAssetAccessor->get(asyncSystem, resolvedUrl, requestHeaders)
-      .thenInWorkerThread([pLogger,
-                           contentOptions,
-                           tileTransform,
-                           tileRefine,
-                           upAxis = _upAxis,
-                           externalContentInitializer =
-                               std::move(externalContentInitializer),
-                           pAssetAccessor,
-                           &asyncSystem,
-                           requestHeaders](
-                              std::shared_ptr<CesiumAsync::IAssetRequest>&&
-                                  pCompletedRequest) mutable {
+      CesiumUtility::Uri::resolve(this->_baseUrl, url->toString(), true);
+
+  // Content that was fetched early is only used once, by the first load of
+  // its tile.
+  std::optional<
+      CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>>
+      maybePrefetched;
+  auto prefetchedIt = this->_prefetchedContent.find(resolvedUrl);
+  if (prefetchedIt != this->_prefetchedContent.end()) {
+    if (prefetchedIt->second.requestHeaders == requestHeaders) {
+      maybePrefetched.emplace(std::move(prefetchedIt->second.request));
+    }
+    this->_prefetchedContent.erase(prefetchedIt);
+  }
+
+  return thenInDecodeThread(
+      loadInput.decodeThreadPool,
+      maybePrefetched
+          ? std::move(*maybePrefetched)
+          : pAssetAccessor->get(asyncSystem, resolvedUrl, requestHeaders),
+      [pLogger,
+       contentOptions,
+       tileTransform,
+       tileRefine,
+       upAxis = _upAxis,
+       externalContentInitializer = std::move(externalContentInitializer),
+       pAssetAccessor,
+       &asyncSystem,
+       requestHeaders,
+       pCanceled = loadInput.pCanceled](
+          std::shared_ptr<CesiumAsync::IAssetRequest>&&
+              pCompletedRequest) mutable {
         auto pResponse = pCompletedRequest->response();
         const std::string& tileUrl = pCompletedRequest->url();
         if (!pResponse) {
@@ -894,6 +1213,13 @@ TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
               TileLoadResult::createFailedResult(std::move(pCompletedRequest)));
         }
 
+        if (pCanceled && *pCanceled) {
+          // The tile is no longer needed, so don't spend time decoding it.
+          return asyncSystem.createResolvedFuture(
+              TileLoadResult::createRetryLaterResult(
+                  std::move(pCompletedRequest)));
+        }
+
         // find gltf converter
         const auto& responseData = pResponse->data();
         auto converter = GltfConverters::getConverterByMagic(responseData);
@@ -901,6 +1227,12 @@ TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
           converter = GltfConverters::getConverterByFileExtension(tileUrl);
         }
 
+        if (converter && contentOptions.skipContentDecoding) {
+          return asyncSystem.createResolvedFuture(
+              TileLoadResult::createFetchedResult(
+                  std::move(pCompletedRequest)));
+        }
+
         if (converter) {
           // Convert to gltf
           AssetFetcher assetFetcher{
@@ -909,12 +1241,22 @@ TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
               tileUrl,
               tileTransform,
               requestHeaders};
+          assetFetcher.convertBatchTables = contentOptions.convertBatchTables;
+          assetFetcher.keepPointCloudsQuantized =
+              contentOptions.keepPointCloudsQuantized;
+          assetFetcher.pGltfModelCache = contentOptions.pGltfModelCache;
+          assetFetcher.pDecodedModelCache = contentOptions.pDecodedModelCache;
           CesiumGltfReader::GltfReaderOptions gltfOptions;
           gltfOptions.ktx2TranscodeTargets =
               contentOptions.ktx2TranscodeTargets;
+          gltfOptions.maximumTextureSize = contentOptions.maximumTextureSize;
           gltfOptions.applyTextureTransform =
               contentOptions.applyTextureTransform;
-          return converter(responseData, gltfOptions, assetFetcher)
+          return DecodedModelCache::convert(
+                     converter,
+                     responseData,
+                     gltfOptions,
+                     assetFetcher)
               .thenImmediately([pLogger, upAxis, tileUrl, pCompletedRequest](
                                    GltfConverterResult&& result) {
                 logTileLoadResult(pLogger, tileUrl, result.errors);
@@ -939,6 +1281,7 @@ TilesetJsonLoader::loadTileContent(const TileLoadInput& loadInput) {
                   tileTransform,
                   upAxis,
                   tileRefine,
+                  contentOptions.createChildTilesLazily,
                   pLogger,
                   std::move(pCompletedRequest),
                   std::move(externalContentInitializer)));
@@ -952,7 +1295,72 @@ TileChildrenResult TilesetJsonLoader::createTileChildren(const Tile& tile) {
     return pLoader->createTileChildren(tile);
   }
 
-  return {{}, TileLoadResultState::Failed};
+  const rapidjson::Value* pTileJson = this->findTileJson(tile);
+  if (!pTileJson) {
+    return {{}, TileLoadResultState::Failed};
+  }
+
+  const auto childrenIt = pTileJson->FindMember("children");
+  if (childrenIt == pTileJson->MemberEnd() || !childrenIt->value.IsArray() ||
+      childrenIt->value.Empty()) {
+    return {{}, TileLoadResultState::Failed};
+  }
+
+  // The transform, refinement and geometric error of the tile are the same
+  // ones that its children would have inherited when all tiles are created at
+  // once.
+  const rapidjson::Value& childrenJson = childrenIt->value;
+  std::vector<Tile> children;
+  children.reserve(childrenJson.Size());
+  for (const rapidjson::Value& childJson : childrenJson.GetArray()) {
+    std::optional<Tile> maybeChild = parseTileJsonRecursively(
+        this->_pLogger,
+        childJson,
+        tile.getTransform(),
+        tile.getRefine(),
+        tile.getGeometricError(),
+        *this,
+        false);
+    if (maybeChild) {
+      children.emplace_back(std::move(*maybeChild));
+    }
+  }
+
+  return {std::move(children), TileLoadResultState::Success};
+}
+
+bool TilesetJsonLoader::canRecreateTileChildren(
+    const Tile& tile) const noexcept {
+  return this->_pTilesetJson && !tile.isExternalContent();
+}
+
+bool TilesetJsonLoader::mayHaveExternalTileset(
+    const Tile& tile) const noexcept {
+  const TileUrl* pUrl = std::get_if<TileUrl>(&tile.getTileID());
+  if (!pUrl) {
+    return false;
+  }
+
+  const std::string fullUrl = pUrl->toString();
+  const std::string_view url(fullUrl);
+  const std::string_view path = url.substr(0, url.find_first_of("?#"));
+  const std::string_view extension = ".json";
+  return path.size() >= extension.size() &&
+         std::equal(
+             extension.rbegin(),
+             extension.rend(),
+             path.rbegin(),
+             [](char lhs, char rhs) {
+               return lhs == std::tolower(static_cast<unsigned char>(rhs));
+             });
+}
+
+void TilesetJsonLoader::createChildTilesLazily(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    rapidjson::Document&& tilesetJson) {
+  this->_pLogger = pLogger;
+  this->_pTilesetJson =
+      std::make_unique<rapidjson::Document>(std::move(tilesetJson));
 }
 
 const std::string& TilesetJsonLoader::getBaseUrl() const noexcept {
@@ -963,8 +1371,46 @@ CesiumGeometry::Axis TilesetJsonLoader::getUpAxis() const noexcept {
   return _upAxis;
 }
 
+TileUrlPool& TilesetJsonLoader::getUrlPool() noexcept {
+  return this->_urlPool;
+}
+
 void TilesetJsonLoader::addChildLoader(
     std::unique_ptr<TilesetContentLoader> pLoader) {
   this->_children.emplace_back(std::move(pLoader));
 }
+
+const rapidjson::Value*
+TilesetJsonLoader::findTileJson(const Tile& tile) const {
+  if (!this->_pTilesetJson || tile.isExternalContent()) {
+    return nullptr;
+  }
+
+  // Walk up to the tile that was created from the root of the JSON. Its parent
+  // is either the tile added above it by addTilesetRootTile, or the tile of
+  // another loader whose content is this external tileset.
+  std::vector<const Tile*> path{&tile};
+  for (const Tile* pParent = tile.getParent();
+       pParent != nullptr && pParent->getLoader() == this &&
+       !pParent->isExternalContent();
+       pParent = pParent->getParent()) {
+    path.emplace_back(pParent);
+  }
+
+  const auto rootIt = this->_pTilesetJson->FindMember("root");
+  if (rootIt == this->_pTilesetJson->MemberEnd()) {
+    return nullptr;
+  }
+
+  const rapidjson::Value* pTileJson = &rootIt->value;
+  for (size_t i = path.size() - 1; i > 0 && pTileJson; --i) {
+    gsl::span<const Tile> siblings = path[i]->getChildren();
+    pTileJson = findChildTileJson(
+        *pTileJson,
+        size_t(path[i - 1] - siblings.data()),
+        siblings.size());
+  }
+
+  return pTileJson;
+}
 } // namespace Cesium3DTilesSelection
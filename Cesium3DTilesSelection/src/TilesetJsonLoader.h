@@ -3,6 +3,7 @@
 #include "TilesetContentLoaderResult.h"
 
 #include <Cesium3DTilesSelection/TilesetContentLoader.h>
+#include <Cesium3DTilesSelection/TileUrl.h>
 #include <Cesium3DTilesSelection/TilesetExternals.h>
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/IAssetAccessor.h>
@@ -10,39 +11,163 @@
 #include <rapidjson/fwd.h>
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+namespace CesiumAsync {
+class ICacheDatabase;
+class IAssetRequest;
+} // namespace CesiumAsync
+
 namespace Cesium3DTilesSelection {
 class TilesetJsonLoader : public TilesetContentLoader {
 public:
   TilesetJsonLoader(const std::string& baseUrl, CesiumGeometry::Axis upAxis);
 
+  ~TilesetJsonLoader() noexcept override;
+
   CesiumAsync::Future<TileLoadResult>
   loadTileContent(const TileLoadInput& loadInput) override;
 
   TileChildrenResult createTileChildren(const Tile& tile) override;
 
+  /**
+   * @brief Returns whether the children of the given tile can be discarded,
+   * which is only the case when they are created lazily, see
+   * {@link createChildTilesLazily}.
+   */
+  bool canRecreateTileChildren(const Tile& tile) const noexcept override;
+
+  /**
+   * @brief Returns whether the content URI of the given tile has a `.json`
+   * extension, which is how external tilesets are usually named.
+   */
+  bool mayHaveExternalTileset(const Tile& tile) const noexcept override;
+
   const std::string& getBaseUrl() const noexcept;
 
   CesiumGeometry::Axis getUpAxis() const noexcept;
 
+  /**
+   * @brief Gets the pool that the content URLs of the tiles of this loader
+   * are created with.
+   */
+  TileUrlPool& getUrlPool() noexcept;
+
   void addChildLoader(std::unique_ptr<TilesetContentLoader> pLoader);
 
+  /**
+   * @brief Makes {@link createTileChildren} create the children of the tiles
+   * of this loader from the given tileset JSON.
+   *
+   * The tiles must have been created from the same JSON without their
+   * children. The loader keeps the JSON for as long as it exists, because the
+   * children may be discarded and created again.
+   *
+   * @param pLogger The logger for the errors in the JSON of the children.
+   * @param tilesetJson The tileset JSON that the tiles were created from.
+   */
+  void createChildTilesLazily(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      rapidjson::Document&& tilesetJson);
+
+  /**
+   * @brief Starts fetching the content of the root tile of the tileset JSON
+   * and of the children of that tile, so that {@link loadTileContent} can use
+   * the responses rather than requesting them again.
+   *
+   * This must be called before the loader is used to load tiles, from the
+   * thread that created it.
+   *
+   * @param asyncSystem The async system.
+   * @param pAssetAccessor The accessor to fetch the content with.
+   * @param rootTile The root tile created by {@link createLoader}.
+   * @param requestHeaders The headers to fetch the content with. A tile that
+   * is loaded with other headers is fetched again.
+   */
+  void prefetchRootContent(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const Tile& rootTile,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders);
+
   static CesiumAsync::Future<TilesetContentLoaderResult<TilesetJsonLoader>>
   createLoader(
       const TilesetExternals& externals,
       const std::string& tilesetJsonUrl,
-      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders);
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& requestHeaders,
+      bool createChildTilesLazily = false,
+      bool prefetchRootTileContent = false);
 
   static TilesetContentLoaderResult<TilesetJsonLoader> createLoader(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::string& tilesetJsonUrl,
       const rapidjson::Document& tilesetJson);
 
+  /**
+   * @brief Creates a loader like {@link createLoader}, except that only the
+   * tile of the root of the JSON is created up front.
+   *
+   * The children of each tile are created the first time they are needed, see
+   * {@link createChildTilesLazily}.
+   */
+  static TilesetContentLoaderResult<TilesetJsonLoader> createLazyLoader(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::string& tilesetJsonUrl,
+      rapidjson::Document&& tilesetJson);
+
+  /**
+   * @brief Creates a loader from the skeleton that was stored for a tileset
+   * JSON by {@link storeSkeleton}.
+   *
+   * @param pLogger The logger.
+   * @param skeletonCache The database that holds the skeletons.
+   * @param completedRequest The completed request for the tileset JSON.
+   * @return The loader, or `std::nullopt` if there is no skeleton for the
+   * URL of the request, or if the skeleton was stored for a response with a
+   * different `ETag`.
+   */
+  static std::optional<TilesetContentLoaderResult<TilesetJsonLoader>>
+  createLoaderFromSkeleton(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      CesiumAsync::ICacheDatabase& skeletonCache,
+      const CesiumAsync::IAssetRequest& completedRequest);
+
+  /**
+   * @brief Stores the skeleton of a tileset JSON, so that
+   * {@link createLoaderFromSkeleton} can later create the same loader
+   * without parsing the JSON.
+   *
+   * Nothing is stored if the response has no `ETag`, if the loader could not
+   * be created, or if the tiles can't be represented by a skeleton, as is the
+   * case for implicit tilesets.
+   *
+   * @param skeletonCache The database that holds the skeletons.
+   * @param completedRequest The completed request for the tileset JSON.
+   * @param tilesetJson The parsed tileset JSON.
+   * @param result The loader that was created from the JSON by
+   * {@link createLoader}.
+   */
+  static void storeSkeleton(
+      CesiumAsync::ICacheDatabase& skeletonCache,
+      const CesiumAsync::IAssetRequest& completedRequest,
+      const rapidjson::Document& tilesetJson,
+      const TilesetContentLoaderResult<TilesetJsonLoader>& result);
+
 private:
+  /**
+   * @brief Finds the JSON that the given tile of this loader was created
+   * from, or returns `nullptr` if the children of its tiles aren't created
+   * lazily.
+   */
+  const rapidjson::Value* findTileJson(const Tile& tile) const;
+
   std::string _baseUrl;
 
+  TileUrlPool _urlPool;
+
   /**
    * @brief The axis that was declared as the "up-axis" for glTF content.
    *
@@ -56,5 +181,24 @@ private:
   CesiumGeometry::Axis _upAxis;
 
   std::vector<std::unique_ptr<TilesetContentLoader>> _children;
+
+  std::shared_ptr<spdlog::logger> _pLogger;
+
+  /**
+   * @brief The tileset JSON that the children of the tiles are created from,
+   * if they are created lazily.
+   */
+  std::unique_ptr<rapidjson::Document> _pTilesetJson;
+
+  struct PrefetchedContent {
+    std::vector<CesiumAsync::IAssetAccessor::THeader> requestHeaders;
+    CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> request;
+  };
+
+  /**
+   * @brief The requests started by {@link prefetchRootContent} that haven't
+   * been used by {@link loadTileContent} yet, by the resolved URL.
+   */
+  std::unordered_map<std::string, PrefetchedContent> _prefetchedContent;
 };
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,355 @@
+#include "TilesetSkeleton.h"
+
+#include <Cesium3DTilesSelection/TileUrl.h>
+#include <Cesium3DTilesSelection/TilesetContentLoader.h>
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/BoundingRegionWithLooseFittingHeights.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumGeospatial/S2CellBoundingVolume.h>
+#include <CesiumGeospatial/S2CellID.h>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <variant>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+
+namespace Cesium3DTilesSelection {
+namespace {
+// Also tells apart skeletons written on machines with a different byte
+// order, which are stored in the native one.
+const uint32_t skeletonMagic = 0x4c454b53; // "SKEL"
+
+// Changes whenever the layout below does.
+const uint32_t skeletonVersion = 1;
+
+enum TileFlags : uint8_t {
+  HasContent = 1 << 0,
+  HasViewerRequestVolume = 1 << 1,
+  HasContentBoundingVolume = 1 << 2,
+  RefineAdd = 1 << 3
+};
+
+class SkeletonWriter {
+public:
+  template <typename T> void write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const std::byte* pValue = reinterpret_cast<const std::byte*>(&value);
+    this->data.insert(this->data.end(), pValue, pValue + sizeof(T));
+  }
+
+  void writeString(const std::string& value) {
+    this->write(static_cast<uint64_t>(value.size()));
+    const std::byte* pValue = reinterpret_cast<const std::byte*>(value.data());
+    this->data.insert(this->data.end(), pValue, pValue + value.size());
+  }
+
+  void writeBoundingVolume(const BoundingVolume& boundingVolume) {
+    this->write(static_cast<uint8_t>(boundingVolume.index()));
+    std::visit(
+        [this](const auto& volume) { this->writeVolume(volume); },
+        boundingVolume);
+  }
+
+  std::vector<std::byte> data;
+
+private:
+  void writeVolume(const BoundingSphere& sphere) {
+    this->write(sphere.getCenter());
+    this->write(sphere.getRadius());
+  }
+
+  void writeVolume(const OrientedBoundingBox& box) {
+    this->write(box.getCenter());
+    this->write(box.getHalfAxes());
+  }
+
+  void writeVolume(const BoundingRegion& region) {
+    const GlobeRectangle& rectangle = region.getRectangle();
+    this->write(rectangle.getWest());
+    this->write(rectangle.getSouth());
+    this->write(rectangle.getEast());
+    this->write(rectangle.getNorth());
+    this->write(region.getMinimumHeight());
+    this->write(region.getMaximumHeight());
+  }
+
+  void writeVolume(const BoundingRegionWithLooseFittingHeights& region) {
+    this->writeVolume(region.getBoundingRegion());
+  }
+
+  void writeVolume(const S2CellBoundingVolume& cell) {
+    this->write(cell.getCellID().getID());
+    this->write(cell.getMinimumHeight());
+    this->write(cell.getMaximumHeight());
+  }
+};
+
+// Reads the values written by a SkeletonWriter. Once a read goes past the
+// end of the data, every read fails.
+class SkeletonReader {
+public:
+  explicit SkeletonReader(const gsl::span<const std::byte>& data)
+      : _data(data), _offset(0), _failed(false) {}
+
+  template <typename T> T read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    if (this->_failed || this->_data.size() - this->_offset < sizeof(T)) {
+      this->_failed = true;
+      return value;
+    }
+    std::memcpy(&value, this->_data.data() + this->_offset, sizeof(T));
+    this->_offset += sizeof(T);
+    return value;
+  }
+
+  gsl::span<const std::byte> readBytes() {
+    const uint64_t size = this->read<uint64_t>();
+    if (this->_failed || this->_data.size() - this->_offset < size) {
+      this->_failed = true;
+      return {};
+    }
+    gsl::span<const std::byte> bytes =
+        this->_data.subspan(this->_offset, static_cast<size_t>(size));
+    this->_offset += static_cast<size_t>(size);
+    return bytes;
+  }
+
+  std::string readString() {
+    const gsl::span<const std::byte> bytes = this->readBytes();
+    return std::string(
+        reinterpret_cast<const char*>(bytes.data()),
+        bytes.size());
+  }
+
+  std::optional<BoundingVolume> readBoundingVolume() {
+    switch (this->read<uint8_t>()) {
+    case 0: {
+      const glm::dvec3 center = this->read<glm::dvec3>();
+      return BoundingSphere(center, this->read<double>());
+    }
+    case 1: {
+      const glm::dvec3 center = this->read<glm::dvec3>();
+      return OrientedBoundingBox(center, this->read<glm::dmat3>());
+    }
+    case 2:
+      return this->readBoundingRegion();
+    case 3:
+      return BoundingRegionWithLooseFittingHeights(this->readBoundingRegion());
+    case 4: {
+      const uint64_t id = this->read<uint64_t>();
+      const double minimumHeight = this->read<double>();
+      return S2CellBoundingVolume(
+          S2CellID(id),
+          minimumHeight,
+          this->read<double>());
+    }
+    default:
+      this->_failed = true;
+      return std::nullopt;
+    }
+  }
+
+  gsl::span<const std::byte> remaining() const {
+    return this->_data.subspan(this->_offset);
+  }
+
+  bool failed() const noexcept { return this->_failed; }
+
+private:
+  BoundingRegion readBoundingRegion() {
+    const double west = this->read<double>();
+    const double south = this->read<double>();
+    const double east = this->read<double>();
+    const double north = this->read<double>();
+    const double minimumHeight = this->read<double>();
+    const double maximumHeight = this->read<double>();
+    return BoundingRegion(
+        GlobeRectangle(west, south, east, north),
+        minimumHeight,
+        maximumHeight);
+  }
+
+  gsl::span<const std::byte> _data;
+  size_t _offset;
+  bool _failed;
+};
+
+bool writeTile(
+    SkeletonWriter& writer,
+    const Tile& tile,
+    const TilesetContentLoader& loader) {
+  const TileUrl* pUrl = std::get_if<TileUrl>(&tile.getTileID());
+  if (tile.getLoader() != &loader || tile.isExternalContent() || !pUrl) {
+    return false;
+  }
+
+  uint8_t flags = 0;
+  if (!tile.isEmptyContent()) {
+    flags |= HasContent;
+  }
+  if (tile.getViewerRequestVolume()) {
+    flags |= HasViewerRequestVolume;
+  }
+  if (tile.getContentBoundingVolume()) {
+    flags |= HasContentBoundingVolume;
+  }
+  if (tile.getRefine() == TileRefine::Add) {
+    flags |= RefineAdd;
+  }
+
+  writer.write(flags);
+  if (flags & HasContent) {
+    writer.writeString(pUrl->toString());
+  }
+  writer.write(tile.getTransform());
+  writer.writeBoundingVolume(tile.getBoundingVolume());
+  if (flags & HasViewerRequestVolume) {
+    writer.writeBoundingVolume(*tile.getViewerRequestVolume());
+  }
+  if (flags & HasContentBoundingVolume) {
+    writer.writeBoundingVolume(*tile.getContentBoundingVolume());
+  }
+  writer.write(tile.getGeometricError());
+
+  const gsl::span<const Tile> children = tile.getChildren();
+  writer.write(static_cast<uint64_t>(children.size()));
+  for (const Tile& child : children) {
+    if (!writeTile(writer, child, loader)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::optional<Tile> readTile(
+    SkeletonReader& reader,
+    TilesetContentLoader& loader,
+    TileUrlPool& urlPool) {
+  const uint8_t flags = reader.read<uint8_t>();
+  std::optional<Tile> tile;
+  if (flags & HasContent) {
+    tile.emplace(&loader);
+    tile->setTileID(urlPool.create(reader.readString()));
+  } else {
+    tile.emplace(&loader, TileEmptyContent{});
+    tile->setTileID("");
+  }
+
+  tile->setTransform(reader.read<glm::dmat4>());
+
+  std::optional<BoundingVolume> boundingVolume = reader.readBoundingVolume();
+  if (!boundingVolume) {
+    return std::nullopt;
+  }
+  tile->setBoundingVolume(*boundingVolume);
+
+  if (flags & HasViewerRequestVolume) {
+    tile->setViewerRequestVolume(reader.readBoundingVolume());
+  }
+  if (flags & HasContentBoundingVolume) {
+    tile->setContentBoundingVolume(reader.readBoundingVolume());
+  }
+  tile->setGeometricError(reader.read<double>());
+  tile->setRefine((flags & RefineAdd) ? TileRefine::Add : TileRefine::Replace);
+
+  // Every child takes at least a byte, so a corrupt count can't make the
+  // vector huge.
+  const uint64_t childCount = reader.read<uint64_t>();
+  if (reader.failed() || childCount > reader.remaining().size()) {
+    return std::nullopt;
+  }
+
+  std::vector<Tile> children;
+  children.reserve(static_cast<size_t>(childCount));
+  for (uint64_t i = 0; i < childCount; ++i) {
+    std::optional<Tile> child = readTile(reader, loader, urlPool);
+    if (!child) {
+      return std::nullopt;
+    }
+    children.emplace_back(std::move(*child));
+  }
+  tile->createChildTiles(std::move(children));
+
+  if (reader.failed()) {
+    return std::nullopt;
+  }
+  return tile;
+}
+} // namespace
+
+std::optional<std::vector<std::byte>> writeTilesetSkeleton(
+    const rapidjson::Document& tilesetJson,
+    const Tile& rootTile,
+    const TilesetContentLoader& loader) {
+  // Write all of the JSON but the root, without copying it.
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> jsonWriter(buffer);
+  jsonWriter.StartObject();
+  for (auto it = tilesetJson.MemberBegin(); it != tilesetJson.MemberEnd();
+       ++it) {
+    if (it->name != "root") {
+      it->name.Accept(jsonWriter);
+      it->value.Accept(jsonWriter);
+    }
+  }
+  jsonWriter.EndObject();
+
+  SkeletonWriter writer;
+  writer.write(skeletonMagic);
+  writer.write(skeletonVersion);
+  writer.writeString(std::string(buffer.GetString(), buffer.GetSize()));
+  if (!writeTile(writer, rootTile, loader)) {
+    return std::nullopt;
+  }
+
+  return std::move(writer.data);
+}
+
+std::optional<TilesetSkeleton>
+readTilesetSkeleton(const gsl::span<const std::byte>& skeleton) {
+  SkeletonReader reader(skeleton);
+  if (reader.read<uint32_t>() != skeletonMagic ||
+      reader.read<uint32_t>() != skeletonVersion) {
+    return std::nullopt;
+  }
+
+  const gsl::span<const std::byte> json = reader.readBytes();
+  if (reader.failed()) {
+    return std::nullopt;
+  }
+
+  TilesetSkeleton result;
+  result.tilesetJson.Parse(
+      reinterpret_cast<const char*>(json.data()),
+      json.size());
+  if (result.tilesetJson.HasParseError() || !result.tilesetJson.IsObject()) {
+    return std::nullopt;
+  }
+
+  result.tiles = reader.remaining();
+  return result;
+}
+
+std::optional<Tile> createTilesFromSkeleton(
+    const gsl::span<const std::byte>& tiles,
+    TilesetContentLoader& loader,
+    TileUrlPool& urlPool) {
+  SkeletonReader reader(tiles);
+  std::optional<Tile> rootTile = readTile(reader, loader, urlPool);
+  if (!rootTile || !reader.remaining().empty()) {
+    return std::nullopt;
+  }
+  return rootTile;
+}
+} // namespace Cesium3DTilesSelection
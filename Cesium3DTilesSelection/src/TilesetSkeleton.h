@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Cesium3DTilesSelection/Tile.h>
+
+#include <gsl/span>
+#include <rapidjson/document.h>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class TilesetContentLoader;
+
+/**
+ * @brief A tileset JSON, stored in a compact binary form that can be read
+ * much faster than the JSON can be parsed.
+ *
+ * The tile hierarchy is stored as the tiles that were created from the JSON:
+ * their transforms, bounding volumes, geometric errors, refinement and
+ * content URLs. The rest of the JSON, such as its metadata, is stored as
+ * JSON.
+ */
+struct TilesetSkeleton {
+  /**
+   * @brief The tileset JSON, without its `root` tile.
+   */
+  rapidjson::Document tilesetJson;
+
+  /**
+   * @brief The encoded tile hierarchy, which can be decoded with
+   * {@link createTilesFromSkeleton}.
+   */
+  gsl::span<const std::byte> tiles;
+};
+
+/**
+ * @brief Writes the skeleton of a tileset JSON.
+ *
+ * @param tilesetJson The tileset JSON.
+ * @param rootTile The tile that was created from the `root` of the JSON.
+ * @param loader The loader of the tiles.
+ * @return The skeleton, or `std::nullopt` if it can't represent the tiles.
+ * That is the case if any tile has another loader or external content, such
+ * as the root of an implicit tileset.
+ */
+std::optional<std::vector<std::byte>> writeTilesetSkeleton(
+    const rapidjson::Document& tilesetJson,
+    const Tile& rootTile,
+    const TilesetContentLoader& loader);
+
+/**
+ * @brief Reads a skeleton written by {@link writeTilesetSkeleton}.
+ *
+ * @param skeleton The skeleton, which must outlive the result.
+ * @return The parts of the skeleton, or `std::nullopt` if it is invalid or
+ * was written by a different version of this library.
+ */
+std::optional<TilesetSkeleton>
+readTilesetSkeleton(const gsl::span<const std::byte>& skeleton);
+
+/**
+ * @brief Creates the tile hierarchy of a skeleton.
+ *
+ * @param tiles The {@link TilesetSkeleton::tiles} of the skeleton.
+ * @param loader The loader of the tiles.
+ * @param urlPool The pool that the content URLs of the tiles are created
+ * with.
+ * @return The root tile, or `std::nullopt` if the tiles are invalid.
+ */
+std::optional<Tile> createTilesFromSkeleton(
+    const gsl::span<const std::byte>& tiles,
+    TilesetContentLoader& loader,
+    TileUrlPool& urlPool);
+} // namespace Cesium3DTilesSelection
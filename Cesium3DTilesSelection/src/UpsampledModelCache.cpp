@@ -0,0 +1,112 @@
+#include "UpsampledModelCache.h"
+
+#include <CesiumRasterOverlays/RasterOverlayUtilities.h>
+
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+using namespace CesiumRasterOverlays;
+
+namespace Cesium3DTilesSelection {
+namespace {
+size_t hashBuffers(const CesiumGltf::Model& model) {
+  size_t hash = model.buffers.size();
+  for (const CesiumGltf::Buffer& buffer : model.buffers) {
+    const CesiumUtility::ByteVector& data = buffer.cesium.data;
+    const size_t bufferHash = std::hash<std::string_view>()(std::string_view(
+        reinterpret_cast<const char*>(data.data()),
+        data.size()));
+    // Combine the hashes as boost::hash_combine does.
+    hash ^= bufferHash + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+} // namespace
+
+UpsampledModelCache::UpsampledModelCache(size_t maximumModels) noexcept
+    : _maximumModels(maximumModels) {}
+
+void UpsampledModelCache::setMaximumModels(size_t maximumModels) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_maximumModels = maximumModels;
+  this->trim();
+}
+
+std::optional<CesiumGltf::Model> UpsampledModelCache::upsample(
+    const Tile* pParent,
+    const CesiumGltf::Model& parentModel,
+    const CesiumGeometry::QuadtreeTileID& childID,
+    int32_t textureCoordinateIndex) {
+  const auto upsampleModel = [&]() {
+    return RasterOverlayUtilities::upsampleGltfForRasterOverlays(
+        parentModel,
+        CesiumGeometry::UpsampledQuadtreeNode{childID},
+        false,
+        RasterOverlayUtilities::DEFAULT_TEXTURE_COORDINATE_BASE_NAME,
+        textureCoordinateIndex);
+  };
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_maximumModels == 0) {
+      return upsampleModel();
+    }
+  }
+
+  const Key key{
+      pParent,
+      childID,
+      textureCoordinateIndex,
+      hashBuffers(parentModel)};
+
+  std::shared_ptr<const CesiumGltf::Model> pCached;
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = std::find_if(
+        this->_entries.begin(),
+        this->_entries.end(),
+        [&key](const auto& entry) { return entry.first == key; });
+    if (it != this->_entries.end()) {
+      this->_entries.splice(this->_entries.begin(), this->_entries, it);
+      pCached = it->second;
+    }
+  }
+
+  if (pCached) {
+    return *pCached;
+  }
+
+  // Upsample without holding the lock, so that other children are upsampled
+  // at the same time.
+  std::optional<CesiumGltf::Model> model = upsampleModel();
+  if (!model) {
+    return model;
+  }
+
+  auto pModel = std::make_shared<const CesiumGltf::Model>(*model);
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  const bool alreadyAdded = std::any_of(
+      this->_entries.begin(),
+      this->_entries.end(),
+      [&key](const auto& entry) { return entry.first == key; });
+  if (!alreadyAdded) {
+    this->_entries.emplace_front(key, std::move(pModel));
+    this->trim();
+  }
+
+  return model;
+}
+
+size_t UpsampledModelCache::size() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_entries.size();
+}
+
+void UpsampledModelCache::trim() {
+  while (this->_entries.size() > this->_maximumModels) {
+    this->_entries.pop_back();
+  }
+}
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGltf/Model.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+
+/**
+ * @brief A cache of the models upsampled from the models of parent tiles,
+ * so that a child tile that is unloaded and loaded again doesn't upsample the
+ * same model again.
+ *
+ * A model is identified by its parent tile, the ID of the child, the texture
+ * coordinates with which it is upsampled, and a hash of the buffers of the
+ * parent model. The hash keeps a parent whose content has changed, or a new
+ * tile at the address of a destroyed one, from using a stale model.
+ *
+ * This class is thread-safe. Models are upsampled in worker threads.
+ */
+class UpsampledModelCache {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param maximumModels The number of models to keep, or 0 to keep none.
+   */
+  explicit UpsampledModelCache(size_t maximumModels = 0) noexcept;
+
+  /**
+   * @brief Changes the number of models to keep. If it shrinks, the least
+   * recently used models are removed.
+   */
+  void setMaximumModels(size_t maximumModels);
+
+  /**
+   * @brief Upsamples a child of a parent model with
+   * `RasterOverlayUtilities::upsampleGltfForRasterOverlays`, or copies the
+   * model upsampled for the same child before.
+   *
+   * @param pParent The parent tile.
+   * @param parentModel The model of the parent tile.
+   * @param childID The ID of the child tile.
+   * @param textureCoordinateIndex The index of the raster overlay texture
+   * coordinates that divide the parent model.
+   * @return The upsampled model, or `std::nullopt` if no part of the parent
+   * model is in the child.
+   */
+  std::optional<CesiumGltf::Model> upsample(
+      const Tile* pParent,
+      const CesiumGltf::Model& parentModel,
+      const CesiumGeometry::QuadtreeTileID& childID,
+      int32_t textureCoordinateIndex);
+
+  /**
+   * @brief Gets the number of models in the cache.
+   */
+  size_t size() const;
+
+private:
+  struct Key {
+    const Tile* pParent;
+    CesiumGeometry::QuadtreeTileID childID;
+    int32_t textureCoordinateIndex;
+    size_t parentContentHash;
+
+    bool operator==(const Key& other) const noexcept {
+      return this->pParent == other.pParent &&
+             this->childID == other.childID &&
+             this->textureCoordinateIndex == other.textureCoordinateIndex &&
+             this->parentContentHash == other.parentContentHash;
+    }
+  };
+
+  void trim();
+
+  size_t _maximumModels;
+  mutable std::mutex _mutex;
+  // The most recently used entries come first.
+  std::list<std::pair<Key, std::shared_ptr<const CesiumGltf::Model>>> _entries;
+};
+} // namespace Cesium3DTilesSelection
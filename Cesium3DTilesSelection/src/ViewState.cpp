@@ -1,9 +1,13 @@
 #include "Cesium3DTilesSelection/ViewState.h"
 
+#include <CesiumGeometry/BatchCulling.h>
 #include <CesiumGeometry/CullingVolume.h>
 
 #include <glm/trigonometric.hpp>
 
+#include <algorithm>
+#include <array>
+
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 
@@ -122,6 +126,147 @@ bool ViewState::isBoundingVolumeVisible(
   return std::visit(Operation{*this}, boundingVolume);
 }
 
+bool ViewState::isBoundingVolumeVisible(
+    const OrientedBoundingBox& boundingBox,
+    const BoundingSphere& boundingSphere) const noexcept {
+  const CullingVolume& cullingVolume = this->_cullingVolume;
+  for (const Plane* pPlane :
+       {&cullingVolume.leftPlane,
+        &cullingVolume.rightPlane,
+        &cullingVolume.topPlane,
+        &cullingVolume.bottomPlane}) {
+    // The sphere encloses the box, so the box is only tested when the plane
+    // cuts through the sphere.
+    const CullingResult sphereResult = boundingSphere.intersectPlane(*pPlane);
+    if (sphereResult == CullingResult::Outside) {
+      return false;
+    }
+    if (sphereResult == CullingResult::Intersecting &&
+        boundingBox.intersectPlane(*pPlane) == CullingResult::Outside) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+namespace {
+std::array<Plane, 4>
+getCullingPlanes(const CullingVolume& cullingVolume) noexcept {
+  return {
+      cullingVolume.leftPlane,
+      cullingVolume.rightPlane,
+      cullingVolume.topPlane,
+      cullingVolume.bottomPlane};
+}
+
+bool isAnyNotOutside(
+    const std::array<CullingResult, BatchCulling::LaneCount>& results,
+    size_t count) noexcept {
+  return std::any_of(
+      results.begin(),
+      results.begin() + std::ptrdiff_t(count),
+      [](CullingResult result) { return result != CullingResult::Outside; });
+}
+
+template <typename T>
+bool isAnyVisible(
+    const std::array<Plane, 4>& planes,
+    gsl::span<const T> volumes) noexcept {
+  std::array<CullingResult, BatchCulling::LaneCount> results;
+  for (size_t first = 0; first < volumes.size(); first += results.size()) {
+    const size_t count = std::min(results.size(), volumes.size() - first);
+    BatchCulling::intersectPlanes(
+        planes,
+        volumes.subspan(first, count),
+        results);
+    if (isAnyNotOutside(results, count)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename T> class CullingBatch {
+public:
+  explicit CullingBatch(const std::array<Plane, 4>& planes) noexcept
+      : _planes(planes), _volumes(), _count(0) {}
+
+  /**
+   * @brief Adds a volume to the batch, culling the batch if it is full.
+   *
+   * @return Whether any volume in a batch culled by this call is visible.
+   */
+  bool add(const T* pVolume) noexcept {
+    this->_volumes[this->_count++] = pVolume;
+    return this->_count == this->_volumes.size() && this->flush();
+  }
+
+  /**
+   * @brief Culls the volumes currently in the batch and empties it.
+   *
+   * @return Whether any of the volumes is visible.
+   */
+  bool flush() noexcept {
+    const size_t count = this->_count;
+    this->_count = 0;
+    return isAnyVisible(
+        this->_planes,
+        gsl::span<const T* const>(this->_volumes.data(), count));
+  }
+
+private:
+  const std::array<Plane, 4>& _planes;
+  std::array<const T*, BatchCulling::LaneCount> _volumes;
+  size_t _count;
+};
+} // namespace
+
+bool ViewState::isAnyBoundingVolumeVisible(
+    gsl::span<const BoundingVolume* const> boundingVolumes) const noexcept {
+  const std::array<Plane, 4> planes = getCullingPlanes(this->_cullingVolume);
+
+  CullingBatch<OrientedBoundingBox> boxes(planes);
+  CullingBatch<BoundingSphere> spheres(planes);
+
+  for (const BoundingVolume* pBoundingVolume : boundingVolumes) {
+    bool visible;
+    if (const auto* pBox = std::get_if<OrientedBoundingBox>(pBoundingVolume)) {
+      visible = boxes.add(pBox);
+    } else if (
+        const auto* pRegion = std::get_if<BoundingRegion>(pBoundingVolume)) {
+      visible = boxes.add(&pRegion->getBoundingBox());
+    } else if (
+        const auto* pLoose =
+            std::get_if<BoundingRegionWithLooseFittingHeights>(
+                pBoundingVolume)) {
+      visible = boxes.add(&pLoose->getBoundingRegion().getBoundingBox());
+    } else if (
+        const auto* pSphere = std::get_if<BoundingSphere>(pBoundingVolume)) {
+      visible = spheres.add(pSphere);
+    } else {
+      // S2 cells have their own plane test that does not batch.
+      visible = this->isBoundingVolumeVisible(*pBoundingVolume);
+    }
+
+    if (visible) {
+      return true;
+    }
+  }
+
+  return boxes.flush() || spheres.flush();
+}
+
+bool ViewState::isAnyBoundingVolumeVisible(
+    gsl::span<const OrientedBoundingBox> boundingBoxes) const noexcept {
+  return isAnyVisible(getCullingPlanes(this->_cullingVolume), boundingBoxes);
+}
+
+bool ViewState::isAnyBoundingVolumeVisible(
+    gsl::span<const BoundingSphere> boundingSpheres) const noexcept {
+  return isAnyVisible(getCullingPlanes(this->_cullingVolume), boundingSpheres);
+}
+
 double ViewState::computeDistanceSquaredToBoundingVolume(
     const BoundingVolume& boundingVolume) const noexcept {
   struct Operation {
@@ -131,13 +276,17 @@ double ViewState::computeDistanceSquaredToBoundingVolume(
       return boundingBox.computeDistanceSquaredToPosition(viewState._position);
     }
 
+    // The camera's cartographic position is computed once, when the view is
+    // created. Without one, the camera is too close to the center of the
+    // ellipsoid for the region's planes to mean anything, and only the
+    // distance to the box of the region is used, as the region itself would.
     double operator()(const BoundingRegion& boundingRegion) noexcept {
       if (viewState._positionCartographic) {
         return boundingRegion.computeDistanceSquaredToPosition(
             viewState._positionCartographic.value(),
             viewState._position);
       }
-      return boundingRegion.computeDistanceSquaredToPosition(
+      return boundingRegion.getBoundingBox().computeDistanceSquaredToPosition(
           viewState._position);
     }
 
@@ -153,8 +302,9 @@ double ViewState::computeDistanceSquaredToBoundingVolume(
             viewState._positionCartographic.value(),
             viewState._position);
       }
-      return boundingRegion.computeConservativeDistanceSquaredToPosition(
-          viewState._position);
+      return boundingRegion.getBoundingRegion()
+          .getBoundingBox()
+          .computeDistanceSquaredToPosition(viewState._position);
     }
 
     double operator()(const S2CellBoundingVolume& s2Cell) noexcept {
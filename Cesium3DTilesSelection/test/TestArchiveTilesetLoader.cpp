@@ -0,0 +1,252 @@
+#include "ArchiveTilesetLoader.h"
+#include "SimplePrepareRendererResource.h"
+
+#include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+#include <CesiumUtility/CreditSystem.h>
+#include <CesiumUtility/Gunzip.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumNativeTests;
+using namespace CesiumUtility;
+
+namespace {
+std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+
+const std::string archiveUrl = "https://example.com/AddTileset.3tz";
+
+void writeLittleEndian(std::vector<std::byte>& out, uint64_t value, size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    out.emplace_back(std::byte((value >> (8 * i)) & 0xff));
+  }
+}
+
+// Creates a zip archive of the given files, without checksums. Files are
+// deflated if that makes them smaller.
+std::vector<std::byte> createArchive(
+    const std::vector<std::pair<std::string, std::vector<std::byte>>>& files) {
+  std::vector<std::byte> archive;
+  std::vector<std::byte> centralDirectory;
+
+  for (const auto& [path, data] : files) {
+    uint16_t method = 0;
+    std::vector<std::byte> compressed = data;
+    std::vector<std::byte> gzipped;
+    if (gzip(data, gzipped) && gzipped.size() - 18 < data.size()) {
+      // Without its header and trailer, gzip data is raw deflate data.
+      method = 8;
+      compressed.assign(gzipped.begin() + 10, gzipped.end() - 8);
+    }
+
+    const uint64_t localHeaderOffset = archive.size();
+    for (std::vector<std::byte>* pHeader : {&archive, &centralDirectory}) {
+      const bool isCentral = pHeader == &centralDirectory;
+      writeLittleEndian(*pHeader, isCentral ? 0x02014b50 : 0x04034b50, 4);
+      if (isCentral) {
+        writeLittleEndian(*pHeader, 20, 2); // version made by
+      }
+      writeLittleEndian(*pHeader, 20, 2); // version needed to extract
+      writeLittleEndian(*pHeader, 0, 2);  // flags
+      writeLittleEndian(*pHeader, method, 2);
+      writeLittleEndian(*pHeader, 0, 4); // modification time and date
+      writeLittleEndian(*pHeader, 0, 4); // CRC-32
+      writeLittleEndian(*pHeader, compressed.size(), 4);
+      writeLittleEndian(*pHeader, data.size(), 4);
+      writeLittleEndian(*pHeader, path.size(), 2);
+      writeLittleEndian(*pHeader, 0, 2); // extra field length
+      if (isCentral) {
+        writeLittleEndian(*pHeader, 0, 2); // comment length
+        writeLittleEndian(*pHeader, 0, 2); // disk number
+        writeLittleEndian(*pHeader, 0, 2); // internal attributes
+        writeLittleEndian(*pHeader, 0, 4); // external attributes
+        writeLittleEndian(*pHeader, localHeaderOffset, 4);
+      }
+      for (char c : path) {
+        pHeader->emplace_back(std::byte(c));
+      }
+    }
+    archive.insert(archive.end(), compressed.begin(), compressed.end());
+  }
+
+  const uint64_t centralDirectoryOffset = archive.size();
+  archive.insert(
+      archive.end(),
+      centralDirectory.begin(),
+      centralDirectory.end());
+
+  writeLittleEndian(archive, 0x06054b50, 4);
+  writeLittleEndian(archive, 0, 4); // disk numbers
+  writeLittleEndian(archive, files.size(), 2);
+  writeLittleEndian(archive, files.size(), 2);
+  writeLittleEndian(archive, centralDirectory.size(), 4);
+  writeLittleEndian(archive, centralDirectoryOffset, 4);
+  writeLittleEndian(archive, 0, 2); // comment length
+
+  return archive;
+}
+
+// Serves an archive, and answers range requests for it unless told to ignore
+// them.
+class MockArchiveAssetAccessor : public IAssetAccessor {
+public:
+  MockArchiveAssetAccessor(std::vector<std::byte>&& archive_, bool ranges_)
+      : archive(std::move(archive_)), ranges(ranges_), requestCount(0) {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    ++this->requestCount;
+    REQUIRE(url == archiveUrl);
+
+    const HttpHeaders requestHeaders(headers.begin(), headers.end());
+    auto rangeIt = requestHeaders.find("Range");
+    if (!this->ranges || rangeIt == requestHeaders.end()) {
+      return this->respond(asyncSystem, url, 200, HttpHeaders{}, this->archive);
+    }
+
+    const std::string& range = rangeIt->second;
+    const size_t dash = range.find('-');
+    const size_t size = this->archive.size();
+    size_t first;
+    size_t last = size - 1;
+    if (dash == 6) {
+      first = size - std::min<size_t>(std::stoul(range.substr(7)), size);
+    } else {
+      first = std::stoul(range.substr(6, dash - 6));
+      if (dash + 1 < range.size()) {
+        last = std::min<size_t>(std::stoul(range.substr(dash + 1)), last);
+      }
+    }
+
+    HttpHeaders responseHeaders{
+        {"Content-Range",
+         "bytes " + std::to_string(first) + "-" + std::to_string(last) + "/" +
+             std::to_string(size)}};
+    return this->respond(
+        asyncSystem,
+        url,
+        206,
+        responseHeaders,
+        std::vector<std::byte>(
+            this->archive.begin() + static_cast<std::ptrdiff_t>(first),
+            this->archive.begin() + static_cast<std::ptrdiff_t>(last + 1)));
+  }
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& /* verb */,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>&) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+
+  std::vector<std::byte> archive;
+  bool ranges;
+  int32_t requestCount;
+
+private:
+  Future<std::shared_ptr<IAssetRequest>> respond(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      uint16_t statusCode,
+      const HttpHeaders& headers,
+      const std::vector<std::byte>& data) {
+    std::shared_ptr<IAssetRequest> pRequest =
+        std::make_shared<SimpleAssetRequest>(
+            "GET",
+            url,
+            HttpHeaders{},
+            std::make_unique<SimpleAssetResponse>(
+                statusCode,
+                "application/zip",
+                headers,
+                data));
+    return asyncSystem.createResolvedFuture(std::move(pRequest));
+  }
+};
+} // namespace
+
+TEST_CASE("Test loading a tileset from a 3D Tiles archive") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  const bool ranges = GENERATE(true, false);
+  std::shared_ptr<MockArchiveAssetAccessor> pAssetAccessor =
+      std::make_shared<MockArchiveAssetAccessor>(
+          createArchive(
+              {{"tileset.json",
+                readFile(testDataPath / "AddTileset" / "tileset.json")},
+               {"tileset2.json",
+                readFile(testDataPath / "AddTileset" / "tileset2.json")}}),
+          ranges);
+
+  AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+  TilesetExternals externals{
+      pAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      asyncSystem,
+      std::make_shared<CreditSystem>()};
+
+  auto loaderResultFuture =
+      ArchiveTilesetLoader::createLoader(externals, archiveUrl, {});
+  asyncSystem.dispatchMainThreadTasks();
+  auto loaderResult = loaderResultFuture.wait();
+
+  REQUIRE(!loaderResult.errors);
+  REQUIRE(loaderResult.pLoader);
+  REQUIRE(loaderResult.pRootTile);
+  REQUIRE(loaderResult.pRootTile->getChildren().size() == 1);
+
+  // The end of a small archive includes its central directory.
+  CHECK(pAssetAccessor->requestCount == (ranges ? 2 : 1));
+
+  Tile& tile = loaderResult.pRootTile->getChildren()[0];
+  CHECK(std::get<TileUrl>(tile.getTileID()) == "tileset2.json");
+
+  const TilesetContentOptions contentOptions;
+  const std::shared_ptr<IAssetAccessor> pTileAssetAccessor = pAssetAccessor;
+  const std::shared_ptr<spdlog::logger> pLogger = spdlog::default_logger();
+  const std::vector<IAssetAccessor::THeader> requestHeaders;
+  TileLoadInput loadInput{
+      tile,
+      contentOptions,
+      asyncSystem,
+      pTileAssetAccessor,
+      pLogger,
+      requestHeaders};
+  auto tileLoadResultFuture = loaderResult.pLoader->loadTileContent(loadInput);
+  asyncSystem.dispatchMainThreadTasks();
+  auto tileLoadResult = tileLoadResultFuture.wait();
+
+  CHECK(tileLoadResult.state == TileLoadResultState::Success);
+  CHECK(
+      std::holds_alternative<TileExternalContent>(tileLoadResult.contentKind));
+  REQUIRE(tileLoadResult.pCompletedRequest);
+  CHECK(
+      tileLoadResult.pCompletedRequest->url() == archiveUrl + "/tileset2.json");
+  CHECK(pAssetAccessor->requestCount == (ranges ? 3 : 1));
+}
+
+TEST_CASE("Test recognizing the URL of a 3D Tiles archive") {
+  CHECK(ArchiveTilesetLoader::isArchiveUrl("https://example.com/a.3tz"));
+  CHECK(ArchiveTilesetLoader::isArchiveUrl("https://example.com/a.3TZ?k=v"));
+  CHECK(!ArchiveTilesetLoader::isArchiveUrl("https://example.com/a.json"));
+  CHECK(!ArchiveTilesetLoader::isArchiveUrl("https://example.com/a.3tz/b"));
+}
@@ -0,0 +1,456 @@
+#include "CesiumIonTilesetLoader.h"
+#include "SimplePrepareRendererResource.h"
+
+#include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+#include <CesiumUtility/CreditSystem.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumNativeTests;
+using namespace CesiumUtility;
+
+namespace {
+std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+
+const std::string ionAccessToken = "ion-token";
+const std::string ionAssetEndpointUrl = "https://api.example.com/";
+const std::string tilesetUrl = "https://assets.example.com/tileset.json";
+
+class MockCacheDatabase : public ICacheDatabase {
+public:
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override {
+    auto it = this->entries.find(key);
+    if (it == this->entries.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    this->entries.insert_or_assign(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(
+                HttpHeaders(requestHeaders),
+                std::string(requestMethod),
+                std::string(url)),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    return true;
+  }
+
+  virtual bool prune() override { return true; }
+
+  virtual bool clearAll() override {
+    this->entries.clear();
+    return true;
+  }
+
+  std::map<std::string, CacheItem> entries;
+};
+
+std::string getEndpointUrl(int64_t ionAssetID) {
+  return ionAssetEndpointUrl + "v1/assets/" + std::to_string(ionAssetID) +
+         "/endpoint?access_token=" + ionAccessToken;
+}
+
+std::vector<std::byte> createEndpointResponse(
+    const std::string& url,
+    const std::string& accessToken) {
+  const std::string json = "{\"type\":\"3DTILES\",\"url\":\"" + url +
+                           "\",\"accessToken\":\"" + accessToken + "\"}";
+  const std::byte* pBegin = reinterpret_cast<const std::byte*>(json.data());
+  return std::vector<std::byte>(pBegin, pBegin + json.size());
+}
+
+std::string toString(const std::vector<std::byte>& data) {
+  return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+std::shared_ptr<SimpleAssetRequest>
+createRequest(const std::string& url, std::vector<std::byte>&& data) {
+  return std::make_shared<SimpleAssetRequest>(
+      "GET",
+      url,
+      HttpHeaders{},
+      std::make_unique<SimpleAssetResponse>(
+          static_cast<uint16_t>(200),
+          "application/json",
+          HttpHeaders{},
+          std::move(data)));
+}
+
+// Rejects the requests of tile content that aren't authorized with the given
+// token.
+class AuthorizingAssetAccessor : public SimpleAssetAccessor {
+public:
+  AuthorizingAssetAccessor(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>&&
+          mockCompletedRequests,
+      const std::string& endpointUrl_,
+      const std::string& validToken_)
+      : SimpleAssetAccessor{std::move(mockCompletedRequests)},
+        endpointUrl{endpointUrl_},
+        validToken{validToken_} {}
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    if (url == this->endpointUrl) {
+      ++this->endpointRequestCount;
+    } else if (url != tilesetUrl) {
+      const THeader authorization{"Authorization", "Bearer " + validToken};
+      if (std::find(headers.begin(), headers.end(), authorization) ==
+          headers.end()) {
+        ++this->rejectedRequestCount;
+        return asyncSystem.createResolvedFuture(
+            std::shared_ptr<CesiumAsync::IAssetRequest>(
+                std::make_shared<SimpleAssetRequest>(
+                    "GET",
+                    url,
+                    HttpHeaders{},
+                    std::make_unique<SimpleAssetResponse>(
+                        static_cast<uint16_t>(401),
+                        "application/json",
+                        HttpHeaders{},
+                        std::vector<std::byte>{}))));
+      }
+    }
+    return SimpleAssetAccessor::get(asyncSystem, url, headers);
+  }
+
+  std::string endpointUrl;
+  std::string validToken;
+  int32_t endpointRequestCount = 0;
+  int32_t rejectedRequestCount = 0;
+};
+
+void storeEndpointResponse(
+    MockCacheDatabase& cache,
+    int64_t ionAssetID,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& accessToken) {
+  const std::string endpointUrl = getEndpointUrl(ionAssetID);
+  cache.storeEntry(
+      "ion-endpoint " + endpointUrl,
+      expiryTime,
+      endpointUrl,
+      "GET",
+      HttpHeaders{},
+      200,
+      HttpHeaders{},
+      createEndpointResponse(url, accessToken));
+}
+} // namespace
+
+TEST_CASE("Test keeping Cesium ion endpoints across sessions") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  auto pCache = std::make_shared<MockCacheDatabase>();
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> mockRequests;
+  mockRequests.insert(
+      {tilesetUrl,
+       createRequest(
+           tilesetUrl,
+           readFile(testDataPath / "ReplaceTileset" / "tileset.json"))});
+  auto pMockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockRequests));
+
+  AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+  TilesetExternals externals{
+      pMockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      asyncSystem,
+      std::make_shared<CreditSystem>()};
+  externals.pIonEndpointCache = pCache;
+
+  std::string authorizationHeader;
+  auto headerChangeListener =
+      [&authorizationHeader](const std::string&, const std::string& value) {
+        authorizationHeader = value;
+      };
+
+  // The endpoints of the loaders are also kept in memory for the rest of the
+  // session, so each section uses an asset of its own.
+  auto createLoader = [&](int64_t ionAssetID) {
+    auto loaderFuture = CesiumIonTilesetLoader::createLoader(
+        externals,
+        TilesetContentOptions{},
+        ionAssetID,
+        ionAccessToken,
+        ionAssetEndpointUrl,
+        headerChangeListener,
+        false);
+    asyncSystem.dispatchMainThreadTasks();
+    return loaderFuture.wait();
+  };
+
+  SECTION("stores the endpoint response") {
+    const int64_t ionAssetID = 970001;
+    const std::string endpointUrl = getEndpointUrl(ionAssetID);
+    pMockAssetAccessor->mockCompletedRequests.insert(
+        {endpointUrl,
+         createRequest(
+             endpointUrl,
+             createEndpointResponse(tilesetUrl, "new-token"))});
+
+    auto loaderResult = createLoader(ionAssetID);
+    REQUIRE(loaderResult.pLoader);
+    CHECK(!loaderResult.errors);
+
+    auto entryIt = pCache->entries.find("ion-endpoint " + endpointUrl);
+    REQUIRE(entryIt != pCache->entries.end());
+    CHECK(entryIt->second.expiryTime > std::time(nullptr));
+    CHECK(
+        toString(entryIt->second.cacheResponse.data) ==
+        toString(createEndpointResponse(tilesetUrl, "new-token")));
+  }
+
+  SECTION("loads from a stored endpoint without waiting for the API") {
+    const int64_t ionAssetID = 970002;
+    storeEndpointResponse(
+        *pCache,
+        ionAssetID,
+        std::time(nullptr) + 60,
+        tilesetUrl,
+        "stored-token");
+
+    // The accessor doesn't know the endpoint, so requesting it fails the test.
+    auto loaderResult = createLoader(ionAssetID);
+    REQUIRE(loaderResult.pLoader);
+    REQUIRE(loaderResult.pRootTile);
+    CHECK(!loaderResult.errors);
+    REQUIRE(loaderResult.requestHeaders.size() == 1);
+    CHECK(loaderResult.requestHeaders[0].second == "Bearer stored-token");
+
+    // Once a tile loads, the endpoint is requested again, and the new token
+    // is used and stored.
+    const std::string endpointUrl = getEndpointUrl(ionAssetID);
+    const std::string contentUrl = "https://assets.example.com/parent.b3dm";
+    pMockAssetAccessor->mockCompletedRequests.insert(
+        {endpointUrl,
+         createRequest(
+             endpointUrl,
+             createEndpointResponse(tilesetUrl, "new-token"))});
+    pMockAssetAccessor->mockCompletedRequests.insert(
+        {contentUrl,
+         createRequest(
+             contentUrl,
+             readFile(testDataPath / "ReplaceTileset" / "parent.b3dm"))});
+
+    REQUIRE(loaderResult.pRootTile->getChildren().size() == 1);
+    const Tile& tile = loaderResult.pRootTile->getChildren()[0];
+    TileLoadInput loadInput{
+        tile,
+        {},
+        asyncSystem,
+        pMockAssetAccessor,
+        spdlog::default_logger(),
+        loaderResult.requestHeaders};
+    auto tileLoadResultFuture =
+        loaderResult.pLoader->loadTileContent(loadInput);
+    asyncSystem.dispatchMainThreadTasks();
+    CHECK(tileLoadResultFuture.wait().state == TileLoadResultState::Success);
+
+    CHECK(authorizationHeader == "Bearer new-token");
+    auto entryIt = pCache->entries.find("ion-endpoint " + endpointUrl);
+    REQUIRE(entryIt != pCache->entries.end());
+    CHECK(
+        toString(entryIt->second.cacheResponse.data) ==
+        toString(createEndpointResponse(tilesetUrl, "new-token")));
+  }
+
+  SECTION("doesn't use an expired endpoint") {
+    const int64_t ionAssetID = 970003;
+    storeEndpointResponse(
+        *pCache,
+        ionAssetID,
+        std::time(nullptr) - 60,
+        "https://assets.example.com/old/tileset.json",
+        "stored-token");
+
+    const std::string endpointUrl = getEndpointUrl(ionAssetID);
+    pMockAssetAccessor->mockCompletedRequests.insert(
+        {endpointUrl,
+         createRequest(
+             endpointUrl,
+             createEndpointResponse(tilesetUrl, "new-token"))});
+
+    auto loaderResult = createLoader(ionAssetID);
+    REQUIRE(loaderResult.pLoader);
+    CHECK(!loaderResult.errors);
+    REQUIRE(loaderResult.requestHeaders.size() == 1);
+    CHECK(loaderResult.requestHeaders[0].second == "Bearer new-token");
+  }
+}
+
+TEST_CASE("Test refreshing Cesium ion tokens") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  const std::string parentUrl = "https://assets.example.com/parent.b3dm";
+  const std::string childUrl = "https://assets.example.com/ll.b3dm";
+
+  // Tokens that expire in 2001 and 2100.
+  const std::string expiringToken = "e30.eyJleHAiOjEwMDAwMDAwMDB9.signature";
+  const std::string validToken = "e30.eyJleHAiOjQxMDI0NDQ4MDB9.signature";
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> mockRequests;
+  mockRequests.insert(
+      {tilesetUrl,
+       createRequest(
+           tilesetUrl,
+           readFile(testDataPath / "ReplaceTileset" / "tileset.json"))});
+  mockRequests.insert(
+      {parentUrl,
+       createRequest(
+           parentUrl,
+           readFile(testDataPath / "ReplaceTileset" / "parent.b3dm"))});
+  mockRequests.insert(
+      {childUrl,
+       createRequest(
+           childUrl,
+           readFile(testDataPath / "ReplaceTileset" / "ll.b3dm"))});
+  auto pMockAssetAccessor = std::make_shared<AuthorizingAssetAccessor>(
+      std::move(mockRequests),
+      "",
+      validToken);
+
+  AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+  TilesetExternals externals{
+      pMockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      asyncSystem,
+      std::make_shared<CreditSystem>()};
+
+  std::vector<CesiumAsync::IAssetAccessor::THeader> requestHeaders;
+  auto headerChangeListener = [&requestHeaders](
+                                  const std::string& header,
+                                  const std::string& value) {
+    REQUIRE(requestHeaders.size() == 1);
+    CHECK(requestHeaders[0].first == header);
+    requestHeaders[0].second = value;
+  };
+
+  // The endpoints of the loaders are also kept in memory for the rest of the
+  // session, so each section uses an asset of its own.
+  auto createLoader = [&](int64_t ionAssetID, const std::string& accessToken) {
+    const std::string endpointUrl = getEndpointUrl(ionAssetID);
+    pMockAssetAccessor->endpointUrl = endpointUrl;
+    pMockAssetAccessor->mockCompletedRequests[endpointUrl] = createRequest(
+        endpointUrl,
+        createEndpointResponse(tilesetUrl, accessToken));
+    auto loaderFuture = CesiumIonTilesetLoader::createLoader(
+        externals,
+        TilesetContentOptions{},
+        ionAssetID,
+        ionAccessToken,
+        ionAssetEndpointUrl,
+        headerChangeListener,
+        false);
+    asyncSystem.dispatchMainThreadTasks();
+    auto loaderResult = loaderFuture.wait();
+    REQUIRE(loaderResult.pLoader);
+    REQUIRE(loaderResult.pRootTile);
+    requestHeaders = loaderResult.requestHeaders;
+
+    // Later requests of the endpoint give the valid token.
+    pMockAssetAccessor->mockCompletedRequests[endpointUrl] = createRequest(
+        endpointUrl,
+        createEndpointResponse(tilesetUrl, validToken));
+    return loaderResult;
+  };
+
+  auto loadTiles = [&](TilesetContentLoader& loader, const Tile& rootTile) {
+    REQUIRE(rootTile.getChildren().size() == 1);
+    const Tile& parent = rootTile.getChildren()[0];
+    REQUIRE(!parent.getChildren().empty());
+    const Tile& child = parent.getChildren()[0];
+
+    TileLoadInput parentLoadInput{
+        parent,
+        {},
+        asyncSystem,
+        pMockAssetAccessor,
+        spdlog::default_logger(),
+        requestHeaders};
+    TileLoadInput childLoadInput{
+        child,
+        {},
+        asyncSystem,
+        pMockAssetAccessor,
+        spdlog::default_logger(),
+        requestHeaders};
+    auto parentFuture = loader.loadTileContent(parentLoadInput);
+    auto childFuture = loader.loadTileContent(childLoadInput);
+    asyncSystem.dispatchMainThreadTasks();
+    CHECK(parentFuture.wait().state == TileLoadResultState::Success);
+    CHECK(childFuture.wait().state == TileLoadResultState::Success);
+  };
+
+  SECTION("tiles that are rejected wait for one refresh and are retried") {
+    auto loaderResult = createLoader(970101, "rejected-token");
+    const int32_t endpointRequestCount =
+        pMockAssetAccessor->endpointRequestCount;
+
+    loadTiles(*loaderResult.pLoader, *loaderResult.pRootTile);
+    CHECK(pMockAssetAccessor->rejectedRequestCount == 2);
+    CHECK(
+        pMockAssetAccessor->endpointRequestCount == endpointRequestCount + 1);
+    CHECK(requestHeaders[0].second == "Bearer " + validToken);
+  }
+
+  SECTION("a token is refreshed before it expires") {
+    auto loaderResult = createLoader(970102, expiringToken);
+    const int32_t endpointRequestCount =
+        pMockAssetAccessor->endpointRequestCount;
+
+    loadTiles(*loaderResult.pLoader, *loaderResult.pRootTile);
+    CHECK(
+        pMockAssetAccessor->endpointRequestCount == endpointRequestCount + 1);
+    CHECK(requestHeaders[0].second == "Bearer " + validToken);
+  }
+
+  SECTION("a token isn't refreshed long before it expires") {
+    auto loaderResult = createLoader(970103, validToken);
+    const int32_t endpointRequestCount =
+        pMockAssetAccessor->endpointRequestCount;
+
+    loadTiles(*loaderResult.pLoader, *loaderResult.pRootTile);
+    CHECK(pMockAssetAccessor->rejectedRequestCount == 0);
+    CHECK(pMockAssetAccessor->endpointRequestCount == endpointRequestCount);
+  }
+}
@@ -146,3 +146,41 @@ TEST_CASE("Test setting showOnScreen on credits") {
   CHECK(creditSystem.shouldBeShownOnScreen(credit1) == true);
   CHECK(creditSystem.shouldBeShownOnScreen(credit2) == true);
 }
+
+TEST_CASE("Test adding credits in bulk") {
+
+  CreditSystem creditSystem;
+
+  std::vector<Credit> credits;
+  for (int i = 0; i < 100; i++) {
+    credits.push_back(creditSystem.createCredit(
+        "<html>Credit" + std::to_string(i) + "</html>"));
+  }
+
+  REQUIRE(creditSystem.createCredit("<html>Credit42</html>") == credits[42]);
+
+  // Frame 0: Add all of the credits, each more than once
+  creditSystem.addCreditsToFrame(credits);
+  creditSystem.addCreditsToFrame(credits);
+  REQUIRE(creditSystem.getCreditsToShowThisFrame().size() == credits.size());
+  REQUIRE(creditSystem.getCreditsToNoLongerShowThisFrame().empty());
+
+  // Start frame 1: Add the even credits, remove the odd ones
+  creditSystem.startNextFrame();
+
+  std::vector<Credit> evenCredits;
+  std::vector<Credit> oddCredits;
+  for (size_t i = 0; i < credits.size(); i++) {
+    (i % 2 == 0 ? evenCredits : oddCredits).push_back(credits[i]);
+  }
+  creditSystem.addCreditsToFrame(evenCredits);
+
+  REQUIRE(creditSystem.getCreditsToShowThisFrame() == evenCredits);
+  REQUIRE(creditSystem.getCreditsToNoLongerShowThisFrame() == oddCredits);
+
+  // Credits that are added after the list of those to no longer show is
+  // requested are removed from it, too
+  creditSystem.addCreditToFrame(oddCredits[0]);
+  oddCredits.erase(oddCredits.begin());
+  REQUIRE(creditSystem.getCreditsToNoLongerShowThisFrame() == oddCredits);
+}
@@ -15,6 +15,9 @@
 #include <catch2/catch.hpp>
 
 #include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
 
 using namespace Cesium3DTilesContent;
 using namespace Cesium3DTilesSelection;
@@ -540,3 +543,207 @@ TEST_CASE("Test tile subdivision for implicit quadtree loader") {
     CHECK(box_1_1_1.getCellID().toToken() == "14");
   }
 }
+
+TEST_CASE("Implicit quadtree loader reuses the storage of released children") {
+  OrientedBoundingBox loaderBoundingVolume{glm::dvec3(0.0), glm::dmat3(20.0)};
+  ImplicitQuadtreeLoader loader{
+      "tileset.json",
+      "content/{level}.{x}.{y}.b3dm",
+      "subtrees/{level}.{x}.{y}.json",
+      5,
+      5,
+      loaderBoundingVolume};
+
+  loader.addSubtreeAvailability(
+      QuadtreeTileID{0, 0, 0},
+      SubtreeAvailability{
+          ImplicitTileSubdivisionScheme::Quadtree,
+          5,
+          SubtreeAvailability::SubtreeConstantAvailability{true},
+          SubtreeAvailability::SubtreeConstantAvailability{false},
+          {SubtreeAvailability::SubtreeConstantAvailability{true}},
+          {}});
+
+  Tile tile(&loader);
+  tile.setTileID(QuadtreeTileID(0, 0, 0));
+  tile.setBoundingVolume(loaderBoundingVolume);
+
+  TileChildrenResult first = loader.createTileChildren(tile);
+  REQUIRE(first.state == TileLoadResultState::Success);
+  REQUIRE(first.children.size() == 4);
+  const Tile* pFirstStorage = first.children.data();
+
+  loader.releaseTileChildren(std::move(first.children));
+
+  TileChildrenResult second = loader.createTileChildren(tile);
+  REQUIRE(second.state == TileLoadResultState::Success);
+  REQUIRE(second.children.size() == 4);
+  CHECK(second.children.data() == pFirstStorage);
+}
+
+TEST_CASE("Implicit quadtree loader prefetches child subtrees") {
+  OrientedBoundingBox loaderBoundingVolume{glm::dvec3(0.0), glm::dmat3(20.0)};
+  ImplicitQuadtreeLoader loader{
+      "tileset.json",
+      "content/{level}.{x}.{y}.b3dm",
+      "subtrees/{level}.{x}.{y}.json",
+      2,
+      4,
+      loaderBoundingVolume};
+
+  // All tiles and child subtrees are available, but no content, so that
+  // loading a tile doesn't request anything but the child subtrees.
+  loader.addSubtreeAvailability(
+      QuadtreeTileID{0, 0, 0},
+      SubtreeAvailability{
+          ImplicitTileSubdivisionScheme::Quadtree,
+          2,
+          SubtreeAvailability::SubtreeConstantAvailability{true},
+          SubtreeAvailability::SubtreeConstantAvailability{true},
+          {SubtreeAvailability::SubtreeConstantAvailability{false}},
+          {}});
+
+  // The child subtrees below the tile (1, 0, 0).
+  const std::vector<QuadtreeTileID> childSubtreeIDs{
+      QuadtreeTileID(2, 0, 0),
+      QuadtreeTileID(2, 1, 0),
+      QuadtreeTileID(2, 0, 1),
+      QuadtreeTileID(2, 1, 1)};
+
+  const std::string subtreeJson = R"({
+    "tileAvailability": {"constant": 1},
+    "contentAvailability": [{"constant": 0}],
+    "childSubtreeAvailability": {"constant": 0}
+  })";
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+  for (const QuadtreeTileID& id : childSubtreeIDs) {
+    const std::string url = "subtrees/2." + std::to_string(id.x) + "." +
+                            std::to_string(id.y) + ".json";
+    const std::byte* pBegin =
+        reinterpret_cast<const std::byte*>(subtreeJson.data());
+    requests.emplace(
+        url,
+        std::make_shared<SimpleAssetRequest>(
+            "GET",
+            url,
+            CesiumAsync::HttpHeaders{},
+            std::make_unique<SimpleAssetResponse>(
+                static_cast<uint16_t>(200),
+                "doesn't matter",
+                CesiumAsync::HttpHeaders{},
+                std::vector<std::byte>(
+                    pBegin,
+                    pBegin + subtreeJson.size()))));
+  }
+  auto pMockedAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(requests));
+  CesiumAsync::AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+
+  auto countLoadedChildSubtrees = [&]() {
+    size_t count = 0;
+    for (const QuadtreeTileID& id : childSubtreeIDs) {
+      Tile childSubtreeRoot(&loader);
+      childSubtreeRoot.setTileID(id);
+      childSubtreeRoot.setBoundingVolume(loaderBoundingVolume);
+      TileChildrenResult result = loader.createTileChildren(childSubtreeRoot);
+      if (result.state == TileLoadResultState::Success) {
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  Tile tile(&loader);
+  tile.setTileID(QuadtreeTileID(1, 0, 0));
+
+  TilesetContentOptions contentOptions;
+  contentOptions.maximumSimultaneousSubtreeLoads = 3;
+
+  TileLoadInput loadInput{
+      tile,
+      contentOptions,
+      asyncSystem,
+      pMockedAssetAccessor,
+      spdlog::default_logger(),
+      {}};
+
+  SECTION("loads the available child subtrees, a few at a time") {
+    auto tileLoadResultFuture = loader.loadTileContent(loadInput);
+    asyncSystem.dispatchMainThreadTasks();
+    CHECK(tileLoadResultFuture.wait().state == TileLoadResultState::Success);
+    CHECK(countLoadedChildSubtrees() == 3);
+
+    // The next load of the tile starts the rest.
+    auto nextTileLoadResultFuture = loader.loadTileContent(loadInput);
+    asyncSystem.dispatchMainThreadTasks();
+    CHECK(
+        nextTileLoadResultFuture.wait().state == TileLoadResultState::Success);
+    CHECK(countLoadedChildSubtrees() == 4);
+  }
+
+  SECTION("doesn't prefetch when disabled") {
+    contentOptions.subtreePrefetchLevels = 0;
+    auto tileLoadResultFuture = loader.loadTileContent(loadInput);
+    asyncSystem.dispatchMainThreadTasks();
+    CHECK(tileLoadResultFuture.wait().state == TileLoadResultState::Success);
+    CHECK(countLoadedChildSubtrees() == 0);
+  }
+}
+
+TEST_CASE("Implicit quadtree loader unloads subtrees without tiles") {
+  OrientedBoundingBox loaderBoundingVolume{glm::dvec3(0.0), glm::dmat3(20.0)};
+  ImplicitQuadtreeLoader loader{
+      "tileset.json",
+      "content/{level}.{x}.{y}.b3dm",
+      "subtrees/{level}.{x}.{y}.json",
+      2,
+      4,
+      loaderBoundingVolume};
+
+  auto createAvailability = []() {
+    return SubtreeAvailability{
+        ImplicitTileSubdivisionScheme::Quadtree,
+        2,
+        SubtreeAvailability::SubtreeConstantAvailability{true},
+        SubtreeAvailability::SubtreeConstantAvailability{true},
+        {SubtreeAvailability::SubtreeConstantAvailability{false}},
+        {}};
+  };
+  loader.addSubtreeAvailability(QuadtreeTileID{0, 0, 0}, createAvailability());
+  loader.addSubtreeAvailability(QuadtreeTileID{2, 0, 0}, createAvailability());
+
+  Tile tile(&loader);
+  tile.setTileID(QuadtreeTileID(1, 0, 0));
+  tile.setBoundingVolume(loaderBoundingVolume);
+
+  // The children of the tile are the roots of the child subtrees.
+  TileChildrenResult children = loader.createTileChildren(tile);
+  REQUIRE(children.state == TileLoadResultState::Success);
+  REQUIRE(children.children.size() == 4);
+  const Tile& childSubtreeRoot =
+      findTile(children.children, QuadtreeTileID(2, 0, 0));
+
+  // The subtree is kept while the root of the subtree exists, even once the
+  // other tiles in it are gone.
+  TileChildrenResult grandchildren =
+      loader.createTileChildren(childSubtreeRoot);
+  REQUIRE(grandchildren.state == TileLoadResultState::Success);
+  loader.releaseTileChildren(std::move(grandchildren.children));
+
+  TileChildrenResult recreatedGrandchildren =
+      loader.createTileChildren(childSubtreeRoot);
+  CHECK(recreatedGrandchildren.state == TileLoadResultState::Success);
+  loader.releaseTileChildren(std::move(recreatedGrandchildren.children));
+
+  loader.releaseTileChildren(std::move(children.children));
+
+  Tile recreatedChildSubtreeRoot(&loader);
+  recreatedChildSubtreeRoot.setTileID(QuadtreeTileID(2, 0, 0));
+  recreatedChildSubtreeRoot.setBoundingVolume(loaderBoundingVolume);
+  CHECK(
+      loader.createTileChildren(recreatedChildSubtreeRoot).state ==
+      TileLoadResultState::RetryLater);
+
+  // The root subtree is never unloaded.
+  CHECK(loader.createTileChildren(tile).state == TileLoadResultState::Success);
+}
@@ -0,0 +1,269 @@
+#include "Cesium3DTilesContent/registerAllTileContentTypes.h"
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTilesSelection/ViewState.h"
+#include "SimplePrepareRendererResource.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/CachingAssetAccessor.h>
+#include <CesiumAsync/SqliteCache.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/SimulatedAssetAccessor.h>
+#include <CesiumNativeTests/readFile.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+#include <glm/geometric.hpp>
+#include <spdlog/spdlog.h>
+
+#include <cmath>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+using namespace CesiumNativeTests;
+using namespace CesiumUtility;
+
+namespace {
+std::shared_ptr<SimpleAssetRequest>
+createRequest(const std::string& url, std::vector<std::byte>&& data) {
+  return std::make_shared<SimpleAssetRequest>(
+      "GET",
+      url,
+      HttpHeaders{},
+      std::make_unique<SimpleAssetResponse>(
+          static_cast<uint16_t>(200),
+          "doesn't matter",
+          HttpHeaders{{"Cache-Control", "max-age=86400"}},
+          std::move(data)));
+}
+
+std::shared_ptr<SimpleAssetAccessor> createTilesetAccessor() {
+  const std::filesystem::path testDataPath =
+      std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) /
+      "ReplaceTileset";
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+  for (const std::string& file :
+       {"tileset.json",
+        "parent.b3dm",
+        "ll.b3dm",
+        "lr.b3dm",
+        "ul.b3dm",
+        "ur.b3dm",
+        "ll_ll.b3dm"}) {
+    requests.emplace(file, createRequest(file, readFile(testDataPath / file)));
+  }
+  return std::make_shared<SimpleAssetAccessor>(std::move(requests));
+}
+
+ViewState zoomToTile(const Tile& tile) {
+  const BoundingRegion* pRegion =
+      std::get_if<BoundingRegion>(&tile.getBoundingVolume());
+  REQUIRE(pRegion != nullptr);
+
+  Cartographic corner = pRegion->getRectangle().getNorthwest();
+  corner.height = pRegion->getMaximumHeight();
+  const glm::dvec3 position =
+      Ellipsoid::WGS84.cartographicToCartesian(corner);
+  const glm::dvec3 focus = Ellipsoid::WGS84.cartographicToCartesian(
+      pRegion->getRectangle().computeCenter());
+  const double fieldOfView = Math::degreesToRadians(60.0);
+  return ViewState::create(
+      position,
+      glm::normalize(focus - position),
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(500.0, 500.0),
+      fieldOfView,
+      fieldOfView);
+}
+
+struct LoadLatency {
+  std::optional<double> timeToFirstRender;
+  std::optional<double> timeToFullDetail;
+};
+
+// Loads the tileset over the simulated network, one frame at a time, until
+// every tile that the view needs is loaded or a minute of simulated time has
+// passed. The times are in seconds since the tileset was created.
+LoadLatency measureLoadLatency(
+    SimulatedAssetAccessor& network,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor) {
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+  TilesetExternals externals{
+      pAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      asyncSystem,
+      nullptr};
+  Tileset tileset(externals, "tileset.json");
+
+  const double frameTime = 1.0 / 60.0;
+  const double startTime = network.getTime();
+  std::optional<ViewState> viewState;
+  LoadLatency latency;
+  while (network.getTime() - startTime < 60.0) {
+    network.advanceTime(frameTime);
+    asyncSystem.dispatchMainThreadTasks();
+
+    const Tile* pRootTile = tileset.getRootTile();
+    if (!pRootTile) {
+      continue;
+    }
+    if (!viewState) {
+      viewState = zoomToTile(*pRootTile);
+    }
+
+    const ViewUpdateResult& result =
+        tileset.updateView({*viewState}, static_cast<float>(frameTime));
+    const double time = network.getTime() - startTime;
+    if (!latency.timeToFirstRender && !result.tilesToRenderThisFrame.empty()) {
+      latency.timeToFirstRender = time;
+    }
+    if (tileset.computeLoadProgress() >= 100.0f) {
+      latency.timeToFullDetail = time;
+      break;
+    }
+  }
+
+  return latency;
+}
+} // namespace
+
+TEST_CASE("SimulatedAssetAccessor") {
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+  std::shared_ptr<SimpleAssetAccessor> pTilesetAccessor =
+      createTilesetAccessor();
+  SimulatedNetworkOptions options;
+  options.medianLatency = 0.1;
+
+  SECTION("completes requests after their latency") {
+    SimulatedAssetAccessor network(pTilesetAccessor, options);
+    Future<std::shared_ptr<IAssetRequest>> future =
+        network.get(asyncSystem, "tileset.json", {});
+
+    network.advanceTime(0.05);
+    CHECK(!future.isReady());
+    network.advanceTime(0.06);
+    REQUIRE(future.isReady());
+    CHECK(future.wait()->response()->statusCode() == 200);
+    CHECK(network.getPendingRequestCount() == 0);
+  }
+
+  SECTION("limits the requests that are in flight to a host") {
+    options.maximumRequestsPerHost = 1;
+    SimulatedAssetAccessor network(pTilesetAccessor, options);
+    Future<std::shared_ptr<IAssetRequest>> first =
+        network.get(asyncSystem, "ll.b3dm", {});
+    Future<std::shared_ptr<IAssetRequest>> second =
+        network.get(asyncSystem, "lr.b3dm", {});
+
+    network.advanceTime(0.15);
+    CHECK(first.isReady());
+    CHECK(!second.isReady());
+    network.advanceTime(0.1);
+    CHECK(second.isReady());
+  }
+
+  SECTION("shares the bandwidth between the responses") {
+    // Each response takes a second to transfer.
+    const std::vector<std::byte> data = readFile(
+        std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) /
+        "ReplaceTileset" / "ll.b3dm");
+    options.medianLatency = 0.0;
+    options.bandwidth = double(data.size());
+    SimulatedAssetAccessor network(pTilesetAccessor, options);
+    Future<std::shared_ptr<IAssetRequest>> first =
+        network.get(asyncSystem, "ll.b3dm", {});
+    Future<std::shared_ptr<IAssetRequest>> second =
+        network.get(asyncSystem, "ll.b3dm", {});
+
+    network.advanceTime(1.5);
+    CHECK(first.isReady());
+    CHECK(!second.isReady());
+    network.advanceTime(1.0);
+    CHECK(second.isReady());
+  }
+
+  SECTION("fails the given fraction of requests") {
+    options.failureRate = 1.0;
+    SimulatedAssetAccessor network(pTilesetAccessor, options);
+    Future<std::shared_ptr<IAssetRequest>> future =
+        network.get(asyncSystem, "tileset.json", {});
+
+    // Ticking completes the next request, whenever it's done.
+    network.tick();
+    REQUIRE(future.isReady());
+    CHECK(future.wait()->response()->statusCode() == 503);
+    CHECK(network.getFailedRequestCount() == 1);
+    CHECK(network.getTime() == Approx(0.1));
+  }
+}
+
+TEST_CASE("Load latency of a tileset over a simulated network") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  SimulatedNetworkOptions options;
+  options.medianLatency = 0.1;
+  options.latencyDeviation = 0.5;
+  options.bandwidth = 100000.0;
+  options.maximumRequestsPerHost = 2;
+
+  std::shared_ptr<SimulatedAssetAccessor> pNetwork =
+      std::make_shared<SimulatedAssetAccessor>(
+          createTilesetAccessor(),
+          options);
+  const LoadLatency latency = measureLoadLatency(*pNetwork, pNetwork);
+  REQUIRE(latency.timeToFirstRender);
+  REQUIRE(latency.timeToFullDetail);
+  CHECK(*latency.timeToFirstRender <= *latency.timeToFullDetail);
+
+  SECTION("is the same under the same conditions") {
+    std::shared_ptr<SimulatedAssetAccessor> pSameNetwork =
+        std::make_shared<SimulatedAssetAccessor>(
+            createTilesetAccessor(),
+            options);
+    const LoadLatency same = measureLoadLatency(*pSameNetwork, pSameNetwork);
+    CHECK(same.timeToFirstRender == latency.timeToFirstRender);
+    CHECK(same.timeToFullDetail == latency.timeToFullDetail);
+  }
+
+  SECTION("is shorter once the tiles are cached") {
+    std::shared_ptr<SqliteCache> pCache = std::make_shared<SqliteCache>(
+        spdlog::default_logger(),
+        "test-load-latency.db",
+        4096,
+        0);
+    pCache->clearAll();
+
+    std::shared_ptr<SimulatedAssetAccessor> pCachedNetwork =
+        std::make_shared<SimulatedAssetAccessor>(
+            createTilesetAccessor(),
+            options);
+    std::shared_ptr<CachingAssetAccessor> pCachingAccessor =
+        std::make_shared<CachingAssetAccessor>(
+            spdlog::default_logger(),
+            pCachedNetwork,
+            pCache);
+
+    const LoadLatency uncached =
+        measureLoadLatency(*pCachedNetwork, pCachingAccessor);
+    REQUIRE(uncached.timeToFullDetail);
+
+    const size_t requestCount = pCachedNetwork->getRequestCount();
+    const LoadLatency cached =
+        measureLoadLatency(*pCachedNetwork, pCachingAccessor);
+    REQUIRE(cached.timeToFullDetail);
+    CHECK(*cached.timeToFullDetail < *uncached.timeToFullDetail);
+    CHECK(pCachedNetwork->getRequestCount() == requestCount);
+  }
+}
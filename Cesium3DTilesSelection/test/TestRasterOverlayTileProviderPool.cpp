@@ -0,0 +1,96 @@
+#include "SimplePrepareRendererResource.h"
+
+#include <Cesium3DTilesSelection/RasterOverlayCollection.h>
+#include <Cesium3DTilesSelection/RasterOverlayTileProviderPool.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/TilesetExternals.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumRasterOverlays/DebugColorizeTilesRasterOverlay.h>
+#include <CesiumUtility/CreditSystem.h>
+#include <CesiumUtility/IntrusivePointer.h>
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+using namespace CesiumNativeTests;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+TEST_CASE("RasterOverlayTileProviderPool") {
+  AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+  TilesetExternals externals{
+      std::make_shared<SimpleAssetAccessor>(
+          std::map<std::string, std::shared_ptr<SimpleAssetRequest>>{}),
+      std::make_shared<SimplePrepareRendererResource>(),
+      asyncSystem,
+      std::make_shared<CreditSystem>()};
+
+  IntrusivePointer<RasterOverlay> pOverlay =
+      new DebugColorizeTilesRasterOverlay("Shared");
+
+  SECTION("collections that share a pool share tile providers") {
+    auto pPool = std::make_shared<RasterOverlayTileProviderPool>();
+    externals.pRasterOverlayTileProviderPool = pPool;
+
+    Tile::LoadedLinkedList firstTiles;
+    Tile::LoadedLinkedList secondTiles;
+    RasterOverlayCollection first{firstTiles, externals};
+    RasterOverlayCollection second{secondTiles, externals};
+    first.add(pOverlay);
+    second.add(pOverlay);
+    asyncSystem.dispatchMainThreadTasks();
+
+    CHECK(pPool->size() == 1);
+    const RasterOverlayTileProvider* pProvider =
+        first.findTileProviderForOverlay(*pOverlay);
+    REQUIRE(pProvider);
+    CHECK(!pProvider->isPlaceholder());
+    CHECK(second.findTileProviderForOverlay(*pOverlay) == pProvider);
+
+    // Each collection still has its own placeholder.
+    CHECK(
+        first.findPlaceholderTileProviderForOverlay(*pOverlay) !=
+        second.findPlaceholderTileProviderForOverlay(*pOverlay));
+
+    // The tile provider stays in the pool while any collection uses it.
+    first.remove(pOverlay);
+    CHECK(pPool->size() == 1);
+    CHECK(second.findTileProviderForOverlay(*pOverlay) == pProvider);
+    second.remove(pOverlay);
+    CHECK(pPool->size() == 0);
+
+    // A new tile provider is created when the overlay is used again.
+    first.add(pOverlay);
+    asyncSystem.dispatchMainThreadTasks();
+    CHECK(pPool->size() == 1);
+    REQUIRE(first.findTileProviderForOverlay(*pOverlay));
+    CHECK(!first.findTileProviderForOverlay(*pOverlay)->isPlaceholder());
+  }
+
+  SECTION("collections without a pool have their own tile providers") {
+    Tile::LoadedLinkedList firstTiles;
+    Tile::LoadedLinkedList secondTiles;
+    RasterOverlayCollection first{firstTiles, externals};
+    RasterOverlayCollection second{secondTiles, externals};
+    first.add(pOverlay);
+    second.add(pOverlay);
+    asyncSystem.dispatchMainThreadTasks();
+
+    const RasterOverlayTileProvider* pFirst =
+        first.findTileProviderForOverlay(*pOverlay);
+    const RasterOverlayTileProvider* pSecond =
+        second.findTileProviderForOverlay(*pOverlay);
+    REQUIRE(pFirst);
+    REQUIRE(pSecond);
+    CHECK(!pFirst->isPlaceholder());
+    CHECK(!pSecond->isPlaceholder());
+    CHECK(pFirst != pSecond);
+  }
+}
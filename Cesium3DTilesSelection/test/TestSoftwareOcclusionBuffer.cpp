@@ -0,0 +1,81 @@
+#include "SoftwareOcclusionBuffer.h"
+
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+TEST_CASE("SoftwareOcclusionBuffer") {
+  // A camera on the equator, 2000 meters up, looking north.
+  const ViewState viewState = ViewState::create(
+      Ellipsoid::WGS84.cartographicToCartesian(Cartographic(0.0, 0.0, 2000.0)),
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec3(1.0, 0.0, 0.0),
+      glm::dvec2(500.0, 500.0),
+      Math::degreesToRadians(60.0),
+      Math::degreesToRadians(60.0));
+
+  // A plateau 1500 meters high, from 3 to 19 kilometers north of the camera.
+  const BoundingRegion plateau(
+      GlobeRectangle(-0.003, 0.0005, 0.003, 0.003),
+      1500.0,
+      1600.0);
+
+  // A valley behind the plateau.
+  const BoundingRegion valley(
+      GlobeRectangle(-0.0005, 0.004, 0.0005, 0.0045),
+      0.0,
+      200.0);
+
+  SoftwareOcclusionBuffer buffer;
+  buffer.reset(viewState, 128);
+  CHECK(buffer.getWidth() == 128);
+  CHECK(buffer.getHeight() == 128);
+
+  SECTION("Nothing is occluded without occluders") {
+    CHECK(!buffer.hasOccluders());
+    CHECK(!buffer.isOccluded(valley));
+  }
+
+  SECTION("A region behind the ground below an occluder is occluded") {
+    buffer.addOccluder(plateau);
+    REQUIRE(buffer.hasOccluders());
+    CHECK(buffer.isOccluded(valley));
+  }
+
+  SECTION("A region above the occluder is not occluded") {
+    buffer.addOccluder(plateau);
+    const BoundingRegion clouds(
+        GlobeRectangle(-0.0005, 0.004, 0.0005, 0.0045),
+        5000.0,
+        5200.0);
+    CHECK(!buffer.isOccluded(clouds));
+  }
+
+  SECTION("A region in front of the occluder is not occluded") {
+    buffer.addOccluder(plateau);
+    const BoundingRegion hill(
+        GlobeRectangle(-0.0001, 0.00039, 0.0001, 0.00041),
+        1800.0,
+        1850.0);
+    CHECK(!buffer.isOccluded(hill));
+  }
+
+  SECTION("Occluders that reach behind the camera are ignored") {
+    const BoundingRegion underCamera(
+        GlobeRectangle(-0.003, -0.003, 0.003, 0.003),
+        1500.0,
+        1600.0);
+    buffer.addOccluder(underCamera);
+    CHECK(!buffer.hasOccluders());
+    CHECK(!buffer.isOccluded(valley));
+  }
+}
@@ -0,0 +1,78 @@
+#include "TerrainAvailabilityCache.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+
+namespace {
+// The tiles of the western root tile down to level 5, and the southern half
+// of them at level 6.
+bool isAvailable(const QuadtreeTileID& tileID) {
+  if (tileID.level > 6) {
+    return false;
+  }
+
+  const uint32_t width = 1U << tileID.level;
+  if (tileID.level == 6) {
+    return tileID.x < width && tileID.y < width / 2;
+  }
+  return tileID.x < width;
+}
+} // namespace
+
+TEST_CASE("TerrainAvailabilityCache") {
+  TerrainAvailabilityCache cache;
+  size_t lookups = 0;
+  const auto countingIsAvailable = [&lookups](const QuadtreeTileID& tileID) {
+    ++lookups;
+    return isAvailable(tileID);
+  };
+
+  SECTION("gives the availability of the tiles") {
+    for (uint32_t level = 0; level < 9; ++level) {
+      const uint32_t width = 1U << level;
+      for (uint32_t y = 0; y < width; ++y) {
+        for (uint32_t x = 0; x < 2 * width; ++x) {
+          const QuadtreeTileID tileID(level, x, y);
+          CHECK(
+              cache.isTileAvailable(tileID, countingIsAvailable) ==
+              isAvailable(tileID));
+        }
+      }
+    }
+  }
+
+  SECTION("looks up the tiles of a block once") {
+    CHECK(cache.isTileAvailable(QuadtreeTileID(0, 0, 0), countingIsAvailable));
+    CHECK(cache.size() == 1);
+    const size_t lookupsOfBlock = lookups;
+
+    CHECK(cache.isTileAvailable(QuadtreeTileID(3, 7, 7), countingIsAvailable));
+    CHECK(cache.isTileAvailable(QuadtreeTileID(1, 1, 0), countingIsAvailable));
+    CHECK(lookups == lookupsOfBlock);
+    CHECK(cache.size() == 1);
+
+    CHECK(cache.isTileAvailable(QuadtreeTileID(4, 0, 0), countingIsAvailable));
+    CHECK(cache.size() == 2);
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+  }
+
+  SECTION("doesn't look up the descendants of unavailable tiles") {
+    CHECK(!cache.isTileAvailable(QuadtreeTileID(3, 8, 0), countingIsAvailable));
+    CHECK(lookups == 1);
+  }
+
+  SECTION("is cleared when it has too many blocks") {
+    TerrainAvailabilityCache smallCache(2);
+    CHECK(smallCache.isTileAvailable(QuadtreeTileID(4, 0, 0), isAvailable));
+    CHECK(smallCache.isTileAvailable(QuadtreeTileID(4, 1, 0), isAvailable));
+    CHECK(smallCache.size() == 2);
+    CHECK(smallCache.isTileAvailable(QuadtreeTileID(4, 0, 1), isAvailable));
+    CHECK(smallCache.size() == 1);
+  }
+}
@@ -0,0 +1,108 @@
+#include "TileDecodeThrottle.h"
+
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+using namespace CesiumNativeTests;
+
+TEST_CASE("TileDecodeThrottle") {
+  AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+
+  SECTION("grants slots up to the limit, then in arrival order") {
+    auto pThrottle = std::make_shared<TileDecodeThrottle>(2);
+
+    Future<void> first = pThrottle->acquire(asyncSystem);
+    Future<void> second = pThrottle->acquire(asyncSystem);
+    Future<void> third = pThrottle->acquire(asyncSystem);
+    Future<void> fourth = pThrottle->acquire(asyncSystem);
+    CHECK(first.isReady());
+    CHECK(second.isReady());
+    CHECK(!third.isReady());
+    CHECK(!fourth.isReady());
+    CHECK(pThrottle->getNumberOfTilesDecoding() == 2);
+    CHECK(pThrottle->getNumberOfTilesWaiting() == 2);
+
+    pThrottle->release();
+    CHECK(third.isReady());
+    CHECK(!fourth.isReady());
+    CHECK(pThrottle->getNumberOfTilesDecoding() == 2);
+    CHECK(pThrottle->getNumberOfTilesWaiting() == 1);
+
+    // Raising the limit grants the new slots right away.
+    pThrottle->setMaximumSimultaneousDecodes(3);
+    CHECK(fourth.isReady());
+    CHECK(pThrottle->getNumberOfTilesDecoding() == 3);
+    CHECK(pThrottle->getNumberOfTilesWaiting() == 0);
+
+    // Lowering it lets the extra slots drain instead of handing them on.
+    pThrottle->setMaximumSimultaneousDecodes(1);
+    Future<void> fifth = pThrottle->acquire(asyncSystem);
+    pThrottle->release();
+    pThrottle->release();
+    CHECK(!fifth.isReady());
+    pThrottle->release();
+    CHECK(fifth.isReady());
+    pThrottle->release();
+    CHECK(pThrottle->getNumberOfTilesDecoding() == 0);
+  }
+
+  SECTION("never waits without a limit") {
+    auto pThrottle = std::make_shared<TileDecodeThrottle>(0);
+    for (int i = 0; i < 100; ++i) {
+      CHECK(pThrottle->acquire(asyncSystem).isReady());
+    }
+    CHECK(pThrottle->getNumberOfTilesDecoding() == 100);
+    CHECK(pThrottle->getNumberOfTilesWaiting() == 0);
+  }
+
+  SECTION("a tile holds a single slot for all of its responses") {
+    auto pMockCompletedResponse = std::make_unique<SimpleAssetResponse>(
+        static_cast<uint16_t>(200),
+        "doesn't matter",
+        HttpHeaders{},
+        std::vector<std::byte>{});
+    auto pMockCompletedRequest = std::make_shared<SimpleAssetRequest>(
+        "GET",
+        "content.glb",
+        HttpHeaders{},
+        std::move(pMockCompletedResponse));
+    auto pMockAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+        std::map<std::string, std::shared_ptr<SimpleAssetRequest>>{
+            {"content.glb", pMockCompletedRequest}});
+
+    auto pThrottle = std::make_shared<TileDecodeThrottle>(1);
+    auto pFirstSlot = std::make_shared<TileDecodeSlot>(pThrottle);
+    auto pSecondSlot = std::make_shared<TileDecodeSlot>(pThrottle);
+    TileDecodeSlotAssetAccessor firstAccessor(pMockAssetAccessor, pFirstSlot);
+    TileDecodeSlotAssetAccessor secondAccessor(pMockAssetAccessor, pSecondSlot);
+
+    auto firstContent = firstAccessor.get(asyncSystem, "content.glb", {});
+    auto firstBuffer = firstAccessor.get(asyncSystem, "content.glb", {});
+    auto secondContent = secondAccessor.get(asyncSystem, "content.glb", {});
+    CHECK(firstContent.isReady());
+    CHECK(firstBuffer.isReady());
+    CHECK(!secondContent.isReady());
+    CHECK(pThrottle->getNumberOfTilesDecoding() == 1);
+    CHECK(pThrottle->getNumberOfTilesWaiting() == 1);
+
+    pFirstSlot->release();
+    CHECK(secondContent.isReady());
+    CHECK(secondContent.wait() == pMockCompletedRequest);
+
+    // Releasing twice does nothing.
+    pFirstSlot->release();
+    CHECK(pThrottle->getNumberOfTilesDecoding() == 1);
+    pSecondSlot->release();
+    CHECK(pThrottle->getNumberOfTilesDecoding() == 0);
+  }
+}
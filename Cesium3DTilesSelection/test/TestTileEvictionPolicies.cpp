@@ -0,0 +1,75 @@
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/TileEvictionPolicies.h>
+#include <CesiumGltf/Model.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+
+namespace {
+void setContentSize(Tile& tile, size_t bytes) {
+  CesiumGltf::Model model;
+  model.buffers.emplace_back().cesium.data.resize(bytes);
+  tile.getContent().setContentKind(
+      std::make_unique<TileRenderContent>(std::move(model)));
+}
+} // namespace
+
+TEST_CASE("Tile eviction policies") {
+  // A root with two children, the first of which has two children of its own.
+  Tile root(nullptr);
+  std::vector<Tile> children;
+  children.emplace_back(nullptr);
+  children.emplace_back(nullptr);
+  root.createChildTiles(std::move(children));
+  Tile& left = root.getChildren()[0];
+  Tile& right = root.getChildren()[1];
+
+  std::vector<Tile> grandchildren;
+  grandchildren.emplace_back(nullptr);
+  grandchildren.emplace_back(nullptr);
+  left.createChildTiles(std::move(grandchildren));
+  Tile& leftLeft = left.getChildren()[0];
+  Tile& leftRight = left.getChildren()[1];
+
+  setContentSize(left, 10);
+  setContentSize(right, 30);
+  setContentSize(leftRight, 20);
+
+  const std::vector<Tile*> rendered{&leftLeft};
+
+  SECTION("LRU keeps the candidates in order") {
+    LruTileEvictionPolicy policy;
+    std::vector<Tile*> candidates{&left, &right, &leftRight};
+    policy.orderEvictionCandidates(candidates, rendered);
+    CHECK(candidates == std::vector<Tile*>{&left, &right, &leftRight});
+  }
+
+  SECTION("Cost-aware unloads the largest tiles first by default") {
+    CostAwareTileEvictionPolicy policy;
+    std::vector<Tile*> candidates{&left, &right, &leftRight};
+    policy.orderEvictionCandidates(candidates, rendered);
+    CHECK(candidates == std::vector<Tile*>{&right, &leftRight, &left});
+  }
+
+  SECTION("Cost-aware keeps the tiles that are expensive to reload") {
+    CostAwareTileEvictionPolicy policy([&right](const Tile& tile) {
+      return &tile == &right ? 10.0 : 1.0;
+    });
+    std::vector<Tile*> candidates{&left, &right, &leftRight};
+    policy.orderEvictionCandidates(candidates, rendered);
+    CHECK(candidates == std::vector<Tile*>{&leftRight, &left, &right});
+  }
+
+  SECTION("Ancestor pinning keeps the ancestors of rendered tiles") {
+    AncestorPinningTileEvictionPolicy policy(
+        std::make_shared<CostAwareTileEvictionPolicy>());
+    std::vector<Tile*> candidates{&root, &left, &right, &leftRight};
+    policy.orderEvictionCandidates(candidates, rendered);
+    CHECK(candidates == std::vector<Tile*>{&right, &leftRight});
+  }
+}
@@ -0,0 +1,317 @@
+#include "Cesium3DTilesContent/registerAllTileContentTypes.h"
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTilesSelection/ViewState.h"
+#include "SimplePrepareRendererResource.h"
+
+#include <Cesium3DTilesSelection/ClippingTileExcluder.h>
+#include <Cesium3DTilesSelection/ITileExcluder.h>
+#include <Cesium3DTilesSelection/RasterizedPolygonsTileExcluder.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumGeometry/Plane.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/GeographicProjection.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+#include <CesiumRasterOverlays/RasterizedPolygonsOverlay.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+#include <glm/vec2.hpp>
+
+#include <cmath>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumNativeTests;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace {
+class CountingExcluder : public ITileExcluder {
+public:
+  explicit CountingExcluder(TileExclusion exclusion_) : exclusion(exclusion_) {}
+
+  bool shouldExclude(const Tile& /* tile */) const noexcept override {
+    return false;
+  }
+
+  TileExclusion evaluateTile(const Tile& /* tile */) const noexcept override {
+    ++this->calls;
+    return this->exclusion;
+  }
+
+  TileExclusion exclusion;
+  mutable size_t calls = 0;
+};
+
+class ShouldExcludeOnly : public ITileExcluder {
+public:
+  bool shouldExclude(const Tile& tile) const noexcept override {
+    return tile.getGeometricError() > 1.0;
+  }
+};
+
+Tile createTile(const GlobeRectangle& rectangle) {
+  Tile tile(nullptr);
+  tile.setBoundingVolume(BoundingRegion(rectangle, 0.0, 10.0));
+  return tile;
+}
+
+ViewState zoomToTile(const Tile& tile) {
+  const BoundingRegion* pRegion =
+      std::get_if<BoundingRegion>(&tile.getBoundingVolume());
+  REQUIRE(pRegion != nullptr);
+
+  const GlobeRectangle& rectangle = pRegion->getRectangle();
+  Cartographic corner = rectangle.getNorthwest();
+  corner.height = pRegion->getMaximumHeight();
+
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  const glm::dvec3 viewPosition = ellipsoid.cartographicToCartesian(corner);
+  const glm::dvec3 viewFocus =
+      ellipsoid.cartographicToCartesian(rectangle.computeCenter());
+  const double fieldOfView = Math::degreesToRadians(60.0);
+  return ViewState::create(
+      viewPosition,
+      glm::normalize(viewFocus - viewPosition),
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(500.0, 500.0),
+      fieldOfView,
+      fieldOfView);
+}
+
+std::shared_ptr<SimpleAssetAccessor> createTilesetAccessor() {
+  const std::filesystem::path testDataPath =
+      std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) /
+      "ReplaceTileset";
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+  for (const std::string& file :
+       {"tileset.json",
+        "parent.b3dm",
+        "ll.b3dm",
+        "lr.b3dm",
+        "ul.b3dm",
+        "ur.b3dm",
+        "ll_ll.b3dm"}) {
+    requests.emplace(
+        file,
+        std::make_shared<SimpleAssetRequest>(
+            "GET",
+            file,
+            HttpHeaders{},
+            std::make_unique<SimpleAssetResponse>(
+                static_cast<uint16_t>(200),
+                "doesn't matter",
+                HttpHeaders{},
+                readFile(testDataPath / file))));
+  }
+  return std::make_shared<SimpleAssetAccessor>(std::move(requests));
+}
+} // namespace
+
+TEST_CASE("ITileExcluder::evaluateTile defaults to shouldExclude") {
+  const ShouldExcludeOnly excluder;
+  Tile tile(nullptr);
+
+  tile.setGeometricError(2.0);
+  CHECK(excluder.evaluateTile(tile) == TileExclusion::Excluded);
+
+  tile.setGeometricError(0.5);
+  CHECK(excluder.evaluateTile(tile) == TileExclusion::Included);
+}
+
+TEST_CASE("RasterizedPolygonsTileExcluder") {
+  const std::vector<CartographicPolygon> polygons{CartographicPolygon(
+      std::vector<glm::dvec2>{
+          glm::dvec2(0.0, 0.0),
+          glm::dvec2(0.1, 0.0),
+          glm::dvec2(0.1, 0.1),
+          glm::dvec2(0.0, 0.1)})};
+
+  const Tile inside = createTile(GlobeRectangle(0.04, 0.04, 0.06, 0.06));
+  const Tile outside = createTile(GlobeRectangle(0.5, 0.5, 0.6, 0.6));
+  const Tile overlapping = createTile(GlobeRectangle(0.05, 0.05, 0.2, 0.2));
+
+  SECTION("excludes the tiles inside the polygons") {
+    const RasterizedPolygonsTileExcluder excluder(
+        new RasterizedPolygonsOverlay(
+            "polygons",
+            polygons,
+            false,
+            Ellipsoid::WGS84,
+            GeographicProjection()));
+
+    CHECK(excluder.evaluateTile(inside) == TileExclusion::Excluded);
+    CHECK(
+        excluder.evaluateTile(outside) ==
+        TileExclusion::IncludedWithDescendants);
+    CHECK(excluder.evaluateTile(overlapping) == TileExclusion::Included);
+
+    CHECK(excluder.shouldExclude(inside));
+    CHECK(!excluder.shouldExclude(outside));
+    CHECK(!excluder.shouldExclude(overlapping));
+  }
+
+  SECTION("excludes the tiles outside the polygons when inverted") {
+    const RasterizedPolygonsTileExcluder excluder(
+        new RasterizedPolygonsOverlay(
+            "polygons",
+            polygons,
+            true,
+            Ellipsoid::WGS84,
+            GeographicProjection()));
+
+    CHECK(
+        excluder.evaluateTile(inside) ==
+        TileExclusion::IncludedWithDescendants);
+    CHECK(excluder.evaluateTile(outside) == TileExclusion::Excluded);
+    CHECK(excluder.evaluateTile(overlapping) == TileExclusion::Included);
+  }
+}
+
+TEST_CASE("ClippingTileExcluder") {
+  const std::vector<CartographicPolygon> polygons{CartographicPolygon(
+      std::vector<glm::dvec2>{
+          glm::dvec2(0.0, 0.0),
+          glm::dvec2(0.1, 0.0),
+          glm::dvec2(0.1, 0.1),
+          glm::dvec2(0.0, 0.1)})};
+
+  const Tile inside = createTile(GlobeRectangle(0.04, 0.04, 0.06, 0.06));
+  const Tile outside = createTile(GlobeRectangle(0.5, 0.5, 0.6, 0.6));
+  const Tile overlapping = createTile(GlobeRectangle(0.05, 0.05, 0.2, 0.2));
+
+  // Clips away everything with a y coordinate below that of the polygons'
+  // northeast corner.
+  const double radius = Ellipsoid::WGS84.getMaximumRadius();
+  const Plane plane(glm::dvec3(0.0, 1.0, 0.0), -0.1 * radius);
+
+  SECTION("excludes the tiles behind a plane") {
+    const ClippingTileExcluder excluder({plane});
+    CHECK(excluder.evaluateTile(inside) == TileExclusion::Excluded);
+    CHECK(
+        excluder.evaluateTile(outside) ==
+        TileExclusion::IncludedWithDescendants);
+    CHECK(excluder.evaluateTile(overlapping) == TileExclusion::Included);
+
+    CHECK(excluder.shouldExclude(inside));
+    CHECK(!excluder.isPartiallyClipped(outside));
+    CHECK(excluder.isPartiallyClipped(overlapping));
+  }
+
+  SECTION("excludes the tiles inside the polygons, or outside if inverted") {
+    const ClippingTileExcluder excluder({}, polygons);
+    CHECK(excluder.evaluateTile(inside) == TileExclusion::Excluded);
+    CHECK(
+        excluder.evaluateTile(outside) ==
+        TileExclusion::IncludedWithDescendants);
+    CHECK(excluder.evaluateTile(overlapping) == TileExclusion::Included);
+
+    const ClippingTileExcluder inverted({}, polygons, true);
+    CHECK(
+        inverted.evaluateTile(inside) ==
+        TileExclusion::IncludedWithDescendants);
+    CHECK(inverted.evaluateTile(outside) == TileExclusion::Excluded);
+    CHECK(inverted.evaluateTile(overlapping) == TileExclusion::Included);
+  }
+
+  SECTION("keeps a tile entirely only if no plane or polygon clips it") {
+    const Plane keepAll(glm::dvec3(1.0, 0.0, 0.0), 0.0);
+    const ClippingTileExcluder excluder({keepAll, plane}, polygons, true);
+    CHECK(excluder.evaluateTile(inside) == TileExclusion::Excluded);
+    CHECK(excluder.evaluateTile(outside) == TileExclusion::Excluded);
+    CHECK(excluder.evaluateTile(overlapping) == TileExclusion::Included);
+
+    const ClippingTileExcluder planesOnly({keepAll});
+    CHECK(
+        planesOnly.evaluateTile(inside) ==
+        TileExclusion::IncludedWithDescendants);
+  }
+}
+
+TEST_CASE("Tileset doesn't load tiles that are entirely clipped away") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::shared_ptr<SimpleAssetAccessor> pAssetAccessor =
+      createTilesetAccessor();
+  TilesetExternals externals{
+      pAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  // Every point is behind this plane.
+  const Plane clipAll(glm::dvec3(1.0, 0.0, 0.0), -1.0e8);
+  TilesetOptions options;
+  options.excluders = {std::make_shared<ClippingTileExcluder>(
+      std::vector<Plane>{clipAll})};
+
+  Tileset tileset(externals, "tileset.json", options);
+  tileset.updateView({});
+  const Tile* pRootTile = tileset.getRootTile();
+  REQUIRE(pRootTile);
+
+  const ViewState viewState = zoomToTile(*pRootTile);
+  for (int i = 0; i < 5; ++i) {
+    pAssetAccessor->tick();
+    const ViewUpdateResult& result = tileset.updateView({viewState});
+    CHECK(result.tilesToRenderThisFrame.empty());
+    CHECK(result.workerThreadTileLoadQueueLength == 0);
+  }
+
+  CHECK(pRootTile->getState() == TileLoadState::Unloaded);
+}
+
+TEST_CASE("Tileset skips excluders that included a whole subtree") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::shared_ptr<SimpleAssetAccessor> pAssetAccessor =
+      createTilesetAccessor();
+  TilesetExternals externals{
+      pAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  std::shared_ptr<CountingExcluder> pWholeSubtree =
+      std::make_shared<CountingExcluder>(
+          TileExclusion::IncludedWithDescendants);
+  std::shared_ptr<CountingExcluder> pEachTile =
+      std::make_shared<CountingExcluder>(TileExclusion::Included);
+  TilesetOptions options;
+  options.excluders = {pWholeSubtree, pEachTile};
+
+  Tileset tileset(externals, "tileset.json", options);
+  tileset.updateView({});
+  const Tile* pRootTile = tileset.getRootTile();
+  REQUIRE(pRootTile);
+
+  const ViewState viewState = zoomToTile(*pRootTile);
+  for (int i = 0; i < 10; ++i) {
+    pAssetAccessor->tick();
+    pWholeSubtree->calls = 0;
+    pEachTile->calls = 0;
+
+    tileset.updateView({viewState});
+
+    // Only the root is evaluated by the excluder that included its subtree.
+    CHECK(pWholeSubtree->calls == 1);
+    CHECK(pEachTile->calls >= pWholeSubtree->calls);
+  }
+
+  // Once loaded, the tileset is refined below the root.
+  CHECK(pEachTile->calls > 1);
+}
@@ -0,0 +1,102 @@
+#include "TileHibernationCache.h"
+
+#include <Cesium3DTilesSelection/Tile.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGltf;
+
+namespace {
+Model createModel(std::byte value) {
+  Model model;
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(1000, value);
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+  model.extras["gltfUpAxis"] = 2;
+  return model;
+}
+} // namespace
+
+TEST_CASE("TileHibernationCache") {
+  const Tile first(nullptr);
+  const Tile second(nullptr);
+  const Model firstModel = createModel(std::byte(1));
+  const Model secondModel = createModel(std::byte(2));
+
+  SECTION("doesn't keep tiles by default") {
+    TileHibernationCache cache;
+    CHECK(cache.beginHibernating(&first) == 0);
+    CHECK(cache.size() == 0);
+    CHECK(!cache.take(&first));
+  }
+
+  SECTION("gives back the model of a tile once") {
+    TileHibernationCache cache(1000000);
+    const uint64_t ticket = cache.beginHibernating(&first);
+    REQUIRE(ticket != 0);
+
+    // The tile can't be taken before its model is compressed.
+    CHECK(!cache.take(&second));
+    cache.finishHibernating(&first, ticket, firstModel, std::nullopt);
+    CHECK(cache.size() == 1);
+    CHECK(cache.getTotalBytes() > 0);
+    CHECK(cache.getTotalBytes() < 1000);
+
+    std::shared_ptr<const HibernatedTileContent> pContent = cache.take(&first);
+    REQUIRE(pContent);
+    CHECK(cache.size() == 0);
+    CHECK(cache.getTotalBytes() == 0);
+    CHECK(!cache.take(&first));
+
+    std::optional<Model> model = cache.decompress(*pContent);
+    REQUIRE(model);
+    REQUIRE(model->buffers.size() == 1);
+    CHECK(model->buffers[0].cesium.data == firstModel.buffers[0].cesium.data);
+    CHECK(model->extras["gltfUpAxis"].getSafeNumberOrDefault<int32_t>(0) == 2);
+  }
+
+  SECTION("drops a model whose tile was removed while it was compressed") {
+    TileHibernationCache cache(1000000);
+    const uint64_t staleTicket = cache.beginHibernating(&first);
+    cache.remove(&first);
+    cache.finishHibernating(&first, staleTicket, firstModel, std::nullopt);
+    CHECK(cache.size() == 0);
+
+    // Only the latest hibernation of a tile is kept.
+    const uint64_t oldTicket = cache.beginHibernating(&first);
+    const uint64_t newTicket = cache.beginHibernating(&first);
+    cache.finishHibernating(&first, oldTicket, firstModel, std::nullopt);
+    CHECK(cache.size() == 0);
+    cache.finishHibernating(&first, newTicket, secondModel, std::nullopt);
+    std::shared_ptr<const HibernatedTileContent> pContent = cache.take(&first);
+    REQUIRE(pContent);
+    std::optional<Model> model = cache.decompress(*pContent);
+    REQUIRE(model);
+    CHECK(model->buffers[0].cesium.data == secondModel.buffers[0].cesium.data);
+  }
+
+  SECTION("drops the tiles unloaded longest ago when it is full") {
+    TileHibernationCache cache(1000000);
+    cache.finishHibernating(
+        &first,
+        cache.beginHibernating(&first),
+        firstModel,
+        std::nullopt);
+    const int64_t bytesPerTile = cache.getTotalBytes();
+    cache.setMaximumBytes(bytesPerTile + bytesPerTile / 2);
+
+    cache.finishHibernating(
+        &second,
+        cache.beginHibernating(&second),
+        secondModel,
+        std::nullopt);
+    CHECK(cache.size() == 1);
+    CHECK(!cache.take(&first));
+    CHECK(cache.take(&second));
+  }
+}
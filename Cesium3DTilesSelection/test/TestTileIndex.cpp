@@ -0,0 +1,151 @@
+#include "SimplePrepareRendererResource.h"
+#include "TileIndex.h"
+
+#include <Cesium3DTilesContent/registerAllTileContentTypes.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumGeometry/OctreeTileID.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumNativeTests;
+
+TEST_CASE("TileIndex") {
+  Tile root(nullptr);
+  root.setTileID("root.glb");
+
+  std::vector<Tile> children;
+  for (uint32_t i = 0; i < 4; ++i) {
+    children.emplace_back(nullptr);
+  }
+  children[0].setTileID(QuadtreeTileID(1, 0, 0));
+  children[1].setTileID(OctreeTileID(1, 0, 0, 1));
+  children[2].setTileID(UpsampledQuadtreeNode{QuadtreeTileID(1, 0, 0)});
+  children[3].setTileID("");
+  root.createChildTiles(std::move(children));
+  gsl::span<Tile> childTiles = root.getChildren();
+
+  TileIndex index;
+  index.addSubtree(root);
+
+  SECTION("finds the tiles of each kind of ID") {
+    CHECK(index.size() == 4);
+    CHECK(index.find(std::string("root.glb")) == &root);
+    CHECK(index.find(QuadtreeTileID(1, 0, 0)) == &childTiles[0]);
+    CHECK(index.find(OctreeTileID(1, 0, 0, 1)) == &childTiles[1]);
+    CHECK(
+        index.find(UpsampledQuadtreeNode{QuadtreeTileID(1, 0, 0)}) ==
+        &childTiles[2]);
+  }
+
+  SECTION("doesn't find tiles that aren't indexed") {
+    CHECK(index.find(std::string("")) == nullptr);
+    CHECK(index.find(std::string("other.glb")) == nullptr);
+    CHECK(index.find(QuadtreeTileID(1, 1, 0)) == nullptr);
+    CHECK(index.find(OctreeTileID(1, 0, 1, 0)) == nullptr);
+  }
+
+  SECTION("removes single tiles") {
+    index.remove(childTiles[0]);
+    CHECK(index.find(QuadtreeTileID(1, 0, 0)) == nullptr);
+    CHECK(
+        index.find(UpsampledQuadtreeNode{QuadtreeTileID(1, 0, 0)}) ==
+        &childTiles[2]);
+    CHECK(index.find(std::string("root.glb")) == &root);
+    CHECK(index.size() == 3);
+
+    // Removing a tile that is not in the index does nothing.
+    index.remove(childTiles[0]);
+    index.remove(childTiles[3]);
+    CHECK(index.size() == 3);
+  }
+
+  SECTION("keeps tiles with the same ID apart") {
+    Tile other(nullptr);
+    other.setTileID(QuadtreeTileID(1, 0, 0));
+    index.addSubtree(other);
+    CHECK(index.size() == 5);
+
+    index.remove(childTiles[0]);
+    CHECK(index.find(QuadtreeTileID(1, 0, 0)) == &other);
+    index.remove(other);
+    CHECK(index.find(QuadtreeTileID(1, 0, 0)) == nullptr);
+  }
+}
+
+TEST_CASE("Tileset::findTile") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  const std::filesystem::path testDataPath =
+      std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) /
+      "ReplaceTileset";
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+  for (const std::string& file :
+       {"tileset.json",
+        "parent.b3dm",
+        "ll.b3dm",
+        "lr.b3dm",
+        "ul.b3dm",
+        "ur.b3dm",
+        "ll_ll.b3dm"}) {
+    requests.emplace(
+        file,
+        std::make_shared<SimpleAssetRequest>(
+            "GET",
+            file,
+            HttpHeaders{},
+            std::make_unique<SimpleAssetResponse>(
+                static_cast<uint16_t>(200),
+                "doesn't matter",
+                HttpHeaders{},
+                readFile(testDataPath / file))));
+  }
+
+  TilesetExternals externals{
+      std::make_shared<SimpleAssetAccessor>(std::move(requests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+  TilesetOptions options;
+  options.contentOptions.skipContentDecoding = true;
+
+  SECTION("finds the tiles once they exist") {
+    options.enableTileIndex = true;
+    Tileset tileset(externals, "tileset.json", options);
+    tileset.fetchRegionOffline({});
+
+    const Tile* pTile = tileset.findTile(std::string("ll_ll.b3dm"));
+    REQUIRE(pTile != nullptr);
+    CHECK(std::get<TileUrl>(pTile->getTileID()) == std::string("ll_ll.b3dm"));
+    REQUIRE(pTile->getParent() != nullptr);
+    CHECK(tileset.findTile(std::string("ll.b3dm")) == pTile->getParent());
+
+    // The root tile of a tileset JSON has no content of its own.
+    const Tile* pParent = tileset.findTile(std::string("parent.b3dm"));
+    REQUIRE(pParent != nullptr);
+    CHECK(pParent->getParent() == tileset.getRootTile());
+  }
+
+  SECTION("finds nothing without the index") {
+    Tileset tileset(externals, "tileset.json", options);
+    tileset.fetchRegionOffline({});
+    REQUIRE(tileset.getRootTile() != nullptr);
+    CHECK(tileset.findTile(std::string("parent.b3dm")) == nullptr);
+  }
+}
@@ -0,0 +1,75 @@
+#include <Cesium3DTilesSelection/TileLoadMetrics.h>
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+
+using namespace Cesium3DTilesSelection;
+
+TEST_CASE("TileLoadLatencyHistogram") {
+  SECTION("puts latencies in buckets by powers of two") {
+    CHECK(TileLoadLatencyHistogram::getBucket(0) == 0);
+    CHECK(TileLoadLatencyHistogram::getBucket(15) == 0);
+    CHECK(TileLoadLatencyHistogram::getBucket(16) == 1);
+    CHECK(TileLoadLatencyHistogram::getBucket(31) == 1);
+    CHECK(TileLoadLatencyHistogram::getBucket(32) == 2);
+    CHECK(
+        TileLoadLatencyHistogram::getBucket(int64_t(1) << 40) ==
+        TileLoadLatencyHistogram::BucketCount - 1);
+
+    CHECK(
+        TileLoadLatencyHistogram::getBucketUpperBoundMilliseconds(0) ==
+        Approx(0.016));
+    CHECK(
+        TileLoadLatencyHistogram::getBucketUpperBoundMilliseconds(2) ==
+        Approx(0.064));
+    CHECK(std::isinf(TileLoadLatencyHistogram::getBucketUpperBoundMilliseconds(
+        TileLoadLatencyHistogram::BucketCount - 1)));
+  }
+
+  SECTION("estimates the mean and percentiles") {
+    TileLoadLatencyHistogram histogram;
+    CHECK(histogram.computeMeanMilliseconds() == 0.0);
+    CHECK(histogram.computePercentileMilliseconds(0.5) == 0.0);
+
+    // 90 latencies of 10 microseconds and 10 of 1000 microseconds.
+    histogram.buckets[TileLoadLatencyHistogram::getBucket(10)] = 90;
+    histogram.buckets[TileLoadLatencyHistogram::getBucket(1000)] = 10;
+    histogram.count = 100;
+    histogram.totalMicroseconds = 90 * 10 + 10 * 1000;
+
+    CHECK(histogram.computeMeanMilliseconds() == Approx(0.109));
+    CHECK(histogram.computePercentileMilliseconds(0.5) == Approx(0.016));
+    CHECK(histogram.computePercentileMilliseconds(0.9) == Approx(0.016));
+    CHECK(histogram.computePercentileMilliseconds(0.95) == Approx(1.024));
+  }
+}
+
+TEST_CASE("TileLoadMetrics::computeDifference") {
+  TileLoadMetrics earlier;
+  TileLoadLatencyHistogram& earlierRequests =
+      earlier.latencies[size_t(TileLoadStage::Request)];
+  earlierRequests.buckets[3] = 2;
+  earlierRequests.count = 2;
+  earlierRequests.totalMicroseconds = 200;
+  earlier.bytesReceived = 1000;
+
+  TileLoadMetrics later = earlier;
+  TileLoadLatencyHistogram& laterRequests =
+      later.latencies[size_t(TileLoadStage::Request)];
+  laterRequests.buckets[3] = 3;
+  laterRequests.buckets[5] = 1;
+  laterRequests.count = 4;
+  laterRequests.totalMicroseconds = 900;
+  later.bytesReceived = 1500;
+
+  const TileLoadMetrics difference = later.computeDifference(earlier);
+  const TileLoadLatencyHistogram& requests =
+      difference.getLatencies(TileLoadStage::Request);
+  CHECK(requests.buckets[3] == 1);
+  CHECK(requests.buckets[5] == 1);
+  CHECK(requests.count == 2);
+  CHECK(requests.totalMicroseconds == 700);
+  CHECK(difference.getLatencies(TileLoadStage::Load).count == 0);
+  CHECK(difference.bytesReceived == 500);
+}
@@ -0,0 +1,174 @@
+#include <Cesium3DTilesSelection/TileTriangleIndex.h>
+#include <CesiumGeometry/Axis.h>
+#include <CesiumGeometry/IntersectionTests.h>
+#include <CesiumGeometry/Ray.h>
+#include <CesiumGltf/Model.h>
+
+#include <catch2/catch.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+
+namespace {
+constexpr uint32_t gridSize = 24;
+
+glm::vec3 getGridPosition(uint32_t x, uint32_t y) {
+  return glm::vec3(
+      float(x),
+      float(y),
+      float(std::sin(double(x) * 0.5) * std::cos(double(y) * 0.3)));
+}
+
+// A bumpy grid with the Z axis up, so that the index doesn't rotate it.
+CesiumGltf::Model createBumpyGrid() {
+  std::vector<glm::vec3> positions;
+  std::vector<uint32_t> indices;
+  for (uint32_t y = 0; y < gridSize; ++y) {
+    for (uint32_t x = 0; x < gridSize; ++x) {
+      positions.emplace_back(getGridPosition(x, y));
+
+      if (x < gridSize - 1 && y < gridSize - 1) {
+        const uint32_t i = y * gridSize + x;
+        indices.insert(
+            indices.end(),
+            {i, i + 1, i + gridSize, i + 1, i + gridSize + 1, i + gridSize});
+      }
+    }
+  }
+
+  CesiumGltf::Model model;
+  model.extras["gltfUpAxis"] = static_cast<int64_t>(Axis::Z);
+
+  CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+  const size_t positionsSize = positions.size() * sizeof(glm::vec3);
+  const size_t indicesSize = indices.size() * sizeof(uint32_t);
+  buffer.cesium.data.resize(positionsSize + indicesSize);
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+  std::memcpy(buffer.cesium.data.data(), positions.data(), positionsSize);
+  std::memcpy(
+      buffer.cesium.data.data() + positionsSize,
+      indices.data(),
+      indicesSize);
+
+  CesiumGltf::BufferView& positionBufferView = model.bufferViews.emplace_back();
+  positionBufferView.buffer = 0;
+  positionBufferView.byteLength = int64_t(positionsSize);
+
+  CesiumGltf::BufferView& indexBufferView = model.bufferViews.emplace_back();
+  indexBufferView.buffer = 0;
+  indexBufferView.byteOffset = int64_t(positionsSize);
+  indexBufferView.byteLength = int64_t(indicesSize);
+
+  CesiumGltf::Accessor& positionAccessor = model.accessors.emplace_back();
+  positionAccessor.bufferView = 0;
+  positionAccessor.componentType = CesiumGltf::Accessor::ComponentType::FLOAT;
+  positionAccessor.count = int64_t(positions.size());
+  positionAccessor.type = CesiumGltf::Accessor::Type::VEC3;
+
+  CesiumGltf::Accessor& indexAccessor = model.accessors.emplace_back();
+  indexAccessor.bufferView = 1;
+  indexAccessor.componentType =
+      CesiumGltf::Accessor::ComponentType::UNSIGNED_INT;
+  indexAccessor.count = int64_t(indices.size());
+  indexAccessor.type = CesiumGltf::Accessor::Type::SCALAR;
+
+  CesiumGltf::MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = 0;
+  primitive.indices = 1;
+
+  model.nodes.emplace_back().mesh = 0;
+  model.scenes.emplace_back().nodes.emplace_back(0);
+
+  return model;
+}
+
+std::optional<double> intersectGridBruteForce(const Ray& ray) {
+  std::optional<double> closest;
+  for (uint32_t y = 0; y < gridSize - 1; ++y) {
+    for (uint32_t x = 0; x < gridSize - 1; ++x) {
+      const glm::dvec3 p00(getGridPosition(x, y));
+      const glm::dvec3 p10(getGridPosition(x + 1, y));
+      const glm::dvec3 p01(getGridPosition(x, y + 1));
+      const glm::dvec3 p11(getGridPosition(x + 1, y + 1));
+      for (const std::optional<double>& t :
+           {IntersectionTests::rayTriangleParametric(ray, p00, p10, p01),
+            IntersectionTests::rayTriangleParametric(ray, p10, p11, p01)}) {
+        if (t && (!closest || *t < *closest)) {
+          closest = t;
+        }
+      }
+    }
+  }
+  return closest;
+}
+} // namespace
+
+TEST_CASE("TileTriangleIndex") {
+  const CesiumGltf::Model model = createBumpyGrid();
+  const TileTriangleIndex index(model, glm::dmat4(1.0));
+
+  SECTION("indexes every triangle of the model") {
+    CHECK(index.getTriangleCount() == 2 * (gridSize - 1) * (gridSize - 1));
+    CHECK(index.getNodeCount() > 1);
+  }
+
+  SECTION("finds the same hits as testing every triangle") {
+    const std::array<glm::dvec3, 4> directions{
+        glm::dvec3(0.0, 0.0, -1.0),
+        glm::normalize(glm::dvec3(0.3, 0.2, -1.0)),
+        glm::normalize(glm::dvec3(-1.0, 0.5, -0.2)),
+        glm::normalize(glm::dvec3(0.0, 0.0, 1.0))};
+
+    int32_t hitCount = 0;
+    for (const glm::dvec3& direction : directions) {
+      for (double y = -2.0; y < double(gridSize) + 2.0; y += 0.7) {
+        for (double x = -2.0; x < double(gridSize) + 2.0; x += 0.9) {
+          const Ray ray(glm::dvec3(x, y, 3.0) - direction * 2.0, direction);
+          const std::optional<double> expected = intersectGridBruteForce(ray);
+          const std::optional<double> actual = index.intersectRay(ray);
+          REQUIRE(actual.has_value() == expected.has_value());
+          if (expected) {
+            CHECK(*actual == Approx(*expected));
+            ++hitCount;
+          }
+        }
+      }
+    }
+    CHECK(hitCount > 0);
+  }
+
+  SECTION("applies the transform of the tile") {
+    const glm::dvec3 offset(1000.0, -2000.0, 500.0);
+    const TileTriangleIndex translated(
+        model,
+        glm::translate(glm::dmat4(1.0), offset));
+
+    const Ray ray(glm::dvec3(5.2, 7.7, 3.0), glm::dvec3(0.0, 0.0, -1.0));
+    const Ray translatedRay(ray.getOrigin() + offset, ray.getDirection());
+    const std::optional<double> t = index.intersectRay(ray);
+    const std::optional<double> translatedT =
+        translated.intersectRay(translatedRay);
+    REQUIRE(t);
+    REQUIRE(translatedT);
+    CHECK(*translatedT == Approx(*t));
+    CHECK(!translated.intersectRay(ray));
+  }
+
+  SECTION("is empty for a model without triangles") {
+    const TileTriangleIndex empty(CesiumGltf::Model(), glm::dmat4(1.0));
+    CHECK(empty.getTriangleCount() == 0);
+    CHECK(empty.getNodeCount() == 0);
+    CHECK(!empty.intersectRay(
+        Ray(glm::dvec3(0.0, 0.0, 1.0), glm::dvec3(0.0, 0.0, -1.0))));
+  }
+}
@@ -0,0 +1,82 @@
+#include <Cesium3DTilesSelection/TileUrl.h>
+
+#include <catch2/catch.hpp>
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+using namespace Cesium3DTilesSelection;
+
+TEST_CASE("TileUrl") {
+  SECTION("puts together the URL it was created from") {
+    TileUrlPool pool;
+    for (const std::string url :
+         {"tile.b3dm",
+          "a/b/tile.b3dm",
+          "a/b/",
+          "tile.b3dm?session=1",
+          "a/b/tile.b3dm?session=1#part",
+          "a/b/tile.b3dm#part/x",
+          "https://example.com/a/tile.glb?v=2"}) {
+      const TileUrl pooled = pool.create(url);
+      CHECK(pooled.toString() == url);
+      CHECK(pooled.size() == url.size());
+      CHECK(!pooled.empty());
+      CHECK(TileUrl(url).toString() == url);
+    }
+
+    CHECK(TileUrl().empty());
+    CHECK(pool.create("").empty());
+    CHECK(TileUrl("").toString().empty());
+  }
+
+  SECTION("shares the directories and queries of a pool") {
+    TileUrlPool pool;
+    pool.create("a/b/1.b3dm?session=1");
+    pool.create("a/b/2.b3dm?session=1");
+    pool.create("a/c/3.b3dm?session=1");
+    pool.create("a/b/4.b3dm");
+    CHECK(pool.getSharedSegmentCount() == 3);
+  }
+
+  SECTION("compares and hashes the full URL") {
+    TileUrlPool pool;
+    TileUrlPool otherPool;
+    const TileUrl url = pool.create("a/b/1.b3dm?session=1");
+    const std::hash<TileUrl> hash;
+
+    CHECK(url == pool.create("a/b/1.b3dm?session=1"));
+    CHECK(url == otherPool.create("a/b/1.b3dm?session=1"));
+    CHECK(url == TileUrl("a/b/1.b3dm?session=1"));
+    CHECK(hash(url) == hash(TileUrl("a/b/1.b3dm?session=1")));
+
+    CHECK(url != pool.create("a/b/2.b3dm?session=1"));
+    CHECK(url != pool.create("a/b/1.b3dm?session=2"));
+    CHECK(url != pool.create("a/1.b3dm?session=1"));
+    CHECK(url != TileUrl());
+
+    // The same characters split in different places are the same URL.
+    CHECK(pool.create("a/b") == TileUrl("a/b"));
+    CHECK(pool.create("a/b") != pool.create("a/b/"));
+
+    std::unordered_map<TileUrl, int> values;
+    values.emplace(url, 1);
+    values.emplace(TileUrl("a/b/2.b3dm?session=1"), 2);
+    CHECK(values.at(TileUrl("a/b/1.b3dm?session=1")) == 1);
+    CHECK(values.at(pool.create("a/b/2.b3dm?session=1")) == 2);
+  }
+
+  SECTION("outlives its pool") {
+    std::optional<TileUrlPool> pool;
+    pool.emplace();
+    TileUrl url = pool->create("a/b/1.b3dm?session=1");
+    const TileUrl copy = url;
+    pool.reset();
+
+    CHECK(copy.toString() == "a/b/1.b3dm?session=1");
+    url = TileUrl();
+    CHECK(copy.toString() == "a/b/1.b3dm?session=1");
+  }
+}
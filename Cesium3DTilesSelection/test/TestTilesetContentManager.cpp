@@ -21,7 +21,9 @@
 #include <catch2/catch.hpp>
 #include <glm/glm.hpp>
 
+#include <atomic>
 #include <filesystem>
+#include <optional>
 #include <vector>
 
 using namespace Cesium3DTilesSelection;
@@ -51,6 +53,24 @@ public:
   TileChildrenResult mockCreateTileChildren;
 };
 
+class DeferredTilesetContentLoader : public TilesetContentLoader {
+public:
+  CesiumAsync::Future<TileLoadResult>
+  loadTileContent(const TileLoadInput& input) override {
+    pCanceled = input.pCanceled;
+    promise.emplace(input.asyncSystem.createPromise<TileLoadResult>());
+    return promise->getFuture();
+  }
+
+  TileChildrenResult
+  createTileChildren([[maybe_unused]] const Tile& tile) override {
+    return {{}, TileLoadResultState::Failed};
+  }
+
+  std::optional<CesiumAsync::Promise<TileLoadResult>> promise;
+  std::shared_ptr<const std::atomic<bool>> pCanceled;
+};
+
 std::shared_ptr<SimpleAssetRequest>
 createMockRequest(const std::filesystem::path& path) {
   auto pMockCompletedResponse = std::make_unique<SimpleAssetResponse>(
@@ -225,7 +245,7 @@ TEST_CASE("Test the manager can be initialized with correct loaders") {
     REQUIRE(pTilesetJson);
     REQUIRE(pTilesetJson->getChildren().size() == 1);
     const Tile* pRootTile = &pTilesetJson->getChildren()[0];
-    CHECK(std::get<std::string>(pRootTile->getTileID()) == "parent.b3dm");
+    CHECK(std::get<TileUrl>(pRootTile->getTileID()) == "parent.b3dm");
     CHECK(pRootTile->getGeometricError() == 70.0);
     CHECK(pRootTile->getRefine() == TileRefine::Add);
   }
@@ -372,19 +392,40 @@ TEST_CASE("Test tile state machine") {
       CHECK(tile.getContent().getRenderContent()->getRenderResources());
       CHECK(initializerCall);
 
+      // The mocked loader doesn't make requests, so only the stages after it
+      // are measured.
+      TileLoadMetrics metrics = pManager->getTileLoadMetrics();
+      CHECK(metrics.getLatencies(TileLoadStage::Request).count == 0);
+      CHECK(metrics.getLatencies(TileLoadStage::Decode).count == 0);
+      CHECK(metrics.getLatencies(TileLoadStage::PostProcess).count == 1);
+      CHECK(
+          metrics.getLatencies(TileLoadStage::PrepareInLoadThread).count == 1);
+      CHECK(metrics.getLatencies(TileLoadStage::Load).count == 1);
+      CHECK(metrics.getLatencies(TileLoadStage::MainThreadQueue).count == 0);
+
       // ContentLoaded -> Done
       // update tile content to move from ContentLoaded -> Done
+      const int64_t contentBytes = pManager->getTotalDataUsed();
+      pMockedPrepareRendererResources->renderResourcesByteSize = 1000;
       pManager->updateTileContent(tile, options);
       CHECK(tile.getState() == TileLoadState::Done);
+      CHECK(pManager->getTotalDataUsed() == contentBytes + 1000);
+      CHECK(tile.computeByteSize() == contentBytes + 1000);
       CHECK(tile.getChildren().size() == 1);
       CHECK(tile.getChildren().front().getContent().isEmptyContent());
       CHECK(tile.getContent().isRenderContent());
       CHECK(tile.getContent().getRenderContent()->getRenderResources());
       CHECK(initializerCall);
 
+      metrics = pManager->getTileLoadMetrics();
+      CHECK(metrics.getLatencies(TileLoadStage::MainThreadQueue).count == 1);
+      CHECK(
+          metrics.getLatencies(TileLoadStage::PrepareInMainThread).count == 1);
+
       // Done -> Unloaded
       pManager->unloadTileContent(tile);
       CHECK(tile.getState() == TileLoadState::Unloaded);
+      CHECK(pManager->getTotalDataUsed() == 0);
       CHECK(tile.getContent().isUnknownContent());
       CHECK(!tile.getContent().isRenderContent());
       CHECK(!tile.getContent().getRenderContent());
@@ -416,6 +457,258 @@ TEST_CASE("Test tile state machine") {
     }
   }
 
+  SECTION("Cancel the load of a tile that is no longer needed") {
+    auto pMockedLoader = std::make_unique<DeferredTilesetContentLoader>();
+    DeferredTilesetContentLoader* pMockedLoaderRaw = pMockedLoader.get();
+    auto pRootTile = std::make_unique<Tile>(pMockedLoader.get());
+
+    TilesetOptions options{};
+    Tile::LoadedLinkedList loadedTiles;
+    IntrusivePointer<TilesetContentManager> pManager =
+        new TilesetContentManager{
+            externals,
+            options,
+            RasterOverlayCollection{loadedTiles, externals},
+            {},
+            std::move(pMockedLoader),
+            std::move(pRootTile)};
+
+    Tile& tile = *pManager->getRootTile();
+    pManager->loadTileContent(tile, options);
+    REQUIRE(pMockedLoaderRaw->promise);
+    REQUIRE(pMockedLoaderRaw->pCanceled);
+    CHECK(!*pMockedLoaderRaw->pCanceled);
+
+    // The tile can't be unloaded while it's loading, but its load is canceled.
+    CHECK(!pManager->unloadTileContent(tile));
+    CHECK(tile.getState() == TileLoadState::ContentLoading);
+    CHECK(*pMockedLoaderRaw->pCanceled);
+
+    // The loader produces a model anyway, but it isn't post-processed and no
+    // renderer resources are created for it.
+    pMockedLoaderRaw->promise->resolve(TileLoadResult{
+        CesiumGltf::Model(),
+        CesiumGeometry::Axis::Y,
+        std::nullopt,
+        std::nullopt,
+        std::nullopt,
+        nullptr,
+        {},
+        TileLoadResultState::Success});
+    pManager->waitUntilIdle();
+    CHECK(pManager->getNumberOfTilesLoading() == 0);
+    CHECK(tile.getState() == TileLoadState::FailedTemporarily);
+    CHECK(!tile.getContent().isRenderContent());
+
+    // The tile can be loaded again, with a new flag.
+    pManager->loadTileContent(tile, options);
+    CHECK(tile.getState() == TileLoadState::ContentLoading);
+    REQUIRE(pMockedLoaderRaw->pCanceled);
+    CHECK(!*pMockedLoaderRaw->pCanceled);
+
+    // Cancellation spares the tiles that are still needed.
+    pManager->cancelTileLoadsExcept({&tile});
+    CHECK(!*pMockedLoaderRaw->pCanceled);
+
+    pMockedLoaderRaw->promise->resolve(TileLoadResult{
+        CesiumGltf::Model(),
+        CesiumGeometry::Axis::Y,
+        std::nullopt,
+        std::nullopt,
+        std::nullopt,
+        nullptr,
+        {},
+        TileLoadResultState::Success});
+    pManager->waitUntilIdle();
+    CHECK(tile.getState() == TileLoadState::ContentLoaded);
+    CHECK(tile.getContent().isRenderContent());
+
+    pManager->unloadTileContent(tile);
+  }
+
+  SECTION("Release the glTF data once the tile is uploaded") {
+    CesiumGltf::Model model;
+    model.buffers.emplace_back().cesium.data.resize(100);
+    model.images.emplace_back().cesium.pixelData.resize(50);
+
+    auto pMockedLoader = std::make_unique<SimpleTilesetContentLoader>();
+    pMockedLoader->mockLoadTileContent = {
+        std::move(model),
+        CesiumGeometry::Axis::Y,
+        std::nullopt,
+        std::nullopt,
+        std::nullopt,
+        nullptr,
+        {},
+        TileLoadResultState::Success};
+    pMockedLoader->mockCreateTileChildren = {{}, TileLoadResultState::Success};
+
+    auto pRootTile = std::make_unique<Tile>(pMockedLoader.get());
+
+    TilesetOptions options{};
+    options.releaseGltfDataAfterUpload = true;
+
+    Tile::LoadedLinkedList loadedTiles;
+    IntrusivePointer<TilesetContentManager> pManager =
+        new TilesetContentManager{
+            externals,
+            options,
+            RasterOverlayCollection{loadedTiles, externals},
+            {},
+            std::move(pMockedLoader),
+            std::move(pRootTile)};
+
+    Tile& tile = *pManager->getRootTile();
+    pManager->loadTileContent(tile, options);
+    pManager->waitUntilIdle();
+    REQUIRE(tile.getState() == TileLoadState::ContentLoaded);
+    CHECK(pManager->getTotalDataUsed() == 150);
+
+    pManager->updateTileContent(tile, options);
+    REQUIRE(tile.getState() == TileLoadState::Done);
+    const CesiumGltf::Model& loadedModel =
+        tile.getContent().getRenderContent()->getModel();
+    REQUIRE(loadedModel.buffers.size() == 1);
+    CHECK(loadedModel.buffers[0].cesium.data.empty());
+    REQUIRE(loadedModel.images.size() == 1);
+    CHECK(loadedModel.images[0].cesium.pixelData.empty());
+    CHECK(pManager->getTotalDataUsed() == 0);
+
+    pManager->unloadTileContent(tile);
+    CHECK(tile.getState() == TileLoadState::Unloaded);
+    CHECK(pManager->getTotalDataUsed() == 0);
+  }
+
+  SECTION("Load hibernated content again without the loader") {
+    CesiumGltf::Model model;
+    model.buffers.emplace_back().cesium.data.resize(100, std::byte(7));
+    model.buffers[0].byteLength = 100;
+
+    auto pMockedLoader = std::make_unique<SimpleTilesetContentLoader>();
+    SimpleTilesetContentLoader* pLoader = pMockedLoader.get();
+    pMockedLoader->mockLoadTileContent = {
+        std::move(model),
+        CesiumGeometry::Axis::X,
+        std::nullopt,
+        std::nullopt,
+        std::nullopt,
+        nullptr,
+        {},
+        TileLoadResultState::Success};
+    pMockedLoader->mockCreateTileChildren = {{}, TileLoadResultState::Success};
+
+    auto pRootTile = std::make_unique<Tile>(pMockedLoader.get());
+
+    TilesetOptions options{};
+    options.maximumHibernatedBytes = 1024 * 1024;
+
+    Tile::LoadedLinkedList loadedTiles;
+    IntrusivePointer<TilesetContentManager> pManager =
+        new TilesetContentManager{
+            externals,
+            options,
+            RasterOverlayCollection{loadedTiles, externals},
+            {},
+            std::move(pMockedLoader),
+            std::move(pRootTile)};
+
+    Tile& tile = *pManager->getRootTile();
+    pManager->loadTileContent(tile, options);
+    pManager->waitUntilIdle();
+    pManager->updateTileContent(tile, options);
+    REQUIRE(tile.getState() == TileLoadState::Done);
+    CHECK(pManager->unloadTileContent(tile));
+
+    // The loader would fail now, so the content must come from hibernation.
+    pLoader->mockLoadTileContent = TileLoadResult::createFailedResult(nullptr);
+    pManager->loadTileContent(tile, options);
+    pManager->waitUntilIdle();
+    REQUIRE(tile.getState() == TileLoadState::ContentLoaded);
+    const CesiumGltf::Model& reloadedModel =
+        tile.getContent().getRenderContent()->getModel();
+    REQUIRE(reloadedModel.buffers.size() == 1);
+    const CesiumUtility::ByteVector& data =
+        reloadedModel.buffers[0].cesium.data;
+    REQUIRE(data.size() == 100);
+    CHECK(data[0] == std::byte(7));
+    CHECK(
+        reloadedModel.extras.at("gltfUpAxis")
+            .getSafeNumberOrDefault<int32_t>(-1) ==
+        static_cast<int32_t>(CesiumGeometry::Axis::X));
+
+    // The hibernated content is used once, and a revalidated tile is loaded
+    // again by the loader.
+    pManager->updateTileContent(tile, options);
+    CHECK(pManager->unloadTileContent(tile));
+    pManager->revalidateNextTileLoad(tile);
+    pManager->loadTileContent(tile, options);
+    pManager->waitUntilIdle();
+    CHECK(tile.getState() == TileLoadState::Failed);
+  }
+
+  SECTION("Keep the glTF data once the tileset has had a raster overlay") {
+    auto pMockedLoader = std::make_unique<SimpleTilesetContentLoader>();
+    SimpleTilesetContentLoader* pLoader = pMockedLoader.get();
+    auto mockLoad = [pLoader]() {
+      CesiumGltf::Model model;
+      model.buffers.emplace_back().cesium.data.resize(100);
+      pLoader->mockLoadTileContent = {
+          std::move(model),
+          CesiumGeometry::Axis::Y,
+          std::nullopt,
+          std::nullopt,
+          std::nullopt,
+          nullptr,
+          {},
+          TileLoadResultState::Success};
+    };
+    pMockedLoader->mockCreateTileChildren = {{}, TileLoadResultState::Success};
+
+    auto pRootTile = std::make_unique<Tile>(pMockedLoader.get());
+
+    TilesetOptions options{};
+    options.releaseGltfDataAfterUpload = true;
+
+    Tile::LoadedLinkedList loadedTiles;
+    IntrusivePointer<TilesetContentManager> pManager =
+        new TilesetContentManager{
+            externals,
+            options,
+            RasterOverlayCollection{loadedTiles, externals},
+            {},
+            std::move(pMockedLoader),
+            std::move(pRootTile)};
+
+    RasterOverlayCollection& overlays = pManager->getRasterOverlayCollection();
+    IntrusivePointer<RasterOverlay> pOverlay =
+        new DebugColorizeTilesRasterOverlay("DebugOverlay");
+    overlays.add(pOverlay);
+    asyncSystem.dispatchMainThreadTasks();
+
+    Tile& tile = *pManager->getRootTile();
+    mockLoad();
+    pManager->loadTileContent(tile, options);
+    pManager->waitUntilIdle();
+    pManager->updateTileContent(tile, options);
+    REQUIRE(tile.getState() == TileLoadState::Done);
+    pManager->unloadTileContent(tile);
+
+    // Without the overlay, the tile is loaded again and keeps its data.
+    overlays.remove(pOverlay);
+    mockLoad();
+    pManager->loadTileContent(tile, options);
+    pManager->waitUntilIdle();
+    pManager->updateTileContent(tile, options);
+    REQUIRE(tile.getState() == TileLoadState::Done);
+    CHECK(tile.getMappedRasterTiles().empty());
+    const CesiumGltf::Model& loadedModel =
+        tile.getContent().getRenderContent()->getModel();
+    REQUIRE(loadedModel.buffers.size() == 1);
+    CHECK(loadedModel.buffers[0].cesium.data.size() == 100);
+
+    pManager->unloadTileContent(tile);
+  }
+
   SECTION("Loader requests retry later") {
     // create mock loader
     bool initializerCall = false;
@@ -1221,4 +1514,80 @@ TEST_CASE("Test the tileset content manager's post processing for gltf") {
 
     pManager->unloadTileContent(tile);
   }
+
+  SECTION("Add texture coordinates for an overlay added after the tile is "
+          "loaded, without unloading it") {
+    Tile::LoadedLinkedList loadedTiles;
+
+    auto pMockedLoader = std::make_unique<SimpleTilesetContentLoader>();
+    Cartographic beginCarto{glm::radians(32.0), glm::radians(48.0), 100.0};
+    pMockedLoader->mockLoadTileContent = {
+        createGlobeGrid(beginCarto, 10, 10, 0.01),
+        CesiumGeometry::Axis::Z,
+        std::nullopt,
+        std::nullopt,
+        std::nullopt,
+        nullptr,
+        {},
+        TileLoadResultState::Success};
+    pMockedLoader->mockCreateTileChildren = {{}, TileLoadResultState::Success};
+
+    auto pRootTile = std::make_unique<Tile>(pMockedLoader.get());
+
+    IntrusivePointer<TilesetContentManager> pManager =
+        new TilesetContentManager{
+            externals,
+            {},
+            RasterOverlayCollection{loadedTiles, externals},
+            {},
+            std::move(pMockedLoader),
+            std::move(pRootTile)};
+
+    Tile& tile = *pManager->getRootTile();
+    pManager->loadTileContent(tile, {});
+    pManager->waitUntilIdle();
+    pManager->updateTileContent(tile, {});
+    REQUIRE(tile.getState() == TileLoadState::Done);
+    loadedTiles.insertAtTail(tile);
+
+    pManager->getRasterOverlayCollection().add(
+        new DebugColorizeTilesRasterOverlay("DebugOverlay"));
+    asyncSystem.dispatchMainThreadTasks();
+
+    // The tile stays loaded, and asks to be loaded again in a worker thread.
+    pManager->updateTileContent(tile, {});
+    CHECK(tile.getState() == TileLoadState::Done);
+    CHECK(pManager->tileNeedsWorkerThreadLoading(tile));
+
+    pManager->loadTileContent(tile, {});
+    pManager->waitUntilIdle();
+    CHECK(tile.getState() == TileLoadState::Done);
+    CHECK(!pManager->tileNeedsWorkerThreadLoading(tile));
+
+    const TileRenderContent* pRenderContent =
+        tile.getContent().getRenderContent();
+    REQUIRE(pRenderContent);
+    CHECK(
+        pRenderContent->getRasterOverlayDetails()
+            .rasterOverlayProjections.size() == 1);
+    const CesiumGltf::MeshPrimitive& primitive =
+        pRenderContent->getModel().meshes.front().primitives.front();
+    CHECK(
+        primitive.attributes.find("_CESIUMOVERLAY_0") !=
+        primitive.attributes.end());
+
+    // The placeholder is now replaced by a raster overlay tile that uses the
+    // new texture coordinates.
+    pManager->updateTileContent(tile, {});
+    REQUIRE(tile.getMappedRasterTiles().size() == 1);
+    const RasterMappedTo3DTile& mapped = tile.getMappedRasterTiles().front();
+    REQUIRE(mapped.getLoadingTile());
+    CHECK(
+        mapped.getLoadingTile()->getState() !=
+        RasterOverlayTile::LoadState::Placeholder);
+    CHECK(mapped.getTextureCoordinateID() == 0);
+
+    loadedTiles.remove(tile);
+    pManager->unloadTileContent(tile);
+  }
 }
@@ -0,0 +1,139 @@
+#include "Cesium3DTilesContent/registerAllTileContentTypes.h"
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "SimplePrepareRendererResource.h"
+
+#include <Cesium3DTilesSelection/TileFetchRegion.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+using namespace CesiumNativeTests;
+
+namespace {
+// The tiles of the ReplaceTileset, where the root has the children ll, lr,
+// ul and ur, and ll has the child ll_ll. The missing files are answered with
+// a 404 status code.
+std::shared_ptr<SimpleAssetAccessor>
+createTilesetAccessor(const std::set<std::string>& missingFiles = {}) {
+  const std::filesystem::path testDataPath =
+      std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) /
+      "ReplaceTileset";
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+  for (const std::string& file :
+       {"tileset.json",
+        "parent.b3dm",
+        "ll.b3dm",
+        "lr.b3dm",
+        "ul.b3dm",
+        "ur.b3dm",
+        "ll_ll.b3dm"}) {
+    const bool isMissing = missingFiles.find(file) != missingFiles.end();
+    requests.emplace(
+        file,
+        std::make_shared<SimpleAssetRequest>(
+            "GET",
+            file,
+            HttpHeaders{},
+            std::make_unique<SimpleAssetResponse>(
+                static_cast<uint16_t>(isMissing ? 404 : 200),
+                "doesn't matter",
+                HttpHeaders{},
+                isMissing ? std::vector<std::byte>()
+                          : readFile(testDataPath / file))));
+  }
+  return std::make_shared<SimpleAssetAccessor>(std::move(requests));
+}
+} // namespace
+
+TEST_CASE("Tileset::fetchRegion") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::shared_ptr<SimplePrepareRendererResource> pRendererResources =
+      std::make_shared<SimplePrepareRendererResource>();
+  TilesetExternals externals{
+      createTilesetAccessor(),
+      pRendererResources,
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+  TilesetOptions options;
+  options.contentOptions.skipContentDecoding = true;
+
+  SECTION("fetches every tile without decoding them") {
+    Tileset tileset(externals, "tileset.json", options);
+    const TileFetchResult result = tileset.fetchRegionOffline({});
+    CHECK(result.tilesLoaded == 6);
+    CHECK(result.tilesFailed == 0);
+    CHECK(result.warnings.empty());
+
+    REQUIRE(tileset.getRootTile());
+    CHECK(tileset.getRootTile()->getContent().isEmptyContent());
+    CHECK(pRendererResources->totalAllocation == 0);
+  }
+
+  SECTION("fetches only the tiles that overlap the region") {
+    Tileset tileset(externals, "tileset.json", options);
+    TileFetchRegion region;
+    region.rectangle = GlobeRectangle(-1.31971, 0.69885, -1.31969, 0.69886);
+
+    // The root, ll and ll_ll.
+    CHECK(tileset.fetchRegionOffline(region).tilesLoaded == 3);
+
+    region.maximumLevel = 1;
+    CHECK(tileset.fetchRegionOffline(region).tilesLoaded == 2);
+  }
+
+  SECTION("stops at the tiles that are detailed enough") {
+    Tileset tileset(externals, "tileset.json", options);
+    TileFetchRegion region;
+    region.maximumGeometricError = 5.0;
+
+    // All but ll_ll, because the geometric error of ll is 5.
+    CHECK(tileset.fetchRegionOffline(region).tilesLoaded == 5);
+  }
+
+  SECTION("counts the tiles that fail to load") {
+    externals.pAssetAccessor =
+        createTilesetAccessor({"lr.b3dm", "ul.b3dm", "ur.b3dm"});
+    Tileset tileset(externals, "tileset.json", options);
+    const TileFetchResult result = tileset.fetchRegionOffline({});
+    CHECK(result.tilesLoaded == 3);
+    CHECK(result.tilesFailed == 3);
+  }
+
+  SECTION("decodes the tiles unless decoding is skipped") {
+    Tileset tileset(externals, "tileset.json");
+    Future<TileFetchResult> future = tileset.fetchRegion({});
+    while (!future.isReady()) {
+      externals.pAssetAccessor->tick();
+      tileset.updateView({});
+    }
+
+    CHECK(future.wait().tilesLoaded == 6);
+    REQUIRE(tileset.getRootTile());
+    CHECK(tileset.getRootTile()->isRenderContent());
+  }
+
+  SECTION("reports a tileset that fails to load") {
+    externals.pAssetAccessor = createTilesetAccessor({"tileset.json"});
+    Tileset tileset(externals, "tileset.json", options);
+    const TileFetchResult result = tileset.fetchRegionOffline({});
+    CHECK(result.tilesLoaded == 0);
+    CHECK(!result.warnings.empty());
+  }
+}
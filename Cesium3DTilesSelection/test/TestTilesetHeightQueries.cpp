@@ -0,0 +1,363 @@
+#include "SimplePrepareRendererResource.h"
+
+#include <Cesium3DTilesSelection/Tile.h>
+#include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/TilesetContentLoader.h>
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeometry/Axis.h>
+#include <CesiumGeometry/Ray.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <variant>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+using namespace CesiumGeospatial;
+using namespace CesiumNativeTests;
+
+namespace {
+// A grid of triangles at a constant height above the ellipsoid, with its
+// positions relative to the center of the grid.
+CesiumGltf::Model
+createFlatGrid(const GlobeRectangle& rectangle, double height) {
+  constexpr uint32_t size = 5;
+
+  std::vector<glm::dvec3> positions;
+  std::vector<uint32_t> indices;
+  for (uint32_t y = 0; y < size; ++y) {
+    for (uint32_t x = 0; x < size; ++x) {
+      positions.emplace_back(Ellipsoid::WGS84.cartographicToCartesian(
+          Cartographic(
+              rectangle.getWest() +
+                  rectangle.computeWidth() * double(x) / double(size - 1),
+              rectangle.getSouth() +
+                  rectangle.computeHeight() * double(y) / double(size - 1),
+              height)));
+
+      if (x < size - 1 && y < size - 1) {
+        const uint32_t i = y * size + x;
+        indices.insert(
+            indices.end(),
+            {i, i + 1, i + size, i + 1, i + size + 1, i + size});
+      }
+    }
+  }
+
+  const glm::dvec3 center = Ellipsoid::WGS84.cartographicToCartesian(
+      Cartographic(
+          rectangle.computeCenter().longitude,
+          rectangle.computeCenter().latitude,
+          height));
+  std::vector<glm::vec3> relativePositions;
+  for (const glm::dvec3& position : positions) {
+    relativePositions.emplace_back(glm::vec3(position - center));
+  }
+
+  CesiumGltf::Model model;
+  CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+  const size_t positionsSize = relativePositions.size() * sizeof(glm::vec3);
+  const size_t indicesSize = indices.size() * sizeof(uint32_t);
+  buffer.cesium.data.resize(positionsSize + indicesSize);
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+  std::memcpy(
+      buffer.cesium.data.data(),
+      relativePositions.data(),
+      positionsSize);
+  std::memcpy(
+      buffer.cesium.data.data() + positionsSize,
+      indices.data(),
+      indicesSize);
+
+  CesiumGltf::BufferView& positionBufferView = model.bufferViews.emplace_back();
+  positionBufferView.buffer = 0;
+  positionBufferView.byteLength = int64_t(positionsSize);
+
+  CesiumGltf::BufferView& indexBufferView = model.bufferViews.emplace_back();
+  indexBufferView.buffer = 0;
+  indexBufferView.byteOffset = int64_t(positionsSize);
+  indexBufferView.byteLength = int64_t(indicesSize);
+
+  CesiumGltf::Accessor& positionAccessor = model.accessors.emplace_back();
+  positionAccessor.bufferView = 0;
+  positionAccessor.componentType = CesiumGltf::Accessor::ComponentType::FLOAT;
+  positionAccessor.count = int64_t(relativePositions.size());
+  positionAccessor.type = CesiumGltf::Accessor::Type::VEC3;
+
+  CesiumGltf::Accessor& indexAccessor = model.accessors.emplace_back();
+  indexAccessor.bufferView = 1;
+  indexAccessor.componentType =
+      CesiumGltf::Accessor::ComponentType::UNSIGNED_INT;
+  indexAccessor.count = int64_t(indices.size());
+  indexAccessor.type = CesiumGltf::Accessor::Type::SCALAR;
+
+  CesiumGltf::MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = 0;
+  primitive.indices = 1;
+
+  CesiumGltf::Node& node = model.nodes.emplace_back();
+  node.translation = {center.x, center.y, center.z};
+  node.mesh = 0;
+  model.scenes.emplace_back().nodes.emplace_back(0);
+
+  return model;
+}
+
+// A root tile with a flat grid at a height of 0 meters, and a child tile that
+// covers the western half of it with a flat grid at a height of 10 meters.
+class HeightContentLoader : public TilesetContentLoader {
+public:
+  static constexpr double childHeight = 10.0;
+
+  Tile* pRootTile = nullptr;
+  int32_t loadCount = 0;
+
+  std::unique_ptr<Tile> createRootTile(
+      const GlobeRectangle& rectangle,
+      TileRefine refine) {
+    auto pRoot = std::make_unique<Tile>(this);
+    this->pRootTile = pRoot.get();
+    pRoot->setBoundingVolume(BoundingRegion(rectangle, -1.0, 20.0));
+    pRoot->setGeometricError(100.0);
+    pRoot->setRefine(refine);
+
+    Tile child(this);
+    child.setBoundingVolume(BoundingRegion(
+        GlobeRectangle(
+            rectangle.getWest(),
+            rectangle.getSouth(),
+            rectangle.computeCenter().longitude,
+            rectangle.getNorth()),
+        -1.0,
+        20.0));
+    child.setGeometricError(0.0);
+
+    std::vector<Tile> children;
+    children.emplace_back(std::move(child));
+    pRoot->createChildTiles(std::move(children));
+
+    return pRoot;
+  }
+
+  CesiumAsync::Future<TileLoadResult>
+  loadTileContent(const TileLoadInput& input) override {
+    ++this->loadCount;
+
+    const BoundingRegion& region =
+        std::get<BoundingRegion>(input.tile.getBoundingVolume());
+    TileLoadResult result{};
+    result.contentKind = createFlatGrid(
+        region.getRectangle(),
+        &input.tile == this->pRootTile ? 0.0 : childHeight);
+    result.glTFUpAxis = CesiumGeometry::Axis::Z;
+    result.state = TileLoadResultState::Success;
+    return input.asyncSystem.createResolvedFuture(std::move(result));
+  }
+
+  TileChildrenResult createTileChildren(const Tile&) override {
+    return TileChildrenResult{{}, TileLoadResultState::Failed};
+  }
+};
+} // namespace
+
+TEST_CASE("Tileset::sampleHeightMostDetailed") {
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+  TilesetExternals externals{
+      nullptr,
+      std::make_shared<SimplePrepareRendererResource>(),
+      asyncSystem,
+      nullptr};
+
+  const GlobeRectangle rectangle = GlobeRectangle::fromDegrees(
+      118.0,
+      32.0,
+      118.01,
+      32.01);
+  const Cartographic west = Cartographic::fromDegrees(118.002, 32.005, 1000.0);
+  const Cartographic east = Cartographic::fromDegrees(118.008, 32.005, 1000.0);
+  const Cartographic outside =
+      Cartographic::fromDegrees(118.02, 32.005, 1000.0);
+  const std::vector<Cartographic> positions{west, east, outside, west};
+
+  const auto sample = [&](Tileset& tileset) {
+    std::optional<SampleHeightResult> result;
+    tileset.sampleHeightMostDetailed(positions).thenInMainThread(
+        [&result](SampleHeightResult&& sampled) {
+          result = std::move(sampled);
+        });
+    for (int i = 0; i < 100 && !result; ++i) {
+      tileset.updateView({});
+      asyncSystem.dispatchMainThreadTasks();
+    }
+    REQUIRE(result);
+    REQUIRE(result->positions.size() == positions.size());
+    REQUIRE(result->sampleSuccess.size() == positions.size());
+    CHECK(result->warnings.empty());
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+      CHECK(result->positions[i].longitude == positions[i].longitude);
+      CHECK(result->positions[i].latitude == positions[i].latitude);
+    }
+    return *result;
+  };
+
+  SECTION("samples the leaf tiles of replace-refined tiles") {
+    auto pLoader = std::make_unique<HeightContentLoader>();
+    HeightContentLoader* pRawLoader = pLoader.get();
+    std::unique_ptr<Tile> pRoot =
+        pRawLoader->createRootTile(rectangle, TileRefine::Replace);
+    Tileset tileset(externals, std::move(pLoader), std::move(pRoot));
+
+    const SampleHeightResult result = sample(tileset);
+    CHECK(result.sampleSuccess == std::vector<bool>{true, false, false, true});
+    CHECK(
+        result.positions[0].height ==
+        Approx(HeightContentLoader::childHeight).margin(0.01));
+    CHECK(result.positions[1].height == east.height);
+    CHECK(result.positions[2].height == outside.height);
+    CHECK(
+        result.positions[3].height ==
+        Approx(HeightContentLoader::childHeight).margin(0.01));
+
+    // The root tile isn't needed, and the child is loaded once for both of
+    // the positions on it.
+    CHECK(pRawLoader->loadCount == 1);
+  }
+
+  SECTION("samples additive-refined tiles along with their children") {
+    auto pLoader = std::make_unique<HeightContentLoader>();
+    HeightContentLoader* pRawLoader = pLoader.get();
+    std::unique_ptr<Tile> pRoot =
+        pRawLoader->createRootTile(rectangle, TileRefine::Add);
+    Tileset tileset(externals, std::move(pLoader), std::move(pRoot));
+
+    const SampleHeightResult result = sample(tileset);
+    CHECK(result.sampleSuccess == std::vector<bool>{true, true, false, true});
+    CHECK(
+        result.positions[0].height ==
+        Approx(HeightContentLoader::childHeight).margin(0.01));
+    CHECK(result.positions[1].height == Approx(0.0).margin(0.01));
+    CHECK(pRawLoader->loadCount == 2);
+  }
+
+  SECTION("resolves without heights when the tileset is destroyed") {
+    auto pLoader = std::make_unique<HeightContentLoader>();
+    HeightContentLoader* pRawLoader = pLoader.get();
+    std::unique_ptr<Tile> pRoot =
+        pRawLoader->createRootTile(rectangle, TileRefine::Replace);
+    auto pTileset = std::make_unique<Tileset>(
+        externals,
+        std::move(pLoader),
+        std::move(pRoot));
+
+    std::optional<SampleHeightResult> result;
+    pTileset->sampleHeightMostDetailed(positions).thenInMainThread(
+        [&result](SampleHeightResult&& sampled) {
+          result = std::move(sampled);
+        });
+    pTileset.reset();
+    asyncSystem.dispatchMainThreadTasks();
+
+    REQUIRE(result);
+    CHECK(
+        result->sampleSuccess == std::vector<bool>{false, false, false, false});
+    CHECK(result->positions[0].height == west.height);
+    CHECK(result->warnings.size() == 1);
+  }
+}
+
+TEST_CASE("Tileset::intersectRay") {
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+  TilesetExternals externals{
+      nullptr,
+      std::make_shared<SimplePrepareRendererResource>(),
+      asyncSystem,
+      nullptr};
+
+  const GlobeRectangle rectangle = GlobeRectangle::fromDegrees(
+      118.0,
+      32.0,
+      118.01,
+      32.01);
+  const Cartographic west = Cartographic::fromDegrees(118.002, 32.005, 1000.0);
+  const Cartographic east = Cartographic::fromDegrees(118.008, 32.005, 1000.0);
+
+  auto pLoader = std::make_unique<HeightContentLoader>();
+  HeightContentLoader* pRawLoader = pLoader.get();
+  std::unique_ptr<Tile> pRoot =
+      pRawLoader->createRootTile(rectangle, TileRefine::Replace);
+  Tile* pChild = &pRoot->getChildren()[0];
+  Tileset tileset(externals, std::move(pLoader), std::move(pRoot));
+
+  const auto createDownwardRay = [](const Cartographic& position) {
+    return CesiumGeometry::Ray(
+        Ellipsoid::WGS84.cartographicToCartesian(position),
+        -Ellipsoid::WGS84.geodeticSurfaceNormal(position));
+  };
+
+  // Nothing is rendered before the first view update.
+  CHECK(!tileset.intersectRay(createDownwardRay(west)));
+
+  // Look down at the tileset closely enough to refine to the child.
+  const CesiumGeometry::Ray viewRay = createDownwardRay(west);
+  const glm::dvec3 up = -viewRay.getDirection();
+  const glm::dvec3 north = glm::cross(
+      up,
+      glm::normalize(glm::cross(glm::dvec3(0.0, 0.0, 1.0), up)));
+  const ViewState viewState = ViewState::create(
+      viewRay.getOrigin(),
+      viewRay.getDirection(),
+      north,
+      glm::dvec2(500.0, 500.0),
+      CesiumUtility::Math::OnePi / 2.0,
+      CesiumUtility::Math::OnePi / 2.0);
+  for (int i = 0; i < 10; ++i) {
+    tileset.updateView({viewState});
+    asyncSystem.dispatchMainThreadTasks();
+  }
+
+  const std::optional<TileRayIntersection> hit =
+      tileset.intersectRay(createDownwardRay(west));
+  REQUIRE(hit);
+  CHECK(hit->pTile == pChild);
+  CHECK(
+      hit->distance ==
+      Approx(west.height - HeightContentLoader::childHeight).margin(0.01));
+  CHECK(
+      Ellipsoid::WGS84.cartesianToCartographic(hit->position)->height ==
+      Approx(HeightContentLoader::childHeight).margin(0.01));
+
+  // The root tile, which covers the east, is replaced by the child.
+  CHECK(!tileset.intersectRay(createDownwardRay(east)));
+
+  CHECK(!tileset.intersectRay(CesiumGeometry::Ray(viewRay.getOrigin(), up)));
+
+  // The child is hit even where it sticks out of the bounding volume of its
+  // parent.
+  tileset.getRootTile()->setBoundingVolume(BoundingRegion(
+      GlobeRectangle(
+          rectangle.computeCenter().longitude,
+          rectangle.getSouth(),
+          rectangle.getEast(),
+          rectangle.getNorth()),
+      -1.0,
+      20.0));
+  const std::optional<TileRayIntersection> outsideParent =
+      tileset.intersectRay(createDownwardRay(west));
+  REQUIRE(outsideParent);
+  CHECK(outsideParent->pTile == pChild);
+}
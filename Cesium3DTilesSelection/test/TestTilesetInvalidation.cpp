@@ -0,0 +1,157 @@
+#include "Cesium3DTilesContent/registerAllTileContentTypes.h"
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "SimplePrepareRendererResource.h"
+
+#include <Cesium3DTilesSelection/TileInvalidation.h>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumNativeTests;
+
+namespace {
+// Records the headers of the last request of each URL.
+class RecordingAssetAccessor : public SimpleAssetAccessor {
+public:
+  using SimpleAssetAccessor::SimpleAssetAccessor;
+
+  Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    this->lastHeaders[url] = headers;
+    return SimpleAssetAccessor::get(asyncSystem, url, headers);
+  }
+
+  bool lastRequestRevalidated(const std::string& url) const {
+    auto it = this->lastHeaders.find(url);
+    return it != this->lastHeaders.end() &&
+           std::find(
+               it->second.begin(),
+               it->second.end(),
+               THeader("Cache-Control", "no-cache")) != it->second.end();
+  }
+
+  std::map<std::string, std::vector<THeader>> lastHeaders;
+};
+
+// The tiles of the ReplaceTileset, where the root has the children ll, lr,
+// ul and ur, and ll has the child ll_ll.
+std::shared_ptr<RecordingAssetAccessor> createTilesetAccessor() {
+  const std::filesystem::path testDataPath =
+      std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) /
+      "ReplaceTileset";
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+  for (const std::string& file :
+       {"tileset.json",
+        "parent.b3dm",
+        "ll.b3dm",
+        "lr.b3dm",
+        "ul.b3dm",
+        "ur.b3dm",
+        "ll_ll.b3dm"}) {
+    requests.emplace(
+        file,
+        std::make_shared<SimpleAssetRequest>(
+            "GET",
+            file,
+            HttpHeaders{},
+            std::make_unique<SimpleAssetResponse>(
+                static_cast<uint16_t>(200),
+                "doesn't matter",
+                HttpHeaders{},
+                readFile(testDataPath / file))));
+  }
+  return std::make_shared<RecordingAssetAccessor>(std::move(requests));
+}
+
+void loadAllTiles(Tileset& tileset, IAssetAccessor& assetAccessor) {
+  Future<TileFetchResult> future = tileset.fetchRegion({});
+  while (!future.isReady()) {
+    assetAccessor.tick();
+    tileset.updateView({});
+  }
+  REQUIRE(future.wait().tilesLoaded == 6);
+}
+
+const Tile* findTile(const Tile& tile, const std::string& url) {
+  if (tile.getTileID() == TileID(url)) {
+    return &tile;
+  }
+  for (const Tile& child : tile.getChildren()) {
+    if (const Tile* pFound = findTile(child, url)) {
+      return pFound;
+    }
+  }
+  return nullptr;
+}
+} // namespace
+
+TEST_CASE("Tileset::invalidateTiles") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::shared_ptr<RecordingAssetAccessor> pAssetAccessor =
+      createTilesetAccessor();
+  TilesetExternals externals{
+      pAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(externals, "tileset.json");
+  loadAllTiles(tileset, *pAssetAccessor);
+  const Tile* pRootTile = tileset.getRootTile();
+  REQUIRE(pRootTile);
+
+  SECTION("unloads only the matching tiles") {
+    TileInvalidation invalidation;
+    invalidation.tileIDs.emplace_back(std::string("ll.b3dm"));
+    invalidation.urlPatterns.emplace_back("u*.b3dm");
+    CHECK(tileset.invalidateTiles(invalidation) == 3);
+
+    for (const std::string& url : {"ll.b3dm", "ul.b3dm", "ur.b3dm"}) {
+      const Tile* pTile = findTile(*pRootTile, url);
+      REQUIRE(pTile);
+      CHECK(pTile->getState() == TileLoadState::Unloaded);
+    }
+    for (const std::string& url : {"parent.b3dm", "lr.b3dm", "ll_ll.b3dm"}) {
+      const Tile* pTile = findTile(*pRootTile, url);
+      REQUIRE(pTile);
+      CHECK(pTile->getState() == TileLoadState::Done);
+    }
+  }
+
+  SECTION("reloads the tiles without using the cache") {
+    TileInvalidation invalidation;
+    invalidation.tileIDs.emplace_back(std::string("ll.b3dm"));
+    CHECK(tileset.invalidateTiles(invalidation) == 1);
+
+    loadAllTiles(tileset, *pAssetAccessor);
+    const Tile* pTile = findTile(*pRootTile, "ll.b3dm");
+    REQUIRE(pTile);
+    CHECK(pTile->getState() == TileLoadState::Done);
+    CHECK(pAssetAccessor->lastRequestRevalidated("ll.b3dm"));
+    CHECK(!pAssetAccessor->lastRequestRevalidated("lr.b3dm"));
+  }
+
+  SECTION("doesn't reload the tileset JSON or match nothing") {
+    TileInvalidation invalidation;
+    invalidation.urlPatterns.emplace_back("*.json");
+    invalidation.urlPatterns.emplace_back("does-not-exist");
+    CHECK(tileset.invalidateTiles(invalidation) == 0);
+  }
+}
@@ -8,12 +8,18 @@
 #include <CesiumNativeTests/SimpleAssetResponse.h>
 #include <CesiumNativeTests/SimpleTaskProcessor.h>
 #include <CesiumNativeTests/readFile.h>
+#include <CesiumUtility/Uri.h>
 
 #include <catch2/catch.hpp>
+#include <rapidjson/document.h>
 
 #include <cstddef>
+#include <filesystem>
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 using namespace CesiumAsync;
 using namespace Cesium3DTilesSelection;
@@ -72,7 +78,8 @@ createLoader(const std::filesystem::path& tilesetPath) {
 TileLoadResult loadTileContent(
     const std::filesystem::path& tilePath,
     TilesetContentLoader& loader,
-    Tile& tile) {
+    Tile& tile,
+    const std::optional<ThreadPool>& decodeThreadPool = std::nullopt) {
   auto pMockCompletedResponse = std::make_unique<SimpleAssetResponse>(
       static_cast<uint16_t>(200),
       "doesn't matter",
@@ -100,7 +107,9 @@ TileLoadResult loadTileContent(
       asyncSystem,
       pMockAssetAccessor,
       spdlog::default_logger(),
-      {}};
+      {},
+      nullptr,
+      decodeThreadPool};
 
   auto tileLoadResultFuture = loader.loadTileContent(loadInput);
 
@@ -108,6 +117,40 @@ TileLoadResult loadTileContent(
 
   return tileLoadResultFuture.wait();
 }
+
+rapidjson::Document parseTilesetJson(const std::string& json) {
+  rapidjson::Document tilesetJson;
+  tilesetJson.Parse(json.data(), json.size());
+  REQUIRE(!tilesetJson.HasParseError());
+  return tilesetJson;
+}
+
+void createAllChildTiles(TilesetContentLoader& loader, Tile& tile) {
+  if (tile.getChildren().empty()) {
+    TileChildrenResult childrenResult = loader.createTileChildren(tile);
+    if (childrenResult.state == TileLoadResultState::Success) {
+      tile.createChildTiles(std::move(childrenResult.children));
+    }
+  }
+
+  for (Tile& child : tile.getChildren()) {
+    createAllChildTiles(loader, child);
+  }
+}
+
+void checkSameTiles(const Tile& expected, const Tile& actual) {
+  CHECK(actual.getTileID() == expected.getTileID());
+  CHECK(actual.getTransform() == expected.getTransform());
+  CHECK(
+      getBoundingVolumeCenter(actual.getBoundingVolume()) ==
+      getBoundingVolumeCenter(expected.getBoundingVolume()));
+  CHECK(actual.getGeometricError() == expected.getGeometricError());
+  CHECK(actual.getRefine() == expected.getRefine());
+  REQUIRE(actual.getChildren().size() == expected.getChildren().size());
+  for (size_t i = 0; i < expected.getChildren().size(); ++i) {
+    checkSameTiles(expected.getChildren()[i], actual.getChildren()[i]);
+  }
+}
 } // namespace
 
 TEST_CASE("Test creating tileset json loader") {
@@ -129,7 +172,7 @@ TEST_CASE("Test creating tileset json loader") {
     REQUIRE(pRootTile->getChildren().size() == 4);
     CHECK(pRootTile->getGeometricError() == 70.0);
     CHECK(pRootTile->getRefine() == TileRefine::Replace);
-    CHECK(std::get<std::string>(pRootTile->getTileID()) == "parent.b3dm");
+    CHECK(std::get<TileUrl>(pRootTile->getTileID()) == "parent.b3dm");
 
     const auto& boundingVolume = pRootTile->getBoundingVolume();
     const auto* pRegion =
@@ -148,7 +191,7 @@ TEST_CASE("Test creating tileset json loader") {
     CHECK(children[0].getChildren().size() == 1);
     CHECK(children[0].getGeometricError() == 5.0);
     CHECK(children[0].getRefine() == TileRefine::Replace);
-    CHECK(std::get<std::string>(children[0].getTileID()) == "ll.b3dm");
+    CHECK(std::get<TileUrl>(children[0].getTileID()) == "ll.b3dm");
     CHECK(std::holds_alternative<CesiumGeospatial::BoundingRegion>(
         children[0].getBoundingVolume()));
 
@@ -156,7 +199,7 @@ TEST_CASE("Test creating tileset json loader") {
     CHECK(children[1].getChildren().size() == 0);
     CHECK(children[1].getGeometricError() == 0.0);
     CHECK(children[1].getRefine() == TileRefine::Replace);
-    CHECK(std::get<std::string>(children[1].getTileID()) == "lr.b3dm");
+    CHECK(std::get<TileUrl>(children[1].getTileID()) == "lr.b3dm");
     CHECK(std::holds_alternative<CesiumGeospatial::BoundingRegion>(
         children[1].getBoundingVolume()));
 
@@ -164,7 +207,7 @@ TEST_CASE("Test creating tileset json loader") {
     CHECK(children[2].getChildren().size() == 0);
     CHECK(children[2].getGeometricError() == 0.0);
     CHECK(children[2].getRefine() == TileRefine::Replace);
-    CHECK(std::get<std::string>(children[2].getTileID()) == "ur.b3dm");
+    CHECK(std::get<TileUrl>(children[2].getTileID()) == "ur.b3dm");
     CHECK(std::holds_alternative<CesiumGeospatial::BoundingRegion>(
         children[2].getBoundingVolume()));
 
@@ -172,7 +215,7 @@ TEST_CASE("Test creating tileset json loader") {
     CHECK(children[3].getChildren().size() == 0);
     CHECK(children[3].getGeometricError() == 0.0);
     CHECK(children[3].getRefine() == TileRefine::Replace);
-    CHECK(std::get<std::string>(children[3].getTileID()) == "ul.b3dm");
+    CHECK(std::get<TileUrl>(children[3].getTileID()) == "ul.b3dm");
     CHECK(std::holds_alternative<CesiumGeospatial::BoundingRegion>(
         children[3].getBoundingVolume()));
 
@@ -196,7 +239,7 @@ TEST_CASE("Test creating tileset json loader") {
     CHECK(pRootTile->getChildren().size() == 4);
     CHECK(pRootTile->getGeometricError() == 70.0);
     CHECK(pRootTile->getRefine() == TileRefine::Add);
-    CHECK(std::get<std::string>(pRootTile->getTileID()) == "parent.b3dm");
+    CHECK(std::get<TileUrl>(pRootTile->getTileID()) == "parent.b3dm");
 
     const auto& boundingVolume = pRootTile->getBoundingVolume();
     const auto* pRegion =
@@ -218,7 +261,7 @@ TEST_CASE("Test creating tileset json loader") {
       CHECK(child.getChildren().size() == 0);
       CHECK(child.getGeometricError() == 0.0);
       CHECK(child.getRefine() == TileRefine::Add);
-      CHECK(std::get<std::string>(child.getTileID()) == *expectedUrlIt);
+      CHECK(std::get<TileUrl>(child.getTileID()) == *expectedUrlIt);
       CHECK(std::holds_alternative<CesiumGeospatial::BoundingRegion>(
           child.getBoundingVolume()));
       ++expectedUrlIt;
@@ -432,7 +475,8 @@ TEST_CASE("Test loading individual tile of tileset json") {
 
     auto pRootTile = &loaderResult.pRootTile->getChildren()[0];
 
-    const auto& tileID = std::get<std::string>(pRootTile->getTileID());
+    const std::string tileID =
+        std::get<TileUrl>(pRootTile->getTileID()).toString();
     CHECK(tileID == "parent.b3dm");
 
     // check tile content
@@ -448,6 +492,26 @@ TEST_CASE("Test loading individual tile of tileset json") {
     CHECK(!tileLoadResult.tileInitializer);
   }
 
+  SECTION("Load tile that has render content in a decode thread pool") {
+    auto loaderResult =
+        createLoader(testDataPath / "ReplaceTileset" / "tileset.json");
+    REQUIRE(loaderResult.pRootTile);
+    REQUIRE(loaderResult.pRootTile->getChildren().size() == 1);
+
+    auto pRootTile = &loaderResult.pRootTile->getChildren()[0];
+    const std::string tileID =
+        std::get<TileUrl>(pRootTile->getTileID()).toString();
+
+    auto tileLoadResult = loadTileContent(
+        testDataPath / "ReplaceTileset" / tileID,
+        *loaderResult.pLoader,
+        *pRootTile,
+        ThreadPool(1));
+    CHECK(
+        std::holds_alternative<CesiumGltf::Model>(tileLoadResult.contentKind));
+    CHECK(tileLoadResult.state == TileLoadResultState::Success);
+  }
+
   SECTION("Load tile that has external content") {
     auto loaderResult =
         createLoader(testDataPath / "AddTileset" / "tileset.json");
@@ -457,7 +521,8 @@ TEST_CASE("Test loading individual tile of tileset json") {
 
     auto pRootTile = &loaderResult.pRootTile->getChildren()[0];
 
-    const auto& tileID = std::get<std::string>(pRootTile->getTileID());
+    const std::string tileID =
+        std::get<TileUrl>(pRootTile->getTileID()).toString();
     CHECK(tileID == "tileset2.json");
 
     // check tile content
@@ -481,7 +546,7 @@ TEST_CASE("Test loading individual tile of tileset json") {
     REQUIRE(children.size() == 1);
 
     const Tile& parentB3dmTile = children[0];
-    CHECK(std::get<std::string>(parentB3dmTile.getTileID()) == "parent.b3dm");
+    CHECK(std::get<TileUrl>(parentB3dmTile.getTileID()) == "parent.b3dm");
     CHECK(parentB3dmTile.getGeometricError() == Approx(70.0));
 
     std::vector<std::string> expectedChildUrls{
@@ -492,7 +557,7 @@ TEST_CASE("Test loading individual tile of tileset json") {
     const auto& parentB3dmChildren = parentB3dmTile.getChildren();
     for (std::size_t i = 0; i < parentB3dmChildren.size(); ++i) {
       const Tile& child = parentB3dmChildren[i];
-      CHECK(std::get<std::string>(child.getTileID()) == expectedChildUrls[i]);
+      CHECK(std::get<TileUrl>(child.getTileID()) == expectedChildUrls[i]);
       CHECK(child.getGeometricError() == Approx(0.0));
       CHECK(child.getRefine() == TileRefine::Add);
       CHECK(std::holds_alternative<CesiumGeospatial::BoundingRegion>(
@@ -622,3 +687,188 @@ TEST_CASE("Test loading individual tile of tileset json") {
     CHECK(pLoader->getAvailableLevels() == 2);
   }
 }
+
+TEST_CASE("Test creating the tiles of tileset json lazily") {
+  // The second child of the root is invalid, so it is skipped.
+  const std::string json = R"(
+    {
+      "asset": { "version": "1.0" },
+      "geometricError": 100,
+      "root": {
+        "boundingVolume": { "box": [0, 0, 0, 10, 0, 0, 0, 10, 0, 0, 0, 10] },
+        "geometricError": 50,
+        "refine": "REPLACE",
+        "transform": [2, 0, 0, 0, 0, 2, 0, 0, 0, 0, 2, 0, 10, 20, 30, 1],
+        "children": [
+          {
+            "boundingVolume": { "sphere": [1, 2, 3, 4] },
+            "geometricError": 20,
+            "content": { "uri": "a.b3dm" }
+          },
+          {
+            "geometricError": 20,
+            "content": { "uri": "invalid.b3dm" }
+          },
+          {
+            "boundingVolume": { "sphere": [4, 3, 2, 1] },
+            "geometricError": 20,
+            "refine": "ADD",
+            "transform": [1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 5, 0, 0, 1],
+            "children": [
+              {
+                "boundingVolume": { "sphere": [0, 0, 0, 1] },
+                "geometricError": 5,
+                "content": { "uri": "b.b3dm" }
+              },
+              {
+                "boundingVolume": { "sphere": [0, 0, 0, 2] }
+              }
+            ]
+          }
+        ]
+      }
+    })";
+
+  TilesetContentLoaderResult<TilesetJsonLoader> eagerResult =
+      TilesetJsonLoader::createLoader(
+          spdlog::default_logger(),
+          "tileset.json",
+          parseTilesetJson(json));
+  REQUIRE(eagerResult.pRootTile);
+  REQUIRE(eagerResult.pRootTile->getChildren().size() == 1);
+  Tile& eagerRootTile = eagerResult.pRootTile->getChildren()[0];
+  CHECK(!eagerResult.pLoader->canRecreateTileChildren(eagerRootTile));
+  CHECK(
+      eagerResult.pLoader->createTileChildren(eagerRootTile.getChildren()[0])
+          .state == TileLoadResultState::Failed);
+
+  TilesetContentLoaderResult<TilesetJsonLoader> lazyResult =
+      TilesetJsonLoader::createLazyLoader(
+          spdlog::default_logger(),
+          "tileset.json",
+          parseTilesetJson(json));
+  REQUIRE(lazyResult.pRootTile);
+  REQUIRE(lazyResult.pRootTile->getChildren().size() == 1);
+  Tile& lazyRootTile = lazyResult.pRootTile->getChildren()[0];
+  CHECK(lazyRootTile.getChildren().empty());
+  CHECK(lazyResult.pLoader->canRecreateTileChildren(lazyRootTile));
+  CHECK(!lazyResult.pLoader->canRecreateTileChildren(*lazyResult.pRootTile));
+
+  SECTION("creates the same tiles as the eager loader") {
+    createAllChildTiles(*lazyResult.pLoader, *lazyResult.pRootTile);
+    checkSameTiles(*eagerResult.pRootTile, *lazyResult.pRootTile);
+  }
+
+  SECTION("creates children again after they are discarded") {
+    createAllChildTiles(*lazyResult.pLoader, *lazyResult.pRootTile);
+    REQUIRE(lazyRootTile.getChildren().size() == 2);
+    lazyResult.pLoader->releaseTileChildren(
+        lazyRootTile.getChildren()[1].takeChildTiles());
+    lazyResult.pLoader->releaseTileChildren(lazyRootTile.takeChildTiles());
+    CHECK(lazyRootTile.getChildren().empty());
+
+    createAllChildTiles(*lazyResult.pLoader, *lazyResult.pRootTile);
+    checkSameTiles(*eagerResult.pRootTile, *lazyResult.pRootTile);
+  }
+
+  SECTION("has no children for a leaf tile") {
+    createAllChildTiles(*lazyResult.pLoader, lazyRootTile);
+    const Tile& leafTile = lazyRootTile.getChildren()[0];
+    CHECK(leafTile.getChildren().empty());
+    CHECK(
+        lazyResult.pLoader->createTileChildren(leafTile).state ==
+        TileLoadResultState::Failed);
+  }
+}
+
+TEST_CASE("Test prefetching the root content of tileset json") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  class CountingAssetAccessor : public SimpleAssetAccessor {
+  public:
+    using SimpleAssetAccessor::SimpleAssetAccessor;
+
+    CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+    get(const CesiumAsync::AsyncSystem& asyncSystem,
+        const std::string& url,
+        const std::vector<THeader>& headers) override {
+      ++this->getCounts[url];
+      return SimpleAssetAccessor::get(asyncSystem, url, headers);
+    }
+
+    std::map<std::string, int> getCounts;
+  };
+
+  const std::filesystem::path tilesetPath =
+      testDataPath / "ReplaceTileset" / "tileset.json";
+  const std::string tilesetUrl = tilesetPath.string();
+  TilesetExternals externals = createMockTilesetExternals(tilesetUrl);
+
+  // Tile content is resolved against the URL of the mock tileset request.
+  auto resolve = [](const char* name) {
+    return Uri::resolve("tileset.json", name, true);
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests =
+      std::move(static_cast<SimpleAssetAccessor&>(*externals.pAssetAccessor)
+                    .mockCompletedRequests);
+  for (const char* name :
+       {"parent.b3dm", "ll.b3dm", "lr.b3dm", "ul.b3dm", "ur.b3dm"}) {
+    const std::string url = resolve(name);
+    requests[url] = std::make_shared<SimpleAssetRequest>(
+        "GET",
+        url,
+        CesiumAsync::HttpHeaders{},
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(tilesetPath.parent_path() / name)));
+  }
+  auto pAssetAccessor =
+      std::make_shared<CountingAssetAccessor>(std::move(requests));
+  externals.pAssetAccessor = pAssetAccessor;
+
+  auto loaderResultFuture = TilesetJsonLoader::createLoader(
+      externals,
+      tilesetUrl,
+      {},
+      false,
+      true);
+  externals.asyncSystem.dispatchMainThreadTasks();
+  auto loaderResult = loaderResultFuture.wait();
+  REQUIRE(loaderResult.pRootTile);
+  REQUIRE(loaderResult.pRootTile->getChildren().size() == 1);
+
+  // The root and its children are requested before any of them is loaded,
+  // but not the grandchild.
+  auto getCount = [&pAssetAccessor, &resolve](const char* name) {
+    return pAssetAccessor->getCounts[resolve(name)];
+  };
+  CHECK(getCount("parent.b3dm") == 1);
+  CHECK(getCount("ll.b3dm") == 1);
+  CHECK(getCount("ur.b3dm") == 1);
+  CHECK(getCount("ll_ll.b3dm") == 0);
+
+  Tile& rootTile = loaderResult.pRootTile->getChildren()[0];
+  auto loadRoot = [&]() {
+    TileLoadInput loadInput{
+        rootTile,
+        {},
+        externals.asyncSystem,
+        pAssetAccessor,
+        spdlog::default_logger(),
+        {}};
+    auto tileLoadResultFuture =
+        loaderResult.pLoader->loadTileContent(loadInput);
+    externals.asyncSystem.dispatchMainThreadTasks();
+    return tileLoadResultFuture.wait();
+  };
+
+  // The first load uses the content that was prefetched, and later loads
+  // request it again.
+  CHECK(loadRoot().state == TileLoadResultState::Success);
+  CHECK(getCount("parent.b3dm") == 1);
+  CHECK(loadRoot().state == TileLoadResultState::Success);
+  CHECK(getCount("parent.b3dm") == 2);
+}
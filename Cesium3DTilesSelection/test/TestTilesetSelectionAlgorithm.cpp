@@ -1,5 +1,6 @@
 #include "Cesium3DTilesContent/registerAllTileContentTypes.h"
 #include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTilesSelection/TilesetGroup.h"
 #include "Cesium3DTilesSelection/ViewState.h"
 #include "SimplePrepareRendererResource.h"
 
@@ -18,6 +19,7 @@
 #include <cstddef>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 
 using namespace CesiumAsync;
 using namespace Cesium3DTilesSelection;
@@ -218,6 +220,8 @@ TEST_CASE("Test replace refinement for render") {
       REQUIRE(result.tilesVisited == 2);
       REQUIRE(result.workerThreadTileLoadQueueLength == 0);
       REQUIRE(result.mainThreadTileLoadQueueLength == 0);
+      REQUIRE(result.maximumSimultaneousTileLoads == 20);
+      REQUIRE(result.maximumSimultaneousSubtreeLoads == 4);
       REQUIRE(result.tilesCulled == 0);
       REQUIRE(result.culledTilesVisited == 0);
 
@@ -226,6 +230,17 @@ TEST_CASE("Test replace refinement for render") {
         REQUIRE(child.getState() == TileLoadState::Unloaded);
       }
     }
+
+    // An adaptive limit starts from the static one, within its range, and
+    // the subtree limit is scaled along with it.
+    AdaptiveConcurrencyLimitOptions adaptiveOptions;
+    adaptiveOptions.maximumLimit = 8;
+    tileset.getOptions().adaptiveLoadConcurrency = adaptiveOptions;
+    ViewUpdateResult result = tileset.updateView({zoomOutViewState});
+    CHECK(result.maximumSimultaneousTileLoads == 8);
+    CHECK(result.maximumSimultaneousSubtreeLoads == 2);
+    CHECK(tileset.getOptions().contentOptions.maximumSimultaneousSubtreeLoads ==
+          4);
   }
 
   SECTION("Root doesn't meet sse but has to be rendered because children "
@@ -509,6 +524,40 @@ TEST_CASE("Test replace refinement for render") {
       REQUIRE(result.culledTilesVisited == 0);
     }
   }
+
+  SECTION("Skipping levels of detail loads the leaf without its parent") {
+    TilesetOptions& options = tileset.getOptions();
+    options.skipLevelOfDetail = true;
+    options.baseScreenSpaceError = std::numeric_limits<double>::infinity();
+    options.skipLevels = 2;
+
+    const Tile& ll = root->getChildren()[0];
+    REQUIRE(ll.getChildren().size() == 1);
+    const Tile& ll_ll = ll.getChildren()[0];
+
+    // From inside ll, neither ll nor its parent meet the SSE.
+    ViewState viewState = zoomToTile(ll);
+    ViewUpdateResult result;
+    for (int frame = 0; frame < 10; ++frame) {
+      result = tileset.updateView({viewState});
+    }
+
+    CHECK(!doesTileMeetSSE(viewState, ll, tileset));
+    CHECK(ll.getState() == TileLoadState::Unloaded);
+    CHECK(ll_ll.getState() == TileLoadState::Done);
+    CHECK(
+        std::find(
+            result.tilesToRenderThisFrame.begin(),
+            result.tilesToRenderThisFrame.end(),
+            &ll_ll) != result.tilesToRenderThisFrame.end());
+
+    // Without skipping, ll is loaded on the way down.
+    options.skipLevelOfDetail = false;
+    for (int frame = 0; frame < 10; ++frame) {
+      tileset.updateView({viewState});
+    }
+    CHECK(ll.getState() == TileLoadState::Done);
+  }
 }
 
 TEST_CASE("Test additive refinement") {
@@ -621,7 +670,7 @@ TEST_CASE("Test additive refinement") {
       for (const Tile& child : parentB3DM.getChildren()) {
         REQUIRE(child.getState() == TileLoadState::Done);
 
-        if (*std::get_if<std::string>(&child.getTileID()) !=
+        if (std::get<TileUrl>(child.getTileID()) !=
             "tileset3/tileset3.json") {
           REQUIRE(doesTileMeetSSE(viewState, child, tileset));
         } else {
@@ -1678,3 +1727,1294 @@ TEST_CASE("Additive-refined tiles are added to the tilesFadingOut array") {
   CHECK(updateResult.tilesToRenderThisFrame.size() == 2);
   CHECK(updateResult.tilesFadingOut.size() == 2);
 }
+
+TEST_CASE("Parallel traversal selects the same tiles as serial traversal") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> mockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+  TilesetExternals tilesetExternals{
+      mockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions parallelOptions{};
+  parallelOptions.enableParallelTraversal = true;
+  parallelOptions.parallelTraversalMinimumChildren = 1;
+
+  Tileset serialTileset(tilesetExternals, "tileset.json");
+  Tileset parallelTileset(tilesetExternals, "tileset.json", parallelOptions);
+  initializeTileset(serialTileset);
+  initializeTileset(parallelTileset);
+
+  ViewState viewState = zoomToTileset(serialTileset);
+  glm::dvec3 zoomOutPosition =
+      viewState.getPosition() - viewState.getDirection() * 2500.0;
+  ViewState zoomOutViewState = ViewState::create(
+      zoomOutPosition,
+      viewState.getDirection(),
+      viewState.getUp(),
+      viewState.getViewportSize(),
+      viewState.getHorizontalFieldOfView(),
+      viewState.getVerticalFieldOfView());
+
+  for (int frame = 0; frame < 4; ++frame) {
+    const ViewUpdateResult& serialResult =
+        serialTileset.updateView({viewState, zoomOutViewState});
+    const ViewUpdateResult& parallelResult =
+        parallelTileset.updateView({viewState, zoomOutViewState});
+
+    CHECK(serialResult.tilesVisited == parallelResult.tilesVisited);
+    CHECK(serialResult.tilesCulled == parallelResult.tilesCulled);
+    CHECK(
+        serialResult.workerThreadTileLoadQueueLength ==
+        parallelResult.workerThreadTileLoadQueueLength);
+    CHECK(
+        serialResult.tilesFadingOut.size() ==
+        parallelResult.tilesFadingOut.size());
+
+    REQUIRE(
+        serialResult.tilesToRenderThisFrame.size() ==
+        parallelResult.tilesToRenderThisFrame.size());
+    for (size_t i = 0; i < serialResult.tilesToRenderThisFrame.size(); ++i) {
+      CHECK(
+          serialResult.tilesToRenderThisFrame[i]->getTileID() ==
+          parallelResult.tilesToRenderThisFrame[i]->getTileID());
+    }
+
+    // The loaded tiles are in the order in which they were visited, which
+    // decides the order in which they're unloaded.
+    std::vector<TileID> serialLoadedTiles;
+    serialTileset.forEachLoadedTile([&serialLoadedTiles](Tile& tile) {
+      serialLoadedTiles.emplace_back(tile.getTileID());
+    });
+    std::vector<TileID> parallelLoadedTiles;
+    parallelTileset.forEachLoadedTile([&parallelLoadedTiles](Tile& tile) {
+      parallelLoadedTiles.emplace_back(tile.getTileID());
+    });
+    CHECK(serialLoadedTiles == parallelLoadedTiles);
+  }
+}
+
+TEST_CASE("Cached view evaluations select the same tiles as a full "
+          "evaluation") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::vector<std::string> files{
+      "tileset.json",
+      "parent.b3dm",
+      "ll.b3dm",
+      "lr.b3dm",
+      "ul.b3dm",
+      "ur.b3dm",
+      "ll_ll.b3dm",
+  };
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& file : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> mockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests));
+  TilesetExternals tilesetExternals{
+      mockAssetAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions cachingOptions{};
+  cachingOptions.enableViewEvaluationCaching = true;
+
+  Tileset fullTileset(tilesetExternals, "tileset.json");
+  Tileset cachingTileset(tilesetExternals, "tileset.json", cachingOptions);
+  initializeTileset(fullTileset);
+  initializeTileset(cachingTileset);
+
+  ViewState viewState = zoomToTileset(fullTileset);
+
+  auto checkSameSelection = [&]() {
+    const ViewUpdateResult& fullResult = fullTileset.updateView({viewState});
+    const ViewUpdateResult& cachingResult =
+        cachingTileset.updateView({viewState});
+
+    CHECK(fullResult.tilesVisited == cachingResult.tilesVisited);
+    CHECK(fullResult.tilesCulled == cachingResult.tilesCulled);
+    CHECK(fullResult.screenSpaceErrorEvaluations > 0);
+    CHECK(
+        cachingResult.screenSpaceErrorEvaluations <=
+        fullResult.screenSpaceErrorEvaluations);
+    // Each evaluated tile is tested at least against the frustum, and at most
+    // against the frustum, the fog and the horizon of the one view.
+    CHECK(fullResult.cullingTests >= fullResult.screenSpaceErrorEvaluations);
+    CHECK(
+        fullResult.cullingTests <= 3 * fullResult.screenSpaceErrorEvaluations);
+    CHECK(cachingResult.cullingTests <= fullResult.cullingTests);
+
+    // Timings are only measured when asked for.
+    CHECK(fullResult.traversalTime == 0.0);
+    CHECK(fullResult.mainThreadLoadQueueTime == 0.0);
+    REQUIRE(
+        fullResult.tilesToRenderThisFrame.size() ==
+        cachingResult.tilesToRenderThisFrame.size());
+    for (size_t i = 0; i < fullResult.tilesToRenderThisFrame.size(); ++i) {
+      CHECK(
+          fullResult.tilesToRenderThisFrame[i]->getTileID() ==
+          cachingResult.tilesToRenderThisFrame[i]->getTileID());
+    }
+  };
+
+  // The camera doesn't move, so evaluations are reused while tiles load.
+  for (int frame = 0; frame < 4; ++frame) {
+    checkSameSelection();
+  }
+
+  SECTION("Changing the screen-space error takes effect immediately") {
+    fullTileset.getOptions().maximumScreenSpaceError = 1e10;
+    cachingTileset.getOptions().maximumScreenSpaceError = 1e10;
+    checkSameSelection();
+    const ViewUpdateResult& result = cachingTileset.updateView({viewState});
+    CHECK(result.tilesToRenderThisFrame.size() == 1);
+  }
+
+  SECTION("Moving the camera discards the cached evaluations") {
+    viewState = ViewState::create(
+        viewState.getPosition() - viewState.getDirection() * 2500.0,
+        viewState.getDirection(),
+        viewState.getUp(),
+        viewState.getViewportSize(),
+        viewState.getHorizontalFieldOfView(),
+        viewState.getVerticalFieldOfView());
+    for (int frame = 0; frame < 2; ++frame) {
+      checkSameSelection();
+    }
+  }
+}
+
+static std::shared_ptr<SimpleAssetAccessor> createImplicitTilesetAccessor() {
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ImplicitTileset";
+  std::map<std::string, std::filesystem::path> files{
+      {"tileset.json", "tileset_1.1.json"},
+      {"subtrees/0.0.0.json", "subtrees/0.0.0.json"},
+      {"content/0/0/0.b3dm", "content/0/0/0.b3dm"},
+      {"content/1/0/0.b3dm", "content/1/0/0.b3dm"},
+      {"content/1/0/1.b3dm", "content/1/0/1.b3dm"},
+      {"content/1/1/0.b3dm", "content/1/1/0.b3dm"},
+      {"content/1/1/1.b3dm", "content/1/1/1.b3dm"}};
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const auto& [url, file] : files) {
+    std::unique_ptr<SimpleAssetResponse> mockCompletedResponse =
+        std::make_unique<SimpleAssetResponse>(
+            static_cast<uint16_t>(200),
+            "doesn't matter",
+            CesiumAsync::HttpHeaders{},
+            readFile(testDataPath / file));
+    mockCompletedRequests.insert(
+        {url,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             url,
+             CesiumAsync::HttpHeaders{},
+             std::move(mockCompletedResponse))});
+  }
+
+  return std::make_shared<SimpleAssetAccessor>(
+      std::move(mockCompletedRequests));
+}
+
+// A view from high above a tile, from which it meets the screen-space error.
+static ViewState viewFromFarAbove(const Tile& tile, const ViewState& like) {
+  const BoundingRegion& region =
+      std::get<BoundingRegion>(tile.getBoundingVolume());
+  Cartographic center = region.getRectangle().computeCenter();
+  Cartographic farAway = center;
+  farAway.height = 10000000.0;
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  glm::dvec3 farPosition = ellipsoid.cartographicToCartesian(farAway);
+  glm::dvec3 centerPosition = ellipsoid.cartographicToCartesian(center);
+  return ViewState::create(
+      farPosition,
+      glm::normalize(centerPosition - farPosition),
+      glm::dvec3(0.0, 0.0, 1.0),
+      like.getViewportSize(),
+      like.getHorizontalFieldOfView(),
+      like.getVerticalFieldOfView());
+}
+
+TEST_CASE("Unused implicit subtrees are pruned and recreated on demand") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals{
+      createImplicitTilesetAccessor(),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  options.maximumCachedBytes = 0;
+  options.enableSubtreePruning = true;
+  options.subtreePruningFrameCount = 2;
+
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& root = pTilesetJson->getChildren()[0];
+  REQUIRE(root.getChildren().size() == 1);
+  const Tile& implicitRoot = root.getChildren()[0];
+
+  // Look at the implicit root up close until its children are created and
+  // loaded.
+  ViewState closeView = zoomToTile(implicitRoot);
+  for (int i = 0; i < 10; ++i) {
+    tileset.updateView({closeView});
+  }
+  REQUIRE(!implicitRoot.getChildren().empty());
+  const size_t childCount = implicitRoot.getChildren().size();
+
+  // From far away, the root meets the screen-space error, so the implicit root
+  // is no longer visited and its children's content is evicted from the
+  // cache.
+  ViewState farView = viewFromFarAbove(implicitRoot, closeView);
+
+  SECTION("The children are discarded and created again when needed") {
+    for (int i = 0; i < 10; ++i) {
+      tileset.updateView({farView});
+    }
+    CHECK(implicitRoot.getChildren().empty());
+
+    tileset.updateView({closeView});
+    CHECK(implicitRoot.getChildren().size() == childCount);
+  }
+
+  SECTION("Nothing is discarded when pruning is disabled") {
+    TilesetOptions& tilesetOptions = tileset.getOptions();
+    tilesetOptions.enableSubtreePruning = false;
+    for (int i = 0; i < 10; ++i) {
+      tileset.updateView({farView});
+    }
+    CHECK(implicitRoot.getChildren().size() == childCount);
+  }
+}
+
+TEST_CASE("Tiles needed by predicted views are loaded but not rendered") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals{
+      createImplicitTilesetAccessor(),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& root = pTilesetJson->getChildren()[0];
+  REQUIRE(root.getChildren().size() == 1);
+  const Tile& implicitRoot = root.getChildren()[0];
+
+  const ViewState closeView = zoomToTile(implicitRoot);
+  const ViewState farView = viewFromFarAbove(implicitRoot, closeView);
+
+  SECTION("Nothing beyond the current view is loaded without predictions") {
+    for (int i = 0; i < 10; ++i) {
+      tileset.updateView({farView});
+    }
+    CHECK(implicitRoot.getState() == TileLoadState::Unloaded);
+  }
+
+  SECTION("The tiles of a predicted view are loaded") {
+    tileset.setPredictedViews({closeView});
+    REQUIRE(tileset.getPredictedViews().size() == 1);
+
+    for (int i = 0; i < 10; ++i) {
+      const ViewUpdateResult& result = tileset.updateView({farView});
+      CHECK(
+          std::find(
+              result.tilesToRenderThisFrame.begin(),
+              result.tilesToRenderThisFrame.end(),
+              &implicitRoot) == result.tilesToRenderThisFrame.end());
+    }
+
+    CHECK(implicitRoot.getState() == TileLoadState::Done);
+    REQUIRE(!implicitRoot.getChildren().empty());
+    for (const Tile& child : implicitRoot.getChildren()) {
+      CHECK(child.getState() == TileLoadState::Done);
+    }
+
+    // Once the camera arrives, everything is ready to render right away.
+    const ViewUpdateResult& result = tileset.updateView({closeView});
+    CHECK(result.workerThreadTileLoadQueueLength == 0);
+    CHECK(result.mainThreadTileLoadQueueLength == 0);
+  }
+}
+
+// A view from the given height above the center of a tile, looking down but
+// turned east by the given angle.
+static ViewState
+viewFromAbove(const Tile& tile, double height, double angleFromTile) {
+  const BoundingRegion& region =
+      std::get<BoundingRegion>(tile.getBoundingVolume());
+  Cartographic above = region.getRectangle().computeCenter();
+  above.height = height;
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  const glm::dvec3 position = ellipsoid.cartographicToCartesian(above);
+  const glm::dvec3 up = ellipsoid.geodeticSurfaceNormal(position);
+  const glm::dvec3 east = glm::normalize(glm::cross(glm::dvec3(0, 0, 1), up));
+  const glm::dvec3 north = glm::cross(up, east);
+  const double fieldOfView = Math::degreesToRadians(60.0);
+  return ViewState::create(
+      position,
+      -glm::cos(angleFromTile) * up + glm::sin(angleFromTile) * east,
+      north,
+      glm::dvec2(500.0, 500.0),
+      fieldOfView,
+      fieldOfView);
+}
+
+TEST_CASE("Foveated screen-space error relaxes tiles at the edge of the view") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals{
+      createImplicitTilesetAccessor(),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& root = pTilesetJson->getChildren()[0];
+  REQUIRE(root.getChildren().size() == 1);
+  const Tile& implicitRoot = root.getChildren()[0];
+
+  // From 1000 meters above, the implicit root doesn't meet the screen-space
+  // error when looked at directly.
+  auto createView = [&implicitRoot](double angleFromTile) {
+    return viewFromAbove(implicitRoot, 1000.0, angleFromTile);
+  };
+
+  auto getImplicitRootResult = [&](const ViewState& view) {
+    const ViewUpdateResult* pResult = nullptr;
+    for (int i = 0; i < 10; ++i) {
+      pResult = &tileset.updateView({view});
+    }
+    return implicitRoot.getLastSelectionState().getResult(
+        pResult->frameNumber);
+  };
+
+  // The tile is still partially visible at the edge of this view.
+  const ViewState edgeView = createView(Math::degreesToRadians(40.0));
+  const ViewState centerView = createView(0.0);
+
+  SECTION("Without foveation, the tile is refined anywhere in the view") {
+    CHECK(
+        getImplicitRootResult(edgeView) ==
+        TileSelectionState::Result::Refined);
+  }
+
+  SECTION("With foveation, the tile is only refined near the center") {
+    FoveatedScreenSpaceErrorOptions foveation;
+    foveation.coneSize = 0.0;
+    foveation.minimumScreenSpaceErrorFactor = 0.0;
+    tileset.getOptions().foveatedScreenSpaceError = foveation;
+
+    CHECK(
+        getImplicitRootResult(edgeView) ==
+        TileSelectionState::Result::Rendered);
+    CHECK(
+        getImplicitRootResult(centerView) ==
+        TileSelectionState::Result::Refined);
+  }
+}
+
+TEST_CASE("The screen-space error governor keeps the tileset within budget") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals{
+      createImplicitTilesetAccessor(),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& root = pTilesetJson->getChildren()[0];
+  REQUIRE(root.getChildren().size() == 1);
+  const Tile& implicitRoot = root.getChildren()[0];
+
+  // From here, the root tile meets a screen-space error of 64, but not 16.
+  const ViewState view = viewFromAbove(implicitRoot, 1000.0, 0.0);
+
+  size_t tilesRenderedWithoutGovernor = 0;
+  for (int i = 0; i < 10; ++i) {
+    const ViewUpdateResult& result = tileset.updateView({view});
+    CHECK(result.maximumScreenSpaceError == 16.0);
+    tilesRenderedWithoutGovernor = result.tilesToRenderThisFrame.size();
+  }
+  REQUIRE(tilesRenderedWithoutGovernor > 1);
+
+  ScreenSpaceErrorGovernorOptions governor;
+  governor.maximumTilesRendered = 1;
+  governor.minimumScreenSpaceError = 16.0;
+  governor.maximumScreenSpaceError = 100000.0;
+  governor.adjustmentRate = 1.0;
+  tileset.getOptions().screenSpaceErrorGovernor = governor;
+
+  SECTION("The screen-space error is raised until the budget is met") {
+    const ViewUpdateResult* pResult = nullptr;
+    for (int i = 0; i < 20; ++i) {
+      pResult = &tileset.updateView({view});
+    }
+    CHECK(pResult->maximumScreenSpaceError > 16.0);
+    CHECK(pResult->tilesToRenderThisFrame.size() == 1);
+  }
+
+  SECTION("The screen-space error is lowered again when there is room") {
+    for (int i = 0; i < 20; ++i) {
+      tileset.updateView({view});
+    }
+
+    tileset.getOptions().screenSpaceErrorGovernor->maximumTilesRendered =
+        100;
+    const ViewUpdateResult* pResult = nullptr;
+    for (int i = 0; i < 40; ++i) {
+      pResult = &tileset.updateView({view});
+    }
+    CHECK(pResult->maximumScreenSpaceError == 16.0);
+    CHECK(
+        pResult->tilesToRenderThisFrame.size() ==
+        tilesRenderedWithoutGovernor);
+  }
+
+  SECTION("The screen-space error stays within the configured range") {
+    tileset.getOptions().screenSpaceErrorGovernor->maximumScreenSpaceError =
+        20.0;
+    const ViewUpdateResult* pResult = nullptr;
+    for (int i = 0; i < 20; ++i) {
+      pResult = &tileset.updateView({view});
+    }
+    CHECK(pResult->maximumScreenSpaceError == 20.0);
+  }
+
+  SECTION("The screen-space error is unchanged without a budget") {
+    ScreenSpaceErrorGovernorOptions& options =
+        *tileset.getOptions().screenSpaceErrorGovernor;
+    options.maximumTilesRendered.reset();
+    options.minimumScreenSpaceError = 1.0;
+    const ViewUpdateResult* pResult = nullptr;
+    for (int i = 0; i < 20; ++i) {
+      pResult = &tileset.updateView({view});
+    }
+    CHECK(pResult->maximumScreenSpaceError == 16.0);
+    CHECK(
+        pResult->tilesToRenderThisFrame.size() ==
+        tilesRenderedWithoutGovernor);
+  }
+}
+
+TEST_CASE("Tiles load in either priority mode") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals{
+      createImplicitTilesetAccessor(),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  // Load one tile at a time, so that the load order matters.
+  options.maximumSimultaneousTileLoads = 1;
+
+  SECTION("Distance") {
+    options.tileLoadPriorityMode = TileLoadPriorityMode::Distance;
+  }
+
+  SECTION("Screen-space error deficit") {
+    options.tileLoadPriorityMode =
+        TileLoadPriorityMode::ScreenSpaceErrorDeficit;
+  }
+
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& root = pTilesetJson->getChildren()[0];
+  REQUIRE(root.getChildren().size() == 1);
+  const Tile& implicitRoot = root.getChildren()[0];
+
+  const ViewState view = zoomToTile(implicitRoot);
+  const ViewUpdateResult* pResult = nullptr;
+  for (int i = 0; i < 20; ++i) {
+    pResult = &tileset.updateView({view});
+  }
+
+  CHECK(pResult->workerThreadTileLoadQueueLength == 0);
+  CHECK(pResult->mainThreadTileLoadQueueLength == 0);
+  CHECK(implicitRoot.getState() == TileLoadState::Done);
+  REQUIRE(!implicitRoot.getChildren().empty());
+  for (const Tile& child : implicitRoot.getChildren()) {
+    CHECK(child.getState() == TileLoadState::Done);
+  }
+}
+
+TEST_CASE("Tiles load within a main-thread time budget") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals{
+      createImplicitTilesetAccessor(),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  // A budget so small that only the minimum amount of work is done each frame.
+  TilesetOptions options;
+  options.mainThreadTimeLimit = 1e-6;
+
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& root = pTilesetJson->getChildren()[0];
+  REQUIRE(root.getChildren().size() == 1);
+  const Tile& implicitRoot = root.getChildren()[0];
+
+  const ViewState view = zoomToTile(implicitRoot);
+  const ViewUpdateResult* pResult = nullptr;
+  for (int i = 0; i < 200; ++i) {
+    pResult = &tileset.updateView({view});
+  }
+
+  // Work left over in one frame is carried over to the next, so everything
+  // eventually loads.
+  CHECK(pResult->workerThreadTileLoadQueueLength == 0);
+  CHECK(pResult->mainThreadTileLoadQueueLength == 0);
+  CHECK(implicitRoot.getState() == TileLoadState::Done);
+  REQUIRE(!implicitRoot.getChildren().empty());
+  for (const Tile& child : implicitRoot.getChildren()) {
+    CHECK(child.getState() == TileLoadState::Done);
+  }
+}
+
+TEST_CASE("An offline view update loads all tiles regardless of the limits") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals{
+      createImplicitTilesetAccessor(),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  options.maximumSimultaneousTileLoads = 1;
+  options.mainThreadTimeLimit = 1e-6;
+
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& root = pTilesetJson->getChildren()[0];
+  REQUIRE(root.getChildren().size() == 1);
+  const Tile& implicitRoot = root.getChildren()[0];
+
+  const ViewUpdateResult& result =
+      tileset.updateViewOffline({zoomToTile(implicitRoot)});
+
+  CHECK(result.workerThreadTileLoadQueueLength == 0);
+  CHECK(result.mainThreadTileLoadQueueLength == 0);
+  CHECK(implicitRoot.getState() == TileLoadState::Done);
+  REQUIRE(!implicitRoot.getChildren().empty());
+  for (const Tile& child : implicitRoot.getChildren()) {
+    CHECK(child.getState() == TileLoadState::Done);
+  }
+
+  // The limits apply again to the views that are updated afterward.
+  CHECK(tileset.getOptions().maximumSimultaneousTileLoads == 1);
+  CHECK(tileset.getOptions().mainThreadTimeLimit == 1e-6);
+}
+
+TEST_CASE("Evicting for memory pressure keeps the rendered tiles") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals{
+      createImplicitTilesetAccessor(),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& root = pTilesetJson->getChildren()[0];
+  REQUIRE(root.getChildren().size() == 1);
+  const Tile& implicitRoot = root.getChildren()[0];
+
+  const ViewState closeView = zoomToTile(implicitRoot);
+  for (int i = 0; i < 10; ++i) {
+    tileset.updateView({closeView});
+  }
+  REQUIRE(!implicitRoot.getChildren().empty());
+  for (const Tile& child : implicitRoot.getChildren()) {
+    REQUIRE(child.getState() == TileLoadState::Done);
+  }
+
+  // The children are no longer needed, but fit in the cache.
+  const ViewState farView = viewFromFarAbove(implicitRoot, closeView);
+  const ViewUpdateResult& result = tileset.updateView({farView});
+  for (const Tile& child : implicitRoot.getChildren()) {
+    REQUIRE(child.getState() == TileLoadState::Done);
+  }
+
+  const int64_t bytesBefore = tileset.getTotalDataBytes();
+  tileset.evictForMemoryPressure();
+  CHECK(tileset.getTotalDataBytes() < bytesBefore);
+
+  for (const Tile& child : implicitRoot.getChildren()) {
+    CHECK(child.getState() == TileLoadState::Unloaded);
+  }
+  for (const Tile* pTile : result.tilesToRenderThisFrame) {
+    CHECK(pTile->getState() == TileLoadState::Done);
+  }
+  CHECK(pTilesetJson->getState() == TileLoadState::Done);
+}
+
+TEST_CASE("Tilesets in a group share their loads and memory budget") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals{
+      createImplicitTilesetAccessor(),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  Tileset first(tilesetExternals, "tileset.json");
+  Tileset second(tilesetExternals, "tileset.json");
+  initializeTileset(first);
+  initializeTileset(second);
+
+  TilesetGroup group;
+  group.addTileset(first);
+  group.addTileset(second);
+  REQUIRE(group.getTilesets() == std::vector<Tileset*>{&first, &second});
+
+  auto getImplicitRoot = [](const Tileset& tileset) -> const Tile& {
+    const Tile* pTilesetJson = tileset.getRootTile();
+    REQUIRE(pTilesetJson);
+    REQUIRE(pTilesetJson->getChildren().size() == 1);
+    const Tile& root = pTilesetJson->getChildren()[0];
+    REQUIRE(root.getChildren().size() == 1);
+    return root.getChildren()[0];
+  };
+  const Tile& firstImplicitRoot = getImplicitRoot(first);
+  const Tile& secondImplicitRoot = getImplicitRoot(second);
+
+  const ViewState closeView = zoomToTile(firstImplicitRoot);
+
+  SECTION("Tiles are only loaded by the group") {
+    const ViewUpdateResult* pResult = nullptr;
+    for (int i = 0; i < 10; ++i) {
+      pResult = &first.updateView({closeView});
+    }
+    CHECK(pResult->workerThreadTileLoadQueueLength > 0);
+    for (const Tile& child : firstImplicitRoot.getChildren()) {
+      CHECK(child.getState() == TileLoadState::Unloaded);
+    }
+
+    for (int i = 0; i < 10; ++i) {
+      first.updateView({closeView});
+      group.updateLoads();
+    }
+    CHECK(firstImplicitRoot.getState() == TileLoadState::Done);
+    REQUIRE(!firstImplicitRoot.getChildren().empty());
+    for (const Tile& child : firstImplicitRoot.getChildren()) {
+      CHECK(child.getState() == TileLoadState::Done);
+    }
+  }
+
+  SECTION("Every tileset in the group loads its tiles") {
+    group.getOptions().maximumSimultaneousTileLoads = 1;
+    const std::vector<const ViewUpdateResult*>* pResults = nullptr;
+    for (int i = 0; i < 20; ++i) {
+      pResults = &group.updateView({closeView});
+    }
+
+    REQUIRE(pResults->size() == 2);
+    for (const ViewUpdateResult* pResult : *pResults) {
+      CHECK(!pResult->tilesToRenderThisFrame.empty());
+    }
+
+    for (const Tile* pImplicitRoot :
+         {&firstImplicitRoot, &secondImplicitRoot}) {
+      CHECK(pImplicitRoot->getState() == TileLoadState::Done);
+      REQUIRE(!pImplicitRoot->getChildren().empty());
+      for (const Tile& child : pImplicitRoot->getChildren()) {
+        CHECK(child.getState() == TileLoadState::Done);
+      }
+    }
+  }
+
+  SECTION("Cached tiles are unloaded to fit the group's budget") {
+    for (int i = 0; i < 10; ++i) {
+      group.updateView({closeView});
+    }
+    REQUIRE(!firstImplicitRoot.getChildren().empty());
+    REQUIRE(
+        firstImplicitRoot.getChildren()[0].getState() == TileLoadState::Done);
+
+    // The tilesets would keep their tiles within their own budgets.
+    group.getOptions().maximumCachedBytes = 0;
+    const ViewState farView = viewFromFarAbove(firstImplicitRoot, closeView);
+    for (int i = 0; i < 10; ++i) {
+      group.updateView({farView});
+    }
+    for (const Tile& child : firstImplicitRoot.getChildren()) {
+      CHECK(child.getState() == TileLoadState::Unloaded);
+    }
+  }
+
+  SECTION("Destroyed tilesets leave their group") {
+    {
+      Tileset third(tilesetExternals, "tileset.json");
+      group.addTileset(third);
+      CHECK(group.getTilesets().size() == 3);
+    }
+    CHECK(group.getTilesets().size() == 2);
+  }
+}
+
+// A tileset whose root has one child in the middle and one in each of two
+// corners, each of which refers to an external tileset.
+static std::shared_ptr<SimpleAssetAccessor> createExternalTilesetsAccessor() {
+  const std::string tilesetJson = R"(
+    {
+      "asset": { "version": "1.0" },
+      "geometricError": 240,
+      "root": {
+        "boundingVolume": {
+          "region": [-1.32, 0.698, -1.318, 0.7, 0, 88]
+        },
+        "geometricError": 70,
+        "refine": "REPLACE",
+        "content": { "uri": "parent.b3dm" },
+        "children": [
+          {
+            "boundingVolume": {
+              "region": [-1.3192, 0.6988, -1.3188, 0.6992, 0, 88]
+            },
+            "geometricError": 10,
+            "content": { "uri": "middle.json" }
+          },
+          {
+            "boundingVolume": {
+              "region": [-1.32, 0.698, -1.3196, 0.6984, 0, 88]
+            },
+            "geometricError": 10,
+            "content": { "uri": "southwest.json" }
+          },
+          {
+            "boundingVolume": {
+              "region": [-1.3184, 0.6996, -1.318, 0.7, 0, 88]
+            },
+            "geometricError": 10,
+            "content": { "uri": "northeast.json" }
+          }
+        ]
+      }
+    })";
+  const std::string externalTilesetJson = R"(
+    {
+      "asset": { "version": "1.0" },
+      "geometricError": 10,
+      "root": {
+        "boundingVolume": {
+          "region": [-1.32, 0.698, -1.318, 0.7, 0, 88]
+        },
+        "geometricError": 0,
+        "content": { "uri": "ll.b3dm" }
+      }
+    })";
+
+  const auto toBytes = [](const std::string& json) {
+    std::vector<std::byte> bytes(json.size());
+    std::transform(json.begin(), json.end(), bytes.begin(), [](char c) {
+      return std::byte(c);
+    });
+    return bytes;
+  };
+
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::map<std::string, std::vector<std::byte>> files{
+      {"tileset.json", toBytes(tilesetJson)},
+      {"middle.json", toBytes(externalTilesetJson)},
+      {"southwest.json", toBytes(externalTilesetJson)},
+      {"northeast.json", toBytes(externalTilesetJson)},
+      {"parent.b3dm", readFile(testDataPath / "parent.b3dm")},
+      {"ll.b3dm", readFile(testDataPath / "ll.b3dm")}};
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (auto& [url, data] : files) {
+    mockCompletedRequests.insert(
+        {url,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             url,
+             CesiumAsync::HttpHeaders{},
+             std::make_unique<SimpleAssetResponse>(
+                 static_cast<uint16_t>(200),
+                 "doesn't matter",
+                 CesiumAsync::HttpHeaders{},
+                 std::move(data)))});
+  }
+
+  return std::make_shared<SimpleAssetAccessor>(
+      std::move(mockCompletedRequests));
+}
+
+TEST_CASE("The nearest external tilesets are loaded before they are needed") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals{
+      createExternalTilesetsAccessor(),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+
+  TilesetOptions options;
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile& root = pTilesetJson->getChildren()[0];
+  REQUIRE(root.getChildren().size() == 3);
+  const Tile& middle = root.getChildren()[0];
+
+  // From far above its middle, the root meets the screen-space error, so its
+  // children aren't visited.
+  const ViewState farView = viewFromFarAbove(root, zoomToTile(root));
+
+  SECTION("Nothing is loaded ahead of time by default") {
+    for (int i = 0; i < 10; ++i) {
+      const ViewUpdateResult& result = tileset.updateView({farView});
+      CHECK(result.tilesToRenderThisFrame.size() == 1);
+    }
+    for (const Tile& child : root.getChildren()) {
+      CHECK(child.getState() == TileLoadState::Unloaded);
+    }
+  }
+
+  SECTION("The nearest external tilesets are loaded") {
+    tileset.getOptions().externalTilesetPrefetchCount = 2;
+    for (int i = 0; i < 10; ++i) {
+      const ViewUpdateResult& result = tileset.updateView({farView});
+      CHECK(result.tilesToRenderThisFrame.size() == 1);
+    }
+
+    CHECK(middle.isExternalContent());
+    CHECK(middle.getChildren().size() == 1);
+    size_t loadedCount = 0;
+    for (const Tile& child : root.getChildren()) {
+      if (child.getState() != TileLoadState::Unloaded) {
+        CHECK(child.isExternalContent());
+        ++loadedCount;
+      }
+    }
+    CHECK(loadedCount == 2);
+  }
+}
+
+static TilesetExternals createReplaceTilesetExternals() {
+  //				   parent.b3dm
+  //
+  // ll.b3dm		lr.b3dm		ul.b3dm		ur.b3dm
+  //
+  // ll_ll.b3dm
+  std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testDataPath = testDataPath / "ReplaceTileset";
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  for (const std::string& file :
+       {"tileset.json",
+        "parent.b3dm",
+        "ll.b3dm",
+        "lr.b3dm",
+        "ul.b3dm",
+        "ur.b3dm",
+        "ll_ll.b3dm"}) {
+    mockCompletedRequests.insert(
+        {file,
+         std::make_shared<SimpleAssetRequest>(
+             "GET",
+             file,
+             CesiumAsync::HttpHeaders{},
+             std::make_unique<SimpleAssetResponse>(
+                 static_cast<uint16_t>(200),
+                 "doesn't matter",
+                 CesiumAsync::HttpHeaders{},
+                 readFile(testDataPath / file)))});
+  }
+
+  return TilesetExternals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      AsyncSystem(std::make_shared<SimpleTaskProcessor>()),
+      nullptr};
+}
+
+TEST_CASE("Test LOD transitions only update the tiles that are fading") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals = createReplaceTilesetExternals();
+  TilesetOptions options;
+  options.enableLodTransitionPeriod = true;
+  options.lodTransitionLength = 1.0f;
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile* root = &pTilesetJson->getChildren()[0];
+
+  ViewState viewState = zoomToTileset(tileset);
+  ViewState zoomOutViewState = ViewState::create(
+      viewState.getPosition() - viewState.getDirection() * 2500.0,
+      viewState.getDirection(),
+      viewState.getUp(),
+      viewState.getViewportSize(),
+      viewState.getHorizontalFieldOfView(),
+      viewState.getVerticalFieldOfView());
+
+  const ViewUpdateResult* pResult =
+      &tileset.updateView({zoomOutViewState}, 0.25f);
+  REQUIRE(root->getState() == TileLoadState::Done);
+  REQUIRE(pResult->tilesToRenderThisFrame.size() == 1);
+  REQUIRE(pResult->tilesToRenderThisFrame.front() == root);
+
+  const TileRenderContent* pRenderContent =
+      root->getContent().getRenderContent();
+  REQUIRE(pRenderContent);
+
+  // The root fades in over the transition length, and is reported in the
+  // fading arrays until it is fully visible.
+  float lastPercentage = pRenderContent->getLodTransitionFadePercentage();
+  for (int frame = 0; frame < 3; ++frame) {
+    pResult = &tileset.updateView({zoomOutViewState}, 0.25f);
+    const float percentage = pRenderContent->getLodTransitionFadePercentage();
+    CHECK(percentage > lastPercentage);
+    lastPercentage = percentage;
+
+    if (percentage < 1.0f) {
+      REQUIRE(pResult->fadingInTiles.size() == 1);
+      CHECK(pResult->fadingInTiles.front() == root);
+      REQUIRE(pResult->fadingInPercentages.size() == 1);
+      CHECK(pResult->fadingInPercentages.front() == percentage);
+    }
+  }
+
+  for (int frame = 0; frame < 4; ++frame) {
+    pResult = &tileset.updateView({zoomOutViewState}, 0.25f);
+  }
+  CHECK(pRenderContent->getLodTransitionFadePercentage() == 1.0f);
+  CHECK(pResult->tilesToRenderThisFrame.size() == 1);
+  CHECK(pResult->fadingInTiles.empty());
+  CHECK(pResult->fadingInPercentages.empty());
+  CHECK(pResult->fadingOutTiles.empty());
+  CHECK(pResult->fadingOutPercentages.empty());
+
+  // Zooming in replaces the root with its children, which fade in while the
+  // root fades out.
+  for (int frame = 0; frame < 3; ++frame) {
+    pResult = &tileset.updateView({viewState}, 0.25f);
+  }
+  REQUIRE(pResult->tilesToRenderThisFrame.size() == 4);
+  CHECK(pResult->fadingInTiles.size() == 4);
+  CHECK(
+      pResult->fadingInPercentages.size() == pResult->fadingInTiles.size());
+  REQUIRE(pResult->fadingOutTiles.size() == 1);
+  CHECK(pResult->fadingOutTiles.front() == root);
+  CHECK(pResult->fadingOutPercentages.front() > 0.0f);
+}
+
+TEST_CASE("Test reporting the changes to the render list") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals = createReplaceTilesetExternals();
+  TilesetOptions options;
+  options.reportRenderListChanges = true;
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile* root = &pTilesetJson->getChildren()[0];
+
+  ViewState viewState = zoomToTileset(tileset);
+  ViewState zoomOutViewState = ViewState::create(
+      viewState.getPosition() - viewState.getDirection() * 2500.0,
+      viewState.getDirection(),
+      viewState.getUp(),
+      viewState.getViewportSize(),
+      viewState.getHorizontalFieldOfView(),
+      viewState.getVerticalFieldOfView());
+
+  const ViewUpdateResult* pResult = &tileset.updateView({zoomOutViewState});
+  REQUIRE(pResult->tilesToRenderThisFrame.size() == 1);
+  REQUIRE(pResult->tilesToRenderThisFrame.front() == root);
+
+  // Nothing changes while the view stays the same.
+  pResult = &tileset.updateView({zoomOutViewState});
+  CHECK(pResult->tilesAddedToRenderList.empty());
+  CHECK(pResult->tilesRemovedFromRenderList.empty());
+
+  // The children replace the root once they are loaded.
+  for (int frame = 0; frame < 3; ++frame) {
+    pResult = &tileset.updateView({viewState});
+    if (!pResult->tilesRemovedFromRenderList.empty()) {
+      break;
+    }
+    CHECK(pResult->tilesAddedToRenderList.empty());
+  }
+  REQUIRE(pResult->tilesToRenderThisFrame.size() == 4);
+  CHECK(pResult->tilesAddedToRenderList.size() == 4);
+  for (const Tile* pTile : pResult->tilesAddedToRenderList) {
+    CHECK(pTile->getParent() == root);
+  }
+  REQUIRE(pResult->tilesRemovedFromRenderList.size() == 1);
+  CHECK(pResult->tilesRemovedFromRenderList.front() == root);
+
+  // Zooming out again brings the root back.
+  pResult = &tileset.updateView({zoomOutViewState});
+  REQUIRE(pResult->tilesAddedToRenderList.size() == 1);
+  CHECK(pResult->tilesAddedToRenderList.front() == root);
+  CHECK(pResult->tilesRemovedFromRenderList.size() == 4);
+}
+
+namespace {
+class BatchRecordingPrepareRendererResource
+    : public SimplePrepareRendererResource {
+public:
+  virtual void prepareInMainThreadBatch(
+      gsl::span<Tile* const> tiles,
+      gsl::span<void* const> loadThreadResults,
+      gsl::span<void*> mainThreadResults) override {
+    batchSizes.push_back(tiles.size());
+    SimplePrepareRendererResource::prepareInMainThreadBatch(
+        tiles,
+        loadThreadResults,
+        mainThreadResults);
+  }
+
+  std::vector<size_t> batchSizes;
+};
+} // namespace
+
+TEST_CASE("Test preparing tiles in the main thread in batches") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  std::shared_ptr<BatchRecordingPrepareRendererResource> pRendererResources =
+      std::make_shared<BatchRecordingPrepareRendererResource>();
+  TilesetExternals tilesetExternals = createReplaceTilesetExternals();
+  tilesetExternals.pPrepareRendererResources = pRendererResources;
+
+  TilesetOptions options;
+  options.mainThreadPreparationBatchSize = 2;
+  Tileset tileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(tileset);
+
+  ViewState viewState = zoomToTileset(tileset);
+  const ViewUpdateResult* pResult = nullptr;
+  for (int frame = 0; frame < 5; ++frame) {
+    pResult = &tileset.updateView({viewState});
+  }
+
+  // The root and its four children are rendered, and were prepared two at a
+  // time at most.
+  REQUIRE(pResult->tilesToRenderThisFrame.size() == 4);
+  size_t preparedTiles = 0;
+  size_t largestBatch = 0;
+  for (size_t batchSize : pRendererResources->batchSizes) {
+    CHECK(batchSize > 0);
+    CHECK(batchSize <= 2);
+    preparedTiles += batchSize;
+    largestBatch = std::max(largestBatch, batchSize);
+  }
+  CHECK(preparedTiles == 5);
+  CHECK(largestBatch == 2);
+  for (const Tile* pTile : pResult->tilesToRenderThisFrame) {
+    CHECK(pTile->getState() == TileLoadState::Done);
+  }
+}
+
+TEST_CASE("Test selecting tiles for stereo views with one combined view") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals = createReplaceTilesetExternals();
+  TilesetOptions options;
+  Tileset separateTileset(tilesetExternals, "tileset.json", options);
+  options.combineStereoViews = true;
+  Tileset combinedTileset(tilesetExternals, "tileset.json", options);
+  initializeTileset(separateTileset);
+  initializeTileset(combinedTileset);
+
+  const ViewState viewState = zoomToTileset(combinedTileset);
+  const glm::dvec3 right = glm::normalize(
+      glm::cross(viewState.getDirection(), viewState.getUp()));
+  const auto createEye = [&viewState](const glm::dvec3& offset) {
+    return ViewState::create(
+        viewState.getPosition() + offset,
+        viewState.getDirection(),
+        viewState.getUp(),
+        viewState.getViewportSize(),
+        viewState.getHorizontalFieldOfView(),
+        viewState.getVerticalFieldOfView());
+  };
+  const std::vector<ViewState> eyes{
+      createEye(right * -0.03),
+      createEye(right * 0.03)};
+
+  const ViewUpdateResult* pSeparate = nullptr;
+  const ViewUpdateResult* pCombined = nullptr;
+  for (int frame = 0; frame < 5; ++frame) {
+    pSeparate = &separateTileset.updateView(eyes);
+    pCombined = &combinedTileset.updateView(eyes);
+  }
+
+  REQUIRE(pSeparate->tilesToRenderThisFrame.size() == 4);
+  CHECK(
+      pCombined->tilesToRenderThisFrame.size() ==
+      pSeparate->tilesToRenderThisFrame.size());
+  CHECK(pCombined->tilesVisited == pSeparate->tilesVisited);
+  CHECK(
+      2 * pCombined->screenSpaceErrorEvaluations ==
+      pSeparate->screenSpaceErrorEvaluations);
+}
+
+TEST_CASE("Test selecting loaded tiles for render-only views") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  TilesetExternals tilesetExternals = createReplaceTilesetExternals();
+  Tileset tileset(tilesetExternals, "tileset.json");
+  initializeTileset(tileset);
+
+  const Tile* pTilesetJson = tileset.getRootTile();
+  REQUIRE(pTilesetJson);
+  REQUIRE(pTilesetJson->getChildren().size() == 1);
+  const Tile* root = &pTilesetJson->getChildren()[0];
+
+  ViewState viewState = zoomToTileset(tileset);
+  ViewState zoomOutViewState = ViewState::create(
+      viewState.getPosition() - viewState.getDirection() * 2500.0,
+      viewState.getDirection(),
+      viewState.getUp(),
+      viewState.getViewportSize(),
+      viewState.getHorizontalFieldOfView(),
+      viewState.getVerticalFieldOfView());
+
+  tileset.setRenderOnlyViews({viewState});
+  REQUIRE(tileset.getRenderOnlyViews().size() == 1);
+
+  // The render-only view gets the root, because its children aren't loaded,
+  // and doesn't load them.
+  const ViewUpdateResult* pResult = nullptr;
+  for (int frame = 0; frame < 5; ++frame) {
+    pResult = &tileset.updateView({zoomOutViewState});
+  }
+  REQUIRE(pResult->renderOnlyViewTiles.size() == 1);
+  REQUIRE(pResult->renderOnlyViewTiles[0].size() == 1);
+  CHECK(pResult->renderOnlyViewTiles[0].front() == root);
+  for (const Tile& child : root->getChildren()) {
+    CHECK(child.getState() == TileLoadState::Unloaded);
+  }
+
+  // Once the main view has loaded the children, the render-only view gets
+  // them even after the main view zooms out again.
+  for (int frame = 0; frame < 5; ++frame) {
+    tileset.updateView({viewState});
+  }
+  pResult = &tileset.updateView({zoomOutViewState});
+  REQUIRE(pResult->tilesToRenderThisFrame.size() == 1);
+  CHECK(pResult->tilesToRenderThisFrame.front() == root);
+  REQUIRE(pResult->renderOnlyViewTiles[0].size() == 4);
+  for (const Tile* pTile : pResult->renderOnlyViewTiles[0]) {
+    CHECK(pTile->getParent() == root);
+  }
+
+  tileset.setRenderOnlyViews({});
+  pResult = &tileset.updateView({zoomOutViewState});
+  CHECK(pResult->renderOnlyViewTiles.empty());
+}
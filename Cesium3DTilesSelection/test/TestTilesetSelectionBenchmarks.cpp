@@ -0,0 +1,414 @@
+#include "Cesium3DTilesContent/registerAllTileContentTypes.h"
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTilesSelection/ViewState.h"
+#include "SimplePrepareRendererResource.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+using namespace CesiumNativeTests;
+
+// These benchmarks replay camera paths over large synthetic tilesets, so that
+// changes to the selection algorithm can be compared. They're hidden, so run
+// them explicitly with:
+//
+//   cesium-native-tests "[benchmark]"
+
+namespace {
+// The rectangle covered by the synthetic tilesets, in degrees.
+constexpr double west = -75.65;
+constexpr double south = 39.95;
+constexpr double east = -75.55;
+constexpr double north = 40.05;
+
+// Answers every request for a synthetic tileset, and counts the requests so
+// that the loads of each frame can be reported.
+class SyntheticAssetAccessor : public IAssetAccessor {
+public:
+  explicit SyntheticAssetAccessor(
+      std::function<std::vector<std::byte>(const std::string&)> respond)
+      : _respond(std::move(respond)), _requestCount(0) {}
+
+  Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>&) override {
+    ++this->_requestCount;
+    return asyncSystem.createResolvedFuture<std::shared_ptr<IAssetRequest>>(
+        std::make_shared<SimpleAssetRequest>(
+            "GET",
+            url,
+            HttpHeaders{},
+            std::make_unique<SimpleAssetResponse>(
+                static_cast<uint16_t>(200),
+                "doesn't matter",
+                HttpHeaders{},
+                this->_respond(url))));
+  }
+
+  Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& /* verb */,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>&) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  void tick() noexcept override {}
+
+  size_t getRequestCount() const noexcept { return this->_requestCount; }
+
+private:
+  std::function<std::vector<std::byte>(const std::string&)> _respond;
+  size_t _requestCount;
+};
+
+struct SyntheticTileset {
+  std::string name;
+  std::string url;
+  std::function<std::vector<std::byte>(const std::string&)> respond;
+};
+
+std::vector<std::byte> toBytes(const std::string& text) {
+  const std::byte* pBegin = reinterpret_cast<const std::byte*>(text.data());
+  return std::vector<std::byte>(pBegin, pBegin + text.size());
+}
+
+bool endsWith(const std::string& url, const std::string& suffix) {
+  return url.size() >= suffix.size() &&
+         url.compare(url.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+std::string createRegion(
+    double westDegrees,
+    double southDegrees,
+    double eastDegrees,
+    double northDegrees,
+    double minimumHeight,
+    double maximumHeight) {
+  std::ostringstream region;
+  region << std::setprecision(17) << "[" << Math::degreesToRadians(westDegrees)
+         << "," << Math::degreesToRadians(southDegrees) << ","
+         << Math::degreesToRadians(eastDegrees) << ","
+         << Math::degreesToRadians(northDegrees) << "," << minimumHeight << ","
+         << maximumHeight << "]";
+  return region.str();
+}
+
+void appendExplicitTile(
+    std::string& json,
+    uint32_t level,
+    uint32_t x,
+    uint32_t y,
+    uint32_t maximumLevel) {
+  const double tilesAtLevel = double(1U << level);
+  const double width = (east - west) / tilesAtLevel;
+  const double height = (north - south) / tilesAtLevel;
+  const double tileWest = west + width * double(x);
+  const double tileSouth = south + height * double(y);
+  const double geometricError =
+      level == maximumLevel ? 0.0 : 2000.0 / tilesAtLevel;
+
+  json += R"({"boundingVolume":{"region":)";
+  json += createRegion(
+      tileWest,
+      tileSouth,
+      tileWest + width,
+      tileSouth + height,
+      0.0,
+      100.0);
+  json += R"(},"geometricError":)" + std::to_string(geometricError);
+  json += R"(,"refine":"REPLACE","content":{"uri":"content/)" +
+          std::to_string(level) + "." + std::to_string(x) + "." +
+          std::to_string(y) + R"(.b3dm"})";
+
+  if (level < maximumLevel) {
+    json += R"(,"children":[)";
+    for (uint32_t i = 0; i < 4; ++i) {
+      if (i > 0) {
+        json += ",";
+      }
+      appendExplicitTile(
+          json,
+          level + 1,
+          2 * x + (i & 1),
+          2 * y + (i >> 1),
+          maximumLevel);
+    }
+    json += "]";
+  }
+
+  json += "}";
+}
+
+std::vector<std::byte> readTestData(const std::filesystem::path& path) {
+  return readFile(
+      std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) / path);
+}
+
+SyntheticTileset createExplicitTileset() {
+  // A full quadtree of 21845 tiles in a single tileset.json.
+  std::string json = R"({"asset":{"version":"1.0"},"geometricError":4000,)";
+  json += R"("root":)";
+  appendExplicitTile(json, 0, 0, 0, 7);
+  json += "}";
+
+  std::vector<std::byte> tilesetJson = toBytes(json);
+  std::vector<std::byte> content = readTestData("ReplaceTileset/ll.b3dm");
+  return SyntheticTileset{
+      "explicit quadtree",
+      "tileset.json",
+      [tilesetJson, content](const std::string& url) {
+        return url == "tileset.json" ? tilesetJson : content;
+      }};
+}
+
+SyntheticTileset createImplicitTileset(bool octree) {
+  const std::string coordinates =
+      octree ? "{level}.{x}.{y}.{z}" : "{level}.{x}.{y}";
+  std::string json = R"({"asset":{"version":"1.1"},"geometricError":4000,)";
+  json += R"("root":{"boundingVolume":{"region":)";
+  json += createRegion(west, south, east, north, 0.0, octree ? 1000.0 : 100.0);
+  json += R"(},"geometricError":2000,"refine":"REPLACE",)";
+  json += R"("content":{"uri":"content/)" + coordinates + R"(.b3dm"},)";
+  json += R"("implicitTiling":{"subdivisionScheme":")";
+  json += octree ? "OCTREE" : "QUADTREE";
+  json += R"(","subtreeLevels":3,"availableLevels":)";
+  json += octree ? "6" : "9";
+  json += R"(,"subtrees":{"uri":"subtrees/)" + coordinates + R"(.json"}}}})";
+
+  std::vector<std::byte> tilesetJson = toBytes(json);
+  std::vector<std::byte> subtreeJson = toBytes(R"({
+    "tileAvailability": {"constant": 1},
+    "contentAvailability": [{"constant": 1}],
+    "childSubtreeAvailability": {"constant": 1}
+  })");
+  std::vector<std::byte> content = readTestData("ReplaceTileset/ll.b3dm");
+  return SyntheticTileset{
+      octree ? "implicit octree" : "implicit quadtree",
+      "tileset.json",
+      [tilesetJson, subtreeJson, content](const std::string& url) {
+        if (url == "tileset.json") {
+          return tilesetJson;
+        }
+        return endsWith(url, ".json") ? subtreeJson : content;
+      }};
+}
+
+SyntheticTileset createLayerJsonTileset() {
+  // Every tile of the geographic tiling scheme is available down to level 16.
+  std::string json = R"({"tilejson":"2.1.0","format":"quantized-mesh-1.0",)";
+  json += R"("version":"1.0.0","scheme":"tms",)";
+  json += R"("tiles":["{z}/{x}/{y}.terrain?v={version}"],"available":[)";
+  for (uint32_t level = 0; level <= 16; ++level) {
+    if (level > 0) {
+      json += ",";
+    }
+    json += R"([{"startX":0,"startY":0,"endX":)" +
+            std::to_string((2U << level) - 1) +
+            R"(,"endY":)" + std::to_string((1U << level) - 1) + "}]";
+  }
+  json += "]}";
+
+  std::vector<std::byte> layerJson = toBytes(json);
+  std::vector<std::byte> content =
+      readTestData("CesiumTerrainTileJson/tile.terrain");
+  return SyntheticTileset{
+      "layer.json",
+      "layer.json",
+      [layerJson, content](const std::string& url) {
+        return url == "layer.json" ? layerJson : content;
+      }};
+}
+
+// A keyframe of a camera path. The camera moves linearly from each keyframe
+// to the next over the given number of frames.
+struct CameraKeyframe {
+  double longitude;
+  double latitude;
+  double height;
+  double heading;
+  double pitch;
+  uint32_t frames;
+};
+
+struct CameraPath {
+  std::string name;
+  std::vector<CameraKeyframe> keyframes;
+};
+
+// Camera paths recorded as keyframes, in degrees and meters.
+std::vector<CameraPath> createCameraPaths() {
+  return {
+      {"flyover",
+       {{-75.64, 39.96, 400.0, 45.0, -20.0, 60},
+        {-75.56, 40.04, 400.0, 45.0, -20.0, 30},
+        {-75.56, 40.04, 400.0, 225.0, -20.0, 0}}},
+      {"descent",
+       {{-75.60, 39.90, 20000.0, 0.0, -70.0, 60},
+        {-75.60, 39.99, 1000.0, 30.0, -40.0, 30},
+        {-75.59, 40.00, 150.0, 90.0, -15.0, 0}}}};
+}
+
+ViewState createViewState(const CameraKeyframe& keyframe) {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  const glm::dvec3 position =
+      ellipsoid.cartographicToCartesian(Cartographic::fromDegrees(
+          keyframe.longitude,
+          keyframe.latitude,
+          keyframe.height));
+
+  const glm::dvec3 up = ellipsoid.geodeticSurfaceNormal(position);
+  const glm::dvec3 localEast =
+      glm::normalize(glm::cross(glm::dvec3(0.0, 0.0, 1.0), up));
+  const glm::dvec3 localNorth = glm::cross(up, localEast);
+
+  const double heading = Math::degreesToRadians(keyframe.heading);
+  const double pitch = Math::degreesToRadians(keyframe.pitch);
+  const glm::dvec3 direction =
+      std::cos(pitch) * (std::cos(heading) * localNorth +
+                         std::sin(heading) * localEast) +
+      std::sin(pitch) * up;
+  const glm::dvec3 right = glm::normalize(glm::cross(direction, up));
+
+  const glm::dvec2 viewportSize{1920.0, 1080.0};
+  const double horizontalFieldOfView = Math::degreesToRadians(60.0);
+  const double verticalFieldOfView =
+      std::atan(
+          std::tan(horizontalFieldOfView * 0.5) * viewportSize.y /
+          viewportSize.x) *
+      2.0;
+  return ViewState::create(
+      position,
+      direction,
+      glm::cross(right, direction),
+      viewportSize,
+      horizontalFieldOfView,
+      verticalFieldOfView);
+}
+
+std::vector<ViewState> createFrames(const CameraPath& path) {
+  std::vector<ViewState> frames;
+  for (size_t i = 0; i + 1 < path.keyframes.size(); ++i) {
+    const CameraKeyframe& from = path.keyframes[i];
+    const CameraKeyframe& to = path.keyframes[i + 1];
+    for (uint32_t frame = 0; frame < from.frames; ++frame) {
+      const double t = double(frame) / double(from.frames);
+      frames.emplace_back(createViewState(CameraKeyframe{
+          Math::lerp(from.longitude, to.longitude, t),
+          Math::lerp(from.latitude, to.latitude, t),
+          Math::lerp(from.height, to.height, t),
+          Math::lerp(from.heading, to.heading, t),
+          Math::lerp(from.pitch, to.pitch, t),
+          0}));
+    }
+  }
+  frames.emplace_back(createViewState(path.keyframes.back()));
+  return frames;
+}
+
+struct PathStatistics {
+  double totalTraversalTime = 0.0;
+  double maximumTraversalTime = 0.0;
+  uint64_t tilesVisited = 0;
+  uint64_t tilesRendered = 0;
+  size_t loadsRequested = 0;
+};
+
+PathStatistics replayPath(
+    Tileset& tileset,
+    const SyntheticAssetAccessor& accessor,
+    const std::vector<ViewState>& frames) {
+  PathStatistics statistics;
+  const size_t requestsBefore = accessor.getRequestCount();
+  for (const ViewState& frame : frames) {
+    const ViewUpdateResult& result = tileset.updateView({frame}, 1.0f / 60.0f);
+    statistics.totalTraversalTime += result.traversalTime;
+    statistics.maximumTraversalTime =
+        std::max(statistics.maximumTraversalTime, result.traversalTime);
+    statistics.tilesVisited += result.tilesVisited;
+    statistics.tilesRendered += result.tilesToRenderThisFrame.size();
+  }
+  statistics.loadsRequested = accessor.getRequestCount() - requestsBefore;
+  return statistics;
+}
+} // namespace
+
+TEST_CASE("Benchmark tile selection along camera paths", "[.][benchmark]") {
+  Cesium3DTilesContent::registerAllTileContentTypes();
+
+  const SyntheticTileset synthetic = GENERATE(
+      createExplicitTileset(),
+      createImplicitTileset(false),
+      createImplicitTileset(true),
+      createLayerJsonTileset());
+  const CameraPath path = GENERATE(from_range(createCameraPaths()));
+  const std::vector<ViewState> frames = createFrames(path);
+
+  std::shared_ptr<SyntheticAssetAccessor> pAccessor =
+      std::make_shared<SyntheticAssetAccessor>(synthetic.respond);
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+  TilesetExternals externals{
+      pAccessor,
+      std::make_shared<SimplePrepareRendererResource>(),
+      asyncSystem,
+      nullptr};
+
+  TilesetOptions options;
+  options.measureViewUpdateTimes = true;
+  Tileset tileset(externals, synthetic.url, options);
+  while (!tileset.getRootTileAvailableEvent().isReady()) {
+    asyncSystem.dispatchMainThreadTasks();
+  }
+  REQUIRE(tileset.getRootTile() != nullptr);
+
+  // Loading the tiles along the path the first time reports the loads.
+  const PathStatistics loading = replayPath(tileset, *pAccessor, frames);
+  CHECK(loading.tilesVisited > 0);
+  CHECK(loading.tilesRendered > 0);
+  CHECK(loading.loadsRequested > 0);
+
+  // Replaying it once everything is loaded measures the traversal alone.
+  const PathStatistics loaded = replayPath(tileset, *pAccessor, frames);
+  const double frameCount = double(frames.size());
+  WARN(
+      synthetic.name
+      << ", " << path.name << ": " << frames.size()
+      << " frames, mean traversal time "
+      << loaded.totalTraversalTime / frameCount << " ms, maximum "
+      << loaded.maximumTraversalTime << " ms, "
+      << double(loaded.tilesVisited) / frameCount
+      << " tiles visited per frame, " << loading.loadsRequested
+      << " loads requested while loading");
+
+  BENCHMARK(synthetic.name + ", " + path.name) {
+    return replayPath(tileset, *pAccessor, frames).tilesVisited;
+  };
+}
@@ -0,0 +1,273 @@
+#include "SimplePrepareRendererResource.h"
+#include "TilesetJsonLoader.h"
+#include "TilesetSkeleton.h"
+
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+#include <CesiumUtility/CreditSystem.h>
+
+#include <catch2/catch.hpp>
+#include <rapidjson/document.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumNativeTests;
+using namespace CesiumUtility;
+
+namespace {
+std::filesystem::path testDataPath = Cesium3DTilesSelection_TEST_DATA_DIR;
+
+const std::string tilesetUrl = "https://example.com/tileset.json";
+
+class MockCacheDatabase : public ICacheDatabase {
+public:
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override {
+    auto it = this->entries.find(key);
+    if (it == this->entries.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    this->entries.insert_or_assign(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(
+                HttpHeaders(requestHeaders),
+                std::string(requestMethod),
+                std::string(url)),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    return true;
+  }
+
+  virtual bool prune() override { return true; }
+
+  virtual bool clearAll() override {
+    this->entries.clear();
+    return true;
+  }
+
+  std::map<std::string, CacheItem> entries;
+};
+
+rapidjson::Document parseJson(const std::vector<std::byte>& data) {
+  rapidjson::Document json;
+  json.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  REQUIRE(!json.HasParseError());
+  return json;
+}
+
+void checkTilesAreEqual(const Tile& expected, const Tile& actual) {
+  CHECK(expected.getTileID() == actual.getTileID());
+  CHECK(expected.isEmptyContent() == actual.isEmptyContent());
+  CHECK(expected.getTransform() == actual.getTransform());
+  CHECK(expected.getGeometricError() == actual.getGeometricError());
+  CHECK(expected.getRefine() == actual.getRefine());
+  CHECK(
+      expected.getBoundingVolume().index() ==
+      actual.getBoundingVolume().index());
+  CHECK(
+      getBoundingVolumeCenter(expected.getBoundingVolume()) ==
+      getBoundingVolumeCenter(actual.getBoundingVolume()));
+  CHECK(
+      expected.getViewerRequestVolume().has_value() ==
+      actual.getViewerRequestVolume().has_value());
+  CHECK(
+      expected.getContentBoundingVolume().has_value() ==
+      actual.getContentBoundingVolume().has_value());
+
+  REQUIRE(expected.getChildren().size() == actual.getChildren().size());
+  for (size_t i = 0; i < expected.getChildren().size(); ++i) {
+    CHECK(actual.getChildren()[i].getParent() == &actual);
+    checkTilesAreEqual(expected.getChildren()[i], actual.getChildren()[i]);
+  }
+}
+
+TilesetContentLoaderResult<TilesetJsonLoader> loadTileset(
+    const std::shared_ptr<ICacheDatabase>& pCache,
+    const std::string& etag,
+    std::vector<std::byte>&& tilesetContent) {
+  HttpHeaders responseHeaders;
+  if (!etag.empty()) {
+    responseHeaders.emplace("ETag", etag);
+  }
+
+  auto pMockCompletedRequest = std::make_shared<SimpleAssetRequest>(
+      "GET",
+      tilesetUrl,
+      HttpHeaders{},
+      std::make_unique<SimpleAssetResponse>(
+          static_cast<uint16_t>(200),
+          "application/json",
+          responseHeaders,
+          std::move(tilesetContent)));
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockCompletedRequests;
+  mockCompletedRequests.insert({tilesetUrl, std::move(pMockCompletedRequest)});
+
+  AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+  TilesetExternals externals{
+      std::make_shared<SimpleAssetAccessor>(std::move(mockCompletedRequests)),
+      std::make_shared<SimplePrepareRendererResource>(),
+      asyncSystem,
+      std::make_shared<CreditSystem>()};
+  externals.pTilesetSkeletonCache = pCache;
+
+  auto loaderResultFuture =
+      TilesetJsonLoader::createLoader(externals, tilesetUrl, {});
+  asyncSystem.dispatchMainThreadTasks();
+  return loaderResultFuture.wait();
+}
+} // namespace
+
+TEST_CASE("Test writing and reading tileset skeletons") {
+  const std::string tilesetName = GENERATE(
+      "AddTileset",
+      "ReplaceTileset",
+      "Tileset",
+      "MultipleKindsOfTilesets/BoxBoundingVolumeTileset.json",
+      "MultipleKindsOfTilesets/SphereBoundingVolumeTileset.json");
+  std::filesystem::path tilesetPath = testDataPath / tilesetName;
+  if (tilesetPath.extension() != ".json") {
+    tilesetPath /= "tileset.json";
+  }
+
+  const rapidjson::Document tilesetJson = parseJson(readFile(tilesetPath));
+  TilesetContentLoaderResult<TilesetJsonLoader> loaderResult =
+      TilesetJsonLoader::createLoader(
+          spdlog::default_logger(),
+          tilesetUrl,
+          tilesetJson);
+  REQUIRE(loaderResult.pRootTile);
+  REQUIRE(loaderResult.pRootTile->getChildren().size() == 1);
+  const Tile& rootTile = loaderResult.pRootTile->getChildren()[0];
+
+  std::optional<std::vector<std::byte>> data =
+      writeTilesetSkeleton(tilesetJson, rootTile, *loaderResult.pLoader);
+  REQUIRE(data);
+
+  SECTION("The skeleton holds the tiles and the JSON without its root") {
+    std::optional<TilesetSkeleton> skeleton = readTilesetSkeleton(*data);
+    REQUIRE(skeleton);
+    CHECK(!skeleton->tilesetJson.HasMember("root"));
+    CHECK(skeleton->tilesetJson.HasMember("asset"));
+
+    TileUrlPool urlPool;
+    std::optional<Tile> tile = createTilesFromSkeleton(
+        skeleton->tiles,
+        *loaderResult.pLoader,
+        urlPool);
+    REQUIRE(tile);
+    CHECK(tile->getLoader() == loaderResult.pLoader.get());
+    checkTilesAreEqual(rootTile, *tile);
+  }
+
+  SECTION("A truncated skeleton is rejected") {
+    data->resize(data->size() - 1);
+    std::optional<TilesetSkeleton> skeleton = readTilesetSkeleton(*data);
+    REQUIRE(skeleton);
+    TileUrlPool urlPool;
+    CHECK(!createTilesFromSkeleton(
+        skeleton->tiles,
+        *loaderResult.pLoader,
+        urlPool));
+
+    data->resize(6);
+    CHECK(!readTilesetSkeleton(*data));
+  }
+}
+
+TEST_CASE("Test that implicit tilesets have no skeleton") {
+  const rapidjson::Document tilesetJson = parseJson(readFile(
+      testDataPath / "MultipleKindsOfTilesets" /
+      "QuadtreeImplicitTileset.json"));
+  TilesetContentLoaderResult<TilesetJsonLoader> loaderResult =
+      TilesetJsonLoader::createLoader(
+          spdlog::default_logger(),
+          tilesetUrl,
+          tilesetJson);
+  REQUIRE(loaderResult.pRootTile);
+  REQUIRE(loaderResult.pRootTile->getChildren().size() == 1);
+
+  CHECK(!writeTilesetSkeleton(
+      tilesetJson,
+      loaderResult.pRootTile->getChildren()[0],
+      *loaderResult.pLoader));
+}
+
+TEST_CASE("Test loading a tileset from its cached skeleton") {
+  std::shared_ptr<MockCacheDatabase> pCache =
+      std::make_shared<MockCacheDatabase>();
+  const std::filesystem::path tilesetPath =
+      testDataPath / "WithMetadata" / "tileset.json";
+
+  TilesetContentLoaderResult<TilesetJsonLoader> parsedResult =
+      loadTileset(pCache, "\"v1\"", readFile(tilesetPath));
+  REQUIRE(!parsedResult.errors.hasErrors());
+  REQUIRE(parsedResult.pRootTile);
+  REQUIRE(pCache->entries.size() == 1);
+
+  // The JSON is not parsed again while the ETag is the same.
+  const std::string invalidJson = "not a tileset";
+  std::vector<std::byte> invalidContent(
+      reinterpret_cast<const std::byte*>(invalidJson.data()),
+      reinterpret_cast<const std::byte*>(invalidJson.data()) +
+          invalidJson.size());
+
+  SECTION("A response with the same ETag uses the skeleton") {
+    TilesetContentLoaderResult<TilesetJsonLoader> cachedResult =
+        loadTileset(pCache, "\"v1\"", std::move(invalidContent));
+    REQUIRE(!cachedResult.errors.hasErrors());
+    REQUIRE(cachedResult.pRootTile);
+    CHECK(cachedResult.pLoader->getBaseUrl() == tilesetUrl);
+    checkTilesAreEqual(*parsedResult.pRootTile, *cachedResult.pRootTile);
+
+    TileExternalContent* pExternal =
+        cachedResult.pRootTile->getContent().getExternalContent();
+    REQUIRE(pExternal);
+    REQUIRE(pExternal->metadata.schema);
+    CHECK(pExternal->metadata.schema->id == "foo");
+  }
+
+  SECTION("A response with another ETag is parsed") {
+    TilesetContentLoaderResult<TilesetJsonLoader> cachedResult =
+        loadTileset(pCache, "\"v2\"", std::move(invalidContent));
+    CHECK(cachedResult.errors.hasErrors());
+  }
+
+  SECTION("A response without an ETag is parsed and not cached") {
+    pCache->entries.clear();
+    TilesetContentLoaderResult<TilesetJsonLoader> result =
+        loadTileset(pCache, "", readFile(tilesetPath));
+    CHECK(!result.errors.hasErrors());
+    CHECK(pCache->entries.empty());
+  }
+}
@@ -0,0 +1,151 @@
+#include "UpsampledModelCache.h"
+
+#include <CesiumGltf/AccessorView.h>
+
+#include <catch2/catch.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGltf;
+
+namespace {
+// A quad that covers the whole parent tile.
+Model createParentModel() {
+  const std::vector<glm::vec3> positions{
+      glm::vec3(0.0f, 0.0f, 0.0f),
+      glm::vec3(1.0f, 0.0f, 0.0f),
+      glm::vec3(0.0f, 1.0f, 0.0f),
+      glm::vec3(1.0f, 1.0f, 0.0f)};
+  const std::vector<glm::vec2> uvs{
+      glm::vec2(0.0f, 0.0f),
+      glm::vec2(1.0f, 0.0f),
+      glm::vec2(0.0f, 1.0f),
+      glm::vec2(1.0f, 1.0f)};
+  const std::vector<uint32_t> indices{0, 1, 2, 1, 3, 2};
+
+  Model model;
+  Buffer& buffer = model.buffers.emplace_back();
+  const size_t positionsSize = positions.size() * sizeof(glm::vec3);
+  const size_t uvsSize = uvs.size() * sizeof(glm::vec2);
+  const size_t indicesSize = indices.size() * sizeof(uint32_t);
+  buffer.cesium.data.resize(positionsSize + uvsSize + indicesSize);
+  std::memcpy(buffer.cesium.data.data(), positions.data(), positionsSize);
+  std::memcpy(buffer.cesium.data.data() + positionsSize, uvs.data(), uvsSize);
+  std::memcpy(
+      buffer.cesium.data.data() + positionsSize + uvsSize,
+      indices.data(),
+      indicesSize);
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+  const auto addAccessor = [&model](
+                               size_t offset,
+                               size_t size,
+                               int64_t count,
+                               int32_t componentType,
+                               const std::string& type) {
+    BufferView& bufferView = model.bufferViews.emplace_back();
+    bufferView.buffer = 0;
+    bufferView.byteOffset = int64_t(offset);
+    bufferView.byteLength = int64_t(size);
+
+    Accessor& accessor = model.accessors.emplace_back();
+    accessor.bufferView = int32_t(model.bufferViews.size() - 1);
+    accessor.count = count;
+    accessor.componentType = componentType;
+    accessor.type = type;
+    return int32_t(model.accessors.size() - 1);
+  };
+
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = addAccessor(
+      0,
+      positionsSize,
+      int64_t(positions.size()),
+      Accessor::ComponentType::FLOAT,
+      Accessor::Type::VEC3);
+  primitive.attributes["_CESIUMOVERLAY_0"] = addAccessor(
+      positionsSize,
+      uvsSize,
+      int64_t(uvs.size()),
+      Accessor::ComponentType::FLOAT,
+      Accessor::Type::VEC2);
+  primitive.indices = addAccessor(
+      positionsSize + uvsSize,
+      indicesSize,
+      int64_t(indices.size()),
+      Accessor::ComponentType::UNSIGNED_INT,
+      Accessor::Type::SCALAR);
+  model.nodes.emplace_back().mesh = 0;
+  return model;
+}
+} // namespace
+
+TEST_CASE("UpsampledModelCache") {
+  Model parentModel = createParentModel();
+  const QuadtreeTileID southWest(1, 0, 0);
+  const QuadtreeTileID northEast(1, 1, 1);
+
+  SECTION("doesn't keep models by default") {
+    UpsampledModelCache cache;
+    std::optional<Model> model =
+        cache.upsample(nullptr, parentModel, southWest, 0);
+    REQUIRE(model);
+    CHECK(!model->meshes[0].primitives.empty());
+    CHECK(cache.size() == 0);
+  }
+
+  SECTION("copies the model upsampled for the same child") {
+    UpsampledModelCache cache(2);
+    std::optional<Model> first =
+        cache.upsample(nullptr, parentModel, southWest, 0);
+    std::optional<Model> second =
+        cache.upsample(nullptr, parentModel, southWest, 0);
+    REQUIRE(first);
+    REQUIRE(second);
+    CHECK(cache.size() == 1);
+    REQUIRE(first->buffers.size() == second->buffers.size());
+    for (size_t i = 0; i < first->buffers.size(); ++i) {
+      CHECK(first->buffers[i].cesium.data == second->buffers[i].cesium.data);
+    }
+
+    // Other children, or the same child of a parent with other content, are
+    // upsampled again.
+    CHECK(cache.upsample(nullptr, parentModel, northEast, 0));
+    CHECK(cache.size() == 2);
+
+    const glm::vec3 moved(0.0f, 0.0f, 10.0f);
+    std::memcpy(
+        parentModel.buffers[0].cesium.data.data(),
+        &moved,
+        sizeof(glm::vec3));
+    std::optional<Model> third =
+        cache.upsample(nullptr, parentModel, southWest, 0);
+    REQUIRE(third);
+    AccessorView<glm::vec3> firstPositions(
+        *first,
+        first->meshes[0].primitives[0].attributes.at("POSITION"));
+    AccessorView<glm::vec3> thirdPositions(
+        *third,
+        third->meshes[0].primitives[0].attributes.at("POSITION"));
+    REQUIRE(firstPositions.size() == thirdPositions.size());
+    bool moves = false;
+    for (int64_t i = 0; i < thirdPositions.size(); ++i) {
+      moves = moves || thirdPositions[i].z != firstPositions[i].z;
+    }
+    CHECK(moves);
+
+    // The least recently used model was removed.
+    CHECK(cache.size() == 2);
+
+    cache.setMaximumModels(0);
+    CHECK(cache.size() == 0);
+  }
+}
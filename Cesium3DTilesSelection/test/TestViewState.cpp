@@ -0,0 +1,179 @@
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeometry/BatchCulling.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace {
+ViewState createViewState() {
+  return ViewState::create(
+      glm::dvec3(0.0),
+      glm::dvec3(1.0, 0.0, 0.0),
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(100.0, 100.0),
+      Math::PiOverTwo,
+      Math::PiOverTwo);
+}
+
+bool isAnyVisibleOneByOne(
+    const ViewState& viewState,
+    const std::vector<BoundingVolume>& boundingVolumes) {
+  return std::any_of(
+      boundingVolumes.begin(),
+      boundingVolumes.end(),
+      [&viewState](const BoundingVolume& boundingVolume) {
+        return viewState.isBoundingVolumeVisible(boundingVolume);
+      });
+}
+
+std::vector<const BoundingVolume*>
+getPointers(const std::vector<BoundingVolume>& boundingVolumes) {
+  std::vector<const BoundingVolume*> result;
+  for (const BoundingVolume& boundingVolume : boundingVolumes) {
+    result.emplace_back(&boundingVolume);
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("ViewState::isAnyBoundingVolumeVisible") {
+  const ViewState viewState = createViewState();
+
+  // More volumes of each kind than fit in a single batch, all behind the
+  // camera.
+  std::vector<BoundingVolume> boundingVolumes;
+  const size_t count = 2 * BatchCulling::LaneCount + 1;
+  for (size_t i = 0; i < count; ++i) {
+    const double offset = double(i);
+    boundingVolumes.emplace_back(OrientedBoundingBox(
+        glm::dvec3(-10.0 - offset, offset, 0.0),
+        glm::dmat3(1.0)));
+    boundingVolumes.emplace_back(
+        BoundingSphere(glm::dvec3(-10.0 - offset, 0.0, offset), 1.0));
+  }
+
+  SECTION("returns false when no volume is visible") {
+    CHECK(!isAnyVisibleOneByOne(viewState, boundingVolumes));
+    CHECK(!viewState.isAnyBoundingVolumeVisible(getPointers(boundingVolumes)));
+  }
+
+  SECTION("finds a visible box in a later batch") {
+    boundingVolumes.emplace_back(
+        OrientedBoundingBox(glm::dvec3(10.0, 0.0, 0.0), glm::dmat3(1.0)));
+    CHECK(isAnyVisibleOneByOne(viewState, boundingVolumes));
+    CHECK(viewState.isAnyBoundingVolumeVisible(getPointers(boundingVolumes)));
+  }
+
+  SECTION("finds a visible sphere in a partial batch") {
+    boundingVolumes.emplace_back(
+        BoundingSphere(glm::dvec3(10.0, 0.0, 0.0), 1.0));
+    CHECK(isAnyVisibleOneByOne(viewState, boundingVolumes));
+    CHECK(viewState.isAnyBoundingVolumeVisible(getPointers(boundingVolumes)));
+  }
+
+  SECTION("agrees with the per-volume test for other volumes") {
+    boundingVolumes.emplace_back(S2CellBoundingVolume(
+        S2CellID::fromQuadtreeTileID(1, QuadtreeTileID(10, 1, 2)),
+        100.0,
+        200.0));
+    CHECK(
+        viewState.isAnyBoundingVolumeVisible(getPointers(boundingVolumes)) ==
+        isAnyVisibleOneByOne(viewState, boundingVolumes));
+  }
+
+  SECTION("culls contiguous boxes and spheres") {
+    std::vector<OrientedBoundingBox> boxes;
+    std::vector<BoundingSphere> spheres;
+    for (size_t i = 0; i < count; ++i) {
+      const double offset = double(i);
+      boxes.emplace_back(
+          glm::dvec3(-10.0 - offset, offset, 0.0),
+          glm::dmat3(1.0));
+      spheres.emplace_back(glm::dvec3(-10.0 - offset, 0.0, offset), 1.0);
+    }
+    CHECK(!viewState.isAnyBoundingVolumeVisible(boxes));
+    CHECK(!viewState.isAnyBoundingVolumeVisible(spheres));
+
+    boxes.emplace_back(glm::dvec3(10.0, 0.0, 0.0), glm::dmat3(1.0));
+    spheres.emplace_back(glm::dvec3(10.0, 0.0, 0.0), 1.0);
+    CHECK(viewState.isAnyBoundingVolumeVisible(boxes));
+    CHECK(viewState.isAnyBoundingVolumeVisible(spheres));
+  }
+}
+
+TEST_CASE("ViewState::isBoundingVolumeVisible with a box and a sphere") {
+  const ViewState viewState = createViewState();
+
+  // Long, thin boxes around the edges of the frustum, whose spheres are
+  // often visible when the boxes themselves are not.
+  size_t visibleCount = 0;
+  size_t culledByBoxCount = 0;
+  for (double y = -20.0; y <= 20.0; y += 1.5) {
+    for (double x = -5.0; x <= 15.0; x += 2.5) {
+      const OrientedBoundingBox box(
+          glm::dvec3(x, y, 0.5 * y),
+          glm::dmat3(
+              glm::dvec3(3.0, 3.0, 0.0),
+              glm::dvec3(0.1, -0.1, 0.0),
+              glm::dvec3(0.0, 0.0, 0.1)));
+      const BoundingSphere sphere = box.toSphere();
+
+      const bool expected = viewState.isBoundingVolumeVisible(box);
+      CHECK(viewState.isBoundingVolumeVisible(box, sphere) == expected);
+
+      if (expected) {
+        ++visibleCount;
+      } else if (viewState.isBoundingVolumeVisible(sphere)) {
+        ++culledByBoxCount;
+      }
+    }
+  }
+
+  CHECK(visibleCount > 0);
+  CHECK(culledByBoxCount > 0);
+}
+
+TEST_CASE("ViewState::computeDistanceSquaredToBoundingVolume for regions") {
+  const BoundingRegion region(
+      GlobeRectangle::fromDegrees(10.0, 20.0, 11.0, 21.0),
+      100.0,
+      500.0);
+
+  // Above, beside, and below the region, and at the center of the ellipsoid.
+  const std::vector<glm::dvec3> positions{
+      Ellipsoid::WGS84.cartographicToCartesian(
+          Cartographic::fromDegrees(10.5, 20.5, 2000.0)),
+      Ellipsoid::WGS84.cartographicToCartesian(
+          Cartographic::fromDegrees(12.0, 19.5, 300.0)),
+      Ellipsoid::WGS84.cartographicToCartesian(
+          Cartographic::fromDegrees(10.2, 22.0, -50.0)),
+      glm::dvec3(0.0)};
+
+  for (const glm::dvec3& position : positions) {
+    const ViewState viewState = ViewState::create(
+        position,
+        glm::dvec3(1.0, 0.0, 0.0),
+        glm::dvec3(0.0, 0.0, 1.0),
+        glm::dvec2(100.0, 100.0),
+        Math::PiOverTwo,
+        Math::PiOverTwo);
+
+    const double expected = region.computeDistanceSquaredToPosition(position);
+    CHECK(
+        viewState.computeDistanceSquaredToBoundingVolume(region) ==
+        Approx(expected));
+    CHECK(
+        viewState.computeDistanceSquaredToBoundingVolume(
+            BoundingRegionWithLooseFittingHeights(region)) ==
+        Approx(expected));
+  }
+}
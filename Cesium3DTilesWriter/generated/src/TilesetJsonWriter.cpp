@@ -206,6 +206,29 @@ template <typename T>
   jsonWriter.Int64(val);
 }
 
+// Arrays of numbers are written in one call, which is faster than writing
+// each number.
+[[maybe_unused]] void writeJson(
+    const std::vector<double>& list,
+    CesiumJsonWriter::JsonWriter& jsonWriter,
+    const CesiumJsonWriter::ExtensionWriterContext& /* context */) {
+  jsonWriter.PrimitiveArray(list);
+}
+
+[[maybe_unused]] void writeJson(
+    const std::vector<int64_t>& list,
+    CesiumJsonWriter::JsonWriter& jsonWriter,
+    const CesiumJsonWriter::ExtensionWriterContext& /* context */) {
+  jsonWriter.PrimitiveArray(list);
+}
+
+[[maybe_unused]] void writeJson(
+    const std::vector<int32_t>& list,
+    CesiumJsonWriter::JsonWriter& jsonWriter,
+    const CesiumJsonWriter::ExtensionWriterContext& /* context */) {
+  jsonWriter.PrimitiveArray(list);
+}
+
 [[maybe_unused]] void writeJson(
     const CesiumUtility::JsonValue::Object& obj,
     CesiumJsonWriter::JsonWriter& jsonWriter,
@@ -3,6 +3,7 @@
 #include "Cesium3DTilesWriter/Library.h"
 
 #include <CesiumJsonWriter/ExtensionWriterContext.h>
+#include <CesiumJsonWriter/ReusableJsonWriter.h>
 
 // forward declarations
 namespace Cesium3DTiles {
@@ -40,6 +41,15 @@ struct CESIUM3DTILESWRITER_API TilesetWriterOptions {
    * @brief If the tileset JSON should be pretty printed.
    */
   bool prettyPrint = false;
+
+  /**
+   * @brief The writer to write the JSON with, so that its memory is reused
+   * from one tileset to the next. If nullptr, a new writer is created for each
+   * tileset.
+   *
+   * The writer must not be used by another thread at the same time.
+   */
+  CesiumJsonWriter::ReusableJsonWriter* pJsonWriter = nullptr;
 };
 
 /**
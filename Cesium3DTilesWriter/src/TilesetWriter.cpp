@@ -29,18 +29,24 @@ TilesetWriterResult TilesetWriter::writeTileset(
       this->getExtensions();
 
   TilesetWriterResult result;
-  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer;
+  std::unique_ptr<CesiumJsonWriter::JsonWriter> pNewWriter;
+  CesiumJsonWriter::JsonWriter* pWriter = nullptr;
 
-  if (options.prettyPrint) {
-    writer = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
+  if (options.pJsonWriter) {
+    pWriter = &options.pJsonWriter->getWriter(options.prettyPrint);
   } else {
-    writer = std::make_unique<CesiumJsonWriter::JsonWriter>();
+    if (options.prettyPrint) {
+      pNewWriter = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
+    } else {
+      pNewWriter = std::make_unique<CesiumJsonWriter::JsonWriter>();
+    }
+    pWriter = pNewWriter.get();
   }
 
-  TilesetJsonWriter::write(tileset, *writer, context);
-  result.tilesetBytes = writer->toBytes();
-  result.errors = writer->getErrors();
-  result.warnings = writer->getWarnings();
+  TilesetJsonWriter::write(tileset, *pWriter, context);
+  result.tilesetBytes = pWriter->toBytes();
+  result.errors = pWriter->getErrors();
+  result.warnings = pWriter->getWarnings();
 
   return result;
 }
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "Library.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace CesiumAsync {
+class IAssetRequest;
+
+/**
+ * @brief Options for an {@link AdaptiveConcurrencyLimit}.
+ */
+struct CESIUMASYNC_API AdaptiveConcurrencyLimitOptions {
+  /**
+   * @brief The smallest number of requests that are allowed at the same time,
+   * however slow the responses are.
+   */
+  uint32_t minimumLimit = 4;
+
+  /**
+   * @brief The largest number of requests that are allowed at the same time,
+   * however fast the responses are.
+   */
+  uint32_t maximumLimit = 64;
+
+  /**
+   * @brief How many times longer than the shortest observed latency the
+   * requests may take before the limit is lowered.
+   *
+   * Requests that take longer than that are queueing somewhere between the
+   * client and the server, so more of them at the same time only delay the
+   * ones that matter most.
+   */
+  double latencyTolerance = 2.0;
+
+  /**
+   * @brief The factor that the limit is multiplied by when it is lowered.
+   */
+  double decreaseFactor = 0.75;
+};
+
+/**
+ * @brief A limit on the number of requests at the same time that adapts to
+ * the latency and throughput of the completed requests.
+ *
+ * The limit is adjusted once per window of completed requests, whose size is
+ * the current limit, with additive increase and multiplicative decrease. It is
+ * lowered by {@link AdaptiveConcurrencyLimitOptions::decreaseFactor} if any
+ * request of the window failed with a server error or too many requests, or if
+ * the mean latency of the window is more than
+ * {@link AdaptiveConcurrencyLimitOptions::latencyTolerance} times the shortest
+ * one observed. Otherwise it is raised by one, as long as the throughput of the
+ * window didn't drop compared to the window before, which means the last
+ * increase still helped.
+ *
+ * The shortest latency slowly drifts towards the observed ones, so that the
+ * limit recovers if the network gets slower for good.
+ *
+ * This class is thread-safe. {@link getLimit} doesn't lock.
+ */
+class CESIUMASYNC_API AdaptiveConcurrencyLimit {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param initialLimit The limit before any request completes. It is clamped
+   * to the limits of the options.
+   * @param options The options.
+   */
+  AdaptiveConcurrencyLimit(
+      uint32_t initialLimit,
+      const AdaptiveConcurrencyLimitOptions& options = {}) noexcept;
+
+  /**
+   * @brief Gets the current number of requests that are allowed at the same
+   * time.
+   */
+  uint32_t getLimit() const noexcept {
+    return this->_limit.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gets the options.
+   */
+  AdaptiveConcurrencyLimitOptions getOptions() const;
+
+  /**
+   * @brief Changes the options. The current limit is clamped to the new
+   * limits.
+   */
+  void setOptions(const AdaptiveConcurrencyLimitOptions& options);
+
+  /**
+   * @brief Records a completed request.
+   *
+   * @param requestTime When the request was started.
+   * @param responseTime When the request completed.
+   * @param bytes The number of bytes that were received.
+   * @param succeeded False if the server failed to respond or asked for fewer
+   * requests, true otherwise, even if the requested resource doesn't exist.
+   */
+  void recordResponse(
+      std::chrono::steady_clock::time_point requestTime,
+      std::chrono::steady_clock::time_point responseTime,
+      size_t bytes,
+      bool succeeded);
+
+  /**
+   * @brief Records a completed request.
+   *
+   * A request without a response, or with a response status of 429 (Too Many
+   * Requests) or of 500 or more, counts as failed.
+   * A response served from a cache, see {@link IAssetResponse::isFromCache},
+   * isn't recorded, because its latency isn't that of the network.
+   *
+   * @param request The completed request.
+   * @param requestTime When the request was started.
+   * @param responseTime When the request completed.
+   */
+  void recordResponse(
+      const IAssetRequest& request,
+      std::chrono::steady_clock::time_point requestTime,
+      std::chrono::steady_clock::time_point responseTime);
+
+  /**
+   * @brief Gets the throughput of the last complete window of requests, in
+   * bytes per second, or `std::nullopt` if no window completed yet.
+   */
+  std::optional<double> getThroughput() const;
+
+  /**
+   * @brief Gets the shortest mean latency of a window of requests, which the
+   * latency of later windows is compared to, or `std::nullopt` if no window
+   * completed yet.
+   */
+  std::optional<std::chrono::steady_clock::duration>
+  getBaselineLatency() const;
+
+private:
+  void finishWindow(std::chrono::steady_clock::time_point responseTime);
+
+  std::atomic<uint32_t> _limit;
+
+  mutable std::mutex _mutex;
+  AdaptiveConcurrencyLimitOptions _options;
+
+  // The requests that completed since the window started.
+  uint32_t _windowResponses;
+  uint32_t _windowFailures;
+  size_t _windowBytes;
+  std::chrono::steady_clock::duration _windowLatency;
+  std::optional<std::chrono::steady_clock::time_point> _windowStart;
+
+  std::optional<double> _throughput;
+  std::optional<std::chrono::steady_clock::duration> _baselineLatency;
+};
+
+} // namespace CesiumAsync
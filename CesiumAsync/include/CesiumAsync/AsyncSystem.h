@@ -6,12 +6,18 @@
 #include "Impl/WithTracing.h"
 #include "Impl/cesium-async++.h"
 #include "Library.h"
+#include "MainThreadDispatchBudget.h"
 #include "Promise.h"
 #include "ThreadPool.h"
 
 #include <CesiumUtility/Tracing.h>
 
+#include <atomic>
+#include <exception>
 #include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 namespace CesiumAsync {
 class ITaskProcessor;
@@ -227,6 +233,108 @@ public:
         std::forward<std::vector<SharedFuture<T>>>(futures));
   }
 
+  /**
+   * @brief Invokes a function with the value of each Future in a vector as
+   * soon as that Future resolves, rather than waiting for all of them.
+   *
+   * The function is called with the index of the Future in the vector and its
+   * value. It is invoked immediately in whichever thread resolves the Future,
+   * so it may be called from several threads at once.
+   *
+   * @tparam T The type that each Future resolves to.
+   * @tparam Func The type of the function.
+   * @param futures The list of futures.
+   * @param f The function, taking a `size_t` index and a `T&&` value.
+   * @return A Future that resolves when every given Future has resolved and
+   * its function call has returned, and rejects when any Future in the vector
+   * rejects. As with {@link all}, the exception is from the first Future in
+   * the vector that rejects. The function is still called for the others.
+   */
+  template <typename T, typename Func>
+  Future<void> whenEach(std::vector<Future<T>>&& futures, Func&& f) const {
+    return this->whenEachWithScheduler(
+        async::inline_scheduler(),
+        std::move(futures),
+        std::forward<Func>(f));
+  }
+
+  /**
+   * @brief Invokes a function in the main thread with the value of each Future
+   * in a vector as soon as that Future resolves, rather than waiting for all
+   * of them.
+   *
+   * This is like {@link whenEach}, except that the function is always invoked
+   * in the main thread, as with {@link Future::thenInMainThread}.
+   *
+   * @tparam T The type that each Future resolves to.
+   * @tparam Func The type of the function.
+   * @param futures The list of futures.
+   * @param f The function, taking a `size_t` index and a `T&&` value.
+   * @return A Future that resolves when every given Future has resolved and
+   * its function call has returned, and rejects when any Future in the vector
+   * rejects.
+   */
+  template <typename T, typename Func>
+  Future<void>
+  whenEachInMainThread(std::vector<Future<T>>&& futures, Func&& f) const {
+    return this->whenEachWithScheduler(
+        this->_pSchedulers->mainThread.immediate,
+        std::move(futures),
+        std::forward<Func>(f));
+  }
+
+  /**
+   * @brief Creates a Future that resolves with the value of whichever Future
+   * in a vector resolves first.
+   *
+   * The returned Future only rejects if every Future in the vector rejects,
+   * with the exception of the last one to reject, or if the vector is empty.
+   * The values of the Futures that resolve later are discarded.
+   *
+   * @tparam T The type that each Future resolves to.
+   * @param futures The list of futures.
+   * @return A Future that resolves when the first of the given Futures
+   * resolves.
+   */
+  template <typename T> Future<T> any(std::vector<Future<T>>&& futures) const {
+    struct State {
+      State(Promise<T>&& resultPromise, size_t futureCount)
+          : promise(std::move(resultPromise)), count(futureCount) {}
+
+      Promise<T> promise;
+      size_t count;
+      std::atomic<bool> resolved{false};
+      std::atomic<size_t> rejected{0};
+    };
+
+    Promise<T> promise = this->createPromise<T>();
+    Future<T> result = promise.getFuture();
+    if (futures.empty()) {
+      promise.reject(std::runtime_error("No Futures were given to any."));
+      return result;
+    }
+
+    auto pState = std::make_shared<State>(std::move(promise), futures.size());
+    for (Future<T>& future : futures) {
+      std::move(future._task)
+          .then(async::inline_scheduler(), [pState](async::task<T>&& task) {
+            try {
+              T value = task.get();
+              if (!pState->resolved.exchange(true)) {
+                pState->promise.resolve(std::move(value));
+              }
+            } catch (...) {
+              if (pState->rejected.fetch_add(1) + 1 == pState->count) {
+                pState->promise.reject(std::current_exception());
+              }
+            }
+          });
+    }
+    futures.clear();
+
+    return result;
+  }
+
   /**
    * @brief Creates a future that is already resolved.
    *
@@ -256,6 +364,20 @@ public:
    */
   void dispatchMainThreadTasks();
 
+  /**
+   * @brief Runs the tasks that are queued for the main thread until the
+   * budget is used up or no tasks are left.
+   *
+   * Tasks that were queued in a {@link TaskPriorityScope} run first, in order
+   * of priority, followed by the others in the order they were queued. The
+   * tasks are run in the calling thread.
+   *
+   * @param budget The limits on the time spent and the number of tasks run.
+   * @return How many tasks were run and how many are still waiting.
+   */
+  MainThreadDispatchResult
+  dispatchMainThreadTasks(const MainThreadDispatchBudget& budget);
+
   /**
    * @brief Runs a single waiting task that is currently queued for the main
    * thread. If there are no tasks waiting, it returns immediately without
@@ -322,6 +444,38 @@ private:
     return Future<std::vector<T>>(this->_pSchedulers, std::move(task));
   }
 
+  template <typename T, typename Func, typename Scheduler>
+  Future<void> whenEachWithScheduler(
+      Scheduler& scheduler,
+      std::vector<Future<T>>&& futures,
+      Func&& f) const {
+    // The function is shared by the continuations of all the Futures.
+    auto pFunction =
+        std::make_shared<std::decay_t<Func>>(std::forward<Func>(f));
+
+    std::vector<async::task<void>> tasks;
+    tasks.reserve(futures.size());
+    for (size_t i = 0; i < futures.size(); ++i) {
+      tasks.emplace_back(std::move(futures[i]._task)
+                             .then(scheduler, [pFunction, i](T&& value) {
+                               (*pFunction)(i, std::move(value));
+                             }));
+    }
+    futures.clear();
+
+    async::task<void> task =
+        async::when_all(tasks.begin(), tasks.end())
+            .then(
+                async::inline_scheduler(),
+                [](std::vector<async::task<void>>&& tasks) {
+                  // Rethrow the first rejection, if any.
+                  for (async::task<void>& eachTask : tasks) {
+                    eachTask.get();
+                  }
+                });
+    return Future<void>(this->_pSchedulers, std::move(task));
+  }
+
   std::shared_ptr<CesiumImpl::AsyncSystemSchedulers> _pSchedulers;
 
   template <typename T> friend class Future;
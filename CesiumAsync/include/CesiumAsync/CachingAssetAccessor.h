@@ -15,12 +15,49 @@
 namespace CesiumAsync {
 class AsyncSystem;
 
+/**
+ * @brief How a {@link CachingAssetAccessor} answers a get with a cached
+ * response that may be out of date.
+ *
+ * In every mode, a get whose headers include `Cache-Control: no-cache` or
+ * `max-age=0` is only answered after asking the server.
+ */
+enum class CacheMode {
+  /**
+   * @brief A stale cached response is revalidated with the server before it
+   * is returned.
+   */
+  Revalidate,
+
+  /**
+   * @brief A stale cached response is returned right away and revalidated
+   * with the server in the background, so that later gets find the updated
+   * response in the cache.
+   *
+   * A response that must not be used without revalidation, because of a
+   * `no-cache` or `must-revalidate` directive, is still revalidated first.
+   */
+  StaleWhileRevalidate,
+
+  /**
+   * @brief Any cached response is returned without asking the server, no
+   * matter how old it is. The server is only asked for the assets that are
+   * not cached.
+   */
+  OfflineFirst
+};
+
 /**
  * @brief A decorator for an {@link IAssetAccessor} that caches requests and
  * responses in an {@link ICacheDatabase}.
  *
  * This can be used to improve asset loading performance by caching assets
  * across runs.
+ *
+ * Concurrent calls to {@link get} with the same URL and headers, and with the
+ * same {@link AsyncSystem}, share a single cache lookup and, if needed, a
+ * single request to the underlying accessor. Each resolves with the same
+ * {@link IAssetRequest}.
  */
 class CachingAssetAccessor : public IAssetAccessor {
 public:
@@ -35,12 +72,14 @@ public:
    * responses.
    * @param requestsPerCachePrune The number of requests to handle before each
    * {@link ICacheDatabase::prune} of old cached results from the database.
+   * @param cacheMode How cached responses that may be out of date are used.
    */
   CachingAssetAccessor(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
       const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
-      int32_t requestsPerCachePrune = 10000);
+      int32_t requestsPerCachePrune = 10000,
+      CacheMode cacheMode = CacheMode::Revalidate);
 
   virtual ~CachingAssetAccessor() noexcept override;
 
@@ -60,13 +99,35 @@ public:
   /** @copydoc IAssetAccessor::tick */
   virtual void tick() noexcept override;
 
+  /**
+   * @brief Gets how cached responses that may be out of date are used.
+   */
+  CacheMode getCacheMode() const noexcept;
+
+  /**
+   * @brief Sets how cached responses that may be out of date are used, such
+   * as {@link CacheMode::OfflineFirst} while the network is unavailable.
+   *
+   * The mode applies to the gets that start after this call.
+   */
+  void setCacheMode(CacheMode cacheMode) noexcept;
+
 private:
+  struct InFlightRequests;
+
+  Future<std::shared_ptr<IAssetRequest>> getUncoalesced(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers);
+
   int32_t _requestsPerCachePrune;
   std::atomic<int32_t> _requestSinceLastPrune;
+  std::atomic<CacheMode> _cacheMode;
   std::shared_ptr<spdlog::logger> _pLogger;
   std::shared_ptr<IAssetAccessor> _pAssetAccessor;
   std::shared_ptr<ICacheDatabase> _pCacheDatabase;
   ThreadPool _cacheThreadPool;
+  std::shared_ptr<InFlightRequests> _pInFlightRequests;
   CESIUM_TRACE_DECLARE_TRACK_SET(_pruneSlots, "Prune cache database");
 };
 } // namespace CesiumAsync
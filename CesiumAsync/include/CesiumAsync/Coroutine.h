@@ -0,0 +1,217 @@
+#pragma once
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include "AsyncSystem.h"
+#include "Future.h"
+#include "Impl/cesium-async++.h"
+#include "Promise.h"
+#include "ThreadPool.h"
+
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Defined to 1 when C++20 coroutines are available, and with them the
+ * contents of `CesiumAsync/Coroutine.h`.
+ */
+#define CESIUM_ASYNC_HAS_COROUTINES 1
+
+namespace CesiumAsync {
+namespace CesiumImpl {
+// Begin omitting doxgen warnings for Impl namespace
+//! @cond Doxygen_Suppress
+
+struct CoroutineAccess {
+  template <typename T> static async::task<T>&& task(Future<T>& future) {
+    return std::move(future._task);
+  }
+
+  template <typename T>
+  static CesiumImpl::AsyncSystemSchedulers& schedulers(Future<T>& future) {
+    return *future._pSchedulers;
+  }
+
+  static auto& immediate(const ThreadPool& threadPool) {
+    return threadPool._pScheduler->immediate;
+  }
+};
+
+// Suspends a coroutine until a Future resolves or rejects, and resumes it
+// with the given scheduler. The Future's schedulers are kept alive until then.
+template <typename T, typename Scheduler> class FutureAwaiter {
+public:
+  FutureAwaiter(Future<T>&& future, Scheduler& scheduler)
+      : _future(std::move(future)), _scheduler(scheduler), _completed() {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    // If the Future is already resolved and this thread is suitable for the
+    // scheduler, the coroutine resumes before this returns.
+    [[maybe_unused]] async::task<void> resumed =
+        CoroutineAccess::task(this->_future)
+            .then(
+                this->_scheduler,
+                [this, handle](async::task<T>&& completed) mutable {
+                  this->_completed = std::move(completed);
+                  handle.resume();
+                });
+  }
+
+  T await_resume() { return this->_completed.get(); }
+
+private:
+  Future<T> _future;
+  Scheduler& _scheduler;
+  async::task<T> _completed;
+};
+
+template <typename T, typename Scheduler>
+FutureAwaiter<T, Scheduler>
+makeFutureAwaiter(Future<T>&& future, Scheduler& scheduler) {
+  return FutureAwaiter<T, Scheduler>(std::move(future), scheduler);
+}
+
+// Finds the AsyncSystem among the parameters of a coroutine.
+template <typename First, typename... Rest>
+const AsyncSystem& findAsyncSystem(First& first, Rest&... rest) {
+  if constexpr (std::is_convertible_v<First&, const AsyncSystem&>) {
+    return first;
+  } else {
+    static_assert(
+        sizeof...(Rest) > 0,
+        "A coroutine that returns a CesiumAsync::Future must take a "
+        "CesiumAsync::AsyncSystem as one of its parameters.");
+    return findAsyncSystem(rest...);
+  }
+}
+
+template <typename T> class FuturePromiseBase {
+public:
+  template <typename... Args>
+  explicit FuturePromiseBase(Args&... args)
+      : _promise(findAsyncSystem(args...).template createPromise<T>()) {}
+
+  Future<T> get_return_object() { return this->_promise.getFuture(); }
+
+  // The coroutine runs in the calling thread until it first suspends, like the
+  // function passed to AsyncSystem::createFuture.
+  std::suspend_never initial_suspend() const noexcept { return {}; }
+  std::suspend_never final_suspend() const noexcept { return {}; }
+
+  void unhandled_exception() {
+    this->_promise.reject(std::current_exception());
+  }
+
+protected:
+  Promise<T> _promise;
+};
+
+template <typename T> class FuturePromise : public FuturePromiseBase<T> {
+public:
+  using FuturePromiseBase<T>::FuturePromiseBase;
+
+  void return_value(T&& value) { this->_promise.resolve(std::move(value)); }
+  void return_value(const T& value) { this->_promise.resolve(value); }
+};
+
+template <> class FuturePromise<void> : public FuturePromiseBase<void> {
+public:
+  using FuturePromiseBase<void>::FuturePromiseBase;
+
+  void return_void() { this->_promise.resolve(); }
+};
+
+//! @endcond
+// End omitting doxgen warnings for Impl namespace
+} // namespace CesiumImpl
+
+/**
+ * @brief Awaits a Future in a coroutine, and resumes the coroutine in a
+ * worker thread when the Future resolves.
+ *
+ * As with {@link Future::thenInWorkerThread}, the coroutine resumes right away
+ * if the Future is resolved by a designated worker thread.
+ *
+ * @param future The Future to await.
+ * @return An awaitable that produces the value of the Future, or throws the
+ * exception that rejected it.
+ */
+template <typename T> auto inWorkerThread(Future<T>&& future) {
+  CesiumImpl::AsyncSystemSchedulers& schedulers =
+      CesiumImpl::CoroutineAccess::schedulers(future);
+  return CesiumImpl::makeFutureAwaiter(
+      std::move(future),
+      schedulers.workerThread.immediate);
+}
+
+/**
+ * @brief Awaits a Future in a coroutine, and resumes the coroutine in the
+ * main thread when the Future resolves.
+ *
+ * As with {@link Future::thenInMainThread}, the coroutine resumes right away
+ * if the Future is resolved by the main thread, and otherwise when the main
+ * thread next dispatches its tasks.
+ *
+ * @param future The Future to await.
+ * @return An awaitable that produces the value of the Future, or throws the
+ * exception that rejected it.
+ */
+template <typename T> auto inMainThread(Future<T>&& future) {
+  CesiumImpl::AsyncSystemSchedulers& schedulers =
+      CesiumImpl::CoroutineAccess::schedulers(future);
+  return CesiumImpl::makeFutureAwaiter(
+      std::move(future),
+      schedulers.mainThread.immediate);
+}
+
+/**
+ * @brief Awaits a Future in a coroutine, and resumes the coroutine in a
+ * thread pool thread when the Future resolves.
+ *
+ * @param threadPool The thread pool in which to resume.
+ * @param future The Future to await.
+ * @return An awaitable that produces the value of the Future, or throws the
+ * exception that rejected it.
+ */
+template <typename T>
+auto inThreadPool(const ThreadPool& threadPool, Future<T>&& future) {
+  return CesiumImpl::makeFutureAwaiter(
+      std::move(future),
+      CesiumImpl::CoroutineAccess::immediate(threadPool));
+}
+
+/**
+ * @brief Awaits a Future in a coroutine, and resumes the coroutine in
+ * whichever thread resolves the Future, like
+ * {@link Future::thenImmediately}.
+ *
+ * Use {@link inWorkerThread}, {@link inMainThread} or {@link inThreadPool} to
+ * resume in a particular thread instead.
+ */
+template <typename T> auto operator co_await(Future<T>&& future) {
+  return CesiumImpl::makeFutureAwaiter(
+      std::move(future),
+      async::inline_scheduler());
+}
+
+} // namespace CesiumAsync
+
+/**
+ * @brief Allows a function that returns a {@link CesiumAsync::Future} to be a
+ * coroutine.
+ *
+ * The Future resolves with the value the coroutine `co_return`s, or rejects
+ * with the exception that escapes it. The coroutine must take the
+ * {@link CesiumAsync::AsyncSystem} that creates the Future as one of its
+ * parameters.
+ */
+template <typename T, typename... Args>
+struct std::coroutine_traits<CesiumAsync::Future<T>, Args...> {
+  using promise_type = CesiumAsync::CesiumImpl::FuturePromise<T>;
+};
+
+#endif
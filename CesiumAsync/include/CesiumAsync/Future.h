@@ -3,6 +3,7 @@
 #include "Impl/AsyncSystemSchedulers.h"
 #include "Impl/CatchFunction.h"
 #include "Impl/ContinuationFutureType.h"
+#include "Impl/WithPriority.h"
 #include "Impl/WithTracing.h"
 #include "SharedFuture.h"
 #include "ThreadPool.h"
@@ -17,6 +18,7 @@ namespace CesiumImpl {
 
 template <typename R> struct ParameterizedTaskUnwrapper;
 struct TaskUnwrapper;
+struct CoroutineAccess;
 
 } // namespace CesiumImpl
 
@@ -116,7 +118,7 @@ public:
   template <typename Func>
   CesiumImpl::ContinuationFutureType_t<Func, T> thenImmediately(Func&& f) && {
     return CesiumImpl::ContinuationFutureType_t<Func, T>(
-        this->_pSchedulers,
+        std::move(this->_pSchedulers),
         _task.then(
             async::inline_scheduler(),
             CesiumImpl::WithTracing<T>::end(nullptr, std::forward<Func>(f))));
@@ -281,7 +283,9 @@ public:
    * @return The `SharedFuture`.
    */
   SharedFuture<T> share() && {
-    return SharedFuture<T>(this->_pSchedulers, this->_task.share());
+    return SharedFuture<T>(
+        std::move(this->_pSchedulers),
+        this->_task.share());
   }
 
 private:
@@ -290,6 +294,13 @@ private:
       async::task<T>&& task) noexcept
       : _pSchedulers(pSchedulers), _task(std::move(task)) {}
 
+  // A continuation invalidates this Future, so the Future it returns takes
+  // over the schedulers without touching their reference count.
+  Future(
+      std::shared_ptr<CesiumImpl::AsyncSystemSchedulers>&& pSchedulers,
+      async::task<T>&& task) noexcept
+      : _pSchedulers(std::move(pSchedulers)), _task(std::move(task)) {}
+
   template <typename Func, typename Scheduler>
   CesiumImpl::ContinuationFutureType_t<Func, T> thenWithScheduler(
       Scheduler& scheduler,
@@ -310,8 +321,9 @@ private:
 #endif
 
     return CesiumImpl::ContinuationFutureType_t<Func, T>(
-        this->_pSchedulers,
-        task.then(
+        std::move(this->_pSchedulers),
+        CesiumImpl::thenWithCurrentPriority<async::task<T>&&>(
+            task,
             scheduler,
             CesiumImpl::WithTracing<T>::end(
                 tracingName,
@@ -322,7 +334,7 @@ private:
   CesiumImpl::ContinuationFutureType_t<Func, std::exception>
   catchWithScheduler(Scheduler& scheduler, Func&& f) && {
     return CesiumImpl::ContinuationFutureType_t<Func, std::exception>(
-        this->_pSchedulers,
+        std::move(this->_pSchedulers),
         this->_task.then(
             async::inline_scheduler(),
             CesiumImpl::CatchFunction<Func, T, Scheduler>{
@@ -339,6 +351,8 @@ private:
 
   friend struct CesiumImpl::TaskUnwrapper;
 
+  friend struct CesiumImpl::CoroutineAccess;
+
   template <typename R> friend class Future;
   template <typename R> friend class SharedFuture;
   template <typename R> friend class Promise;
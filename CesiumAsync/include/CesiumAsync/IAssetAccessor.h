@@ -7,6 +7,7 @@
 #include <gsl/span>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -41,6 +42,32 @@ public:
       const std::string& url,
       const std::vector<THeader>& headers = {}) = 0;
 
+  /**
+   * @brief Starts a new request for a range of the bytes of the asset with the
+   * given URL.
+   *
+   * The default implementation adds an HTTP `Range` header to the headers and
+   * calls {@link get}. If the response is the whole asset, with status 200,
+   * because the server or the accessor doesn't support ranges, it is reduced
+   * to the range and given status 206 (Partial Content). So the data of a
+   * successful response is only the requested range, or as much of it as the
+   * asset has.
+   *
+   * @param asyncSystem The async system used to do work in threads.
+   * @param url The URL of the asset.
+   * @param offset The offset of the first byte in the range.
+   * @param length The number of bytes in the range, or 0 for all of the bytes
+   * from the offset to the end of the asset.
+   * @param headers The other headers to include in the request.
+   * @return The in-progress asset request.
+   */
+  virtual CesiumAsync::Future<std::shared_ptr<IAssetRequest>> getRange(
+      const AsyncSystem& asyncSystem,
+      const std::string& url,
+      uint64_t offset,
+      uint64_t length,
+      const std::vector<THeader>& headers = {});
+
   /**
    * @brief Starts a new request to the given URL, using the provided HTTP verb
    * and the provided content payload.
@@ -41,6 +41,15 @@ public:
    * @brief Returns the data of this response
    */
   virtual gsl::span<const std::byte> data() const = 0;
+
+  /**
+   * @brief Returns true if this response was served from a local cache
+   * without contacting the server, so its latency says nothing about the
+   * network.
+   *
+   * The default implementation returns false.
+   */
+  virtual bool isFromCache() const { return false; }
 };
 
 } // namespace CesiumAsync
@@ -5,7 +5,9 @@
 #include "Library.h"
 
 #include <cstddef>
+#include <memory>
 #include <optional>
+#include <utility>
 
 namespace CesiumAsync {
 /**
@@ -28,6 +30,28 @@ public:
    */
   virtual std::optional<CacheItem> getEntry(const std::string& key) const = 0;
 
+  /**
+   * @brief Gets a cache entry from the database, as an item that the caller
+   * may share with the database instead of a copy of it.
+   *
+   * The item must not change while it is shared, so an implementation that
+   * keeps entries in memory can return them without copying their data. The
+   * default implementation moves the result of {@link getEntry} into a new
+   * item.
+   *
+   * @param key The unique key associated with the cache entry.
+   * @return The result of the cache lookup, or `nullptr` if the key does not
+   * exist in the cache or an error occurred.
+   */
+  virtual std::shared_ptr<const CacheItem>
+  getSharedEntry(const std::string& key) const {
+    std::optional<CacheItem> cacheItem = this->getEntry(key);
+    if (!cacheItem) {
+      return nullptr;
+    }
+    return std::make_shared<const CacheItem>(std::move(*cacheItem));
+  }
+
   /**
    * @brief Store a cache entry in the database.
    *
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "Library.h"
+#include "TaskPriority.h"
 
 #include <functional>
+#include <utility>
 
 namespace CesiumAsync {
 /**
@@ -25,5 +27,22 @@ public:
    * @param f The function to execute
    */
   virtual void startTask(std::function<void()> f) = 0;
+
+  /**
+   * @brief Starts a task with a priority that executes the given function in
+   * a background thread.
+   *
+   * The priority is a hint: of the tasks that are waiting to run, the ones
+   * that {@link TaskPriority::runsBefore} the others should run first. The
+   * default implementation ignores it and calls {@link startTask}.
+   *
+   * @param f The function to execute
+   * @param priority The priority of the task
+   */
+  virtual void startPrioritizedTask(
+      std::function<void()> f,
+      [[maybe_unused]] const TaskPriority& priority) {
+    this->startTask(std::move(f));
+  }
 };
 } // namespace CesiumAsync
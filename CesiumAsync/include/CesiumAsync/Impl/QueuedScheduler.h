@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../MainThreadDispatchBudget.h"
 #include "ImmediateScheduler.h"
 #include "cesium-async++.h"
 
@@ -15,7 +16,10 @@ public:
 
   void schedule(async::task_run_handle t);
   void dispatchQueuedContinuations();
+  MainThreadDispatchResult
+  dispatchQueuedContinuations(const MainThreadDispatchBudget& budget);
   bool dispatchZeroOrOneContinuation();
+  size_t getQueuedContinuationCount() const;
 
   template <typename T> T dispatchUntilTaskCompletes(async::task<T>&& task) {
     // Set up a continuation to unblock the blocking dispatch when this task
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../TaskPriority.h"
+#include "cesium-async++.h"
+
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace CesiumAsync {
+namespace CesiumImpl {
+// Begin omitting doxgen warnings for Impl namespace
+//! @cond Doxygen_Suppress
+
+// A continuation that schedules another continuation with a priority. The
+// continuation is normally scheduled by whichever thread completes the task,
+// after the task completes, when the priority that was current when it was
+// created is long gone. So instead, this is run inline when the task
+// completes, and schedules the continuation itself from inside a scope with
+// that priority.
+template <typename Func, typename Scheduler, typename TaskParameter>
+struct WithPriority {
+  Scheduler& scheduler;
+  TaskPriority priority;
+  Func f;
+
+  auto operator()(TaskParameter t) {
+    TaskPriorityScope scope(this->priority);
+    return t.then(this->scheduler, std::move(this->f));
+  }
+};
+
+template <
+    typename TaskParameter,
+    typename Task,
+    typename Scheduler,
+    typename Func>
+auto thenWithCurrentPriority(Task& task, Scheduler& scheduler, Func&& f) {
+  const std::optional<TaskPriority> priority = TaskPriorityScope::getCurrent();
+  if (!priority) {
+    return task.then(scheduler, std::forward<Func>(f));
+  }
+
+  return task.then(
+      async::inline_scheduler(),
+      WithPriority<std::decay_t<Func>, Scheduler, TaskParameter>{
+          scheduler,
+          *priority,
+          std::forward<Func>(f)});
+}
+
+//! @endcond
+// End omitting doxgen warnings for Impl namespace
+} // namespace CesiumImpl
+} // namespace CesiumAsync
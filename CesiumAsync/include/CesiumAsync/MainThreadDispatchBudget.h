@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstddef>
+#include <optional>
+
+namespace CesiumAsync {
+
+/**
+ * @brief Limits the main-thread tasks run by one call to
+ * {@link AsyncSystem::dispatchMainThreadTasks}.
+ *
+ * At least one task is run if any are waiting, even if the budget allows
+ * none, so that the waiting work always makes progress.
+ */
+struct CESIUMASYNC_API MainThreadDispatchBudget {
+  /**
+   * @brief The time, in milliseconds, after which no more tasks are started,
+   * or `std::nullopt` for no time limit.
+   */
+  std::optional<double> timeLimit;
+
+  /**
+   * @brief The largest number of tasks to run, or `std::nullopt` for no
+   * limit.
+   */
+  std::optional<size_t> maximumTasks;
+};
+
+/**
+ * @brief The result of {@link AsyncSystem::dispatchMainThreadTasks}.
+ */
+struct CESIUMASYNC_API MainThreadDispatchResult {
+  /**
+   * @brief The number of tasks that were run.
+   */
+  size_t tasksDispatched = 0;
+
+  /**
+   * @brief The number of tasks that are still waiting to run in the main
+   * thread, including any that were queued by the tasks that were run.
+   */
+  size_t tasksRemaining = 0;
+};
+
+} // namespace CesiumAsync
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "ICacheDatabase.h"
+#include "Library.h"
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace CesiumAsync {
+
+/**
+ * @brief A bounded in-memory cache of the most recently used entries of
+ * another {@link ICacheDatabase}, such as a {@link SqliteCache}.
+ *
+ * Entries that are read from or stored in the other database are kept in
+ * memory, up to a total size, so that reading them again doesn't go to the
+ * other database. When the total size is exceeded, the least recently used
+ * entries are dropped from memory, but not from the other database.
+ *
+ * The entries are returned just as the other database would return them, so
+ * the {@link CachingAssetAccessor} decides whether they are stale, and
+ * revalidates them, in the same way. Expired entries are dropped from memory
+ * when the cache is pruned.
+ */
+class CESIUMASYNC_API MemoryCache : public ICacheDatabase {
+public:
+  /**
+   * @brief Constructs a new instance in front of the given database.
+   *
+   * @param pDatabase The database in which entries are stored, and from which
+   * entries that are not in memory are read.
+   * @param maximumSize The largest total size, in bytes, of the entries that
+   * are kept in memory. Entries larger than this are not kept in memory at
+   * all.
+   */
+  MemoryCache(std::shared_ptr<ICacheDatabase> pDatabase, size_t maximumSize);
+
+  /** @copydoc ICacheDatabase::getEntry*/
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override;
+
+  /** @copydoc ICacheDatabase::getSharedEntry*/
+  virtual std::shared_ptr<const CacheItem>
+  getSharedEntry(const std::string& key) const override;
+
+  /** @copydoc ICacheDatabase::storeEntry*/
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  /** @copydoc ICacheDatabase::prune*/
+  virtual bool prune() override;
+
+  /** @copydoc ICacheDatabase::clearAll*/
+  virtual bool clearAll() override;
+
+  /**
+   * @brief Gets the total size, in bytes, of the entries that are currently
+   * kept in memory.
+   */
+  size_t getCurrentSize() const;
+
+private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const CacheItem> pCacheItem;
+    size_t size;
+  };
+
+  // Keeps an entry in memory, if it fits, and returns the entry that is kept
+  // for the key.
+  std::shared_ptr<const CacheItem> keep(
+      const std::string& key,
+      std::shared_ptr<const CacheItem>&& pItem,
+      bool replaceExisting) const;
+  void forget(std::list<Entry>::iterator it) const;
+
+  std::shared_ptr<ICacheDatabase> _pDatabase;
+  size_t _maximumSize;
+
+  // Guards the members below. Reads reorder the entries, so they're mutable.
+  mutable std::mutex _mutex;
+
+  // The entries kept in memory, the most recently used first.
+  mutable std::list<Entry> _entries;
+  mutable std::unordered_map<std::string, std::list<Entry>::iterator>
+      _entriesByKey;
+  mutable size_t _currentSize;
+};
+
+} // namespace CesiumAsync
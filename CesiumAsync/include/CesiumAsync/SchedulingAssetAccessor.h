@@ -0,0 +1,102 @@
+#pragma once
+
+#include "IAssetAccessor.h"
+#include "IAssetRequest.h"
+#include "Library.h"
+#include "TaskPriority.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace CesiumAsync {
+class AsyncSystem;
+
+/**
+ * @brief A decorator for an {@link IAssetAccessor} that limits the number of
+ * requests that are in flight to each host at once.
+ *
+ * The requests that would exceed a host's limit are queued, and each starts
+ * when one of the host's requests completes. Queued requests that were made in
+ * a {@link TaskPriorityScope} start first, in order of priority, followed by
+ * the others in the order they were made. A queued request's priority can be
+ * changed with {@link reprioritize}.
+ *
+ * The host of a request is the part of its URL between the scheme and the
+ * path, including any port. See {@link getHost}.
+ */
+class CESIUMASYNC_API SchedulingAssetAccessor : public IAssetAccessor {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param pAssetAccessor The underlying {@link IAssetAccessor} used to make
+   * the requests.
+   * @param maximumRequestsPerHost The largest number of requests that are in
+   * flight to a host at once, unless the host is given a limit of its own with
+   * {@link setMaximumRequestsForHost}.
+   */
+  SchedulingAssetAccessor(
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+      size_t maximumRequestsPerHost = 6);
+
+  virtual ~SchedulingAssetAccessor() noexcept override;
+
+  /** @copydoc IAssetAccessor::get */
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  virtual Future<std::shared_ptr<IAssetRequest>> request(
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  /** @copydoc IAssetAccessor::tick */
+  virtual void tick() noexcept override;
+
+  /**
+   * @brief Sets the largest number of requests that are in flight to the
+   * given host at once.
+   *
+   * If the limit is raised, queued requests to the host start right away.
+   *
+   * @param host The host, as returned by {@link getHost}.
+   * @param maximumRequests The largest number of requests.
+   */
+  void
+  setMaximumRequestsForHost(const std::string& host, size_t maximumRequests);
+
+  /**
+   * @brief Changes the priority of the queued requests for the given URL.
+   *
+   * Requests that are already in flight are not affected.
+   *
+   * @param url The URL of the requests.
+   * @param priority The new priority.
+   */
+  void reprioritize(const std::string& url, const TaskPriority& priority);
+
+  /**
+   * @brief Gets the number of requests that are queued for the given host.
+   *
+   * @param host The host, as returned by {@link getHost}.
+   */
+  size_t getQueuedRequestCount(const std::string& host) const;
+
+  /**
+   * @brief Gets the host of a URL: the part between `://` and the next `/`,
+   * `?` or `#`, or the empty string if the URL has no scheme.
+   *
+   * @param url The URL.
+   */
+  static std::string getHost(const std::string& url);
+
+private:
+  struct Scheduler;
+  std::shared_ptr<Scheduler> _pScheduler;
+};
+} // namespace CesiumAsync
@@ -3,6 +3,7 @@
 #include "Impl/AsyncSystemSchedulers.h"
 #include "Impl/CatchFunction.h"
 #include "Impl/ContinuationFutureType.h"
+#include "Impl/WithPriority.h"
 #include "Impl/WithTracing.h"
 #include "ThreadPool.h"
 
@@ -275,6 +276,11 @@ private:
       async::shared_task<T>&& task) noexcept
       : _pSchedulers(pSchedulers), _task(std::move(task)) {}
 
+  SharedFuture(
+      std::shared_ptr<CesiumImpl::AsyncSystemSchedulers>&& pSchedulers,
+      async::shared_task<T>&& task) noexcept
+      : _pSchedulers(std::move(pSchedulers)), _task(std::move(task)) {}
+
   template <typename Func, typename Scheduler>
   CesiumImpl::ContinuationFutureType_t<Func, T>
   thenWithScheduler(Scheduler& scheduler, const char* tracingName, Func&& f) {
@@ -296,7 +302,8 @@ private:
 
     return CesiumImpl::ContinuationFutureType_t<Func, T>(
         this->_pSchedulers,
-        task.then(
+        CesiumImpl::thenWithCurrentPriority<const async::shared_task<T>&>(
+            task,
             scheduler,
             CesiumImpl::WithTracingShared<T>::end(
                 tracingName,
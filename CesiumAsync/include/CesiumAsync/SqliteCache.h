@@ -13,6 +13,10 @@ namespace CesiumAsync {
 
 /**
  * @brief Cache storage using SQLITE to store completed response.
+ *
+ * Entries are read through a pool of read-only connections, so concurrent
+ * calls to {@link getEntry} don't wait for each other, nor for writes, which
+ * are made through a separate connection.
  */
 class CESIUMASYNC_API SqliteCache : public ICacheDatabase {
 public:
@@ -27,17 +31,60 @@ public:
    * @param databaseName the database path.
    * @param maxItems the maximum number of items should be kept in the database
    * after prunning.
+   * @param writeBatchSize The number of stored entries that are written to the
+   * database together, in one transaction, by a background thread. Until they
+   * are written, {@link getEntry} returns them from memory, and
+   * {@link storeEntry} returns true without waiting for the disk. If 0, each
+   * entry is written to the database before {@link storeEntry} returns.
+   * @param writeBatchInterval The longest time, in milliseconds, that a stored
+   * entry waits for a batch to fill before it is written.
+   * @param dataFileThreshold The size, in bytes, from which response data is
+   * stored in a file of its own rather than in the database, so that the
+   * database stays small and pruning an entry just removes its file. The files
+   * are stored in a directory named after the database, with a `-data`
+   * suffix, and are named by their content, so that identical responses share
+   * one file. If 0, all response data is stored in the database.
+   * @param maxSize The maximum total size, in bytes, of the response data that
+   * should be kept in the database and its data files after prunning. If 0,
+   * only the number of items is limited.
+   * @param pruneBatchSize The largest number of items that are removed
+   * together, in one transaction, when the database is pruned. If greater
+   * than 0, {@link prune} returns right away, and a background thread removes
+   * the items in batches, so that the database is never locked for long. If
+   * 0, {@link prune} removes all of the items at once before it returns.
+   * @param pruneBatchInterval The time, in milliseconds, that the background
+   * thread waits between batches of removed items.
+   * @param compressResponseData Whether to compress response data with gzip
+   * when it's stored, to save space, unless that doesn't make it smaller.
+   * Compressed data is decompressed when it's read, whether or not this is
+   * true.
    */
   SqliteCache(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::string& databaseName,
-      uint64_t maxItems = 4096);
+      uint64_t maxItems = 4096,
+      size_t writeBatchSize = 64,
+      double writeBatchInterval = 100.0,
+      size_t dataFileThreshold = 0,
+      uint64_t maxSize = 0,
+      size_t pruneBatchSize = 0,
+      double pruneBatchInterval = 10.0,
+      bool compressResponseData = false);
   ~SqliteCache();
 
   /** @copydoc ICacheDatabase::getEntry*/
   virtual std::optional<CacheItem>
   getEntry(const std::string& key) const override;
 
+  /**
+   * @copydoc ICacheDatabase::getSharedEntry
+   *
+   * Entries that have been stored but not yet written to the database are
+   * returned without copying them.
+   */
+  virtual std::shared_ptr<const CacheItem>
+  getSharedEntry(const std::string& key) const override;
+
   /** @copydoc ICacheDatabase::storeEntry*/
   virtual bool storeEntry(
       const std::string& key,
@@ -57,8 +104,31 @@ public:
 
 private:
   struct Impl;
+  struct WriteBehind;
+  struct Pruner;
   std::unique_ptr<Impl> _pImpl;
+  std::unique_ptr<WriteBehind> _pWriteBehind;
+  std::unique_ptr<Pruner> _pPruner;
   void createConnection() const;
   void destroyDatabase();
+  std::shared_ptr<const CacheItem>
+  findPendingEntry(const std::string& key) const;
+  std::optional<CacheItem> readEntry(const std::string& key) const;
+  bool writeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData);
+  bool updateLastAccessedTime(int64_t itemIndex) const;
+  void writePendingEntries();
+  void writePendingEntriesUntilStopped();
+  bool pruneEntries();
+  bool pruneBatch(size_t batchSize, bool& finished);
+  void pruneEntriesUntilStopped();
+  void removeUnreferencedDataFiles();
 };
 } // namespace CesiumAsync
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstdint>
+#include <optional>
+
+namespace CesiumAsync {
+
+/**
+ * @brief The priority of work done in a worker thread, which an
+ * {@link ITaskProcessor} may use to decide which of its waiting tasks to run
+ * first. See {@link TaskPriorityScope}.
+ */
+struct CESIUMASYNC_API TaskPriority {
+  /**
+   * @brief The priority group of the work. All of the work in a higher group
+   * should run before any of the work in a lower group.
+   */
+  int32_t group = 0;
+
+  /**
+   * @brief The priority of the work within its group. Work with a _lower_
+   * value should run sooner.
+   */
+  double value = 0.0;
+
+  /**
+   * @brief Determines whether work with this priority should run before work
+   * with another priority.
+   */
+  bool runsBefore(const TaskPriority& rhs) const noexcept {
+    if (this->group == rhs.group) {
+      return this->value < rhs.value;
+    }
+    return this->group > rhs.group;
+  }
+};
+
+/**
+ * @brief Gives a priority to the worker-thread work started by the current
+ * thread while an instance of this class exists.
+ *
+ * {@link AsyncSystem::runInWorkerThread}, {@link Future::thenInWorkerThread}
+ * and {@link SharedFuture::thenInWorkerThread} capture the priority that is
+ * current when they're called, and the work they schedule is started with
+ * {@link ITaskProcessor::startPrioritizedTask}. That work then runs with the
+ * same priority, so the continuations that it creates inherit it.
+ *
+ * Scopes may be nested. The innermost one is current.
+ */
+class CESIUMASYNC_API TaskPriorityScope final {
+public:
+  /**
+   * @brief Makes the given priority current in this thread until this
+   * instance is destroyed.
+   *
+   * @param priority The priority.
+   */
+  explicit TaskPriorityScope(const TaskPriority& priority) noexcept;
+
+  /**
+   * @brief Restores the priority that was current before this instance was
+   * created.
+   */
+  ~TaskPriorityScope() noexcept;
+
+  TaskPriorityScope(const TaskPriorityScope& rhs) = delete;
+  TaskPriorityScope& operator=(const TaskPriorityScope& rhs) = delete;
+
+  /**
+   * @brief Gets the priority that is current in this thread, or
+   * `std::nullopt` if there is no current scope.
+   */
+  static std::optional<TaskPriority> getCurrent() noexcept;
+
+private:
+  std::optional<TaskPriority> _previous;
+};
+
+} // namespace CesiumAsync
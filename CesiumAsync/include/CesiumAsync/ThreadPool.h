@@ -8,6 +8,10 @@
 
 namespace CesiumAsync {
 
+namespace CesiumImpl {
+struct CoroutineAccess;
+} // namespace CesiumImpl
+
 /**
  * @brief A thread pool created by {@link AsyncSystem::createThreadPool}.
  *
@@ -46,6 +50,7 @@ private:
   template <typename T> friend class Future;
   template <typename T> friend class SharedFuture;
   friend class AsyncSystem;
+  friend struct CesiumImpl::CoroutineAccess;
 };
 
 } // namespace CesiumAsync
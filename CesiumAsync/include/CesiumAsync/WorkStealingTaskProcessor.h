@@ -0,0 +1,86 @@
+#pragma once
+
+#include "ITaskProcessor.h"
+#include "Library.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace CesiumAsync {
+
+/**
+ * @brief Options for a {@link WorkStealingTaskProcessor}.
+ */
+struct CESIUMASYNC_API WorkStealingTaskProcessorOptions {
+  /**
+   * @brief The number of worker threads. If 0, one thread is created for each
+   * hardware thread, as reported by `std::thread::hardware_concurrency`.
+   */
+  uint32_t numberOfThreads = 0;
+
+  /**
+   * @brief Whether to pin each worker thread to its own hardware thread.
+   *
+   * This is a hint that is only supported on Linux and Windows. It's ignored
+   * elsewhere, and when there are more worker threads than hardware threads.
+   */
+  bool pinThreadsToCores = false;
+};
+
+/**
+ * @brief An {@link ITaskProcessor} that runs tasks in a fixed pool of worker
+ * threads, for applications that don't have a scheduler of their own.
+ *
+ * Each worker has its own queue. Tasks started by a worker go to the back of
+ * its own queue, and tasks started by other threads are spread across the
+ * queues in turn. A worker runs the tasks at the back of its own queue first,
+ * because they're likely to use data that's still in its cache, and when its
+ * queue is empty it steals from the front of the other queues. Each queue has
+ * its own lock, so starting a task never contends with more than one worker.
+ *
+ * Tasks started with {@link startPrioritizedTask} share one queue, ordered by
+ * their priority, and run before any of the tasks in the workers' queues.
+ *
+ * The tasks that are still queued when the processor is destroyed are run
+ * before its destructor returns.
+ */
+class CESIUMASYNC_API WorkStealingTaskProcessor : public ITaskProcessor {
+public:
+  /**
+   * @brief Constructs a new instance and starts its worker threads.
+   *
+   * @param options The options for the processor.
+   */
+  explicit WorkStealingTaskProcessor(
+      const WorkStealingTaskProcessorOptions& options =
+          WorkStealingTaskProcessorOptions());
+
+  /**
+   * @brief Runs the remaining tasks and stops the worker threads.
+   */
+  virtual ~WorkStealingTaskProcessor() noexcept override;
+
+  WorkStealingTaskProcessor(const WorkStealingTaskProcessor& rhs) = delete;
+  WorkStealingTaskProcessor&
+  operator=(const WorkStealingTaskProcessor& rhs) = delete;
+
+  /** @copydoc ITaskProcessor::startTask */
+  virtual void startTask(std::function<void()> f) override;
+
+  /** @copydoc ITaskProcessor::startPrioritizedTask */
+  virtual void startPrioritizedTask(
+      std::function<void()> f,
+      const TaskPriority& priority) override;
+
+  /**
+   * @brief Gets the number of worker threads.
+   */
+  uint32_t getNumberOfThreads() const noexcept;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> _pImpl;
+};
+
+} // namespace CesiumAsync
@@ -0,0 +1,158 @@
+#include <CesiumAsync/AdaptiveConcurrencyLimit.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace CesiumAsync {
+namespace {
+// The share of the previous window's throughput that a window needs to reach
+// for the limit to keep growing, so that noise doesn't stop it.
+const double throughputTolerance = 0.95;
+
+// How far the baseline latency moves towards the mean latency of a slower
+// window, each window.
+const int baselineDriftDivisor = 32;
+
+uint32_t
+clampLimit(uint32_t limit, const AdaptiveConcurrencyLimitOptions& options) {
+  const uint32_t minimumLimit = std::max(options.minimumLimit, uint32_t(1));
+  const uint32_t maximumLimit = std::max(options.maximumLimit, minimumLimit);
+  return std::clamp(limit, minimumLimit, maximumLimit);
+}
+} // namespace
+
+AdaptiveConcurrencyLimit::AdaptiveConcurrencyLimit(
+    uint32_t initialLimit,
+    const AdaptiveConcurrencyLimitOptions& options) noexcept
+    : _limit(clampLimit(initialLimit, options)),
+      _mutex(),
+      _options(options),
+      _windowResponses(0),
+      _windowFailures(0),
+      _windowBytes(0),
+      _windowLatency(0),
+      _windowStart(),
+      _throughput(),
+      _baselineLatency() {}
+
+AdaptiveConcurrencyLimitOptions AdaptiveConcurrencyLimit::getOptions() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_options;
+}
+
+void AdaptiveConcurrencyLimit::setOptions(
+    const AdaptiveConcurrencyLimitOptions& options) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  this->_options = options;
+  this->_limit.store(
+      clampLimit(this->_limit.load(std::memory_order_relaxed), options),
+      std::memory_order_relaxed);
+}
+
+void AdaptiveConcurrencyLimit::recordResponse(
+    std::chrono::steady_clock::time_point requestTime,
+    std::chrono::steady_clock::time_point responseTime,
+    size_t bytes,
+    bool succeeded) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (!this->_windowStart) {
+    this->_windowStart = requestTime;
+  }
+
+  ++this->_windowResponses;
+  if (!succeeded) {
+    ++this->_windowFailures;
+  }
+  this->_windowBytes += bytes;
+  this->_windowLatency += responseTime - requestTime;
+
+  if (this->_windowResponses >= this->_limit.load(std::memory_order_relaxed)) {
+    this->finishWindow(responseTime);
+  }
+}
+
+void AdaptiveConcurrencyLimit::recordResponse(
+    const IAssetRequest& request,
+    std::chrono::steady_clock::time_point requestTime,
+    std::chrono::steady_clock::time_point responseTime) {
+  const IAssetResponse* pResponse = request.response();
+  if (!pResponse) {
+    this->recordResponse(requestTime, responseTime, 0, false);
+    return;
+  }
+
+  if (pResponse->isFromCache()) {
+    // The latency of a cache hit is that of the disk, not of the network, so
+    // it would make every later window look congested.
+    return;
+  }
+
+  const uint16_t statusCode = pResponse->statusCode();
+  this->recordResponse(
+      requestTime,
+      responseTime,
+      pResponse->data().size(),
+      statusCode != 429 && statusCode < 500);
+}
+
+std::optional<double> AdaptiveConcurrencyLimit::getThroughput() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_throughput;
+}
+
+std::optional<std::chrono::steady_clock::duration>
+AdaptiveConcurrencyLimit::getBaselineLatency() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_baselineLatency;
+}
+
+void AdaptiveConcurrencyLimit::finishWindow(
+    std::chrono::steady_clock::time_point responseTime) {
+  const std::chrono::steady_clock::duration meanLatency =
+      this->_windowLatency / this->_windowResponses;
+  const double seconds = std::chrono::duration<double>(
+                             responseTime - this->_windowStart.value())
+                             .count();
+  const double throughput =
+      seconds > 0.0 ? double(this->_windowBytes) / seconds : 0.0;
+
+  if (!this->_baselineLatency || meanLatency < *this->_baselineLatency) {
+    this->_baselineLatency = meanLatency;
+  }
+
+  const uint32_t limit = this->_limit.load(std::memory_order_relaxed);
+  const bool congested =
+      this->_windowFailures > 0 ||
+      std::chrono::duration<double>(meanLatency).count() >
+          this->_options.latencyTolerance *
+              std::chrono::duration<double>(*this->_baselineLatency).count();
+  if (congested) {
+    this->_limit.store(
+        clampLimit(
+            uint32_t(std::floor(double(limit) * this->_options.decreaseFactor)),
+            this->_options),
+        std::memory_order_relaxed);
+  } else if (
+      !this->_throughput ||
+      throughput >= throughputTolerance * *this->_throughput) {
+    this->_limit.store(
+        clampLimit(limit + 1, this->_options),
+        std::memory_order_relaxed);
+  }
+
+  // Moving the baseline after the comparison lets a lasting slowdown lower
+  // the limit before the baseline catches up with it.
+  *this->_baselineLatency +=
+      (meanLatency - *this->_baselineLatency) / baselineDriftDivisor;
+
+  this->_throughput = throughput;
+  this->_windowResponses = 0;
+  this->_windowFailures = 0;
+  this->_windowBytes = 0;
+  this->_windowLatency = std::chrono::steady_clock::duration(0);
+  this->_windowStart = responseTime;
+}
+
+} // namespace CesiumAsync
@@ -13,6 +13,11 @@ void AsyncSystem::dispatchMainThreadTasks() {
   this->_pSchedulers->mainThread.dispatchQueuedContinuations();
 }
 
+MainThreadDispatchResult
+AsyncSystem::dispatchMainThreadTasks(const MainThreadDispatchBudget& budget) {
+  return this->_pSchedulers->mainThread.dispatchQueuedContinuations(budget);
+}
+
 bool AsyncSystem::dispatchOneMainThreadTask() {
   return this->_pSchedulers->mainThread.dispatchZeroOrOneContinuation();
 }
@@ -11,55 +11,97 @@
 #include <algorithm>
 #include <cstddef>
 #include <iomanip>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace CesiumAsync {
 class CacheAssetResponse : public IAssetResponse {
 public:
-  CacheAssetResponse(const CacheItem* pCacheItem) noexcept
-      : _pCacheItem{pCacheItem} {}
+  CacheAssetResponse(
+      const CacheResponse* pCacheResponse,
+      const HttpHeaders* pHeaders,
+      bool isFromCache) noexcept
+      : _pCacheResponse{pCacheResponse},
+        _pHeaders{pHeaders},
+        _isFromCache{isFromCache} {}
 
   virtual uint16_t statusCode() const noexcept override {
-    return this->_pCacheItem->cacheResponse.statusCode;
+    return this->_pCacheResponse->statusCode;
   }
 
   virtual std::string contentType() const override {
-    auto it = this->_pCacheItem->cacheResponse.headers.find("Content-Type");
-    if (it == this->_pCacheItem->cacheResponse.headers.end()) {
+    auto it = this->_pHeaders->find("Content-Type");
+    if (it == this->_pHeaders->end()) {
       return std::string();
     }
     return it->second;
   }
 
   virtual const HttpHeaders& headers() const noexcept override {
-    return this->_pCacheItem->cacheResponse.headers;
+    return *this->_pHeaders;
   }
 
   virtual gsl::span<const std::byte> data() const noexcept override {
     return gsl::span<const std::byte>(
-        this->_pCacheItem->cacheResponse.data.data(),
-        this->_pCacheItem->cacheResponse.data.size());
+        this->_pCacheResponse->data.data(),
+        this->_pCacheResponse->data.size());
+  }
+
+  virtual bool isFromCache() const noexcept override {
+    return this->_isFromCache;
   }
 
 private:
-  const CacheItem* _pCacheItem;
+  const CacheResponse* _pCacheResponse;
+  const HttpHeaders* _pHeaders;
+  bool _isFromCache;
 };
 
+// A request served from the cache. The cache item may be shared with the
+// cache database, so its data is never copied or modified. Headers updated by
+// a revalidation are kept alongside it instead. Only a response that wasn't
+// revalidated is from the cache alone; a revalidated one waited for the
+// server.
 class CacheAssetRequest : public IAssetRequest {
 public:
-  CacheAssetRequest(CacheItem&& cacheItem)
-      : _cacheItem(std::move(cacheItem)), _response(&this->_cacheItem) {}
+  explicit CacheAssetRequest(std::shared_ptr<const CacheItem>&& pCacheItem)
+      : _pCacheItem(std::move(pCacheItem)),
+        _updatedHeaders(),
+        _updatedResponseHeaders(),
+        _response(
+            &this->_pCacheItem->cacheResponse,
+            &this->_pCacheItem->cacheResponse.headers,
+            true) {}
+
+  CacheAssetRequest(
+      std::shared_ptr<const CacheItem>&& pCacheItem,
+      HttpHeaders&& updatedHeaders,
+      HttpHeaders&& updatedResponseHeaders)
+      : _pCacheItem(std::move(pCacheItem)),
+        _updatedHeaders(std::move(updatedHeaders)),
+        _updatedResponseHeaders(std::move(updatedResponseHeaders)),
+        _response(
+            &this->_pCacheItem->cacheResponse,
+            &*this->_updatedResponseHeaders,
+            false) {}
 
   virtual const std::string& method() const noexcept override {
-    return this->_cacheItem.cacheRequest.method;
+    return this->_pCacheItem->cacheRequest.method;
   }
 
   virtual const std::string& url() const noexcept override {
-    return this->_cacheItem.cacheRequest.url;
+    return this->_pCacheItem->cacheRequest.url;
   }
 
   virtual const HttpHeaders& headers() const noexcept override {
-    return this->_cacheItem.cacheRequest.headers;
+    if (this->_updatedHeaders) {
+      return *this->_updatedHeaders;
+    }
+    return this->_pCacheItem->cacheRequest.headers;
   }
 
   virtual const IAssetResponse* response() const noexcept override {
@@ -67,7 +109,9 @@ public:
   }
 
 private:
-  CacheItem _cacheItem;
+  std::shared_ptr<const CacheItem> _pCacheItem;
+  std::optional<HttpHeaders> _updatedHeaders;
+  std::optional<HttpHeaders> _updatedResponseHeaders;
   CacheAssetResponse _response;
 };
 
@@ -77,30 +121,90 @@ static bool shouldRevalidateCache(const CacheItem& cacheItem);
 
 static bool isCacheStale(const CacheItem& cacheItem) noexcept;
 
+static bool canServeStale(const CacheItem& cacheItem);
+
+static Future<std::shared_ptr<IAssetRequest>> revalidateCacheItem(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
+    const ThreadPool& threadPool,
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    std::shared_ptr<const CacheItem>&& pCacheItem);
+
 static bool shouldCacheRequest(
     const IAssetRequest& request,
     const std::optional<ResponseCacheControl>& cacheControl);
 
 static std::string calculateCacheKey(const IAssetRequest& request);
 
+static std::string
+calculateCacheKey(const std::string& url, const std::string& range);
+
+static std::string
+findRangeHeader(const std::vector<IAssetAccessor::THeader>& headers);
+
+static bool
+requestsRevalidation(const std::vector<IAssetAccessor::THeader>& headers);
+
 static std::time_t calculateExpiryTime(
     const IAssetRequest& request,
     const std::optional<ResponseCacheControl>& cacheControl);
 
-static std::unique_ptr<IAssetRequest>
-updateCacheItem(CacheItem&& cacheItem, const IAssetRequest& request);
+static std::unique_ptr<IAssetRequest> updateCacheItem(
+    std::shared_ptr<const CacheItem>&& pCacheItem,
+    const IAssetRequest& request);
+
+static std::string calculateInFlightKey(
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers);
+
+// The gets that have not completed yet, by URL and headers. These are kept
+// apart from the accessor so that a get can complete after the accessor is
+// destroyed.
+struct CachingAssetAccessor::InFlightRequests {
+  struct Request {
+    AsyncSystem asyncSystem;
+    SharedFuture<std::shared_ptr<IAssetRequest>> future;
+  };
+
+  std::mutex mutex;
+  std::unordered_map<std::string, Request> requests;
+
+  // The gets whose stale cached responses are being revalidated in the
+  // background.
+  std::unordered_set<std::string> revalidations;
+
+  void remove(const std::string& key) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->requests.erase(key);
+  }
+
+  bool startRevalidation(const std::string& key) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->revalidations.insert(key).second;
+  }
+
+  void endRevalidation(const std::string& key) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->revalidations.erase(key);
+  }
+};
 
 CachingAssetAccessor::CachingAssetAccessor(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
     const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
-    int32_t requestsPerCachePrune)
+    int32_t requestsPerCachePrune,
+    CacheMode cacheMode)
     : _requestsPerCachePrune(requestsPerCachePrune),
       _requestSinceLastPrune(0),
+      _cacheMode(cacheMode),
       _pLogger(pLogger),
       _pAssetAccessor(pAssetAccessor),
       _pCacheDatabase(pCacheDatabase),
-      _cacheThreadPool(1) {}
+      _cacheThreadPool(1),
+      _pInFlightRequests(std::make_shared<InFlightRequests>()) {}
 
 CachingAssetAccessor::~CachingAssetAccessor() noexcept {}
 
@@ -120,6 +224,58 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::get(
     });
   }
 
+  // Share a get that is already in flight, unless it uses another async
+  // system, whose threads its continuations would otherwise run in.
+  std::string key = calculateInFlightKey(url, headers);
+  std::unique_lock<std::mutex> lock(this->_pInFlightRequests->mutex);
+  auto it = this->_pInFlightRequests->requests.find(key);
+  if (it != this->_pInFlightRequests->requests.end()) {
+    if (it->second.asyncSystem != asyncSystem) {
+      lock.unlock();
+      return this->getUncoalesced(asyncSystem, url, headers);
+    }
+
+    SharedFuture<std::shared_ptr<IAssetRequest>> inFlight = it->second.future;
+    lock.unlock();
+    return inFlight.thenImmediately(
+        [](const std::shared_ptr<IAssetRequest>& pRequest) {
+          return pRequest;
+        });
+  }
+
+  Promise<std::shared_ptr<IAssetRequest>> promise =
+      asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+  SharedFuture<std::shared_ptr<IAssetRequest>> future =
+      promise.getFuture().share();
+  this->_pInFlightRequests->requests.emplace(
+      key,
+      InFlightRequests::Request{asyncSystem, future});
+  lock.unlock();
+
+  // The request is no longer in flight by the time its promise resolves, so a
+  // later get starts over with a fresh cache lookup.
+  std::shared_ptr<InFlightRequests> pInFlightRequests =
+      this->_pInFlightRequests;
+  this->getUncoalesced(asyncSystem, url, headers)
+      .thenImmediately(
+          [pInFlightRequests, key, promise](
+              std::shared_ptr<IAssetRequest>&& pRequest) {
+            pInFlightRequests->remove(key);
+            promise.resolve(std::move(pRequest));
+          })
+      .catchImmediately([pInFlightRequests, key, promise](std::exception&&) {
+        pInFlightRequests->remove(key);
+        promise.reject(std::current_exception());
+      });
+
+  return future.thenImmediately(
+      [](const std::shared_ptr<IAssetRequest>& pRequest) { return pRequest; });
+}
+
+Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::getUncoalesced(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
   CESIUM_TRACE_BEGIN_IN_TRACK("IAssetAccessor::get (cached)");
 
   const ThreadPool& threadPool = this->_cacheThreadPool;
@@ -131,12 +287,31 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::get(
            pAssetAccessor = this->_pAssetAccessor,
            pCacheDatabase = this->_pCacheDatabase,
            pLogger = this->_pLogger,
+           pInFlightRequests = this->_pInFlightRequests,
+           cacheMode = this->_cacheMode.load(),
            url,
            headers,
            threadPool]() -> Future<std::shared_ptr<IAssetRequest>> {
-            std::optional<CacheItem> cacheLookup =
-                pCacheDatabase->getEntry(url);
-            if (!cacheLookup) {
+            const std::string range = findRangeHeader(headers);
+            const bool mustRevalidate = requestsRevalidation(headers);
+            std::shared_ptr<const CacheItem> pCacheItem =
+                pCacheDatabase->getSharedEntry(calculateCacheKey(url, range));
+
+            if (!pCacheItem && !range.empty() && !mustRevalidate) {
+              // A fresh copy of the whole asset includes the range. It's
+              // returned whole, as a server that ignores the range would.
+              std::shared_ptr<const CacheItem> pWholeItem =
+                  pCacheDatabase->getSharedEntry(url);
+              if (pWholeItem && pWholeItem->cacheResponse.statusCode == 200 &&
+                  (cacheMode == CacheMode::OfflineFirst ||
+                   !shouldRevalidateCache(*pWholeItem))) {
+                std::shared_ptr<IAssetRequest> pRequest =
+                    std::make_shared<CacheAssetRequest>(std::move(pWholeItem));
+                return asyncSystem.createResolvedFuture(std::move(pRequest));
+              }
+            }
+
+            if (!pCacheItem) {
               // No cache item found, request directly from the server
               return pAssetAccessor->get(asyncSystem, url, headers)
                   .thenInThreadPool(
@@ -173,78 +348,57 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::get(
                       });
             }
 
-            CacheItem& cacheItem = cacheLookup.value();
-
-            if (shouldRevalidateCache(cacheItem)) {
-              // Cache is stale and needs revalidation
-              std::vector<THeader> newHeaders = headers;
-              const CacheResponse& cacheResponse = cacheItem.cacheResponse;
-              const HttpHeaders& responseHeaders = cacheResponse.headers;
-              HttpHeaders::const_iterator etagHeader =
-                  responseHeaders.find("Etag");
-              if (etagHeader != responseHeaders.end()) {
-                newHeaders.emplace_back("If-None-Match", etagHeader->second);
-              } else {
-                HttpHeaders::const_iterator lastModifiedHeader =
-                    responseHeaders.find("Last-Modified");
-                if (lastModifiedHeader != responseHeaders.end())
-                  newHeaders.emplace_back(
-                      "If-Modified-Since",
-                      lastModifiedHeader->second);
+            if (mustRevalidate ||
+                (cacheMode != CacheMode::OfflineFirst &&
+                 shouldRevalidateCache(*pCacheItem))) {
+              if (mustRevalidate || cacheMode == CacheMode::Revalidate ||
+                  !canServeStale(*pCacheItem)) {
+                return revalidateCacheItem(
+                    asyncSystem,
+                    pAssetAccessor,
+                    pCacheDatabase,
+                    threadPool,
+                    url,
+                    headers,
+                    std::move(pCacheItem));
               }
 
-              return pAssetAccessor->get(asyncSystem, url, newHeaders)
-                  .thenInThreadPool(
-                      threadPool,
-                      [cacheItem = std::move(cacheItem),
-                       pCacheDatabase,
-                       pLogger](std::shared_ptr<IAssetRequest>&&
-                                    pCompletedRequest) mutable {
-                        if (!pCompletedRequest) {
-                          return std::move(pCompletedRequest);
-                        }
-
-                        std::shared_ptr<IAssetRequest> pRequestToStore;
-                        if (pCompletedRequest->response()->statusCode() ==
-                            304) { // status Not-Modified
-                          pRequestToStore = updateCacheItem(
-                              std::move(cacheItem),
-                              *pCompletedRequest);
-                        } else {
-                          pRequestToStore = pCompletedRequest;
-                        }
-
-                        const IAssetResponse* pResponseToStore =
-                            pRequestToStore->response();
-                        const std::optional<ResponseCacheControl> cacheControl =
-                            ResponseCacheControl::parseFromResponseHeaders(
-                                pResponseToStore->headers());
-
-                        if (shouldCacheRequest(
-                                *pRequestToStore,
-                                cacheControl)) {
-
-                          pCacheDatabase->storeEntry(
-                              calculateCacheKey(*pRequestToStore),
-                              calculateExpiryTime(
-                                  *pRequestToStore,
-                                  cacheControl),
-                              pRequestToStore->url(),
-                              pRequestToStore->method(),
-                              pRequestToStore->headers(),
-                              pResponseToStore->statusCode(),
-                              pResponseToStore->headers(),
-                              pResponseToStore->data());
-                        }
-
-                        return pRequestToStore;
-                      });
+              // Return the stale item now, and update the cache for later
+              // gets. A revalidation that is already running for the same get
+              // isn't started again.
+              std::string key = calculateInFlightKey(url, headers);
+              if (pInFlightRequests->startRevalidation(key)) {
+                revalidateCacheItem(
+                    asyncSystem,
+                    pAssetAccessor,
+                    pCacheDatabase,
+                    threadPool,
+                    url,
+                    headers,
+                    std::shared_ptr<const CacheItem>(pCacheItem))
+                    .thenImmediately(
+                        [pInFlightRequests,
+                         key](std::shared_ptr<IAssetRequest>&&) {
+                          pInFlightRequests->endRevalidation(key);
+                        })
+                    .catchImmediately(
+                        [pInFlightRequests, key, pLogger, url](
+                            std::exception&& e) {
+                          pInFlightRequests->endRevalidation(key);
+                          SPDLOG_LOGGER_WARN(
+                              pLogger,
+                              "Failed to revalidate the cached response for "
+                              "{}: {}",
+                              url,
+                              e.what());
+                        });
+              }
             }
 
             // Good cache item that doesn't need to be revalidated, just return
             // it.
             std::shared_ptr<IAssetRequest> pRequest =
-                std::make_shared<CacheAssetRequest>(std::move(cacheItem));
+                std::make_shared<CacheAssetRequest>(std::move(pCacheItem));
             return asyncSystem.createResolvedFuture(std::move(pRequest));
           })
       .thenImmediately([](std::shared_ptr<IAssetRequest>&& pRequest) noexcept {
@@ -265,6 +419,88 @@ Future<std::shared_ptr<IAssetRequest>> CachingAssetAccessor::request(
 
 void CachingAssetAccessor::tick() noexcept { _pAssetAccessor->tick(); }
 
+CacheMode CachingAssetAccessor::getCacheMode() const noexcept {
+  return this->_cacheMode;
+}
+
+void CachingAssetAccessor::setCacheMode(CacheMode cacheMode) noexcept {
+  this->_cacheMode = cacheMode;
+}
+
+Future<std::shared_ptr<IAssetRequest>> revalidateCacheItem(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<ICacheDatabase>& pCacheDatabase,
+    const ThreadPool& threadPool,
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    std::shared_ptr<const CacheItem>&& pCacheItem) {
+  std::vector<IAssetAccessor::THeader> newHeaders = headers;
+  const CacheResponse& cacheResponse = pCacheItem->cacheResponse;
+  const HttpHeaders& responseHeaders = cacheResponse.headers;
+  HttpHeaders::const_iterator etagHeader = responseHeaders.find("Etag");
+  if (etagHeader != responseHeaders.end()) {
+    newHeaders.emplace_back("If-None-Match", etagHeader->second);
+  } else {
+    HttpHeaders::const_iterator lastModifiedHeader =
+        responseHeaders.find("Last-Modified");
+    if (lastModifiedHeader != responseHeaders.end())
+      newHeaders.emplace_back("If-Modified-Since", lastModifiedHeader->second);
+  }
+
+  return pAssetAccessor->get(asyncSystem, url, newHeaders)
+      .thenInThreadPool(
+          threadPool,
+          [pCacheItem = std::move(pCacheItem), pCacheDatabase](
+              std::shared_ptr<IAssetRequest>&& pCompletedRequest) mutable {
+            if (!pCompletedRequest) {
+              return std::move(pCompletedRequest);
+            }
+
+            std::shared_ptr<IAssetRequest> pRequestToStore;
+            if (pCompletedRequest->response()->statusCode() ==
+                304) { // status Not-Modified
+              pRequestToStore =
+                  updateCacheItem(std::move(pCacheItem), *pCompletedRequest);
+            } else {
+              pRequestToStore = pCompletedRequest;
+            }
+
+            const IAssetResponse* pResponseToStore =
+                pRequestToStore->response();
+            const std::optional<ResponseCacheControl> cacheControl =
+                ResponseCacheControl::parseFromResponseHeaders(
+                    pResponseToStore->headers());
+
+            if (shouldCacheRequest(*pRequestToStore, cacheControl)) {
+              pCacheDatabase->storeEntry(
+                  calculateCacheKey(*pRequestToStore),
+                  calculateExpiryTime(*pRequestToStore, cacheControl),
+                  pRequestToStore->url(),
+                  pRequestToStore->method(),
+                  pRequestToStore->headers(),
+                  pResponseToStore->statusCode(),
+                  pResponseToStore->headers(),
+                  pResponseToStore->data());
+            }
+
+            return pRequestToStore;
+          });
+}
+
+bool canServeStale(const CacheItem& cacheItem) {
+  //
+  // https://developer.mozilla.org/en-US/docs/Web/HTTP/Headers/Cache-Control
+  //
+  // A response with the no-cache or must-revalidate directive must not be
+  // used once it is stale without asking the server first.
+  std::optional<ResponseCacheControl> cacheControl =
+      ResponseCacheControl::parseFromResponseHeaders(
+          cacheItem.cacheResponse.headers);
+  return !cacheControl ||
+         (!cacheControl->noCache() && !cacheControl->mustRevalidate());
+}
+
 bool shouldRevalidateCache(const CacheItem& cacheItem) {
   std::optional<ResponseCacheControl> cacheControl =
       ResponseCacheControl::parseFromResponseHeaders(
@@ -298,7 +534,10 @@ bool shouldCacheRequest(
 
   // check if response status code is cacheable
   const uint16_t statusCode = pResponse->statusCode();
-  if (statusCode != 200 && // status OK
+  const bool isRangeRequest =
+      request.headers().find("Range") != request.headers().end();
+  if (!(statusCode == 206 && isRangeRequest) && // status Partial Content
+      statusCode != 200 && // status OK
       statusCode != 201 && // status Created
       statusCode != 202 && // status Accepted
       statusCode != 203 && // status Non-Authoritive Information
@@ -364,7 +603,58 @@ bool shouldCacheRequest(
 
 std::string calculateCacheKey(const IAssetRequest& request) {
   // TODO: more complete cache key
-  return request.url();
+  const HttpHeaders& headers = request.headers();
+  HttpHeaders::const_iterator rangeHeader = headers.find("Range");
+  return calculateCacheKey(
+      request.url(),
+      rangeHeader == headers.end() ? std::string() : rangeHeader->second);
+}
+
+std::string
+calculateCacheKey(const std::string& url, const std::string& range) {
+  // Ranges are cached apart from the whole asset and from each other. URLs
+  // can't contain spaces, so a range's key can't be another asset's key.
+  if (range.empty()) {
+    return url;
+  }
+  return url + " " + range;
+}
+
+std::string
+findRangeHeader(const std::vector<IAssetAccessor::THeader>& headers) {
+  const CaseInsensitiveCompare compare;
+  for (const IAssetAccessor::THeader& header : headers) {
+    if (!compare(header.first, "Range") && !compare("Range", header.first)) {
+      return header.second;
+    }
+  }
+  return std::string();
+}
+
+bool requestsRevalidation(
+    const std::vector<IAssetAccessor::THeader>& headers) {
+  //
+  // https://developer.mozilla.org/en-US/docs/Web/HTTP/Headers/Cache-Control
+  //
+  // A request with the no-cache or max-age=0 directive must not be answered
+  // from the cache without asking the server whether it is still up to date.
+  const CaseInsensitiveCompare compare;
+  for (const IAssetAccessor::THeader& header : headers) {
+    if (compare(header.first, "Cache-Control") ||
+        compare("Cache-Control", header.first)) {
+      continue;
+    }
+
+    const std::optional<ResponseCacheControl> cacheControl =
+        ResponseCacheControl::parseFromResponseHeaders(
+            HttpHeaders{{header.first, header.second}});
+    if (cacheControl &&
+        (cacheControl->noCache() ||
+         (cacheControl->maxAgeExists() && cacheControl->maxAgeValue() == 0))) {
+      return true;
+    }
+  }
+  return false;
 }
 
 std::time_t calculateExpiryTime(
@@ -395,22 +685,43 @@ std::time_t calculateExpiryTime(
   }
 }
 
-std::unique_ptr<IAssetRequest>
-updateCacheItem(CacheItem&& cacheItem, const IAssetRequest& request) {
+std::unique_ptr<IAssetRequest> updateCacheItem(
+    std::shared_ptr<const CacheItem>&& pCacheItem,
+    const IAssetRequest& request) {
+  HttpHeaders requestHeaders = pCacheItem->cacheRequest.headers;
   for (const std::pair<const std::string, std::string>& header :
        request.headers()) {
-    cacheItem.cacheRequest.headers[header.first] = header.second;
+    requestHeaders[header.first] = header.second;
   }
 
+  HttpHeaders responseHeaders = pCacheItem->cacheResponse.headers;
   const IAssetResponse* pResponse = request.response();
   if (pResponse) {
     for (const std::pair<const std::string, std::string>& header :
          pResponse->headers()) {
-      cacheItem.cacheResponse.headers[header.first] = header.second;
+      responseHeaders[header.first] = header.second;
     }
   }
 
-  return std::make_unique<CacheAssetRequest>(std::move(cacheItem));
+  return std::make_unique<CacheAssetRequest>(
+      std::move(pCacheItem),
+      std::move(requestHeaders),
+      std::move(responseHeaders));
+}
+
+std::string calculateInFlightKey(
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers) {
+  // Header names and values can't contain line breaks, so these separators
+  // can't make two different gets look the same.
+  std::string key = url;
+  for (const IAssetAccessor::THeader& header : headers) {
+    key += "\r\n";
+    key += header.first;
+    key += ": ";
+    key += header.second;
+  }
+  return key;
 }
 
 std::time_t convertHttpDateToTime(const std::string& httpDate) {
@@ -2,6 +2,7 @@
 
 #include "CesiumAsync/AsyncSystem.h"
 #include "CesiumAsync/IAssetResponse.h"
+#include "CesiumUtility/Allocator.h"
 #include "CesiumUtility/Gunzip.h"
 
 namespace CesiumAsync {
@@ -34,9 +35,14 @@ public:
                             : this->_pAssetResponse->data();
   }
 
+  virtual bool isFromCache() const override {
+    return this->_pAssetResponse->isFromCache();
+  }
+
 private:
   const IAssetResponse* _pAssetResponse;
-  std::vector<std::byte> _gunzippedData;
+  CesiumUtility::ByteVector _gunzippedData{
+      CesiumUtility::AllocationCategory::DecompressedResponse};
   bool _dataValid;
 };
 
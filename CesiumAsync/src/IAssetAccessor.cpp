@@ -0,0 +1,122 @@
+#include "CesiumAsync/IAssetAccessor.h"
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetResponse.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace CesiumAsync {
+
+namespace {
+
+// A whole asset, reduced to a range of its bytes.
+class RangeAssetResponse : public IAssetResponse {
+public:
+  RangeAssetResponse(
+      const IAssetResponse* pOther,
+      uint64_t offset,
+      uint64_t length) noexcept
+      : _pAssetResponse{pOther}, _data() {
+    const gsl::span<const std::byte> data = this->_pAssetResponse->data();
+    const size_t start = static_cast<size_t>(std::min<uint64_t>(
+        offset,
+        static_cast<uint64_t>(data.size())));
+    const size_t end =
+        length == 0 ? data.size()
+                    : static_cast<size_t>(std::min<uint64_t>(
+                          offset + length,
+                          static_cast<uint64_t>(data.size())));
+    this->_data = data.subspan(start, end - start);
+  }
+
+  virtual uint16_t statusCode() const noexcept override { return 206; }
+
+  virtual std::string contentType() const override {
+    return this->_pAssetResponse->contentType();
+  }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_pAssetResponse->headers();
+  }
+
+  virtual gsl::span<const std::byte> data() const noexcept override {
+    return this->_data;
+  }
+
+  virtual bool isFromCache() const override {
+    return this->_pAssetResponse->isFromCache();
+  }
+
+private:
+  const IAssetResponse* _pAssetResponse;
+  gsl::span<const std::byte> _data;
+};
+
+class RangeAssetRequest : public IAssetRequest {
+public:
+  RangeAssetRequest(
+      std::shared_ptr<IAssetRequest>&& pOther,
+      uint64_t offset,
+      uint64_t length)
+      : _pAssetRequest(std::move(pOther)),
+        _assetResponse(this->_pAssetRequest->response(), offset, length) {}
+
+  virtual const std::string& method() const noexcept override {
+    return this->_pAssetRequest->method();
+  }
+
+  virtual const std::string& url() const noexcept override {
+    return this->_pAssetRequest->url();
+  }
+
+  virtual const HttpHeaders& headers() const noexcept override {
+    return this->_pAssetRequest->headers();
+  }
+
+  virtual const IAssetResponse* response() const noexcept override {
+    return &this->_assetResponse;
+  }
+
+private:
+  std::shared_ptr<IAssetRequest> _pAssetRequest;
+  RangeAssetResponse _assetResponse;
+};
+
+} // namespace
+
+Future<std::shared_ptr<IAssetRequest>> IAssetAccessor::getRange(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    uint64_t offset,
+    uint64_t length,
+    const std::vector<THeader>& headers) {
+  std::string range = "bytes=" + std::to_string(offset) + "-";
+  if (length > 0) {
+    range += std::to_string(offset + length - 1);
+  }
+
+  std::vector<THeader> rangeHeaders = headers;
+  rangeHeaders.emplace_back("Range", std::move(range));
+
+  return this->get(asyncSystem, url, rangeHeaders)
+      .thenImmediately(
+          [offset, length](std::shared_ptr<IAssetRequest>&& pRequest)
+              -> std::shared_ptr<IAssetRequest> {
+            // A status of 0 is the whole asset from an accessor that isn't
+            // HTTP.
+            const IAssetResponse* pResponse =
+                pRequest ? pRequest->response() : nullptr;
+            if (!pResponse || (pResponse->statusCode() != 200 &&
+                               pResponse->statusCode() != 0)) {
+              return std::move(pRequest);
+            }
+            return std::make_shared<RangeAssetRequest>(
+                std::move(pRequest),
+                offset,
+                length);
+          });
+}
+
+} // namespace CesiumAsync
@@ -0,0 +1,185 @@
+#include "CesiumAsync/MemoryCache.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <ctime>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace CesiumAsync {
+
+namespace {
+size_t getHeadersSize(const HttpHeaders& headers) {
+  size_t size = 0;
+  for (const auto& [name, value] : headers) {
+    size += name.size() + value.size();
+  }
+  return size;
+}
+
+// The approximate number of bytes used by a cache item. Only the strings and
+// the response data are counted, because they're most of it.
+size_t getCacheItemSize(const CacheItem& item) {
+  const CacheRequest& request = item.cacheRequest;
+  const CacheResponse& response = item.cacheResponse;
+  return sizeof(CacheItem) + request.method.size() + request.url.size() +
+         getHeadersSize(request.headers) + getHeadersSize(response.headers) +
+         response.data.size();
+}
+} // namespace
+
+MemoryCache::MemoryCache(
+    std::shared_ptr<ICacheDatabase> pDatabase,
+    size_t maximumSize)
+    : _pDatabase(std::move(pDatabase)),
+      _maximumSize(maximumSize),
+      _mutex(),
+      _entries(),
+      _entriesByKey(),
+      _currentSize(0) {}
+
+std::optional<CacheItem> MemoryCache::getEntry(const std::string& key) const {
+  std::shared_ptr<const CacheItem> pCacheItem = this->getSharedEntry(key);
+  if (!pCacheItem) {
+    return std::nullopt;
+  }
+  return *pCacheItem;
+}
+
+std::shared_ptr<const CacheItem>
+MemoryCache::getSharedEntry(const std::string& key) const {
+  CESIUM_TRACE("MemoryCache::getSharedEntry");
+  {
+    std::lock_guard<std::mutex> guard(this->_mutex);
+    auto it = this->_entriesByKey.find(key);
+    if (it != this->_entriesByKey.end()) {
+      // Move the entry to the front, as the most recently used.
+      this->_entries.splice(this->_entries.begin(), this->_entries, it->second);
+      return it->second->pCacheItem;
+    }
+  }
+
+  std::shared_ptr<const CacheItem> pCacheItem =
+      this->_pDatabase->getSharedEntry(key);
+  if (!pCacheItem) {
+    return nullptr;
+  }
+
+  // If the entry was stored while it was read, the stored one is newer.
+  return this->keep(key, std::move(pCacheItem), false);
+}
+
+bool MemoryCache::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  CESIUM_TRACE("MemoryCache::storeEntry");
+  const bool stored = this->_pDatabase->storeEntry(
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      responseData);
+
+  // Keep the entry even if the database couldn't store it, because it's
+  // still the latest response.
+  this->keep(
+      key,
+      std::make_shared<const CacheItem>(
+          expiryTime,
+          CacheRequest(
+              HttpHeaders(requestHeaders),
+              std::string(requestMethod),
+              std::string(url)),
+          CacheResponse(
+              statusCode,
+              HttpHeaders(responseHeaders),
+              std::vector<std::byte>(
+                  responseData.begin(),
+                  responseData.end()))),
+      true);
+
+  return stored;
+}
+
+bool MemoryCache::prune() {
+  CESIUM_TRACE("MemoryCache::prune");
+  {
+    // Drop the expired entries, which the database prunes too.
+    const std::time_t now = std::time(nullptr);
+    std::lock_guard<std::mutex> guard(this->_mutex);
+    auto it = this->_entries.begin();
+    while (it != this->_entries.end()) {
+      auto next = std::next(it);
+      if (it->pCacheItem->expiryTime < now) {
+        this->forget(it);
+      }
+      it = next;
+    }
+  }
+
+  return this->_pDatabase->prune();
+}
+
+bool MemoryCache::clearAll() {
+  {
+    std::lock_guard<std::mutex> guard(this->_mutex);
+    this->_entries.clear();
+    this->_entriesByKey.clear();
+    this->_currentSize = 0;
+  }
+
+  return this->_pDatabase->clearAll();
+}
+
+size_t MemoryCache::getCurrentSize() const {
+  std::lock_guard<std::mutex> guard(this->_mutex);
+  return this->_currentSize;
+}
+
+std::shared_ptr<const CacheItem> MemoryCache::keep(
+    const std::string& key,
+    std::shared_ptr<const CacheItem>&& pItem,
+    bool replaceExisting) const {
+  const size_t size = getCacheItemSize(*pItem);
+
+  std::lock_guard<std::mutex> guard(this->_mutex);
+  auto it = this->_entriesByKey.find(key);
+  if (it != this->_entriesByKey.end()) {
+    if (!replaceExisting) {
+      return it->second->pCacheItem;
+    }
+    this->forget(it->second);
+  }
+
+  if (size > this->_maximumSize) {
+    return std::move(pItem);
+  }
+
+  // Make room by dropping the least recently used entries.
+  while (this->_currentSize + size > this->_maximumSize) {
+    this->forget(std::prev(this->_entries.end()));
+  }
+
+  this->_entries.push_front(Entry{key, std::move(pItem), size});
+  this->_entriesByKey.emplace(key, this->_entries.begin());
+  this->_currentSize += size;
+  return this->_entries.front().pCacheItem;
+}
+
+void MemoryCache::forget(std::list<Entry>::iterator it) const {
+  this->_currentSize -= it->size;
+  this->_entriesByKey.erase(it->key);
+  this->_entries.erase(it);
+}
+
+} // namespace CesiumAsync
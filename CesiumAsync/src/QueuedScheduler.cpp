@@ -1,7 +1,14 @@
 #include "CesiumAsync/Impl/QueuedScheduler.h"
 
+#include "CesiumAsync/TaskPriority.h"
+
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
+#include <optional>
+#include <vector>
 
 // Hackily use Async++'s internal fifo_queue. We could copy it instead - it's
 // not much code - but why create the duplication? However, we are assuming that
@@ -12,9 +19,34 @@
 
 namespace CesiumAsync::CesiumImpl {
 
+namespace {
+struct PrioritizedContinuation {
+  async::task_run_handle task;
+  CesiumAsync::TaskPriority priority;
+  // Continuations with the same priority run in the order they were queued.
+  uint64_t sequence;
+
+  // Orders a heap so that its top is the continuation that runs first.
+  bool operator<(const PrioritizedContinuation& rhs) const noexcept {
+    if (rhs.priority.runsBefore(this->priority)) {
+      return true;
+    }
+    if (this->priority.runsBefore(rhs.priority)) {
+      return false;
+    }
+    return this->sequence > rhs.sequence;
+  }
+};
+} // namespace
+
 struct QueuedScheduler::Impl {
   async::detail::fifo_queue queue;
-  std::mutex mutex;
+  // Continuations scheduled in a priority scope run before the others, in
+  // order of priority.
+  std::vector<PrioritizedContinuation> prioritized;
+  uint64_t nextSequence = 0;
+  size_t queuedCount = 0;
+  mutable std::mutex mutex;
   std::condition_variable conditionVariable;
 };
 
@@ -22,8 +54,20 @@ QueuedScheduler::QueuedScheduler() : _pImpl(std::make_unique<Impl>()) {}
 QueuedScheduler::~QueuedScheduler() = default;
 
 void QueuedScheduler::schedule(async::task_run_handle t) {
+  const std::optional<CesiumAsync::TaskPriority> priority =
+      CesiumAsync::TaskPriorityScope::getCurrent();
+
   std::unique_lock<std::mutex> guard(this->_pImpl->mutex);
-  this->_pImpl->queue.push(std::move(t));
+  if (priority) {
+    std::vector<PrioritizedContinuation>& prioritized =
+        this->_pImpl->prioritized;
+    prioritized.push_back(
+        {std::move(t), *priority, this->_pImpl->nextSequence++});
+    std::push_heap(prioritized.begin(), prioritized.end());
+  } else {
+    this->_pImpl->queue.push(std::move(t));
+  }
+  ++this->_pImpl->queuedCount;
 
   // Notify listeners that there is new work.
   this->_pImpl->conditionVariable.notify_all();
@@ -34,22 +78,69 @@ void QueuedScheduler::dispatchQueuedContinuations() {
   }
 }
 
+MainThreadDispatchResult QueuedScheduler::dispatchQueuedContinuations(
+    const MainThreadDispatchBudget& budget) {
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+
+  MainThreadDispatchResult result;
+  while (this->dispatchInternal(false)) {
+    ++result.tasksDispatched;
+    if (budget.maximumTasks &&
+        result.tasksDispatched >= *budget.maximumTasks) {
+      break;
+    }
+    if (budget.timeLimit &&
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+                .count() >= *budget.timeLimit) {
+      break;
+    }
+  }
+
+  result.tasksRemaining = this->getQueuedContinuationCount();
+  return result;
+}
+
+size_t QueuedScheduler::getQueuedContinuationCount() const {
+  std::unique_lock<std::mutex> guard(this->_pImpl->mutex);
+  return this->_pImpl->queuedCount;
+}
+
 bool QueuedScheduler::dispatchZeroOrOneContinuation() {
   return this->dispatchInternal(false);
 }
 
 bool QueuedScheduler::dispatchInternal(bool blockIfNoTasks) {
   async::task_run_handle t;
+  std::optional<CesiumAsync::TaskPriority> priority;
 
   {
     std::unique_lock<std::mutex> guard(this->_pImpl->mutex);
-    t = this->_pImpl->queue.pop();
-    if (blockIfNoTasks && !t) {
+    std::vector<PrioritizedContinuation>& prioritized =
+        this->_pImpl->prioritized;
+    if (!prioritized.empty()) {
+      std::pop_heap(prioritized.begin(), prioritized.end());
+      t = std::move(prioritized.back().task);
+      priority = prioritized.back().priority;
+      prioritized.pop_back();
+    } else {
+      t = this->_pImpl->queue.pop();
+    }
+
+    if (t) {
+      --this->_pImpl->queuedCount;
+    } else if (blockIfNoTasks) {
       this->_pImpl->conditionVariable.wait(guard);
     }
   }
 
   if (t) {
+    // Run the continuation in its priority scope, so that the work it
+    // schedules inherits the priority.
+    std::optional<CesiumAsync::TaskPriorityScope> priorityScope;
+    if (priority) {
+      priorityScope.emplace(*priority);
+    }
     auto scope = this->immediate.scope();
     t.run();
     return true;
@@ -0,0 +1,324 @@
+#include "CesiumAsync/SchedulingAssetAccessor.h"
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/Promise.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CesiumAsync {
+
+// The hosts and their queued requests. These are kept apart from the accessor
+// so that a request can complete, and start the next one, after the accessor
+// is destroyed.
+struct SchedulingAssetAccessor::Scheduler {
+  struct QueuedRequest {
+    AsyncSystem asyncSystem;
+    std::string verb;
+    std::string url;
+    std::vector<THeader> headers;
+    std::vector<std::byte> contentPayload;
+    std::optional<TaskPriority> priority;
+    uint64_t sequenceNumber;
+    Promise<std::shared_ptr<IAssetRequest>> promise;
+  };
+
+  struct Host {
+    std::optional<size_t> maximumRequests;
+    size_t activeRequests = 0;
+    std::vector<QueuedRequest> queuedRequests;
+  };
+
+  Scheduler(
+      const std::shared_ptr<IAssetAccessor>& pUnderlyingAssetAccessor,
+      size_t maximumRequests)
+      : pAssetAccessor(pUnderlyingAssetAccessor),
+        maximumRequestsPerHost(maximumRequests),
+        mutex(),
+        hosts(),
+        nextSequenceNumber(0) {}
+
+  std::shared_ptr<IAssetAccessor> pAssetAccessor;
+  size_t maximumRequestsPerHost;
+
+  // Guards the members below.
+  mutable std::mutex mutex;
+  std::unordered_map<std::string, Host> hosts;
+  uint64_t nextSequenceNumber;
+
+  size_t getMaximumRequests(const Host& host) const {
+    return host.maximumRequests.value_or(this->maximumRequestsPerHost);
+  }
+
+  // Determines whether a queued request should start before another.
+  static bool startsBefore(const QueuedRequest& lhs, const QueuedRequest& rhs);
+
+  static Future<std::shared_ptr<IAssetRequest>> schedule(
+      const std::shared_ptr<Scheduler>& pScheduler,
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload);
+
+  static Future<std::shared_ptr<IAssetRequest>> start(
+      const std::shared_ptr<Scheduler>& pScheduler,
+      const std::string& hostName,
+      const AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload);
+
+  static void startQueuedRequests(
+      const std::shared_ptr<Scheduler>& pScheduler,
+      const std::string& hostName);
+};
+
+/*static*/ bool SchedulingAssetAccessor::Scheduler::startsBefore(
+    const QueuedRequest& lhs,
+    const QueuedRequest& rhs) {
+  if (lhs.priority && rhs.priority) {
+    if (lhs.priority->runsBefore(*rhs.priority)) {
+      return true;
+    }
+    if (rhs.priority->runsBefore(*lhs.priority)) {
+      return false;
+    }
+  } else if (lhs.priority || rhs.priority) {
+    return lhs.priority.has_value();
+  }
+
+  return lhs.sequenceNumber < rhs.sequenceNumber;
+}
+
+/*static*/ Future<std::shared_ptr<IAssetRequest>>
+SchedulingAssetAccessor::Scheduler::schedule(
+    const std::shared_ptr<Scheduler>& pScheduler,
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  std::string hostName = SchedulingAssetAccessor::getHost(url);
+  {
+    std::lock_guard<std::mutex> lock(pScheduler->mutex);
+    Host& host = pScheduler->hosts[hostName];
+    if (host.activeRequests >= pScheduler->getMaximumRequests(host)) {
+      Promise<std::shared_ptr<IAssetRequest>> promise =
+          asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+      Future<std::shared_ptr<IAssetRequest>> future = promise.getFuture();
+      host.queuedRequests.emplace_back(QueuedRequest{
+          asyncSystem,
+          verb,
+          url,
+          headers,
+          std::vector<std::byte>(contentPayload.begin(), contentPayload.end()),
+          TaskPriorityScope::getCurrent(),
+          pScheduler->nextSequenceNumber++,
+          std::move(promise)});
+      return future;
+    }
+    ++host.activeRequests;
+  }
+
+  return start(
+      pScheduler,
+      hostName,
+      asyncSystem,
+      verb,
+      url,
+      headers,
+      contentPayload);
+}
+
+/*static*/ Future<std::shared_ptr<IAssetRequest>>
+SchedulingAssetAccessor::Scheduler::start(
+    const std::shared_ptr<Scheduler>& pScheduler,
+    const std::string& hostName,
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  Future<std::shared_ptr<IAssetRequest>> future =
+      verb == "GET" ? pScheduler->pAssetAccessor->get(asyncSystem, url, headers)
+                    : pScheduler->pAssetAccessor->request(
+                          asyncSystem,
+                          verb,
+                          url,
+                          headers,
+                          contentPayload);
+
+  // When the request completes, successfully or not, its slot goes to the
+  // next queued request for the host.
+  auto finish = [pScheduler, hostName]() {
+    {
+      std::lock_guard<std::mutex> lock(pScheduler->mutex);
+      --pScheduler->hosts[hostName].activeRequests;
+    }
+    startQueuedRequests(pScheduler, hostName);
+  };
+
+  return std::move(future)
+      .thenImmediately(
+          [finish](std::shared_ptr<IAssetRequest>&& pRequest) {
+            finish();
+            return std::move(pRequest);
+          })
+      .catchImmediately(
+          [finish](std::exception&&) -> std::shared_ptr<IAssetRequest> {
+            finish();
+            std::rethrow_exception(std::current_exception());
+          });
+}
+
+/*static*/ void SchedulingAssetAccessor::Scheduler::startQueuedRequests(
+    const std::shared_ptr<Scheduler>& pScheduler,
+    const std::string& hostName) {
+  std::vector<QueuedRequest> requestsToStart;
+  {
+    std::lock_guard<std::mutex> lock(pScheduler->mutex);
+    auto hostIt = pScheduler->hosts.find(hostName);
+    if (hostIt == pScheduler->hosts.end()) {
+      return;
+    }
+
+    Host& host = hostIt->second;
+    std::vector<QueuedRequest>& queued = host.queuedRequests;
+    while (!queued.empty() &&
+           host.activeRequests < pScheduler->getMaximumRequests(host)) {
+      auto bestIt = queued.begin();
+      for (auto it = queued.begin() + 1; it != queued.end(); ++it) {
+        if (startsBefore(*it, *bestIt)) {
+          bestIt = it;
+        }
+      }
+      requestsToStart.emplace_back(std::move(*bestIt));
+      queued.erase(bestIt);
+      ++host.activeRequests;
+    }
+
+    // Forget idle hosts, unless they have a limit of their own.
+    if (host.activeRequests == 0 && queued.empty() && !host.maximumRequests) {
+      pScheduler->hosts.erase(hostIt);
+    }
+  }
+
+  for (QueuedRequest& request : requestsToStart) {
+    start(
+        pScheduler,
+        hostName,
+        request.asyncSystem,
+        request.verb,
+        request.url,
+        request.headers,
+        request.contentPayload)
+        .thenImmediately(
+            [promise = request.promise](
+                std::shared_ptr<IAssetRequest>&& pRequest) {
+              promise.resolve(std::move(pRequest));
+            })
+        .catchImmediately([promise = request.promise](std::exception&&) {
+          promise.reject(std::current_exception());
+        });
+  }
+}
+
+SchedulingAssetAccessor::SchedulingAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    size_t maximumRequestsPerHost)
+    : _pScheduler(
+          std::make_shared<Scheduler>(pAssetAccessor, maximumRequestsPerHost)) {
+}
+
+SchedulingAssetAccessor::~SchedulingAssetAccessor() noexcept = default;
+
+Future<std::shared_ptr<IAssetRequest>> SchedulingAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return Scheduler::schedule(
+      this->_pScheduler,
+      asyncSystem,
+      "GET",
+      url,
+      headers,
+      gsl::span<const std::byte>());
+}
+
+Future<std::shared_ptr<IAssetRequest>> SchedulingAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return Scheduler::schedule(
+      this->_pScheduler,
+      asyncSystem,
+      verb,
+      url,
+      headers,
+      contentPayload);
+}
+
+void SchedulingAssetAccessor::tick() noexcept {
+  this->_pScheduler->pAssetAccessor->tick();
+}
+
+void SchedulingAssetAccessor::setMaximumRequestsForHost(
+    const std::string& host,
+    size_t maximumRequests) {
+  {
+    std::lock_guard<std::mutex> lock(this->_pScheduler->mutex);
+    this->_pScheduler->hosts[host].maximumRequests = maximumRequests;
+  }
+  Scheduler::startQueuedRequests(this->_pScheduler, host);
+}
+
+void SchedulingAssetAccessor::reprioritize(
+    const std::string& url,
+    const TaskPriority& priority) {
+  const std::string hostName = getHost(url);
+  std::lock_guard<std::mutex> lock(this->_pScheduler->mutex);
+  auto hostIt = this->_pScheduler->hosts.find(hostName);
+  if (hostIt == this->_pScheduler->hosts.end()) {
+    return;
+  }
+
+  for (Scheduler::QueuedRequest& request : hostIt->second.queuedRequests) {
+    if (request.url == url) {
+      request.priority = priority;
+    }
+  }
+}
+
+size_t
+SchedulingAssetAccessor::getQueuedRequestCount(const std::string& host) const {
+  std::lock_guard<std::mutex> lock(this->_pScheduler->mutex);
+  auto hostIt = this->_pScheduler->hosts.find(host);
+  if (hostIt == this->_pScheduler->hosts.end()) {
+    return 0;
+  }
+  return hostIt->second.queuedRequests.size();
+}
+
+/*static*/ std::string
+SchedulingAssetAccessor::getHost(const std::string& url) {
+  const size_t schemeEnd = url.find("://");
+  if (schemeEnd == std::string::npos) {
+    return std::string();
+  }
+
+  const size_t hostStart = schemeEnd + 3;
+  const size_t hostEnd = url.find_first_of("/?#", hostStart);
+  return url.substr(hostStart, hostEnd - hostStart);
+}
+
+} // namespace CesiumAsync
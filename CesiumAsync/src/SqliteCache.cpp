@@ -2,6 +2,8 @@
 
 #include "CesiumAsync/IAssetResponse.h"
 
+#include <CesiumUtility/Gunzip.h>
+#include <CesiumUtility/ScopeGuard.h>
 #include <CesiumUtility/Tracing.h>
 #include <cesium-sqlite3.h>
 
@@ -10,9 +12,22 @@
 #include <spdlog/spdlog.h>
 #include <sqlite3.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 using namespace CesiumAsync;
 
@@ -29,6 +44,10 @@ const std::string CACHE_TABLE_RESPONSE_DATA_COLUMN = "responseData";
 const std::string CACHE_TABLE_REQUEST_HEADER_COLUMN = "requestHeader";
 const std::string CACHE_TABLE_REQUEST_METHOD_COLUMN = "requestMethod";
 const std::string CACHE_TABLE_REQUEST_URL_COLUMN = "requestUrl";
+const std::string CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN = "responseDataFile";
+const std::string CACHE_TABLE_RESPONSE_DATA_SIZE_COLUMN = "responseDataSize";
+const std::string CACHE_TABLE_RESPONSE_DATA_ENCODING_COLUMN =
+    "responseDataEncoding";
 const std::string CACHE_TABLE_VIRTUAL_TOTAL_ITEMS_COLUMN = "totalItems";
 
 // Sql commands for setting up database
@@ -49,6 +68,38 @@ const std::string PRAGMA_SYNC_SQL = "PRAGMA synchronous=OFF";
 
 const std::string PRAGMA_PAGE_SIZE_SQL = "PRAGMA page_size=4096";
 
+// Sql commands for upgrading tables created by older versions
+const std::string GET_SCHEMA_VERSION_SQL = "PRAGMA user_version";
+
+const std::string UPGRADE_SCHEMA_TO_VERSION_1_SQL =
+    "ALTER TABLE " + CACHE_TABLE + " ADD COLUMN " +
+    CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN + " TEXT; " +
+    "CREATE INDEX IF NOT EXISTS " + CACHE_TABLE + "ResponseDataFileIndex ON " +
+    CACHE_TABLE + "(" + CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN + "); " +
+    "PRAGMA user_version=1";
+
+// The size of the data in files is the part of their names after the hash.
+const std::string UPGRADE_SCHEMA_TO_VERSION_2_SQL =
+    "ALTER TABLE " + CACHE_TABLE + " ADD COLUMN " +
+    CACHE_TABLE_RESPONSE_DATA_SIZE_COLUMN + " INTEGER NOT NULL DEFAULT 0; " +
+    "UPDATE " + CACHE_TABLE + " SET " + CACHE_TABLE_RESPONSE_DATA_SIZE_COLUMN +
+    " = CASE WHEN " + CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN +
+    " IS NULL THEN COALESCE(length(" + CACHE_TABLE_RESPONSE_DATA_COLUMN +
+    "), 0) ELSE CAST(substr(" + CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN +
+    ", instr(" + CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN +
+    ", '-') + 1) AS INTEGER) END; CREATE INDEX IF NOT EXISTS " + CACHE_TABLE +
+    "LastAccessedTimeIndex ON " + CACHE_TABLE + "(" +
+    CACHE_TABLE_LAST_ACCESSED_TIME_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_DATA_SIZE_COLUMN + "); " +
+    "CREATE INDEX IF NOT EXISTS " + CACHE_TABLE + "ExpiryTimeIndex ON " +
+    CACHE_TABLE + "(" + CACHE_TABLE_EXPIRY_TIME_COLUMN + "); " +
+    "PRAGMA user_version=2";
+
+const std::string UPGRADE_SCHEMA_TO_VERSION_3_SQL =
+    "ALTER TABLE " + CACHE_TABLE + " ADD COLUMN " +
+    CACHE_TABLE_RESPONSE_DATA_ENCODING_COLUMN +
+    " INTEGER NOT NULL DEFAULT 0; PRAGMA user_version=3";
+
 // Sql commands for getting entry from database
 const std::string GET_ENTRY_SQL =
     "SELECT rowid, " + CACHE_TABLE_EXPIRY_TIME_COLUMN + ", " +
@@ -57,7 +108,9 @@ const std::string GET_ENTRY_SQL =
     CACHE_TABLE_RESPONSE_DATA_COLUMN + ", " +
     CACHE_TABLE_REQUEST_HEADER_COLUMN + ", " +
     CACHE_TABLE_REQUEST_METHOD_COLUMN + ", " + CACHE_TABLE_REQUEST_URL_COLUMN +
-    " FROM " + CACHE_TABLE + " WHERE " + CACHE_TABLE_KEY_COLUMN + "=?";
+    ", " + CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_DATA_ENCODING_COLUMN + " FROM " + CACHE_TABLE +
+    " WHERE " + CACHE_TABLE_KEY_COLUMN + "=?";
 
 const std::string UPDATE_LAST_ACCESSED_TIME_SQL =
     "UPDATE " + CACHE_TABLE + " SET " + CACHE_TABLE_LAST_ACCESSED_TIME_COLUMN +
@@ -72,25 +125,50 @@ const std::string STORE_RESPONSE_SQL =
     CACHE_TABLE_RESPONSE_DATA_COLUMN + ", " +
     CACHE_TABLE_REQUEST_HEADER_COLUMN + ", " +
     CACHE_TABLE_REQUEST_METHOD_COLUMN + ", " + CACHE_TABLE_REQUEST_URL_COLUMN +
-    ", " + CACHE_TABLE_KEY_COLUMN + ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)";
-
-// Sql commands for prunning the database
+    ", " + CACHE_TABLE_KEY_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_DATA_SIZE_COLUMN + ", " +
+    CACHE_TABLE_RESPONSE_DATA_ENCODING_COLUMN +
+    ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+
+// Sql commands for prunning the database. Rows are selected and then deleted
+// one at a time, so that a batch of them can be deleted, and the size of the
+// data that they free is known.
 const std::string TOTAL_ITEMS_QUERY_SQL =
-    "SELECT COUNT(*) " + CACHE_TABLE_VIRTUAL_TOTAL_ITEMS_COLUMN + " FROM " +
+    "SELECT COUNT(*) " + CACHE_TABLE_VIRTUAL_TOTAL_ITEMS_COLUMN + ", " +
+    "COALESCE(SUM(" + CACHE_TABLE_RESPONSE_DATA_SIZE_COLUMN + "), 0) FROM " +
     CACHE_TABLE;
 
-const std::string DELETE_EXPIRED_ITEMS_SQL =
-    "DELETE FROM " + CACHE_TABLE + " WHERE " + CACHE_TABLE_EXPIRY_TIME_COLUMN +
-    " < strftime('%s','now')";
+const std::string SELECT_EXPIRED_ITEMS_SQL =
+    "SELECT rowid, " + CACHE_TABLE_RESPONSE_DATA_SIZE_COLUMN + " FROM " +
+    CACHE_TABLE + " WHERE " + CACHE_TABLE_EXPIRY_TIME_COLUMN +
+    " < strftime('%s','now') LIMIT ?";
 
-const std::string DELETE_LRU_ITEMS_SQL =
-    "DELETE FROM " + CACHE_TABLE + " WHERE rowid " + " IN (SELECT rowid FROM " +
+const std::string SELECT_LRU_ITEMS_SQL =
+    "SELECT rowid, " + CACHE_TABLE_RESPONSE_DATA_SIZE_COLUMN + " FROM " +
     CACHE_TABLE + " ORDER BY " + CACHE_TABLE_LAST_ACCESSED_TIME_COLUMN +
-    " ASC " + " LIMIT ?)";
+    " ASC LIMIT ?";
+
+const std::string DELETE_ITEM_SQL =
+    "DELETE FROM " + CACHE_TABLE + " WHERE rowid=?";
 
 // Sql commands for clean all items
 const std::string CLEAR_ALL_SQL = "DELETE FROM " + CACHE_TABLE;
 
+// Sql commands for removing response data files that are no longer used
+const std::string IS_DATA_FILE_REFERENCED_SQL =
+    "SELECT 1 FROM " + CACHE_TABLE + " WHERE " +
+    CACHE_TABLE_RESPONSE_DATA_FILE_COLUMN + "=? LIMIT 1";
+
+// Sql commands for writing a batch of items in one transaction
+const std::string BEGIN_TRANSACTION_SQL = "BEGIN TRANSACTION";
+
+const std::string COMMIT_TRANSACTION_SQL = "COMMIT TRANSACTION";
+
+// How the response data of a row is encoded. The values are stored in the
+// database, so they must not change.
+enum class ResponseDataEncoding : int { None = 0, Gzip = 1 };
+
 std::string convertHeadersToString(const HttpHeaders& headers) {
   rapidjson::Document document;
   rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
@@ -163,6 +241,218 @@ SqliteStatementPtr prepareStatement(
   return SqliteStatementPtr(pStmt);
 }
 
+// Names a response data file by its content, so that identical responses
+// share one file.
+std::string getDataFileName(const gsl::span<const std::byte>& data) {
+  // 64-bit FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (std::byte b : data) {
+    hash ^= static_cast<uint64_t>(b);
+    hash *= 1099511628211ULL;
+  }
+
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash << '-'
+       << std::dec << data.size();
+  return name.str();
+}
+
+std::optional<std::vector<std::byte>>
+readDataFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return std::nullopt;
+  }
+
+  const std::streamoff size = file.tellg();
+  if (size < 0) {
+    return std::nullopt;
+  }
+
+  std::vector<std::byte> data(static_cast<size_t>(size));
+  file.seekg(0);
+  if (!file.read(
+          reinterpret_cast<char*>(data.data()),
+          static_cast<std::streamsize>(size))) {
+    return std::nullopt;
+  }
+  return data;
+}
+
+// Stores response data in a file in the given directory, unless a file with
+// the same content is already there, and returns the name of the file. Returns
+// an empty string if the data should be stored in the database instead.
+std::string storeDataFile(
+    const std::filesystem::path& directory,
+    const gsl::span<const std::byte>& data,
+    const std::shared_ptr<spdlog::logger>& pLogger) {
+  std::string name = getDataFileName(data);
+  const std::filesystem::path path = directory / name;
+
+  std::error_code error;
+  if (std::filesystem::exists(path, error)) {
+    // The name is only a hash, so make sure that the content really is the
+    // same.
+    std::optional<std::vector<std::byte>> existing = readDataFile(path);
+    if (existing && std::equal(
+                        existing->begin(),
+                        existing->end(),
+                        data.begin(),
+                        data.end())) {
+      return name;
+    }
+    return std::string();
+  }
+
+  // Write to a temporary file first, so that a file with the final name is
+  // always complete.
+  std::filesystem::path temporaryPath = path;
+  temporaryPath += ".tmp";
+  {
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    file.write(
+        reinterpret_cast<const char*>(data.data()),
+        static_cast<std::streamsize>(data.size()));
+    if (!file) {
+      SPDLOG_LOGGER_ERROR(
+          pLogger,
+          "Unable to write response data file {}.",
+          temporaryPath.string());
+      return std::string();
+    }
+  }
+
+  std::filesystem::rename(temporaryPath, path, error);
+  if (error) {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "Unable to write response data file {}: {}",
+        path.string(),
+        error.message());
+    std::filesystem::remove(temporaryPath, error);
+    return std::string();
+  }
+
+  return name;
+}
+
+// A read-only connection, for getEntry.
+struct SqliteReader {
+  SqliteConnectionPtr pConnection;
+  SqliteStatementPtr pGetEntryStatement;
+};
+
+// Read-only connections that are not in use. SQLite in WAL mode lets each of
+// them read while the others read and while the cache's own connection
+// writes. Connections are opened as they're needed, so there are as many as
+// there have ever been concurrent reads.
+class SqliteReaderPool {
+public:
+  SqliteReaderPool(const std::string& databaseName)
+      : _databaseName(databaseName), _mutex(), _idle() {}
+
+  std::unique_ptr<SqliteReader>
+  acquire(const std::shared_ptr<spdlog::logger>& pLogger) {
+    {
+      std::lock_guard<std::mutex> guard(this->_mutex);
+      if (!this->_idle.empty()) {
+        std::unique_ptr<SqliteReader> pReader = std::move(this->_idle.back());
+        this->_idle.pop_back();
+        return pReader;
+      }
+    }
+
+    CESIUM_SQLITE(sqlite3*) pConnection = nullptr;
+    const int status = CESIUM_SQLITE(sqlite3_open_v2)(
+        this->_databaseName.c_str(),
+        &pConnection,
+        SQLITE_OPEN_READONLY,
+        nullptr);
+    SqliteConnectionPtr pConnectionWrapper(pConnection);
+    if (status != SQLITE_OK) {
+      SPDLOG_LOGGER_ERROR(pLogger, CESIUM_SQLITE(sqlite3_errstr)(status));
+      return nullptr;
+    }
+
+    try {
+      SqliteStatementPtr pGetEntryStatement =
+          prepareStatement(pConnectionWrapper, GET_ENTRY_SQL);
+      return std::make_unique<SqliteReader>(SqliteReader{
+          std::move(pConnectionWrapper),
+          std::move(pGetEntryStatement)});
+    } catch (const std::exception& e) {
+      SPDLOG_LOGGER_ERROR(pLogger, e.what());
+      return nullptr;
+    }
+  }
+
+  void release(std::unique_ptr<SqliteReader>&& pReader) {
+    std::lock_guard<std::mutex> guard(this->_mutex);
+    this->_idle.emplace_back(std::move(pReader));
+  }
+
+private:
+  std::string _databaseName;
+  std::mutex _mutex;
+  std::vector<std::unique_ptr<SqliteReader>> _idle;
+};
+
+void executeStatement(
+    const SqliteConnectionPtr& pConnection,
+    const std::string& sql,
+    const std::shared_ptr<spdlog::logger>& pLogger) {
+  char* error = nullptr;
+  const int status = CESIUM_SQLITE(sqlite3_exec)(
+      pConnection.get(),
+      sql.c_str(),
+      nullptr,
+      nullptr,
+      &error);
+  if (status != SQLITE_OK) {
+    SPDLOG_LOGGER_ERROR(pLogger, CESIUM_SQLITE(sqlite3_errstr)(status));
+  }
+  CESIUM_SQLITE(sqlite3_free)(error);
+}
+
+// Selects the rows of pSelect, whose first column is a rowid and whose second
+// is the size of a row's response data, until enough are selected to free
+// both the excess items and the excess size.
+int selectRowsToPrune(
+    CESIUM_SQLITE(sqlite3_stmt*) pSelect,
+    int64_t limit,
+    int64_t excessItems,
+    int64_t excessSize,
+    std::vector<int64_t>& rows) {
+  int status = CESIUM_SQLITE(sqlite3_reset)(pSelect);
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  status = CESIUM_SQLITE(sqlite3_bind_int64)(pSelect, 1, limit);
+  if (status != SQLITE_OK) {
+    return status;
+  }
+
+  int64_t selectedSize = 0;
+  status = SQLITE_ROW;
+  while (static_cast<int64_t>(rows.size()) < excessItems ||
+         selectedSize < excessSize) {
+    status = CESIUM_SQLITE(sqlite3_step)(pSelect);
+    if (status != SQLITE_ROW) {
+      break;
+    }
+    rows.emplace_back(CESIUM_SQLITE(sqlite3_column_int64)(pSelect, 0));
+    selectedSize += CESIUM_SQLITE(sqlite3_column_int64)(pSelect, 1);
+  }
+
+  CESIUM_SQLITE(sqlite3_reset)(pSelect);
+
+  if (status != SQLITE_ROW && status != SQLITE_DONE) {
+    return status;
+  }
+  return SQLITE_OK;
+}
+
 } // namespace
 
 namespace CesiumAsync {
@@ -171,39 +461,179 @@ struct SqliteCache::Impl {
   Impl(
       const std::shared_ptr<spdlog::logger>& pLogger,
       const std::string& databaseName,
-      uint64_t maxItems)
+      uint64_t maxItems,
+      uint64_t maxSize,
+      size_t dataFileThreshold,
+      bool compressResponseData)
       : _pLogger(pLogger),
         _pConnection(nullptr),
         _databaseName(databaseName),
         _maxItems(maxItems),
-        _getEntryStmtWrapper(),
+        _maxSize(maxSize),
+        _dataDirectory(databaseName + "-data"),
+        _dataFileThreshold(dataFileThreshold),
+        _compressResponseData(compressResponseData),
         _updateLastAccessedTimeStmtWrapper(),
         _storeResponseStmtWrapper(),
         _totalItemsQueryStmtWrapper(),
-        _deleteExpiredStmtWrapper(),
-        _deleteLRUStmtWrapper(),
-        _clearAllStmtWrapper() {}
+        _selectExpiredStmtWrapper(),
+        _selectLRUStmtWrapper(),
+        _deleteItemStmtWrapper(),
+        _clearAllStmtWrapper(),
+        _isDataFileReferencedStmtWrapper(),
+        _pReaders(std::make_shared<SqliteReaderPool>(databaseName)) {}
 
   std::shared_ptr<spdlog::logger> _pLogger;
   SqliteConnectionPtr _pConnection;
   std::string _databaseName;
   uint64_t _maxItems;
+  uint64_t _maxSize;
+
+  // Where response data of at least _dataFileThreshold bytes is stored, one
+  // file per distinct response. Data files are read even if the threshold is
+  // 0, in case they were stored by another instance.
+  std::filesystem::path _dataDirectory;
+  size_t _dataFileThreshold;
+
+  // Response data is read whichever way it was stored, so that a database can
+  // be opened with compression on or off.
+  bool _compressResponseData;
+
   mutable std::mutex _mutex;
-  SqliteStatementPtr _getEntryStmtWrapper;
   SqliteStatementPtr _updateLastAccessedTimeStmtWrapper;
   SqliteStatementPtr _storeResponseStmtWrapper;
   SqliteStatementPtr _totalItemsQueryStmtWrapper;
-  SqliteStatementPtr _deleteExpiredStmtWrapper;
-  SqliteStatementPtr _deleteLRUStmtWrapper;
+  SqliteStatementPtr _selectExpiredStmtWrapper;
+  SqliteStatementPtr _selectLRUStmtWrapper;
+  SqliteStatementPtr _deleteItemStmtWrapper;
   SqliteStatementPtr _clearAllStmtWrapper;
+  SqliteStatementPtr _isDataFileReferencedStmtWrapper;
+
+  // Shared with any getEntry that is reading when a corrupt database is
+  // destroyed.
+  std::shared_ptr<SqliteReaderPool> _pReaders;
+};
+
+// The entries that have been stored but not yet written to the database, and
+// the thread that writes them. This is kept apart from the Impl, which is
+// replaced when a corrupt database is destroyed.
+struct SqliteCache::WriteBehind {
+  WriteBehind(size_t writeBatchSize, double writeBatchInterval)
+      : batchSize(writeBatchSize),
+        batchInterval(writeBatchInterval),
+        mutex(),
+        wakeWriter(),
+        pending(),
+        writing(),
+        accessed(),
+        stopping(false),
+        writeMutex(),
+        writer() {}
+
+  size_t batchSize;
+  std::chrono::duration<double, std::milli> batchInterval;
+
+  // Guards pending, writing, accessed and stopping.
+  std::mutex mutex;
+  std::condition_variable wakeWriter;
+
+  // Entries waiting for the next batch, and the entries in the batch that is
+  // being written. getEntry looks in both before the database. The entries
+  // are shared with getSharedEntry callers, so they must not be modified.
+  std::unordered_map<std::string, std::shared_ptr<const CacheItem>> pending;
+  std::unordered_map<std::string, std::shared_ptr<const CacheItem>> writing;
+
+  // The rows that getEntry has read, whose last accessed times are updated
+  // along with the next batch.
+  std::vector<int64_t> accessed;
+
+  bool stopping;
+
+  bool hasWork() const {
+    return !this->pending.empty() || !this->accessed.empty();
+  }
+
+  // Held while a batch is written, so that batches are written in order.
+  std::mutex writeMutex;
+  std::thread writer;
+};
+
+// The thread that prunes the database in batches, so that the database isn't
+// locked for long, when asked to by prune.
+struct SqliteCache::Pruner {
+  Pruner(size_t pruneBatchSize, double pruneBatchInterval)
+      : batchSize(pruneBatchSize),
+        batchInterval(pruneBatchInterval),
+        mutex(),
+        wakePruner(),
+        requested(false),
+        stopping(false),
+        pruner() {}
+
+  size_t batchSize;
+  std::chrono::duration<double, std::milli> batchInterval;
+
+  // Guards requested and stopping.
+  std::mutex mutex;
+  std::condition_variable wakePruner;
+  bool requested;
+  bool stopping;
+
+  // Waits between batches. Returns false if the cache is being destroyed
+  // instead.
+  bool waitForNextBatch() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    return !this->wakePruner.wait_for(lock, this->batchInterval, [this]() {
+      return this->stopping;
+    });
+  }
+
+  std::thread pruner;
 };
 
 SqliteCache::SqliteCache(
     const std::shared_ptr<spdlog::logger>& pLogger,
     const std::string& databaseName,
-    uint64_t maxItems)
-    : _pImpl(std::make_unique<Impl>(pLogger, databaseName, maxItems)) {
+    uint64_t maxItems,
+    size_t writeBatchSize,
+    double writeBatchInterval,
+    size_t dataFileThreshold,
+    uint64_t maxSize,
+    size_t pruneBatchSize,
+    double pruneBatchInterval,
+    bool compressResponseData)
+    : _pImpl(std::make_unique<Impl>(
+          pLogger,
+          databaseName,
+          maxItems,
+          maxSize,
+          dataFileThreshold,
+          compressResponseData)),
+      _pWriteBehind(),
+      _pPruner() {
   createConnection();
+
+  if (dataFileThreshold > 0) {
+    std::error_code error;
+    std::filesystem::create_directories(this->_pImpl->_dataDirectory, error);
+    if (error) {
+      throw std::runtime_error(error.message());
+    }
+  }
+
+  if (writeBatchSize > 0) {
+    this->_pWriteBehind =
+        std::make_unique<WriteBehind>(writeBatchSize, writeBatchInterval);
+    this->_pWriteBehind->writer =
+        std::thread([this]() { this->writePendingEntriesUntilStopped(); });
+  }
+
+  if (pruneBatchSize > 0) {
+    this->_pPruner =
+        std::make_unique<Pruner>(pruneBatchSize, pruneBatchInterval);
+    this->_pPruner->pruner =
+        std::thread([this]() { this->pruneEntriesUntilStopped(); });
+  }
 }
 
 void SqliteCache::createConnection() const {
@@ -233,6 +663,64 @@ void SqliteCache::createConnection() const {
     throw std::runtime_error(errorStr);
   }
 
+  // upgrade tables created by older versions
+  int schemaVersion = 0;
+  {
+    SqliteStatementPtr pGetSchemaVersion =
+        prepareStatement(this->_pImpl->_pConnection, GET_SCHEMA_VERSION_SQL);
+    status = CESIUM_SQLITE(sqlite3_step)(pGetSchemaVersion.get());
+    if (status != SQLITE_ROW) {
+      throw std::runtime_error(CESIUM_SQLITE(sqlite3_errstr)(status));
+    }
+    schemaVersion =
+        CESIUM_SQLITE(sqlite3_column_int)(pGetSchemaVersion.get(), 0);
+  }
+
+  if (schemaVersion < 1) {
+    char* upgradeError = nullptr;
+    status = CESIUM_SQLITE(sqlite3_exec)(
+        this->_pImpl->_pConnection.get(),
+        UPGRADE_SCHEMA_TO_VERSION_1_SQL.c_str(),
+        nullptr,
+        nullptr,
+        &upgradeError);
+    if (status != SQLITE_OK) {
+      std::string errorStr(upgradeError);
+      CESIUM_SQLITE(sqlite3_free)(upgradeError);
+      throw std::runtime_error(errorStr);
+    }
+  }
+
+  if (schemaVersion < 2) {
+    char* upgradeError = nullptr;
+    status = CESIUM_SQLITE(sqlite3_exec)(
+        this->_pImpl->_pConnection.get(),
+        UPGRADE_SCHEMA_TO_VERSION_2_SQL.c_str(),
+        nullptr,
+        nullptr,
+        &upgradeError);
+    if (status != SQLITE_OK) {
+      std::string errorStr(upgradeError);
+      CESIUM_SQLITE(sqlite3_free)(upgradeError);
+      throw std::runtime_error(errorStr);
+    }
+  }
+
+  if (schemaVersion < 3) {
+    char* upgradeError = nullptr;
+    status = CESIUM_SQLITE(sqlite3_exec)(
+        this->_pImpl->_pConnection.get(),
+        UPGRADE_SCHEMA_TO_VERSION_3_SQL.c_str(),
+        nullptr,
+        nullptr,
+        &upgradeError);
+    if (status != SQLITE_OK) {
+      std::string errorStr(upgradeError);
+      CESIUM_SQLITE(sqlite3_free)(upgradeError);
+      throw std::runtime_error(errorStr);
+    }
+  }
+
   // turn on WAL mode
   char* walError = nullptr;
   status = CESIUM_SQLITE(sqlite3_exec)(
@@ -275,10 +763,6 @@ void SqliteCache::createConnection() const {
     throw std::runtime_error(errorStr);
   }
 
-  // get entry based on key
-  this->_pImpl->_getEntryStmtWrapper =
-      prepareStatement(this->_pImpl->_pConnection, GET_ENTRY_SQL);
-
   // update last accessed for entry
   this->_pImpl->_updateLastAccessedTimeStmtWrapper = prepareStatement(
       this->_pImpl->_pConnection,
@@ -292,28 +776,115 @@ void SqliteCache::createConnection() const {
   this->_pImpl->_totalItemsQueryStmtWrapper =
       prepareStatement(this->_pImpl->_pConnection, TOTAL_ITEMS_QUERY_SQL);
 
-  // delete expired items
-  this->_pImpl->_deleteExpiredStmtWrapper =
-      prepareStatement(this->_pImpl->_pConnection, DELETE_EXPIRED_ITEMS_SQL);
+  // select expired items
+  this->_pImpl->_selectExpiredStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, SELECT_EXPIRED_ITEMS_SQL);
+
+  // select least recently used items
+  this->_pImpl->_selectLRUStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, SELECT_LRU_ITEMS_SQL);
 
-  // delete expired items
-  this->_pImpl->_deleteLRUStmtWrapper =
-      prepareStatement(this->_pImpl->_pConnection, DELETE_LRU_ITEMS_SQL);
+  // delete an item
+  this->_pImpl->_deleteItemStmtWrapper =
+      prepareStatement(this->_pImpl->_pConnection, DELETE_ITEM_SQL);
 
   // clear all items
   this->_pImpl->_clearAllStmtWrapper =
       prepareStatement(this->_pImpl->_pConnection, CLEAR_ALL_SQL);
+
+  // check whether a response data file is in use
+  this->_pImpl->_isDataFileReferencedStmtWrapper = prepareStatement(
+      this->_pImpl->_pConnection,
+      IS_DATA_FILE_REFERENCED_SQL);
 }
 
-SqliteCache::~SqliteCache() = default;
+SqliteCache::~SqliteCache() {
+  // Stop pruning first, because the pruner writes pending entries.
+  if (this->_pPruner) {
+    {
+      std::lock_guard<std::mutex> guard(this->_pPruner->mutex);
+      this->_pPruner->stopping = true;
+    }
+    this->_pPruner->wakePruner.notify_one();
+    this->_pPruner->pruner.join();
+  }
+
+  if (this->_pWriteBehind) {
+    {
+      std::lock_guard<std::mutex> guard(this->_pWriteBehind->mutex);
+      this->_pWriteBehind->stopping = true;
+    }
+    this->_pWriteBehind->wakeWriter.notify_one();
+    this->_pWriteBehind->writer.join();
+
+    // Write whatever was stored after the last batch.
+    this->writePendingEntries();
+  }
+}
 
 std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
   CESIUM_TRACE("SqliteCache::getEntry");
-  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+  std::shared_ptr<const CacheItem> pPending = this->findPendingEntry(key);
+  if (pPending) {
+    return *pPending;
+  }
+
+  return this->readEntry(key);
+}
+
+std::shared_ptr<const CacheItem>
+SqliteCache::getSharedEntry(const std::string& key) const {
+  CESIUM_TRACE("SqliteCache::getSharedEntry");
+  std::shared_ptr<const CacheItem> pPending = this->findPendingEntry(key);
+  if (pPending) {
+    return pPending;
+  }
+
+  std::optional<CacheItem> cacheItem = this->readEntry(key);
+  if (!cacheItem) {
+    return nullptr;
+  }
+  return std::make_shared<const CacheItem>(std::move(*cacheItem));
+}
+
+std::shared_ptr<const CacheItem>
+SqliteCache::findPendingEntry(const std::string& key) const {
+  if (!this->_pWriteBehind) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> guard(this->_pWriteBehind->mutex);
+  auto it = this->_pWriteBehind->pending.find(key);
+  if (it != this->_pWriteBehind->pending.end()) {
+    return it->second;
+  }
+
+  it = this->_pWriteBehind->writing.find(key);
+  if (it != this->_pWriteBehind->writing.end()) {
+    return it->second;
+  }
+
+  return nullptr;
+}
+
+std::optional<CacheItem> SqliteCache::readEntry(const std::string& key) const {
+  std::shared_ptr<SqliteReaderPool> pReaders = this->_pImpl->_pReaders;
+  std::unique_ptr<SqliteReader> pReader =
+      pReaders->acquire(this->_pImpl->_pLogger);
+  if (!pReader) {
+    return std::nullopt;
+  }
+  CESIUM_SQLITE(sqlite3_stmt*) pGetEntry = pReader->pGetEntryStatement.get();
+
+  // Reset the statement before the connection is reused, so that it doesn't
+  // keep reading an old snapshot of the database, nor hold back checkpoints.
+  CesiumUtility::ScopeGuard releaseReader{[&pReaders, &pReader, pGetEntry]() {
+    CESIUM_SQLITE(sqlite3_reset)(pGetEntry);
+    pReaders->release(std::move(pReader));
+  }};
 
   // get entry based on key
-  int status =
-      CESIUM_SQLITE(sqlite3_reset)(this->_pImpl->_getEntryStmtWrapper.get());
+  int status = CESIUM_SQLITE(sqlite3_reset)(pGetEntry);
   if (status != SQLITE_OK) {
     SPDLOG_LOGGER_ERROR(
         this->_pImpl->_pLogger,
@@ -321,8 +892,7 @@ std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
     return std::nullopt;
   }
 
-  status = CESIUM_SQLITE(sqlite3_clear_bindings)(
-      this->_pImpl->_getEntryStmtWrapper.get());
+  status = CESIUM_SQLITE(sqlite3_clear_bindings)(pGetEntry);
   if (status != SQLITE_OK) {
     SPDLOG_LOGGER_ERROR(
         this->_pImpl->_pLogger,
@@ -331,7 +901,7 @@ std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
   }
 
   status = CESIUM_SQLITE(sqlite3_bind_text)(
-      this->_pImpl->_getEntryStmtWrapper.get(),
+      pGetEntry,
       1,
       key.c_str(),
       -1,
@@ -343,8 +913,7 @@ std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
     return std::nullopt;
   }
 
-  status =
-      CESIUM_SQLITE(sqlite3_step)(this->_pImpl->_getEntryStmtWrapper.get());
+  status = CESIUM_SQLITE(sqlite3_step)(pGetEntry);
   if (status == SQLITE_DONE) {
     // Cache miss
     return std::nullopt;
@@ -359,58 +928,109 @@ std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
   }
 
   // Cache hit - unpack and return it.
-  const int64_t itemIndex = CESIUM_SQLITE(
-      sqlite3_column_int64)(this->_pImpl->_getEntryStmtWrapper.get(), 0);
+  const int64_t itemIndex = CESIUM_SQLITE(sqlite3_column_int64)(pGetEntry, 0);
 
   // parse cache item metadata
-  const std::time_t expiryTime = CESIUM_SQLITE(
-      sqlite3_column_int64)(this->_pImpl->_getEntryStmtWrapper.get(), 1);
+  const std::time_t expiryTime =
+      CESIUM_SQLITE(sqlite3_column_int64)(pGetEntry, 1);
 
   // parse response cache
-  std::string serializedResponseHeaders =
-      reinterpret_cast<const char*>(CESIUM_SQLITE(
-          sqlite3_column_text)(this->_pImpl->_getEntryStmtWrapper.get(), 2));
+  std::string serializedResponseHeaders = reinterpret_cast<const char*>(
+      CESIUM_SQLITE(sqlite3_column_text)(pGetEntry, 2));
   std::optional<HttpHeaders> responseHeaders =
       convertStringToHeaders(serializedResponseHeaders, this->_pImpl->_pLogger);
   if (!responseHeaders) {
     return std::nullopt;
   }
-  const uint16_t statusCode = static_cast<uint16_t>(CESIUM_SQLITE(
-      sqlite3_column_int)(this->_pImpl->_getEntryStmtWrapper.get(), 3));
+  const uint16_t statusCode =
+      static_cast<uint16_t>(CESIUM_SQLITE(sqlite3_column_int)(pGetEntry, 3));
 
-  const std::byte* rawResponseData =
-      reinterpret_cast<const std::byte*>(CESIUM_SQLITE(
-          sqlite3_column_blob)(this->_pImpl->_getEntryStmtWrapper.get(), 4));
-  const int responseDataSize = CESIUM_SQLITE(
-      sqlite3_column_bytes)(this->_pImpl->_getEntryStmtWrapper.get(), 4);
+  const std::byte* rawResponseData = reinterpret_cast<const std::byte*>(
+      CESIUM_SQLITE(sqlite3_column_blob)(pGetEntry, 4));
+  const int responseDataSize =
+      CESIUM_SQLITE(sqlite3_column_bytes)(pGetEntry, 4);
   std::vector<std::byte> responseData(
       rawResponseData,
       rawResponseData + responseDataSize);
 
+  // The response data may be in a file instead.
+  if (CESIUM_SQLITE(sqlite3_column_type)(pGetEntry, 8) != SQLITE_NULL) {
+    std::string dataFileName = reinterpret_cast<const char*>(
+        CESIUM_SQLITE(sqlite3_column_text)(pGetEntry, 8));
+    std::optional<std::vector<std::byte>> fileData =
+        readDataFile(this->_pImpl->_dataDirectory / dataFileName);
+    if (!fileData) {
+      // The file was removed along with the entry, after the entry was read.
+      return std::nullopt;
+    }
+    responseData = std::move(*fileData);
+  }
+
+  if (CESIUM_SQLITE(sqlite3_column_int)(pGetEntry, 9) ==
+      static_cast<int>(ResponseDataEncoding::Gzip)) {
+    std::vector<std::byte> decompressedData;
+    if (!CesiumUtility::gunzip(responseData, decompressedData)) {
+      SPDLOG_LOGGER_ERROR(
+          this->_pImpl->_pLogger,
+          "Unable to decompress cached response data.");
+      return std::nullopt;
+    }
+    responseData = std::move(decompressedData);
+  }
+
   // parse request
-  std::string serializedRequestHeaders =
-      reinterpret_cast<const char*>(CESIUM_SQLITE(
-          sqlite3_column_text)(this->_pImpl->_getEntryStmtWrapper.get(), 5));
+  std::string serializedRequestHeaders = reinterpret_cast<const char*>(
+      CESIUM_SQLITE(sqlite3_column_text)(pGetEntry, 5));
   std::optional<HttpHeaders> requestHeaders =
       convertStringToHeaders(serializedRequestHeaders, this->_pImpl->_pLogger);
   if (!requestHeaders) {
     return std::nullopt;
   }
 
-  std::string requestMethod = reinterpret_cast<const char*>(CESIUM_SQLITE(
-      sqlite3_column_text)(this->_pImpl->_getEntryStmtWrapper.get(), 6));
+  std::string requestMethod = reinterpret_cast<const char*>(
+      CESIUM_SQLITE(sqlite3_column_text)(pGetEntry, 6));
 
-  std::string requestUrl = reinterpret_cast<const char*>(CESIUM_SQLITE(
-      sqlite3_column_text)(this->_pImpl->_getEntryStmtWrapper.get(), 7));
+  std::string requestUrl = reinterpret_cast<const char*>(
+      CESIUM_SQLITE(sqlite3_column_text)(pGetEntry, 7));
 
   // update the last accessed time
+  if (this->_pWriteBehind) {
+    bool isFirst;
+    {
+      std::lock_guard<std::mutex> guard(this->_pWriteBehind->mutex);
+      this->_pWriteBehind->accessed.emplace_back(itemIndex);
+      isFirst = this->_pWriteBehind->accessed.size() == 1;
+    }
+    if (isFirst) {
+      this->_pWriteBehind->wakeWriter.notify_one();
+    }
+  } else {
+    std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+    if (!this->updateLastAccessedTime(itemIndex)) {
+      return std::nullopt;
+    }
+  }
+
+  return CacheItem{
+      expiryTime,
+      CacheRequest{
+          std::move(*requestHeaders),
+          std::move(requestMethod),
+          std::move(requestUrl)},
+      CacheResponse{
+          statusCode,
+          std::move(*responseHeaders),
+          std::move(responseData)}};
+}
+
+bool SqliteCache::updateLastAccessedTime(int64_t itemIndex) const {
   int updateStatus = CESIUM_SQLITE(sqlite3_reset)(
       this->_pImpl->_updateLastAccessedTimeStmtWrapper.get());
   if (updateStatus != SQLITE_OK) {
     SPDLOG_LOGGER_ERROR(
         this->_pImpl->_pLogger,
         CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
-    return std::nullopt;
+    return false;
   }
 
   updateStatus = CESIUM_SQLITE(sqlite3_clear_bindings)(
@@ -419,7 +1039,7 @@ std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
     SPDLOG_LOGGER_ERROR(
         this->_pImpl->_pLogger,
         CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
-    return std::nullopt;
+    return false;
   }
 
   updateStatus = CESIUM_SQLITE(sqlite3_bind_int64)(
@@ -430,7 +1050,7 @@ std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
     SPDLOG_LOGGER_ERROR(
         this->_pImpl->_pLogger,
         CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
-    return std::nullopt;
+    return false;
   }
 
   updateStatus = CESIUM_SQLITE(sqlite3_step)(
@@ -439,19 +1059,10 @@ std::optional<CacheItem> SqliteCache::getEntry(const std::string& key) const {
     SPDLOG_LOGGER_ERROR(
         this->_pImpl->_pLogger,
         CESIUM_SQLITE(sqlite3_errstr)(updateStatus));
-    return std::nullopt;
+    return false;
   }
 
-  return CacheItem{
-      expiryTime,
-      CacheRequest{
-          std::move(*requestHeaders),
-          std::move(requestMethod),
-          std::move(requestUrl)},
-      CacheResponse{
-          statusCode,
-          std::move(*responseHeaders),
-          std::move(responseData)}};
+  return true;
 }
 
 bool SqliteCache::storeEntry(
@@ -464,8 +1075,54 @@ bool SqliteCache::storeEntry(
     const HttpHeaders& responseHeaders,
     const gsl::span<const std::byte>& responseData) {
   CESIUM_TRACE("SqliteCache::storeEntry");
-  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+  if (!this->_pWriteBehind) {
+    std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+    return this->writeEntry(
+        key,
+        expiryTime,
+        url,
+        requestMethod,
+        requestHeaders,
+        statusCode,
+        responseHeaders,
+        responseData);
+  }
 
+  std::shared_ptr<const CacheItem> pItem = std::make_shared<const CacheItem>(
+      expiryTime,
+      CacheRequest(
+          HttpHeaders(requestHeaders),
+          std::string(requestMethod),
+          std::string(url)),
+      CacheResponse(
+          statusCode,
+          HttpHeaders(responseHeaders),
+          std::vector<std::byte>(responseData.begin(), responseData.end())));
+
+  size_t pendingCount;
+  {
+    std::lock_guard<std::mutex> guard(this->_pWriteBehind->mutex);
+    this->_pWriteBehind->pending.insert_or_assign(key, std::move(pItem));
+    pendingCount = this->_pWriteBehind->pending.size();
+  }
+
+  // Wake the writer to start timing a new batch, or to write a full one.
+  if (pendingCount == 1 || pendingCount >= this->_pWriteBehind->batchSize) {
+    this->_pWriteBehind->wakeWriter.notify_one();
+  }
+
+  return true;
+}
+
+bool SqliteCache::writeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
   // cache the request with the key
   int status = CESIUM_SQLITE(sqlite3_reset)(
       this->_pImpl->_storeResponseStmtWrapper.get());
@@ -532,12 +1189,39 @@ bool SqliteCache::storeEntry(
     return false;
   }
 
-  status = CESIUM_SQLITE(sqlite3_bind_blob)(
-      this->_pImpl->_storeResponseStmtWrapper.get(),
-      5,
-      responseData.data(),
-      static_cast<int>(responseData.size()),
-      SQLITE_STATIC);
+  // compress the response data, unless that doesn't make it smaller
+  ResponseDataEncoding encoding = ResponseDataEncoding::None;
+  gsl::span<const std::byte> storedData = responseData;
+  std::vector<std::byte> compressedData;
+  if (this->_pImpl->_compressResponseData &&
+      CesiumUtility::gzip(responseData, compressedData) &&
+      compressedData.size() < responseData.size()) {
+    encoding = ResponseDataEncoding::Gzip;
+    storedData = compressedData;
+  }
+
+  // store large response data in a file, with only its name in the database
+  std::string dataFileName;
+  if (this->_pImpl->_dataFileThreshold > 0 &&
+      storedData.size() >= this->_pImpl->_dataFileThreshold) {
+    dataFileName = storeDataFile(
+        this->_pImpl->_dataDirectory,
+        storedData,
+        this->_pImpl->_pLogger);
+  }
+
+  if (dataFileName.empty()) {
+    status = CESIUM_SQLITE(sqlite3_bind_blob)(
+        this->_pImpl->_storeResponseStmtWrapper.get(),
+        5,
+        storedData.data(),
+        static_cast<int>(storedData.size()),
+        SQLITE_STATIC);
+  } else {
+    status = CESIUM_SQLITE(sqlite3_bind_null)(
+        this->_pImpl->_storeResponseStmtWrapper.get(),
+        5);
+  }
   if (status != SQLITE_OK) {
     SPDLOG_LOGGER_ERROR(
         this->_pImpl->_pLogger,
@@ -598,6 +1282,47 @@ bool SqliteCache::storeEntry(
     return false;
   }
 
+  if (dataFileName.empty()) {
+    status = CESIUM_SQLITE(sqlite3_bind_null)(
+        this->_pImpl->_storeResponseStmtWrapper.get(),
+        10);
+  } else {
+    status = CESIUM_SQLITE(sqlite3_bind_text)(
+        this->_pImpl->_storeResponseStmtWrapper.get(),
+        10,
+        dataFileName.c_str(),
+        -1,
+        SQLITE_STATIC);
+  }
+  if (status != SQLITE_OK) {
+    SPDLOG_LOGGER_ERROR(
+        this->_pImpl->_pLogger,
+        CESIUM_SQLITE(sqlite3_errstr)(status));
+    return false;
+  }
+
+  status = CESIUM_SQLITE(sqlite3_bind_int64)(
+      this->_pImpl->_storeResponseStmtWrapper.get(),
+      11,
+      static_cast<int64_t>(storedData.size()));
+  if (status != SQLITE_OK) {
+    SPDLOG_LOGGER_ERROR(
+        this->_pImpl->_pLogger,
+        CESIUM_SQLITE(sqlite3_errstr)(status));
+    return false;
+  }
+
+  status = CESIUM_SQLITE(sqlite3_bind_int)(
+      this->_pImpl->_storeResponseStmtWrapper.get(),
+      12,
+      static_cast<int>(encoding));
+  if (status != SQLITE_OK) {
+    SPDLOG_LOGGER_ERROR(
+        this->_pImpl->_pLogger,
+        CESIUM_SQLITE(sqlite3_errstr)(status));
+    return false;
+  }
+
   status = CESIUM_SQLITE(sqlite3_step)(
       this->_pImpl->_storeResponseStmtWrapper.get());
   if (status != SQLITE_DONE) {
@@ -613,13 +1338,134 @@ bool SqliteCache::storeEntry(
   return true;
 }
 
+void SqliteCache::writePendingEntries() {
+  CESIUM_TRACE("SqliteCache::writePendingEntries");
+  WriteBehind& writeBehind = *this->_pWriteBehind;
+  std::lock_guard<std::mutex> writeGuard(writeBehind.writeMutex);
+
+  std::vector<int64_t> accessed;
+  {
+    std::lock_guard<std::mutex> guard(writeBehind.mutex);
+    if (!writeBehind.hasWork()) {
+      return;
+    }
+    std::swap(writeBehind.pending, writeBehind.writing);
+    std::swap(writeBehind.accessed, accessed);
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+    executeStatement(
+        this->_pImpl->_pConnection,
+        BEGIN_TRANSACTION_SQL,
+        this->_pImpl->_pLogger);
+
+    for (const auto& [key, pItem] : writeBehind.writing) {
+      const CacheRequest& request = pItem->cacheRequest;
+      const CacheResponse& response = pItem->cacheResponse;
+      if (!this->writeEntry(
+              key,
+              pItem->expiryTime,
+              request.url,
+              request.method,
+              request.headers,
+              response.statusCode,
+              response.headers,
+              gsl::span<const std::byte>(response.data))) {
+        // The rest of the batch is lost, as the entries would be if they
+        // failed to store one at a time.
+        break;
+      }
+    }
+
+    for (int64_t itemIndex : accessed) {
+      this->updateLastAccessedTime(itemIndex);
+    }
+
+    executeStatement(
+        this->_pImpl->_pConnection,
+        COMMIT_TRANSACTION_SQL,
+        this->_pImpl->_pLogger);
+  }
+
+  std::lock_guard<std::mutex> guard(writeBehind.mutex);
+  writeBehind.writing.clear();
+}
+
+void SqliteCache::writePendingEntriesUntilStopped() {
+  WriteBehind& writeBehind = *this->_pWriteBehind;
+  std::unique_lock<std::mutex> lock(writeBehind.mutex);
+  while (!writeBehind.stopping) {
+    writeBehind.wakeWriter.wait(lock, [&writeBehind]() {
+      return writeBehind.stopping || writeBehind.hasWork();
+    });
+
+    // Let the batch fill, for a while.
+    writeBehind.wakeWriter.wait_for(
+        lock,
+        writeBehind.batchInterval,
+        [&writeBehind]() {
+          return writeBehind.stopping ||
+                 writeBehind.pending.size() >= writeBehind.batchSize;
+        });
+
+    lock.unlock();
+    this->writePendingEntries();
+    lock.lock();
+  }
+}
+
 bool SqliteCache::prune() {
   CESIUM_TRACE("SqliteCache::prune");
+  if (this->_pPruner) {
+    {
+      std::lock_guard<std::mutex> guard(this->_pPruner->mutex);
+      this->_pPruner->requested = true;
+    }
+    this->_pPruner->wakePruner.notify_one();
+    return true;
+  }
+
+  return this->pruneEntries();
+}
+
+bool SqliteCache::pruneEntries() {
+  if (this->_pWriteBehind) {
+    // Count pending entries, and make them available to prune.
+    this->writePendingEntries();
+  }
+
+  const size_t batchSize = this->_pPruner ? this->_pPruner->batchSize : 0;
+  bool succeeded = true;
+  bool finished = false;
+  while (!finished) {
+    succeeded = this->pruneBatch(batchSize, finished);
+    if (!succeeded) {
+      break;
+    }
+
+    if (!finished && this->_pPruner && !this->_pPruner->waitForNextBatch()) {
+      // The cache is being destroyed.
+      break;
+    }
+  }
+
+  // Remove the files of the entries that were pruned, and of any entries
+  // that were replaced since the last prune.
   std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+  this->removeUnreferencedDataFiles();
+
+  return succeeded;
+}
+
+bool SqliteCache::pruneBatch(size_t batchSize, bool& finished) {
+  std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
+  finished = true;
 
   int64_t totalItems = 0;
+  int64_t totalSize = 0;
 
-  // query total size of response's data
+  // query total number and size of response's data
   {
     int totalItemsQueryStatus = CESIUM_SQLITE(sqlite3_reset)(
         this->_pImpl->_totalItemsQueryStmtWrapper.get());
@@ -656,106 +1502,127 @@ bool SqliteCache::prune() {
       return false;
     }
 
-    // prune the rows if over maximum
     totalItems = CESIUM_SQLITE(sqlite3_column_int64)(
         this->_pImpl->_totalItemsQueryStmtWrapper.get(),
         0);
-    if (totalItems > 0 &&
-        totalItems <= static_cast<int64_t>(this->_pImpl->_maxItems)) {
-      return true;
-    }
+    totalSize = CESIUM_SQLITE(sqlite3_column_int64)(
+        this->_pImpl->_totalItemsQueryStmtWrapper.get(),
+        1);
+    CESIUM_SQLITE(sqlite3_reset)(
+        this->_pImpl->_totalItemsQueryStmtWrapper.get());
   }
 
-  // delete expired rows first
-  {
-    int deleteExpiredStatus = CESIUM_SQLITE(sqlite3_reset)(
-        this->_pImpl->_deleteExpiredStmtWrapper.get());
-    if (deleteExpiredStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteExpiredStatus));
-      return false;
-    }
-
-    deleteExpiredStatus = CESIUM_SQLITE(sqlite3_clear_bindings)(
-        this->_pImpl->_deleteExpiredStmtWrapper.get());
-    if (deleteExpiredStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteExpiredStatus));
-      return false;
-    }
+  // prune the rows if over maximum
+  const int64_t excessItems =
+      totalItems - static_cast<int64_t>(this->_pImpl->_maxItems);
+  const int64_t excessSize =
+      this->_pImpl->_maxSize > 0
+          ? totalSize - static_cast<int64_t>(this->_pImpl->_maxSize)
+          : 0;
+  if (totalItems == 0 || (excessItems <= 0 && excessSize <= 0)) {
+    return true;
+  }
 
-    deleteExpiredStatus = CESIUM_SQLITE(sqlite3_step)(
-        this->_pImpl->_deleteExpiredStmtWrapper.get());
-    if (deleteExpiredStatus != SQLITE_DONE) {
-      if (deleteExpiredStatus == SQLITE_CORRUPT) {
-        destroyDatabase();
-      }
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteExpiredStatus));
-      return false;
+  // A limit of -1 selects all of the rows.
+  const int64_t limit = batchSize > 0 ? static_cast<int64_t>(batchSize) : -1;
+
+  // select expired rows first, then rows LRU if none have expired
+  std::vector<int64_t> rowsToDelete;
+  int selectStatus = selectRowsToPrune(
+      this->_pImpl->_selectExpiredStmtWrapper.get(),
+      limit,
+      std::numeric_limits<int64_t>::max(),
+      std::numeric_limits<int64_t>::max(),
+      rowsToDelete);
+  if (selectStatus == SQLITE_OK && rowsToDelete.empty()) {
+    selectStatus = selectRowsToPrune(
+        this->_pImpl->_selectLRUStmtWrapper.get(),
+        limit,
+        excessItems,
+        excessSize,
+        rowsToDelete);
+  }
+  if (selectStatus != SQLITE_OK) {
+    if (selectStatus == SQLITE_CORRUPT) {
+      destroyDatabase();
     }
+    SPDLOG_LOGGER_ERROR(
+        this->_pImpl->_pLogger,
+        CESIUM_SQLITE(sqlite3_errstr)(selectStatus));
+    return false;
   }
 
-  // check if we should delete more
-  const int deletedRows =
-      CESIUM_SQLITE(sqlite3_changes)(this->_pImpl->_pConnection.get());
-  if (totalItems - deletedRows < static_cast<int>(this->_pImpl->_maxItems)) {
+  if (rowsToDelete.empty()) {
     return true;
   }
 
-  totalItems -= deletedRows;
-
-  // delete rows LRU if we are still over maximum
-  {
-    int deleteLLRUStatus =
-        CESIUM_SQLITE(sqlite3_reset)(this->_pImpl->_deleteLRUStmtWrapper.get());
-    if (deleteLLRUStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteLLRUStatus));
-      return false;
-    }
-
-    deleteLLRUStatus = CESIUM_SQLITE(sqlite3_clear_bindings)(
-        this->_pImpl->_deleteLRUStmtWrapper.get());
-    if (deleteLLRUStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteLLRUStatus));
-      return false;
-    }
-
-    deleteLLRUStatus = CESIUM_SQLITE(sqlite3_bind_int64)(
-        this->_pImpl->_deleteLRUStmtWrapper.get(),
-        1,
-        totalItems - static_cast<int64_t>(this->_pImpl->_maxItems));
-    if (deleteLLRUStatus != SQLITE_OK) {
-      SPDLOG_LOGGER_ERROR(
-          this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteLLRUStatus));
-      return false;
+  executeStatement(
+      this->_pImpl->_pConnection,
+      BEGIN_TRANSACTION_SQL,
+      this->_pImpl->_pLogger);
+
+  CESIUM_SQLITE(sqlite3_stmt*) pDeleteItem =
+      this->_pImpl->_deleteItemStmtWrapper.get();
+  for (int64_t row : rowsToDelete) {
+    CESIUM_SQLITE(sqlite3_reset)(pDeleteItem);
+    int deleteStatus = CESIUM_SQLITE(sqlite3_bind_int64)(pDeleteItem, 1, row);
+    if (deleteStatus == SQLITE_OK) {
+      deleteStatus = CESIUM_SQLITE(sqlite3_step)(pDeleteItem);
     }
-
-    deleteLLRUStatus =
-        CESIUM_SQLITE(sqlite3_step)(this->_pImpl->_deleteLRUStmtWrapper.get());
-    if (deleteLLRUStatus != SQLITE_DONE) {
-      if (deleteLLRUStatus == SQLITE_CORRUPT) {
+    if (deleteStatus != SQLITE_DONE) {
+      // Keep the rows that were deleted.
+      executeStatement(
+          this->_pImpl->_pConnection,
+          COMMIT_TRANSACTION_SQL,
+          this->_pImpl->_pLogger);
+      if (deleteStatus == SQLITE_CORRUPT) {
         destroyDatabase();
       }
       SPDLOG_LOGGER_ERROR(
           this->_pImpl->_pLogger,
-          CESIUM_SQLITE(sqlite3_errstr)(deleteLLRUStatus));
+          CESIUM_SQLITE(sqlite3_errstr)(deleteStatus));
       return false;
     }
   }
 
+  executeStatement(
+      this->_pImpl->_pConnection,
+      COMMIT_TRANSACTION_SQL,
+      this->_pImpl->_pLogger);
+
+  // Check again, in case more rows need to be deleted.
+  finished = false;
   return true;
 }
 
+void SqliteCache::pruneEntriesUntilStopped() {
+  Pruner& pruner = *this->_pPruner;
+  std::unique_lock<std::mutex> lock(pruner.mutex);
+  while (true) {
+    pruner.wakePruner.wait(lock, [&pruner]() {
+      return pruner.stopping || pruner.requested;
+    });
+    if (pruner.stopping) {
+      return;
+    }
+    pruner.requested = false;
+
+    lock.unlock();
+    this->pruneEntries();
+    lock.lock();
+  }
+}
+
 bool SqliteCache::clearAll() {
+  std::unique_lock<std::mutex> writeLock;
+  if (this->_pWriteBehind) {
+    // Drop the pending entries, after any batch being written is done.
+    writeLock = std::unique_lock<std::mutex>(this->_pWriteBehind->writeMutex);
+    std::lock_guard<std::mutex> pendingGuard(this->_pWriteBehind->mutex);
+    this->_pWriteBehind->pending.clear();
+    this->_pWriteBehind->accessed.clear();
+  }
+
   std::lock_guard<std::mutex> guard(this->_pImpl->_mutex);
 
   int status =
@@ -779,15 +1646,62 @@ bool SqliteCache::clearAll() {
     return false;
   }
 
+  this->removeUnreferencedDataFiles();
+
   return true;
 }
 
+void SqliteCache::removeUnreferencedDataFiles() {
+  std::error_code error;
+  std::filesystem::directory_iterator it(this->_pImpl->_dataDirectory, error);
+  if (error) {
+    // There are no data files.
+    return;
+  }
+
+  CESIUM_SQLITE(sqlite3_stmt*) pIsReferenced =
+      this->_pImpl->_isDataFileReferencedStmtWrapper.get();
+  for (; it != std::filesystem::directory_iterator(); it.increment(error)) {
+    const std::string name = it->path().filename().string();
+
+    CESIUM_SQLITE(sqlite3_reset)(pIsReferenced);
+    CESIUM_SQLITE(sqlite3_clear_bindings)(pIsReferenced);
+    int status = CESIUM_SQLITE(
+        sqlite3_bind_text)(pIsReferenced, 1, name.c_str(), -1, SQLITE_STATIC);
+    if (status == SQLITE_OK) {
+      status = CESIUM_SQLITE(sqlite3_step)(pIsReferenced);
+    }
+
+    if (status == SQLITE_DONE) {
+      std::error_code removeError;
+      std::filesystem::remove(it->path(), removeError);
+    } else if (status != SQLITE_ROW) {
+      // Keep the files, rather than remove any that are in use.
+      SPDLOG_LOGGER_ERROR(
+          this->_pImpl->_pLogger,
+          CESIUM_SQLITE(sqlite3_errstr)(status));
+      break;
+    }
+  }
+
+  CESIUM_SQLITE(sqlite3_reset)(pIsReferenced);
+}
+
 void SqliteCache::destroyDatabase() {
   std::shared_ptr<spdlog::logger> pLogger = _pImpl->_pLogger;
   std::string databaseName = _pImpl->_databaseName;
   uint64_t maxItems = _pImpl->_maxItems;
+  uint64_t maxSize = _pImpl->_maxSize;
+  size_t dataFileThreshold = _pImpl->_dataFileThreshold;
+  bool compressResponseData = _pImpl->_compressResponseData;
   _pImpl.reset();
-  _pImpl = std::make_unique<Impl>(pLogger, databaseName, maxItems);
+  _pImpl = std::make_unique<Impl>(
+      pLogger,
+      databaseName,
+      maxItems,
+      maxSize,
+      dataFileThreshold,
+      compressResponseData);
   if (remove(_pImpl->_databaseName.c_str()) != 0) {
     SPDLOG_LOGGER_ERROR(
         this->_pImpl->_pLogger,
@@ -0,0 +1,26 @@
+#include "CesiumAsync/TaskPriority.h"
+
+namespace CesiumAsync {
+namespace {
+std::optional<TaskPriority>& currentPriority() noexcept {
+  // A static local rather than a static field, for the same reason as in
+  // ImmediateScheduler.
+  static thread_local std::optional<TaskPriority> priority;
+  return priority;
+}
+} // namespace
+
+TaskPriorityScope::TaskPriorityScope(const TaskPriority& priority) noexcept
+    : _previous(currentPriority()) {
+  currentPriority() = priority;
+}
+
+TaskPriorityScope::~TaskPriorityScope() noexcept {
+  currentPriority() = this->_previous;
+}
+
+/*static*/ std::optional<TaskPriority>
+TaskPriorityScope::getCurrent() noexcept {
+  return currentPriority();
+}
+} // namespace CesiumAsync
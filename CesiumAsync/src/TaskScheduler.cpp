@@ -12,6 +12,10 @@ void TaskScheduler::schedule(async::task_run_handle t) {
   // So, we wrap it with a copyable type (shared_ptr).
   // https://riptutorial.com/cplusplus/example/1950/generalized-capture has
   // a good explanation of this problem.
+  //
+  // The shared_ptr also owns the handle if the task processor discards the
+  // function without calling it, so that the task is canceled rather than
+  // leaked.
 
   struct Receiver {
     async::task_run_handle taskHandle;
@@ -20,8 +24,23 @@ void TaskScheduler::schedule(async::task_run_handle t) {
   std::shared_ptr<Receiver> pReceiver = std::make_shared<Receiver>();
   pReceiver->taskHandle = std::move(t);
 
-  this->_pTaskProcessor->startTask([this, pReceiver]() mutable {
-    auto scope = this->immediate.scope();
-    pReceiver->taskHandle.run();
-  });
+  // Work scheduled in a priority scope is started with that priority, and runs
+  // in the same scope so that the work it schedules inherits the priority.
+  const std::optional<CesiumAsync::TaskPriority> priority =
+      CesiumAsync::TaskPriorityScope::getCurrent();
+  if (!priority) {
+    this->_pTaskProcessor->startTask([this, pReceiver]() mutable {
+      auto scope = this->immediate.scope();
+      pReceiver->taskHandle.run();
+    });
+    return;
+  }
+
+  this->_pTaskProcessor->startPrioritizedTask(
+      [this, pReceiver, priority = *priority]() mutable {
+        CesiumAsync::TaskPriorityScope priorityScope(priority);
+        auto scope = this->immediate.scope();
+        pReceiver->taskHandle.run();
+      },
+      *priority);
 }
@@ -0,0 +1,259 @@
+#include "CesiumAsync/WorkStealingTaskProcessor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+using namespace CesiumAsync;
+
+namespace {
+// Keeps the queues of different workers in different cache lines.
+constexpr size_t cacheLineSize = 64;
+
+struct alignas(cacheLineSize) WorkerQueue {
+  std::mutex mutex;
+  std::deque<std::function<void()>> tasks;
+};
+
+struct PrioritizedTask {
+  std::function<void()> task;
+  TaskPriority priority;
+
+  // Orders a heap so that its top is the task that runs first.
+  bool operator<(const PrioritizedTask& rhs) const noexcept {
+    return rhs.priority.runsBefore(this->priority);
+  }
+};
+
+void pinCurrentThreadToCore([[maybe_unused]] uint32_t core) noexcept {
+#if defined(__linux__)
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(core, &cpuSet);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#elif defined(_WIN32)
+  if (core < sizeof(DWORD_PTR) * 8) {
+    SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core);
+  }
+#endif
+}
+} // namespace
+
+struct WorkStealingTaskProcessor::Impl {
+  explicit Impl(uint32_t numberOfThreads) : queues(numberOfThreads) {}
+
+  void addTask(size_t queueIndex, std::function<void()>&& task);
+  void addPrioritizedTask(
+      std::function<void()>&& task,
+      const TaskPriority& priority);
+  void wakeWorker();
+  bool takeTask(size_t workerIndex, std::function<void()>& task);
+  void run(size_t workerIndex);
+
+  std::vector<WorkerQueue> queues;
+  std::vector<std::thread> threads;
+
+  // Tasks with a priority are shared by all workers, and run before the
+  // tasks in their queues.
+  std::mutex prioritizedMutex;
+  std::vector<PrioritizedTask> prioritizedTasks;
+  std::atomic<size_t> prioritizedTaskCount{0};
+
+  // The number of tasks that are queued. Workers only sleep when this is 0.
+  std::atomic<size_t> pendingTasks{0};
+  // Where the next task started by a thread that isn't a worker goes.
+  std::atomic<size_t> nextQueue{0};
+
+  std::mutex sleepMutex;
+  std::condition_variable wakeCondition;
+  std::atomic<uint32_t> sleepingWorkers{0};
+  bool stopping = false;
+};
+
+namespace {
+// The processor that the current thread is a worker of, if any, and the
+// index of its queue.
+thread_local const void* tpCurrentProcessor = nullptr;
+thread_local size_t tCurrentWorkerIndex = 0;
+} // namespace
+
+void WorkStealingTaskProcessor::Impl::addTask(
+    size_t queueIndex,
+    std::function<void()>&& task) {
+  // A worker that is going to sleep counts itself as sleeping before it
+  // checks for pending tasks, so either it sees this task or this sees it.
+  this->pendingTasks.fetch_add(1);
+
+  WorkerQueue& queue = this->queues[queueIndex];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.emplace_back(std::move(task));
+  }
+
+  this->wakeWorker();
+}
+
+void WorkStealingTaskProcessor::Impl::addPrioritizedTask(
+    std::function<void()>&& task,
+    const TaskPriority& priority) {
+  this->pendingTasks.fetch_add(1);
+
+  {
+    std::lock_guard<std::mutex> lock(this->prioritizedMutex);
+    this->prioritizedTasks.push_back({std::move(task), priority});
+    std::push_heap(
+        this->prioritizedTasks.begin(),
+        this->prioritizedTasks.end());
+    this->prioritizedTaskCount.fetch_add(1);
+  }
+
+  this->wakeWorker();
+}
+
+void WorkStealingTaskProcessor::Impl::wakeWorker() {
+  if (this->sleepingWorkers.load() > 0) {
+    std::lock_guard<std::mutex> lock(this->sleepMutex);
+    this->wakeCondition.notify_one();
+  }
+}
+
+bool WorkStealingTaskProcessor::Impl::takeTask(
+    size_t workerIndex,
+    std::function<void()>& task) {
+  // The most urgent task with a priority first.
+  if (this->prioritizedTaskCount.load() > 0) {
+    std::lock_guard<std::mutex> lock(this->prioritizedMutex);
+    if (!this->prioritizedTasks.empty()) {
+      std::pop_heap(
+          this->prioritizedTasks.begin(),
+          this->prioritizedTasks.end());
+      task = std::move(this->prioritizedTasks.back().task);
+      this->prioritizedTasks.pop_back();
+      this->prioritizedTaskCount.fetch_sub(1);
+      return true;
+    }
+  }
+
+  // Then the most recently added task of the worker's own queue.
+  {
+    WorkerQueue& queue = this->queues[workerIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+      return true;
+    }
+  }
+
+  // Then the oldest task of any other queue.
+  for (size_t i = 1; i < this->queues.size(); ++i) {
+    WorkerQueue& queue = this->queues[(workerIndex + i) % this->queues.size()];
+    std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+    if (lock.owns_lock() && !queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void WorkStealingTaskProcessor::Impl::run(size_t workerIndex) {
+  tpCurrentProcessor = this;
+  tCurrentWorkerIndex = workerIndex;
+
+  std::function<void()> task;
+  while (true) {
+    if (this->takeTask(workerIndex, task)) {
+      this->pendingTasks.fetch_sub(1);
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    // A task may be pending but not taken because its queue was locked, so
+    // only sleep when there are no pending tasks at all.
+    std::unique_lock<std::mutex> lock(this->sleepMutex);
+    this->sleepingWorkers.fetch_add(1);
+    this->wakeCondition.wait(lock, [this]() {
+      return this->stopping || this->pendingTasks.load() > 0;
+    });
+    this->sleepingWorkers.fetch_sub(1);
+    if (this->stopping && this->pendingTasks.load() == 0) {
+      break;
+    }
+  }
+
+  tpCurrentProcessor = nullptr;
+}
+
+WorkStealingTaskProcessor::WorkStealingTaskProcessor(
+    const WorkStealingTaskProcessorOptions& options)
+    : _pImpl() {
+  const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+  const uint32_t numberOfThreads = options.numberOfThreads > 0
+                                       ? options.numberOfThreads
+                                       : std::max(hardwareThreads, 1U);
+  const bool pinThreads =
+      options.pinThreadsToCores && numberOfThreads <= hardwareThreads;
+
+  this->_pImpl = std::make_unique<Impl>(numberOfThreads);
+  this->_pImpl->threads.reserve(numberOfThreads);
+  for (uint32_t i = 0; i < numberOfThreads; ++i) {
+    this->_pImpl->threads.emplace_back([pImpl = this->_pImpl.get(),
+                                        i,
+                                        pinThreads]() {
+      if (pinThreads) {
+        pinCurrentThreadToCore(i);
+      }
+      pImpl->run(i);
+    });
+  }
+}
+
+WorkStealingTaskProcessor::~WorkStealingTaskProcessor() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(this->_pImpl->sleepMutex);
+    this->_pImpl->stopping = true;
+  }
+  this->_pImpl->wakeCondition.notify_all();
+
+  for (std::thread& thread : this->_pImpl->threads) {
+    thread.join();
+  }
+}
+
+void WorkStealingTaskProcessor::startTask(std::function<void()> f) {
+  Impl& impl = *this->_pImpl;
+  // Workers add to their own queue, everyone else to each queue in turn.
+  const size_t queueIndex =
+      tpCurrentProcessor == &impl
+          ? tCurrentWorkerIndex
+          : impl.nextQueue.fetch_add(1) % impl.queues.size();
+  impl.addTask(queueIndex, std::move(f));
+}
+
+void WorkStealingTaskProcessor::startPrioritizedTask(
+    std::function<void()> f,
+    const TaskPriority& priority) {
+  this->_pImpl->addPrioritizedTask(std::move(f), priority);
+}
+
+uint32_t WorkStealingTaskProcessor::getNumberOfThreads() const noexcept {
+  return static_cast<uint32_t>(this->_pImpl->threads.size());
+}
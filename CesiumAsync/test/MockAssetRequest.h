@@ -4,6 +4,7 @@
 #include "CesiumAsync/IAssetRequest.h"
 #include "CesiumAsync/IAssetResponse.h"
 
+#include <memory>
 #include <string>
 
 class MockAssetRequest : public CesiumAsync::IAssetRequest {
@@ -0,0 +1,142 @@
+#include "MockAssetRequest.h"
+#include "MockAssetResponse.h"
+
+#include <CesiumAsync/AdaptiveConcurrencyLimit.h>
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <memory>
+
+using namespace CesiumAsync;
+using namespace std::chrono_literals;
+
+namespace {
+// Completes a window of requests that all start at `time` and take `latency`,
+// and moves `time` to their end.
+void recordWindow(
+    AdaptiveConcurrencyLimit& limit,
+    std::chrono::steady_clock::time_point& time,
+    std::chrono::steady_clock::duration latency,
+    size_t bytesPerResponse,
+    bool succeeded = true) {
+  const uint32_t responses = limit.getLimit();
+  for (uint32_t i = 0; i < responses; ++i) {
+    limit.recordResponse(time, time + latency, bytesPerResponse, succeeded);
+  }
+  time += latency;
+}
+
+class MockCachedAssetResponse : public MockAssetResponse {
+public:
+  using MockAssetResponse::MockAssetResponse;
+
+  virtual bool isFromCache() const override { return true; }
+};
+} // namespace
+
+TEST_CASE("AdaptiveConcurrencyLimit") {
+  AdaptiveConcurrencyLimitOptions options;
+  options.minimumLimit = 4;
+  options.maximumLimit = 12;
+  std::chrono::steady_clock::time_point time{};
+
+  SECTION("clamps the initial limit") {
+    CHECK(AdaptiveConcurrencyLimit(100, options).getLimit() == 12);
+    CHECK(AdaptiveConcurrencyLimit(1, options).getLimit() == 4);
+    CHECK(!AdaptiveConcurrencyLimit(8, options).getThroughput());
+  }
+
+  SECTION("grows while the throughput grows and the latency doesn't") {
+    AdaptiveConcurrencyLimit limit(8, options);
+    recordWindow(limit, time, 100ms, 1000);
+    CHECK(limit.getLimit() == 9);
+    REQUIRE(limit.getThroughput());
+    CHECK(*limit.getThroughput() == Approx(80000.0));
+    CHECK(limit.getBaselineLatency() == std::chrono::steady_clock::duration(
+                                            100ms));
+
+    for (int i = 0; i < 10; ++i) {
+      recordWindow(limit, time, 100ms, 1000);
+    }
+    CHECK(limit.getLimit() == 12);
+  }
+
+  SECTION("shrinks when the latency grows too much") {
+    AdaptiveConcurrencyLimit limit(8, options);
+    recordWindow(limit, time, 100ms, 1000);
+    recordWindow(limit, time, 250ms, 1000);
+    CHECK(limit.getLimit() == 6);
+    recordWindow(limit, time, 250ms, 1000);
+    CHECK(limit.getLimit() == 4);
+
+    // A lasting slowdown becomes the new normal.
+    for (int i = 0; i < 100; ++i) {
+      recordWindow(limit, time, 250ms, 1000);
+    }
+    CHECK(limit.getLimit() > 4);
+  }
+
+  SECTION("shrinks when requests fail") {
+    AdaptiveConcurrencyLimit limit(10, options);
+    recordWindow(limit, time, 100ms, 1000, false);
+    CHECK(limit.getLimit() == 7);
+
+    const uint32_t windowSize = limit.getLimit();
+    for (uint32_t i = 0; i < windowSize; ++i) {
+      const MockAssetRequest request(
+          "GET",
+          "https://example.com",
+          HttpHeaders{},
+          std::make_unique<MockAssetResponse>(
+              static_cast<uint16_t>(i == 0 ? 429 : 200),
+              "application/octet-stream",
+              HttpHeaders{},
+              std::vector<std::byte>(1000)));
+      limit.recordResponse(request, time, time + 100ms);
+    }
+    CHECK(limit.getLimit() == 5);
+  }
+
+  SECTION("ignores the latency of responses served from the cache") {
+    AdaptiveConcurrencyLimit limit(8, options);
+    for (uint32_t i = 0; i < 8; ++i) {
+      const MockAssetRequest request(
+          "GET",
+          "https://example.com",
+          HttpHeaders{},
+          std::make_unique<MockCachedAssetResponse>(
+              static_cast<uint16_t>(200),
+              "application/octet-stream",
+              HttpHeaders{},
+              std::vector<std::byte>(1000)));
+      limit.recordResponse(request, time, time + 1ms);
+    }
+    time += 1ms;
+    CHECK(limit.getLimit() == 8);
+    CHECK(!limit.getBaselineLatency());
+
+    for (int i = 0; i < 10; ++i) {
+      recordWindow(limit, time, 100ms, 1000);
+    }
+    CHECK(limit.getLimit() == 12);
+    CHECK(limit.getBaselineLatency() == std::chrono::steady_clock::duration(
+                                            100ms));
+  }
+
+  SECTION("holds when more requests no longer help") {
+    AdaptiveConcurrencyLimit limit(8, options);
+    recordWindow(limit, time, 100ms, 1000);
+    CHECK(limit.getLimit() == 9);
+    recordWindow(limit, time, 100ms, 500);
+    CHECK(limit.getLimit() == 9);
+  }
+
+  SECTION("applies new options to the current limit") {
+    AdaptiveConcurrencyLimit limit(8, options);
+    options.maximumLimit = 6;
+    limit.setOptions(options);
+    CHECK(limit.getLimit() == 6);
+    CHECK(limit.getOptions().maximumLimit == 6);
+  }
+}
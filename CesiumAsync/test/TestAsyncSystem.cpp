@@ -4,7 +4,11 @@
 
 #include <chrono>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
+#include <utility>
+#include <vector>
 
 using namespace CesiumAsync;
 
@@ -13,11 +17,23 @@ namespace {
 class MockTaskProcessor : public ITaskProcessor {
 public:
   std::atomic<int32_t> tasksStarted = 0;
+  std::mutex prioritiesMutex;
+  std::vector<TaskPriority> priorities;
 
-  virtual void startTask(std::function<void()> f) {
+  virtual void startTask(std::function<void()> f) override {
     ++tasksStarted;
     std::thread(f).detach();
   }
+
+  virtual void startPrioritizedTask(
+      std::function<void()> f,
+      const TaskPriority& priority) override {
+    {
+      std::lock_guard<std::mutex> lock(prioritiesMutex);
+      priorities.emplace_back(priority);
+    }
+    startTask(std::move(f));
+  }
 };
 
 } // namespace
@@ -47,6 +63,52 @@ TEST_CASE("AsyncSystem") {
     CHECK(executed);
   }
 
+  SECTION("worker tasks started in a priority scope have its priority") {
+    std::optional<TaskPriority> priorityInTask;
+    {
+      TaskPriorityScope scope(TaskPriority{2, 5.0});
+      asyncSystem
+          .runInWorkerThread([&priorityInTask]() {
+            priorityInTask = TaskPriorityScope::getCurrent();
+          })
+          .wait();
+    }
+
+    REQUIRE(pTaskProcessor->priorities.size() == 1);
+    CHECK(pTaskProcessor->priorities[0].group == 2);
+    CHECK(pTaskProcessor->priorities[0].value == 5.0);
+
+    // The task runs with the same priority, so the work it starts inherits it.
+    REQUIRE(priorityInTask);
+    CHECK(priorityInTask->group == 2);
+    CHECK(priorityInTask->value == 5.0);
+  }
+
+  SECTION("worker continuations have the priority of the scope they were "
+          "created in") {
+    Promise<void> promise = asyncSystem.createPromise<void>();
+    std::optional<Future<void>> maybeFuture;
+    {
+      TaskPriorityScope scope(TaskPriority{1, 3.0});
+      maybeFuture = promise.getFuture().thenInWorkerThread([]() {});
+    }
+
+    // Resolve the promise in a thread without a priority.
+    std::thread([&promise]() { promise.resolve(); }).join();
+    maybeFuture->wait();
+
+    REQUIRE(pTaskProcessor->priorities.size() == 1);
+    CHECK(pTaskProcessor->priorities[0].group == 1);
+    CHECK(pTaskProcessor->priorities[0].value == 3.0);
+  }
+
+  SECTION("worker tasks without a priority scope have no priority") {
+    asyncSystem.runInWorkerThread([]() {}).wait();
+
+    CHECK(pTaskProcessor->tasksStarted == 1);
+    CHECK(pTaskProcessor->priorities.empty());
+  }
+
   SECTION("runs main thread tasks when instructed") {
     bool executed = false;
 
@@ -60,6 +122,54 @@ TEST_CASE("AsyncSystem") {
     CHECK(pTaskProcessor->tasksStarted == 0);
   }
 
+  SECTION("dispatches main thread tasks within a budget") {
+    int32_t executed = 0;
+    for (int32_t i = 0; i < 5; ++i) {
+      asyncSystem.runInMainThread([&executed]() { ++executed; });
+    }
+
+    MainThreadDispatchBudget budget;
+    budget.maximumTasks = 2;
+    MainThreadDispatchResult result =
+        asyncSystem.dispatchMainThreadTasks(budget);
+    CHECK(result.tasksDispatched == 2);
+    CHECK(result.tasksRemaining == 3);
+    CHECK(executed == 2);
+
+    // At least one task runs even if there's no time.
+    budget.maximumTasks.reset();
+    budget.timeLimit = 0.0;
+    result = asyncSystem.dispatchMainThreadTasks(budget);
+    CHECK(result.tasksDispatched == 1);
+    CHECK(result.tasksRemaining == 2);
+    CHECK(executed == 3);
+
+    result = asyncSystem.dispatchMainThreadTasks(MainThreadDispatchBudget());
+    CHECK(result.tasksDispatched == 2);
+    CHECK(result.tasksRemaining == 0);
+    CHECK(executed == 5);
+  }
+
+  SECTION("dispatches main thread tasks in order of priority") {
+    std::vector<int32_t> order;
+    asyncSystem.runInMainThread([&order]() { order.emplace_back(0); });
+    {
+      TaskPriorityScope scope(TaskPriority{0, 2.0});
+      asyncSystem.runInMainThread([&order]() { order.emplace_back(1); });
+    }
+    {
+      TaskPriorityScope scope(TaskPriority{1, 5.0});
+      asyncSystem.runInMainThread([&order]() { order.emplace_back(2); });
+    }
+    {
+      TaskPriorityScope scope(TaskPriority{0, 1.0});
+      asyncSystem.runInMainThread([&order]() { order.emplace_back(3); });
+    }
+
+    asyncSystem.dispatchMainThreadTasks();
+    CHECK(order == std::vector<int32_t>{2, 3, 1, 0});
+  }
+
   SECTION("main thread continuations are run when instructed") {
     bool executed = false;
 
@@ -356,6 +466,95 @@ TEST_CASE("AsyncSystem") {
     CHECK(rejected);
   }
 
+  SECTION("whenEach invokes the function as each Future resolves") {
+    Promise<int> first = asyncSystem.createPromise<int>();
+    Promise<int> second = asyncSystem.createPromise<int>();
+    std::vector<Future<int>> futures;
+    futures.emplace_back(first.getFuture());
+    futures.emplace_back(second.getFuture());
+
+    std::vector<std::pair<size_t, int>> calls;
+    Future<void> future = asyncSystem.whenEach(
+        std::move(futures),
+        [&calls](size_t index, int&& value) {
+          calls.emplace_back(index, value);
+        });
+
+    second.resolve(2);
+    CHECK(calls == std::vector<std::pair<size_t, int>>{{1, 2}});
+    CHECK(!future.isReady());
+
+    first.resolve(1);
+    CHECK(calls == std::vector<std::pair<size_t, int>>{{1, 2}, {0, 1}});
+    CHECK(future.isReady());
+    future.wait();
+  }
+
+  SECTION("whenEach rejects when any Future rejects") {
+    Promise<int> first = asyncSystem.createPromise<int>();
+    Promise<int> second = asyncSystem.createPromise<int>();
+    std::vector<Future<int>> futures;
+    futures.emplace_back(first.getFuture());
+    futures.emplace_back(second.getFuture());
+
+    int32_t calls = 0;
+    Future<void> future = asyncSystem.whenEach(
+        std::move(futures),
+        [&calls](size_t, int&&) { ++calls; });
+
+    first.reject(std::runtime_error("first"));
+    second.resolve(2);
+    CHECK(calls == 1);
+    CHECK_THROWS_WITH(future.wait(), "first");
+  }
+
+  SECTION("whenEachInMainThread invokes the function in the main thread") {
+    std::vector<Future<int>> futures;
+    futures.emplace_back(asyncSystem.runInWorkerThread([]() { return 1; }));
+
+    bool called = false;
+    Future<void> future = asyncSystem.whenEachInMainThread(
+        std::move(futures),
+        [&called](size_t index, int&& value) {
+          CHECK(index == 0);
+          CHECK(value == 1);
+          called = true;
+        });
+
+    future.waitInMainThread();
+    CHECK(called);
+  }
+
+  SECTION("any resolves with the first Future to resolve") {
+    Promise<int> first = asyncSystem.createPromise<int>();
+    Promise<int> second = asyncSystem.createPromise<int>();
+    std::vector<Future<int>> futures;
+    futures.emplace_back(first.getFuture());
+    futures.emplace_back(second.getFuture());
+
+    Future<int> future = asyncSystem.any(std::move(futures));
+    first.reject(std::runtime_error("first"));
+    CHECK(!future.isReady());
+
+    second.resolve(2);
+    CHECK(future.wait() == 2);
+  }
+
+  SECTION("any rejects when every Future rejects") {
+    Promise<int> first = asyncSystem.createPromise<int>();
+    Promise<int> second = asyncSystem.createPromise<int>();
+    std::vector<Future<int>> futures;
+    futures.emplace_back(first.getFuture());
+    futures.emplace_back(second.getFuture());
+
+    Future<int> future = asyncSystem.any(std::move(futures));
+    first.reject(std::runtime_error("first"));
+    second.reject(std::runtime_error("second"));
+    CHECK_THROWS_WITH(future.wait(), "second");
+
+    CHECK_THROWS(asyncSystem.any(std::vector<Future<int>>()).wait());
+  }
+
   SECTION("conversion to SharedFuture") {
     auto promise = asyncSystem.createPromise<int>();
     auto sharedFuture = promise.getFuture().share();
@@ -703,3 +902,17 @@ TEST_CASE("AsyncSystem") {
     }
   }
 }
+
+TEST_CASE("AsyncSystem rejects worker tasks that are discarded") {
+  class DiscardingTaskProcessor : public ITaskProcessor {
+  public:
+    virtual void startTask(std::function<void()> /*f*/) override {}
+  };
+
+  AsyncSystem asyncSystem(std::make_shared<DiscardingTaskProcessor>());
+
+  bool called = false;
+  auto future = asyncSystem.runInWorkerThread([&called]() { called = true; });
+  CHECK_THROWS(future.wait());
+  CHECK(!called);
+}
@@ -11,6 +11,7 @@
 #include <catch2/catch.hpp>
 #include <spdlog/spdlog.h>
 
+#include <atomic>
 #include <cstddef>
 #include <optional>
 
@@ -84,6 +85,30 @@ public:
   std::optional<CacheItem> cacheItem;
 };
 
+// Answers every get with the same request, once the given future resolves,
+// and counts the gets.
+class MockDeferredAssetAccessor : public MockAssetAccessor {
+public:
+  MockDeferredAssetAccessor(
+      const SharedFuture<std::shared_ptr<IAssetRequest>>& future)
+      : MockAssetAccessor(nullptr), futureRequest{future}, getCount{0} {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& /* asyncSystem */,
+      const std::string& /* url */,
+      const std::vector<THeader>& /* headers */
+      ) override {
+    ++this->getCount;
+    return this->futureRequest.thenImmediately(
+        [](const std::shared_ptr<IAssetRequest>& pRequest) {
+          return pRequest;
+        });
+  }
+
+  SharedFuture<std::shared_ptr<IAssetRequest>> futureRequest;
+  std::atomic<int32_t> getCount;
+};
+
 } // namespace
 
 bool runResponseCacheTest(
@@ -632,6 +657,7 @@ TEST_CASE("Test serving cache item") {
               REQUIRE(response->statusCode() == 200);
               REQUIRE(response->contentType() == "app/json");
               REQUIRE(response->data().empty());
+              REQUIRE(!response->isFromCache());
               REQUIRE(!ResponseCacheControl::parseFromResponseHeaders(
                            response->headers())
                            .has_value());
@@ -709,6 +735,7 @@ TEST_CASE("Test serving cache item") {
               REQUIRE(response->statusCode() == 200);
               REQUIRE(response->contentType() == "app/json");
               REQUIRE(response->data().empty());
+              REQUIRE(response->isFromCache());
 
               std::optional<ResponseCacheControl> cacheControl =
                   ResponseCacheControl::parseFromResponseHeaders(
@@ -804,6 +831,7 @@ TEST_CASE("Test serving cache item") {
               REQUIRE(response->statusCode() == 200);
               REQUIRE(response->contentType() == "app/json");
               REQUIRE(response->data().empty());
+              REQUIRE(!response->isFromCache());
 
               // check cache control is updated
               std::optional<ResponseCacheControl> cacheControl =
@@ -899,4 +927,205 @@ TEST_CASE("Test serving cache item") {
             })
         .wait();
   }
+
+  SECTION("Cache should ask the server about a fresh cache item if the "
+          "request has no-cache") {
+    std::unique_ptr<IAssetResponse> mockResponse =
+        std::make_unique<MockAssetResponse>(
+            static_cast<uint16_t>(200),
+            "app/json",
+            HttpHeaders{{"Content-Type", "app/json"}},
+            std::vector<std::byte>());
+
+    std::shared_ptr<IAssetRequest> mockRequest =
+        std::make_shared<MockAssetRequest>(
+            "GET",
+            "test.com",
+            HttpHeaders{},
+            std::move(mockResponse));
+
+    // mock fresh cache item
+    std::unique_ptr<MockStoreCacheDatabase> mockCacheDatabase =
+        std::make_unique<MockStoreCacheDatabase>();
+    std::time_t currentTime = std::time(nullptr);
+    CacheRequest cacheRequest(HttpHeaders{}, "GET", "cache.com");
+    CacheResponse cacheResponse(
+        static_cast<uint16_t>(200),
+        HttpHeaders{
+            {"Content-Type", "app/json"},
+            {"Cache-Control", "max-age=100, private"}},
+        std::vector<std::byte>());
+    CacheItem cacheItem(
+        currentTime + 100,
+        std::move(cacheRequest),
+        std::move(cacheResponse));
+    mockCacheDatabase->cacheItem = cacheItem;
+
+    std::shared_ptr<CachingAssetAccessor> cacheAssetAccessor =
+        std::make_shared<CachingAssetAccessor>(
+            spdlog::default_logger(),
+            std::make_unique<MockAssetAccessor>(mockRequest),
+            std::move(mockCacheDatabase));
+    std::shared_ptr<MockTaskProcessor> mockTaskProcessor =
+        std::make_shared<MockTaskProcessor>();
+
+    // test that the response is from the server, not the cache
+    AsyncSystem asyncSystem(mockTaskProcessor);
+    for (const std::string& directive : {"no-cache", "max-age=0"}) {
+      cacheAssetAccessor
+          ->get(
+              asyncSystem,
+              "test.com",
+              std::vector<IAssetAccessor::THeader>{
+                  {"Cache-Control", directive}})
+          .thenImmediately(
+              [](const std::shared_ptr<IAssetRequest>& completedRequest) {
+                REQUIRE(completedRequest != nullptr);
+                REQUIRE(completedRequest->url() == "test.com");
+              })
+          .wait();
+    }
+  }
+}
+
+TEST_CASE("Test coalescing in-flight requests") {
+  std::shared_ptr<IAssetRequest> mockRequest =
+      std::make_shared<MockAssetRequest>(
+          "GET",
+          "test.com",
+          HttpHeaders{},
+          std::make_unique<MockAssetResponse>(
+              static_cast<uint16_t>(200),
+              "app/json",
+              HttpHeaders{{"Content-Type", "app/json"}},
+              std::vector<std::byte>()));
+
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  Promise<std::shared_ptr<IAssetRequest>> promise =
+      asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+
+  std::shared_ptr<MockDeferredAssetAccessor> pMockAssetAccessor =
+      std::make_shared<MockDeferredAssetAccessor>(promise.getFuture().share());
+  std::shared_ptr<CachingAssetAccessor> cacheAssetAccessor =
+      std::make_shared<CachingAssetAccessor>(
+          spdlog::default_logger(),
+          pMockAssetAccessor,
+          std::make_unique<MockStoreCacheDatabase>());
+
+  const std::vector<IAssetAccessor::THeader> noHeaders;
+  const std::vector<IAssetAccessor::THeader> otherHeaders{{"Key", "Value"}};
+
+  // The first two gets are the same, so they share one request. The third has
+  // different headers, so it gets its own.
+  Future<std::shared_ptr<IAssetRequest>> first =
+      cacheAssetAccessor->get(asyncSystem, "test.com", noHeaders);
+  Future<std::shared_ptr<IAssetRequest>> second =
+      cacheAssetAccessor->get(asyncSystem, "test.com", noHeaders);
+  Future<std::shared_ptr<IAssetRequest>> third =
+      cacheAssetAccessor->get(asyncSystem, "test.com", otherHeaders);
+
+  promise.resolve(mockRequest);
+
+  std::shared_ptr<IAssetRequest> pFirst = first.wait();
+  std::shared_ptr<IAssetRequest> pSecond = second.wait();
+  std::shared_ptr<IAssetRequest> pThird = third.wait();
+  CHECK(pFirst == mockRequest);
+  CHECK(pSecond == mockRequest);
+  CHECK(pThird == mockRequest);
+  CHECK(pMockAssetAccessor->getCount == 2);
+
+  // A get after the first one completed is not coalesced with it.
+  cacheAssetAccessor->get(asyncSystem, "test.com", noHeaders).wait();
+  CHECK(pMockAssetAccessor->getCount == 3);
+}
+
+TEST_CASE("Test serving stale cache items in each cache mode") {
+  std::shared_ptr<IAssetRequest> mockNotModifiedRequest =
+      std::make_shared<MockAssetRequest>(
+          "GET",
+          "test.com",
+          HttpHeaders{},
+          std::make_unique<MockAssetResponse>(
+              static_cast<uint16_t>(304),
+              "app/json",
+              HttpHeaders{{"Cache-Control", "max-age=300"}},
+              std::vector<std::byte>()));
+
+  std::unique_ptr<MockStoreCacheDatabase> ownedMockCacheDatabase =
+      std::make_unique<MockStoreCacheDatabase>();
+  MockStoreCacheDatabase* pMockCacheDatabase = ownedMockCacheDatabase.get();
+  pMockCacheDatabase->cacheItem = CacheItem(
+      std::time(nullptr) - 100,
+      CacheRequest(HttpHeaders{}, "GET", "cache.com"),
+      CacheResponse(
+          static_cast<uint16_t>(200),
+          HttpHeaders{{"Content-Type", "app/json"}, {"Etag", "1234"}},
+          std::vector<std::byte>()));
+
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  Promise<std::shared_ptr<IAssetRequest>> promise =
+      asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>();
+  std::shared_ptr<MockDeferredAssetAccessor> pMockAssetAccessor =
+      std::make_shared<MockDeferredAssetAccessor>(promise.getFuture().share());
+
+  const std::vector<IAssetAccessor::THeader> noHeaders;
+
+  SECTION("Stale-while-revalidate returns the stale item right away") {
+    CachingAssetAccessor cacheAssetAccessor(
+        spdlog::default_logger(),
+        pMockAssetAccessor,
+        std::move(ownedMockCacheDatabase),
+        10000,
+        CacheMode::StaleWhileRevalidate);
+    CHECK(cacheAssetAccessor.getCacheMode() == CacheMode::StaleWhileRevalidate);
+
+    // Both gets are answered from the cache while the server hasn't answered,
+    // and share a single revalidation.
+    std::shared_ptr<IAssetRequest> pFirst =
+        cacheAssetAccessor.get(asyncSystem, "test.com", noHeaders).wait();
+    std::shared_ptr<IAssetRequest> pSecond =
+        cacheAssetAccessor.get(asyncSystem, "test.com", noHeaders).wait();
+    REQUIRE(pFirst);
+    REQUIRE(pSecond);
+    CHECK(pFirst->url() == "cache.com");
+    CHECK(pSecond->url() == "cache.com");
+    CHECK(pMockAssetAccessor->getCount.load() == 1);
+    CHECK(!pMockCacheDatabase->storeResponseCall);
+
+    // Once the revalidation completes, the updated item is stored. The cache
+    // thread finishes it before it looks up the next get, which doesn't start
+    // another revalidation.
+    promise.resolve(mockNotModifiedRequest);
+    cacheAssetAccessor.setCacheMode(CacheMode::OfflineFirst);
+    cacheAssetAccessor.get(asyncSystem, "test.com", noHeaders).wait();
+    CHECK(pMockAssetAccessor->getCount.load() == 1);
+    CHECK(pMockCacheDatabase->storeResponseCall);
+    REQUIRE(pMockCacheDatabase->storeRequestParam);
+    CHECK(pMockCacheDatabase->storeRequestParam->url == "cache.com");
+    CHECK(pMockCacheDatabase->storeRequestParam->statusCode == 200);
+  }
+
+  SECTION("Offline-first returns the stale item without asking the server") {
+    CachingAssetAccessor cacheAssetAccessor(
+        spdlog::default_logger(),
+        pMockAssetAccessor,
+        std::move(ownedMockCacheDatabase));
+    cacheAssetAccessor.setCacheMode(CacheMode::OfflineFirst);
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        cacheAssetAccessor.get(asyncSystem, "test.com", noHeaders).wait();
+    REQUIRE(pRequest);
+    CHECK(pRequest->url() == "cache.com");
+    CHECK(pMockAssetAccessor->getCount.load() == 0);
+
+    // A get that asks for revalidation still goes to the server.
+    Future<std::shared_ptr<IAssetRequest>> revalidated =
+        cacheAssetAccessor.get(
+            asyncSystem,
+            "test.com",
+            {{"Cache-Control", "no-cache"}});
+    promise.resolve(mockNotModifiedRequest);
+    CHECK(revalidated.wait());
+    CHECK(pMockAssetAccessor->getCount.load() == 1);
+  }
 }
@@ -0,0 +1,62 @@
+#include "CesiumAsync/AsyncSystem.h"
+#include "MockTaskProcessor.h"
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+using namespace CesiumAsync;
+
+namespace {
+// The number of continuations in a chain, about as many as a tile load has.
+constexpr int32_t continuationsPerChain = 12;
+constexpr int32_t chains = 20000;
+
+Future<int32_t> chainContinuations(Future<int32_t>&& future) {
+  for (int32_t i = 0; i < continuationsPerChain; ++i) {
+    future = std::move(future).thenInWorkerThread(
+        [](int32_t value) { return value + 1; });
+  }
+  return std::move(future);
+}
+
+// Runs the chain of continuations made by the function many times, and
+// returns the average time per continuation.
+template <typename Func> double nanosecondsPerContinuation(Func&& f) {
+  int64_t total = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < chains; ++i) {
+    total += f();
+  }
+  const std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  CHECK(total == int64_t(chains) * continuationsPerChain);
+  return elapsed.count() / double(chains * continuationsPerChain);
+}
+} // namespace
+
+// A microbenchmark of the cost of creating and dispatching continuations,
+// which only runs when asked for, with the [!benchmark] tag.
+TEST_CASE("Future continuation overhead", "[!benchmark]") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+
+  SECTION("continuations of a resolved future") {
+    const double nanoseconds = nanosecondsPerContinuation([&asyncSystem]() {
+      return chainContinuations(asyncSystem.createResolvedFuture(0)).wait();
+    });
+    WARN("Resolved: " << nanoseconds << " ns per continuation");
+  }
+
+  SECTION("continuations scheduled when a promise resolves") {
+    const double nanoseconds = nanosecondsPerContinuation([&asyncSystem]() {
+      Promise<int32_t> promise = asyncSystem.createPromise<int32_t>();
+      Future<int32_t> future = chainContinuations(promise.getFuture());
+      promise.resolve(0);
+      return future.wait();
+    });
+    WARN("Scheduled: " << nanoseconds << " ns per continuation");
+  }
+}
@@ -0,0 +1,85 @@
+#include "CesiumAsync/Coroutine.h"
+
+#ifdef CESIUM_ASYNC_HAS_COROUTINES
+
+#include "CesiumAsync/AsyncSystem.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using namespace CesiumAsync;
+
+namespace {
+class ThreadTaskProcessor : public ITaskProcessor {
+public:
+  virtual void startTask(std::function<void()> f) override {
+    std::thread(f).detach();
+  }
+};
+
+// The AsyncSystem creates the Future that the coroutine returns.
+Future<int32_t>
+addOne([[maybe_unused]] AsyncSystem asyncSystem, Future<int32_t> future) {
+  const int32_t value = co_await std::move(future);
+  co_return value + 1;
+}
+
+Future<void> throwAfter(AsyncSystem asyncSystem) {
+  co_await asyncSystem.createResolvedFuture();
+  throw std::runtime_error("failed");
+}
+
+Future<std::thread::id> resumeInWorkerThread(AsyncSystem asyncSystem) {
+  co_await inWorkerThread(asyncSystem.createResolvedFuture());
+  co_return std::this_thread::get_id();
+}
+
+Future<std::thread::id> resumeInMainThread(AsyncSystem asyncSystem) {
+  co_await inWorkerThread(asyncSystem.createResolvedFuture());
+  co_await inMainThread(asyncSystem.createResolvedFuture());
+  co_return std::this_thread::get_id();
+}
+} // namespace
+
+TEST_CASE("Coroutines") {
+  AsyncSystem asyncSystem(std::make_shared<ThreadTaskProcessor>());
+
+  SECTION("may await a Future and return a Future") {
+    Promise<int32_t> promise = asyncSystem.createPromise<int32_t>();
+    Future<int32_t> result = addOne(asyncSystem, promise.getFuture());
+    CHECK(!result.isReady());
+
+    promise.resolve(41);
+    CHECK(result.wait() == 42);
+  }
+
+  SECTION("reject their Future with the exceptions that escape them") {
+    CHECK_THROWS_AS(throwAfter(asyncSystem).wait(), std::runtime_error);
+  }
+
+  SECTION("rethrow the exception of a rejected Future they await") {
+    Promise<int32_t> promise = asyncSystem.createPromise<int32_t>();
+    Future<int32_t> result = addOne(asyncSystem, promise.getFuture());
+    promise.reject(std::runtime_error("failed"));
+    CHECK_THROWS_AS(result.wait(), std::runtime_error);
+  }
+
+  SECTION("may resume in a worker thread") {
+    CHECK(
+        resumeInWorkerThread(asyncSystem).wait() !=
+        std::this_thread::get_id());
+  }
+
+  SECTION("may resume in the main thread") {
+    CHECK(
+        resumeInMainThread(asyncSystem).waitInMainThread() ==
+        std::this_thread::get_id());
+  }
+}
+
+#endif
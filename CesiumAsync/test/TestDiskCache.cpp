@@ -6,7 +6,14 @@
 #include <catch2/catch.hpp>
 #include <spdlog/spdlog.h>
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
 
 using namespace CesiumAsync;
 
@@ -214,3 +221,332 @@ TEST_CASE("Test disk cache with Sqlite") {
     }
   }
 }
+
+TEST_CASE("Test disk cache writes stored entries behind") {
+  HttpHeaders responseHeaders{{"Content-Type", "text/html"}};
+  std::vector<std::byte> responseData = {std::byte(0), std::byte(1)};
+
+  auto storeEntries = [&](SqliteCache& diskCache) {
+    for (size_t i = 0; i < 10; ++i) {
+      REQUIRE(diskCache.storeEntry(
+          "TestKey" + std::to_string(i),
+          std::time(nullptr) + 100,
+          "test.com",
+          "GET",
+          HttpHeaders{},
+          static_cast<uint16_t>(200),
+          responseHeaders,
+          responseData));
+    }
+  };
+
+  SECTION("Pending entries can be read before they are written") {
+    // The batch won't fill, and won't be written for a minute.
+    SqliteCache diskCache(
+        spdlog::default_logger(),
+        "test-write-behind.db",
+        4096,
+        100,
+        60000.0);
+    REQUIRE(diskCache.clearAll());
+    storeEntries(diskCache);
+
+    for (size_t i = 0; i < 10; ++i) {
+      std::optional<CacheItem> cacheItem =
+          diskCache.getEntry("TestKey" + std::to_string(i));
+      REQUIRE(cacheItem);
+      CHECK(cacheItem->cacheResponse.data == responseData);
+    }
+  }
+
+  SECTION("Pending entries are shared rather than copied") {
+    SqliteCache diskCache(
+        spdlog::default_logger(),
+        "test-write-behind.db",
+        4096,
+        100,
+        60000.0);
+    REQUIRE(diskCache.clearAll());
+    storeEntries(diskCache);
+
+    std::shared_ptr<const CacheItem> pFirst =
+        diskCache.getSharedEntry("TestKey0");
+    std::shared_ptr<const CacheItem> pSecond =
+        diskCache.getSharedEntry("TestKey0");
+    REQUIRE(pFirst);
+    CHECK(pFirst == pSecond);
+    CHECK(pFirst->cacheResponse.data == responseData);
+    CHECK(!diskCache.getSharedEntry("TestKeyMissing"));
+  }
+
+  SECTION("Pending entries are written when the cache is destroyed") {
+    {
+      SqliteCache diskCache(
+          spdlog::default_logger(),
+          "test-write-behind.db",
+          4096,
+          100,
+          60000.0);
+      REQUIRE(diskCache.clearAll());
+      storeEntries(diskCache);
+    }
+
+    SqliteCache diskCache(
+        spdlog::default_logger(),
+        "test-write-behind.db",
+        4096,
+        0);
+    for (size_t i = 0; i < 10; ++i) {
+      std::optional<CacheItem> cacheItem =
+          diskCache.getEntry("TestKey" + std::to_string(i));
+      REQUIRE(cacheItem);
+      CHECK(cacheItem->cacheResponse.data == responseData);
+    }
+  }
+
+  SECTION("Pending entries are dropped by clearAll") {
+    SqliteCache diskCache(
+        spdlog::default_logger(),
+        "test-write-behind.db",
+        4096,
+        100,
+        60000.0);
+    storeEntries(diskCache);
+    REQUIRE(diskCache.clearAll());
+    CHECK(!diskCache.getEntry("TestKey0"));
+  }
+}
+
+TEST_CASE("Test disk cache reads concurrently") {
+  SqliteCache diskCache(spdlog::default_logger(), "test-readers.db", 4096, 0);
+  REQUIRE(diskCache.clearAll());
+
+  std::vector<std::byte> responseData = {std::byte(0), std::byte(1)};
+  for (size_t i = 0; i < 10; ++i) {
+    REQUIRE(diskCache.storeEntry(
+        "TestKey" + std::to_string(i),
+        std::time(nullptr) + 100,
+        "test.com",
+        "GET",
+        HttpHeaders{},
+        static_cast<uint16_t>(200),
+        HttpHeaders{{"Content-Type", "text/html"}},
+        responseData));
+  }
+
+  std::atomic<int32_t> found = 0;
+  std::vector<std::thread> readers;
+  for (int32_t i = 0; i < 8; ++i) {
+    readers.emplace_back([&diskCache, &found]() {
+      for (size_t j = 0; j < 100; ++j) {
+        if (diskCache.getEntry("TestKey" + std::to_string(j % 10))) {
+          ++found;
+        }
+      }
+    });
+  }
+
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+
+  CHECK(found.load() == 800);
+
+  // Entries stored after the reads are visible to the same connections.
+  REQUIRE(diskCache.storeEntry(
+      "TestKeyAfter",
+      std::time(nullptr) + 100,
+      "test.com",
+      "GET",
+      HttpHeaders{},
+      static_cast<uint16_t>(200),
+      HttpHeaders{},
+      responseData));
+  CHECK(diskCache.getEntry("TestKeyAfter"));
+}
+
+TEST_CASE("Test disk cache stores large response data in files") {
+  const std::filesystem::path dataDirectory = "test-data-files.db-data";
+  auto countDataFiles = [&dataDirectory]() {
+    return std::distance(
+        std::filesystem::directory_iterator(dataDirectory),
+        std::filesystem::directory_iterator());
+  };
+
+  SqliteCache diskCache(
+      spdlog::default_logger(),
+      "test-data-files.db",
+      4096,
+      0,
+      0.0,
+      4);
+  REQUIRE(diskCache.clearAll());
+  CHECK(countDataFiles() == 0);
+
+  std::vector<std::byte> smallData = {std::byte(0), std::byte(1)};
+  std::vector<std::byte> largeData =
+      {std::byte(0), std::byte(1), std::byte(2), std::byte(3), std::byte(4)};
+  auto store = [&diskCache](
+                   const std::string& key,
+                   const std::vector<std::byte>& data) {
+    REQUIRE(diskCache.storeEntry(
+        key,
+        std::time(nullptr) + 100,
+        "test.com",
+        "GET",
+        HttpHeaders{},
+        static_cast<uint16_t>(200),
+        HttpHeaders{},
+        data));
+  };
+
+  // The two large entries share a file, and the small one is stored in the
+  // database.
+  store("Small", smallData);
+  store("Large", largeData);
+  store("LargeCopy", largeData);
+  CHECK(countDataFiles() == 1);
+
+  std::optional<CacheItem> small = diskCache.getEntry("Small");
+  REQUIRE(small);
+  CHECK(small->cacheResponse.data == smallData);
+
+  std::optional<CacheItem> large = diskCache.getEntry("Large");
+  REQUIRE(large);
+  CHECK(large->cacheResponse.data == largeData);
+
+  std::optional<CacheItem> largeCopy = diskCache.getEntry("LargeCopy");
+  REQUIRE(largeCopy);
+  CHECK(largeCopy->cacheResponse.data == largeData);
+
+  // The file is kept while any entry uses it.
+  store("Large", smallData);
+  REQUIRE(diskCache.prune());
+  CHECK(countDataFiles() == 1);
+
+  REQUIRE(diskCache.clearAll());
+  CHECK(countDataFiles() == 0);
+}
+
+TEST_CASE("Test disk cache prunes incrementally") {
+  std::vector<std::byte> responseData(300, std::byte(1));
+
+  auto storeEntries = [&responseData](SqliteCache& diskCache) {
+    for (size_t i = 0; i < 10; ++i) {
+      REQUIRE(diskCache.storeEntry(
+          "TestKey" + std::to_string(i),
+          std::time(nullptr) + 100,
+          "test.com",
+          "GET",
+          HttpHeaders{},
+          static_cast<uint16_t>(200),
+          HttpHeaders{},
+          responseData));
+    }
+  };
+
+  auto countEntries = [](SqliteCache& diskCache) {
+    int count = 0;
+    for (size_t i = 0; i < 10; ++i) {
+      if (diskCache.getEntry("TestKey" + std::to_string(i))) {
+        ++count;
+      }
+    }
+    return count;
+  };
+
+  SECTION("The total size of the response data is limited") {
+    SqliteCache diskCache(
+        spdlog::default_logger(),
+        "test-prune.db",
+        4096,
+        0,
+        0.0,
+        0,
+        1000);
+    REQUIRE(diskCache.clearAll());
+    storeEntries(diskCache);
+
+    REQUIRE(diskCache.prune());
+    CHECK(countEntries(diskCache) == 3);
+  }
+
+  SECTION("Pruning runs in batches in the background") {
+    SqliteCache diskCache(
+        spdlog::default_logger(),
+        "test-prune.db",
+        4,
+        0,
+        0.0,
+        0,
+        0,
+        2,
+        1.0);
+    REQUIRE(diskCache.clearAll());
+    storeEntries(diskCache);
+
+    REQUIRE(diskCache.prune());
+
+    int count = countEntries(diskCache);
+    for (int i = 0; i < 500 && count > 4; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      count = countEntries(diskCache);
+    }
+    CHECK(count == 4);
+  }
+}
+
+TEST_CASE("Test disk cache compresses response data") {
+  std::vector<std::byte> compressibleData(10000, std::byte(1));
+  std::vector<std::byte> smallData = {std::byte(0), std::byte(1)};
+
+  auto store = [](
+                   SqliteCache& diskCache,
+                   const std::string& key,
+                   const std::vector<std::byte>& data) {
+    REQUIRE(diskCache.storeEntry(
+        key,
+        std::time(nullptr) + 100,
+        "test.com",
+        "GET",
+        HttpHeaders{},
+        static_cast<uint16_t>(200),
+        HttpHeaders{},
+        data));
+  };
+
+  {
+    SqliteCache diskCache(
+        spdlog::default_logger(),
+        "test-compression.db",
+        4096,
+        0,
+        0.0,
+        0,
+        0,
+        0,
+        0.0,
+        true);
+    REQUIRE(diskCache.clearAll());
+    store(diskCache, "Compressible", compressibleData);
+    store(diskCache, "Small", smallData);
+
+    std::optional<CacheItem> compressible = diskCache.getEntry("Compressible");
+    REQUIRE(compressible);
+    CHECK(compressible->cacheResponse.data == compressibleData);
+
+    std::optional<CacheItem> small = diskCache.getEntry("Small");
+    REQUIRE(small);
+    CHECK(small->cacheResponse.data == smallData);
+  }
+
+  // Compressed entries are still read with compression turned off.
+  SqliteCache diskCache(
+      spdlog::default_logger(),
+      "test-compression.db",
+      4096,
+      0);
+  std::optional<CacheItem> compressible = diskCache.getEntry("Compressible");
+  REQUIRE(compressible);
+  CHECK(compressible->cacheResponse.data == compressibleData);
+}
@@ -0,0 +1,166 @@
+#include "CesiumAsync/MemoryCache.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+class MockMapCacheDatabase : public ICacheDatabase {
+public:
+  MockMapCacheDatabase() : items(), getEntryCalls(0) {}
+
+  virtual std::optional<CacheItem>
+  getEntry(const std::string& key) const override {
+    ++this->getEntryCalls;
+    auto it = this->items.find(key);
+    if (it == this->items.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override {
+    this->items.insert_or_assign(
+        key,
+        CacheItem(
+            expiryTime,
+            CacheRequest(
+                HttpHeaders(requestHeaders),
+                std::string(requestMethod),
+                std::string(url)),
+            CacheResponse(
+                statusCode,
+                HttpHeaders(responseHeaders),
+                std::vector<std::byte>(
+                    responseData.begin(),
+                    responseData.end()))));
+    return true;
+  }
+
+  virtual bool prune() override { return true; }
+
+  virtual bool clearAll() override {
+    this->items.clear();
+    return true;
+  }
+
+  std::map<std::string, CacheItem> items;
+  mutable int getEntryCalls;
+};
+
+bool storeEntry(
+    ICacheDatabase& database,
+    const std::string& key,
+    size_t dataSize,
+    std::time_t expiryTime = std::time(nullptr) + 100) {
+  return database.storeEntry(
+      key,
+      expiryTime,
+      "test.com",
+      "GET",
+      HttpHeaders{},
+      static_cast<uint16_t>(200),
+      HttpHeaders{},
+      std::vector<std::byte>(dataSize, std::byte(1)));
+}
+
+} // namespace
+
+TEST_CASE("Test memory cache") {
+  std::shared_ptr<MockMapCacheDatabase> pDatabase =
+      std::make_shared<MockMapCacheDatabase>();
+
+  SECTION("Stored entries are read from memory") {
+    MemoryCache memoryCache(pDatabase, 1024 * 1024);
+    REQUIRE(storeEntry(memoryCache, "TestKey", 100));
+    CHECK(pDatabase->items.count("TestKey") == 1);
+
+    std::optional<CacheItem> cacheItem = memoryCache.getEntry("TestKey");
+    REQUIRE(cacheItem);
+    CHECK(cacheItem->cacheResponse.data.size() == 100);
+    CHECK(pDatabase->getEntryCalls == 0);
+  }
+
+  SECTION("Entries read from the database are kept in memory") {
+    REQUIRE(storeEntry(*pDatabase, "TestKey", 100));
+
+    MemoryCache memoryCache(pDatabase, 1024 * 1024);
+    std::shared_ptr<const CacheItem> pFirst =
+        memoryCache.getSharedEntry("TestKey");
+    std::shared_ptr<const CacheItem> pSecond =
+        memoryCache.getSharedEntry("TestKey");
+    REQUIRE(pFirst);
+    CHECK(pFirst == pSecond);
+    CHECK(pDatabase->getEntryCalls == 1);
+
+    CHECK(!memoryCache.getSharedEntry("TestKeyMissing"));
+    CHECK(pDatabase->getEntryCalls == 2);
+  }
+
+  SECTION("The least recently used entries are dropped from memory") {
+    MemoryCache memoryCache(pDatabase, 4000);
+    REQUIRE(storeEntry(memoryCache, "TestKey0", 1000));
+    REQUIRE(storeEntry(memoryCache, "TestKey1", 1000));
+    REQUIRE(storeEntry(memoryCache, "TestKey2", 1000));
+    CHECK(memoryCache.getCurrentSize() <= 4000);
+
+    // Use TestKey0, so that TestKey1 is the least recently used.
+    CHECK(memoryCache.getSharedEntry("TestKey0"));
+    REQUIRE(storeEntry(memoryCache, "TestKey3", 1000));
+    CHECK(memoryCache.getCurrentSize() <= 4000);
+    CHECK(pDatabase->getEntryCalls == 0);
+
+    CHECK(memoryCache.getSharedEntry("TestKey0"));
+    CHECK(memoryCache.getSharedEntry("TestKey3"));
+    CHECK(pDatabase->getEntryCalls == 0);
+
+    // TestKey1 is still in the database.
+    CHECK(memoryCache.getSharedEntry("TestKey1"));
+    CHECK(pDatabase->getEntryCalls == 1);
+  }
+
+  SECTION("Entries larger than the cache are not kept in memory") {
+    MemoryCache memoryCache(pDatabase, 1000);
+    REQUIRE(storeEntry(memoryCache, "TestKey", 2000));
+    CHECK(memoryCache.getCurrentSize() == 0);
+    CHECK(memoryCache.getSharedEntry("TestKey"));
+    CHECK(pDatabase->getEntryCalls == 1);
+  }
+
+  SECTION("Expired entries are dropped from memory when pruned") {
+    MemoryCache memoryCache(pDatabase, 1024 * 1024);
+    REQUIRE(storeEntry(memoryCache, "Expired", 100, std::time(nullptr) - 10));
+    REQUIRE(storeEntry(memoryCache, "Fresh", 100));
+    REQUIRE(memoryCache.prune());
+
+    CHECK(memoryCache.getSharedEntry("Fresh"));
+    CHECK(pDatabase->getEntryCalls == 0);
+    CHECK(memoryCache.getSharedEntry("Expired"));
+    CHECK(pDatabase->getEntryCalls == 1);
+  }
+
+  SECTION("clearAll clears memory and the database") {
+    MemoryCache memoryCache(pDatabase, 1024 * 1024);
+    REQUIRE(storeEntry(memoryCache, "TestKey", 100));
+    REQUIRE(memoryCache.clearAll());
+    CHECK(memoryCache.getCurrentSize() == 0);
+    CHECK(!memoryCache.getSharedEntry("TestKey"));
+  }
+}
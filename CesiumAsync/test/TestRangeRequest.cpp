@@ -0,0 +1,174 @@
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/CachingAssetAccessor.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumAsync/SqliteCache.h"
+#include "MockAssetAccessor.h"
+#include "MockAssetRequest.h"
+#include "MockAssetResponse.h"
+#include "MockTaskProcessor.h"
+
+#include <catch2/catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+std::vector<std::byte> createData(size_t size) {
+  std::vector<std::byte> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = std::byte(i);
+  }
+  return data;
+}
+
+// Answers every get with the whole asset, or with the requested range of it
+// if partialContent is true, and records the Range header of each get.
+class MockRangeAssetAccessor : public MockAssetAccessor {
+public:
+  MockRangeAssetAccessor(bool partialContent_)
+      : MockAssetAccessor(nullptr),
+        partialContent(partialContent_),
+        data(createData(100)),
+        ranges() {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    HttpHeaders requestHeaders(headers.begin(), headers.end());
+    auto rangeHeader = requestHeaders.find("Range");
+    this->ranges.emplace_back(
+        rangeHeader == requestHeaders.end() ? "" : rangeHeader->second);
+
+    uint16_t statusCode = 200;
+    std::vector<std::byte> responseData = this->data;
+    if (this->partialContent && rangeHeader != requestHeaders.end()) {
+      // Only "bytes=first-last" is needed here.
+      const std::string& range = rangeHeader->second;
+      const size_t dash = range.find('-');
+      const size_t first = std::stoul(range.substr(6, dash - 6));
+      const size_t last = std::stoul(range.substr(dash + 1));
+      statusCode = 206;
+      responseData.assign(
+          this->data.begin() + static_cast<std::ptrdiff_t>(first),
+          this->data.begin() + static_cast<std::ptrdiff_t>(last + 1));
+    }
+
+    std::shared_ptr<IAssetRequest> pRequest =
+        std::make_shared<MockAssetRequest>(
+            "GET",
+            url,
+            requestHeaders,
+            std::make_unique<MockAssetResponse>(
+                statusCode,
+                "application/octet-stream",
+                HttpHeaders{{"Cache-Control", "max-age=100"}},
+                responseData));
+    return asyncSystem.createResolvedFuture(std::move(pRequest));
+  }
+
+  bool partialContent;
+  std::vector<std::byte> data;
+  std::vector<std::string> ranges;
+};
+
+std::vector<std::byte> getRangeData(
+    IAssetAccessor& assetAccessor,
+    const AsyncSystem& asyncSystem,
+    uint64_t offset,
+    uint64_t length) {
+  std::shared_ptr<IAssetRequest> pRequest =
+      assetAccessor.getRange(asyncSystem, "test.com/tiles", offset, length)
+          .wait();
+  REQUIRE(pRequest);
+  const IAssetResponse* pResponse = pRequest->response();
+  REQUIRE(pResponse);
+  CHECK(pResponse->statusCode() == 206);
+  return std::vector<std::byte>(
+      pResponse->data().begin(),
+      pResponse->data().end());
+}
+
+} // namespace
+
+TEST_CASE("Test range requests") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  const std::vector<std::byte> data = createData(100);
+
+  SECTION("A whole asset is reduced to the requested range") {
+    MockRangeAssetAccessor assetAccessor(false);
+
+    CHECK(
+        getRangeData(assetAccessor, asyncSystem, 10, 5) ==
+        std::vector<std::byte>(data.begin() + 10, data.begin() + 15));
+    CHECK(
+        getRangeData(assetAccessor, asyncSystem, 90, 0) ==
+        std::vector<std::byte>(data.begin() + 90, data.end()));
+    CHECK(getRangeData(assetAccessor, asyncSystem, 95, 10).size() == 5);
+
+    REQUIRE(assetAccessor.ranges.size() == 3);
+    CHECK(assetAccessor.ranges[0] == "bytes=10-14");
+    CHECK(assetAccessor.ranges[1] == "bytes=90-");
+    CHECK(assetAccessor.ranges[2] == "bytes=95-104");
+  }
+
+  SECTION("Ranges are cached apart from each other") {
+    std::shared_ptr<SqliteCache> pCache = std::make_shared<SqliteCache>(
+        spdlog::default_logger(),
+        "test-range.db",
+        4096,
+        0);
+    pCache->clearAll();
+
+    std::shared_ptr<MockRangeAssetAccessor> pMockAccessor =
+        std::make_shared<MockRangeAssetAccessor>(true);
+    CachingAssetAccessor cachingAccessor(
+        spdlog::default_logger(),
+        pMockAccessor,
+        pCache);
+
+    for (int i = 0; i < 2; ++i) {
+      CHECK(
+          getRangeData(cachingAccessor, asyncSystem, 0, 10) ==
+          std::vector<std::byte>(data.begin(), data.begin() + 10));
+      CHECK(
+          getRangeData(cachingAccessor, asyncSystem, 20, 10) ==
+          std::vector<std::byte>(data.begin() + 20, data.begin() + 30));
+    }
+
+    REQUIRE(pMockAccessor->ranges.size() == 2);
+    CHECK(pMockAccessor->ranges[0] == "bytes=0-9");
+    CHECK(pMockAccessor->ranges[1] == "bytes=20-29");
+  }
+
+  SECTION("A cached whole asset serves its ranges") {
+    std::shared_ptr<SqliteCache> pCache = std::make_shared<SqliteCache>(
+        spdlog::default_logger(),
+        "test-range.db",
+        4096,
+        0);
+    pCache->clearAll();
+
+    std::shared_ptr<MockRangeAssetAccessor> pMockAccessor =
+        std::make_shared<MockRangeAssetAccessor>(true);
+    CachingAssetAccessor cachingAccessor(
+        spdlog::default_logger(),
+        pMockAccessor,
+        pCache);
+
+    cachingAccessor.get(asyncSystem, "test.com/tiles", {}).wait();
+    CHECK(
+        getRangeData(cachingAccessor, asyncSystem, 40, 10) ==
+        std::vector<std::byte>(data.begin() + 40, data.begin() + 50));
+
+    REQUIRE(pMockAccessor->ranges.size() == 1);
+    CHECK(pMockAccessor->ranges[0].empty());
+  }
+}
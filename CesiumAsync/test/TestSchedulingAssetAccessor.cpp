@@ -0,0 +1,153 @@
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/SchedulingAssetAccessor.h"
+#include "CesiumAsync/TaskPriority.h"
+#include "MockAssetAccessor.h"
+#include "MockAssetRequest.h"
+#include "MockTaskProcessor.h"
+
+#include <catch2/catch.hpp>
+
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+
+namespace {
+
+// Records the requests that are made, and completes them when asked.
+class MockManualAssetAccessor : public MockAssetAccessor {
+public:
+  MockManualAssetAccessor() : MockAssetAccessor(nullptr), urls(), promises() {}
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& /* headers */
+      ) override {
+    this->urls.emplace_back(url);
+    this->promises.emplace_back(
+        asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>());
+    return this->promises.back().getFuture();
+  }
+
+  void complete(size_t index) {
+    this->promises[index].resolve(std::make_shared<MockAssetRequest>(
+        "GET",
+        this->urls[index],
+        HttpHeaders{},
+        nullptr));
+  }
+
+  std::vector<std::string> urls;
+  // A deque, because completing a request can make another one.
+  std::deque<Promise<std::shared_ptr<IAssetRequest>>> promises;
+};
+
+} // namespace
+
+TEST_CASE("SchedulingAssetAccessor") {
+  AsyncSystem asyncSystem(std::make_shared<MockTaskProcessor>());
+  std::shared_ptr<MockManualAssetAccessor> pMockAssetAccessor =
+      std::make_shared<MockManualAssetAccessor>();
+
+  SECTION("limits the requests in flight to each host") {
+    SchedulingAssetAccessor accessor(pMockAssetAccessor, 2);
+    Future<std::shared_ptr<IAssetRequest>> a0 =
+        accessor.get(asyncSystem, "https://a.com/0", {});
+    Future<std::shared_ptr<IAssetRequest>> a1 =
+        accessor.get(asyncSystem, "https://a.com/1", {});
+    Future<std::shared_ptr<IAssetRequest>> a2 =
+        accessor.get(asyncSystem, "https://a.com/2", {});
+    Future<std::shared_ptr<IAssetRequest>> b0 =
+        accessor.get(asyncSystem, "https://b.com/0", {});
+
+    REQUIRE(pMockAssetAccessor->urls.size() == 3);
+    CHECK(pMockAssetAccessor->urls[2] == "https://b.com/0");
+    CHECK(accessor.getQueuedRequestCount("a.com") == 1);
+
+    // Completing a request to a.com starts the queued one.
+    pMockAssetAccessor->complete(0);
+    REQUIRE(pMockAssetAccessor->urls.size() == 4);
+    CHECK(pMockAssetAccessor->urls[3] == "https://a.com/2");
+    CHECK(accessor.getQueuedRequestCount("a.com") == 0);
+
+    pMockAssetAccessor->complete(3);
+    CHECK(a2.wait()->url() == "https://a.com/2");
+  }
+
+  SECTION("hosts can have limits of their own") {
+    SchedulingAssetAccessor accessor(pMockAssetAccessor, 1);
+    accessor.setMaximumRequestsForHost("a.com", 2);
+    Future<std::shared_ptr<IAssetRequest>> a0 =
+        accessor.get(asyncSystem, "https://a.com/0", {});
+    Future<std::shared_ptr<IAssetRequest>> a1 =
+        accessor.get(asyncSystem, "https://a.com/1", {});
+    Future<std::shared_ptr<IAssetRequest>> b0 =
+        accessor.get(asyncSystem, "https://b.com/0", {});
+    Future<std::shared_ptr<IAssetRequest>> b1 =
+        accessor.get(asyncSystem, "https://b.com/1", {});
+    CHECK(pMockAssetAccessor->urls.size() == 3);
+    CHECK(accessor.getQueuedRequestCount("b.com") == 1);
+
+    // Raising the limit starts queued requests.
+    accessor.setMaximumRequestsForHost("b.com", 2);
+    CHECK(pMockAssetAccessor->urls.size() == 4);
+    CHECK(accessor.getQueuedRequestCount("b.com") == 0);
+  }
+
+  SECTION("queued requests start in order of priority") {
+    SchedulingAssetAccessor accessor(pMockAssetAccessor, 1);
+    Future<std::shared_ptr<IAssetRequest>> first =
+        accessor.get(asyncSystem, "https://a.com/first", {});
+
+    Future<std::shared_ptr<IAssetRequest>> none =
+        accessor.get(asyncSystem, "https://a.com/none", {});
+    std::optional<Future<std::shared_ptr<IAssetRequest>>> low;
+    std::optional<Future<std::shared_ptr<IAssetRequest>>> high;
+    {
+      TaskPriorityScope scope(TaskPriority{0, 5.0});
+      low = accessor.get(asyncSystem, "https://a.com/low", {});
+    }
+    {
+      TaskPriorityScope scope(TaskPriority{0, 1.0});
+      high = accessor.get(asyncSystem, "https://a.com/high", {});
+    }
+
+    for (size_t i = 0; i < 3; ++i) {
+      pMockAssetAccessor->complete(i);
+    }
+
+    REQUIRE(pMockAssetAccessor->urls.size() == 4);
+    CHECK(pMockAssetAccessor->urls[1] == "https://a.com/high");
+    CHECK(pMockAssetAccessor->urls[2] == "https://a.com/low");
+    CHECK(pMockAssetAccessor->urls[3] == "https://a.com/none");
+  }
+
+  SECTION("queued requests can be reprioritized") {
+    SchedulingAssetAccessor accessor(pMockAssetAccessor, 1);
+    Future<std::shared_ptr<IAssetRequest>> first =
+        accessor.get(asyncSystem, "https://a.com/first", {});
+    Future<std::shared_ptr<IAssetRequest>> second =
+        accessor.get(asyncSystem, "https://a.com/second", {});
+    Future<std::shared_ptr<IAssetRequest>> third =
+        accessor.get(asyncSystem, "https://a.com/third", {});
+
+    accessor.reprioritize("https://a.com/third", TaskPriority{0, 1.0});
+    pMockAssetAccessor->complete(0);
+
+    REQUIRE(pMockAssetAccessor->urls.size() == 2);
+    CHECK(pMockAssetAccessor->urls[1] == "https://a.com/third");
+  }
+}
+
+TEST_CASE("SchedulingAssetAccessor::getHost") {
+  CHECK(
+      SchedulingAssetAccessor::getHost("https://a.com:8080/path?query") ==
+      "a.com:8080");
+  CHECK(SchedulingAssetAccessor::getHost("https://a.com?query") == "a.com");
+  CHECK(SchedulingAssetAccessor::getHost("https://a.com") == "a.com");
+  CHECK(SchedulingAssetAccessor::getHost("data:text/plain,a") == "");
+}
@@ -0,0 +1,121 @@
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/WorkStealingTaskProcessor.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace CesiumAsync;
+
+TEST_CASE("WorkStealingTaskProcessor") {
+  WorkStealingTaskProcessorOptions options;
+  options.numberOfThreads = 4;
+
+  SECTION("creates the requested number of threads") {
+    WorkStealingTaskProcessor processor(options);
+    CHECK(processor.getNumberOfThreads() == 4);
+
+    WorkStealingTaskProcessor defaultProcessor;
+    CHECK(defaultProcessor.getNumberOfThreads() > 0);
+  }
+
+  SECTION("runs every task, including tasks started by tasks") {
+    std::atomic<int32_t> tasksRun = 0;
+    {
+      WorkStealingTaskProcessor processor(options);
+      for (int32_t i = 0; i < 100; ++i) {
+        processor.startTask([&processor, &tasksRun]() {
+          ++tasksRun;
+          for (int32_t j = 0; j < 10; ++j) {
+            processor.startTask([&tasksRun]() { ++tasksRun; });
+          }
+        });
+      }
+    }
+
+    // The remaining tasks are run before the processor is destroyed.
+    CHECK(tasksRun == 1100);
+  }
+
+  SECTION("runs tasks in its worker threads") {
+    WorkStealingTaskProcessor processor(options);
+    const std::thread::id mainThread = std::this_thread::get_id();
+    std::atomic<bool> ranInMainThread = false;
+    std::atomic<int32_t> tasksRun = 0;
+    for (int32_t i = 0; i < 100; ++i) {
+      processor.startTask([mainThread, &ranInMainThread, &tasksRun]() {
+        if (std::this_thread::get_id() == mainThread) {
+          ranInMainThread = true;
+        }
+        ++tasksRun;
+      });
+    }
+
+    while (tasksRun < 100) {
+      std::this_thread::yield();
+    }
+    CHECK(!ranInMainThread);
+  }
+
+  SECTION("runs tasks with a priority first, in order of priority") {
+    options.numberOfThreads = 1;
+    std::mutex mutex;
+    std::vector<int32_t> order;
+    {
+      WorkStealingTaskProcessor processor(options);
+
+      // Keep the only worker busy until all the tasks are started.
+      std::atomic<bool> blocked = true;
+      processor.startTask([&blocked]() {
+        while (blocked) {
+          std::this_thread::yield();
+        }
+      });
+
+      const auto recordTask = [&mutex, &order](int32_t id) {
+        return [&mutex, &order, id]() {
+          std::lock_guard<std::mutex> lock(mutex);
+          order.emplace_back(id);
+        };
+      };
+      processor.startTask(recordTask(0));
+      processor.startPrioritizedTask(recordTask(1), TaskPriority{0, 2.0});
+      processor.startPrioritizedTask(recordTask(2), TaskPriority{1, 5.0});
+      processor.startPrioritizedTask(recordTask(3), TaskPriority{0, 1.0});
+
+      blocked = false;
+    }
+
+    CHECK(order == std::vector<int32_t>{2, 3, 1, 0});
+  }
+
+  SECTION("works with an AsyncSystem") {
+    AsyncSystem asyncSystem(
+        std::make_shared<WorkStealingTaskProcessor>(options));
+
+    std::vector<Future<int32_t>> futures;
+    for (int32_t i = 0; i < 50; ++i) {
+      futures.emplace_back(
+          asyncSystem.runInWorkerThread([i]() { return i; })
+              .thenInWorkerThread([](int32_t value) { return value * 2; }));
+    }
+
+    const std::vector<int32_t> results =
+        asyncSystem.all(std::move(futures)).wait();
+    REQUIRE(results.size() == 50);
+    for (size_t i = 0; i < results.size(); ++i) {
+      CHECK(results[i] == int32_t(i) * 2);
+    }
+  }
+
+  SECTION("may pin its threads to cores") {
+    options.pinThreadsToCores = true;
+    AsyncSystem asyncSystem(
+        std::make_shared<WorkStealingTaskProcessor>(options));
+    CHECK(asyncSystem.runInWorkerThread([]() { return 42; }).wait() == 42);
+  }
+}
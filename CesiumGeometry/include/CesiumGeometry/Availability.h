@@ -37,6 +37,56 @@ struct CESIUMGEOMETRY_API AvailabilitySubtree {
   std::vector<std::vector<std::byte>> buffers;
 };
 
+/**
+ * @brief An availability bitstream of a loaded subtree, laid out for fast
+ * queries.
+ *
+ * The bits are packed into 64-bit words, and the number of set bits before
+ * each word is stored with it, so that counting the set bits before any bit,
+ * which is how the index of an available child subtree is found, takes a
+ * single population count instead of a pass over the buffer.
+ */
+class CESIUMGEOMETRY_API AvailabilityBitstream {
+public:
+  /**
+   * @brief Creates an invalid bitstream, in which no bit is set.
+   */
+  AvailabilityBitstream() noexcept = default;
+
+  /**
+   * @brief Creates a bitstream from an availability view of a subtree.
+   *
+   * @param view The availability view.
+   * @param subtree The subtree that holds the buffers of the view.
+   */
+  AvailabilityBitstream(
+      const AvailabilityView& view,
+      const AvailabilitySubtree& subtree) noexcept;
+
+  /**
+   * @brief Whether the view was either constant or a valid buffer view.
+   */
+  bool isValid() const noexcept { return this->_valid; }
+
+  /**
+   * @brief Whether the bit at the given index is set.
+   */
+  bool isAvailable(uint32_t index) const noexcept;
+
+  /**
+   * @brief Counts the set bits before the given index.
+   *
+   * For a constant bitstream where every bit is set, this is the index.
+   */
+  uint32_t countAvailableBefore(uint32_t index) const noexcept;
+
+private:
+  bool _valid = false;
+  bool _constant = false;
+  std::vector<uint64_t> _words;
+  std::vector<uint32_t> _setBitsBeforeWord;
+};
+
 /**
  * @brief Availability nodes wrap subtree objects and link them together to
  * form a downwardly traversable availability tree.
@@ -70,6 +120,34 @@ struct CESIUMGEOMETRY_API AvailabilityNode {
   void setLoadedSubtree(
       AvailabilitySubtree&& subtree_,
       uint32_t maxChildrenSubtrees) noexcept;
+
+  /**
+   * @brief Finds the index in {@link childNodes} of a child subtree.
+   *
+   * @param mortonIndex The Morton index of the child subtree among all the
+   * possible children of this node's subtree.
+   * @return The index, or `std::nullopt` if the subtree isn't loaded or the
+   * child subtree isn't available.
+   */
+  std::optional<uint32_t>
+  findChildSubtreeIndex(uint32_t mortonIndex) const noexcept;
+
+  /**
+   * @brief The bits of the tile availability of the loaded subtree, indexed in
+   * level order as in the subtree.
+   */
+  AvailabilityBitstream tileAvailabilityBits;
+
+  /**
+   * @brief The bits of the content availability of the loaded subtree.
+   */
+  AvailabilityBitstream contentAvailabilityBits;
+
+  /**
+   * @brief The bits of the child subtree availability of the loaded subtree,
+   * indexed by Morton index.
+   */
+  AvailabilityBitstream subtreeAvailabilityBits;
 };
 
 struct CESIUMGEOMETRY_API AvailabilityTree {
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CullingResult.h"
+#include "Library.h"
+
+#include <gsl/span>
+
+#include <cstddef>
+
+namespace CesiumGeometry {
+class BoundingSphere;
+class OrientedBoundingBox;
+class Plane;
+
+/**
+ * @brief Functions for culling many bounding volumes against a set of planes
+ * at once.
+ *
+ * The bounding volumes are processed in groups of {@link LaneCount}. Each
+ * group is transposed into a structure-of-arrays layout on the stack and then
+ * tested against every plane with branch-free loops over the group, which
+ * compilers turn into SSE, AVX, or NEON instructions as available on the
+ * target.
+ *
+ * The result for each volume is identical to calling `intersectPlane` for
+ * each plane and combining the results: {@link CullingResult::Outside} if the
+ * volume is outside any plane, {@link CullingResult::Inside} if it is inside
+ * all of them, and {@link CullingResult::Intersecting} otherwise.
+ */
+class CESIUMGEOMETRY_API BatchCulling final {
+public:
+  /**
+   * @brief The number of bounding volumes that are tested together.
+   */
+  static constexpr size_t LaneCount = 8;
+
+  /**
+   * @brief Tests each of the given boxes against all of the given planes.
+   *
+   * @param planes The planes to test against.
+   * @param boxes The boxes to test.
+   * @param results Receives the result for each box. Must be at least as large
+   * as `boxes`.
+   */
+  static void intersectPlanes(
+      gsl::span<const Plane> planes,
+      gsl::span<const OrientedBoundingBox> boxes,
+      gsl::span<CullingResult> results) noexcept;
+
+  /**
+   * @copydoc intersectPlanes(gsl::span<const Plane>, gsl::span<const OrientedBoundingBox>, gsl::span<CullingResult>)
+   */
+  static void intersectPlanes(
+      gsl::span<const Plane> planes,
+      gsl::span<const OrientedBoundingBox* const> boxes,
+      gsl::span<CullingResult> results) noexcept;
+
+  /**
+   * @brief Tests each of the given spheres against all of the given planes.
+   *
+   * @param planes The planes to test against.
+   * @param spheres The spheres to test.
+   * @param results Receives the result for each sphere. Must be at least as
+   * large as `spheres`.
+   */
+  static void intersectPlanes(
+      gsl::span<const Plane> planes,
+      gsl::span<const BoundingSphere> spheres,
+      gsl::span<CullingResult> results) noexcept;
+
+  /**
+   * @copydoc intersectPlanes(gsl::span<const Plane>, gsl::span<const BoundingSphere>, gsl::span<CullingResult>)
+   */
+  static void intersectPlanes(
+      gsl::span<const Plane> planes,
+      gsl::span<const BoundingSphere* const> spheres,
+      gsl::span<CullingResult> results) noexcept;
+};
+
+} // namespace CesiumGeometry
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "Library.h"
+
+#include <glm/vec3.hpp>
+#include <gsl/span>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+namespace CesiumGeometry {
+class BoundingSphere;
+class OrientedBoundingBox;
+class Ray;
+struct AxisAlignedBox;
+
+/**
+ * @brief Functions for intersecting a ray with many primitives, or many rays
+ * with a primitive, at once.
+ *
+ * The rays or primitives are processed in groups of {@link LaneCount}, which
+ * are transposed into a structure-of-arrays layout on the stack and tested
+ * with branch-free loops over the group, like {@link BatchCulling}.
+ *
+ * Unless noted otherwise, each result is identical to that of the matching
+ * function of {@link IntersectionTests}: the distance along the ray to the
+ * intersection, or `std::nullopt` if there is none.
+ */
+class CESIUMGEOMETRY_API BatchIntersection final {
+public:
+  /**
+   * @brief The number of rays or primitives that are tested together.
+   */
+  static constexpr size_t LaneCount = 8;
+
+  /**
+   * @brief Intersects a ray with each of the given triangles, see
+   * {@link IntersectionTests::rayTriangleParametric}.
+   *
+   * @param ray The ray.
+   * @param triangles The triangles, each given by its three vertices.
+   * @param results Receives the result for each triangle. Must be at least as
+   * large as `triangles`.
+   * @param cullBackFaces Whether to ignore the triangles whose backs the ray
+   * hits.
+   */
+  static void intersectRay(
+      const Ray& ray,
+      gsl::span<const std::array<glm::dvec3, 3>> triangles,
+      gsl::span<std::optional<double>> results,
+      bool cullBackFaces = false) noexcept;
+
+  /**
+   * @brief Intersects a ray with each of the given single-precision triangles.
+   *
+   * This is computed in single precision, so twice as many triangles fit in a
+   * vector register, and is mostly suited to triangles in a local frame whose
+   * origin is near the ray. It may differ slightly from
+   * {@link IntersectionTests::rayTriangleParametric}.
+   *
+   * @param ray The ray, in the same frame as the triangles.
+   * @param triangles The triangles, each given by its three vertices.
+   * @param results Receives the result for each triangle. Must be at least as
+   * large as `triangles`.
+   * @param cullBackFaces Whether to ignore the triangles whose backs the ray
+   * hits.
+   */
+  static void intersectRay(
+      const Ray& ray,
+      gsl::span<const std::array<glm::vec3, 3>> triangles,
+      gsl::span<std::optional<double>> results,
+      bool cullBackFaces = false) noexcept;
+
+  /**
+   * @brief Intersects a ray with each of the given boxes, see
+   * {@link IntersectionTests::rayAABBParametric}.
+   *
+   * @param ray The ray.
+   * @param boxes The boxes.
+   * @param results Receives the result for each box. Must be at least as
+   * large as `boxes`.
+   */
+  static void intersectRay(
+      const Ray& ray,
+      gsl::span<const AxisAlignedBox> boxes,
+      gsl::span<std::optional<double>> results) noexcept;
+
+  /**
+   * @brief Intersects a ray with each of the given boxes, see
+   * {@link IntersectionTests::rayOBBParametric}.
+   *
+   * @param ray The ray.
+   * @param boxes The boxes.
+   * @param results Receives the result for each box. Must be at least as
+   * large as `boxes`.
+   */
+  static void intersectRay(
+      const Ray& ray,
+      gsl::span<const OrientedBoundingBox> boxes,
+      gsl::span<std::optional<double>> results) noexcept;
+
+  /**
+   * @brief Intersects a ray with each of the given spheres, see
+   * {@link IntersectionTests::raySphereParametric}.
+   *
+   * @param ray The ray.
+   * @param spheres The spheres.
+   * @param results Receives the result for each sphere. Must be at least as
+   * large as `spheres`.
+   */
+  static void intersectRay(
+      const Ray& ray,
+      gsl::span<const BoundingSphere> spheres,
+      gsl::span<std::optional<double>> results) noexcept;
+
+  /**
+   * @brief Intersects each of the given rays with a triangle, see
+   * {@link IntersectionTests::rayTriangleParametric}.
+   *
+   * @param rays The rays.
+   * @param p0 The first vertex of the triangle.
+   * @param p1 The second vertex of the triangle.
+   * @param p2 The third vertex of the triangle.
+   * @param results Receives the result for each ray. Must be at least as
+   * large as `rays`.
+   * @param cullBackFaces Whether to ignore the rays that hit the back of the
+   * triangle.
+   */
+  static void intersectRays(
+      gsl::span<const Ray> rays,
+      const glm::dvec3& p0,
+      const glm::dvec3& p1,
+      const glm::dvec3& p2,
+      gsl::span<std::optional<double>> results,
+      bool cullBackFaces = false) noexcept;
+
+  /**
+   * @brief Intersects each of the given rays with a box, see
+   * {@link IntersectionTests::rayAABBParametric}.
+   *
+   * @param rays The rays.
+   * @param box The box.
+   * @param results Receives the result for each ray. Must be at least as
+   * large as `rays`.
+   */
+  static void intersectRays(
+      gsl::span<const Ray> rays,
+      const AxisAlignedBox& box,
+      gsl::span<std::optional<double>> results) noexcept;
+
+  /**
+   * @brief Intersects each of the given rays with a box, see
+   * {@link IntersectionTests::rayOBBParametric}.
+   *
+   * @param rays The rays.
+   * @param box The box.
+   * @param results Receives the result for each ray. Must be at least as
+   * large as `rays`.
+   */
+  static void intersectRays(
+      gsl::span<const Ray> rays,
+      const OrientedBoundingBox& box,
+      gsl::span<std::optional<double>> results) noexcept;
+
+  /**
+   * @brief Intersects each of the given rays with a sphere, see
+   * {@link IntersectionTests::raySphereParametric}.
+   *
+   * @param rays The rays.
+   * @param sphere The sphere.
+   * @param results Receives the result for each ray. Must be at least as
+   * large as `rays`.
+   */
+  static void intersectRays(
+      gsl::span<const Ray> rays,
+      const BoundingSphere& sphere,
+      gsl::span<std::optional<double>> results) noexcept;
+};
+
+} // namespace CesiumGeometry
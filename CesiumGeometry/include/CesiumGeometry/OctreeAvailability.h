@@ -34,6 +34,22 @@ public:
    */
   uint8_t computeAvailability(const OctreeTileID& tileID) const noexcept;
 
+  /**
+   * @brief Determines the currently known availability status of many tiles.
+   *
+   * This gives the same results as calling {@link computeAvailability} for
+   * each tile, but a tile in the same loaded subtree as the one before it is
+   * found without traversing the availability tree from the root, so it's
+   * fastest when tiles that are near each other are adjacent.
+   *
+   * @param tileIDs The IDs of the tiles.
+   * @param availability The {@link TileAvailabilityFlags} of each tile, in
+   * the same order. It must be at least as long as the tile IDs.
+   */
+  void computeAvailability(
+      const gsl::span<const OctreeTileID>& tileIDs,
+      const gsl::span<uint8_t>& availability) const noexcept;
+
   /**
    * @brief Attempts to add an availability subtree into the existing overall
    * availability tree.
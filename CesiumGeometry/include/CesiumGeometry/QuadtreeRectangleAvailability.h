@@ -7,13 +7,21 @@
 
 #include <glm/vec2.hpp>
 
-#include <memory>
+#include <cstdint>
 #include <vector>
 
 namespace CesiumGeometry {
 
 /**
  * @brief Manages information about the availability of tiles in a quadtree.
+ *
+ * The available ranges of each level are kept in a segment tree over the
+ * columns of the level, whose nodes hold the merged row intervals of the
+ * ranges that span them. Finding whether a level has a range that contains a
+ * tile takes a number of binary searches that grows with the logarithm of the
+ * number of ranges at the level. The index of a level is rebuilt by the first
+ * query after ranges are added to it, so this class is not thread-safe, even
+ * for queries.
  */
 class CESIUMGEOMETRY_API QuadtreeRectangleAvailability final {
 public:
@@ -22,7 +30,8 @@ public:
    *
    * @param tilingScheme The {@link QuadtreeTilingScheme}.
    * @param maximumLevel The maximum level (height of the tree) for which
-   * the availability should be tracked.
+   * the availability is expected to be tracked. Ranges at deeper levels may
+   * still be added.
    */
   QuadtreeRectangleAvailability(
       const QuadtreeTilingScheme& tilingScheme,
@@ -64,58 +73,62 @@ public:
    */
   uint8_t isTileAvailable(const QuadtreeTileID& id) const noexcept;
 
+  /**
+   * @brief Determines which of the four children of a tile are available.
+   *
+   * This gives the same results as calling {@link isTileAvailable} for each
+   * child, but looks at each level only once for all of them.
+   *
+   * @param id The quadtree tile ID of the parent.
+   * @returns A bit mask in which the bit `2 * dy + dx` is set when the child
+   * with the ID `(id.level + 1, 2 * id.x + dx, 2 * id.y + dy)` is available.
+   */
+  uint8_t computeAvailableChildren(const QuadtreeTileID& id) const noexcept;
+
 private:
-  struct RectangleWithLevel {
-    uint32_t level;
-    Rectangle rectangle;
+  // A half-open interval of rows.
+  struct RowInterval {
+    uint64_t begin;
+    uint64_t end;
   };
 
-  struct QuadtreeNode {
-    QuadtreeNode(
-        const QuadtreeTileID& id_,
-        const Rectangle& extent_,
-        QuadtreeNode* pParent_) noexcept
-        : id(id_),
-          extent(extent_),
-          pParent(pParent_),
-          ll(),
-          lr(),
-          ul(),
-          ur(),
-          rectangles() {}
-
-    QuadtreeTileID id;
-
-    CesiumGeometry::Rectangle extent;
-
-    QuadtreeNode* pParent;
-    std::unique_ptr<QuadtreeNode> ll;
-    std::unique_ptr<QuadtreeNode> lr;
-    std::unique_ptr<QuadtreeNode> ul;
-    std::unique_ptr<QuadtreeNode> ur;
-
-    std::vector<RectangleWithLevel> rectangles;
+  struct LevelIndex {
+    std::vector<QuadtreeTileRectangularRange> ranges;
+
+    // The sorted, distinct first and past-the-end columns of the ranges,
+    // which bound the leaves of the segment tree.
+    std::vector<uint64_t> columnBounds;
+
+    // The nodes of the segment tree, with the children of node i at 2i and
+    // 2i + 1. Each holds the sorted, disjoint row intervals of the ranges
+    // that span the columns of the node but not those of its parent.
+    std::vector<std::vector<RowInterval>> nodes;
+
+    bool isDirty = false;
+
+    void build() noexcept;
+    void insert(
+        size_t node,
+        size_t first,
+        size_t last,
+        uint64_t beginColumn,
+        uint64_t endColumn,
+        const RowInterval& rows) noexcept;
+    bool contains(uint64_t column, uint64_t row) const noexcept;
+    bool containsAny(
+        uint64_t firstColumn,
+        uint64_t lastColumn,
+        uint64_t firstRow,
+        uint64_t lastRow) const noexcept;
   };
 
-  QuadtreeTilingScheme _tilingScheme;
-  uint32_t _maximumLevel;
-  std::vector<std::unique_ptr<QuadtreeNode>> _rootNodes;
+  const LevelIndex* getLevelIndex(uint32_t level) const noexcept;
+  static bool isTileCenterAvailableAtLevel(
+      const LevelIndex& index,
+      const QuadtreeTileID& id,
+      uint32_t level) noexcept;
 
-  static void putRectangleInQuadtree(
-      const QuadtreeTilingScheme& tilingScheme,
-      uint32_t maximumLevel,
-      QuadtreeRectangleAvailability::QuadtreeNode& node,
-      const QuadtreeRectangleAvailability::RectangleWithLevel&
-          rectangle) noexcept;
-  static bool rectangleLevelComparator(
-      const QuadtreeRectangleAvailability::RectangleWithLevel& a,
-      const QuadtreeRectangleAvailability::RectangleWithLevel& b) noexcept;
-  static uint32_t findMaxLevelFromNode(
-      QuadtreeNode* pStopNode,
-      QuadtreeNode& node,
-      const glm::dvec2& position) noexcept;
-  static void createNodeChildrenIfNecessary(
-      QuadtreeNode& node,
-      const QuadtreeTilingScheme& tilingScheme) noexcept;
+  QuadtreeTilingScheme _tilingScheme;
+  mutable std::vector<LevelIndex> _levels;
 };
 } // namespace CesiumGeometry
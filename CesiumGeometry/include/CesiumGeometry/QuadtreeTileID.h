@@ -97,6 +97,20 @@ struct CESIUMGEOMETRY_API UpsampledQuadtreeNode final {
    * @brief The {@link QuadtreeTileID} for this tree node.
    */
   QuadtreeTileID tileID;
+
+  /**
+   * @brief Returns `true` if two nodes are equal.
+   */
+  constexpr bool operator==(const UpsampledQuadtreeNode& other) const noexcept {
+    return this->tileID == other.tileID;
+  }
+
+  /**
+   * @brief Returns `true` if two nodes are *not* equal.
+   */
+  constexpr bool operator!=(const UpsampledQuadtreeNode& other) const noexcept {
+    return !(*this == other);
+  }
 };
 } // namespace CesiumGeometry
 
@@ -28,6 +28,79 @@ uint32_t countOnesInBuffer(gsl::span<const std::byte> buffer) {
 }
 } // namespace AvailabilityUtilities
 
+namespace {
+uint32_t countOnesInWord(uint64_t word) noexcept {
+  // For reference:
+  // https://graphics.stanford.edu/~seander/bithacks.html#CountBitsSetParallel
+  word = word - ((word >> 1) & 0x5555555555555555ULL);
+  word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+  word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return static_cast<uint32_t>((word * 0x0101010101010101ULL) >> 56);
+}
+} // namespace
+
+AvailabilityBitstream::AvailabilityBitstream(
+    const AvailabilityView& view,
+    const AvailabilitySubtree& subtree) noexcept {
+  const AvailabilityAccessor accessor(view, subtree);
+  if (accessor.isConstant()) {
+    this->_valid = true;
+    this->_constant = accessor.getConstant();
+    return;
+  }
+
+  if (!accessor.isBufferView()) {
+    return;
+  }
+
+  this->_valid = true;
+
+  // Bit i of the buffer is bit i % 8 of byte i / 8, so the bytes are packed
+  // into the words from the least significant end.
+  const gsl::span<const std::byte>& buffer = accessor.getBufferAccessor();
+  this->_words.resize((buffer.size() + 7) / 8);
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    this->_words[i / 8] |= uint64_t(buffer[i]) << ((i % 8) * 8);
+  }
+
+  this->_setBitsBeforeWord.resize(this->_words.size() + 1);
+  uint32_t setBits = 0;
+  for (size_t i = 0; i < this->_words.size(); ++i) {
+    this->_setBitsBeforeWord[i] = setBits;
+    setBits += countOnesInWord(this->_words[i]);
+  }
+  this->_setBitsBeforeWord.back() = setBits;
+}
+
+bool AvailabilityBitstream::isAvailable(uint32_t index) const noexcept {
+  if (this->_words.empty()) {
+    return this->_constant;
+  }
+
+  const size_t wordIndex = index >> 6;
+  if (wordIndex >= this->_words.size()) {
+    return false;
+  }
+
+  return (this->_words[wordIndex] >> (index & 63)) & 1;
+}
+
+uint32_t
+AvailabilityBitstream::countAvailableBefore(uint32_t index) const noexcept {
+  if (this->_words.empty()) {
+    return this->_constant ? index : 0;
+  }
+
+  const size_t wordIndex = index >> 6;
+  if (wordIndex >= this->_words.size()) {
+    return this->_setBitsBeforeWord.back();
+  }
+
+  const uint64_t bitsBefore = (uint64_t(1) << (index & 63)) - 1;
+  return this->_setBitsBeforeWord[wordIndex] +
+         countOnesInWord(this->_words[wordIndex] & bitsBefore);
+}
+
 AvailabilityNode::AvailabilityNode() noexcept
     : subtree(std::nullopt), childNodes() {}
 
@@ -36,23 +109,32 @@ void AvailabilityNode::setLoadedSubtree(
     uint32_t maxChildrenSubtrees) noexcept {
   this->subtree = std::make_optional<AvailabilitySubtree>(std::move(subtree_));
 
-  AvailabilityAccessor subtreeAvailabilityAccessor(
+  this->tileAvailabilityBits = AvailabilityBitstream(
+      this->subtree->tileAvailability,
+      *this->subtree);
+  this->contentAvailabilityBits = AvailabilityBitstream(
+      this->subtree->contentAvailability,
+      *this->subtree);
+  this->subtreeAvailabilityBits = AvailabilityBitstream(
       this->subtree->subtreeAvailability,
       *this->subtree);
 
-  size_t childNodesCount = 0;
-  if (subtreeAvailabilityAccessor.isConstant()) {
-    if (subtreeAvailabilityAccessor.getConstant()) {
-      childNodesCount = maxChildrenSubtrees;
-    }
-  } else if (subtreeAvailabilityAccessor.isBufferView()) {
-    childNodesCount = AvailabilityUtilities::countOnesInBuffer(
-        subtreeAvailabilityAccessor.getBufferAccessor());
-  } else {
+  if (!this->subtreeAvailabilityBits.isValid()) {
     return;
   }
 
-  this->childNodes.resize(childNodesCount);
+  this->childNodes.resize(
+      this->subtreeAvailabilityBits.countAvailableBefore(maxChildrenSubtrees));
+}
+
+std::optional<uint32_t>
+AvailabilityNode::findChildSubtreeIndex(uint32_t mortonIndex) const noexcept {
+  if (!this->subtree ||
+      !this->subtreeAvailabilityBits.isAvailable(mortonIndex)) {
+    return std::nullopt;
+  }
+
+  return this->subtreeAvailabilityBits.countAvailableBefore(mortonIndex);
 }
 
 AvailabilityAccessor::AvailabilityAccessor(
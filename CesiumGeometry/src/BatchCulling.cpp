@@ -0,0 +1,187 @@
+#include "CesiumGeometry/BatchCulling.h"
+
+#include "CesiumGeometry/BoundingSphere.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
+#include "CesiumGeometry/Plane.h"
+
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace CesiumGeometry {
+
+namespace {
+constexpr size_t LaneCount = BatchCulling::LaneCount;
+using LaneArray = std::array<double, LaneCount>;
+using LaneMask = std::array<uint32_t, LaneCount>;
+
+const OrientedBoundingBox& getBox(const OrientedBoundingBox& box) noexcept {
+  return box;
+}
+
+const OrientedBoundingBox& getBox(const OrientedBoundingBox* pBox) noexcept {
+  return *pBox;
+}
+
+const BoundingSphere& getSphere(const BoundingSphere& sphere) noexcept {
+  return sphere;
+}
+
+const BoundingSphere& getSphere(const BoundingSphere* pSphere) noexcept {
+  return *pSphere;
+}
+
+CullingResult toCullingResult(uint32_t outside, uint32_t inside) noexcept {
+  if (outside) {
+    return CullingResult::Outside;
+  }
+  return inside ? CullingResult::Inside : CullingResult::Intersecting;
+}
+
+template <typename T>
+void intersectBoxes(
+    gsl::span<const Plane> planes,
+    gsl::span<const T> boxes,
+    gsl::span<CullingResult> results) noexcept {
+  for (size_t first = 0; first < boxes.size(); first += LaneCount) {
+    const size_t count = std::min(LaneCount, boxes.size() - first);
+
+    alignas(32) LaneArray centerX;
+    alignas(32) LaneArray centerY;
+    alignas(32) LaneArray centerZ;
+    alignas(32) std::array<LaneArray, 3> axisX;
+    alignas(32) std::array<LaneArray, 3> axisY;
+    alignas(32) std::array<LaneArray, 3> axisZ;
+
+    // Unused lanes repeat the last box so that every lane holds valid values;
+    // their results are never written out.
+    for (size_t i = 0; i < LaneCount; ++i) {
+      const OrientedBoundingBox& box =
+          getBox(boxes[first + std::min(i, count - 1)]);
+      const glm::dvec3& center = box.getCenter();
+      const glm::dmat3& halfAxes = box.getHalfAxes();
+      centerX[i] = center.x;
+      centerY[i] = center.y;
+      centerZ[i] = center.z;
+      for (glm::length_t axis = 0; axis < 3; ++axis) {
+        const size_t a = size_t(axis);
+        axisX[a][i] = halfAxes[axis].x;
+        axisY[a][i] = halfAxes[axis].y;
+        axisZ[a][i] = halfAxes[axis].z;
+      }
+    }
+
+    LaneMask outside{};
+    LaneMask inside;
+    inside.fill(1);
+
+    for (const Plane& plane : planes) {
+      const glm::dvec3& normal = plane.getNormal();
+      const double nx = normal.x;
+      const double ny = normal.y;
+      const double nz = normal.z;
+      const double planeDistance = plane.getDistance();
+
+      // Same arithmetic, in the same order, as
+      // OrientedBoundingBox::intersectPlane.
+      for (size_t i = 0; i < LaneCount; ++i) {
+        const double radEffective =
+            glm::abs(nx * axisX[0][i] + ny * axisY[0][i] + nz * axisZ[0][i]) +
+            glm::abs(nx * axisX[1][i] + ny * axisY[1][i] + nz * axisZ[1][i]) +
+            glm::abs(nx * axisX[2][i] + ny * axisY[2][i] + nz * axisZ[2][i]);
+        const double distanceToPlane =
+            nx * centerX[i] + ny * centerY[i] + nz * centerZ[i] +
+            planeDistance;
+        outside[i] |= uint32_t(distanceToPlane <= -radEffective);
+        inside[i] &= uint32_t(distanceToPlane >= radEffective);
+      }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      results[first + i] = toCullingResult(outside[i], inside[i]);
+    }
+  }
+}
+
+template <typename T>
+void intersectSpheres(
+    gsl::span<const Plane> planes,
+    gsl::span<const T> spheres,
+    gsl::span<CullingResult> results) noexcept {
+  for (size_t first = 0; first < spheres.size(); first += LaneCount) {
+    const size_t count = std::min(LaneCount, spheres.size() - first);
+
+    alignas(32) LaneArray centerX;
+    alignas(32) LaneArray centerY;
+    alignas(32) LaneArray centerZ;
+    alignas(32) LaneArray radius;
+
+    for (size_t i = 0; i < LaneCount; ++i) {
+      const BoundingSphere& sphere =
+          getSphere(spheres[first + std::min(i, count - 1)]);
+      const glm::dvec3& center = sphere.getCenter();
+      centerX[i] = center.x;
+      centerY[i] = center.y;
+      centerZ[i] = center.z;
+      radius[i] = sphere.getRadius();
+    }
+
+    LaneMask outside{};
+    LaneMask inside;
+    inside.fill(1);
+
+    for (const Plane& plane : planes) {
+      const glm::dvec3& normal = plane.getNormal();
+      const double nx = normal.x;
+      const double ny = normal.y;
+      const double nz = normal.z;
+      const double planeDistance = plane.getDistance();
+
+      // Same arithmetic, in the same order, as BoundingSphere::intersectPlane.
+      for (size_t i = 0; i < LaneCount; ++i) {
+        const double distanceToPlane =
+            nx * centerX[i] + ny * centerY[i] + nz * centerZ[i] +
+            planeDistance;
+        outside[i] |= uint32_t(distanceToPlane < -radius[i]);
+        inside[i] &= uint32_t(distanceToPlane >= radius[i]);
+      }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      results[first + i] = toCullingResult(outside[i], inside[i]);
+    }
+  }
+}
+} // namespace
+
+/*static*/ void BatchCulling::intersectPlanes(
+    gsl::span<const Plane> planes,
+    gsl::span<const OrientedBoundingBox> boxes,
+    gsl::span<CullingResult> results) noexcept {
+  intersectBoxes(planes, boxes, results);
+}
+
+/*static*/ void BatchCulling::intersectPlanes(
+    gsl::span<const Plane> planes,
+    gsl::span<const OrientedBoundingBox* const> boxes,
+    gsl::span<CullingResult> results) noexcept {
+  intersectBoxes(planes, boxes, results);
+}
+
+/*static*/ void BatchCulling::intersectPlanes(
+    gsl::span<const Plane> planes,
+    gsl::span<const BoundingSphere> spheres,
+    gsl::span<CullingResult> results) noexcept {
+  intersectSpheres(planes, spheres, results);
+}
+
+/*static*/ void BatchCulling::intersectPlanes(
+    gsl::span<const Plane> planes,
+    gsl::span<const BoundingSphere* const> spheres,
+    gsl::span<CullingResult> results) noexcept {
+  intersectSpheres(planes, spheres, results);
+}
+
+} // namespace CesiumGeometry
@@ -0,0 +1,435 @@
+#include "CesiumGeometry/BatchIntersection.h"
+
+#include "CesiumGeometry/AxisAlignedBox.h"
+#include "CesiumGeometry/BoundingSphere.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
+#include "CesiumGeometry/Ray.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <glm/common.hpp>
+#include <glm/exponential.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+using namespace CesiumUtility;
+
+namespace CesiumGeometry {
+
+namespace {
+constexpr size_t LaneCount = BatchIntersection::LaneCount;
+using LaneMask = std::array<uint32_t, LaneCount>;
+
+// One vector for each lane, stored as a structure of arrays.
+template <typename T> struct VectorLanes {
+  alignas(32) std::array<T, LaneCount> x;
+  alignas(32) std::array<T, LaneCount> y;
+  alignas(32) std::array<T, LaneCount> z;
+
+  void set(size_t lane, const glm::vec<3, T>& value) noexcept {
+    this->x[lane] = value.x;
+    this->y[lane] = value.y;
+    this->z[lane] = value.z;
+  }
+
+  glm::vec<3, T> get(size_t lane) const noexcept {
+    return glm::vec<3, T>(this->x[lane], this->y[lane], this->z[lane]);
+  }
+};
+
+// Tests the items in groups of LaneCount: `load(lane, index)` stores an item
+// in a lane, and `test(lane, t)` tests the lane, returning whether there is an
+// intersection and its distance along the ray in t.
+template <typename T, typename Load, typename Test>
+void intersectInGroups(
+    size_t size,
+    gsl::span<std::optional<double>> results,
+    Load&& load,
+    Test&& test) noexcept {
+  for (size_t first = 0; first < size; first += LaneCount) {
+    const size_t count = std::min(LaneCount, size - first);
+
+    // Unused lanes repeat the last item so that every lane holds valid values;
+    // their results are never written out.
+    for (size_t lane = 0; lane < LaneCount; ++lane) {
+      load(lane, first + std::min(lane, count - 1));
+    }
+
+    alignas(32) std::array<T, LaneCount> t;
+    LaneMask hit;
+    for (size_t lane = 0; lane < LaneCount; ++lane) {
+      hit[lane] = test(lane, t[lane]);
+    }
+
+    for (size_t lane = 0; lane < count; ++lane) {
+      results[first + lane] =
+          hit[lane] ? std::optional<double>(double(t[lane])) : std::nullopt;
+    }
+  }
+}
+
+// Same arithmetic, in the same order, as
+// IntersectionTests::rayTriangleParametric, with the early returns combined
+// into the returned mask.
+template <typename T>
+uint32_t rayTriangle(
+    const glm::vec<3, T>& origin,
+    const glm::vec<3, T>& direction,
+    const glm::vec<3, T>& p0,
+    const glm::vec<3, T>& edge0,
+    const glm::vec<3, T>& edge1,
+    bool cullBackFaces,
+    T& t) noexcept {
+  const glm::vec<3, T> p = glm::cross(direction, edge1);
+  const T determinant = glm::dot(edge0, p);
+
+  const T epsilon = T(Math::Epsilon12);
+  const bool isFacing = cullBackFaces ? determinant >= epsilon
+                                      : glm::abs(determinant) >= epsilon;
+
+  // This is infinite when the determinant is 0, but then the lane misses.
+  const T inverseDeterminant = T(1) / determinant;
+  const glm::vec<3, T> toOrigin = origin - p0;
+
+  const T u = glm::dot(toOrigin, p) * inverseDeterminant;
+  const glm::vec<3, T> q = glm::cross(toOrigin, edge0);
+  const T v = glm::dot(direction, q) * inverseDeterminant;
+  t = glm::dot(edge1, q) * inverseDeterminant;
+
+  return uint32_t(isFacing) & uint32_t(u >= T(0)) & uint32_t(u <= T(1)) &
+         uint32_t(v >= T(0)) & uint32_t(u + v <= T(1)) & uint32_t(t >= T(0));
+}
+
+// Narrows [tMin, tMax] to where the ray is between the two sides of a slab, as
+// each iteration of IntersectionTests::rayAABBParametric and
+// IntersectionTests::rayOBBParametric does.
+void clipToSlab(
+    double lower,
+    double upper,
+    double position,
+    double speed,
+    bool isParallel,
+    double& tMin,
+    double& tMax,
+    uint32_t& outside) noexcept {
+  outside |= uint32_t(isParallel) &
+             (uint32_t(position < lower) | uint32_t(position > upper));
+
+  // A parallel slab doesn't bound the distances, and dividing by 1 instead
+  // keeps the lane finite.
+  const double safeSpeed = isParallel ? 1.0 : speed;
+  const double t0 = (lower - position) / safeSpeed;
+  const double t1 = (upper - position) / safeSpeed;
+  tMin = isParallel ? tMin : glm::max(tMin, glm::min(t0, t1));
+  tMax = isParallel ? tMax : glm::min(tMax, glm::max(t0, t1));
+}
+
+uint32_t rayAABB(
+    const glm::dvec3& origin,
+    const glm::dvec3& direction,
+    const glm::dvec3& minimum,
+    const glm::dvec3& maximum,
+    double& t) noexcept {
+  double tMin = 0.0;
+  double tMax = std::numeric_limits<double>::max();
+  uint32_t outside = 0;
+  for (glm::length_t i = 0; i < 3; ++i) {
+    clipToSlab(
+        minimum[i],
+        maximum[i],
+        origin[i],
+        direction[i],
+        glm::abs(direction[i]) <= Math::Epsilon15,
+        tMin,
+        tMax,
+        outside);
+  }
+
+  t = tMin;
+  return uint32_t(outside == 0) & uint32_t(tMin <= tMax);
+}
+
+uint32_t rayOBB(
+    const glm::dvec3& origin,
+    const glm::dvec3& direction,
+    const glm::dvec3& center,
+    const std::array<glm::dvec3, 3>& halfAxes,
+    double& t) noexcept {
+  const glm::dvec3 toOrigin = origin - center;
+
+  double tMin = 0.0;
+  double tMax = std::numeric_limits<double>::max();
+  uint32_t outside = 0;
+  for (const glm::dvec3& axis : halfAxes) {
+    const double extent = glm::dot(axis, axis);
+    const double speed = glm::dot(direction, axis);
+    clipToSlab(
+        -extent,
+        extent,
+        glm::dot(toOrigin, axis),
+        speed,
+        glm::abs(speed) <= Math::Epsilon15 * extent,
+        tMin,
+        tMax,
+        outside);
+  }
+
+  t = tMin;
+  return uint32_t(outside == 0) & uint32_t(tMin <= tMax);
+}
+
+// Same arithmetic, in the same order, as
+// IntersectionTests::raySphereParametric.
+uint32_t raySphere(
+    const glm::dvec3& origin,
+    const glm::dvec3& direction,
+    const glm::dvec3& center,
+    double radius,
+    double& t) noexcept {
+  const glm::dvec3 toCenter = center - origin;
+  const double b = glm::dot(toCenter, direction);
+  const double c = glm::dot(toCenter, toCenter) - radius * radius;
+  const double discriminant = b * b - c;
+  const double tEnter = b - glm::sqrt(glm::max(discriminant, 0.0));
+
+  const bool isInside = c <= 0.0;
+  t = isInside ? 0.0 : tEnter;
+  return uint32_t(isInside) |
+         (uint32_t(discriminant >= 0.0) & uint32_t(tEnter >= 0.0));
+}
+
+template <typename T>
+void intersectTriangles(
+    const Ray& ray,
+    gsl::span<const std::array<glm::vec<3, T>, 3>> triangles,
+    gsl::span<std::optional<double>> results,
+    bool cullBackFaces) noexcept {
+  const glm::vec<3, T> origin(ray.getOrigin());
+  const glm::vec<3, T> direction(ray.getDirection());
+
+  VectorLanes<T> p0;
+  VectorLanes<T> edge0;
+  VectorLanes<T> edge1;
+  intersectInGroups<T>(
+      triangles.size(),
+      results,
+      [&](size_t lane, size_t index) {
+        const std::array<glm::vec<3, T>, 3>& triangle = triangles[index];
+        p0.set(lane, triangle[0]);
+        edge0.set(lane, triangle[1] - triangle[0]);
+        edge1.set(lane, triangle[2] - triangle[0]);
+      },
+      [&](size_t lane, T& t) {
+        return rayTriangle(
+            origin,
+            direction,
+            p0.get(lane),
+            edge0.get(lane),
+            edge1.get(lane),
+            cullBackFaces,
+            t);
+      });
+}
+
+// Stores the origin and the direction of each ray in the lanes.
+struct RayLanes {
+  VectorLanes<double> origins;
+  VectorLanes<double> directions;
+
+  void set(size_t lane, const Ray& ray) noexcept {
+    this->origins.set(lane, ray.getOrigin());
+    this->directions.set(lane, ray.getDirection());
+  }
+};
+} // namespace
+
+/*static*/ void BatchIntersection::intersectRay(
+    const Ray& ray,
+    gsl::span<const std::array<glm::dvec3, 3>> triangles,
+    gsl::span<std::optional<double>> results,
+    bool cullBackFaces) noexcept {
+  intersectTriangles<double>(ray, triangles, results, cullBackFaces);
+}
+
+/*static*/ void BatchIntersection::intersectRay(
+    const Ray& ray,
+    gsl::span<const std::array<glm::vec3, 3>> triangles,
+    gsl::span<std::optional<double>> results,
+    bool cullBackFaces) noexcept {
+  intersectTriangles<float>(ray, triangles, results, cullBackFaces);
+}
+
+/*static*/ void BatchIntersection::intersectRay(
+    const Ray& ray,
+    gsl::span<const AxisAlignedBox> boxes,
+    gsl::span<std::optional<double>> results) noexcept {
+  VectorLanes<double> minimums;
+  VectorLanes<double> maximums;
+  intersectInGroups<double>(
+      boxes.size(),
+      results,
+      [&](size_t lane, size_t index) {
+        const AxisAlignedBox& box = boxes[index];
+        minimums.set(
+            lane,
+            glm::dvec3(box.minimumX, box.minimumY, box.minimumZ));
+        maximums.set(
+            lane,
+            glm::dvec3(box.maximumX, box.maximumY, box.maximumZ));
+      },
+      [&](size_t lane, double& t) {
+        return rayAABB(
+            ray.getOrigin(),
+            ray.getDirection(),
+            minimums.get(lane),
+            maximums.get(lane),
+            t);
+      });
+}
+
+/*static*/ void BatchIntersection::intersectRay(
+    const Ray& ray,
+    gsl::span<const OrientedBoundingBox> boxes,
+    gsl::span<std::optional<double>> results) noexcept {
+  VectorLanes<double> centers;
+  std::array<VectorLanes<double>, 3> halfAxes;
+  intersectInGroups<double>(
+      boxes.size(),
+      results,
+      [&](size_t lane, size_t index) {
+        const OrientedBoundingBox& box = boxes[index];
+        centers.set(lane, box.getCenter());
+        for (glm::length_t axis = 0; axis < 3; ++axis) {
+          halfAxes[size_t(axis)].set(lane, box.getHalfAxes()[axis]);
+        }
+      },
+      [&](size_t lane, double& t) {
+        return rayOBB(
+            ray.getOrigin(),
+            ray.getDirection(),
+            centers.get(lane),
+            {halfAxes[0].get(lane),
+             halfAxes[1].get(lane),
+             halfAxes[2].get(lane)},
+            t);
+      });
+}
+
+/*static*/ void BatchIntersection::intersectRay(
+    const Ray& ray,
+    gsl::span<const BoundingSphere> spheres,
+    gsl::span<std::optional<double>> results) noexcept {
+  VectorLanes<double> centers;
+  alignas(32) std::array<double, LaneCount> radii;
+  intersectInGroups<double>(
+      spheres.size(),
+      results,
+      [&](size_t lane, size_t index) {
+        centers.set(lane, spheres[index].getCenter());
+        radii[lane] = spheres[index].getRadius();
+      },
+      [&](size_t lane, double& t) {
+        return raySphere(
+            ray.getOrigin(),
+            ray.getDirection(),
+            centers.get(lane),
+            radii[lane],
+            t);
+      });
+}
+
+/*static*/ void BatchIntersection::intersectRays(
+    gsl::span<const Ray> rays,
+    const glm::dvec3& p0,
+    const glm::dvec3& p1,
+    const glm::dvec3& p2,
+    gsl::span<std::optional<double>> results,
+    bool cullBackFaces) noexcept {
+  const glm::dvec3 edge0 = p1 - p0;
+  const glm::dvec3 edge1 = p2 - p0;
+
+  RayLanes lanes;
+  intersectInGroups<double>(
+      rays.size(),
+      results,
+      [&](size_t lane, size_t index) { lanes.set(lane, rays[index]); },
+      [&](size_t lane, double& t) {
+        return rayTriangle(
+            lanes.origins.get(lane),
+            lanes.directions.get(lane),
+            p0,
+            edge0,
+            edge1,
+            cullBackFaces,
+            t);
+      });
+}
+
+/*static*/ void BatchIntersection::intersectRays(
+    gsl::span<const Ray> rays,
+    const AxisAlignedBox& box,
+    gsl::span<std::optional<double>> results) noexcept {
+  const glm::dvec3 minimum(box.minimumX, box.minimumY, box.minimumZ);
+  const glm::dvec3 maximum(box.maximumX, box.maximumY, box.maximumZ);
+
+  RayLanes lanes;
+  intersectInGroups<double>(
+      rays.size(),
+      results,
+      [&](size_t lane, size_t index) { lanes.set(lane, rays[index]); },
+      [&](size_t lane, double& t) {
+        return rayAABB(
+            lanes.origins.get(lane),
+            lanes.directions.get(lane),
+            minimum,
+            maximum,
+            t);
+      });
+}
+
+/*static*/ void BatchIntersection::intersectRays(
+    gsl::span<const Ray> rays,
+    const OrientedBoundingBox& box,
+    gsl::span<std::optional<double>> results) noexcept {
+  const glm::dmat3& halfAxes = box.getHalfAxes();
+  const std::array<glm::dvec3, 3> axes{halfAxes[0], halfAxes[1], halfAxes[2]};
+
+  RayLanes lanes;
+  intersectInGroups<double>(
+      rays.size(),
+      results,
+      [&](size_t lane, size_t index) { lanes.set(lane, rays[index]); },
+      [&](size_t lane, double& t) {
+        return rayOBB(
+            lanes.origins.get(lane),
+            lanes.directions.get(lane),
+            box.getCenter(),
+            axes,
+            t);
+      });
+}
+
+/*static*/ void BatchIntersection::intersectRays(
+    gsl::span<const Ray> rays,
+    const BoundingSphere& sphere,
+    gsl::span<std::optional<double>> results) noexcept {
+  RayLanes lanes;
+  intersectInGroups<double>(
+      rays.size(),
+      results,
+      [&](size_t lane, size_t index) { lanes.set(lane, rays[index]); },
+      [&](size_t lane, double& t) {
+        return raySphere(
+            lanes.origins.get(lane),
+            lanes.directions.get(lane),
+            sphere.getCenter(),
+            sphere.getRadius(),
+            t);
+      });
+}
+
+} // namespace CesiumGeometry
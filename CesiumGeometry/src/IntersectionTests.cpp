@@ -1,13 +1,20 @@
 #include "CesiumGeometry/IntersectionTests.h"
 
+#include "CesiumGeometry/AxisAlignedBox.h"
+#include "CesiumGeometry/BoundingSphere.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
 #include "CesiumGeometry/Plane.h"
 #include "CesiumGeometry/Ray.h"
 
 #include <CesiumUtility/Math.h>
 
+#include <glm/exponential.hpp>
 #include <glm/geometric.hpp>
 #include <glm/gtx/norm.hpp>
 
+#include <limits>
+#include <utility>
+
 using namespace CesiumUtility;
 
 namespace CesiumGeometry {
@@ -32,6 +39,154 @@ IntersectionTests::rayPlane(const Ray& ray, const Plane& plane) noexcept {
   return ray.getOrigin() + ray.getDirection() * t;
 }
 
+/*static*/ std::optional<double> IntersectionTests::rayTriangleParametric(
+    const Ray& ray,
+    const glm::dvec3& p0,
+    const glm::dvec3& p1,
+    const glm::dvec3& p2,
+    bool cullBackFaces) noexcept {
+  // The Moller-Trumbore algorithm.
+  const glm::dvec3& origin = ray.getOrigin();
+  const glm::dvec3& direction = ray.getDirection();
+
+  const glm::dvec3 edge0 = p1 - p0;
+  const glm::dvec3 edge1 = p2 - p0;
+
+  const glm::dvec3 p = glm::cross(direction, edge1);
+  const double determinant = glm::dot(edge0, p);
+
+  if (cullBackFaces ? determinant < Math::Epsilon12
+                    : glm::abs(determinant) < Math::Epsilon12) {
+    // The ray is parallel to the triangle, or hits its back.
+    return std::nullopt;
+  }
+
+  const double inverseDeterminant = 1.0 / determinant;
+  const glm::dvec3 toOrigin = origin - p0;
+
+  const double u = glm::dot(toOrigin, p) * inverseDeterminant;
+  if (u < 0.0 || u > 1.0) {
+    return std::nullopt;
+  }
+
+  const glm::dvec3 q = glm::cross(toOrigin, edge0);
+  const double v = glm::dot(direction, q) * inverseDeterminant;
+  if (v < 0.0 || u + v > 1.0) {
+    return std::nullopt;
+  }
+
+  const double t = glm::dot(edge1, q) * inverseDeterminant;
+  if (t < 0.0) {
+    return std::nullopt;
+  }
+
+  return t;
+}
+
+/*static*/ std::optional<double> IntersectionTests::rayOBBParametric(
+    const Ray& ray,
+    const OrientedBoundingBox& obb) noexcept {
+  // The slab test along each axis of the box. The axes are not normalized, so
+  // that a box that is flat along an axis doesn't need any special handling.
+  const glm::dvec3 toOrigin = ray.getOrigin() - obb.getCenter();
+  const glm::dmat3& halfAxes = obb.getHalfAxes();
+
+  double tMin = 0.0;
+  double tMax = std::numeric_limits<double>::max();
+  for (glm::length_t i = 0; i < 3; ++i) {
+    const glm::dvec3& axis = halfAxes[i];
+    const double extent = glm::dot(axis, axis);
+    const double offset = glm::dot(toOrigin, axis);
+    const double speed = glm::dot(ray.getDirection(), axis);
+
+    if (glm::abs(speed) <= Math::Epsilon15 * extent) {
+      // The ray is parallel to this slab.
+      if (glm::abs(offset) > extent) {
+        return std::nullopt;
+      }
+      continue;
+    }
+
+    double t0 = (-extent - offset) / speed;
+    double t1 = (extent - offset) / speed;
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+
+    tMin = glm::max(tMin, t0);
+    tMax = glm::min(tMax, t1);
+    if (tMin > tMax) {
+      return std::nullopt;
+    }
+  }
+
+  return tMin;
+}
+
+/*static*/ std::optional<double> IntersectionTests::rayAABBParametric(
+    const Ray& ray,
+    const AxisAlignedBox& aabb) noexcept {
+  const glm::dvec3& origin = ray.getOrigin();
+  const glm::dvec3& direction = ray.getDirection();
+  const glm::dvec3 minimum(aabb.minimumX, aabb.minimumY, aabb.minimumZ);
+  const glm::dvec3 maximum(aabb.maximumX, aabb.maximumY, aabb.maximumZ);
+
+  double tMin = 0.0;
+  double tMax = std::numeric_limits<double>::max();
+  for (glm::length_t i = 0; i < 3; ++i) {
+    if (glm::abs(direction[i]) <= Math::Epsilon15) {
+      // The ray is parallel to this slab.
+      if (origin[i] < minimum[i] || origin[i] > maximum[i]) {
+        return std::nullopt;
+      }
+      continue;
+    }
+
+    double t0 = (minimum[i] - origin[i]) / direction[i];
+    double t1 = (maximum[i] - origin[i]) / direction[i];
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+
+    tMin = glm::max(tMin, t0);
+    tMax = glm::min(tMax, t1);
+    if (tMin > tMax) {
+      return std::nullopt;
+    }
+  }
+
+  return tMin;
+}
+
+/*static*/ std::optional<double> IntersectionTests::raySphereParametric(
+    const Ray& ray,
+    const BoundingSphere& sphere) noexcept {
+  const glm::dvec3 toCenter = sphere.getCenter() - ray.getOrigin();
+  const double radius = sphere.getRadius();
+
+  // The direction is normalized, so the distances t along the ray to the
+  // surface solve t^2 - 2 * b * t + c = 0.
+  const double b = glm::dot(toCenter, ray.getDirection());
+  const double c = glm::dot(toCenter, toCenter) - radius * radius;
+  if (c <= 0.0) {
+    // The origin is inside the sphere.
+    return 0.0;
+  }
+
+  const double discriminant = b * b - c;
+  if (discriminant < 0.0) {
+    return std::nullopt;
+  }
+
+  const double t = b - glm::sqrt(discriminant);
+  if (t < 0.0) {
+    // The sphere is behind the ray.
+    return std::nullopt;
+  }
+
+  return t;
+}
+
 bool IntersectionTests::pointInTriangle(
     const glm::dvec2& point,
     const glm::dvec2& triangleVertA,
@@ -40,39 +40,53 @@ OctreeAvailability::OctreeAvailability(
       _maximumChildrenSubtrees(1U << (3U * subtreeLevels)),
       _pRoot(nullptr) {}
 
-uint8_t OctreeAvailability::computeAvailability(
-    const OctreeTileID& tileID) const noexcept {
-
-  // The root tile and root tile's subtree are implicitly available.
-  if (!this->_pRoot && tileID.level == 0) {
-    return TileAvailabilityFlags::TILE_AVAILABLE |
-           TileAvailabilityFlags::SUBTREE_AVAILABLE;
+namespace {
+// The loaded subtree that the availability of the last tile of a batch query
+// was found in, which is where the next query can start if its tile is in
+// the same subtree.
+struct SubtreeCursor {
+  const AvailabilityNode* pNode;
+  uint32_t level;
+  uint32_t x;
+  uint32_t y;
+  uint32_t z;
+};
+
+// Computes the tile and content availability of a tile at the given level
+// order index of a loaded subtree.
+uint8_t computeAvailabilityInSubtree(
+    const AvailabilityNode& node,
+    uint32_t availabilityIndex) noexcept {
+  uint8_t availability = 0;
+  if (node.tileAvailabilityBits.isAvailable(availabilityIndex)) {
+    availability |= TileAvailabilityFlags::TILE_AVAILABLE;
   }
-
-  if (!this->_pRoot || tileID.level > this->_maximumLevel) {
-    return 0;
+  if (node.contentAvailabilityBits.isAvailable(availabilityIndex)) {
+    availability |= TileAvailabilityFlags::CONTENT_AVAILABLE;
   }
+  return availability;
+}
 
-  uint32_t level = 0;
-  AvailabilityNode* pNode = this->_pRoot.get();
-
+// Traverses the availability tree from a node whose subtree contains the
+// tile, and stores the deepest loaded subtree that contains it in the cursor.
+uint8_t computeAvailabilityFromNode(
+    const OctreeTileID& tileID,
+    const AvailabilityNode* pNode,
+    uint32_t level,
+    uint32_t subtreeLevels,
+    SubtreeCursor& cursor) noexcept {
   while (pNode && pNode->subtree && tileID.level >= level) {
-    const AvailabilitySubtree& subtree = *pNode->subtree;
-
-    AvailabilityAccessor tileAvailabilityAccessor(
-        subtree.tileAvailability,
-        subtree);
-    AvailabilityAccessor contentAvailabilityAccessor(
-        subtree.contentAvailability,
-        subtree);
-    AvailabilityAccessor subtreeAvailabilityAccessor(
-        subtree.subtreeAvailability,
-        subtree);
-
     uint32_t levelsLeft = tileID.level - level;
     uint32_t subtreeRelativeMask = ~(0xFFFFFFFF << levelsLeft);
 
-    if (levelsLeft < this->_subtreeLevels) {
+    cursor = SubtreeCursor{
+        pNode,
+        level,
+        tileID.x >> levelsLeft,
+        tileID.y >> levelsLeft,
+        tileID.z >> levelsLeft};
+
+    if (levelsLeft < subtreeLevels) {
       // The availability info is within this subtree.
       uint8_t availability = TileAvailabilityFlags::REACHABLE;
 
@@ -87,26 +101,8 @@ uint8_t OctreeAvailability::computeAvailability(
       // (8^levelRelativeToSubtree - 1) / 7
       uint32_t offset = ((1U << (3U * levelsLeft)) - 1U) / 7U;
 
-      uint32_t availabilityIndex = relativeMortonIndex + offset;
-      uint32_t byteIndex = availabilityIndex >> 3;
-      uint8_t bitIndex = static_cast<uint8_t>(availabilityIndex & 7);
-      uint8_t bitMask = static_cast<uint8_t>(1 << bitIndex);
-
-      // Check tile availability.
-      if ((tileAvailabilityAccessor.isConstant() &&
-           tileAvailabilityAccessor.getConstant()) ||
-          (tileAvailabilityAccessor.isBufferView() &&
-           (uint8_t)tileAvailabilityAccessor[byteIndex] & bitMask)) {
-        availability |= TileAvailabilityFlags::TILE_AVAILABLE;
-      }
-
-      // Check content availability.
-      if ((contentAvailabilityAccessor.isConstant() &&
-           contentAvailabilityAccessor.getConstant()) ||
-          (contentAvailabilityAccessor.isBufferView() &&
-           (uint8_t)contentAvailabilityAccessor[byteIndex] & bitMask)) {
-        availability |= TileAvailabilityFlags::CONTENT_AVAILABLE;
-      }
+      availability |=
+          computeAvailabilityInSubtree(*pNode, relativeMortonIndex + offset);
 
       // If this is the 0th level within the subtree, we know this tile's
       // subtree is available and loaded.
@@ -118,53 +114,26 @@ uint8_t OctreeAvailability::computeAvailability(
       return availability;
     }
 
-    uint32_t levelsLeftAfterNextLevel = levelsLeft - this->_subtreeLevels;
+    if (!pNode->subtreeAvailabilityBits.isValid()) {
+      // INVALID AVAILABILITY ACCESSOR
+      return 0;
+    }
+
+    uint32_t levelsLeftAfterNextLevel = levelsLeft - subtreeLevels;
     uint32_t childSubtreeMortonIndex = getMortonIndex(
         (tileID.x & subtreeRelativeMask) >> levelsLeftAfterNextLevel,
         (tileID.y & subtreeRelativeMask) >> levelsLeftAfterNextLevel,
         (tileID.z & subtreeRelativeMask) >> levelsLeftAfterNextLevel);
 
-    // Check if the needed child subtree exists.
-    bool childSubtreeAvailable = false;
-    uint32_t childSubtreeIndex = 0;
-
-    if (subtreeAvailabilityAccessor.isConstant()) {
-      childSubtreeAvailable = subtreeAvailabilityAccessor.getConstant();
-      childSubtreeIndex = childSubtreeMortonIndex;
-
-    } else if (subtreeAvailabilityAccessor.isBufferView()) {
-      uint32_t byteIndex = childSubtreeMortonIndex >> 3;
-      uint8_t bitIndex = static_cast<uint8_t>(childSubtreeMortonIndex & 7);
-      uint8_t bitMask = static_cast<uint8_t>(1 << bitIndex);
-
-      gsl::span<const std::byte> clippedSubtreeAvailability =
-          subtreeAvailabilityAccessor.getBufferAccessor().subspan(0, byteIndex);
-      uint8_t availabilityByte =
-          (uint8_t)subtreeAvailabilityAccessor[byteIndex];
-
-      childSubtreeAvailable = availabilityByte & bitMask;
-      // Calculte the index the child subtree is stored in.
-      if (childSubtreeAvailable) {
-        childSubtreeIndex =
-            // TODO: maybe partial sums should be precomputed in the subtree
-            // availability, instead of iterating through the buffer each time.
-            AvailabilityUtilities::countOnesInBuffer(
-                clippedSubtreeAvailability) +
-            AvailabilityUtilities::countOnesInByte(
-                static_cast<uint8_t>(availabilityByte << (8 - bitIndex)));
-      }
-    } else {
-      // INVALID AVAILABILITY ACCESSOR
-      return 0;
-    }
-
-    if (childSubtreeAvailable) {
-      pNode = pNode->childNodes[childSubtreeIndex].get();
-      level += this->_subtreeLevels;
-    } else {
+    std::optional<uint32_t> childSubtreeIndex =
+        pNode->findChildSubtreeIndex(childSubtreeMortonIndex);
+    if (!childSubtreeIndex) {
       // The child subtree containing the tile id is not available.
       return TileAvailabilityFlags::REACHABLE;
     }
+
+    pNode = pNode->childNodes[*childSubtreeIndex].get();
+    level += subtreeLevels;
   }
 
   // This is the only case where execution should reach here. It means that a
@@ -182,6 +151,63 @@ uint8_t OctreeAvailability::computeAvailability(
 
   return 0;
 }
+} // namespace
+
+uint8_t OctreeAvailability::computeAvailability(
+    const OctreeTileID& tileID) const noexcept {
+
+  // The root tile and root tile's subtree are implicitly available.
+  if (!this->_pRoot && tileID.level == 0) {
+    return TileAvailabilityFlags::TILE_AVAILABLE |
+           TileAvailabilityFlags::SUBTREE_AVAILABLE;
+  }
+
+  if (!this->_pRoot || tileID.level > this->_maximumLevel) {
+    return 0;
+  }
+
+  SubtreeCursor cursor{this->_pRoot.get(), 0, 0, 0};
+  return computeAvailabilityFromNode(
+      tileID,
+      this->_pRoot.get(),
+      0,
+      this->_subtreeLevels,
+      cursor);
+}
+
+void OctreeAvailability::computeAvailability(
+    const gsl::span<const OctreeTileID>& tileIDs,
+    const gsl::span<uint8_t>& availability) const noexcept {
+  assert(availability.size() >= tileIDs.size());
+
+  SubtreeCursor cursor{this->_pRoot.get(), 0, 0, 0};
+  for (size_t i = 0; i < tileIDs.size(); ++i) {
+    const OctreeTileID& tileID = tileIDs[i];
+    if (!this->_pRoot || tileID.level > this->_maximumLevel) {
+      availability[i] = this->computeAvailability(tileID);
+      continue;
+    }
+
+    // Start from the subtree of the previous tile if it contains this one,
+    // as it often does when tiles are queried in order.
+    const uint32_t levelsBelowCursor = tileID.level - cursor.level;
+    const bool inCursor =
+        tileID.level >= cursor.level &&
+        (tileID.x >> levelsBelowCursor) == cursor.x &&
+        (tileID.y >> levelsBelowCursor) == cursor.y &&
+        (tileID.z >> levelsBelowCursor) == cursor.z;
+    if (!inCursor) {
+      cursor = SubtreeCursor{this->_pRoot.get(), 0, 0, 0, 0};
+    }
+
+    availability[i] = computeAvailabilityFromNode(
+        tileID,
+        cursor.pNode,
+        cursor.level,
+        this->_subtreeLevels,
+        cursor);
+  }
+}
 
 bool OctreeAvailability::addSubtree(
     const OctreeTileID& tileID,
@@ -209,12 +235,6 @@ bool OctreeAvailability::addSubtree(
   uint32_t level = 0;
 
   while (pNode && pNode->subtree && tileID.level > level) {
-    AvailabilitySubtree& subtree = *pNode->subtree;
-
-    AvailabilityAccessor subtreeAvailabilityAccessor(
-        subtree.subtreeAvailability,
-        subtree);
-
     uint32_t levelsLeft = tileID.level - level;
 
     // The given subtree to add must fall exactly at the end of an existing
@@ -223,8 +243,6 @@ bool OctreeAvailability::addSubtree(
       return false;
     }
 
-    // TODO: consolidate duplicated code here...
-
     uint32_t subtreeRelativeMask = ~(0xFFFFFFFF << levelsLeft);
     uint32_t levelsLeftAfterChildren = levelsLeft - this->_subtreeLevels;
     uint32_t childSubtreeMortonIndex = getMortonIndex(
@@ -232,66 +250,36 @@ bool OctreeAvailability::addSubtree(
         (tileID.y & subtreeRelativeMask) >> levelsLeftAfterChildren,
         (tileID.z & subtreeRelativeMask) >> levelsLeftAfterChildren);
 
-    // Check if the needed child subtree exists.
-    bool childSubtreeAvailable = false;
-    uint32_t childSubtreeIndex = 0;
-
-    if (subtreeAvailabilityAccessor.isConstant()) {
-      childSubtreeAvailable = subtreeAvailabilityAccessor.getConstant();
-      childSubtreeIndex = childSubtreeMortonIndex;
-    } else if (subtreeAvailabilityAccessor.isBufferView()) {
-      uint32_t byteIndex = childSubtreeMortonIndex >> 3;
-      uint8_t bitIndex = static_cast<uint8_t>(childSubtreeMortonIndex & 7);
-      uint8_t bitMask = static_cast<uint8_t>(1 << bitIndex);
-
-      gsl::span<const std::byte> clippedSubtreeAvailability =
-          subtreeAvailabilityAccessor.getBufferAccessor().subspan(0, byteIndex);
-      uint8_t availabilityByte =
-          (uint8_t)subtreeAvailabilityAccessor[byteIndex];
-
-      childSubtreeAvailable = availabilityByte & bitMask;
-      // Calculte the index the child subtree is stored in.
-      if (childSubtreeAvailable) {
-        childSubtreeIndex =
-            // TODO: maybe partial sums should be precomputed in the subtree
-            // availability, instead of iterating through the buffer each time.
-            AvailabilityUtilities::countOnesInBuffer(
-                clippedSubtreeAvailability) +
-            AvailabilityUtilities::countOnesInByte(
-                static_cast<uint8_t>(availabilityByte << (8 - bitIndex)));
-      }
-    } else {
-      // INVALID AVAILABILITY ACCESSOR
+    std::optional<uint32_t> childSubtreeIndex =
+        pNode->findChildSubtreeIndex(childSubtreeMortonIndex);
+    if (!childSubtreeIndex) {
+      // This child subtree is marked as non-available.
+      // TODO: warn of invalid availability
       return false;
     }
 
-    if (childSubtreeAvailable) {
-      if (levelsLeftAfterChildren == 0) {
-        // This is the child that the new subtree corresponds to.
-
-        if (pNode->childNodes[childSubtreeIndex]) {
-          // This subtree was already added.
-          // TODO: warn of error
-          return false;
-        }
-
-        pNode->childNodes[childSubtreeIndex] =
-            std::make_unique<AvailabilityNode>();
-        pNode->childNodes[childSubtreeIndex]->setLoadedSubtree(
-            std::move(newSubtree),
-            this->_maximumChildrenSubtrees);
-        return true;
-      } else {
-        // We need to traverse this child subtree to find where to add the new
-        // subtree.
-        pNode = pNode->childNodes[childSubtreeIndex].get();
-        level += this->_subtreeLevels;
+    std::unique_ptr<AvailabilityNode>& pChildNode =
+        pNode->childNodes[*childSubtreeIndex];
+    if (levelsLeftAfterChildren == 0) {
+      // This is the child that the new subtree corresponds to.
+
+      if (pChildNode) {
+        // This subtree was already added.
+        // TODO: warn of error
+        return false;
       }
-    } else {
-      // This child subtree is marked as non-available.
-      // TODO: warn of invalid availability
-      return false;
+
+      pChildNode = std::make_unique<AvailabilityNode>();
+      pChildNode->setLoadedSubtree(
+          std::move(newSubtree),
+          this->_maximumChildrenSubtrees);
+      return true;
     }
+
+    // We need to traverse this child subtree to find where to add the new
+    // subtree.
+    pNode = pChildNode.get();
+    level += this->_subtreeLevels;
   }
 
   return false;
@@ -314,16 +302,6 @@ uint8_t OctreeAvailability::computeAvailability(
     return 0;
   }
 
-  AvailabilityAccessor tileAvailabilityAccessor(
-      pNode->subtree->tileAvailability,
-      *pNode->subtree);
-  AvailabilityAccessor contentAvailabilityAccessor(
-      pNode->subtree->contentAvailability,
-      *pNode->subtree);
-  AvailabilityAccessor subtreeAvailability(
-      pNode->subtree->subtreeAvailability,
-      *pNode->subtree);
-
   uint32_t subtreeRelativeMask = ~(0xFFFFFFFF << relativeLevel);
 
   // Assume the availability info is within this subtree.
@@ -341,26 +319,8 @@ uint8_t OctreeAvailability::computeAvailability(
   // (8^levelRelativeToSubtree - 1) / 7
   uint32_t offset = ((1U << (3U * relativeLevel)) - 1U) / 7U;
 
-  uint32_t availabilityIndex = relativeMortonIndex + offset;
-  uint32_t byteIndex = availabilityIndex >> 3;
-  uint8_t bitIndex = static_cast<uint8_t>(availabilityIndex & 7);
-  uint8_t bitMask = static_cast<uint8_t>(1 << bitIndex);
-
-  // Check tile availability.
-  if ((tileAvailabilityAccessor.isConstant() &&
-       tileAvailabilityAccessor.getConstant()) ||
-      (tileAvailabilityAccessor.isBufferView() &&
-       (uint8_t)tileAvailabilityAccessor[byteIndex] & bitMask)) {
-    availability |= TileAvailabilityFlags::TILE_AVAILABLE;
-  }
-
-  // Check content availability.
-  if ((contentAvailabilityAccessor.isConstant() &&
-       contentAvailabilityAccessor.getConstant()) ||
-      (contentAvailabilityAccessor.isBufferView() &&
-       (uint8_t)contentAvailabilityAccessor[byteIndex] & bitMask)) {
-    availability |= TileAvailabilityFlags::CONTENT_AVAILABLE;
-  }
+  availability |=
+      computeAvailabilityInSubtree(*pNode, relativeMortonIndex + offset);
 
   // If this is the 0th level within the subtree, we know this tile's
   // subtree is available and loaded.
@@ -406,47 +366,15 @@ AvailabilityNode* OctreeAvailability::addNode(
       tileID.y & subtreeRelativeMask,
       tileID.z & subtreeRelativeMask);
 
-  AvailabilityAccessor subtreeAvailabilityAccessor(
-      pParentNode->subtree->subtreeAvailability,
-      *pParentNode->subtree);
-
-  bool subtreeAvailable = false;
-  uint32_t subtreeIndex = 0;
-  if (subtreeAvailabilityAccessor.isConstant()) {
-    subtreeAvailable = subtreeAvailabilityAccessor.getConstant();
-    subtreeIndex = mortonIndex;
-  } else if (subtreeAvailabilityAccessor.isBufferView()) {
-    uint32_t byteIndex = mortonIndex >> 3;
-    uint8_t bitIndex = static_cast<uint8_t>(mortonIndex & 7);
-    uint8_t bitMask = static_cast<uint8_t>(1 << bitIndex);
-
-    gsl::span<const std::byte> clippedSubtreeAvailability =
-        subtreeAvailabilityAccessor.getBufferAccessor().subspan(0, byteIndex);
-    uint8_t availabilityByte = (uint8_t)subtreeAvailabilityAccessor[byteIndex];
-
-    subtreeAvailable = availabilityByte & bitMask;
-
-    // Calculte the index the child subtree is stored in.
-    if (subtreeAvailable) {
-      subtreeIndex =
-          // TODO: maybe partial sums should be precomputed in the subtree
-          // availability, instead of iterating through the buffer each time.
-          AvailabilityUtilities::countOnesInBuffer(clippedSubtreeAvailability) +
-          AvailabilityUtilities::countOnesInByte(
-              static_cast<uint8_t>(availabilityByte << (8 - bitIndex)));
-    } else {
-      // This subtree is not supposed to be available.
-      return nullptr;
-    }
-  }
-
-  if (subtreeAvailable) {
-    pParentNode->childNodes[subtreeIndex] =
-        std::make_unique<AvailabilityNode>();
-    return pParentNode->childNodes[subtreeIndex].get();
+  std::optional<uint32_t> subtreeIndex =
+      pParentNode->findChildSubtreeIndex(mortonIndex);
+  if (!subtreeIndex) {
+    // This subtree is not supposed to be available.
+    return nullptr;
   }
 
-  return nullptr;
+  pParentNode->childNodes[*subtreeIndex] = std::make_unique<AvailabilityNode>();
+  return pParentNode->childNodes[*subtreeIndex].get();
 }
 
 bool OctreeAvailability::addLoadedSubtree(
@@ -477,42 +405,7 @@ std::optional<uint32_t> OctreeAvailability::findChildNodeIndex(
       tileID.y & subtreeRelativeMask,
       tileID.z & subtreeRelativeMask);
 
-  AvailabilityAccessor subtreeAvailabilityAccessor(
-      pParentNode->subtree->subtreeAvailability,
-      *pParentNode->subtree);
-
-  bool subtreeAvailable = false;
-  uint32_t subtreeIndex = 0;
-  if (subtreeAvailabilityAccessor.isConstant()) {
-    subtreeAvailable = subtreeAvailabilityAccessor.getConstant();
-    subtreeIndex = mortonIndex;
-  } else if (subtreeAvailabilityAccessor.isBufferView()) {
-    uint32_t byteIndex = mortonIndex >> 3;
-    uint8_t bitIndex = static_cast<uint8_t>(mortonIndex & 7);
-    uint8_t bitMask = static_cast<uint8_t>(1 << bitIndex);
-
-    gsl::span<const std::byte> clippedSubtreeAvailability =
-        subtreeAvailabilityAccessor.getBufferAccessor().subspan(0, byteIndex);
-    uint8_t availabilityByte = (uint8_t)subtreeAvailabilityAccessor[byteIndex];
-
-    subtreeAvailable = availabilityByte & bitMask;
-
-    // Calculte the index the child subtree is stored in.
-    if (subtreeAvailable) {
-      subtreeIndex =
-          // TODO: maybe partial sums should be precomputed in the subtree
-          // availability, instead of iterating through the buffer each time.
-          AvailabilityUtilities::countOnesInBuffer(clippedSubtreeAvailability) +
-          AvailabilityUtilities::countOnesInByte(
-              static_cast<uint8_t>(availabilityByte << (8 - bitIndex)));
-    }
-  }
-
-  if (subtreeAvailable) {
-    return subtreeIndex;
-  }
-
-  return std::nullopt;
+  return pParentNode->findChildSubtreeIndex(mortonIndex);
 }
 
 AvailabilityNode* OctreeAvailability::findChildNode(
@@ -528,4 +421,5 @@ AvailabilityNode* OctreeAvailability::findChildNode(
 
   return pParentNode->childNodes[*childIndex].get();
 }
+
 } // namespace CesiumGeometry
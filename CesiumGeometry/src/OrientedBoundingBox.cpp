@@ -57,9 +57,10 @@ double OrientedBoundingBox::computeDistanceSquaredToPosition(
   glm::dvec3 v = halfAxes[1];
   glm::dvec3 w = halfAxes[2];
 
-  const double uHalf = glm::length(u);
-  const double vHalf = glm::length(v);
-  const double wHalf = glm::length(w);
+  // The lengths of the axes are computed once, when the box is constructed.
+  const double uHalf = 0.5 * this->_lengths.x;
+  const double vHalf = 0.5 * this->_lengths.y;
+  const double wHalf = 0.5 * this->_lengths.z;
 
   u /= uHalf;
   v /= vHalf;
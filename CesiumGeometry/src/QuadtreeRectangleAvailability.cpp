@@ -2,59 +2,66 @@
 
 #include "CesiumGeometry/TileAvailabilityFlags.h"
 
-#include <glm/common.hpp>
-
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 
 namespace CesiumGeometry {
 
 QuadtreeRectangleAvailability::QuadtreeRectangleAvailability(
     const QuadtreeTilingScheme& tilingScheme,
     uint32_t maximumLevel) noexcept
-    : _tilingScheme(tilingScheme),
-      _maximumLevel(maximumLevel),
-      _rootNodes(
-          this->_tilingScheme.getRootTilesX() *
-          this->_tilingScheme.getRootTilesY()) {
-  for (uint32_t j = 0; j < this->_tilingScheme.getRootTilesY(); ++j) {
-    const uint32_t rowStart = j * this->_tilingScheme.getRootTilesX();
-    for (uint32_t i = 0; i < this->_tilingScheme.getRootTilesX(); ++i) {
-      QuadtreeTileID id(0, i, j);
-      Rectangle extent = tilingScheme.tileToRectangle(id);
-      this->_rootNodes[rowStart + i] =
-          std::make_unique<QuadtreeNode>(id, extent, nullptr);
-    }
-  }
-}
+    : _tilingScheme(tilingScheme), _levels(size_t(maximumLevel) + 1) {}
 
 void QuadtreeRectangleAvailability::addAvailableTileRange(
     const QuadtreeTileRectangularRange& range) noexcept {
-  const Rectangle ll = this->_tilingScheme.tileToRectangle(
-      QuadtreeTileID(range.level, range.minimumX, range.minimumY));
-  const Rectangle ur = this->_tilingScheme.tileToRectangle(
-      QuadtreeTileID(range.level, range.maximumX, range.maximumY));
-
-  RectangleWithLevel rectangleWithLevel{
-      range.level,
-      Rectangle(ll.minimumX, ll.minimumY, ur.maximumX, ur.maximumY)};
-
-  for (const std::unique_ptr<QuadtreeNode>& pNode : this->_rootNodes) {
-    if (pNode->extent.overlaps(rectangleWithLevel.rectangle)) {
-      putRectangleInQuadtree(
-          this->_tilingScheme,
-          this->_maximumLevel,
-          *pNode,
-          rectangleWithLevel);
-    }
+  if (range.minimumX > range.maximumX || range.minimumY > range.maximumY) {
+    return;
+  }
+
+  if (range.level >= this->_levels.size()) {
+    this->_levels.resize(size_t(range.level) + 1);
   }
+
+  LevelIndex& index = this->_levels[range.level];
+  index.ranges.push_back(range);
+  index.isDirty = true;
 }
 
 uint32_t QuadtreeRectangleAvailability::computeMaximumLevelAtPosition(
     const glm::dvec2& position) const noexcept {
-  // Find the root node that contains this position.
-  for (const std::unique_ptr<QuadtreeNode>& pNode : this->_rootNodes) {
-    if (pNode->extent.contains(position)) {
-      return findMaxLevelFromNode(nullptr, *pNode, position);
+  const Rectangle& rectangle = this->_tilingScheme.getRectangle();
+  if (!rectangle.contains(position)) {
+    return 0;
+  }
+
+  const double u =
+      (position.x - rectangle.minimumX) / rectangle.computeWidth();
+  const double v =
+      (position.y - rectangle.minimumY) / rectangle.computeHeight();
+
+  for (size_t i = this->_levels.size(); i > 0; --i) {
+    const uint32_t level = uint32_t(i - 1);
+    const LevelIndex* pIndex = this->getLevelIndex(level);
+    if (!pIndex) {
+      continue;
+    }
+
+    // A position on the edge between tiles is in all of them.
+    const double column =
+        u * double(uint64_t(this->_tilingScheme.getRootTilesX()) << level);
+    const double row =
+        v * double(uint64_t(this->_tilingScheme.getRootTilesY()) << level);
+    const uint64_t lastColumn = uint64_t(std::floor(column));
+    const uint64_t lastRow = uint64_t(std::floor(row));
+    const uint64_t firstColumn =
+        lastColumn > 0 && double(lastColumn) == column ? lastColumn - 1
+                                                       : lastColumn;
+    const uint64_t firstRow =
+        lastRow > 0 && double(lastRow) == row ? lastRow - 1 : lastRow;
+
+    if (pIndex->containsAny(firstColumn, lastColumn, firstRow, lastRow)) {
+      return level;
     }
   }
 
@@ -63,176 +70,225 @@ uint32_t QuadtreeRectangleAvailability::computeMaximumLevelAtPosition(
 
 uint8_t QuadtreeRectangleAvailability::isTileAvailable(
     const QuadtreeTileID& id) const noexcept {
-  // Get the center of the tile and find the maximum level at that position.
-  // Because availability is by tile, if the level is available at that point,
-  // it is sure to be available for the whole tile.  We assume that if a tile at
-  // level n exists, then all its parent tiles back to level 0 exist too.  This
-  // isn't really enforced anywhere, but Cesium would never load a tile for
-  // which this is not true.
-  const CesiumGeometry::Rectangle rectangle =
-      this->_tilingScheme.tileToRectangle(id);
-  const glm::dvec2 center = rectangle.getCenter();
-  if (this->computeMaximumLevelAtPosition(center) >= id.level) {
-    return TileAvailabilityFlags::TILE_AVAILABLE |
-           TileAvailabilityFlags::REACHABLE;
+  // Find whether any level at or below this tile has a range that contains
+  // the center of the tile. Because availability is by tile, if the level is
+  // available at that point, it is sure to be available for the whole tile.
+  // We assume that if a tile at level n exists, then all its parent tiles
+  // back to level 0 exist too.  This isn't really enforced anywhere, but
+  // Cesium would never load a tile for which this is not true.
+  for (uint32_t level = id.level; level < this->_levels.size(); ++level) {
+    const LevelIndex* pIndex = this->getLevelIndex(level);
+    if (pIndex && isTileCenterAvailableAtLevel(*pIndex, id, level)) {
+      return TileAvailabilityFlags::TILE_AVAILABLE |
+             TileAvailabilityFlags::REACHABLE;
+    }
   }
 
   return 0;
 }
 
-/*static*/ void QuadtreeRectangleAvailability::putRectangleInQuadtree(
-    const QuadtreeTilingScheme& tilingScheme,
-    uint32_t maximumLevel,
-    QuadtreeRectangleAvailability::QuadtreeNode& node,
-    const QuadtreeRectangleAvailability::RectangleWithLevel&
-        rectangle) noexcept {
-  QuadtreeNode* pNode = &node;
-
-  while (pNode->id.level < maximumLevel) {
-    createNodeChildrenIfNecessary(*pNode, tilingScheme);
-    if (pNode->ll && pNode->ll->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->ll.get();
-    } else if (
-        pNode->lr && pNode->lr->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->lr.get();
-    } else if (
-        pNode->ul && pNode->ul->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->ul.get();
-    } else if (
-        pNode->ur && pNode->ur->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->ur.get();
-    } else {
+uint8_t QuadtreeRectangleAvailability::computeAvailableChildren(
+    const QuadtreeTileID& id) const noexcept {
+  const uint32_t childLevel = id.level + 1;
+  uint8_t result = 0;
+
+  for (uint32_t level = childLevel; level < this->_levels.size(); ++level) {
+    const LevelIndex* pIndex = this->getLevelIndex(level);
+    if (!pIndex) {
+      continue;
+    }
+
+    for (uint32_t i = 0; i < 4; ++i) {
+      const uint8_t bit = uint8_t(1U << i);
+      if (result & bit) {
+        continue;
+      }
+
+      const QuadtreeTileID childID(
+          childLevel,
+          id.x * 2 + (i & 1),
+          id.y * 2 + (i >> 1));
+      if (isTileCenterAvailableAtLevel(*pIndex, childID, level)) {
+        result |= bit;
+      }
+    }
+
+    if (result == 0xF) {
       break;
     }
   }
 
-  if (pNode->rectangles.empty() ||
-      pNode->rectangles.back().level <= rectangle.level) {
-    pNode->rectangles.push_back(rectangle);
-  } else {
-    // Maintain ordering by level when inserting.
-    std::push_heap(
-        pNode->rectangles.begin(),
-        pNode->rectangles.end(),
-        QuadtreeRectangleAvailability::rectangleLevelComparator);
+  return result;
+}
+
+const QuadtreeRectangleAvailability::LevelIndex*
+QuadtreeRectangleAvailability::getLevelIndex(uint32_t level) const noexcept {
+  if (level >= this->_levels.size()) {
+    return nullptr;
+  }
+
+  LevelIndex& index = this->_levels[level];
+  if (index.ranges.empty()) {
+    return nullptr;
+  }
+
+  if (index.isDirty) {
+    index.build();
   }
+
+  return &index;
 }
 
-/*static*/ bool QuadtreeRectangleAvailability::rectangleLevelComparator(
-    const QuadtreeRectangleAvailability::RectangleWithLevel& a,
-    const QuadtreeRectangleAvailability::RectangleWithLevel& b) noexcept {
-  return a.level < b.level;
+/*static*/ bool QuadtreeRectangleAvailability::isTileCenterAvailableAtLevel(
+    const LevelIndex& index,
+    const QuadtreeTileID& id,
+    uint32_t level) noexcept {
+  const uint32_t levelsBelow = level - id.level;
+  if (levelsBelow == 0) {
+    return index.contains(id.x, id.y);
+  }
+
+  // The center of the tile is the corner shared by four tiles at the deeper
+  // level, and it's in all of them.
+  const uint64_t column = (uint64_t(id.x) * 2 + 1) << (levelsBelow - 1);
+  const uint64_t row = (uint64_t(id.y) * 2 + 1) << (levelsBelow - 1);
+  return index.containsAny(column - 1, column, row - 1, row);
 }
 
-/*static*/ uint32_t QuadtreeRectangleAvailability::findMaxLevelFromNode(
-    QuadtreeRectangleAvailability::QuadtreeNode* pStopNode,
-    QuadtreeRectangleAvailability::QuadtreeNode& node,
-    const glm::dvec2& position) noexcept {
-  uint32_t maxLevel = 0;
-  QuadtreeRectangleAvailability::QuadtreeNode* pNode = &node;
-
-  // Find the deepest quadtree node containing this point.
-  bool found = false;
-  while (!found) {
-    const uint32_t ll =
-        pNode->ll && pNode->ll->extent.contains(position) ? 1 : 0;
-    const uint32_t lr =
-        pNode->lr && pNode->lr->extent.contains(position) ? 1 : 0;
-    const uint32_t ul =
-        pNode->ul && pNode->ul->extent.contains(position) ? 1 : 0;
-    const uint32_t ur =
-        pNode->ur && pNode->ur->extent.contains(position) ? 1 : 0;
-
-    // The common scenario is that the point is in only one quadrant and we can
-    // simply iterate down the tree.  But if the point is on a boundary between
-    // tiles, it is in multiple tiles and we need to check all of them, so use
-    // recursion.
-    if (ll + lr + ul + ur > 1) {
-      if (ll) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->ll, position));
-      }
-      if (lr) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->lr, position));
-      }
-      if (ul) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->ul, position));
-      }
-      if (ur) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->ur, position));
-      }
-      break;
-    }
-    if (ll) {
-      pNode = pNode->ll.get();
-    } else if (lr) {
-      pNode = pNode->lr.get();
-    } else if (ul) {
-      pNode = pNode->ul.get();
-    } else if (ur) {
-      pNode = pNode->ur.get();
-    } else {
-      found = true;
-    }
+void QuadtreeRectangleAvailability::LevelIndex::build() noexcept {
+  this->columnBounds.clear();
+  this->columnBounds.reserve(this->ranges.size() * 2);
+  for (const QuadtreeTileRectangularRange& range : this->ranges) {
+    this->columnBounds.push_back(range.minimumX);
+    this->columnBounds.push_back(uint64_t(range.maximumX) + 1);
   }
+  std::sort(this->columnBounds.begin(), this->columnBounds.end());
+  this->columnBounds.erase(
+      std::unique(this->columnBounds.begin(), this->columnBounds.end()),
+      this->columnBounds.end());
 
-  // Wal up the tree until we find a rectangle that contains this point.
-  while (pNode != pStopNode) {
-    const std::vector<RectangleWithLevel>& rectangles = pNode->rectangles;
+  const size_t leaves = this->columnBounds.size() - 1;
+  this->nodes.clear();
+  this->nodes.resize(leaves * 4);
+  for (const QuadtreeTileRectangularRange& range : this->ranges) {
+    this->insert(
+        1,
+        0,
+        leaves,
+        range.minimumX,
+        uint64_t(range.maximumX) + 1,
+        RowInterval{range.minimumY, uint64_t(range.maximumY) + 1});
+  }
 
-    // Rectangles are sorted by level, lowest first.
-    for (int32_t i = static_cast<int32_t>(rectangles.size()) - 1;
-         i >= 0 && rectangles[static_cast<size_t>(i)].level > maxLevel;
-         --i) {
-      const RectangleWithLevel& rectangle = rectangles[static_cast<size_t>(i)];
-      if (rectangle.rectangle.contains(position)) {
-        maxLevel = rectangle.level;
-      }
+  for (std::vector<RowInterval>& rows : this->nodes) {
+    if (rows.size() < 2) {
+      continue;
     }
 
-    pNode = pNode->pParent;
+    std::sort(
+        rows.begin(),
+        rows.end(),
+        [](const RowInterval& a, const RowInterval& b) {
+          return a.begin < b.begin;
+        });
+
+    size_t last = 0;
+    for (size_t i = 1; i < rows.size(); ++i) {
+      if (rows[i].begin <= rows[last].end) {
+        rows[last].end = std::max(rows[last].end, rows[i].end);
+      } else {
+        rows[++last] = rows[i];
+      }
+    }
+    rows.resize(last + 1);
+    rows.shrink_to_fit();
   }
 
-  return maxLevel;
+  this->isDirty = false;
 }
 
-/*static*/ void QuadtreeRectangleAvailability::createNodeChildrenIfNecessary(
-    QuadtreeRectangleAvailability::QuadtreeNode& node,
-    const QuadtreeTilingScheme& tilingScheme) noexcept {
-  if (node.ll) {
+void QuadtreeRectangleAvailability::LevelIndex::insert(
+    size_t node,
+    size_t first,
+    size_t last,
+    uint64_t beginColumn,
+    uint64_t endColumn,
+    const RowInterval& rows) noexcept {
+  if (beginColumn <= this->columnBounds[first] &&
+      this->columnBounds[last] <= endColumn) {
+    this->nodes[node].push_back(rows);
     return;
   }
 
-  QuadtreeTileID llID(node.id.level + 1, node.id.x * 2, node.id.y * 2);
-  node.ll = std::make_unique<QuadtreeNode>(
-      llID,
-      tilingScheme.tileToRectangle(llID),
-      &node);
-
-  QuadtreeTileID lrID(llID.level, llID.x + 1, llID.y);
-  node.lr = std::make_unique<QuadtreeNode>(
-      lrID,
-      tilingScheme.tileToRectangle(lrID),
-      &node);
-
-  QuadtreeTileID ulID(llID.level, llID.x, llID.y + 1);
-  node.ul = std::make_unique<QuadtreeNode>(
-      ulID,
-      tilingScheme.tileToRectangle(ulID),
-      &node);
-
-  QuadtreeTileID urID(llID.level, llID.x + 1, llID.y + 1);
-  node.ur = std::make_unique<QuadtreeNode>(
-      urID,
-      tilingScheme.tileToRectangle(urID),
-      &node);
+  const size_t middle = (first + last) / 2;
+  if (beginColumn < this->columnBounds[middle]) {
+    this->insert(node * 2, first, middle, beginColumn, endColumn, rows);
+  }
+  if (endColumn > this->columnBounds[middle]) {
+    this->insert(node * 2 + 1, middle, last, beginColumn, endColumn, rows);
+  }
+}
+
+bool QuadtreeRectangleAvailability::LevelIndex::contains(
+    uint64_t column,
+    uint64_t row) const noexcept {
+  if (this->columnBounds.size() < 2 || column < this->columnBounds.front() ||
+      column >= this->columnBounds.back()) {
+    return false;
+  }
+
+  const size_t leaf = size_t(
+      std::upper_bound(
+          this->columnBounds.begin(),
+          this->columnBounds.end(),
+          column) -
+      this->columnBounds.begin() - 1);
+
+  // Every node on the path from the root to the leaf spans the column.
+  size_t node = 1;
+  size_t first = 0;
+  size_t last = this->columnBounds.size() - 1;
+  while (true) {
+    const std::vector<RowInterval>& rows = this->nodes[node];
+    auto it = std::upper_bound(
+        rows.begin(),
+        rows.end(),
+        row,
+        [](uint64_t value, const RowInterval& interval) {
+          return value < interval.begin;
+        });
+    if (it != rows.begin() && std::prev(it)->end > row) {
+      return true;
+    }
+
+    if (last - first == 1) {
+      return false;
+    }
+
+    const size_t middle = (first + last) / 2;
+    if (leaf < middle) {
+      node = node * 2;
+      last = middle;
+    } else {
+      node = node * 2 + 1;
+      first = middle;
+    }
+  }
+}
+
+bool QuadtreeRectangleAvailability::LevelIndex::containsAny(
+    uint64_t firstColumn,
+    uint64_t lastColumn,
+    uint64_t firstRow,
+    uint64_t lastRow) const noexcept {
+  for (uint64_t column = firstColumn; column <= lastColumn; ++column) {
+    for (uint64_t row = firstRow; row <= lastRow; ++row) {
+      if (this->contains(column, row)) {
+        return true;
+      }
+    }
+  }
+  return false;
 }
 
 } // namespace CesiumGeometry
@@ -41,6 +41,67 @@ TEST_CASE("Test AvailabilityUtilities") {
   }
 }
 
+TEST_CASE("Test AvailabilityBitstream") {
+  // Enough bytes to span several 64-bit words, with a different number of
+  // ones in each byte.
+  std::vector<std::byte> buffer(29);
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    buffer[i] = static_cast<std::byte>((i * 37) & 0xFF);
+  }
+
+  AvailabilitySubtree subtree{
+      SubtreeBufferView{3, 26, 0},
+      ConstantAvailability{true},
+      ConstantAvailability{false},
+      {buffer}};
+
+  SECTION("Test a buffer view") {
+    AvailabilityBitstream bits(subtree.tileAvailability, subtree);
+    REQUIRE(bits.isValid());
+
+    const gsl::span<const std::byte> view(buffer.data() + 3, 26);
+    for (uint32_t i = 0; i < 26U * 8U; ++i) {
+      const uint8_t byte = static_cast<uint8_t>(view[i / 8]);
+      CHECK(bits.isAvailable(i) == bool((byte >> (i % 8)) & 1));
+
+      const uint32_t expectedCount =
+          AvailabilityUtilities::countOnesInBuffer(view.subspan(0, i / 8)) +
+          AvailabilityUtilities::countOnesInByte(
+              static_cast<uint8_t>(byte << (8 - i % 8)));
+      CHECK(bits.countAvailableBefore(i) == expectedCount);
+    }
+
+    // Past the end, nothing is available.
+    CHECK(!bits.isAvailable(26U * 8U * 2U));
+    CHECK(
+        bits.countAvailableBefore(26U * 8U * 2U) ==
+        AvailabilityUtilities::countOnesInBuffer(view));
+  }
+
+  SECTION("Test constant views") {
+    AvailabilityBitstream allBits(subtree.contentAvailability, subtree);
+    REQUIRE(allBits.isValid());
+    CHECK(allBits.isAvailable(1000));
+    CHECK(allBits.countAvailableBefore(1000) == 1000);
+
+    AvailabilityBitstream noBits(subtree.subtreeAvailability, subtree);
+    REQUIRE(noBits.isValid());
+    CHECK(!noBits.isAvailable(0));
+    CHECK(noBits.countAvailableBefore(1000) == 0);
+  }
+
+  SECTION("Test an invalid buffer view") {
+    AvailabilitySubtree invalidSubtree{
+        SubtreeBufferView{0, 8, 1},
+        ConstantAvailability{true},
+        ConstantAvailability{true},
+        {buffer}};
+    AvailabilityBitstream bits(invalidSubtree.tileAvailability, invalidSubtree);
+    CHECK(!bits.isValid());
+    CHECK(!bits.isAvailable(0));
+  }
+}
+
 TEST_CASE("Test AvailabilityAccessor") {
   std::vector<std::byte> availabilityBuffer(64);
   for (size_t i = 0; i < 64U; ++i) {
@@ -304,6 +365,51 @@ TEST_CASE("Test OctreeAvailability") {
   }
 }
 
+TEST_CASE("Test OctreeAvailability batch queries") {
+  // Two of the 64 child subtrees are available.
+  std::vector<std::byte> subtreeAvailabilityBuffer(8);
+  subtreeAvailabilityBuffer[0] = static_cast<std::byte>(0x05);
+
+  OctreeAvailability octreeAvailability(2, 4);
+  octreeAvailability.addSubtree(
+      OctreeTileID(0, 0, 0, 0),
+      AvailabilitySubtree{
+          ConstantAvailability{true},
+          ConstantAvailability{false},
+          SubtreeBufferView{0, 8, 0},
+          {subtreeAvailabilityBuffer}});
+
+  // Load one of the available child subtrees.
+  octreeAvailability.addSubtree(
+      OctreeTileID(2, 0, 0, 0),
+      AvailabilitySubtree{
+          ConstantAvailability{true},
+          ConstantAvailability{true},
+          ConstantAvailability{false},
+          {}});
+
+  std::vector<OctreeTileID> tileIDs;
+  for (uint32_t level = 0; level <= 5U; ++level) {
+    for (uint32_t z = 0; z < (1U << level); ++z) {
+      for (uint32_t y = 0; y < (1U << level); ++y) {
+        for (uint32_t x = 0; x < (1U << level); ++x) {
+          tileIDs.emplace_back(level, x, y, z);
+        }
+      }
+    }
+  }
+  std::vector<OctreeTileID> reversed(tileIDs.rbegin(), tileIDs.rend());
+
+  for (const std::vector<OctreeTileID>& ids : {tileIDs, reversed}) {
+    std::vector<uint8_t> availability(ids.size());
+    octreeAvailability.computeAvailability(ids, availability);
+    for (size_t i = 0; i < ids.size(); ++i) {
+      REQUIRE(
+          availability[i] == octreeAvailability.computeAvailability(ids[i]));
+    }
+  }
+}
+
 TEST_CASE("Test QuadtreeAvailability") {
   // We will test with a quadtree availability subtree with 3 levels.
 
@@ -490,5 +596,27 @@ TEST_CASE("Test QuadtreeAvailability") {
         REQUIRE((pChildNode != nullptr) == subtreeShouldBeLoaded);
       }
     }
+
+    // A batch query gives the same results as querying each tile, whether
+    // tiles in the same subtree are adjacent or not.
+    std::vector<QuadtreeTileID> tileIDs;
+    for (uint32_t level = 0; level <= 6U; ++level) {
+      for (uint32_t y = 0; y < (1U << level); ++y) {
+        for (uint32_t x = 0; x < (1U << level); ++x) {
+          tileIDs.emplace_back(level, x, y);
+        }
+      }
+    }
+    std::vector<QuadtreeTileID> reversed(tileIDs.rbegin(), tileIDs.rend());
+
+    for (const std::vector<QuadtreeTileID>& ids : {tileIDs, reversed}) {
+      std::vector<uint8_t> batchAvailability(ids.size());
+      quadtreeAvailability.computeAvailability(ids, batchAvailability);
+      for (size_t i = 0; i < ids.size(); ++i) {
+        REQUIRE(
+            batchAvailability[i] ==
+            quadtreeAvailability.computeAvailability(ids[i]));
+      }
+    }
   }
 }
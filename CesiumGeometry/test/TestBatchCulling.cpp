@@ -0,0 +1,132 @@
+#include "CesiumGeometry/BatchCulling.h"
+#include "CesiumGeometry/BoundingSphere.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
+#include "CesiumGeometry/Plane.h"
+
+#include <catch2/catch.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <vector>
+
+using namespace CesiumGeometry;
+
+namespace {
+std::vector<Plane> createPlanes() {
+  return {
+      Plane(glm::normalize(glm::dvec3(1.0, 0.0, 0.2)), 3.0),
+      Plane(glm::normalize(glm::dvec3(-1.0, 0.0, 0.2)), 3.0),
+      Plane(glm::normalize(glm::dvec3(0.0, 1.0, 0.3)), 2.0),
+      Plane(glm::normalize(glm::dvec3(0.0, -1.0, 0.3)), 2.0)};
+}
+
+template <typename T>
+CullingResult intersectPlanesOneByOne(
+    const std::vector<Plane>& planes,
+    const T& volume) {
+  CullingResult combined = CullingResult::Inside;
+  for (const Plane& plane : planes) {
+    const CullingResult result = volume.intersectPlane(plane);
+    if (result == CullingResult::Outside) {
+      return CullingResult::Outside;
+    }
+    if (result == CullingResult::Intersecting) {
+      combined = CullingResult::Intersecting;
+    }
+  }
+  return combined;
+}
+} // namespace
+
+TEST_CASE("BatchCulling::intersectPlanes") {
+  const std::vector<Plane> planes = createPlanes();
+
+  // A count that is not a multiple of the lane count, so that the last batch
+  // is only partially full.
+  const size_t count = 3 * BatchCulling::LaneCount + 5;
+
+  SECTION("boxes") {
+    std::vector<OrientedBoundingBox> boxes;
+    for (size_t i = 0; i < count; ++i) {
+      const double t = double(i);
+      const glm::dvec3 center(-8.0 + 0.6 * t, 5.0 - 0.35 * t, 0.1 * t - 1.0);
+      const glm::dmat3 halfAxes(glm::rotate(
+          glm::scale(glm::dmat4(1.0), glm::dvec3(0.5 + 0.1 * t, 1.0, 0.3)),
+          0.2 * t,
+          glm::dvec3(0.5, 1.5, -1.2)));
+      boxes.emplace_back(center, halfAxes);
+    }
+
+    std::vector<CullingResult> results(count);
+    BatchCulling::intersectPlanes(planes, boxes, results);
+
+    std::vector<const OrientedBoundingBox*> pointers;
+    for (const OrientedBoundingBox& box : boxes) {
+      pointers.emplace_back(&box);
+    }
+    std::vector<CullingResult> pointerResults(count);
+    BatchCulling::intersectPlanes(planes, pointers, pointerResults);
+
+    bool sawOutside = false;
+    bool sawInside = false;
+    bool sawIntersecting = false;
+    for (size_t i = 0; i < count; ++i) {
+      const CullingResult expected = intersectPlanesOneByOne(planes, boxes[i]);
+      CHECK(results[i] == expected);
+      CHECK(pointerResults[i] == expected);
+      sawOutside = sawOutside || expected == CullingResult::Outside;
+      sawInside = sawInside || expected == CullingResult::Inside;
+      sawIntersecting =
+          sawIntersecting || expected == CullingResult::Intersecting;
+    }
+
+    // Make sure the test data actually exercises every result.
+    CHECK(sawOutside);
+    CHECK(sawInside);
+    CHECK(sawIntersecting);
+  }
+
+  SECTION("spheres") {
+    std::vector<BoundingSphere> spheres;
+    for (size_t i = 0; i < count; ++i) {
+      const double t = double(i);
+      spheres.emplace_back(
+          glm::dvec3(-8.0 + 0.6 * t, 5.0 - 0.35 * t, 0.1 * t - 1.0),
+          0.2 + 0.05 * t);
+    }
+
+    std::vector<CullingResult> results(count);
+    BatchCulling::intersectPlanes(planes, spheres, results);
+
+    std::vector<const BoundingSphere*> pointers;
+    for (const BoundingSphere& sphere : spheres) {
+      pointers.emplace_back(&sphere);
+    }
+    std::vector<CullingResult> pointerResults(count);
+    BatchCulling::intersectPlanes(planes, pointers, pointerResults);
+
+    bool sawOutside = false;
+    bool sawInside = false;
+    bool sawIntersecting = false;
+    for (size_t i = 0; i < count; ++i) {
+      const CullingResult expected =
+          intersectPlanesOneByOne(planes, spheres[i]);
+      CHECK(results[i] == expected);
+      CHECK(pointerResults[i] == expected);
+      sawOutside = sawOutside || expected == CullingResult::Outside;
+      sawInside = sawInside || expected == CullingResult::Inside;
+      sawIntersecting =
+          sawIntersecting || expected == CullingResult::Intersecting;
+    }
+
+    CHECK(sawOutside);
+    CHECK(sawInside);
+    CHECK(sawIntersecting);
+  }
+
+  SECTION("no volumes") {
+    std::vector<OrientedBoundingBox> boxes;
+    std::vector<CullingResult> results;
+    BatchCulling::intersectPlanes(planes, boxes, results);
+    CHECK(results.empty());
+  }
+}
@@ -0,0 +1,246 @@
+#include "CesiumGeometry/AxisAlignedBox.h"
+#include "CesiumGeometry/BatchIntersection.h"
+#include "CesiumGeometry/BoundingSphere.h"
+#include "CesiumGeometry/IntersectionTests.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
+#include "CesiumGeometry/Ray.h"
+
+#include <catch2/catch.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <array>
+#include <cmath>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace CesiumGeometry;
+
+namespace {
+// A count that is not a multiple of the lane count, so that the last batch is
+// only partially full.
+constexpr size_t count = 3 * BatchIntersection::LaneCount + 5;
+
+// Rays from around the origin towards the positive X axis, some of which are
+// parallel to the coordinate planes.
+std::vector<Ray> createRays() {
+  std::vector<Ray> rays;
+  for (size_t i = 0; i < count; ++i) {
+    const double t = double(i);
+    const glm::dvec3 origin(
+        -1.0 + 0.1 * t,
+        0.3 * std::sin(t),
+        0.2 * std::cos(t));
+    const glm::dvec3 direction =
+        i % 4 == 0 ? glm::dvec3(1.0, 0.0, 0.0)
+                   : glm::normalize(glm::dvec3(
+                         1.0,
+                         0.4 * std::sin(1.7 * t),
+                         0.3 * std::cos(2.3 * t)));
+    rays.emplace_back(origin, direction);
+  }
+  return rays;
+}
+
+void checkResults(
+    const std::vector<std::optional<double>>& results,
+    const std::vector<std::optional<double>>& expected) {
+  REQUIRE(results.size() == expected.size());
+
+  bool sawHit = false;
+  bool sawMiss = false;
+  for (size_t i = 0; i < results.size(); ++i) {
+    REQUIRE(results[i].has_value() == expected[i].has_value());
+    if (expected[i]) {
+      CHECK(*results[i] == Approx(*expected[i]));
+      sawHit = true;
+    } else {
+      sawMiss = true;
+    }
+  }
+
+  // Make sure that the test covers both cases.
+  CHECK(sawHit);
+  CHECK(sawMiss);
+}
+} // namespace
+
+TEST_CASE("BatchIntersection::intersectRay") {
+  const Ray ray(
+      glm::dvec3(0.0, 0.1, -0.2),
+      glm::normalize(glm::dvec3(1.0, 0.05, 0.02)));
+  std::vector<std::optional<double>> results(count);
+  std::vector<std::optional<double>> expected(count);
+
+  SECTION("triangles") {
+    std::vector<std::array<glm::dvec3, 3>> triangles;
+    std::vector<std::array<glm::vec3, 3>> floatTriangles;
+    for (size_t i = 0; i < count; ++i) {
+      const double t = double(i);
+      const double size = 0.2 + 0.05 * t;
+
+      // Centered on the ray, except for every third triangle, which is moved
+      // well away from it. The ray passes far from the edges of the others,
+      // so that computing in single precision finds the same hits.
+      glm::dvec3 center = ray.getOrigin() + ray.getDirection() * (2.0 + t);
+      if (i % 3 == 2) {
+        center.y += 3.0;
+      }
+
+      // Alternate the winding so that some triangles face away from the ray.
+      std::array<glm::dvec3, 3> triangle{
+          center + glm::dvec3(0.1, -size, -size),
+          center + glm::dvec3(-0.1, 2.0 * size, -size),
+          center + glm::dvec3(0.0, -size, 2.0 * size)};
+      if (i % 2 == 1) {
+        std::swap(triangle[1], triangle[2]);
+      }
+
+      triangles.push_back(triangle);
+      floatTriangles.push_back(
+          {glm::vec3(triangle[0]),
+           glm::vec3(triangle[1]),
+           glm::vec3(triangle[2])});
+    }
+
+    const bool cullBackFaces = GENERATE(false, true);
+    for (size_t i = 0; i < count; ++i) {
+      expected[i] = IntersectionTests::rayTriangleParametric(
+          ray,
+          triangles[i][0],
+          triangles[i][1],
+          triangles[i][2],
+          cullBackFaces);
+    }
+
+    BatchIntersection::intersectRay(ray, triangles, results, cullBackFaces);
+    checkResults(results, expected);
+
+    BatchIntersection::intersectRay(
+        ray,
+        floatTriangles,
+        results,
+        cullBackFaces);
+    checkResults(results, expected);
+  }
+
+  SECTION("axis-aligned boxes") {
+    std::vector<AxisAlignedBox> boxes;
+    for (size_t i = 0; i < count; ++i) {
+      const double t = double(i);
+      const double y = 0.5 * std::sin(t);
+      boxes.emplace_back(
+          1.0 + t,
+          y - 0.3,
+          -0.4,
+          1.5 + t,
+          y + 0.3,
+          0.4 + 0.01 * t);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      expected[i] = IntersectionTests::rayAABBParametric(ray, boxes[i]);
+    }
+
+    BatchIntersection::intersectRay(ray, boxes, results);
+    checkResults(results, expected);
+  }
+
+  SECTION("oriented boxes") {
+    std::vector<OrientedBoundingBox> boxes;
+    for (size_t i = 0; i < count; ++i) {
+      const double t = double(i);
+      const glm::dvec3 center(1.0 + t, 0.5 * std::sin(t), 0.4 * std::cos(t));
+      const glm::dmat3 halfAxes(glm::rotate(
+          glm::scale(glm::dmat4(1.0), glm::dvec3(0.3, 0.3 + 0.01 * t, 0.2)),
+          0.2 * t,
+          glm::dvec3(0.5, 1.5, -1.2)));
+      boxes.emplace_back(center, halfAxes);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      expected[i] = IntersectionTests::rayOBBParametric(ray, boxes[i]);
+    }
+
+    BatchIntersection::intersectRay(ray, boxes, results);
+    checkResults(results, expected);
+  }
+
+  SECTION("spheres") {
+    std::vector<BoundingSphere> spheres;
+    for (size_t i = 0; i < count; ++i) {
+      const double t = double(i);
+      spheres.emplace_back(
+          glm::dvec3(t - 1.0, 0.6 * std::sin(t), 0.5 * std::cos(t)),
+          0.25 + 0.02 * t);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      expected[i] = IntersectionTests::raySphereParametric(ray, spheres[i]);
+    }
+
+    BatchIntersection::intersectRay(ray, spheres, results);
+    checkResults(results, expected);
+  }
+}
+
+TEST_CASE("BatchIntersection::intersectRays") {
+  const std::vector<Ray> rays = createRays();
+  std::vector<std::optional<double>> results(count);
+  std::vector<std::optional<double>> expected(count);
+
+  SECTION("triangle") {
+    // Facing the rays, so that culling back faces doesn't hide it.
+    const glm::dvec3 p0(3.0, -0.3, -0.3);
+    const glm::dvec3 p1(3.2, 0.0, 0.35);
+    const glm::dvec3 p2(3.5, 0.4, -0.2);
+
+    const bool cullBackFaces = GENERATE(false, true);
+    for (size_t i = 0; i < count; ++i) {
+      expected[i] = IntersectionTests::rayTriangleParametric(
+          rays[i],
+          p0,
+          p1,
+          p2,
+          cullBackFaces);
+    }
+
+    BatchIntersection::intersectRays(rays, p0, p1, p2, results, cullBackFaces);
+    checkResults(results, expected);
+  }
+
+  SECTION("axis-aligned box") {
+    const AxisAlignedBox box(2.0, -0.25, -0.2, 3.0, 0.25, 0.2);
+    for (size_t i = 0; i < count; ++i) {
+      expected[i] = IntersectionTests::rayAABBParametric(rays[i], box);
+    }
+
+    BatchIntersection::intersectRays(rays, box, results);
+    checkResults(results, expected);
+  }
+
+  SECTION("oriented box") {
+    const OrientedBoundingBox box(
+        glm::dvec3(2.5, 0.0, 0.0),
+        glm::dmat3(glm::rotate(
+            glm::scale(glm::dmat4(1.0), glm::dvec3(0.5, 0.25, 0.2)),
+            0.7,
+            glm::dvec3(0.0, 0.0, 1.0))));
+    for (size_t i = 0; i < count; ++i) {
+      expected[i] = IntersectionTests::rayOBBParametric(rays[i], box);
+    }
+
+    BatchIntersection::intersectRays(rays, box, results);
+    checkResults(results, expected);
+  }
+
+  SECTION("sphere") {
+    const BoundingSphere sphere(glm::dvec3(0.5, 0.0, 0.0), 0.35);
+    for (size_t i = 0; i < count; ++i) {
+      expected[i] = IntersectionTests::raySphereParametric(rays[i], sphere);
+    }
+
+    BatchIntersection::intersectRays(rays, sphere, results);
+    checkResults(results, expected);
+  }
+}
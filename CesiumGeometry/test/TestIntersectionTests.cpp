@@ -1,9 +1,13 @@
+#include "CesiumGeometry/AxisAlignedBox.h"
+#include "CesiumGeometry/BoundingSphere.h"
 #include "CesiumGeometry/IntersectionTests.h"
+#include "CesiumGeometry/OrientedBoundingBox.h"
 #include "CesiumGeometry/Plane.h"
 #include "CesiumGeometry/Ray.h"
 
 #include <catch2/catch.hpp>
 #include <glm/glm.hpp>
+#include <glm/gtc/epsilon.hpp>
 
 #include <array>
 
@@ -38,6 +42,192 @@ TEST_CASE("IntersectionTests::rayPlane") {
   CHECK(intersectionPoint == testCase.expectedIntersectionPoint);
 }
 
+TEST_CASE("IntersectionTests::rayTriangleParametric") {
+  struct TestCase {
+    Ray ray;
+    bool cullBackFaces;
+    std::optional<double> expectedT;
+  };
+
+  // A counter-clockwise triangle in the z = 0 plane, facing +z.
+  const glm::dvec3 p0(0.0, 0.0, 0.0);
+  const glm::dvec3 p1(2.0, 0.0, 0.0);
+  const glm::dvec3 p2(0.0, 2.0, 0.0);
+
+  auto testCase = GENERATE(
+      // hits the front
+      TestCase{
+          Ray(glm::dvec3(0.5, 0.5, 3.0), glm::dvec3(0.0, 0.0, -1.0)),
+          true,
+          3.0},
+      // hits the back
+      TestCase{
+          Ray(glm::dvec3(0.5, 0.5, -2.0), glm::dvec3(0.0, 0.0, 1.0)),
+          false,
+          2.0},
+      // hits the back, with back faces culled
+      TestCase{
+          Ray(glm::dvec3(0.5, 0.5, -2.0), glm::dvec3(0.0, 0.0, 1.0)),
+          true,
+          std::nullopt},
+      // misses, outside of the triangle
+      TestCase{
+          Ray(glm::dvec3(1.5, 1.5, 3.0), glm::dvec3(0.0, 0.0, -1.0)),
+          false,
+          std::nullopt},
+      // misses, the triangle is behind the ray
+      TestCase{
+          Ray(glm::dvec3(0.5, 0.5, 3.0), glm::dvec3(0.0, 0.0, 1.0)),
+          false,
+          std::nullopt},
+      // misses (parallel)
+      TestCase{
+          Ray(glm::dvec3(-1.0, 0.5, 0.0), glm::dvec3(1.0, 0.0, 0.0)),
+          false,
+          std::nullopt});
+
+  std::optional<double> t = IntersectionTests::rayTriangleParametric(
+      testCase.ray,
+      p0,
+      p1,
+      p2,
+      testCase.cullBackFaces);
+  CHECK(t == testCase.expectedT);
+}
+
+TEST_CASE("IntersectionTests::rayOBBParametric") {
+  struct TestCase {
+    Ray ray;
+    OrientedBoundingBox obb;
+    std::optional<double> expectedT;
+  };
+
+  const OrientedBoundingBox box(
+      glm::dvec3(10.0, 0.0, 0.0),
+      glm::dmat3(
+          glm::dvec3(0.0, 2.0, 0.0),
+          glm::dvec3(-1.0, 0.0, 0.0),
+          glm::dvec3(0.0, 0.0, 3.0)));
+  const OrientedBoundingBox flatBox(
+      glm::dvec3(10.0, 0.0, 0.0),
+      glm::dmat3(
+          glm::dvec3(1.0, 0.0, 0.0),
+          glm::dvec3(0.0, 1.0, 0.0),
+          glm::dvec3(0.0, 0.0, 0.0)));
+
+  auto testCase = GENERATE_COPY(
+      // enters the box
+      TestCase{
+          Ray(glm::dvec3(0.0, 0.0, 0.0), glm::dvec3(1.0, 0.0, 0.0)),
+          box,
+          9.0},
+      // starts inside the box
+      TestCase{
+          Ray(glm::dvec3(10.0, 1.0, 2.0), glm::dvec3(0.0, 0.0, 1.0)),
+          box,
+          0.0},
+      // misses, passing beside the box
+      TestCase{
+          Ray(glm::dvec3(0.0, 2.5, 0.0), glm::dvec3(1.0, 0.0, 0.0)),
+          box,
+          std::nullopt},
+      // misses, the box is behind the ray
+      TestCase{
+          Ray(glm::dvec3(0.0, 0.0, 0.0), glm::dvec3(-1.0, 0.0, 0.0)),
+          box,
+          std::nullopt},
+      // enters a flat box
+      TestCase{
+          Ray(glm::dvec3(10.5, 0.5, 4.0), glm::dvec3(0.0, 0.0, -1.0)),
+          flatBox,
+          4.0},
+      // misses a flat box, passing beside it
+      TestCase{
+          Ray(glm::dvec3(11.5, 0.5, 4.0), glm::dvec3(0.0, 0.0, -1.0)),
+          flatBox,
+          std::nullopt});
+
+  std::optional<double> t =
+      IntersectionTests::rayOBBParametric(testCase.ray, testCase.obb);
+  REQUIRE(t.has_value() == testCase.expectedT.has_value());
+  if (t) {
+    CHECK(glm::epsilonEqual(*t, *testCase.expectedT, 1e-12));
+  }
+}
+
+TEST_CASE("IntersectionTests::rayAABBParametric") {
+  struct TestCase {
+    Ray ray;
+    std::optional<double> expectedT;
+  };
+
+  const AxisAlignedBox box(9.0, -2.0, -3.0, 11.0, 2.0, 3.0);
+
+  auto testCase = GENERATE(
+      // enters the box
+      TestCase{
+          Ray(glm::dvec3(0.0, 0.0, 0.0), glm::dvec3(1.0, 0.0, 0.0)),
+          9.0},
+      // enters the box diagonally
+      TestCase{
+          Ray(glm::dvec3(7.0, -3.0, 0.0),
+              glm::normalize(glm::dvec3(1.0, 1.0, 0.0))),
+          2.0 * glm::sqrt(2.0)},
+      // starts inside the box
+      TestCase{
+          Ray(glm::dvec3(10.0, 1.0, 2.0), glm::dvec3(0.0, 0.0, 1.0)),
+          0.0},
+      // misses, passing beside the box
+      TestCase{
+          Ray(glm::dvec3(0.0, 2.5, 0.0), glm::dvec3(1.0, 0.0, 0.0)),
+          std::nullopt},
+      // misses, the box is behind the ray
+      TestCase{
+          Ray(glm::dvec3(0.0, 0.0, 0.0), glm::dvec3(-1.0, 0.0, 0.0)),
+          std::nullopt});
+
+  const std::optional<double> t =
+      IntersectionTests::rayAABBParametric(testCase.ray, box);
+  REQUIRE(t.has_value() == testCase.expectedT.has_value());
+  if (t) {
+    CHECK(glm::epsilonEqual(*t, *testCase.expectedT, 1e-12));
+  }
+}
+
+TEST_CASE("IntersectionTests::raySphereParametric") {
+  struct TestCase {
+    Ray ray;
+    std::optional<double> expectedT;
+  };
+
+  const BoundingSphere sphere(glm::dvec3(10.0, 0.0, 0.0), 2.0);
+
+  auto testCase = GENERATE(
+      // enters the sphere
+      TestCase{
+          Ray(glm::dvec3(0.0, 0.0, 0.0), glm::dvec3(1.0, 0.0, 0.0)),
+          8.0},
+      // starts inside the sphere
+      TestCase{
+          Ray(glm::dvec3(10.0, 1.0, 0.0), glm::dvec3(0.0, 1.0, 0.0)),
+          0.0},
+      // misses, passing beside the sphere
+      TestCase{
+          Ray(glm::dvec3(0.0, 2.5, 0.0), glm::dvec3(1.0, 0.0, 0.0)),
+          std::nullopt},
+      // misses, the sphere is behind the ray
+      TestCase{
+          Ray(glm::dvec3(0.0, 0.0, 0.0), glm::dvec3(-1.0, 0.0, 0.0)),
+          std::nullopt});
+
+  const std::optional<double> t =
+      IntersectionTests::raySphereParametric(testCase.ray, sphere);
+  REQUIRE(t.has_value() == testCase.expectedT.has_value());
+  if (t) {
+    CHECK(glm::epsilonEqual(*t, *testCase.expectedT, 1e-12));
+  }
+}
+
 TEST_CASE("IntersectionTests::pointInTriangle (2D overload)") {
   struct TestCase {
     glm::dvec2 point;
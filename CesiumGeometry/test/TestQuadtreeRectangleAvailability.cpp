@@ -0,0 +1,133 @@
+#include "CesiumGeometry/QuadtreeRectangleAvailability.h"
+#include "CesiumGeometry/TileAvailabilityFlags.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+using namespace CesiumGeometry;
+
+namespace {
+// Whether any of the ranges contains the position, the way the tiles are
+// laid out by the tiling scheme, considering only the ranges at or below the
+// given level.
+bool anyRangeContains(
+    const QuadtreeTilingScheme& tilingScheme,
+    const std::vector<QuadtreeTileRectangularRange>& ranges,
+    const glm::dvec2& position,
+    uint32_t minimumLevel) {
+  for (const QuadtreeTileRectangularRange& range : ranges) {
+    if (range.level < minimumLevel) {
+      continue;
+    }
+
+    const Rectangle ll = tilingScheme.tileToRectangle(
+        QuadtreeTileID(range.level, range.minimumX, range.minimumY));
+    const Rectangle ur = tilingScheme.tileToRectangle(
+        QuadtreeTileID(range.level, range.maximumX, range.maximumY));
+    const Rectangle rectangle(
+        ll.minimumX,
+        ll.minimumY,
+        ur.maximumX,
+        ur.maximumY);
+    if (rectangle.contains(position)) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+TEST_CASE("QuadtreeRectangleAvailability") {
+  const QuadtreeTilingScheme tilingScheme(
+      Rectangle(-180.0, -90.0, 180.0, 90.0),
+      2,
+      1);
+  QuadtreeRectangleAvailability availability(tilingScheme, 6);
+
+  // Overlapping, adjacent and nested ranges at several levels, added out of
+  // order.
+  const std::vector<QuadtreeTileRectangularRange> ranges{
+      {0, 0, 0, 1, 0},
+      {2, 0, 0, 3, 1},
+      {2, 2, 1, 5, 3},
+      {2, 6, 3, 7, 3},
+      {1, 1, 0, 2, 1},
+      {4, 5, 4, 9, 6},
+      {4, 7, 2, 8, 12},
+      {4, 30, 0, 31, 0},
+      {6, 40, 17, 40, 17},
+      {3, 9, 5, 9, 5},
+      {3, 9, 5, 12, 5}};
+  for (const QuadtreeTileRectangularRange& range : ranges) {
+    availability.addAvailableTileRange(range);
+  }
+
+  SECTION("matches the tiles whose centers are in a range at their level or "
+          "deeper") {
+    for (uint32_t level = 0; level <= 7; ++level) {
+      for (uint32_t y = 0; y < tilingScheme.getNumberOfYTilesAtLevel(level);
+           ++y) {
+        for (uint32_t x = 0;
+             x < tilingScheme.getNumberOfXTilesAtLevel(level);
+             ++x) {
+          const QuadtreeTileID id(level, x, y);
+          const glm::dvec2 center =
+              tilingScheme.tileToRectangle(id).getCenter();
+          const bool expected =
+              anyRangeContains(tilingScheme, ranges, center, level);
+          CHECK(
+              availability.isTileAvailable(id) ==
+              (expected ? TileAvailabilityFlags::TILE_AVAILABLE |
+                              TileAvailabilityFlags::REACHABLE
+                        : 0));
+
+          uint8_t expectedChildren = 0;
+          for (uint32_t i = 0; i < 4; ++i) {
+            const QuadtreeTileID childID(
+                level + 1,
+                x * 2 + (i & 1),
+                y * 2 + (i >> 1));
+            if (availability.isTileAvailable(childID)) {
+              expectedChildren |= uint8_t(1U << i);
+            }
+          }
+          CHECK(availability.computeAvailableChildren(id) == expectedChildren);
+        }
+      }
+    }
+  }
+
+  SECTION("computes the maximum level at a position") {
+    // Inside the level 6 range.
+    const glm::dvec2 deep =
+        tilingScheme.tileToRectangle(QuadtreeTileID(6, 40, 17)).getCenter();
+    CHECK(availability.computeMaximumLevelAtPosition(deep) == 6);
+
+    // On the corner of a tile in a level 4 range.
+    const Rectangle edge =
+        tilingScheme.tileToRectangle(QuadtreeTileID(4, 9, 6));
+    CHECK(
+        availability.computeMaximumLevelAtPosition(edge.getUpperRight()) == 4);
+
+    // Only in the level 0 range.
+    CHECK(
+        availability.computeMaximumLevelAtPosition(glm::dvec2(-170.0, 80.0)) ==
+        0);
+
+    // Outside the tiling scheme.
+    CHECK(
+        availability.computeMaximumLevelAtPosition(glm::dvec2(200.0, 0.0)) ==
+        0);
+  }
+
+  SECTION("indexes ranges added after a query") {
+    const QuadtreeTileID id(5, 0, 31);
+    CHECK(availability.isTileAvailable(id) == 0);
+    availability.addAvailableTileRange({5, 0, 31, 0, 31});
+    CHECK(availability.isTileAvailable(id) != 0);
+    CHECK(availability.computeMaximumLevelAtPosition(
+              tilingScheme.tileToRectangle(id).getCenter()) == 5);
+  }
+}
@@ -4,7 +4,9 @@
 #include "Library.h"
 
 #include <glm/vec2.hpp>
+#include <gsl/span>
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
@@ -64,6 +66,46 @@ public:
     return this->_boundingRectangle;
   }
 
+  /**
+   * @brief Determines whether a longitude-latitude point is inside this
+   * polygon.
+   *
+   * The point is only tested against the edges of the polygon that span its
+   * latitude, which are found with an index that is built when the polygon is
+   * constructed. Whether points on the perimeter are inside is unspecified.
+   *
+   * @param point The longitude-latitude point in radians.
+   * @return True if the point is inside this polygon; otherwise, false.
+   */
+  bool contains(const glm::dvec2& point) const noexcept;
+
+  /**
+   * @brief Determines whether each of many longitude-latitude points is inside
+   * this polygon.
+   *
+   * The results are the same as calling
+   * {@link contains(const glm::dvec2&) const} for each point, with a loop over
+   * the edges of the polygon that the compiler can vectorize.
+   *
+   * @param points The longitude-latitude points in radians.
+   * @param results Receives whether each point is inside this polygon. Must be
+   * at least as large as `points`.
+   */
+  void contains(
+      gsl::span<const glm::dvec2> points,
+      gsl::span<bool> results) const noexcept;
+
+  /**
+   * @brief Determines whether a globe rectangle is completely inside this
+   * polygon.
+   *
+   * @param rectangle The {@link CesiumGeospatial::GlobeRectangle} of the tile.
+   * @return True if the rectangle is completely inside this polygon;
+   * otherwise, false.
+   */
+  bool containsRectangle(
+      const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept;
+
   /**
    * @brief Determines whether a globe rectangle is completely inside any of the
    * polygons in a list.
@@ -96,6 +138,26 @@ private:
   std::vector<glm::dvec2> _vertices;
   std::vector<uint32_t> _indices;
   std::optional<CesiumGeospatial::GlobeRectangle> _boundingRectangle;
+
+  // The edges of the perimeter, with longitudes relative to the first vertex,
+  // sorted into bands of equal latitude range. An edge is in each band that its
+  // latitudes overlap, so that a point is only tested against the edges of its
+  // band. The edges of band i are at [bandStarts[i], bandStarts[i + 1]) in the
+  // arrays, which hold the start of each edge and the change in longitude per
+  // change in latitude along it. Horizontal edges are left out.
+  struct EdgeIndex {
+    double south = 0.0;
+    double north = 0.0;
+    double bandsPerRadian = 0.0;
+    std::vector<uint32_t> bandStarts;
+    std::vector<double> startX;
+    std::vector<double> startY;
+    std::vector<double> endY;
+    std::vector<double> slope;
+  };
+  EdgeIndex _edgeIndex;
+
+  bool containsLocal(double x, double y) const noexcept;
 };
 
 } // namespace CesiumGeospatial
@@ -6,6 +6,7 @@
 #include <CesiumUtility/Math.h>
 
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 #include <optional>
 
@@ -70,6 +71,22 @@ public:
    */
   glm::dvec3 geodeticSurfaceNormal(const glm::dvec3& position) const noexcept;
 
+  /**
+   * @brief Computes the normals of the planes tangent to the surface of the
+   * ellipsoid at many cartesian positions at once.
+   *
+   * The results are the same as calling
+   * {@link geodeticSurfaceNormal(const glm::dvec3&) const} for each position,
+   * with a loop that the compiler can vectorize.
+   *
+   * @param positions The cartesian positions.
+   * @param results Receives the normal at each position. Must be at least as
+   * large as `positions`.
+   */
+  void geodeticSurfaceNormal(
+      gsl::span<const glm::dvec3> positions,
+      gsl::span<glm::dvec3> results) const noexcept;
+
   /**
    * @brief Computes the normal of the plane tangent to the surface of the
    * ellipsoid at the provided position.
@@ -91,6 +108,22 @@ public:
   glm::dvec3
   cartographicToCartesian(const Cartographic& cartographic) const noexcept;
 
+  /**
+   * @brief Converts many {@link Cartographic} positions to their cartesian
+   * representations at once.
+   *
+   * The results are the same as calling
+   * {@link cartographicToCartesian(const Cartographic&) const} for each
+   * position, with loops that the compiler can vectorize.
+   *
+   * @param cartographics The {@link Cartographic} positions.
+   * @param results Receives the cartesian representation of each position.
+   * Must be at least as large as `cartographics`.
+   */
+  void cartographicToCartesian(
+      gsl::span<const Cartographic> cartographics,
+      gsl::span<glm::dvec3> results) const noexcept;
+
   /**
    * @brief Converts the provided cartesian to a {@link Cartographic}
    * representation.
@@ -105,6 +138,47 @@ public:
   std::optional<Cartographic>
   cartesianToCartographic(const glm::dvec3& cartesian) const noexcept;
 
+  /**
+   * @brief Converts many cartesian positions to their {@link Cartographic}
+   * representations at once.
+   *
+   * The results are the same as calling
+   * {@link cartesianToCartographic(const glm::dvec3&) const} for each
+   * position, but the positions are processed in blocks, with loops that the
+   * compiler can vectorize.
+   *
+   * @param cartesians The cartesian positions.
+   * @param results Receives the {@link Cartographic} representation of each
+   * position, or the empty optional if the position is at the center of this
+   * ellipsoid. Must be at least as large as `cartesians`.
+   */
+  void cartesianToCartographic(
+      gsl::span<const glm::dvec3> cartesians,
+      gsl::span<std::optional<Cartographic>> results) const noexcept;
+
+  /**
+   * @brief Converts many cartesian positions to approximations of their
+   * {@link Cartographic} representations at once, without iterating.
+   *
+   * For an ellipsoid of revolution, whose X and Y radii are equal, this uses a
+   * single step of Bowring's method. For positions within 100 kilometers of
+   * the surface of {@link WGS84}, the latitudes are within `1e-10` radians of
+   * those computed by {@link cartesianToCartographic}, which is less than a
+   * millimeter, and the heights are within a millimeter. The longitudes are
+   * exact. This is accurate enough for texture coordinates, and several times
+   * faster. For other ellipsoids, this is the same as
+   * {@link cartesianToCartographic}.
+   *
+   * @param cartesians The cartesian positions.
+   * @param results Receives the approximate {@link Cartographic}
+   * representation of each position, or the empty optional if the position is
+   * at the center of this ellipsoid. Must be at least as large as
+   * `cartesians`.
+   */
+  void cartesianToCartographicApproximate(
+      gsl::span<const glm::dvec3> cartesians,
+      gsl::span<std::optional<Cartographic>> results) const noexcept;
+
   /**
    * @brief Scales the given cartesian position along the geodetic surface
    * normal so that it is on the surface of this ellipsoid.
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "BoundingRegion.h"
+#include "Ellipsoid.h"
+#include "Library.h"
+#include "S2CellBoundingVolume.h"
+
+#include <glm/vec3.hpp>
+#include <gsl/span>
+
+#include <optional>
+
+namespace CesiumGeospatial {
+
+/**
+ * @brief A point that stands in for a whole volume when culling it against
+ * the horizon of an ellipsoid: if the point is below the horizon, so is all of
+ * the volume. See {@link EllipsoidalOccluder}.
+ */
+struct HorizonCullingPoint {
+  /**
+   * @brief The position of the point in the scaled space of the ellipsoid,
+   * where the ellipsoid is a unit sphere.
+   *
+   * If {@link minimumHeight} is negative, this is relative to the ellipsoid
+   * shrunk by that much instead.
+   */
+  glm::dvec3 scaledSpacePosition{0.0};
+
+  /**
+   * @brief The height of the lowest part of the volume above the ellipsoid.
+   * Parts of the volume below the ellipsoid are not hidden by it, so a smaller
+   * ellipsoid is used for volumes that reach below it.
+   */
+  double minimumHeight = 0.0;
+};
+
+/**
+ * @brief Determines whether points and volumes are hidden from a camera by an
+ * ellipsoid, that is, whether they are below its horizon.
+ *
+ * This is based on the algorithm described in <a
+ * href="https://cesium.com/blog/2013/04/25/horizon-culling/">Horizon
+ * Culling</a>, extended to ellipsoids by working in the ellipsoid's scaled
+ * space, where it is a unit sphere.
+ */
+class CESIUMGEOSPATIAL_API EllipsoidalOccluder final {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param ellipsoid The ellipsoid that occludes.
+   * @param cameraPosition The position of the camera, in the ellipsoid's
+   * coordinate system.
+   */
+  EllipsoidalOccluder(
+      const Ellipsoid& ellipsoid,
+      const glm::dvec3& cameraPosition) noexcept;
+
+  /**
+   * @brief Gets the ellipsoid that occludes.
+   */
+  const Ellipsoid& getEllipsoid() const noexcept { return this->_ellipsoid; }
+
+  /**
+   * @brief Gets the position of the camera.
+   */
+  const glm::dvec3& getCameraPosition() const noexcept {
+    return this->_cameraPosition;
+  }
+
+  /**
+   * @brief Determines whether a point is visible, that is, not hidden by the
+   * ellipsoid.
+   *
+   * Points are always visible from a camera that is inside the ellipsoid.
+   *
+   * @param occludee The point, in the ellipsoid's coordinate system.
+   */
+  bool isPointVisible(const glm::dvec3& occludee) const noexcept;
+
+  /**
+   * @brief Determines whether the volume that a horizon culling point was
+   * computed for may be visible.
+   *
+   * @param point The horizon culling point, see
+   * {@link computeHorizonCullingPoint}.
+   */
+  bool isHorizonCullingPointVisible(
+      const HorizonCullingPoint& point) const noexcept;
+
+  /**
+   * @brief Computes a horizon culling point for a set of positions. If the
+   * point is below the horizon, so are all of the positions.
+   *
+   * @param ellipsoid The ellipsoid that occludes.
+   * @param directionToPoint The direction from the center of the ellipsoid in
+   * which to place the point, usually toward the center of the positions.
+   * @param positions The positions, in the ellipsoid's coordinate system.
+   * @param minimumHeight The height of the lowest position above the
+   * ellipsoid, if it's below the ellipsoid.
+   * @returns The point, or `std::nullopt` if the positions are too spread
+   * out around the ellipsoid for any point along the direction to stand in
+   * for all of them.
+   */
+  static std::optional<HorizonCullingPoint> computeHorizonCullingPoint(
+      const Ellipsoid& ellipsoid,
+      const glm::dvec3& directionToPoint,
+      gsl::span<const glm::dvec3> positions,
+      double minimumHeight = 0.0);
+
+  /**
+   * @brief Computes a horizon culling point for a bounding region. If the
+   * point is below the horizon, so is the whole region.
+   *
+   * @param region The region.
+   * @param ellipsoid The ellipsoid that occludes.
+   * @returns The point, or `std::nullopt` if the region covers too much of
+   * the ellipsoid to ever be below its horizon.
+   */
+  static std::optional<HorizonCullingPoint> computeHorizonCullingPoint(
+      const BoundingRegion& region,
+      const Ellipsoid& ellipsoid = Ellipsoid::WGS84);
+
+  /**
+   * @brief Computes a horizon culling point for an S2 cell bounding volume.
+   * If the point is below the horizon, so is the whole volume.
+   *
+   * @param s2Cell The S2 cell bounding volume.
+   * @param ellipsoid The ellipsoid that occludes.
+   * @returns The point, or `std::nullopt` if the volume covers too much of
+   * the ellipsoid to ever be below its horizon.
+   */
+  static std::optional<HorizonCullingPoint> computeHorizonCullingPoint(
+      const S2CellBoundingVolume& s2Cell,
+      const Ellipsoid& ellipsoid = Ellipsoid::WGS84);
+
+private:
+  static bool isScaledSpacePointVisible(
+      const glm::dvec3& occludeeScaledSpacePosition,
+      const glm::dvec3& cameraScaledSpacePosition,
+      double distanceToLimbInScaledSpaceSquared) noexcept;
+
+  Ellipsoid _ellipsoid;
+  glm::dvec3 _cameraPosition;
+  glm::dvec3 _cameraPositionInScaledSpace;
+  double _distanceToLimbInScaledSpaceSquared;
+};
+
+} // namespace CesiumGeospatial
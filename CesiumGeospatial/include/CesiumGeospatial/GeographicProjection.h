@@ -8,6 +8,7 @@
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 namespace CesiumGeospatial {
 
@@ -82,6 +83,21 @@ public:
    */
   glm::dvec3 project(const Cartographic& cartographic) const noexcept;
 
+  /**
+   * @brief Converts many geodetic ellipsoid coordinates to geographic
+   * coordinates.
+   *
+   * This gives the same results as calling {@link project} for each position,
+   * without the per-call overhead.
+   *
+   * @param cartographics The geodetic coordinates in radians.
+   * @param results Receives the equivalent geographic X, Y, Z coordinates, in
+   * meters. Must be at least as large as `cartographics`.
+   */
+  void project(
+      gsl::span<const Cartographic> cartographics,
+      gsl::span<glm::dvec3> results) const noexcept;
+
   /**
    * @brief Projects a globe rectangle to geographic coordinates.
    *
@@ -119,6 +135,22 @@ public:
    */
   Cartographic unproject(const glm::dvec3& projectedCoordinates) const noexcept;
 
+  /**
+   * @brief Converts many geographic coordinates to geodetic ellipsoid
+   * coordinates.
+   *
+   * This gives the same results as calling {@link unproject} for each
+   * position, without the per-call overhead.
+   *
+   * @param projectedCoordinates The geographic projected coordinates to
+   * unproject, with height (z) in meters.
+   * @param results Receives the equivalent cartographic coordinates. Must be at
+   * least as large as `projectedCoordinates`.
+   */
+  void unproject(
+      gsl::span<const glm::dvec3> projectedCoordinates,
+      gsl::span<Cartographic> results) const noexcept;
+
   /**
    * @brief Unprojects a geographic rectangle to the globe.
    *
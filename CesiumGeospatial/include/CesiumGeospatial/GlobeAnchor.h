@@ -5,6 +5,7 @@
 #include <CesiumGeospatial/Ellipsoid.h>
 
 #include <glm/mat4x4.hpp>
+#include <gsl/span>
 
 #include <optional>
 
@@ -128,6 +129,70 @@ public:
       bool adjustOrientation = true,
       const Ellipsoid& ellipsoid = Ellipsoid::WGS84);
 
+  /**
+   * @brief Gets the transformation from the anchor coordinate system of many
+   * anchors to the same local-horizontal coordinate system at once.
+   *
+   * The results are the same as calling {@link getAnchorToLocalTransform} for
+   * each anchor.
+   *
+   * @param localCoordinateSystem The local coordinate system that is the target
+   * of the transformations.
+   * @param anchors The anchors.
+   * @param results Receives the transformation of each anchor. Must be at least
+   * as large as `anchors`.
+   */
+  static void getAnchorToLocalTransforms(
+      const LocalHorizontalCoordinateSystem& localCoordinateSystem,
+      gsl::span<const GlobeAnchor> anchors,
+      gsl::span<glm::dmat4> results) noexcept;
+
+  /**
+   * @brief Sets the globe-fixed transformations of many anchors at once.
+   *
+   * The result is the same as calling {@link setAnchorToFixedTransform} for
+   * each anchor, but the surface normals that adjust the orientations are
+   * computed together, with loops that the compiler can vectorize.
+   *
+   * @param anchors The anchors to update.
+   * @param newAnchorToFixed The new transformation of each anchor. Must be at
+   * least as large as `anchors`.
+   * @param adjustOrientation Whether to adjust the orientation of the anchors
+   * based on globe curvature as they move, see
+   * {@link setAnchorToFixedTransform}.
+   * @param ellipsoid The ellipsoid on which the anchors are located.
+   */
+  static void setAnchorToFixedTransforms(
+      gsl::span<GlobeAnchor> anchors,
+      gsl::span<const glm::dmat4> newAnchorToFixed,
+      bool adjustOrientation = true,
+      const Ellipsoid& ellipsoid = Ellipsoid::WGS84);
+
+  /**
+   * @brief Sets the globe-fixed transformations of many anchors at once, based
+   * on new transformations to the same local-horizontal coordinate system.
+   *
+   * The result is the same as calling {@link setAnchorToLocalTransform} for
+   * each anchor. Anchors that are placed in the same local coordinate system
+   * share it, so it is set up only once rather than once per anchor.
+   *
+   * @param localCoordinateSystem The local coordinate system that is the source
+   * of the transformations.
+   * @param anchors The anchors to update.
+   * @param newAnchorToLocal The new transformation of each anchor to the local
+   * coordinate system. Must be at least as large as `anchors`.
+   * @param adjustOrientation Whether to adjust the orientation of the anchors
+   * based on globe curvature as they move, see
+   * {@link setAnchorToLocalTransform}.
+   * @param ellipsoid The ellipsoid on which the anchors are located.
+   */
+  static void setAnchorToLocalTransforms(
+      const LocalHorizontalCoordinateSystem& localCoordinateSystem,
+      gsl::span<GlobeAnchor> anchors,
+      gsl::span<const glm::dmat4> newAnchorToLocal,
+      bool adjustOrientation = true,
+      const Ellipsoid& ellipsoid = Ellipsoid::WGS84);
+
 private:
   glm::dmat4 _anchorToFixed;
 };
@@ -7,6 +7,7 @@
 #include "WebMercatorProjection.h"
 
 #include <glm/vec2.hpp>
+#include <gsl/span>
 
 #include <variant>
 
@@ -34,6 +35,24 @@ typedef std::variant<GeographicProjection, WebMercatorProjection> Projection;
 glm::dvec3
 projectPosition(const Projection& projection, const Cartographic& position);
 
+/**
+ * @brief Projects many positions on the globe using the given
+ * {@link Projection}.
+ *
+ * This is the same as calling {@link projectPosition} for each position, but
+ * the type of the projection is only determined once.
+ *
+ * @param projection The projection.
+ * @param positions The {@link Cartographic} positions.
+ * @param results Receives the coordinates of each projected point, in the
+ * coordinate system of the given projection. Must be at least as large as
+ * `positions`.
+ */
+void projectPositions(
+    const Projection& projection,
+    gsl::span<const Cartographic> positions,
+    gsl::span<glm::dvec3> results);
+
 /**
  * @brief Unprojects a position from the globe using the given
  * {@link Projection}.
@@ -45,6 +64,23 @@ projectPosition(const Projection& projection, const Cartographic& position);
 Cartographic
 unprojectPosition(const Projection& projection, const glm::dvec3& position);
 
+/**
+ * @brief Unprojects many positions from the globe using the given
+ * {@link Projection}.
+ *
+ * This is the same as calling {@link unprojectPosition} for each position, but
+ * the type of the projection is only determined once.
+ *
+ * @param projection The projection.
+ * @param positions The coordinates of the points, in meters.
+ * @param results Receives the {@link Cartographic} position of each point.
+ * Must be at least as large as `positions`.
+ */
+void unprojectPositions(
+    const Projection& projection,
+    gsl::span<const glm::dvec3> positions,
+    gsl::span<Cartographic> results);
+
 /**
  * @brief Projects a rectangle on the globe by simply projecting its four
  * corners.
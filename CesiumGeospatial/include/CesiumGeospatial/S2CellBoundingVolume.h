@@ -5,8 +5,10 @@
 #include "S2CellID.h"
 
 #include <CesiumGeometry/CullingResult.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
 #include <CesiumGeometry/Plane.h>
 
+#include <glm/mat3x3.hpp>
 #include <glm/vec3.hpp>
 #include <gsl/span>
 
@@ -65,6 +67,9 @@ public:
   /**
    * @brief Determines on which side of a plane the bounding volume is located.
    *
+   * The plane is tested against a box that encloses the volume first, so the
+   * corners of the volume are only tested when the plane cuts through the box.
+   *
    * @param plane The plane to test against.
    * @return The {@link CesiumGeometry::CullingResult}
    *  * `Inside` if the entire region is on the side of the plane the normal is
@@ -102,6 +107,19 @@ public:
    */
   BoundingRegion computeBoundingRegion() const noexcept;
 
+  /**
+   * @brief Computes an oriented bounding box that tightly encloses this S2
+   * cell volume.
+   *
+   * The box is aligned with the top plane and the sides of the cell, so it
+   * fits much more tightly than the box of {@link computeBoundingRegion}, and
+   * is cheaper to compute.
+   *
+   * @return The oriented bounding box.
+   */
+  CesiumGeometry::OrientedBoundingBox
+  computeOrientedBoundingBox() const noexcept;
+
 private:
   S2CellID _cellID;
   double _minimumHeight;
@@ -109,6 +127,10 @@ private:
   glm::dvec3 _center;
   std::array<CesiumGeometry::Plane, 6> _boundingPlanes;
   std::array<glm::dvec3, 8> _vertices;
+  // The center and half axes of a box that encloses the vertices, which rule
+  // out most planes without testing each vertex.
+  glm::dvec3 _boxCenter;
+  glm::dmat3 _boxHalfAxes;
 };
 
 } // namespace CesiumGeospatial
@@ -6,6 +6,7 @@
 
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
+#include <gsl/span>
 
 namespace CesiumGeospatial {
 
@@ -85,6 +86,21 @@ public:
    */
   glm::dvec3 project(const Cartographic& cartographic) const noexcept;
 
+  /**
+   * @brief Converts many geodetic ellipsoid coordinates to Web Mercator
+   * coordinates.
+   *
+   * This gives the same results as calling {@link project} for each position,
+   * without the per-call overhead.
+   *
+   * @param cartographics The geodetic coordinates in radians.
+   * @param results Receives the equivalent Web Mercator X, Y, Z coordinates, in
+   * meters. Must be at least as large as `cartographics`.
+   */
+  void project(
+      gsl::span<const Cartographic> cartographics,
+      gsl::span<glm::dvec3> results) const noexcept;
+
   /**
    * @brief Projects a globe rectangle to Web Mercator coordinates.
    *
@@ -122,6 +138,22 @@ public:
    */
   Cartographic unproject(const glm::dvec3& projectedCoordinates) const noexcept;
 
+  /**
+   * @brief Converts many Web Mercator coordinates to geodetic ellipsoid
+   * coordinates.
+   *
+   * This gives the same results as calling {@link unproject} for each
+   * position, without the per-call overhead.
+   *
+   * @param projectedCoordinates The Web Mercator projected coordinates to
+   * unproject, with height (z) in meters.
+   * @param results Receives the equivalent cartographic coordinates. Must be at
+   * least as large as `projectedCoordinates`.
+   */
+  void unproject(
+      gsl::span<const glm::dvec3> projectedCoordinates,
+      gsl::span<Cartographic> results) const noexcept;
+
   /**
    * @brief Unprojects a Web Mercator rectangle to the globe.
    *
@@ -137,6 +169,10 @@ public:
    * @brief Converts a Mercator angle, in the range -PI to PI, to a geodetic
    * latitude in the range -PI/2 to PI/2.
    *
+   * This is computed as `PI/2 - 2 * atan(exp(-mercatorAngle))` in double
+   * precision, which is within 1e-15 radians of the exact latitude over the
+   * whole range, or a few nanometers on the surface of the WGS84 ellipsoid.
+   *
    * @param mercatorAngle The angle to convert.
    * @returns The geodetic latitude in radians.
    */
@@ -146,6 +182,13 @@ public:
    * @brief Converts a geodetic latitude in radians, in the range -PI/2 to PI/2,
    * to a Mercator angle in the range -PI to PI.
    *
+   * The latitude is first clamped to {@link MAXIMUM_LATITUDE}. The angle is
+   * computed as `0.5 * log((1 + sin(latitude)) / (1 - sin(latitude)))` in
+   * double precision, which is within 1e-14 of the exact angle up to that
+   * latitude. The error is largest near the poles, where `1 - sin(latitude)`
+   * loses digits, and is still well under a micrometer once multiplied by the
+   * WGS84 semimajor axis.
+   *
    * @param latitude The geodetic latitude in radians.
    * @returns The Mercator angle.
    */
@@ -5,7 +5,10 @@
 #include <glm/mat2x2.hpp>
 #include <mapbox/earcut.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cmath>
 
 using namespace CesiumGeometry;
 
@@ -106,15 +109,159 @@ computeBoundingRectangle(const std::vector<glm::dvec2>& polygon) {
   return CesiumGeospatial::GlobeRectangle(west, south, east, north);
 }
 
+// Gets a longitude relative to the first vertex of a polygon, within -PI to PI
+// like the longitudes that the polygon is triangulated with.
+static double toLocalLongitude(double longitude, double origin) noexcept {
+  double result = longitude - origin;
+  if (glm::abs(result) > CesiumUtility::Math::OnePi) {
+    if (result > 0.0) {
+      result -= CesiumUtility::Math::TwoPi;
+    } else {
+      result += CesiumUtility::Math::TwoPi;
+    }
+  }
+  return result;
+}
+
 CartographicPolygon::CartographicPolygon(const std::vector<glm::dvec2>& polygon)
     : _vertices(polygon),
       _indices(triangulatePolygon(polygon)),
-      _boundingRectangle(computeBoundingRectangle(polygon)) {}
+      _boundingRectangle(computeBoundingRectangle(polygon)),
+      _edgeIndex() {
+  const size_t vertexCount = polygon.size();
+  if (vertexCount < 3) {
+    return;
+  }
 
-/*static*/ bool CartographicPolygon::rectangleIsWithinPolygons(
-    const CesiumGeospatial::GlobeRectangle& rectangle,
-    const std::vector<CartographicPolygon>& cartographicPolygons) noexcept {
+  std::vector<glm::dvec2> local(vertexCount);
+  for (size_t i = 0; i < vertexCount; ++i) {
+    local[i] = glm::dvec2(
+        i == 0 ? 0.0 : toLocalLongitude(polygon[i].x, polygon[0].x),
+        polygon[i].y);
+  }
+
+  EdgeIndex& index = this->_edgeIndex;
+  index.south = local[0].y;
+  index.north = local[0].y;
+  for (const glm::dvec2& point : local) {
+    index.south = std::min(index.south, point.y);
+    index.north = std::max(index.north, point.y);
+  }
 
+  // About as many bands as there are edges in each band, for polygons whose
+  // edges are spread evenly over their latitudes.
+  const size_t bandCount = std::clamp(
+      size_t(std::sqrt(double(vertexCount))),
+      size_t(1),
+      size_t(1024));
+  const double height = index.north - index.south;
+  index.bandsPerRadian = height > 0.0 ? double(bandCount) / height : 0.0;
+
+  auto getBand = [&index, bandCount](double y) {
+    const double band = (y - index.south) * index.bandsPerRadian;
+    return std::min(size_t(std::max(band, 0.0)), bandCount - 1);
+  };
+
+  // Count the edges of each band, then place them.
+  std::vector<uint32_t> counts(bandCount + 1, 0);
+  for (size_t i = 0; i < vertexCount; ++i) {
+    const glm::dvec2& a = local[i];
+    const glm::dvec2& b = local[(i + 1) % vertexCount];
+    if (a.y == b.y) {
+      continue;
+    }
+    const size_t last = getBand(std::max(a.y, b.y));
+    for (size_t band = getBand(std::min(a.y, b.y)); band <= last; ++band) {
+      ++counts[band + 1];
+    }
+  }
+  for (size_t band = 0; band < bandCount; ++band) {
+    counts[band + 1] += counts[band];
+  }
+
+  index.bandStarts = counts;
+  const size_t edgeCount = counts[bandCount];
+  index.startX.resize(edgeCount);
+  index.startY.resize(edgeCount);
+  index.endY.resize(edgeCount);
+  index.slope.resize(edgeCount);
+
+  for (size_t i = 0; i < vertexCount; ++i) {
+    const glm::dvec2& a = local[i];
+    const glm::dvec2& b = local[(i + 1) % vertexCount];
+    if (a.y == b.y) {
+      continue;
+    }
+    const double slope = (b.x - a.x) / (b.y - a.y);
+    const size_t last = getBand(std::max(a.y, b.y));
+    for (size_t band = getBand(std::min(a.y, b.y)); band <= last; ++band) {
+      const size_t edge = counts[band]++;
+      index.startX[edge] = a.x;
+      index.startY[edge] = a.y;
+      index.endY[edge] = b.y;
+      index.slope[edge] = slope;
+    }
+  }
+}
+
+bool CartographicPolygon::containsLocal(double x, double y) const noexcept {
+  const EdgeIndex& index = this->_edgeIndex;
+  if (index.bandStarts.empty() || !(y >= index.south && y <= index.north)) {
+    return false;
+  }
+
+  const size_t bandCount = index.bandStarts.size() - 1;
+  const size_t band = std::min(
+      size_t((y - index.south) * index.bandsPerRadian),
+      bandCount - 1);
+  const size_t first = index.bandStarts[band];
+  const size_t last = index.bandStarts[band + 1];
+
+  const double* pStartX = index.startX.data();
+  const double* pStartY = index.startY.data();
+  const double* pEndY = index.endY.data();
+  const double* pSlope = index.slope.data();
+
+  // Counts the edges that a ray from the point towards the east crosses, with
+  // a branch-free loop so the edges are tested several at a time.
+  uint32_t crossings = 0;
+  for (size_t i = first; i < last; ++i) {
+    const bool spansLatitude = (pStartY[i] > y) != (pEndY[i] > y);
+    const double crossingX = pStartX[i] + (y - pStartY[i]) * pSlope[i];
+    crossings ^= uint32_t(spansLatitude & (x < crossingX));
+  }
+
+  return crossings != 0;
+}
+
+bool CartographicPolygon::contains(const glm::dvec2& point) const noexcept {
+  if (this->_vertices.empty()) {
+    return false;
+  }
+  return this->containsLocal(
+      toLocalLongitude(point.x, this->_vertices[0].x),
+      point.y);
+}
+
+void CartographicPolygon::contains(
+    gsl::span<const glm::dvec2> points,
+    gsl::span<bool> results) const noexcept {
+  assert(results.size() >= points.size());
+
+  if (this->_vertices.empty()) {
+    std::fill(results.begin(), results.begin() + points.size(), false);
+    return;
+  }
+
+  const double origin = this->_vertices[0].x;
+  for (size_t i = 0; i < points.size(); ++i) {
+    results[i] =
+        this->containsLocal(toLocalLongitude(points[i].x, origin), points[i].y);
+  }
+}
+
+bool CartographicPolygon::containsRectangle(
+    const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept {
   glm::dvec2 rectangleCorners[] = {
       glm::dvec2(rectangle.getWest(), rectangle.getSouth()),
       glm::dvec2(rectangle.getWest(), rectangle.getNorth()),
@@ -127,79 +274,67 @@ CartographicPolygon::CartographicPolygon(const std::vector<glm::dvec2>& polygon)
       rectangleCorners[3] - rectangleCorners[2],
       rectangleCorners[0] - rectangleCorners[3]};
 
-  // Iterate through all polygons.
-  for (size_t i = 0; i < cartographicPolygons.size(); ++i) {
-    const CartographicPolygon& selection = cartographicPolygons[i];
-
-    const std::optional<CesiumGeospatial::GlobeRectangle>&
-        polygonBoundingRectangle = selection.getBoundingRectangle();
-    if (!polygonBoundingRectangle ||
-        !rectangle.computeIntersection(*polygonBoundingRectangle)) {
-      continue;
-    }
-
-    const std::vector<glm::dvec2>& vertices = selection.getVertices();
-    const std::vector<uint32_t>& indices = selection.getIndices();
-
-    // First check if an arbitrary point on the bounding globe rectangle is
-    // inside the polygon.
-    bool inside = false;
-    for (size_t j = 2; j < indices.size(); j += 3) {
-      if (IntersectionTests::pointInTriangle(
-              rectangleCorners[0],
-              vertices[indices[j - 2]],
-              vertices[indices[j - 1]],
-              vertices[indices[j]])) {
-        inside = true;
-        break;
-      }
-    }
+  const std::optional<CesiumGeospatial::GlobeRectangle>&
+      polygonBoundingRectangle = this->getBoundingRectangle();
+  if (!polygonBoundingRectangle ||
+      !rectangle.computeIntersection(*polygonBoundingRectangle)) {
+    return false;
+  }
 
-    // If the arbitrary point was outside, then this polygon does not entirely
-    // cull the tile.
-    if (!inside) {
-      continue;
-    }
+  const std::vector<glm::dvec2>& vertices = this->getVertices();
 
-    // Check if the polygon perimeter intersects the bounding globe rectangle
-    // edges.
-    bool intersectionFound = false;
-    for (size_t j = 0; j < vertices.size(); ++j) {
-      const glm::dvec2& a = vertices[j];
-      const glm::dvec2& b = vertices[(j + 1) % vertices.size()];
+  // First check if an arbitrary point on the bounding globe rectangle is
+  // inside the polygon. If it's outside, then this polygon does not entirely
+  // cull the tile.
+  if (!this->contains(rectangleCorners[0])) {
+    return false;
+  }
 
-      const glm::dvec2 ba = a - b;
+  // Check if the polygon perimeter intersects the bounding globe rectangle
+  // edges.
+  bool intersectionFound = false;
+  for (size_t j = 0; j < vertices.size(); ++j) {
+    const glm::dvec2& a = vertices[j];
+    const glm::dvec2& b = vertices[(j + 1) % vertices.size()];
 
-      // Check each rectangle edge.
-      for (size_t k = 0; k < 4; ++k) {
-        const glm::dvec2& cd = rectangleEdges[k];
-        const glm::dmat2 lineSegmentMatrix(cd, ba);
-        const glm::dvec2 ca = a - rectangleCorners[k];
+    const glm::dvec2 ba = a - b;
 
-        // s and t are calculated such that:
-        // line_intersection = a + t * ab = c + s * cd
-        const glm::dvec2 st = glm::inverse(lineSegmentMatrix) * ca;
+    // Check each rectangle edge.
+    for (size_t k = 0; k < 4; ++k) {
+      const glm::dvec2& cd = rectangleEdges[k];
+      const glm::dmat2 lineSegmentMatrix(cd, ba);
+      const glm::dvec2 ca = a - rectangleCorners[k];
 
-        // check that the intersection is within the line segments
-        if (st.x <= 1.0 && st.x >= 0.0 && st.y <= 1.0 && st.y >= 0.0) {
-          intersectionFound = true;
-          break;
-        }
-      }
+      // s and t are calculated such that:
+      // line_intersection = a + t * ab = c + s * cd
+      const glm::dvec2 st = glm::inverse(lineSegmentMatrix) * ca;
 
-      if (intersectionFound) {
+      // check that the intersection is within the line segments
+      if (st.x <= 1.0 && st.x >= 0.0 && st.y <= 1.0 && st.y >= 0.0) {
+        intersectionFound = true;
         break;
       }
     }
 
-    // There is no intersection with the perimeter and at least one point is
-    // inside the polygon so the tile is completely inside this polygon.
-    if (!intersectionFound) {
-      return true;
+    if (intersectionFound) {
+      break;
     }
   }
 
-  return false;
+  // If there is no intersection with the perimeter and at least one point is
+  // inside the polygon, the tile is completely inside this polygon.
+  return !intersectionFound;
+}
+
+/*static*/ bool CartographicPolygon::rectangleIsWithinPolygons(
+    const CesiumGeospatial::GlobeRectangle& rectangle,
+    const std::vector<CartographicPolygon>& cartographicPolygons) noexcept {
+  return std::any_of(
+      cartographicPolygons.begin(),
+      cartographicPolygons.end(),
+      [&rectangle](const CartographicPolygon& polygon) {
+        return polygon.containsRectangle(rectangle);
+      });
 }
 
 /*static*/ bool CartographicPolygon::rectangleIsOutsidePolygons(
@@ -231,7 +366,6 @@ CartographicPolygon::CartographicPolygon(const std::vector<glm::dvec2>& polygon)
     }
 
     const std::vector<glm::dvec2>& vertices = selection.getVertices();
-    const std::vector<uint32_t>& indices = selection.getIndices();
 
     // Check if an arbitrary point on the polygon is in the globe rectangle.
     if (IntersectionTests::pointInTriangle(
@@ -249,14 +383,8 @@ CartographicPolygon::CartographicPolygon(const std::vector<glm::dvec2>& polygon)
 
     // Check if an arbitrary point on the bounding globe rectangle is
     // inside the polygon.
-    for (size_t j = 2; j < indices.size(); j += 3) {
-      if (IntersectionTests::pointInTriangle(
-              rectangleCorners[0],
-              vertices[indices[j - 2]],
-              vertices[indices[j - 1]],
-              vertices[indices[j]])) {
-        return false;
-      }
+    if (selection.contains(rectangleCorners[0])) {
+      return false;
     }
 
     // Now we know the rectangle does not fully contain the polygon and the
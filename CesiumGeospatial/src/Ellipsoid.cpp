@@ -5,6 +5,10 @@
 #include <glm/geometric.hpp>
 #include <glm/trigonometric.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+
 using namespace CesiumUtility;
 
 namespace CesiumGeospatial {
@@ -16,6 +20,17 @@ Ellipsoid::geodeticSurfaceNormal(const glm::dvec3& position) const noexcept {
   return glm::normalize(position * this->_oneOverRadiiSquared);
 }
 
+void Ellipsoid::geodeticSurfaceNormal(
+    gsl::span<const glm::dvec3> positions,
+    gsl::span<glm::dvec3> results) const noexcept {
+  assert(results.size() >= positions.size());
+
+  const glm::dvec3 oneOverRadiiSquared = this->_oneOverRadiiSquared;
+  for (size_t i = 0; i < positions.size(); ++i) {
+    results[i] = glm::normalize(positions[i] * oneOverRadiiSquared);
+  }
+}
+
 glm::dvec3 Ellipsoid::geodeticSurfaceNormal(
     const Cartographic& cartographic) const noexcept {
   const double longitude = cartographic.longitude;
@@ -38,6 +53,27 @@ glm::dvec3 Ellipsoid::cartographicToCartesian(
   return k + n;
 }
 
+void Ellipsoid::cartographicToCartesian(
+    gsl::span<const Cartographic> cartographics,
+    gsl::span<glm::dvec3> results) const noexcept {
+  assert(results.size() >= cartographics.size());
+
+  const glm::dvec3 radiiSquared = this->_radiiSquared;
+  for (size_t i = 0; i < cartographics.size(); ++i) {
+    const Cartographic& cartographic = cartographics[i];
+    const double cosLatitude = glm::cos(cartographic.latitude);
+    glm::dvec3 n = glm::normalize(glm::dvec3(
+        cosLatitude * glm::cos(cartographic.longitude),
+        cosLatitude * glm::sin(cartographic.longitude),
+        glm::sin(cartographic.latitude)));
+    glm::dvec3 k = radiiSquared * n;
+    const double gamma = sqrt(glm::dot(n, k));
+    k /= gamma;
+    n *= cartographic.height;
+    results[i] = k + n;
+  }
+}
+
 std::optional<Cartographic>
 Ellipsoid::cartesianToCartographic(const glm::dvec3& cartesian) const noexcept {
   std::optional<glm::dvec3> p = this->scaleToGeodeticSurface(cartesian);
@@ -56,6 +92,169 @@ Ellipsoid::cartesianToCartographic(const glm::dvec3& cartesian) const noexcept {
   return Cartographic(longitude, latitude, height);
 }
 
+void Ellipsoid::cartesianToCartographic(
+    gsl::span<const glm::dvec3> cartesians,
+    gsl::span<std::optional<Cartographic>> results) const noexcept {
+  assert(results.size() >= cartesians.size());
+
+  // This is scaleToGeodeticSurface and cartesianToCartographic for a block of
+  // positions at a time. The Newton iterations run over the whole block until
+  // every position has converged, without branches, so that each step
+  // vectorizes. A position that has converged keeps the same lambda, so the
+  // results are the same as for one position at a time.
+  constexpr size_t blockSize = 64;
+  std::array<double, blockSize> x2;
+  std::array<double, blockSize> y2;
+  std::array<double, blockSize> z2;
+  std::array<double, blockSize> lambda;
+  std::array<bool, blockSize> nearCenter;
+
+  const glm::dvec3 oneOverRadii = this->_oneOverRadii;
+  const glm::dvec3 oneOverRadiiSquared = this->_oneOverRadiiSquared;
+
+  for (size_t blockBegin = 0; blockBegin < cartesians.size();
+       blockBegin += blockSize) {
+    const size_t count = std::min(blockSize, cartesians.size() - blockBegin);
+    const glm::dvec3* pCartesians = cartesians.data() + blockBegin;
+
+    for (size_t i = 0; i < count; ++i) {
+      const glm::dvec3& cartesian = pCartesians[i];
+      x2[i] = cartesian.x * cartesian.x * oneOverRadii.x * oneOverRadii.x;
+      y2[i] = cartesian.y * cartesian.y * oneOverRadii.y * oneOverRadii.y;
+      z2[i] = cartesian.z * cartesian.z * oneOverRadii.z * oneOverRadii.z;
+
+      const double squaredNorm = x2[i] + y2[i] + z2[i];
+      const double ratio = sqrt(1.0 / squaredNorm);
+      nearCenter[i] = squaredNorm < this->_centerToleranceSquared;
+
+      const glm::dvec3 intersection = cartesian * ratio;
+      const glm::dvec3 gradient = intersection * oneOverRadiiSquared * 2.0;
+      lambda[i] = ((1.0 - ratio) * glm::length(cartesian)) /
+                  (0.5 * glm::length(gradient));
+    }
+
+    bool anyActive = true;
+    while (anyActive) {
+      anyActive = false;
+      for (size_t i = 0; i < count; ++i) {
+        const double xMultiplier =
+            1.0 / (1.0 + lambda[i] * oneOverRadiiSquared.x);
+        const double yMultiplier =
+            1.0 / (1.0 + lambda[i] * oneOverRadiiSquared.y);
+        const double zMultiplier =
+            1.0 / (1.0 + lambda[i] * oneOverRadiiSquared.z);
+
+        const double xMultiplier2 = xMultiplier * xMultiplier;
+        const double yMultiplier2 = yMultiplier * yMultiplier;
+        const double zMultiplier2 = zMultiplier * zMultiplier;
+
+        const double xMultiplier3 = xMultiplier2 * xMultiplier;
+        const double yMultiplier3 = yMultiplier2 * yMultiplier;
+        const double zMultiplier3 = zMultiplier2 * zMultiplier;
+
+        const double func = x2[i] * xMultiplier2 + y2[i] * yMultiplier2 +
+                            z2[i] * zMultiplier2 - 1.0;
+        const double denominator =
+            x2[i] * xMultiplier3 * oneOverRadiiSquared.x +
+            y2[i] * yMultiplier3 * oneOverRadiiSquared.y +
+            z2[i] * zMultiplier3 * oneOverRadiiSquared.z;
+
+        const bool active =
+            !nearCenter[i] && glm::abs(func) > Math::Epsilon12;
+        lambda[i] -= active ? func / (-2.0 * denominator) : 0.0;
+        anyActive |= active;
+      }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      const glm::dvec3& cartesian = pCartesians[i];
+      std::optional<Cartographic>& result = results[blockBegin + i];
+
+      glm::dvec3 p;
+      if (nearCenter[i]) {
+        const double ratio = sqrt(1.0 / (x2[i] + y2[i] + z2[i]));
+        if (!std::isfinite(ratio)) {
+          result = std::nullopt;
+          continue;
+        }
+        p = cartesian * ratio;
+      } else {
+        p = cartesian *
+            (1.0 / (glm::dvec3(1.0) + lambda[i] * oneOverRadiiSquared));
+      }
+
+      const glm::dvec3 n = this->geodeticSurfaceNormal(p);
+      const glm::dvec3 h = cartesian - p;
+
+      result = Cartographic(
+          glm::atan(n.y, n.x),
+          glm::asin(n.z),
+          Math::sign(glm::dot(h, cartesian)) * glm::length(h));
+    }
+  }
+}
+
+void Ellipsoid::cartesianToCartographicApproximate(
+    gsl::span<const glm::dvec3> cartesians,
+    gsl::span<std::optional<Cartographic>> results) const noexcept {
+  assert(results.size() >= cartesians.size());
+
+  if (this->_radii.x != this->_radii.y) {
+    this->cartesianToCartographic(cartesians, results);
+    return;
+  }
+
+  // Bowring's method: the parametric latitude of the position on a confocal
+  // ellipsoid is a close enough guess that one step of the iteration gives the
+  // geodetic latitude. See "Transformation from spatial to geographical
+  // coordinates", B. R. Bowring, Survey Review, 1976.
+  const double a = this->_radii.x;
+  const double b = this->_radii.z;
+  const double eSquared = 1.0 - (b * b) / (a * a);
+  const double ePrimeSquared = (a * a) / (b * b) - 1.0;
+  const glm::dvec3 oneOverRadiiSquared = this->_oneOverRadiiSquared;
+
+  for (size_t i = 0; i < cartesians.size(); ++i) {
+    const glm::dvec3& cartesian = cartesians[i];
+
+    const double squaredNorm =
+        glm::dot(cartesian * cartesian, oneOverRadiiSquared);
+    if (squaredNorm < this->_centerToleranceSquared) {
+      // The guess is poor near the center, so use the exact conversion.
+      results[i] = this->cartesianToCartographic(cartesian);
+      continue;
+    }
+
+    const double p =
+        sqrt(cartesian.x * cartesian.x + cartesian.y * cartesian.y);
+    const double za = cartesian.z * a;
+    const double pb = p * b;
+    const double oneOverR = 1.0 / sqrt(za * za + pb * pb);
+    const double sinTheta = za * oneOverR;
+    const double cosTheta = pb * oneOverR;
+
+    const double numerator =
+        cartesian.z + ePrimeSquared * b * sinTheta * sinTheta * sinTheta;
+    const double denominator =
+        p - eSquared * a * cosTheta * cosTheta * cosTheta;
+    const double oneOverHypotenuse =
+        1.0 / sqrt(numerator * numerator + denominator * denominator);
+    const double sinLatitude = numerator * oneOverHypotenuse;
+    const double cosLatitude = denominator * oneOverHypotenuse;
+
+    // The height along the normal, which is stable near the poles as well as
+    // near the equator.
+    const double height =
+        p * cosLatitude + cartesian.z * sinLatitude -
+        a * sqrt(1.0 - eSquared * sinLatitude * sinLatitude);
+
+    results[i] = Cartographic(
+        glm::atan(cartesian.y, cartesian.x),
+        glm::atan(numerator, denominator),
+        height);
+  }
+}
+
 std::optional<glm::dvec3>
 Ellipsoid::scaleToGeodeticSurface(const glm::dvec3& cartesian) const noexcept {
   const double positionX = cartesian.x;
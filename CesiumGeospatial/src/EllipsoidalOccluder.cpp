@@ -0,0 +1,190 @@
+#include "CesiumGeospatial/EllipsoidalOccluder.h"
+
+#include "CesiumGeospatial/Cartographic.h"
+#include "CesiumGeospatial/GlobeRectangle.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace CesiumUtility;
+
+namespace CesiumGeospatial {
+
+EllipsoidalOccluder::EllipsoidalOccluder(
+    const Ellipsoid& ellipsoid,
+    const glm::dvec3& cameraPosition) noexcept
+    : _ellipsoid(ellipsoid),
+      _cameraPosition(cameraPosition),
+      _cameraPositionInScaledSpace(cameraPosition / ellipsoid.getRadii()),
+      _distanceToLimbInScaledSpaceSquared(
+          glm::dot(
+              this->_cameraPositionInScaledSpace,
+              this->_cameraPositionInScaledSpace) -
+          1.0) {}
+
+bool EllipsoidalOccluder::isPointVisible(
+    const glm::dvec3& occludee) const noexcept {
+  return isScaledSpacePointVisible(
+      occludee / this->_ellipsoid.getRadii(),
+      this->_cameraPositionInScaledSpace,
+      this->_distanceToLimbInScaledSpaceSquared);
+}
+
+bool EllipsoidalOccluder::isHorizonCullingPointVisible(
+    const HorizonCullingPoint& point) const noexcept {
+  if (point.minimumHeight >= 0.0) {
+    return isScaledSpacePointVisible(
+        point.scaledSpacePosition,
+        this->_cameraPositionInScaledSpace,
+        this->_distanceToLimbInScaledSpaceSquared);
+  }
+
+  // The point is relative to the ellipsoid shrunk to the volume's minimum
+  // height, so the camera must be too.
+  const glm::dvec3 cameraPositionInScaledSpace =
+      this->_cameraPosition /
+      (this->_ellipsoid.getRadii() + point.minimumHeight);
+  return isScaledSpacePointVisible(
+      point.scaledSpacePosition,
+      cameraPositionInScaledSpace,
+      glm::dot(cameraPositionInScaledSpace, cameraPositionInScaledSpace) -
+          1.0);
+}
+
+/*static*/ std::optional<HorizonCullingPoint>
+EllipsoidalOccluder::computeHorizonCullingPoint(
+    const Ellipsoid& ellipsoid,
+    const glm::dvec3& directionToPoint,
+    gsl::span<const glm::dvec3> positions,
+    double minimumHeight) {
+  minimumHeight = std::min(minimumHeight, 0.0);
+  if (positions.empty() || -minimumHeight >= ellipsoid.getMinimumRadius()) {
+    return std::nullopt;
+  }
+
+  const glm::dvec3 radii = ellipsoid.getRadii() + minimumHeight;
+  const glm::dvec3 scaledSpaceDirectionToPoint = directionToPoint / radii;
+  const double directionLength = glm::length(scaledSpaceDirectionToPoint);
+  if (directionLength == 0.0) {
+    return std::nullopt;
+  }
+  const glm::dvec3 direction = scaledSpaceDirectionToPoint / directionLength;
+
+  // Find how far along the direction the point must be to be above the
+  // horizon whenever any of the positions is.
+  double resultMagnitude = 0.0;
+  for (const glm::dvec3& position : positions) {
+    const glm::dvec3 scaledSpacePosition = position / radii;
+    double magnitudeSquared =
+        glm::dot(scaledSpacePosition, scaledSpacePosition);
+    double magnitude = std::sqrt(magnitudeSquared);
+    if (magnitude == 0.0) {
+      return std::nullopt;
+    }
+    const glm::dvec3 directionToPosition = scaledSpacePosition / magnitude;
+
+    // Positions below the ellipsoid are treated as if they were on it.
+    magnitudeSquared = std::max(1.0, magnitudeSquared);
+    magnitude = std::max(1.0, magnitude);
+
+    const double cosAlpha = glm::dot(directionToPosition, direction);
+    const double sinAlpha =
+        glm::length(glm::cross(directionToPosition, direction));
+    const double cosBeta = 1.0 / magnitude;
+    const double sinBeta = std::sqrt(magnitudeSquared - 1.0) * cosBeta;
+
+    // This is the cosine of the angle between the direction and the far edge
+    // of the position's horizon. If that angle is 90 degrees or more, no point
+    // along the direction is below the horizon only when the position is.
+    const double cosAlphaPlusBeta = cosAlpha * cosBeta - sinAlpha * sinBeta;
+    if (cosAlphaPlusBeta <= 0.0) {
+      return std::nullopt;
+    }
+
+    resultMagnitude = std::max(resultMagnitude, 1.0 / cosAlphaPlusBeta);
+  }
+
+  return HorizonCullingPoint{direction * resultMagnitude, minimumHeight};
+}
+
+/*static*/ std::optional<HorizonCullingPoint>
+EllipsoidalOccluder::computeHorizonCullingPoint(
+    const BoundingRegion& region,
+    const Ellipsoid& ellipsoid) {
+  const GlobeRectangle& rectangle = region.getRectangle();
+  if (rectangle.computeWidth() >= Math::OnePi) {
+    return std::nullopt;
+  }
+
+  // Sample the top of the region at its corners, and where it's farthest from
+  // the poles at each quarter of longitude it crosses and at its edges.
+  const double height = region.getMaximumHeight();
+  const double west = rectangle.getWest();
+  const double south = rectangle.getSouth();
+  const double east = rectangle.getEast();
+  const double north = rectangle.getNorth();
+
+  std::vector<glm::dvec3> positions{
+      ellipsoid.cartographicToCartesian(Cartographic(west, north, height)),
+      ellipsoid.cartographicToCartesian(Cartographic(east, north, height)),
+      ellipsoid.cartographicToCartesian(Cartographic(east, south, height)),
+      ellipsoid.cartographicToCartesian(Cartographic(west, south, height))};
+
+  const double latitudeNearestEquator =
+      north < 0.0 ? north : (south > 0.0 ? south : 0.0);
+  for (int i = 1; i < 8; ++i) {
+    const Cartographic sample(
+        -Math::OnePi + i * Math::PiOverTwo,
+        latitudeNearestEquator,
+        height);
+    if (rectangle.contains(sample)) {
+      positions.emplace_back(ellipsoid.cartographicToCartesian(sample));
+    }
+  }
+
+  if (latitudeNearestEquator == 0.0) {
+    positions.emplace_back(
+        ellipsoid.cartographicToCartesian(Cartographic(west, 0.0, height)));
+    positions.emplace_back(
+        ellipsoid.cartographicToCartesian(Cartographic(east, 0.0, height)));
+  }
+
+  return computeHorizonCullingPoint(
+      ellipsoid,
+      region.getBoundingBox().getCenter(),
+      positions,
+      region.getMinimumHeight());
+}
+
+/*static*/ std::optional<HorizonCullingPoint>
+EllipsoidalOccluder::computeHorizonCullingPoint(
+    const S2CellBoundingVolume& s2Cell,
+    const Ellipsoid& ellipsoid) {
+  return computeHorizonCullingPoint(s2Cell.computeBoundingRegion(), ellipsoid);
+}
+
+/*static*/ bool EllipsoidalOccluder::isScaledSpacePointVisible(
+    const glm::dvec3& occludeeScaledSpacePosition,
+    const glm::dvec3& cameraScaledSpacePosition,
+    double distanceToLimbInScaledSpaceSquared) noexcept {
+  // A camera inside the ellipsoid sees what's around it, not the ellipsoid.
+  if (distanceToLimbInScaledSpaceSquared < 0.0) {
+    return true;
+  }
+
+  // The occludee is hidden if it's beyond the plane of the horizon and inside
+  // the cone from the camera that just touches the ellipsoid.
+  const glm::dvec3 vt = occludeeScaledSpacePosition - cameraScaledSpacePosition;
+  const double vtDotVc = -glm::dot(vt, cameraScaledSpacePosition);
+  const bool isOccluded =
+      vtDotVc > distanceToLimbInScaledSpaceSquared &&
+      vtDotVc * vtDotVc / glm::dot(vt, vt) > distanceToLimbInScaledSpaceSquared;
+  return !isOccluded;
+}
+
+} // namespace CesiumGeospatial
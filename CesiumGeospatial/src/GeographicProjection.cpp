@@ -4,6 +4,8 @@
 
 #include <CesiumUtility/Math.h>
 
+#include <cassert>
+
 namespace CesiumGeospatial {
 
 GeographicProjection::GeographicProjection(const Ellipsoid& ellipsoid) noexcept
@@ -20,6 +22,21 @@ GeographicProjection::project(const Cartographic& cartographic) const noexcept {
       cartographic.height);
 }
 
+void GeographicProjection::project(
+    gsl::span<const Cartographic> cartographics,
+    gsl::span<glm::dvec3> results) const noexcept {
+  assert(results.size() >= cartographics.size());
+
+  const double semimajorAxis = this->_semimajorAxis;
+  for (size_t i = 0; i < cartographics.size(); ++i) {
+    const Cartographic& cartographic = cartographics[i];
+    results[i] = glm::dvec3(
+        cartographic.longitude * semimajorAxis,
+        cartographic.latitude * semimajorAxis,
+        cartographic.height);
+  }
+}
+
 CesiumGeometry::Rectangle GeographicProjection::project(
     const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept {
   const glm::dvec3 sw = this->project(rectangle.getSouthwest());
@@ -44,6 +61,21 @@ Cartographic GeographicProjection::unproject(
   return result;
 }
 
+void GeographicProjection::unproject(
+    gsl::span<const glm::dvec3> projectedCoordinates,
+    gsl::span<Cartographic> results) const noexcept {
+  assert(results.size() >= projectedCoordinates.size());
+
+  const double oneOverEarthSemimajorAxis = this->_oneOverSemimajorAxis;
+  for (size_t i = 0; i < projectedCoordinates.size(); ++i) {
+    const glm::dvec3& projected = projectedCoordinates[i];
+    results[i] = Cartographic(
+        projected.x * oneOverEarthSemimajorAxis,
+        projected.y * oneOverEarthSemimajorAxis,
+        projected.z);
+  }
+}
+
 CesiumGeospatial::GlobeRectangle GeographicProjection::unproject(
     const CesiumGeometry::Rectangle& rectangle) const noexcept {
   const Cartographic sw = this->unproject(rectangle.getLowerLeft());
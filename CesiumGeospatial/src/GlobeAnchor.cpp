@@ -4,19 +4,18 @@
 #include <glm/gtx/quaternion.hpp>
 #include <glm/vec3.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+
 namespace {
 
-glm::dmat4 adjustOrientationForMove(
-    const CesiumGeospatial::Ellipsoid& ellipsoid,
-    const glm::dvec3& oldPosition,
-    const glm::dvec3& newPosition,
+// Rotates the orientation of an anchor by the rotation between the surface
+// normals at its old and new positions.
+glm::dmat4 rotateForMove(
+    const glm::dvec3& oldNormal,
+    const glm::dvec3& newNormal,
     const glm::dmat4& anchorToFixed) {
-  if (oldPosition == newPosition)
-    return anchorToFixed;
-
-  glm::dvec3 oldNormal = ellipsoid.geodeticSurfaceNormal(oldPosition);
-  glm::dvec3 newNormal = ellipsoid.geodeticSurfaceNormal(newPosition);
-
   glm::dmat3 ellipsoidNormalRotation =
       glm::mat3_cast(glm::rotation(oldNormal, newNormal));
   glm::dmat3 newRotationScale =
@@ -29,6 +28,23 @@ glm::dmat4 adjustOrientationForMove(
       anchorToFixed[3]);
 }
 
+glm::dmat4 adjustOrientationForMove(
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    const glm::dvec3& oldPosition,
+    const glm::dvec3& newPosition,
+    const glm::dmat4& anchorToFixed) {
+  if (oldPosition == newPosition)
+    return anchorToFixed;
+
+  glm::dvec3 oldNormal = ellipsoid.geodeticSurfaceNormal(oldPosition);
+  glm::dvec3 newNormal = ellipsoid.geodeticSurfaceNormal(newPosition);
+  return rotateForMove(oldNormal, newNormal, anchorToFixed);
+}
+
+// The number of anchors whose normals are computed together, which keeps their
+// positions and normals on the stack.
+constexpr size_t BatchSize = 64;
+
 } // namespace
 
 namespace CesiumGeospatial {
@@ -86,4 +102,83 @@ void GlobeAnchor::setAnchorToLocalTransform(
       ellipsoid);
 }
 
+/*static*/ void GlobeAnchor::getAnchorToLocalTransforms(
+    const LocalHorizontalCoordinateSystem& localCoordinateSystem,
+    gsl::span<const GlobeAnchor> anchors,
+    gsl::span<glm::dmat4> results) noexcept {
+  assert(results.size() >= anchors.size());
+
+  const glm::dmat4& ecefToLocal =
+      localCoordinateSystem.getEcefToLocalTransformation();
+  for (size_t i = 0; i < anchors.size(); ++i) {
+    results[i] = ecefToLocal * anchors[i]._anchorToFixed;
+  }
+}
+
+/*static*/ void GlobeAnchor::setAnchorToFixedTransforms(
+    gsl::span<GlobeAnchor> anchors,
+    gsl::span<const glm::dmat4> newAnchorToFixed,
+    bool adjustOrientation,
+    const Ellipsoid& ellipsoid) {
+  assert(newAnchorToFixed.size() >= anchors.size());
+
+  if (!adjustOrientation) {
+    for (size_t i = 0; i < anchors.size(); ++i) {
+      anchors[i]._anchorToFixed = newAnchorToFixed[i];
+    }
+    return;
+  }
+
+  // The old positions come first and the new positions second, so that the
+  // normals of both are computed with a single vectorized loop.
+  std::array<glm::dvec3, 2 * BatchSize> positions;
+  std::array<glm::dvec3, 2 * BatchSize> normals;
+
+  for (size_t first = 0; first < anchors.size(); first += BatchSize) {
+    const size_t count = std::min(BatchSize, anchors.size() - first);
+    for (size_t i = 0; i < count; ++i) {
+      positions[i] = glm::dvec3(anchors[first + i]._anchorToFixed[3]);
+      positions[count + i] = glm::dvec3(newAnchorToFixed[first + i][3]);
+    }
+
+    ellipsoid.geodeticSurfaceNormal(
+        gsl::span<const glm::dvec3>(positions.data(), 2 * count),
+        gsl::span<glm::dvec3>(normals.data(), 2 * count));
+
+    for (size_t i = 0; i < count; ++i) {
+      const glm::dmat4& anchorToFixed = newAnchorToFixed[first + i];
+      anchors[first + i]._anchorToFixed =
+          positions[i] == positions[count + i]
+              ? anchorToFixed
+              : rotateForMove(normals[i], normals[count + i], anchorToFixed);
+    }
+  }
+}
+
+/*static*/ void GlobeAnchor::setAnchorToLocalTransforms(
+    const LocalHorizontalCoordinateSystem& localCoordinateSystem,
+    gsl::span<GlobeAnchor> anchors,
+    gsl::span<const glm::dmat4> newAnchorToLocal,
+    bool adjustOrientation,
+    const Ellipsoid& ellipsoid) {
+  assert(newAnchorToLocal.size() >= anchors.size());
+
+  const glm::dmat4& localToEcef =
+      localCoordinateSystem.getLocalToEcefTransformation();
+  std::array<glm::dmat4, BatchSize> newAnchorToFixed;
+
+  for (size_t first = 0; first < anchors.size(); first += BatchSize) {
+    const size_t count = std::min(BatchSize, anchors.size() - first);
+    for (size_t i = 0; i < count; ++i) {
+      newAnchorToFixed[i] = localToEcef * newAnchorToLocal[first + i];
+    }
+
+    setAnchorToFixedTransforms(
+        anchors.subspan(first, count),
+        gsl::span<const glm::dmat4>(newAnchorToFixed.data(), count),
+        adjustOrientation,
+        ellipsoid);
+  }
+}
+
 } // namespace CesiumGeospatial
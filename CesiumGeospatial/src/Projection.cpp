@@ -3,6 +3,8 @@
 #include <glm/geometric.hpp>
 #include <glm/trigonometric.hpp>
 
+#include <cassert>
+
 namespace CesiumGeospatial {
 
 glm::dvec3
@@ -22,6 +24,28 @@ projectPosition(const Projection& projection, const Cartographic& position) {
   return std::visit(Operation{position}, projection);
 }
 
+void projectPositions(
+    const Projection& projection,
+    gsl::span<const Cartographic> positions,
+    gsl::span<glm::dvec3> results) {
+  assert(results.size() >= positions.size());
+
+  struct Operation {
+    gsl::span<const Cartographic> positions;
+    gsl::span<glm::dvec3> results;
+
+    void operator()(const GeographicProjection& geographic) noexcept {
+      geographic.project(positions, results);
+    }
+
+    void operator()(const WebMercatorProjection& webMercator) noexcept {
+      webMercator.project(positions, results);
+    }
+  };
+
+  std::visit(Operation{positions, results}, projection);
+}
+
 Cartographic
 unprojectPosition(const Projection& projection, const glm::dvec3& position) {
   struct Operation {
@@ -39,6 +63,28 @@ unprojectPosition(const Projection& projection, const glm::dvec3& position) {
   return std::visit(Operation{position}, projection);
 }
 
+void unprojectPositions(
+    const Projection& projection,
+    gsl::span<const glm::dvec3> positions,
+    gsl::span<Cartographic> results) {
+  assert(results.size() >= positions.size());
+
+  struct Operation {
+    gsl::span<const glm::dvec3> positions;
+    gsl::span<Cartographic> results;
+
+    void operator()(const GeographicProjection& geographic) noexcept {
+      geographic.unproject(positions, results);
+    }
+
+    void operator()(const WebMercatorProjection& webMercator) noexcept {
+      webMercator.unproject(positions, results);
+    }
+  };
+
+  std::visit(Operation{positions, results}, projection);
+}
+
 CesiumGeometry::Rectangle projectRectangleSimple(
     const Projection& projection,
     const GlobeRectangle& rectangle) {
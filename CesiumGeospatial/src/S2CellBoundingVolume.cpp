@@ -2,6 +2,7 @@
 
 #include <CesiumUtility/Math.h>
 
+#include <glm/common.hpp>
 #include <glm/geometric.hpp>
 #include <glm/gtx/norm.hpp>
 #include <glm/matrix.hpp>
@@ -127,6 +128,42 @@ computeVertices(const std::array<Plane, 6>& boundingPlanes) {
   return vertices;
 }
 
+// Fits a box to the vertices that is aligned with the top plane and with the
+// average direction of the left and right sides of the top face.
+void computeEnclosingBox(
+    const Plane& topPlane,
+    const std::array<glm::dvec3, 8>& vertices,
+    glm::dvec3& center,
+    glm::dmat3& halfAxes) {
+  const glm::dvec3& zAxis = topPlane.getNormal();
+  const glm::dvec3 across =
+      (vertices[1] + vertices[2]) - (vertices[0] + vertices[3]);
+  const glm::dvec3 xAxis =
+      glm::normalize(across - zAxis * glm::dot(across, zAxis));
+  const glm::dvec3 yAxis = glm::cross(zAxis, xAxis);
+
+  const glm::dvec3 origin = vertices[0];
+  glm::dvec3 minimum(0.0);
+  glm::dvec3 maximum(0.0);
+  for (const glm::dvec3& vertex : vertices) {
+    const glm::dvec3 offset = vertex - origin;
+    const glm::dvec3 projected(
+        glm::dot(offset, xAxis),
+        glm::dot(offset, yAxis),
+        glm::dot(offset, zAxis));
+    minimum = glm::min(minimum, projected);
+    maximum = glm::max(maximum, projected);
+  }
+
+  const glm::dvec3 middle = (minimum + maximum) * 0.5;
+  const glm::dvec3 halfLengths = (maximum - minimum) * 0.5;
+  center = origin + xAxis * middle.x + yAxis * middle.y + zAxis * middle.z;
+  halfAxes = glm::dmat3(
+      xAxis * halfLengths.x,
+      yAxis * halfLengths.y,
+      zAxis * halfLengths.z);
+}
+
 } // namespace
 
 S2CellBoundingVolume::S2CellBoundingVolume(
@@ -142,6 +179,11 @@ S2CellBoundingVolume::S2CellBoundingVolume(
   this->_center = ellipsoid.cartographicToCartesian(result);
   this->_boundingPlanes = computeBoundingPlanes(*this, ellipsoid);
   this->_vertices = computeVertices(this->_boundingPlanes);
+  computeEnclosingBox(
+      this->_boundingPlanes[0],
+      this->_vertices,
+      this->_boxCenter,
+      this->_boxHalfAxes);
 }
 
 glm::dvec3 S2CellBoundingVolume::getCenter() const noexcept {
@@ -154,6 +196,19 @@ gsl::span<const glm::dvec3> S2CellBoundingVolume::getVertices() const noexcept {
 
 CesiumGeometry::CullingResult S2CellBoundingVolume::intersectPlane(
     const CesiumGeometry::Plane& plane) const noexcept {
+  const glm::dvec3& normal = plane.getNormal();
+  const double boxRadius = glm::abs(glm::dot(normal, this->_boxHalfAxes[0])) +
+                           glm::abs(glm::dot(normal, this->_boxHalfAxes[1])) +
+                           glm::abs(glm::dot(normal, this->_boxHalfAxes[2]));
+  const double boxDistance =
+      glm::dot(normal, this->_boxCenter) + plane.getDistance();
+  if (boxDistance - boxRadius >= 0.0) {
+    return CullingResult::Inside;
+  }
+  if (boxDistance + boxRadius < 0.0) {
+    return CullingResult::Outside;
+  }
+
   size_t plusCount = 0;
   size_t negCount = 0;
   for (size_t i = 0; i < this->_vertices.size(); ++i) {
@@ -195,15 +250,17 @@ getPlaneVertices(const std::array<glm::dvec3, 8>& vertices, size_t index) {
       vertices[4 + i]};
 }
 
+// The normals are not normalized, because only the side of their edges that
+// a point is on is taken from them.
 std::array<glm::dvec3, 4> computeEdgeNormals(
     const Plane& plane,
     const std::array<glm::dvec3, 4>& vertices,
     bool invert) {
   std::array<glm::dvec3, 4> result = {
-      glm::normalize(glm::cross(plane.getNormal(), vertices[1] - vertices[0])),
-      glm::normalize(glm::cross(plane.getNormal(), vertices[2] - vertices[1])),
-      glm::normalize(glm::cross(plane.getNormal(), vertices[3] - vertices[2])),
-      glm::normalize(glm::cross(plane.getNormal(), vertices[0] - vertices[3]))};
+      glm::cross(plane.getNormal(), vertices[1] - vertices[0]),
+      glm::cross(plane.getNormal(), vertices[2] - vertices[1]),
+      glm::cross(plane.getNormal(), vertices[3] - vertices[2]),
+      glm::cross(plane.getNormal(), vertices[0] - vertices[3])};
 
   if (invert) {
     result[0] = -result[0];
@@ -255,13 +312,10 @@ glm::dvec3 closestPointPolygon(
   glm::dvec3 closestPoint = p;
 
   for (size_t i = 0; i < vertices.size(); ++i) {
-    Plane edgePlane(vertices[i], edgeNormals[i]);
-    double edgePlaneDistance = edgePlane.getPointDistance(p);
-
     // Skip checking against the edge if the point is not in the half-space that
-    // the edgePlane's normal points towards i.e. if the edgePlane is facing
-    // away from the point.
-    if (edgePlaneDistance < 0.0) {
+    // the edge normal points towards i.e. if the edge is facing away from the
+    // point.
+    if (glm::dot(edgeNormals[i], p - vertices[i]) < 0.0) {
       continue;
     }
 
@@ -429,3 +483,8 @@ BoundingRegion S2CellBoundingVolume::computeBoundingRegion() const noexcept {
       this->_minimumHeight,
       this->_maximumHeight);
 }
+
+OrientedBoundingBox
+S2CellBoundingVolume::computeOrientedBoundingBox() const noexcept {
+  return OrientedBoundingBox(this->_boxCenter, this->_boxHalfAxes);
+}
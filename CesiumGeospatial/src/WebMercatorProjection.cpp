@@ -7,6 +7,8 @@
 #include <glm/exponential.hpp>
 #include <glm/trigonometric.hpp>
 
+#include <cassert>
+
 namespace CesiumGeospatial {
 
 /*static*/ const double WebMercatorProjection::MAXIMUM_LATITUDE =
@@ -37,6 +39,23 @@ glm::dvec3 WebMercatorProjection::project(
       cartographic.height);
 }
 
+void WebMercatorProjection::project(
+    gsl::span<const Cartographic> cartographics,
+    gsl::span<glm::dvec3> results) const noexcept {
+  assert(results.size() >= cartographics.size());
+
+  const double semimajorAxis = this->_semimajorAxis;
+  for (size_t i = 0; i < cartographics.size(); ++i) {
+    const Cartographic& cartographic = cartographics[i];
+    results[i] = glm::dvec3(
+        cartographic.longitude * semimajorAxis,
+        WebMercatorProjection::geodeticLatitudeToMercatorAngle(
+            cartographic.latitude) *
+            semimajorAxis,
+        cartographic.height);
+  }
+}
+
 CesiumGeometry::Rectangle WebMercatorProjection::project(
     const CesiumGeospatial::GlobeRectangle& rectangle) const noexcept {
   const glm::dvec3 sw = this->project(rectangle.getSouthwest());
@@ -62,6 +81,22 @@ Cartographic WebMercatorProjection::unproject(
   return result;
 }
 
+void WebMercatorProjection::unproject(
+    gsl::span<const glm::dvec3> projectedCoordinates,
+    gsl::span<Cartographic> results) const noexcept {
+  assert(results.size() >= projectedCoordinates.size());
+
+  const double oneOverEarthSemimajorAxis = this->_oneOverSemimajorAxis;
+  for (size_t i = 0; i < projectedCoordinates.size(); ++i) {
+    const glm::dvec3& projected = projectedCoordinates[i];
+    results[i] = Cartographic(
+        projected.x * oneOverEarthSemimajorAxis,
+        WebMercatorProjection::mercatorAngleToGeodeticLatitude(
+            projected.y * oneOverEarthSemimajorAxis),
+        projected.z);
+  }
+}
+
 CesiumGeospatial::GlobeRectangle WebMercatorProjection::unproject(
     const CesiumGeometry::Rectangle& rectangle) const noexcept {
   const Cartographic sw = this->unproject(rectangle.getLowerLeft());
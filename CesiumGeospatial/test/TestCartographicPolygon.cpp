@@ -0,0 +1,110 @@
+#include <CesiumGeometry/IntersectionTests.h>
+#include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+#include <glm/trigonometric.hpp>
+#include <glm/vec2.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace {
+bool containsWithTriangles(
+    const CartographicPolygon& polygon,
+    const glm::dvec2& point) {
+  const std::vector<glm::dvec2>& vertices = polygon.getVertices();
+  const std::vector<uint32_t>& indices = polygon.getIndices();
+  for (size_t i = 2; i < indices.size(); i += 3) {
+    if (IntersectionTests::pointInTriangle(
+            point,
+            vertices[indices[i - 2]],
+            vertices[indices[i - 1]],
+            vertices[indices[i]])) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+TEST_CASE("CartographicPolygon::contains") {
+  SECTION("tests points against a concave polygon") {
+    // An L shape.
+    const CartographicPolygon polygon(std::vector<glm::dvec2>{
+        glm::dvec2(0.0, 0.0),
+        glm::dvec2(0.2, 0.0),
+        glm::dvec2(0.2, 0.1),
+        glm::dvec2(0.1, 0.1),
+        glm::dvec2(0.1, 0.2),
+        glm::dvec2(0.0, 0.2)});
+
+    CHECK(polygon.contains(glm::dvec2(0.05, 0.05)));
+    CHECK(polygon.contains(glm::dvec2(0.15, 0.05)));
+    CHECK(polygon.contains(glm::dvec2(0.05, 0.15)));
+    CHECK(!polygon.contains(glm::dvec2(0.15, 0.15)));
+    CHECK(!polygon.contains(glm::dvec2(0.3, 0.05)));
+    CHECK(!polygon.contains(glm::dvec2(0.05, 0.3)));
+    CHECK(!polygon.contains(glm::dvec2(-0.05, -0.05)));
+  }
+
+  SECTION("agrees with the triangulation of a polygon with many vertices") {
+    // A star with 200 points.
+    std::vector<glm::dvec2> vertices;
+    for (size_t i = 0; i < 400; ++i) {
+      const double angle = Math::TwoPi * double(i) / 400.0;
+      const double radius = i % 2 == 0 ? 0.1 : 0.05;
+      vertices.emplace_back(
+          0.5 + radius * glm::cos(angle),
+          0.5 + radius * glm::sin(angle));
+    }
+    const CartographicPolygon polygon(vertices);
+
+    std::vector<glm::dvec2> points;
+    for (size_t i = 0; i < 50; ++i) {
+      for (size_t j = 0; j < 50; ++j) {
+        points.emplace_back(
+            0.38 + 0.24 * double(i) / 49.0 + 1e-7,
+            0.38 + 0.24 * double(j) / 49.0 + 1e-7);
+      }
+    }
+
+    std::unique_ptr<bool[]> results(new bool[points.size()]);
+    polygon.contains(points, gsl::span<bool>(results.get(), points.size()));
+
+    size_t inside = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+      const bool expected = containsWithTriangles(polygon, points[i]);
+      CHECK(polygon.contains(points[i]) == expected);
+      CHECK(results[i] == expected);
+      inside += expected ? 1 : 0;
+    }
+    CHECK(inside > 0);
+    CHECK(inside < points.size());
+  }
+
+  SECTION("wraps longitudes across the antimeridian") {
+    const double west = Math::OnePi - 0.1;
+    const double east = -Math::OnePi + 0.1;
+    const CartographicPolygon polygon(std::vector<glm::dvec2>{
+        glm::dvec2(west, -0.1),
+        glm::dvec2(east, -0.1),
+        glm::dvec2(east, 0.1),
+        glm::dvec2(west, 0.1)});
+
+    CHECK(polygon.contains(glm::dvec2(Math::OnePi - 0.05, 0.0)));
+    CHECK(polygon.contains(glm::dvec2(-Math::OnePi + 0.05, 0.0)));
+    CHECK(!polygon.contains(glm::dvec2(0.0, 0.0)));
+  }
+
+  SECTION("contains nothing without enough vertices") {
+    const CartographicPolygon polygon(
+        std::vector<glm::dvec2>{glm::dvec2(0.0, 0.0), glm::dvec2(1.0, 1.0)});
+    CHECK(!polygon.contains(glm::dvec2(0.5, 0.5)));
+  }
+}
@@ -0,0 +1,146 @@
+#include "CesiumGeospatial/Ellipsoid.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+#include <optional>
+#include <vector>
+
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+TEST_CASE("Ellipsoid::cartesianToCartographic for many positions") {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+
+  std::vector<glm::dvec3> cartesians;
+  for (int32_t i = 0; i < 150; ++i) {
+    const double longitude = Math::degreesToRadians(-180.0 + 2.4 * i);
+    const double latitude = Math::degreesToRadians(-90.0 + 1.2 * i);
+    const double height = -1000.0 + 5000.0 * (i % 7);
+    cartesians.emplace_back(ellipsoid.cartographicToCartesian(
+        Cartographic(longitude, latitude, height)));
+  }
+  cartesians.emplace_back(0.0, 0.0, 0.0);
+  cartesians.emplace_back(0.01, 0.0, 0.0);
+  cartesians.emplace_back(0.0, 0.0, 6356752.3142451793);
+
+  std::vector<std::optional<Cartographic>> results(cartesians.size());
+  ellipsoid.cartesianToCartographic(cartesians, results);
+
+  for (size_t i = 0; i < cartesians.size(); ++i) {
+    const std::optional<Cartographic> expected =
+        ellipsoid.cartesianToCartographic(cartesians[i]);
+    REQUIRE(results[i].has_value() == expected.has_value());
+    if (expected) {
+      CHECK(Math::equalsEpsilon(
+          results[i]->longitude,
+          expected->longitude,
+          Math::Epsilon14));
+      CHECK(Math::equalsEpsilon(
+          results[i]->latitude,
+          expected->latitude,
+          Math::Epsilon14));
+      CHECK(Math::equalsEpsilon(
+          results[i]->height,
+          expected->height,
+          Math::Epsilon14,
+          Math::Epsilon8));
+    }
+  }
+
+  CHECK(!results[150]);
+  REQUIRE(results[1]);
+  CHECK(Math::equalsEpsilon(
+      results[1]->latitude,
+      Math::degreesToRadians(-88.8),
+      Math::Epsilon10));
+}
+
+TEST_CASE("Ellipsoid::cartographicToCartesian for many positions") {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+
+  std::vector<Cartographic> cartographics;
+  for (int32_t i = 0; i < 100; ++i) {
+    cartographics.emplace_back(
+        Math::degreesToRadians(-180.0 + 3.6 * i),
+        Math::degreesToRadians(-90.0 + 1.8 * i),
+        -1000.0 + 5000.0 * (i % 7));
+  }
+
+  std::vector<glm::dvec3> results(cartographics.size());
+  ellipsoid.cartographicToCartesian(cartographics, results);
+
+  for (size_t i = 0; i < cartographics.size(); ++i) {
+    const glm::dvec3 expected =
+        ellipsoid.cartographicToCartesian(cartographics[i]);
+    CHECK(Math::equalsEpsilon(results[i], expected, 0.0, Math::Epsilon8));
+  }
+}
+
+TEST_CASE("Ellipsoid::cartesianToCartographicApproximate") {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+
+  std::vector<glm::dvec3> cartesians;
+  for (int32_t i = 0; i < 200; ++i) {
+    const double longitude = Math::degreesToRadians(-180.0 + 1.8 * i);
+    const double latitude = Math::degreesToRadians(-90.0 + 0.9 * i);
+    const double height = -100000.0 + 2000.0 * (i % 101);
+    cartesians.emplace_back(ellipsoid.cartographicToCartesian(
+        Cartographic(longitude, latitude, height)));
+  }
+  cartesians.emplace_back(0.0, 0.0, 6356752.3142451793);
+  cartesians.emplace_back(0.0, 0.0, -6356752.3142451793 - 100.0);
+  cartesians.emplace_back(0.0, 0.0, 0.0);
+
+  std::vector<std::optional<Cartographic>> results(cartesians.size());
+  ellipsoid.cartesianToCartographicApproximate(cartesians, results);
+
+  for (size_t i = 0; i < cartesians.size(); ++i) {
+    const std::optional<Cartographic> expected =
+        ellipsoid.cartesianToCartographic(cartesians[i]);
+    REQUIRE(results[i].has_value() == expected.has_value());
+    if (expected) {
+      CHECK(Math::equalsEpsilon(
+          results[i]->longitude,
+          expected->longitude,
+          0.0,
+          Math::Epsilon14));
+      CHECK(Math::equalsEpsilon(
+          results[i]->latitude,
+          expected->latitude,
+          0.0,
+          Math::Epsilon10));
+      CHECK(Math::equalsEpsilon(
+          results[i]->height,
+          expected->height,
+          0.0,
+          Math::Epsilon3));
+    }
+  }
+
+  REQUIRE(results[201]);
+  CHECK(Math::equalsEpsilon(
+      results[201]->latitude,
+      -Math::PiOverTwo,
+      Math::Epsilon14));
+  CHECK(Math::equalsEpsilon(results[201]->height, 100.0, 0.0, Math::Epsilon6));
+  CHECK(!results[202]);
+
+  SECTION("is exact for ellipsoids that aren't of revolution") {
+    const Ellipsoid triaxial(3.0, 2.0, 1.0);
+    const std::vector<glm::dvec3> positions{
+        glm::dvec3(4.0, 1.0, 0.5),
+        glm::dvec3(-1.0, 3.0, -2.0)};
+    std::vector<std::optional<Cartographic>> approximate(positions.size());
+    std::vector<std::optional<Cartographic>> exact(positions.size());
+    triaxial.cartesianToCartographicApproximate(positions, approximate);
+    triaxial.cartesianToCartographic(positions, exact);
+    for (size_t i = 0; i < positions.size(); ++i) {
+      REQUIRE(approximate[i]);
+      REQUIRE(exact[i]);
+      CHECK(approximate[i]->latitude == exact[i]->latitude);
+      CHECK(approximate[i]->height == exact[i]->height);
+    }
+  }
+}
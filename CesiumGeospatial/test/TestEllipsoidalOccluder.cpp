@@ -0,0 +1,85 @@
+#include "CesiumGeospatial/BoundingRegion.h"
+#include "CesiumGeospatial/Cartographic.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumGeospatial/EllipsoidalOccluder.h"
+#include "CesiumGeospatial/GlobeRectangle.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+TEST_CASE("EllipsoidalOccluder") {
+  // A camera 1000 kilometers above the equator, which sees about 30 degrees of
+  // longitude to either side before the horizon.
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  const EllipsoidalOccluder occluder(
+      ellipsoid,
+      ellipsoid.cartographicToCartesian(Cartographic(0.0, 0.0, 1000000.0)));
+
+  auto equatorialRegion = [](double westDegrees,
+                             double eastDegrees,
+                             double minimumHeight,
+                             double maximumHeight) {
+    return BoundingRegion(
+        GlobeRectangle::fromDegrees(westDegrees, -1.0, eastDegrees, 1.0),
+        minimumHeight,
+        maximumHeight);
+  };
+
+  const glm::dvec3 farSide =
+      ellipsoid.cartographicToCartesian(Cartographic(Math::OnePi, 0.0, 0.0));
+
+  SECTION("isPointVisible") {
+    CHECK(occluder.isPointVisible(
+        ellipsoid.cartographicToCartesian(Cartographic(0.01, 0.0, 0.0))));
+    CHECK(!occluder.isPointVisible(farSide));
+    CHECK(!occluder.isPointVisible(ellipsoid.cartographicToCartesian(
+        Cartographic(Math::degreesToRadians(40.0), 0.0, 0.0))));
+  }
+
+  SECTION("Regions near the camera are visible") {
+    const auto point = EllipsoidalOccluder::computeHorizonCullingPoint(
+        equatorialRegion(-5.0, 5.0, 0.0, 100.0));
+    REQUIRE(point);
+    CHECK(occluder.isHorizonCullingPointVisible(*point));
+  }
+
+  SECTION("Regions beyond the horizon are not visible") {
+    const auto point = EllipsoidalOccluder::computeHorizonCullingPoint(
+        equatorialRegion(35.0, 40.0, 0.0, 100.0));
+    REQUIRE(point);
+    CHECK(!occluder.isHorizonCullingPointVisible(*point));
+  }
+
+  SECTION("Regions that rise above the horizon are visible") {
+    const auto point = EllipsoidalOccluder::computeHorizonCullingPoint(
+        equatorialRegion(35.0, 40.0, 0.0, 2000000.0));
+    REQUIRE(point);
+    CHECK(occluder.isHorizonCullingPointVisible(*point));
+  }
+
+  SECTION("Regions below the ellipsoid are culled by a smaller one") {
+    const auto point = EllipsoidalOccluder::computeHorizonCullingPoint(
+        equatorialRegion(35.0, 40.0, -1000000.0, 100.0));
+    REQUIRE(point);
+    CHECK(point->minimumHeight == -1000000.0);
+    CHECK(occluder.isHorizonCullingPointVisible(*point));
+  }
+
+  SECTION("Regions that cover too much of the ellipsoid have no point") {
+    CHECK(!EllipsoidalOccluder::computeHorizonCullingPoint(
+        equatorialRegion(-100.0, 100.0, 0.0, 100.0)));
+  }
+
+  SECTION("Everything is visible from inside the ellipsoid") {
+    const EllipsoidalOccluder inside(ellipsoid, glm::dvec3(0.0));
+    CHECK(inside.isPointVisible(farSide));
+    const auto point = EllipsoidalOccluder::computeHorizonCullingPoint(
+        equatorialRegion(35.0, 40.0, 0.0, 100.0));
+    REQUIRE(point);
+    CHECK(inside.isHorizonCullingPointVisible(*point));
+  }
+}
@@ -5,6 +5,9 @@
 #include <catch2/catch.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include <cstddef>
+#include <vector>
+
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
@@ -178,4 +181,67 @@ TEST_CASE("GlobeAnchor") {
         0.0,
         Math::Epsilon10));
   }
+
+  SECTION("Batch updates match updating each anchor") {
+    std::vector<GlobeAnchor> anchors;
+    std::vector<glm::dmat4> newToLocal;
+    for (size_t i = 0; i < 100; ++i) {
+      const double offset = double(i) * 1000.0;
+      anchors.push_back(GlobeAnchor::fromAnchorToLocalTransform(
+          leftHandedEastUpNorth,
+          glm::dmat4(
+              glm::dvec4(1.0, 0.0, 0.0, 0.0),
+              glm::dvec4(0.0, 1.0, 0.0, 0.0),
+              glm::dvec4(0.0, 0.0, 1.0, 0.0),
+              glm::dvec4(offset, 0.0, 0.0, 1.0))));
+      // Every tenth anchor stays where it is.
+      newToLocal.push_back(glm::dmat4(
+          glm::dvec4(0.0, 1.0, 0.0, 0.0),
+          glm::dvec4(-1.0, 0.0, 0.0, 0.0),
+          glm::dvec4(0.0, 0.0, 1.0, 0.0),
+          glm::dvec4(i % 10 == 0 ? offset : -offset, 0.0, offset, 1.0)));
+    }
+
+    for (const bool adjustOrientation : {false, true}) {
+      std::vector<GlobeAnchor> expected = anchors;
+      for (size_t i = 0; i < expected.size(); ++i) {
+        expected[i].setAnchorToLocalTransform(
+            leftHandedEastUpNorth,
+            newToLocal[i],
+            adjustOrientation);
+      }
+
+      std::vector<GlobeAnchor> actual = anchors;
+      GlobeAnchor::setAnchorToLocalTransforms(
+          leftHandedEastUpNorth,
+          actual,
+          newToLocal,
+          adjustOrientation);
+
+      std::vector<glm::dmat4> actualToLocal(actual.size());
+      GlobeAnchor::getAnchorToLocalTransforms(
+          leftHandedEastUpNorth90,
+          actual,
+          actualToLocal);
+
+      for (size_t i = 0; i < actual.size(); ++i) {
+        const glm::dmat4& expectedToFixed =
+            expected[i].getAnchorToFixedTransform();
+        const glm::dmat4 expectedToLocal =
+            expected[i].getAnchorToLocalTransform(leftHandedEastUpNorth90);
+        for (glm::length_t column = 0; column < 4; ++column) {
+          CHECK(Math::equalsEpsilon(
+              actual[i].getAnchorToFixedTransform()[column],
+              expectedToFixed[column],
+              0.0,
+              Math::Epsilon10));
+          CHECK(Math::equalsEpsilon(
+              actualToLocal[i][column],
+              expectedToLocal[column],
+              0.0,
+              Math::Epsilon10));
+        }
+      }
+    }
+  }
 }
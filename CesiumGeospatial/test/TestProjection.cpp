@@ -6,6 +6,8 @@
 #include <catch2/catch.hpp>
 #include <glm/geometric.hpp>
 
+#include <vector>
+
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
@@ -105,3 +107,58 @@ TEST_CASE("computeProjectedRectangleSize") {
         1.0));
   }
 }
+
+TEST_CASE("projectPositions") {
+  const std::vector<Cartographic> positions{
+      Cartographic::fromDegrees(-120.0, 35.0, 100.0),
+      Cartographic::fromDegrees(0.0, 0.0, 0.0),
+      Cartographic::fromDegrees(179.0, -60.0, -20.0)};
+  std::vector<glm::dvec3> results(positions.size());
+
+  for (const Projection& projection :
+       {Projection(GeographicProjection()),
+        Projection(WebMercatorProjection())}) {
+    projectPositions(projection, positions, results);
+    for (size_t i = 0; i < positions.size(); ++i) {
+      CHECK(results[i] == projectPosition(projection, positions[i]));
+    }
+  }
+}
+
+TEST_CASE("unprojectPositions") {
+  const std::vector<Cartographic> positions{
+      Cartographic::fromDegrees(-120.0, 35.0, 100.0),
+      Cartographic::fromDegrees(0.0, 0.0, 0.0),
+      Cartographic::fromDegrees(179.0, -60.0, -20.0),
+      Cartographic(
+          Math::OnePi,
+          WebMercatorProjection::MAXIMUM_LATITUDE,
+          5.0)};
+  std::vector<glm::dvec3> projected(positions.size());
+  std::vector<Cartographic> results(positions.size());
+
+  for (const Projection& projection :
+       {Projection(GeographicProjection()),
+        Projection(WebMercatorProjection())}) {
+    projectPositions(projection, positions, projected);
+    unprojectPositions(projection, projected, results);
+    for (size_t i = 0; i < positions.size(); ++i) {
+      const Cartographic expected = unprojectPosition(projection, projected[i]);
+      CHECK(results[i].longitude == expected.longitude);
+      CHECK(results[i].latitude == expected.latitude);
+      CHECK(results[i].height == expected.height);
+
+      CHECK(Math::equalsEpsilon(
+          results[i].longitude,
+          positions[i].longitude,
+          0.0,
+          1e-14));
+      CHECK(Math::equalsEpsilon(
+          results[i].latitude,
+          positions[i].latitude,
+          0.0,
+          1e-14));
+      CHECK(results[i].height == positions[i].height);
+    }
+  }
+}
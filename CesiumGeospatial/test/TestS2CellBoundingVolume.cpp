@@ -4,6 +4,8 @@
 #include <catch2/catch.hpp>
 #include <glm/geometric.hpp>
 
+#include <cstddef>
+
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
@@ -127,6 +129,57 @@ TEST_CASE("S2CellBoundingVolume") {
         CullingResult::Inside);
   }
 
+  SECTION("intersect plane agrees with the vertices of a small cell") {
+    const S2CellBoundingVolume cell(
+        S2CellID::fromToken("89c25"),
+        0.0,
+        500.0);
+    gsl::span<const glm::dvec3> vertices = cell.getVertices();
+    const glm::dvec3 center = cell.getCenter();
+
+    for (const glm::dvec3& direction :
+         {glm::dvec3(1.0, 0.0, 0.0),
+          glm::dvec3(0.0, -1.0, 0.0),
+          glm::normalize(glm::dvec3(1.0, 1.0, 1.0)),
+          glm::normalize(center)}) {
+      for (const double offset : {-20000.0, -100.0, 0.0, 100.0, 20000.0}) {
+        const Plane plane(center + direction * offset, direction);
+        size_t inFront = 0;
+        for (const glm::dvec3& vertex : vertices) {
+          if (plane.getPointDistance(vertex) >= 0.0) {
+            ++inFront;
+          }
+        }
+        CullingResult expected = CullingResult::Intersecting;
+        if (inFront == vertices.size()) {
+          expected = CullingResult::Inside;
+        } else if (inFront == 0) {
+          expected = CullingResult::Outside;
+        }
+        CHECK(cell.intersectPlane(plane) == expected);
+      }
+    }
+  }
+
+  SECTION("oriented bounding box encloses the vertices tightly") {
+    const S2CellBoundingVolume cell(
+        S2CellID::fromToken("89c25"),
+        0.0,
+        500.0);
+    const OrientedBoundingBox box = cell.computeOrientedBoundingBox();
+    for (const glm::dvec3& vertex : cell.getVertices()) {
+      CHECK(box.computeDistanceSquaredToPosition(vertex) < Math::Epsilon3);
+    }
+
+    // The box of the bounding region is no smaller than the cell's own.
+    const glm::dvec3 lengths = box.getLengths();
+    const glm::dvec3 regionLengths =
+        cell.computeBoundingRegion().getBoundingBox().getLengths();
+    CHECK(
+        lengths.x * lengths.y * lengths.z <=
+        regionLengths.x * regionLengths.y * regionLengths.z);
+  }
+
   SECTION("can construct face 2 (North pole)") {
     S2CellBoundingVolume face2Root(S2CellID::fromToken("5"), 1000.0, 2000.0);
     CHECK(face2Root.getCellID().isValid());
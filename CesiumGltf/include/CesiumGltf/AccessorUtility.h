@@ -5,7 +5,11 @@
 #include <CesiumGltf/MeshPrimitive.h>
 
 #include <glm/common.hpp>
+#include <glm/vec3.hpp>
 
+#include <algorithm>
+#include <limits>
+#include <optional>
 #include <variant>
 
 namespace CesiumGltf {
@@ -62,6 +66,97 @@ typedef AccessorView<AccessorTypes::VEC3<float>> NormalAccessorType;
 NormalAccessorType
 getNormalAccessorView(const Model& model, const MeshPrimitive& primitive);
 
+/**
+ * Type definition for position accessors that may be quantized, as allowed by
+ * the `KHR_mesh_quantization` extension.
+ */
+typedef std::variant<
+    AccessorView<AccessorTypes::VEC3<int8_t>>,
+    AccessorView<AccessorTypes::VEC3<uint8_t>>,
+    AccessorView<AccessorTypes::VEC3<int16_t>>,
+    AccessorView<AccessorTypes::VEC3<uint16_t>>,
+    AccessorView<AccessorTypes::VEC3<float>>>
+    QuantizedPositionAccessorType;
+
+/**
+ * Retrieves an accessor view for the position attribute from the given glTF
+ * primitive and model, which may have any of the component types allowed by
+ * `KHR_mesh_quantization`. This verifies that the accessor is of a valid type.
+ * If not, the returned accessor view will be invalid.
+ */
+QuantizedPositionAccessorType getQuantizedPositionAccessorView(
+    const Model& model,
+    const MeshPrimitive& primitive);
+
+/**
+ * @brief The transform from the components stored in an accessor to the
+ * values that they represent.
+ *
+ * The components of a normalized accessor are divided by the largest value of
+ * their type, and signed ones are clamped to -1. The components of other
+ * accessors are used as they are. The rest of the dequantization of positions
+ * quantized with `KHR_mesh_quantization`, their scale and offset, is in the
+ * transform of their node.
+ */
+struct AccessorDequantization {
+  /**
+   * @brief The factor that each component is multiplied by.
+   */
+  double scale = 1.0;
+
+  /**
+   * @brief The smallest value of a component once it is scaled.
+   */
+  double minimum = std::numeric_limits<double>::lowest();
+
+  /**
+   * @brief Dequantizes a single component.
+   */
+  double apply(double component) const noexcept {
+    return std::max(component * this->scale, this->minimum);
+  }
+
+  /**
+   * @brief Dequantizes the components of a vector.
+   */
+  template <typename T>
+  glm::dvec3 apply(const AccessorTypes::VEC3<T>& value) const noexcept {
+    return glm::dvec3(
+        this->apply(static_cast<double>(value.value[0])),
+        this->apply(static_cast<double>(value.value[1])),
+        this->apply(static_cast<double>(value.value[2])));
+  }
+};
+
+/**
+ * Gets the transform from the components stored in the given accessor to the
+ * values that they represent.
+ */
+AccessorDequantization getAccessorDequantization(const Accessor& accessor);
+
+/**
+ * Visitor that retrieves the dequantized position from the given accessor type
+ * as a glm::dvec3. This should be initialized with the target index and the
+ * {@link AccessorDequantization} of the accessor.
+ *
+ * std::nullopt is used to indicate errors retrieving the position, e.g., if the
+ * given index was out-of-bounds.
+ */
+struct QuantizedPositionFromAccessor {
+  template <typename T>
+  std::optional<glm::dvec3>
+  operator()(const AccessorView<AccessorTypes::VEC3<T>>& value) {
+    if (index < 0 || index >= value.size()) {
+      return std::nullopt;
+    }
+
+    return dequantization.apply(value[index]);
+  }
+
+  int64_t index;
+  AccessorDequantization dequantization;
+};
+
 /**
  * Type definition for all kinds of feature ID attribute accessors.
  */
@@ -1,9 +1,17 @@
 #pragma once
 
+#include "CesiumGltf/Library.h"
 #include "CesiumGltf/Model.h"
 
+#include <gsl/span>
+
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <optional>
 #include <stdexcept>
+#include <vector>
 
 namespace CesiumGltf {
 
@@ -65,6 +73,94 @@ enum class AccessorViewStatus {
   InvalidComponentType,
 };
 
+/**
+ * @brief The validated location and layout of the data of an
+ * {@link Accessor}, from which an {@link AccessorView} can be created without
+ * validating the accessor again.
+ *
+ * The layout points to the data of the buffer, so it must not be used after
+ * the accessor, its buffer view or its buffer are modified.
+ */
+struct CESIUMGLTF_API AccessorLayout {
+  /**
+   * @brief Validates an accessor of a model and computes its layout.
+   *
+   * @param model The model that the accessor belongs to.
+   * @param accessor The accessor.
+   * @return The layout. Its {@link status} indicates whether the accessor can
+   * be viewed and, if not, why not.
+   */
+  static AccessorLayout
+  create(const Model& model, const Accessor& accessor) noexcept;
+
+  /**
+   * @brief The data of the accessor's buffer.
+   */
+  const std::byte* pData = nullptr;
+
+  /**
+   * @brief The stride, in bytes, between successive elements.
+   */
+  int64_t stride = 0;
+
+  /**
+   * @brief The offset from the start of the buffer to the first element.
+   */
+  int64_t offset = 0;
+
+  /**
+   * @brief The number of elements.
+   */
+  int64_t size = 0;
+
+  /**
+   * @brief The size of each element, from
+   * {@link Accessor::computeBytesPerVertex}.
+   */
+  int64_t bytesPerElement = 0;
+
+  /**
+   * @brief The status of a view of the accessor, before the size of the view's
+   * element type is checked against {@link bytesPerElement}.
+   */
+  AccessorViewStatus status = AccessorViewStatus::InvalidAccessorIndex;
+};
+
+/**
+ * @brief The layouts of all of the accessors of a {@link Model}.
+ *
+ * Each accessor is validated once, when the cache is created, so that the
+ * {@link AccessorView}s created from the cache only compare the size of their
+ * element type. This helps code that creates many views of the same
+ * accessors.
+ *
+ * The cache isn't updated when the model changes. Create a new one after
+ * accessors, buffer views or buffers are modified, added or removed.
+ */
+class CESIUMGLTF_API AccessorLayoutCache {
+public:
+  /**
+   * @brief Validates the accessors of the given model and caches their
+   * layouts.
+   *
+   * @param model The model.
+   */
+  explicit AccessorLayoutCache(const Model& model);
+
+  /**
+   * @brief Gets the layout of the accessor with the given index.
+   *
+   * @param accessorIndex The index of the accessor in {@link Model::accessors}.
+   * @return The layout, which has a status of
+   * {@link AccessorViewStatus::InvalidAccessorIndex} if there is no accessor
+   * with that index.
+   */
+  const AccessorLayout& get(int32_t accessorIndex) const noexcept;
+
+private:
+  std::vector<AccessorLayout> _layouts;
+};
+
 /**
  * @brief A view on the data of one accessor of a glTF asset.
  *
@@ -91,6 +187,147 @@ public:
    */
   typedef T value_type;
 
+  /**
+   * @brief A random-access iterator over the elements of an
+   * {@link AccessorView}.
+   *
+   * Unlike {@link AccessorView::operator[]}, it does not check that the
+   * elements it accesses are within the view, so loops over a range of
+   * elements that is known to be valid do not pay for a check per element.
+   */
+  class const_iterator {
+  public:
+    /** @brief The category of this iterator. */
+    using iterator_category = std::random_access_iterator_tag;
+    /** @brief The type of the elements. */
+    using value_type = T;
+    /** @brief The type of the distance between two iterators. */
+    using difference_type = int64_t;
+    /** @brief The type of a pointer to an element. */
+    using pointer = const T*;
+    /** @brief The type of a reference to an element. */
+    using reference = const T&;
+
+    /**
+     * @brief Creates an iterator that does not point to any element.
+     */
+    const_iterator() noexcept : _pElement(nullptr), _stride(0) {}
+
+    /**
+     * @brief Creates an iterator pointing to the given element.
+     *
+     * @param pElement The first byte of the element.
+     * @param stride The stride, in bytes, between successive elements.
+     */
+    const_iterator(const std::byte* pElement, int64_t stride) noexcept
+        : _pElement(pElement), _stride(stride) {}
+
+    /** @brief Gets the element. */
+    reference operator*() const noexcept {
+      return *reinterpret_cast<const T*>(this->_pElement);
+    }
+
+    /** @brief Gets a pointer to the element. */
+    pointer operator->() const noexcept {
+      return reinterpret_cast<const T*>(this->_pElement);
+    }
+
+    /** @brief Gets the element that is the given number of elements later. */
+    reference operator[](difference_type i) const noexcept {
+      return *reinterpret_cast<const T*>(this->_pElement + i * this->_stride);
+    }
+
+    /** @brief Moves to the next element. */
+    const_iterator& operator++() noexcept {
+      this->_pElement += this->_stride;
+      return *this;
+    }
+
+    /** @brief Moves to the next element. */
+    const_iterator operator++(int) noexcept {
+      const_iterator result = *this;
+      ++*this;
+      return result;
+    }
+
+    /** @brief Moves to the previous element. */
+    const_iterator& operator--() noexcept {
+      this->_pElement -= this->_stride;
+      return *this;
+    }
+
+    /** @brief Moves to the previous element. */
+    const_iterator operator--(int) noexcept {
+      const_iterator result = *this;
+      --*this;
+      return result;
+    }
+
+    /** @brief Moves forward by the given number of elements. */
+    const_iterator& operator+=(difference_type n) noexcept {
+      this->_pElement += n * this->_stride;
+      return *this;
+    }
+
+    /** @brief Moves back by the given number of elements. */
+    const_iterator& operator-=(difference_type n) noexcept {
+      this->_pElement -= n * this->_stride;
+      return *this;
+    }
+
+    /** @brief Gets an iterator the given number of elements later. */
+    const_iterator operator+(difference_type n) const noexcept {
+      return const_iterator(*this) += n;
+    }
+
+    /** @brief Gets an iterator the given number of elements earlier. */
+    const_iterator operator-(difference_type n) const noexcept {
+      return const_iterator(*this) -= n;
+    }
+
+    /** @brief Gets the number of elements between two iterators. */
+    difference_type operator-(const const_iterator& rhs) const noexcept {
+      if (this->_stride == 0) {
+        return 0;
+      }
+      return (this->_pElement - rhs._pElement) / this->_stride;
+    }
+
+    /** @brief Checks if two iterators point to the same element. */
+    bool operator==(const const_iterator& rhs) const noexcept {
+      return this->_pElement == rhs._pElement;
+    }
+
+    /** @brief Checks if two iterators point to different elements. */
+    bool operator!=(const const_iterator& rhs) const noexcept {
+      return this->_pElement != rhs._pElement;
+    }
+
+    /** @brief Checks if this iterator points to an earlier element. */
+    bool operator<(const const_iterator& rhs) const noexcept {
+      return this->_pElement < rhs._pElement;
+    }
+
+    /** @brief Checks if this iterator points to a later element. */
+    bool operator>(const const_iterator& rhs) const noexcept {
+      return this->_pElement > rhs._pElement;
+    }
+
+    /** @brief Checks if this iterator does not point to a later element. */
+    bool operator<=(const const_iterator& rhs) const noexcept {
+      return this->_pElement <= rhs._pElement;
+    }
+
+    /** @brief Checks if this iterator does not point to an earlier element. */
+    bool operator>=(const const_iterator& rhs) const noexcept {
+      return this->_pElement >= rhs._pElement;
+    }
+
+  private:
+    const std::byte* _pElement;
+    int64_t _stride;
+  };
+
   /**
    * @brief Construct a new instance not pointing to any data.
    *
@@ -165,6 +402,34 @@ public:
     this->create(model, *pAccessor);
   }
 
+  /**
+   * @brief Creates a new instance from the validated layout of an accessor.
+   *
+   * If `sizeof(T)` is not the size of the accessor's elements, {@link size}
+   * will return 0 and {@link status} will be
+   * {@link AccessorViewStatus::WrongSizeT}.
+   *
+   * @param layout The layout of the accessor to view.
+   */
+  AccessorView(const AccessorLayout& layout) noexcept : AccessorView() {
+    this->create(layout);
+  }
+
+  /**
+   * @brief Creates a new instance from a cached accessor layout.
+   *
+   * This doesn't validate the accessor again, so it is faster than creating
+   * the view from the model when many views of the same accessors are needed.
+   *
+   * @param layouts The layouts of the accessors of the model.
+   * @param accessorIndex The index of the accessor to view in the model's
+   * {@link Model::accessors} list.
+   */
+  AccessorView(
+      const AccessorLayoutCache& layouts,
+      int32_t accessorIndex) noexcept
+      : AccessorView(layouts.get(accessorIndex)) {}
+
   /**
    * @brief Provides the specified accessor element.
    *
@@ -217,57 +482,117 @@ public:
     return this->_pData + this->_offset;
   }
 
-private:
-  void create(const Model& model, const Accessor& accessor) noexcept {
-    const CesiumGltf::BufferView* pBufferView =
-        Model::getSafe(&model.bufferViews, accessor.bufferView);
-    if (!pBufferView) {
-      this->_status = AccessorViewStatus::InvalidBufferViewIndex;
-      return;
+  /**
+   * @brief Returns an iterator to the first element of this view.
+   */
+  const_iterator begin() const noexcept {
+    return const_iterator(this->data(), this->_stride);
+  }
+
+  /**
+   * @brief Returns an iterator past the last element of this view.
+   */
+  const_iterator end() const noexcept {
+    return const_iterator(
+        this->data() + this->_size * this->_stride,
+        this->_stride);
+  }
+
+  /**
+   * @brief Gets the elements of this view as a span, if they are tightly
+   * packed.
+   *
+   * @returns The span, or `std::nullopt` if the {@link stride} is larger
+   * than the size of an element. A view without elements gives an empty span.
+   */
+  std::optional<gsl::span<const T>> asSpan() const noexcept {
+    if (this->_size > 0 && this->_stride != static_cast<int64_t>(sizeof(T))) {
+      return std::nullopt;
     }
 
-    const CesiumGltf::Buffer* pBuffer =
-        Model::getSafe(&model.buffers, pBufferView->buffer);
-    if (!pBuffer) {
-      this->_status = AccessorViewStatus::InvalidBufferIndex;
-      return;
+    return gsl::span<const T>(
+        reinterpret_cast<const T*>(this->data()),
+        static_cast<size_t>(this->_size));
+  }
+
+  /**
+   * @brief Copies the elements of this view to the target, as many as fit.
+   *
+   * Tightly packed elements are copied together.
+   *
+   * @param target The span to copy the elements to.
+   * @returns The number of elements copied.
+   */
+  size_t copyTo(const gsl::span<T>& target) const noexcept {
+    const size_t count =
+        std::min(target.size(), static_cast<size_t>(this->_size));
+    if (count == 0) {
+      return 0;
     }
 
-    const std::vector<std::byte>& data = pBuffer->cesium.data;
-    const int64_t bufferBytes = int64_t(data.size());
-    if (pBufferView->byteOffset + pBufferView->byteLength > bufferBytes) {
-      this->_status = AccessorViewStatus::BufferTooSmall;
-      return;
+    if (this->_stride == static_cast<int64_t>(sizeof(T))) {
+      std::memcpy(target.data(), this->data(), count * sizeof(T));
+    } else {
+      std::copy_n(this->begin(), count, target.begin());
     }
 
-    const int64_t accessorByteStride = accessor.computeByteStride(model);
-    const int64_t accessorComponentElements =
-        accessor.computeNumberOfComponents();
-    const int64_t accessorComponentBytes =
-        accessor.computeByteSizeOfComponent();
-    const int64_t accessorBytesPerStride =
-        accessorComponentElements * accessorComponentBytes;
+    return count;
+  }
+
+  /**
+   * @brief Copies the elements with the given indices to the target.
+   *
+   * Each index is checked once, without throwing.
+   *
+   * @param indices The indices of the elements to copy, in order.
+   * @param target The span to copy the elements to. It must be at least as
+   * long as the indices.
+   * @returns True if all of the elements were copied, or false if the target
+   * is too small or an index is out of range. In that case the target may
+   * have been partially written.
+   */
+  template <typename TIndex>
+  bool gather(
+      const gsl::span<const TIndex>& indices,
+      const gsl::span<T>& target) const noexcept {
+    if (target.size() < indices.size()) {
+      return false;
+    }
+
+    const const_iterator first = this->begin();
+    for (size_t i = 0; i < indices.size(); ++i) {
+      const int64_t index = static_cast<int64_t>(indices[i]);
+      if (index < 0 || index >= this->_size) {
+        return false;
+      }
+      target[i] = first[index];
+    }
+
+    return true;
+  }
+
+private:
+  void create(const Model& model, const Accessor& accessor) noexcept {
+    this->create(AccessorLayout::create(model, accessor));
+  }
 
-    if (sizeof(T) != accessorBytesPerStride) {
+  void create(const AccessorLayout& layout) noexcept {
+    if ((layout.status == AccessorViewStatus::Valid ||
+         layout.status == AccessorViewStatus::BufferViewTooSmall) &&
+        int64_t(sizeof(T)) != layout.bytesPerElement) {
       this->_status = AccessorViewStatus::WrongSizeT;
       return;
     }
 
-    const int64_t accessorBytes = accessorByteStride * accessor.count;
-    const int64_t bytesRemainingInBufferView =
-        pBufferView->byteLength -
-        (accessor.byteOffset + accessorByteStride * (accessor.count - 1) +
-         accessorBytesPerStride);
-    if (accessorBytes > pBufferView->byteLength ||
-        bytesRemainingInBufferView < 0) {
-      this->_status = AccessorViewStatus::BufferViewTooSmall;
+    if (layout.status != AccessorViewStatus::Valid) {
+      this->_status = layout.status;
       return;
     }
 
-    this->_pData = pBuffer->cesium.data.data();
-    this->_stride = accessorByteStride;
-    this->_offset = accessor.byteOffset + pBufferView->byteOffset;
-    this->_size = accessor.count;
+    this->_pData = layout.pData;
+    this->_stride = layout.stride;
+    this->_offset = layout.offset;
+    this->_size = layout.size;
     this->_status = AccessorViewStatus::Valid;
   }
 };
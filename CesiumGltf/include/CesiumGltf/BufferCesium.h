@@ -2,8 +2,7 @@
 
 #include "CesiumGltf/Library.h"
 
-#include <cstddef>
-#include <vector>
+#include <CesiumUtility/Allocator.h>
 
 namespace CesiumGltf {
 /**
@@ -13,7 +12,11 @@ namespace CesiumGltf {
 struct CESIUMGLTF_API BufferCesium final {
   /**
    * @brief The buffer's data.
+   *
+   * The data is allocated with the {@link CesiumUtility::getAllocator}, in the
+   * {@link CesiumUtility::AllocationCategory::GltfBuffer} category unless it
+   * was created in another one.
    */
-  std::vector<std::byte> data;
+  CesiumUtility::ByteVector data{CesiumUtility::AllocationCategory::GltfBuffer};
 };
 } // namespace CesiumGltf
@@ -7,6 +7,9 @@
 #include "CesiumGltf/Texture.h"
 #include "CesiumGltf/TextureView.h"
 
+#include <glm/vec2.hpp>
+#include <gsl/span>
+
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
@@ -125,6 +128,23 @@ public:
    */
   int64_t getFeatureID(double u, double v) const noexcept;
 
+  /**
+   * @brief Get the feature IDs from the texture at many texture coordinates.
+   * This gives the same feature IDs as calling {@link getFeatureID} for each
+   * of the texture coordinates, but is much faster for large batches, such as
+   * when picking or classifying many points at once.
+   *
+   * If the texture is somehow invalid, every feature ID is -1.
+   *
+   * @param uvs The texture coordinates. Each component must be within
+   * [0.0, 1.0].
+   * @param result The feature IDs at the nearest pixels to the texture
+   * coordinates. This must be at least as large as `uvs`.
+   */
+  void getFeatureIDs(
+      const gsl::span<const glm::dvec2>& uvs,
+      const gsl::span<int64_t>& result) const noexcept;
+
   /**
    * @brief Get the status of this view.
    *
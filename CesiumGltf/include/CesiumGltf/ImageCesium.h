@@ -3,6 +3,8 @@
 #include "CesiumGltf/Ktx2TranscodeTargets.h"
 #include "CesiumGltf/Library.h"
 
+#include <CesiumUtility/Allocator.h>
+
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -93,8 +95,13 @@ struct CESIUMGLTF_API ImageCesium final {
    * | 2                  | grey, alpha               |
    * | 3                  | red, green, blue          |
    * | 4                  | red, green, blue, alpha   |
+   *
+   * The pixels are allocated with the {@link CesiumUtility::getAllocator}, in
+   * the {@link CesiumUtility::AllocationCategory::ImagePixels} category unless
+   * they were created in another one.
    */
-  std::vector<std::byte> pixelData;
+  CesiumUtility::ByteVector pixelData{
+      CesiumUtility::AllocationCategory::ImagePixels};
 
   /**
    * @brief The effective size of this image, in bytes, for estimating resource
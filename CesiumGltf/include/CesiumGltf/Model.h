@@ -5,8 +5,10 @@
 #include <CesiumUtility/ErrorList.h>
 
 #include <glm/mat4x4.hpp>
+#include <gsl/span>
 
 #include <functional>
+#include <vector>
 
 namespace CesiumGltf {
 
@@ -25,6 +27,19 @@ struct CESIUMGLTF_API Model : public ModelSpec {
    */
   CesiumUtility::ErrorList merge(Model&& rhs);
 
+  /**
+   * @brief Merges several other models into this one.
+   *
+   * This gives the same elements as merging the models one after another
+   * with {@link merge}, but each vector of elements grows only once, and the
+   * default scenes of all of the models are combined into a single new scene,
+   * rather than into a new scene for each model. The elements of the given
+   * models are moved into this one, rather than copied.
+   *
+   * @param models The models to merge into this one.
+   */
+  CesiumUtility::ErrorList mergeAll(const gsl::span<Model>& models);
+
   /**
    * @brief A callback function for {@link forEachRootNodeInScene}.
    */
@@ -160,6 +175,47 @@ struct CESIUMGLTF_API Model : public ModelSpec {
       int32_t sceneID,
       std::function<ForEachPrimitiveInSceneConstCallback>&& callback) const;
 
+  /**
+   * @brief A primitive found by {@link getPrimitivesInScene}, with the node
+   * and mesh it belongs to and the transform of that node.
+   */
+  struct ScenePrimitive {
+    /**
+     * @brief The node that uses the mesh.
+     */
+    const Node* pNode;
+
+    /**
+     * @brief The mesh that contains the primitive.
+     */
+    const Mesh* pMesh;
+
+    /**
+     * @brief The primitive.
+     */
+    const MeshPrimitive* pPrimitive;
+
+    /**
+     * @brief The transform of the node, relative to the root of the scene.
+     */
+    glm::dmat4 transform;
+  };
+
+  /**
+   * @brief Gets the primitives that {@link forEachPrimitiveInScene} would
+   * visit, in the same order and with the same transforms.
+   *
+   * Once the scene is flattened into a list, the primitives can be processed
+   * independently, for example on several threads. The pointers refer into
+   * this model, so they stay valid only as long as its nodes and meshes are
+   * not added to or removed.
+   *
+   * @param sceneID The scene ID (index), chosen as in
+   * {@link forEachPrimitiveInScene}.
+   * @return The primitives in the scene.
+   */
+  std::vector<ScenePrimitive> getPrimitivesInScene(int32_t sceneID) const;
+
   /**
    * @brief Fills in smooth normals for any primitives with missing normals.
    */
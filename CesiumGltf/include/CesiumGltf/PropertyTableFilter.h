@@ -0,0 +1,150 @@
+#pragma once
+
+#include "CesiumGltf/Library.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CesiumGltf {
+class PropertyTableView;
+
+/**
+ * @brief A predicate on the properties of the features of a
+ * {@link PropertyTable}, which can be evaluated for all of its features at
+ * once.
+ *
+ * Filters are built from comparisons of a property with a value, and are
+ * combined with {@link PropertyTableFilter::all},
+ * {@link PropertyTableFilter::any} and {@link PropertyTableFilter::negate}.
+ * For example, to find the buildings that are taller than 20 meters and are
+ * either residential or commercial:
+ *
+ * ```
+ * PropertyTableFilter filter = PropertyTableFilter::all(
+ *     {PropertyTableFilter::greater("height", 20.0),
+ *      PropertyTableFilter::isOneOf("use", {"residential", "commercial"})});
+ * std::vector<bool> visible = filter.evaluate(propertyTable);
+ * ```
+ *
+ * A filter is evaluated one column at a time rather than one feature at a
+ * time. Each property it uses is read once, for all features, in a single
+ * pass. Numeric properties are converted to `double`. String properties are
+ * dictionary-encoded with a {@link PropertyTableStringDictionary}, so
+ * comparing strings becomes comparing integers. A filter holds no reference
+ * to a property table, and can be evaluated from any thread.
+ *
+ * Scalar numeric and boolean properties can be compared to numbers. Booleans
+ * compare as 0 and 1. String properties can be compared to strings with
+ * {@link PropertyTableFilter::equal}, {@link PropertyTableFilter::notEqual}
+ * and {@link PropertyTableFilter::isOneOf}. A comparison on a feature that has
+ * no value for the property, on a property that doesn't exist or on a property
+ * of another type is false for that feature.
+ */
+class CESIUMGLTF_API PropertyTableFilter {
+public:
+  /**
+   * @brief Matches the features whose property equals a number.
+   */
+  static PropertyTableFilter equal(const std::string& property, double value);
+
+  /**
+   * @brief Matches the features whose property equals a string.
+   */
+  static PropertyTableFilter
+  equal(const std::string& property, const std::string& value);
+
+  /**
+   * @brief Matches the features whose property has a value that is not
+   * equal to a number.
+   */
+  static PropertyTableFilter
+  notEqual(const std::string& property, double value);
+
+  /**
+   * @brief Matches the features whose property has a value that is not
+   * equal to a string.
+   */
+  static PropertyTableFilter
+  notEqual(const std::string& property, const std::string& value);
+
+  /**
+   * @brief Matches the features whose property is less than a number.
+   */
+  static PropertyTableFilter less(const std::string& property, double value);
+
+  /**
+   * @brief Matches the features whose property is less than or equal to a
+   * number.
+   */
+  static PropertyTableFilter
+  lessOrEqual(const std::string& property, double value);
+
+  /**
+   * @brief Matches the features whose property is greater than a number.
+   */
+  static PropertyTableFilter
+  greater(const std::string& property, double value);
+
+  /**
+   * @brief Matches the features whose property is greater than or equal to a
+   * number.
+   */
+  static PropertyTableFilter
+  greaterOrEqual(const std::string& property, double value);
+
+  /**
+   * @brief Matches the features whose property is in the range
+   * `[minimum, maximum]`.
+   */
+  static PropertyTableFilter
+  inRange(const std::string& property, double minimum, double maximum);
+
+  /**
+   * @brief Matches the features whose property equals one of the numbers.
+   */
+  static PropertyTableFilter
+  isOneOf(const std::string& property, std::vector<double> values);
+
+  /**
+   * @brief Matches the features whose property equals one of the strings.
+   */
+  static PropertyTableFilter
+  isOneOf(const std::string& property, std::vector<std::string> values);
+
+  /**
+   * @brief Matches the features that match all of the filters. If there are
+   * no filters, this matches every feature.
+   */
+  static PropertyTableFilter all(std::vector<PropertyTableFilter> filters);
+
+  /**
+   * @brief Matches the features that match any of the filters. If there are
+   * no filters, this matches no feature.
+   */
+  static PropertyTableFilter any(std::vector<PropertyTableFilter> filters);
+
+  /**
+   * @brief Matches the features that don't match a filter.
+   */
+  static PropertyTableFilter negate(PropertyTableFilter filter);
+
+  /**
+   * @brief Evaluates this filter for all of the features of a property table.
+   *
+   * @param propertyTable The property table.
+   * @return One value for each feature, in the order of their feature IDs,
+   * which is true if the feature matches this filter. If the property table
+   * is invalid, this is empty.
+   */
+  std::vector<bool> evaluate(const PropertyTableView& propertyTable) const;
+
+  /** @private */
+  struct Node;
+
+private:
+  explicit PropertyTableFilter(std::shared_ptr<const Node>&& pNode) noexcept;
+
+  std::shared_ptr<const Node> _pNode;
+};
+} // namespace CesiumGltf
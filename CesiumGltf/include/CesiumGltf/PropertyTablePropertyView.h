@@ -7,9 +7,11 @@
 
 #include <gsl/span>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string_view>
 #include <type_traits>
 
@@ -375,6 +377,98 @@ public:
     }
   }
 
+  /**
+   * @brief Gets the values of a range of elements in the
+   * {@link PropertyTable}, exactly as {@link PropertyTablePropertyView::get}
+   * would return them.
+   *
+   * For numeric properties, the offset, scale, "no data" and default values
+   * are looked up once for the whole range instead of once per element.
+   *
+   * @param begin The index of the first element.
+   * @param end The index after the last element.
+   * @param result The values of the elements. It must hold at least
+   * `end - begin` values.
+   */
+  void getRange(
+      int64_t begin,
+      int64_t end,
+      const gsl::span<std::optional<ElementType>>& result) const noexcept {
+    const size_t count = getRangeSize(begin, end);
+    assert(result.size() >= count && "result must hold the whole range");
+
+    if (this->_status ==
+        PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) {
+      std::fill_n(result.begin(), count, this->defaultValue());
+      return;
+    }
+
+    if constexpr (IsMetadataNumeric<ElementType>::value) {
+      const gsl::span<const ElementType> values =
+          getNumericValues(begin, count);
+      const std::optional<ElementType> noData = this->noData();
+      const std::optional<ElementType> defaultValue = this->defaultValue();
+      const std::optional<ElementType> offset = this->offset();
+      const std::optional<ElementType> scale = this->scale();
+      for (size_t i = 0; i < count; ++i) {
+        if (noData && values[i] == *noData) {
+          result[i] = defaultValue;
+        } else {
+          result[i] = transformValue<ElementType>(values[i], offset, scale);
+        }
+      }
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        result[i] = this->get(begin + static_cast<int64_t>(i));
+      }
+    }
+  }
+
+  /**
+   * @brief Gets the values of a range of numeric elements in the
+   * {@link PropertyTable}, with the offset and scale applied.
+   * Elements equal to the "no data" value are set to the default value
+   * instead. If there is no default value, they are left unchanged in
+   * `result`.
+   *
+   * Because the values are written without a `std::optional` around them,
+   * the transforms of a property without a "no data" value are applied in
+   * simple loops that the compiler can vectorize. Prefer this to
+   * {@link PropertyTablePropertyView::get} when reading whole columns.
+   *
+   * @param begin The index of the first element.
+   * @param end The index after the last element.
+   * @param result The values of the elements. It must hold at least
+   * `end - begin` values.
+   */
+  void getRange(
+      int64_t begin,
+      int64_t end,
+      const gsl::span<ElementType>& result) const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "Only numeric properties can be read into plain values");
+    const size_t count = getRangeSize(begin, end);
+    assert(result.size() >= count && "result must hold the whole range");
+
+    if (this->_status ==
+        PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) {
+      if (this->defaultValue()) {
+        std::fill_n(result.begin(), count, *this->defaultValue());
+      }
+      return;
+    }
+
+    transformValues<ElementType>(
+        getNumericValues(begin, count),
+        result.first(count),
+        [](const ElementType& value) { return value; },
+        this->noData(),
+        this->defaultValue(),
+        this->offset(),
+        this->scale());
+  }
+
   /**
    * @brief Get the number of elements in this
    * PropertyTablePropertyView. If the view is valid, this returns
@@ -385,6 +479,20 @@ public:
   int64_t size() const noexcept { return _size; }
 
 private:
+  size_t getRangeSize(int64_t begin, int64_t end) const noexcept {
+    assert(begin >= 0 && "begin must be non-negative");
+    assert(begin <= end && "begin must not be greater than end");
+    assert(end <= size() && "end must not be greater than size");
+    return static_cast<size_t>(end - begin);
+  }
+
+  gsl::span<const ElementType>
+  getNumericValues(int64_t begin, size_t count) const noexcept {
+    return gsl::span<const ElementType>(
+        reinterpret_cast<const ElementType*>(_values.data()) + begin,
+        count);
+  }
+
   ElementType getNumericValue(int64_t index) const noexcept {
     return reinterpret_cast<const ElementType*>(_values.data())[index];
   }
@@ -749,6 +857,100 @@ public:
     }
   }
 
+  /**
+   * @brief Gets the values of a range of elements in the
+   * {@link PropertyTable}, exactly as {@link PropertyTablePropertyView::get}
+   * would return them.
+   *
+   * For numeric properties, the offset, scale, "no data" and default values
+   * are looked up once for the whole range instead of once per element.
+   *
+   * @param begin The index of the first element.
+   * @param end The index after the last element.
+   * @param result The values of the elements. It must hold at least
+   * `end - begin` values.
+   */
+  void getRange(
+      int64_t begin,
+      int64_t end,
+      const gsl::span<std::optional<NormalizedType>>& result) const noexcept {
+    const size_t count = getRangeSize(begin, end);
+    assert(result.size() >= count && "result must hold the whole range");
+
+    if (this->_status ==
+        PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) {
+      std::fill_n(result.begin(), count, this->defaultValue());
+      return;
+    }
+
+    if constexpr (IsMetadataNumeric<ElementType>::value) {
+      const gsl::span<const ElementType> values = getValues(begin, count);
+      const std::optional<ElementType> noData = this->noData();
+      const std::optional<NormalizedType> defaultValue = this->defaultValue();
+      const std::optional<NormalizedType> offset = this->offset();
+      const std::optional<NormalizedType> scale = this->scale();
+      for (size_t i = 0; i < count; ++i) {
+        if (noData && values[i] == *noData) {
+          result[i] = defaultValue;
+        } else {
+          result[i] = transformValue<NormalizedType>(
+              normalizeValue(values[i]),
+              offset,
+              scale);
+        }
+      }
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        result[i] = this->get(begin + static_cast<int64_t>(i));
+      }
+    }
+  }
+
+  /**
+   * @brief Gets the values of a range of numeric elements in the
+   * {@link PropertyTable}, normalized and with the offset and scale
+   * applied. Elements equal to the "no data" value are set to the default value
+   * instead. If there is no default value, they are left unchanged in
+   * `result`.
+   *
+   * Because the values are written without a `std::optional` around them,
+   * the transforms of a property without a "no data" value are applied in
+   * simple loops that the compiler can vectorize. Prefer this to
+   * {@link PropertyTablePropertyView::get} when reading whole columns.
+   *
+   * @param begin The index of the first element.
+   * @param end The index after the last element.
+   * @param result The values of the elements. It must hold at least
+   * `end - begin` values.
+   */
+  void getRange(
+      int64_t begin,
+      int64_t end,
+      const gsl::span<NormalizedType>& result) const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "Only numeric properties can be read into plain values");
+    const size_t count = getRangeSize(begin, end);
+    assert(result.size() >= count && "result must hold the whole range");
+
+    if (this->_status ==
+        PropertyTablePropertyViewStatus::EmptyPropertyWithDefault) {
+      if (this->defaultValue()) {
+        std::fill_n(result.begin(), count, *this->defaultValue());
+      }
+      return;
+    }
+
+    transformValues<NormalizedType>(
+        getValues(begin, count),
+        result.first(count),
+        [](const ElementType& value) { return normalizeValue(value); },
+        this->noData(),
+        this->defaultValue(),
+        this->offset(),
+        this->scale());
+  }
+
   /**
    * @brief Get the number of elements in this
    * PropertyTablePropertyView. If the view is valid, this returns
@@ -761,6 +963,30 @@ public:
   }
 
 private:
+  size_t getRangeSize(int64_t begin, int64_t end) const noexcept {
+    assert(begin >= 0 && "begin must be non-negative");
+    assert(begin <= end && "begin must not be greater than end");
+    assert(end <= size() && "end must not be greater than size");
+    return static_cast<size_t>(end - begin);
+  }
+
+  gsl::span<const ElementType>
+  getValues(int64_t begin, size_t count) const noexcept {
+    return gsl::span<const ElementType>(
+        reinterpret_cast<const ElementType*>(_values.data()) + begin,
+        count);
+  }
+
+  static NormalizedType normalizeValue(const ElementType& value) noexcept {
+    if constexpr (IsMetadataScalar<ElementType>::value) {
+      return normalize<ElementType>(value);
+    } else {
+      constexpr glm::length_t N = ElementType::length();
+      using T = typename ElementType::value_type;
+      return normalize<N, T>(value);
+    }
+  }
+
   ElementType getValue(int64_t index) const noexcept {
     return reinterpret_cast<const ElementType*>(_values.data())[index];
   }
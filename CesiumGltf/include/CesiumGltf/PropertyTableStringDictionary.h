@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CesiumGltf/Library.h"
+#include "CesiumGltf/PropertyTablePropertyView.h"
+
+#include <gsl/span>
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumGltf {
+/**
+ * @brief A dictionary encoding of a string property of a
+ * {@link PropertyTable}.
+ *
+ * Each distinct value of the property is stored once, and each element of the
+ * property is an index into those values. Once it is created, comparing or
+ * categorizing elements only needs integer comparisons, instead of decoding
+ * string offsets and comparing strings for each element. This is most useful
+ * for properties with few distinct values, such as building types or land use
+ * classes.
+ *
+ * The values are views on the data of the property, so the
+ * {@link PropertyTablePropertyView} and the buffers it views must outlive the
+ * dictionary.
+ */
+class CESIUMGLTF_API PropertyTableStringDictionary {
+public:
+  /**
+   * @brief The index of the elements that have no value, because they are
+   * equal to the "no data" value of a property without a default value.
+   */
+  static constexpr uint32_t NoValue = 0xffffffff;
+
+  /**
+   * @brief Creates the dictionary of a string property. This reads every
+   * element of the property once.
+   *
+   * If the property is invalid, the dictionary is empty.
+   *
+   * @param property The string property.
+   */
+  explicit PropertyTableStringDictionary(
+      const PropertyTablePropertyView<std::string_view>& property);
+
+  /**
+   * @brief Gets the distinct values of the property, in the order in which
+   * they first appear.
+   */
+  const std::vector<std::string_view>& getValues() const noexcept {
+    return this->_values;
+  }
+
+  /**
+   * @brief Gets the index in {@link getValues} of the value of each element,
+   * or {@link NoValue} for elements that have no value.
+   */
+  gsl::span<const uint32_t> getIndices() const noexcept {
+    return this->_indices;
+  }
+
+  /**
+   * @brief Gets the index in {@link getValues} of the value of an element, or
+   * {@link NoValue} if the element has no value.
+   *
+   * @param index The index of the element.
+   */
+  uint32_t getIndex(int64_t index) const noexcept {
+    assert(index >= 0 && "index must be non-negative");
+    assert(index < this->size() && "index must be less than size");
+    return this->_indices[static_cast<size_t>(index)];
+  }
+
+  /**
+   * @brief Finds the index of a value in {@link getValues}.
+   *
+   * Elements can then be compared to the value by comparing their
+   * {@link getIndex} to this index.
+   *
+   * @param value The value to find.
+   * @return The index of the value, or `std::nullopt` if no element of the
+   * property has this value.
+   */
+  std::optional<uint32_t> find(std::string_view value) const noexcept;
+
+  /**
+   * @brief Gets the number of elements of the property.
+   */
+  int64_t size() const noexcept {
+    return static_cast<int64_t>(this->_indices.size());
+  }
+
+private:
+  std::vector<std::string_view> _values;
+  std::unordered_map<std::string_view, uint32_t> _valueIndices;
+  std::vector<uint32_t> _indices;
+};
+} // namespace CesiumGltf
@@ -8,9 +8,21 @@
 #include <glm/common.hpp>
 
 #include <optional>
+#include <tuple>
 
 namespace CesiumGltf {
 
+namespace CesiumImpl {
+template <typename PropertyViewType> struct PropertyTablePropertyViewTraits;
+
+template <typename T, bool Normalized>
+struct PropertyTablePropertyViewTraits<
+    PropertyTablePropertyView<T, Normalized>> {
+  using ElementType = T;
+  static constexpr bool normalized = Normalized;
+};
+} // namespace CesiumImpl
+
 /**
  * @brief Indicates the status of a property table view.
  *
@@ -304,6 +316,69 @@ public:
             PropertyTablePropertyViewStatus::ErrorTypeMismatch));
   }
 
+  /**
+   * @brief Gets a {@link PropertyTablePropertyView} through a callback, like
+   * {@link getPropertyView}, but only for the given types of views.
+   *
+   * The other callback overload creates a view, and calls the callback, for
+   * every type that a property may have, so both are instantiated more than
+   * a hundred times. This one only instantiates those listed in
+   * `PropertyViewTypes`, each a {@link PropertyTablePropertyView} with its
+   * element type and normalization, which keeps code that handles only a few
+   * types smaller and faster to compile. The type of the property is compared
+   * with each listed type before any view is created.
+   *
+   * If the property is invalid, or doesn't have any of the listed types, the
+   * callback receives an invalid view of the first listed type, with an error
+   * status.
+   *
+   * @tparam PropertyViewTypes The types of the views to pass to the callback,
+   * such as `PropertyTablePropertyView<glm::vec3>` or
+   * `PropertyTablePropertyView<uint8_t, true>`.
+   * @param propertyId The id of the property to retrieve data from
+   * @param callback A callback function that accepts a property id and a view
+   * of one of the listed types.
+   */
+  template <typename... PropertyViewTypes, typename Callback>
+  void getPropertyViewOfTypes(
+      const std::string& propertyId,
+      Callback&& callback) const {
+    static_assert(
+        sizeof...(PropertyViewTypes) > 0,
+        "At least one type of view must be given");
+    using FirstViewType =
+        std::tuple_element_t<0, std::tuple<PropertyViewTypes...>>;
+
+    if (this->size() <= 0) {
+      callback(
+          propertyId,
+          FirstViewType(
+              PropertyTablePropertyViewStatus::ErrorInvalidPropertyTable));
+      return;
+    }
+
+    const ClassProperty* pClassProperty = getClassProperty(propertyId);
+    if (!pClassProperty) {
+      callback(
+          propertyId,
+          FirstViewType(
+              PropertyTablePropertyViewStatus::ErrorNonexistentProperty));
+      return;
+    }
+
+    const bool found =
+        (this->getPropertyViewIfType<PropertyViewTypes>(
+             propertyId,
+             *pClassProperty,
+             callback) ||
+         ...);
+    if (!found) {
+      callback(
+          propertyId,
+          FirstViewType(PropertyTablePropertyViewStatus::ErrorTypeMismatch));
+    }
+  }
+
   /**
    * @brief Iterates over each property in the {@link PropertyTable} with a callback
    * that accepts a property id and a {@link PropertyTablePropertyView<T>} to view
@@ -332,6 +407,34 @@ public:
   }
 
 private:
+  template <typename PropertyViewType, typename Callback>
+  bool getPropertyViewIfType(
+      const std::string& propertyId,
+      const ClassProperty& classProperty,
+      Callback& callback) const {
+    using Traits =
+        CesiumImpl::PropertyTablePropertyViewTraits<PropertyViewType>;
+    using T = typename Traits::ElementType;
+    if (classProperty.normalized != Traits::normalized) {
+      return false;
+    }
+
+    PropertyViewStatusType status;
+    if constexpr (IsMetadataArray<T>::value) {
+      status = validateArrayPropertyType<T>(classProperty);
+    } else {
+      status = validatePropertyType<T>(classProperty);
+    }
+    if (status != PropertyViewStatus::Valid) {
+      return false;
+    }
+
+    callback(
+        propertyId,
+        getPropertyViewImpl<T, Traits::normalized>(propertyId, classProperty));
+    return true;
+  }
+
   template <typename Callback, bool Normalized>
   void getScalarArrayPropertyViewImpl(
       const std::string& propertyId,
@@ -9,6 +9,7 @@
 #include "CesiumGltf/Sampler.h"
 #include "CesiumGltf/TextureView.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>
@@ -193,6 +194,43 @@ ElementType assembleValueFromChannels(const gsl::span<uint8_t> bytes) noexcept {
   }
 }
 
+/**
+ * @brief Samples the raw values of a property texture property at many texture
+ * coordinates, and calls a function with the index and value of each sample.
+ *
+ * The texture is sampled in chunks into a fixed buffer, so that no memory is
+ * allocated for the samples regardless of the number of texture coordinates.
+ *
+ * @private
+ */
+template <typename ElementType, typename Callback>
+void sampleRawValues(
+    const TextureView& texture,
+    const std::vector<int64_t>& channels,
+    const gsl::span<const glm::dvec2>& uvs,
+    Callback&& callback) {
+  std::array<uint8_t, 1024> samples;
+  const size_t channelCount = channels.size();
+  const size_t chunkSize = samples.size() / std::max<size_t>(channelCount, 1);
+
+  for (size_t begin = 0; begin < uvs.size(); begin += chunkSize) {
+    const size_t count = std::min(chunkSize, uvs.size() - begin);
+    texture.sampleNearestPixels(
+        uvs.subspan(begin, count),
+        channels,
+        gsl::span<uint8_t>(samples.data(), count * channelCount));
+
+    uint8_t* pSample = samples.data();
+    for (size_t i = 0; i < count; ++i) {
+      callback(
+          begin + i,
+          assembleValueFromChannels<ElementType>(
+              gsl::span<uint8_t>(pSample, channelCount)));
+      pSample += channelCount;
+    }
+  }
+}
+
 #pragma region Non - normalized property
 
 /**
@@ -376,21 +414,42 @@ public:
       return this->defaultValue();
     }
 
-    ElementType value = getRaw(u, v);
+    return this->transformRawValue(getRaw(u, v));
+  }
 
-    if (value == this->noData()) {
-      return this->defaultValue();
-    }
+  /**
+   * @brief Gets the values of the property for many texture coordinates, with
+   * all value transforms applied. This gives the same values as calling
+   * {@link PropertyTexturePropertyView::get} for each of the texture
+   * coordinates, but is much faster for large batches, because the texture
+   * transform, wrap modes and image are looked up once for all of them.
+   *
+   * @param uvs The texture coordinates.
+   * @param result The values of the elements, or std::nullopt for those that
+   * match the "no data" value. This must be at least as large as `uvs`.
+   */
+  void get(
+      const gsl::span<const glm::dvec2>& uvs,
+      const gsl::span<std::optional<ElementType>>& result) const noexcept {
+    assert(result.size() >= uvs.size());
 
-    if constexpr (IsMetadataNumeric<ElementType>::value) {
-      value = transformValue(value, this->offset(), this->scale());
+    if (this->_status ==
+        PropertyTexturePropertyViewStatus::EmptyPropertyWithDefault) {
+      std::fill_n(result.begin(), uvs.size(), this->defaultValue());
+      return;
     }
 
-    if constexpr (IsMetadataNumericArray<ElementType>::value) {
-      value = transformArray(value, this->offset(), this->scale());
-    }
+    assert(
+        this->_status == PropertyTexturePropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
 
-    return value;
+    sampleRawValues<ElementType>(
+        *this,
+        this->_channels,
+        uvs,
+        [this, &result](size_t i, ElementType&& value) {
+          result[i] = this->transformRawValue(std::move(value));
+        });
   }
 
   /**
@@ -432,6 +491,23 @@ public:
   const std::string& getSwizzle() const noexcept { return this->_swizzle; }
 
 private:
+  std::optional<ElementType>
+  transformRawValue(ElementType value) const noexcept {
+    if (value == this->noData()) {
+      return this->defaultValue();
+    }
+
+    if constexpr (IsMetadataNumeric<ElementType>::value) {
+      value = transformValue(value, this->offset(), this->scale());
+    }
+
+    if constexpr (IsMetadataNumericArray<ElementType>::value) {
+      value = transformArray(value, this->offset(), this->scale());
+    }
+
+    return value;
+  }
+
   std::vector<int64_t> _channels;
   std::string _swizzle;
 };
@@ -607,47 +683,43 @@ public:
       return this->defaultValue();
     }
 
-    ElementType value = getRaw(u, v);
-
-    if (value == this->noData()) {
-      return this->defaultValue();
-    }
+    return this->transformRawValue(getRaw(u, v));
+  }
 
-    if constexpr (IsMetadataScalar<ElementType>::value) {
-      return transformValue<NormalizedType>(
-          normalize<ElementType>(value),
-          this->offset(),
-          this->scale());
-    }
+  /**
+   * @brief Gets the normalized values of the property for many texture
+   * coordinates, with all value transforms applied. This gives the same values
+   * as calling {@link PropertyTexturePropertyView::get} for each of the
+   * texture coordinates, but is much faster for large batches, because the
+   * texture transform, wrap modes and image are looked up once for all of
+   * them.
+   *
+   * @param uvs The texture coordinates.
+   * @param result The values of the elements, or std::nullopt for those that
+   * match the "no data" value. This must be at least as large as `uvs`.
+   */
+  void get(
+      const gsl::span<const glm::dvec2>& uvs,
+      const gsl::span<std::optional<NormalizedType>>& result) const noexcept {
+    assert(result.size() >= uvs.size());
 
-    if constexpr (IsMetadataVecN<ElementType>::value) {
-      constexpr glm::length_t N = ElementType::length();
-      using T = typename ElementType::value_type;
-      using NormalizedT = typename NormalizedType::value_type;
-      return transformValue<glm::vec<N, NormalizedT>>(
-          normalize<N, T>(value),
-          this->offset(),
-          this->scale());
+    if (this->_status ==
+        PropertyTexturePropertyViewStatus::EmptyPropertyWithDefault) {
+      std::fill_n(result.begin(), uvs.size(), this->defaultValue());
+      return;
     }
 
-    if constexpr (IsMetadataArray<ElementType>::value) {
-      using ArrayElementType = typename MetadataArrayType<ElementType>::type;
-      if constexpr (IsMetadataScalar<ArrayElementType>::value) {
-        return transformNormalizedArray<ArrayElementType>(
-            value,
-            this->offset(),
-            this->scale());
-      }
+    assert(
+        this->_status == PropertyTexturePropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
 
-      if constexpr (IsMetadataVecN<ArrayElementType>::value) {
-        constexpr glm::length_t N = ArrayElementType::length();
-        using T = typename ArrayElementType::value_type;
-        return transformNormalizedVecNArray<N, T>(
-            value,
-            this->offset(),
-            this->scale());
-      }
-    }
+    sampleRawValues<ElementType>(
+        *this,
+        this->_channels,
+        uvs,
+        [this, &result](size_t i, ElementType&& value) {
+          result[i] = this->transformRawValue(std::move(value));
+        });
   }
 
   /**
@@ -689,6 +761,49 @@ public:
   const std::string& getSwizzle() const noexcept { return this->_swizzle; }
 
 private:
+  std::optional<NormalizedType>
+  transformRawValue(const ElementType& value) const noexcept {
+    if (value == this->noData()) {
+      return this->defaultValue();
+    }
+
+    if constexpr (IsMetadataScalar<ElementType>::value) {
+      return transformValue<NormalizedType>(
+          normalize<ElementType>(value),
+          this->offset(),
+          this->scale());
+    }
+
+    if constexpr (IsMetadataVecN<ElementType>::value) {
+      constexpr glm::length_t N = ElementType::length();
+      using T = typename ElementType::value_type;
+      using NormalizedT = typename NormalizedType::value_type;
+      return transformValue<glm::vec<N, NormalizedT>>(
+          normalize<N, T>(value),
+          this->offset(),
+          this->scale());
+    }
+
+    if constexpr (IsMetadataArray<ElementType>::value) {
+      using ArrayElementType = typename MetadataArrayType<ElementType>::type;
+      if constexpr (IsMetadataScalar<ArrayElementType>::value) {
+        return transformNormalizedArray<ArrayElementType>(
+            value,
+            this->offset(),
+            this->scale());
+      }
+
+      if constexpr (IsMetadataVecN<ArrayElementType>::value) {
+        constexpr glm::length_t N = ArrayElementType::length();
+        using T = typename ArrayElementType::value_type;
+        return transformNormalizedVecNArray<N, T>(
+            value,
+            this->offset(),
+            this->scale());
+      }
+    }
+  }
+
   std::vector<int64_t> _channels;
   std::string _swizzle;
 };
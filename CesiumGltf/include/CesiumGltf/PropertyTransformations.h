@@ -4,8 +4,10 @@
 #include "CesiumGltf/PropertyTypeTraits.h"
 
 #include <glm/common.hpp>
+#include <gsl/span>
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 
@@ -78,6 +80,61 @@ T transformValue(
   return result;
 }
 
+/**
+ * @brief Transforms a range of values like {@link transformValue} does for one
+ * value, after converting them with `convert`. Values equal to `noData` are
+ * replaced by `defaultValue`, or are left unchanged in `result` if there is no
+ * default value.
+ *
+ * The offset, scale and "no data" value are checked once for the whole range,
+ * so that the compiler can vectorize the loops over the values.
+ */
+template <typename T, typename RawType, typename Convert>
+void transformValues(
+    const gsl::span<const RawType>& values,
+    const gsl::span<T>& result,
+    Convert convert,
+    const std::optional<RawType>& noData,
+    const std::optional<T>& defaultValue,
+    const std::optional<T>& offset,
+    const std::optional<T>& scale) {
+  const RawType* pValues = values.data();
+  T* pResult = result.data();
+  const size_t count = values.size();
+
+  if (noData) {
+    for (size_t i = 0; i < count; ++i) {
+      if (pValues[i] == *noData) {
+        if (defaultValue) {
+          pResult[i] = *defaultValue;
+        }
+      } else {
+        pResult[i] = transformValue<T>(convert(pValues[i]), offset, scale);
+      }
+    }
+  } else if (offset && scale) {
+    const T offsetValue = *offset;
+    const T scaleValue = *scale;
+    for (size_t i = 0; i < count; ++i) {
+      pResult[i] = applyScale<T>(convert(pValues[i]), scaleValue) + offsetValue;
+    }
+  } else if (scale) {
+    const T scaleValue = *scale;
+    for (size_t i = 0; i < count; ++i) {
+      pResult[i] = applyScale<T>(convert(pValues[i]), scaleValue);
+    }
+  } else if (offset) {
+    const T offsetValue = *offset;
+    for (size_t i = 0; i < count; ++i) {
+      pResult[i] = convert(pValues[i]) + offsetValue;
+    }
+  } else {
+    for (size_t i = 0; i < count; ++i) {
+      pResult[i] = convert(pValues[i]);
+    }
+  }
+}
+
 template <typename T>
 PropertyArrayView<T> transformArray(
     const PropertyArrayView<T>& value,
@@ -5,6 +5,9 @@
 #include "CesiumGltf/Sampler.h"
 #include "CesiumGltf/TextureInfo.h"
 
+#include <glm/vec2.hpp>
+#include <gsl/span>
+
 #include <vector>
 
 namespace CesiumGltf {
@@ -206,6 +209,25 @@ public:
       double v,
       const std::vector<int64_t>& channels) const noexcept;
 
+  /**
+   * @brief Samples the image at many texture coordinates using NEAREST pixel
+   * filtering, like {@link sampleNearestPixel} does for each of them.
+   *
+   * The texture transform, wrap modes and image are looked up once for all
+   * of the coordinates, and no memory is allocated, so this is much faster
+   * than sampling each pixel separately.
+   *
+   * @param uvs The texture coordinates.
+   * @param channels The image channels to retrieve, in order.
+   * @param result The bytes of the samples. The bytes of each sample are
+   * consecutive, so the sample of `uvs[i]` starts at `i * channels.size()`.
+   * This must hold `uvs.size() * channels.size()` bytes.
+   */
+  void sampleNearestPixels(
+      const gsl::span<const glm::dvec2>& uvs,
+      const std::vector<int64_t>& channels,
+      const gsl::span<uint8_t>& result) const noexcept;
+
 private:
   TextureViewStatus _textureViewStatus;
 
@@ -37,6 +37,65 @@ getNormalAccessorView(const Model& model, const MeshPrimitive& primitive) {
   return NormalAccessorType(model, *pAccessor);
 }
 
+QuantizedPositionAccessorType getQuantizedPositionAccessorView(
+    const Model& model,
+    const MeshPrimitive& primitive) {
+  auto positionAttribute = primitive.attributes.find("POSITION");
+  if (positionAttribute == primitive.attributes.end()) {
+    return QuantizedPositionAccessorType();
+  }
+
+  const Accessor* pAccessor =
+      model.getSafe<Accessor>(&model.accessors, positionAttribute->second);
+  if (!pAccessor || pAccessor->type != Accessor::Type::VEC3) {
+    return QuantizedPositionAccessorType();
+  }
+
+  switch (pAccessor->componentType) {
+  case Accessor::ComponentType::BYTE:
+    return AccessorView<AccessorTypes::VEC3<int8_t>>(model, *pAccessor);
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    return AccessorView<AccessorTypes::VEC3<uint8_t>>(model, *pAccessor);
+  case Accessor::ComponentType::SHORT:
+    return AccessorView<AccessorTypes::VEC3<int16_t>>(model, *pAccessor);
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    return AccessorView<AccessorTypes::VEC3<uint16_t>>(model, *pAccessor);
+  case Accessor::ComponentType::FLOAT:
+    return AccessorView<AccessorTypes::VEC3<float>>(model, *pAccessor);
+  default:
+    return QuantizedPositionAccessorType();
+  }
+}
+
+AccessorDequantization getAccessorDequantization(const Accessor& accessor) {
+  AccessorDequantization result;
+  if (!accessor.normalized) {
+    return result;
+  }
+
+  switch (accessor.componentType) {
+  case Accessor::ComponentType::BYTE:
+    result.scale = 1.0 / std::numeric_limits<int8_t>::max();
+    result.minimum = -1.0;
+    break;
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    result.scale = 1.0 / std::numeric_limits<uint8_t>::max();
+    break;
+  case Accessor::ComponentType::SHORT:
+    result.scale = 1.0 / std::numeric_limits<int16_t>::max();
+    result.minimum = -1.0;
+    break;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    result.scale = 1.0 / std::numeric_limits<uint16_t>::max();
+    break;
+  case Accessor::ComponentType::UNSIGNED_INT:
+    result.scale = 1.0 / std::numeric_limits<uint32_t>::max();
+    break;
+  }
+
+  return result;
+}
+
 FeatureIdAccessorType getFeatureIdAccessorView(
     const Model& model,
     const MeshPrimitive& primitive,
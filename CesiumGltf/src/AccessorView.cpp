@@ -0,0 +1,69 @@
+#include "CesiumGltf/AccessorView.h"
+
+namespace CesiumGltf {
+
+/*static*/ AccessorLayout
+AccessorLayout::create(const Model& model, const Accessor& accessor) noexcept {
+  AccessorLayout layout;
+
+  const CesiumGltf::BufferView* pBufferView =
+      Model::getSafe(&model.bufferViews, accessor.bufferView);
+  if (!pBufferView) {
+    layout.status = AccessorViewStatus::InvalidBufferViewIndex;
+    return layout;
+  }
+
+  const CesiumGltf::Buffer* pBuffer =
+      Model::getSafe(&model.buffers, pBufferView->buffer);
+  if (!pBuffer) {
+    layout.status = AccessorViewStatus::InvalidBufferIndex;
+    return layout;
+  }
+
+  const CesiumUtility::ByteVector& data = pBuffer->cesium.data;
+  const int64_t bufferBytes = int64_t(data.size());
+  if (pBufferView->byteOffset + pBufferView->byteLength > bufferBytes) {
+    layout.status = AccessorViewStatus::BufferTooSmall;
+    return layout;
+  }
+
+  const int64_t accessorByteStride = accessor.computeByteStride(model);
+  const int64_t accessorBytesPerStride = accessor.computeBytesPerVertex();
+  layout.bytesPerElement = accessorBytesPerStride;
+
+  const int64_t accessorBytes = accessorByteStride * accessor.count;
+  const int64_t bytesRemainingInBufferView =
+      pBufferView->byteLength -
+      (accessor.byteOffset + accessorByteStride * (accessor.count - 1) +
+       accessorBytesPerStride);
+  if (accessorBytes > pBufferView->byteLength ||
+      bytesRemainingInBufferView < 0) {
+    layout.status = AccessorViewStatus::BufferViewTooSmall;
+    return layout;
+  }
+
+  layout.pData = data.data();
+  layout.stride = accessorByteStride;
+  layout.offset = accessor.byteOffset + pBufferView->byteOffset;
+  layout.size = accessor.count;
+  layout.status = AccessorViewStatus::Valid;
+  return layout;
+}
+
+AccessorLayoutCache::AccessorLayoutCache(const Model& model) {
+  this->_layouts.reserve(model.accessors.size());
+  for (const Accessor& accessor : model.accessors) {
+    this->_layouts.emplace_back(AccessorLayout::create(model, accessor));
+  }
+}
+
+const AccessorLayout&
+AccessorLayoutCache::get(int32_t accessorIndex) const noexcept {
+  static const AccessorLayout invalidLayout;
+  if (accessorIndex < 0 || size_t(accessorIndex) >= this->_layouts.size()) {
+    return invalidLayout;
+  }
+  return this->_layouts[size_t(accessorIndex)];
+}
+
+} // namespace CesiumGltf
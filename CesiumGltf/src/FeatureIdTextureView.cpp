@@ -4,6 +4,9 @@
 #include "CesiumGltf/Model.h"
 #include "CesiumGltf/SamplerUtility.h"
 
+#include <array>
+#include <cassert>
+
 namespace CesiumGltf {
 FeatureIdTextureView::FeatureIdTextureView() noexcept
     : TextureView(),
@@ -79,4 +82,39 @@ int64_t FeatureIdTextureView::getFeatureID(double u, double v) const noexcept {
 
   return value;
 }
+
+void FeatureIdTextureView::getFeatureIDs(
+    const gsl::span<const glm::dvec2>& uvs,
+    const gsl::span<int64_t>& result) const noexcept {
+  assert(result.size() >= uvs.size());
+
+  if (this->_status != FeatureIdTextureViewStatus::Valid) {
+    std::fill_n(result.begin(), uvs.size(), -1);
+    return;
+  }
+
+  // Sample the texture in chunks that fit in a fixed buffer, so that no memory
+  // is allocated regardless of the number of texture coordinates.
+  std::array<uint8_t, 1024> samples;
+  const size_t channelCount = this->_channels.size();
+  const size_t chunkSize = samples.size() / std::max<size_t>(channelCount, 1);
+
+  for (size_t begin = 0; begin < uvs.size(); begin += chunkSize) {
+    const size_t count = std::min(chunkSize, uvs.size() - begin);
+    this->sampleNearestPixels(
+        uvs.subspan(begin, count),
+        this->_channels,
+        gsl::span<uint8_t>(samples.data(), count * channelCount));
+
+    const uint8_t* pSample = samples.data();
+    for (size_t i = 0; i < count; ++i) {
+      int64_t value = 0;
+      for (size_t j = 0; j < channelCount; ++j) {
+        value |= static_cast<int64_t>(pSample[j]) << (8 * j);
+      }
+      result[begin + i] = value;
+      pSample += channelCount;
+    }
+  }
+}
 } // namespace CesiumGltf
@@ -29,14 +29,25 @@ namespace {
 template <typename T>
 size_t copyElements(std::vector<T>& to, std::vector<T>& from) {
   const size_t out = to.size();
-  to.resize(out + from.size());
-  for (size_t i = 0; i < from.size(); ++i) {
-    to[out + i] = std::move(from[i]);
-  }
-
+  to.insert(
+      to.end(),
+      std::make_move_iterator(from.begin()),
+      std::make_move_iterator(from.end()));
   return out;
 }
 
+template <typename T>
+void reserveElements(
+    std::vector<T>& to,
+    const gsl::span<Model>& models,
+    std::vector<T> ModelSpec::*pElements) {
+  size_t count = to.size();
+  for (const Model& model : models) {
+    count += (model.*pElements).size();
+  }
+  to.reserve(count);
+}
+
 void updateIndex(int32_t& index, size_t offset) noexcept {
   if (index == -1) {
     return;
@@ -49,43 +60,41 @@ void mergeSchemas(
     Schema& rhs,
     std::map<std::string, std::string>& classNameMap);
 
-} // namespace
-
-ErrorList Model::merge(Model&& rhs) {
-  ErrorList result;
-
+// Moves the elements of rhs to the end of those of lhs, and updates the
+// indices in the moved elements. The default scenes are left alone. Returns
+// the index in lhs of the first scene of rhs.
+size_t appendElements(Model& lhs, Model& rhs, ErrorList& errors) {
   // TODO: we could generate this pretty easily if the glTF JSON schema made
   // it clear which index properties refer to which types of objects.
 
-  // Copy all the source data into this instance.
-  copyElements(this->extensionsUsed, rhs.extensionsUsed);
-  std::sort(this->extensionsUsed.begin(), this->extensionsUsed.end());
-  this->extensionsUsed.erase(
-      std::unique(this->extensionsUsed.begin(), this->extensionsUsed.end()),
-      this->extensionsUsed.end());
+  // Copy all the source data into lhs.
+  copyElements(lhs.extensionsUsed, rhs.extensionsUsed);
+  std::sort(lhs.extensionsUsed.begin(), lhs.extensionsUsed.end());
+  lhs.extensionsUsed.erase(
+      std::unique(lhs.extensionsUsed.begin(), lhs.extensionsUsed.end()),
+      lhs.extensionsUsed.end());
 
-  copyElements(this->extensionsRequired, rhs.extensionsRequired);
-  std::sort(this->extensionsRequired.begin(), this->extensionsRequired.end());
-  this->extensionsRequired.erase(
+  copyElements(lhs.extensionsRequired, rhs.extensionsRequired);
+  std::sort(lhs.extensionsRequired.begin(), lhs.extensionsRequired.end());
+  lhs.extensionsRequired.erase(
       std::unique(
-          this->extensionsRequired.begin(),
-          this->extensionsRequired.end()),
-      this->extensionsRequired.end());
-
-  const size_t firstAccessor = copyElements(this->accessors, rhs.accessors);
-  const size_t firstAnimation = copyElements(this->animations, rhs.animations);
-  const size_t firstBuffer = copyElements(this->buffers, rhs.buffers);
-  const size_t firstBufferView =
-      copyElements(this->bufferViews, rhs.bufferViews);
-  const size_t firstCamera = copyElements(this->cameras, rhs.cameras);
-  const size_t firstImage = copyElements(this->images, rhs.images);
-  const size_t firstMaterial = copyElements(this->materials, rhs.materials);
-  const size_t firstMesh = copyElements(this->meshes, rhs.meshes);
-  const size_t firstNode = copyElements(this->nodes, rhs.nodes);
-  const size_t firstSampler = copyElements(this->samplers, rhs.samplers);
-  const size_t firstScene = copyElements(this->scenes, rhs.scenes);
-  const size_t firstSkin = copyElements(this->skins, rhs.skins);
-  const size_t firstTexture = copyElements(this->textures, rhs.textures);
+          lhs.extensionsRequired.begin(),
+          lhs.extensionsRequired.end()),
+      lhs.extensionsRequired.end());
+
+  const size_t firstAccessor = copyElements(lhs.accessors, rhs.accessors);
+  const size_t firstAnimation = copyElements(lhs.animations, rhs.animations);
+  const size_t firstBuffer = copyElements(lhs.buffers, rhs.buffers);
+  const size_t firstBufferView = copyElements(lhs.bufferViews, rhs.bufferViews);
+  const size_t firstCamera = copyElements(lhs.cameras, rhs.cameras);
+  const size_t firstImage = copyElements(lhs.images, rhs.images);
+  const size_t firstMaterial = copyElements(lhs.materials, rhs.materials);
+  const size_t firstMesh = copyElements(lhs.meshes, rhs.meshes);
+  const size_t firstNode = copyElements(lhs.nodes, rhs.nodes);
+  const size_t firstSampler = copyElements(lhs.samplers, rhs.samplers);
+  const size_t firstScene = copyElements(lhs.scenes, rhs.scenes);
+  const size_t firstSkin = copyElements(lhs.skins, rhs.skins);
+  const size_t firstTexture = copyElements(lhs.textures, rhs.textures);
 
   size_t firstPropertyTable = 0;
   size_t firstPropertyTexture = 0;
@@ -95,13 +104,13 @@ ErrorList Model::merge(Model&& rhs) {
       rhs.getExtension<ExtensionModelExtStructuralMetadata>();
   if (pRhsMetadata) {
     ExtensionModelExtStructuralMetadata& metadata =
-        this->addExtension<ExtensionModelExtStructuralMetadata>();
+        lhs.addExtension<ExtensionModelExtStructuralMetadata>();
 
     if (metadata.schemaUri && pRhsMetadata->schemaUri &&
         *metadata.schemaUri != *pRhsMetadata->schemaUri) {
       // We can't merge schema URIs. So the thing to do here is download both
       // schemas and merge them. But for now we're just reporting an error.
-      result.emplaceError("Cannot merge EXT_structural_metadata extensions "
+      errors.emplaceError("Cannot merge EXT_structural_metadata extensions "
                           "with different schemaUris.");
     } else if (pRhsMetadata->schemaUri) {
       metadata.schemaUri = pRhsMetadata->schemaUri;
@@ -165,8 +174,8 @@ ErrorList Model::merge(Model&& rhs) {
   }
 
   // Update the copied indices
-  for (size_t i = firstAccessor; i < this->accessors.size(); ++i) {
-    Accessor& accessor = this->accessors[i];
+  for (size_t i = firstAccessor; i < lhs.accessors.size(); ++i) {
+    Accessor& accessor = lhs.accessors[i];
     updateIndex(accessor.bufferView, firstBufferView);
 
     if (accessor.sparse) {
@@ -175,8 +184,8 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
-  for (size_t i = firstAnimation; i < this->animations.size(); ++i) {
-    Animation& animation = this->animations[i];
+  for (size_t i = firstAnimation; i < lhs.animations.size(); ++i) {
+    Animation& animation = lhs.animations[i];
 
     for (AnimationChannel& channel : animation.channels) {
       updateIndex(channel.sampler, firstSampler);
@@ -189,8 +198,8 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
-  for (size_t i = firstBufferView; i < this->bufferViews.size(); ++i) {
-    BufferView& bufferView = this->bufferViews[i];
+  for (size_t i = firstBufferView; i < lhs.bufferViews.size(); ++i) {
+    BufferView& bufferView = lhs.bufferViews[i];
     updateIndex(bufferView.buffer, firstBuffer);
 
     ExtensionBufferViewExtMeshoptCompression* pMeshOpt =
@@ -200,13 +209,13 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
-  for (size_t i = firstImage; i < this->images.size(); ++i) {
-    Image& image = this->images[i];
+  for (size_t i = firstImage; i < lhs.images.size(); ++i) {
+    Image& image = lhs.images[i];
     updateIndex(image.bufferView, firstBufferView);
   }
 
-  for (size_t i = firstMesh; i < this->meshes.size(); ++i) {
-    Mesh& mesh = this->meshes[i];
+  for (size_t i = firstMesh; i < lhs.meshes.size(); ++i) {
+    Mesh& mesh = lhs.meshes[i];
 
     for (MeshPrimitive& primitive : mesh.primitives) {
       updateIndex(primitive.indices, firstAccessor);
@@ -269,8 +278,8 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
-  for (size_t i = firstNode; i < this->nodes.size(); ++i) {
-    Node& node = this->nodes[i];
+  for (size_t i = firstNode; i < lhs.nodes.size(); ++i) {
+    Node& node = lhs.nodes[i];
 
     updateIndex(node.camera, firstCamera);
     updateIndex(node.skin, firstSkin);
@@ -289,15 +298,15 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
-  for (size_t i = firstScene; i < this->scenes.size(); ++i) {
-    Scene& currentScene = this->scenes[i];
+  for (size_t i = firstScene; i < lhs.scenes.size(); ++i) {
+    Scene& currentScene = lhs.scenes[i];
     for (int32_t& node : currentScene.nodes) {
       updateIndex(node, firstNode);
     }
   }
 
-  for (size_t i = firstSkin; i < this->skins.size(); ++i) {
-    Skin& skin = this->skins[i];
+  for (size_t i = firstSkin; i < lhs.skins.size(); ++i) {
+    Skin& skin = lhs.skins[i];
 
     updateIndex(skin.inverseBindMatrices, firstAccessor);
     updateIndex(skin.skeleton, firstNode);
@@ -307,8 +316,8 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
-  for (size_t i = firstTexture; i < this->textures.size(); ++i) {
-    Texture& texture = this->textures[i];
+  for (size_t i = firstTexture; i < lhs.textures.size(); ++i) {
+    Texture& texture = lhs.textures[i];
 
     updateIndex(texture.sampler, firstSampler);
     updateIndex(texture.source, firstImage);
@@ -323,8 +332,8 @@ ErrorList Model::merge(Model&& rhs) {
       updateIndex(pWebP->source, firstImage);
   }
 
-  for (size_t i = firstMaterial; i < this->materials.size(); ++i) {
-    Material& material = this->materials[i];
+  for (size_t i = firstMaterial; i < lhs.materials.size(); ++i) {
+    Material& material = lhs.materials[i];
 
     if (material.normalTexture) {
       updateIndex(material.normalTexture.value().index, firstTexture);
@@ -346,6 +355,15 @@ ErrorList Model::merge(Model&& rhs) {
     }
   }
 
+  return firstScene;
+}
+
+} // namespace
+
+ErrorList Model::merge(Model&& rhs) {
+  ErrorList result;
+  const size_t firstScene = appendElements(*this, rhs, result);
+
   Scene* pThisDefaultScene = Model::getSafe(&this->scenes, this->scene);
   Scene* pRhsDefaultScene =
       Model::getSafe(&this->scenes, rhs.scene + int32_t(firstScene));
@@ -380,6 +398,65 @@ ErrorList Model::merge(Model&& rhs) {
   return result;
 }
 
+ErrorList Model::mergeAll(const gsl::span<Model>& models) {
+  ErrorList result;
+
+  // Grow each vector once for all of the models.
+  reserveElements(this->accessors, models, &ModelSpec::accessors);
+  reserveElements(this->animations, models, &ModelSpec::animations);
+  reserveElements(this->buffers, models, &ModelSpec::buffers);
+  reserveElements(this->bufferViews, models, &ModelSpec::bufferViews);
+  reserveElements(this->cameras, models, &ModelSpec::cameras);
+  reserveElements(this->images, models, &ModelSpec::images);
+  reserveElements(this->materials, models, &ModelSpec::materials);
+  reserveElements(this->meshes, models, &ModelSpec::meshes);
+  reserveElements(this->nodes, models, &ModelSpec::nodes);
+  reserveElements(this->samplers, models, &ModelSpec::samplers);
+  reserveElements(this->skins, models, &ModelSpec::skins);
+  reserveElements(this->textures, models, &ModelSpec::textures);
+  this->scenes.reserve(this->scenes.size() + models.size() + 1);
+
+  // The default scenes are combined at the end, so that there's only one
+  // combined scene rather than one per model.
+  std::vector<int32_t> defaultScenes;
+  if (Model::getSafe(&this->scenes, this->scene)) {
+    defaultScenes.emplace_back(this->scene);
+  }
+
+  for (Model& model : models) {
+    const size_t firstScene = appendElements(*this, model, result);
+    const int32_t modelScene =
+        model.scene < 0 ? -1 : model.scene + int32_t(firstScene);
+    if (Model::getSafe(&this->scenes, modelScene)) {
+      defaultScenes.emplace_back(modelScene);
+    }
+  }
+
+  if (defaultScenes.size() == 1) {
+    this->scene = defaultScenes[0];
+  } else if (defaultScenes.size() > 1) {
+    Scene newScene;
+    size_t nodeCount = 0;
+    for (int32_t sceneIndex : defaultScenes) {
+      nodeCount += this->scenes[size_t(sceneIndex)].nodes.size();
+    }
+    newScene.nodes.reserve(nodeCount);
+    for (int32_t sceneIndex : defaultScenes) {
+      const std::vector<int32_t>& sceneNodes =
+          this->scenes[size_t(sceneIndex)].nodes;
+      newScene.nodes.insert(
+          newScene.nodes.end(),
+          sceneNodes.begin(),
+          sceneNodes.end());
+    }
+
+    this->scenes.emplace_back(std::move(newScene));
+    this->scene = int32_t(this->scenes.size() - 1);
+  }
+
+  return result;
+}
+
 namespace {
 template <typename TCallback>
 void forEachPrimitiveInMeshObject(
@@ -617,23 +694,43 @@ void Model::forEachPrimitiveInScene(
       });
 
   if (!anythingVisited) {
-    // No root nodes at all in this model, so enumerate all the meshes.
+    // No root nodes at all in this model, so enumerate all the meshes. They
+    // share an empty node that outlives the callback, so that
+    // getPrimitivesInScene can keep a pointer to it.
+    static const Node emptyNode;
     for (const Mesh& mesh : this->meshes) {
       forEachPrimitiveInMeshObject(
           glm::dmat4x4(1.0),
           *this,
-          Node(),
+          emptyNode,
           mesh,
           callback);
     }
   }
 }
 
+std::vector<Model::ScenePrimitive>
+Model::getPrimitivesInScene(int32_t sceneID) const {
+  std::vector<ScenePrimitive> result;
+  this->forEachPrimitiveInScene(
+      sceneID,
+      [&result](
+          const Model& /*gltf*/,
+          const Node& node,
+          const Mesh& mesh,
+          const MeshPrimitive& primitive,
+          const glm::dmat4& transform) {
+        result.emplace_back(
+            ScenePrimitive{&node, &mesh, &primitive, transform});
+      });
+  return result;
+}
+
 namespace {
 template <typename TIndex>
 void addTriangleNormalToVertexNormals(
     const gsl::span<glm::vec3>& normals,
-    const AccessorView<glm::vec3>& positionView,
+    const gsl::span<const glm::vec3>& positions,
     TIndex tIndex0,
     TIndex tIndex1,
     TIndex tIndex2) {
@@ -644,9 +741,9 @@ void addTriangleNormalToVertexNormals(
   const uint32_t index1 = static_cast<uint32_t>(tIndex1);
   const uint32_t index2 = static_cast<uint32_t>(tIndex2);
 
-  const glm::vec3& vertex0 = positionView[index0];
-  const glm::vec3& vertex1 = positionView[index1];
-  const glm::vec3& vertex2 = positionView[index2];
+  const glm::vec3& vertex0 = positions[index0];
+  const glm::vec3& vertex1 = positions[index1];
+  const glm::vec3& vertex2 = positions[index2];
 
   const glm::vec3 triangleNormal =
       glm::cross(vertex1 - vertex0, vertex2 - vertex0);
@@ -662,7 +759,7 @@ template <typename TIndex, typename GetIndex>
 bool accumulateNormals(
     int32_t meshPrimitiveMode,
     const gsl::span<glm::vec3>& normals,
-    const AccessorView<glm::vec3>& positionView,
+    const gsl::span<const glm::vec3>& positions,
     int64_t numIndices,
     GetIndex getIndex) {
 
@@ -675,7 +772,7 @@ bool accumulateNormals(
 
       addTriangleNormalToVertexNormals<TIndex>(
           normals,
-          positionView,
+          positions,
           index0,
           index1,
           index2);
@@ -700,7 +797,7 @@ bool accumulateNormals(
 
       addTriangleNormalToVertexNormals<TIndex>(
           normals,
-          positionView,
+          positions,
           index0,
           index1,
           index2);
@@ -720,7 +817,7 @@ bool accumulateNormals(
 
         addTriangleNormalToVertexNormals<TIndex>(
             normals,
-            positionView,
+            positions,
             index0,
             index1,
             index2);
@@ -746,11 +843,26 @@ void generateSmoothNormals(
   const size_t normalBufferStride = sizeof(glm::vec3);
   const size_t normalBufferSize = count * normalBufferStride;
 
-  std::vector<std::byte> normalByteBuffer(normalBufferSize);
+  CesiumUtility::ByteVector normalByteBuffer(
+      normalBufferSize,
+      CesiumUtility::AllocationCategory::GltfBuffer);
   gsl::span<glm::vec3> normals(
       reinterpret_cast<glm::vec3*>(normalByteBuffer.data()),
       count);
 
+  // Read the positions directly if they are tightly packed, and otherwise
+  // copy them once, so that the accumulation does not pay for a stride or a
+  // bounds check per vertex.
+  std::vector<glm::vec3> copiedPositions;
+  std::optional<gsl::span<const glm::vec3>> maybePositions =
+      positionView.asSpan();
+  if (!maybePositions) {
+    copiedPositions.resize(count);
+    positionView.copyTo(gsl::span<glm::vec3>(copiedPositions));
+    maybePositions = gsl::span<const glm::vec3>(copiedPositions);
+  }
+  const gsl::span<const glm::vec3> positions = *maybePositions;
+
   // In the indexed case, the positions are accessed with the
   // indices from the indexView. Otherwise, the elements are
   // accessed directly.
@@ -761,18 +873,28 @@ void generateSmoothNormals(
       return;
     }
 
+    // Check the indices once, up front, instead of on each access.
+    if (std::any_of(
+            indexView.begin(),
+            indexView.end(),
+            [count](TIndex index) { return size_t(index) >= count; })) {
+      return;
+    }
+
     accumulationResult = accumulateNormals<TIndex>(
         primitive.mode,
         normals,
-        positionView,
+        positions,
         indexView.size(),
-        [&indexView](int64_t index) { return indexView[index]; });
+        [indices = indexView.begin()](int64_t index) {
+          return indices[index];
+        });
 
   } else {
     accumulationResult = accumulateNormals<TIndex>(
         primitive.mode,
         normals,
-        positionView,
+        positions,
         int64_t(count),
         [](int64_t index) { return static_cast<TIndex>(index); });
   }
@@ -0,0 +1,414 @@
+#include "CesiumGltf/PropertyTableFilter.h"
+
+#include "CesiumGltf/PropertyTableStringDictionary.h"
+#include "CesiumGltf/PropertyTableView.h"
+
+#include <gsl/span>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+
+namespace CesiumGltf {
+struct PropertyTableFilter::Node {
+  enum class Operation {
+    Equal,
+    NotEqual,
+    Less,
+    LessOrEqual,
+    Greater,
+    GreaterOrEqual,
+    InRange,
+    IsOneOf,
+    All,
+    Any,
+    Not
+  };
+
+  Operation operation;
+  std::string property;
+  std::vector<double> numbers;
+  std::vector<std::string> strings;
+  std::vector<std::shared_ptr<const Node>> children;
+};
+
+namespace {
+using Operation = PropertyTableFilter::Node::Operation;
+
+// Masks are evaluated with a byte per feature, so that the loops that
+// combine them can be vectorized.
+using Mask = std::vector<uint8_t>;
+
+// Reads a scalar numeric or boolean property as doubles. Features that have no
+// value are NaN, which makes every comparison with them false.
+template <typename T, bool Normalized>
+std::optional<std::vector<double>>
+readNumbers(const PropertyTablePropertyView<T, Normalized>& property) {
+  if constexpr (IsMetadataScalar<T>::value || IsMetadataBoolean<T>::value) {
+    const int64_t size = property.size();
+    if (size <= 0) {
+      return std::nullopt;
+    }
+
+    using ValueType = typename decltype(property.get(0))::value_type;
+    std::vector<double> numbers(
+        static_cast<size_t>(size),
+        std::numeric_limits<double>::quiet_NaN());
+    if constexpr (std::is_same_v<ValueType, double>) {
+      property.getRange(0, size, gsl::span<double>(numbers));
+    } else {
+      std::vector<std::optional<ValueType>> values(static_cast<size_t>(size));
+      property.getRange(0, size, gsl::span<std::optional<ValueType>>(values));
+      for (size_t i = 0; i < values.size(); ++i) {
+        if (values[i]) {
+          numbers[i] = static_cast<double>(*values[i]);
+        }
+      }
+    }
+    return numbers;
+  } else {
+    return std::nullopt;
+  }
+}
+
+struct StringColumn {
+  explicit StringColumn(PropertyTablePropertyView<std::string_view>&& property_)
+      : property(std::move(property_)), dictionary(property) {}
+
+  // The dictionary may view the default value held by the property, so the
+  // column is never moved.
+  PropertyTablePropertyView<std::string_view> property;
+  PropertyTableStringDictionary dictionary;
+};
+
+// Reads each property used by a filter once, the first time it is needed.
+class ColumnCache {
+public:
+  explicit ColumnCache(const PropertyTableView& propertyTable)
+      : _propertyTable(propertyTable), _numbers(), _strings() {}
+
+  const std::vector<double>* getNumbers(const std::string& property) {
+    auto it = this->_numbers.find(property);
+    if (it == this->_numbers.end()) {
+      std::optional<std::vector<double>> numbers;
+      this->_propertyTable.getPropertyView(
+          property,
+          [&numbers](const std::string& /*propertyId*/, auto propertyView) {
+            numbers = readNumbers(propertyView);
+          });
+      it = this->_numbers.emplace(property, std::move(numbers)).first;
+    }
+    return it->second ? &*it->second : nullptr;
+  }
+
+  const StringColumn* getStrings(const std::string& property) {
+    auto it = this->_strings.find(property);
+    if (it == this->_strings.end()) {
+      PropertyTablePropertyView<std::string_view> propertyView =
+          this->_propertyTable.getPropertyView<std::string_view>(property);
+      std::unique_ptr<StringColumn> pColumn;
+      if (propertyView.size() > 0) {
+        pColumn = std::make_unique<StringColumn>(std::move(propertyView));
+      }
+      it = this->_strings.emplace(property, std::move(pColumn)).first;
+    }
+    return it->second.get();
+  }
+
+private:
+  const PropertyTableView& _propertyTable;
+  std::unordered_map<std::string, std::optional<std::vector<double>>> _numbers;
+  std::unordered_map<std::string, std::unique_ptr<StringColumn>> _strings;
+};
+
+template <typename Predicate>
+Mask compareNumbers(const std::vector<double>& numbers, Predicate predicate) {
+  Mask mask(numbers.size());
+  const double* pNumbers = numbers.data();
+  uint8_t* pMask = mask.data();
+  for (size_t i = 0; i < numbers.size(); ++i) {
+    pMask[i] = predicate(pNumbers[i]) ? 1 : 0;
+  }
+  return mask;
+}
+
+Mask evaluateNumbers(
+    const PropertyTableFilter::Node& node,
+    const std::vector<double>& numbers) {
+  switch (node.operation) {
+  case Operation::Equal: {
+    const double value = node.numbers[0];
+    return compareNumbers(numbers, [value](double x) { return x == value; });
+  }
+  case Operation::NotEqual: {
+    const double value = node.numbers[0];
+    return compareNumbers(numbers, [value](double x) {
+      return !std::isnan(x) && x != value;
+    });
+  }
+  case Operation::Less: {
+    const double value = node.numbers[0];
+    return compareNumbers(numbers, [value](double x) { return x < value; });
+  }
+  case Operation::LessOrEqual: {
+    const double value = node.numbers[0];
+    return compareNumbers(numbers, [value](double x) { return x <= value; });
+  }
+  case Operation::Greater: {
+    const double value = node.numbers[0];
+    return compareNumbers(numbers, [value](double x) { return x > value; });
+  }
+  case Operation::GreaterOrEqual: {
+    const double value = node.numbers[0];
+    return compareNumbers(numbers, [value](double x) { return x >= value; });
+  }
+  case Operation::InRange: {
+    const double minimum = node.numbers[0];
+    const double maximum = node.numbers[1];
+    return compareNumbers(numbers, [minimum, maximum](double x) {
+      return x >= minimum && x <= maximum;
+    });
+  }
+  case Operation::IsOneOf: {
+    // The values were sorted when the filter was created.
+    const std::vector<double>& values = node.numbers;
+    return compareNumbers(numbers, [&values](double x) {
+      return !std::isnan(x) &&
+             std::binary_search(values.begin(), values.end(), x);
+    });
+  }
+  default:
+    return Mask(numbers.size(), 0);
+  }
+}
+
+Mask evaluateStrings(
+    const PropertyTableFilter::Node& node,
+    const PropertyTableStringDictionary& dictionary) {
+  // Find which of the distinct values match, then look up the value of each
+  // feature.
+  std::vector<uint8_t> matches(dictionary.getValues().size(), 0);
+  for (const std::string& string : node.strings) {
+    const std::optional<uint32_t> index = dictionary.find(string);
+    if (index) {
+      matches[*index] = 1;
+    }
+  }
+  if (node.operation == Operation::NotEqual) {
+    for (uint8_t& match : matches) {
+      match = match ? 0 : 1;
+    }
+  }
+
+  const gsl::span<const uint32_t> indices = dictionary.getIndices();
+  Mask mask(indices.size(), 0);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    const uint32_t index = indices[i];
+    if (index != PropertyTableStringDictionary::NoValue) {
+      mask[i] = matches[index];
+    }
+  }
+  return mask;
+}
+
+Mask evaluateNode(
+    const PropertyTableFilter::Node& node,
+    ColumnCache& columns,
+    size_t count) {
+  switch (node.operation) {
+  case Operation::All: {
+    Mask mask(count, 1);
+    for (const std::shared_ptr<const PropertyTableFilter::Node>& pChild :
+         node.children) {
+      const Mask childMask = evaluateNode(*pChild, columns, count);
+      for (size_t i = 0; i < count; ++i) {
+        mask[i] &= childMask[i];
+      }
+    }
+    return mask;
+  }
+  case Operation::Any: {
+    Mask mask(count, 0);
+    for (const std::shared_ptr<const PropertyTableFilter::Node>& pChild :
+         node.children) {
+      const Mask childMask = evaluateNode(*pChild, columns, count);
+      for (size_t i = 0; i < count; ++i) {
+        mask[i] |= childMask[i];
+      }
+    }
+    return mask;
+  }
+  case Operation::Not: {
+    Mask mask = evaluateNode(*node.children[0], columns, count);
+    for (size_t i = 0; i < count; ++i) {
+      mask[i] ^= 1;
+    }
+    return mask;
+  }
+  default:
+    break;
+  }
+
+  const bool comparesStrings =
+      !node.strings.empty() ||
+      (node.operation == Operation::IsOneOf && node.numbers.empty());
+  if (comparesStrings) {
+    const StringColumn* pColumn = columns.getStrings(node.property);
+    if (!pColumn) {
+      return Mask(count, 0);
+    }
+    return evaluateStrings(node, pColumn->dictionary);
+  }
+
+  const std::vector<double>* pNumbers = columns.getNumbers(node.property);
+  if (!pNumbers) {
+    return Mask(count, 0);
+  }
+  return evaluateNumbers(node, *pNumbers);
+}
+
+std::shared_ptr<const PropertyTableFilter::Node> createComparison(
+    Operation operation,
+    const std::string& property,
+    std::vector<double>&& numbers,
+    std::vector<std::string>&& strings) {
+  auto pNode = std::make_shared<PropertyTableFilter::Node>();
+  pNode->operation = operation;
+  pNode->property = property;
+  pNode->numbers = std::move(numbers);
+  pNode->strings = std::move(strings);
+  return pNode;
+}
+
+std::shared_ptr<const PropertyTableFilter::Node> createCombination(
+    Operation operation,
+    std::vector<std::shared_ptr<const PropertyTableFilter::Node>>&& children) {
+  auto pNode = std::make_shared<PropertyTableFilter::Node>();
+  pNode->operation = operation;
+  pNode->children = std::move(children);
+  return pNode;
+}
+} // namespace
+
+PropertyTableFilter
+PropertyTableFilter::equal(const std::string& property, double value) {
+  return PropertyTableFilter(
+      createComparison(Operation::Equal, property, {value}, {}));
+}
+
+PropertyTableFilter PropertyTableFilter::equal(
+    const std::string& property,
+    const std::string& value) {
+  return PropertyTableFilter(
+      createComparison(Operation::Equal, property, {}, {value}));
+}
+
+PropertyTableFilter
+PropertyTableFilter::notEqual(const std::string& property, double value) {
+  return PropertyTableFilter(
+      createComparison(Operation::NotEqual, property, {value}, {}));
+}
+
+PropertyTableFilter PropertyTableFilter::notEqual(
+    const std::string& property,
+    const std::string& value) {
+  return PropertyTableFilter(
+      createComparison(Operation::NotEqual, property, {}, {value}));
+}
+
+PropertyTableFilter
+PropertyTableFilter::less(const std::string& property, double value) {
+  return PropertyTableFilter(
+      createComparison(Operation::Less, property, {value}, {}));
+}
+
+PropertyTableFilter
+PropertyTableFilter::lessOrEqual(const std::string& property, double value) {
+  return PropertyTableFilter(
+      createComparison(Operation::LessOrEqual, property, {value}, {}));
+}
+
+PropertyTableFilter
+PropertyTableFilter::greater(const std::string& property, double value) {
+  return PropertyTableFilter(
+      createComparison(Operation::Greater, property, {value}, {}));
+}
+
+PropertyTableFilter PropertyTableFilter::greaterOrEqual(
+    const std::string& property,
+    double value) {
+  return PropertyTableFilter(
+      createComparison(Operation::GreaterOrEqual, property, {value}, {}));
+}
+
+PropertyTableFilter PropertyTableFilter::inRange(
+    const std::string& property,
+    double minimum,
+    double maximum) {
+  return PropertyTableFilter(
+      createComparison(Operation::InRange, property, {minimum, maximum}, {}));
+}
+
+PropertyTableFilter PropertyTableFilter::isOneOf(
+    const std::string& property,
+    std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  return PropertyTableFilter(
+      createComparison(Operation::IsOneOf, property, std::move(values), {}));
+}
+
+PropertyTableFilter PropertyTableFilter::isOneOf(
+    const std::string& property,
+    std::vector<std::string> values) {
+  return PropertyTableFilter(
+      createComparison(Operation::IsOneOf, property, {}, std::move(values)));
+}
+
+PropertyTableFilter
+PropertyTableFilter::all(std::vector<PropertyTableFilter> filters) {
+  std::vector<std::shared_ptr<const Node>> children;
+  children.reserve(filters.size());
+  for (PropertyTableFilter& filter : filters) {
+    children.emplace_back(std::move(filter._pNode));
+  }
+  return PropertyTableFilter(
+      createCombination(Operation::All, std::move(children)));
+}
+
+PropertyTableFilter
+PropertyTableFilter::any(std::vector<PropertyTableFilter> filters) {
+  std::vector<std::shared_ptr<const Node>> children;
+  children.reserve(filters.size());
+  for (PropertyTableFilter& filter : filters) {
+    children.emplace_back(std::move(filter._pNode));
+  }
+  return PropertyTableFilter(
+      createCombination(Operation::Any, std::move(children)));
+}
+
+PropertyTableFilter PropertyTableFilter::negate(PropertyTableFilter filter) {
+  return PropertyTableFilter(
+      createCombination(Operation::Not, {std::move(filter._pNode)}));
+}
+
+std::vector<bool>
+PropertyTableFilter::evaluate(const PropertyTableView& propertyTable) const {
+  const int64_t size = propertyTable.size();
+  if (size <= 0) {
+    return {};
+  }
+
+  ColumnCache columns(propertyTable);
+  const Mask mask =
+      evaluateNode(*this->_pNode, columns, static_cast<size_t>(size));
+  return std::vector<bool>(mask.begin(), mask.end());
+}
+
+PropertyTableFilter::PropertyTableFilter(
+    std::shared_ptr<const Node>&& pNode) noexcept
+    : _pNode(std::move(pNode)) {}
+} // namespace CesiumGltf
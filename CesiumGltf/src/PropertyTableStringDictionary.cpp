@@ -0,0 +1,47 @@
+#include "CesiumGltf/PropertyTableStringDictionary.h"
+
+namespace CesiumGltf {
+PropertyTableStringDictionary::PropertyTableStringDictionary(
+    const PropertyTablePropertyView<std::string_view>& property)
+    : _values(), _valueIndices(), _indices() {
+  const int64_t count = property.size();
+  if (count <= 0) {
+    return;
+  }
+
+  this->_indices.resize(static_cast<size_t>(count));
+
+  // Consecutive elements often have the same value, so they are compared to
+  // the previous value before it is looked up.
+  std::optional<std::string_view> previousValue;
+  uint32_t previousIndex = NoValue;
+  for (int64_t i = 0; i < count; ++i) {
+    const std::optional<std::string_view> value = property.get(i);
+    if (i == 0 || value != previousValue) {
+      if (!value) {
+        previousIndex = NoValue;
+      } else {
+        auto [it, added] = this->_valueIndices.emplace(
+            *value,
+            static_cast<uint32_t>(this->_values.size()));
+        if (added) {
+          this->_values.emplace_back(*value);
+        }
+        previousIndex = it->second;
+      }
+      previousValue = value;
+    }
+
+    this->_indices[static_cast<size_t>(i)] = previousIndex;
+  }
+}
+
+std::optional<uint32_t>
+PropertyTableStringDictionary::find(std::string_view value) const noexcept {
+  auto it = this->_valueIndices.find(value);
+  if (it == this->_valueIndices.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+} // namespace CesiumGltf
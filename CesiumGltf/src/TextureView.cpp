@@ -119,48 +119,81 @@ std::vector<uint8_t> TextureView::sampleNearestPixel(
     return result;
   }
 
-  if (this->_applyTextureTransform && this->_textureTransform) {
-    glm::dvec2 transformedUvs = this->_textureTransform->applyTransform(u, v);
-    u = transformedUvs.x;
-    v = transformedUvs.y;
-  }
+  const glm::dvec2 uv(u, v);
+  this->sampleNearestPixels(
+      gsl::span<const glm::dvec2>(&uv, 1),
+      channels,
+      gsl::span<uint8_t>(result));
+  return result;
+}
 
-  u = applySamplerWrapS(u, this->_pSampler->wrapS);
-  v = applySamplerWrapT(v, this->_pSampler->wrapT);
-
-  const ImageCesium& image = this->_imageCopy.value_or(*this->_pImage);
-
-  // For nearest filtering, std::floor is used instead of std::round.
-  // This is because filtering is supposed to consider the pixel centers. But
-  // memory access here acts as sampling the beginning of the pixel. Example:
-  // 0.4 * 2 = 0.8. In a 2x1 pixel image, that should be closer to the left
-  // pixel's center. But it will round to 1.0 which corresponds to the right
-  // pixel. So the right pixel has a bigger range than the left one, which is
-  // incorrect.
-  double xCoord = std::floor(u * image.width);
-  double yCoord = std::floor(v * image.height);
-
-  // Clamp to ensure no out-of-bounds data access
-  int64_t x = glm::clamp(
-      static_cast<int64_t>(xCoord),
-      static_cast<int64_t>(0),
-      static_cast<int64_t>(image.width) - 1);
-  int64_t y = glm::clamp(
-      static_cast<int64_t>(yCoord),
-      static_cast<int64_t>(0),
-      static_cast<int64_t>(image.height) - 1);
-
-  int64_t pixelIndex =
-      image.bytesPerChannel * image.channels * (y * image.width + x);
+void TextureView::sampleNearestPixels(
+    const gsl::span<const glm::dvec2>& uvs,
+    const std::vector<int64_t>& channels,
+    const gsl::span<uint8_t>& result) const noexcept {
+  assert(this->_textureViewStatus == TextureViewStatus::Valid);
+  assert(result.size() >= uvs.size() * channels.size());
+
+  const KhrTextureTransform* pTransform =
+      this->_applyTextureTransform && this->_textureTransform
+          ? &this->_textureTransform.value()
+          : nullptr;
+  const int32_t wrapS = this->_pSampler->wrapS;
+  const int32_t wrapT = this->_pSampler->wrapT;
+
+  const ImageCesium& image = *this->getImage();
+  const double width = static_cast<double>(image.width);
+  const double height = static_cast<double>(image.height);
+  const int64_t maxX = static_cast<int64_t>(image.width) - 1;
+  const int64_t maxY = static_cast<int64_t>(image.height) - 1;
+  const int64_t pixelSize =
+      static_cast<int64_t>(image.bytesPerChannel) * image.channels;
 
   // TODO: Currently stb only outputs uint8 pixel types. If that
   // changes this should account for additional pixel byte sizes.
-  const uint8_t* pValue =
-      reinterpret_cast<const uint8_t*>(image.pixelData.data() + pixelIndex);
-  for (size_t i = 0; i < result.size(); i++) {
-    result[i] = *(pValue + channels[i]);
+  const uint8_t* pPixels =
+      reinterpret_cast<const uint8_t*>(image.pixelData.data());
+  const size_t channelCount = channels.size();
+  const int64_t* pChannels = channels.data();
+  uint8_t* pResult = result.data();
+
+  for (const glm::dvec2& uv : uvs) {
+    double u = uv.x;
+    double v = uv.y;
+    if (pTransform) {
+      const glm::dvec2 transformedUvs = pTransform->applyTransform(u, v);
+      u = transformedUvs.x;
+      v = transformedUvs.y;
+    }
+
+    u = applySamplerWrapS(u, wrapS);
+    v = applySamplerWrapT(v, wrapT);
+
+    // For nearest filtering, std::floor is used instead of std::round.
+    // This is because filtering is supposed to consider the pixel centers. But
+    // memory access here acts as sampling the beginning of the pixel. Example:
+    // 0.4 * 2 = 0.8. In a 2x1 pixel image, that should be closer to the left
+    // pixel's center. But it will round to 1.0 which corresponds to the right
+    // pixel. So the right pixel has a bigger range than the left one, which is
+    // incorrect.
+    const double xCoord = std::floor(u * width);
+    const double yCoord = std::floor(v * height);
+
+    // Clamp to ensure no out-of-bounds data access
+    const int64_t x = glm::clamp(
+        static_cast<int64_t>(xCoord),
+        static_cast<int64_t>(0),
+        maxX);
+    const int64_t y = glm::clamp(
+        static_cast<int64_t>(yCoord),
+        static_cast<int64_t>(0),
+        maxY);
+
+    const uint8_t* pValue = pPixels + pixelSize * (y * image.width + x);
+    for (size_t i = 0; i < channelCount; i++) {
+      pResult[i] = pValue[pChannels[i]];
+    }
+    pResult += channelCount;
   }
-
-  return result;
 }
 } // namespace CesiumGltf
@@ -176,6 +176,74 @@ TEST_CASE("Test getNormalAccessorView") {
   }
 }
 
+TEST_CASE("Test QuantizedPositionFromAccessor") {
+  Model model;
+  std::vector<int16_t> positions{0, 32767, -32767, -32768, 16384, 1};
+
+  {
+    Buffer& buffer = model.buffers.emplace_back();
+    buffer.cesium.data.resize(positions.size() * sizeof(int16_t));
+    std::memcpy(
+        buffer.cesium.data.data(),
+        positions.data(),
+        buffer.cesium.data.size());
+    buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+
+    BufferView& bufferView = model.bufferViews.emplace_back();
+    bufferView.buffer = 0;
+    bufferView.byteLength = buffer.byteLength;
+
+    Accessor& accessor = model.accessors.emplace_back();
+    accessor.bufferView = 0;
+    accessor.componentType = Accessor::ComponentType::SHORT;
+    accessor.type = Accessor::Type::VEC3;
+    accessor.count = 2;
+  }
+
+  Mesh& mesh = model.meshes.emplace_back();
+  MeshPrimitive primitive = mesh.primitives.emplace_back();
+  primitive.attributes.insert({"POSITION", 0});
+
+  QuantizedPositionAccessorType positionAccessor =
+      getQuantizedPositionAccessorView(model, primitive);
+  REQUIRE(
+      std::visit(StatusFromAccessor{}, positionAccessor) ==
+      AccessorViewStatus::Valid);
+  REQUIRE(std::visit(CountFromAccessor{}, positionAccessor) == 2);
+
+  SECTION("Uses the components of an accessor that is not normalized") {
+    AccessorDequantization dequantization =
+        getAccessorDequantization(model.accessors[0]);
+    CHECK(
+        std::visit(
+            QuantizedPositionFromAccessor{1, dequantization},
+            positionAccessor) == glm::dvec3(-32768.0, 16384.0, 1.0));
+  }
+
+  SECTION("Normalizes the components of a normalized accessor") {
+    model.accessors[0].normalized = true;
+    AccessorDequantization dequantization =
+        getAccessorDequantization(model.accessors[0]);
+    CHECK(
+        std::visit(
+            QuantizedPositionFromAccessor{0, dequantization},
+            positionAccessor) == glm::dvec3(0.0, 1.0, -1.0));
+
+    std::optional<glm::dvec3> position = std::visit(
+        QuantizedPositionFromAccessor{1, dequantization},
+        positionAccessor);
+    REQUIRE(position);
+    CHECK(position->x == -1.0);
+    CHECK(position->y == Approx(16384.0 / 32767.0));
+  }
+
+  SECTION("Handles out-of-bounds index") {
+    CHECK(!std::visit(
+        QuantizedPositionFromAccessor{2, AccessorDequantization()},
+        positionAccessor));
+  }
+}
+
 TEST_CASE("Test getFeatureIdAccessorView") {
   Model model;
   std::vector<uint8_t> featureIds0{1, 2, 3, 4};
@@ -3,6 +3,11 @@
 
 #include <catch2/catch.hpp>
 #include <glm/vec3.hpp>
+#include <gsl/span>
+
+#include <algorithm>
+#include <optional>
+#include <vector>
 
 TEST_CASE("AccessorView construct and read example") {
   auto anyOldFunctionToGetAModel = []() {
@@ -90,3 +95,113 @@ TEST_CASE("Create AccessorView of unknown type with lambda") {
     CHECK(int64_t(accessorView[0].value[0]) == int64_t(0x0201));
   });
 }
+
+TEST_CASE("AccessorView iterators, spans and bulk copies") {
+  using namespace CesiumGltf;
+
+  std::vector<float> values{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  const std::byte* pData = reinterpret_cast<const std::byte*>(values.data());
+
+  SECTION("Tightly packed elements") {
+    const int64_t stride = static_cast<int64_t>(sizeof(float));
+    AccessorView<float> view(pData, stride, 0, 12);
+
+    std::optional<gsl::span<const float>> span = view.asSpan();
+    REQUIRE(span);
+    CHECK(span->size() == 12);
+    CHECK((*span)[11] == 11.0f);
+
+    std::vector<float> copied(20);
+    CHECK(view.copyTo(gsl::span<float>(copied)) == 12);
+    CHECK(std::equal(values.begin(), values.end(), copied.begin()));
+  }
+
+  SECTION("Strided elements") {
+    const int64_t stride = static_cast<int64_t>(3 * sizeof(float));
+    AccessorView<float> view(pData, stride, stride / 3, 4);
+    CHECK(!view.asSpan());
+    CHECK(view.end() - view.begin() == 4);
+
+    const std::vector<float> expected{1, 4, 7, 10};
+    std::vector<float> iterated(view.begin(), view.end());
+    CHECK(iterated == expected);
+    CHECK(view.begin()[2] == 7.0f);
+
+    std::vector<float> copied(2);
+    CHECK(view.copyTo(gsl::span<float>(copied)) == 2);
+    CHECK(copied[0] == 1.0f);
+    CHECK(copied[1] == 4.0f);
+
+    std::vector<uint16_t> indices{3, 0, 3};
+    std::vector<float> gathered(3);
+    CHECK(view.gather(
+        gsl::span<const uint16_t>(indices),
+        gsl::span<float>(gathered)));
+    CHECK(gathered[0] == 10.0f);
+    CHECK(gathered[1] == 1.0f);
+    CHECK(gathered[2] == 10.0f);
+
+    indices[1] = 4;
+    CHECK(!view.gather(
+        gsl::span<const uint16_t>(indices),
+        gsl::span<float>(gathered)));
+  }
+
+  SECTION("A view without elements") {
+    AccessorView<float> view;
+    CHECK(view.begin() == view.end());
+    std::optional<gsl::span<const float>> span = view.asSpan();
+    REQUIRE(span);
+    CHECK(span->empty());
+  }
+}
+
+TEST_CASE("AccessorView from an AccessorLayoutCache") {
+  using namespace CesiumGltf;
+
+  Model model;
+
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(sizeof(float) * 6);
+  float* p = reinterpret_cast<float*>(buffer.cesium.data.data());
+  for (size_t i = 0; i < 6; ++i) {
+    p[i] = float(i);
+  }
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteLength = buffer.byteLength;
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = 0;
+  accessor.componentType = Accessor::ComponentType::FLOAT;
+  accessor.type = Accessor::Type::VEC3;
+  accessor.count = 2;
+
+  Accessor& badAccessor = model.accessors.emplace_back();
+  badAccessor.bufferView = 5;
+
+  const AccessorLayoutCache cache(model);
+
+  AccessorView<glm::vec3> fromCache(cache, 0);
+  AccessorView<glm::vec3> fromModel(model, 0);
+  REQUIRE(fromCache.status() == AccessorViewStatus::Valid);
+  REQUIRE(fromCache.size() == fromModel.size());
+  CHECK(fromCache.stride() == fromModel.stride());
+  CHECK(fromCache.data() == fromModel.data());
+  CHECK(fromCache[1] == glm::vec3(3.0f, 4.0f, 5.0f));
+
+  CHECK(
+      AccessorView<float>(cache, 0).status() ==
+      AccessorViewStatus::WrongSizeT);
+  CHECK(
+      AccessorView<glm::vec3>(cache, 1).status() ==
+      AccessorViewStatus::InvalidBufferViewIndex);
+  CHECK(
+      AccessorView<glm::vec3>(cache, 2).status() ==
+      AccessorViewStatus::InvalidAccessorIndex);
+  CHECK(
+      AccessorView<glm::vec3>(cache, -1).status() ==
+      AccessorViewStatus::InvalidAccessorIndex);
+}
@@ -402,7 +402,7 @@ TEST_CASE("Test FeatureIdTextureView with makeImageCopy = true") {
   REQUIRE(view.status() == FeatureIdTextureViewStatus::Valid);
 
   // Clear the original image data.
-  std::vector<std::byte> emptyData;
+  CesiumUtility::ByteVector emptyData;
   image.cesium.pixelData.swap(emptyData);
 
   const ImageCesium* pImage = view.getImage();
@@ -640,7 +640,7 @@ TEST_CASE("Test getFeatureId on view with makeImageCopy = true") {
   REQUIRE(view.status() == FeatureIdTextureViewStatus::Valid);
 
   // Clear the original image data.
-  std::vector<std::byte> emptyData;
+  CesiumUtility::ByteVector emptyData;
   image.cesium.pixelData.swap(emptyData);
 
   REQUIRE(view.getFeatureID(0, 0) == 1);
@@ -779,6 +779,58 @@ TEST_CASE("Test getFeatureID handles multiple channels") {
   REQUIRE(view.getFeatureID(1, 1) == 17);
 }
 
+TEST_CASE("Test getFeatureIDs samples many texture coordinates") {
+  Model model;
+  Sampler& sampler = model.samplers.emplace_back();
+  sampler.wrapS = Sampler::WrapS::REPEAT;
+  sampler.wrapT = Sampler::WrapT::CLAMP_TO_EDGE;
+
+  std::vector<uint16_t> featureIDs{260, 512, 8, 17};
+
+  Image& image = model.images.emplace_back();
+  image.cesium.width = 2;
+  image.cesium.height = 2;
+  image.cesium.channels = 2;
+  image.cesium.bytesPerChannel = 1;
+
+  auto& data = image.cesium.pixelData;
+  data.resize(featureIDs.size() * sizeof(uint16_t));
+  std::memcpy(data.data(), featureIDs.data(), data.size());
+
+  Texture& texture = model.textures.emplace_back();
+  texture.sampler = 0;
+  texture.source = 0;
+
+  FeatureIdTexture featureIdTexture;
+  featureIdTexture.index = 0;
+  featureIdTexture.texCoord = 0;
+  featureIdTexture.channels = {0, 1};
+
+  // Use more coordinates than fit in one chunk of samples.
+  std::vector<glm::dvec2> uvs;
+  for (size_t i = 0; i < 1000; i++) {
+    uvs.emplace_back(
+        0.3 * static_cast<double>(i % 7),
+        0.25 * static_cast<double>(i % 5));
+  }
+  std::vector<int64_t> result(uvs.size(), 0);
+
+  SECTION("Matches getFeatureID") {
+    FeatureIdTextureView view(model, featureIdTexture);
+    REQUIRE(view.status() == FeatureIdTextureViewStatus::Valid);
+    view.getFeatureIDs(uvs, result);
+    for (size_t i = 0; i < uvs.size(); i++) {
+      REQUIRE(result[i] == view.getFeatureID(uvs[i].x, uvs[i].y));
+    }
+  }
+
+  SECTION("Returns -1 for an invalid view") {
+    FeatureIdTextureView view;
+    view.getFeatureIDs(uvs, result);
+    CHECK(result == std::vector<int64_t>(uvs.size(), -1));
+  }
+}
+
 TEST_CASE("Check FeatureIdTextureView sampling with different wrap values") {
   Model model;
   Mesh& mesh = model.meshes.emplace_back();
@@ -4,6 +4,9 @@
 
 #include <cstdint>
 #include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
 
 using namespace CesiumUtility;
 
@@ -86,3 +89,28 @@ TEST_CASE("JsonValue::getSafeNumberOrDefault() returns default if narrowing "
     REQUIRE(value.getSafeNumberOrDefault<std::uint16_t>(365) == 365);
   }
 }
+
+TEST_CASE("JsonValue objects look up their properties by name") {
+  JsonValue value = JsonValue::Object{
+      {"name", "tile"},
+      {"count", std::int64_t(3)},
+      {"children", JsonValue::Array{JsonValue::Object{{"a", true}}}}};
+
+  CHECK(value.hasKey("count"));
+  CHECK(!value.hasKey("missing"));
+  CHECK(value.getSafeNumericalValueForKey<int32_t>("count") == 3);
+  CHECK(value.getSafeNumericalValueOrDefaultForKey<int32_t>("missing", 7) == 7);
+  REQUIRE(value.getValuePtrForKey<std::string>("name"));
+  CHECK(*value.getValuePtrForKey<std::string>("name") == "tile");
+
+  const JsonValue::Object& object = value.getObject();
+  const auto it = object.find(std::string_view("children"));
+  REQUIRE(it != object.end());
+  CHECK(it->second.getArray()[0].getObject().at("a").getBool());
+
+  std::vector<std::string> names;
+  for (const auto& [name, property] : object) {
+    names.emplace_back(name);
+  }
+  CHECK(names == std::vector<std::string>{"children", "count", "name"});
+}
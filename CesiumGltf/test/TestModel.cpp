@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <cstring>
 #include <iostream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -201,6 +202,34 @@ TEST_CASE("Test forEachPrimitive") {
     REQUIRE(nodeTransforms.size() == 1);
     REQUIRE(nodeTransforms[0] == expectedNodeTransform);
   }
+
+  SECTION("Check that getPrimitivesInScene flattens the same primitives") {
+    std::vector<Model::ScenePrimitive> primitives =
+        model.getPrimitivesInScene(-1);
+    REQUIRE(primitives.size() == 3);
+    CHECK(primitives[0].pNode == &node0);
+    CHECK(primitives[0].pMesh == &mesh0);
+    CHECK(primitives[0].pPrimitive == &primitive0);
+    CHECK(primitives[1].pPrimitive == &primitive1);
+    CHECK(primitives[2].pNode == &node1);
+    CHECK(primitives[2].pPrimitive == &primitive2);
+
+    primitives = model.getPrimitivesInScene(1);
+    REQUIRE(primitives.size() == 1);
+    CHECK(primitives[0].pNode == &node3);
+    CHECK(primitives[0].pMesh == &mesh2);
+    CHECK(primitives[0].pPrimitive == &primitive3);
+    CHECK(primitives[0].transform == expectedNodeTransform);
+
+    // Without nodes, every mesh is visited with a shared empty node.
+    model.scenes.clear();
+    model.nodes.clear();
+    primitives = model.getPrimitivesInScene(-1);
+    REQUIRE(primitives.size() == 4);
+    CHECK(primitives[3].pPrimitive == &primitive3);
+    CHECK(primitives[3].pNode->mesh == -1);
+    CHECK(primitives[3].transform == glm::dmat4(1.0));
+  }
 }
 
 static Model createCubeGltf() {
@@ -385,6 +414,16 @@ static Model createTriangleFan() {
 }
 
 TEST_CASE("Test smooth normal generation") {
+  SECTION("Test that out-of-range indices are skipped without throwing") {
+    Model model = createCubeGltf();
+    model.buffers[1].cesium.data[0] = std::byte(8);
+
+    model.generateMissingNormalsSmooth();
+
+    const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+    CHECK(primitive.attributes.find("NORMAL") == primitive.attributes.end());
+  }
+
   SECTION("Test normal generation TRIANGLES") {
     Model model = createCubeGltf();
 
@@ -1297,6 +1336,89 @@ TEST_CASE("Model::merge") {
   }
 }
 
+TEST_CASE("Model::mergeAll") {
+  SECTION("appends the elements of every model and updates their indices") {
+    Model m1;
+    m1.buffers.emplace_back().name = "m1";
+    m1.bufferViews.emplace_back().buffer = 0;
+    m1.accessors.emplace_back().bufferView = 0;
+
+    std::vector<Model> models(3);
+    for (size_t i = 0; i < models.size(); ++i) {
+      Model& model = models[i];
+      model.buffers.emplace_back().name = "m" + std::to_string(i + 2);
+      model.bufferViews.emplace_back().buffer = 0;
+      model.accessors.emplace_back().bufferView = 0;
+      model.meshes.emplace_back().primitives.emplace_back().attributes.emplace(
+          "POSITION",
+          0);
+      model.nodes.emplace_back().mesh = 0;
+    }
+
+    ErrorList errors = m1.mergeAll(models);
+    CHECK(errors.errors.empty());
+    CHECK(errors.warnings.empty());
+
+    REQUIRE(m1.buffers.size() == 4);
+    REQUIRE(m1.bufferViews.size() == 4);
+    REQUIRE(m1.accessors.size() == 4);
+    REQUIRE(m1.meshes.size() == 3);
+    REQUIRE(m1.nodes.size() == 3);
+    for (size_t i = 0; i < 4; ++i) {
+      CHECK(m1.buffers[i].name == "m" + std::to_string(i + 1));
+      CHECK(m1.bufferViews[i].buffer == int32_t(i));
+      CHECK(m1.accessors[i].bufferView == int32_t(i));
+    }
+    for (size_t i = 0; i < 3; ++i) {
+      CHECK(m1.nodes[i].mesh == int32_t(i));
+      CHECK(
+          m1.meshes[i].primitives[0].attributes["POSITION"] ==
+          int32_t(i + 1));
+    }
+  }
+
+  SECTION("combines the default scenes into a single scene") {
+    Model m1;
+    m1.nodes.emplace_back().name = "node1";
+    m1.scenes.emplace_back().nodes.push_back(0);
+    m1.scene = 0;
+
+    std::vector<Model> models(3);
+    for (size_t i = 0; i < models.size(); ++i) {
+      Model& model = models[i];
+      model.nodes.emplace_back().name = "node" + std::to_string(i + 2);
+      model.scenes.emplace_back().nodes.push_back(0);
+      model.scene = 0;
+    }
+
+    ErrorList errors = m1.mergeAll(models);
+    CHECK(errors.errors.empty());
+
+    // The four scenes of the models and the combined one.
+    REQUIRE(m1.scenes.size() == 5);
+    REQUIRE(m1.scene == 4);
+    const Scene& defaultScene = m1.scenes[4];
+    REQUIRE(defaultScene.nodes.size() == 4);
+    for (size_t i = 0; i < 4; ++i) {
+      CHECK(
+          m1.nodes[size_t(defaultScene.nodes[i])].name ==
+          "node" + std::to_string(i + 1));
+    }
+  }
+
+  SECTION("uses the only default scene as is") {
+    Model m1;
+    std::vector<Model> models(2);
+    models[1].nodes.emplace_back();
+    models[1].scenes.emplace_back().nodes.push_back(0);
+    models[1].scene = 0;
+
+    m1.mergeAll(models);
+    REQUIRE(m1.scenes.size() == 1);
+    CHECK(m1.scene == 0);
+  }
+}
+
 TEST_CASE("Model::forEachRootNodeInScene") {
   Model m;
 
@@ -0,0 +1,175 @@
+#include "CesiumGltf/PropertyTableFilter.h"
+#include "CesiumGltf/PropertyTableView.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+int32_t addBufferView(Model& model, const void* pData, size_t size) {
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(size);
+  std::memcpy(buffer.cesium.data.data(), pData, size);
+  buffer.byteLength = static_cast<int64_t>(size);
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+  bufferView.byteLength = buffer.byteLength;
+  return static_cast<int32_t>(model.bufferViews.size() - 1);
+}
+
+template <typename T>
+void addProperty(
+    Model& model,
+    const std::string& name,
+    const std::string& componentType,
+    const std::vector<T>& values) {
+  ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  ClassProperty& classProperty =
+      pMetadata->schema->classes["Building"].properties[name];
+  classProperty.type = ClassProperty::Type::SCALAR;
+  classProperty.componentType = componentType;
+
+  pMetadata->propertyTables[0].properties[name].values =
+      addBufferView(model, values.data(), values.size() * sizeof(T));
+}
+
+void addStringProperty(
+    Model& model,
+    const std::string& name,
+    const std::vector<std::string>& strings) {
+  std::string values;
+  std::vector<uint32_t> offsets;
+  for (const std::string& string : strings) {
+    offsets.emplace_back(static_cast<uint32_t>(values.size()));
+    values += string;
+  }
+  offsets.emplace_back(static_cast<uint32_t>(values.size()));
+
+  ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  pMetadata->schema->classes["Building"].properties[name].type =
+      ClassProperty::Type::STRING;
+
+  PropertyTableProperty& property =
+      pMetadata->propertyTables[0].properties[name];
+  property.values = addBufferView(model, values.data(), values.size());
+  property.stringOffsets = addBufferView(
+      model,
+      offsets.data(),
+      offsets.size() * sizeof(uint32_t));
+  property.stringOffsetType = PropertyTableProperty::StringOffsetType::UINT32;
+}
+
+std::vector<bool>
+evaluate(const Model& model, const PropertyTableFilter& filter) {
+  const ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  PropertyTableView view(model, pMetadata->propertyTables[0]);
+  REQUIRE(view.status() == PropertyTableViewStatus::Valid);
+  return filter.evaluate(view);
+}
+} // namespace
+
+TEST_CASE("Test PropertyTableFilter") {
+  Model model;
+  ExtensionModelExtStructuralMetadata& metadata =
+      model.addExtension<ExtensionModelExtStructuralMetadata>();
+  metadata.schema.emplace().classes["Building"];
+  PropertyTable& propertyTable = metadata.propertyTables.emplace_back();
+  propertyTable.classProperty = "Building";
+  propertyTable.count = 5;
+
+  addProperty<float>(
+      model,
+      "height",
+      ClassProperty::ComponentType::FLOAT32,
+      {5.0f, 30.0f, 12.5f, 40.0f, 20.0f});
+  addProperty<uint8_t>(
+      model,
+      "floors",
+      ClassProperty::ComponentType::UINT8,
+      {1, 8, 255, 10, 5});
+  metadata.schema->classes["Building"].properties["floors"].noData = 255;
+  addStringProperty(
+      model,
+      "use",
+      {"residential", "commercial", "residential", "industrial", ""});
+
+  using Filter = PropertyTableFilter;
+
+  SECTION("Compares numbers") {
+    CHECK(
+        evaluate(model, Filter::greater("height", 12.5)) ==
+        std::vector<bool>{false, true, false, true, true});
+    CHECK(
+        evaluate(model, Filter::lessOrEqual("height", 12.5)) ==
+        std::vector<bool>{true, false, true, false, false});
+    CHECK(
+        evaluate(model, Filter::inRange("height", 10.0, 30.0)) ==
+        std::vector<bool>{false, true, true, false, true});
+    CHECK(
+        evaluate(model, Filter::isOneOf("height", {40.0, 5.0})) ==
+        std::vector<bool>{true, false, false, true, false});
+  }
+
+  SECTION("Features without a value never match a comparison") {
+    CHECK(
+        evaluate(model, Filter::notEqual("floors", 8.0)) ==
+        std::vector<bool>{true, false, false, true, true});
+    CHECK(
+        evaluate(model, Filter::less("floors", 1000.0)) ==
+        std::vector<bool>{true, true, false, true, true});
+  }
+
+  SECTION("Compares strings") {
+    CHECK(
+        evaluate(model, Filter::equal("use", "residential")) ==
+        std::vector<bool>{true, false, true, false, false});
+    CHECK(
+        evaluate(model, Filter::notEqual("use", "residential")) ==
+        std::vector<bool>{false, true, false, true, true});
+    const std::vector<std::string> uses{"commercial", "industrial", "farm"};
+    CHECK(
+        evaluate(model, Filter::isOneOf("use", uses)) ==
+        std::vector<bool>{false, true, false, true, false});
+    CHECK(
+        evaluate(model, Filter::equal("use", "farm")) ==
+        std::vector<bool>(5, false));
+  }
+
+  SECTION("Combines filters") {
+    const Filter filter = Filter::all(
+        {Filter::greater("height", 10.0),
+         Filter::any(
+             {Filter::equal("use", "residential"),
+              Filter::greaterOrEqual("floors", 10.0)})});
+    CHECK(
+        evaluate(model, filter) ==
+        std::vector<bool>{false, false, true, true, false});
+    CHECK(
+        evaluate(model, Filter::negate(filter)) ==
+        std::vector<bool>{true, true, false, false, true});
+
+    CHECK(evaluate(model, Filter::all({})) == std::vector<bool>(5, true));
+    CHECK(evaluate(model, Filter::any({})) == std::vector<bool>(5, false));
+  }
+
+  SECTION("Comparisons on missing or mismatched properties are false") {
+    CHECK(
+        evaluate(model, Filter::equal("missing", 1.0)) ==
+        std::vector<bool>(5, false));
+    CHECK(
+        evaluate(model, Filter::equal("height", "tall")) ==
+        std::vector<bool>(5, false));
+    CHECK(
+        evaluate(model, Filter::equal("use", 1.0)) ==
+        std::vector<bool>(5, false));
+  }
+}
@@ -4,6 +4,7 @@
 #include <gsl/span>
 
 #include <bitset>
+#include <chrono>
 #include <climits>
 #include <cstddef>
 #include <cstring>
@@ -23,6 +24,30 @@ checkArrayEqual(PropertyArrayView<T> arrayView, std::vector<T> expected) {
   }
 }
 
+template <typename T, bool Normalized>
+static void
+checkRange(const PropertyTablePropertyView<T, Normalized>& property) {
+  using ValueType = typename decltype(property.get(0))::value_type;
+  const int64_t size = property.size();
+
+  std::vector<std::optional<ValueType>> values(static_cast<size_t>(size));
+  property.getRange(0, size, gsl::span<std::optional<ValueType>>(values));
+  for (int64_t i = 0; i < size; ++i) {
+    REQUIRE(values[static_cast<size_t>(i)] == property.get(i));
+  }
+
+  // Elements that have no value are left as they were.
+  std::vector<ValueType> plainValues(static_cast<size_t>(size), ValueType(42));
+  property.getRange(1, size, gsl::span<ValueType>(plainValues));
+  for (int64_t i = 1; i < size; ++i) {
+    const std::optional<ValueType> expected = property.get(i);
+    REQUIRE(
+        plainValues[static_cast<size_t>(i - 1)] ==
+        expected.value_or(ValueType(42)));
+  }
+  REQUIRE(plainValues.back() == ValueType(42));
+}
+
 template <typename T> static void checkNumeric(const std::vector<T>& expected) {
   std::vector<std::byte> data;
   data.resize(expected.size() * sizeof(T));
@@ -51,6 +76,8 @@ template <typename T> static void checkNumeric(const std::vector<T>& expected) {
     REQUIRE(property.getRaw(i) == expected[static_cast<size_t>(i)]);
     REQUIRE(property.get(i) == property.getRaw(i));
   }
+
+  checkRange(property);
 }
 
 template <typename T>
@@ -96,6 +123,8 @@ static void checkNumeric(
       REQUIRE(property.get(i) == expected[static_cast<size_t>(i)]);
     }
   }
+
+  checkRange(property);
 }
 
 template <typename T, typename D = typename TypeToNormalizedType<T>::type>
@@ -139,6 +168,8 @@ static void checkNormalizedNumeric(
     REQUIRE(property.getRaw(i) == values[static_cast<size_t>(i)]);
     REQUIRE(property.get(i) == expected[static_cast<size_t>(i)]);
   }
+
+  checkRange(property);
 }
 
 template <typename DataType, typename OffsetType>
@@ -3710,3 +3741,106 @@ TEST_CASE("Check variable-length boolean array PropertyTablePropertyView") {
     }
   }
 }
+
+TEST_CASE("Check PropertyTablePropertyView::getRange") {
+  SECTION("Empty property with default") {
+    ClassProperty classProperty;
+    classProperty.type = ClassProperty::Type::SCALAR;
+    classProperty.componentType = ClassProperty::ComponentType::FLOAT32;
+    classProperty.defaultProperty = 5.0f;
+
+    PropertyTablePropertyView<float> property(classProperty, 3);
+    REQUIRE(
+        property.status() ==
+        PropertyTablePropertyViewStatus::EmptyPropertyWithDefault);
+
+    std::vector<std::optional<float>> values(3);
+    property.getRange(0, 3, gsl::span<std::optional<float>>(values));
+    REQUIRE(values == std::vector<std::optional<float>>{5.0f, 5.0f, 5.0f});
+
+    std::vector<float> plainValues(3);
+    property.getRange(1, 3, gsl::span<float>(plainValues));
+    REQUIRE(plainValues == std::vector<float>{5.0f, 5.0f, 0.0f});
+  }
+
+  SECTION("String") {
+    std::string strings = "abcdef";
+    std::vector<uint32_t> offsets{0, 2, 5, 6};
+    std::vector<std::byte> offsetData(offsets.size() * sizeof(uint32_t));
+    std::memcpy(offsetData.data(), offsets.data(), offsetData.size());
+
+    PropertyTableProperty propertyTableProperty;
+    ClassProperty classProperty;
+    classProperty.type = ClassProperty::Type::STRING;
+    classProperty.noData = "cde";
+    classProperty.defaultProperty = "none";
+
+    PropertyTablePropertyView<std::string_view> property(
+        propertyTableProperty,
+        classProperty,
+        3,
+        gsl::span<const std::byte>(
+            reinterpret_cast<const std::byte*>(strings.data()),
+            strings.size()),
+        gsl::span<const std::byte>(),
+        gsl::span<const std::byte>(offsetData.data(), offsetData.size()),
+        PropertyComponentType::None,
+        PropertyComponentType::Uint32);
+    REQUIRE(property.status() == PropertyTablePropertyViewStatus::Valid);
+
+    std::vector<std::optional<std::string_view>> values(2);
+    property.getRange(
+        1,
+        3,
+        gsl::span<std::optional<std::string_view>>(values));
+    REQUIRE(values[0] == "none");
+    REQUIRE(values[1] == "f");
+  }
+}
+
+TEST_CASE(
+    "Benchmark PropertyTablePropertyView::getRange against get",
+    "[!benchmark]") {
+  const int64_t count = 500000;
+  std::vector<uint16_t> values(static_cast<size_t>(count));
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<uint16_t>(i);
+  }
+  std::vector<std::byte> data(values.size() * sizeof(uint16_t));
+  std::memcpy(data.data(), values.data(), data.size());
+
+  PropertyTableProperty propertyTableProperty;
+  ClassProperty classProperty;
+  classProperty.type = ClassProperty::Type::SCALAR;
+  classProperty.componentType = ClassProperty::ComponentType::UINT16;
+  classProperty.normalized = true;
+  classProperty.offset = 1.0;
+  classProperty.scale = 2.0;
+
+  PropertyTablePropertyView<uint16_t, true> property(
+      propertyTableProperty,
+      classProperty,
+      count,
+      gsl::span<const std::byte>(data.data(), data.size()));
+  REQUIRE(property.status() == PropertyTablePropertyViewStatus::Valid);
+
+  std::vector<double> fromGet(static_cast<size_t>(count));
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < count; ++i) {
+    fromGet[static_cast<size_t>(i)] = property.get(i).value_or(0.0);
+  }
+  const std::chrono::duration<double, std::milli> getTime =
+      std::chrono::steady_clock::now() - start;
+
+  std::vector<double> fromRange(static_cast<size_t>(count));
+  start = std::chrono::steady_clock::now();
+  property.getRange(0, count, gsl::span<double>(fromRange));
+  const std::chrono::duration<double, std::milli> rangeTime =
+      std::chrono::steady_clock::now() - start;
+
+  REQUIRE(fromGet == fromRange);
+  WARN(
+      "Reading " << count << " normalized values took " << getTime.count()
+                 << "ms with get and " << rangeTime.count()
+                 << "ms with getRange");
+}
@@ -0,0 +1,104 @@
+#include "CesiumGltf/PropertyTableStringDictionary.h"
+
+#include <catch2/catch.hpp>
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+struct StringColumn {
+  explicit StringColumn(const std::vector<std::string>& strings) {
+    uint32_t offset = 0;
+    for (const std::string& string : strings) {
+      this->offsets.emplace_back(offset);
+      this->values.insert(
+          this->values.end(),
+          reinterpret_cast<const std::byte*>(string.data()),
+          reinterpret_cast<const std::byte*>(string.data()) + string.size());
+      offset += static_cast<uint32_t>(string.size());
+    }
+    this->offsets.emplace_back(offset);
+  }
+
+  PropertyTablePropertyView<std::string_view>
+  getView(const ClassProperty& classProperty) const {
+    return PropertyTablePropertyView<std::string_view>(
+        PropertyTableProperty(),
+        classProperty,
+        static_cast<int64_t>(this->offsets.size() - 1),
+        gsl::span<const std::byte>(this->values),
+        gsl::span<const std::byte>(),
+        gsl::span<const std::byte>(
+            reinterpret_cast<const std::byte*>(this->offsets.data()),
+            this->offsets.size() * sizeof(uint32_t)),
+        PropertyComponentType::None,
+        PropertyComponentType::Uint32);
+  }
+
+  std::vector<std::byte> values;
+  std::vector<uint32_t> offsets;
+};
+} // namespace
+
+TEST_CASE("Test PropertyTableStringDictionary") {
+  StringColumn column(
+      {"residential", "residential", "commercial", "", "residential", ""});
+  ClassProperty classProperty;
+  classProperty.type = ClassProperty::Type::STRING;
+
+  SECTION("Stores each distinct value once") {
+    PropertyTablePropertyView<std::string_view> property =
+        column.getView(classProperty);
+    PropertyTableStringDictionary dictionary(property);
+
+    REQUIRE(dictionary.size() == 6);
+    CHECK(
+        dictionary.getValues() ==
+        std::vector<std::string_view>{"residential", "commercial", ""});
+
+    const std::vector<uint32_t> expected{0, 0, 1, 2, 0, 2};
+    const gsl::span<const uint32_t> indices = dictionary.getIndices();
+    CHECK(std::vector<uint32_t>(indices.begin(), indices.end()) == expected);
+    for (int64_t i = 0; i < property.size(); ++i) {
+      CHECK(dictionary.getValues()[dictionary.getIndex(i)] == property.get(i));
+    }
+
+    CHECK(dictionary.find("commercial") == 1);
+    CHECK(!dictionary.find("industrial"));
+  }
+
+  SECTION("Uses the no data and default values") {
+    classProperty.noData = "";
+    PropertyTablePropertyView<std::string_view> property =
+        column.getView(classProperty);
+    PropertyTableStringDictionary dictionary(property);
+    CHECK(
+        dictionary.getValues() ==
+        std::vector<std::string_view>{"residential", "commercial"});
+    CHECK(dictionary.getIndex(3) == PropertyTableStringDictionary::NoValue);
+    CHECK(!dictionary.find(""));
+
+    classProperty.defaultProperty = "unknown";
+    property = column.getView(classProperty);
+    dictionary = PropertyTableStringDictionary(property);
+    const std::vector<std::string_view> expected{
+        "residential",
+        "commercial",
+        "unknown"};
+    CHECK(dictionary.getValues() == expected);
+    CHECK(dictionary.getIndex(5) == 2);
+  }
+
+  SECTION("Is empty for an invalid property") {
+    PropertyTableStringDictionary dictionary(
+        PropertyTablePropertyView<std::string_view>(
+            PropertyTablePropertyViewStatus::ErrorNonexistentProperty));
+    CHECK(dictionary.size() == 0);
+    CHECK(dictionary.getValues().empty());
+  }
+}
@@ -5341,3 +5341,99 @@ TEST_CASE("Test callback for empty PropertyTableProperty with default value") {
 
   REQUIRE(invokedCallbackCount == 1);
 }
+
+TEST_CASE("Test callback for a PropertyTableProperty of one of the given "
+          "types") {
+  Model model;
+  std::vector<glm::ivec3> values = {
+      glm::ivec3(-12, 34, 30),
+      glm::ivec3(11, 73, 0),
+      glm::ivec3(-2, 6, 12),
+      glm::ivec3(-4, 8, -13)};
+
+  addBufferToModel(model, values);
+  size_t valueBufferViewIndex = model.bufferViews.size() - 1;
+
+  ExtensionModelExtStructuralMetadata& metadata =
+      model.addExtension<ExtensionModelExtStructuralMetadata>();
+
+  Schema& schema = metadata.schema.emplace();
+  Class& testClass = schema.classes["TestClass"];
+  ClassProperty& testClassProperty = testClass.properties["TestClassProperty"];
+  testClassProperty.type = ClassProperty::Type::VEC3;
+  testClassProperty.componentType = ClassProperty::ComponentType::INT32;
+
+  PropertyTable& propertyTable = metadata.propertyTables.emplace_back();
+  propertyTable.classProperty = "TestClass";
+  propertyTable.count = static_cast<int64_t>(values.size());
+
+  PropertyTableProperty& propertyTableProperty =
+      propertyTable.properties["TestClassProperty"];
+  propertyTableProperty.values = static_cast<int32_t>(valueBufferViewIndex);
+
+  PropertyTableView view(model, propertyTable);
+  REQUIRE(view.status() == PropertyTableViewStatus::Valid);
+  REQUIRE(view.size() == propertyTable.count);
+
+  uint32_t invokedCallbackCount = 0;
+
+  SECTION("Passes a view of the matching type") {
+    view.getPropertyViewOfTypes<
+        PropertyTablePropertyView<float>,
+        PropertyTablePropertyView<glm::ivec3, true>,
+        PropertyTablePropertyView<glm::ivec3>>(
+        "TestClassProperty",
+        [&values, &invokedCallbackCount](
+            const std::string& /*propertyId*/,
+            auto propertyValue) mutable {
+          invokedCallbackCount++;
+          if constexpr (std::is_same_v<
+                            PropertyTablePropertyView<glm::ivec3>,
+                            decltype(propertyValue)>) {
+            REQUIRE(
+                propertyValue.status() ==
+                PropertyTablePropertyViewStatus::Valid);
+            REQUIRE(propertyValue.size() == int64_t(values.size()));
+            for (int64_t i = 0; i < propertyValue.size(); ++i) {
+              REQUIRE(propertyValue.get(i) == values[static_cast<size_t>(i)]);
+            }
+          } else {
+            FAIL("getPropertyViewOfTypes returned PropertyTablePropertyView "
+                 "of incorrect type for TestClassProperty.");
+          }
+        });
+  }
+
+  SECTION("Passes an invalid view of the first type for other types") {
+    view.getPropertyViewOfTypes<
+        PropertyTablePropertyView<float>,
+        PropertyTablePropertyView<glm::ivec3, true>>(
+        "TestClassProperty",
+        [&invokedCallbackCount](
+            const std::string& /*propertyId*/,
+            auto propertyValue) mutable {
+          invokedCallbackCount++;
+          REQUIRE(std::is_same_v<
+                  PropertyTablePropertyView<float>,
+                  decltype(propertyValue)>);
+          REQUIRE(
+              propertyValue.status() ==
+              PropertyTablePropertyViewStatus::ErrorTypeMismatch);
+        });
+  }
+
+  SECTION("Passes an invalid view of the first type for a missing property") {
+    view.getPropertyViewOfTypes<PropertyTablePropertyView<glm::ivec3>>(
+        "NonexistentProperty",
+        [&invokedCallbackCount](
+            const std::string& /*propertyId*/,
+            auto propertyValue) mutable {
+          invokedCallbackCount++;
+          REQUIRE(
+              propertyValue.status() ==
+              PropertyTablePropertyViewStatus::ErrorNonexistentProperty);
+        });
+  }
+
+  REQUIRE(invokedCallbackCount == 1);
+}
@@ -13,6 +13,18 @@ using namespace CesiumGltf;
 using namespace CesiumUtility;
 
 namespace {
+template <typename View>
+void checkBatchedValues(
+    const View& view,
+    const std::vector<glm::dvec2>& texCoords) {
+  std::vector<decltype(view.get(0.0, 0.0))> values(texCoords.size());
+  view.get(texCoords, gsl::span(values));
+  for (size_t i = 0; i < texCoords.size(); i++) {
+    glm::dvec2 uv = texCoords[i];
+    REQUIRE(values[i] == view.get(uv[0], uv[1]));
+  }
+}
+
 template <typename T>
 void checkTextureValues(
     const std::vector<uint8_t>& data,
@@ -33,7 +45,7 @@ void checkTextureValues(
   image.channels = static_cast<int32_t>(sizeof(T));
   image.bytesPerChannel = 1;
 
-  std::vector<std::byte>& imageData = image.pixelData;
+  CesiumUtility::ByteVector& imageData = image.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -73,6 +85,8 @@ void checkTextureValues(
     REQUIRE(view.getRaw(uv[0], uv[1]) == expected[i]);
     REQUIRE(view.get(uv[0], uv[1]) == expected[i]);
   }
+
+  checkBatchedValues(view, texCoords);
 }
 
 template <typename T>
@@ -105,7 +119,7 @@ void checkTextureValues(
   image.channels = static_cast<int32_t>(sizeof(T));
   image.bytesPerChannel = 1;
 
-  std::vector<std::byte>& imageData = image.pixelData;
+  CesiumUtility::ByteVector& imageData = image.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -145,6 +159,8 @@ void checkTextureValues(
     REQUIRE(view.getRaw(uv[0], uv[1]) == expectedRaw[i]);
     REQUIRE(view.get(uv[0], uv[1]) == expectedTransformed[i]);
   }
+
+  checkBatchedValues(view, texCoords);
 }
 
 template <typename T, typename D = typename TypeToNormalizedType<T>::type>
@@ -179,7 +195,7 @@ void checkNormalizedTextureValues(
   image.channels = static_cast<int32_t>(sizeof(T));
   image.bytesPerChannel = 1;
 
-  std::vector<std::byte>& imageData = image.pixelData;
+  CesiumUtility::ByteVector& imageData = image.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -223,6 +239,8 @@ void checkNormalizedTextureValues(
     REQUIRE(view.getRaw(uv[0], uv[1]) == expectedRaw[i]);
     REQUIRE(view.get(uv[0], uv[1]) == expectedTransformed[i]);
   }
+
+  checkBatchedValues(view, texCoords);
 }
 
 template <typename T>
@@ -250,7 +268,7 @@ void checkTextureArrayValues(
       static_cast<int32_t>(count) * static_cast<int32_t>(sizeof(T));
   image.bytesPerChannel = 1;
 
-  std::vector<std::byte>& imageData = image.pixelData;
+  CesiumUtility::ByteVector& imageData = image.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -336,7 +354,7 @@ void checkTextureArrayValues(
       static_cast<int32_t>(count) * static_cast<int32_t>(sizeof(T));
   image.bytesPerChannel = 1;
 
-  std::vector<std::byte>& imageData = image.pixelData;
+  CesiumUtility::ByteVector& imageData = image.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -436,7 +454,7 @@ void checkNormalizedTextureArrayValues(
       static_cast<int32_t>(count) * static_cast<int32_t>(sizeof(T));
   image.bytesPerChannel = 1;
 
-  std::vector<std::byte>& imageData = image.pixelData;
+  CesiumUtility::ByteVector& imageData = image.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -1422,7 +1440,7 @@ TEST_CASE("Check that PropertyTextureProperty values override class property "
     expectedTransformed[i] = value * scale + offset;
   }
 
-  std::vector<std::byte>& imageData = image.pixelData;
+  CesiumUtility::ByteVector& imageData = image.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -1456,6 +1474,8 @@ TEST_CASE("Check that PropertyTextureProperty values override class property "
     REQUIRE(view.getRaw(uv[0], uv[1]) == expectedRaw[i]);
     REQUIRE(view.get(uv[0], uv[1]) == expectedTransformed[i]);
   }
+
+  checkBatchedValues(view, texCoords);
 }
 
 TEST_CASE("Check that non-adjacent channels resolve to expected output") {
@@ -1488,7 +1508,7 @@ TEST_CASE("Check that non-adjacent channels resolve to expected output") {
       2, 3, 8, 1};
     // clang-format on
 
-    std::vector<std::byte>& imageData = image.pixelData;
+    CesiumUtility::ByteVector& imageData = image.pixelData;
     imageData.resize(data.size());
     std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -1529,7 +1549,7 @@ TEST_CASE("Check that non-adjacent channels resolve to expected output") {
       1, 0, 1, 0,
       2, 3, 8, 1};
     // clang-format on
-    std::vector<std::byte>& imageData = image.pixelData;
+    CesiumUtility::ByteVector& imageData = image.pixelData;
     imageData.resize(data.size());
     std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -1570,7 +1590,7 @@ TEST_CASE("Check that non-adjacent channels resolve to expected output") {
       1, 0, 1, 0,
       2, 3, 8, 1};
     // clang-format on
-    std::vector<std::byte>& imageData = image.pixelData;
+    CesiumUtility::ByteVector& imageData = image.pixelData;
     imageData.resize(data.size());
     std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -1617,7 +1637,7 @@ TEST_CASE("Check that non-adjacent channels resolve to expected output") {
       0, 5, 2, 27};
     // clang-format on
 
-    std::vector<std::byte>& imageData = image.pixelData;
+    CesiumUtility::ByteVector& imageData = image.pixelData;
     imageData.resize(data.size());
     std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -1667,7 +1687,7 @@ TEST_CASE("Check sampling with different sampler values") {
   image.bytesPerChannel = 1;
 
   std::vector<uint8_t> data{12, 33, 56, 67};
-  std::vector<std::byte>& imageData = image.pixelData;
+  CesiumUtility::ByteVector& imageData = image.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -1799,7 +1819,7 @@ TEST_CASE("Test PropertyTextureProperty constructs with "
   image.channels = 1;
   image.bytesPerChannel = 1;
 
-  std::vector<std::byte>& imageData = image.pixelData;
+  CesiumUtility::ByteVector& imageData = image.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -1841,6 +1861,8 @@ TEST_CASE("Test PropertyTextureProperty constructs with "
     REQUIRE(view.getRaw(uv[0], uv[1]) == expectedValues[i]);
     REQUIRE(view.get(uv[0], uv[1]) == expectedValues[i]);
   }
+
+  checkBatchedValues(view, texCoords);
 }
 
 TEST_CASE("Test normalized PropertyTextureProperty constructs with "
@@ -1872,7 +1894,7 @@ TEST_CASE("Test normalized PropertyTextureProperty constructs with "
   image.channels = 1;
   image.bytesPerChannel = 1;
 
-  std::vector<std::byte>& imageData = image.pixelData;
+  CesiumUtility::ByteVector& imageData = image.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -1946,7 +1968,7 @@ TEST_CASE("Test PropertyTextureProperty constructs with "
   image.channels = 1;
   image.bytesPerChannel = 1;
 
-  std::vector<std::byte>& imageData = image.pixelData;
+  CesiumUtility::ByteVector& imageData = image.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -1960,7 +1982,7 @@ TEST_CASE("Test PropertyTextureProperty constructs with "
   REQUIRE(view.status() == PropertyTexturePropertyViewStatus::Valid);
 
   // Clear the original image data.
-  std::vector<std::byte> emptyData;
+  CesiumUtility::ByteVector emptyData;
   image.pixelData.swap(emptyData);
 
   const ImageCesium* pImage = view.getImage();
@@ -2013,7 +2035,7 @@ TEST_CASE("Test normalized PropertyTextureProperty constructs with "
   image.channels = 1;
   image.bytesPerChannel = 1;
 
-  std::vector<std::byte>& imageData = image.pixelData;
+  CesiumUtility::ByteVector& imageData = image.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -2027,7 +2049,7 @@ TEST_CASE("Test normalized PropertyTextureProperty constructs with "
   REQUIRE(view.status() == PropertyTexturePropertyViewStatus::Valid);
 
   // Clear the original image data.
-  std::vector<std::byte> emptyData;
+  CesiumUtility::ByteVector emptyData;
   image.pixelData.swap(emptyData);
 
   const ImageCesium* pImage = view.getImage();
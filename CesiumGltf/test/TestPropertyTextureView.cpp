@@ -24,7 +24,7 @@ void addTextureToModel(
   image.cesium.channels = channels;
   image.cesium.bytesPerChannel = 1;
 
-  std::vector<std::byte>& imageData = image.cesium.pixelData;
+  CesiumUtility::ByteVector& imageData = image.cesium.pixelData;
   imageData.resize(data.size());
   std::memcpy(imageData.data(), data.data(), data.size());
 
@@ -247,7 +247,7 @@ TEST_CASE("Test scalar PropertyTextureProperty") {
     REQUIRE(uint8Property.status() == PropertyTexturePropertyViewStatus::Valid);
 
     // Clear the original image data.
-    std::vector<std::byte> emptyData;
+    CesiumUtility::ByteVector emptyData;
     model.images[model.images.size() - 1].cesium.pixelData.swap(emptyData);
 
     std::vector<glm::dvec2> texCoords{
@@ -492,7 +492,7 @@ TEST_CASE("Test scalar PropertyTextureProperty (normalized)") {
     REQUIRE(uint8Property.status() == PropertyTexturePropertyViewStatus::Valid);
 
     // Clear the original image data.
-    std::vector<std::byte> emptyData;
+    CesiumUtility::ByteVector emptyData;
     model.images[model.images.size() - 1].cesium.pixelData.swap(emptyData);
 
     std::vector<glm::dvec2> texCoords{
@@ -688,7 +688,7 @@ TEST_CASE("Test vecN PropertyTextureProperty") {
         u8vec2Property.status() == PropertyTexturePropertyViewStatus::Valid);
 
     // Clear the original image data.
-    std::vector<std::byte> emptyData;
+    CesiumUtility::ByteVector emptyData;
     model.images[model.images.size() - 1].cesium.pixelData.swap(emptyData);
 
     std::vector<glm::dvec2> texCoords{
@@ -902,7 +902,7 @@ TEST_CASE("Test vecN PropertyTextureProperty (normalized)") {
         u8vec2Property.status() == PropertyTexturePropertyViewStatus::Valid);
 
     // Clear the original image data.
-    std::vector<std::byte> emptyData;
+    CesiumUtility::ByteVector emptyData;
     model.images[model.images.size() - 1].cesium.pixelData.swap(emptyData);
 
     std::vector<glm::dvec2> texCoords{
@@ -1149,7 +1149,7 @@ TEST_CASE("Test array PropertyTextureProperty") {
         PropertyTexturePropertyViewStatus::Valid);
 
     // Clear the original image data.
-    std::vector<std::byte> emptyData;
+    CesiumUtility::ByteVector emptyData;
     model.images[model.images.size() - 1].cesium.pixelData.swap(emptyData);
 
     std::vector<glm::dvec2> texCoords{
@@ -1417,7 +1417,7 @@ TEST_CASE("Test array PropertyTextureProperty (normalized)") {
         PropertyTexturePropertyViewStatus::Valid);
 
     // Clear the original image data.
-    std::vector<std::byte> emptyData;
+    CesiumUtility::ByteVector emptyData;
     model.images[model.images.size() - 1].cesium.pixelData.swap(emptyData);
 
     std::vector<glm::dvec2> texCoords{
@@ -2238,7 +2238,7 @@ TEST_CASE("Test callback for scalar PropertyTextureProperty") {
                 PropertyTexturePropertyViewStatus::Valid);
 
             // Clear the original image data.
-            std::vector<std::byte> emptyData;
+            CesiumUtility::ByteVector emptyData;
             model.images[model.images.size() - 1].cesium.pixelData.swap(
                 emptyData);
 
@@ -2360,7 +2360,7 @@ TEST_CASE("Test callback for scalar PropertyTextureProperty (normalized)") {
                 PropertyTexturePropertyViewStatus::Valid);
 
             // Clear the original image data.
-            std::vector<std::byte> emptyData;
+            CesiumUtility::ByteVector emptyData;
             model.images[model.images.size() - 1].cesium.pixelData.swap(
                 emptyData);
 
@@ -2491,7 +2491,7 @@ TEST_CASE("Test callback for vecN PropertyTextureProperty") {
                 PropertyTexturePropertyViewStatus::Valid);
 
             // Clear the original image data.
-            std::vector<std::byte> emptyData;
+            CesiumUtility::ByteVector emptyData;
             model.images[model.images.size() - 1].cesium.pixelData.swap(
                 emptyData);
 
@@ -2623,7 +2623,7 @@ TEST_CASE("Test callback for vecN PropertyTextureProperty (normalized)") {
                 PropertyTexturePropertyViewStatus::Valid);
 
             // Clear the original image data.
-            std::vector<std::byte> emptyData;
+            CesiumUtility::ByteVector emptyData;
             model.images[model.images.size() - 1].cesium.pixelData.swap(
                 emptyData);
 
@@ -2775,7 +2775,7 @@ TEST_CASE("Test callback for array PropertyTextureProperty") {
                 PropertyTexturePropertyViewStatus::Valid);
 
             // Clear the original image data.
-            std::vector<std::byte> emptyData;
+            CesiumUtility::ByteVector emptyData;
             model.images[model.images.size() - 1].cesium.pixelData.swap(
                 emptyData);
 
@@ -2946,7 +2946,7 @@ TEST_CASE("Test callback for array PropertyTextureProperty (normalized)") {
                 PropertyTexturePropertyViewStatus::Valid);
 
             // Clear the original image data.
-            std::vector<std::byte> emptyData;
+            CesiumUtility::ByteVector emptyData;
             model.images[model.images.size() - 1].cesium.pixelData.swap(
                 emptyData);
 
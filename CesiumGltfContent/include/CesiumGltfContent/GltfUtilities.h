@@ -2,11 +2,15 @@
 
 #include "Library.h"
 
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/Future.h>
 #include <CesiumGeospatial/BoundingRegion.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumGltf/Model.h>
 
 #include <glm/fwd.hpp>
 
+#include <functional>
 #include <optional>
 #include <string_view>
 #include <vector>
@@ -109,6 +113,33 @@ struct CESIUMGLTFCONTENT_API GltfUtilities {
       const CesiumGltf::Model& gltf,
       const glm::dmat4& transform);
 
+  /**
+   * @brief Applies the given callback to the primitives of a scene on worker
+   * threads.
+   *
+   * This visits the same primitives, with the same transforms, as
+   * {@link CesiumGltf::Model::forEachPrimitiveInScene}, but the scene is first
+   * flattened with {@link CesiumGltf::Model::getPrimitivesInScene} and the
+   * primitives are then shared among several worker threads. The callback is
+   * called concurrently and in no particular order, so it must be safe to
+   * call from several threads at once. It must not modify the model.
+   *
+   * @param asyncSystem The async system whose worker threads to use.
+   * @param gltf The model, which must stay alive and unchanged until the
+   * returned future resolves.
+   * @param sceneID The scene ID (index), chosen as in
+   * {@link CesiumGltf::Model::forEachPrimitiveInScene}.
+   * @param callback The callback to apply to each primitive.
+   * @return A future that resolves once the callback has been applied to
+   * every primitive, or rejects if any call throws.
+   */
+  static CesiumAsync::Future<void> forEachPrimitiveInSceneInParallel(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const CesiumGltf::Model& gltf,
+      int32_t sceneID,
+      std::function<CesiumGltf::Model::ForEachPrimitiveInSceneConstCallback>&&
+          callback);
+
   /**
    * @brief Parse the copyright field of a glTF model and return the individual
    * credits.
@@ -185,5 +216,103 @@ struct CESIUMGLTFCONTENT_API GltfUtilities {
    * @param bufferIndex The index of the buffer to compact.
    */
   static void compactBuffer(CesiumGltf::Model& gltf, int32_t bufferIndex);
+
+  /**
+   * @brief Merges the glTF's buffers into the first one, like
+   * {@link collapseToSingleBuffer}, and removes the bytes that are not
+   * referenced by any BufferView, like {@link compactBuffers}.
+   *
+   * This is much faster than calling those two functions one after the other.
+   * The used bytes of every buffer are copied once, into a buffer that is
+   * allocated at its final size, and all of the BufferView offsets are
+   * updated in a single pass. Each used range keeps its offset modulo 8, so
+   * the alignment of the data is not disrupted.
+   *
+   * Call {@link removeUnusedAccessors} and {@link removeUnusedBufferViews}
+   * first so that the bytes they referred to are removed too.
+   *
+   * @param gltf The glTF to modify.
+   */
+  static void collapseToSingleCompactBuffer(CesiumGltf::Model& gltf);
+
+  /**
+   * @brief Reorders the triangles and vertices of each indexed triangle
+   * primitive so that they render faster.
+   *
+   * The triangles are reordered to make better use of the GPU's vertex cache
+   * and to reduce overdraw, and then the vertices are reordered in the order
+   * that the triangles use them. Vertices that aren't used by any triangle
+   * are removed. This is done with meshoptimizer.
+   *
+   * The accessors are modified in place, so a primitive is only optimized if
+   * none of its accessors are sparse or used anywhere else in the model.
+   * Primitives with skirts or with extensions that refer to their indices,
+   * such as `CESIUM_primitive_outline`, are left as they are.
+   *
+   * @param gltf The glTF to modify.
+   */
+  static void optimizeMeshes(CesiumGltf::Model& gltf);
+
+  /**
+   * @brief Simplifies each indexed triangle primitive so that it has fewer
+   * triangles, and then optimizes it like {@link optimizeMeshes}.
+   *
+   * Triangles are collapsed with meshoptimizer as long as no position moves by
+   * more than the given error from the original surface. The error is
+   * measured in the units of the positions, before any node transforms are
+   * applied. The vertices on the border of each primitive are kept where they
+   * are, so that its edges still meet the primitives next to it, such as
+   * those of neighboring tiles.
+   *
+   * Only primitives with float positions and without morph targets are
+   * simplified, with the same restrictions as {@link optimizeMeshes}. Other
+   * vertex attributes are kept for the vertices that remain, but are not
+   * taken into account when choosing which triangles to collapse.
+   *
+   * @param gltf The glTF to modify.
+   * @param maximumError The largest distance that the surface may move. If
+   * this is not greater than 0, the model is left as it is.
+   */
+  static void simplifyMeshes(CesiumGltf::Model& gltf, double maximumError);
+
+  /**
+   * @brief Merges the primitives of each mesh that can be drawn together, so
+   * that they take fewer draw calls.
+   *
+   * Primitives are merged if they have the same mode, material and attributes,
+   * with accessors of the same types, and the same `EXT_mesh_features` and
+   * `EXT_structural_metadata`. Their vertices and indices are concatenated
+   * into new accessors in a new buffer, so per-vertex feature IDs still
+   * identify the same features. Only points, lines and triangles without
+   * morph targets or skirts are merged.
+   *
+   * The accessors of the primitives that were merged are left in the model.
+   * They can be removed with {@link removeUnusedAccessors},
+   * {@link removeUnusedBufferViews} and {@link compactBuffers}.
+   *
+   * @param gltf The glTF to modify.
+   */
+  static void mergePrimitives(CesiumGltf::Model& gltf);
+
+  /**
+   * @brief Reorders the vertices of each point cloud primitive so that any
+   * prefix of them is spread evenly over the primitive.
+   *
+   * Drawing only the first `n` points of a reordered primitive then gives a
+   * coarser version of the whole point cloud, rather than a part of it, so a
+   * renderer can draw fewer points as a tile gets farther away. The points
+   * are ordered by level of detail in a hierarchy of grids over their bounds:
+   * one point, then one in each octant, then one in each octant of those, and
+   * so on.
+   *
+   * Implicit feature IDs are the indices of the vertices, so they are replaced
+   * by new feature ID attributes that keep identifying the same features.
+   * Like {@link optimizeMeshes}, the accessors are modified in place, so a
+   * primitive is only reordered if it has no indices, and none of its
+   * accessors are sparse or used anywhere else in the model.
+   *
+   * @param gltf The glTF to modify.
+   */
+  static void orderPointsForLevelOfDetail(CesiumGltf::Model& gltf);
 };
 } // namespace CesiumGltfContent
@@ -2,8 +2,12 @@
 
 #include "Library.h"
 
+#include <CesiumGltf/Ktx2TranscodeTargets.h>
+#include <CesiumUtility/Allocator.h>
+
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 // Forward declarations
 namespace CesiumGltf {
@@ -63,6 +67,43 @@ public:
       size_t sourceHeight,
       size_t bytesPerPixel);
 
+  /**
+   * @brief Scales pixels from a source to a target with bilinear filtering,
+   * without validating the provided pointers or ranges.
+   *
+   * Each channel must be 1 byte. Images with 1 to 4 channels, including
+   * RGBA8, have their own specialized loops.
+   *
+   * Bilinear filtering is appropriate for enlarging images, or for shrinking
+   * them by less than half. Shrinking them further skips source pixels.
+   *
+   * @param pTarget The pointer at which to start writing pixels.
+   * @param targetRowStride The number of bytes between rows in the target
+   * image.
+   * @param targetWidth The number of pixels to write in the horizontal
+   * direction.
+   * @param targetHeight The number of pixels to write in the vertical
+   * direction.
+   * @param pSource The pointer at which to start reading pixels.
+   * @param sourceRowStride The number of bytes between rows in the source
+   * image.
+   * @param sourceWidth The number of pixels to read in the horizontal
+   * direction.
+   * @param sourceHeight The number of pixels to read in the vertical
+   * direction.
+   * @param channels The number of channels of each pixel.
+   */
+  static void unsafeResampleImage(
+      std::byte* pTarget,
+      size_t targetRowStride,
+      size_t targetWidth,
+      size_t targetHeight,
+      const std::byte* pSource,
+      size_t sourceRowStride,
+      size_t sourceWidth,
+      size_t sourceHeight,
+      size_t channels);
+
   /**
    * @brief Copies pixels from a source image to a target image.
    *
@@ -71,7 +112,8 @@ public:
    * the target rectangle.
    *
    * The filtering algorithm for scaling is not specified, but can be assumed
-   * to provide reasonably good quality.
+   * to provide reasonably good quality. Images that are enlarged use the
+   * faster {@link unsafeResampleImage}.
    *
    * The source and target images must have the same number of channels and same
    * bytes per channel. If scaling is required, they must also use exactly 1
@@ -82,6 +124,13 @@ public:
    * range of the images. If they do not, this function will return false and
    * will not change any pixels.
    *
+   * Block-compressed images, such as those transcoded from KTX2, are copied
+   * block by block in their first mip level. Both images must have the same
+   * format, one whose blocks can be copied (see
+   * {@link computeBlockCompressedImageSize}), the rectangles must have the
+   * same size, and they must start on a block and end on a block or at the
+   * edge of the image. Compressed images can't be scaled.
+   *
    * @param target The image in which to write pixels.
    * @param targetPixels The pixels to write in the target.
    * @param source The image from which to read pixels.
@@ -96,6 +145,22 @@ public:
       const CesiumGltf::ImageCesium& source,
       const PixelRectangle& sourcePixels);
 
+  /**
+   * @brief Computes the size in bytes of the first mip level of an image in a
+   * block-compressed format.
+   *
+   * @param format The format of the image.
+   * @param width The width of the image in pixels.
+   * @param height The height of the image in pixels.
+   * @return The size in bytes, or 0 if the image is not block-compressed or
+   * its blocks can't be copied by {@link blitImage}, as with the PVRTC
+   * formats.
+   */
+  static size_t computeBlockCompressedImageSize(
+      CesiumGltf::GpuCompressedPixelFormat format,
+      int32_t width,
+      int32_t height) noexcept;
+
   /**
    * @brief Saves an image to a new byte buffer in PNG format.
    *
@@ -115,6 +180,19 @@ public:
    */
   static void
   savePng(const CesiumGltf::ImageCesium& image, std::vector<std::byte>& output);
+
+  /**
+   * @brief Saves an image to an existing byte buffer in PNG format, such as the
+   * data of a glTF buffer.
+   *
+   * @param image The image to save.
+   * @param output The buffer in which to store the PNG. The image is written to
+   * the end of the buffer. If the buffer size is unchanged on return the image
+   * could not be written.
+   */
+  static void savePng(
+      const CesiumGltf::ImageCesium& image,
+      CesiumUtility::ByteVector& output);
 };
 
 } // namespace CesiumGltfContent
@@ -2,7 +2,9 @@
 
 #include <glm/vec3.hpp>
 
+#include <cstdint>
 #include <optional>
+#include <vector>
 
 namespace CesiumGltfContent {
 struct SkirtMeshMetadata {
@@ -15,7 +17,12 @@ struct SkirtMeshMetadata {
         skirtWestHeight{0.0},
         skirtSouthHeight{0.0},
         skirtEastHeight{0.0},
-        skirtNorthHeight{0.0} {}
+        skirtNorthHeight{0.0},
+        hasBakedSkirts{true},
+        westEdgeIndices{},
+        southEdgeIndices{},
+        eastEdgeIndices{},
+        northEdgeIndices{} {}
 
   static std::optional<SkirtMeshMetadata>
   parseFromGltfExtras(const CesiumUtility::JsonValue::Object& extras);
@@ -32,5 +39,15 @@ struct SkirtMeshMetadata {
   double skirtSouthHeight;
   double skirtEastHeight;
   double skirtNorthHeight;
+
+  // Whether the skirt vertices and triangles are part of the mesh. If not,
+  // the indices of the vertices on each edge of the mesh, in the order in
+  // which a skirt would connect them, are kept below so that a renderer can
+  // generate the skirts itself.
+  bool hasBakedSkirts;
+  std::vector<uint32_t> westEdgeIndices;
+  std::vector<uint32_t> southEdgeIndices;
+  std::vector<uint32_t> eastEdgeIndices;
+  std::vector<uint32_t> northEdgeIndices;
 };
 } // namespace CesiumGltfContent
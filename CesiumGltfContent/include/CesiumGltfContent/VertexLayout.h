@@ -0,0 +1,242 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumGltf {
+struct MeshPrimitive;
+struct Model;
+} // namespace CesiumGltf
+
+namespace CesiumGltfContent {
+
+/**
+ * @brief The format of each component of a packed vertex attribute.
+ */
+enum class VertexComponentFormat {
+  /** @brief A 32-bit float. */
+  Float32,
+  /** @brief A 16-bit float. */
+  Float16,
+  /** @brief A 16-bit signed integer that maps -1.0 to 1.0. */
+  Snorm16,
+  /** @brief A 16-bit unsigned integer that maps 0.0 to 1.0. */
+  Unorm16,
+  /** @brief An 8-bit signed integer that maps -1.0 to 1.0. */
+  Snorm8,
+  /** @brief An 8-bit unsigned integer that maps 0.0 to 1.0. */
+  Unorm8
+};
+
+/**
+ * @brief The width of packed vertex indices.
+ */
+enum class IndexFormat {
+  /**
+   * @brief 16-bit indices for primitives with at most 65535 vertices, and
+   * 32-bit indices for larger ones.
+   */
+  Smallest,
+  /**
+   * @brief 16-bit indices. Indexed primitives with more than 65535 vertices
+   * are not packed.
+   */
+  UInt16,
+  /** @brief 32-bit indices. */
+  UInt32
+};
+
+/**
+ * @brief How a vertex attribute of a glTF primitive is packed.
+ */
+struct CESIUMGLTFCONTENT_API VertexAttributeLayout {
+  /**
+   * @brief The name of the attribute in
+   * {@link CesiumGltf::MeshPrimitive::attributes}, such as `POSITION`,
+   * `NORMAL` or `TEXCOORD_0`.
+   */
+  std::string semantic;
+
+  /**
+   * @brief The format of the packed components.
+   *
+   * The accessor's values are converted as the glTF specification defines,
+   * so normalized integers become floats from -1.0 or 0.0 to 1.0 first. Values
+   * outside the range of a normalized format are clamped.
+   */
+  VertexComponentFormat format = VertexComponentFormat::Float32;
+
+  /**
+   * @brief The number of packed components, from 1 to 4.
+   *
+   * Components that the accessor doesn't have are set to 0, except for the
+   * fourth, which is set to 1, as when a GPU fetches a vertex attribute with
+   * fewer components than the shader expects. Extra components of the
+   * accessor are dropped.
+   */
+  int32_t componentCount = 3;
+
+  /**
+   * @brief The vertex buffer that the attribute is packed in.
+   *
+   * The attributes of a stream are interleaved in the order of
+   * {@link VertexLayout::attributes}. Give each attribute its own stream to
+   * pack them in separate buffers instead.
+   */
+  int32_t stream = 0;
+};
+
+/**
+ * @brief The packed vertices of a stream of a {@link VertexLayout}.
+ */
+struct CESIUMGLTFCONTENT_API PackedVertexStream {
+  /**
+   * @brief The vertices, {@link byteStride} bytes each.
+   */
+  std::vector<std::byte> data;
+
+  /**
+   * @brief The number of bytes from the start of a vertex to the start of the
+   * next one.
+   */
+  int64_t byteStride = 0;
+};
+
+/**
+ * @brief The vertices and indices of a glTF primitive, packed in the format of
+ * a {@link VertexLayout}.
+ */
+struct CESIUMGLTFCONTENT_API PackedMeshPrimitive {
+  /**
+   * @brief The index of the mesh of the primitive in
+   * {@link CesiumGltf::Model::meshes}.
+   */
+  int32_t meshIndex = -1;
+
+  /**
+   * @brief The index of the primitive in the mesh's
+   * {@link CesiumGltf::Mesh::primitives}.
+   */
+  int32_t primitiveIndex = -1;
+
+  /**
+   * @brief The number of vertices, which is the number of elements of the
+   * primitive's `POSITION` accessor.
+   */
+  int64_t vertexCount = 0;
+
+  /**
+   * @brief The vertices of each stream of the layout.
+   */
+  std::vector<PackedVertexStream> streams;
+
+  /**
+   * @brief Whether the primitive has each of the attributes of
+   * {@link VertexLayout::attributes}.
+   *
+   * The attributes that it doesn't have are packed as if each of their
+   * components were missing from the accessor.
+   */
+  std::vector<bool> hasAttribute;
+
+  /**
+   * @brief The width of the packed indices. This is never
+   * {@link IndexFormat::Smallest}.
+   */
+  IndexFormat indexFormat = IndexFormat::UInt32;
+
+  /**
+   * @brief The number of indices, or 0 if the primitive isn't indexed.
+   */
+  int64_t indexCount = 0;
+
+  /**
+   * @brief The indices, in the width given by {@link indexFormat}.
+   */
+  std::vector<std::byte> indices;
+};
+
+/**
+ * @brief A layout of vertex buffers that the primitives of a glTF are packed
+ * in, so that a renderer can upload them to the GPU without converting them.
+ *
+ * Each attribute starts at a multiple of four bytes from the start of its
+ * vertex, as graphics APIs require, so an attribute whose components take
+ * fewer bytes is followed by padding. For example, a 3-component
+ * {@link VertexComponentFormat::Snorm8} normal takes four bytes.
+ */
+struct CESIUMGLTFCONTENT_API VertexLayout {
+  /**
+   * @brief The attributes to pack, in the order in which they are
+   * interleaved in their streams.
+   */
+  std::vector<VertexAttributeLayout> attributes;
+
+  /**
+   * @brief The width of the packed indices.
+   */
+  IndexFormat indexFormat = IndexFormat::Smallest;
+
+  /**
+   * @brief Gets the number of bytes that a component of the given format
+   * takes.
+   */
+  static int64_t getComponentByteSize(VertexComponentFormat format) noexcept;
+
+  /**
+   * @brief Gets the number of streams, which is one more than the largest
+   * {@link VertexAttributeLayout::stream}.
+   */
+  int32_t getStreamCount() const noexcept;
+
+  /**
+   * @brief Gets the number of bytes of each vertex of the given stream.
+   */
+  int64_t getStreamByteStride(int32_t stream) const noexcept;
+
+  /**
+   * @brief Gets the offset, in bytes, of an attribute from the start of each
+   * vertex of its stream.
+   *
+   * @param attributeIndex The index of the attribute in {@link attributes}.
+   */
+  int64_t getAttributeByteOffset(size_t attributeIndex) const noexcept;
+
+  /**
+   * @brief Packs the vertices and indices of a primitive.
+   *
+   * The primitive's topology is kept as it is. The attributes of the
+   * primitive that aren't in the layout are left out.
+   *
+   * @param model The model that the primitive belongs to.
+   * @param primitive The primitive.
+   * @return The packed primitive, or `std::nullopt` if the primitive has no
+   * `POSITION` accessor, if an accessor that is packed is invalid,
+   * sparse, or not a scalar or vector, if its attributes have different
+   * numbers of elements, if an index refers to a vertex that doesn't exist,
+   * or if the indices don't fit the {@link indexFormat}. It is also
+   * `std::nullopt` if an attribute of the layout has
+   * a {@link VertexAttributeLayout::componentCount} that isn't from 1 to 4, or
+   * a negative {@link VertexAttributeLayout::stream}.
+   */
+  std::optional<PackedMeshPrimitive> packPrimitive(
+      const CesiumGltf::Model& model,
+      const CesiumGltf::MeshPrimitive& primitive) const;
+
+  /**
+   * @brief Packs all of the primitives of a model that can be packed, as with
+   * {@link packPrimitive}, in the order of their meshes.
+   *
+   * @param model The model.
+   * @return The packed primitives.
+   */
+  std::vector<PackedMeshPrimitive>
+  packModel(const CesiumGltf::Model& model) const;
+};
+
+} // namespace CesiumGltfContent
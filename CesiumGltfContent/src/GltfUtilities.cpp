@@ -1,6 +1,7 @@
 #include <CesiumGeometry/Axis.h>
 #include <CesiumGeometry/Transforms.h>
 #include <CesiumGeospatial/BoundingRegionBuilder.h>
+#include <CesiumGltf/AccessorUtility.h>
 #include <CesiumGltf/AccessorView.h>
 #include <CesiumGltf/ExtensionBufferExtMeshoptCompression.h>
 #include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
@@ -12,6 +13,7 @@
 #include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
 #include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
 #include <CesiumGltf/ExtensionKhrTextureBasisu.h>
+#include <CesiumGltf/ExtensionMeshPrimitiveExtStructuralMetadata.h>
 #include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
 #include <CesiumGltf/ExtensionTextureWebp.h>
 #include <CesiumGltf/FeatureId.h>
@@ -20,8 +22,26 @@
 
 #include <glm/gtc/quaternion.hpp>
 
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#endif
+#include <meshoptimizer.h>
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
 using namespace CesiumGltf;
@@ -185,9 +205,13 @@ GltfUtilities::computeBoundingRegion(
   // at such extreme latitudes.
   CesiumGeospatial::BoundingRegionBuilder computedBounds;
 
+  // Reused by all primitives.
+  std::vector<glm::dvec3> positionsEcef;
+  std::vector<std::optional<CesiumGeospatial::Cartographic>> cartographics;
+
   gltf.forEachPrimitiveInScene(
       -1,
-      [&rootTransform, &computedBounds](
+      [&rootTransform, &computedBounds, &positionsEcef, &cartographics](
           const CesiumGltf::Model& gltf_,
           const CesiumGltf::Node& /*node*/,
           const CesiumGltf::Mesh& /*mesh*/,
@@ -206,13 +230,19 @@ GltfUtilities::computeBoundingRegion(
 
         const glm::dmat4 fullTransform = rootTransform * nodeTransform;
 
-        const CesiumGltf::AccessorView<glm::vec3> positionView(
-            gltf_,
-            positionAccessorIndex);
-        if (positionView.status() != CesiumGltf::AccessorViewStatus::Valid) {
+        const CesiumGltf::QuantizedPositionAccessorType positionView =
+            CesiumGltf::getQuantizedPositionAccessorView(gltf_, primitive);
+        if (std::visit(CesiumGltf::StatusFromAccessor{}, positionView) !=
+            CesiumGltf::AccessorViewStatus::Valid) {
           return;
         }
 
+        const CesiumGltf::AccessorDequantization dequantization =
+            CesiumGltf::getAccessorDequantization(
+                gltf_.accessors[static_cast<size_t>(positionAccessorIndex)]);
+        const int64_t positionCount =
+            std::visit(CesiumGltf::CountFromAccessor{}, positionView);
+
         std::optional<SkirtMeshMetadata> skirtMeshMetadata =
             SkirtMeshMetadata::parseFromGltfExtras(primitive.extras);
         int64_t vertexBegin, vertexEnd;
@@ -222,30 +252,93 @@ GltfUtilities::computeBoundingRegion(
                       skirtMeshMetadata->noSkirtVerticesCount;
         } else {
           vertexBegin = 0;
-          vertexEnd = positionView.size();
+          vertexEnd = positionCount;
         }
-
-        for (int64_t i = vertexBegin; i < vertexEnd; ++i) {
-          // Get the ECEF position
-          const glm::vec3 position = positionView[i];
-          const glm::dvec3 positionEcef =
-              glm::dvec3(fullTransform * glm::dvec4(position, 1.0));
-
-          // Convert it to cartographic
-          std::optional<CesiumGeospatial::Cartographic> cartographic =
-              CesiumGeospatial::Ellipsoid::WGS84.cartesianToCartographic(
-                  positionEcef);
-          if (!cartographic) {
-            continue;
+        vertexBegin = std::clamp<int64_t>(vertexBegin, 0, positionCount);
+        vertexEnd = std::clamp<int64_t>(vertexEnd, vertexBegin, positionCount);
+
+        // Get the ECEF positions, and convert them to cartographic at once.
+        positionsEcef.clear();
+        positionsEcef.reserve(size_t(vertexEnd - vertexBegin));
+        std::visit(
+            [&](const auto& view) {
+              const auto end = view.begin() + vertexEnd;
+              for (auto it = view.begin() + vertexBegin; it != end; ++it) {
+                positionsEcef.emplace_back(glm::dvec3(
+                    fullTransform *
+                    glm::dvec4(dequantization.apply(*it), 1.0)));
+              }
+            },
+            positionView);
+
+        cartographics.resize(positionsEcef.size());
+        CesiumGeospatial::Ellipsoid::WGS84.cartesianToCartographic(
+            positionsEcef,
+            cartographics);
+
+        for (const std::optional<CesiumGeospatial::Cartographic>&
+                 cartographic : cartographics) {
+          if (cartographic) {
+            computedBounds.expandToIncludePosition(*cartographic);
           }
-
-          computedBounds.expandToIncludePosition(*cartographic);
         }
       });
 
   return computedBounds.toRegion();
 }
 
+/*static*/ CesiumAsync::Future<void>
+GltfUtilities::forEachPrimitiveInSceneInParallel(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const CesiumGltf::Model& gltf,
+    int32_t sceneID,
+    std::function<CesiumGltf::Model::ForEachPrimitiveInSceneConstCallback>&&
+        callback) {
+  struct ParallelVisit {
+    std::vector<CesiumGltf::Model::ScenePrimitive> primitives;
+    std::function<CesiumGltf::Model::ForEachPrimitiveInSceneConstCallback>
+        callback;
+    std::atomic<size_t> nextPrimitive = 0;
+  };
+
+  auto pVisit = std::make_shared<ParallelVisit>();
+  pVisit->primitives = gltf.getPrimitivesInScene(sceneID);
+  pVisit->callback = std::move(callback);
+  if (pVisit->primitives.empty()) {
+    return asyncSystem.createResolvedFuture();
+  }
+
+  // The primitives have very different sizes, so each task takes the next
+  // unvisited primitive until there are none left.
+  const size_t taskCount = std::min<size_t>(
+      pVisit->primitives.size(),
+      std::max(std::thread::hardware_concurrency(), 1U));
+
+  // Each task resolves to its index only because `all` needs a value.
+  std::vector<CesiumAsync::Future<size_t>> tasks;
+  tasks.reserve(taskCount);
+  for (size_t i = 0; i < taskCount; ++i) {
+    tasks.emplace_back(asyncSystem.runInWorkerThread([pVisit, &gltf, i]() {
+      const std::vector<CesiumGltf::Model::ScenePrimitive>& primitives =
+          pVisit->primitives;
+      for (size_t j = pVisit->nextPrimitive++; j < primitives.size();
+           j = pVisit->nextPrimitive++) {
+        const CesiumGltf::Model::ScenePrimitive& primitive = primitives[j];
+        pVisit->callback(
+            gltf,
+            *primitive.pNode,
+            *primitive.pMesh,
+            *primitive.pPrimitive,
+            primitive.transform);
+      }
+      return i;
+    }));
+  }
+
+  return asyncSystem.all(std::move(tasks))
+      .thenImmediately([](std::vector<size_t>&&) {});
+}
+
 std::vector<std::string_view>
 GltfUtilities::parseGltfCopyright(const CesiumGltf::Model& gltf) {
   std::vector<std::string_view> result;
@@ -867,4 +960,1160 @@ void GltfUtilities::compactBuffer(
   }
 }
 
+namespace {
+
+// A range of bytes used in a source buffer, and where it goes in the
+// collapsed buffer.
+struct UsedBufferRange {
+  int64_t start;
+  int64_t end;
+  int64_t destination;
+};
+
+// Whether collapseToSingleBuffer would leave this buffer intact.
+bool isExternalBuffer(const Buffer& buffer) {
+  const ExtensionBufferExtMeshoptCompression* pMeshOpt =
+      buffer.getExtension<ExtensionBufferExtMeshoptCompression>();
+  const bool isMeshOptFallback = pMeshOpt && pMeshOpt->fallback;
+  return buffer.cesium.data.empty() && (buffer.uri || isMeshOptFallback);
+}
+
+// Updates a bufferView's or a meshopt extension's buffer and offset.
+void relocateBufferRange(
+    const std::vector<std::vector<UsedBufferRange>>& usedRanges,
+    const std::vector<int32_t>& indexMap,
+    int32_t& bufferIndex,
+    int64_t& byteOffset) {
+  if (bufferIndex < 0 || size_t(bufferIndex) >= usedRanges.size()) {
+    return;
+  }
+
+  const std::vector<UsedBufferRange>& ranges = usedRanges[size_t(bufferIndex)];
+  auto it = std::upper_bound(
+      ranges.begin(),
+      ranges.end(),
+      byteOffset,
+      [](int64_t offset, const UsedBufferRange& range) {
+        return offset < range.start;
+      });
+  if (it != ranges.begin()) {
+    --it;
+    byteOffset = it->destination + (byteOffset - it->start);
+  }
+
+  const int32_t newIndex = indexMap[size_t(bufferIndex)];
+  bufferIndex = newIndex == -1 ? 0 : newIndex;
+}
+
+} // namespace
+
+void GltfUtilities::collapseToSingleCompactBuffer(CesiumGltf::Model& gltf) {
+  if (gltf.buffers.empty())
+    return;
+
+  // The first buffer and those that collapseToSingleBuffer would merge into it
+  // are collapsed. The others are kept as they are.
+  std::vector<bool> isCollapsed(gltf.buffers.size());
+  std::vector<bool> keepBuffer(gltf.buffers.size());
+  for (size_t i = 0; i < gltf.buffers.size(); ++i) {
+    isCollapsed[i] = i == 0 || !isExternalBuffer(gltf.buffers[i]);
+    keepBuffer[i] = i == 0 || !isCollapsed[i];
+  }
+
+  // Find the ranges of each buffer that are used by a bufferView.
+  std::vector<std::vector<UsedBufferRange>> usedRanges(gltf.buffers.size());
+  auto addUsedRange = [&](int32_t bufferIndex, int64_t start, int64_t length) {
+    if (bufferIndex >= 0 && size_t(bufferIndex) < usedRanges.size() &&
+        isCollapsed[size_t(bufferIndex)] && start >= 0 && length >= 0) {
+      usedRanges[size_t(bufferIndex)].push_back({start, start + length, 0});
+    }
+  };
+
+  for (const BufferView& bufferView : gltf.bufferViews) {
+    addUsedRange(
+        bufferView.buffer,
+        bufferView.byteOffset,
+        bufferView.byteLength);
+
+    const ExtensionBufferViewExtMeshoptCompression* pMeshOpt =
+        bufferView.getExtension<ExtensionBufferViewExtMeshoptCompression>();
+    if (pMeshOpt) {
+      addUsedRange(
+          pMeshOpt->buffer,
+          pMeshOpt->byteOffset,
+          pMeshOpt->byteLength);
+    }
+  }
+
+  // Merge the overlapping ranges, and place each one in the collapsed buffer
+  // at the same offset modulo 8 as in its source, so that the alignment of
+  // every bufferView is kept.
+  int64_t size = 0;
+  for (std::vector<UsedBufferRange>& ranges : usedRanges) {
+    std::sort(
+        ranges.begin(),
+        ranges.end(),
+        [](const UsedBufferRange& a, const UsedBufferRange& b) {
+          return a.start < b.start;
+        });
+
+    size_t merged = 0;
+    for (size_t i = 1; i < ranges.size(); ++i) {
+      if (ranges[i].start <= ranges[merged].end) {
+        ranges[merged].end = std::max(ranges[merged].end, ranges[i].end);
+      } else {
+        ranges[++merged] = ranges[i];
+      }
+    }
+    if (!ranges.empty()) {
+      ranges.resize(merged + 1);
+    }
+
+    for (UsedBufferRange& range : ranges) {
+      range.destination = size + (((range.start - size) % 8) + 8) % 8;
+      size = range.destination + (range.end - range.start);
+    }
+  }
+
+  // Copy every used range once, into a buffer allocated at its final size.
+  CesiumUtility::ByteVector data(
+      size_t(size),
+      CesiumUtility::AllocationCategory::GltfBuffer);
+  for (size_t i = 0; i < usedRanges.size(); ++i) {
+    const CesiumUtility::ByteVector& source = gltf.buffers[i].cesium.data;
+    for (const UsedBufferRange& range : usedRanges[i]) {
+      const int64_t available =
+          std::min(range.end, int64_t(source.size())) - range.start;
+      if (available > 0) {
+        std::memcpy(
+            data.data() + range.destination,
+            source.data() + range.start,
+            size_t(available));
+      }
+    }
+  }
+
+  const std::vector<int32_t> indexMap = getIndexMap(keepBuffer);
+  for (BufferView& bufferView : gltf.bufferViews) {
+    relocateBufferRange(
+        usedRanges,
+        indexMap,
+        bufferView.buffer,
+        bufferView.byteOffset);
+
+    ExtensionBufferViewExtMeshoptCompression* pMeshOpt =
+        bufferView.getExtension<ExtensionBufferViewExtMeshoptCompression>();
+    if (pMeshOpt) {
+      relocateBufferRange(
+          usedRanges,
+          indexMap,
+          pMeshOpt->buffer,
+          pMeshOpt->byteOffset);
+    }
+  }
+
+  Buffer& destinationBuffer = gltf.buffers[0];
+  destinationBuffer.cesium.data = std::move(data);
+  destinationBuffer.byteLength = size;
+
+  gltf.buffers.erase(
+      std::remove_if(
+          gltf.buffers.begin(),
+          gltf.buffers.end(),
+          [&keepBuffer, &gltf](const Buffer& buffer) {
+            int64_t index = &buffer - &gltf.buffers[0];
+            assert(index >= 0 && size_t(index) < keepBuffer.size());
+            return !keepBuffer[size_t(index)];
+          }),
+      gltf.buffers.end());
+}
+
+namespace {
+
+// The elements of an accessor, which can be modified in place.
+struct AccessorElements {
+  std::byte* pData;
+  size_t count;
+  size_t size;
+  size_t stride;
+};
+
+std::optional<AccessorElements>
+getAccessorElements(Model& gltf, const Accessor& accessor) {
+  if (accessor.sparse || accessor.count <= 0) {
+    return std::nullopt;
+  }
+
+  BufferView* pBufferView =
+      Model::getSafe(&gltf.bufferViews, accessor.bufferView);
+  Buffer* pBuffer =
+      pBufferView ? Model::getSafe(&gltf.buffers, pBufferView->buffer)
+                  : nullptr;
+  if (!pBuffer) {
+    return std::nullopt;
+  }
+
+  const int64_t size = accessor.computeBytesPerVertex();
+  const int64_t stride = accessor.computeByteStride(gltf);
+  if (size <= 0 || stride < size || accessor.byteOffset < 0 ||
+      pBufferView->byteOffset < 0 ||
+      accessor.byteOffset + stride * (accessor.count - 1) + size >
+          pBufferView->byteLength ||
+      pBufferView->byteOffset + pBufferView->byteLength >
+          int64_t(pBuffer->cesium.data.size())) {
+    return std::nullopt;
+  }
+
+  return AccessorElements{
+      pBuffer->cesium.data.data() + pBufferView->byteOffset +
+          accessor.byteOffset,
+      size_t(accessor.count),
+      size_t(size),
+      size_t(stride)};
+}
+
+template <typename T>
+void readIndices(
+    const AccessorElements& elements,
+    std::vector<uint32_t>& indices) {
+  for (size_t i = 0; i < elements.count; ++i) {
+    T index;
+    std::memcpy(&index, elements.pData + i * elements.stride, sizeof(T));
+    indices[i] = index;
+  }
+}
+
+template <typename T>
+void writeIndices(
+    const AccessorElements& elements,
+    const std::vector<uint32_t>& indices) {
+  for (size_t i = 0; i < elements.count; ++i) {
+    const T index = static_cast<T>(indices[i]);
+    std::memcpy(elements.pData + i * elements.stride, &index, sizeof(T));
+  }
+}
+
+// Whether the primitive has no extensions but the metadata ones. Others, like
+// CESIUM_primitive_outline, refer to the vertices by index.
+bool hasOnlyMetadataExtensions(const MeshPrimitive& primitive) {
+  for (const auto& pair : primitive.extensions) {
+    if (pair.first != ExtensionExtMeshFeatures::ExtensionName &&
+        pair.first != ExtensionMeshPrimitiveExtStructuralMetadata::
+                          ExtensionName) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Counts the number of times that each accessor is used in the model.
+std::vector<int32_t> countAccessorUses(Model& gltf) {
+  std::vector<int32_t> useCounts(gltf.accessors.size(), 0);
+  auto countUse = [&useCounts](int32_t index) {
+    if (index >= 0 && size_t(index) < useCounts.size()) {
+      ++useCounts[size_t(index)];
+    }
+  };
+
+  VisitAccessorIds()(gltf, countUse);
+  for (const Mesh& mesh : gltf.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      for (const auto& target : primitive.targets) {
+        for (const auto& pair : target) {
+          countUse(pair.second);
+        }
+      }
+    }
+  }
+
+  return useCounts;
+}
+
+bool isUsedOnce(int32_t index, const std::vector<int32_t>& useCounts) {
+  return index >= 0 && size_t(index) < useCounts.size() &&
+         useCounts[size_t(index)] == 1;
+}
+
+// Whether the accessors of the primitive's vertices are not used anywhere else
+// in the model, so that they can be modified in place.
+bool hasOnlyUnsharedVertexAccessors(
+    const MeshPrimitive& primitive,
+    const std::vector<int32_t>& useCounts) {
+  for (const auto& pair : primitive.attributes) {
+    if (!isUsedOnce(pair.second, useCounts)) {
+      return false;
+    }
+  }
+  for (const auto& target : primitive.targets) {
+    for (const auto& pair : target) {
+      if (!isUsedOnce(pair.second, useCounts)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool canOptimizePrimitive(
+    const MeshPrimitive& primitive,
+    const std::vector<int32_t>& useCounts) {
+  if (primitive.mode != MeshPrimitive::Mode::TRIANGLES ||
+      SkirtMeshMetadata::parseFromGltfExtras(primitive.extras) ||
+      !hasOnlyMetadataExtensions(primitive)) {
+    return false;
+  }
+
+  return isUsedOnce(primitive.indices, useCounts) &&
+         hasOnlyUnsharedVertexAccessors(primitive, useCounts);
+}
+
+// Optimizes the primitive, after simplifying it so that its positions move by
+// at most the given error if that is greater than 0.
+void optimizePrimitive(
+    Model& gltf,
+    MeshPrimitive& primitive,
+    double maximumSimplificationError = 0.0) {
+  auto positionIt = primitive.attributes.find("POSITION");
+  if (positionIt == primitive.attributes.end()) {
+    return;
+  }
+
+  const Accessor* pPositionAccessor =
+      Model::getSafe(&gltf.accessors, positionIt->second);
+  Accessor* pIndexAccessor = Model::getSafe(&gltf.accessors, primitive.indices);
+  if (!pPositionAccessor || !pIndexAccessor ||
+      pIndexAccessor->type != Accessor::Type::SCALAR) {
+    return;
+  }
+
+  std::optional<AccessorElements> maybeIndexElements =
+      getAccessorElements(gltf, *pIndexAccessor);
+  if (!maybeIndexElements || maybeIndexElements->count % 3 != 0) {
+    return;
+  }
+  const AccessorElements indexElements = *maybeIndexElements;
+
+  std::vector<Accessor*> vertexAccessors;
+  std::vector<AccessorElements> vertexElements;
+  auto addVertexAccessor = [&](int32_t index) {
+    Accessor* pAccessor = Model::getSafe(&gltf.accessors, index);
+    if (!pAccessor || pAccessor->count != pPositionAccessor->count ||
+        pAccessor->type.rfind("MAT", 0) == 0) {
+      return false;
+    }
+    std::optional<AccessorElements> elements =
+        getAccessorElements(gltf, *pAccessor);
+    if (!elements) {
+      return false;
+    }
+    vertexAccessors.emplace_back(pAccessor);
+    vertexElements.emplace_back(*elements);
+    return true;
+  };
+
+  // The positions come first.
+  if (!addVertexAccessor(positionIt->second)) {
+    return;
+  }
+  for (const auto& pair : primitive.attributes) {
+    if (pair.first != "POSITION" && !addVertexAccessor(pair.second)) {
+      return;
+    }
+  }
+  for (const auto& target : primitive.targets) {
+    for (const auto& pair : target) {
+      if (!addVertexAccessor(pair.second)) {
+        return;
+      }
+    }
+  }
+
+  std::vector<uint32_t> indices(indexElements.count);
+  switch (pIndexAccessor->componentType) {
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    readIndices<uint8_t>(indexElements, indices);
+    break;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    readIndices<uint16_t>(indexElements, indices);
+    break;
+  case Accessor::ComponentType::UNSIGNED_INT:
+    readIndices<uint32_t>(indexElements, indices);
+    break;
+  default:
+    return;
+  }
+
+  const size_t vertexCount = size_t(pPositionAccessor->count);
+  if (std::any_of(indices.begin(), indices.end(), [vertexCount](uint32_t i) {
+        return i >= vertexCount;
+      })) {
+    return;
+  }
+
+  // Overdraw can only be estimated, and meshes simplified, from float
+  // positions that meshoptimizer can read directly.
+  const AccessorElements& positionElements = vertexElements[0];
+  const bool hasFloatPositions =
+      pPositionAccessor->componentType == Accessor::ComponentType::FLOAT &&
+      pPositionAccessor->type == Accessor::Type::VEC3 &&
+      positionElements.stride % sizeof(float) == 0 &&
+      positionElements.stride <= 256 &&
+      reinterpret_cast<uintptr_t>(positionElements.pData) % alignof(float) ==
+          0;
+
+  AccessorElements newIndexElements = indexElements;
+  if (maximumSimplificationError > 0.0 && hasFloatPositions &&
+      primitive.targets.empty()) {
+    const float* pPositions =
+        reinterpret_cast<const float*>(positionElements.pData);
+    // meshoptimizer measures the error relative to the size of the mesh.
+    const float scale = meshopt_simplifyScale(
+        pPositions,
+        vertexCount,
+        positionElements.stride);
+    if (scale > 0.0f) {
+      // The border is locked so that the edges still match those of the
+      // neighboring tiles.
+      std::vector<uint32_t> simplified(indices.size());
+      simplified.resize(meshopt_simplify(
+          simplified.data(),
+          indices.data(),
+          indices.size(),
+          pPositions,
+          vertexCount,
+          positionElements.stride,
+          0,
+          float(maximumSimplificationError / double(scale)),
+          meshopt_SimplifyLockBorder,
+          nullptr));
+      // An accessor can't be empty, so keep a mesh that would vanish.
+      if (!simplified.empty()) {
+        indices = std::move(simplified);
+        newIndexElements.count = indices.size();
+        pIndexAccessor->count = int64_t(indices.size());
+      }
+    }
+  }
+
+  meshopt_optimizeVertexCache(
+      indices.data(),
+      indices.data(),
+      indices.size(),
+      vertexCount);
+
+  if (hasFloatPositions) {
+    meshopt_optimizeOverdraw(
+        indices.data(),
+        indices.data(),
+        indices.size(),
+        reinterpret_cast<const float*>(positionElements.pData),
+        vertexCount,
+        positionElements.stride,
+        1.05f);
+  }
+
+  std::vector<uint32_t> remap(vertexCount);
+  const size_t uniqueVertexCount = meshopt_optimizeVertexFetchRemap(
+      remap.data(),
+      indices.data(),
+      indices.size(),
+      vertexCount);
+  meshopt_remapIndexBuffer(
+      indices.data(),
+      indices.data(),
+      indices.size(),
+      remap.data());
+
+  std::vector<std::byte> packed;
+  std::vector<std::byte> remapped;
+  for (size_t i = 0; i < vertexAccessors.size(); ++i) {
+    const AccessorElements& elements = vertexElements[i];
+    packed.resize(vertexCount * elements.size);
+    for (size_t j = 0; j < vertexCount; ++j) {
+      std::memcpy(
+          packed.data() + j * elements.size,
+          elements.pData + j * elements.stride,
+          elements.size);
+    }
+
+    remapped.resize(uniqueVertexCount * elements.size);
+    meshopt_remapVertexBuffer(
+        remapped.data(),
+        packed.data(),
+        vertexCount,
+        elements.size,
+        remap.data());
+
+    for (size_t j = 0; j < uniqueVertexCount; ++j) {
+      std::memcpy(
+          elements.pData + j * elements.stride,
+          remapped.data() + j * elements.size,
+          elements.size);
+    }
+    vertexAccessors[i]->count = int64_t(uniqueVertexCount);
+  }
+
+  switch (pIndexAccessor->componentType) {
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    writeIndices<uint8_t>(newIndexElements, indices);
+    break;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    writeIndices<uint16_t>(newIndexElements, indices);
+    break;
+  default:
+    writeIndices<uint32_t>(newIndexElements, indices);
+    break;
+  }
+}
+
+} // namespace
+
+void GltfUtilities::optimizeMeshes(CesiumGltf::Model& gltf) {
+  // The accessors are modified in place, so only those that aren't shared
+  // can be.
+  const std::vector<int32_t> useCounts = countAccessorUses(gltf);
+  for (Mesh& mesh : gltf.meshes) {
+    for (MeshPrimitive& primitive : mesh.primitives) {
+      if (canOptimizePrimitive(primitive, useCounts)) {
+        optimizePrimitive(gltf, primitive);
+      }
+    }
+  }
+}
+
+void GltfUtilities::simplifyMeshes(
+    CesiumGltf::Model& gltf,
+    double maximumError) {
+  if (maximumError <= 0.0) {
+    return;
+  }
+
+  const std::vector<int32_t> useCounts = countAccessorUses(gltf);
+  for (Mesh& mesh : gltf.meshes) {
+    for (MeshPrimitive& primitive : mesh.primitives) {
+      if (canOptimizePrimitive(primitive, useCounts)) {
+        optimizePrimitive(gltf, primitive, maximumError);
+      }
+    }
+  }
+}
+
+namespace {
+
+bool isSameFeatureId(const FeatureId& a, const FeatureId& b) {
+  if (a.featureCount != b.featureCount || a.nullFeatureId != b.nullFeatureId ||
+      a.label != b.label || a.attribute != b.attribute ||
+      a.propertyTable != b.propertyTable ||
+      a.texture.has_value() != b.texture.has_value()) {
+    return false;
+  }
+  return !a.texture || (a.texture->index == b.texture->index &&
+                        a.texture->texCoord == b.texture->texCoord &&
+                        a.texture->channels == b.texture->channels);
+}
+
+bool haveSameMetadata(const MeshPrimitive& a, const MeshPrimitive& b) {
+  const ExtensionExtMeshFeatures* pFeaturesA =
+      a.getExtension<ExtensionExtMeshFeatures>();
+  const ExtensionExtMeshFeatures* pFeaturesB =
+      b.getExtension<ExtensionExtMeshFeatures>();
+  if ((pFeaturesA == nullptr) != (pFeaturesB == nullptr) ||
+      (pFeaturesA && !std::equal(
+                         pFeaturesA->featureIds.begin(),
+                         pFeaturesA->featureIds.end(),
+                         pFeaturesB->featureIds.begin(),
+                         pFeaturesB->featureIds.end(),
+                         isSameFeatureId))) {
+    return false;
+  }
+
+  const ExtensionMeshPrimitiveExtStructuralMetadata* pMetadataA =
+      a.getExtension<ExtensionMeshPrimitiveExtStructuralMetadata>();
+  const ExtensionMeshPrimitiveExtStructuralMetadata* pMetadataB =
+      b.getExtension<ExtensionMeshPrimitiveExtStructuralMetadata>();
+  if (!pMetadataA || !pMetadataB) {
+    return pMetadataA == pMetadataB;
+  }
+  return pMetadataA->propertyTextures == pMetadataB->propertyTextures &&
+         pMetadataA->propertyAttributes == pMetadataB->propertyAttributes;
+}
+
+int64_t getVertexCount(const Model& gltf, const MeshPrimitive& primitive) {
+  return gltf.accessors[size_t(primitive.attributes.at("POSITION"))].count;
+}
+
+// Whether the primitive's vertices and indices can be concatenated with
+// those of other primitives.
+bool canMergePrimitive(Model& gltf, const MeshPrimitive& primitive) {
+  if ((primitive.mode != MeshPrimitive::Mode::POINTS &&
+       primitive.mode != MeshPrimitive::Mode::LINES &&
+       primitive.mode != MeshPrimitive::Mode::TRIANGLES) ||
+      !primitive.targets.empty() ||
+      SkirtMeshMetadata::parseFromGltfExtras(primitive.extras) ||
+      !hasOnlyMetadataExtensions(primitive)) {
+    return false;
+  }
+
+  auto positionIt = primitive.attributes.find("POSITION");
+  if (positionIt == primitive.attributes.end()) {
+    return false;
+  }
+  const Accessor* pPositionAccessor =
+      Model::getSafe(&gltf.accessors, positionIt->second);
+  if (!pPositionAccessor) {
+    return false;
+  }
+
+  for (const auto& pair : primitive.attributes) {
+    const Accessor* pAccessor = Model::getSafe(&gltf.accessors, pair.second);
+    if (!pAccessor || pAccessor->count != pPositionAccessor->count ||
+        pAccessor->type.rfind("MAT", 0) == 0 ||
+        !getAccessorElements(gltf, *pAccessor)) {
+      return false;
+    }
+  }
+
+  if (primitive.indices >= 0) {
+    const Accessor* pIndexAccessor =
+        Model::getSafe(&gltf.accessors, primitive.indices);
+    if (!pIndexAccessor || pIndexAccessor->type != Accessor::Type::SCALAR ||
+        (pIndexAccessor->componentType !=
+             Accessor::ComponentType::UNSIGNED_BYTE &&
+         pIndexAccessor->componentType !=
+             Accessor::ComponentType::UNSIGNED_SHORT &&
+         pIndexAccessor->componentType !=
+             Accessor::ComponentType::UNSIGNED_INT) ||
+        !getAccessorElements(gltf, *pIndexAccessor)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Whether two primitives that can be merged can be merged with each other.
+bool canMergePrimitives(
+    const Model& gltf,
+    const MeshPrimitive& a,
+    const MeshPrimitive& b) {
+  if (a.mode != b.mode || a.material != b.material ||
+      (a.indices < 0) != (b.indices < 0) ||
+      a.attributes.size() != b.attributes.size() || !haveSameMetadata(a, b)) {
+    return false;
+  }
+
+  for (const auto& pair : a.attributes) {
+    auto it = b.attributes.find(pair.first);
+    if (it == b.attributes.end()) {
+      return false;
+    }
+
+    const Accessor& accessorA = gltf.accessors[size_t(pair.second)];
+    const Accessor& accessorB = gltf.accessors[size_t(it->second)];
+    if (accessorA.type != accessorB.type ||
+        accessorA.componentType != accessorB.componentType ||
+        accessorA.normalized != accessorB.normalized) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Adds a bufferView for the given number of bytes at the end of the buffer,
+// and returns a pointer to them.
+std::byte* addBufferView(
+    Model& gltf,
+    int32_t bufferIndex,
+    size_t byteLength,
+    int32_t target) {
+  Buffer& buffer = gltf.buffers[size_t(bufferIndex)];
+  // Vertex attributes and indices must be aligned to 4 bytes.
+  const size_t byteOffset = (buffer.cesium.data.size() + 3) / 4 * 4;
+  buffer.cesium.data.resize(byteOffset + byteLength);
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+  BufferView& bufferView = gltf.bufferViews.emplace_back();
+  bufferView.buffer = bufferIndex;
+  bufferView.byteOffset = int64_t(byteOffset);
+  bufferView.byteLength = int64_t(byteLength);
+  bufferView.target = target;
+
+  return buffer.cesium.data.data() + byteOffset;
+}
+
+int32_t mergeVertexAccessors(
+    Model& gltf,
+    int32_t bufferIndex,
+    const std::vector<int32_t>& accessorIndices) {
+  const Accessor& first = gltf.accessors[size_t(accessorIndices[0])];
+  Accessor merged;
+  merged.type = first.type;
+  merged.componentType = first.componentType;
+  merged.normalized = first.normalized;
+  merged.min = first.min;
+  merged.max = first.max;
+  merged.count = 0;
+  for (int32_t index : accessorIndices) {
+    merged.count += gltf.accessors[size_t(index)].count;
+  }
+
+  const size_t size = size_t(first.computeBytesPerVertex());
+  const size_t stride = (size + 3) / 4 * 4;
+  std::byte* pOut = addBufferView(
+      gltf,
+      bufferIndex,
+      size_t(merged.count) * stride,
+      BufferView::Target::ARRAY_BUFFER);
+  if (stride != size) {
+    gltf.bufferViews.back().byteStride = int64_t(stride);
+  }
+  merged.bufferView = int32_t(gltf.bufferViews.size() - 1);
+
+  for (int32_t index : accessorIndices) {
+    const Accessor& source = gltf.accessors[size_t(index)];
+    const AccessorElements elements = *getAccessorElements(gltf, source);
+    for (size_t i = 0; i < elements.count; ++i) {
+      std::memcpy(pOut, elements.pData + i * elements.stride, size);
+      pOut += stride;
+    }
+
+    // Keep the bounds only if every source has them.
+    if (source.min.size() == merged.min.size()) {
+      for (size_t i = 0; i < merged.min.size(); ++i) {
+        merged.min[i] = std::min(merged.min[i], source.min[i]);
+      }
+    } else {
+      merged.min.clear();
+    }
+    if (source.max.size() == merged.max.size()) {
+      for (size_t i = 0; i < merged.max.size(); ++i) {
+        merged.max[i] = std::max(merged.max[i], source.max[i]);
+      }
+    } else {
+      merged.max.clear();
+    }
+  }
+
+  gltf.accessors.emplace_back(std::move(merged));
+  return int32_t(gltf.accessors.size() - 1);
+}
+
+int32_t mergeIndexAccessors(
+    Model& gltf,
+    int32_t bufferIndex,
+    const std::vector<const MeshPrimitive*>& primitives) {
+  std::vector<uint32_t> indices;
+  std::vector<uint32_t> primitiveIndices;
+  uint32_t firstVertex = 0;
+  for (const MeshPrimitive* pPrimitive : primitives) {
+    const Accessor& source = gltf.accessors[size_t(pPrimitive->indices)];
+    const AccessorElements elements = *getAccessorElements(gltf, source);
+    primitiveIndices.resize(elements.count);
+    switch (source.componentType) {
+    case Accessor::ComponentType::UNSIGNED_BYTE:
+      readIndices<uint8_t>(elements, primitiveIndices);
+      break;
+    case Accessor::ComponentType::UNSIGNED_SHORT:
+      readIndices<uint16_t>(elements, primitiveIndices);
+      break;
+    default:
+      readIndices<uint32_t>(elements, primitiveIndices);
+      break;
+    }
+
+    for (uint32_t index : primitiveIndices) {
+      indices.emplace_back(firstVertex + index);
+    }
+    firstVertex += uint32_t(getVertexCount(gltf, *pPrimitive));
+  }
+
+  // The largest value of each type is reserved for primitive restart.
+  Accessor merged;
+  merged.type = Accessor::Type::SCALAR;
+  merged.count = int64_t(indices.size());
+  merged.componentType = firstVertex < std::numeric_limits<uint16_t>::max()
+                             ? Accessor::ComponentType::UNSIGNED_SHORT
+                             : Accessor::ComponentType::UNSIGNED_INT;
+
+  const size_t size =
+      size_t(Accessor::computeByteSizeOfComponent(merged.componentType));
+  std::byte* pOut = addBufferView(
+      gltf,
+      bufferIndex,
+      indices.size() * size,
+      BufferView::Target::ELEMENT_ARRAY_BUFFER);
+  merged.bufferView = int32_t(gltf.bufferViews.size() - 1);
+
+  const AccessorElements elements{pOut, indices.size(), size, size};
+  if (merged.componentType == Accessor::ComponentType::UNSIGNED_SHORT) {
+    writeIndices<uint16_t>(elements, indices);
+  } else {
+    writeIndices<uint32_t>(elements, indices);
+  }
+
+  gltf.accessors.emplace_back(std::move(merged));
+  return int32_t(gltf.accessors.size() - 1);
+}
+
+MeshPrimitive mergePrimitiveGroup(
+    Model& gltf,
+    int32_t bufferIndex,
+    const std::vector<const MeshPrimitive*>& primitives) {
+  // The mode, material and metadata are the same in all of the primitives.
+  MeshPrimitive merged = *primitives[0];
+
+  std::vector<int32_t> accessorIndices;
+  for (auto& pair : merged.attributes) {
+    accessorIndices.clear();
+    for (const MeshPrimitive* pPrimitive : primitives) {
+      accessorIndices.emplace_back(pPrimitive->attributes.at(pair.first));
+    }
+    pair.second = mergeVertexAccessors(gltf, bufferIndex, accessorIndices);
+  }
+
+  if (merged.indices >= 0) {
+    merged.indices = mergeIndexAccessors(gltf, bufferIndex, primitives);
+  }
+
+  return merged;
+}
+
+} // namespace
+
+void GltfUtilities::mergePrimitives(CesiumGltf::Model& gltf) {
+  int32_t bufferIndex = -1;
+
+  for (Mesh& mesh : gltf.meshes) {
+    const size_t primitiveCount = mesh.primitives.size();
+    std::vector<bool> canMerge(primitiveCount);
+    for (size_t i = 0; i < primitiveCount; ++i) {
+      canMerge[i] = canMergePrimitive(gltf, mesh.primitives[i]);
+    }
+
+    std::vector<bool> isMerged(primitiveCount, false);
+    std::vector<MeshPrimitive> primitives;
+    std::vector<const MeshPrimitive*> group;
+    for (size_t i = 0; i < primitiveCount; ++i) {
+      if (isMerged[i]) {
+        continue;
+      }
+
+      const MeshPrimitive& primitive = mesh.primitives[i];
+      group.assign(1, &primitive);
+      if (canMerge[i]) {
+        // Keep the indices within 32 bits.
+        int64_t vertexCount = getVertexCount(gltf, primitive);
+        for (size_t j = i + 1; j < primitiveCount; ++j) {
+          const MeshPrimitive& other = mesh.primitives[j];
+          if (isMerged[j] || !canMerge[j] ||
+              !canMergePrimitives(gltf, primitive, other) ||
+              vertexCount + getVertexCount(gltf, other) >=
+                  std::numeric_limits<uint32_t>::max()) {
+            continue;
+          }
+          vertexCount += getVertexCount(gltf, other);
+          group.emplace_back(&other);
+          isMerged[j] = true;
+        }
+      }
+
+      if (group.size() == 1) {
+        primitives.emplace_back(std::move(mesh.primitives[i]));
+        continue;
+      }
+
+      if (bufferIndex < 0) {
+        bufferIndex = int32_t(gltf.buffers.size());
+        gltf.buffers.emplace_back();
+      }
+      primitives.emplace_back(mergePrimitiveGroup(gltf, bufferIndex, group));
+    }
+
+    mesh.primitives = std::move(primitives);
+  }
+}
+
+namespace {
+
+// Spreads the lowest 10 bits of a value out to every third bit.
+uint32_t spreadBits(uint32_t value) noexcept {
+  value &= 0x3ff;
+  value = (value | (value << 16)) & 0x030000ff;
+  value = (value | (value << 8)) & 0x0300f00f;
+  value = (value | (value << 4)) & 0x030c30c3;
+  value = (value | (value << 2)) & 0x09249249;
+  return value;
+}
+
+// Reverses the order of the lowest 30 bits of a value.
+uint32_t reverseBits30(uint32_t value) noexcept {
+  value = ((value >> 1) & 0x55555555) | ((value & 0x55555555) << 1);
+  value = ((value >> 2) & 0x33333333) | ((value & 0x33333333) << 2);
+  value = ((value >> 4) & 0x0f0f0f0f) | ((value & 0x0f0f0f0f) << 4);
+  value = ((value >> 8) & 0x00ff00ff) | ((value & 0x00ff00ff) << 8);
+  value = (value >> 16) | (value << 16);
+  return value >> 2;
+}
+
+struct ReadPositions {
+  std::vector<glm::dvec3>& positions;
+
+  template <typename T>
+  bool operator()(const AccessorView<AccessorTypes::VEC3<T>>& view) {
+    if (view.status() != AccessorViewStatus::Valid) {
+      return false;
+    }
+    this->positions.resize(size_t(view.size()));
+    for (int64_t i = 0; i < view.size(); ++i) {
+      const AccessorTypes::VEC3<T>& position = view[i];
+      this->positions[size_t(i)] = glm::dvec3(
+          static_cast<double>(position.value[0]),
+          static_cast<double>(position.value[1]),
+          static_cast<double>(position.value[2]));
+    }
+    return true;
+  }
+};
+
+bool canOrderPoints(
+    const MeshPrimitive& primitive,
+    const std::vector<int32_t>& useCounts) {
+  return primitive.mode == MeshPrimitive::Mode::POINTS &&
+         primitive.indices < 0 && hasOnlyMetadataExtensions(primitive) &&
+         hasOnlyUnsharedVertexAccessors(primitive, useCounts);
+}
+
+// Finds an order of the points in which each prefix is spread evenly over
+// their bounds. The bounds are divided into a hierarchy of grids, from a
+// single cell to 1024^3 cells. Each point is in the coarsest level of the
+// hierarchy at which it is the first point of its cell that isn't in a coarser
+// level, and the points that share a cell of the finest grid are in the
+// following levels in turn. The levels come one after the other, and the
+// cells of each level are in bit-reversed Morton order, so that consecutive
+// points are far apart.
+std::vector<uint32_t>
+computeLevelOfDetailOrder(const std::vector<glm::dvec3>& positions) {
+  glm::dvec3 minimum(std::numeric_limits<double>::max());
+  glm::dvec3 maximum(std::numeric_limits<double>::lowest());
+  for (const glm::dvec3& position : positions) {
+    minimum = glm::min(minimum, position);
+    maximum = glm::max(maximum, position);
+  }
+
+  constexpr uint32_t gridLevels = 10;
+  const glm::dvec3 extent = maximum - minimum;
+  glm::dvec3 scale(0.0);
+  for (glm::length_t i = 0; i < 3; ++i) {
+    if (extent[i] > 0.0) {
+      scale[i] = double((1 << gridLevels) - 1) / extent[i];
+    }
+  }
+
+  // The Morton code of each point is in the highest bits and its index is in
+  // the lowest ones, so that sorting them puts the points of each cell of each
+  // level together.
+  const size_t count = positions.size();
+  std::vector<uint64_t> sorted(count);
+  for (size_t i = 0; i < count; ++i) {
+    const glm::dvec3 cell = (positions[i] - minimum) * scale;
+    const uint32_t morton =
+        spreadBits(static_cast<uint32_t>(cell.x)) |
+        (spreadBits(static_cast<uint32_t>(cell.y)) << 1) |
+        (spreadBits(static_cast<uint32_t>(cell.z)) << 2);
+    sorted[i] = (uint64_t(morton) << 32) | uint64_t(i);
+  }
+  std::sort(sorted.begin(), sorted.end());
+
+  auto getMorton = [&sorted](size_t i) {
+    return static_cast<uint32_t>(sorted[i] >> 32);
+  };
+
+  constexpr uint32_t noLevel = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> levels(count, noLevel);
+  for (uint32_t level = 0; level <= gridLevels; ++level) {
+    const uint32_t shift = 3 * (gridLevels - level);
+    size_t begin = 0;
+    while (begin < count) {
+      const uint32_t cell = getMorton(begin) >> shift;
+      size_t end = begin + 1;
+      while (end < count && (getMorton(end) >> shift) == cell) {
+        ++end;
+      }
+
+      // In the finest grid, all of the remaining points get a level.
+      uint32_t nextLevel = level;
+      for (size_t i = begin; i < end; ++i) {
+        if (levels[i] == noLevel) {
+          levels[i] = nextLevel;
+          if (level < gridLevels) {
+            break;
+          }
+          ++nextLevel;
+        }
+      }
+      begin = end;
+    }
+  }
+
+  // Each cell has at most one point in each level, so the keys are unique.
+  std::vector<std::pair<uint64_t, uint32_t>> keys(count);
+  for (size_t i = 0; i < count; ++i) {
+    const uint32_t cellLevel = std::min(levels[i], gridLevels);
+    const uint32_t cell = getMorton(i) >> (3 * (gridLevels - cellLevel));
+    const uint32_t reversedCell =
+        reverseBits30(cell) >> (3 * (gridLevels - cellLevel));
+    keys[i] = std::make_pair(
+        (uint64_t(levels[i]) << 32) | uint64_t(reversedCell),
+        static_cast<uint32_t>(sorted[i]));
+  }
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<uint32_t> order(count);
+  for (size_t i = 0; i < count; ++i) {
+    order[i] = keys[i].second;
+  }
+  return order;
+}
+
+// Adds a feature ID attribute for each implicit feature ID of the primitive,
+// since implicit feature IDs are the indices of the vertices, which are about
+// to change.
+void addImplicitFeatureIdAttributes(
+    Model& gltf,
+    MeshPrimitive& primitive,
+    const std::vector<uint32_t>& order) {
+  ExtensionExtMeshFeatures* pMeshFeatures =
+      primitive.getExtension<ExtensionExtMeshFeatures>();
+  if (!pMeshFeatures) {
+    return;
+  }
+
+  for (FeatureId& featureId : pMeshFeatures->featureIds) {
+    if (featureId.attribute || featureId.texture) {
+      continue;
+    }
+
+    int64_t set = 0;
+    while (primitive.attributes.find("_FEATURE_ID_" + std::to_string(set)) !=
+           primitive.attributes.end()) {
+      ++set;
+    }
+
+    // Float feature IDs are exact up to 2^24, which is more points than any
+    // tile should have.
+    const bool isShort = order.size() <= 65536;
+    const int32_t componentType =
+        isShort ? Accessor::ComponentType::UNSIGNED_SHORT
+                : Accessor::ComponentType::FLOAT;
+    const size_t componentSize = isShort ? sizeof(uint16_t) : sizeof(float);
+
+    const int32_t bufferIndex = int32_t(gltf.buffers.size());
+    gltf.buffers.emplace_back();
+    std::byte* pData = addBufferView(
+        gltf,
+        bufferIndex,
+        order.size() * componentSize,
+        BufferView::Target::ARRAY_BUFFER);
+    for (size_t i = 0; i < order.size(); ++i) {
+      if (isShort) {
+        const uint16_t value = static_cast<uint16_t>(order[i]);
+        std::memcpy(pData + i * componentSize, &value, componentSize);
+      } else {
+        const float value = static_cast<float>(order[i]);
+        std::memcpy(pData + i * componentSize, &value, componentSize);
+      }
+    }
+
+    Accessor& accessor = gltf.accessors.emplace_back();
+    accessor.bufferView = int32_t(gltf.bufferViews.size() - 1);
+    accessor.componentType = componentType;
+    accessor.type = Accessor::Type::SCALAR;
+    accessor.count = int64_t(order.size());
+
+    primitive.attributes.emplace(
+        "_FEATURE_ID_" + std::to_string(set),
+        int32_t(gltf.accessors.size() - 1));
+    featureId.attribute = set;
+  }
+}
+
+void orderPrimitivePoints(Model& gltf, MeshPrimitive& primitive) {
+  std::vector<glm::dvec3> positions;
+  if (!std::visit(
+          ReadPositions{positions},
+          getQuantizedPositionAccessorView(gltf, primitive)) ||
+      positions.size() < 2 ||
+      positions.size() > std::numeric_limits<uint32_t>::max()) {
+    return;
+  }
+  const size_t vertexCount = positions.size();
+
+  std::vector<AccessorElements> vertexElements;
+  auto addVertexAccessor = [&](int32_t index) {
+    const Accessor* pAccessor = Model::getSafe(&gltf.accessors, index);
+    if (!pAccessor || pAccessor->count != int64_t(vertexCount)) {
+      return false;
+    }
+    std::optional<AccessorElements> elements =
+        getAccessorElements(gltf, *pAccessor);
+    if (!elements) {
+      return false;
+    }
+    vertexElements.emplace_back(*elements);
+    return true;
+  };
+
+  for (const auto& pair : primitive.attributes) {
+    if (!addVertexAccessor(pair.second)) {
+      return;
+    }
+  }
+  for (const auto& target : primitive.targets) {
+    for (const auto& pair : target) {
+      if (!addVertexAccessor(pair.second)) {
+        return;
+      }
+    }
+  }
+
+  const std::vector<uint32_t> order = computeLevelOfDetailOrder(positions);
+
+  std::vector<std::byte> reordered;
+  for (const AccessorElements& elements : vertexElements) {
+    reordered.resize(vertexCount * elements.size);
+    for (size_t i = 0; i < vertexCount; ++i) {
+      std::memcpy(
+          reordered.data() + i * elements.size,
+          elements.pData + size_t(order[i]) * elements.stride,
+          elements.size);
+    }
+    for (size_t i = 0; i < vertexCount; ++i) {
+      std::memcpy(
+          elements.pData + i * elements.stride,
+          reordered.data() + i * elements.size,
+          elements.size);
+    }
+  }
+
+  // This adds accessors, so the elements above must not be used after this.
+  addImplicitFeatureIdAttributes(gltf, primitive, order);
+}
+
+} // namespace
+
+void GltfUtilities::orderPointsForLevelOfDetail(CesiumGltf::Model& gltf) {
+  // The accessors are modified in place, so only those that aren't shared
+  // can be.
+  const std::vector<int32_t> useCounts = countAccessorUses(gltf);
+  for (Mesh& mesh : gltf.meshes) {
+    for (MeshPrimitive& primitive : mesh.primitives) {
+      if (canOrderPoints(primitive, useCounts)) {
+        orderPrimitivePoints(gltf, primitive);
+      }
+    }
+  }
+}
+
 } // namespace CesiumGltfContent
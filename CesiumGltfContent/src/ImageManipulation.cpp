@@ -1,8 +1,11 @@
 #include <CesiumGltf/ImageCesium.h>
 #include <CesiumGltfContent/ImageManipulation.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstring>
+#include <vector>
 
 namespace Cesium {
 // Use STB resize in our own namespace to avoid conflicts from other libs
@@ -19,6 +22,193 @@ using namespace Cesium;
 
 namespace CesiumGltfContent {
 
+namespace {
+// The width and height of the blocks of all the formats that can be copied.
+constexpr int32_t blockSize = 4;
+
+// The size in bytes of a block of 4x4 pixels in the given format, or 0 if
+// the blocks can't be copied independently. PVRTC blocks are stored in Morton
+// order and their colors are interpolated from neighboring blocks.
+size_t getBlockByteSize(CesiumGltf::GpuCompressedPixelFormat format) noexcept {
+  using CesiumGltf::GpuCompressedPixelFormat;
+  switch (format) {
+  case GpuCompressedPixelFormat::ETC1_RGB:
+  case GpuCompressedPixelFormat::BC1_RGB:
+  case GpuCompressedPixelFormat::BC4_R:
+  case GpuCompressedPixelFormat::ETC2_EAC_R11:
+    return 8;
+  case GpuCompressedPixelFormat::ETC2_RGBA:
+  case GpuCompressedPixelFormat::BC3_RGBA:
+  case GpuCompressedPixelFormat::BC5_RG:
+  case GpuCompressedPixelFormat::BC7_RGBA:
+  case GpuCompressedPixelFormat::ASTC_4x4_RGBA:
+  case GpuCompressedPixelFormat::ETC2_EAC_RG11:
+    return 16;
+  default:
+    return 0;
+  }
+}
+
+size_t countBlocks(int32_t pixels) noexcept {
+  return size_t((pixels + blockSize - 1) / blockSize);
+}
+
+// Whether a range of pixels starts on a block and ends on a block or at the
+// edge of the image.
+bool isBlockAligned(int32_t start, int32_t length, int32_t imageLength) {
+  return start % blockSize == 0 &&
+         (length % blockSize == 0 || start + length == imageLength);
+}
+
+bool blitBlockCompressedImage(
+    CesiumGltf::ImageCesium& target,
+    const PixelRectangle& targetPixels,
+    const CesiumGltf::ImageCesium& source,
+    const PixelRectangle& sourcePixels) {
+  const size_t blockBytes = getBlockByteSize(source.compressedPixelFormat);
+  if (blockBytes == 0 ||
+      target.compressedPixelFormat != source.compressedPixelFormat) {
+    return false;
+  }
+
+  if (sourcePixels.width != targetPixels.width ||
+      sourcePixels.height != targetPixels.height) {
+    // Compressed images can't be scaled.
+    return false;
+  }
+
+  // The last block of a row or column may be partly outside the image, so
+  // a rectangle that ends in the middle of a block must end there in both.
+  if (!isBlockAligned(sourcePixels.x, sourcePixels.width, source.width) ||
+      !isBlockAligned(sourcePixels.y, sourcePixels.height, source.height) ||
+      !isBlockAligned(targetPixels.x, targetPixels.width, target.width) ||
+      !isBlockAligned(targetPixels.y, targetPixels.height, target.height)) {
+    return false;
+  }
+
+  const size_t sourceOffset =
+      source.mipPositions.empty() ? 0 : source.mipPositions[0].byteOffset;
+  const size_t targetOffset =
+      target.mipPositions.empty() ? 0 : target.mipPositions[0].byteOffset;
+  const size_t sourceBlocksPerRow = countBlocks(source.width);
+  const size_t targetBlocksPerRow = countBlocks(target.width);
+  if (source.pixelData.size() <
+          sourceOffset + ImageManipulation::computeBlockCompressedImageSize(
+                             source.compressedPixelFormat,
+                             source.width,
+                             source.height) ||
+      target.pixelData.size() <
+          targetOffset + ImageManipulation::computeBlockCompressedImageSize(
+                             target.compressedPixelFormat,
+                             target.width,
+                             target.height)) {
+    return false;
+  }
+
+  const size_t blocksWide = countBlocks(sourcePixels.width);
+  const size_t blocksHigh = countBlocks(sourcePixels.height);
+  const std::byte* pSource =
+      source.pixelData.data() + sourceOffset +
+      (size_t(sourcePixels.y / blockSize) * sourceBlocksPerRow +
+       size_t(sourcePixels.x / blockSize)) *
+          blockBytes;
+  std::byte* pTarget =
+      target.pixelData.data() + targetOffset +
+      (size_t(targetPixels.y / blockSize) * targetBlocksPerRow +
+       size_t(targetPixels.x / blockSize)) *
+          blockBytes;
+  for (size_t j = 0; j < blocksHigh; ++j) {
+    std::memcpy(pTarget, pSource, blocksWide * blockBytes);
+    pSource += sourceBlocksPerRow * blockBytes;
+    pTarget += targetBlocksPerRow * blockBytes;
+  }
+
+  return true;
+}
+
+// The two source pixels of a target pixel in one direction, and the weight of
+// the second one in 1/256ths.
+struct ResampleTap {
+  size_t index0;
+  size_t index1;
+  uint32_t weight1;
+};
+
+std::vector<ResampleTap>
+computeResampleTaps(size_t sourceLength, size_t targetLength) {
+  std::vector<ResampleTap> taps(targetLength);
+  const double scale = double(sourceLength) / double(targetLength);
+  const double maximum = double(sourceLength - 1);
+  for (size_t i = 0; i < targetLength; ++i) {
+    // Align the centers of the source and target pixels.
+    const double position =
+        std::clamp((double(i) + 0.5) * scale - 0.5, 0.0, maximum);
+    const double index = std::floor(position);
+    ResampleTap& tap = taps[i];
+    tap.index0 = size_t(index);
+    tap.index1 = std::min(tap.index0 + 1, sourceLength - 1);
+    tap.weight1 = uint32_t(std::lround((position - index) * 256.0));
+    if (tap.weight1 == 256) {
+      tap.index0 = tap.index1;
+      tap.weight1 = 0;
+    }
+  }
+  return taps;
+}
+
+// Resamples one row of the target from two rows of the source. Channels is
+// the number of channels when it is known at compile time, so that the inner
+// loop is unrolled, or 0 otherwise.
+template <size_t Channels>
+void resampleRow(
+    uint8_t* pTarget,
+    const uint8_t* pRow0,
+    const uint8_t* pRow1,
+    uint32_t weightY1,
+    const std::vector<ResampleTap>& columns,
+    size_t runtimeChannels) {
+  const size_t channels = Channels == 0 ? runtimeChannels : Channels;
+  const uint32_t weightY0 = 256 - weightY1;
+  for (const ResampleTap& column : columns) {
+    const uint8_t* p00 = pRow0 + column.index0 * channels;
+    const uint8_t* p01 = pRow0 + column.index1 * channels;
+    const uint8_t* p10 = pRow1 + column.index0 * channels;
+    const uint8_t* p11 = pRow1 + column.index1 * channels;
+    const uint32_t weightX1 = column.weight1;
+    const uint32_t weightX0 = 256 - weightX1;
+    for (size_t c = 0; c < channels; ++c) {
+      const uint32_t top = p00[c] * weightX0 + p01[c] * weightX1;
+      const uint32_t bottom = p10[c] * weightX0 + p11[c] * weightX1;
+      pTarget[c] =
+          uint8_t((top * weightY0 + bottom * weightY1 + 32768U) >> 16);
+    }
+    pTarget += channels;
+  }
+}
+
+template <size_t Channels>
+void resampleRows(
+    uint8_t* pTarget,
+    size_t targetRowStride,
+    const uint8_t* pSource,
+    size_t sourceRowStride,
+    const std::vector<ResampleTap>& rows,
+    const std::vector<ResampleTap>& columns,
+    size_t channels) {
+  for (size_t j = 0; j < rows.size(); ++j) {
+    const ResampleTap& row = rows[j];
+    resampleRow<Channels>(
+        pTarget + j * targetRowStride,
+        pSource + row.index0 * sourceRowStride,
+        pSource + row.index1 * sourceRowStride,
+        row.weight1,
+        columns,
+        channels);
+  }
+}
+
+} // namespace
+
 void ImageManipulation::unsafeBlitImage(
     std::byte* pTarget,
     size_t targetRowStride,
@@ -43,6 +233,69 @@ void ImageManipulation::unsafeBlitImage(
   }
 }
 
+void ImageManipulation::unsafeResampleImage(
+    std::byte* pTarget,
+    size_t targetRowStride,
+    size_t targetWidth,
+    size_t targetHeight,
+    const std::byte* pSource,
+    size_t sourceRowStride,
+    size_t sourceWidth,
+    size_t sourceHeight,
+    size_t channels) {
+  if (targetWidth == 0 || targetHeight == 0 || sourceWidth == 0 ||
+      sourceHeight == 0 || channels == 0) {
+    return;
+  }
+
+  const std::vector<ResampleTap> columns =
+      computeResampleTaps(sourceWidth, targetWidth);
+  const std::vector<ResampleTap> rows =
+      computeResampleTaps(sourceHeight, targetHeight);
+
+  uint8_t* pTargetBytes = reinterpret_cast<uint8_t*>(pTarget);
+  const uint8_t* pSourceBytes = reinterpret_cast<const uint8_t*>(pSource);
+
+  auto resample = [&](auto resampleChannels) {
+    resampleChannels(
+        pTargetBytes,
+        targetRowStride,
+        pSourceBytes,
+        sourceRowStride,
+        rows,
+        columns,
+        channels);
+  };
+
+  switch (channels) {
+  case 1:
+    resample(resampleRows<1>);
+    break;
+  case 2:
+    resample(resampleRows<2>);
+    break;
+  case 3:
+    resample(resampleRows<3>);
+    break;
+  case 4:
+    resample(resampleRows<4>);
+    break;
+  default:
+    resample(resampleRows<0>);
+    break;
+  }
+}
+
+size_t ImageManipulation::computeBlockCompressedImageSize(
+    CesiumGltf::GpuCompressedPixelFormat format,
+    int32_t width,
+    int32_t height) noexcept {
+  if (width <= 0 || height <= 0) {
+    return 0;
+  }
+  return countBlocks(width) * countBlocks(height) * getBlockByteSize(format);
+}
+
 bool ImageManipulation::blitImage(
     CesiumGltf::ImageCesium& target,
     const PixelRectangle& targetPixels,
@@ -64,6 +317,13 @@ bool ImageManipulation::blitImage(
     return false;
   }
 
+  if (target.compressedPixelFormat !=
+          CesiumGltf::GpuCompressedPixelFormat::NONE ||
+      source.compressedPixelFormat !=
+          CesiumGltf::GpuCompressedPixelFormat::NONE) {
+    return blitBlockCompressedImage(target, targetPixels, source, sourcePixels);
+  }
+
   if (target.channels != source.channels ||
       target.bytesPerChannel != source.bytesPerChannel) {
     // Source and target image formats don't match; currently not supported.
@@ -108,6 +368,24 @@ bool ImageManipulation::blitImage(
       return false;
     }
 
+    if (targetPixels.width >= sourcePixels.width &&
+        targetPixels.height >= sourcePixels.height) {
+      // Enlarging, which is what combining the tiles of a raster overlay
+      // does with ancestor tiles. Bilinear filtering is enough for this, and
+      // is much faster than STB's filters.
+      unsafeResampleImage(
+          pTarget,
+          bytesPerTargetRow,
+          size_t(targetPixels.width),
+          size_t(targetPixels.height),
+          pSource,
+          bytesPerSourceRow,
+          size_t(sourcePixels.width),
+          size_t(sourcePixels.height),
+          size_t(target.channels));
+      return true;
+    }
+
     // Use STB to do the copy / scale
     stbir_resize_uint8(
         reinterpret_cast<const unsigned char*>(pSource),
@@ -125,25 +403,23 @@ bool ImageManipulation::blitImage(
 }
 
 namespace {
+template <typename TVector>
 void writePngToVector(void* context, void* data, int size) {
-  std::vector<std::byte>* pVector =
-      reinterpret_cast<std::vector<std::byte>*>(context);
+  TVector* pVector = reinterpret_cast<TVector*>(context);
   size_t previousSize = pVector->size();
   pVector->resize(previousSize + size_t(size));
   std::memcpy(pVector->data() + previousSize, data, size_t(size));
 }
-} // namespace
 
-/*static*/ void ImageManipulation::savePng(
-    const CesiumGltf::ImageCesium& image,
-    std::vector<std::byte>& output) {
+template <typename TVector>
+void savePngToVector(const CesiumGltf::ImageCesium& image, TVector& output) {
   if (image.bytesPerChannel != 1) {
     // Only 8-bit images can be written.
     return;
   }
 
   stbi_write_png_to_func(
-      writePngToVector,
+      writePngToVector<TVector>,
       &output,
       image.width,
       image.height,
@@ -151,6 +427,19 @@ void writePngToVector(void* context, void* data, int size) {
       image.pixelData.data(),
       0);
 }
+} // namespace
+
+/*static*/ void ImageManipulation::savePng(
+    const CesiumGltf::ImageCesium& image,
+    std::vector<std::byte>& output) {
+  savePngToVector(image, output);
+}
+
+/*static*/ void ImageManipulation::savePng(
+    const CesiumGltf::ImageCesium& image,
+    CesiumUtility::ByteVector& output) {
+  savePngToVector(image, output);
+}
 
 /*static*/ std::vector<std::byte>
 ImageManipulation::savePng(const CesiumGltf::ImageCesium& image) {
@@ -1,12 +1,51 @@
 #include <CesiumGltfContent/SkirtMeshMetadata.h>
 #include <CesiumUtility/JsonValue.h>
 
+#include <cstdint>
+#include <limits>
 #include <optional>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace CesiumUtility;
 
 namespace CesiumGltfContent {
+namespace {
+bool parseEdgeIndices(
+    const JsonValue& gltfSkirtMeshMetadata,
+    const std::string& key,
+    std::vector<uint32_t>& edgeIndices) {
+  const auto* pEdgeIndices =
+      gltfSkirtMeshMetadata.getValuePtrForKey<JsonValue::Array>(key);
+  if (!pEdgeIndices) {
+    return false;
+  }
+
+  edgeIndices.resize(pEdgeIndices->size());
+  for (size_t i = 0; i < pEdgeIndices->size(); ++i) {
+    const int64_t index =
+        (*pEdgeIndices)[i].getSafeNumberOrDefault<int64_t>(-1);
+    if (index < 0 || index > int64_t(std::numeric_limits<uint32_t>::max())) {
+      return false;
+    }
+    edgeIndices[i] = uint32_t(index);
+  }
+
+  return true;
+}
+
+JsonValue::Array createEdgeIndices(const std::vector<uint32_t>& edgeIndices) {
+  JsonValue::Array result;
+  result.reserve(edgeIndices.size());
+  for (const uint32_t index : edgeIndices) {
+    result.emplace_back(index);
+  }
+  return result;
+}
+} // namespace
+
 std::optional<SkirtMeshMetadata>
 SkirtMeshMetadata::parseFromGltfExtras(const JsonValue::Object& extras) {
   auto skirtIt = extras.find("skirtMeshMetadata");
@@ -88,28 +127,69 @@ SkirtMeshMetadata::parseFromGltfExtras(const JsonValue::Object& extras) {
   skirtMeshMetadata.skirtEastHeight = eastHeight;
   skirtMeshMetadata.skirtNorthHeight = northHeight;
 
+  // Older metadata doesn't say, and always comes with baked skirts.
+  const auto* pHasBakedSkirts =
+      gltfSkirtMeshMetadata.getValuePtrForKey<bool>("hasBakedSkirts");
+  skirtMeshMetadata.hasBakedSkirts = !pHasBakedSkirts || *pHasBakedSkirts;
+  if (!skirtMeshMetadata.hasBakedSkirts) {
+    if (!parseEdgeIndices(
+            gltfSkirtMeshMetadata,
+            "westEdgeIndices",
+            skirtMeshMetadata.westEdgeIndices) ||
+        !parseEdgeIndices(
+            gltfSkirtMeshMetadata,
+            "southEdgeIndices",
+            skirtMeshMetadata.southEdgeIndices) ||
+        !parseEdgeIndices(
+            gltfSkirtMeshMetadata,
+            "eastEdgeIndices",
+            skirtMeshMetadata.eastEdgeIndices) ||
+        !parseEdgeIndices(
+            gltfSkirtMeshMetadata,
+            "northEdgeIndices",
+            skirtMeshMetadata.northEdgeIndices)) {
+      return std::nullopt;
+    }
+  }
+
   return skirtMeshMetadata;
 }
 
 JsonValue::Object SkirtMeshMetadata::createGltfExtras(
     const SkirtMeshMetadata& skirtMeshMetadata) {
-  return {
-      {"skirtMeshMetadata",
-       JsonValue::Object{
-           {"noSkirtRange",
-            JsonValue::Array{
-                skirtMeshMetadata.noSkirtIndicesBegin,
-                skirtMeshMetadata.noSkirtIndicesCount,
-                skirtMeshMetadata.noSkirtVerticesBegin,
-                skirtMeshMetadata.noSkirtVerticesCount}},
-           {"meshCenter",
-            JsonValue::Array{
-                skirtMeshMetadata.meshCenter.x,
-                skirtMeshMetadata.meshCenter.y,
-                skirtMeshMetadata.meshCenter.z}},
-           {"skirtWestHeight", skirtMeshMetadata.skirtWestHeight},
-           {"skirtSouthHeight", skirtMeshMetadata.skirtSouthHeight},
-           {"skirtEastHeight", skirtMeshMetadata.skirtEastHeight},
-           {"skirtNorthHeight", skirtMeshMetadata.skirtNorthHeight}}}};
+  JsonValue::Object gltfSkirtMeshMetadata{
+      {"noSkirtRange",
+       JsonValue::Array{
+           skirtMeshMetadata.noSkirtIndicesBegin,
+           skirtMeshMetadata.noSkirtIndicesCount,
+           skirtMeshMetadata.noSkirtVerticesBegin,
+           skirtMeshMetadata.noSkirtVerticesCount}},
+      {"meshCenter",
+       JsonValue::Array{
+           skirtMeshMetadata.meshCenter.x,
+           skirtMeshMetadata.meshCenter.y,
+           skirtMeshMetadata.meshCenter.z}},
+      {"skirtWestHeight", skirtMeshMetadata.skirtWestHeight},
+      {"skirtSouthHeight", skirtMeshMetadata.skirtSouthHeight},
+      {"skirtEastHeight", skirtMeshMetadata.skirtEastHeight},
+      {"skirtNorthHeight", skirtMeshMetadata.skirtNorthHeight}};
+
+  if (!skirtMeshMetadata.hasBakedSkirts) {
+    gltfSkirtMeshMetadata.emplace("hasBakedSkirts", false);
+    gltfSkirtMeshMetadata.emplace(
+        "westEdgeIndices",
+        createEdgeIndices(skirtMeshMetadata.westEdgeIndices));
+    gltfSkirtMeshMetadata.emplace(
+        "southEdgeIndices",
+        createEdgeIndices(skirtMeshMetadata.southEdgeIndices));
+    gltfSkirtMeshMetadata.emplace(
+        "eastEdgeIndices",
+        createEdgeIndices(skirtMeshMetadata.eastEdgeIndices));
+    gltfSkirtMeshMetadata.emplace(
+        "northEdgeIndices",
+        createEdgeIndices(skirtMeshMetadata.northEdgeIndices));
+  }
+
+  return {{"skirtMeshMetadata", std::move(gltfSkirtMeshMetadata)}};
 }
 } // namespace CesiumGltfContent
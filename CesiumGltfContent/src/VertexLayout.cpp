@@ -0,0 +1,666 @@
+#include <CesiumGltf/Accessor.h>
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/Mesh.h>
+#include <CesiumGltf/MeshPrimitive.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/VertexLayout.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace CesiumGltfContent {
+
+namespace {
+// The vertices of an attribute are converted in blocks, first from the
+// accessor's type to floats and then from floats to the packed format, so that
+// each loop handles a single type and can be vectorized by the compiler.
+constexpr int64_t blockSize = 256;
+
+// The values of the components that an accessor doesn't have, as when a GPU
+// fetches a vertex attribute with fewer components than the shader expects.
+constexpr std::array<float, 4> missingComponents{0.0f, 0.0f, 0.0f, 1.0f};
+
+// Every attribute starts at a multiple of this many bytes in its vertex.
+constexpr int64_t attributeAlignment = 4;
+
+int64_t getAttributeByteSize(const VertexAttributeLayout& attribute) noexcept {
+  const int64_t size =
+      VertexLayout::getComponentByteSize(attribute.format) *
+      attribute.componentCount;
+  return (size + attributeAlignment - 1) / attributeAlignment *
+         attributeAlignment;
+}
+
+// Converts a float to the nearest 16-bit float, rounding ties to even.
+uint16_t toHalf(float value) noexcept {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint32_t sign = (bits >> 16) & 0x8000u;
+  bits &= 0x7fffffffu;
+
+  uint32_t half;
+  if (bits >= 0x47800000u) {
+    // Too large even before rounding, infinite, or NaN.
+    half = bits > 0x7f800000u ? 0x7e00u : 0x7c00u;
+  } else if (bits < 0x38800000u) {
+    // A subnormal or zero. Adding 0.5 puts the bits of the result at the
+    // bottom of the mantissa, rounded by the float addition.
+    float magnitude;
+    std::memcpy(&magnitude, &bits, sizeof(magnitude));
+    magnitude += 0.5f;
+    std::memcpy(&half, &magnitude, sizeof(half));
+    half -= 0x3f000000u;
+  } else {
+    // Rebias the exponent and round the mantissa. A carry out of the mantissa
+    // correctly increments the exponent, up to infinity.
+    const uint32_t mantissaOdd = (bits >> 13) & 1u;
+    bits -= 0x38000000u;
+    bits += 0xfffu + mantissaOdd;
+    half = bits >> 13;
+  }
+  return static_cast<uint16_t>(half | sign);
+}
+
+// How a float is stored in a packed component. Normalized values are clamped
+// with the comparisons in this order so that NaN becomes the minimum.
+template <VertexComponentFormat Format> struct ComponentEncoding;
+
+template <> struct ComponentEncoding<VertexComponentFormat::Float32> {
+  using Type = float;
+  static Type encode(float value) noexcept { return value; }
+};
+
+template <> struct ComponentEncoding<VertexComponentFormat::Float16> {
+  using Type = uint16_t;
+  static Type encode(float value) noexcept { return toHalf(value); }
+};
+
+template <> struct ComponentEncoding<VertexComponentFormat::Snorm16> {
+  using Type = int16_t;
+  static Type encode(float value) noexcept {
+    const float clamped = std::min(1.0f, std::max(-1.0f, value));
+    return static_cast<Type>(std::round(clamped * 32767.0f));
+  }
+};
+
+template <> struct ComponentEncoding<VertexComponentFormat::Unorm16> {
+  using Type = uint16_t;
+  static Type encode(float value) noexcept {
+    const float clamped = std::min(1.0f, std::max(0.0f, value));
+    return static_cast<Type>(std::round(clamped * 65535.0f));
+  }
+};
+
+template <> struct ComponentEncoding<VertexComponentFormat::Snorm8> {
+  using Type = int8_t;
+  static Type encode(float value) noexcept {
+    const float clamped = std::min(1.0f, std::max(-1.0f, value));
+    return static_cast<Type>(std::round(clamped * 127.0f));
+  }
+};
+
+template <> struct ComponentEncoding<VertexComponentFormat::Unorm8> {
+  using Type = uint8_t;
+  static Type encode(float value) noexcept {
+    const float clamped = std::min(1.0f, std::max(0.0f, value));
+    return static_cast<Type>(std::round(clamped * 255.0f));
+  }
+};
+
+// Reads components of an accessor into four floats per vertex. Normalized
+// integers are scaled and, if they are signed, clamped to -1.0, as the glTF
+// specification defines.
+template <typename T>
+void readComponents(
+    const AccessorLayout& layout,
+    int32_t componentCount,
+    float scale,
+    float minimum,
+    int64_t first,
+    int64_t count,
+    float* pValues) noexcept {
+  const std::byte* pElement =
+      layout.pData + layout.offset + first * layout.stride;
+  for (int64_t i = 0; i < count; ++i, pElement += layout.stride) {
+    std::array<T, 4> components{};
+    std::memcpy(
+        components.data(),
+        pElement,
+        sizeof(T) * static_cast<size_t>(componentCount));
+    for (int32_t j = 0; j < componentCount; ++j) {
+      pValues[i * 4 + j] =
+          std::max(static_cast<float>(components[size_t(j)]) * scale, minimum);
+    }
+  }
+}
+
+template <typename T>
+void readComponents(
+    const AccessorLayout& layout,
+    int32_t componentCount,
+    bool normalized,
+    int64_t first,
+    int64_t count,
+    float* pValues) noexcept {
+  float scale = 1.0f;
+  float minimum = std::numeric_limits<float>::lowest();
+  if constexpr (std::is_integral_v<T>) {
+    if (normalized) {
+      scale = 1.0f / static_cast<float>(std::numeric_limits<T>::max());
+      minimum = std::is_signed_v<T> ? -1.0f : 0.0f;
+    }
+  }
+  readComponents<T>(
+      layout,
+      componentCount,
+      scale,
+      minimum,
+      first,
+      count,
+      pValues);
+}
+
+template <VertexComponentFormat Format>
+void writeComponents(
+    const float* pValues,
+    int32_t componentCount,
+    int64_t count,
+    std::byte* pDestination,
+    int64_t stride) noexcept {
+  using Encoding = ComponentEncoding<Format>;
+  using Type = typename Encoding::Type;
+  for (int64_t i = 0; i < count; ++i, pDestination += stride) {
+    for (int32_t j = 0; j < componentCount; ++j) {
+      const Type component = Encoding::encode(pValues[i * 4 + j]);
+      std::memcpy(
+          pDestination + j * int64_t(sizeof(Type)),
+          &component,
+          sizeof(Type));
+    }
+  }
+}
+
+void writeComponents(
+    VertexComponentFormat format,
+    const float* pValues,
+    int32_t componentCount,
+    int64_t count,
+    std::byte* pDestination,
+    int64_t stride) noexcept {
+  switch (format) {
+  case VertexComponentFormat::Float32:
+    writeComponents<VertexComponentFormat::Float32>(
+        pValues,
+        componentCount,
+        count,
+        pDestination,
+        stride);
+    break;
+  case VertexComponentFormat::Float16:
+    writeComponents<VertexComponentFormat::Float16>(
+        pValues,
+        componentCount,
+        count,
+        pDestination,
+        stride);
+    break;
+  case VertexComponentFormat::Snorm16:
+    writeComponents<VertexComponentFormat::Snorm16>(
+        pValues,
+        componentCount,
+        count,
+        pDestination,
+        stride);
+    break;
+  case VertexComponentFormat::Unorm16:
+    writeComponents<VertexComponentFormat::Unorm16>(
+        pValues,
+        componentCount,
+        count,
+        pDestination,
+        stride);
+    break;
+  case VertexComponentFormat::Snorm8:
+    writeComponents<VertexComponentFormat::Snorm8>(
+        pValues,
+        componentCount,
+        count,
+        pDestination,
+        stride);
+    break;
+  case VertexComponentFormat::Unorm8:
+    writeComponents<VertexComponentFormat::Unorm8>(
+        pValues,
+        componentCount,
+        count,
+        pDestination,
+        stride);
+    break;
+  }
+}
+
+bool readComponents(
+    const Accessor& accessor,
+    const AccessorLayout& layout,
+    int32_t componentCount,
+    int64_t first,
+    int64_t count,
+    float* pValues) noexcept {
+  const bool normalized = accessor.normalized;
+  switch (accessor.componentType) {
+  case Accessor::ComponentType::BYTE:
+    readComponents<int8_t>(
+        layout,
+        componentCount,
+        normalized,
+        first,
+        count,
+        pValues);
+    return true;
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    readComponents<uint8_t>(
+        layout,
+        componentCount,
+        normalized,
+        first,
+        count,
+        pValues);
+    return true;
+  case Accessor::ComponentType::SHORT:
+    readComponents<int16_t>(
+        layout,
+        componentCount,
+        normalized,
+        first,
+        count,
+        pValues);
+    return true;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    readComponents<uint16_t>(
+        layout,
+        componentCount,
+        normalized,
+        first,
+        count,
+        pValues);
+    return true;
+  case Accessor::ComponentType::UNSIGNED_INT:
+    readComponents<uint32_t>(
+        layout,
+        componentCount,
+        normalized,
+        first,
+        count,
+        pValues);
+    return true;
+  case Accessor::ComponentType::FLOAT:
+    readComponents<float>(
+        layout,
+        componentCount,
+        normalized,
+        first,
+        count,
+        pValues);
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Whether the components of the accessor are already stored in the packed
+// format, so that they can be copied as they are.
+bool isStoredAs(const Accessor& accessor, VertexComponentFormat format) {
+  switch (format) {
+  case VertexComponentFormat::Float32:
+    return accessor.componentType == Accessor::ComponentType::FLOAT;
+  case VertexComponentFormat::Snorm16:
+    return accessor.normalized &&
+           accessor.componentType == Accessor::ComponentType::SHORT;
+  case VertexComponentFormat::Unorm16:
+    return accessor.normalized &&
+           accessor.componentType == Accessor::ComponentType::UNSIGNED_SHORT;
+  case VertexComponentFormat::Snorm8:
+    return accessor.normalized &&
+           accessor.componentType == Accessor::ComponentType::BYTE;
+  case VertexComponentFormat::Unorm8:
+    return accessor.normalized &&
+           accessor.componentType == Accessor::ComponentType::UNSIGNED_BYTE;
+  default:
+    return false;
+  }
+}
+
+// Packs an attribute into its stream. Without an accessor, every vertex gets
+// the components for missing ones.
+bool packAttribute(
+    const VertexAttributeLayout& attribute,
+    const Accessor* pAccessor,
+    const AccessorLayout& layout,
+    int64_t vertexCount,
+    std::byte* pDestination,
+    int64_t stride) {
+  const int32_t sourceComponentCount =
+      pAccessor ? std::min<int32_t>(
+                      pAccessor->computeNumberOfComponents(),
+                      attribute.componentCount)
+                : 0;
+  const int64_t componentSize =
+      VertexLayout::getComponentByteSize(attribute.format);
+
+  // The components that the accessor doesn't have are the same for every
+  // vertex, so they are encoded once.
+  std::array<std::byte, 16> padding{};
+  const int32_t paddingComponentCount =
+      attribute.componentCount - sourceComponentCount;
+  writeComponents(
+      attribute.format,
+      missingComponents.data() + sourceComponentCount,
+      paddingComponentCount,
+      1,
+      padding.data(),
+      0);
+  const int64_t sourceBytes = componentSize * sourceComponentCount;
+  const size_t paddingBytes =
+      static_cast<size_t>(componentSize * paddingComponentCount);
+  if (paddingBytes > 0) {
+    std::byte* pVertex = pDestination + sourceBytes;
+    for (int64_t i = 0; i < vertexCount; ++i, pVertex += stride) {
+      std::memcpy(pVertex, padding.data(), paddingBytes);
+    }
+  }
+
+  if (sourceComponentCount == 0) {
+    return true;
+  }
+
+  if (isStoredAs(*pAccessor, attribute.format)) {
+    const std::byte* pElement = layout.pData + layout.offset;
+    std::byte* pVertex = pDestination;
+    for (int64_t i = 0; i < vertexCount; ++i) {
+      std::memcpy(pVertex, pElement, static_cast<size_t>(sourceBytes));
+      pElement += layout.stride;
+      pVertex += stride;
+    }
+    return true;
+  }
+
+  std::vector<float> values(size_t(blockSize * 4));
+  for (int64_t first = 0; first < vertexCount; first += blockSize) {
+    const int64_t count = std::min(blockSize, vertexCount - first);
+    if (!readComponents(
+            *pAccessor,
+            layout,
+            sourceComponentCount,
+            first,
+            count,
+            values.data())) {
+      return false;
+    }
+    writeComponents(
+        attribute.format,
+        values.data(),
+        sourceComponentCount,
+        count,
+        pDestination + first * stride,
+        stride);
+  }
+  return true;
+}
+
+template <typename TSource, typename TDestination>
+bool copyIndices(
+    const AccessorLayout& layout,
+    int64_t vertexCount,
+    std::byte* pDestination) noexcept {
+  const std::byte* pElement = layout.pData + layout.offset;
+  bool valid = true;
+  for (int64_t i = 0; i < layout.size; ++i, pElement += layout.stride) {
+    TSource index;
+    std::memcpy(&index, pElement, sizeof(index));
+    valid &= int64_t(index) < vertexCount;
+    const TDestination packed = static_cast<TDestination>(index);
+    std::memcpy(
+        pDestination + i * int64_t(sizeof(packed)),
+        &packed,
+        sizeof(packed));
+  }
+  return valid;
+}
+
+template <typename TSource>
+bool copyIndices(
+    const AccessorLayout& layout,
+    int64_t vertexCount,
+    IndexFormat format,
+    std::byte* pDestination) noexcept {
+  return format == IndexFormat::UInt16
+             ? copyIndices<TSource, uint16_t>(layout, vertexCount, pDestination)
+             : copyIndices<TSource, uint32_t>(
+                   layout,
+                   vertexCount,
+                   pDestination);
+}
+
+bool packIndices(
+    const Model& model,
+    const MeshPrimitive& primitive,
+    IndexFormat requestedFormat,
+    PackedMeshPrimitive& result) {
+  // The largest 16-bit index is left out, because some graphics APIs always
+  // treat it as a primitive restart.
+  const bool fits16Bits = result.vertexCount <= 65535;
+  result.indexFormat = requestedFormat == IndexFormat::UInt32 ||
+                               (requestedFormat == IndexFormat::Smallest &&
+                                !fits16Bits)
+                           ? IndexFormat::UInt32
+                           : IndexFormat::UInt16;
+
+  if (primitive.indices < 0) {
+    return true;
+  }
+  if (result.indexFormat == IndexFormat::UInt16 && !fits16Bits) {
+    return false;
+  }
+
+  const Accessor* pAccessor =
+      Model::getSafe(&model.accessors, primitive.indices);
+  if (!pAccessor || pAccessor->sparse ||
+      pAccessor->type != Accessor::Type::SCALAR) {
+    return false;
+  }
+  const AccessorLayout layout = AccessorLayout::create(model, *pAccessor);
+  if (layout.status != AccessorViewStatus::Valid) {
+    return false;
+  }
+
+  const int64_t indexSize =
+      result.indexFormat == IndexFormat::UInt16 ? 2 : 4;
+  result.indexCount = layout.size;
+  result.indices.resize(size_t(layout.size * indexSize));
+  switch (pAccessor->componentType) {
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    return copyIndices<uint8_t>(
+        layout,
+        result.vertexCount,
+        result.indexFormat,
+        result.indices.data());
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    return copyIndices<uint16_t>(
+        layout,
+        result.vertexCount,
+        result.indexFormat,
+        result.indices.data());
+  case Accessor::ComponentType::UNSIGNED_INT:
+    return copyIndices<uint32_t>(
+        layout,
+        result.vertexCount,
+        result.indexFormat,
+        result.indices.data());
+  default:
+    return false;
+  }
+}
+
+const Accessor* getAttributeAccessor(
+    const Model& model,
+    const MeshPrimitive& primitive,
+    const std::string& semantic) {
+  auto it = primitive.attributes.find(semantic);
+  if (it == primitive.attributes.end()) {
+    return nullptr;
+  }
+  return Model::getSafe(&model.accessors, it->second);
+}
+} // namespace
+
+/*static*/ int64_t
+VertexLayout::getComponentByteSize(VertexComponentFormat format) noexcept {
+  switch (format) {
+  case VertexComponentFormat::Float32:
+    return 4;
+  case VertexComponentFormat::Float16:
+  case VertexComponentFormat::Snorm16:
+  case VertexComponentFormat::Unorm16:
+    return 2;
+  case VertexComponentFormat::Snorm8:
+  case VertexComponentFormat::Unorm8:
+    return 1;
+  }
+  return 0;
+}
+
+int32_t VertexLayout::getStreamCount() const noexcept {
+  int32_t count = 0;
+  for (const VertexAttributeLayout& attribute : this->attributes) {
+    count = std::max(count, attribute.stream + 1);
+  }
+  return count;
+}
+
+int64_t VertexLayout::getStreamByteStride(int32_t stream) const noexcept {
+  int64_t stride = 0;
+  for (const VertexAttributeLayout& attribute : this->attributes) {
+    if (attribute.stream == stream) {
+      stride += getAttributeByteSize(attribute);
+    }
+  }
+  return stride;
+}
+
+int64_t
+VertexLayout::getAttributeByteOffset(size_t attributeIndex) const noexcept {
+  if (attributeIndex >= this->attributes.size()) {
+    return 0;
+  }
+  const int32_t stream = this->attributes[attributeIndex].stream;
+  int64_t offset = 0;
+  for (size_t i = 0; i < attributeIndex; ++i) {
+    if (this->attributes[i].stream == stream) {
+      offset += getAttributeByteSize(this->attributes[i]);
+    }
+  }
+  return offset;
+}
+
+std::optional<PackedMeshPrimitive> VertexLayout::packPrimitive(
+    const Model& model,
+    const MeshPrimitive& primitive) const {
+  for (const VertexAttributeLayout& attribute : this->attributes) {
+    if (attribute.componentCount < 1 || attribute.componentCount > 4 ||
+        attribute.stream < 0) {
+      return std::nullopt;
+    }
+  }
+
+  const Accessor* pPositions =
+      getAttributeAccessor(model, primitive, "POSITION");
+  if (!pPositions) {
+    return std::nullopt;
+  }
+
+  PackedMeshPrimitive result;
+  result.vertexCount = pPositions->count;
+
+  // Validate every accessor before converting any of them.
+  std::vector<const Accessor*> accessors(this->attributes.size());
+  std::vector<AccessorLayout> layouts(this->attributes.size());
+  result.hasAttribute.resize(this->attributes.size());
+  for (size_t i = 0; i < this->attributes.size(); ++i) {
+    const Accessor* pAccessor =
+        getAttributeAccessor(model, primitive, this->attributes[i].semantic);
+    if (!pAccessor) {
+      continue;
+    }
+    const int8_t componentCount = pAccessor->computeNumberOfComponents();
+    if (pAccessor->sparse || componentCount < 1 || componentCount > 4 ||
+        pAccessor->type.rfind("MAT", 0) == 0) {
+      return std::nullopt;
+    }
+    const AccessorLayout layout = AccessorLayout::create(model, *pAccessor);
+    if (layout.status != AccessorViewStatus::Valid ||
+        layout.size != result.vertexCount) {
+      return std::nullopt;
+    }
+    accessors[i] = pAccessor;
+    layouts[i] = layout;
+    result.hasAttribute[i] = true;
+  }
+
+  if (!packIndices(model, primitive, this->indexFormat, result)) {
+    return std::nullopt;
+  }
+
+  result.streams.resize(size_t(this->getStreamCount()));
+  for (size_t stream = 0; stream < result.streams.size(); ++stream) {
+    PackedVertexStream& packed = result.streams[stream];
+    packed.byteStride = this->getStreamByteStride(int32_t(stream));
+    packed.data.resize(size_t(packed.byteStride * result.vertexCount));
+  }
+
+  for (size_t i = 0; i < this->attributes.size(); ++i) {
+    const VertexAttributeLayout& attribute = this->attributes[i];
+    PackedVertexStream& packed = result.streams[size_t(attribute.stream)];
+    if (!packAttribute(
+            attribute,
+            accessors[i],
+            layouts[i],
+            result.vertexCount,
+            packed.data.data() + this->getAttributeByteOffset(i),
+            packed.byteStride)) {
+      return std::nullopt;
+    }
+  }
+
+  return result;
+}
+
+std::vector<PackedMeshPrimitive>
+VertexLayout::packModel(const Model& model) const {
+  std::vector<PackedMeshPrimitive> result;
+  for (size_t meshIndex = 0; meshIndex < model.meshes.size(); ++meshIndex) {
+    const Mesh& mesh = model.meshes[meshIndex];
+    for (size_t primitiveIndex = 0; primitiveIndex < mesh.primitives.size();
+         ++primitiveIndex) {
+      std::optional<PackedMeshPrimitive> maybePacked =
+          this->packPrimitive(model, mesh.primitives[primitiveIndex]);
+      if (maybePacked) {
+        maybePacked->meshIndex = int32_t(meshIndex);
+        maybePacked->primitiveIndex = int32_t(primitiveIndex);
+        result.emplace_back(std::move(*maybePacked));
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace CesiumGltfContent
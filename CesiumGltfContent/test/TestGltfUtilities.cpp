@@ -1,5 +1,9 @@
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/WorkStealingTaskProcessor.h>
+#include <CesiumGltf/AccessorView.h>
 #include <CesiumGltf/ExtensionBufferExtMeshoptCompression.h>
 #include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
+#include <CesiumGltf/ExtensionExtMeshFeatures.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumGltf/Node.h>
 #include <CesiumGltfContent/GltfUtilities.h>
@@ -8,6 +12,15 @@
 #include <catch2/catch.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 using namespace CesiumGltf;
 using namespace CesiumGltfContent;
 using namespace CesiumUtility;
@@ -643,3 +656,541 @@ TEST_CASE("GltfUtilities::collapseToSingleBuffer") {
     CHECK(m.bufferViews[2].byteLength == 100);
   }
 }
+
+TEST_CASE("GltfUtilities::collapseToSingleCompactBuffer") {
+  Model m;
+
+  Buffer& buffer1 = m.buffers.emplace_back();
+  buffer1.byteLength = 40;
+  for (size_t i = 0; i < 40; ++i) {
+    buffer1.cesium.data.emplace_back(std::byte(i));
+  }
+
+  Buffer& buffer2 = m.buffers.emplace_back();
+  buffer2.byteLength = 100;
+  buffer2.uri = "foo";
+
+  Buffer& buffer3 = m.buffers.emplace_back();
+  buffer3.byteLength = 24;
+  for (size_t i = 0; i < 24; ++i) {
+    buffer3.cesium.data.emplace_back(std::byte(100 + i));
+  }
+
+  BufferView& bufferView1 = m.bufferViews.emplace_back();
+  bufferView1.buffer = 0;
+  bufferView1.byteOffset = 16;
+  bufferView1.byteLength = 10;
+
+  BufferView& bufferView2 = m.bufferViews.emplace_back();
+  bufferView2.buffer = 1;
+  bufferView2.byteLength = 100;
+
+  BufferView& bufferView3 = m.bufferViews.emplace_back();
+  bufferView3.buffer = 2;
+  bufferView3.byteOffset = 3;
+  bufferView3.byteLength = 10;
+  ExtensionBufferViewExtMeshoptCompression& extension =
+      bufferView3.addExtension<ExtensionBufferViewExtMeshoptCompression>();
+  extension.buffer = 2;
+  extension.byteOffset = 13;
+  extension.byteLength = 7;
+
+  GltfUtilities::collapseToSingleCompactBuffer(m);
+
+  REQUIRE(m.buffers.size() == 2);
+  CHECK(m.buffers[1].uri == "foo");
+  CHECK(m.bufferViews[1].buffer == 1);
+  CHECK(m.bufferViews[1].byteOffset == 0);
+
+  // The used bytes are packed, each at the same offset modulo 8 as before.
+  const CesiumUtility::ByteVector& data = m.buffers[0].cesium.data;
+  REQUIRE(data.size() == 28);
+  CHECK(m.buffers[0].byteLength == 28);
+
+  CHECK(m.bufferViews[0].buffer == 0);
+  CHECK(m.bufferViews[0].byteOffset == 0);
+  CHECK(m.bufferViews[2].buffer == 0);
+  CHECK(m.bufferViews[2].byteOffset == 11);
+  CHECK(extension.buffer == 0);
+  CHECK(extension.byteOffset == 21);
+
+  for (size_t i = 0; i < 10; ++i) {
+    CHECK(data[i] == std::byte(16 + i));
+  }
+  for (size_t i = 0; i < 17; ++i) {
+    CHECK(data[11 + i] == std::byte(103 + i));
+  }
+}
+
+namespace {
+// A model like a converted b3dm, with many buffers that each have gaps
+// between their bufferViews.
+Model createModelWithManyBuffers() {
+  Model m;
+  for (int32_t i = 0; i < 200; ++i) {
+    Buffer& buffer = m.buffers.emplace_back();
+    buffer.cesium.data.resize(1 << 16);
+    buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+    for (int64_t j = 0; j < 4; ++j) {
+      BufferView& bufferView = m.bufferViews.emplace_back();
+      bufferView.buffer = i;
+      bufferView.byteOffset = j * (1 << 14) + 64;
+      bufferView.byteLength = (1 << 14) - 128;
+    }
+  }
+  return m;
+}
+
+template <typename Func> double millisecondsToProcess(Func&& f) {
+  constexpr int32_t iterations = 20;
+  double total = 0.0;
+  for (int32_t i = 0; i < iterations; ++i) {
+    Model m = createModelWithManyBuffers();
+    const auto start = std::chrono::steady_clock::now();
+    f(m);
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    total += elapsed.count();
+    CHECK(m.buffers.size() == 1);
+  }
+  return total / double(iterations);
+}
+} // namespace
+
+// A benchmark of collapsing and compacting the buffers of a model, which only
+// runs when asked for, with the [!benchmark] tag.
+TEST_CASE("Collapsing and compacting buffers", "[!benchmark]") {
+  const double separate = millisecondsToProcess([](Model& m) {
+    GltfUtilities::collapseToSingleBuffer(m);
+    GltfUtilities::compactBuffers(m);
+  });
+  WARN("collapseToSingleBuffer and compactBuffers: " << separate << " ms");
+
+  const double combined = millisecondsToProcess(
+      [](Model& m) { GltfUtilities::collapseToSingleCompactBuffer(m); });
+  WARN("collapseToSingleCompactBuffer: " << combined << " ms");
+}
+
+namespace {
+template <typename T>
+int32_t addAccessor(
+    Model& model,
+    const std::vector<T>& values,
+    const std::string& type,
+    int32_t componentType) {
+  Buffer& buffer = model.buffers[0];
+  const size_t byteOffset = buffer.cesium.data.size();
+  const size_t byteLength = values.size() * sizeof(T);
+  buffer.cesium.data.resize(byteOffset + byteLength);
+  std::memcpy(
+      buffer.cesium.data.data() + byteOffset,
+      values.data(),
+      byteLength);
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteOffset = int64_t(byteOffset);
+  bufferView.byteLength = int64_t(byteLength);
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = int32_t(model.bufferViews.size() - 1);
+  accessor.type = type;
+  accessor.componentType = componentType;
+  accessor.count = int64_t(values.size());
+  return int32_t(model.accessors.size() - 1);
+}
+
+// Each triangle as the x coordinates of its vertices, starting with the
+// smallest so that equal triangles with the same winding compare equal.
+std::vector<std::array<float, 3>>
+getTriangles(const Model& model, const MeshPrimitive& primitive) {
+  AccessorView<glm::vec3> positions(
+      model,
+      primitive.attributes.at("POSITION"));
+  AccessorView<uint16_t> indices(model, primitive.indices);
+  REQUIRE(positions.status() == AccessorViewStatus::Valid);
+  REQUIRE(indices.status() == AccessorViewStatus::Valid);
+
+  std::vector<std::array<float, 3>> triangles;
+  for (int64_t i = 0; i + 2 < indices.size(); i += 3) {
+    std::array<float, 3> triangle{
+        positions[indices[i]].x,
+        positions[indices[i + 1]].x,
+        positions[indices[i + 2]].x};
+    std::rotate(
+        triangle.begin(),
+        std::min_element(triangle.begin(), triangle.end()),
+        triangle.end());
+    triangles.emplace_back(triangle);
+  }
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+} // namespace
+
+TEST_CASE("GltfUtilities::optimizeMeshes") {
+  Model m;
+  m.buffers.emplace_back();
+
+  // The last vertex isn't used.
+  const std::vector<glm::vec3> positions{
+      glm::vec3(0.0f, 0.0f, 0.0f),
+      glm::vec3(1.0f, 0.0f, 0.0f),
+      glm::vec3(2.0f, 1.0f, 0.0f),
+      glm::vec3(3.0f, 1.0f, 0.0f),
+      glm::vec3(4.0f, 2.0f, 0.0f)};
+  std::vector<glm::vec2> texCoords;
+  for (const glm::vec3& position : positions) {
+    texCoords.emplace_back(position.x, position.y);
+  }
+  const std::vector<uint16_t> indices{3, 1, 2, 2, 1, 0, 3, 2, 0};
+
+  MeshPrimitive& primitive = m.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = addAccessor(
+      m,
+      positions,
+      Accessor::Type::VEC3,
+      Accessor::ComponentType::FLOAT);
+  primitive.attributes["TEXCOORD_0"] = addAccessor(
+      m,
+      texCoords,
+      Accessor::Type::VEC2,
+      Accessor::ComponentType::FLOAT);
+  primitive.indices = addAccessor(
+      m,
+      indices,
+      Accessor::Type::SCALAR,
+      Accessor::ComponentType::UNSIGNED_SHORT);
+
+  const std::vector<std::array<float, 3>> expectedTriangles =
+      getTriangles(m, primitive);
+
+  SECTION("reorders the vertices and keeps the triangles") {
+    GltfUtilities::optimizeMeshes(m);
+
+    CHECK(getTriangles(m, m.meshes[0].primitives[0]) == expectedTriangles);
+    CHECK(m.accessors[0].count == 4);
+    CHECK(m.accessors[1].count == 4);
+
+    // The vertices are in the order that the triangles use them.
+    AccessorView<glm::vec3> newPositions(m, 0);
+    AccessorView<glm::vec2> newTexCoords(m, 1);
+    AccessorView<uint16_t> newIndices(m, 2);
+    uint16_t nextVertex = 0;
+    for (int64_t i = 0; i < newIndices.size(); ++i) {
+      CHECK(newIndices[i] <= nextVertex);
+      if (newIndices[i] == nextVertex) {
+        ++nextVertex;
+      }
+    }
+
+    for (int64_t i = 0; i < newPositions.size(); ++i) {
+      CHECK(newTexCoords[i].x == newPositions[i].x);
+      CHECK(newTexCoords[i].y == newPositions[i].y);
+    }
+  }
+
+  SECTION("leaves primitives with shared accessors alone") {
+    MeshPrimitive copy = primitive;
+    m.meshes[0].primitives.emplace_back(std::move(copy));
+    GltfUtilities::optimizeMeshes(m);
+
+    CHECK(m.accessors[0].count == 5);
+    AccessorView<uint16_t> newIndices(m, 2);
+    for (int64_t i = 0; i < newIndices.size(); ++i) {
+      CHECK(newIndices[i] == indices[size_t(i)]);
+    }
+  }
+}
+
+TEST_CASE("GltfUtilities::simplifyMeshes") {
+  Model m;
+  m.buffers.emplace_back();
+
+  // A flat 8x8 grid of squares, each split into two triangles.
+  const uint16_t size = 9;
+  std::vector<glm::vec3> positions;
+  for (uint16_t y = 0; y < size; ++y) {
+    for (uint16_t x = 0; x < size; ++x) {
+      positions.emplace_back(float(x), float(y), 0.0f);
+    }
+  }
+  std::vector<uint16_t> indices;
+  for (uint16_t y = 0; y + 1 < size; ++y) {
+    for (uint16_t x = 0; x + 1 < size; ++x) {
+      const uint16_t i = uint16_t(y * size + x);
+      const uint16_t square[6]{
+          i,
+          uint16_t(i + 1),
+          uint16_t(i + size),
+          uint16_t(i + 1),
+          uint16_t(i + size + 1),
+          uint16_t(i + size)};
+      indices.insert(indices.end(), std::begin(square), std::end(square));
+    }
+  }
+
+  MeshPrimitive& primitive = m.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = addAccessor(
+      m,
+      positions,
+      Accessor::Type::VEC3,
+      Accessor::ComponentType::FLOAT);
+  primitive.indices = addAccessor(
+      m,
+      indices,
+      Accessor::Type::SCALAR,
+      Accessor::ComponentType::UNSIGNED_SHORT);
+
+  SECTION("collapses the inside of a flat mesh and keeps its border") {
+    GltfUtilities::simplifyMeshes(m, 0.01);
+
+    AccessorView<glm::vec3> newPositions(m, 0);
+    AccessorView<uint16_t> newIndices(m, 1);
+    REQUIRE(newPositions.status() == AccessorViewStatus::Valid);
+    REQUIRE(newIndices.status() == AccessorViewStatus::Valid);
+    CHECK(newIndices.size() % 3 == 0);
+    CHECK(newIndices.size() < int64_t(indices.size()));
+    CHECK(newPositions.size() < int64_t(positions.size()));
+
+    // The border vertices are all still there.
+    int64_t borderVertices = 0;
+    for (int64_t i = 0; i < newPositions.size(); ++i) {
+      const glm::vec3& position = newPositions[i];
+      CHECK(position.z == 0.0f);
+      if (position.x == 0.0f || position.y == 0.0f ||
+          position.x == float(size - 1) || position.y == float(size - 1)) {
+        ++borderVertices;
+      }
+    }
+    CHECK(borderVertices == 4 * (size - 1));
+
+    // The triangles still cover the whole grid, without folding over.
+    double area = 0.0;
+    for (int64_t i = 0; i + 2 < newIndices.size(); i += 3) {
+      const glm::vec3 a = newPositions[newIndices[i]];
+      const glm::vec3 b = newPositions[newIndices[i + 1]];
+      const glm::vec3 c = newPositions[newIndices[i + 2]];
+      const double signedArea =
+          0.5 * double((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y));
+      CHECK(signedArea > 0.0);
+      area += signedArea;
+    }
+    CHECK(Math::equalsEpsilon(area, double((size - 1) * (size - 1)), 1e-6));
+  }
+
+  SECTION("leaves the meshes alone without an error") {
+    GltfUtilities::simplifyMeshes(m, 0.0);
+
+    CHECK(m.accessors[0].count == int64_t(positions.size()));
+    CHECK(m.accessors[1].count == int64_t(indices.size()));
+  }
+}
+
+TEST_CASE("GltfUtilities::mergePrimitives") {
+  Model m;
+  m.buffers.emplace_back();
+  Mesh& mesh = m.meshes.emplace_back();
+
+  auto addPrimitive = [&m, &mesh](float featureId, int32_t material) {
+    const std::vector<glm::vec3> positions{
+        glm::vec3(featureId, 0.0f, 0.0f),
+        glm::vec3(featureId, 1.0f, 0.0f),
+        glm::vec3(featureId, 1.0f, 1.0f)};
+    const std::vector<float> featureIds(positions.size(), featureId);
+    const std::vector<uint8_t> indices{0, 1, 2};
+
+    MeshPrimitive primitive;
+    primitive.material = material;
+    primitive.attributes["POSITION"] = addAccessor(
+        m,
+        positions,
+        Accessor::Type::VEC3,
+        Accessor::ComponentType::FLOAT);
+    primitive.attributes["_FEATURE_ID_0"] = addAccessor(
+        m,
+        featureIds,
+        Accessor::Type::SCALAR,
+        Accessor::ComponentType::FLOAT);
+    primitive.indices = addAccessor(
+        m,
+        indices,
+        Accessor::Type::SCALAR,
+        Accessor::ComponentType::UNSIGNED_BYTE);
+
+    FeatureId& feature = primitive.addExtension<ExtensionExtMeshFeatures>()
+                             .featureIds.emplace_back();
+    feature.featureCount = 2;
+    feature.attribute = 0;
+    mesh.primitives.emplace_back(std::move(primitive));
+  };
+
+  addPrimitive(0.0f, 0);
+  addPrimitive(1.0f, 1);
+  addPrimitive(1.0f, 0);
+
+  GltfUtilities::mergePrimitives(m);
+
+  REQUIRE(mesh.primitives.size() == 2);
+  const MeshPrimitive& merged = mesh.primitives[0];
+  CHECK(merged.material == 0);
+  CHECK(merged.hasExtension<ExtensionExtMeshFeatures>());
+  CHECK(mesh.primitives[1].material == 1);
+  CHECK(mesh.primitives[1].indices == 5);
+
+  AccessorView<glm::vec3> positions(m, merged.attributes.at("POSITION"));
+  AccessorView<float> featureIds(m, merged.attributes.at("_FEATURE_ID_0"));
+  AccessorView<uint16_t> indices(m, merged.indices);
+  REQUIRE(positions.status() == AccessorViewStatus::Valid);
+  REQUIRE(featureIds.status() == AccessorViewStatus::Valid);
+  REQUIRE(indices.status() == AccessorViewStatus::Valid);
+  REQUIRE(positions.size() == 6);
+  REQUIRE(indices.size() == 6);
+
+  // Each vertex keeps its feature ID, and the indices of the second
+  // primitive are offset by the vertices of the first.
+  for (int64_t i = 0; i < positions.size(); ++i) {
+    const float expected = i < 3 ? 0.0f : 1.0f;
+    CHECK(positions[i].x == expected);
+    CHECK(featureIds[i] == expected);
+    CHECK(indices[i] == i);
+  }
+}
+
+TEST_CASE("GltfUtilities::orderPointsForLevelOfDetail") {
+  Model m;
+  m.buffers.emplace_back();
+
+  // An 8x8x8 grid of points, with the original index of each point.
+  std::vector<glm::vec3> positions;
+  for (int32_t z = 0; z < 8; ++z) {
+    for (int32_t y = 0; y < 8; ++y) {
+      for (int32_t x = 0; x < 8; ++x) {
+        positions.emplace_back(float(x), float(y), float(z));
+      }
+    }
+  }
+  std::vector<float> ids(positions.size());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    ids[i] = float(i);
+  }
+
+  MeshPrimitive& primitive = m.meshes.emplace_back().primitives.emplace_back();
+  primitive.mode = MeshPrimitive::Mode::POINTS;
+  primitive.attributes["POSITION"] = addAccessor(
+      m,
+      positions,
+      Accessor::Type::VEC3,
+      Accessor::ComponentType::FLOAT);
+  primitive.attributes["_ID"] = addAccessor(
+      m,
+      ids,
+      Accessor::Type::SCALAR,
+      Accessor::ComponentType::FLOAT);
+  FeatureId& feature = primitive.addExtension<ExtensionExtMeshFeatures>()
+                           .featureIds.emplace_back();
+  feature.featureCount = int64_t(positions.size());
+
+  GltfUtilities::orderPointsForLevelOfDetail(m);
+
+  AccessorView<glm::vec3> ordered(m, primitive.attributes.at("POSITION"));
+  AccessorView<float> orderedIds(m, primitive.attributes.at("_ID"));
+  REQUIRE(ordered.status() == AccessorViewStatus::Valid);
+  REQUIRE(orderedIds.status() == AccessorViewStatus::Valid);
+  REQUIRE(ordered.size() == int64_t(positions.size()));
+
+  // The implicit feature IDs are replaced by an attribute.
+  REQUIRE(feature.attribute == 0);
+  AccessorView<uint16_t> featureIds(
+      m,
+      primitive.attributes.at("_FEATURE_ID_0"));
+  REQUIRE(featureIds.status() == AccessorViewStatus::Valid);
+
+  std::vector<bool> found(positions.size(), false);
+  for (int64_t i = 0; i < ordered.size(); ++i) {
+    const size_t id = size_t(orderedIds[i]);
+    CHECK(ordered[i] == positions[id]);
+    CHECK(size_t(featureIds[i]) == id);
+    found[id] = true;
+  }
+  CHECK(std::all_of(found.begin(), found.end(), [](bool b) { return b; }));
+
+  // After the first point, the next 8 points are in different octants, and
+  // the 64 after those are in different cells of a 4x4x4 grid.
+  std::vector<bool> octants(8, false);
+  for (int64_t i = 1; i < 9; ++i) {
+    const glm::ivec3 cell = glm::ivec3(ordered[i]) / 4;
+    octants[size_t(cell.x + 2 * cell.y + 4 * cell.z)] = true;
+  }
+  CHECK(std::all_of(octants.begin(), octants.end(), [](bool b) { return b; }));
+
+  std::vector<bool> cells(64, false);
+  for (int64_t i = 9; i < 73; ++i) {
+    const glm::ivec3 cell = glm::ivec3(ordered[i]) / 2;
+    cells[size_t(cell.x + 4 * cell.y + 16 * cell.z)] = true;
+  }
+  CHECK(std::all_of(cells.begin(), cells.end(), [](bool b) { return b; }));
+}
+
+TEST_CASE("GltfUtilities::forEachPrimitiveInSceneInParallel") {
+  Model model;
+  Scene& scene = model.scenes.emplace_back();
+  model.scene = 0;
+  for (int32_t i = 0; i < 8; ++i) {
+    scene.nodes.emplace_back(i);
+    Node& node = model.nodes.emplace_back();
+    node.mesh = i;
+    node.translation = {double(i), 0.0, 0.0};
+    model.meshes.emplace_back().primitives.resize(size_t(i) + 1);
+  }
+
+  const std::vector<Model::ScenePrimitive> expected =
+      model.getPrimitivesInScene(-1);
+  REQUIRE(expected.size() == 36);
+
+  CesiumAsync::WorkStealingTaskProcessorOptions options;
+  options.numberOfThreads = 4;
+  CesiumAsync::AsyncSystem asyncSystem(
+      std::make_shared<CesiumAsync::WorkStealingTaskProcessor>(options));
+
+  std::mutex mutex;
+  std::vector<Model::ScenePrimitive> visited;
+  GltfUtilities::forEachPrimitiveInSceneInParallel(
+      asyncSystem,
+      model,
+      -1,
+      [&mutex, &visited](
+          const Model& /*gltf*/,
+          const Node& node,
+          const Mesh& mesh,
+          const MeshPrimitive& primitive,
+          const glm::dmat4& transform) {
+        std::lock_guard<std::mutex> lock(mutex);
+        visited.emplace_back(
+            Model::ScenePrimitive{&node, &mesh, &primitive, transform});
+      })
+      .wait();
+
+  REQUIRE(visited.size() == expected.size());
+  std::sort(
+      visited.begin(),
+      visited.end(),
+      [](const Model::ScenePrimitive& a, const Model::ScenePrimitive& b) {
+        return a.pPrimitive < b.pPrimitive;
+      });
+  for (const Model::ScenePrimitive& primitive : expected) {
+    auto it = std::lower_bound(
+        visited.begin(),
+        visited.end(),
+        primitive.pPrimitive,
+        [](const Model::ScenePrimitive& a, const MeshPrimitive* pPrimitive) {
+          return a.pPrimitive < pPrimitive;
+        });
+    REQUIRE(it != visited.end());
+    CHECK(it->pPrimitive == primitive.pPrimitive);
+    CHECK(it->pNode == primitive.pNode);
+    CHECK(it->transform == primitive.transform);
+  }
+}
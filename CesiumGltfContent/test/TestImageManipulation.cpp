@@ -4,6 +4,8 @@
 #include <catch2/catch.hpp>
 
 #include <algorithm>
+#include <cstdint>
+#include <vector>
 
 using namespace CesiumGltf;
 using namespace CesiumGltfContent;
@@ -133,7 +135,7 @@ TEST_CASE("ImageManipulation::blitImage") {
   target.channels = 4;
   target.width = 15;
   target.height = 9;
-  target.pixelData = std::vector<std::byte>(
+  target.pixelData.assign(
       size_t(
           target.width * target.height * target.channels *
           target.bytesPerChannel),
@@ -144,7 +146,7 @@ TEST_CASE("ImageManipulation::blitImage") {
   source.channels = 4;
   source.width = 10;
   source.height = 11;
-  source.pixelData = std::vector<std::byte>(
+  source.pixelData.assign(
       size_t(
           source.width * source.height * source.channels *
           source.bytesPerChannel),
@@ -332,3 +334,190 @@ TEST_CASE("ImageManipulation::blitImage") {
     verifyTargetUnchanged();
   }
 }
+
+TEST_CASE("ImageManipulation::unsafeResampleImage") {
+  SECTION("interpolates between the centers of the source pixels") {
+    const std::vector<uint8_t> source{0, 255, 10, 255, 255, 0, 10, 255};
+    std::vector<uint8_t> target(4 * 4);
+    ImageManipulation::unsafeResampleImage(
+        reinterpret_cast<std::byte*>(target.data()),
+        4 * 4,
+        4,
+        1,
+        reinterpret_cast<const std::byte*>(source.data()),
+        2 * 4,
+        2,
+        1,
+        4);
+
+    const std::vector<uint8_t> expectedRed{0, 64, 191, 255};
+    const std::vector<uint8_t> expectedGreen{255, 191, 64, 0};
+    for (size_t i = 0; i < 4; ++i) {
+      CHECK(target[i * 4] == expectedRed[i]);
+      CHECK(target[i * 4 + 1] == expectedGreen[i]);
+      CHECK(target[i * 4 + 2] == 10);
+      CHECK(target[i * 4 + 3] == 255);
+    }
+  }
+
+  SECTION("interpolates vertically") {
+    const std::vector<uint8_t> source{0, 0, 255, 255};
+    std::vector<uint8_t> target(4 * 4);
+    ImageManipulation::unsafeResampleImage(
+        reinterpret_cast<std::byte*>(target.data()),
+        4,
+        4,
+        4,
+        reinterpret_cast<const std::byte*>(source.data()),
+        2,
+        2,
+        2,
+        1);
+
+    const std::vector<uint8_t> expectedRows{0, 64, 191, 255};
+    for (size_t j = 0; j < 4; ++j) {
+      for (size_t i = 0; i < 4; ++i) {
+        CHECK(target[j * 4 + i] == expectedRows[j]);
+      }
+    }
+  }
+
+  SECTION("resamples large images") {
+    const size_t width = 1024;
+    const size_t height = 768;
+    const size_t channels = 3;
+    const std::vector<uint8_t> source{10, 20, 30, 40, 50, 60};
+    std::vector<uint8_t> target(width * height * channels);
+    ImageManipulation::unsafeResampleImage(
+        reinterpret_cast<std::byte*>(target.data()),
+        width * channels,
+        width,
+        height,
+        reinterpret_cast<const std::byte*>(source.data()),
+        2 * channels,
+        2,
+        1,
+        channels);
+
+    CHECK(target[0] == 10);
+    CHECK(target[(width - 1) * channels + 2] == 60);
+    for (size_t j = 1; j < height; ++j) {
+      REQUIRE(std::equal(
+          target.begin(),
+          target.begin() + std::ptrdiff_t(width * channels),
+          target.begin() + std::ptrdiff_t(j * width * channels)));
+    }
+  }
+}
+
+TEST_CASE("ImageManipulation::blitImage enlarges images") {
+  ImageCesium source;
+  source.bytesPerChannel = 1;
+  source.channels = 4;
+  source.width = 2;
+  source.height = 2;
+  source.pixelData.assign(16, std::byte(200));
+
+  ImageCesium target;
+  target.bytesPerChannel = 1;
+  target.channels = 4;
+  target.width = 8;
+  target.height = 8;
+  target.pixelData.assign(8 * 8 * 4, std::byte(1));
+
+  CHECK(ImageManipulation::blitImage(
+      target,
+      PixelRectangle{2, 2, 4, 4},
+      source,
+      PixelRectangle{0, 0, 2, 2}));
+
+  for (size_t j = 0; j < 8; ++j) {
+    for (size_t i = 0; i < 8; ++i) {
+      const bool inside = i >= 2 && i < 6 && j >= 2 && j < 6;
+      const std::byte expected = inside ? std::byte(200) : std::byte(1);
+      for (size_t k = 0; k < 4; ++k) {
+        CHECK(target.pixelData[(j * 8 + i) * 4 + k] == expected);
+      }
+    }
+  }
+}
+
+TEST_CASE("ImageManipulation::blitImage copies the blocks of compressed "
+          "images") {
+  // Two by two blocks, each filled with its index.
+  ImageCesium source;
+  source.bytesPerChannel = 1;
+  source.channels = 3;
+  source.width = 8;
+  source.height = 8;
+  source.compressedPixelFormat = GpuCompressedPixelFormat::BC1_RGB;
+  for (size_t i = 0; i < 4; ++i) {
+    source.pixelData.insert(source.pixelData.end(), 8, std::byte(i));
+  }
+
+  // Three by two blocks, where the last column of blocks is partly outside
+  // the image.
+  ImageCesium target;
+  target.bytesPerChannel = 1;
+  target.channels = 3;
+  target.width = 10;
+  target.height = 8;
+  target.compressedPixelFormat = GpuCompressedPixelFormat::BC1_RGB;
+  REQUIRE(
+      ImageManipulation::computeBlockCompressedImageSize(
+          target.compressedPixelFormat,
+          target.width,
+          target.height) == 6 * 8);
+  target.pixelData.assign(6 * 8, std::byte(9));
+
+  SECTION("copies aligned blocks") {
+    CHECK(ImageManipulation::blitImage(
+        target,
+        PixelRectangle{4, 0, 4, 8},
+        source,
+        PixelRectangle{0, 0, 4, 8}));
+
+    const std::vector<std::byte> expected{
+        std::byte(9),
+        std::byte(0),
+        std::byte(9),
+        std::byte(9),
+        std::byte(2),
+        std::byte(9)};
+    for (size_t i = 0; i < expected.size(); ++i) {
+      for (size_t j = 0; j < 8; ++j) {
+        CHECK(target.pixelData[i * 8 + j] == expected[i]);
+      }
+    }
+  }
+
+  SECTION("returns false for blocks that aren't aligned") {
+    CHECK(!ImageManipulation::blitImage(
+        target,
+        PixelRectangle{2, 0, 4, 4},
+        source,
+        PixelRectangle{0, 0, 4, 4}));
+    CHECK(!ImageManipulation::blitImage(
+        target,
+        PixelRectangle{0, 0, 2, 4},
+        source,
+        PixelRectangle{0, 0, 2, 4}));
+  }
+
+  SECTION("returns false for a scaled blit") {
+    CHECK(!ImageManipulation::blitImage(
+        target,
+        PixelRectangle{0, 0, 8, 8},
+        source,
+        PixelRectangle{0, 0, 4, 4}));
+  }
+
+  SECTION("returns false for mismatched formats") {
+    target.compressedPixelFormat = GpuCompressedPixelFormat::NONE;
+    CHECK(!ImageManipulation::blitImage(
+        target,
+        PixelRectangle{0, 0, 4, 4},
+        source,
+        PixelRectangle{0, 0, 4, 4}));
+  }
+}
@@ -0,0 +1,237 @@
+#include <CesiumGltf/Accessor.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/VertexLayout.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+
+namespace {
+template <typename T>
+int32_t addAccessor(
+    Model& model,
+    const std::vector<T>& values,
+    const std::string& type,
+    int32_t componentType,
+    bool normalized = false) {
+  Buffer& buffer = model.buffers[0];
+  const size_t byteOffset = buffer.cesium.data.size();
+  const size_t byteLength = values.size() * sizeof(T);
+  buffer.cesium.data.resize(byteOffset + byteLength);
+  std::memcpy(
+      buffer.cesium.data.data() + byteOffset,
+      values.data(),
+      byteLength);
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteOffset = int64_t(byteOffset);
+  bufferView.byteLength = int64_t(byteLength);
+
+  const int64_t componentCount = Accessor::computeNumberOfComponents(type);
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = int32_t(model.bufferViews.size() - 1);
+  accessor.type = type;
+  accessor.componentType = componentType;
+  accessor.normalized = normalized;
+  accessor.count = int64_t(values.size()) / componentCount;
+  return int32_t(model.accessors.size() - 1);
+}
+
+template <typename T>
+T readPacked(
+    const PackedVertexStream& stream,
+    int64_t vertex,
+    int64_t byteOffset) {
+  T value;
+  std::memcpy(
+      &value,
+      stream.data.data() + vertex * stream.byteStride + byteOffset,
+      sizeof(T));
+  return value;
+}
+
+template <typename T>
+std::vector<T> readIndices(const PackedMeshPrimitive& packed) {
+  REQUIRE(packed.indices.size() == size_t(packed.indexCount) * sizeof(T));
+  std::vector<T> indices(size_t(packed.indexCount));
+  std::memcpy(indices.data(), packed.indices.data(), packed.indices.size());
+  return indices;
+}
+} // namespace
+
+TEST_CASE("VertexLayout") {
+  Model model;
+  model.buffers.emplace_back();
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = addAccessor(
+      model,
+      std::vector<float>{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f},
+      Accessor::Type::VEC3,
+      Accessor::ComponentType::FLOAT);
+  primitive.attributes["NORMAL"] = addAccessor(
+      model,
+      std::vector<float>{0.0f, 0.0f, 1.0f, 0.0f, -1.0f, 0.0f, 2.0f, 0.0f, 0.0f},
+      Accessor::Type::VEC3,
+      Accessor::ComponentType::FLOAT);
+  primitive.attributes["TEXCOORD_0"] = addAccessor(
+      model,
+      std::vector<uint8_t>{0, 255, 128, 64, 255, 0},
+      Accessor::Type::VEC2,
+      Accessor::ComponentType::UNSIGNED_BYTE,
+      true);
+  primitive.indices = addAccessor(
+      model,
+      std::vector<uint32_t>{0, 1, 2},
+      Accessor::Type::SCALAR,
+      Accessor::ComponentType::UNSIGNED_INT);
+
+  VertexLayout layout;
+  layout.attributes = {
+      {"POSITION", VertexComponentFormat::Float32, 3, 0},
+      {"NORMAL", VertexComponentFormat::Snorm8, 3, 0},
+      {"TEXCOORD_0", VertexComponentFormat::Unorm16, 2, 1},
+      {"COLOR_0", VertexComponentFormat::Unorm8, 4, 1}};
+
+  SECTION("interleaves the attributes of each stream, aligned to 4 bytes") {
+    CHECK(layout.getStreamCount() == 2);
+    CHECK(layout.getStreamByteStride(0) == 16);
+    CHECK(layout.getStreamByteStride(1) == 8);
+    CHECK(layout.getAttributeByteOffset(0) == 0);
+    CHECK(layout.getAttributeByteOffset(1) == 12);
+    CHECK(layout.getAttributeByteOffset(2) == 0);
+    CHECK(layout.getAttributeByteOffset(3) == 4);
+  }
+
+  SECTION("converts the attributes to their packed formats") {
+    const std::optional<PackedMeshPrimitive> maybePacked =
+        layout.packPrimitive(model, primitive);
+    REQUIRE(maybePacked);
+    const PackedMeshPrimitive& packed = *maybePacked;
+    CHECK(packed.vertexCount == 3);
+    CHECK(packed.hasAttribute == std::vector<bool>{true, true, true, false});
+    REQUIRE(packed.streams.size() == 2);
+    const PackedVertexStream& first = packed.streams[0];
+    const PackedVertexStream& second = packed.streams[1];
+    REQUIRE(first.data.size() == 3 * 16);
+    REQUIRE(second.data.size() == 3 * 8);
+
+    CHECK(readPacked<float>(first, 1, 0) == 3.0f);
+    CHECK(readPacked<float>(first, 2, 8) == 8.0f);
+
+    // Normals are clamped, and the padding after them is left as zeros.
+    CHECK(readPacked<int8_t>(first, 0, 14) == 127);
+    CHECK(readPacked<int8_t>(first, 1, 13) == -127);
+    CHECK(readPacked<int8_t>(first, 2, 12) == 127);
+    CHECK(readPacked<int8_t>(first, 2, 15) == 0);
+
+    CHECK(readPacked<uint16_t>(second, 0, 0) == 0);
+    CHECK(readPacked<uint16_t>(second, 0, 2) == 65535);
+    CHECK(readPacked<uint16_t>(second, 1, 0) == 128 * 257);
+
+    // The primitive has no colors, so they are (0, 0, 0, 1).
+    CHECK(readPacked<uint8_t>(second, 2, 4) == 0);
+    CHECK(readPacked<uint8_t>(second, 2, 5) == 0);
+    CHECK(readPacked<uint8_t>(second, 2, 6) == 0);
+    CHECK(readPacked<uint8_t>(second, 2, 7) == 255);
+
+    CHECK(packed.indexFormat == IndexFormat::UInt16);
+    CHECK(readIndices<uint16_t>(packed) == std::vector<uint16_t>{0, 1, 2});
+  }
+
+  SECTION("copies components that are already in the packed format") {
+    layout.attributes = {
+        {"POSITION", VertexComponentFormat::Float32, 4, 0},
+        {"TEXCOORD_0", VertexComponentFormat::Unorm8, 2, 0}};
+    const std::optional<PackedMeshPrimitive> maybePacked =
+        layout.packPrimitive(model, primitive);
+    REQUIRE(maybePacked);
+    const PackedVertexStream& stream = maybePacked->streams[0];
+    CHECK(stream.byteStride == 20);
+    CHECK(readPacked<float>(stream, 2, 0) == 6.0f);
+    CHECK(readPacked<float>(stream, 2, 12) == 1.0f);
+    CHECK(readPacked<uint8_t>(stream, 1, 16) == 128);
+    CHECK(readPacked<uint8_t>(stream, 1, 17) == 64);
+  }
+
+  SECTION("converts to 16-bit floats") {
+    primitive.attributes["_VALUES"] = addAccessor(
+        model,
+        std::vector<float>{1.0f, -2.0f, 65504.0f, 1.0e6f, 5.96046448e-8f, 0.1f},
+        Accessor::Type::VEC2,
+        Accessor::ComponentType::FLOAT);
+    layout.attributes = {{"_VALUES", VertexComponentFormat::Float16, 2, 0}};
+    const std::optional<PackedMeshPrimitive> maybePacked =
+        layout.packPrimitive(model, primitive);
+    REQUIRE(maybePacked);
+    const PackedVertexStream& stream = maybePacked->streams[0];
+    CHECK(readPacked<uint16_t>(stream, 0, 0) == 0x3c00);
+    CHECK(readPacked<uint16_t>(stream, 0, 2) == 0xc000);
+    CHECK(readPacked<uint16_t>(stream, 1, 0) == 0x7bff);
+    CHECK(readPacked<uint16_t>(stream, 1, 2) == 0x7c00);
+    CHECK(readPacked<uint16_t>(stream, 2, 0) == 0x0001);
+    CHECK(readPacked<uint16_t>(stream, 2, 2) == 0x2e66);
+  }
+
+  SECTION("packs indices in the requested width") {
+    layout.indexFormat = IndexFormat::UInt32;
+    const std::optional<PackedMeshPrimitive> packed =
+        layout.packPrimitive(model, primitive);
+    REQUIRE(packed);
+    CHECK(packed->indexFormat == IndexFormat::UInt32);
+    CHECK(readIndices<uint32_t>(*packed) == std::vector<uint32_t>{0, 1, 2});
+
+    primitive.indices = -1;
+    const std::optional<PackedMeshPrimitive> unindexed =
+        layout.packPrimitive(model, primitive);
+    REQUIRE(unindexed);
+    CHECK(unindexed->indexCount == 0);
+    CHECK(unindexed->indices.empty());
+  }
+
+  SECTION("does not pack primitives that it can't pack correctly") {
+    SECTION("an index is out of range") {
+      primitive.indices = addAccessor(
+          model,
+          std::vector<uint16_t>{0, 1, 3},
+          Accessor::Type::SCALAR,
+          Accessor::ComponentType::UNSIGNED_SHORT);
+    }
+
+    SECTION("an attribute has the wrong number of vertices") {
+      model.accessors[size_t(primitive.attributes["NORMAL"])].count = 2;
+    }
+
+    SECTION("there are no positions") {
+      primitive.attributes.erase("POSITION");
+    }
+
+    SECTION("the layout has an invalid attribute") {
+      layout.attributes[0].componentCount = 5;
+    }
+
+    CHECK(!layout.packPrimitive(model, primitive));
+    CHECK(layout.packModel(model).empty());
+  }
+
+  SECTION("packs every primitive of a model that it can") {
+    const MeshPrimitive copy = primitive;
+    model.meshes.emplace_back().primitives = {MeshPrimitive(), copy};
+    const std::vector<PackedMeshPrimitive> packed = layout.packModel(model);
+    REQUIRE(packed.size() == 2);
+    CHECK(packed[0].meshIndex == 0);
+    CHECK(packed[0].primitiveIndex == 0);
+    CHECK(packed[1].meshIndex == 1);
+    CHECK(packed[1].primitiveIndex == 1);
+  }
+}
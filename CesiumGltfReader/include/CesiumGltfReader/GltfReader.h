@@ -11,9 +11,12 @@
 #include <CesiumGltf/Model.h>
 #include <CesiumJsonReader/IExtensionJsonHandler.h>
 #include <CesiumJsonReader/JsonReaderOptions.h>
+#include <CesiumUtility/Allocator.h>
 
 #include <gsl/span>
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -67,6 +70,8 @@ struct CESIUMGLTFREADER_API ImageReaderResult {
   std::vector<std::string> warnings;
 };
 
+class SharedImageCache;
+
 /**
  * @brief Options for how to read a glTF.
  */
@@ -101,6 +106,18 @@ struct CESIUMGLTFREADER_API GltfReaderOptions {
    */
   bool decodeDraco = true;
 
+  /**
+   * @brief Whether the vertex attributes of each primitive decoded from
+   * `KHR_draco_mesh_compression` are interleaved in a single buffer view.
+   *
+   * Either way, the indices and vertex attributes of each decoded primitive
+   * are copied into a single new buffer. If this is false, each attribute has
+   * a buffer view of its own in that buffer. If it is true, the attributes
+   * share a buffer view with a `byteStride` of the size of a whole vertex,
+   * which is ready to be uploaded as an interleaved vertex buffer.
+   */
+  bool interleaveDracoAttributes = false;
+
   /**
    * @brief Whether the mesh data are decompressed as part of the load process,
    * or left in the compressed format according to the EXT_meshopt_compression
@@ -112,6 +129,13 @@ struct CESIUMGLTFREADER_API GltfReaderOptions {
    * @brief Whether the quantized mesh data are dequantized and converted to
    * floating-point values when loading, according to the KHR_mesh_quantization
    * extension.
+   *
+   * If this is false, quantized attributes keep their smaller integer
+   * components. Quantized positions can be read with
+   * {@link CesiumGltf::getQuantizedPositionAccessorView} and
+   * {@link CesiumGltf::getAccessorDequantization}, which is how
+   * `GltfUtilities::computeBoundingRegion` and the raster overlay texture
+   * coordinates read them.
    */
   bool dequantizeMeshData = true;
 
@@ -121,11 +145,57 @@ struct CESIUMGLTFREADER_API GltfReaderOptions {
    */
   bool applyTextureTransform = true;
 
+  /**
+   * @brief Whether the `animations` of the glTF are read into
+   * {@link Model::animations}.
+   *
+   * If this is false, they are skipped while parsing the JSON, which saves
+   * the time and memory it takes to read them when they are not needed.
+   */
+  bool readAnimations = true;
+
+  /**
+   * @brief Whether the `skins` of the glTF are read into
+   * {@link Model::skins}.
+   *
+   * If this is false, they are skipped while parsing the JSON. Nodes still
+   * refer to the skipped skins by index.
+   */
+  bool readSkins = true;
+
+  /**
+   * @brief The largest width or height of a decoded image, or 0 to decode
+   * images at their full size.
+   *
+   * Larger images are reduced as cheaply as their format allows:
+   *
+   *  * JPEG images are downscaled while they are decoded, by the largest of
+   *    the factors that libjpeg-turbo supports (such as 7/8, 1/2 or 1/8) that
+   *    fits. This is much faster than decoding the full image.
+   *  * KTX2 images with mipmaps skip the mip levels that are too large.
+   *  * Other uncompressed images, and JPEG images that are still too large,
+   *    are halved with a 2x2 box filter until they fit.
+   *
+   * Images that are GPU-compressed and have no small enough mip level are
+   * left at their full size.
+   */
+  int32_t maximumTextureSize = 0;
+
   /**
    * @brief For each possible input transmission format, this struct names
    * the ideal target gpu-compressed pixel format to transcode to.
    */
   CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets;
+
+  /**
+   * @brief A cache to get the external images of the model from, so that the
+   * images that many models refer to are only fetched and decoded once, or
+   * nullptr to fetch and decode the images of each model.
+   *
+   * This is only used by {@link GltfReader::resolveExternalData}. See
+   * {@link SharedImageCache}.
+   */
+  std::shared_ptr<SharedImageCache> pSharedImageCache;
 };
 
 /**
@@ -159,6 +229,57 @@ public:
       const gsl::span<const std::byte>& data,
       const GltfReaderOptions& options = GltfReaderOptions()) const;
 
+  /**
+   * @brief Reads a glTF or binary glTF (GLB) from a buffer, decoding its
+   * embedded images, Draco-compressed primitives and meshopt-compressed
+   * buffer views in parallel in worker threads.
+   *
+   * The JSON is read before this method returns, so the buffer does not need
+   * to outlive the call.
+   *
+   * @param asyncSystem The async system to use for the decoding.
+   * @param data The buffer from which to read the glTF.
+   * @param options Options for how to read the glTF.
+   * @return A future that resolves to the result of reading the glTF.
+   */
+  CesiumAsync::Future<GltfReaderResult> readGltf(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const gsl::span<const std::byte>& data,
+      const GltfReaderOptions& options = GltfReaderOptions()) const;
+
+  /**
+   * @brief Reads a glTF or binary glTF (GLB) from a buffer that the caller no
+   * longer needs.
+   *
+   * This is the same as the overload that takes a span, except that the
+   * binary chunk of a GLB is not copied into a new allocation. It is moved to
+   * the start of `data`, which then becomes the data of the first buffer.
+   *
+   * @param data The buffer from which to read the glTF.
+   * @param options Options for how to read the glTF.
+   * @return The result of reading the glTF.
+   */
+  GltfReaderResult readGltf(
+      CesiumUtility::ByteVector&& data,
+      const GltfReaderOptions& options = GltfReaderOptions()) const;
+
+  /**
+   * @brief Reads a glTF or binary glTF (GLB) from a buffer that the caller no
+   * longer needs, decoding it in parallel in worker threads.
+   *
+   * As with the synchronous overload, the binary chunk of a GLB becomes the
+   * data of the first buffer without a new allocation.
+   *
+   * @param asyncSystem The async system to use for the decoding.
+   * @param data The buffer from which to read the glTF.
+   * @param options Options for how to read the glTF.
+   * @return A future that resolves to the result of reading the glTF.
+   */
+  CesiumAsync::Future<GltfReaderResult> readGltf(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      CesiumUtility::ByteVector&& data,
+      const GltfReaderOptions& options = GltfReaderOptions()) const;
+
   /**
    * @brief Reads a glTF or binary glTF file from a URL and resolves external
    * buffers and images.
@@ -187,6 +308,23 @@ public:
   void
   postprocessGltf(GltfReaderResult& readGltf, const GltfReaderOptions& options);
 
+  /**
+   * @brief Performs post-load processing on a glTF, like
+   * {@link postprocessGltf}, but decodes its embedded images, Draco-compressed
+   * primitives and meshopt-compressed buffer views in parallel in worker
+   * threads. Everything else is done in the calling thread or in the thread
+   * that finishes the last decode.
+   *
+   * @param asyncSystem The async system to use for the decoding.
+   * @param readGltf The result of reading the glTF.
+   * @param options The options to use in post-processing.
+   * @return A future that resolves to the post-processed glTF.
+   */
+  CesiumAsync::Future<GltfReaderResult> postprocessGltf(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      GltfReaderResult&& readGltf,
+      const GltfReaderOptions& options) const;
+
   /**
    * @brief Accepts the result of {@link readGltf} and resolves any remaining
    * external buffers and images.
@@ -217,11 +355,15 @@ public:
    * @param ktx2TranscodeTargetFormat The compression format to transcode
    * KTX v2 textures into. If this is std::nullopt, KTX v2 textures will be
    * fully decompressed into raw pixels.
+   * @param maximumTextureSize If greater than zero, images that are wider or
+   * taller than this are reduced to fit. See
+   * {@link GltfReaderOptions::maximumTextureSize}.
    * @return The result of reading the image.
    */
   static ImageReaderResult readImage(
       const gsl::span<const std::byte>& data,
-      const CesiumGltf::Ktx2TranscodeTargets& ktx2TranscodeTargets);
+      const CesiumGltf::Ktx2TranscodeTargets& ktx2TranscodeTargets,
+      int32_t maximumTextureSize = 0);
 
   /**
    * @brief Generate mipmaps for this image.
@@ -239,4 +381,85 @@ private:
   CesiumJsonReader::JsonReaderOptions _context;
 };
 
+/**
+ * @brief Reads a binary glTF (GLB) incrementally, as its bytes arrive.
+ *
+ * The JSON chunk of a GLB comes before its binary chunk, and is usually a
+ * small part of it. This reader reads the JSON as soon as all of it has been
+ * {@link append}ed, so that the external buffers and images of the model can
+ * be requested, with {@link GltfReader::resolveExternalData}, while the rest of
+ * the GLB is still being received. Once the whole GLB has arrived, the binary
+ * chunk is added to the model with {@link readBinaryChunk}, and the model can
+ * be post-processed with {@link GltfReader::postprocessGltf}.
+ */
+class CESIUMGLTFREADER_API GlbStreamReader {
+public:
+  /**
+   * @brief Constructs a new instance.
+   *
+   * @param reader The reader whose extensions are used to read the JSON. It
+   * must outlive this instance.
+   * @param options Options for how to read the glTF.
+   */
+  explicit GlbStreamReader(
+      const GltfReader& reader,
+      const GltfReaderOptions& options = GltfReaderOptions());
+
+  /**
+   * @brief Appends the next bytes of the GLB, and reads the JSON chunk if all
+   * of it has now arrived.
+   *
+   * The bytes are copied, so they do not need to outlive the call.
+   *
+   * @param data The bytes that follow the ones appended before.
+   */
+  void append(const gsl::span<const std::byte>& data);
+
+  /**
+   * @brief Determines whether the JSON chunk has been read, or could not be
+   * read because the GLB is invalid. Either way, the result can be taken with
+   * {@link takeJsonResult}.
+   */
+  bool isJsonRead() const noexcept { return this->_jsonRead; }
+
+  /**
+   * @brief Determines whether all of the bytes of the GLB have been appended,
+   * according to the length in its header, or the GLB is invalid.
+   */
+  bool isComplete() const noexcept;
+
+  /**
+   * @brief Takes the result of reading the JSON chunk.
+   *
+   * The first buffer of the model does not have the data of the binary chunk
+   * yet. If the GLB is invalid, the result has no model and holds the errors.
+   *
+   * @return The result, or `std::nullopt` if the JSON chunk has not been read
+   * yet or its result has already been taken.
+   */
+  std::optional<GltfReaderResult> takeJsonResult();
+
+  /**
+   * @brief Adds the binary chunk of the GLB to the model read from its JSON
+   * chunk.
+   *
+   * If the GLB is not complete yet, or its binary chunk is invalid, an error
+   * is added to the result and its model is removed.
+   *
+   * @param result The result taken with {@link takeJsonResult}, which may have
+   * had its external data resolved since.
+   */
+  void readBinaryChunk(GltfReaderResult& result) const;
+
+private:
+  const GltfReader* _pReader;
+  GltfReaderOptions _options;
+  std::vector<std::byte> _data;
+  size_t _length;
+  size_t _jsonEnd;
+  bool _jsonRead;
+  bool _failed;
+  std::optional<GltfReaderResult> _jsonResult;
+};
+
 } // namespace CesiumGltfReader
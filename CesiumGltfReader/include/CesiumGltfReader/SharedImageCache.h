@@ -0,0 +1,148 @@
+#pragma once
+
+#include "CesiumGltfReader/Library.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/SharedFuture.h>
+#include <CesiumGltf/ImageCesium.h>
+#include <CesiumGltf/Ktx2TranscodeTargets.h>
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumGltfReader {
+
+/**
+ * @brief An image decoded by a {@link SharedImageCache}.
+ */
+struct CESIUMGLTFREADER_API SharedImage {
+  /**
+   * @brief An identifier of the image that is the same for every image with
+   * the same content, decoded with the same options, even from another URL.
+   *
+   * It is written to the extras of each glTF image that is resolved from the
+   * cache, see {@link SharedImageCache::ExtrasKey}, so that a renderer can
+   * share one texture between all of them.
+   */
+  std::string key;
+
+  /**
+   * @brief The decoded image.
+   */
+  CesiumGltf::ImageCesium image;
+};
+
+/**
+ * @brief A cache of the external images of glTF models, so that an image that
+ * many models refer to is only fetched and decoded once.
+ *
+ * Photogrammetry and BIM tilesets often have many tiles that refer to the
+ * same texture files. When a cache is set in
+ * {@link GltfReaderOptions::pSharedImageCache},
+ * {@link GltfReader::resolveExternalData} gets the images from it instead of
+ * fetching and decoding each one itself. A request for an image that is
+ * still loading for another model waits for that load. Images with another
+ * URL but the same content are only decoded once, too.
+ *
+ * Each model still gets its own copy of the pixels, which can be released
+ * once they are uploaded to the GPU. The {@link SharedImage::key} in the
+ * extras of each image lets the renderer share the texture itself.
+ *
+ * All methods are thread-safe. The cache must outlive the loads that it
+ * starts, which {@link GltfReader::resolveExternalData} makes sure of.
+ */
+class CESIUMGLTFREADER_API SharedImageCache {
+public:
+  /**
+   * @brief The key in the extras of a glTF image under which
+   * {@link GltfReader::resolveExternalData} writes the
+   * {@link SharedImage::key} of an image resolved from a cache.
+   */
+  static constexpr const char* ExtrasKey = "Cesium_SharedImageKey";
+
+  /**
+   * @brief Creates an empty cache.
+   *
+   * @param maximumBytes The largest total size, in bytes, of the pixels of
+   * the loaded images that are kept. When more are loaded, the least recently
+   * used ones are removed.
+   */
+  explicit SharedImageCache(int64_t maximumBytes = 256 * 1024 * 1024);
+
+  /**
+   * @brief Gets the image at a URL, fetching and decoding it if it isn't in
+   * the cache or loading already.
+   *
+   * @param asyncSystem The async system to load the image with.
+   * @param pAssetAccessor The asset accessor to fetch the image with.
+   * @param url The absolute URL of the image.
+   * @param headers The headers of the request.
+   * @param ktx2TranscodeTargets The formats to transcode KTX2 images to.
+   * @param maximumTextureSize The largest width or height of the image, or 0
+   * for no limit, see {@link GltfReaderOptions::maximumTextureSize}.
+   * @return A future that resolves to the image, or to nullptr if it couldn't
+   * be fetched or decoded.
+   */
+  CesiumAsync::SharedFuture<std::shared_ptr<const SharedImage>> getOrLoad(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const CesiumGltf::Ktx2TranscodeTargets& ktx2TranscodeTargets,
+      int32_t maximumTextureSize);
+
+  /**
+   * @brief Gets the number of URLs whose images are in the cache or loading.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Gets the total size, in bytes, of the pixels of the loaded images
+   * in the cache.
+   */
+  int64_t getTotalBytes() const;
+
+private:
+  using ImageFuture =
+      CesiumAsync::SharedFuture<std::shared_ptr<const SharedImage>>;
+
+  struct Entry {
+    std::string urlKey;
+    ImageFuture future;
+    bool isLoaded = false;
+    int64_t sizeBytes = 0;
+    std::string imageKey;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  std::shared_ptr<const SharedImage> findOrDecode(
+      const std::string& optionsKey,
+      const gsl::span<const std::byte>& data,
+      const CesiumGltf::Ktx2TranscodeTargets& ktx2TranscodeTargets,
+      int32_t maximumTextureSize);
+  void finishLoad(
+      const std::string& urlKey,
+      const std::shared_ptr<const SharedImage>& pImage);
+  void evictEntries();
+
+  int64_t _maximumBytes;
+  int64_t _totalBytes;
+  mutable std::mutex _mutex;
+  // The most recently used entries come first.
+  EntryList _entries;
+  std::unordered_map<std::string, EntryList::iterator> _entriesByUrl;
+  std::unordered_map<std::string, std::weak_ptr<const SharedImage>>
+      _imagesByKey;
+};
+
+} // namespace CesiumGltfReader
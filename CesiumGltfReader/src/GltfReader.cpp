@@ -1,5 +1,7 @@
 #include "CesiumGltfReader/GltfReader.h"
 
+#include "CesiumGltfReader/SharedImageCache.h"
+
 #include "ModelJsonHandler.h"
 #include "applyKhrTextureTransform.h"
 #include "decodeDataUrls.h"
@@ -7,6 +9,7 @@
 #include "decodeMeshOpt.h"
 #include "dequantizeMeshData.h"
 #include "registerReaderExtensions.h"
+#include "skipKtx2MipLevels.h"
 
 #include <CesiumAsync/IAssetRequest.h>
 #include <CesiumAsync/IAssetResponse.h>
@@ -24,9 +27,13 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <iomanip>
+#include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #define STBI_FAILURE_USERMSG
 
@@ -72,13 +79,43 @@ bool isBinaryGltf(const gsl::span<const std::byte>& data) noexcept {
   return reinterpret_cast<const GlbHeader*>(data.data())->magic == 0x46546C67;
 }
 
+/**
+ * @brief Reads a glTF, skipping the top-level properties that the
+ * {@link GltfReaderOptions} say are not needed.
+ */
+class FilteredModelJsonHandler : public ModelJsonHandler {
+public:
+  FilteredModelJsonHandler(
+      const CesiumJsonReader::JsonReaderOptions& context,
+      const GltfReaderOptions& options) noexcept
+      : ModelJsonHandler(context),
+        _readAnimations(options.readAnimations),
+        _readSkins(options.readSkins) {}
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    using namespace std::string_literals;
+
+    if ((!this->_readAnimations && "animations"s == str) ||
+        (!this->_readSkins && "skins"s == str)) {
+      return this->ignoreAndContinue();
+    }
+
+    return ModelJsonHandler::readObjectKey(str);
+  }
+
+private:
+  bool _readAnimations;
+  bool _readSkins;
+};
+
 GltfReaderResult readJsonGltf(
     const CesiumJsonReader::JsonReaderOptions& context,
+    const GltfReaderOptions& options,
     const gsl::span<const std::byte>& data) {
 
   CESIUM_TRACE("CesiumGltfReader::GltfReader::readJsonGltf");
 
-  ModelJsonHandler modelHandler(context);
+  FilteredModelJsonHandler modelHandler(context, options);
   CesiumJsonReader::ReadJsonResult<Model> jsonResult =
       CesiumJsonReader::JsonReader::readJson(data, modelHandler);
 
@@ -108,32 +145,148 @@ std::string toMagicString(uint32_t i) {
   return stream.str();
 }
 
-GltfReaderResult readBinaryGltf(
-    const CesiumJsonReader::JsonReaderOptions& context,
-    const gsl::span<const std::byte>& data) {
-  CESIUM_TRACE("CesiumGltfReader::GltfReader::readBinaryGltf");
-
-  if (data.size() < sizeof(GlbHeader) + sizeof(ChunkHeader)) {
-    return {std::nullopt, {"Too short to be a valid GLB."}, {}};
-  }
+const size_t glbJsonStart = sizeof(GlbHeader) + sizeof(ChunkHeader);
 
+// Checks the GLB header and the header of the JSON chunk, which must both be
+// in the data.
+std::optional<std::string>
+checkGlbHeaders(const gsl::span<const std::byte>& data) {
   const GlbHeader* pHeader = reinterpret_cast<const GlbHeader*>(data.data());
   if (pHeader->magic != 0x46546C67) {
-    return {
-        std::nullopt,
-        {"GLB does not start with the expected magic value 'glTF', but " +
-         toMagicString(pHeader->magic)},
-        {}};
+    return "GLB does not start with the expected magic value 'glTF', but " +
+           toMagicString(pHeader->magic);
   }
 
   if (pHeader->version != 2) {
-    return {
-        std::nullopt,
-        {"Only binary glTF version 2 is supported, found version " +
-         std::to_string(pHeader->version)},
-        {}};
+    return "Only binary glTF version 2 is supported, found version " +
+           std::to_string(pHeader->version);
+  }
+
+  const ChunkHeader* pJsonChunkHeader =
+      reinterpret_cast<const ChunkHeader*>(data.data() + sizeof(GlbHeader));
+  if (pJsonChunkHeader->chunkType != 0x4E4F534A) {
+    return "GLB JSON chunk does not have the expected chunkType 'JSON', but " +
+           toMagicString(pJsonChunkHeader->chunkType);
+  }
+
+  return std::nullopt;
+}
+
+size_t getGlbJsonEnd(const gsl::span<const std::byte>& data) {
+  const ChunkHeader* pJsonChunkHeader =
+      reinterpret_cast<const ChunkHeader*>(data.data() + sizeof(GlbHeader));
+  return glbJsonStart + pJsonChunkHeader->chunkLength;
+}
+
+// Finds the binary chunk that follows the JSON chunk, if there is one.
+std::optional<std::string> findBinaryChunk(
+    const gsl::span<const std::byte>& glbData,
+    size_t jsonEnd,
+    gsl::span<const std::byte>& binaryChunk) {
+  if (jsonEnd + sizeof(ChunkHeader) > glbData.size()) {
+    return std::nullopt;
+  }
+
+  const ChunkHeader* pBinaryChunkHeader =
+      reinterpret_cast<const ChunkHeader*>(glbData.data() + jsonEnd);
+  if (pBinaryChunkHeader->chunkType != 0x004E4942) {
+    return "GLB binary chunk does not have the expected chunkType 'BIN', but " +
+           toMagicString(pBinaryChunkHeader->chunkType);
   }
 
+  const size_t binaryStart = jsonEnd + sizeof(ChunkHeader);
+  const size_t binaryEnd = binaryStart + pBinaryChunkHeader->chunkLength;
+
+  if (binaryEnd > glbData.size()) {
+    return "GLB binary chunk extends past the end of the buffer, binary end "
+           "at " +
+           std::to_string(binaryEnd) + ", data size " +
+           std::to_string(glbData.size());
+  }
+
+  binaryChunk = glbData.subspan(binaryStart, pBinaryChunkHeader->chunkLength);
+  return std::nullopt;
+}
+
+// Copies the binary chunk into the first buffer of the model read from the
+// JSON chunk. If pGlb is given, it is the vector that holds the chunk, and
+// the chunk is moved to its start and the vector used as the buffer's data
+// instead, so no new allocation is needed.
+void addBinaryChunk(
+    GltfReaderResult& result,
+    const gsl::span<const std::byte>& binaryChunk,
+    CesiumUtility::ByteVector* pGlb = nullptr) {
+  if (!result.model || binaryChunk.empty()) {
+    return;
+  }
+
+  Model& model = result.model.value();
+
+  if (model.buffers.empty()) {
+    result.errors.emplace_back(
+        "GLB has a binary chunk but the JSON does not define any buffers.");
+    return;
+  }
+
+  Buffer& buffer = model.buffers[0];
+  if (buffer.uri) {
+    result.errors.emplace_back("GLB has a binary chunk but the first buffer "
+                               "in the JSON chunk also has a 'uri'.");
+    return;
+  }
+
+  const int64_t binaryChunkSize = static_cast<int64_t>(binaryChunk.size());
+  if (buffer.byteLength > binaryChunkSize) {
+    result.errors.emplace_back(
+        "The size of the first buffer in the JSON chunk is " +
+        std::to_string(buffer.byteLength) +
+        ", which is larger than the size of the GLB binary chunk (" +
+        std::to_string(binaryChunkSize) + ")");
+    return;
+  }
+  // The byte length of the BIN chunk MAY be up to 3 bytes
+  // bigger than JSON-defined buffer.byteLength. When it is
+  // more than 3 bytes bigger, generate a warning.
+  if (binaryChunkSize - buffer.byteLength > 3) {
+    result.warnings.emplace_back(
+        "The size of the first buffer in the JSON chunk is " +
+        std::to_string(buffer.byteLength) +
+        ", which is more than 3 bytes smaller than the size of the GLB "
+        "binary chunk (" +
+        std::to_string(binaryChunkSize) + ")");
+  }
+
+  if (pGlb) {
+    const size_t byteLength = static_cast<size_t>(buffer.byteLength);
+    std::memmove(pGlb->data(), binaryChunk.data(), byteLength);
+    pGlb->resize(byteLength);
+    buffer.cesium.data = std::move(*pGlb);
+  } else {
+    buffer.cesium.data.assign(
+        binaryChunk.begin(),
+        binaryChunk.begin() + buffer.byteLength);
+  }
+}
+
+// Reads the JSON chunk of a GLB and finds its binary chunk, which is not
+// added to the model.
+GltfReaderResult readBinaryGltfJson(
+    const CesiumJsonReader::JsonReaderOptions& context,
+    const GltfReaderOptions& options,
+    const gsl::span<const std::byte>& data,
+    gsl::span<const std::byte>& binaryChunk) {
+  CESIUM_TRACE("CesiumGltfReader::GltfReader::readBinaryGltf");
+
+  if (data.size() < glbJsonStart) {
+    return {std::nullopt, {"Too short to be a valid GLB."}, {}};
+  }
+
+  std::optional<std::string> headerError = checkGlbHeaders(data);
+  if (headerError) {
+    return {std::nullopt, {std::move(*headerError)}, {}};
+  }
+
+  const GlbHeader* pHeader = reinterpret_cast<const GlbHeader*>(data.data());
   if (pHeader->length > data.size()) {
     return {
         std::nullopt,
@@ -144,19 +297,7 @@ GltfReaderResult readBinaryGltf(
   }
 
   const gsl::span<const std::byte> glbData = data.subspan(0, pHeader->length);
-
-  const ChunkHeader* pJsonChunkHeader =
-      reinterpret_cast<const ChunkHeader*>(glbData.data() + sizeof(GlbHeader));
-  if (pJsonChunkHeader->chunkType != 0x4E4F534A) {
-    return {
-        std::nullopt,
-        {"GLB JSON chunk does not have the expected chunkType 'JSON', but " +
-         toMagicString(pJsonChunkHeader->chunkType)},
-        {}};
-  }
-
-  const size_t jsonStart = sizeof(GlbHeader) + sizeof(ChunkHeader);
-  const size_t jsonEnd = jsonStart + pJsonChunkHeader->chunkLength;
+  const size_t jsonEnd = getGlbJsonEnd(glbData);
 
   if (jsonEnd > glbData.size()) {
     return {
@@ -167,96 +308,190 @@ GltfReaderResult readBinaryGltf(
         {}};
   }
 
-  const gsl::span<const std::byte> jsonChunk =
-      glbData.subspan(jsonStart, pJsonChunkHeader->chunkLength);
+  std::optional<std::string> binaryChunkError =
+      findBinaryChunk(glbData, jsonEnd, binaryChunk);
+  if (binaryChunkError) {
+    return {std::nullopt, {std::move(*binaryChunkError)}, {}};
+  }
+
+  return readJsonGltf(
+      context,
+      options,
+      glbData.subspan(glbJsonStart, jsonEnd - glbJsonStart));
+}
+
+GltfReaderResult readBinaryGltf(
+    const CesiumJsonReader::JsonReaderOptions& context,
+    const GltfReaderOptions& options,
+    const gsl::span<const std::byte>& data) {
   gsl::span<const std::byte> binaryChunk;
+  GltfReaderResult result =
+      readBinaryGltfJson(context, options, data, binaryChunk);
+  addBinaryChunk(result, binaryChunk);
+  return result;
+}
 
-  if (jsonEnd + sizeof(ChunkHeader) <= data.size()) {
-    const ChunkHeader* pBinaryChunkHeader =
-        reinterpret_cast<const ChunkHeader*>(glbData.data() + jsonEnd);
-    if (pBinaryChunkHeader->chunkType != 0x004E4942) {
-      return {
-          std::nullopt,
-          {"GLB binary chunk does not have the expected chunkType 'BIN', but " +
-           toMagicString(pBinaryChunkHeader->chunkType)},
-          {}};
-    }
+// Reads a glTF or GLB, reusing the memory of a GLB for its binary chunk.
+GltfReaderResult readGltfFromVector(
+    const CesiumJsonReader::JsonReaderOptions& context,
+    const GltfReaderOptions& options,
+    CesiumUtility::ByteVector&& data) {
+  if (!isBinaryGltf(data)) {
+    return readJsonGltf(context, options, data);
+  }
+
+  gsl::span<const std::byte> binaryChunk;
+  GltfReaderResult result =
+      readBinaryGltfJson(context, options, data, binaryChunk);
+  addBinaryChunk(result, binaryChunk, &data);
+  return result;
+}
 
-    const size_t binaryStart = jsonEnd + sizeof(ChunkHeader);
-    const size_t binaryEnd = binaryStart + pBinaryChunkHeader->chunkLength;
+// An embedded image that needs to be decoded.
+struct PendingImage {
+  size_t imageIndex = 0;
+  gsl::span<const std::byte> data;
+  ImageReaderResult result;
+};
 
-    if (binaryEnd > glbData.size()) {
-      return {
-          std::nullopt,
-          {"GLB binary chunk extends past the end of the buffer, binary end "
-           "at " +
-           std::to_string(binaryEnd) + ", data size " +
-           std::to_string(glbData.size())},
-          {}};
+// The decoding done while post-processing a glTF. It only reads the buffers
+// of the model and writes to its own results, so the decodes can be done in
+// parallel with each other. The results are copied into the model afterward.
+struct PendingDecodes {
+  std::vector<PendingImage> images;
+  std::vector<DracoPrimitive> dracoPrimitives;
+  std::vector<MeshOptBufferView> meshOptBufferViews;
+
+  size_t size() const noexcept {
+    return this->images.size() + this->dracoPrimitives.size() +
+           this->meshOptBufferViews.size();
+  }
+
+  // Does the decode with the given index, counting across all three
+  // vectors. Decodes with different indices may be done concurrently.
+  void decode(size_t index, const GltfReaderOptions& options) {
+    if (index < this->images.size()) {
+      PendingImage& image = this->images[index];
+      image.result = GltfReader::readImage(
+          image.data,
+          options.ktx2TranscodeTargets,
+          options.maximumTextureSize);
+      return;
     }
+    index -= this->images.size();
 
-    binaryChunk = glbData.subspan(binaryStart, pBinaryChunkHeader->chunkLength);
+    if (index < this->dracoPrimitives.size()) {
+      this->dracoPrimitives[index].decode();
+      return;
+    }
+    index -= this->dracoPrimitives.size();
+
+    this->meshOptBufferViews[index].decode();
   }
+};
 
-  GltfReaderResult result = readJsonGltf(context, jsonChunk);
+bool hasExtension(const Model& model, const std::string& extension) {
+  return std::find(
+             model.extensionsUsed.begin(),
+             model.extensionsUsed.end(),
+             extension) != model.extensionsUsed.end();
+}
 
-  if (result.model && !binaryChunk.empty()) {
-    Model& model = result.model.value();
+std::vector<PendingImage> findEmbeddedImages(GltfReaderResult& readGltf) {
+  Model& model = readGltf.model.value();
+  std::vector<PendingImage> result;
+  for (size_t i = 0; i < model.images.size(); ++i) {
+    const Image& image = model.images[i];
 
-    if (model.buffers.empty()) {
-      result.errors.emplace_back(
-          "GLB has a binary chunk but the JSON does not define any buffers.");
-      return result;
+    // Ignore external images for now.
+    if (image.uri) {
+      continue;
     }
 
-    Buffer& buffer = model.buffers[0];
-    if (buffer.uri) {
-      result.errors.emplace_back("GLB has a binary chunk but the first buffer "
-                                 "in the JSON chunk also has a 'uri'.");
-      return result;
+    // Image has already been decoded
+    if (!image.cesium.pixelData.empty()) {
+      continue;
     }
 
-    const int64_t binaryChunkSize = static_cast<int64_t>(binaryChunk.size());
-    if (buffer.byteLength > binaryChunkSize) {
-      result.errors.emplace_back(
-          "The size of the first buffer in the JSON chunk is " +
-          std::to_string(buffer.byteLength) +
-          ", which is larger than the size of the GLB binary chunk (" +
-          std::to_string(binaryChunkSize) + ")");
-      return result;
-    }
-    // The byte length of the BIN chunk MAY be up to 3 bytes
-    // bigger than JSON-defined buffer.byteLength. When it is
-    // more than 3 bytes bigger, generate a warning.
-    if (binaryChunkSize - buffer.byteLength > 3) {
-      result.warnings.emplace_back(
-          "The size of the first buffer in the JSON chunk is " +
-          std::to_string(buffer.byteLength) +
-          ", which is more than 3 bytes smaller than the size of the GLB "
-          "binary chunk (" +
-          std::to_string(binaryChunkSize) + ")");
+    const BufferView& bufferView =
+        Model::getSafe(model.bufferViews, image.bufferView);
+    const Buffer& buffer = Model::getSafe(model.buffers, bufferView.buffer);
+
+    if (bufferView.byteOffset + bufferView.byteLength >
+        static_cast<int64_t>(buffer.cesium.data.size())) {
+      readGltf.warnings.emplace_back(
+          "Image bufferView's byte offset is " +
+          std::to_string(bufferView.byteOffset) + " and the byteLength is " +
+          std::to_string(bufferView.byteLength) + ", the result is " +
+          std::to_string(bufferView.byteOffset + bufferView.byteLength) +
+          ", which is more than the available " +
+          std::to_string(buffer.cesium.data.size()) + " bytes.");
+      continue;
     }
 
-    buffer.cesium.data = std::vector<std::byte>(
-        binaryChunk.begin(),
-        binaryChunk.begin() + buffer.byteLength);
+    const gsl::span<const std::byte> bufferSpan(buffer.cesium.data);
+    PendingImage& pendingImage = result.emplace_back();
+    pendingImage.imageIndex = i;
+    pendingImage.data = bufferSpan.subspan(
+        static_cast<size_t>(bufferView.byteOffset),
+        static_cast<size_t>(bufferView.byteLength));
   }
-
   return result;
 }
 
-void postprocess(
+void applyDecodedImages(
+    GltfReaderResult& readGltf,
+    std::vector<PendingImage>& images) {
+  Model& model = readGltf.model.value();
+  for (PendingImage& pendingImage : images) {
+    Image& image = model.images[pendingImage.imageIndex];
+    ImageReaderResult& imageResult = pendingImage.result;
+    readGltf.warnings.insert(
+        readGltf.warnings.end(),
+        imageResult.warnings.begin(),
+        imageResult.warnings.end());
+    readGltf.errors.insert(
+        readGltf.errors.end(),
+        imageResult.errors.begin(),
+        imageResult.errors.end());
+    if (imageResult.image) {
+      image.cesium = std::move(imageResult.image.value());
+    } else {
+      if (image.mimeType) {
+        readGltf.errors.emplace_back(
+            "Declared image MIME Type: " + image.mimeType.value());
+      } else {
+        readGltf.errors.emplace_back("Image does not declare a MIME Type");
+      }
+    }
+  }
+
+  // Copy the source property in texture extensions to the main Texture. The
+  // image has already been decoded as necessary, so it's more convenient for
+  // clients to not need to worry about the extension.
+  for (Texture& texture : model.textures) {
+    ExtensionTextureWebp* pWebP = texture.getExtension<ExtensionTextureWebp>();
+    if (pWebP) {
+      texture.source = pWebP->source;
+    }
+
+    ExtensionKhrTextureBasisu* pKtx =
+        texture.getExtension<ExtensionKhrTextureBasisu>();
+    if (pKtx) {
+      texture.source = pKtx->source;
+    }
+  }
+}
+
+// Does the post-processing that comes before decoding, and finds what needs
+// to be decoded.
+PendingDecodes startPostprocess(
     const GltfReader& reader,
     GltfReaderResult& readGltf,
     const GltfReaderOptions& options) {
   Model& model = readGltf.model.value();
 
-  auto extFeatureMetadataIter = std::find(
-      model.extensionsUsed.begin(),
-      model.extensionsUsed.end(),
-      "EXT_feature_metadata");
-
-  if (extFeatureMetadataIter != model.extensionsUsed.end()) {
+  if (hasExtension(model, "EXT_feature_metadata")) {
     readGltf.warnings.emplace_back(
         "glTF contains EXT_feature_metadata extension, which is no longer "
         "supported. The model will still be loaded, but views cannot be "
@@ -267,108 +502,116 @@ void postprocess(
     decodeDataUrls(reader, readGltf, options);
   }
 
+  PendingDecodes decodes;
   if (options.decodeEmbeddedImages) {
     CESIUM_TRACE("CesiumGltfReader::decodeEmbeddedImages");
-    for (Image& image : model.images) {
-      // Ignore external images for now.
-      if (image.uri) {
-        continue;
-      }
+    decodes.images = findEmbeddedImages(readGltf);
+  }
 
-      // Image has already been decoded
-      if (!image.cesium.pixelData.empty()) {
-        continue;
-      }
+  if (options.decodeDraco) {
+    decodes.dracoPrimitives = findDracoPrimitives(readGltf);
+  }
 
-      const BufferView& bufferView =
-          Model::getSafe(model.bufferViews, image.bufferView);
-      const Buffer& buffer = Model::getSafe(model.buffers, bufferView.buffer);
-
-      if (bufferView.byteOffset + bufferView.byteLength >
-          static_cast<int64_t>(buffer.cesium.data.size())) {
-        readGltf.warnings.emplace_back(
-            "Image bufferView's byte offset is " +
-            std::to_string(bufferView.byteOffset) + " and the byteLength is " +
-            std::to_string(bufferView.byteLength) + ", the result is " +
-            std::to_string(bufferView.byteOffset + bufferView.byteLength) +
-            ", which is more than the available " +
-            std::to_string(buffer.cesium.data.size()) + " bytes.");
-        continue;
-      }
+  if (options.decodeMeshOptData &&
+      hasExtension(model, "EXT_meshopt_compression")) {
+    decodes.meshOptBufferViews = findMeshOptBufferViews(readGltf);
+  }
 
-      const gsl::span<const std::byte> bufferSpan(buffer.cesium.data);
-      const gsl::span<const std::byte> bufferViewSpan = bufferSpan.subspan(
-          static_cast<size_t>(bufferView.byteOffset),
-          static_cast<size_t>(bufferView.byteLength));
-      ImageReaderResult imageResult =
-          GltfReader::readImage(bufferViewSpan, options.ktx2TranscodeTargets);
-      readGltf.warnings.insert(
-          readGltf.warnings.end(),
-          imageResult.warnings.begin(),
-          imageResult.warnings.end());
-      readGltf.errors.insert(
-          readGltf.errors.end(),
-          imageResult.errors.begin(),
-          imageResult.errors.end());
-      if (imageResult.image) {
-        image.cesium = std::move(imageResult.image.value());
-      } else {
-        if (image.mimeType) {
-          readGltf.errors.emplace_back(
-              "Declared image MIME Type: " + image.mimeType.value());
-        } else {
-          readGltf.errors.emplace_back("Image does not declare a MIME Type");
-        }
-      }
-    }
+  return decodes;
+}
 
-    // Copy the source property in texture extensions to the main Texture. The
-    // image has already been decoded as necessary, so it's more convenient for
-    // clients to not need to worry about the extension.
-    for (Texture& texture : model.textures) {
-      ExtensionTextureWebp* pWebP =
-          texture.getExtension<ExtensionTextureWebp>();
-      if (pWebP) {
-        texture.source = pWebP->source;
-      }
+// Copies the decoded data into the model, and does the rest of the
+// post-processing.
+void finishPostprocess(
+    GltfReaderResult& readGltf,
+    PendingDecodes& decodes,
+    const GltfReaderOptions& options) {
+  Model& model = readGltf.model.value();
 
-      ExtensionKhrTextureBasisu* pKtx =
-          texture.getExtension<ExtensionKhrTextureBasisu>();
-      if (pKtx) {
-        texture.source = pKtx->source;
-      }
-    }
+  if (options.decodeEmbeddedImages) {
+    applyDecodedImages(readGltf, decodes.images);
   }
 
   if (options.decodeDraco) {
-    decodeDraco(readGltf);
+    applyDecodedDraco(
+        readGltf,
+        decodes.dracoPrimitives,
+        options.interleaveDracoAttributes);
   }
 
   if (options.decodeMeshOptData &&
-      std::find(
-          model.extensionsUsed.begin(),
-          model.extensionsUsed.end(),
-          "EXT_meshopt_compression") != model.extensionsUsed.end()) {
-    decodeMeshOpt(model, readGltf);
+      hasExtension(model, "EXT_meshopt_compression")) {
+    applyDecodedMeshOpt(readGltf, decodes.meshOptBufferViews);
   }
 
   if (options.dequantizeMeshData &&
-      std::find(
-          model.extensionsUsed.begin(),
-          model.extensionsUsed.end(),
-          "KHR_mesh_quantization") != model.extensionsUsed.end()) {
+      hasExtension(model, "KHR_mesh_quantization")) {
     dequantizeMeshData(model);
   }
 
   if (options.applyTextureTransform &&
-      std::find(
-          model.extensionsUsed.begin(),
-          model.extensionsUsed.end(),
-          "KHR_texture_transform") != model.extensionsUsed.end()) {
+      hasExtension(model, "KHR_texture_transform")) {
     applyKhrTextureTransform(model);
   }
 }
 
+void postprocess(
+    const GltfReader& reader,
+    GltfReaderResult& readGltf,
+    const GltfReaderOptions& options) {
+  PendingDecodes decodes = startPostprocess(reader, readGltf, options);
+  for (size_t i = 0; i < decodes.size(); ++i) {
+    decodes.decode(i, options);
+  }
+  finishPostprocess(readGltf, decodes, options);
+}
+
+Future<GltfReaderResult> postprocessInParallel(
+    const AsyncSystem& asyncSystem,
+    const GltfReader& reader,
+    GltfReaderResult&& result,
+    const GltfReaderOptions& options) {
+  struct State {
+    GltfReaderResult result;
+    GltfReaderOptions options;
+    PendingDecodes decodes;
+  };
+
+  // The decodes refer to the buffers of the model, so it must not move until
+  // they're done.
+  auto pState = std::make_shared<State>();
+  pState->result = std::move(result);
+  pState->options = options;
+  pState->decodes = startPostprocess(reader, pState->result, options);
+
+  // A single decode is done right here rather than waiting for another
+  // thread to do it.
+  const size_t decodeCount = pState->decodes.size();
+  if (decodeCount <= 1) {
+    if (decodeCount == 1) {
+      pState->decodes.decode(0, options);
+    }
+    finishPostprocess(pState->result, pState->decodes, options);
+    return asyncSystem.createResolvedFuture(std::move(pState->result));
+  }
+
+  // Each decode resolves to its index only because `all` needs a value.
+  std::vector<Future<size_t>> decoded;
+  decoded.reserve(decodeCount);
+  for (size_t i = 0; i < decodeCount; ++i) {
+    decoded.emplace_back(asyncSystem.runInWorkerThread([pState, i]() {
+      pState->decodes.decode(i, pState->options);
+      return i;
+    }));
+  }
+
+  return asyncSystem.all(std::move(decoded))
+      .thenImmediately([pState](std::vector<size_t>&&) {
+        finishPostprocess(pState->result, pState->decodes, pState->options);
+        return std::move(pState->result);
+      });
+}
+
 } // namespace
 
 GltfReader::GltfReader() : _context() {
@@ -388,8 +631,9 @@ GltfReaderResult GltfReader::readGltf(
     const GltfReaderOptions& options) const {
 
   const CesiumJsonReader::JsonReaderOptions& context = this->getExtensions();
-  GltfReaderResult result = isBinaryGltf(data) ? readBinaryGltf(context, data)
-                                               : readJsonGltf(context, data);
+  GltfReaderResult result = isBinaryGltf(data)
+                                ? readBinaryGltf(context, options, data)
+                                : readJsonGltf(context, options, data);
 
   if (result.model) {
     postprocess(*this, result, options);
@@ -398,6 +642,41 @@ GltfReaderResult GltfReader::readGltf(
   return result;
 }
 
+CesiumAsync::Future<GltfReaderResult> GltfReader::readGltf(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const gsl::span<const std::byte>& data,
+    const GltfReaderOptions& options) const {
+  const CesiumJsonReader::JsonReaderOptions& context = this->getExtensions();
+  GltfReaderResult result = isBinaryGltf(data)
+                                ? readBinaryGltf(context, options, data)
+                                : readJsonGltf(context, options, data);
+
+  return this->postprocessGltf(asyncSystem, std::move(result), options);
+}
+
+GltfReaderResult GltfReader::readGltf(
+    CesiumUtility::ByteVector&& data,
+    const GltfReaderOptions& options) const {
+  GltfReaderResult result =
+      readGltfFromVector(this->getExtensions(), options, std::move(data));
+
+  if (result.model) {
+    postprocess(*this, result, options);
+  }
+
+  return result;
+}
+
+CesiumAsync::Future<GltfReaderResult> GltfReader::readGltf(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    CesiumUtility::ByteVector&& data,
+    const GltfReaderOptions& options) const {
+  GltfReaderResult result =
+      readGltfFromVector(this->getExtensions(), options, std::move(data));
+
+  return this->postprocessGltf(asyncSystem, std::move(result), options);
+}
+
 CesiumAsync::Future<GltfReaderResult> GltfReader::loadGltf(
     const CesiumAsync::AsyncSystem& asyncSystem,
     const std::string& uri,
@@ -432,8 +711,8 @@ CesiumAsync::Future<GltfReaderResult> GltfReader::loadGltf(
                 this->getExtensions();
             GltfReaderResult result =
                 isBinaryGltf(pResponse->data())
-                    ? readBinaryGltf(context, pResponse->data())
-                    : readJsonGltf(context, pResponse->data());
+                    ? readBinaryGltf(context, options, pResponse->data())
+                    : readJsonGltf(context, options, pResponse->data());
 
             if (!result.model) {
               return asyncSystem.createResolvedFuture(std::move(result));
@@ -447,10 +726,13 @@ CesiumAsync::Future<GltfReaderResult> GltfReader::loadGltf(
                 options,
                 std::move(result));
           })
-      .thenInWorkerThread([options, this](GltfReaderResult&& result) {
-        postprocess(*this, result, options);
-        return std::move(result);
-      });
+      .thenInWorkerThread(
+          [options, asyncSystem, this](GltfReaderResult&& result) {
+            return this->postprocessGltf(
+                asyncSystem,
+                std::move(result),
+                options);
+          });
 }
 
 void CesiumGltfReader::GltfReader::postprocessGltf(
@@ -461,6 +743,20 @@ void CesiumGltfReader::GltfReader::postprocessGltf(
   }
 }
 
+CesiumAsync::Future<GltfReaderResult> GltfReader::postprocessGltf(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    GltfReaderResult&& readGltf,
+    const GltfReaderOptions& options) const {
+  if (!readGltf.model) {
+    return asyncSystem.createResolvedFuture(std::move(readGltf));
+  }
+  return postprocessInParallel(
+      asyncSystem,
+      *this,
+      std::move(readGltf),
+      options);
+}
+
 /*static*/ Future<GltfReaderResult> GltfReader::resolveExternalData(
     AsyncSystem asyncSystem,
     const std::string& baseUrl,
@@ -523,7 +819,7 @@ void CesiumGltfReader::GltfReader::postprocessGltf(
 
                     if (pResponse) {
                       pBuffer->uri = std::nullopt;
-                      pBuffer->cesium.data = std::vector<std::byte>(
+                      pBuffer->cesium.data.assign(
                           pResponse->data().begin(),
                           pResponse->data().end());
                       return ExternalBufferLoadResult{true, bufferUri};
@@ -535,13 +831,42 @@ void CesiumGltfReader::GltfReader::postprocessGltf(
   }
 
   for (Image& image : pResult->model->images) {
-    if (image.uri && image.uri->substr(0, dataPrefixLength) != dataPrefix) {
+    if (!image.uri || image.uri->substr(0, dataPrefixLength) == dataPrefix) {
+      continue;
+    }
+
+    if (options.pSharedImageCache) {
+      resolvedBuffers.push_back(
+          options.pSharedImageCache
+              ->getOrLoad(
+                  asyncSystem,
+                  pAssetAccessor,
+                  Uri::resolve(baseUrl, *image.uri),
+                  tHeaders,
+                  options.ktx2TranscodeTargets,
+                  options.maximumTextureSize)
+              .thenInWorkerThread(
+                  // The cache is kept alive until its load finishes.
+                  [pImage = &image, pCache = options.pSharedImageCache](
+                      const std::shared_ptr<const SharedImage>& pShared) {
+                    std::string imageUri = *pImage->uri;
+                    if (!pShared) {
+                      return ExternalBufferLoadResult{false, imageUri};
+                    }
+
+                    pImage->uri = std::nullopt;
+                    pImage->cesium = pShared->image;
+                    pImage->extras[SharedImageCache::ExtrasKey] = pShared->key;
+                    return ExternalBufferLoadResult{true, imageUri};
+                  }));
+    } else {
       resolvedBuffers.push_back(
           pAssetAccessor
               ->get(asyncSystem, Uri::resolve(baseUrl, *image.uri), tHeaders)
               .thenInWorkerThread(
                   [pImage = &image,
-                   ktx2TranscodeTargets = options.ktx2TranscodeTargets](
+                   ktx2TranscodeTargets = options.ktx2TranscodeTargets,
+                   maximumTextureSize = options.maximumTextureSize](
                       std::shared_ptr<IAssetRequest>&& pRequest) {
                     const IAssetResponse* pResponse = pRequest->response();
 
@@ -550,8 +875,10 @@ void CesiumGltfReader::GltfReader::postprocessGltf(
                     if (pResponse) {
                       pImage->uri = std::nullopt;
 
-                      ImageReaderResult imageResult =
-                          readImage(pResponse->data(), ktx2TranscodeTargets);
+                      ImageReaderResult imageResult = readImage(
+                          pResponse->data(),
+                          ktx2TranscodeTargets,
+                          maximumTextureSize);
                       if (imageResult.image) {
                         pImage->cesium = std::move(*imageResult.image);
                         return ExternalBufferLoadResult{true, imageUri};
@@ -599,11 +926,168 @@ bool isWebP(const gsl::span<const std::byte>& data) {
   return magic1 == 0x46464952 && magic2 == 0x50424557;
 }
 
-/*static*/
-ImageReaderResult GltfReader::readImage(
+namespace {
+// Finds the largest of the scales libjpeg-turbo can decode at, no larger than
+// the original size, that brings both dimensions down to the maximum. If none
+// does, the smallest scale is used.
+tjscalingfactor chooseJpegScalingFactor(
+    int32_t width,
+    int32_t height,
+    int32_t maximumDimension) {
+  const tjscalingfactor unscaled{1, 1};
+  if (maximumDimension <= 0 ||
+      (width <= maximumDimension && height <= maximumDimension)) {
+    return unscaled;
+  }
+
+  int numScalingFactors = 0;
+  const tjscalingfactor* pScalingFactors =
+      tjGetScalingFactors(&numScalingFactors);
+  if (!pScalingFactors) {
+    return unscaled;
+  }
+
+  std::optional<tjscalingfactor> best;
+  std::optional<tjscalingfactor> smallest;
+  for (int i = 0; i < numScalingFactors; ++i) {
+    const tjscalingfactor& factor = pScalingFactors[i];
+    if (factor.num > factor.denom) {
+      continue;
+    }
+    const double scale = double(factor.num) / double(factor.denom);
+    if (!smallest ||
+        scale < double(smallest->num) / double(smallest->denom)) {
+      smallest = factor;
+    }
+    if (TJSCALED(width, factor) <= maximumDimension &&
+        TJSCALED(height, factor) <= maximumDimension &&
+        (!best || scale > double(best->num) / double(best->denom))) {
+      best = factor;
+    }
+  }
+
+  return best.value_or(smallest.value_or(unscaled));
+}
+
+// Halves the width and height of uncompressed pixels with one byte per
+// channel by averaging each 2x2 block of pixels. A dimension of 1 stays 1,
+// and the last row or column of an odd dimension is dropped, as GPUs do when
+// they generate mipmaps.
+void halvePixels(
+    const std::byte* pSource,
+    int32_t sourceWidth,
+    int32_t sourceHeight,
+    int32_t channels,
+    std::byte* pTarget) {
+  const int32_t width = std::max(sourceWidth / 2, 1);
+  const int32_t height = std::max(sourceHeight / 2, 1);
+  const size_t pixelSize = static_cast<size_t>(channels);
+  const size_t rowSize = static_cast<size_t>(sourceWidth) * pixelSize;
+  const size_t columnStep = sourceWidth > 1 ? pixelSize : 0;
+  const size_t rowStep = sourceHeight > 1 ? rowSize : 0;
+
+  const uint8_t* pIn = reinterpret_cast<const uint8_t*>(pSource);
+  uint8_t* pOut = reinterpret_cast<uint8_t*>(pTarget);
+  for (int32_t y = 0; y < height; ++y) {
+    const uint8_t* pRow0 = pIn + static_cast<size_t>(2 * y) * rowStep;
+    const uint8_t* pRow1 = pRow0 + rowStep;
+    for (int32_t x = 0; x < width; ++x) {
+      const size_t blockOffset = static_cast<size_t>(2 * x) * columnStep;
+      const uint8_t* p0 = pRow0 + blockOffset;
+      const uint8_t* p1 = pRow1 + blockOffset;
+      for (size_t c = 0; c < pixelSize; ++c) {
+        const uint32_t sum = uint32_t(p0[c]) + p0[c + columnStep] + p1[c] +
+                             p1[c + columnStep];
+        *pOut++ = static_cast<uint8_t>((sum + 2) / 4);
+      }
+    }
+  }
+}
+
+void halveImage(ImageCesium& image) {
+  CESIUM_TRACE("CesiumGltfReader::halveImage");
+  const int32_t width = std::max(image.width / 2, 1);
+  const int32_t height = std::max(image.height / 2, 1);
+  CesiumUtility::ByteVector pixelData(
+      static_cast<size_t>(width) * static_cast<size_t>(height) *
+          static_cast<size_t>(image.channels),
+      image.pixelData.get_allocator());
+  halvePixels(
+      image.pixelData.data(),
+      image.width,
+      image.height,
+      image.channels,
+      pixelData.data());
+
+  image.width = width;
+  image.height = height;
+  image.pixelData = std::move(pixelData);
+}
+
+// Removes the mip levels of an image that are larger than the maximum size,
+// and makes the largest remaining one the image.
+void skipMipLevels(ImageCesium& image, int32_t maximumTextureSize) {
+  size_t level = 0;
+  while (level + 1 < image.mipPositions.size() &&
+         (std::max(image.width >> level, 1) > maximumTextureSize ||
+          std::max(image.height >> level, 1) > maximumTextureSize)) {
+    ++level;
+  }
+  if (level == 0) {
+    return;
+  }
+
+  CesiumUtility::ByteVector pixelData(image.pixelData.get_allocator());
+  std::vector<ImageCesiumMipPosition> mipPositions;
+  for (size_t i = level; i < image.mipPositions.size(); ++i) {
+    const ImageCesiumMipPosition& position = image.mipPositions[i];
+    mipPositions.push_back({pixelData.size(), position.byteSize});
+    const auto begin = image.pixelData.begin() +
+                       static_cast<std::ptrdiff_t>(position.byteOffset);
+    pixelData.insert(
+        pixelData.end(),
+        begin,
+        begin + static_cast<std::ptrdiff_t>(position.byteSize));
+  }
+
+  image.width = std::max(image.width >> level, 1);
+  image.height = std::max(image.height >> level, 1);
+  image.pixelData = std::move(pixelData);
+  image.mipPositions = std::move(mipPositions);
+}
+
+// Reduces an image that is larger than the maximum size, if its format
+// allows.
+void fitImage(ImageCesium& image, int32_t maximumTextureSize) {
+  if (maximumTextureSize <= 0 || (image.width <= maximumTextureSize &&
+                                  image.height <= maximumTextureSize)) {
+    return;
+  }
+
+  if (image.mipPositions.size() > 1) {
+    skipMipLevels(image, maximumTextureSize);
+    return;
+  }
+
+  if (image.compressedPixelFormat != GpuCompressedPixelFormat::NONE ||
+      image.bytesPerChannel != 1 || image.pixelData.empty()) {
+    return;
+  }
+
+  while (image.width > maximumTextureSize ||
+         image.height > maximumTextureSize) {
+    halveImage(image);
+  }
+
+  if (!image.mipPositions.empty()) {
+    image.mipPositions = {{0, image.pixelData.size()}};
+  }
+}
+
+ImageReaderResult decodeImage(
     const gsl::span<const std::byte>& data,
-    const Ktx2TranscodeTargets& ktx2TranscodeTargets) {
-  CESIUM_TRACE("CesiumGltfReader::readImage");
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets,
+    int32_t maximumTextureSize) {
 
   ImageReaderResult result;
 
@@ -611,12 +1095,19 @@ ImageReaderResult GltfReader::readImage(
   ImageCesium& image = result.image.value();
 
   if (isKtx(data)) {
+    // Transcoding is expensive, so levels that would be skipped afterward
+    // are removed before it.
+    const std::optional<std::vector<std::byte>> reducedKtx =
+        skipKtx2MipLevels(data, maximumTextureSize);
+    const gsl::span<const std::byte> ktxData =
+        reducedKtx ? gsl::span<const std::byte>(*reducedKtx) : data;
+
     ktxTexture2* pTexture = nullptr;
     KTX_error_code errorCode;
 
     errorCode = ktxTexture2_CreateFromMemory(
-        reinterpret_cast<const std::uint8_t*>(data.data()),
-        data.size(),
+        reinterpret_cast<const std::uint8_t*>(ktxData.data()),
+        ktxData.size(),
         KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT,
         &pTexture);
 
@@ -840,6 +1331,16 @@ ImageReaderResult GltfReader::readImage(
       CESIUM_TRACE("Decode JPG");
       image.bytesPerChannel = 1;
       image.channels = 4;
+
+      // Downscaling is done as part of the inverse DCT, which is much faster
+      // than decoding the whole image and resizing it.
+      const tjscalingfactor scalingFactor = chooseJpegScalingFactor(
+          image.width,
+          image.height,
+          maximumTextureSize);
+      image.width = TJSCALED(image.width, scalingFactor);
+      image.height = TJSCALED(image.height, scalingFactor);
+
       const auto lastByte =
           image.width * image.height * image.channels * image.bytesPerChannel;
       image.pixelData.resize(static_cast<std::size_t>(lastByte));
@@ -894,6 +1395,23 @@ ImageReaderResult GltfReader::readImage(
   return result;
 }
 
+} // namespace
+
+/*static*/
+ImageReaderResult GltfReader::readImage(
+    const gsl::span<const std::byte>& data,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets,
+    int32_t maximumTextureSize) {
+  CESIUM_TRACE("CesiumGltfReader::readImage");
+
+  ImageReaderResult result =
+      decodeImage(data, ktx2TranscodeTargets, maximumTextureSize);
+  if (result.image) {
+    fitImage(*result.image, maximumTextureSize);
+  }
+  return result;
+}
+
 /*static*/
 std::optional<std::string> GltfReader::generateMipMaps(ImageCesium& image) {
   if (!image.mipPositions.empty() ||
@@ -967,17 +1485,27 @@ std::optional<std::string> GltfReader::generateMipMaps(ImageCesium& image) {
     image.mipPositions[mipIndex].byteOffset = byteOffset;
     image.mipPositions[mipIndex].byteSize = byteSize;
 
-    if (!stbir_resize_uint8(
-            reinterpret_cast<const unsigned char*>(
-                &image.pixelData[lastByteOffset]),
-            lastWidth,
-            lastHeight,
-            0,
-            reinterpret_cast<unsigned char*>(&image.pixelData[byteOffset]),
-            mipWidth,
-            mipHeight,
-            0,
-            image.channels)) {
+    if (image.bytesPerChannel == 1) {
+      // Each level is a straight 2x2 average of the one before it, like
+      // mipmaps generated on a GPU, which is much cheaper than resampling.
+      halvePixels(
+          &image.pixelData[lastByteOffset],
+          lastWidth,
+          lastHeight,
+          image.channels,
+          &image.pixelData[byteOffset]);
+    } else if (!stbir_resize_uint8(
+                   reinterpret_cast<const unsigned char*>(
+                       &image.pixelData[lastByteOffset]),
+                   lastWidth,
+                   lastHeight,
+                   0,
+                   reinterpret_cast<unsigned char*>(
+                       &image.pixelData[byteOffset]),
+                   mipWidth,
+                   mipHeight,
+                   0,
+                   image.channels)) {
       // Remove any added mipmaps.
       image.mipPositions.clear();
       image.pixelData.resize(imageByteSize);
@@ -987,3 +1515,99 @@ std::optional<std::string> GltfReader::generateMipMaps(ImageCesium& image) {
 
   return std::nullopt;
 }
+
+GlbStreamReader::GlbStreamReader(
+    const GltfReader& reader,
+    const GltfReaderOptions& options)
+    : _pReader(&reader),
+      _options(options),
+      _data(),
+      _length(0),
+      _jsonEnd(0),
+      _jsonRead(false),
+      _failed(false),
+      _jsonResult() {}
+
+void GlbStreamReader::append(const gsl::span<const std::byte>& data) {
+  if (this->_failed) {
+    return;
+  }
+
+  this->_data.insert(this->_data.end(), data.begin(), data.end());
+  if (this->_jsonRead || this->_data.size() < glbJsonStart) {
+    return;
+  }
+
+  const gsl::span<const std::byte> received(this->_data);
+
+  if (this->_length == 0) {
+    std::optional<std::string> headerError = checkGlbHeaders(received);
+    if (!headerError) {
+      this->_length =
+          reinterpret_cast<const GlbHeader*>(received.data())->length;
+      this->_jsonEnd = getGlbJsonEnd(received);
+      if (this->_jsonEnd > this->_length) {
+        headerError =
+            "GLB JSON chunk extends past the end of the GLB, JSON end at " +
+            std::to_string(this->_jsonEnd) + ", GLB size " +
+            std::to_string(this->_length);
+      }
+    }
+
+    if (headerError) {
+      this->_failed = true;
+      this->_jsonRead = true;
+      this->_jsonResult =
+          GltfReaderResult{std::nullopt, {std::move(*headerError)}, {}};
+      return;
+    }
+  }
+
+  if (received.size() < this->_jsonEnd) {
+    return;
+  }
+
+  this->_jsonResult = readJsonGltf(
+      this->_pReader->getExtensions(),
+      this->_options,
+      received.subspan(glbJsonStart, this->_jsonEnd - glbJsonStart));
+  this->_jsonRead = true;
+}
+
+bool GlbStreamReader::isComplete() const noexcept {
+  return this->_failed ||
+         (this->_jsonRead && this->_data.size() >= this->_length);
+}
+
+std::optional<GltfReaderResult> GlbStreamReader::takeJsonResult() {
+  std::optional<GltfReaderResult> result = std::move(this->_jsonResult);
+  this->_jsonResult.reset();
+  return result;
+}
+
+void GlbStreamReader::readBinaryChunk(GltfReaderResult& result) const {
+  if (!result.model || this->_failed) {
+    return;
+  }
+
+  if (!this->isComplete()) {
+    result.model.reset();
+    result.errors.emplace_back(
+        "GLB is not complete, received " + std::to_string(this->_data.size()) +
+        " bytes of " + std::to_string(this->_length));
+    return;
+  }
+
+  const gsl::span<const std::byte> glbData =
+      gsl::span<const std::byte>(this->_data).subspan(0, this->_length);
+  gsl::span<const std::byte> binaryChunk;
+  std::optional<std::string> binaryChunkError =
+      findBinaryChunk(glbData, this->_jsonEnd, binaryChunk);
+  if (binaryChunkError) {
+    result.model.reset();
+    result.errors.emplace_back(std::move(*binaryChunkError));
+    return;
+  }
+
+  addBinaryChunk(result, binaryChunk);
+}
@@ -0,0 +1,211 @@
+#include "CesiumGltfReader/SharedImageCache.h"
+
+#include "CesiumGltfReader/GltfReader.h"
+
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/Promise.h>
+
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+using namespace CesiumAsync;
+using namespace CesiumGltf;
+
+namespace CesiumGltfReader {
+namespace {
+uint64_t hashBytes(const gsl::span<const std::byte>& data) {
+  // 64-bit FNV-1a.
+  uint64_t hash = 14695981039346656037ULL;
+  for (const std::byte byte : data) {
+    hash ^= static_cast<uint64_t>(byte);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+std::string getOptionsKey(
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets,
+    int32_t maximumTextureSize) {
+  std::string key;
+  for (const GpuCompressedPixelFormat format :
+       {ktx2TranscodeTargets.ETC1S_R,
+        ktx2TranscodeTargets.ETC1S_RG,
+        ktx2TranscodeTargets.ETC1S_RGB,
+        ktx2TranscodeTargets.ETC1S_RGBA,
+        ktx2TranscodeTargets.UASTC_R,
+        ktx2TranscodeTargets.UASTC_RG,
+        ktx2TranscodeTargets.UASTC_RGB,
+        ktx2TranscodeTargets.UASTC_RGBA}) {
+    key += std::to_string(static_cast<int32_t>(format)) + ",";
+  }
+  key += std::to_string(maximumTextureSize) + ":";
+  return key;
+}
+} // namespace
+
+SharedImageCache::SharedImageCache(int64_t maximumBytes)
+    : _maximumBytes(maximumBytes), _totalBytes(0) {}
+
+SharedFuture<std::shared_ptr<const SharedImage>> SharedImageCache::getOrLoad(
+    const AsyncSystem& asyncSystem,
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets,
+    int32_t maximumTextureSize) {
+  std::string optionsKey =
+      getOptionsKey(ktx2TranscodeTargets, maximumTextureSize);
+  std::string urlKey = optionsKey + url;
+
+  Promise<std::shared_ptr<const SharedImage>> promise =
+      asyncSystem.createPromise<std::shared_ptr<const SharedImage>>();
+  ImageFuture future = promise.getFuture().share();
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_entriesByUrl.find(urlKey);
+    if (it != this->_entriesByUrl.end()) {
+      this->_entries.splice(this->_entries.begin(), this->_entries, it->second);
+      return it->second->future;
+    }
+
+    this->_entries.emplace_front(Entry{urlKey, future, false, 0, {}});
+    this->_entriesByUrl.emplace(urlKey, this->_entries.begin());
+  }
+
+  // The entry is added before the image is requested, so that the request
+  // can't finish before there is an entry to finish.
+  pAssetAccessor->get(asyncSystem, url, headers)
+      .thenInWorkerThread(
+          [this,
+           optionsKey = std::move(optionsKey),
+           ktx2TranscodeTargets,
+           maximumTextureSize](std::shared_ptr<IAssetRequest>&& pRequest) {
+            const IAssetResponse* pResponse = pRequest->response();
+            if (!pResponse) {
+              return std::shared_ptr<const SharedImage>();
+            }
+            const uint16_t statusCode = pResponse->statusCode();
+            if (statusCode != 0 && (statusCode < 200 || statusCode >= 300)) {
+              return std::shared_ptr<const SharedImage>();
+            }
+            return this->findOrDecode(
+                optionsKey,
+                pResponse->data(),
+                ktx2TranscodeTargets,
+                maximumTextureSize);
+          })
+      .thenImmediately(
+          [this, urlKey, promise](std::shared_ptr<const SharedImage>&& pImage) {
+            this->finishLoad(urlKey, pImage);
+            promise.resolve(std::move(pImage));
+          })
+      .catchImmediately([this, urlKey, promise](std::exception&&) {
+        this->finishLoad(urlKey, nullptr);
+        promise.resolve(nullptr);
+      });
+
+  return future;
+}
+
+size_t SharedImageCache::size() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_entries.size();
+}
+
+int64_t SharedImageCache::getTotalBytes() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_totalBytes;
+}
+
+std::shared_ptr<const SharedImage> SharedImageCache::findOrDecode(
+    const std::string& optionsKey,
+    const gsl::span<const std::byte>& data,
+    const Ktx2TranscodeTargets& ktx2TranscodeTargets,
+    int32_t maximumTextureSize) {
+  const std::string key = optionsKey + std::to_string(data.size()) + ":" +
+                          std::to_string(hashBytes(data));
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto it = this->_imagesByKey.find(key);
+    if (it != this->_imagesByKey.end()) {
+      std::shared_ptr<const SharedImage> pExisting = it->second.lock();
+      if (pExisting) {
+        return pExisting;
+      }
+      this->_imagesByKey.erase(it);
+    }
+  }
+
+  // Decode without the lock, so that other images can be decoded at the same
+  // time. If the same content is decoded twice at once, the first one wins.
+  ImageReaderResult result =
+      GltfReader::readImage(data, ktx2TranscodeTargets, maximumTextureSize);
+  if (!result.image) {
+    return nullptr;
+  }
+
+  std::shared_ptr<const SharedImage> pImage =
+      std::make_shared<const SharedImage>(
+          SharedImage{key, std::move(*result.image)});
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  auto [it, inserted] = this->_imagesByKey.try_emplace(key, pImage);
+  if (!inserted) {
+    std::shared_ptr<const SharedImage> pExisting = it->second.lock();
+    if (pExisting) {
+      return pExisting;
+    }
+    it->second = pImage;
+  }
+  return pImage;
+}
+
+void SharedImageCache::finishLoad(
+    const std::string& urlKey,
+    const std::shared_ptr<const SharedImage>& pImage) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  auto it = this->_entriesByUrl.find(urlKey);
+  if (it == this->_entriesByUrl.end()) {
+    return;
+  }
+
+  // Failed loads are forgotten, so that a later request tries again.
+  if (!pImage) {
+    this->_entries.erase(it->second);
+    this->_entriesByUrl.erase(it);
+    return;
+  }
+
+  Entry& entry = *it->second;
+  entry.isLoaded = true;
+  entry.sizeBytes = static_cast<int64_t>(pImage->image.pixelData.size());
+  entry.imageKey = pImage->key;
+  this->_totalBytes += entry.sizeBytes;
+  this->evictEntries();
+}
+
+void SharedImageCache::evictEntries() {
+  auto it = this->_entries.end();
+  while (this->_totalBytes > this->_maximumBytes &&
+         it != this->_entries.begin()) {
+    --it;
+    if (!it->isLoaded) {
+      continue;
+    }
+
+    const std::string imageKey = std::move(it->imageKey);
+    this->_totalBytes -= it->sizeBytes;
+    this->_entriesByUrl.erase(it->urlKey);
+    it = this->_entries.erase(it);
+
+    // Another URL with the same content may still hold the image.
+    auto imageIt = this->_imagesByKey.find(imageKey);
+    if (imageIt != this->_imagesByKey.end() && imageIt->second.expired()) {
+      this->_imagesByKey.erase(imageIt);
+    }
+  }
+}
+
+} // namespace CesiumGltfReader
@@ -11,7 +11,7 @@ namespace CesiumGltfReader {
 namespace {
 bool transformBufferView(
     const AccessorView<glm::vec2>& accessorView,
-    std::vector<std::byte>& data,
+    CesiumUtility::ByteVector& data,
     const ExtensionKhrTextureTransform& textureTransformExtension) {
   KhrTextureTransform textureTransform(textureTransformExtension);
   if (textureTransform.status() != KhrTextureTransformStatus::Valid) {
@@ -70,7 +70,9 @@ void processTextureInfo(
     return;
   }
 
-  std::vector<std::byte> data(static_cast<size_t>(pBufferView->byteLength));
+  CesiumUtility::ByteVector data(
+      static_cast<size_t>(pBufferView->byteLength),
+      CesiumUtility::AllocationCategory::GltfBuffer);
   bool success = transformBufferView(accessorView, data, *pTextureTransform);
   if (!success) {
     return;
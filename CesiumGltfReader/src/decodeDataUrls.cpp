@@ -3,83 +3,97 @@
 #include "CesiumGltfReader/GltfReader.h"
 
 #include <CesiumGltf/Model.h>
+#include <CesiumUtility/Allocator.h>
 #include <CesiumUtility/Tracing.h>
 
 #include <modp_b64.h>
 
 #include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
 
 namespace CesiumGltfReader {
 
 namespace {
 
-std::vector<std::byte> decodeBase64(gsl::span<const std::byte> data) {
+// Decodes base64 into a buffer of exactly the decoded size, or returns
+// std::nullopt if it isn't valid base64.
+std::optional<CesiumUtility::ByteVector>
+decodeBase64(std::string_view encoded) {
   CESIUM_TRACE("CesiumGltfReader::decodeBase64");
-  std::vector<std::byte> result(modp_b64_decode_len(data.size()));
-
-  const size_t resultLength = modp_b64_decode(
-      reinterpret_cast<char*>(result.data()),
-      reinterpret_cast<const char*>(data.data()),
-      data.size());
-  if (resultLength == size_t(-1)) {
-    result.clear();
-    result.shrink_to_fit();
-  } else {
-    result.resize(resultLength);
+  if (encoded.size() % 4 != 0) {
+    return std::nullopt;
   }
 
+  size_t decodedLength = encoded.size() / 4 * 3;
+  if (!encoded.empty() && encoded.back() == '=') {
+    --decodedLength;
+    if (encoded[encoded.size() - 2] == '=') {
+      --decodedLength;
+    }
+  }
+
+  std::optional<CesiumUtility::ByteVector> result(
+      std::in_place,
+      decodedLength,
+      CesiumUtility::AllocationCategory::GltfBuffer);
+  const size_t length = modp_b64_decode(
+      reinterpret_cast<char*>(result->data()),
+      encoded.data(),
+      encoded.size());
+  if (length != decodedLength) {
+    result.reset();
+  }
   return result;
 }
 
 struct DecodeResult {
   std::string mimeType;
-  std::vector<std::byte> data;
+  CesiumUtility::ByteVector data{CesiumUtility::AllocationCategory::GltfBuffer};
 };
 
-std::optional<DecodeResult> tryDecode(const std::string& uri) {
+std::optional<DecodeResult> tryDecode(std::string_view uri) {
   constexpr std::string_view dataPrefix = "data:";
-  constexpr size_t dataPrefixLength = dataPrefix.size();
-
   constexpr std::string_view base64Indicator = ";base64";
-  constexpr size_t base64IndicatorLength = base64Indicator.size();
 
-  if (uri.substr(0, dataPrefixLength) != dataPrefix) {
+  if (uri.substr(0, dataPrefix.size()) != dataPrefix) {
     return std::nullopt;
   }
 
-  const size_t dataDelimeter = uri.find(',', dataPrefixLength);
-  if (dataDelimeter == std::string::npos) {
+  const size_t dataDelimeter = uri.find(',', dataPrefix.size());
+  if (dataDelimeter == std::string_view::npos) {
     return std::nullopt;
   }
 
-  bool isBase64Encoded = false;
-
-  DecodeResult result;
-
-  result.mimeType =
-      uri.substr(dataPrefixLength, dataDelimeter - dataPrefixLength);
-  if (result.mimeType.size() >= base64IndicatorLength &&
-      result.mimeType.substr(
-          result.mimeType.size() - base64IndicatorLength,
-          base64IndicatorLength) == base64Indicator) {
-    isBase64Encoded = true;
-    result.mimeType = result.mimeType.substr(
-        0,
-        result.mimeType.size() - base64IndicatorLength);
+  std::string_view mimeType =
+      uri.substr(dataPrefix.size(), dataDelimeter - dataPrefix.size());
+  const bool isBase64Encoded =
+      mimeType.size() >= base64Indicator.size() &&
+      mimeType.substr(mimeType.size() - base64Indicator.size()) ==
+          base64Indicator;
+  if (isBase64Encoded) {
+    mimeType.remove_suffix(base64Indicator.size());
   }
 
-  const gsl::span<const std::byte> data(
-      reinterpret_cast<const std::byte*>(uri.data()) + dataDelimeter + 1,
-      uri.size() - dataDelimeter - 1);
+  // The data is viewed in place, rather than copied out of the URL, so that
+  // only the decoded bytes are allocated.
+  const std::string_view data = uri.substr(dataDelimeter + 1);
+
+  DecodeResult result;
+  result.mimeType = mimeType;
 
   if (isBase64Encoded) {
-    result.data = decodeBase64(data);
-    if (result.data.empty() && !data.empty()) {
-      // base64 decode failed.
+    std::optional<CesiumUtility::ByteVector> decoded = decodeBase64(data);
+    if (!decoded) {
       return std::nullopt;
     }
+    result.data = std::move(*decoded);
   } else {
-    result.data = std::vector<std::byte>(data.begin(), data.end());
+    const gsl::span<const std::byte> bytes(
+        reinterpret_cast<const std::byte*>(data.data()),
+        data.size());
+    result.data.assign(bytes.begin(), bytes.end());
   }
 
   return result;
@@ -134,8 +148,10 @@ void decodeDataUrls(
       continue;
     }
 
-    ImageReaderResult imageResult =
-        reader.readImage(decoded.value().data, options.ktx2TranscodeTargets);
+    ImageReaderResult imageResult = reader.readImage(
+        decoded.value().data,
+        options.ktx2TranscodeTargets,
+        options.maximumTextureSize);
 
     if (!imageResult.image) {
       continue;
@@ -4,10 +4,13 @@
 
 #include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
 #include <CesiumGltf/Model.h>
+#include <CesiumUtility/Allocator.h>
 #include <CesiumUtility/Tracing.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -24,61 +27,6 @@
 namespace CesiumGltfReader {
 
 namespace {
-std::unique_ptr<draco::Mesh> decodeBufferViewToDracoMesh(
-    GltfReaderResult& readGltf,
-    CesiumGltf::MeshPrimitive& /* primitive */,
-    const CesiumGltf::ExtensionKhrDracoMeshCompression& draco) {
-  CESIUM_TRACE("CesiumGltfReader::decodeBufferViewToDracoMesh");
-  CesiumGltf::Model& model = readGltf.model.value();
-
-  CesiumGltf::BufferView* pBufferView =
-      CesiumGltf::Model::getSafe(&model.bufferViews, draco.bufferView);
-  if (!pBufferView) {
-    readGltf.warnings.emplace_back("Draco bufferView index is invalid.");
-    return nullptr;
-  }
-
-  const CesiumGltf::BufferView& bufferView = *pBufferView;
-
-  CesiumGltf::Buffer* pBuffer =
-      CesiumGltf::Model::getSafe(&model.buffers, bufferView.buffer);
-  if (!pBuffer) {
-    readGltf.warnings.emplace_back(
-        "Draco bufferView has an invalid buffer index.");
-    return nullptr;
-  }
-
-  CesiumGltf::Buffer& buffer = *pBuffer;
-
-  if (bufferView.byteOffset < 0 || bufferView.byteLength < 0 ||
-      bufferView.byteOffset + bufferView.byteLength >
-          static_cast<int64_t>(buffer.cesium.data.size())) {
-    readGltf.warnings.emplace_back(
-        "Draco bufferView extends beyond its buffer.");
-    return nullptr;
-  }
-
-  const gsl::span<const std::byte> data(
-      buffer.cesium.data.data() + bufferView.byteOffset,
-      static_cast<uint64_t>(bufferView.byteLength));
-
-  draco::DecoderBuffer decodeBuffer;
-  decodeBuffer.Init(reinterpret_cast<const char*>(data.data()), data.size());
-
-  draco::Decoder decoder;
-  draco::Mesh mesh;
-  draco::StatusOr<std::unique_ptr<draco::Mesh>> result =
-      decoder.DecodeMeshFromBuffer(&decodeBuffer);
-  if (!result.ok()) {
-    readGltf.warnings.emplace_back(
-        std::string("Draco decoding failed: ") +
-        result.status().error_msg_string());
-    return nullptr;
-  }
-
-  return std::move(result).value();
-}
-
 template <typename TSource, typename TDestination>
 void copyData(
     const TSource* pSource,
@@ -94,22 +42,25 @@ void copyData(const T* pSource, T* pDestination, int64_t length) {
   std::copy(pSource, pSource + length, pDestination);
 }
 
-void copyDecodedIndices(
+int64_t alignTo4(int64_t value) { return (value + 3) & ~int64_t(3); }
+
+// Checks the indices accessor of a primitive against the decoded mesh and
+// fixes its count and component type to fit the decoded indices.
+CesiumGltf::Accessor* prepareIndicesAccessor(
     GltfReaderResult& readGltf,
     const CesiumGltf::MeshPrimitive& primitive,
-    draco::Mesh* pMesh) {
-  CESIUM_TRACE("CesiumGltfReader::copyDecodedIndices");
+    const draco::Mesh* pMesh) {
   CesiumGltf::Model& model = readGltf.model.value();
 
   if (primitive.indices < 0) {
-    return;
+    return nullptr;
   }
 
   CesiumGltf::Accessor* pIndicesAccessor =
       CesiumGltf::Model::getSafe(&model.accessors, primitive.indices);
   if (!pIndicesAccessor) {
     readGltf.warnings.emplace_back("Primitive indices accessor ID is invalid.");
-    return;
+    return nullptr;
   }
 
   if (pIndicesAccessor->count != pMesh->num_faces() * 3) {
@@ -136,154 +87,176 @@ void copyDecodedIndices(
     pIndicesAccessor->componentType = supposedComponentType;
   }
 
-  pIndicesAccessor->bufferView = static_cast<int32_t>(model.bufferViews.size());
-  CesiumGltf::BufferView& indicesBufferView = model.bufferViews.emplace_back();
-
-  indicesBufferView.buffer = static_cast<int32_t>(model.buffers.size());
-  CesiumGltf::Buffer& indicesBuffer = model.buffers.emplace_back();
-
-  int64_t indexBytes = pIndicesAccessor->computeByteSizeOfComponent();
-  const int64_t indicesBytes = pIndicesAccessor->count * indexBytes;
-
-  indicesBuffer.cesium.data.resize(static_cast<size_t>(indicesBytes));
-  indicesBuffer.byteLength = indicesBytes;
-  indicesBufferView.byteLength = indicesBytes;
-  indicesBufferView.byteOffset = 0;
-  indicesBufferView.target =
-      CesiumGltf::BufferView::Target::ELEMENT_ARRAY_BUFFER;
   pIndicesAccessor->type = CesiumGltf::Accessor::Type::SCALAR;
   pIndicesAccessor->byteOffset = 0;
+  return pIndicesAccessor;
+}
+
+void copyDecodedIndices(
+    const CesiumGltf::Accessor& indicesAccessor,
+    const draco::Mesh* pMesh,
+    std::byte* pOut) {
+  CESIUM_TRACE("CesiumGltfReader::copyDecodedIndices");
 
   static_assert(sizeof(draco::PointIndex) == sizeof(uint32_t));
 
   const uint32_t* pSourceIndices =
       reinterpret_cast<const uint32_t*>(&pMesh->face(draco::FaceIndex(0))[0]);
 
-  switch (pIndicesAccessor->componentType) {
+  switch (indicesAccessor.componentType) {
   case CesiumGltf::Accessor::ComponentType::BYTE:
     copyData(
         pSourceIndices,
-        reinterpret_cast<int8_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
+        reinterpret_cast<int8_t*>(pOut),
+        indicesAccessor.count);
     break;
   case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
     copyData(
         pSourceIndices,
-        reinterpret_cast<uint8_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
+        reinterpret_cast<uint8_t*>(pOut),
+        indicesAccessor.count);
     break;
   case CesiumGltf::Accessor::ComponentType::SHORT:
     copyData(
         pSourceIndices,
-        reinterpret_cast<int16_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
+        reinterpret_cast<int16_t*>(pOut),
+        indicesAccessor.count);
     break;
   case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
     copyData(
         pSourceIndices,
-        reinterpret_cast<uint16_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
+        reinterpret_cast<uint16_t*>(pOut),
+        indicesAccessor.count);
     break;
   case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
     copyData(
         pSourceIndices,
-        reinterpret_cast<uint32_t*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
+        reinterpret_cast<uint32_t*>(pOut),
+        indicesAccessor.count);
     break;
   case CesiumGltf::Accessor::ComponentType::FLOAT:
     copyData(
         pSourceIndices,
-        reinterpret_cast<float*>(indicesBuffer.cesium.data.data()),
-        pIndicesAccessor->count);
+        reinterpret_cast<float*>(pOut),
+        indicesAccessor.count);
     break;
   }
 }
 
-void copyDecodedAttribute(
-    GltfReaderResult& readGltf,
-    CesiumGltf::MeshPrimitive& /* primitive */,
-    CesiumGltf::Accessor* pAccessor,
+template <typename T>
+void copyAttributeValues(
     const draco::Mesh* pMesh,
-    const draco::PointAttribute* pAttribute) {
-  CESIUM_TRACE("CesiumGltfReader::copyDecodedAttribute");
-  CesiumGltf::Model& model = readGltf.model.value();
-
-  if (pAccessor->count != pMesh->num_points()) {
-    readGltf.warnings.emplace_back("Attribute accessor.count doesn't match "
-                                   "with number of decoded Draco vertices.");
-
-    pAccessor->count = pMesh->num_points();
+    const draco::PointAttribute* pAttribute,
+    int8_t numberOfComponents,
+    std::byte* pOut,
+    int64_t stride) {
+  for (draco::PointIndex i(0); i < pMesh->num_points(); ++i) {
+    const draco::AttributeValueIndex valueIndex = pAttribute->mapped_index(i);
+    pAttribute->ConvertValue(
+        valueIndex,
+        numberOfComponents,
+        reinterpret_cast<T*>(pOut));
+    pOut += stride;
   }
+}
 
-  pAccessor->bufferView = static_cast<int32_t>(model.bufferViews.size());
-  CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
-
-  bufferView.buffer = static_cast<int32_t>(model.buffers.size());
-  CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
-
-  const int8_t numberOfComponents = pAccessor->computeNumberOfComponents();
-  const int64_t stride =
-      numberOfComponents * pAccessor->computeByteSizeOfComponent();
-  const int64_t sizeBytes = pAccessor->count * stride;
-
-  buffer.cesium.data.resize(static_cast<size_t>(sizeBytes));
-  buffer.byteLength = sizeBytes;
-  bufferView.byteLength = sizeBytes;
-  bufferView.byteStride = stride;
-  bufferView.byteOffset = 0;
-  bufferView.target = CesiumGltf::BufferView::Target::ARRAY_BUFFER;
-  pAccessor->byteOffset = 0;
-
-  const auto doCopy = [pMesh, pAttribute, numberOfComponents](auto pOut) {
-    for (draco::PointIndex i(0); i < pMesh->num_points(); ++i) {
-      const draco::AttributeValueIndex valueIndex = pAttribute->mapped_index(i);
-      pAttribute->ConvertValue(valueIndex, numberOfComponents, pOut);
-      pOut += pAttribute->num_components();
-    }
-  };
+void copyDecodedAttribute(
+    const CesiumGltf::Accessor& accessor,
+    const draco::Mesh* pMesh,
+    const draco::PointAttribute* pAttribute,
+    std::byte* pOut,
+    int64_t stride) {
+  CESIUM_TRACE("CesiumGltfReader::copyDecodedAttribute");
+  const int8_t numberOfComponents = accessor.computeNumberOfComponents();
 
-  switch (pAccessor->componentType) {
+  switch (accessor.componentType) {
   case CesiumGltf::Accessor::ComponentType::BYTE:
-    doCopy(reinterpret_cast<int8_t*>(buffer.cesium.data.data()));
+    copyAttributeValues<int8_t>(
+        pMesh,
+        pAttribute,
+        numberOfComponents,
+        pOut,
+        stride);
     break;
   case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
-    doCopy(reinterpret_cast<uint8_t*>(buffer.cesium.data.data()));
+    copyAttributeValues<uint8_t>(
+        pMesh,
+        pAttribute,
+        numberOfComponents,
+        pOut,
+        stride);
     break;
   case CesiumGltf::Accessor::ComponentType::SHORT:
-    doCopy(reinterpret_cast<int16_t*>(buffer.cesium.data.data()));
+    copyAttributeValues<int16_t>(
+        pMesh,
+        pAttribute,
+        numberOfComponents,
+        pOut,
+        stride);
     break;
   case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
-    doCopy(reinterpret_cast<uint16_t*>(buffer.cesium.data.data()));
+    copyAttributeValues<uint16_t>(
+        pMesh,
+        pAttribute,
+        numberOfComponents,
+        pOut,
+        stride);
     break;
   case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
-    doCopy(reinterpret_cast<uint32_t*>(buffer.cesium.data.data()));
+    copyAttributeValues<uint32_t>(
+        pMesh,
+        pAttribute,
+        numberOfComponents,
+        pOut,
+        stride);
     break;
   case CesiumGltf::Accessor::ComponentType::FLOAT:
-    doCopy(reinterpret_cast<float*>(buffer.cesium.data.data()));
+    copyAttributeValues<float>(
+        pMesh,
+        pAttribute,
+        numberOfComponents,
+        pOut,
+        stride);
     break;
+  }
+}
+
+bool isKnownComponentType(int32_t componentType) {
+  switch (componentType) {
+  case CesiumGltf::Accessor::ComponentType::BYTE:
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE:
+  case CesiumGltf::Accessor::ComponentType::SHORT:
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT:
+  case CesiumGltf::Accessor::ComponentType::UNSIGNED_INT:
+  case CesiumGltf::Accessor::ComponentType::FLOAT:
+    return true;
   default:
-    readGltf.warnings.emplace_back(
-        "Accessor uses an unknown componentType: " +
-        std::to_string(int32_t(pAccessor->componentType)));
-    break;
+    return false;
   }
 }
 
-void decodePrimitive(
+struct DecodedAttribute {
+  CesiumGltf::Accessor* pAccessor;
+  const draco::PointAttribute* pAttribute;
+  int64_t elementSize;
+};
+
+// Copies the decoded indices and attributes of a primitive into a single new
+// buffer. The attributes either get a buffer view each or share a single
+// interleaved one.
+void copyDecodedPrimitive(
     GltfReaderResult& readGltf,
     CesiumGltf::MeshPrimitive& primitive,
-    CesiumGltf::ExtensionKhrDracoMeshCompression& draco) {
-  CESIUM_TRACE("CesiumGltfReader::decodePrimitive");
+    const CesiumGltf::ExtensionKhrDracoMeshCompression& draco,
+    const draco::Mesh* pMesh,
+    bool interleave) {
+  CESIUM_TRACE("CesiumGltfReader::copyDecodedPrimitive");
   CesiumGltf::Model& model = readGltf.model.value();
 
-  std::unique_ptr<draco::Mesh> pMesh =
-      decodeBufferViewToDracoMesh(readGltf, primitive, draco);
-  if (!pMesh) {
-    return;
-  }
-
-  copyDecodedIndices(readGltf, primitive, pMesh.get());
+  CesiumGltf::Accessor* pIndicesAccessor =
+      prepareIndicesAccessor(readGltf, primitive, pMesh);
 
+  std::vector<DecodedAttribute> attributes;
   for (const std::pair<const std::string, int32_t>& attribute :
        draco.attributes) {
     auto primitiveAttrIt = primitive.attributes.find(attribute.first);
@@ -315,41 +288,233 @@ void decodePrimitive(
       continue;
     }
 
-    copyDecodedAttribute(
-        readGltf,
-        primitive,
+    if (!isKnownComponentType(pAccessor->componentType)) {
+      readGltf.warnings.emplace_back(
+          "Accessor uses an unknown componentType: " +
+          std::to_string(int32_t(pAccessor->componentType)));
+      continue;
+    }
+
+    if (pAccessor->count != pMesh->num_points()) {
+      readGltf.warnings.emplace_back("Attribute accessor.count doesn't match "
+                                     "with number of decoded Draco vertices.");
+
+      pAccessor->count = pMesh->num_points();
+    }
+
+    attributes.emplace_back(DecodedAttribute{
         pAccessor,
-        pMesh.get(),
-        pAttribute);
+        pAttribute,
+        pAccessor->computeNumberOfComponents() *
+            pAccessor->computeByteSizeOfComponent()});
+  }
+
+  // Lay out the indices and then the attributes, starting each buffer view
+  // and each interleaved attribute on a four-byte boundary.
+  int64_t bufferSize = 0;
+  int64_t indicesBytes = 0;
+  if (pIndicesAccessor) {
+    indicesBytes = pIndicesAccessor->count *
+                   pIndicesAccessor->computeByteSizeOfComponent();
+    bufferSize = alignTo4(indicesBytes);
   }
-}
-} // namespace
 
-void decodeDraco(CesiumGltfReader::GltfReaderResult& readGltf) {
-  CESIUM_TRACE("CesiumGltfReader::decodeDraco");
-  if (!readGltf.model) {
+  const int64_t numPoints = static_cast<int64_t>(pMesh->num_points());
+  const int64_t verticesOffset = bufferSize;
+  int64_t vertexStride = 0;
+  std::vector<int64_t> attributeOffsets;
+  attributeOffsets.reserve(attributes.size());
+  for (const DecodedAttribute& attribute : attributes) {
+    if (interleave) {
+      attributeOffsets.emplace_back(vertexStride);
+      vertexStride += alignTo4(attribute.elementSize);
+    } else {
+      attributeOffsets.emplace_back(bufferSize);
+      bufferSize = alignTo4(bufferSize + numPoints * attribute.elementSize);
+    }
+  }
+  if (interleave) {
+    bufferSize += numPoints * vertexStride;
+  }
+
+  const int32_t bufferIndex = static_cast<int32_t>(model.buffers.size());
+  CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data = CesiumUtility::ByteVector(
+      static_cast<size_t>(bufferSize),
+      CesiumUtility::AllocationCategory::DracoOutput);
+  buffer.byteLength = bufferSize;
+  std::byte* pData = buffer.cesium.data.data();
+
+  if (pIndicesAccessor) {
+    pIndicesAccessor->bufferView =
+        static_cast<int32_t>(model.bufferViews.size());
+    CesiumGltf::BufferView& indicesBufferView =
+        model.bufferViews.emplace_back();
+    indicesBufferView.buffer = bufferIndex;
+    indicesBufferView.byteOffset = 0;
+    indicesBufferView.byteLength = indicesBytes;
+    indicesBufferView.target =
+        CesiumGltf::BufferView::Target::ELEMENT_ARRAY_BUFFER;
+
+    copyDecodedIndices(*pIndicesAccessor, pMesh, pData);
+  }
+
+  if (interleave && !attributes.empty()) {
+    const int32_t bufferViewIndex =
+        static_cast<int32_t>(model.bufferViews.size());
+    CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
+    bufferView.buffer = bufferIndex;
+    bufferView.byteOffset = verticesOffset;
+    bufferView.byteLength = numPoints * vertexStride;
+    bufferView.byteStride = vertexStride;
+    bufferView.target = CesiumGltf::BufferView::Target::ARRAY_BUFFER;
+
+    for (size_t i = 0; i < attributes.size(); ++i) {
+      attributes[i].pAccessor->bufferView = bufferViewIndex;
+      attributes[i].pAccessor->byteOffset = attributeOffsets[i];
+      copyDecodedAttribute(
+          *attributes[i].pAccessor,
+          pMesh,
+          attributes[i].pAttribute,
+          pData + verticesOffset + attributeOffsets[i],
+          vertexStride);
+    }
     return;
   }
 
+  for (size_t i = 0; i < attributes.size(); ++i) {
+    const DecodedAttribute& attribute = attributes[i];
+    attribute.pAccessor->bufferView =
+        static_cast<int32_t>(model.bufferViews.size());
+    attribute.pAccessor->byteOffset = 0;
+
+    CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
+    bufferView.buffer = bufferIndex;
+    bufferView.byteOffset = attributeOffsets[i];
+    bufferView.byteLength = numPoints * attribute.elementSize;
+    bufferView.byteStride = attribute.elementSize;
+    bufferView.target = CesiumGltf::BufferView::Target::ARRAY_BUFFER;
+
+    copyDecodedAttribute(
+        *attribute.pAccessor,
+        pMesh,
+        attribute.pAttribute,
+        pData + attributeOffsets[i],
+        attribute.elementSize);
+  }
+}
+} // namespace
+
+std::vector<DracoPrimitive> findDracoPrimitives(GltfReaderResult& readGltf) {
+  CESIUM_TRACE("CesiumGltfReader::findDracoPrimitives");
   CesiumGltf::Model& model = readGltf.model.value();
 
-  for (CesiumGltf::Mesh& mesh : model.meshes) {
-    for (CesiumGltf::MeshPrimitive& primitive : mesh.primitives) {
-      CesiumGltf::ExtensionKhrDracoMeshCompression* pDraco =
-          primitive
+  std::vector<DracoPrimitive> result;
+  for (size_t i = 0; i < model.meshes.size(); ++i) {
+    const CesiumGltf::Mesh& mesh = model.meshes[i];
+    for (size_t j = 0; j < mesh.primitives.size(); ++j) {
+      const CesiumGltf::ExtensionKhrDracoMeshCompression* pDraco =
+          mesh.primitives[j]
               .getExtension<CesiumGltf::ExtensionKhrDracoMeshCompression>();
       if (!pDraco) {
         continue;
       }
 
-      decodePrimitive(readGltf, primitive, *pDraco);
+      DracoPrimitive& primitive = result.emplace_back();
+      primitive.meshIndex = i;
+      primitive.primitiveIndex = j;
+
+      const CesiumGltf::BufferView* pBufferView =
+          CesiumGltf::Model::getSafe(&model.bufferViews, pDraco->bufferView);
+      if (!pBufferView) {
+        readGltf.warnings.emplace_back("Draco bufferView index is invalid.");
+        continue;
+      }
+
+      const CesiumGltf::BufferView& bufferView = *pBufferView;
+
+      const CesiumGltf::Buffer* pBuffer =
+          CesiumGltf::Model::getSafe(&model.buffers, bufferView.buffer);
+      if (!pBuffer) {
+        readGltf.warnings.emplace_back(
+            "Draco bufferView has an invalid buffer index.");
+        continue;
+      }
+
+      const CesiumGltf::Buffer& buffer = *pBuffer;
+
+      if (bufferView.byteOffset < 0 || bufferView.byteLength < 0 ||
+          bufferView.byteOffset + bufferView.byteLength >
+              static_cast<int64_t>(buffer.cesium.data.size())) {
+        readGltf.warnings.emplace_back(
+            "Draco bufferView extends beyond its buffer.");
+        continue;
+      }
 
-      // Remove the Draco extension as it no longer applies.
-      primitive.extensions.erase(
-          CesiumGltf::ExtensionKhrDracoMeshCompression::ExtensionName);
+      primitive.data = gsl::span<const std::byte>(
+          buffer.cesium.data.data() + bufferView.byteOffset,
+          static_cast<uint64_t>(bufferView.byteLength));
     }
   }
 
+  return result;
+}
+
+void DracoPrimitive::decode() {
+  CESIUM_TRACE("CesiumGltfReader::DracoPrimitive::decode");
+  if (!this->data) {
+    return;
+  }
+
+  draco::DecoderBuffer decodeBuffer;
+  decodeBuffer.Init(
+      reinterpret_cast<const char*>(this->data->data()),
+      this->data->size());
+
+  draco::Decoder decoder;
+  draco::StatusOr<std::unique_ptr<draco::Mesh>> result =
+      decoder.DecodeMeshFromBuffer(&decodeBuffer);
+  if (!result.ok()) {
+    this->warning = std::string("Draco decoding failed: ") +
+                    result.status().error_msg_string();
+    return;
+  }
+
+  this->pMesh = std::move(result).value();
+}
+
+void applyDecodedDraco(
+    GltfReaderResult& readGltf,
+    std::vector<DracoPrimitive>& primitives,
+    bool interleave) {
+  CESIUM_TRACE("CesiumGltfReader::applyDecodedDraco");
+  CesiumGltf::Model& model = readGltf.model.value();
+
+  for (DracoPrimitive& dracoPrimitive : primitives) {
+    CesiumGltf::MeshPrimitive& primitive =
+        model.meshes[dracoPrimitive.meshIndex]
+            .primitives[dracoPrimitive.primitiveIndex];
+
+    if (dracoPrimitive.warning) {
+      readGltf.warnings.emplace_back(std::move(*dracoPrimitive.warning));
+    }
+
+    const CesiumGltf::ExtensionKhrDracoMeshCompression* pDraco =
+        primitive.getExtension<CesiumGltf::ExtensionKhrDracoMeshCompression>();
+    if (pDraco && dracoPrimitive.pMesh) {
+      copyDecodedPrimitive(
+          readGltf,
+          primitive,
+          *pDraco,
+          dracoPrimitive.pMesh.get(),
+          interleave);
+    }
+
+    // Remove the Draco extension as it no longer applies.
+    primitive.extensions.erase(
+        CesiumGltf::ExtensionKhrDracoMeshCompression::ExtensionName);
+  }
+
   model.extensionsRequired.erase(
       std::remove(
           model.extensionsRequired.begin(),
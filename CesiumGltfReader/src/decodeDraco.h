@@ -1,7 +1,83 @@
 #pragma once
 
+#include <gsl/span>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace draco {
+class Mesh;
+}
+
 namespace CesiumGltfReader {
 struct GltfReaderResult;
 
-void decodeDraco(GltfReaderResult& readGltf);
+/**
+ * @brief A primitive compressed with the `KHR_draco_mesh_compression`
+ * extension.
+ *
+ * Decoding a primitive only reads its compressed data, so the primitives of a
+ * model can be decoded in parallel. The results are then copied into the
+ * model by {@link applyDecodedDraco}.
+ */
+struct DracoPrimitive {
+  /**
+   * @brief The index of the mesh in the model.
+   */
+  size_t meshIndex = 0;
+
+  /**
+   * @brief The index of the primitive in the mesh.
+   */
+  size_t primitiveIndex = 0;
+
+  /**
+   * @brief The compressed data, or `std::nullopt` if the extension's buffer
+   * view is invalid.
+   */
+  std::optional<gsl::span<const std::byte>> data;
+
+  /**
+   * @brief The decoded mesh, or nullptr if the primitive has not been decoded
+   * or decoding failed.
+   */
+  std::shared_ptr<draco::Mesh> pMesh;
+
+  /**
+   * @brief Why decoding failed, if it did.
+   */
+  std::optional<std::string> warning;
+
+  /**
+   * @brief Decodes the primitive. This may be called from any thread.
+   */
+  void decode();
+};
+
+/**
+ * @brief Finds the primitives of the model that are compressed with the
+ * `KHR_draco_mesh_compression` extension, and warns about those whose data is
+ * invalid.
+ */
+std::vector<DracoPrimitive> findDracoPrimitives(GltfReaderResult& readGltf);
+
+/**
+ * @brief Copies the meshes decoded by {@link DracoPrimitive::decode} into
+ * the model, and removes the `KHR_draco_mesh_compression` extension from it.
+ *
+ * The indices and attributes of each primitive are copied into a single new
+ * buffer.
+ *
+ * @param readGltf The result of reading the glTF.
+ * @param primitives The decoded primitives.
+ * @param interleave Whether the attributes of each primitive share a single
+ * interleaved buffer view, rather than each having its own.
+ */
+void applyDecodedDraco(
+    GltfReaderResult& readGltf,
+    std::vector<DracoPrimitive>& primitives,
+    bool interleave);
 } // namespace CesiumGltfReader
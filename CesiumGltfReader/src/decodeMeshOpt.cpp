@@ -101,58 +101,87 @@ int decodeBufferView(
 }
 } // namespace
 
-void decodeMeshOpt(Model& model, CesiumGltfReader::GltfReaderResult& readGltf) {
-  for (BufferView& bufferView : model.bufferViews) {
+std::vector<MeshOptBufferView>
+findMeshOptBufferViews(CesiumGltfReader::GltfReaderResult& readGltf) {
+  Model& model = readGltf.model.value();
+  std::vector<MeshOptBufferView> result;
+  for (size_t i = 0; i < model.bufferViews.size(); ++i) {
     const ExtensionBufferViewExtMeshoptCompression* pMeshOpt =
-        bufferView.getExtension<ExtensionBufferViewExtMeshoptCompression>();
-    if (pMeshOpt) {
-      const Buffer* pBuffer = model.getSafe(&model.buffers, pMeshOpt->buffer);
-      if (!pBuffer) {
-        readGltf.warnings.emplace_back(
-            "The EXT_meshopt_compression extension has an invalid buffer "
-            "index.");
-        continue;
-      }
-
-      if (pMeshOpt->byteOffset < 0 || pMeshOpt->byteLength < 0 ||
-          static_cast<size_t>(pMeshOpt->byteOffset + pMeshOpt->byteLength) >
-              pBuffer->cesium.data.size()) {
-        readGltf.warnings.emplace_back(
-            "The EXT_meshopt_compression extension has a bufferView that "
-            "extends beyond its buffer.");
-        continue;
-      }
-      int64_t byteLength = pMeshOpt->byteStride * pMeshOpt->count;
-      if (byteLength < 0) {
-        readGltf.warnings.emplace_back("The EXT_meshopt_compression extension "
-                                       "has a negative byte length.");
-        continue;
-      }
-
-      std::vector<std::byte> data;
-      data.resize(static_cast<size_t>(byteLength));
-      if (decodeBufferView(
-              data.data(),
-              gsl::span<const std::byte>(
-                  pBuffer->cesium.data.data() + pMeshOpt->byteOffset,
-                  static_cast<size_t>(pMeshOpt->byteLength)),
-              *pMeshOpt) != 0) {
-        readGltf.warnings.emplace_back(
-            "The EXT_meshopt_compression extension has a corrupted or "
-            "incompatible meshopt compression buffer.");
-        continue;
-      }
-      decodeFilter(data.data(), *pMeshOpt);
-      Buffer& buffer = model.buffers.emplace_back();
-      buffer.byteLength = byteLength;
-      buffer.cesium.data = std::move(data);
-
-      bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
-      bufferView.byteOffset = 0;
-      bufferView.byteLength = byteLength;
-      bufferView.extensions.erase(
-          ExtensionBufferViewExtMeshoptCompression::ExtensionName);
+        model.bufferViews[i]
+            .getExtension<ExtensionBufferViewExtMeshoptCompression>();
+    if (!pMeshOpt) {
+      continue;
     }
+
+    const Buffer* pBuffer = model.getSafe(&model.buffers, pMeshOpt->buffer);
+    if (!pBuffer) {
+      readGltf.warnings.emplace_back(
+          "The EXT_meshopt_compression extension has an invalid buffer "
+          "index.");
+      continue;
+    }
+
+    if (pMeshOpt->byteOffset < 0 || pMeshOpt->byteLength < 0 ||
+        static_cast<size_t>(pMeshOpt->byteOffset + pMeshOpt->byteLength) >
+            pBuffer->cesium.data.size()) {
+      readGltf.warnings.emplace_back(
+          "The EXT_meshopt_compression extension has a bufferView that "
+          "extends beyond its buffer.");
+      continue;
+    }
+    if (pMeshOpt->byteStride * pMeshOpt->count < 0) {
+      readGltf.warnings.emplace_back("The EXT_meshopt_compression extension "
+                                     "has a negative byte length.");
+      continue;
+    }
+
+    MeshOptBufferView& bufferView = result.emplace_back();
+    bufferView.bufferViewIndex = i;
+    bufferView.pMeshOpt = pMeshOpt;
+    bufferView.data = gsl::span<const std::byte>(
+        pBuffer->cesium.data.data() + pMeshOpt->byteOffset,
+        static_cast<size_t>(pMeshOpt->byteLength));
+  }
+  return result;
+}
+
+void MeshOptBufferView::decode() {
+  const int64_t byteLength = this->pMeshOpt->byteStride * this->pMeshOpt->count;
+  CesiumUtility::ByteVector result(
+      static_cast<size_t>(byteLength),
+      CesiumUtility::AllocationCategory::GltfBuffer);
+  if (decodeBufferView(result.data(), this->data, *this->pMeshOpt) != 0) {
+    return;
+  }
+  decodeFilter(result.data(), *this->pMeshOpt);
+  this->decoded = std::move(result);
+}
+
+void applyDecodedMeshOpt(
+    CesiumGltfReader::GltfReaderResult& readGltf,
+    std::vector<MeshOptBufferView>& bufferViews) {
+  Model& model = readGltf.model.value();
+  for (MeshOptBufferView& meshOptBufferView : bufferViews) {
+    if (!meshOptBufferView.decoded) {
+      readGltf.warnings.emplace_back(
+          "The EXT_meshopt_compression extension has a corrupted or "
+          "incompatible meshopt compression buffer.");
+      continue;
+    }
+
+    const int64_t byteLength =
+        static_cast<int64_t>(meshOptBufferView.decoded->size());
+    Buffer& buffer = model.buffers.emplace_back();
+    buffer.byteLength = byteLength;
+    buffer.cesium.data = std::move(*meshOptBufferView.decoded);
+
+    BufferView& bufferView =
+        model.bufferViews[meshOptBufferView.bufferViewIndex];
+    bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+    bufferView.byteOffset = 0;
+    bufferView.byteLength = byteLength;
+    bufferView.extensions.erase(
+        ExtensionBufferViewExtMeshoptCompression::ExtensionName);
   }
 
   model.extensionsUsed.erase(
@@ -1,7 +1,15 @@
 #pragma once
 
+#include <CesiumUtility/Allocator.h>
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
 namespace CesiumGltf {
-struct Model;
+struct ExtensionBufferViewExtMeshoptCompression;
 }
 
 namespace CesiumGltfReader {
@@ -11,14 +19,57 @@ struct GltfReaderResult;
 namespace CesiumGltfReader {
 
 /**
- * @brief Decodes the mesh data in the model according to the
- * EXT_meshopt_compression extension
+ * @brief A buffer view compressed with the EXT_meshopt_compression extension.
+ *
+ * Decoding a buffer view only reads its compressed data, so the buffer views
+ * of a model can be decoded in parallel. The results are then copied into the
+ * model by {@link applyDecodedMeshOpt}.
  *
  * The decompressed buffer may be in a quantized format as specified by the
  * KHR_mesh_quantization extension, in which case the data will have to be
  * dequantized to get the original values.
- **/
-void decodeMeshOpt(
-    CesiumGltf::Model& model,
-    CesiumGltfReader::GltfReaderResult& readGltf);
+ */
+struct MeshOptBufferView {
+  /**
+   * @brief The index of the buffer view in the model.
+   */
+  size_t bufferViewIndex = 0;
+
+  /**
+   * @brief The extension of the buffer view.
+   */
+  const CesiumGltf::ExtensionBufferViewExtMeshoptCompression* pMeshOpt =
+      nullptr;
+
+  /**
+   * @brief The compressed data.
+   */
+  gsl::span<const std::byte> data;
+
+  /**
+   * @brief The decoded data, or `std::nullopt` if the buffer view has not been
+   * decoded or decoding failed.
+   */
+  std::optional<CesiumUtility::ByteVector> decoded;
+
+  /**
+   * @brief Decodes the buffer view. This may be called from any thread.
+   */
+  void decode();
+};
+
+/**
+ * @brief Finds the buffer views of the model that can be decoded according to
+ * the EXT_meshopt_compression extension, and warns about those that can't.
+ */
+std::vector<MeshOptBufferView>
+findMeshOptBufferViews(CesiumGltfReader::GltfReaderResult& readGltf);
+
+/**
+ * @brief Replaces the compressed buffer views of the model with the data
+ * decoded by {@link MeshOptBufferView::decode}.
+ */
+void applyDecodedMeshOpt(
+    CesiumGltfReader::GltfReaderResult& readGltf,
+    std::vector<MeshOptBufferView>& bufferViews);
 } // namespace CesiumGltfReader
@@ -22,28 +22,50 @@ template <> float intToFloat(std::int16_t c) {
 
 template <> float intToFloat(std::uint16_t c) { return c / 65535.0f; }
 
-template <typename T, size_t N>
-void normalizeQuantized(
-    float* fPtr,
-    int64_t count,
-    const std::byte* bPtr,
-    int64_t stride) {
-  for (int i = 0; i < count; i++, bPtr += stride) {
-    for (unsigned int j = 0; j < N; j++) {
-      *fPtr++ = intToFloat<T>(reinterpret_cast<const T*>(bPtr)[j]);
+// Converts elements that are a compile-time number of bytes apart. Because the
+// stride is a constant, compilers can vectorize this loop.
+template <typename T, size_t N, size_t Stride, typename Convert>
+void convertPackedToFloat(
+    float* pOut,
+    size_t count,
+    const std::byte* pIn,
+    Convert convert) {
+  for (size_t i = 0; i < count; ++i) {
+    const T* pValues = reinterpret_cast<const T*>(pIn + i * Stride);
+    for (size_t j = 0; j < N; ++j) {
+      pOut[i * N + j] = convert(pValues[j]);
     }
   }
 }
 
-template <typename T, size_t N>
-void castQuantizedToFloat(
-    float* fPtr,
+// Converts each component of the elements to a float. Elements that are
+// tightly packed, or padded to the 4-byte alignment that glTF requires for
+// vertex attributes, take a loop specialized for their stride.
+template <typename T, size_t N, typename Convert>
+void convertToFloat(
+    float* pOut,
     int64_t count,
-    const std::byte* bPtr,
-    int64_t stride) {
-  for (int i = 0; i < count; i++, bPtr += stride) {
-    for (unsigned int j = 0; j < N; j++) {
-      *fPtr++ = static_cast<float>(reinterpret_cast<const T*>(bPtr)[j]);
+    const std::byte* pIn,
+    int64_t stride,
+    Convert convert) {
+  constexpr size_t packedStride = N * sizeof(T);
+  constexpr size_t alignedStride = (packedStride + 3) / 4 * 4;
+  const size_t elementCount = static_cast<size_t>(count);
+
+  if (stride == static_cast<int64_t>(packedStride)) {
+    convertPackedToFloat<T, N, packedStride>(pOut, elementCount, pIn, convert);
+    return;
+  }
+
+  if (stride == static_cast<int64_t>(alignedStride)) {
+    convertPackedToFloat<T, N, alignedStride>(pOut, elementCount, pIn, convert);
+    return;
+  }
+
+  for (size_t i = 0; i < elementCount; ++i, pIn += stride) {
+    const T* pValues = reinterpret_cast<const T*>(pIn);
+    for (size_t j = 0; j < N; ++j) {
+      *pOut++ = convert(pValues[j]);
     }
   }
 }
@@ -82,18 +104,20 @@ void dequantizeAccessor(Model& model, Accessor& accessor) {
     return;
   }
 
-  std::vector<std::byte> data;
-  data.resize(static_cast<size_t>(byteLength));
+  CesiumUtility::ByteVector data(
+      static_cast<size_t>(byteLength),
+      CesiumUtility::AllocationCategory::GltfBuffer);
 
   const std::byte* bPtr = pBuffer->cesium.data.data() +
                           pBufferView->byteOffset + accessor.byteOffset;
 
   if (accessor.normalized) {
-    normalizeQuantized<T, N>(
+    convertToFloat<T, N>(
         reinterpret_cast<float*>(data.data()),
         accessor.count,
         bPtr,
-        byteStride);
+        byteStride,
+        [](T value) { return intToFloat<T>(value); });
     for (double& d : accessor.min) {
       d = intToFloat<T>(static_cast<T>(d));
     }
@@ -101,11 +125,12 @@ void dequantizeAccessor(Model& model, Accessor& accessor) {
       d = intToFloat<T>(static_cast<T>(d));
     }
   } else {
-    castQuantizedToFloat<T, N>(
+    convertToFloat<T, N>(
         reinterpret_cast<float*>(data.data()),
         accessor.count,
         bPtr,
-        byteStride);
+        byteStride,
+        [](T value) { return static_cast<float>(value); });
   }
   accessor.componentType = AccessorSpec::ComponentType::FLOAT;
   accessor.byteOffset = 0;
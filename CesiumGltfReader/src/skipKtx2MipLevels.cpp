@@ -0,0 +1,191 @@
+#include "skipKtx2MipLevels.h"
+
+#include <CesiumUtility/Tracing.h>
+
+#include <algorithm>
+
+namespace CesiumGltfReader {
+
+namespace {
+// The layout of a KTX2 file, from
+// https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html#_file_structure
+const size_t pixelWidthOffset = 20;
+const size_t pixelHeightOffset = 24;
+const size_t pixelDepthOffset = 28;
+const size_t layerCountOffset = 32;
+const size_t faceCountOffset = 36;
+const size_t levelCountOffset = 40;
+const size_t supercompressionSchemeOffset = 44;
+const size_t dfdByteOffsetOffset = 48;
+const size_t kvdByteOffsetOffset = 56;
+const size_t sgdByteOffsetOffset = 64;
+const size_t headerSize = 80;
+const size_t levelIndexEntrySize = 24;
+
+const uint32_t basisLzScheme = 1;
+
+// BasisLZ global data starts with a header, followed by a description of
+// each image, which for a plain 2D texture is one per level.
+const size_t basisLzHeaderSize = 20;
+const size_t basisLzImageDescSize = 20;
+
+// Level data is aligned to a multiple of every alignment the spec requires.
+const size_t levelAlignment = 16;
+
+template <typename T>
+T read(const gsl::span<const std::byte>& data, size_t offset) {
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    value |= T(uint8_t(data[offset + i])) << (8 * i);
+  }
+  return value;
+}
+
+template <typename T>
+void write(std::vector<std::byte>& data, size_t offset, T value) {
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    data[offset + i] = std::byte(uint8_t(value >> (8 * i)));
+  }
+}
+
+void append(
+    std::vector<std::byte>& data,
+    const gsl::span<const std::byte>& bytes) {
+  data.insert(data.end(), bytes.begin(), bytes.end());
+}
+
+void pad(std::vector<std::byte>& data, size_t alignment) {
+  data.resize((data.size() + alignment - 1) / alignment * alignment);
+}
+
+bool isInRange(
+    const gsl::span<const std::byte>& data,
+    uint64_t offset,
+    uint64_t length) {
+  return offset <= data.size() && length <= data.size() - offset;
+}
+
+gsl::span<const std::byte> subspan(
+    const gsl::span<const std::byte>& data,
+    uint64_t offset,
+    uint64_t length) {
+  return data.subspan(static_cast<size_t>(offset), static_cast<size_t>(length));
+}
+} // namespace
+
+std::optional<std::vector<std::byte>> skipKtx2MipLevels(
+    const gsl::span<const std::byte>& data,
+    int32_t maximumTextureSize) {
+  CESIUM_TRACE("CesiumGltfReader::skipKtx2MipLevels");
+  if (maximumTextureSize <= 0 || data.size() < headerSize) {
+    return std::nullopt;
+  }
+
+  const uint32_t width = read<uint32_t>(data, pixelWidthOffset);
+  const uint32_t height = read<uint32_t>(data, pixelHeightOffset);
+  const uint32_t levelCount = read<uint32_t>(data, levelCountOffset);
+  if (read<uint32_t>(data, pixelDepthOffset) > 1 ||
+      read<uint32_t>(data, layerCountOffset) > 1 ||
+      read<uint32_t>(data, faceCountOffset) != 1 || levelCount <= 1) {
+    return std::nullopt;
+  }
+
+  const uint32_t maximumSize = static_cast<uint32_t>(maximumTextureSize);
+  uint32_t skippedLevels = 0;
+  while (skippedLevels + 1 < levelCount &&
+         (std::max(width >> skippedLevels, 1u) > maximumSize ||
+          std::max(height >> skippedLevels, 1u) > maximumSize)) {
+    ++skippedLevels;
+  }
+  if (skippedLevels == 0) {
+    return std::nullopt;
+  }
+
+  const uint64_t dfdOffset = read<uint32_t>(data, dfdByteOffsetOffset);
+  const uint64_t dfdLength = read<uint32_t>(data, dfdByteOffsetOffset + 4);
+  const uint64_t kvdOffset = read<uint32_t>(data, kvdByteOffsetOffset);
+  const uint64_t kvdLength = read<uint32_t>(data, kvdByteOffsetOffset + 4);
+  const uint64_t sgdOffset = read<uint64_t>(data, sgdByteOffsetOffset);
+  const uint64_t sgdLength = read<uint64_t>(data, sgdByteOffsetOffset + 8);
+  const uint64_t levelIndexSize = uint64_t(levelCount) * levelIndexEntrySize;
+  if (!isInRange(data, headerSize, levelIndexSize) ||
+      !isInRange(data, dfdOffset, dfdLength) ||
+      !isInRange(data, kvdOffset, kvdLength) ||
+      !isInRange(data, sgdOffset, sgdLength)) {
+    return std::nullopt;
+  }
+
+  const bool isBasisLz =
+      read<uint32_t>(data, supercompressionSchemeOffset) == basisLzScheme;
+  if (isBasisLz &&
+      sgdLength < basisLzHeaderSize + levelCount * basisLzImageDescSize) {
+    return std::nullopt;
+  }
+
+  for (uint32_t level = 0; level < levelCount; ++level) {
+    const size_t entry = headerSize + level * levelIndexEntrySize;
+    if (!isInRange(
+            data,
+            read<uint64_t>(data, entry),
+            read<uint64_t>(data, entry + 8))) {
+      return std::nullopt;
+    }
+  }
+
+  const uint32_t newLevelCount = levelCount - skippedLevels;
+  const gsl::span<const std::byte> header = data.first(headerSize);
+  std::vector<std::byte> result(header.begin(), header.end());
+  write(result, pixelWidthOffset, std::max(width >> skippedLevels, 1u));
+  write(result, pixelHeightOffset, std::max(height >> skippedLevels, 1u));
+  write(result, levelCountOffset, newLevelCount);
+  result.resize(headerSize + newLevelCount * levelIndexEntrySize);
+
+  write(result, dfdByteOffsetOffset, static_cast<uint32_t>(result.size()));
+  append(result, subspan(data, dfdOffset, dfdLength));
+
+  write(result, kvdByteOffsetOffset, uint32_t(0));
+  if (kvdLength > 0) {
+    write(result, kvdByteOffsetOffset, static_cast<uint32_t>(result.size()));
+    append(result, subspan(data, kvdOffset, kvdLength));
+  }
+
+  write(result, sgdByteOffsetOffset, uint64_t(0));
+  if (sgdLength > 0) {
+    pad(result, 8);
+    write(result, sgdByteOffsetOffset, static_cast<uint64_t>(result.size()));
+    const gsl::span<const std::byte> sgd = subspan(data, sgdOffset, sgdLength);
+    if (isBasisLz) {
+      // Drop the descriptions of the skipped images.
+      append(result, sgd.first(basisLzHeaderSize));
+      append(
+          result,
+          sgd.subspan(
+              basisLzHeaderSize + skippedLevels * basisLzImageDescSize));
+      write(
+          result,
+          sgdByteOffsetOffset + 8,
+          static_cast<uint64_t>(
+              sgdLength - skippedLevels * basisLzImageDescSize));
+    } else {
+      append(result, sgd);
+    }
+  }
+
+  // Levels are stored from the smallest to the largest.
+  for (uint32_t level = levelCount; level-- > skippedLevels;) {
+    const size_t entry = headerSize + level * levelIndexEntrySize;
+    const size_t newEntry =
+        headerSize + (level - skippedLevels) * levelIndexEntrySize;
+    const uint64_t levelLength = read<uint64_t>(data, entry + 8);
+
+    pad(result, levelAlignment);
+    write(result, newEntry, static_cast<uint64_t>(result.size()));
+    write(result, newEntry + 8, levelLength);
+    write(result, newEntry + 16, read<uint64_t>(data, entry + 16));
+    append(result, subspan(data, read<uint64_t>(data, entry), levelLength));
+  }
+
+  return result;
+}
+
+} // namespace CesiumGltfReader
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace CesiumGltfReader {
+
+/**
+ * @brief Rewrites a KTX2 file without the mip levels that are larger than a
+ * maximum size, so that they don't need to be transcoded at all.
+ *
+ * Only two-dimensional textures that are not arrays or cube maps are
+ * rewritten.
+ *
+ * @param data The KTX2 file.
+ * @param maximumTextureSize The largest width or height to keep.
+ * @return The rewritten file, or `std::nullopt` if no levels need to be
+ * skipped or the file can't be rewritten.
+ */
+std::optional<std::vector<std::byte>> skipKtx2MipLevels(
+    const gsl::span<const std::byte>& data,
+    int32_t maximumTextureSize);
+
+} // namespace CesiumGltfReader
@@ -15,9 +15,11 @@
 #include <gsl/span>
 #include <rapidjson/reader.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <limits>
+#include <optional>
 #include <string>
 
 using namespace CesiumAsync;
@@ -234,6 +236,115 @@ TEST_CASE("Can decompress meshes using EXT_meshopt_compression") {
   }
 }
 
+TEST_CASE("Decoding in parallel gives the same model as decoding serially") {
+  const std::string filename = GENERATE(
+      std::string("/DucksMeshopt/Duck.glb"),
+      std::string("/CesiumBalloon.glb"));
+  std::vector<std::byte> data =
+      readFile(CesiumGltfReader_TEST_DATA_DIR + filename);
+
+  GltfReader reader;
+  GltfReaderResult serial = reader.readGltf(data);
+
+  AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+  GltfReaderResult parallel =
+      waitForFuture(asyncSystem, reader.readGltf(asyncSystem, data));
+
+  REQUIRE(serial.model);
+  REQUIRE(parallel.model);
+  CHECK(parallel.errors == serial.errors);
+  CHECK(parallel.warnings == serial.warnings);
+  CHECK(parallel.model->extensionsUsed == serial.model->extensionsUsed);
+
+  REQUIRE(parallel.model->buffers.size() == serial.model->buffers.size());
+  for (size_t i = 0; i < serial.model->buffers.size(); ++i) {
+    CHECK(
+        parallel.model->buffers[i].cesium.data ==
+        serial.model->buffers[i].cesium.data);
+  }
+
+  REQUIRE(parallel.model->images.size() == serial.model->images.size());
+  for (size_t i = 0; i < serial.model->images.size(); ++i) {
+    CHECK(
+        parallel.model->images[i].cesium.pixelData ==
+        serial.model->images[i].cesium.pixelData);
+  }
+}
+
+TEST_CASE("GlbStreamReader reads the JSON before the binary chunk arrives") {
+  std::vector<std::byte> data = readFile(
+      std::string(CesiumGltfReader_TEST_DATA_DIR) + "/CesiumBalloon.glb");
+
+  GltfReader reader;
+  GltfReaderResult expected = reader.readGltf(data);
+  REQUIRE(expected.model);
+
+  SECTION("A valid GLB") {
+    GlbStreamReader streamReader(reader);
+    std::optional<GltfReaderResult> result;
+
+    const size_t pieceSize = 1000;
+    for (size_t offset = 0; offset < data.size(); offset += pieceSize) {
+      streamReader.append(gsl::span<const std::byte>(data).subspan(
+          offset,
+          std::min(pieceSize, data.size() - offset)));
+      if (!result && streamReader.isJsonRead()) {
+        CHECK(!streamReader.isComplete());
+        result = streamReader.takeJsonResult();
+        REQUIRE(result);
+        REQUIRE(result->model);
+        REQUIRE(!result->model->buffers.empty());
+        CHECK(result->model->buffers[0].cesium.data.empty());
+        CHECK(!streamReader.takeJsonResult());
+      }
+    }
+
+    REQUIRE(result);
+    CHECK(streamReader.isComplete());
+    streamReader.readBinaryChunk(*result);
+    reader.postprocessGltf(*result, GltfReaderOptions());
+
+    REQUIRE(result->model);
+    CHECK(result->errors == expected.errors);
+    CHECK(
+        result->model->buffers[0].cesium.data ==
+        expected.model->buffers[0].cesium.data);
+    REQUIRE(result->model->images.size() == expected.model->images.size());
+    for (size_t i = 0; i < expected.model->images.size(); ++i) {
+      CHECK(
+          result->model->images[i].cesium.pixelData ==
+          expected.model->images[i].cesium.pixelData);
+    }
+  }
+
+  SECTION("An incomplete GLB") {
+    GlbStreamReader streamReader(reader);
+    streamReader.append(
+        gsl::span<const std::byte>(data).first(data.size() / 2));
+    REQUIRE(streamReader.isJsonRead());
+    CHECK(!streamReader.isComplete());
+
+    std::optional<GltfReaderResult> result = streamReader.takeJsonResult();
+    REQUIRE(result);
+    streamReader.readBinaryChunk(*result);
+    CHECK(!result->model);
+    CHECK(!result->errors.empty());
+  }
+
+  SECTION("An invalid GLB") {
+    data[0] = std::byte('x');
+    GlbStreamReader streamReader(reader);
+    streamReader.append(data);
+    REQUIRE(streamReader.isJsonRead());
+    CHECK(streamReader.isComplete());
+
+    std::optional<GltfReaderResult> result = streamReader.takeJsonResult();
+    REQUIRE(result);
+    CHECK(!result->model);
+    CHECK(!result->errors.empty());
+  }
+}
+
 TEST_CASE("Read TriangleWithoutIndices") {
   std::filesystem::path gltfFile = CesiumGltfReader_TEST_DATA_DIR;
   gltfFile /=
@@ -266,6 +377,29 @@ TEST_CASE("Read TriangleWithPaddingInGlbBin") {
   REQUIRE(result.warnings.size() == 1);
 }
 
+TEST_CASE("Reading a GLB from a vector moves its binary chunk") {
+  const std::vector<std::byte> data = readFile(
+      std::string(CesiumGltfReader_TEST_DATA_DIR) + "/CesiumBalloon.glb");
+  GltfReader reader;
+  GltfReaderResult copied = reader.readGltf(data);
+  REQUIRE(copied.model);
+
+  CesiumUtility::ByteVector moved(
+      data.begin(),
+      data.end(),
+      CesiumUtility::AllocationCategory::GltfBuffer);
+  const std::byte* pData = moved.data();
+  GltfReaderResult result = reader.readGltf(std::move(moved));
+  REQUIRE(result.model);
+  CHECK(result.errors.empty());
+  REQUIRE(!result.model->buffers.empty());
+
+  const CesiumUtility::ByteVector& buffer =
+      result.model->buffers[0].cesium.data;
+  CHECK(buffer.data() == pData);
+  CHECK(buffer == copied.model->buffers[0].cesium.data);
+}
+
 TEST_CASE("Nested extras deserializes properly") {
   const std::string s = R"(
     {
@@ -577,6 +711,81 @@ TEST_CASE("Can apply RTC CENTER if model uses Cesium RTC extension") {
   CHECK(cesiumRTC->center == rtcCenter);
 }
 
+TEST_CASE("Can downscale JPEG images while decoding them") {
+  std::filesystem::path jpegFile = CesiumGltfReader_TEST_DATA_DIR;
+  jpegFile /= "ktx2/kota.jpg";
+  std::vector<std::byte> data = readFile(jpegFile.string());
+
+  ImageReaderResult fullResult =
+      GltfReader::readImage(data, Ktx2TranscodeTargets{});
+  REQUIRE(fullResult.image);
+  const int32_t width = fullResult.image->width;
+  const int32_t height = fullResult.image->height;
+
+  SECTION("An image that fits is decoded at its full size") {
+    ImageReaderResult result = GltfReader::readImage(
+        data,
+        Ktx2TranscodeTargets{},
+        std::max(width, height));
+    REQUIRE(result.image);
+    CHECK(result.image->width == width);
+    CHECK(result.image->height == height);
+  }
+
+  SECTION("A larger image is decoded at the largest scale that fits") {
+    const int32_t maximumDimension = (std::max(width, height) + 1) / 2;
+    ImageReaderResult result =
+        GltfReader::readImage(data, Ktx2TranscodeTargets{}, maximumDimension);
+    REQUIRE(result.image);
+    CHECK(result.image->width == (width + 1) / 2);
+    CHECK(result.image->height == (height + 1) / 2);
+    CHECK(
+        result.image->pixelData.size() ==
+        size_t(result.image->width * result.image->height * 4));
+  }
+}
+
+TEST_CASE("Can reduce images to a maximum texture size") {
+  std::filesystem::path dataDir = CesiumGltfReader_TEST_DATA_DIR;
+
+  SECTION("KTX2 images skip the mip levels that are too large") {
+    std::vector<std::byte> data = readFile(dataDir / "ktx2/kota-mipmaps.ktx2");
+    ImageReaderResult fullResult =
+        GltfReader::readImage(data, Ktx2TranscodeTargets{});
+    REQUIRE(fullResult.image);
+    const ImageCesium& full = *fullResult.image;
+    REQUIRE(full.mipPositions.size() == 9);
+
+    ImageReaderResult result = GltfReader::readImage(
+        data,
+        Ktx2TranscodeTargets{},
+        std::max(full.width, full.height) / 4);
+    REQUIRE(result.image);
+    const ImageCesium& image = *result.image;
+    CHECK(image.width == full.width / 4);
+    CHECK(image.height == full.height / 4);
+    REQUIRE(image.mipPositions.size() == 7);
+    CHECK(image.mipPositions[0].byteOffset == 0);
+    CHECK(image.mipPositions[0].byteSize == full.mipPositions[2].byteSize);
+    CHECK(
+        image.pixelData.size() ==
+        image.mipPositions[6].byteOffset + image.mipPositions[6].byteSize);
+  }
+
+  SECTION("Other images are halved until they fit") {
+    std::vector<std::byte> data =
+        readFile(dataDir / "DracoCompressed/CesiumMilkTruck.png");
+    ImageReaderResult result =
+        GltfReader::readImage(data, Ktx2TranscodeTargets{}, 600);
+    REQUIRE(result.image);
+    const ImageCesium& image = *result.image;
+    CHECK(image.width == 512);
+    CHECK(image.height == 512);
+    CHECK(image.pixelData.size() == 512 * 512 * 4);
+    CHECK(image.mipPositions.empty());
+  }
+}
+
 TEST_CASE("Can correctly interpret mipmaps in KTX2 files") {
   {
     // This KTX2 file has a single mip level and no further mip levels should be
@@ -691,6 +900,62 @@ TEST_CASE("Ignores unknown properties if requested") {
   CHECK(result.model->asset.unknownProperties.empty());
 }
 
+TEST_CASE("Skips parts of a glTF that are not needed if requested") {
+  const std::string s = R"(
+    {
+      "asset": {
+        "version": "2.0",
+        "extras": { "a": 1 }
+      },
+      "extensions": {
+        "UNKNOWN_extension": { "b": 2 }
+      },
+      "meshes": [{ "primitives": [], "extras": { "c": 3 } }],
+      "animations": [{ "channels": [], "samplers": [] }],
+      "skins": [{ "joints": [0] }]
+    }
+  )";
+  const gsl::span<const std::byte> data(
+      reinterpret_cast<const std::byte*>(s.c_str()),
+      s.size());
+
+  GltfReader reader;
+  GltfReaderOptions options;
+
+  GltfReaderResult result = reader.readGltf(data, options);
+  REQUIRE(result.model.has_value());
+  CHECK(result.model->asset.extras.size() == 1);
+  CHECK(result.model->getGenericExtension("UNKNOWN_extension"));
+  REQUIRE(result.model->meshes.size() == 1);
+  CHECK(result.model->meshes[0].extras.size() == 1);
+  CHECK(result.model->animations.size() == 1);
+  CHECK(result.model->skins.size() == 1);
+
+  options.readAnimations = false;
+  options.readSkins = false;
+  reader.getOptions().setCaptureExtras(false);
+  reader.getOptions().setCaptureUnknownExtensions(false);
+
+  result = reader.readGltf(data, options);
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.model.has_value());
+  CHECK(result.model->asset.version == "2.0");
+  CHECK(result.model->asset.extras.empty());
+  CHECK(result.model->extensions.empty());
+  REQUIRE(result.model->meshes.size() == 1);
+  CHECK(result.model->meshes[0].extras.empty());
+  CHECK(result.model->animations.empty());
+  CHECK(result.model->skins.empty());
+
+  // An extension that is explicitly read as JSON is still captured.
+  reader.getOptions().setExtensionState(
+      "UNKNOWN_extension",
+      CesiumJsonReader::ExtensionState::JsonOnly);
+  result = reader.readGltf(data, options);
+  REQUIRE(result.model.has_value());
+  CHECK(result.model->getGenericExtension("UNKNOWN_extension"));
+}
+
 TEST_CASE("Decodes images with data uris") {
   GltfReader reader;
   GltfReaderResult result = reader.readGltf(readFile(
@@ -834,10 +1099,170 @@ TEST_CASE("GltfReader::postprocessGltf") {
 
     REQUIRE(readerResult.model->buffers.size() == 1);
 
-    std::vector<std::byte>& data = readerResult.model->buffers[0].cesium.data;
+    CesiumUtility::ByteVector& data =
+        readerResult.model->buffers[0].cesium.data;
     std::string s(
         reinterpret_cast<char*>(data.data()),
         reinterpret_cast<char*>(data.data()) + data.size());
     CHECK(s == "test");
   }
+
+  SECTION("decodes long data URLs") {
+    options.decodeDataUrls = true;
+
+    Model& model = readerResult.model.emplace();
+
+    // A long URL, ending with padding.
+    const size_t repetitions = 1500000;
+    std::string uri = "data:application/octet-stream;base64,";
+    uri.reserve(uri.size() + repetitions * 4 + 4);
+    for (size_t i = 0; i < repetitions; ++i) {
+      uri += "YWJj";
+    }
+    uri += "YQ==";
+
+    Buffer& buffer = model.buffers.emplace_back();
+    buffer.uri = uri;
+    buffer.byteLength = int64_t(repetitions * 3 + 1);
+
+    Buffer& invalid = model.buffers.emplace_back();
+    invalid.uri = uri;
+    invalid.uri->replace(uri.size() / 2, 1, "=");
+
+    reader.postprocessGltf(readerResult, options);
+
+    CHECK(readerResult.warnings.empty());
+    REQUIRE(readerResult.model->buffers.size() == 2);
+
+    const CesiumUtility::ByteVector& data =
+        readerResult.model->buffers[0].cesium.data;
+    REQUIRE(data.size() == repetitions * 3 + 1);
+    CHECK(!readerResult.model->buffers[0].uri);
+    bool matches = true;
+    for (size_t i = 0; i < data.size(); ++i) {
+      matches = matches && data[i] == std::byte("abc"[i % 3]);
+    }
+    CHECK(matches);
+
+    CHECK(readerResult.model->buffers[1].cesium.data.empty());
+    CHECK(readerResult.model->buffers[1].uri);
+  }
+}
+
+TEST_CASE("Can interleave the attributes of decoded Draco primitives") {
+  AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+  std::filesystem::path dataDir(CesiumGltfReader_TEST_DATA_DIR);
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> mapUrlToRequest;
+  for (const char* filename :
+       {"CesiumMilkTruck.gltf", "0.bin", "CesiumMilkTruck.png"}) {
+    std::string url = std::string("file:///") + filename;
+    mapUrlToRequest[url] = std::make_shared<SimpleAssetRequest>(
+        "GET",
+        url,
+        CesiumAsync::HttpHeaders{},
+        std::make_unique<SimpleAssetResponse>(
+            uint16_t(200),
+            "application/binary",
+            CesiumAsync::HttpHeaders{},
+            readFile(dataDir / "DracoCompressed" / filename)));
+  }
+  auto pMockAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mapUrlToRequest));
+
+  GltfReader reader;
+  GltfReaderOptions options;
+  options.decodeEmbeddedImages = false;
+  GltfReaderResult separate = waitForFuture(
+      asyncSystem,
+      reader.loadGltf(
+          asyncSystem,
+          "file:///CesiumMilkTruck.gltf",
+          {},
+          pMockAssetAccessor,
+          options));
+
+  options.interleaveDracoAttributes = true;
+  GltfReaderResult interleaved = waitForFuture(
+      asyncSystem,
+      reader.loadGltf(
+          asyncSystem,
+          "file:///CesiumMilkTruck.gltf",
+          {},
+          pMockAssetAccessor,
+          options));
+
+  REQUIRE(separate.model);
+  REQUIRE(interleaved.model);
+  const Model& model = *interleaved.model;
+  REQUIRE(model.meshes.size() == separate.model->meshes.size());
+
+  for (size_t i = 0; i < model.meshes.size(); ++i) {
+    for (const MeshPrimitive& primitive : model.meshes[i].primitives) {
+      CHECK(!primitive.getExtension<ExtensionKhrDracoMeshCompression>());
+
+      const BufferView& indicesBufferView = Model::getSafe(
+          model.bufferViews,
+          Model::getSafe(model.accessors, primitive.indices).bufferView);
+
+      int32_t vertexBufferView = -1;
+      for (const auto& [name, accessorIndex] : primitive.attributes) {
+        const Accessor& accessor =
+            Model::getSafe(model.accessors, accessorIndex);
+        if (vertexBufferView < 0) {
+          vertexBufferView = accessor.bufferView;
+        }
+        CHECK(accessor.bufferView == vertexBufferView);
+      }
+
+      const BufferView& bufferView =
+          Model::getSafe(model.bufferViews, vertexBufferView);
+      CHECK(bufferView.buffer == indicesBufferView.buffer);
+      REQUIRE(bufferView.byteStride);
+      CHECK(*bufferView.byteStride % 4 == 0);
+
+      AccessorView<glm::vec3> positions(
+          model,
+          primitive.attributes.at("POSITION"));
+      AccessorView<glm::vec3> expectedPositions(
+          *separate.model,
+          primitive.attributes.at("POSITION"));
+      REQUIRE(positions.status() == AccessorViewStatus::Valid);
+      REQUIRE(expectedPositions.status() == AccessorViewStatus::Valid);
+      REQUIRE(positions.size() == expectedPositions.size());
+      for (int64_t j = 0; j < positions.size(); ++j) {
+        CHECK(positions[j] == expectedPositions[j]);
+      }
+    }
+  }
+}
+
+TEST_CASE("GltfReader::generateMipMaps") {
+  ImageCesium image;
+  image.width = 4;
+  image.height = 2;
+  image.channels = 1;
+  image.bytesPerChannel = 1;
+  for (int value : {0, 4, 8, 12, 16, 20, 24, 28}) {
+    image.pixelData.emplace_back(std::byte(value));
+  }
+
+  CHECK(!GltfReader::generateMipMaps(image));
+
+  REQUIRE(image.mipPositions.size() == 3);
+  CHECK(image.mipPositions[1].byteOffset == 8);
+  CHECK(image.mipPositions[1].byteSize == 2);
+  CHECK(image.mipPositions[2].byteOffset == 10);
+  CHECK(image.mipPositions[2].byteSize == 1);
+
+  // Each level averages 2x2 blocks of the one before, and a dimension of 1
+  // stays 1.
+  const std::vector<std::byte> expected{
+      std::byte(10),
+      std::byte(18),
+      std::byte(14)};
+  CHECK(
+      std::vector<std::byte>(
+          image.pixelData.begin() + 8,
+          image.pixelData.end()) == expected);
 }
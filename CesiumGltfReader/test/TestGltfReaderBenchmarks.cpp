@@ -0,0 +1,102 @@
+#include "CesiumGltfReader/GltfReader.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumNativeTests/DecodeBenchmark.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace CesiumGltfReader;
+using namespace CesiumNativeTests;
+
+namespace {
+DecodeBenchmarkItem
+createGlbItem(const std::string& name, const std::string& filename) {
+  const std::filesystem::path path =
+      std::filesystem::path(CesiumGltfReader_TEST_DATA_DIR) / filename;
+  return DecodeBenchmarkItem{
+      name,
+      readFile(path),
+      [](const std::vector<std::byte>& data) {
+        GltfReader reader;
+        GltfReaderResult result = reader.readGltf(data);
+        return result.model && result.errors.empty();
+      }};
+}
+
+// Loads a glTF with external buffers and images. The files are read into
+// memory up front, so that only decoding is measured.
+DecodeBenchmarkItem
+createGltfItem(const std::string& name, const std::string& filename) {
+  const std::filesystem::path path =
+      std::filesystem::path(CesiumGltfReader_TEST_DATA_DIR) / filename;
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+  size_t externalByteLength = 0;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(path.parent_path())) {
+    if (!entry.is_regular_file()) {
+      continue;
+    }
+
+    std::vector<std::byte> data = readFile(entry.path());
+    if (entry.path() != path) {
+      externalByteLength += data.size();
+    }
+    const std::string url = "file:///" + entry.path().generic_u8string();
+    requests.emplace(
+        url,
+        std::make_shared<SimpleAssetRequest>(
+            "GET",
+            url,
+            HttpHeaders{},
+            std::make_unique<SimpleAssetResponse>(
+                static_cast<uint16_t>(200),
+                "application/binary",
+                HttpHeaders{},
+                std::move(data))));
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> pAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(requests));
+  const std::string url = "file:///" + path.generic_u8string();
+  DecodeBenchmarkItem item{
+      name,
+      readFile(path),
+      [pAccessor, url](const std::vector<std::byte>& /* data */) {
+        AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+        GltfReader reader;
+        GltfReaderResult result =
+            reader.loadGltf(asyncSystem, url, {}, pAccessor).wait();
+        return result.model && result.errors.empty();
+      }};
+  item.externalByteLength = externalByteLength;
+  return item;
+}
+} // namespace
+
+TEST_CASE("Benchmark GltfReader::readGltf", "[.][benchmark]") {
+  benchmarkDecoding(
+      {createGlbItem("PNG, Duck.glb", "DucksMeshopt/Duck.glb"),
+       createGlbItem(
+           "meshopt and PNG, Duck-vp-12-vt-12-vn-12.glb",
+           "DucksMeshopt/Duck-vp-12-vt-12-vn-12.glb"),
+       createGlbItem("JPEG, CesiumBalloon.glb", "CesiumBalloon.glb"),
+       createGlbItem("KTX2, CesiumBalloonKTX2.glb", "CesiumBalloonKTX2.glb"),
+       createGltfItem(
+           "WebP, BoxTexturedWebp.gltf",
+           "BoxTexturedWebp/glTF/BoxTexturedWebp.gltf"),
+       createGltfItem(
+           "Draco and PNG, CesiumMilkTruck.gltf",
+           "DracoCompressed/CesiumMilkTruck.gltf")});
+}
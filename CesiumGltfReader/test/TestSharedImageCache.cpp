@@ -0,0 +1,164 @@
+#include "CesiumGltfReader/GltfReader.h"
+#include "CesiumGltfReader/SharedImageCache.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumNativeTests/readFile.h>
+#include <CesiumNativeTests/waitForFuture.h>
+
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace CesiumGltf;
+using namespace CesiumGltfReader;
+using namespace CesiumNativeTests;
+
+namespace {
+class CountingAssetAccessor : public SimpleAssetAccessor {
+public:
+  using SimpleAssetAccessor::SimpleAssetAccessor;
+
+  virtual Future<std::shared_ptr<IAssetRequest>>
+  get(const AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    ++this->getCount;
+    return SimpleAssetAccessor::get(asyncSystem, url, headers);
+  }
+
+  int getCount = 0;
+};
+
+std::shared_ptr<SimpleAssetRequest>
+createRequest(const std::string& url, uint16_t statusCode) {
+  const std::vector<std::byte> data =
+      readFile(std::filesystem::path(CesiumGltfReader_TEST_DATA_DIR) /
+               "ktx2" / "kota.jpg");
+  return std::make_shared<SimpleAssetRequest>(
+      "GET",
+      url,
+      HttpHeaders{},
+      std::make_unique<SimpleAssetResponse>(
+          statusCode,
+          "image/jpeg",
+          HttpHeaders{},
+          data));
+}
+} // namespace
+
+TEST_CASE("SharedImageCache") {
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+  requests.emplace("a.jpg", createRequest("a.jpg", 200));
+  requests.emplace("b.jpg", createRequest("b.jpg", 200));
+  requests.emplace("missing.jpg", createRequest("missing.jpg", 404));
+  std::shared_ptr<CountingAssetAccessor> pAccessor =
+      std::make_shared<CountingAssetAccessor>(std::move(requests));
+  std::shared_ptr<SharedImageCache> pCache =
+      std::make_shared<SharedImageCache>();
+  const std::vector<IAssetAccessor::THeader> headers;
+  const Ktx2TranscodeTargets targets;
+
+  SECTION("fetches and decodes each URL once") {
+    std::shared_ptr<const SharedImage> pFirst =
+        pCache->getOrLoad(asyncSystem, pAccessor, "a.jpg", headers, targets, 0)
+            .wait();
+    std::shared_ptr<const SharedImage> pSecond =
+        pCache->getOrLoad(asyncSystem, pAccessor, "a.jpg", headers, targets, 0)
+            .wait();
+    REQUIRE(pFirst);
+    CHECK(pFirst == pSecond);
+    CHECK(pFirst->image.width > 0);
+    CHECK(pAccessor->getCount == 1);
+    CHECK(pCache->size() == 1);
+    CHECK(
+        pCache->getTotalBytes() ==
+        static_cast<int64_t>(pFirst->image.pixelData.size()));
+
+    // Another maximum size is another image.
+    std::shared_ptr<const SharedImage> pSmaller =
+        pCache->getOrLoad(asyncSystem, pAccessor, "a.jpg", headers, targets, 8)
+            .wait();
+    REQUIRE(pSmaller);
+    CHECK(pSmaller->key != pFirst->key);
+    CHECK(pSmaller->image.width <= 8);
+    CHECK(pAccessor->getCount == 2);
+  }
+
+  SECTION("shares the images of URLs with the same content") {
+    std::shared_ptr<const SharedImage> pA =
+        pCache->getOrLoad(asyncSystem, pAccessor, "a.jpg", headers, targets, 0)
+            .wait();
+    std::shared_ptr<const SharedImage> pB =
+        pCache->getOrLoad(asyncSystem, pAccessor, "b.jpg", headers, targets, 0)
+            .wait();
+    REQUIRE(pA);
+    CHECK(pA == pB);
+    CHECK(pCache->size() == 2);
+  }
+
+  SECTION("forgets images that fail to load") {
+    CHECK(!pCache
+               ->getOrLoad(
+                   asyncSystem,
+                   pAccessor,
+                   "missing.jpg",
+                   headers,
+                   targets,
+                   0)
+               .wait());
+    CHECK(pCache->size() == 0);
+  }
+
+  SECTION("evicts the least recently used images") {
+    pCache = std::make_shared<SharedImageCache>(1);
+    pCache->getOrLoad(asyncSystem, pAccessor, "a.jpg", headers, targets, 0)
+        .wait();
+    CHECK(pCache->size() == 0);
+    CHECK(pCache->getTotalBytes() == 0);
+  }
+
+  SECTION("resolves the external images of a model") {
+    GltfReaderResult result;
+    result.model.emplace();
+    result.model->images.emplace_back().uri = "a.jpg";
+    result.model->images.emplace_back().uri = "b.jpg";
+
+    GltfReaderOptions options;
+    options.pSharedImageCache = pCache;
+    GltfReaderResult resolved = waitForFuture(
+        asyncSystem,
+        GltfReader::resolveExternalData(
+            asyncSystem,
+            "",
+            HttpHeaders{},
+            pAccessor,
+            options,
+            std::move(result)));
+
+    REQUIRE(resolved.model);
+    CHECK(resolved.warnings.empty());
+    CHECK(pAccessor->getCount == 2);
+
+    std::vector<std::string> keys;
+    for (const Image& image : resolved.model->images) {
+      CHECK(!image.uri);
+      CHECK(image.cesium.width > 0);
+      const auto it = image.extras.find(SharedImageCache::ExtrasKey);
+      REQUIRE(it != image.extras.end());
+      REQUIRE(it->second.isString());
+      keys.emplace_back(it->second.getString());
+    }
+
+    // Both images have the same content, so they share a key.
+    REQUIRE(keys.size() == 2);
+    CHECK(keys[0] == keys[1]);
+  }
+}
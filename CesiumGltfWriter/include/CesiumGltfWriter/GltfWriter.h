@@ -2,10 +2,18 @@
 
 #include "CesiumGltfWriter/Library.h"
 
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/Future.h>
 #include <CesiumJsonWriter/ExtensionWriterContext.h>
+#include <CesiumJsonWriter/ReusableJsonWriter.h>
 
 #include <gsl/span>
 
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
 // forward declarations
 namespace CesiumGltf {
 struct Model;
@@ -34,6 +42,36 @@ struct CESIUMGLTFWRITER_API GltfWriterResult {
   std::vector<std::string> warnings;
 };
 
+/**
+ * @brief How the meshes of a glb written by {@link GltfWriter::writeGlb} are
+ * compressed.
+ */
+enum class GltfMeshCompression {
+  /**
+   * @brief The mesh data is written as it is.
+   */
+  None,
+
+  /**
+   * @brief Each indexed triangle primitive is encoded with Draco, as
+   * described by the `KHR_draco_mesh_compression` extension.
+   *
+   * Draco quantizes the floating-point attributes itself, with the numbers of
+   * bits in the {@link GltfWriterOptions}, so the attributes are not
+   * quantized with `KHR_mesh_quantization` in addition.
+   */
+  Draco,
+
+  /**
+   * @brief Each buffer view of vertex attributes or indices is encoded with
+   * meshoptimizer, as described by the `EXT_meshopt_compression` extension.
+   *
+   * This is lossless, so it is best combined with
+   * {@link GltfWriterOptions::quantizeMeshes}.
+   */
+  Meshopt
+};
+
 /**
  * @brief Options for how to write a glTF.
  */
@@ -49,8 +87,80 @@ struct CESIUMGLTFWRITER_API GltfWriterOptions {
    * EXT_mesh_features this value should be set to 8.
    */
   size_t binaryChunkByteAlignment = 4;
+
+  /**
+   * @brief The writer to write the JSON with, so that its memory is reused
+   * from one model to the next. If nullptr, a new writer is created for each
+   * model.
+   *
+   * The writer must not be used by another thread at the same time.
+   */
+  CesiumJsonWriter::ReusableJsonWriter* pJsonWriter = nullptr;
+
+  /**
+   * @brief How to compress the meshes of a glb.
+   *
+   * Only the data in the binary chunk is compressed. The model that is passed
+   * to {@link GltfWriter::writeGlb} is not modified; it is copied, and the
+   * copy is written in place of it. Primitives and buffer views that can't be
+   * compressed, for example because their accessors are shared with other
+   * primitives, are written as they are. {@link GltfWriter::writeGltf} ignores
+   * this option.
+   */
+  GltfMeshCompression meshCompression = GltfMeshCompression::None;
+
+  /**
+   * @brief Whether to store the normals, tangents, texture coordinates and
+   * positions of the meshes of a glb in smaller integer types, as allowed by
+   * the `KHR_mesh_quantization` extension.
+   *
+   * Normals and tangents are stored in 8-bit normalized integers and texture
+   * coordinates between 0.0 and 1.0 in 16-bit normalized integers. Positions
+   * are stored in 16-bit integers, and the node that renders the mesh is
+   * given a child with the transform that restores them, so this is skipped
+   * for meshes with morph targets or that are skinned or instanced. This is
+   * ignored with {@link GltfMeshCompression::Draco}.
+   */
+  bool quantizeMeshes = false;
+
+  /**
+   * @brief The Draco compression level, from 0 for the fastest decoding to 10
+   * for the smallest output.
+   */
+  int32_t dracoCompressionLevel = 7;
+
+  /**
+   * @brief The number of bits that Draco quantizes positions to.
+   */
+  int32_t dracoPositionQuantizationBits = 14;
+
+  /**
+   * @brief The number of bits that Draco quantizes normals to.
+   */
+  int32_t dracoNormalQuantizationBits = 10;
+
+  /**
+   * @brief The number of bits that Draco quantizes texture coordinates to.
+   */
+  int32_t dracoTexCoordQuantizationBits = 12;
+
+  /**
+   * @brief The number of bits that Draco quantizes colors and all other
+   * floating-point attributes to.
+   */
+  int32_t dracoGenericQuantizationBits = 12;
 };
 
+/**
+ * @brief Receives the bytes of a GLB, in order, as they are written by
+ * {@link GltfWriter::writeGlb}.
+ *
+ * The bytes are only valid during the call. Returns false if they could not
+ * be written, which stops the writing.
+ */
+using GltfWriterOutput =
+    std::function<bool(const gsl::span<const std::byte>& bytes)>;
+
 /**
  * @brief Writes glTF.
  */
@@ -105,6 +215,54 @@ public:
       const gsl::span<const std::byte>& bufferData,
       const GltfWriterOptions& options = GltfWriterOptions()) const;
 
+  /**
+   * @brief Serializes the provided model as a glb, passing its bytes to an
+   * output as they are written instead of collecting them in a vector.
+   *
+   * @details The JSON is written first, so that the chunk lengths in the
+   * headers are known. Then the headers, the JSON and the buffer data are
+   * passed to the output without being copied, so writing a large model to a
+   * file or a socket needs little memory beyond the model itself. The
+   * {@link GltfWriterResult::gltfBytes} of the result are empty.
+   *
+   * @param model The model.
+   * @param bufferData The buffer data to store in the GLB binary chunk.
+   * @param output The function that receives the bytes of the glb.
+   * @param options Options for how to write the glb.
+   * @return The result of writing the glb. If the output fails, it has an
+   * error.
+   */
+  GltfWriterResult writeGlb(
+      const CesiumGltf::Model& model,
+      const gsl::span<const std::byte>& bufferData,
+      const GltfWriterOutput& output,
+      const GltfWriterOptions& options = GltfWriterOptions()) const;
+
+  /**
+   * @brief Serializes many models into glbs, in parallel in worker threads.
+   *
+   * @details Each model is written as by {@link writeGlb}, with the data of
+   * its first buffer as the binary chunk. The worker threads reuse their JSON
+   * writers from one model to the next, so
+   * {@link GltfWriterOptions::pJsonWriter} is ignored.
+   *
+   * When {@link GltfWriterOptions::meshCompression} is set, the primitives
+   * or buffer views of each model are encoded in parallel too.
+   *
+   * The models and this writer must not be modified or destroyed until the
+   * returned future resolves.
+   *
+   * @param asyncSystem The async system to use for the writing.
+   * @param models The models.
+   * @param options Options for how to write the glbs.
+   * @return A future that resolves to the result of writing each model, in
+   * the same order as the models.
+   */
+  CesiumAsync::Future<std::vector<GltfWriterResult>> writeGlbs(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::vector<const CesiumGltf::Model*>& models,
+      const GltfWriterOptions& options = GltfWriterOptions()) const;
+
 private:
   CesiumJsonWriter::ExtensionWriterContext _context;
 };
@@ -1,12 +1,26 @@
 #include "CesiumGltfWriter/GltfWriter.h"
 
 #include "ModelJsonWriter.h"
+#include "encodeDraco.h"
+#include "encodeMeshOpt.h"
+#include "quantizeMeshData.h"
 #include "registerWriterExtensions.h"
 
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumGltf/Model.h>
 #include <CesiumJsonWriter/JsonWriter.h>
 #include <CesiumJsonWriter/PrettyJsonWriter.h>
 #include <CesiumUtility/Tracing.h>
 
+#include <array>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace CesiumGltfWriter {
 
 namespace {
@@ -19,96 +33,311 @@ getPadding(size_t byteCount, size_t byteAlignment) noexcept {
   return padding;
 }
 
-void writeGlbBuffer(
-    GltfWriterResult& result,
-    const gsl::span<const std::byte>& jsonData,
-    const gsl::span<const std::byte>& bufferData,
+// The sizes of the chunks of a GLB, with their padding.
+struct GlbLayout {
+  size_t jsonChunkDataSize;
+  size_t binaryChunkDataSize;
+  size_t glbSize;
+};
+
+const size_t glbHeaderSize = 12;
+const size_t glbChunkHeaderSize = 8;
+
+GlbLayout computeGlbLayout(
+    size_t jsonSize,
+    size_t bufferSize,
     size_t binaryChunkByteAlignment) {
   assert(binaryChunkByteAlignment > 0 && binaryChunkByteAlignment % 4 == 0);
 
-  size_t headerSize = 12;
-  size_t chunkHeaderSize = 8;
+  GlbLayout layout{};
+  layout.jsonChunkDataSize =
+      jsonSize + getPadding(glbHeaderSize + glbChunkHeaderSize + jsonSize, 4);
+  layout.glbSize =
+      glbHeaderSize + glbChunkHeaderSize + layout.jsonChunkDataSize;
+
+  if (bufferSize > 0) {
+    const size_t extraJsonPadding = getPadding(
+        layout.glbSize + glbChunkHeaderSize,
+        binaryChunkByteAlignment);
+    layout.jsonChunkDataSize += extraJsonPadding;
+    layout.glbSize += extraJsonPadding;
+
+    layout.binaryChunkDataSize =
+        bufferSize +
+        getPadding(layout.glbSize + glbChunkHeaderSize + bufferSize, 4);
+    layout.glbSize += glbChunkHeaderSize + layout.binaryChunkDataSize;
+  }
+
+  return layout;
+}
 
-  size_t jsonPaddingSize =
-      getPadding(headerSize + chunkHeaderSize + jsonData.size(), 4);
-  size_t jsonChunkDataSize = jsonData.size() + jsonPaddingSize;
-  size_t glbSize = headerSize + chunkHeaderSize + jsonChunkDataSize;
+// GLB stores its own length as a uint32. So if that would be >= 4GB , we
+// can't output a valid GLB.
+bool checkGlbSize(GltfWriterResult& result, const GlbLayout& layout) {
+  if (layout.glbSize > size_t(std::numeric_limits<uint32_t>::max())) {
+    result.errors.emplace_back(
+        "glTF is too large to represent as a binary glTF (GLB). The total size "
+        "of the GLB must be less than 4GB.");
+    return false;
+  }
+  return true;
+}
 
-  size_t binaryPaddingSize = 0;
-  size_t binaryChunkDataSize = 0;
+void writeUint32(std::byte* pOut, size_t value) {
+  const uint32_t value32 = static_cast<uint32_t>(value);
+  memcpy(pOut, &value32, sizeof(value32));
+}
 
-  if (bufferData.size() > 0) {
-    size_t extraJsonPadding =
-        getPadding(glbSize + chunkHeaderSize, binaryChunkByteAlignment);
-    if (extraJsonPadding > 0) {
-      jsonPaddingSize += extraJsonPadding;
-      jsonChunkDataSize += extraJsonPadding;
-      glbSize += extraJsonPadding;
+void writeChunkHeader(std::byte* pOut, size_t chunkDataSize, const char* type) {
+  writeUint32(pOut, chunkDataSize);
+  memcpy(pOut + 4, type, 4);
+}
+
+// Passes the GLB to the output in pieces, so that neither the JSON nor the
+// binary chunk is copied.
+bool writeGlbChunks(
+    const GlbLayout& layout,
+    const gsl::span<const std::byte>& jsonData,
+    const gsl::span<const std::byte>& bufferData,
+    const GltfWriterOutput& output) {
+  auto write = [&output](const gsl::span<const std::byte>& bytes) {
+    return bytes.empty() || output(bytes);
+  };
+
+  // GLB header and JSON chunk header
+  std::array<std::byte, glbHeaderSize + glbChunkHeaderSize> header{};
+  memcpy(header.data(), "glTF", 4);
+  writeUint32(header.data() + 4, 2);
+  writeUint32(header.data() + 8, layout.glbSize);
+  writeChunkHeader(
+      header.data() + glbHeaderSize,
+      layout.jsonChunkDataSize,
+      "JSON");
+
+  // JSON chunk padding
+  const std::vector<std::byte> jsonPadding(
+      layout.jsonChunkDataSize - jsonData.size(),
+      std::byte(' '));
+
+  if (!write(header) || !write(jsonData) || !write(jsonPadding)) {
+    return false;
+  }
+
+  if (bufferData.empty()) {
+    return true;
+  }
+
+  // Binary chunk header
+  std::array<std::byte, glbChunkHeaderSize> binaryHeader{};
+  writeChunkHeader(binaryHeader.data(), layout.binaryChunkDataSize, "BIN\0");
+
+  // Binary chunk padding
+  const std::vector<std::byte> binaryPadding(
+      layout.binaryChunkDataSize - bufferData.size(),
+      std::byte(0));
+
+  return write(binaryHeader) && write(bufferData) && write(binaryPadding);
+}
+
+// Writes the JSON of the model with the reusable writer in the options, or
+// with a new one that is put in pNewWriter.
+CesiumJsonWriter::JsonWriter& writeModelJson(
+    const CesiumGltf::Model& model,
+    const GltfWriterOptions& options,
+    const CesiumJsonWriter::ExtensionWriterContext& context,
+    std::unique_ptr<CesiumJsonWriter::JsonWriter>& pNewWriter) {
+  CesiumJsonWriter::JsonWriter* pWriter = nullptr;
+
+  if (options.pJsonWriter) {
+    pWriter = &options.pJsonWriter->getWriter(options.prettyPrint);
+  } else {
+    if (options.prettyPrint) {
+      pNewWriter = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
+    } else {
+      pNewWriter = std::make_unique<CesiumJsonWriter::JsonWriter>();
     }
+    pWriter = pNewWriter.get();
+  }
+
+  ModelJsonWriter::write(model, *pWriter, context);
+  return *pWriter;
+}
 
-    binaryPaddingSize =
-        getPadding(glbSize + chunkHeaderSize + bufferData.size(), 4);
-    binaryChunkDataSize = bufferData.size() + binaryPaddingSize;
-    glbSize += chunkHeaderSize + binaryChunkDataSize;
+// The JSON writers of the worker threads of a batch. Each task takes one
+// while it writes, so there are at most as many as there are threads.
+class ReusableJsonWriterPool {
+public:
+  std::unique_ptr<CesiumJsonWriter::ReusableJsonWriter> acquire() {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    if (this->_writers.empty()) {
+      return std::make_unique<CesiumJsonWriter::ReusableJsonWriter>();
+    }
+    std::unique_ptr<CesiumJsonWriter::ReusableJsonWriter> pWriter =
+        std::move(this->_writers.back());
+    this->_writers.pop_back();
+    return pWriter;
   }
 
-  // GLB stores its own length as a uint32. So if that would be >= 4GB , we
-  // can't output a valid GLB.
-  if (glbSize > size_t(std::numeric_limits<uint32_t>::max())) {
-    result.errors.emplace_back(
-        "glTF is too large to represent as a binary glTF (GLB). The total size "
-        "of the GLB must be less than 4GB.");
-    return;
-  }
-
-  std::vector<std::byte>& glb = result.gltfBytes;
-  glb.resize(glbSize);
-  uint8_t* glb8 = reinterpret_cast<uint8_t*>(glb.data());
-  uint32_t* glb32 = reinterpret_cast<uint32_t*>(glb.data());
-
-  // GLB header
-  size_t byteOffset = 0;
-  glb8[byteOffset++] = 'g';
-  glb8[byteOffset++] = 'l';
-  glb8[byteOffset++] = 'T';
-  glb8[byteOffset++] = 'F';
-  glb32[byteOffset / 4] = 2;
-  byteOffset += 4;
-  glb32[byteOffset / 4] = static_cast<uint32_t>(glbSize);
-  byteOffset += 4;
-
-  // JSON chunk header
-  glb32[byteOffset / 4] = static_cast<uint32_t>(jsonChunkDataSize);
-  byteOffset += 4;
-  glb8[byteOffset++] = 'J';
-  glb8[byteOffset++] = 'S';
-  glb8[byteOffset++] = 'O';
-  glb8[byteOffset++] = 'N';
-
-  // JSON chunk
-  memcpy(glb8 + byteOffset, jsonData.data(), jsonData.size());
-  byteOffset += jsonData.size();
+  void
+  release(std::unique_ptr<CesiumJsonWriter::ReusableJsonWriter>&& pWriter) {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_writers.emplace_back(std::move(pWriter));
+  }
 
-  // JSON chunk padding
-  memset(glb8 + byteOffset, ' ', jsonPaddingSize);
-  byteOffset += jsonPaddingSize;
+private:
+  std::mutex _mutex;
+  std::vector<std::unique_ptr<CesiumJsonWriter::ReusableJsonWriter>> _writers;
+};
+
+void addJsonErrorsAndWarnings(
+    GltfWriterResult& result,
+    const CesiumJsonWriter::JsonWriter& writer) {
+  result.errors.insert(
+      result.errors.end(),
+      writer.getErrors().begin(),
+      writer.getErrors().end());
+
+  result.warnings.insert(
+      result.warnings.end(),
+      writer.getWarnings().begin(),
+      writer.getWarnings().end());
+}
+
+gsl::span<const std::byte>
+getJsonBytes(CesiumJsonWriter::JsonWriter& writer) {
+  const std::string_view json = writer.toStringView();
+  return gsl::span<const std::byte>(
+      reinterpret_cast<const std::byte*>(json.data()),
+      json.size());
+}
+
+bool shouldCompressMeshes(const GltfWriterOptions& options) {
+  return options.meshCompression != GltfMeshCompression::None ||
+         options.quantizeMeshes;
+}
+
+GltfWriterOptions withoutMeshCompression(const GltfWriterOptions& options) {
+  GltfWriterOptions result = options;
+  result.meshCompression = GltfMeshCompression::None;
+  result.quantizeMeshes = false;
+  return result;
+}
+
+gsl::span<const std::byte> getBufferData(const CesiumGltf::Model& model) {
+  if (model.buffers.empty()) {
+    return {};
+  }
+  return model.buffers[0].cesium.data;
+}
+
+// The mesh compression of a glb. Compressing rewrites the buffers, so it's
+// done to a copy of the model, with the binary chunk data in its first
+// buffer. Like the decodes of the reader, the encodes only read the copy and
+// write to their own results, so they can be done in parallel with each
+// other. The results are copied into the model afterward.
+struct PendingCompression {
+  CesiumGltf::Model model;
+  std::vector<DracoPrimitive> dracoPrimitives;
+  std::vector<MeshOptBufferView> meshOptBufferViews;
+  std::vector<std::string> warnings;
+
+  // Copies the model, quantizes it and finds what needs to be encoded.
+  void start(
+      const CesiumGltf::Model& sourceModel,
+      const gsl::span<const std::byte>& bufferData,
+      const GltfWriterOptions& options) {
+    CESIUM_TRACE("CesiumGltfWriter::startMeshCompression");
+
+    this->model = sourceModel;
+    if (this->model.buffers.empty()) {
+      return;
+    }
+
+    CesiumGltf::Buffer& buffer = this->model.buffers[0];
+    buffer.cesium.data.assign(bufferData.begin(), bufferData.end());
+    buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+
+    if (options.meshCompression == GltfMeshCompression::Draco) {
+      this->dracoPrimitives = findDracoPrimitives(this->model);
+      return;
+    }
+
+    if (options.quantizeMeshes) {
+      quantizeMeshData(this->model);
+    }
+
+    if (options.meshCompression == GltfMeshCompression::Meshopt) {
+      this->meshOptBufferViews = findMeshOptBufferViews(this->model);
+    }
+  }
+
+  size_t size() const noexcept {
+    return this->dracoPrimitives.size() + this->meshOptBufferViews.size();
+  }
 
-  if (bufferData.size() > 0) {
-    // Binary chunk header
-    glb32[byteOffset / 4] = static_cast<uint32_t>(binaryChunkDataSize);
-    byteOffset += 4;
-    glb8[byteOffset++] = 'B';
-    glb8[byteOffset++] = 'I';
-    glb8[byteOffset++] = 'N';
-    glb8[byteOffset++] = 0;
+  // Does the encode with the given index, counting across both vectors.
+  // Encodes with different indices may be done concurrently.
+  void encode(size_t index, const GltfWriterOptions& options) {
+    if (index < this->dracoPrimitives.size()) {
+      this->dracoPrimitives[index].encode(this->model, options);
+      return;
+    }
+    index -= this->dracoPrimitives.size();
 
-    // Binary chunk
-    memcpy(glb8 + byteOffset, bufferData.data(), bufferData.size());
-    byteOffset += bufferData.size();
+    this->meshOptBufferViews[index].encode(this->model);
+  }
 
-    // Binary chunk padding
-    memset(glb8 + byteOffset, 0, binaryPaddingSize);
+  void finish() {
+    if (!this->dracoPrimitives.empty()) {
+      applyEncodedDraco(this->model, this->dracoPrimitives, this->warnings);
+    }
+    if (!this->meshOptBufferViews.empty()) {
+      applyEncodedMeshOpt(
+          this->model,
+          this->meshOptBufferViews,
+          this->warnings);
+    }
   }
+};
+
+void addCompressionWarnings(
+    GltfWriterResult& result,
+    const PendingCompression& compression) {
+  result.warnings.insert(
+      result.warnings.begin(),
+      compression.warnings.begin(),
+      compression.warnings.end());
+}
+
+// Encodes on this thread, for a single glb.
+void compressMeshes(
+    PendingCompression& compression,
+    const CesiumGltf::Model& model,
+    const gsl::span<const std::byte>& bufferData,
+    const GltfWriterOptions& options) {
+  compression.start(model, bufferData, options);
+  for (size_t i = 0; i < compression.size(); ++i) {
+    compression.encode(i, options);
+  }
+  compression.finish();
+}
+
+// Writes a glb of one of a batch of models with a JSON writer from the pool.
+GltfWriterResult writePooledGlb(
+    const GltfWriter& gltfWriter,
+    const CesiumGltf::Model& model,
+    const gsl::span<const std::byte>& bufferData,
+    const GltfWriterOptions& options,
+    ReusableJsonWriterPool& pool) {
+  std::unique_ptr<CesiumJsonWriter::ReusableJsonWriter> pJsonWriter =
+      pool.acquire();
+  GltfWriterOptions modelOptions = options;
+  modelOptions.pJsonWriter = pJsonWriter.get();
+
+  GltfWriterResult result =
+      gltfWriter.writeGlb(model, bufferData, modelOptions);
+  pool.release(std::move(pJsonWriter));
+  return result;
 }
 } // namespace
 
@@ -132,60 +361,184 @@ GltfWriterResult GltfWriter::writeGltf(
       this->getExtensions();
 
   GltfWriterResult result;
-  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer;
+  std::unique_ptr<CesiumJsonWriter::JsonWriter> pNewWriter;
+  CesiumJsonWriter::JsonWriter& writer =
+      writeModelJson(model, options, context, pNewWriter);
+  result.gltfBytes = writer.toBytes();
+  result.errors = writer.getErrors();
+  result.warnings = writer.getWarnings();
 
-  if (options.prettyPrint) {
-    writer = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
-  } else {
-    writer = std::make_unique<CesiumJsonWriter::JsonWriter>();
+  return result;
+}
+
+GltfWriterResult GltfWriter::writeGlb(
+    const CesiumGltf::Model& model,
+    const gsl::span<const std::byte>& bufferData,
+    const GltfWriterOptions& options) const {
+  CESIUM_TRACE("GltfWriter::writeGlb");
+
+  if (shouldCompressMeshes(options)) {
+    PendingCompression compression;
+    compressMeshes(compression, model, bufferData, options);
+    GltfWriterResult result = this->writeGlb(
+        compression.model,
+        getBufferData(compression.model),
+        withoutMeshCompression(options));
+    addCompressionWarnings(result, compression);
+    return result;
   }
 
-  ModelJsonWriter::write(model, *writer, context);
-  result.gltfBytes = writer->toBytes();
-  result.errors = writer->getErrors();
-  result.warnings = writer->getWarnings();
+  std::unique_ptr<CesiumJsonWriter::JsonWriter> pNewWriter;
+  CesiumJsonWriter::JsonWriter& writer =
+      writeModelJson(model, options, this->getExtensions(), pNewWriter);
+  const gsl::span<const std::byte> jsonData = getJsonBytes(writer);
 
+  GltfWriterResult result;
+  const GlbLayout layout = computeGlbLayout(
+      jsonData.size(),
+      bufferData.size(),
+      options.binaryChunkByteAlignment);
+  if (checkGlbSize(result, layout)) {
+    std::vector<std::byte>& glb = result.gltfBytes;
+    glb.reserve(layout.glbSize);
+    writeGlbChunks(
+        layout,
+        jsonData,
+        bufferData,
+        [&glb](const gsl::span<const std::byte>& bytes) {
+          glb.insert(glb.end(), bytes.begin(), bytes.end());
+          return true;
+        });
+  }
+
+  addJsonErrorsAndWarnings(result, writer);
   return result;
 }
 
 GltfWriterResult GltfWriter::writeGlb(
     const CesiumGltf::Model& model,
     const gsl::span<const std::byte>& bufferData,
+    const GltfWriterOutput& output,
     const GltfWriterOptions& options) const {
   CESIUM_TRACE("GltfWriter::writeGlb");
 
-  const CesiumJsonWriter::ExtensionWriterContext& context =
-      this->getExtensions();
+  if (shouldCompressMeshes(options)) {
+    PendingCompression compression;
+    compressMeshes(compression, model, bufferData, options);
+    GltfWriterResult result = this->writeGlb(
+        compression.model,
+        getBufferData(compression.model),
+        output,
+        withoutMeshCompression(options));
+    addCompressionWarnings(result, compression);
+    return result;
+  }
 
-  GltfWriterResult result;
-  std::unique_ptr<CesiumJsonWriter::JsonWriter> writer;
+  std::unique_ptr<CesiumJsonWriter::JsonWriter> pNewWriter;
+  CesiumJsonWriter::JsonWriter& writer =
+      writeModelJson(model, options, this->getExtensions(), pNewWriter);
+  const gsl::span<const std::byte> jsonData = getJsonBytes(writer);
 
-  if (options.prettyPrint) {
-    writer = std::make_unique<CesiumJsonWriter::PrettyJsonWriter>();
-  } else {
-    writer = std::make_unique<CesiumJsonWriter::JsonWriter>();
+  GltfWriterResult result;
+  const GlbLayout layout = computeGlbLayout(
+      jsonData.size(),
+      bufferData.size(),
+      options.binaryChunkByteAlignment);
+  if (checkGlbSize(result, layout) &&
+      !writeGlbChunks(layout, jsonData, bufferData, output)) {
+    result.errors.emplace_back("The GLB could not be written to the output.");
   }
 
-  ModelJsonWriter::write(model, *writer, context);
-  std::vector<std::byte> jsonData = writer->toBytes();
+  addJsonErrorsAndWarnings(result, writer);
+  return result;
+}
 
-  writeGlbBuffer(
-      result,
-      gsl::span(jsonData),
-      bufferData,
-      options.binaryChunkByteAlignment);
+CesiumAsync::Future<std::vector<GltfWriterResult>> GltfWriter::writeGlbs(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::vector<const CesiumGltf::Model*>& models,
+    const GltfWriterOptions& options) const {
+  std::shared_ptr<ReusableJsonWriterPool> pPool =
+      std::make_shared<ReusableJsonWriterPool>();
+
+  std::vector<CesiumAsync::Future<GltfWriterResult>> futures;
+  futures.reserve(models.size());
+
+  if (!shouldCompressMeshes(options)) {
+    for (const CesiumGltf::Model* pModel : models) {
+      futures.emplace_back(
+          asyncSystem.runInWorkerThread([this, pModel, options, pPool]() {
+            return writePooledGlb(
+                *this,
+                *pModel,
+                getBufferData(*pModel),
+                options,
+                *pPool);
+          }));
+    }
 
-  result.errors.insert(
-      result.errors.end(),
-      writer->getErrors().begin(),
-      writer->getErrors().end());
+    return asyncSystem.all(std::move(futures));
+  }
 
-  result.warnings.insert(
-      result.warnings.end(),
-      writer->getWarnings().begin(),
-      writer->getWarnings().end());
+  const GltfWriterOptions uncompressedOptions =
+      withoutMeshCompression(options);
+  for (const CesiumGltf::Model* pModel : models) {
+    futures.emplace_back(
+        asyncSystem
+            .runInWorkerThread([pModel, options]() {
+              // The encodes refer to the copy of the model, so it must not
+              // move until they're done.
+              auto pCompression = std::make_shared<PendingCompression>();
+              pCompression->start(*pModel, getBufferData(*pModel), options);
+              return pCompression;
+            })
+            .thenImmediately(
+                [asyncSystem,
+                 options](std::shared_ptr<PendingCompression>&& pCompression) {
+                  // A single encode is done right here rather than waiting
+                  // for another thread to do it.
+                  const size_t encodeCount = pCompression->size();
+                  if (encodeCount <= 1) {
+                    if (encodeCount == 1) {
+                      pCompression->encode(0, options);
+                    }
+                    return asyncSystem.createResolvedFuture(
+                        std::move(pCompression));
+                  }
+
+                  // Each encode resolves to its index only because `all`
+                  // needs a value.
+                  std::vector<CesiumAsync::Future<size_t>> encoded;
+                  encoded.reserve(encodeCount);
+                  for (size_t i = 0; i < encodeCount; ++i) {
+                    encoded.emplace_back(asyncSystem.runInWorkerThread(
+                        [pCompression, i, options]() {
+                          pCompression->encode(i, options);
+                          return i;
+                        }));
+                  }
+
+                  return asyncSystem.all(std::move(encoded))
+                      .thenImmediately(
+                          [pCompression](std::vector<size_t>&&) mutable {
+                            return std::move(pCompression);
+                          });
+                })
+            .thenInWorkerThread(
+                [this, uncompressedOptions, pPool](
+                    std::shared_ptr<PendingCompression>&& pCompression) {
+                  pCompression->finish();
+                  GltfWriterResult result = writePooledGlb(
+                      *this,
+                      pCompression->model,
+                      getBufferData(pCompression->model),
+                      uncompressedOptions,
+                      *pPool);
+                  addCompressionWarnings(result, *pCompression);
+                  return result;
+                }));
+  }
 
-  return result;
+  return asyncSystem.all(std::move(futures));
 }
 
 } // namespace CesiumGltfWriter
@@ -0,0 +1,89 @@
+#include "compressionUtilities.h"
+
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+#include <CesiumUtility/Allocator.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_set>
+
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+
+namespace CesiumGltfWriter {
+
+int64_t appendToFirstBuffer(
+    CesiumGltf::Model& model,
+    const gsl::span<const std::byte>& data) {
+  Buffer& buffer = model.buffers[0];
+  CesiumUtility::ByteVector& bufferData = buffer.cesium.data;
+  bufferData.resize((bufferData.size() + 7) & ~size_t(7));
+  const int64_t byteOffset = static_cast<int64_t>(bufferData.size());
+  bufferData.insert(bufferData.end(), data.begin(), data.end());
+  buffer.byteLength = static_cast<int64_t>(bufferData.size());
+  return byteOffset;
+}
+
+int32_t appendBufferView(
+    CesiumGltf::Model& model,
+    const gsl::span<const std::byte>& data,
+    std::optional<int64_t> byteStride,
+    std::optional<int32_t> target) {
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteOffset = appendToFirstBuffer(model, data);
+  bufferView.byteLength = static_cast<int64_t>(data.size());
+  bufferView.byteStride = byteStride;
+  bufferView.target = target;
+  return static_cast<int32_t>(model.bufferViews.size() - 1);
+}
+
+std::vector<int32_t>
+countPrimitiveAccessorUses(const CesiumGltf::Model& model) {
+  std::vector<int32_t> uses(model.accessors.size(), 0);
+  auto use = [&uses](int32_t accessor) {
+    if (accessor >= 0 && size_t(accessor) < uses.size()) {
+      ++uses[size_t(accessor)];
+    }
+  };
+
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      for (const auto& [semantic, accessor] : primitive.attributes) {
+        use(accessor);
+      }
+      for (const auto& target : primitive.targets) {
+        for (const auto& [semantic, accessor] : target) {
+          use(accessor);
+        }
+      }
+      use(primitive.indices);
+    }
+  }
+
+  return uses;
+}
+
+void removeReplacedBufferViews(
+    CesiumGltf::Model& model,
+    const std::vector<int32_t>& replacedBufferViews) {
+  if (replacedBufferViews.empty()) {
+    return;
+  }
+
+  const std::unordered_set<int32_t> replaced(
+      replacedBufferViews.begin(),
+      replacedBufferViews.end());
+  std::vector<int32_t> keep;
+  for (size_t i = 0; i < model.bufferViews.size(); ++i) {
+    if (replaced.find(int32_t(i)) == replaced.end()) {
+      keep.emplace_back(int32_t(i));
+    }
+  }
+
+  GltfUtilities::removeUnusedBufferViews(model, keep);
+  GltfUtilities::compactBuffer(model, 0);
+}
+
+} // namespace CesiumGltfWriter
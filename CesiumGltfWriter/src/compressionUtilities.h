@@ -0,0 +1,56 @@
+#pragma once
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumGltfWriter {
+
+/**
+ * @brief Appends data to the end of the first buffer of a model, starting on
+ * an eight-byte boundary so that removing unused bytes later can't disrupt
+ * its alignment.
+ *
+ * @return The offset of the data in the buffer.
+ */
+int64_t appendToFirstBuffer(
+    CesiumGltf::Model& model,
+    const gsl::span<const std::byte>& data);
+
+/**
+ * @brief Appends data to the end of the first buffer of a model, like
+ * {@link appendToFirstBuffer}, and adds a buffer view of it.
+ *
+ * @return The index of the new buffer view.
+ */
+int32_t appendBufferView(
+    CesiumGltf::Model& model,
+    const gsl::span<const std::byte>& data,
+    std::optional<int64_t> byteStride,
+    std::optional<int32_t> target);
+
+/**
+ * @brief Counts the references to each accessor from the attributes, morph
+ * targets and indices of the primitives of a model.
+ */
+std::vector<int32_t> countPrimitiveAccessorUses(const CesiumGltf::Model& model);
+
+/**
+ * @brief Removes those of the given buffer views that nothing refers to
+ * anymore, and the bytes of the first buffer that only they used.
+ *
+ * Other unused buffer views are kept, because they may be referred to by
+ * extensions that the writer doesn't know about.
+ */
+void removeReplacedBufferViews(
+    CesiumGltf::Model& model,
+    const std::vector<int32_t>& replacedBufferViews);
+
+} // namespace CesiumGltfWriter
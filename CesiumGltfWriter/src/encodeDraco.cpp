@@ -0,0 +1,378 @@
+#include "encodeDraco.h"
+
+#include "CesiumGltfWriter/GltfWriter.h"
+#include "compressionUtilities.h"
+
+#include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/Allocator.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <glm/common.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4127 4018 4804)
+#endif
+
+#include <draco/compression/decode.h>
+#include <draco/compression/encode.h>
+#include <draco/core/decoder_buffer.h>
+#include <draco/core/encoder_buffer.h>
+#include <draco/mesh/mesh.h>
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+using namespace CesiumGltf;
+
+namespace CesiumGltfWriter {
+
+namespace {
+
+// Whether an accessor can be replaced by the Draco data of the one primitive
+// that uses it.
+bool isEncodable(
+    const Model& model,
+    int32_t accessorIndex,
+    const std::vector<int32_t>& accessorUses) {
+  const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+  if (!pAccessor || pAccessor->sparse ||
+      accessorUses[size_t(accessorIndex)] != 1) {
+    return false;
+  }
+  const BufferView* pBufferView =
+      Model::getSafe(&model.bufferViews, pAccessor->bufferView);
+  return pBufferView && pBufferView->buffer == 0;
+}
+
+// Gets the first element of an accessor and the distance between elements, or
+// nullptr if the accessor doesn't fit in its buffer view.
+const std::byte* getAccessorData(
+    const Model& model,
+    const Accessor& accessor,
+    int64_t& stride) {
+  const BufferView* pBufferView =
+      Model::getSafe(&model.bufferViews, accessor.bufferView);
+  if (!pBufferView || pBufferView->buffer != 0 || model.buffers.empty()) {
+    return nullptr;
+  }
+
+  const CesiumUtility::ByteVector& data = model.buffers[0].cesium.data;
+  stride = accessor.computeByteStride(model);
+  const int64_t elementSize = accessor.computeBytesPerVertex();
+  if (accessor.count <= 0 || stride <= 0 || elementSize <= 0) {
+    return nullptr;
+  }
+
+  const int64_t start = pBufferView->byteOffset + accessor.byteOffset;
+  const int64_t end = start + (accessor.count - 1) * stride + elementSize;
+  if (start < 0 || end > pBufferView->byteOffset + pBufferView->byteLength ||
+      end > static_cast<int64_t>(data.size())) {
+    return nullptr;
+  }
+
+  return data.data() + start;
+}
+
+std::optional<uint32_t> readIndex(const std::byte* pData, int32_t type) {
+  switch (type) {
+  case Accessor::ComponentType::UNSIGNED_BYTE: {
+    uint8_t index;
+    std::memcpy(&index, pData, sizeof(index));
+    return index;
+  }
+  case Accessor::ComponentType::UNSIGNED_SHORT: {
+    uint16_t index;
+    std::memcpy(&index, pData, sizeof(index));
+    return index;
+  }
+  case Accessor::ComponentType::UNSIGNED_INT: {
+    uint32_t index;
+    std::memcpy(&index, pData, sizeof(index));
+    return index;
+  }
+  default:
+    return std::nullopt;
+  }
+}
+
+std::optional<draco::DataType> getDracoDataType(int32_t componentType) {
+  switch (componentType) {
+  case Accessor::ComponentType::BYTE:
+    return draco::DT_INT8;
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    return draco::DT_UINT8;
+  case Accessor::ComponentType::SHORT:
+    return draco::DT_INT16;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    return draco::DT_UINT16;
+  case Accessor::ComponentType::UNSIGNED_INT:
+    return draco::DT_UINT32;
+  case Accessor::ComponentType::FLOAT:
+    return draco::DT_FLOAT32;
+  default:
+    return std::nullopt;
+  }
+}
+
+draco::GeometryAttribute::Type
+getDracoAttributeType(const std::string& semantic) {
+  if (semantic == "POSITION") {
+    return draco::GeometryAttribute::POSITION;
+  }
+  if (semantic == "NORMAL") {
+    return draco::GeometryAttribute::NORMAL;
+  }
+  if (semantic.rfind("TEXCOORD_", 0) == 0) {
+    return draco::GeometryAttribute::TEX_COORD;
+  }
+  if (semantic.rfind("COLOR_", 0) == 0) {
+    return draco::GeometryAttribute::COLOR;
+  }
+  return draco::GeometryAttribute::GENERIC;
+}
+
+void setQuantization(
+    draco::Encoder& encoder,
+    draco::GeometryAttribute::Type type,
+    int32_t bits) {
+  // Without quantization, Draco encodes floating-point values losslessly.
+  if (bits > 0) {
+    encoder.SetAttributeQuantization(type, glm::min(bits, 30));
+  }
+}
+} // namespace
+
+void DracoPrimitive::encode(
+    const CesiumGltf::Model& model,
+    const GltfWriterOptions& options) {
+  CESIUM_TRACE("CesiumGltfWriter::DracoPrimitive::encode");
+
+  const MeshPrimitive& primitive =
+      model.meshes[this->meshIndex].primitives[this->primitiveIndex];
+  const Accessor& positions =
+      model.accessors[size_t(primitive.attributes.at("POSITION"))];
+  const int64_t pointCount = positions.count;
+
+  draco::Mesh mesh;
+  mesh.set_num_points(static_cast<uint32_t>(pointCount));
+
+  const Accessor& indices = model.accessors[size_t(primitive.indices)];
+  int64_t indexStride = 0;
+  const std::byte* pIndices = getAccessorData(model, indices, indexStride);
+  if (!pIndices || indices.count % 3 != 0) {
+    this->warning = "The indices of a primitive can't be encoded with Draco.";
+    return;
+  }
+
+  const int64_t faceCount = indices.count / 3;
+  mesh.SetNumFaces(static_cast<size_t>(faceCount));
+  for (int64_t i = 0; i < faceCount; ++i) {
+    draco::Mesh::Face face;
+    for (size_t corner = 0; corner < 3; ++corner) {
+      const std::optional<uint32_t> index = readIndex(
+          pIndices + (i * 3 + int64_t(corner)) * indexStride,
+          indices.componentType);
+      if (!index || int64_t(*index) >= pointCount) {
+        this->warning =
+            "The indices of a primitive can't be encoded with Draco.";
+        return;
+      }
+      face[corner] = draco::PointIndex(*index);
+    }
+    mesh.SetFace(draco::FaceIndex(static_cast<uint32_t>(i)), face);
+  }
+
+  for (const auto& [semantic, accessorIndex] : primitive.attributes) {
+    const Accessor& accessor = model.accessors[size_t(accessorIndex)];
+    const std::optional<draco::DataType> dataType =
+        getDracoDataType(accessor.componentType);
+    int64_t stride = 0;
+    const std::byte* pData = getAccessorData(model, accessor, stride);
+    if (!dataType || !pData || accessor.count != pointCount) {
+      this->warning =
+          "The " + semantic + " attribute can't be encoded with Draco.";
+      return;
+    }
+
+    draco::GeometryAttribute attribute;
+    attribute.Init(
+        getDracoAttributeType(semantic),
+        nullptr,
+        static_cast<uint8_t>(accessor.computeNumberOfComponents()),
+        *dataType,
+        accessor.normalized,
+        accessor.computeBytesPerVertex(),
+        0);
+    const int attributeId = mesh.AddAttribute(
+        attribute,
+        true,
+        static_cast<uint32_t>(pointCount));
+    if (attributeId < 0) {
+      this->warning =
+          "The " + semantic + " attribute can't be encoded with Draco.";
+      return;
+    }
+
+    draco::PointAttribute* pAttribute = mesh.attribute(attributeId);
+    for (int64_t i = 0; i < pointCount; ++i) {
+      pAttribute->SetAttributeValue(
+          draco::AttributeValueIndex(static_cast<uint32_t>(i)),
+          pData + i * stride);
+    }
+    this->attributes[semantic] = static_cast<int32_t>(pAttribute->unique_id());
+  }
+
+  const int speed = 10 - glm::clamp(options.dracoCompressionLevel, 0, 10);
+  draco::Encoder encoder;
+  encoder.SetSpeedOptions(speed, speed);
+  setQuantization(
+      encoder,
+      draco::GeometryAttribute::POSITION,
+      options.dracoPositionQuantizationBits);
+  setQuantization(
+      encoder,
+      draco::GeometryAttribute::NORMAL,
+      options.dracoNormalQuantizationBits);
+  setQuantization(
+      encoder,
+      draco::GeometryAttribute::TEX_COORD,
+      options.dracoTexCoordQuantizationBits);
+  setQuantization(
+      encoder,
+      draco::GeometryAttribute::COLOR,
+      options.dracoGenericQuantizationBits);
+  setQuantization(
+      encoder,
+      draco::GeometryAttribute::GENERIC,
+      options.dracoGenericQuantizationBits);
+
+  draco::EncoderBuffer buffer;
+  const draco::Status status = encoder.EncodeMeshToBuffer(mesh, &buffer);
+  if (!status.ok()) {
+    this->warning =
+        "Draco failed to encode a primitive: " + status.error_msg_string();
+    return;
+  }
+
+  // The encoder may split or reorder the vertices, so the counts of the
+  // accessors are taken from the mesh that a reader will decode.
+  draco::DecoderBuffer decoderBuffer;
+  decoderBuffer.Init(buffer.data(), buffer.size());
+  draco::Decoder decoder;
+  draco::StatusOr<std::unique_ptr<draco::Mesh>> decoded =
+      decoder.DecodeMeshFromBuffer(&decoderBuffer);
+  if (!decoded.ok() || !decoded.value()) {
+    this->warning = "Draco failed to decode an encoded primitive.";
+    return;
+  }
+  this->vertexCount = static_cast<int64_t>(decoded.value()->num_points());
+  this->indexCount = static_cast<int64_t>(decoded.value()->num_faces()) * 3;
+
+  const std::byte* pEncoded = reinterpret_cast<const std::byte*>(buffer.data());
+  this->data.assign(pEncoded, pEncoded + buffer.size());
+}
+
+std::vector<DracoPrimitive>
+findDracoPrimitives(const CesiumGltf::Model& model) {
+  const std::vector<int32_t> accessorUses = countPrimitiveAccessorUses(model);
+
+  std::vector<DracoPrimitive> result;
+  for (size_t i = 0; i < model.meshes.size(); ++i) {
+    const Mesh& mesh = model.meshes[i];
+    for (size_t j = 0; j < mesh.primitives.size(); ++j) {
+      const MeshPrimitive& primitive = mesh.primitives[j];
+      if (primitive.mode != MeshPrimitive::Mode::TRIANGLES ||
+          !primitive.targets.empty() ||
+          primitive.hasExtension<ExtensionKhrDracoMeshCompression>() ||
+          primitive.attributes.find("POSITION") ==
+              primitive.attributes.end() ||
+          !isEncodable(model, primitive.indices, accessorUses)) {
+        continue;
+      }
+
+      bool attributesEncodable = true;
+      for (const auto& [semantic, accessorIndex] : primitive.attributes) {
+        attributesEncodable = attributesEncodable &&
+                              isEncodable(model, accessorIndex, accessorUses);
+      }
+      if (attributesEncodable) {
+        DracoPrimitive& dracoPrimitive = result.emplace_back();
+        dracoPrimitive.meshIndex = i;
+        dracoPrimitive.primitiveIndex = j;
+      }
+    }
+  }
+
+  return result;
+}
+
+void applyEncodedDraco(
+    CesiumGltf::Model& model,
+    std::vector<DracoPrimitive>& primitives,
+    std::vector<std::string>& warnings) {
+  CESIUM_TRACE("CesiumGltfWriter::applyEncodedDraco");
+
+  std::vector<int32_t> replacedBufferViews;
+  for (DracoPrimitive& dracoPrimitive : primitives) {
+    if (dracoPrimitive.warning) {
+      warnings.emplace_back(*dracoPrimitive.warning);
+      continue;
+    }
+    if (dracoPrimitive.data.empty()) {
+      continue;
+    }
+
+    MeshPrimitive& primitive = model.meshes[dracoPrimitive.meshIndex]
+                                   .primitives[dracoPrimitive.primitiveIndex];
+    ExtensionKhrDracoMeshCompression& extension =
+        primitive.addExtension<ExtensionKhrDracoMeshCompression>();
+    extension.bufferView = appendBufferView(
+        model,
+        dracoPrimitive.data,
+        std::nullopt,
+        std::nullopt);
+    extension.attributes = std::move(dracoPrimitive.attributes);
+    dracoPrimitive.data.clear();
+
+    for (const auto& [semantic, accessorIndex] : primitive.attributes) {
+      Accessor& accessor = model.accessors[size_t(accessorIndex)];
+      replacedBufferViews.emplace_back(accessor.bufferView);
+      accessor.bufferView = -1;
+      accessor.byteOffset = 0;
+      accessor.count = dracoPrimitive.vertexCount;
+    }
+
+    // Like the reader, pick an index type that fits the decoded vertices.
+    Accessor& indices = model.accessors[size_t(primitive.indices)];
+    replacedBufferViews.emplace_back(indices.bufferView);
+    indices.bufferView = -1;
+    indices.byteOffset = 0;
+    indices.count = dracoPrimitive.indexCount;
+    if (dracoPrimitive.vertexCount >= 65535) {
+      indices.componentType = Accessor::ComponentType::UNSIGNED_INT;
+    } else if (
+        dracoPrimitive.vertexCount >= 255 &&
+        indices.componentType == Accessor::ComponentType::UNSIGNED_BYTE) {
+      indices.componentType = Accessor::ComponentType::UNSIGNED_SHORT;
+    }
+  }
+
+  if (!replacedBufferViews.empty()) {
+    model.addExtensionUsed(ExtensionKhrDracoMeshCompression::ExtensionName);
+    model.addExtensionRequired(ExtensionKhrDracoMeshCompression::ExtensionName);
+  }
+  removeReplacedBufferViews(model, replacedBufferViews);
+}
+
+} // namespace CesiumGltfWriter
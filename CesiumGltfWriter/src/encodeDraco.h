@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumGltfWriter {
+struct GltfWriterOptions;
+
+/**
+ * @brief A primitive to compress with the `KHR_draco_mesh_compression`
+ * extension.
+ *
+ * Encoding a primitive only reads the model, so the primitives of a model can
+ * be encoded in parallel. The results are then written into the model by
+ * {@link applyEncodedDraco}.
+ */
+struct DracoPrimitive {
+  /**
+   * @brief The index of the mesh in the model.
+   */
+  size_t meshIndex = 0;
+
+  /**
+   * @brief The index of the primitive in the mesh.
+   */
+  size_t primitiveIndex = 0;
+
+  /**
+   * @brief The encoded data, or empty if the primitive has not been encoded
+   * or encoding failed.
+   */
+  std::vector<std::byte> data;
+
+  /**
+   * @brief The unique ID of the Draco attribute of each glTF attribute.
+   */
+  std::unordered_map<std::string, int32_t> attributes;
+
+  /**
+   * @brief The number of vertices of the decoded mesh.
+   */
+  int64_t vertexCount = 0;
+
+  /**
+   * @brief The number of indices of the decoded mesh.
+   */
+  int64_t indexCount = 0;
+
+  /**
+   * @brief Why encoding failed, if it did.
+   */
+  std::optional<std::string> warning;
+
+  /**
+   * @brief Encodes the primitive. This may be called from any thread.
+   */
+  void encode(const CesiumGltf::Model& model, const GltfWriterOptions& options);
+};
+
+/**
+ * @brief Finds the indexed triangle primitives of the model that can be
+ * compressed with the `KHR_draco_mesh_compression` extension.
+ *
+ * A primitive is skipped if it has morph targets, or if any of its accessors
+ * is sparse, isn't in the first buffer or is used by another primitive too.
+ */
+std::vector<DracoPrimitive> findDracoPrimitives(const CesiumGltf::Model& model);
+
+/**
+ * @brief Writes the primitives encoded by {@link DracoPrimitive::encode} into
+ * the model, and removes the data they replace.
+ *
+ * @param model The model.
+ * @param primitives The encoded primitives.
+ * @param warnings The warnings of the primitives that couldn't be encoded are
+ * added to this.
+ */
+void applyEncodedDraco(
+    CesiumGltf::Model& model,
+    std::vector<DracoPrimitive>& primitives,
+    std::vector<std::string>& warnings);
+} // namespace CesiumGltfWriter
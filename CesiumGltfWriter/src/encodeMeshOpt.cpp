@@ -0,0 +1,366 @@
+#include "encodeMeshOpt.h"
+
+#include "compressionUtilities.h"
+
+#include <CesiumGltf/ExtensionBufferExtMeshoptCompression.h>
+#include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
+#include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumGltfContent/GltfUtilities.h>
+#include <CesiumUtility/Tracing.h>
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#endif
+#include <meshoptimizer.h>
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumGltfContent;
+
+namespace CesiumGltfWriter {
+
+namespace {
+
+using Mode = ExtensionBufferViewExtMeshoptCompression::Mode;
+
+// What an accessor is used for. An accessor that is used for more than one
+// thing, or for anything else than the vertices and indices of primitives,
+// is Other.
+enum class AccessorUse { Unused, Attribute, TriangleIndices, Indices, Other };
+
+std::vector<AccessorUse> findAccessorUses(const Model& model) {
+  std::vector<AccessorUse> uses(model.accessors.size(), AccessorUse::Unused);
+  auto use = [&uses](int32_t accessor, AccessorUse accessorUse) {
+    if (accessor < 0 || size_t(accessor) >= uses.size()) {
+      return;
+    }
+    AccessorUse& current = uses[size_t(accessor)];
+    current = current == AccessorUse::Unused || current == accessorUse
+                  ? accessorUse
+                  : AccessorUse::Other;
+  };
+
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      for (const auto& [semantic, accessor] : primitive.attributes) {
+        use(accessor, AccessorUse::Attribute);
+      }
+      for (const auto& target : primitive.targets) {
+        for (const auto& [semantic, accessor] : target) {
+          use(accessor, AccessorUse::Attribute);
+        }
+      }
+      use(primitive.indices,
+          primitive.mode == MeshPrimitive::Mode::TRIANGLES
+              ? AccessorUse::TriangleIndices
+              : AccessorUse::Indices);
+    }
+  }
+
+  for (const Animation& animation : model.animations) {
+    for (const AnimationSampler& sampler : animation.samplers) {
+      use(sampler.input, AccessorUse::Other);
+      use(sampler.output, AccessorUse::Other);
+    }
+  }
+  for (const Skin& skin : model.skins) {
+    use(skin.inverseBindMatrices, AccessorUse::Other);
+  }
+
+  return uses;
+}
+
+// The buffer views that are used by something other than accessors, which
+// must be kept as they are.
+std::vector<bool> findOtherBufferViewUses(const Model& model) {
+  std::vector<bool> uses(model.bufferViews.size(), false);
+  auto use = [&uses](int32_t bufferView) {
+    if (bufferView >= 0 && size_t(bufferView) < uses.size()) {
+      uses[size_t(bufferView)] = true;
+    }
+  };
+
+  for (const Accessor& accessor : model.accessors) {
+    if (accessor.sparse) {
+      use(accessor.bufferView);
+      use(accessor.sparse->indices.bufferView);
+      use(accessor.sparse->values.bufferView);
+    }
+  }
+  for (const Image& image : model.images) {
+    use(image.bufferView);
+  }
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      const ExtensionKhrDracoMeshCompression* pDraco =
+          primitive.getExtension<ExtensionKhrDracoMeshCompression>();
+      if (pDraco) {
+        use(pDraco->bufferView);
+      }
+    }
+  }
+
+  const ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  if (pMetadata) {
+    for (const PropertyTable& propertyTable : pMetadata->propertyTables) {
+      for (const auto& [name, property] : propertyTable.properties) {
+        use(property.values);
+        use(property.arrayOffsets);
+        use(property.stringOffsets);
+      }
+    }
+  }
+
+  return uses;
+}
+
+// Decides how to encode a buffer view from the accessors that use it, or
+// returns false if it can't be encoded.
+bool chooseEncoding(
+    const BufferView& bufferView,
+    const std::vector<const Accessor*>& accessors,
+    AccessorUse use,
+    MeshOptBufferView& result) {
+  if (use == AccessorUse::Attribute) {
+    int64_t stride = bufferView.byteStride.value_or(0);
+    if (stride == 0) {
+      // Accessors that are one after the other in a buffer view without a
+      // stride can only be encoded together if their elements are the same
+      // size.
+      stride = accessors.front()->computeBytesPerVertex();
+      for (const Accessor* pAccessor : accessors) {
+        if (pAccessor->computeBytesPerVertex() != stride) {
+          return false;
+        }
+      }
+    }
+    if (stride <= 0 || stride > 256 || stride % 4 != 0 ||
+        bufferView.byteLength % stride != 0) {
+      return false;
+    }
+
+    result.mode = Mode::ATTRIBUTES;
+    result.byteStride = stride;
+    result.count = bufferView.byteLength / stride;
+    return true;
+  }
+
+  const int64_t indexSize = accessors.front()->computeByteSizeOfComponent();
+  if ((indexSize != 2 && indexSize != 4) ||
+      bufferView.byteLength % indexSize != 0) {
+    return false;
+  }
+
+  // The triangle codec may rotate the vertices of a triangle, which is only
+  // fine if every accessor starts and ends on a whole triangle.
+  bool isTriangles = use == AccessorUse::TriangleIndices;
+  for (const Accessor* pAccessor : accessors) {
+    if (pAccessor->computeByteSizeOfComponent() != indexSize ||
+        pAccessor->byteOffset % indexSize != 0) {
+      return false;
+    }
+    isTriangles = isTriangles && pAccessor->count % 3 == 0 &&
+                  (pAccessor->byteOffset / indexSize) % 3 == 0;
+  }
+
+  result.count = bufferView.byteLength / indexSize;
+  result.byteStride = indexSize;
+  result.mode =
+      isTriangles && result.count % 3 == 0 ? Mode::TRIANGLES : Mode::INDICES;
+  return true;
+}
+} // namespace
+
+void MeshOptBufferView::encode(const CesiumGltf::Model& model) {
+  CESIUM_TRACE("CesiumGltfWriter::MeshOptBufferView::encode");
+
+  const BufferView& bufferView = model.bufferViews[this->bufferViewIndex];
+  const std::byte* pData =
+      model.buffers[0].cesium.data.data() + bufferView.byteOffset;
+  const size_t count = size_t(this->count);
+  const size_t stride = size_t(this->byteStride);
+
+  std::vector<unsigned char> encoded;
+  size_t encodedSize = 0;
+  if (this->mode == Mode::ATTRIBUTES) {
+    encoded.resize(meshopt_encodeVertexBufferBound(count, stride));
+    encodedSize = meshopt_encodeVertexBuffer(
+        encoded.data(),
+        encoded.size(),
+        pData,
+        count,
+        stride);
+  } else {
+    std::vector<uint32_t> indices(count);
+    uint32_t largestIndex = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (stride == 2) {
+        uint16_t index;
+        std::memcpy(&index, pData + i * 2, sizeof(index));
+        indices[i] = index;
+      } else {
+        std::memcpy(&indices[i], pData + i * 4, sizeof(uint32_t));
+      }
+      largestIndex = std::max(largestIndex, indices[i]);
+    }
+
+    const size_t vertexCount = size_t(largestIndex) + 1;
+    if (this->mode == Mode::TRIANGLES) {
+      encoded.resize(meshopt_encodeIndexBufferBound(count, vertexCount));
+      encodedSize = meshopt_encodeIndexBuffer(
+          encoded.data(),
+          encoded.size(),
+          indices.data(),
+          count);
+    } else {
+      encoded.resize(meshopt_encodeIndexSequenceBound(count, vertexCount));
+      encodedSize = meshopt_encodeIndexSequence(
+          encoded.data(),
+          encoded.size(),
+          indices.data(),
+          count);
+    }
+  }
+
+  if (encodedSize == 0) {
+    this->warning = "meshoptimizer failed to encode a buffer view.";
+    return;
+  }
+
+  const std::byte* pEncoded =
+      reinterpret_cast<const std::byte*>(encoded.data());
+  this->data.assign(pEncoded, pEncoded + encodedSize);
+}
+
+std::vector<MeshOptBufferView>
+findMeshOptBufferViews(const CesiumGltf::Model& model) {
+  if (model.buffers.empty()) {
+    return {};
+  }
+
+  const std::vector<AccessorUse> accessorUses = findAccessorUses(model);
+  const std::vector<bool> otherUses = findOtherBufferViewUses(model);
+  std::vector<std::vector<const Accessor*>> accessorsByBufferView(
+      model.bufferViews.size());
+  std::vector<AccessorUse> bufferViewUses(
+      model.bufferViews.size(),
+      AccessorUse::Unused);
+  for (size_t i = 0; i < model.accessors.size(); ++i) {
+    const Accessor& accessor = model.accessors[i];
+    if (accessor.bufferView < 0 ||
+        size_t(accessor.bufferView) >= model.bufferViews.size()) {
+      continue;
+    }
+
+    // Triangle indices share a buffer view with other indices as plain
+    // indices.
+    AccessorUse use = accessorUses[i];
+    AccessorUse& bufferViewUse = bufferViewUses[size_t(accessor.bufferView)];
+    if (bufferViewUse != AccessorUse::Unused && bufferViewUse != use) {
+      const bool areIndices =
+          (use == AccessorUse::Indices ||
+           use == AccessorUse::TriangleIndices) &&
+          (bufferViewUse == AccessorUse::Indices ||
+           bufferViewUse == AccessorUse::TriangleIndices);
+      use = areIndices ? AccessorUse::Indices : AccessorUse::Other;
+    }
+    bufferViewUse = use == AccessorUse::Unused ? AccessorUse::Other : use;
+    accessorsByBufferView[size_t(accessor.bufferView)].emplace_back(&accessor);
+  }
+
+  const int64_t bufferSize =
+      static_cast<int64_t>(model.buffers[0].cesium.data.size());
+  std::vector<MeshOptBufferView> result;
+  for (size_t i = 0; i < model.bufferViews.size(); ++i) {
+    const BufferView& bufferView = model.bufferViews[i];
+    const AccessorUse use = bufferViewUses[i];
+    if (bufferView.buffer != 0 || otherUses[i] || use == AccessorUse::Unused ||
+        use == AccessorUse::Other || bufferView.byteLength <= 0 ||
+        bufferView.byteOffset < 0 ||
+        bufferView.byteOffset + bufferView.byteLength > bufferSize ||
+        bufferView.hasExtension<ExtensionBufferViewExtMeshoptCompression>()) {
+      continue;
+    }
+
+    MeshOptBufferView meshOptBufferView;
+    meshOptBufferView.bufferViewIndex = i;
+    if (chooseEncoding(
+            bufferView,
+            accessorsByBufferView[i],
+            use,
+            meshOptBufferView)) {
+      result.emplace_back(std::move(meshOptBufferView));
+    }
+  }
+
+  return result;
+}
+
+void applyEncodedMeshOpt(
+    CesiumGltf::Model& model,
+    std::vector<MeshOptBufferView>& bufferViews,
+    std::vector<std::string>& warnings) {
+  CESIUM_TRACE("CesiumGltfWriter::applyEncodedMeshOpt");
+
+  int32_t fallbackBufferIndex = -1;
+  for (MeshOptBufferView& meshOptBufferView : bufferViews) {
+    if (meshOptBufferView.warning) {
+      warnings.emplace_back(*meshOptBufferView.warning);
+      continue;
+    }
+    if (meshOptBufferView.data.empty()) {
+      continue;
+    }
+
+    if (fallbackBufferIndex < 0) {
+      Buffer& fallbackBuffer = model.buffers.emplace_back();
+      fallbackBuffer.byteLength = 0;
+      fallbackBuffer.addExtension<ExtensionBufferExtMeshoptCompression>()
+          .fallback = true;
+      fallbackBufferIndex = static_cast<int32_t>(model.buffers.size() - 1);
+    }
+
+    BufferView& bufferView =
+        model.bufferViews[meshOptBufferView.bufferViewIndex];
+    ExtensionBufferViewExtMeshoptCompression& extension =
+        bufferView.addExtension<ExtensionBufferViewExtMeshoptCompression>();
+    extension.buffer = 0;
+    extension.byteOffset = appendToFirstBuffer(model, meshOptBufferView.data);
+    extension.byteLength =
+        static_cast<int64_t>(meshOptBufferView.data.size());
+    extension.byteStride = meshOptBufferView.byteStride;
+    extension.count = meshOptBufferView.count;
+    extension.mode = meshOptBufferView.mode;
+    meshOptBufferView.data.clear();
+
+    // The fallback buffer has no data, so its buffer views only need to be
+    // laid out as a reader that decodes them would.
+    Buffer& fallbackBuffer = model.buffers[size_t(fallbackBufferIndex)];
+    bufferView.buffer = fallbackBufferIndex;
+    bufferView.byteOffset = (fallbackBuffer.byteLength + 3) & ~int64_t(3);
+    fallbackBuffer.byteLength = bufferView.byteOffset + bufferView.byteLength;
+  }
+
+  if (fallbackBufferIndex >= 0) {
+    model.addExtensionUsed(
+        ExtensionBufferViewExtMeshoptCompression::ExtensionName);
+    model.addExtensionRequired(
+        ExtensionBufferViewExtMeshoptCompression::ExtensionName);
+    GltfUtilities::compactBuffer(model, 0);
+  }
+}
+
+} // namespace CesiumGltfWriter
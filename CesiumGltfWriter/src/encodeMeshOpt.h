@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumGltfWriter {
+
+/**
+ * @brief A buffer view to compress with the `EXT_meshopt_compression`
+ * extension.
+ *
+ * Encoding a buffer view only reads the model, so the buffer views of a model
+ * can be encoded in parallel. The results are then written into the model by
+ * {@link applyEncodedMeshOpt}.
+ */
+struct MeshOptBufferView {
+  /**
+   * @brief The index of the buffer view in the model.
+   */
+  size_t bufferViewIndex = 0;
+
+  /**
+   * @brief How the buffer view is encoded, one of
+   * {@link CesiumGltf::ExtensionBufferViewExtMeshoptCompression::Mode}.
+   */
+  std::string mode;
+
+  /**
+   * @brief The size of each element of the buffer view.
+   */
+  int64_t byteStride = 0;
+
+  /**
+   * @brief The number of elements of the buffer view.
+   */
+  int64_t count = 0;
+
+  /**
+   * @brief The encoded data, or empty if the buffer view has not been encoded
+   * or encoding failed.
+   */
+  std::vector<std::byte> data;
+
+  /**
+   * @brief Why encoding failed, if it did.
+   */
+  std::optional<std::string> warning;
+
+  /**
+   * @brief Encodes the buffer view. This may be called from any thread.
+   */
+  void encode(const CesiumGltf::Model& model);
+};
+
+/**
+ * @brief Finds the buffer views of the model that can be compressed with the
+ * `EXT_meshopt_compression` extension.
+ *
+ * These are the buffer views in the first buffer that only hold vertex
+ * attributes, with a stride that is a multiple of four, or only hold 16-bit
+ * or 32-bit indices.
+ */
+std::vector<MeshOptBufferView>
+findMeshOptBufferViews(const CesiumGltf::Model& model);
+
+/**
+ * @brief Writes the buffer views encoded by {@link MeshOptBufferView::encode}
+ * into the model, and removes the data they replace.
+ *
+ * The uncompressed buffer views are moved to a new fallback buffer without
+ * data, so the extension is required to read the model.
+ *
+ * @param model The model.
+ * @param bufferViews The encoded buffer views.
+ * @param warnings The warnings of the buffer views that couldn't be encoded
+ * are added to this.
+ */
+void applyEncodedMeshOpt(
+    CesiumGltf::Model& model,
+    std::vector<MeshOptBufferView>& bufferViews,
+    std::vector<std::string>& warnings);
+} // namespace CesiumGltfWriter
@@ -0,0 +1,367 @@
+#include "quantizeMeshData.h"
+
+#include "compressionUtilities.h"
+
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/Model.h>
+
+#include <glm/common.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace CesiumGltfWriter {
+
+namespace {
+
+// Whether an accessor has floating-point data of the given type in the first
+// buffer, which can be replaced with quantized data.
+bool isQuantizable(
+    const Model& model,
+    const Accessor& accessor,
+    const std::string& type) {
+  if (accessor.componentType != Accessor::ComponentType::FLOAT ||
+      accessor.type != type || accessor.normalized || accessor.sparse) {
+    return false;
+  }
+  const BufferView* pBufferView =
+      Model::getSafe(&model.bufferViews, accessor.bufferView);
+  return pBufferView && pBufferView->buffer == 0;
+}
+
+int8_t toNormalizedInt8(float value) {
+  return static_cast<int8_t>(
+      std::round(glm::clamp(value, -1.0f, 1.0f) * 127.0f));
+}
+
+uint16_t toNormalizedUint16(float value) {
+  return static_cast<uint16_t>(
+      std::round(glm::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+
+// Replaces the data of an accessor with the quantized values of each element,
+// each of which takes `byteStride` bytes, in a new buffer view.
+template <typename TElement, typename TComponent, typename TQuantize>
+bool replaceAccessorData(
+    Model& model,
+    int32_t accessorIndex,
+    int32_t componentType,
+    bool normalized,
+    int64_t byteStride,
+    TQuantize&& quantize,
+    std::vector<int32_t>& replacedBufferViews) {
+  const AccessorView<TElement> view(model, accessorIndex);
+  if (view.status() != AccessorViewStatus::Valid) {
+    return false;
+  }
+
+  std::vector<std::byte> data(size_t(view.size() * byteStride));
+  for (int64_t i = 0; i < view.size(); ++i) {
+    quantize(
+        view[i],
+        reinterpret_cast<TComponent*>(data.data() + i * byteStride));
+  }
+
+  Accessor& accessor = model.accessors[size_t(accessorIndex)];
+  replacedBufferViews.emplace_back(accessor.bufferView);
+  accessor.bufferView = appendBufferView(
+      model,
+      data,
+      byteStride,
+      BufferView::Target::ARRAY_BUFFER);
+  accessor.byteOffset = 0;
+  accessor.componentType = componentType;
+  accessor.normalized = normalized;
+  accessor.min.clear();
+  accessor.max.clear();
+  return true;
+}
+
+bool quantizeNormals(
+    Model& model,
+    int32_t accessorIndex,
+    std::vector<int32_t>& replacedBufferViews) {
+  return replaceAccessorData<glm::vec3, int8_t>(
+      model,
+      accessorIndex,
+      Accessor::ComponentType::BYTE,
+      true,
+      4,
+      [](const glm::vec3& normal, int8_t* pOut) {
+        for (glm::length_t i = 0; i < 3; ++i) {
+          pOut[i] = toNormalizedInt8(normal[i]);
+        }
+      },
+      replacedBufferViews);
+}
+
+bool quantizeTangents(
+    Model& model,
+    int32_t accessorIndex,
+    std::vector<int32_t>& replacedBufferViews) {
+  return replaceAccessorData<glm::vec4, int8_t>(
+      model,
+      accessorIndex,
+      Accessor::ComponentType::BYTE,
+      true,
+      4,
+      [](const glm::vec4& tangent, int8_t* pOut) {
+        for (glm::length_t i = 0; i < 4; ++i) {
+          pOut[i] = toNormalizedInt8(tangent[i]);
+        }
+      },
+      replacedBufferViews);
+}
+
+// Texture coordinates outside of 0.0 to 1.0, which repeat the texture, are
+// left as they are.
+bool quantizeTexCoords(
+    Model& model,
+    int32_t accessorIndex,
+    std::vector<int32_t>& replacedBufferViews) {
+  const AccessorView<glm::vec2> view(model, accessorIndex);
+  if (view.status() != AccessorViewStatus::Valid) {
+    return false;
+  }
+  for (int64_t i = 0; i < view.size(); ++i) {
+    const glm::vec2& texCoord = view[i];
+    if (texCoord.x < 0.0f || texCoord.x > 1.0f || texCoord.y < 0.0f ||
+        texCoord.y > 1.0f) {
+      return false;
+    }
+  }
+
+  return replaceAccessorData<glm::vec2, uint16_t>(
+      model,
+      accessorIndex,
+      Accessor::ComponentType::UNSIGNED_SHORT,
+      true,
+      4,
+      [](const glm::vec2& texCoord, uint16_t* pOut) {
+        pOut[0] = toNormalizedUint16(texCoord.x);
+        pOut[1] = toNormalizedUint16(texCoord.y);
+      },
+      replacedBufferViews);
+}
+
+// The mesh that each accessor is used by, or -2 if it's used by more than one.
+std::vector<int32_t> findAccessorMeshes(const Model& model) {
+  std::vector<int32_t> meshes(model.accessors.size(), -1);
+  auto use = [&meshes](int32_t accessor, int32_t mesh) {
+    if (accessor < 0 || size_t(accessor) >= meshes.size()) {
+      return;
+    }
+    int32_t& accessorMesh = meshes[size_t(accessor)];
+    accessorMesh = accessorMesh == -1 || accessorMesh == mesh ? mesh : -2;
+  };
+
+  for (size_t i = 0; i < model.meshes.size(); ++i) {
+    for (const MeshPrimitive& primitive : model.meshes[i].primitives) {
+      for (const auto& [semantic, accessor] : primitive.attributes) {
+        use(accessor, int32_t(i));
+      }
+      use(primitive.indices, int32_t(i));
+    }
+  }
+
+  return meshes;
+}
+
+// The positions of a mesh can only be quantized if every node that renders it
+// can be given a child with the transform that restores them.
+bool canQuantizePositions(
+    const Model& model,
+    int32_t meshIndex,
+    const std::vector<int32_t>& accessorMeshes) {
+  bool isRendered = false;
+  for (const Node& node : model.nodes) {
+    if (node.mesh != meshIndex) {
+      continue;
+    }
+    if (node.skin >= 0 || !node.extensions.empty()) {
+      return false;
+    }
+    isRendered = true;
+  }
+  if (!isRendered) {
+    return false;
+  }
+
+  const Mesh& mesh = model.meshes[size_t(meshIndex)];
+  for (const MeshPrimitive& primitive : mesh.primitives) {
+    auto positionIt = primitive.attributes.find("POSITION");
+    if (!primitive.targets.empty() ||
+        positionIt == primitive.attributes.end()) {
+      return false;
+    }
+    const Accessor* pAccessor =
+        Model::getSafe(&model.accessors, positionIt->second);
+    if (!pAccessor ||
+        !isQuantizable(model, *pAccessor, Accessor::Type::VEC3) ||
+        accessorMeshes[size_t(positionIt->second)] != meshIndex) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Stores the positions of a mesh in 16-bit integers, relative to the minimum
+// of the positions of all of its primitives and with a single scale, so that
+// one transform restores them all.
+void quantizePositions(
+    Model& model,
+    int32_t meshIndex,
+    std::vector<int32_t>& replacedBufferViews) {
+  std::vector<int32_t> accessors;
+  glm::vec3 minimum(std::numeric_limits<float>::max());
+  glm::vec3 maximum(std::numeric_limits<float>::lowest());
+  for (const MeshPrimitive& primitive :
+       model.meshes[size_t(meshIndex)].primitives) {
+    const int32_t accessorIndex = primitive.attributes.at("POSITION");
+    const AccessorView<glm::vec3> view(model, accessorIndex);
+    if (view.status() != AccessorViewStatus::Valid) {
+      return;
+    }
+    for (int64_t i = 0; i < view.size(); ++i) {
+      minimum = glm::min(minimum, view[i]);
+      maximum = glm::max(maximum, view[i]);
+    }
+    accessors.emplace_back(accessorIndex);
+  }
+  if (minimum.x > maximum.x) {
+    return;
+  }
+
+  const glm::vec3 extent = maximum - minimum;
+  const float largestExtent = glm::max(glm::max(extent.x, extent.y), extent.z);
+  const float scale = largestExtent > 0.0f ? largestExtent / 65535.0f : 1.0f;
+
+  for (const int32_t accessorIndex : accessors) {
+    // The same accessor may be used by more than one primitive.
+    if (model.accessors[size_t(accessorIndex)].componentType !=
+        Accessor::ComponentType::FLOAT) {
+      continue;
+    }
+
+    glm::vec3 quantizedMinimum(65535.0f);
+    glm::vec3 quantizedMaximum(0.0f);
+    replaceAccessorData<glm::vec3, uint16_t>(
+        model,
+        accessorIndex,
+        Accessor::ComponentType::UNSIGNED_SHORT,
+        false,
+        8,
+        [&](const glm::vec3& position, uint16_t* pOut) {
+          const glm::vec3 quantized = glm::clamp(
+              glm::round((position - minimum) / scale),
+              0.0f,
+              65535.0f);
+          quantizedMinimum = glm::min(quantizedMinimum, quantized);
+          quantizedMaximum = glm::max(quantizedMaximum, quantized);
+          for (glm::length_t i = 0; i < 3; ++i) {
+            pOut[i] = static_cast<uint16_t>(quantized[i]);
+          }
+        },
+        replacedBufferViews);
+
+    Accessor& accessor = model.accessors[size_t(accessorIndex)];
+    accessor.min = {quantizedMinimum.x, quantizedMinimum.y, quantizedMinimum.z};
+    accessor.max = {quantizedMaximum.x, quantizedMaximum.y, quantizedMaximum.z};
+  }
+
+  // Each node that renders the mesh gets a child that renders it instead, with
+  // the transform that restores the positions.
+  const size_t nodeCount = model.nodes.size();
+  for (size_t i = 0; i < nodeCount; ++i) {
+    if (model.nodes[i].mesh != meshIndex) {
+      continue;
+    }
+
+    Node& child = model.nodes.emplace_back();
+    child.mesh = meshIndex;
+    child.matrix = {
+        scale,
+        0.0,
+        0.0,
+        0.0,
+        0.0,
+        scale,
+        0.0,
+        0.0,
+        0.0,
+        0.0,
+        scale,
+        0.0,
+        minimum.x,
+        minimum.y,
+        minimum.z,
+        1.0};
+
+    Node& node = model.nodes[i];
+    node.mesh = -1;
+    node.children.emplace_back(int32_t(model.nodes.size() - 1));
+  }
+}
+
+} // namespace
+
+void quantizeMeshData(CesiumGltf::Model& model) {
+  if (model.buffers.empty()) {
+    return;
+  }
+
+  std::vector<int32_t> replacedBufferViews;
+  const std::vector<int32_t> accessorMeshes = findAccessorMeshes(model);
+  std::vector<bool> isQuantized(model.accessors.size(), false);
+  for (size_t i = 0; i < model.meshes.size(); ++i) {
+    if (canQuantizePositions(model, int32_t(i), accessorMeshes)) {
+      quantizePositions(model, int32_t(i), replacedBufferViews);
+    }
+
+    for (const MeshPrimitive& primitive : model.meshes[i].primitives) {
+      for (const auto& [semantic, accessorIndex] : primitive.attributes) {
+        if (accessorIndex < 0 ||
+            size_t(accessorIndex) >= model.accessors.size() ||
+            isQuantized[size_t(accessorIndex)]) {
+          continue;
+        }
+
+        const Accessor& accessor = model.accessors[size_t(accessorIndex)];
+        if (semantic == "NORMAL" &&
+            isQuantizable(model, accessor, Accessor::Type::VEC3)) {
+          isQuantized[size_t(accessorIndex)] =
+              quantizeNormals(model, accessorIndex, replacedBufferViews);
+        } else if (
+            semantic == "TANGENT" &&
+            isQuantizable(model, accessor, Accessor::Type::VEC4)) {
+          isQuantized[size_t(accessorIndex)] =
+              quantizeTangents(model, accessorIndex, replacedBufferViews);
+        } else if (
+            semantic.rfind("TEXCOORD_", 0) == 0 &&
+            isQuantizable(model, accessor, Accessor::Type::VEC2)) {
+          isQuantized[size_t(accessorIndex)] =
+              quantizeTexCoords(model, accessorIndex, replacedBufferViews);
+        }
+      }
+    }
+  }
+
+  if (!replacedBufferViews.empty()) {
+    model.addExtensionUsed("KHR_mesh_quantization");
+    model.addExtensionRequired("KHR_mesh_quantization");
+  }
+  removeReplacedBufferViews(model, replacedBufferViews);
+}
+
+} // namespace CesiumGltfWriter
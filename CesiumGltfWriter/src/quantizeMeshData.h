@@ -0,0 +1,19 @@
+#pragma once
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumGltfWriter {
+
+/**
+ * @brief Stores the floating-point normals, tangents, texture coordinates and
+ * positions of the meshes of a model in smaller integer types, as allowed by
+ * the `KHR_mesh_quantization` extension.
+ *
+ * Only data in the first buffer is quantized. See
+ * {@link GltfWriterOptions::quantizeMeshes} for the details.
+ */
+void quantizeMeshData(CesiumGltf::Model& model);
+
+} // namespace CesiumGltfWriter
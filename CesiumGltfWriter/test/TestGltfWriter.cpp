@@ -1,12 +1,21 @@
 #include "CesiumGltfWriter/GltfWriter.h"
 
+#include <CesiumGltf/AccessorView.h>
 #include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
 #include <CesiumGltfReader/GltfReader.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
 
 #include <catch2/catch.hpp>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
 #include <rapidjson/document.h>
 
 #include <cctype>
+#include <cstring>
 
 namespace {
 void check(const std::string& input, const std::string& expectedOutput) {
@@ -50,6 +59,100 @@ struct ExtensionModelTest final : public CesiumUtility::ExtensibleObject {
   static inline constexpr const char* ExtensionName = "PRIVATE_model_test";
 };
 
+template <typename T>
+int32_t addAccessor(
+    CesiumGltf::Model& model,
+    const std::vector<T>& values,
+    int32_t componentType,
+    const std::string& type,
+    int32_t target) {
+  CesiumUtility::ByteVector& data = model.buffers[0].cesium.data;
+  CesiumGltf::BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteOffset = static_cast<int64_t>(data.size());
+  bufferView.byteLength = static_cast<int64_t>(values.size() * sizeof(T));
+  bufferView.target = target;
+  data.resize(data.size() + (values.size() * sizeof(T) + 3) / 4 * 4);
+  std::memcpy(
+      data.data() + bufferView.byteOffset,
+      values.data(),
+      values.size() * sizeof(T));
+  model.buffers[0].byteLength = static_cast<int64_t>(data.size());
+
+  CesiumGltf::Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = static_cast<int32_t>(model.bufferViews.size() - 1);
+  accessor.componentType = componentType;
+  accessor.type = type;
+  accessor.count = static_cast<int64_t>(values.size());
+  return static_cast<int32_t>(model.accessors.size() - 1);
+}
+
+// A grid of vertices with positions, normals and texture coordinates, drawn
+// by a node as triangles.
+CesiumGltf::Model createGridModel(size_t verticesPerSide) {
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec3> normals;
+  std::vector<glm::vec2> texCoords;
+  std::vector<uint16_t> indices;
+  const float last = float(verticesPerSide - 1);
+  for (size_t j = 0; j < verticesPerSide; ++j) {
+    for (size_t i = 0; i < verticesPerSide; ++i) {
+      positions.emplace_back(float(i), float(j), 0.1f * float((i * j) % 5));
+      normals.emplace_back(
+          glm::normalize(glm::vec3(0.1f * float(i), 0.1f * float(j), 1.0f)));
+      texCoords.emplace_back(float(i) / last, float(j) / last);
+      if (i + 1 < verticesPerSide && j + 1 < verticesPerSide) {
+        const uint16_t index = uint16_t(j * verticesPerSide + i);
+        const uint16_t above = uint16_t(index + verticesPerSide);
+        indices.insert(
+            indices.end(),
+            {index, uint16_t(index + 1), above, uint16_t(index + 1),
+             uint16_t(above + 1), above});
+      }
+    }
+  }
+
+  CesiumGltf::Model model;
+  model.asset.version = "2.0";
+  model.buffers.emplace_back();
+
+  CesiumGltf::MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = addAccessor(
+      model,
+      positions,
+      CesiumGltf::Accessor::ComponentType::FLOAT,
+      CesiumGltf::Accessor::Type::VEC3,
+      CesiumGltf::BufferView::Target::ARRAY_BUFFER);
+  CesiumGltf::Accessor& position =
+      model.accessors[size_t(primitive.attributes["POSITION"])];
+  position.min = {0.0, 0.0, 0.0};
+  position.max = {last, last, 0.4};
+  primitive.attributes["NORMAL"] = addAccessor(
+      model,
+      normals,
+      CesiumGltf::Accessor::ComponentType::FLOAT,
+      CesiumGltf::Accessor::Type::VEC3,
+      CesiumGltf::BufferView::Target::ARRAY_BUFFER);
+  primitive.attributes["TEXCOORD_0"] = addAccessor(
+      model,
+      texCoords,
+      CesiumGltf::Accessor::ComponentType::FLOAT,
+      CesiumGltf::Accessor::Type::VEC2,
+      CesiumGltf::BufferView::Target::ARRAY_BUFFER);
+  primitive.indices = addAccessor(
+      model,
+      indices,
+      CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT,
+      CesiumGltf::Accessor::Type::SCALAR,
+      CesiumGltf::BufferView::Target::ELEMENT_ARRAY_BUFFER);
+
+  model.nodes.emplace_back().mesh = 0;
+  model.scenes.emplace_back().nodes.emplace_back(0);
+  model.scene = 0;
+  return model;
+}
+
 } // namespace
 
 TEST_CASE("Writes glTF") {
@@ -585,6 +688,208 @@ TEST_CASE("Writes glb with binaryChunkByteAlignment of 8") {
   REQUIRE(glbBytesExtraPadding.size() == 88);
 }
 
+TEST_CASE("Writes glb to an output") {
+  const std::vector<std::byte> bufferData(13, std::byte('b'));
+
+  CesiumGltf::Model model;
+  model.asset.version = "2.0";
+  CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+  buffer.byteLength = static_cast<int64_t>(bufferData.size());
+
+  CesiumGltfWriter::GltfWriter writer;
+  CesiumGltfWriter::GltfWriterOptions options;
+  options.binaryChunkByteAlignment = 8;
+  const CesiumGltfWriter::GltfWriterResult expected =
+      writer.writeGlb(model, gsl::span(bufferData), options);
+  REQUIRE(expected.errors.empty());
+
+  SECTION("The output receives the same bytes as the vector") {
+    std::vector<std::byte> glb;
+    size_t writes = 0;
+    CesiumGltfWriter::GltfWriterResult result = writer.writeGlb(
+        model,
+        gsl::span(bufferData),
+        [&glb, &writes](const gsl::span<const std::byte>& bytes) {
+          glb.insert(glb.end(), bytes.begin(), bytes.end());
+          ++writes;
+          return true;
+        },
+        options);
+
+    CHECK(result.errors.empty());
+    CHECK(result.gltfBytes.empty());
+    CHECK(writes > 1);
+    CHECK(glb == expected.gltfBytes);
+  }
+
+  SECTION("A failing output stops the writing and reports an error") {
+    size_t writes = 0;
+    CesiumGltfWriter::GltfWriterResult result = writer.writeGlb(
+        model,
+        gsl::span(bufferData),
+        [&writes](const gsl::span<const std::byte>&) {
+          ++writes;
+          return false;
+        },
+        options);
+
+    CHECK(!result.errors.empty());
+    CHECK(writes == 1);
+  }
+}
+
+TEST_CASE("Writes many glbs in parallel") {
+  std::vector<CesiumGltf::Model> models(3);
+  std::vector<const CesiumGltf::Model*> pModels;
+  for (size_t i = 0; i < models.size(); ++i) {
+    CesiumGltf::Model& model = models[i];
+    model.asset.version = "2.0";
+    model.asset.generator = std::string(i * 10, 'g');
+    CesiumGltf::Buffer& buffer = model.buffers.emplace_back();
+    buffer.cesium.data.resize(i * 5, std::byte('b'));
+    buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+    pModels.emplace_back(&model);
+  }
+
+  CesiumAsync::AsyncSystem asyncSystem(
+      std::make_shared<CesiumNativeTests::SimpleTaskProcessor>());
+  CesiumGltfWriter::GltfWriter writer;
+  std::vector<CesiumGltfWriter::GltfWriterResult> results =
+      writer.writeGlbs(asyncSystem, pModels).wait();
+
+  REQUIRE(results.size() == models.size());
+  for (size_t i = 0; i < models.size(); ++i) {
+    CesiumGltfWriter::GltfWriterResult expected =
+        writer.writeGlb(models[i], models[i].buffers[0].cesium.data);
+    CHECK(results[i].errors.empty());
+    CHECK(results[i].gltfBytes == expected.gltfBytes);
+  }
+}
+
+TEST_CASE("Writes glb with compressed meshes") {
+  const CesiumGltf::Model model = createGridModel(16);
+  const gsl::span<const std::byte> bufferData = model.buffers[0].cesium.data;
+
+  CesiumGltfWriter::GltfWriter writer;
+  const CesiumGltfWriter::GltfWriterResult uncompressed =
+      writer.writeGlb(model, bufferData);
+  REQUIRE(uncompressed.errors.empty());
+
+  CesiumGltfWriter::GltfWriterOptions options;
+  std::string extension;
+  SECTION("With Draco") {
+    options.meshCompression = CesiumGltfWriter::GltfMeshCompression::Draco;
+    extension = "KHR_draco_mesh_compression";
+  }
+  SECTION("With meshopt and quantized meshes") {
+    options.meshCompression = CesiumGltfWriter::GltfMeshCompression::Meshopt;
+    options.quantizeMeshes = true;
+    extension = "EXT_meshopt_compression";
+  }
+
+  const CesiumGltfWriter::GltfWriterResult compressed =
+      writer.writeGlb(model, bufferData, options);
+  REQUIRE(compressed.errors.empty());
+  CHECK(compressed.warnings.empty());
+  CHECK(compressed.gltfBytes.size() < uncompressed.gltfBytes.size());
+
+  // The model passed to the writer is untouched.
+  CHECK(model.extensionsUsed.empty());
+  CHECK(model.bufferViews.size() == 4);
+
+  // Read the positions back without decoding, to see what was written.
+  CesiumGltfReader::GltfReader reader;
+  CesiumGltfReader::GltfReaderOptions readerOptions;
+  readerOptions.decodeDraco = false;
+  readerOptions.decodeMeshOptData = false;
+  CesiumGltfReader::GltfReaderResult encodedResult =
+      reader.readGltf(compressed.gltfBytes, readerOptions);
+  REQUIRE(encodedResult.model);
+  CHECK(encodedResult.model->isExtensionRequired(extension));
+
+  // And decoded, the mesh is the same within the precision of the
+  // quantization once transformed by the node that renders it.
+  CesiumGltfReader::GltfReaderResult readResult =
+      reader.readGltf(compressed.gltfBytes);
+  REQUIRE(readResult.errors.empty());
+  REQUIRE(readResult.model);
+  const CesiumGltf::Model& readModel = *readResult.model;
+  REQUIRE(readModel.meshes.size() == 1);
+  REQUIRE(readModel.meshes[0].primitives.size() == 1);
+  const CesiumGltf::MeshPrimitive& primitive =
+      readModel.meshes[0].primitives[0];
+
+  glm::dmat4 transform(1.0);
+  for (const CesiumGltf::Node& node : readModel.nodes) {
+    if (node.mesh == 0) {
+      REQUIRE(node.matrix.size() == 16);
+      transform = glm::make_mat4(node.matrix.data());
+    }
+  }
+
+  const CesiumGltf::AccessorView<glm::vec3> positions(
+      readModel,
+      primitive.attributes.at("POSITION"));
+  REQUIRE(positions.status() == CesiumGltf::AccessorViewStatus::Valid);
+  CHECK(positions.size() == 256);
+  glm::dvec3 minimum(std::numeric_limits<double>::max());
+  glm::dvec3 maximum(std::numeric_limits<double>::lowest());
+  for (int64_t i = 0; i < positions.size(); ++i) {
+    const glm::dvec3 position =
+        glm::dvec3(transform * glm::dvec4(glm::dvec3(positions[i]), 1.0));
+    minimum = glm::min(minimum, position);
+    maximum = glm::max(maximum, position);
+  }
+  CHECK(minimum.x == Approx(0.0).margin(0.01));
+  CHECK(minimum.y == Approx(0.0).margin(0.01));
+  CHECK(minimum.z == Approx(0.0).margin(0.01));
+  CHECK(maximum.x == Approx(15.0).margin(0.01));
+  CHECK(maximum.y == Approx(15.0).margin(0.01));
+  CHECK(maximum.z == Approx(0.4).margin(0.01));
+
+  const CesiumGltf::AccessorView<glm::vec3> normals(
+      readModel,
+      primitive.attributes.at("NORMAL"));
+  REQUIRE(normals.status() == CesiumGltf::AccessorViewStatus::Valid);
+  CHECK(normals.size() == positions.size());
+  for (int64_t i = 0; i < normals.size(); ++i) {
+    CHECK(glm::length(normals[i]) == Approx(1.0f).margin(0.02f));
+  }
+
+  const CesiumGltf::Accessor& indices =
+      readModel.accessors[size_t(primitive.indices)];
+  CHECK(indices.count == 15 * 15 * 6);
+}
+
+TEST_CASE("Writes many glbs with compressed meshes in parallel") {
+  std::vector<CesiumGltf::Model> models{
+      createGridModel(4),
+      createGridModel(16),
+      createGridModel(32)};
+  std::vector<const CesiumGltf::Model*> pModels;
+  for (const CesiumGltf::Model& model : models) {
+    pModels.emplace_back(&model);
+  }
+
+  CesiumGltfWriter::GltfWriterOptions options;
+  options.meshCompression = CesiumGltfWriter::GltfMeshCompression::Meshopt;
+  options.quantizeMeshes = true;
+
+  CesiumAsync::AsyncSystem asyncSystem(
+      std::make_shared<CesiumNativeTests::SimpleTaskProcessor>());
+  CesiumGltfWriter::GltfWriter writer;
+  std::vector<CesiumGltfWriter::GltfWriterResult> results =
+      writer.writeGlbs(asyncSystem, pModels, options).wait();
+
+  REQUIRE(results.size() == models.size());
+  for (size_t i = 0; i < models.size(); ++i) {
+    CesiumGltfWriter::GltfWriterResult expected =
+        writer.writeGlb(models[i], models[i].buffers[0].cesium.data, options);
+    CHECK(results[i].errors.empty());
+    CHECK(results[i].gltfBytes == expected.gltfBytes);
+  }
+}
+
 TEST_CASE("Reports an error if asked to write a GLB larger than 4GB") {
   CesiumGltf::Model model;
   model.asset.version = "2.0";
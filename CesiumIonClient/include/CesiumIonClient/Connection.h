@@ -13,6 +13,7 @@
 #include <CesiumAsync/Library.h>
 
 #include <cstdint>
+#include <functional>
 
 namespace CesiumIonClient {
 
@@ -253,6 +254,26 @@ public:
   CesiumAsync::Future<Response<TokenList>>
   previousPage(const Response<TokenList>& currentPage) const;
 
+  /**
+   * @brief Gets all of the pages of results from the "List tokens" service.
+   *
+   * The first page is requested with the given options. If the server reports
+   * the number of the last page, the remaining pages are then all requested
+   * at once. Otherwise they are requested one after another, by following
+   * {@link Response::nextPageUrl}.
+   *
+   * @param options Options to include in each "List tokens" request. The
+   * results start at {@link ListTokensOptions::page}, or at the first page.
+   * @param onPage Called in the main thread with each page as it is
+   * received, so that the first tokens can be shown before the others arrive.
+   * Pages requested at once may be received in any order.
+   * @return A future that resolves to the tokens of all of the pages, in
+   * order, or to the first page that failed.
+   */
+  CesiumAsync::Future<Response<TokenList>> allTokens(
+      const ListTokensOptions& options = {},
+      std::function<void(const Response<TokenList>&)> onPage = {}) const;
+
   /**
    * @brief Creates a new token.
    *
@@ -313,6 +334,10 @@ private:
 
   CesiumAsync::Future<Response<TokenList>> tokens(const std::string& url) const;
 
+  CesiumAsync::Future<Response<TokenList>> appendNextTokenPages(
+      Response<TokenList>&& tokens,
+      const std::function<void(const Response<TokenList>&)>& onPage) const;
+
   CesiumAsync::AsyncSystem _asyncSystem;
   std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
   std::string _accessToken;
@@ -84,6 +84,14 @@ template <typename T> struct Response final {
    * Call {@link Connection::previousPage} rather than using this field directly.
    */
   std::optional<std::string> previousPageUrl;
+
+  /**
+   * @brief The URL of the last page of results, if the server reported it.
+   *
+   * This is used by {@link Connection::allTokens} to request the remaining
+   * pages at once.
+   */
+  std::optional<std::string> lastPageUrl;
 };
 
 /**
@@ -17,6 +17,8 @@
 #include <rapidjson/writer.h>
 #include <uriparser/Uri.h>
 
+#include <charconv>
+#include <iterator>
 #include <thread>
 
 #ifdef _MSC_VER
@@ -854,7 +856,76 @@ Connection::previousPage(const Response<TokenList>& currentPage) const {
   return this->tokens(*currentPage.previousPageUrl);
 }
 
-CesiumAsync::Future<Response<Token>> Connection::createToken(
+namespace {
+
+int32_t getPageNumber(const std::string& url) {
+  const std::string page = Uri::getQueryValue(url, "page");
+  int32_t result = 0;
+  std::from_chars(page.data(), page.data() + page.size(), result);
+  return result;
+}
+
+// Appends the tokens of a page to those of the pages before it.
+void appendTokenPage(Response<TokenList>& tokens, Response<TokenList>&& page) {
+  std::vector<Token>& items = tokens.value->items;
+  items.insert(
+      items.end(),
+      std::make_move_iterator(page.value->items.begin()),
+      std::make_move_iterator(page.value->items.end()));
+  tokens.nextPageUrl = std::move(page.nextPageUrl);
+}
+
+} // namespace
+
+CesiumAsync::Future<Response<TokenList>> Connection::allTokens(
+    const ListTokensOptions& options,
+    std::function<void(const Response<TokenList>&)> onPage) const {
+  const int32_t firstPage = options.page.value_or(1);
+  return this->tokens(options).thenInMainThread(
+      [connection = *this, options, onPage = std::move(onPage), firstPage](
+          Response<TokenList>&& tokens) {
+        if (onPage) {
+          onPage(tokens);
+        }
+
+        const int32_t lastPage =
+            tokens.lastPageUrl ? getPageNumber(*tokens.lastPageUrl) : 0;
+        if (!tokens.value || !tokens.nextPageUrl || lastPage <= firstPage) {
+          return connection.appendNextTokenPages(std::move(tokens), onPage);
+        }
+
+        std::vector<Future<Response<TokenList>>> futures;
+        futures.reserve(size_t(lastPage - firstPage));
+        for (int32_t page = firstPage + 1; page <= lastPage; ++page) {
+          ListTokensOptions pageOptions = options;
+          pageOptions.page = page;
+          futures.emplace_back(connection.tokens(pageOptions)
+                                   .thenInMainThread(
+                                       [onPage](Response<TokenList>&& result) {
+                                         if (onPage) {
+                                           onPage(result);
+                                         }
+                                         return std::move(result);
+                                       }));
+        }
+
+        return connection._asyncSystem.all(std::move(futures))
+            .thenInMainThread(
+                [tokens = std::move(tokens)](
+                    std::vector<Response<TokenList>>&& pages) mutable {
+                  for (Response<TokenList>& page : pages) {
+                    if (!page.value) {
+                      return std::move(page);
+                    }
+                    appendTokenPage(tokens, std::move(page));
+                  }
+                  tokens.nextPageUrl.reset();
+                  return std::move(tokens);
+                });
+      });
+}
+
+CesiumAsync::Future<Response<TokenList>> Connection::createToken(
     const std::string& name,
     const std::vector<std::string>& scopes,
     const std::optional<std::vector<int64_t>>& assetIds,
@@ -1148,6 +1219,29 @@ Connection::getIdFromToken(const std::string& token) {
       });
 }
 
+CesiumAsync::Future<Response<TokenList>> Connection::appendNextTokenPages(
+    Response<TokenList>&& tokens,
+    const std::function<void(const Response<TokenList>&)>& onPage) const {
+  if (!tokens.value || !tokens.nextPageUrl) {
+    return this->_asyncSystem.createResolvedFuture(std::move(tokens));
+  }
+
+  const std::string nextPageUrl = *tokens.nextPageUrl;
+  return this->tokens(nextPageUrl)
+      .thenInMainThread([connection = *this,
+                         tokens = std::move(tokens),
+                         onPage](Response<TokenList>&& page) mutable {
+        if (onPage) {
+          onPage(page);
+        }
+        if (!page.value) {
+          return connection._asyncSystem.createResolvedFuture(std::move(page));
+        }
+        appendTokenPage(tokens, std::move(page));
+        return connection.appendNextTokenPages(std::move(tokens), onPage);
+      });
+}
+
 CesiumAsync::Future<Response<TokenList>>
 Connection::tokens(const std::string& url) const {
   return this->_pAssetAccessor
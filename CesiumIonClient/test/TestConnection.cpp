@@ -8,6 +8,11 @@
 
 #include <catch2/catch.hpp>
 
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
 using namespace CesiumAsync;
 using namespace CesiumIonClient;
 using namespace CesiumNativeTests;
@@ -99,3 +104,95 @@ TEST_CASE("CesiumIonClient::Connection on single-user mode") {
   CHECK(me.value->id == 0);
   CHECK(me.value->username == "ion-user");
 }
+
+namespace {
+std::shared_ptr<SimpleAssetRequest> createTokenPageRequest(
+    const std::string& url,
+    const std::string& tokenName,
+    const std::string& linkHeader) {
+  const std::string json =
+      R"({"items":[{"id":")" + tokenName + R"(","name":")" + tokenName +
+      R"("}]})";
+  CesiumAsync::HttpHeaders headers;
+  if (!linkHeader.empty()) {
+    headers["link"] = linkHeader;
+  }
+  std::vector<std::byte> data(json.size());
+  std::memcpy(data.data(), json.data(), json.size());
+  return std::make_shared<SimpleAssetRequest>(
+      "GET",
+      url,
+      CesiumAsync::HttpHeaders{},
+      std::make_unique<SimpleAssetResponse>(
+          static_cast<uint16_t>(200),
+          "application/json",
+          headers,
+          std::move(data)));
+}
+} // namespace
+
+TEST_CASE("CesiumIonClient::Connection::allTokens") {
+  const std::string tokensUrl = "https://example.com/v2/tokens";
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+
+  SECTION("requests the remaining pages at once when the last is known") {
+    requests[tokensUrl] = createTokenPageRequest(
+        tokensUrl,
+        "first",
+        "<" + tokensUrl + "?page=2>; rel=\"next\", <" + tokensUrl +
+            "?page=3>; rel=\"last\"");
+    requests[tokensUrl + "?page=2"] = createTokenPageRequest(
+        tokensUrl + "?page=2",
+        "second",
+        "<" + tokensUrl + "?page=3>; rel=\"next\"");
+    requests[tokensUrl + "?page=3"] =
+        createTokenPageRequest(tokensUrl + "?page=3", "third", "");
+  }
+
+  SECTION("follows the next links when the last page isn't known") {
+    requests[tokensUrl] = createTokenPageRequest(
+        tokensUrl,
+        "first",
+        "<" + tokensUrl + "?cursor=b>; rel=\"next\"");
+    requests[tokensUrl + "?cursor=b"] = createTokenPageRequest(
+        tokensUrl + "?cursor=b",
+        "second",
+        "<" + tokensUrl + "?cursor=c>; rel=\"next\"");
+    requests[tokensUrl + "?cursor=c"] =
+        createTokenPageRequest(tokensUrl + "?cursor=c", "third", "");
+  }
+
+  std::shared_ptr<SimpleAssetAccessor> pAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(requests));
+
+  ApplicationData data;
+  data.authenticationMode = AuthenticationMode::CesiumIon;
+
+  AsyncSystem asyncSystem(std::make_shared<SimpleTaskProcessor>());
+  Connection connection(
+      asyncSystem,
+      pAssetAccessor,
+      "my access token",
+      data,
+      "https://example.com/");
+
+  std::vector<std::string> pagesReceived;
+  Response<TokenList> tokens = waitForFuture(
+      asyncSystem,
+      connection.allTokens({}, [&](const Response<TokenList>& page) {
+        REQUIRE(page.value);
+        REQUIRE(page.value->items.size() == 1);
+        pagesReceived.emplace_back(page.value->items[0].name);
+      }));
+
+  REQUIRE(tokens.value);
+  REQUIRE(tokens.value->items.size() == 3);
+  CHECK(tokens.value->items[0].name == "first");
+  CHECK(tokens.value->items[1].name == "second");
+  CHECK(tokens.value->items[2].name == "third");
+  CHECK(!tokens.nextPageUrl);
+
+  // The first page is received before the others are requested.
+  REQUIRE(pagesReceived.size() == 3);
+  CHECK(pagesReceived[0] == "first");
+}
@@ -31,5 +31,6 @@ private:
   ExtensionsJsonHandler _extensions;
   JsonObjectJsonHandler _unknownProperties;
   bool _captureUnknownProperties;
+  bool _captureExtras;
 };
 } // namespace CesiumJsonReader
@@ -9,6 +9,8 @@ namespace CesiumJsonReader {
 
 class CESIUMJSONREADER_API JsonObjectJsonHandler : public JsonHandler {
 public:
+  using ValueType = CesiumUtility::JsonValue;
+
   JsonObjectJsonHandler() noexcept;
 
   void reset(IJsonHandler* pParent, CesiumUtility::JsonValue* pValue);
@@ -31,6 +33,13 @@ private:
   IJsonHandler* doneElement();
 
   std::vector<CesiumUtility::JsonValue*> _stack;
+
+  // The properties of the objects that are being read, by their depth, which
+  // are moved into their objects when the objects end.
+  std::vector<std::vector<CesiumUtility::JsonValue::Object::value_type>>
+      _properties;
+  size_t _objectDepth = 0;
+
   std::string_view _currentKey;
 };
 
@@ -79,6 +79,46 @@ public:
     return result;
   }
 
+  /**
+   * @brief Reads JSON from a byte buffer into a statically-typed class,
+   * decoding its strings in place.
+   *
+   * This is the same as {@link readJson}, except that each string and key is
+   * decoded into the buffer where it was found, instead of being copied to a
+   * temporary one first. This is faster, but leaves the buffer with contents
+   * that are no longer valid JSON, so it is only suitable for buffers that are
+   * not needed after reading them.
+   *
+   * @param data The buffer from which to read JSON. Its contents are
+   * overwritten.
+   * @param handler The handler to receive the top-level JSON object, with the
+   * same requirements as for {@link readJson}.
+   * @return The result of reading the JSON.
+   */
+  template <typename T>
+  static ReadJsonResult<typename T::ValueType>
+  readJsonInSitu(const gsl::span<std::byte>& data, T& handler) {
+    ReadJsonResult<typename T::ValueType> result;
+
+    result.value.emplace();
+
+    FinalJsonHandler finalHandler(result.warnings);
+    handler.reset(&finalHandler, &result.value.value());
+
+    JsonReader::internalReadInSitu(
+        data,
+        handler,
+        finalHandler,
+        result.errors,
+        result.warnings);
+
+    if (!result.errors.empty()) {
+      result.value.reset();
+    }
+
+    return result;
+  }
+
   /**
    * @brief Reads JSON from a `rapidjson::Value` into a statically-typed class.
    *
@@ -137,6 +177,13 @@ private:
       std::vector<std::string>& errors,
       std::vector<std::string>& warnings);
 
+  static void internalReadInSitu(
+      const gsl::span<std::byte>& data,
+      IJsonHandler& handler,
+      FinalJsonHandler& finalHandler,
+      std::vector<std::string>& errors,
+      std::vector<std::string>& warnings);
+
   static void internalRead(
       const rapidjson::Value& jsonValue,
       IJsonHandler& handler,
@@ -67,6 +67,46 @@ public:
     this->_captureUnknownProperties = value;
   }
 
+  /**
+   * @brief Gets a value indicating whether the `extras` of objects are
+   * captured in the {@link ExtensibleObject::extras} field.
+   *
+   * If this is false, `extras` are skipped without being materialized.
+   */
+  bool getCaptureExtras() const { return this->_captureExtras; }
+
+  /**
+   * @brief Sets a value indicating whether the `extras` of objects are
+   * captured in the {@link ExtensibleObject::extras} field.
+   *
+   * If this is false, `extras` are skipped without being materialized.
+   */
+  void setCaptureExtras(bool value) { this->_captureExtras = value; }
+
+  /**
+   * @brief Gets a value indicating whether extensions that have no registered
+   * handler are captured in the {@link ExtensibleObject::extensions} field as
+   * a {@link CesiumUtility::JsonValue}.
+   *
+   * If this is false, such extensions are ignored, unless their state is
+   * `ExtensionState::JsonOnly`.
+   */
+  bool getCaptureUnknownExtensions() const {
+    return this->_captureUnknownExtensions;
+  }
+
+  /**
+   * @brief Sets a value indicating whether extensions that have no registered
+   * handler are captured in the {@link ExtensibleObject::extensions} field as
+   * a {@link CesiumUtility::JsonValue}.
+   *
+   * If this is false, such extensions are ignored, unless their state is
+   * `ExtensionState::JsonOnly`.
+   */
+  void setCaptureUnknownExtensions(bool value) {
+    this->_captureUnknownExtensions = value;
+  }
+
   /**
    * @brief Registers an extension for an object.
    *
@@ -143,6 +183,8 @@ public:
       const std::string& extendedObjectType) const;
 
 private:
+  std::unique_ptr<IExtensionJsonHandler> createUnknownExtensionHandler() const;
+
   using ExtensionHandlerFactory =
       std::function<std::unique_ptr<IExtensionJsonHandler>(
           const JsonReaderOptions&)>;
@@ -152,6 +194,8 @@ private:
   ExtensionNameMap _extensions;
   std::unordered_map<std::string, ExtensionState> _extensionStates;
   bool _captureUnknownProperties = true;
+  bool _captureExtras = true;
+  bool _captureUnknownExtensions = true;
 };
 
 } // namespace CesiumJsonReader
@@ -11,7 +11,8 @@ ExtensibleObjectJsonHandler::ExtensibleObjectJsonHandler(
     : ObjectJsonHandler(),
       _extras(),
       _extensions(context),
-      _captureUnknownProperties(context.getCaptureUnknownProperties()) {}
+      _captureUnknownProperties(context.getCaptureUnknownProperties()),
+      _captureExtras(context.getCaptureExtras()) {}
 
 void ExtensibleObjectJsonHandler::reset(
     IJsonHandler* pParent,
@@ -25,8 +26,12 @@ IJsonHandler* ExtensibleObjectJsonHandler::readObjectKeyExtensibleObject(
     CesiumUtility::ExtensibleObject& o) {
   using namespace std::string_literals;
 
-  if ("extras"s == str)
+  if ("extras"s == str) {
+    if (!this->_captureExtras) {
+      return this->ignoreAndContinue();
+    }
     return property("extras", this->_extras, o.extras);
+  }
 
   if ("extensions"s == str) {
     this->_extensions.reset(this, &o, objectType);
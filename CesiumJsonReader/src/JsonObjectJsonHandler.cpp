@@ -1,6 +1,11 @@
 #include "CesiumJsonReader/JsonObjectJsonHandler.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace CesiumJsonReader {
 namespace {
@@ -24,6 +29,7 @@ void JsonObjectJsonHandler::reset(
   JsonHandler::reset(pParent);
   this->_stack.clear();
   this->_stack.push_back(pValue);
+  this->_objectDepth = 0;
 }
 
 IJsonHandler* JsonObjectJsonHandler::readNull() {
@@ -86,22 +92,64 @@ IJsonHandler* JsonObjectJsonHandler::readObjectStart() {
     current = CesiumUtility::JsonValue::Object();
   }
 
+  ++this->_objectDepth;
+  if (this->_properties.size() < this->_objectDepth) {
+    this->_properties.emplace_back();
+  }
+  this->_properties[this->_objectDepth - 1].clear();
+
   return this;
 }
 
 IJsonHandler*
 JsonObjectJsonHandler::readObjectKey(const std::string_view& str) {
-  CesiumUtility::JsonValue& json = *this->_stack.back();
-  CesiumUtility::JsonValue::Object* pObject =
-      std::get_if<CesiumUtility::JsonValue::Object>(&json.value);
-
-  auto it = pObject->emplace(str, CesiumUtility::JsonValue()).first;
-  this->_stack.push_back(&it->second);
+  std::vector<CesiumUtility::JsonValue::Object::value_type>& properties =
+      this->_properties[this->_objectDepth - 1];
+  CesiumUtility::JsonValue& value =
+      properties.emplace_back(std::string(str), CesiumUtility::JsonValue())
+          .second;
+  this->_stack.push_back(&value);
   this->_currentKey = str;
   return this;
 }
 
 IJsonHandler* JsonObjectJsonHandler::readObjectEnd() {
+  std::vector<CesiumUtility::JsonValue::Object::value_type>& properties =
+      this->_properties[this->_objectDepth - 1];
+  --this->_objectDepth;
+
+  // Sorting the properties once they are all there, rather than inserting
+  // each one in order, lets the object be allocated once, at its final size.
+  auto keyLess = [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first;
+  };
+  auto notIncreasing = [](const auto& lhs, const auto& rhs) {
+    return !(lhs.first < rhs.first);
+  };
+  if (std::adjacent_find(properties.begin(), properties.end(), notIncreasing) !=
+      properties.end()) {
+    std::stable_sort(properties.begin(), properties.end(), keyLess);
+
+    // A later property with the same name replaces an earlier one.
+    auto last = properties.begin();
+    for (auto it = std::next(last); it != properties.end(); ++it) {
+      if (it->first != last->first) {
+        ++last;
+      }
+      if (last != it) {
+        *last = std::move(*it);
+      }
+    }
+    properties.erase(std::next(last), properties.end());
+  }
+
+  CesiumUtility::JsonValue::Object& object =
+      std::get<CesiumUtility::JsonValue::Object>(this->_stack.back()->value);
+  object.insert(
+      std::make_move_iterator(properties.begin()),
+      std::make_move_iterator(properties.end()));
+  properties.clear();
+
   return this->doneElement();
 }
 
@@ -1,5 +1,7 @@
 #include "CesiumJsonReader/JsonReader.h"
 
+#include <rapidjson/encodedstream.h>
+#include <rapidjson/memorystream.h>
 #include <rapidjson/reader.h>
 
 #include <cassert>
@@ -50,6 +52,27 @@ struct Dispatcher {
   }
 };
 
+/**
+ * @brief A `rapidjson::MemoryStream` into which RapidJSON can also write, so
+ * that it can decode strings in place with `rapidjson::kParseInsituFlag`.
+ *
+ * Unlike `rapidjson::InsituStringStream`, the data does not need to be
+ * null-terminated. A decoded string is never longer than its source, so the
+ * writes stay behind the reads.
+ */
+struct InsituMemoryStream : public rapidjson::MemoryStream {
+  InsituMemoryStream(Ch* data, size_t size) noexcept
+      : rapidjson::MemoryStream(data, size), dst_(nullptr) {}
+
+  Ch* PutBegin() noexcept { return this->dst_ = const_cast<Ch*>(this->src_); }
+  void Put(Ch c) noexcept { *this->dst_++ = c; }
+  size_t PutEnd(Ch* begin) noexcept {
+    return static_cast<size_t>(this->dst_ - begin);
+  }
+
+  Ch* dst_;
+};
+
 std::string getMessageFromRapidJsonError(rapidjson::ParseErrorCode code) {
   switch (code) {
   case rapidjson::ParseErrorCode::kParseErrorDocumentEmpty:
@@ -90,6 +113,30 @@ std::string getMessageFromRapidJsonError(rapidjson::ParseErrorCode code) {
   }
 }
 
+template <unsigned parseFlags, typename TStream>
+void parse(
+    TStream& inputStream,
+    IJsonHandler& handler,
+    std::vector<std::string>& errors) {
+  rapidjson::Reader reader;
+  Dispatcher dispatcher{&handler};
+
+  reader.IterativeParseInit();
+
+  bool success = true;
+  while (success && !reader.IterativeParseComplete()) {
+    success = reader.IterativeParseNext<parseFlags>(inputStream, dispatcher);
+  }
+
+  if (reader.HasParseError()) {
+    std::string s("JSON parsing error at byte offset ");
+    s += std::to_string(reader.GetErrorOffset());
+    s += ": ";
+    s += getMessageFromRapidJsonError(reader.GetParseErrorCode());
+    errors.emplace_back(std::move(s));
+  }
+}
+
 } // namespace
 
 JsonReader::FinalJsonHandler::FinalJsonHandler(
@@ -126,33 +173,38 @@ void JsonReader::FinalJsonHandler::setInputStream(
     FinalJsonHandler& finalHandler,
     std::vector<std::string>& errors,
     std::vector<std::string>& /* warnings */) {
-
-  rapidjson::Reader reader;
-  rapidjson::MemoryStream inputStream(
+  rapidjson::MemoryStream memoryStream(
       reinterpret_cast<const char*>(data.data()),
       data.size());
 
-  finalHandler.setInputStream(&inputStream);
+  finalHandler.setInputStream(&memoryStream);
 
-  Dispatcher dispatcher{&handler};
+  // RapidJSON skips whitespace in this stream with SIMD instructions, when
+  // they are enabled. It also skips a UTF-8 byte order mark.
+  rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream>
+      inputStream(memoryStream);
 
-  reader.IterativeParseInit();
+  parse<rapidjson::kParseDefaultFlags | rapidjson::kParseFullPrecisionFlag>(
+      inputStream,
+      handler,
+      errors);
+}
 
-  bool success = true;
-  while (success && !reader.IterativeParseComplete()) {
-    success = reader.IterativeParseNext<
-        rapidjson::kParseDefaultFlags | rapidjson::kParseFullPrecisionFlag>(
-        inputStream,
-        dispatcher);
-  }
+/*static*/ void JsonReader::internalReadInSitu(
+    const gsl::span<std::byte>& data,
+    IJsonHandler& handler,
+    FinalJsonHandler& finalHandler,
+    std::vector<std::string>& errors,
+    std::vector<std::string>& /* warnings */) {
+  InsituMemoryStream inputStream(
+      reinterpret_cast<char*>(data.data()),
+      data.size());
 
-  if (reader.HasParseError()) {
-    std::string s("JSON parsing error at byte offset ");
-    s += std::to_string(reader.GetErrorOffset());
-    s += ": ";
-    s += getMessageFromRapidJsonError(reader.GetParseErrorCode());
-    errors.emplace_back(std::move(s));
-  }
+  finalHandler.setInputStream(&inputStream);
+
+  parse<
+      rapidjson::kParseDefaultFlags | rapidjson::kParseFullPrecisionFlag |
+      rapidjson::kParseInsituFlag>(inputStream, handler, errors);
 }
 
 void CesiumJsonReader::JsonReader::internalRead(
@@ -62,14 +62,22 @@ JsonReaderOptions::createExtensionHandler(
 
   auto extensionNameIt = this->_extensions.find(extensionNameString);
   if (extensionNameIt == this->_extensions.end()) {
-    return std::make_unique<AnyExtensionJsonHandler>();
+    return this->createUnknownExtensionHandler();
   }
 
   auto objectTypeIt = extensionNameIt->second.find(extendedObjectType);
   if (objectTypeIt == extensionNameIt->second.end()) {
-    return std::make_unique<AnyExtensionJsonHandler>();
+    return this->createUnknownExtensionHandler();
   }
 
   return objectTypeIt->second(*this);
 }
+
+std::unique_ptr<IExtensionJsonHandler>
+JsonReaderOptions::createUnknownExtensionHandler() const {
+  if (!this->_captureUnknownExtensions) {
+    return nullptr;
+  }
+  return std::make_unique<AnyExtensionJsonHandler>();
+}
 } // namespace CesiumJsonReader
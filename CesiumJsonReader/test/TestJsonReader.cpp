@@ -0,0 +1,83 @@
+#include <CesiumJsonReader/ArrayJsonHandler.h>
+#include <CesiumJsonReader/JsonObjectJsonHandler.h>
+#include <CesiumJsonReader/JsonReader.h>
+#include <CesiumJsonReader/StringJsonHandler.h>
+#include <CesiumUtility/JsonValue.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace CesiumJsonReader;
+
+namespace {
+std::vector<std::byte> toBytes(const std::string& s) {
+  return std::vector<std::byte>(
+      reinterpret_cast<const std::byte*>(s.data()),
+      reinterpret_cast<const std::byte*>(s.data()) + s.size());
+}
+} // namespace
+
+TEST_CASE("JsonReader::readJsonInSitu") {
+  const std::string json =
+      R"(["plain", "with \"escapes\"\n", "café", "", "😀"])";
+
+  ArrayJsonHandler<std::string, StringJsonHandler> handler;
+  ReadJsonResult<std::vector<std::string>> expected =
+      JsonReader::readJson(toBytes(json), handler);
+  REQUIRE(expected.errors.empty());
+  REQUIRE(expected.value);
+  REQUIRE(expected.value->size() == 5);
+  CHECK((*expected.value)[1] == "with \"escapes\"\n");
+  CHECK((*expected.value)[2] == "caf\xc3\xa9");
+
+  SECTION("reads the same values as readJson") {
+    std::vector<std::byte> data = toBytes(json);
+    ReadJsonResult<std::vector<std::string>> result =
+        JsonReader::readJsonInSitu(data, handler);
+    REQUIRE(result.errors.empty());
+    REQUIRE(result.value);
+    CHECK(*result.value == *expected.value);
+  }
+
+  SECTION("does not read past the end of a buffer") {
+    // The buffer ends inside a string, and is not null-terminated.
+    std::vector<std::byte> data = toBytes(json);
+    data.resize(12);
+    ReadJsonResult<std::vector<std::string>> result =
+        JsonReader::readJsonInSitu(data, handler);
+    CHECK(!result.errors.empty());
+    CHECK(!result.value);
+  }
+}
+
+TEST_CASE("JsonObjectJsonHandler reads objects in any property order") {
+  const std::string json =
+      R"({"z":1,"a":{"y":[{"c":2,"b":3}],"x":"x"},"m":4,"a2":{},"m":5})";
+
+  JsonObjectJsonHandler handler;
+  ReadJsonResult<CesiumUtility::JsonValue> result =
+      JsonReader::readJson(toBytes(json), handler);
+  REQUIRE(result.errors.empty());
+  REQUIRE(result.value);
+
+  const CesiumUtility::JsonValue::Object& object = result.value->getObject();
+  std::vector<std::string> keys;
+  for (const auto& [key, value] : object) {
+    keys.emplace_back(key);
+  }
+  CHECK(keys == std::vector<std::string>{"a", "a2", "m", "z"});
+
+  // A later property with the same name replaces an earlier one.
+  CHECK(object.at("m").getSafeNumber<int64_t>() == 5);
+  CHECK(object.at("a2").getObject().empty());
+
+  const CesiumUtility::JsonValue::Object& a = object.at("a").getObject();
+  CHECK(a.at("x").getString() == "x");
+  const CesiumUtility::JsonValue::Object& element =
+      a.at("y").getArray().at(0).getObject();
+  CHECK(element.begin()->first == "b");
+  CHECK(element.at("c").getSafeNumber<int64_t>() == 2);
+}
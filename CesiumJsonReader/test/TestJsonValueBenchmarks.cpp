@@ -0,0 +1,254 @@
+#include <CesiumJsonReader/JsonHandler.h>
+#include <CesiumJsonReader/JsonObjectJsonHandler.h>
+#include <CesiumJsonReader/JsonReader.h>
+#include <CesiumUtility/JsonValue.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using namespace CesiumJsonReader;
+using namespace CesiumUtility;
+
+namespace {
+// JSON values the way JsonValue stored them before its objects were flat: a
+// std::map tree node for each property.
+struct MapJsonValue {
+  using Object = std::map<std::string, MapJsonValue>;
+  using Array = std::vector<MapJsonValue>;
+
+  std::variant<
+      std::nullptr_t,
+      double,
+      std::uint64_t,
+      std::int64_t,
+      bool,
+      std::string,
+      Object,
+      Array>
+      value;
+};
+
+// Reads a MapJsonValue the same way that JsonObjectJsonHandler reads a
+// JsonValue.
+class MapJsonValueHandler : public JsonHandler {
+public:
+  using ValueType = MapJsonValue;
+
+  void reset(IJsonHandler* pParent, MapJsonValue* pValue) {
+    JsonHandler::reset(pParent);
+    this->_stack.clear();
+    this->_stack.push_back(pValue);
+  }
+
+  IJsonHandler* readNull() override { return this->add(nullptr); }
+  IJsonHandler* readBool(bool b) override { return this->add(b); }
+  IJsonHandler* readInt32(int32_t i) override {
+    return this->add(std::int64_t(i));
+  }
+  IJsonHandler* readUint32(uint32_t i) override {
+    return this->add(std::uint64_t(i));
+  }
+  IJsonHandler* readInt64(int64_t i) override { return this->add(i); }
+  IJsonHandler* readUint64(uint64_t i) override { return this->add(i); }
+  IJsonHandler* readDouble(double d) override { return this->add(d); }
+  IJsonHandler* readString(const std::string_view& str) override {
+    return this->add(std::string(str));
+  }
+
+  IJsonHandler* readObjectStart() override {
+    this->start(MapJsonValue::Object());
+    return this;
+  }
+
+  IJsonHandler* readObjectKey(const std::string_view& str) override {
+    MapJsonValue::Object& object =
+        std::get<MapJsonValue::Object>(this->_stack.back()->value);
+    auto it = object.emplace(str, MapJsonValue()).first;
+    this->_stack.push_back(&it->second);
+    return this;
+  }
+
+  IJsonHandler* readObjectEnd() override { return this->doneElement(); }
+
+  IJsonHandler* readArrayStart() override {
+    this->start(MapJsonValue::Array());
+    return this;
+  }
+
+  IJsonHandler* readArrayEnd() override {
+    this->_stack.pop_back();
+    return this->_stack.empty() ? this->parent() : this;
+  }
+
+private:
+  template <typename T> IJsonHandler* add(T&& value) {
+    MapJsonValue& current = *this->_stack.back();
+    if (auto* pArray = std::get_if<MapJsonValue::Array>(&current.value)) {
+      pArray->emplace_back().value = std::forward<T>(value);
+    } else {
+      current.value = std::forward<T>(value);
+    }
+    return this->doneElement();
+  }
+
+  template <typename T> void start(T&& value) {
+    MapJsonValue& current = *this->_stack.back();
+    if (auto* pArray = std::get_if<MapJsonValue::Array>(&current.value)) {
+      MapJsonValue& element = pArray->emplace_back();
+      element.value = std::forward<T>(value);
+      this->_stack.push_back(&element);
+    } else {
+      current.value = std::forward<T>(value);
+    }
+  }
+
+  IJsonHandler* doneElement() {
+    if (!std::holds_alternative<MapJsonValue::Array>(
+            this->_stack.back()->value)) {
+      this->_stack.pop_back();
+      return this->_stack.empty() ? this->parent() : this;
+    }
+    return this;
+  }
+
+  std::vector<MapJsonValue*> _stack;
+};
+
+// The heap memory held by a value and the number of allocations it is in. The
+// allocator's own overhead isn't counted, and a std::map node is assumed to
+// have a color and three pointers besides its entry, as in the common
+// standard libraries.
+struct HeapUsage {
+  size_t bytes = 0;
+  size_t allocations = 0;
+};
+
+constexpr size_t mapNodeOverhead = 4 * sizeof(void*);
+
+void addString(const std::string& s, HeapUsage& usage) {
+  const char* pObject = reinterpret_cast<const char*>(&s);
+  const bool isShort = s.data() >= pObject && s.data() < pObject + sizeof(s);
+  if (!isShort) {
+    usage.bytes += s.capacity() + 1;
+    ++usage.allocations;
+  }
+}
+
+void addValue(const JsonValue& value, HeapUsage& usage) {
+  if (const auto* pString = std::get_if<JsonValue::String>(&value.value)) {
+    addString(*pString, usage);
+  } else if (const auto* pArray = std::get_if<JsonValue::Array>(&value.value)) {
+    if (pArray->capacity() > 0) {
+      usage.bytes += pArray->capacity() * sizeof(JsonValue);
+      ++usage.allocations;
+    }
+    for (const JsonValue& element : *pArray) {
+      addValue(element, usage);
+    }
+  } else if (
+      const auto* pObject = std::get_if<JsonValue::Object>(&value.value)) {
+    if (pObject->capacity() > 0) {
+      usage.bytes +=
+          pObject->capacity() * sizeof(JsonValue::Object::value_type);
+      ++usage.allocations;
+    }
+    for (const auto& [key, property] : *pObject) {
+      addString(key, usage);
+      addValue(property, usage);
+    }
+  }
+}
+
+void addValue(const MapJsonValue& value, HeapUsage& usage) {
+  if (const auto* pString = std::get_if<std::string>(&value.value)) {
+    addString(*pString, usage);
+  } else if (
+      const auto* pArray = std::get_if<MapJsonValue::Array>(&value.value)) {
+    if (pArray->capacity() > 0) {
+      usage.bytes += pArray->capacity() * sizeof(MapJsonValue);
+      ++usage.allocations;
+    }
+    for (const MapJsonValue& element : *pArray) {
+      addValue(element, usage);
+    }
+  } else if (
+      const auto* pObject = std::get_if<MapJsonValue::Object>(&value.value)) {
+    usage.bytes += pObject->size() *
+                   (sizeof(MapJsonValue::Object::value_type) + mapNodeOverhead);
+    usage.allocations += pObject->size();
+    for (const auto& [key, property] : *pObject) {
+      addString(key, usage);
+      addValue(property, usage);
+    }
+  }
+}
+
+template <typename T> HeapUsage getHeapUsage(const T& value) {
+  HeapUsage usage;
+  addValue(value, usage);
+  return usage;
+}
+
+// A legacy batch table style JSON with an object of properties for each of
+// many features, as in the metadata of buildings.
+std::vector<std::byte> createMetadataJson(size_t featureCount) {
+  std::string json = R"({"features":[)";
+  for (size_t i = 0; i < featureCount; ++i) {
+    const std::string id = std::to_string(i);
+    if (i > 0) {
+      json += ',';
+    }
+    json += R"({"id":)" + id + R"(,"name":"Building )" + id +
+            R"(","height":)" + std::to_string(double(i % 97) * 0.5) +
+            R"(,"yearBuilt":)" + std::to_string(1900 + i % 120) +
+            R"(,"roofType":"flat","material":"brick","occupied":true,)" +
+            R"("address":{"street":"Main Street","number":)" + id +
+            R"(,"postalCode":"12345"},"tags":["residential","historic"]})";
+  }
+  json += "]}";
+  return std::vector<std::byte>(
+      reinterpret_cast<const std::byte*>(json.data()),
+      reinterpret_cast<const std::byte*>(json.data()) + json.size());
+}
+} // namespace
+
+TEST_CASE("Benchmark JsonValue object representation", "[.][benchmark]") {
+  const std::vector<std::byte> json = createMetadataJson(20000);
+
+  JsonObjectJsonHandler flatHandler;
+  MapJsonValueHandler mapHandler;
+  const ReadJsonResult<JsonValue> flat =
+      JsonReader::readJson(json, flatHandler);
+  const ReadJsonResult<MapJsonValue> map =
+      JsonReader::readJson(json, mapHandler);
+  REQUIRE(flat.value);
+  REQUIRE(map.value);
+  REQUIRE(flat.value->getObject().at("features").getArray().size() == 20000);
+
+  const HeapUsage flatUsage = getHeapUsage(*flat.value);
+  const HeapUsage mapUsage = getHeapUsage(*map.value);
+  CHECK(flatUsage.bytes < mapUsage.bytes);
+  CHECK(flatUsage.allocations < mapUsage.allocations);
+  WARN(
+      json.size() << " bytes of JSON are held in " << flatUsage.bytes
+                  << " bytes and " << flatUsage.allocations
+                  << " allocations with flat objects, and in "
+                  << mapUsage.bytes << " bytes and " << mapUsage.allocations
+                  << " allocations with std::map objects");
+
+  BENCHMARK("Read JSON into flat objects") {
+    return JsonReader::readJson(json, flatHandler).value.has_value();
+  };
+
+  BENCHMARK("Read JSON into std::map objects") {
+    return JsonReader::readJson(json, mapHandler).value.has_value();
+  };
+}
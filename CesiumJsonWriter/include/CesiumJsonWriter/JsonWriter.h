@@ -1,5 +1,6 @@
 #pragma once
 
+#include <gsl/span>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
@@ -42,6 +43,18 @@ public:
   virtual void Primitive(std::nullptr_t value);
   virtual void Primitive(std::string_view string);
 
+  /**
+   * @name Arrays of numbers
+   * @brief Writes an array of numbers in one call, which is faster than
+   * writing each of them with {@link Primitive}.
+   */
+  //! @{
+  virtual void PrimitiveArray(gsl::span<const std::int32_t> values);
+  virtual void PrimitiveArray(gsl::span<const std::int64_t> values);
+  virtual void PrimitiveArray(gsl::span<const float> values);
+  virtual void PrimitiveArray(gsl::span<const double> values);
+  //! @}
+
   // Integral
   virtual void KeyPrimitive(std::string_view keyName, std::int32_t value);
   virtual void KeyPrimitive(std::string_view keyName, std::uint32_t value);
@@ -69,6 +82,21 @@ public:
   virtual std::string_view toStringView();
   virtual std::vector<std::byte> toBytes();
 
+  /**
+   * @brief Makes room for at least the given number of bytes more output, so
+   * that writing them does not grow the output over and over.
+   */
+  virtual void reserve(size_t byteCount);
+
+  /**
+   * @brief Clears what has been written, along with the errors and warnings,
+   * so that this writer can be used for a new document.
+   *
+   * The memory allocated for the output is kept, so writing another document
+   * of a similar size does not allocate it again.
+   */
+  virtual void reset();
+
   template <typename ErrorStr> void emplaceError(ErrorStr&& error) {
     _errors.emplace_back(std::forward<ErrorStr>(error));
   }
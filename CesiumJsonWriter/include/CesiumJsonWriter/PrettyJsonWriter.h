@@ -2,6 +2,7 @@
 
 #include "JsonWriter.h"
 
+#include <gsl/span>
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
 
@@ -47,6 +48,12 @@ public:
   void Primitive(std::nullptr_t value) override;
   void Primitive(std::string_view string) override;
 
+  // Arrays of numbers
+  void PrimitiveArray(gsl::span<const std::int32_t> values) override;
+  void PrimitiveArray(gsl::span<const std::int64_t> values) override;
+  void PrimitiveArray(gsl::span<const float> values) override;
+  void PrimitiveArray(gsl::span<const double> values) override;
+
   // Integral
   void KeyPrimitive(std::string_view keyName, std::int32_t value) override;
   void KeyPrimitive(std::string_view keyName, std::uint32_t value) override;
@@ -74,5 +81,7 @@ public:
   std::string toString() override;
   std::string_view toStringView() override;
   std::vector<std::byte> toBytes() override;
+  void reserve(size_t byteCount) override;
+  void reset() override;
 };
 } // namespace CesiumJsonWriter
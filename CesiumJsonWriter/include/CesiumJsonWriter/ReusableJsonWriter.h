@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CesiumJsonWriter/JsonWriter.h"
+#include "CesiumJsonWriter/Library.h"
+#include "CesiumJsonWriter/PrettyJsonWriter.h"
+
+namespace CesiumJsonWriter {
+/**
+ * @brief A {@link JsonWriter} and a {@link PrettyJsonWriter} that are kept
+ * from one document to the next, so that the memory they write into is only
+ * allocated once.
+ *
+ * This is useful when writing many documents, such as the tiles of a tileset.
+ * An instance must only be used by one thread at a time, so use one per
+ * thread.
+ */
+class CESIUMJSONWRITER_API ReusableJsonWriter {
+public:
+  /**
+   * @brief Gets a writer for a new document, after clearing whatever was
+   * written with it before.
+   *
+   * @param prettyPrint Whether to get the {@link PrettyJsonWriter}.
+   * @return The writer, which is valid until the next call.
+   */
+  JsonWriter& getWriter(bool prettyPrint);
+
+private:
+  JsonWriter _compact;
+  PrettyJsonWriter _pretty;
+};
+} // namespace CesiumJsonWriter
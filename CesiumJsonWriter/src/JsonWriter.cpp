@@ -1,5 +1,7 @@
 #include "CesiumJsonWriter/JsonWriter.h"
 
+#include "writeNumbers.h"
+
 #include <algorithm>
 #include <iterator>
 #include <string>
@@ -22,7 +24,7 @@ bool JsonWriter::Uint64(std::uint64_t i) { return _compact->Uint64(i); }
 
 bool JsonWriter::Int64(std::int64_t i) { return _compact->Int64(i); }
 
-bool JsonWriter::Double(double d) { return _compact->Double(d); }
+bool JsonWriter::Double(double d) { return writeDouble(*_compact, d); }
 
 bool JsonWriter::RawNumber(const char* str, unsigned int length, bool copy) {
   return _compact->RawNumber(str, length, copy);
@@ -54,11 +56,9 @@ void JsonWriter::Primitive(std::int64_t value) { _compact->Int64(value); }
 
 void JsonWriter::Primitive(std::uint64_t value) { _compact->Uint64(value); }
 
-void JsonWriter::Primitive(float value) {
-  _compact->Double(static_cast<double>(value));
-}
+void JsonWriter::Primitive(float value) { writeFloat(*_compact, value); }
 
-void JsonWriter::Primitive(double value) { _compact->Double(value); }
+void JsonWriter::Primitive(double value) { writeDouble(*_compact, value); }
 
 void JsonWriter::Primitive(std::nullptr_t) { _compact->Null(); }
 
@@ -66,6 +66,23 @@ void JsonWriter::Primitive(std::string_view string) {
   _compact->String(string.data(), static_cast<unsigned int>(string.size()));
 }
 
+// Arrays of numbers
+void JsonWriter::PrimitiveArray(gsl::span<const std::int32_t> values) {
+  writeNumberArray(*_compact, values);
+}
+
+void JsonWriter::PrimitiveArray(gsl::span<const std::int64_t> values) {
+  writeNumberArray(*_compact, values);
+}
+
+void JsonWriter::PrimitiveArray(gsl::span<const float> values) {
+  writeNumberArray(*_compact, values);
+}
+
+void JsonWriter::PrimitiveArray(gsl::span<const double> values) {
+  writeNumberArray(*_compact, values);
+}
+
 // Integral
 void JsonWriter::KeyPrimitive(std::string_view keyName, std::int32_t value) {
   Key(keyName);
@@ -131,7 +148,7 @@ void JsonWriter::KeyObject(
 }
 
 std::string JsonWriter::toString() {
-  return std::string(_compactBuffer.GetString());
+  return std::string(_compactBuffer.GetString(), _compactBuffer.GetSize());
 }
 
 std::string_view JsonWriter::toStringView() {
@@ -146,4 +163,15 @@ std::vector<std::byte> JsonWriter::toBytes() {
   return result;
 }
 
+void JsonWriter::reserve(size_t byteCount) {
+  _compactBuffer.Reserve(byteCount);
+}
+
+void JsonWriter::reset() {
+  _compactBuffer.Clear();
+  _compact->Reset(_compactBuffer);
+  _errors.clear();
+  _warnings.clear();
+}
+
 } // namespace CesiumJsonWriter
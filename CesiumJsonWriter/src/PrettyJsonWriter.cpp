@@ -1,5 +1,7 @@
 #include "CesiumJsonWriter/PrettyJsonWriter.h"
 
+#include "writeNumbers.h"
+
 #include <algorithm>
 #include <iterator>
 #include <string>
@@ -27,7 +29,7 @@ bool PrettyJsonWriter::Uint64(std::uint64_t i) { return pretty->Uint64(i); }
 
 bool PrettyJsonWriter::Int64(std::int64_t i) { return pretty->Int64(i); }
 
-bool PrettyJsonWriter::Double(double d) { return pretty->Double(d); }
+bool PrettyJsonWriter::Double(double d) { return writeDouble(*pretty, d); }
 
 bool PrettyJsonWriter::RawNumber(
     const char* str,
@@ -62,11 +64,9 @@ void PrettyJsonWriter::Primitive(std::int64_t value) { pretty->Int64(value); }
 
 void PrettyJsonWriter::Primitive(std::uint64_t value) { pretty->Uint64(value); }
 
-void PrettyJsonWriter::Primitive(float value) {
-  pretty->Double(static_cast<double>(value));
-}
+void PrettyJsonWriter::Primitive(float value) { writeFloat(*pretty, value); }
 
-void PrettyJsonWriter::Primitive(double value) { pretty->Double(value); }
+void PrettyJsonWriter::Primitive(double value) { writeDouble(*pretty, value); }
 
 void PrettyJsonWriter::Primitive(std::nullptr_t) { pretty->Null(); }
 
@@ -74,6 +74,23 @@ void PrettyJsonWriter::Primitive(std::string_view string) {
   pretty->String(string.data(), static_cast<unsigned int>(string.size()));
 }
 
+// Arrays of numbers
+void PrettyJsonWriter::PrimitiveArray(gsl::span<const std::int32_t> values) {
+  writeNumberArray(*pretty, values);
+}
+
+void PrettyJsonWriter::PrimitiveArray(gsl::span<const std::int64_t> values) {
+  writeNumberArray(*pretty, values);
+}
+
+void PrettyJsonWriter::PrimitiveArray(gsl::span<const float> values) {
+  writeNumberArray(*pretty, values);
+}
+
+void PrettyJsonWriter::PrimitiveArray(gsl::span<const double> values) {
+  writeNumberArray(*pretty, values);
+}
+
 // Integral
 void PrettyJsonWriter::KeyPrimitive(
     std::string_view keyName,
@@ -149,11 +166,11 @@ void PrettyJsonWriter::KeyObject(
 }
 
 std::string PrettyJsonWriter::toString() {
-  return std::string(_prettyBuffer.GetString());
+  return std::string(_prettyBuffer.GetString(), _prettyBuffer.GetSize());
 }
 
 std::string_view PrettyJsonWriter::toStringView() {
-  return std::string_view(_prettyBuffer.GetString());
+  return std::string_view(_prettyBuffer.GetString(), _prettyBuffer.GetSize());
 }
 
 std::vector<std::byte> PrettyJsonWriter::toBytes() {
@@ -163,4 +180,14 @@ std::vector<std::byte> PrettyJsonWriter::toBytes() {
   std::copy(view.begin(), view.end(), u8Pointer);
   return result;
 }
+
+void PrettyJsonWriter::reserve(size_t byteCount) {
+  _prettyBuffer.Reserve(byteCount);
+}
+
+void PrettyJsonWriter::reset() {
+  JsonWriter::reset();
+  _prettyBuffer.Clear();
+  pretty->Reset(_prettyBuffer);
+}
 } // namespace CesiumJsonWriter
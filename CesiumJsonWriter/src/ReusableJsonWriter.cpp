@@ -0,0 +1,10 @@
+#include "CesiumJsonWriter/ReusableJsonWriter.h"
+
+namespace CesiumJsonWriter {
+JsonWriter& ReusableJsonWriter::getWriter(bool prettyPrint) {
+  JsonWriter& writer =
+      prettyPrint ? static_cast<JsonWriter&>(_pretty) : _compact;
+  writer.reset();
+  return writer;
+}
+} // namespace CesiumJsonWriter
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <gsl/span>
+#include <rapidjson/internal/diyfp.h>
+#include <rapidjson/internal/dtoa.h>
+#include <rapidjson/internal/itoa.h>
+#include <rapidjson/rapidjson.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace CesiumJsonWriter {
+
+/**
+ * @brief Finds the shortest digits that read back as the given float, as
+ * `rapidjson::internal::Grisu2` does for a double.
+ *
+ * The value must be positive. Widening a float to a double and formatting
+ * that gives the digits of the double, like `0.10000000149011612` for `0.1f`,
+ * so this uses the distance to the neighboring floats instead.
+ */
+inline void grisu2Float(float value, char* buffer, int* length, int* K) {
+  using rapidjson::internal::DiyFp;
+
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const uint32_t fraction = bits & 0x7FFFFF;
+  const int32_t biasedExponent = int32_t((bits >> 23) & 0xFF);
+
+  uint64_t f = fraction;
+  int e = 1 - 150;
+  if (biasedExponent != 0) {
+    f |= 0x800000;
+    e = biasedExponent - 150;
+  }
+
+  // The boundaries halfway to the neighboring floats. The one below is
+  // closer when the value is a power of two, because the float below has a
+  // smaller exponent.
+  const DiyFp plus = DiyFp((f << 1) + 1, e - 1).NormalizeBoundary();
+  DiyFp minus = fraction == 0 && biasedExponent > 1
+                    ? DiyFp((f << 2) - 1, e - 2)
+                    : DiyFp((f << 1) - 1, e - 1);
+  minus.f <<= minus.e - plus.e;
+  minus.e = plus.e;
+
+  const DiyFp cachedPower = rapidjson::internal::GetCachedPower(plus.e, K);
+  const DiyFp W = DiyFp(f, e).Normalize() * cachedPower;
+  DiyFp Wp = plus * cachedPower;
+  DiyFp Wm = minus * cachedPower;
+  Wm.f++;
+  Wp.f--;
+  rapidjson::internal::DigitGen(W, Wp, Wp.f - Wm.f, buffer, length, K);
+}
+
+/**
+ * @brief Writes a finite double as the shortest number that reads back as
+ * it, formatted like `rapidjson::Writer::Double`, and returns the end.
+ *
+ * Whole numbers, which are common in transforms and bounding volumes, are
+ * written without searching for their digits.
+ *
+ * The buffer must have room for 25 characters.
+ */
+inline char* formatDouble(double value, char* buffer) {
+  constexpr double largestExactInteger = 9007199254740992.0;
+  if (value != 0.0 && std::abs(value) < largestExactInteger &&
+      std::trunc(value) == value) {
+    int64_t integer = static_cast<int64_t>(value);
+    if (integer < 0) {
+      *buffer++ = '-';
+      integer = -integer;
+    }
+    char* end = rapidjson::internal::u64toa(uint64_t(integer), buffer);
+    *end++ = '.';
+    *end++ = '0';
+    return end;
+  }
+
+  return rapidjson::internal::dtoa(value, buffer);
+}
+
+/**
+ * @brief Writes a finite float as the shortest number that reads back as it,
+ * and returns the end.
+ *
+ * The buffer must have room for 25 characters.
+ */
+inline char* formatFloat(float value, char* buffer) {
+  // Below 2^24, every whole number is a float and needs all of its digits.
+  constexpr float largestExactInteger = 16777216.0f;
+  if (value == 0.0f ||
+      (std::abs(value) < largestExactInteger && std::trunc(value) == value)) {
+    return formatDouble(double(value), buffer);
+  }
+
+  if (value < 0.0f) {
+    *buffer++ = '-';
+    value = -value;
+  }
+  int length;
+  int K;
+  grisu2Float(value, buffer, &length, &K);
+  return rapidjson::internal::Prettify(buffer, length, K, 324);
+}
+
+/**
+ * @brief Writes a double with a RapidJSON writer, formatted by
+ * {@link formatDouble}.
+ *
+ * Values that are not finite are passed to the writer, which rejects them.
+ */
+template <typename TWriter> bool writeDouble(TWriter& writer, double value) {
+  if (!std::isfinite(value)) {
+    return writer.Double(value);
+  }
+
+  char buffer[25];
+  const char* end = formatDouble(value, buffer);
+  return writer.RawValue(
+      buffer,
+      size_t(end - buffer),
+      rapidjson::Type::kNumberType);
+}
+
+/**
+ * @brief Writes a float with a RapidJSON writer, formatted by
+ * {@link formatFloat}.
+ */
+template <typename TWriter> bool writeFloat(TWriter& writer, float value) {
+  if (!std::isfinite(value)) {
+    return writer.Double(double(value));
+  }
+
+  char buffer[25];
+  const char* end = formatFloat(value, buffer);
+  return writer.RawValue(
+      buffer,
+      size_t(end - buffer),
+      rapidjson::Type::kNumberType);
+}
+
+/**
+ * @brief Writes an array of numbers with a RapidJSON writer.
+ */
+template <typename TWriter, typename T>
+void writeNumberArray(TWriter& writer, const gsl::span<const T>& values) {
+  writer.StartArray();
+  for (const T value : values) {
+    if constexpr (std::is_same_v<T, double>) {
+      writeDouble(writer, value);
+    } else if constexpr (std::is_same_v<T, float>) {
+      writeFloat(writer, value);
+    } else {
+      writer.Int64(value);
+    }
+  }
+  writer.EndArray();
+}
+
+} // namespace CesiumJsonWriter
@@ -0,0 +1,138 @@
+#include <CesiumJsonWriter/JsonWriter.h>
+#include <CesiumJsonWriter/PrettyJsonWriter.h>
+
+#include <catch2/catch.hpp>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace CesiumJsonWriter;
+
+namespace {
+std::string writeWithRapidJson(double value) {
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.Double(value);
+  return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+template <typename T> std::string write(T value) {
+  JsonWriter writer;
+  writer.Primitive(value);
+  return std::string(writer.toStringView());
+}
+} // namespace
+
+TEST_CASE("JsonWriter writes doubles like RapidJSON") {
+  const std::vector<double> values{
+      0.0,
+      -0.0,
+      1.0,
+      -2.0,
+      0.1,
+      1.0 / 3.0,
+      6378137.0,
+      -6356752.314245179,
+      4503599627370497.0,
+      9007199254740992.0,
+      1e21,
+      1e-7,
+      std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::lowest(),
+      std::numeric_limits<double>::denorm_min()};
+
+  for (const double value : values) {
+    CHECK(write(value) == writeWithRapidJson(value));
+  }
+
+  JsonWriter writer;
+  CHECK(!writer.Double(std::numeric_limits<double>::quiet_NaN()));
+}
+
+TEST_CASE("JsonWriter writes floats as the shortest number that reads back "
+          "as them") {
+  CHECK(write(0.1f) == "0.1");
+  CHECK(write(-2.5f) == "-2.5");
+  CHECK(write(1.0f) == "1.0");
+  CHECK(write(-0.0f) == "-0.0");
+  CHECK(write(1e-10f) == "1e-10");
+  CHECK(write(16777216.0f) == "16777216.0");
+
+  std::vector<float> values{
+      1.0f / 3.0f,
+      123456.789f,
+      std::numeric_limits<float>::max(),
+      std::numeric_limits<float>::min(),
+      std::numeric_limits<float>::denorm_min()};
+  for (float value = 1e-6f; value < 1e6f; value *= 1.37f) {
+    values.emplace_back(value);
+    values.emplace_back(-std::nextafter(value, 0.0f));
+  }
+
+  for (const float value : values) {
+    const std::string written = write(value);
+    CHECK(std::strtof(written.c_str(), nullptr) == value);
+    // At most 9 significant digits, with a sign and up to 5 leading zeros.
+    CHECK(written.size() <= 17);
+  }
+}
+
+TEST_CASE("JsonWriter writes arrays of numbers in one call") {
+  const bool prettyPrint = GENERATE(false, true);
+  PrettyJsonWriter pretty;
+  JsonWriter compact;
+  JsonWriter& writer = prettyPrint ? pretty : compact;
+  PrettyJsonWriter expectedPretty;
+  JsonWriter expectedCompact;
+  JsonWriter& expected = prettyPrint ? expectedPretty : expectedCompact;
+
+  const std::vector<double> doubles{1.0, 0.5, -3.25};
+  const std::vector<float> floats{0.1f, 2.0f};
+  const std::vector<int64_t> int64s{-1, 4000000000};
+  const std::vector<int32_t> int32s{};
+
+  writer.reserve(256);
+  writer.StartObject();
+  writer.Key("doubles");
+  writer.PrimitiveArray(doubles);
+  writer.Key("floats");
+  writer.PrimitiveArray(floats);
+  writer.Key("int64s");
+  writer.PrimitiveArray(int64s);
+  writer.Key("int32s");
+  writer.PrimitiveArray(int32s);
+  writer.EndObject();
+
+  expected.StartObject();
+  expected.KeyArray("doubles", [&]() {
+    for (const double value : doubles) {
+      expected.Primitive(value);
+    }
+  });
+  expected.KeyArray("floats", [&]() {
+    for (const float value : floats) {
+      expected.Primitive(value);
+    }
+  });
+  expected.KeyArray("int64s", [&]() {
+    for (const int64_t value : int64s) {
+      expected.Primitive(value);
+    }
+  });
+  expected.KeyArray("int32s", []() {});
+  expected.EndObject();
+
+  CHECK(writer.toStringView() == expected.toStringView());
+  if (!prettyPrint) {
+    CHECK(
+        writer.toStringView() ==
+        R"({"doubles":[1.0,0.5,-3.25],"floats":[0.1,2.0],)"
+        R"("int64s":[-1,4000000000],"int32s":[]})");
+  }
+}
@@ -0,0 +1,26 @@
+#include <CesiumJsonWriter/ReusableJsonWriter.h>
+
+#include <catch2/catch.hpp>
+
+using namespace CesiumJsonWriter;
+
+TEST_CASE("ReusableJsonWriter clears each writer before reusing it") {
+  ReusableJsonWriter reusable;
+  const bool prettyPrint = GENERATE(false, true);
+
+  JsonWriter& first = reusable.getWriter(prettyPrint);
+  first.StartObject();
+  first.KeyPrimitive("a", int32_t(1));
+  first.EndObject();
+  first.emplaceError("error");
+  first.emplaceWarning("warning");
+
+  JsonWriter& second = reusable.getWriter(prettyPrint);
+  CHECK(&first == &second);
+  CHECK(second.getErrors().empty());
+  CHECK(second.getWarnings().empty());
+
+  second.StartArray();
+  second.EndArray();
+  CHECK(second.toStringView() == "[]");
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace CesiumNativeTests {
+
+// A file of a benchmark corpus and how to decode it. The decode function
+// returns false if decoding failed, and must be safe to call from several
+// threads at once. If it reads external resources, such as the buffers of a
+// glTF, their size counts toward the throughput too.
+struct DecodeBenchmarkItem {
+  std::string name;
+  std::vector<std::byte> data;
+  std::function<bool(const std::vector<std::byte>&)> decode;
+  size_t externalByteLength = 0;
+};
+
+// Checks that each item of the corpus decodes, reports its throughput in MB/s
+// and decodes/s with a single thread and with one thread per core, and runs a
+// Catch2 BENCHMARK of decoding it once. Call this from a hidden test case
+// tagged [benchmark].
+void benchmarkDecoding(const std::vector<DecodeBenchmarkItem>& corpus);
+
+} // namespace CesiumNativeTests
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/Promise.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace CesiumNativeTests {
+
+// The conditions of a network simulated by SimulatedAssetAccessor.
+struct SimulatedNetworkOptions {
+  // The median time until the first byte of a response arrives, in seconds.
+  double medianLatency = 0.05;
+
+  // The standard deviation of the logarithm of the latency, which follows a
+  // log-normal distribution. With 0.0, every latency is the median.
+  double latencyDeviation = 0.0;
+
+  // The bandwidth of the link that all responses share, in bytes per second,
+  // or 0.0 for no limit. The link carries one response at a time.
+  double bandwidth = 0.0;
+
+  // The largest number of requests that are in flight to a host at once, or 0
+  // for no limit. The others wait in the order they were made.
+  size_t maximumRequestsPerHost = 0;
+
+  // The fraction of requests that fail with a 503 status code.
+  double failureRate = 0.0;
+
+  // The seed of the random latencies and failures.
+  uint32_t seed = 1;
+};
+
+// Answers requests with the responses of another accessor, after the delays
+// of a simulated network. Time is simulated too: requests only complete when
+// advanceTime or tick is called, so a run under the same conditions is
+// reproducible.
+//
+// The underlying accessor is expected to answer right away, like
+// SimpleAssetAccessor, and everything must happen in one thread, such as with
+// SimpleTaskProcessor.
+class SimulatedAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  SimulatedAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const SimulatedNetworkOptions& options);
+
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override;
+
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  // Completes the next request, advancing the time to when it's done, so that
+  // waiting for requests by ticking the accessor doesn't hang.
+  void tick() noexcept override;
+
+  // Advances the simulated time by the given number of seconds, completing
+  // the requests that are done by then, in the order they're done.
+  void advanceTime(double seconds);
+
+  // Gets the simulated time, in seconds since the accessor was created.
+  double getTime() const noexcept { return this->_time; }
+
+  // Gets the number of requests that were made, including the failed ones.
+  size_t getRequestCount() const noexcept { return this->_requestCount; }
+
+  // Gets the number of requests that failed.
+  size_t getFailedRequestCount() const noexcept {
+    return this->_failedRequestCount;
+  }
+
+  // Gets the number of requests that haven't completed yet.
+  size_t getPendingRequestCount() const noexcept;
+
+private:
+  struct QueuedRequest {
+    CesiumAsync::AsyncSystem asyncSystem;
+    std::string verb;
+    std::string url;
+    std::vector<THeader> headers;
+    std::vector<std::byte> contentPayload;
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise;
+  };
+
+  struct InFlightRequest {
+    double completionTime;
+    uint64_t sequence;
+    std::string host;
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest;
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise;
+  };
+
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  enqueue(QueuedRequest&& queued);
+  void startQueuedRequests(const std::string& host);
+  void start(const std::string& host, QueuedRequest&& queued);
+  std::vector<InFlightRequest>::iterator findNextCompletion();
+  void complete(std::vector<InFlightRequest>::iterator it);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  SimulatedNetworkOptions _options;
+  std::mt19937 _random;
+  double _time;
+  double _linkAvailableTime;
+  uint64_t _nextSequence;
+  size_t _requestCount;
+  size_t _failedRequestCount;
+  std::map<std::string, std::deque<QueuedRequest>> _queuedRequests;
+  std::map<std::string, size_t> _inFlightRequestCounts;
+  std::vector<InFlightRequest> _inFlightRequests;
+};
+
+} // namespace CesiumNativeTests
@@ -0,0 +1,72 @@
+#include <CesiumNativeTests/DecodeBenchmark.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace CesiumNativeTests {
+
+namespace {
+struct Throughput {
+  double megabytesPerSecond;
+  double decodesPerSecond;
+};
+
+// Decodes the item over and over on the given number of threads for about
+// half a second.
+Throughput
+measureThroughput(const DecodeBenchmarkItem& item, uint32_t threadCount) {
+  using clock = std::chrono::steady_clock;
+  const clock::time_point start = clock::now();
+  const clock::time_point deadline = start + std::chrono::milliseconds(500);
+
+  std::atomic<uint64_t> decodes{0};
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < threadCount; ++i) {
+    threads.emplace_back([&item, &decodes, deadline]() {
+      uint64_t count = 0;
+      do {
+        item.decode(item.data);
+        ++count;
+      } while (clock::now() < deadline);
+      decodes += count;
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  const std::chrono::duration<double> elapsed = clock::now() - start;
+  const double decodesPerSecond = double(decodes) / elapsed.count();
+  const size_t byteLength = item.data.size() + item.externalByteLength;
+  return Throughput{
+      decodesPerSecond * double(byteLength) / (1024.0 * 1024.0),
+      decodesPerSecond};
+}
+} // namespace
+
+void benchmarkDecoding(const std::vector<DecodeBenchmarkItem>& corpus) {
+  const uint32_t threadCount =
+      std::max(std::thread::hardware_concurrency(), 1U);
+
+  for (const DecodeBenchmarkItem& item : corpus) {
+    REQUIRE(item.decode(item.data));
+
+    const Throughput single = measureThroughput(item, 1);
+    const Throughput multiple = measureThroughput(item, threadCount);
+    WARN(
+        item.name << ": " << single.megabytesPerSecond << " MB/s, "
+                  << single.decodesPerSecond << " decodes/s with 1 thread, "
+                  << multiple.megabytesPerSecond << " MB/s, "
+                  << multiple.decodesPerSecond << " decodes/s with "
+                  << threadCount << " threads");
+
+    BENCHMARK(std::string(item.name)) { return item.decode(item.data); };
+  }
+}
+
+} // namespace CesiumNativeTests
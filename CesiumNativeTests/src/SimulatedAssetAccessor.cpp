@@ -0,0 +1,216 @@
+#include <CesiumAsync/SchedulingAssetAccessor.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimulatedAssetAccessor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+using namespace CesiumAsync;
+
+namespace CesiumNativeTests {
+
+SimulatedAssetAccessor::SimulatedAssetAccessor(
+    const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+    const SimulatedNetworkOptions& options)
+    : _pAssetAccessor(pAssetAccessor),
+      _options(options),
+      _random(options.seed),
+      _time(0.0),
+      _linkAvailableTime(0.0),
+      _nextSequence(0),
+      _requestCount(0),
+      _failedRequestCount(0),
+      _queuedRequests(),
+      _inFlightRequestCounts(),
+      _inFlightRequests() {}
+
+Future<std::shared_ptr<IAssetRequest>> SimulatedAssetAccessor::get(
+    const AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<THeader>& headers) {
+  return this->enqueue(QueuedRequest{
+      asyncSystem,
+      "GET",
+      url,
+      headers,
+      {},
+      asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>()});
+}
+
+Future<std::shared_ptr<IAssetRequest>> SimulatedAssetAccessor::request(
+    const AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->enqueue(QueuedRequest{
+      asyncSystem,
+      verb,
+      url,
+      headers,
+      std::vector<std::byte>(contentPayload.begin(), contentPayload.end()),
+      asyncSystem.createPromise<std::shared_ptr<IAssetRequest>>()});
+}
+
+void SimulatedAssetAccessor::tick() noexcept {
+  if (this->_inFlightRequests.empty()) {
+    return;
+  }
+
+  auto it = this->findNextCompletion();
+  this->_time = std::max(this->_time, it->completionTime);
+  this->complete(it);
+}
+
+void SimulatedAssetAccessor::advanceTime(double seconds) {
+  const double endTime = this->_time + seconds;
+  while (!this->_inFlightRequests.empty()) {
+    auto it = this->findNextCompletion();
+    if (it->completionTime > endTime) {
+      break;
+    }
+
+    this->_time = std::max(this->_time, it->completionTime);
+    this->complete(it);
+  }
+
+  this->_time = endTime;
+}
+
+size_t SimulatedAssetAccessor::getPendingRequestCount() const noexcept {
+  size_t count = this->_inFlightRequests.size();
+  for (const auto& queued : this->_queuedRequests) {
+    count += queued.second.size();
+  }
+  return count;
+}
+
+std::vector<SimulatedAssetAccessor::InFlightRequest>::iterator
+SimulatedAssetAccessor::findNextCompletion() {
+  return std::min_element(
+      this->_inFlightRequests.begin(),
+      this->_inFlightRequests.end(),
+      [](const InFlightRequest& lhs, const InFlightRequest& rhs) {
+        return std::tie(lhs.completionTime, lhs.sequence) <
+               std::tie(rhs.completionTime, rhs.sequence);
+      });
+}
+
+Future<std::shared_ptr<IAssetRequest>>
+SimulatedAssetAccessor::enqueue(QueuedRequest&& queued) {
+  ++this->_requestCount;
+  Future<std::shared_ptr<IAssetRequest>> future = queued.promise.getFuture();
+
+  const std::string host = SchedulingAssetAccessor::getHost(queued.url);
+  this->_queuedRequests[host].emplace_back(std::move(queued));
+  this->startQueuedRequests(host);
+
+  return future;
+}
+
+void SimulatedAssetAccessor::startQueuedRequests(const std::string& host) {
+  auto queuedIt = this->_queuedRequests.find(host);
+  while (queuedIt != this->_queuedRequests.end() &&
+         !queuedIt->second.empty() &&
+         (this->_options.maximumRequestsPerHost == 0 ||
+          this->_inFlightRequestCounts[host] <
+              this->_options.maximumRequestsPerHost)) {
+    QueuedRequest queued = std::move(queuedIt->second.front());
+    queuedIt->second.pop_front();
+    if (queuedIt->second.empty()) {
+      this->_queuedRequests.erase(queuedIt);
+    }
+
+    this->start(host, std::move(queued));
+    queuedIt = this->_queuedRequests.find(host);
+  }
+}
+
+void SimulatedAssetAccessor::start(
+    const std::string& host,
+    QueuedRequest&& queued) {
+  ++this->_inFlightRequestCounts[host];
+
+  double latency = this->_options.medianLatency;
+  if (this->_options.latencyDeviation > 0.0) {
+    std::lognormal_distribution<double> distribution(
+        std::log(this->_options.medianLatency),
+        this->_options.latencyDeviation);
+    latency = distribution(this->_random);
+  }
+
+  const bool failed =
+      std::uniform_real_distribution<double>(0.0, 1.0)(this->_random) <
+      this->_options.failureRate;
+
+  const double firstByteTime = this->_time + latency;
+  const uint64_t sequence = this->_nextSequence++;
+  Promise<std::shared_ptr<IAssetRequest>> promise = std::move(queued.promise);
+
+  auto addInFlightRequest =
+      [this,
+       host,
+       firstByteTime,
+       sequence,
+       failed,
+       promise,
+       verb = queued.verb,
+       url = queued.url,
+       headers = queued.headers](std::shared_ptr<IAssetRequest>&& pRequest) {
+        if (failed) {
+          ++this->_failedRequestCount;
+          pRequest = std::make_shared<SimpleAssetRequest>(
+              verb,
+              url,
+              HttpHeaders(headers.begin(), headers.end()),
+              std::make_unique<SimpleAssetResponse>(
+                  static_cast<uint16_t>(503),
+                  "",
+                  HttpHeaders{},
+                  std::vector<std::byte>()));
+        }
+
+        const IAssetResponse* pResponse =
+            pRequest ? pRequest->response() : nullptr;
+        double completionTime = firstByteTime;
+        if (pResponse && this->_options.bandwidth > 0.0) {
+          // The response waits for the link to be free, then takes it over.
+          completionTime = std::max(firstByteTime, this->_linkAvailableTime) +
+                           double(pResponse->data().size()) /
+                               this->_options.bandwidth;
+          this->_linkAvailableTime = completionTime;
+        }
+
+        this->_inFlightRequests.emplace_back(InFlightRequest{
+            completionTime,
+            sequence,
+            host,
+            std::move(pRequest),
+            promise});
+      };
+
+  this->_pAssetAccessor
+      ->request(
+          queued.asyncSystem,
+          queued.verb,
+          queued.url,
+          queued.headers,
+          queued.contentPayload)
+      .thenImmediately(std::move(addInFlightRequest));
+}
+
+void SimulatedAssetAccessor::complete(
+    std::vector<InFlightRequest>::iterator it) {
+  InFlightRequest inFlight = std::move(*it);
+  this->_inFlightRequests.erase(it);
+
+  --this->_inFlightRequestCounts[inFlight.host];
+  this->startQueuedRequests(inFlight.host);
+
+  // Resolving the promise may make more requests, so do it last.
+  inFlight.promise.resolve(std::move(inFlight.pRequest));
+}
+
+} // namespace CesiumNativeTests
@@ -74,6 +74,13 @@ public:
    * @param tileBoundingVoume The tile bounding volume.
    * @param url The URL from which the data was loaded.
    * @param data The actual tile data.
+   * @param enableWaterMask Whether to include the water mask of the tile, if
+   * it has one, in the primitive's extras.
+   * @param bakeSkirts Whether to add skirt vertices and triangles to the
+   * mesh. If false, the skirts are left to the renderer: the
+   * {@link CesiumGltfContent::SkirtMeshMetadata} in the primitive's extras
+   * then lists the vertices on each edge of the tile, along with the skirt
+   * height.
    * @return The {@link QuantizedMeshLoadResult}
    */
   static QuantizedMeshLoadResult load(
@@ -81,7 +88,8 @@ public:
       const CesiumGeospatial::BoundingRegion& tileBoundingVolume,
       const std::string& url,
       const gsl::span<const std::byte>& data,
-      bool enableWaterMask);
+      bool enableWaterMask,
+      bool bakeSkirts = true);
 
   /**
    * @brief Parses the metadata (tile availability) from the given
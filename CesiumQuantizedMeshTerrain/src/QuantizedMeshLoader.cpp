@@ -15,6 +15,7 @@
 #include <glm/vec3.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <stdexcept>
 
@@ -114,6 +115,50 @@ int32_t zigZagDecode(int32_t value) noexcept {
   return (value >> 1) ^ (-(value & 1));
 }
 
+// Vertices and indices are decoded in blocks of this many values. Within a
+// block, the only dependency between the values is a prefix sum of a fixed
+// size, so the compiler can vectorize the decoding of the whole block.
+constexpr size_t decodeBlockSize = 8;
+
+// Replaces each value of a block by the sum of it and the values before it.
+template <class T>
+void prefixSumBlock(std::array<T, decodeBlockSize>& block) noexcept {
+  for (size_t step = 1; step < decodeBlockSize; step *= 2) {
+    for (size_t i = decodeBlockSize - 1; i >= step; --i) {
+      block[i] = static_cast<T>(block[i] + block[i - step]);
+    }
+  }
+}
+
+// Decodes the zig-zag encoded deltas of a vertex attribute to the values of
+// the attribute, as ratios of the full range of 32767.
+void decodeVertexAttribute(
+    const gsl::span<const uint16_t>& encoded,
+    std::vector<double>& decoded) {
+  decoded.resize(encoded.size());
+
+  int32_t value = 0;
+  size_t i = 0;
+  for (; i + decodeBlockSize <= encoded.size(); i += decodeBlockSize) {
+    std::array<int32_t, decodeBlockSize> block;
+    for (size_t j = 0; j < decodeBlockSize; ++j) {
+      block[j] = zigZagDecode(encoded[i + j]);
+    }
+    prefixSumBlock(block);
+    for (size_t j = 0; j < decodeBlockSize; ++j) {
+      decoded[i + j] = static_cast<double>(value + block[j]) / 32767.0;
+    }
+    value += block[decodeBlockSize - 1];
+  }
+
+  for (; i < encoded.size(); ++i) {
+    value += zigZagDecode(encoded[i]);
+    decoded[i] = static_cast<double>(value) / 32767.0;
+  }
+}
+
+// Decodes high-water mark encoded indices. Each index is the number of zero
+// codes before it minus its own code.
 template <class E, class D>
 void decodeIndices(
     const gsl::span<const E>& encoded,
@@ -123,13 +168,29 @@ void decodeIndices(
   }
 
   E highest = 0;
-  for (size_t i = 0; i < encoded.size(); ++i) {
-    E code = encoded[i];
-    E decodedIdx = static_cast<E>(highest - code);
-    decoded[i] = static_cast<D>(decodedIdx);
-    if (code == 0) {
-      ++highest;
+  size_t i = 0;
+  for (; i + decodeBlockSize <= encoded.size(); i += decodeBlockSize) {
+    std::array<E, decodeBlockSize> zeros;
+    for (size_t j = 0; j < decodeBlockSize; ++j) {
+      zeros[j] = static_cast<E>(encoded[i + j] == 0);
     }
+    prefixSumBlock(zeros);
+
+    // The prefix sum includes the code of the index itself, which only
+    // counts for the indices after it.
+    for (size_t j = 0; j < decodeBlockSize; ++j) {
+      const E code = encoded[i + j];
+      const E highestBefore =
+          static_cast<E>(highest + zeros[j] - static_cast<E>(code == 0));
+      decoded[i + j] = static_cast<D>(static_cast<E>(highestBefore - code));
+    }
+    highest = static_cast<E>(highest + zeros[decodeBlockSize - 1]);
+  }
+
+  for (; i < encoded.size(); ++i) {
+    const E code = encoded[i];
+    decoded[i] = static_cast<D>(static_cast<E>(highest - code));
+    highest = static_cast<E>(highest + static_cast<E>(code == 0));
   }
 }
 
@@ -382,12 +443,9 @@ static void addSkirt(
   const double east = rectangle.getEast();
   const double north = rectangle.getNorth();
 
-  size_t newEdgeIndex = currentVertexCount;
-  size_t positionIdx = currentVertexCount * 3;
-  size_t indexIdx = currentIndicesCount;
-  for (size_t i = 0; i < edgeIndices.size(); ++i) {
-    E edgeIdx = edgeIndices[i];
-
+  std::vector<Cartographic> cartographics;
+  cartographics.reserve(edgeIndices.size());
+  for (const E edgeIdx : edgeIndices) {
     const double uRatio = uvsAndHeights[edgeIdx].x;
     const double vRatio = uvsAndHeights[edgeIdx].y;
     const double heightRatio = uvsAndHeights[edgeIdx].z;
@@ -395,9 +453,19 @@ static void addSkirt(
     const double latitude = Math::lerp(south, north, vRatio) + latitudeOffset;
     const double heightMeters =
         Math::lerp(minimumHeight, maximumHeight, heightRatio) - skirtHeight;
-    glm::dvec3 position = ellipsoid.cartographicToCartesian(
-        Cartographic(longitude, latitude, heightMeters));
-    position -= center;
+    cartographics.emplace_back(longitude, latitude, heightMeters);
+  }
+
+  std::vector<glm::dvec3> skirtPositions(edgeIndices.size());
+  ellipsoid.cartographicToCartesian(cartographics, skirtPositions);
+
+  size_t newEdgeIndex = currentVertexCount;
+  size_t positionIdx = currentVertexCount * 3;
+  size_t indexIdx = currentIndicesCount;
+  for (size_t i = 0; i < edgeIndices.size(); ++i) {
+    E edgeIdx = edgeIndices[i];
+
+    const glm::dvec3 position = skirtPositions[i] - center;
 
     positions[positionIdx] = static_cast<float>(position.x);
     positions[positionIdx + 1] = static_cast<float>(position.y);
@@ -599,6 +667,50 @@ static void addSkirts(
       positionMaximums);
 }
 
+template <class E, class Compare>
+static std::vector<uint32_t> sortEdge(
+    const gsl::span<const std::byte>& edgeIndicesBuffer,
+    Compare compare) {
+  const gsl::span<const E> edgeIndices(
+      reinterpret_cast<const E*>(edgeIndicesBuffer.data()),
+      edgeIndicesBuffer.size() / sizeof(E));
+  std::vector<uint32_t> sorted(edgeIndices.begin(), edgeIndices.end());
+  std::sort(sorted.begin(), sorted.end(), compare);
+  return sorted;
+}
+
+// Lists the vertices on each edge in the order in which addSkirts connects
+// them, for renderers that generate the skirts themselves.
+template <class E>
+static void setSortedEdgeIndices(
+    const std::vector<glm::dvec3>& uvsAndHeights,
+    const gsl::span<const std::byte>& westEdgeIndicesBuffer,
+    const gsl::span<const std::byte>& southEdgeIndicesBuffer,
+    const gsl::span<const std::byte>& eastEdgeIndicesBuffer,
+    const gsl::span<const std::byte>& northEdgeIndicesBuffer,
+    SkirtMeshMetadata& skirtMeshMetadata) {
+  skirtMeshMetadata.westEdgeIndices = sortEdge<E>(
+      westEdgeIndicesBuffer,
+      [&uvsAndHeights](uint32_t lhs, uint32_t rhs) noexcept {
+        return uvsAndHeights[lhs].y < uvsAndHeights[rhs].y;
+      });
+  skirtMeshMetadata.southEdgeIndices = sortEdge<E>(
+      southEdgeIndicesBuffer,
+      [&uvsAndHeights](uint32_t lhs, uint32_t rhs) noexcept {
+        return uvsAndHeights[lhs].x > uvsAndHeights[rhs].x;
+      });
+  skirtMeshMetadata.eastEdgeIndices = sortEdge<E>(
+      eastEdgeIndicesBuffer,
+      [&uvsAndHeights](uint32_t lhs, uint32_t rhs) noexcept {
+        return uvsAndHeights[lhs].y > uvsAndHeights[rhs].y;
+      });
+  skirtMeshMetadata.northEdgeIndices = sortEdge<E>(
+      northEdgeIndicesBuffer,
+      [&uvsAndHeights](uint32_t lhs, uint32_t rhs) noexcept {
+        return uvsAndHeights[lhs].x < uvsAndHeights[rhs].x;
+      });
+}
+
 static void decodeNormals(
     const gsl::span<const std::byte>& encoded,
     const gsl::span<float>& decoded) {
@@ -618,11 +730,13 @@ static void decodeNormals(
 }
 
 template <class T>
-static std::vector<std::byte> generateNormals(
+static CesiumUtility::ByteVector generateNormals(
     const gsl::span<const float>& positions,
     const gsl::span<T>& indices,
     size_t currentNumOfIndex) {
-  std::vector<std::byte> normalsBuffer(positions.size() * sizeof(float));
+  CesiumUtility::ByteVector normalsBuffer(
+      positions.size() * sizeof(float),
+      CesiumUtility::AllocationCategory::GltfBuffer);
   const gsl::span<float> normals(
       reinterpret_cast<float*>(normalsBuffer.data()),
       positions.size());
@@ -673,7 +787,8 @@ static std::vector<std::byte> generateNormals(
     const BoundingRegion& tileBoundingVolume,
     const std::string& url,
     const gsl::span<const std::byte>& data,
-    bool enableWaterMask) {
+    bool enableWaterMask,
+    bool bakeSkirts) {
 
   CESIUM_TRACE("Cesium3DTilesSelection::QuantizedMeshLoader::load");
 
@@ -690,15 +805,18 @@ static std::vector<std::byte> generateNormals(
   const QuantizedMeshHeader* pHeader = meshView->header;
   const uint32_t vertexCount = pHeader->vertexCount;
   const uint32_t indicesCount = meshView->triangleCount * 3;
-  const uint32_t skirtVertexCount =
+  const uint32_t edgeVertexCount =
       meshView->westEdgeIndicesCount + meshView->southEdgeIndicesCount +
       meshView->eastEdgeIndicesCount + meshView->northEdgeIndicesCount;
-  const uint32_t skirtIndicesCount = (skirtVertexCount - 4) * 6;
+  const uint32_t skirtVertexCount = bakeSkirts ? edgeVertexCount : 0;
+  const uint32_t skirtIndicesCount =
+      skirtVertexCount >= 4 ? (skirtVertexCount - 4) * 6 : 0;
 
   // decode position without skirt, but preallocate position buffer to include
   // skirt as well
-  std::vector<std::byte> outputPositionsBuffer(
-      (vertexCount + skirtVertexCount) * 3 * sizeof(float));
+  CesiumUtility::ByteVector outputPositionsBuffer(
+      (vertexCount + skirtVertexCount) * 3 * sizeof(float),
+      CesiumUtility::AllocationCategory::GltfBuffer);
   gsl::span<float> outputPositions(
       reinterpret_cast<float*>(outputPositionsBuffer.data()),
       (vertexCount + skirtVertexCount) * 3);
@@ -726,40 +844,45 @@ static std::vector<std::byte> generateNormals(
   const double east = rectangle.getEast();
   const double north = rectangle.getNorth();
 
-  int32_t u = 0;
-  int32_t v = 0;
-  int32_t height = 0;
-  std::vector<glm::dvec3> uvsAndHeights;
-  uvsAndHeights.reserve(vertexCount);
-  for (size_t i = 0; i < vertexCount; ++i) {
-    u += zigZagDecode(meshView->uBuffer[i]);
-    v += zigZagDecode(meshView->vBuffer[i]);
-    height += zigZagDecode(meshView->heightBuffer[i]);
+  // Decode each attribute separately, and then combine them.
+  std::vector<double> uRatios;
+  std::vector<double> vRatios;
+  std::vector<double> heightRatios;
+  decodeVertexAttribute(meshView->uBuffer, uRatios);
+  decodeVertexAttribute(meshView->vBuffer, vRatios);
+  decodeVertexAttribute(meshView->heightBuffer, heightRatios);
 
-    double uRatio = static_cast<double>(u) / 32767.0;
-    double vRatio = static_cast<double>(v) / 32767.0;
-    double heightRatio = static_cast<double>(height) / 32767.0;
+  std::vector<glm::dvec3> uvsAndHeights(vertexCount);
+  std::vector<Cartographic> cartographics(vertexCount, Cartographic(0.0, 0.0));
+  for (size_t i = 0; i < vertexCount; ++i) {
+    const double uRatio = uRatios[i];
+    const double vRatio = vRatios[i];
+    const double heightRatio = heightRatios[i];
+
+    cartographics[i] = Cartographic(
+        Math::lerp(west, east, uRatio),
+        Math::lerp(south, north, vRatio),
+        Math::lerp(minimumHeight, maximumHeight, heightRatio));
+    uvsAndHeights[i] = glm::dvec3(uRatio, vRatio, heightRatio);
+  }
 
-    const double longitude = Math::lerp(west, east, uRatio);
-    const double latitude = Math::lerp(south, north, vRatio);
-    const double heightMeters =
-        Math::lerp(minimumHeight, maximumHeight, heightRatio);
+  // Convert all of the vertices to cartesian at once.
+  std::vector<glm::dvec3> positions(vertexCount);
+  ellipsoid.cartographicToCartesian(cartographics, positions);
 
-    glm::dvec3 position = ellipsoid.cartographicToCartesian(
-        Cartographic(longitude, latitude, heightMeters));
-    position -= center;
+  for (size_t i = 0; i < vertexCount; ++i) {
+    const glm::dvec3 position = positions[i] - center;
     outputPositions[positionOutputIndex++] = static_cast<float>(position.x);
     outputPositions[positionOutputIndex++] = static_cast<float>(position.y);
     outputPositions[positionOutputIndex++] = static_cast<float>(position.z);
 
     positionMinimums = glm::min(positionMinimums, position);
     positionMaximums = glm::max(positionMaximums, position);
-
-    uvsAndHeights.emplace_back(uRatio, vRatio, heightRatio);
   }
 
   // decode normal vertices of the tile as well as its metadata without skirt
-  std::vector<std::byte> outputNormalsBuffer;
+  CesiumUtility::ByteVector outputNormalsBuffer(
+      CesiumUtility::AllocationCategory::GltfBuffer);
   gsl::span<float> outputNormals;
   if (!meshView->octEncodedNormalBuffer.empty()) {
     const uint32_t totalNormalFloats = (vertexCount + skirtVertexCount) * 3;
@@ -785,7 +908,8 @@ static std::vector<std::byte> generateNormals(
   // indices buffer for gltf to include tile and skirt indices. Caution of
   // indices type since adding skirt means the number of vertices is potentially
   // over maximum of uint16_t
-  std::vector<std::byte> outputIndicesBuffer;
+  CesiumUtility::ByteVector outputIndicesBuffer(
+      CesiumUtility::AllocationCategory::GltfBuffer);
   uint32_t indexSizeBytes =
       meshView->indexType == QuantizedMeshIndexType::UnsignedInt
           ? sizeof(uint32_t)
@@ -815,27 +939,29 @@ static std::vector<std::byte> generateNormals(
     }
 
     // add skirt
-    addSkirts<uint32_t, uint32_t>(
-        ellipsoid,
-        center,
-        rectangle,
-        minimumHeight,
-        maximumHeight,
-        vertexCount,
-        indicesCount,
-        skirtHeight,
-        longitudeOffset,
-        latitudeOffset,
-        uvsAndHeights,
-        meshView->westEdgeIndicesBuffer,
-        meshView->southEdgeIndicesBuffer,
-        meshView->eastEdgeIndicesBuffer,
-        meshView->northEdgeIndicesBuffer,
-        outputPositions,
-        outputNormals,
-        outputIndices,
-        positionMinimums,
-        positionMaximums);
+    if (bakeSkirts) {
+      addSkirts<uint32_t, uint32_t>(
+          ellipsoid,
+          center,
+          rectangle,
+          minimumHeight,
+          maximumHeight,
+          vertexCount,
+          indicesCount,
+          skirtHeight,
+          longitudeOffset,
+          latitudeOffset,
+          uvsAndHeights,
+          meshView->westEdgeIndicesBuffer,
+          meshView->southEdgeIndicesBuffer,
+          meshView->eastEdgeIndicesBuffer,
+          meshView->northEdgeIndicesBuffer,
+          outputPositions,
+          outputNormals,
+          outputIndices,
+          positionMinimums,
+          positionMaximums);
+    }
 
     indexSizeBytes = sizeof(uint32_t);
   } else {
@@ -860,27 +986,29 @@ static std::vector<std::byte> generateNormals(
             outputNormalsBuffer.size() / sizeof(float));
       }
 
-      addSkirts<uint16_t, uint16_t>(
-          ellipsoid,
-          center,
-          rectangle,
-          minimumHeight,
-          maximumHeight,
-          vertexCount,
-          indicesCount,
-          skirtHeight,
-          longitudeOffset,
-          latitudeOffset,
-          uvsAndHeights,
-          meshView->westEdgeIndicesBuffer,
-          meshView->southEdgeIndicesBuffer,
-          meshView->eastEdgeIndicesBuffer,
-          meshView->northEdgeIndicesBuffer,
-          outputPositions,
-          outputNormals,
-          outputIndices,
-          positionMinimums,
-          positionMaximums);
+      if (bakeSkirts) {
+        addSkirts<uint16_t, uint16_t>(
+            ellipsoid,
+            center,
+            rectangle,
+            minimumHeight,
+            maximumHeight,
+            vertexCount,
+            indicesCount,
+            skirtHeight,
+            longitudeOffset,
+            latitudeOffset,
+            uvsAndHeights,
+            meshView->westEdgeIndicesBuffer,
+            meshView->southEdgeIndicesBuffer,
+            meshView->eastEdgeIndicesBuffer,
+            meshView->northEdgeIndicesBuffer,
+            outputPositions,
+            outputNormals,
+            outputIndices,
+            positionMinimums,
+            positionMaximums);
+      }
 
       indexSizeBytes = sizeof(uint16_t);
     } else {
@@ -899,27 +1027,29 @@ static std::vector<std::byte> generateNormals(
             outputNormalsBuffer.size() / sizeof(float));
       }
 
-      addSkirts<uint16_t, uint32_t>(
-          ellipsoid,
-          center,
-          rectangle,
-          minimumHeight,
-          maximumHeight,
-          vertexCount,
-          indicesCount,
-          skirtHeight,
-          longitudeOffset,
-          latitudeOffset,
-          uvsAndHeights,
-          meshView->westEdgeIndicesBuffer,
-          meshView->southEdgeIndicesBuffer,
-          meshView->eastEdgeIndicesBuffer,
-          meshView->northEdgeIndicesBuffer,
-          outputPositions,
-          outputNormals,
-          outputIndices,
-          positionMinimums,
-          positionMaximums);
+      if (bakeSkirts) {
+        addSkirts<uint16_t, uint32_t>(
+            ellipsoid,
+            center,
+            rectangle,
+            minimumHeight,
+            maximumHeight,
+            vertexCount,
+            indicesCount,
+            skirtHeight,
+            longitudeOffset,
+            latitudeOffset,
+            uvsAndHeights,
+            meshView->westEdgeIndicesBuffer,
+            meshView->southEdgeIndicesBuffer,
+            meshView->eastEdgeIndicesBuffer,
+            meshView->northEdgeIndicesBuffer,
+            outputPositions,
+            outputNormals,
+            outputIndices,
+            positionMinimums,
+            positionMaximums);
+      }
 
       indexSizeBytes = sizeof(uint32_t);
     }
@@ -1053,6 +1183,26 @@ static std::vector<std::byte> generateNormals(
   skirtMeshMetadata.skirtSouthHeight = skirtHeight;
   skirtMeshMetadata.skirtEastHeight = skirtHeight;
   skirtMeshMetadata.skirtNorthHeight = skirtHeight;
+  if (!bakeSkirts) {
+    skirtMeshMetadata.hasBakedSkirts = false;
+    if (meshView->indexType == QuantizedMeshIndexType::UnsignedInt) {
+      setSortedEdgeIndices<uint32_t>(
+          uvsAndHeights,
+          meshView->westEdgeIndicesBuffer,
+          meshView->southEdgeIndicesBuffer,
+          meshView->eastEdgeIndicesBuffer,
+          meshView->northEdgeIndicesBuffer,
+          skirtMeshMetadata);
+    } else {
+      setSortedEdgeIndices<uint16_t>(
+          uvsAndHeights,
+          meshView->westEdgeIndicesBuffer,
+          meshView->southEdgeIndicesBuffer,
+          meshView->eastEdgeIndicesBuffer,
+          meshView->northEdgeIndicesBuffer,
+          skirtMeshMetadata);
+    }
+  }
 
   primitive.extras = SkirtMeshMetadata::createGltfExtras(skirtMeshMetadata);
 
@@ -4,6 +4,7 @@
 #include <CesiumGeospatial/GeographicProjection.h>
 #include <CesiumGeospatial/Projection.h>
 #include <CesiumGltf/AccessorView.h>
+#include <CesiumGltfContent/SkirtMeshMetadata.h>
 #include <CesiumQuantizedMeshTerrain/QuantizedMeshLoader.h>
 #include <CesiumUtility/Math.h>
 
@@ -16,6 +17,7 @@ using namespace Cesium3DTilesContent;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 using namespace CesiumGltf;
+using namespace CesiumGltfContent;
 using namespace CesiumQuantizedMeshTerrain;
 using namespace CesiumUtility;
 
@@ -1048,6 +1050,75 @@ TEST_CASE("Test converting quantized mesh to gltf with skirt") {
       REQUIRE(Math::equalsEpsilon(normals[i].z, normal.z, Math::Epsilon2));
     }
   }
+
+  SECTION("Check quantized mesh without baked skirts") {
+    uint32_t verticesWidth = 3;
+    uint32_t verticesHeight = 3;
+    QuadtreeTileID tileID(10, 0, 0);
+    CesiumGeometry::Rectangle tileRectangle =
+        tilingScheme.tileToRectangle(tileID);
+    BoundingRegion boundingVolume = BoundingRegion(
+        GlobeRectangle(
+            tileRectangle.minimumX,
+            tileRectangle.minimumY,
+            tileRectangle.maximumX,
+            tileRectangle.maximumY),
+        0.0,
+        0.0);
+    QuantizedMesh<uint16_t> quantizedMesh = createGridQuantizedMesh<uint16_t>(
+        boundingVolume,
+        verticesWidth,
+        verticesHeight);
+
+    std::vector<std::byte> quantizedMeshBin =
+        convertQuantizedMeshToBinary(quantizedMesh);
+    gsl::span<const std::byte> data(
+        quantizedMeshBin.data(),
+        quantizedMeshBin.size());
+    QuantizedMeshLoadResult loadResult = QuantizedMeshLoader::load(
+        tileID,
+        boundingVolume,
+        "url",
+        data,
+        false,
+        false);
+    REQUIRE(!loadResult.errors.hasErrors());
+    REQUIRE(loadResult.model != std::nullopt);
+
+    checkGltfSanity(*loadResult.model);
+
+    // the mesh is only the grid
+    const CesiumGltf::Model& model = *loadResult.model;
+    const CesiumGltf::MeshPrimitive& primitive =
+        model.meshes.front().primitives.front();
+    AccessorView<uint16_t> indices(model, primitive.indices);
+    REQUIRE(indices.status() == AccessorViewStatus::Valid);
+    CHECK(
+        static_cast<size_t>(indices.size()) ==
+        quantizedMesh.vertexData.indices.size());
+    AccessorView<glm::vec3> positions(
+        model,
+        primitive.attributes.at("POSITION"));
+    REQUIRE(positions.status() == AccessorViewStatus::Valid);
+    CHECK(positions.size() == verticesWidth * verticesHeight);
+
+    // the edges are listed in the order the skirts connect them
+    std::optional<SkirtMeshMetadata> skirtMeshMetadata =
+        SkirtMeshMetadata::parseFromGltfExtras(primitive.extras);
+    REQUIRE(skirtMeshMetadata);
+    CHECK(!skirtMeshMetadata->hasBakedSkirts);
+    CHECK(skirtMeshMetadata->noSkirtIndicesCount == indices.size());
+    CHECK(skirtMeshMetadata->noSkirtVerticesCount == positions.size());
+    CHECK(skirtMeshMetadata->skirtWestHeight > 0.0);
+    CHECK(
+        skirtMeshMetadata->westEdgeIndices == std::vector<uint32_t>{0, 3, 6});
+    CHECK(
+        skirtMeshMetadata->southEdgeIndices == std::vector<uint32_t>{2, 1, 0});
+    CHECK(
+        skirtMeshMetadata->eastEdgeIndices == std::vector<uint32_t>{8, 5, 2});
+    CHECK(
+        skirtMeshMetadata->northEdgeIndices == std::vector<uint32_t>{6, 7, 8});
+  }
 }
 
 TEST_CASE("Test converting ill-formed quantized mesh") {
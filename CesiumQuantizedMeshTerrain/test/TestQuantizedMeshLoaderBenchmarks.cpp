@@ -0,0 +1,70 @@
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGeometry/QuadtreeTilingScheme.h>
+#include <CesiumGeometry/Rectangle.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumNativeTests/DecodeBenchmark.h>
+#include <CesiumNativeTests/readFile.h>
+#include <CesiumQuantizedMeshTerrain/QuantizedMeshLoader.h>
+
+#include <catch2/catch.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumNativeTests;
+using namespace CesiumQuantizedMeshTerrain;
+
+namespace {
+DecodeBenchmarkItem
+createItem(const std::string& filename, bool enableWaterMask = false) {
+  const QuadtreeTilingScheme tilingScheme(
+      Rectangle(
+          glm::radians(-180.0),
+          glm::radians(-90.0),
+          glm::radians(180.0),
+          glm::radians(90.0)),
+      2,
+      1);
+  const QuadtreeTileID tileID(10, 0, 0);
+  const Rectangle rectangle = tilingScheme.tileToRectangle(tileID);
+  const BoundingRegion boundingVolume(
+      GlobeRectangle(
+          rectangle.minimumX,
+          rectangle.minimumY,
+          rectangle.maximumX,
+          rectangle.maximumY),
+      0.0,
+      0.0);
+
+  return DecodeBenchmarkItem{
+      filename,
+      readFile(
+          std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) /
+          "CesiumTerrainTileJson" / filename),
+      [tileID, boundingVolume, enableWaterMask](
+          const std::vector<std::byte>& data) {
+        QuantizedMeshLoadResult result = QuantizedMeshLoader::load(
+            tileID,
+            boundingVolume,
+            "url",
+            data,
+            enableWaterMask);
+        return result.model && !result.errors.hasErrors();
+      }};
+}
+} // namespace
+
+TEST_CASE("Benchmark QuantizedMeshLoader::load", "[.][benchmark]") {
+  benchmarkDecoding(
+      {createItem("tile.terrain"),
+       createItem("tile.octvertexnormals.terrain"),
+       createItem("tile.octvertexnormals.watermask.terrain", true),
+       createItem("tile.metadataavailability.terrain"),
+       createItem("tile.32bitIndices.terrain")});
+}
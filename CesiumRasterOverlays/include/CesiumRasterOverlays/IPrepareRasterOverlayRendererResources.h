@@ -3,6 +3,7 @@
 #include "Library.h"
 
 #include <any>
+#include <cstdint>
 
 namespace CesiumGltf {
 struct ImageCesium;
@@ -10,6 +11,7 @@ struct ImageCesium;
 
 namespace CesiumRasterOverlays {
 class RasterOverlayTile;
+struct RasterOverlayAtlasRegion;
 }
 
 namespace CesiumRasterOverlays {
@@ -71,6 +73,75 @@ public:
       const RasterOverlayTile& rasterTile,
       void* pLoadThreadResult,
       void* pMainThreadResult) noexcept = 0;
+
+  /**
+   * @brief Creates a page of a {@link RasterOverlayTextureAtlas}: a texture
+   * that holds the images of many raster tiles.
+   *
+   * This is only called for overlays with
+   * {@link RasterOverlayOptions::useTextureAtlas}, from the same thread that
+   * calls {@link prepareRasterInMainThread}. The default implementation
+   * returns `nullptr`, so that each raster tile gets its own texture.
+   *
+   * @param width The width of the page in pixels.
+   * @param height The height of the page in pixels.
+   * @param channels The number of channels of the images of the page.
+   * @param bytesPerChannel The number of bytes of each channel of the images
+   * of the page.
+   * @param rendererOptions Renderer options associated with the raster overlay
+   * from {@link RasterOverlayOptions::rendererOptions}.
+   * @returns Arbitrary data representing the page, which is passed to
+   * {@link prepareRasterInAtlasPage} and {@link freeRasterAtlasPage}, or
+   * `nullptr` if no page was created.
+   */
+  virtual void* createRasterAtlasPage(
+      int32_t /*width*/,
+      int32_t /*height*/,
+      int32_t /*channels*/,
+      int32_t /*bytesPerChannel*/,
+      const std::any& /*rendererOptions*/) {
+    return nullptr;
+  }
+
+  /**
+   * @brief Prepares a raster tile whose image is stored in a page of a
+   * {@link RasterOverlayTextureAtlas}, instead of calling
+   * {@link prepareRasterInMainThread}.
+   *
+   * This should copy the image of the raster tile to the region of the page,
+   * and fill the border of one pixel around the region with the edge pixels
+   * of the image.
+   *
+   * @param rasterTile The raster tile to prepare.
+   * @param pLoadThreadResult The value returned from
+   * {@link prepareRasterInLoadThread}.
+   * @param pAtlasPage The value returned from {@link createRasterAtlasPage}
+   * for the page.
+   * @param region The region of the page for the image, which is also
+   * returned by {@link RasterOverlayTile::getAtlasRegion}.
+   * @returns Arbitrary data representing the result of the load process, like
+   * the value returned from {@link prepareRasterInMainThread}. The default
+   * implementation calls {@link prepareRasterInMainThread}.
+   */
+  virtual void* prepareRasterInAtlasPage(
+      RasterOverlayTile& rasterTile,
+      void* pLoadThreadResult,
+      void* /*pAtlasPage*/,
+      const RasterOverlayAtlasRegion& /*region*/) {
+    return this->prepareRasterInMainThread(rasterTile, pLoadThreadResult);
+  }
+
+  /**
+   * @brief Frees a page created by {@link createRasterAtlasPage}, once none
+   * of the raster tiles use it.
+   *
+   * This is called from the thread that destroyed the last raster tile of the
+   * page, after {@link freeRaster} is called for that tile, or from the thread
+   * that destroyed the {@link RasterOverlayTileProvider}.
+   *
+   * @param pAtlasPage The value returned from {@link createRasterAtlasPage}.
+   */
+  virtual void freeRasterAtlasPage(void* /*pAtlasPage*/) noexcept {}
 };
 
 } // namespace CesiumRasterOverlays
@@ -6,9 +6,16 @@
 #include <CesiumAsync/IAssetRequest.h>
 #include <CesiumGeospatial/Ellipsoid.h>
 
+#include <gsl/span>
+
+#include <cstddef>
 #include <functional>
 #include <memory>
 
+namespace CesiumAsync {
+class ICacheDatabase;
+}
+
 namespace CesiumRasterOverlays {
 
 /**
@@ -27,13 +34,22 @@ public:
    * @param ionAssetID The asset ID.
    * @param ionAccessToken The access token.
    * @param overlayOptions The {@link RasterOverlayOptions} for this instance.
+   * @param ionAssetEndpointUrl The URL of the Cesium ion API.
+   * @param pEndpointCache A database in which to keep the response of the
+   * asset's endpoint, such as a {@link CesiumAsync::SqliteCache}. When a
+   * response from an earlier session is still in the database, the tile
+   * provider is created right away instead of waiting for the API, and the
+   * endpoint is requested again in the background. Responses are kept for an
+   * hour, which is about as long as their access tokens are valid.
    */
   IonRasterOverlay(
       const std::string& name,
       int64_t ionAssetID,
       const std::string& ionAccessToken,
       const RasterOverlayOptions& overlayOptions = {},
-      const std::string& ionAssetEndpointUrl = "https://api.cesium.com/");
+      const std::string& ionAssetEndpointUrl = "https://api.cesium.com/",
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pEndpointCache =
+          nullptr);
   virtual ~IonRasterOverlay() override;
 
   virtual CesiumAsync::Future<CreateTileProviderResult> createTileProvider(
@@ -50,6 +66,7 @@ private:
   int64_t _ionAssetID;
   std::string _ionAccessToken;
   std::string _ionAssetEndpointUrl;
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pEndpointCache;
 
   struct AssetEndpointAttribution {
     std::string html;
@@ -68,6 +85,9 @@ private:
 
   static std::unordered_map<std::string, ExternalAssetEndpoint> endpointCache;
 
+  static nonstd::expected<ExternalAssetEndpoint, std::string>
+  parseEndpointResponse(const gsl::span<const std::byte>& data);
+
   CesiumAsync::Future<CreateTileProviderResult> createTileProvider(
       const ExternalAssetEndpoint& endpoint,
       const CesiumAsync::AsyncSystem& asyncSystem,
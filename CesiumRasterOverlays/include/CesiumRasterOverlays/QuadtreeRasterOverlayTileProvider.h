@@ -13,6 +13,8 @@
 #include <list>
 #include <memory>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace CesiumRasterOverlays {
 
@@ -38,6 +40,9 @@ public:
    * @param maximumLevel The maximum quadtree tile level.
    * @param imageWidth The image width.
    * @param imageHeight The image height.
+   * @param metaTileSize The number of tiles along each side of the blocks of
+   * tiles that are loaded as one image by {@link loadQuadtreeMetaTileImage},
+   * or 1 to load each tile by itself with {@link loadQuadtreeTileImage}.
    */
   QuadtreeRasterOverlayTileProvider(
       const CesiumUtility::IntrusivePointer<const RasterOverlay>& pOwner,
@@ -53,7 +58,8 @@ public:
       uint32_t minimumLevel,
       uint32_t maximumLevel,
       uint32_t imageWidth,
-      uint32_t imageHeight) noexcept;
+      uint32_t imageHeight,
+      uint32_t metaTileSize = 1) noexcept;
 
   /**
    * @brief Returns the minimum tile level of this instance.
@@ -75,6 +81,12 @@ public:
    */
   uint32_t getHeight() const noexcept { return this->_imageHeight; }
 
+  /**
+   * @brief Returns the number of tiles along each side of the blocks of tiles
+   * that are loaded as one image, or 1 if each tile is loaded by itself.
+   */
+  uint32_t getMetaTileSize() const noexcept { return this->_metaTileSize; }
+
   /**
    * @brief Returns the {@link CesiumGeometry::QuadtreeTilingScheme} of this
    * instance.
@@ -107,6 +119,28 @@ protected:
   virtual CesiumAsync::Future<LoadedRasterOverlayImage>
   loadQuadtreeTileImage(const CesiumGeometry::QuadtreeTileID& tileID) const = 0;
 
+  /**
+   * @brief Asynchronously loads a block of tiles in the quadtree as one image,
+   * when the meta-tile size is greater than 1.
+   *
+   * The image must cover the rectangles of all the tiles of the block. It is
+   * split into the images of the tiles in a worker thread, and the tiles that
+   * were not asked for yet are cached, so that one request serves them all.
+   * The default implementation returns an error.
+   *
+   * @param firstTileID The ID of the tile with the smallest coordinates in the
+   * block.
+   * @param tilesX The number of tiles in the block along the X axis.
+   * @param tilesY The number of tiles in the block along the Y axis.
+   * @return A Future that resolves to the loaded image data or error
+   * information.
+   */
+  virtual CesiumAsync::Future<LoadedRasterOverlayImage>
+  loadQuadtreeMetaTileImage(
+      const CesiumGeometry::QuadtreeTileID& firstTileID,
+      uint32_t tilesX,
+      uint32_t tilesY) const;
+
 private:
   virtual CesiumAsync::Future<LoadedRasterOverlayImage>
   loadTileImage(RasterOverlayTile& overlayTile) override final;
@@ -119,6 +153,17 @@ private:
   CesiumAsync::SharedFuture<LoadedQuadtreeImage>
   getQuadtreeTile(const CesiumGeometry::QuadtreeTileID& tileID);
 
+  // The images of the tiles of a meta-tile, in the same order as their IDs.
+  struct LoadedMetaTile {
+    std::vector<CesiumGeometry::QuadtreeTileID> tileIDs;
+    std::vector<std::shared_ptr<LoadedRasterOverlayImage>> images;
+  };
+
+  CesiumAsync::Future<std::shared_ptr<LoadedRasterOverlayImage>>
+  loadTileImageFromMetaTile(const CesiumGeometry::QuadtreeTileID& tileID);
+
+  void cacheMetaTileImages(const LoadedMetaTile& metaTile);
+
   /**
    * @brief Map raster tiles to geometry tile.
    *
@@ -157,6 +202,7 @@ private:
   uint32_t _maximumLevel;
   uint32_t _imageWidth;
   uint32_t _imageHeight;
+  uint32_t _metaTileSize;
   CesiumGeometry::QuadtreeTilingScheme _tilingScheme;
 
   struct CacheEntry {
@@ -175,6 +221,13 @@ private:
       TileLeastRecentlyUsedList::iterator>
       _tileLookup;
 
+  // The meta-tiles that are loading, by the ID of their first tile. Once one
+  // is loaded, its tiles are in the cache above instead.
+  std::unordered_map<
+      CesiumGeometry::QuadtreeTileID,
+      CesiumAsync::SharedFuture<LoadedMetaTile>>
+      _metaTilesLoading;
+
   std::atomic<int64_t> _cachedBytes;
 };
 } // namespace CesiumRasterOverlays
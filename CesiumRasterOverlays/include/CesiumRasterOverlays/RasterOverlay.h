@@ -3,6 +3,7 @@
 #include "Library.h"
 #include "RasterOverlayLoadFailureDetails.h"
 
+#include <CesiumAsync/AdaptiveConcurrencyLimit.h>
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumGltf/Ktx2TranscodeTargets.h>
 #include <CesiumUtility/IntrusivePointer.h>
@@ -37,6 +38,19 @@ struct CESIUMRASTEROVERLAYS_API RasterOverlayOptions {
    */
   int32_t maximumSimultaneousTileLoads = 20;
 
+  /**
+   * @brief Adapts the number of overlay tiles that may simultaneously be
+   * loading to the latency and throughput of their requests, or
+   * `std::nullopt` to always use {@link maximumSimultaneousTileLoads}.
+   *
+   * While set, {@link maximumSimultaneousTileLoads} is only the starting
+   * value. The current limit is reported by
+   * {@link RasterOverlayTileProvider::getMaximumSimultaneousTileLoads}. This
+   * is read when the tile provider is created.
+   */
+  std::optional<CesiumAsync::AdaptiveConcurrencyLimitOptions>
+      adaptiveLoadConcurrency;
+
   /**
    * @brief The maximum number of bytes to use to cache sub-tiles in memory.
    *
@@ -76,9 +90,31 @@ struct CESIUMRASTEROVERLAYS_API RasterOverlayOptions {
   /**
    * @brief For each possible input transmission format, this struct names
    * the ideal target gpu-compressed pixel format to transcode to.
+   *
+   * KTX2 images served by a tile provider are transcoded straight to these
+   * formats, without decoding their pixels or generating mipmaps. Tiles of a
+   * quadtree are combined block by block, so a geometry tile that needs a
+   * scaled ancestor tile, or that isn't aligned to the blocks, fails to get
+   * an image. Formats with 4x4 blocks that can be copied independently are
+   * supported, which excludes PVRTC.
    */
   CesiumGltf::Ktx2TranscodeTargets ktx2TranscodeTargets;
 
+  /**
+   * @brief The GPU compressed pixel formats that loaded images may be
+   * compressed to in a worker thread, before they're passed to
+   * {@link prepareRasterInLoadThread}.
+   *
+   * By default, no format is supported and images are left uncompressed. Only
+   * `BC1_RGB` and `BC3_RGBA` can currently be encoded. Opaque images are
+   * compressed to BC1, which takes an eighth of the memory of an RGBA image,
+   * and images with transparent pixels to BC3, which takes a quarter. Mipmaps
+   * are generated and compressed along with each image. Images whose width or
+   * height isn't a multiple of 4 are left uncompressed, and compressed images
+   * aren't packed into the texture atlas.
+   */
+  CesiumGltf::SupportedGpuCompressedPixelFormats imageCompressionFormats;
+
   /**
    * @brief A callback function that is invoked when a raster overlay resource
    * fails to load.
@@ -97,6 +133,52 @@ struct CESIUMRASTEROVERLAYS_API RasterOverlayOptions {
    */
   bool showCreditsOnScreen = false;
 
+  /**
+   * @brief Whether to pack the images of this overlay's tiles into shared
+   * textures with a {@link RasterOverlayTextureAtlas}.
+   *
+   * Geometry tiles whose overlay images are in the same page of the atlas can
+   * be drawn without binding another texture. The renderer must implement
+   * {@link IPrepareRasterOverlayRendererResources::createRasterAtlasPage} and
+   * {@link IPrepareRasterOverlayRendererResources::prepareRasterInAtlasPage},
+   * and map texture coordinates with
+   * {@link RasterOverlayTile::getAtlasRegion}. Otherwise, each tile has its
+   * own texture, as it does when this is false.
+   */
+  bool useTextureAtlas = false;
+
+  /**
+   * @brief The width and height in pixels of the pages of the texture atlas,
+   * when {@link useTextureAtlas} is true.
+   *
+   * This is rounded up to a power of two. Images that don't fit in a page,
+   * with a border of one pixel, get their own texture.
+   */
+  int32_t textureAtlasPageSize = 4096;
+
+  /**
+   * @brief Whether to first load a less detailed image for each geometry tile,
+   * and then the image with the detail it needs.
+   *
+   * Without this, a geometry tile shows the image of an ancestor until its own
+   * image is loaded, which may be much less detailed. The less detailed image
+   * is requested with {@link progressiveLoadingScreenPixelsFactor} times the
+   * screen pixels of the geometry tile. It is quicker to load, and the tile
+   * provider often has the images it needs already. The detailed image is
+   * requested once it is loaded.
+   */
+  bool loadProgressively = false;
+
+  /**
+   * @brief The factor by which the screen pixels of a geometry tile are
+   * multiplied to request its less detailed image, when
+   * {@link loadProgressively} is true.
+   *
+   * For a quadtree tile provider, the default of 0.25 requests an image two
+   * levels less detailed.
+   */
+  double progressiveLoadingScreenPixelsFactor = 0.25;
+
   /**
    * @brief Arbitrary data that will be passed to {@link prepareRasterInLoadThread},
    * for example, data to control the per-raster overlay client-specific texture
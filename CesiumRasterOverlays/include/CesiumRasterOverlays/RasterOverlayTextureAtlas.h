@@ -0,0 +1,181 @@
+#pragma once
+
+#include "Library.h"
+
+#include <CesiumGeometry/Rectangle.h>
+
+#include <any>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace CesiumRasterOverlays {
+
+class IPrepareRasterOverlayRendererResources;
+
+/**
+ * @brief The part of a page of a {@link RasterOverlayTextureAtlas} that holds
+ * the image of a {@link RasterOverlayTile}.
+ */
+struct CESIUMRASTEROVERLAYS_API RasterOverlayAtlasRegion {
+  /**
+   * @brief The index of the page that holds the image. Images with the same
+   * page index can be drawn with the same texture.
+   */
+  size_t pageIndex = 0;
+
+  /**
+   * @brief The X coordinate of the pixel of the page at which the top-left
+   * pixel of the image is copied.
+   */
+  int32_t x = 0;
+
+  /**
+   * @brief The Y coordinate of the pixel of the page at which the top-left
+   * pixel of the image is copied.
+   */
+  int32_t y = 0;
+
+  /**
+   * @brief The width of the image in pixels.
+   */
+  int32_t width = 0;
+
+  /**
+   * @brief The height of the image in pixels.
+   */
+  int32_t height = 0;
+
+  /**
+   * @brief The texture coordinates of the image in the page, from the left
+   * side of its leftmost pixel to the right side of its rightmost pixel, and
+   * similar for the vertical direction.
+   *
+   * A texture coordinate `(u, v)` of the image is the texture coordinate
+   * `(minimumX + u * computeWidth(), minimumY + v * computeHeight())` of the
+   * page.
+   */
+  CesiumGeometry::Rectangle textureCoordinates{0.0, 0.0, 0.0, 0.0};
+};
+
+/**
+ * @brief Packs the images of the tiles of a {@link RasterOverlayTileProvider}
+ * into large, shared textures, called pages.
+ *
+ * Drawing geometry tiles that use the same page doesn't require binding
+ * another texture, so a renderer can batch them. Each page is square, and its
+ * size is a power of two. It is divided like a quadtree: an image takes the
+ * smallest square block that holds it and a border of one pixel on each side,
+ * and its block is merged back with its free siblings when it is freed. The
+ * border keeps bilinear filtering from blending the edges of neighboring
+ * images. The renderer should fill it with the edge pixels of the image.
+ *
+ * Pages are created, filled and freed by the
+ * {@link IPrepareRasterOverlayRendererResources}. A page is freed as soon as
+ * none of its blocks are used.
+ *
+ * This class isn't thread-safe. A tile provider only uses it in the main
+ * thread.
+ */
+class CESIUMRASTEROVERLAYS_API RasterOverlayTextureAtlas final {
+public:
+  /**
+   * @brief Creates a new instance.
+   *
+   * @param pageSize The width and height of pages in pixels. This is rounded
+   * up to a power of two.
+   * @param pPrepareRendererResources The interface that creates and frees the
+   * renderer resources of the pages.
+   * @param rendererOptions The renderer options of the raster overlay, from
+   * {@link RasterOverlayOptions::rendererOptions}.
+   */
+  RasterOverlayTextureAtlas(
+      int32_t pageSize,
+      const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::any& rendererOptions);
+
+  /**
+   * @brief Frees the renderer resources of all pages.
+   */
+  ~RasterOverlayTextureAtlas() noexcept;
+
+  RasterOverlayTextureAtlas(const RasterOverlayTextureAtlas&) = delete;
+  RasterOverlayTextureAtlas&
+  operator=(const RasterOverlayTextureAtlas&) = delete;
+
+  /**
+   * @brief Gets the width and height of pages in pixels.
+   */
+  int32_t getPageSize() const noexcept { return this->_pageSize; }
+
+  /**
+   * @brief Allocates a region for an image, creating a new page if no page
+   * with the same pixel format has room for it.
+   *
+   * @param width The width of the image in pixels.
+   * @param height The height of the image in pixels.
+   * @param channels The number of channels of the image.
+   * @param bytesPerChannel The number of bytes of each channel of the image.
+   * @return The region, or `std::nullopt` if the image and its border are
+   * larger than a page, or if
+   * {@link IPrepareRasterOverlayRendererResources::createRasterAtlasPage}
+   * didn't create a page.
+   */
+  std::optional<RasterOverlayAtlasRegion> allocate(
+      int32_t width,
+      int32_t height,
+      int32_t channels,
+      int32_t bytesPerChannel);
+
+  /**
+   * @brief Frees a region returned by {@link allocate}, and its page if it
+   * was the last region of its page.
+   *
+   * @param region The region to free.
+   */
+  void free(const RasterOverlayAtlasRegion& region) noexcept;
+
+  /**
+   * @brief Gets the renderer resources of a page, as created by
+   * {@link IPrepareRasterOverlayRendererResources::createRasterAtlasPage}.
+   *
+   * @param pageIndex The {@link RasterOverlayAtlasRegion::pageIndex} of the
+   * page.
+   * @return The renderer resources, or `nullptr` if there is no such page.
+   */
+  void* getPageRendererResources(size_t pageIndex) const noexcept;
+
+  /**
+   * @brief Gets the number of pages that are currently allocated.
+   */
+  size_t getPageCount() const noexcept;
+
+private:
+  struct Page {
+    void* pRendererResources;
+    int32_t channels;
+    int32_t bytesPerChannel;
+    // The origins of the free blocks at each level. The block at level 0 is
+    // the whole page, and each level halves the size of blocks.
+    std::vector<std::set<std::pair<int32_t, int32_t>>> freeBlocks;
+  };
+
+  std::optional<size_t> findLevel(int32_t width, int32_t height) const noexcept;
+  std::optional<std::pair<int32_t, int32_t>>
+  allocateBlock(Page& page, size_t level);
+
+  int32_t _pageSize;
+  size_t _levels;
+  std::shared_ptr<IPrepareRasterOverlayRendererResources>
+      _pPrepareRendererResources;
+  std::any _rendererOptions;
+  // Freed pages leave an empty slot, so that the index of a page never
+  // changes.
+  std::vector<std::unique_ptr<Page>> _pages;
+};
+
+} // namespace CesiumRasterOverlays
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "RasterOverlayTextureAtlas.h"
+
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/IAssetRequest.h>
 #include <CesiumGeometry/Rectangle.h>
@@ -7,6 +9,7 @@
 #include <CesiumUtility/IntrusivePointer.h>
 #include <CesiumUtility/ReferenceCounted.h>
 
+#include <optional>
 #include <vector>
 
 namespace CesiumUtility {
@@ -233,6 +236,20 @@ public:
     this->_pRendererResources = pValue;
   }
 
+  /**
+   * @brief Returns the region of the page of the
+   * {@link RasterOverlayTileProvider::getTextureAtlas} that holds the image of
+   * this tile.
+   *
+   * This is only set once the {@link getState} of this tile is
+   * {@link LoadState `Done`}, and only if its image was packed into the
+   * texture atlas. Otherwise, the image has its own renderer resources.
+   */
+  const std::optional<RasterOverlayAtlasRegion>&
+  getAtlasRegion() const noexcept {
+    return this->_atlasRegion;
+  }
+
   /**
    * @brief Determines if more detailed data is available for the spatial area
    * covered by this tile.
@@ -258,6 +275,7 @@ private:
   LoadState _state;
   CesiumGltf::ImageCesium _image;
   void* _pRendererResources;
+  std::optional<RasterOverlayAtlasRegion> _atlasRegion;
   MoreDetailAvailable _moreDetailAvailable;
 };
 } // namespace CesiumRasterOverlays
@@ -2,7 +2,9 @@
 
 #include "Library.h"
 
+#include <CesiumAsync/AdaptiveConcurrencyLimit.h>
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/TaskPriority.h>
 #include <CesiumGeospatial/Projection.h>
 #include <CesiumGltfReader/GltfReader.h>
 #include <CesiumUtility/CreditSystem.h>
@@ -13,13 +15,16 @@
 #include <spdlog/fwd.h>
 
 #include <cassert>
+#include <memory>
 #include <optional>
+#include <vector>
 
 namespace CesiumRasterOverlays {
 
 class RasterOverlay;
 class RasterOverlayTile;
 class IPrepareRasterOverlayRendererResources;
+class RasterOverlayTextureAtlas;
 
 /**
  * @brief Summarizes the result of loading an image of a {@link RasterOverlay}.
@@ -235,6 +240,15 @@ public:
     return this->_pPrepareRendererResources;
   }
 
+  /**
+   * @brief Gets the texture atlas into which the images of this provider's
+   * tiles are packed, or `nullptr` if the owner's
+   * {@link RasterOverlayOptions::useTextureAtlas} is false.
+   */
+  RasterOverlayTextureAtlas* getTextureAtlas() const noexcept {
+    return this->_pTextureAtlas.get();
+  }
+
   /**
    * @brief Gets the logger to which to send messages about the tile provider
    * and tiles.
@@ -294,6 +308,15 @@ public:
     return this->_totalTilesCurrentlyLoading;
   }
 
+  /**
+   * @brief Gets the number of tiles that may currently be loading at the same
+   * time through {@link loadTileThrottled} and {@link loadQueuedTiles}.
+   *
+   * This is {@link RasterOverlayOptions::maximumSimultaneousTileLoads} unless
+   * {@link RasterOverlayOptions::adaptiveLoadConcurrency} is set.
+   */
+  int32_t getMaximumSimultaneousTileLoads() const noexcept;
+
   /**
    * @brief Removes a no-longer-referenced tile from this provider's cache and
    * deletes it.
@@ -354,6 +377,35 @@ public:
    */
   bool loadTileThrottled(RasterOverlayTile& tile);
 
+  /**
+   * @brief Queues a tile to be loaded by the next call to
+   * {@link loadQueuedTiles}.
+   *
+   * If the tile is not in the `Tile::LoadState::Unloaded` state, or if this is
+   * a placeholder, this method does nothing.
+   *
+   * @param tile The tile to load.
+   * @param priority The priority of the load, usually that of the geometry
+   * tile that needs it. Loads that run before others start first, and the
+   * worker-thread work of each load is done with its priority.
+   */
+  void queueTileLoad(
+      RasterOverlayTile& tile,
+      const CesiumAsync::TaskPriority& priority);
+
+  /**
+   * @brief Starts the loads queued by {@link queueTileLoad} in order of
+   * priority, as long as fewer than
+   * {@link RasterOverlayOptions::maximumSimultaneousTileLoads} throttled loads
+   * are in progress, and then clears the queue.
+   *
+   * The loads that don't start are dropped rather than kept for later, so
+   * the queue should be filled again before each call with the tiles that
+   * are still needed. That way, a tile whose geometry tile is no longer
+   * needed is never requested.
+   */
+  void loadQueuedTiles();
+
 protected:
   /**
    * @brief Loads the image for a tile.
@@ -413,9 +465,21 @@ private:
   CesiumGeospatial::Projection _projection;
   CesiumGeometry::Rectangle _coverageRectangle;
   CesiumUtility::IntrusivePointer<RasterOverlayTile> _pPlaceholder;
+  std::unique_ptr<RasterOverlayTextureAtlas> _pTextureAtlas;
   int64_t _tileDataBytes;
   int32_t _totalTilesCurrentlyLoading;
   int32_t _throttledTilesCurrentlyLoading;
+
+  // Adapts the limit of the throttled loads to the image requests, see
+  // RasterOverlayOptions::adaptiveLoadConcurrency.
+  std::shared_ptr<CesiumAsync::AdaptiveConcurrencyLimit> _pLoadConcurrency;
+
+  struct QueuedTileLoad {
+    CesiumUtility::IntrusivePointer<RasterOverlayTile> pTile;
+    CesiumAsync::TaskPriority priority;
+  };
+  std::vector<QueuedTileLoad> _queuedTileLoads;
+
   CESIUM_TRACE_DECLARE_TRACK_SET(
       _loadingSlots,
       "Raster Overlay Tile Loading Slot");
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Library.h"
+#include "RasterOverlay.h"
+
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumRasterOverlays {
+
+/**
+ * @brief Options for {@link VectorTileRasterOverlay}.
+ */
+struct VectorTileRasterOverlayOptions {
+  /**
+   * @brief A credit for the data source, which is displayed on the canvas.
+   */
+  std::optional<std::string> credit;
+
+  /**
+   * @brief The minimum level of the vector tiles on the server.
+   */
+  uint32_t minimumLevel = 0;
+
+  /**
+   * @brief The maximum level of the vector tiles on the server.
+   */
+  uint32_t maximumLevel = 14;
+
+  /**
+   * @brief The maximum level at which the vector tiles are rasterized.
+   *
+   * Above {@link maximumLevel}, the tiles of `maximumLevel` are rasterized
+   * again at a higher resolution, so that lines stay sharp when zooming in
+   * further than the server's tiles go. If not specified, tiles are
+   * rasterized up to five levels above `maximumLevel`.
+   */
+  std::optional<uint32_t> maximumRasterizedLevel;
+
+  /**
+   * @brief The width and height, in pixels, of the image that each tile is
+   * rasterized to.
+   */
+  uint32_t tileSize = 256;
+
+  /**
+   * @brief The names of the layers of the vector tiles to rasterize. If
+   * empty, all layers are rasterized.
+   */
+  std::vector<std::string> layers;
+
+  /**
+   * @brief The color, with alpha, that polygons are filled with.
+   */
+  glm::u8vec4 fillColor{255, 255, 255, 128};
+
+  /**
+   * @brief The color, with alpha, of lines.
+   */
+  glm::u8vec4 lineColor{255, 255, 255, 255};
+
+  /**
+   * @brief The width of lines, in pixels.
+   */
+  double lineWidth = 2.0;
+
+  /**
+   * @brief The ellipsoid of the Web Mercator projection of the tiles.
+   */
+  CesiumGeospatial::Ellipsoid ellipsoid = CesiumGeospatial::Ellipsoid::WGS84;
+};
+
+/**
+ * @brief A {@link RasterOverlay} that rasterizes Mapbox Vector Tiles.
+ *
+ * The tiles are requested from a URL template in the usual XYZ scheme of
+ * Web Mercator tiles, where `{z}` is the level, `{x}` the column from the
+ * west, and `{y}` the row from the north. The lines and polygons of the
+ * tiles are rasterized in worker threads, with the resolution chosen for
+ * each geometry tile like the images of other quadtree raster overlays.
+ * Points are not drawn.
+ */
+class CESIUMRASTEROVERLAYS_API VectorTileRasterOverlay final
+    : public RasterOverlay {
+public:
+  /**
+   * @brief Creates a new instance.
+   *
+   * @param name The user-given name of this overlay layer.
+   * @param url The URL template of the tiles, for example
+   * `https://example.com/tiles/{z}/{x}/{y}.mvt`.
+   * @param headers The headers. This is a list of pairs of strings of the
+   * form (Key,Value) that will be inserted as request headers internally.
+   * @param vectorTileOptions The {@link VectorTileRasterOverlayOptions}.
+   * @param overlayOptions The {@link RasterOverlayOptions} for this instance.
+   */
+  VectorTileRasterOverlay(
+      const std::string& name,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers = {},
+      const VectorTileRasterOverlayOptions& vectorTileOptions = {},
+      const RasterOverlayOptions& overlayOptions = {});
+  virtual ~VectorTileRasterOverlay() override;
+
+  virtual CesiumAsync::Future<CreateTileProviderResult> createTileProvider(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+      const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      CesiumUtility::IntrusivePointer<const RasterOverlay> pOwner)
+      const override;
+
+private:
+  std::string _url;
+  std::vector<CesiumAsync::IAssetAccessor::THeader> _headers;
+  VectorTileRasterOverlayOptions _options;
+};
+
+} // namespace CesiumRasterOverlays
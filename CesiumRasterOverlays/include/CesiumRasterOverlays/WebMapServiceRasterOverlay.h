@@ -62,6 +62,18 @@ struct WebMapServiceRasterOverlayOptions {
    * @brief Pixel height of image tiles.
    */
   int32_t tileHeight = 256;
+
+  /**
+   * @brief The number of tiles along each side of the blocks of tiles that
+   * are requested from the server as one image.
+   *
+   * With a value of 4, for example, a 1024x1024 image is requested for 16
+   * tiles of 256x256 pixels, which greatly reduces the number of requests.
+   * The image is split into the tiles after it's loaded. The value is reduced
+   * if the images would be larger than the MaxWidth or MaxHeight in the
+   * capabilities of the service. Use 1 to request each tile by itself.
+   */
+  int32_t metaTileSize = 1;
 };
 
 /**
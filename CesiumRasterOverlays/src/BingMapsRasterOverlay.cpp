@@ -16,6 +16,8 @@
 #include <rapidjson/document.h>
 #include <rapidjson/pointer.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <optional>
 #include <unordered_map>
 #include <utility>
@@ -38,6 +40,188 @@ struct CreditAndCoverageAreas {
   std::vector<CoverageArea> coverageAreas;
 };
 
+/**
+ * @brief An index of the coverage areas of the imagery providers, so that
+ * finding the credits of a tile doesn't need to test every coverage area.
+ *
+ * For each Bing zoom level, the coverage areas that are visible at that level
+ * are held in a bounding volume hierarchy over their rectangles. The exact
+ * intersection test is only done for the areas whose bounds overlap the tile.
+ */
+class CoverageAreaIndex {
+public:
+  CoverageAreaIndex(
+      const std::vector<CreditAndCoverageAreas>& credits,
+      uint32_t maximumZoom) {
+    this->_levels.resize(size_t(maximumZoom) + 1);
+
+    for (size_t i = 0; i < credits.size(); ++i) {
+      for (const CoverageArea& coverageArea : credits[i].coverageAreas) {
+        const uint32_t zoomMax = std::min(coverageArea.zoomMax, maximumZoom);
+        for (uint32_t zoom = coverageArea.zoomMin; zoom <= zoomMax; ++zoom) {
+          this->_levels[zoom].entries.push_back(
+              {getBounds(coverageArea.rectangle), coverageArea.rectangle, i});
+        }
+      }
+    }
+
+    for (Level& level : this->_levels) {
+      if (!level.entries.empty()) {
+        buildNode(level, 0, level.entries.size());
+      }
+    }
+  }
+
+  /**
+   * @brief Finds the indices of the credits that have a coverage area that is
+   * visible at the given zoom level and intersects the given rectangle.
+   *
+   * The indices are sorted, and each is included only once.
+   */
+  std::vector<size_t>
+  findCredits(uint32_t zoom, const GlobeRectangle& rectangle) const {
+    std::vector<size_t> result;
+    if (zoom >= this->_levels.size()) {
+      return result;
+    }
+
+    const Level& level = this->_levels[zoom];
+    if (level.nodes.empty()) {
+      return result;
+    }
+
+    const Bounds bounds = getBounds(rectangle);
+    std::vector<size_t> stack{0};
+    while (!stack.empty()) {
+      const Node& node = level.nodes[stack.back()];
+      stack.pop_back();
+
+      if (!node.bounds.overlaps(bounds)) {
+        continue;
+      }
+
+      if (node.left == 0) {
+        for (size_t i = node.begin; i < node.end; ++i) {
+          const Entry& entry = level.entries[i];
+          if (entry.bounds.overlaps(bounds) &&
+              entry.rectangle.computeIntersection(rectangle).has_value()) {
+            result.push_back(entry.creditIndex);
+          }
+        }
+      } else {
+        stack.push_back(node.left);
+        stack.push_back(node.right);
+      }
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+  }
+
+private:
+  static constexpr size_t maximumEntriesPerLeaf = 4;
+
+  // Conservative bounds that don't cross the anti-meridian. A rectangle that
+  // does cross it is bounded by the full range of longitudes.
+  struct Bounds {
+    double west;
+    double south;
+    double east;
+    double north;
+
+    bool overlaps(const Bounds& other) const noexcept {
+      return this->west <= other.east && other.west <= this->east &&
+             this->south <= other.north && other.south <= this->north;
+    }
+
+    Bounds computeUnion(const Bounds& other) const noexcept {
+      return {
+          std::min(this->west, other.west),
+          std::min(this->south, other.south),
+          std::max(this->east, other.east),
+          std::max(this->north, other.north)};
+    }
+  };
+
+  struct Entry {
+    Bounds bounds;
+    GlobeRectangle rectangle;
+    size_t creditIndex;
+  };
+
+  // A node of the hierarchy. A leaf has no children and holds the entries in
+  // [begin, end). The root is node 0, so it is never a child.
+  struct Node {
+    Bounds bounds;
+    size_t begin;
+    size_t end;
+    size_t left;
+    size_t right;
+  };
+
+  struct Level {
+    std::vector<Entry> entries;
+    std::vector<Node> nodes;
+  };
+
+  static Bounds getBounds(const GlobeRectangle& rectangle) noexcept {
+    if (rectangle.getWest() > rectangle.getEast()) {
+      return {
+          -Math::OnePi,
+          rectangle.getSouth(),
+          Math::OnePi,
+          rectangle.getNorth()};
+    }
+    return {
+        rectangle.getWest(),
+        rectangle.getSouth(),
+        rectangle.getEast(),
+        rectangle.getNorth()};
+  }
+
+  static size_t buildNode(Level& level, size_t begin, size_t end) {
+    const size_t nodeIndex = level.nodes.size();
+    level.nodes.push_back({level.entries[begin].bounds, begin, end, 0, 0});
+
+    Bounds bounds = level.entries[begin].bounds;
+    for (size_t i = begin + 1; i < end; ++i) {
+      bounds = bounds.computeUnion(level.entries[i].bounds);
+    }
+    level.nodes[nodeIndex].bounds = bounds;
+
+    if (end - begin <= maximumEntriesPerLeaf) {
+      return nodeIndex;
+    }
+
+    // Split at the median of the centers along the longer axis.
+    const bool splitLongitude =
+        bounds.east - bounds.west >= bounds.north - bounds.south;
+    const size_t middle = begin + (end - begin) / 2;
+    const auto entriesIt = level.entries.begin();
+    std::nth_element(
+        entriesIt + std::ptrdiff_t(begin),
+        entriesIt + std::ptrdiff_t(middle),
+        entriesIt + std::ptrdiff_t(end),
+        [splitLongitude](const Entry& a, const Entry& b) {
+          if (splitLongitude) {
+            return a.bounds.west + a.bounds.east <
+                   b.bounds.west + b.bounds.east;
+          }
+          return a.bounds.south + a.bounds.north <
+                 b.bounds.south + b.bounds.north;
+        });
+
+    const size_t left = buildNode(level, begin, middle);
+    const size_t right = buildNode(level, middle, end);
+    level.nodes[nodeIndex].left = left;
+    level.nodes[nodeIndex].right = right;
+    return nodeIndex;
+  }
+
+  std::vector<Level> _levels;
+};
+
 std::unordered_map<std::string, std::vector<std::byte>> sessionCache;
 } // namespace
 
@@ -120,6 +304,7 @@ public:
             width,
             height),
         _credits(perTileCredits),
+        _coverageAreas(perTileCredits, maximumLevel + 1),
         _urlTemplate(urlTemplate),
         _subdomains(subdomains) {
     if (this->_urlTemplate.find("n=z") == std::string::npos) {
@@ -180,17 +365,9 @@ protected:
     // Cesium levels start at 0, Bing levels start at 1
     const unsigned int bingTileLevel = tileID.level + 1;
 
-    for (const CreditAndCoverageAreas& creditAndCoverageAreas : _credits) {
-      for (const CoverageArea& coverageArea :
-           creditAndCoverageAreas.coverageAreas) {
-        if (coverageArea.zoomMin <= bingTileLevel &&
-            bingTileLevel <= coverageArea.zoomMax &&
-            coverageArea.rectangle.computeIntersection(tileRectangle)
-                .has_value()) {
-          tileCredits.push_back(creditAndCoverageAreas.credit);
-          break;
-        }
-      }
+    for (const size_t creditIndex :
+         this->_coverageAreas.findCredits(bingTileLevel, tileRectangle)) {
+      tileCredits.push_back(this->_credits[creditIndex].credit);
     }
 
     return this->loadTileImageFromUrl(url, {}, std::move(options));
@@ -218,6 +395,7 @@ private:
   }
 
   std::vector<CreditAndCoverageAreas> _credits;
+  CoverageAreaIndex _coverageAreas;
   std::string _urlTemplate;
   std::vector<std::string> _subdomains;
 };
@@ -0,0 +1,336 @@
+#include "ImageBlockCompression.h"
+
+#include <CesiumGltfReader/GltfReader.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace CesiumRasterOverlays {
+
+namespace {
+
+constexpr int32_t blockSize = 4;
+constexpr size_t pixelsPerBlock = 16;
+
+// The RGBA pixels of a block, row by row.
+using Block = std::array<std::array<int32_t, 4>, pixelsPerBlock>;
+using Color = std::array<int32_t, 3>;
+
+void readBlock(
+    const std::byte* pPixels,
+    int32_t width,
+    int32_t height,
+    int32_t channels,
+    int32_t blockX,
+    int32_t blockY,
+    Block& block) {
+  for (int32_t y = 0; y < blockSize; ++y) {
+    // Blocks past the edge of a small mip repeat its last row and column.
+    const int32_t sourceY = std::min(blockY + y, height - 1);
+    for (int32_t x = 0; x < blockSize; ++x) {
+      const int32_t sourceX = std::min(blockX + x, width - 1);
+      const std::byte* pPixel =
+          pPixels + (size_t(sourceY) * size_t(width) + size_t(sourceX)) *
+                        size_t(channels);
+      std::array<int32_t, 4>& pixel = block[size_t(y * blockSize + x)];
+      pixel[0] = int32_t(pPixel[0]);
+      pixel[1] = int32_t(pPixel[1]);
+      pixel[2] = int32_t(pPixel[2]);
+      pixel[3] = channels == 4 ? int32_t(pPixel[3]) : 255;
+    }
+  }
+}
+
+uint16_t toRgb565(const std::array<double, 3>& color) {
+  const auto quantize = [](double value, double maximum) {
+    return uint16_t(std::clamp(value * maximum / 255.0 + 0.5, 0.0, maximum));
+  };
+  return uint16_t(
+      (quantize(color[0], 31.0) << 11) | (quantize(color[1], 63.0) << 5) |
+      quantize(color[2], 31.0));
+}
+
+Color fromRgb565(uint16_t color) {
+  const int32_t r = (color >> 11) & 31;
+  const int32_t g = (color >> 5) & 63;
+  const int32_t b = color & 31;
+  return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+int32_t distanceSquared(const std::array<int32_t, 4>& pixel, const Color& c) {
+  const int32_t r = pixel[0] - c[0];
+  const int32_t g = pixel[1] - c[1];
+  const int32_t b = pixel[2] - c[2];
+  return r * r + g * g + b * b;
+}
+
+void writeColorBlock(const Block& block, std::byte* pOutput) {
+  // The endpoints are the extremes of the pixels along the principal axis of
+  // their colors.
+  std::array<double, 3> mean{0.0, 0.0, 0.0};
+  for (const std::array<int32_t, 4>& pixel : block) {
+    for (size_t c = 0; c < 3; ++c) {
+      mean[c] += double(pixel[c]) / double(pixelsPerBlock);
+    }
+  }
+
+  // The upper triangle of the covariance matrix: xx, xy, xz, yy, yz, zz.
+  std::array<double, 6> covariance{0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  for (const std::array<int32_t, 4>& pixel : block) {
+    const double r = double(pixel[0]) - mean[0];
+    const double g = double(pixel[1]) - mean[1];
+    const double b = double(pixel[2]) - mean[2];
+    covariance[0] += r * r;
+    covariance[1] += r * g;
+    covariance[2] += r * b;
+    covariance[3] += g * g;
+    covariance[4] += g * b;
+    covariance[5] += b * b;
+  }
+
+  // Power iteration, starting from the column of the channel that varies the
+  // most, which can't be orthogonal to the principal axis.
+  std::array<double, 3> axis{covariance[0], covariance[1], covariance[2]};
+  if (covariance[3] > covariance[0] && covariance[3] >= covariance[5]) {
+    axis = {covariance[1], covariance[3], covariance[4]};
+  } else if (covariance[5] > covariance[0] && covariance[5] > covariance[3]) {
+    axis = {covariance[2], covariance[4], covariance[5]};
+  }
+  for (int32_t i = 0; i < 8; ++i) {
+    const std::array<double, 3> next{
+        covariance[0] * axis[0] + covariance[1] * axis[1] +
+            covariance[2] * axis[2],
+        covariance[1] * axis[0] + covariance[3] * axis[1] +
+            covariance[4] * axis[2],
+        covariance[2] * axis[0] + covariance[4] * axis[1] +
+            covariance[5] * axis[2]};
+    const double length = std::max(
+        {std::abs(next[0]), std::abs(next[1]), std::abs(next[2])});
+    if (length == 0.0) {
+      break;
+    }
+    axis = {next[0] / length, next[1] / length, next[2] / length};
+  }
+
+  double minimum = std::numeric_limits<double>::max();
+  double maximum = std::numeric_limits<double>::lowest();
+  for (const std::array<int32_t, 4>& pixel : block) {
+    const double t = (double(pixel[0]) - mean[0]) * axis[0] +
+                     (double(pixel[1]) - mean[1]) * axis[1] +
+                     (double(pixel[2]) - mean[2]) * axis[2];
+    minimum = std::min(minimum, t);
+    maximum = std::max(maximum, t);
+  }
+
+  uint16_t color0 = toRgb565(
+      {mean[0] + maximum * axis[0],
+       mean[1] + maximum * axis[1],
+       mean[2] + maximum * axis[2]});
+  uint16_t color1 = toRgb565(
+      {mean[0] + minimum * axis[0],
+       mean[1] + minimum * axis[1],
+       mean[2] + minimum * axis[2]});
+
+  // The first endpoint must be greater to select the four-color mode of BC1.
+  if (color0 < color1) {
+    std::swap(color0, color1);
+  }
+
+  uint32_t indices = 0;
+  if (color0 != color1) {
+    const Color c0 = fromRgb565(color0);
+    const Color c1 = fromRgb565(color1);
+    const std::array<Color, 4> palette{
+        c0,
+        c1,
+        Color{
+            (2 * c0[0] + c1[0]) / 3,
+            (2 * c0[1] + c1[1]) / 3,
+            (2 * c0[2] + c1[2]) / 3},
+        Color{
+            (c0[0] + 2 * c1[0]) / 3,
+            (c0[1] + 2 * c1[1]) / 3,
+            (c0[2] + 2 * c1[2]) / 3}};
+
+    for (size_t i = 0; i < pixelsPerBlock; ++i) {
+      size_t best = 0;
+      int32_t bestDistance = distanceSquared(block[i], palette[0]);
+      for (size_t j = 1; j < palette.size(); ++j) {
+        const int32_t distance = distanceSquared(block[i], palette[j]);
+        if (distance < bestDistance) {
+          best = j;
+          bestDistance = distance;
+        }
+      }
+      indices |= uint32_t(best) << (2 * i);
+    }
+  }
+
+  pOutput[0] = std::byte(color0 & 0xff);
+  pOutput[1] = std::byte(color0 >> 8);
+  pOutput[2] = std::byte(color1 & 0xff);
+  pOutput[3] = std::byte(color1 >> 8);
+  for (size_t i = 0; i < 4; ++i) {
+    pOutput[4 + i] = std::byte((indices >> (8 * i)) & 0xff);
+  }
+}
+
+void writeAlphaBlock(const Block& block, std::byte* pOutput) {
+  int32_t alpha0 = 0;
+  int32_t alpha1 = 255;
+  for (const std::array<int32_t, 4>& pixel : block) {
+    alpha0 = std::max(alpha0, pixel[3]);
+    alpha1 = std::min(alpha1, pixel[3]);
+  }
+
+  // With the first endpoint greater, BC3 interpolates six values between the
+  // endpoints.
+  uint64_t indices = 0;
+  if (alpha0 != alpha1) {
+    std::array<int32_t, 8> palette{alpha0, alpha1, 0, 0, 0, 0, 0, 0};
+    for (int32_t i = 1; i < 7; ++i) {
+      palette[size_t(i + 1)] = ((7 - i) * alpha0 + i * alpha1) / 7;
+    }
+
+    for (size_t i = 0; i < pixelsPerBlock; ++i) {
+      size_t best = 0;
+      int32_t bestDistance = std::abs(block[i][3] - palette[0]);
+      for (size_t j = 1; j < palette.size(); ++j) {
+        const int32_t distance = std::abs(block[i][3] - palette[j]);
+        if (distance < bestDistance) {
+          best = j;
+          bestDistance = distance;
+        }
+      }
+      indices |= uint64_t(best) << (3 * i);
+    }
+  }
+
+  pOutput[0] = std::byte(alpha0);
+  pOutput[1] = std::byte(alpha1);
+  for (size_t i = 0; i < 6; ++i) {
+    pOutput[2 + i] = std::byte((indices >> (8 * i)) & 0xff);
+  }
+}
+
+} // namespace
+
+/*static*/ GpuCompressedPixelFormat ImageBlockCompression::selectFormat(
+    const ImageCesium& image,
+    const SupportedGpuCompressedPixelFormats& supportedFormats) {
+  if (image.compressedPixelFormat != GpuCompressedPixelFormat::NONE ||
+      image.bytesPerChannel != 1 ||
+      (image.channels != 3 && image.channels != 4) || image.width <= 0 ||
+      image.height <= 0 || image.width % blockSize != 0 ||
+      image.height % blockSize != 0) {
+    return GpuCompressedPixelFormat::NONE;
+  }
+
+  const size_t pixelCount = size_t(image.width) * size_t(image.height);
+  if (image.pixelData.size() < pixelCount * size_t(image.channels)) {
+    return GpuCompressedPixelFormat::NONE;
+  }
+
+  bool opaque = true;
+  if (image.channels == 4) {
+    for (size_t i = 0; i < pixelCount; ++i) {
+      if (image.pixelData[i * 4 + 3] != std::byte(255)) {
+        opaque = false;
+        break;
+      }
+    }
+  }
+
+  if (opaque && supportedFormats.BC1_RGB) {
+    return GpuCompressedPixelFormat::BC1_RGB;
+  }
+  if (supportedFormats.BC3_RGBA) {
+    return GpuCompressedPixelFormat::BC3_RGBA;
+  }
+  return GpuCompressedPixelFormat::NONE;
+}
+
+/*static*/ bool ImageBlockCompression::compress(
+    ImageCesium& image,
+    GpuCompressedPixelFormat format) {
+  if (format != GpuCompressedPixelFormat::BC1_RGB &&
+      format != GpuCompressedPixelFormat::BC3_RGBA) {
+    return false;
+  }
+
+  CESIUM_TRACE("ImageBlockCompression::compress");
+
+  // Mipmaps can't be generated by the client once the image is compressed.
+  if (CesiumGltfReader::GltfReader::generateMipMaps(image) ||
+      image.mipPositions.empty()) {
+    return false;
+  }
+
+  const bool hasAlpha = format == GpuCompressedPixelFormat::BC3_RGBA;
+  const size_t blockBytes = hasAlpha ? 16 : 8;
+
+  CesiumUtility::ByteVector compressed(image.pixelData.get_allocator());
+  std::vector<ImageCesiumMipPosition> mipPositions;
+  mipPositions.reserve(image.mipPositions.size());
+
+  Block block;
+  int32_t width = image.width;
+  int32_t height = image.height;
+  for (const ImageCesiumMipPosition& mip : image.mipPositions) {
+    if (mip.byteOffset + size_t(width) * size_t(height) *
+                             size_t(image.channels) >
+        image.pixelData.size()) {
+      return false;
+    }
+
+    const std::byte* pPixels = image.pixelData.data() + mip.byteOffset;
+    const size_t blocksX = size_t((width + blockSize - 1) / blockSize);
+    const size_t blocksY = size_t((height + blockSize - 1) / blockSize);
+    const size_t byteOffset = compressed.size();
+    compressed.resize(byteOffset + blocksX * blocksY * blockBytes);
+
+    std::byte* pOutput = compressed.data() + byteOffset;
+    for (int32_t blockY = 0; blockY < height; blockY += blockSize) {
+      for (int32_t blockX = 0; blockX < width; blockX += blockSize) {
+        readBlock(
+            pPixels,
+            width,
+            height,
+            image.channels,
+            blockX,
+            blockY,
+            block);
+        if (hasAlpha) {
+          writeAlphaBlock(block, pOutput);
+          writeColorBlock(block, pOutput + 8);
+        } else {
+          writeColorBlock(block, pOutput);
+        }
+        pOutput += blockBytes;
+      }
+    }
+
+    mipPositions.emplace_back(
+        ImageCesiumMipPosition{byteOffset, compressed.size() - byteOffset});
+
+    width = std::max(width >> 1, 1);
+    height = std::max(height >> 1, 1);
+  }
+
+  image.pixelData = std::move(compressed);
+  image.mipPositions = std::move(mipPositions);
+  image.compressedPixelFormat = format;
+  return true;
+}
+
+} // namespace CesiumRasterOverlays
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <CesiumGltf/ImageCesium.h>
+#include <CesiumGltf/Ktx2TranscodeTargets.h>
+
+namespace CesiumRasterOverlays {
+
+/**
+ * @brief Compresses raster overlay images to the block formats that GPUs
+ * sample directly.
+ *
+ * Only the BC1 and BC3 formats can be encoded. They take 4 and 8 bits per
+ * pixel, instead of the 32 bits of an RGBA image.
+ */
+struct ImageBlockCompression {
+  /**
+   * @brief Selects the format to compress an image to.
+   *
+   * Opaque images are compressed to BC1, or BC3 if only it is supported, and
+   * images with transparent pixels to BC3. An image can only be compressed if
+   * it has 3 or 4 channels of 8 bits, its width and height are multiples of
+   * 4, and it isn't compressed already.
+   *
+   * @param image The image.
+   * @param supportedFormats The formats supported by the client.
+   * @return The format, or `GpuCompressedPixelFormat::NONE` if the image
+   * can't be compressed to a supported format.
+   */
+  static CesiumGltf::GpuCompressedPixelFormat selectFormat(
+      const CesiumGltf::ImageCesium& image,
+      const CesiumGltf::SupportedGpuCompressedPixelFormats& supportedFormats);
+
+  /**
+   * @brief Compresses an image and its mipmaps, generating them if they don't
+   * exist yet.
+   *
+   * Each mip is compressed in blocks of 4x4 pixels, and the mips that are
+   * smaller than a block are padded by repeating their last row and column.
+   *
+   * @param image The image, which is compressed in place. It must be suitable
+   * for the format, see {@link selectFormat}.
+   * @param format The format, `BC1_RGB` or `BC3_RGBA`.
+   * @return True if the image was compressed, false if it was left as it was.
+   */
+  static bool compress(
+      CesiumGltf::ImageCesium& image,
+      CesiumGltf::GpuCompressedPixelFormat format);
+};
+
+} // namespace CesiumRasterOverlays
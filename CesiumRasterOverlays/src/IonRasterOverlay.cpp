@@ -1,5 +1,6 @@
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/ICacheDatabase.h>
 #include <CesiumRasterOverlays/BingMapsRasterOverlay.h>
 #include <CesiumRasterOverlays/IonRasterOverlay.h>
 #include <CesiumRasterOverlays/RasterOverlayLoadFailureDetails.h>
@@ -12,27 +13,141 @@
 #include <rapidjson/document.h>
 #include <spdlog/fwd.h>
 
+#include <ctime>
+#include <optional>
+#include <vector>
+
 using namespace CesiumAsync;
 using namespace CesiumUtility;
 
 namespace CesiumRasterOverlays {
 
+namespace {
+// The access token of an endpoint response is valid for about an hour, so a
+// stored response isn't used after that.
+const std::time_t endpointResponseLifetime = 60 * 60;
+
+std::string getEndpointCacheKey(const std::string& ionUrl) {
+  return "ion-endpoint " + ionUrl;
+}
+
+void storeEndpointResponse(
+    ICacheDatabase& endpointCache,
+    const IAssetRequest& completedRequest) {
+  const IAssetResponse* pResponse = completedRequest.response();
+  const std::time_t expiryTime =
+      std::time(nullptr) + endpointResponseLifetime;
+  endpointCache.storeEntry(
+      getEndpointCacheKey(completedRequest.url()),
+      expiryTime,
+      completedRequest.url(),
+      completedRequest.method(),
+      HttpHeaders{},
+      pResponse->statusCode(),
+      HttpHeaders{},
+      pResponse->data());
+}
+
+std::optional<std::vector<std::byte>> getStoredEndpointResponse(
+    const ICacheDatabase& endpointCache,
+    const std::string& ionUrl) {
+  std::optional<CacheItem> cacheItem =
+      endpointCache.getEntry(getEndpointCacheKey(ionUrl));
+  if (!cacheItem ||
+      std::difftime(cacheItem->expiryTime, std::time(nullptr)) <= 0.0) {
+    return std::nullopt;
+  }
+  return std::move(cacheItem->cacheResponse.data);
+}
+} // namespace
+
 IonRasterOverlay::IonRasterOverlay(
     const std::string& name,
     int64_t ionAssetID,
     const std::string& ionAccessToken,
     const RasterOverlayOptions& overlayOptions,
-    const std::string& ionAssetEndpointUrl)
+    const std::string& ionAssetEndpointUrl,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pEndpointCache)
     : RasterOverlay(name, overlayOptions),
       _ionAssetID(ionAssetID),
       _ionAccessToken(ionAccessToken),
-      _ionAssetEndpointUrl(ionAssetEndpointUrl) {}
+      _ionAssetEndpointUrl(ionAssetEndpointUrl),
+      _pEndpointCache(pEndpointCache) {}
 
 IonRasterOverlay::~IonRasterOverlay() {}
 
 std::unordered_map<std::string, IonRasterOverlay::ExternalAssetEndpoint>
     IonRasterOverlay::endpointCache;
 
+nonstd::expected<IonRasterOverlay::ExternalAssetEndpoint, std::string>
+IonRasterOverlay::parseEndpointResponse(
+    const gsl::span<const std::byte>& data) {
+  rapidjson::Document response;
+  response.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+
+  if (response.HasParseError()) {
+    return nonstd::make_unexpected(fmt::format(
+        "Error while parsing Cesium ion raster overlay response, error code "
+        "{} at byte offset {}",
+        response.GetParseError(),
+        response.GetErrorOffset()));
+  }
+
+  std::string type =
+      JsonHelpers::getStringOrDefault(response, "type", "unknown");
+  if (type != "IMAGERY") {
+    return nonstd::make_unexpected(fmt::format(
+        "Assets used with a raster overlay must have type 'IMAGERY', but "
+        "instead saw '{}'.",
+        type));
+  }
+
+  ExternalAssetEndpoint endpoint;
+  endpoint.externalType =
+      JsonHelpers::getStringOrDefault(response, "externalType", "unknown");
+  if (endpoint.externalType == "BING") {
+    const auto optionsIt = response.FindMember("options");
+    if (optionsIt == response.MemberEnd() || !optionsIt->value.IsObject()) {
+      return nonstd::make_unexpected(std::string(
+          "Cesium ion Bing Maps raster overlay metadata response does not "
+          "contain 'options' or it is not an object."));
+    }
+
+    const auto attributionsIt = response.FindMember("attributions");
+    if (attributionsIt != response.MemberEnd() &&
+        attributionsIt->value.IsArray()) {
+
+      for (const rapidjson::Value& attribution :
+           attributionsIt->value.GetArray()) {
+        AssetEndpointAttribution& endpointAttribution =
+            endpoint.attributions.emplace_back();
+        const auto html = attribution.FindMember("html");
+        if (html != attribution.MemberEnd() && html->value.IsString()) {
+          endpointAttribution.html = html->value.GetString();
+        }
+        auto collapsible = attribution.FindMember("collapsible");
+        if (collapsible != attribution.MemberEnd() &&
+            collapsible->value.IsBool()) {
+          endpointAttribution.collapsible = collapsible->value.GetBool();
+        }
+      }
+    }
+
+    const auto& options = optionsIt->value;
+    endpoint.url = JsonHelpers::getStringOrDefault(options, "url", "");
+    endpoint.key = JsonHelpers::getStringOrDefault(options, "key", "");
+    endpoint.mapStyle =
+        JsonHelpers::getStringOrDefault(options, "mapStyle", "AERIAL");
+    endpoint.culture = JsonHelpers::getStringOrDefault(options, "culture", "");
+  } else {
+    endpoint.url = JsonHelpers::getStringOrDefault(response, "url", "");
+    endpoint.accessToken =
+        JsonHelpers::getStringOrDefault(response, "accessToken", "");
+  }
+
+  return endpoint;
+}
+
 Future<RasterOverlay::CreateTileProviderResult>
 IonRasterOverlay::createTileProvider(
     const ExternalAssetEndpoint& endpoint,
@@ -107,100 +222,72 @@ IonRasterOverlay::createTileProvider(
         pOwner);
   }
 
+  // An endpoint response that was stored in an earlier session lets the tile
+  // provider be created without waiting for the ion API. It's requested again
+  // in the background, so that later tile providers get a new access token.
+  if (this->_pEndpointCache) {
+    std::optional<std::vector<std::byte>> maybeResponse =
+        getStoredEndpointResponse(*this->_pEndpointCache, ionUrl);
+    if (maybeResponse) {
+      nonstd::expected<ExternalAssetEndpoint, std::string> endpoint =
+          parseEndpointResponse(*maybeResponse);
+      if (endpoint) {
+        IonRasterOverlay::endpointCache[ionUrl] = *endpoint;
+
+        pAssetAccessor->get(asyncSystem, ionUrl)
+            .thenInMainThread(
+                [pEndpointCache = this->_pEndpointCache,
+                 ionUrl](std::shared_ptr<IAssetRequest>&& pRequest) {
+                  const IAssetResponse* pResponse = pRequest->response();
+                  if (!pResponse || pResponse->statusCode() < 200 ||
+                      pResponse->statusCode() >= 300) {
+                    return;
+                  }
+
+                  nonstd::expected<ExternalAssetEndpoint, std::string>
+                      newEndpoint = parseEndpointResponse(pResponse->data());
+                  if (newEndpoint) {
+                    IonRasterOverlay::endpointCache[ionUrl] =
+                        std::move(*newEndpoint);
+                    storeEndpointResponse(*pEndpointCache, *pRequest);
+                  }
+                });
+
+        return createTileProvider(
+            *endpoint,
+            asyncSystem,
+            pAssetAccessor,
+            pCreditSystem,
+            pPrepareRendererResources,
+            pLogger,
+            pOwner);
+      }
+    }
+  }
+
   return pAssetAccessor->get(asyncSystem, ionUrl)
       .thenImmediately(
-          [](std::shared_ptr<IAssetRequest>&& pRequest)
+          [pEndpointCache = this->_pEndpointCache](
+              std::shared_ptr<IAssetRequest>&& pRequest)
               -> nonstd::expected<
                   ExternalAssetEndpoint,
                   RasterOverlayLoadFailureDetails> {
             const IAssetResponse* pResponse = pRequest->response();
 
-            rapidjson::Document response;
-            response.Parse(
-                reinterpret_cast<const char*>(pResponse->data().data()),
-                pResponse->data().size());
-
-            if (response.HasParseError()) {
-              return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
-                  RasterOverlayLoadType::CesiumIon,
-                  std::move(pRequest),
-                  fmt::format(
-                      "Error while parsing Cesium ion raster overlay response, "
-                      "error code {} at byte offset {}",
-                      response.GetParseError(),
-                      response.GetErrorOffset())});
-            }
-
-            std::string type =
-                JsonHelpers::getStringOrDefault(response, "type", "unknown");
-            if (type != "IMAGERY") {
+            nonstd::expected<ExternalAssetEndpoint, std::string> endpoint =
+                parseEndpointResponse(pResponse->data());
+            if (!endpoint) {
               return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
                   RasterOverlayLoadType::CesiumIon,
                   std::move(pRequest),
-                  fmt::format(
-                      "Assets used with a raster overlay must have type "
-                      "'IMAGERY', but instead saw '{}'.",
-                      type)});
+                  std::move(endpoint).error()});
             }
 
-            ExternalAssetEndpoint endpoint;
-            endpoint.externalType = JsonHelpers::getStringOrDefault(
-                response,
-                "externalType",
-                "unknown");
-            if (endpoint.externalType == "BING") {
-              const auto optionsIt = response.FindMember("options");
-              if (optionsIt == response.MemberEnd() ||
-                  !optionsIt->value.IsObject()) {
-                return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
-                    RasterOverlayLoadType::CesiumIon,
-                    std::move(pRequest),
-                    fmt::format(
-                        "Cesium ion Bing Maps raster overlay metadata response "
-                        "does not contain 'options' or it is not an object.")});
-              }
-
-              const auto attributionsIt = response.FindMember("attributions");
-              if (attributionsIt != response.MemberEnd() &&
-                  attributionsIt->value.IsArray()) {
-
-                for (const rapidjson::Value& attribution :
-                     attributionsIt->value.GetArray()) {
-                  AssetEndpointAttribution& endpointAttribution =
-                      endpoint.attributions.emplace_back();
-                  const auto html = attribution.FindMember("html");
-                  if (html != attribution.MemberEnd() &&
-                      html->value.IsString()) {
-                    endpointAttribution.html = html->value.GetString();
-                  }
-                  auto collapsible = attribution.FindMember("collapsible");
-                  if (collapsible != attribution.MemberEnd() &&
-                      collapsible->value.IsBool()) {
-                    endpointAttribution.collapsible =
-                        collapsible->value.GetBool();
-                  }
-                }
-              }
-
-              const auto& options = optionsIt->value;
-              endpoint.url =
-                  JsonHelpers::getStringOrDefault(options, "url", "");
-              endpoint.key =
-                  JsonHelpers::getStringOrDefault(options, "key", "");
-              endpoint.mapStyle = JsonHelpers::getStringOrDefault(
-                  options,
-                  "mapStyle",
-                  "AERIAL");
-              endpoint.culture =
-                  JsonHelpers::getStringOrDefault(options, "culture", "");
-            } else {
-              endpoint.url =
-                  JsonHelpers::getStringOrDefault(response, "url", "");
-              endpoint.accessToken =
-                  JsonHelpers::getStringOrDefault(response, "accessToken", "");
+            if (pEndpointCache) {
+              storeEndpointResponse(*pEndpointCache, *pRequest);
             }
 
-            return endpoint;
+            return std::move(*endpoint);
           })
       .thenInMainThread(
           [asyncSystem,
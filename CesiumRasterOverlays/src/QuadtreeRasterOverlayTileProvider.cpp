@@ -6,6 +6,8 @@
 #include <CesiumUtility/Math.h>
 #include <CesiumUtility/SpanHelper.h>
 
+#include <algorithm>
+
 using namespace CesiumAsync;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -38,7 +40,8 @@ QuadtreeRasterOverlayTileProvider::QuadtreeRasterOverlayTileProvider(
     uint32_t minimumLevel,
     uint32_t maximumLevel,
     uint32_t imageWidth,
-    uint32_t imageHeight) noexcept
+    uint32_t imageHeight,
+    uint32_t metaTileSize) noexcept
     : RasterOverlayTileProvider(
           pOwner,
           asyncSystem,
@@ -52,9 +55,11 @@ QuadtreeRasterOverlayTileProvider::QuadtreeRasterOverlayTileProvider(
       _maximumLevel(maximumLevel),
       _imageWidth(imageWidth),
       _imageHeight(imageHeight),
+      _metaTileSize(glm::max(metaTileSize, 1U)),
       _tilingScheme(tilingScheme),
       _tilesOldToRecent(),
       _tileLookup(),
+      _metaTilesLoading(),
       _cachedBytes(0) {}
 
 uint32_t QuadtreeRasterOverlayTileProvider::computeLevelFromTargetScreenPixels(
@@ -314,43 +319,52 @@ QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
         });
   };
 
+  Future<std::shared_ptr<LoadedRasterOverlayImage>> loadFuture =
+      this->_metaTileSize > 1
+          ? this->loadTileImageFromMetaTile(tileID)
+          : this->loadQuadtreeTileImage(tileID).thenImmediately(
+                [](LoadedRasterOverlayImage&& loaded) {
+                  return std::make_shared<LoadedRasterOverlayImage>(
+                      std::move(loaded));
+                });
+
   Future<LoadedQuadtreeImage> future =
-      this->loadQuadtreeTileImage(tileID)
+      std::move(loadFuture)
           .catchImmediately([](std::exception&& e) {
             // Turn an exception into an error.
-            LoadedRasterOverlayImage result;
-            result.errors.emplace_back(e.what());
-            return result;
+            auto pResult = std::make_shared<LoadedRasterOverlayImage>();
+            pResult->errors.emplace_back(e.what());
+            return pResult;
           })
           .thenImmediately([&cachedBytes = this->_cachedBytes,
                             currentLevel = tileID.level,
                             minimumLevel = this->getMinimumLevel(),
                             asyncSystem = this->getAsyncSystem(),
                             loadParentTile = std::move(loadParentTile)](
-                               LoadedRasterOverlayImage&& loaded) {
-            if (loaded.image && loaded.errors.empty() &&
-                loaded.image->width > 0 && loaded.image->height > 0) {
+                               std::shared_ptr<LoadedRasterOverlayImage>&&
+                                   pLoaded) {
+            if (pLoaded->image && pLoaded->errors.empty() &&
+                pLoaded->image->width > 0 && pLoaded->image->height > 0) {
               // Successfully loaded, continue.
-              cachedBytes += int64_t(loaded.image->pixelData.size());
+              cachedBytes += int64_t(pLoaded->image->pixelData.size());
 
 #if SHOW_TILE_BOUNDARIES
               // Highlight the edges in red to show tile boundaries.
               gsl::span<uint32_t> pixels =
                   reintepretCastSpan<uint32_t, std::byte>(
-                      loaded.image->pixelData);
-              for (int32_t j = 0; j < loaded.image->height; ++j) {
-                for (int32_t i = 0; i < loaded.image->width; ++i) {
-                  if (i == 0 || j == 0 || i == loaded.image->width - 1 ||
-                      j == loaded.image->height - 1) {
-                    pixels[j * loaded.image->width + i] = 0xFF0000FF;
+                      pLoaded->image->pixelData);
+              for (int32_t j = 0; j < pLoaded->image->height; ++j) {
+                for (int32_t i = 0; i < pLoaded->image->width; ++i) {
+                  if (i == 0 || j == 0 || i == pLoaded->image->width - 1 ||
+                      j == pLoaded->image->height - 1) {
+                    pixels[j * pLoaded->image->width + i] = 0xFF0000FF;
                   }
                 }
               }
 #endif
 
-              return asyncSystem.createResolvedFuture(LoadedQuadtreeImage{
-                  std::make_shared<LoadedRasterOverlayImage>(std::move(loaded)),
-                  std::nullopt});
+              return asyncSystem.createResolvedFuture(
+                  LoadedQuadtreeImage{std::move(pLoaded), std::nullopt});
             }
 
             // Tile failed to load, try loading the parent tile instead.
@@ -360,9 +374,8 @@ QuadtreeRasterOverlayTileProvider::getQuadtreeTile(
               return asyncSystem.runInMainThread(loadParentTile);
             } else {
               // No parent available, so return the original failed result.
-              return asyncSystem.createResolvedFuture(LoadedQuadtreeImage{
-                  std::make_shared<LoadedRasterOverlayImage>(std::move(loaded)),
-                  std::nullopt});
+              return asyncSystem.createResolvedFuture(
+                  LoadedQuadtreeImage{std::move(pLoaded), std::nullopt});
             }
           });
 
@@ -412,11 +425,11 @@ PixelRectangle computePixelRectangle(
   return PixelRectangle{x, y, maxX - x, maxY - y};
 }
 
-// Copy part of a source image to part of a target image.
-// The two rectangles are the extents of each image, and the part of the
-// source image where the source subset rectangle overlaps the target
-// rectangle is copied to the target image.
-void blitImage(
+// Copy part of a source image to part of a target image, and return whether
+// it could be copied. The two rectangles are the extents of each image, and
+// the part of the source image where the source subset rectangle overlaps the
+// target rectangle is copied to the target image.
+bool blitImage(
     ImageCesium& target,
     const Rectangle& targetRectangle,
     const ImageCesium& source,
@@ -427,7 +440,7 @@ void blitImage(
       targetRectangle.computeIntersection(sourceToCopy);
   if (!overlap) {
     // No overlap, nothing to do.
-    return;
+    return true;
   }
 
   const PixelRectangle targetPixels =
@@ -435,11 +448,197 @@ void blitImage(
   const PixelRectangle sourcePixels =
       computePixelRectangle(source, sourceRectangle, *overlap);
 
-  ImageManipulation::blitImage(target, targetPixels, source, sourcePixels);
+  return ImageManipulation::blitImage(
+      target,
+      targetPixels,
+      source,
+      sourcePixels);
+}
+
+// Allocates the pixels of an image with the given size, in the format of the
+// source image, which may be block-compressed.
+void allocateImage(
+    ImageCesium& image,
+    const ImageCesium& source,
+    int32_t width,
+    int32_t height) {
+  image.width = width;
+  image.height = height;
+  image.channels = source.channels;
+  image.bytesPerChannel = source.bytesPerChannel;
+  image.compressedPixelFormat = source.compressedPixelFormat;
+  if (image.compressedPixelFormat != GpuCompressedPixelFormat::NONE) {
+    image.pixelData.resize(ImageManipulation::computeBlockCompressedImageSize(
+        image.compressedPixelFormat,
+        width,
+        height));
+  } else {
+    image.pixelData.resize(
+        size_t(width * height * image.channels * image.bytesPerChannel));
+  }
+}
+
+// Splits the image of a meta-tile into images of the given size for the tiles
+// with the given rectangles. Each of them gets the credits, errors and
+// warnings of the meta-tile.
+std::vector<std::shared_ptr<LoadedRasterOverlayImage>> splitMetaTileImage(
+    const LoadedRasterOverlayImage& loaded,
+    const std::vector<Rectangle>& rectangles,
+    int32_t width,
+    int32_t height) {
+  std::vector<std::shared_ptr<LoadedRasterOverlayImage>> result;
+  result.reserve(rectangles.size());
+
+  const bool haveImage = loaded.image && loaded.errors.empty() &&
+                         loaded.image->width > 0 && loaded.image->height > 0;
+
+  for (const Rectangle& rectangle : rectangles) {
+    auto pPart = std::make_shared<LoadedRasterOverlayImage>();
+    pPart->rectangle = rectangle;
+    pPart->credits = loaded.credits;
+    pPart->errors = loaded.errors;
+    pPart->warnings = loaded.warnings;
+    pPart->moreDetailAvailable = loaded.moreDetailAvailable;
+
+    if (haveImage) {
+      const ImageCesium& source = *loaded.image;
+      ImageCesium& image = pPart->image.emplace();
+      allocateImage(image, source, width, height);
+
+      const PixelRectangle sourcePixels =
+          computePixelRectangle(source, loaded.rectangle, rectangle);
+      if (!ImageManipulation::blitImage(
+              image,
+              PixelRectangle{0, 0, width, height},
+              source,
+              sourcePixels)) {
+        pPart->image.reset();
+        pPart->errors.emplace_back(
+            "The image of a meta-tile could not be split into its tiles.");
+      }
+    }
+
+    result.emplace_back(std::move(pPart));
+  }
+
+  return result;
 }
 
 } // namespace
 
+CesiumAsync::Future<LoadedRasterOverlayImage>
+QuadtreeRasterOverlayTileProvider::loadQuadtreeMetaTileImage(
+    const CesiumGeometry::QuadtreeTileID& /* firstTileID */,
+    uint32_t /* tilesX */,
+    uint32_t /* tilesY */) const {
+  LoadedRasterOverlayImage result;
+  result.errors.emplace_back(
+      "This raster overlay tile provider does not load meta-tiles.");
+  return this->getAsyncSystem().createResolvedFuture(std::move(result));
+}
+
+CesiumAsync::Future<std::shared_ptr<LoadedRasterOverlayImage>>
+QuadtreeRasterOverlayTileProvider::loadTileImageFromMetaTile(
+    const CesiumGeometry::QuadtreeTileID& tileID) {
+  const QuadtreeTilingScheme& tilingScheme = this->getTilingScheme();
+  const uint32_t size = this->_metaTileSize;
+  const QuadtreeTileID firstTileID(
+      tileID.level,
+      tileID.x / size * size,
+      tileID.y / size * size);
+
+  auto it = this->_metaTilesLoading.find(firstTileID);
+  if (it == this->_metaTilesLoading.end()) {
+    // The meta-tiles at the edges of the tiling scheme may have fewer tiles.
+    const uint32_t tilesX = glm::min(
+        size,
+        tilingScheme.getNumberOfXTilesAtLevel(tileID.level) - firstTileID.x);
+    const uint32_t tilesY = glm::min(
+        size,
+        tilingScheme.getNumberOfYTilesAtLevel(tileID.level) - firstTileID.y);
+
+    LoadedMetaTile metaTile;
+    std::vector<Rectangle> rectangles;
+    metaTile.tileIDs.reserve(size_t(tilesX * tilesY));
+    rectangles.reserve(size_t(tilesX * tilesY));
+    for (uint32_t j = 0; j < tilesY; ++j) {
+      for (uint32_t i = 0; i < tilesX; ++i) {
+        const QuadtreeTileID& partID = metaTile.tileIDs.emplace_back(
+            tileID.level,
+            firstTileID.x + i,
+            firstTileID.y + j);
+        rectangles.emplace_back(tilingScheme.tileToRectangle(partID));
+      }
+    }
+
+    // Like loadParentTile in getQuadtreeTile, this is created here so that
+    // `this` is only used in the main thread.
+    auto cacheImages = [this, firstTileID](LoadedMetaTile&& loaded) {
+      this->_metaTilesLoading.erase(firstTileID);
+      this->cacheMetaTileImages(loaded);
+      return std::move(loaded);
+    };
+
+    SharedFuture<LoadedMetaTile> future =
+        this->loadQuadtreeMetaTileImage(firstTileID, tilesX, tilesY)
+            .catchImmediately([](std::exception&& e) {
+              // Turn an exception into an error.
+              LoadedRasterOverlayImage result;
+              result.errors.emplace_back(e.what());
+              return result;
+            })
+            .thenInWorkerThread(
+                [metaTile = std::move(metaTile),
+                 rectangles = std::move(rectangles),
+                 width = int32_t(this->getWidth()),
+                 height = int32_t(this->getHeight())](
+                    LoadedRasterOverlayImage&& loaded) mutable {
+                  metaTile.images =
+                      splitMetaTileImage(loaded, rectangles, width, height);
+                  return std::move(metaTile);
+                })
+            .thenInMainThread(std::move(cacheImages))
+            .share();
+
+    it = this->_metaTilesLoading.emplace(firstTileID, std::move(future)).first;
+  }
+
+  return it->second.thenImmediately([tileID](const LoadedMetaTile& loaded) {
+    const auto partIt =
+        std::find(loaded.tileIDs.begin(), loaded.tileIDs.end(), tileID);
+    return loaded.images[size_t(partIt - loaded.tileIDs.begin())];
+  });
+}
+
+void QuadtreeRasterOverlayTileProvider::cacheMetaTileImages(
+    const LoadedMetaTile& metaTile) {
+  // The tiles that were asked for are in the cache already, so this adds the
+  // others, to be found there when they are needed.
+  for (size_t i = 0; i < metaTile.tileIDs.size(); ++i) {
+    const QuadtreeTileID& tileID = metaTile.tileIDs[i];
+    const std::shared_ptr<LoadedRasterOverlayImage>& pLoaded =
+        metaTile.images[i];
+    if (!pLoaded->image || !pLoaded->errors.empty() ||
+        this->_tileLookup.find(tileID) != this->_tileLookup.end()) {
+      continue;
+    }
+
+    this->_cachedBytes += int64_t(pLoaded->image->pixelData.size());
+
+    auto newIt = this->_tilesOldToRecent.emplace(
+        this->_tilesOldToRecent.end(),
+        CacheEntry{
+            tileID,
+            this->getAsyncSystem()
+                .createResolvedFuture(
+                    LoadedQuadtreeImage{pLoaded, std::nullopt})
+                .share()});
+    this->_tileLookup[tileID] = newIt;
+  }
+
+  this->unloadCachedTiles();
+}
+
 CesiumAsync::Future<LoadedRasterOverlayImage>
 QuadtreeRasterOverlayTileProvider::loadTileImage(
     RasterOverlayTile& overlayTile) {
@@ -670,13 +869,34 @@ QuadtreeRasterOverlayTileProvider::combineImages(
   result.rectangle = measurements.rectangle;
   result.moreDetailAvailable = false;
 
+  // Block-compressed images, such as those transcoded from KTX2, are combined
+  // without decoding them, so the target has their format.
+  const auto compressedIt = std::find_if(
+      images.begin(),
+      images.end(),
+      [](const LoadedQuadtreeImage& image) {
+        return image.pLoaded->image &&
+               image.pLoaded->image->compressedPixelFormat !=
+                   GpuCompressedPixelFormat::NONE;
+      });
+
   ImageCesium& target = result.image.emplace();
   target.bytesPerChannel = measurements.bytesPerChannel;
   target.channels = measurements.channels;
   target.width = measurements.widthPixels;
   target.height = measurements.heightPixels;
-  target.pixelData.resize(size_t(
-      target.width * target.height * target.channels * target.bytesPerChannel));
+  if (compressedIt != images.end()) {
+    target.compressedPixelFormat =
+        compressedIt->pLoaded->image->compressedPixelFormat;
+    target.pixelData.resize(ImageManipulation::computeBlockCompressedImageSize(
+        target.compressedPixelFormat,
+        target.width,
+        target.height));
+  } else {
+    target.pixelData.resize(size_t(
+        target.width * target.height * target.channels *
+        target.bytesPerChannel));
+  }
 
   for (auto it = images.begin(); it != images.end(); ++it) {
     const LoadedRasterOverlayImage& loaded = *it->pLoaded;
@@ -686,12 +906,27 @@ QuadtreeRasterOverlayTileProvider::combineImages(
 
     result.moreDetailAvailable |= loaded.moreDetailAvailable;
 
-    blitImage(
+    const bool copied = blitImage(
         target,
         result.rectangle,
         *loaded.image,
         loaded.rectangle,
         it->subset);
+    if (!copied &&
+        target.compressedPixelFormat != GpuCompressedPixelFormat::NONE) {
+      // A compressed image can't be scaled, as an ancestor's would need to
+      // be, or copied to pixels that aren't aligned to its blocks. Rather
+      // than leave a hole in the target, fail.
+      return LoadedRasterOverlayImage{
+          std::nullopt,
+          targetRectangle,
+          {},
+          {"A block-compressed raster overlay image could not be combined "
+           "with the others, because it would need to be scaled or isn't "
+           "aligned to the blocks."},
+          {},
+          false};
+    }
   }
 
   size_t combinedCreditsCount = 0;
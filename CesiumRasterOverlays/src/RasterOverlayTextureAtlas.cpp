@@ -0,0 +1,241 @@
+#include <CesiumRasterOverlays/IPrepareRasterOverlayRendererResources.h>
+#include <CesiumRasterOverlays/RasterOverlayTextureAtlas.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace CesiumRasterOverlays {
+
+namespace {
+// Smaller blocks would mostly hold their border.
+constexpr int32_t minimumBlockSize = 16;
+
+// The border of one pixel on each side of an image.
+constexpr int32_t borderPixels = 1;
+} // namespace
+
+RasterOverlayTextureAtlas::RasterOverlayTextureAtlas(
+    int32_t pageSize,
+    const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+        pPrepareRendererResources,
+    const std::any& rendererOptions)
+    : _pageSize(minimumBlockSize),
+      _levels(1),
+      _pPrepareRendererResources(pPrepareRendererResources),
+      _rendererOptions(rendererOptions),
+      _pages() {
+  while (this->_pageSize < pageSize) {
+    this->_pageSize *= 2;
+    ++this->_levels;
+  }
+}
+
+RasterOverlayTextureAtlas::~RasterOverlayTextureAtlas() noexcept {
+  for (std::unique_ptr<Page>& pPage : this->_pages) {
+    if (pPage && this->_pPrepareRendererResources) {
+      this->_pPrepareRendererResources->freeRasterAtlasPage(
+          pPage->pRendererResources);
+    }
+  }
+}
+
+std::optional<RasterOverlayAtlasRegion> RasterOverlayTextureAtlas::allocate(
+    int32_t width,
+    int32_t height,
+    int32_t channels,
+    int32_t bytesPerChannel) {
+  const std::optional<size_t> maybeLevel = this->findLevel(width, height);
+  if (!maybeLevel || !this->_pPrepareRendererResources) {
+    return std::nullopt;
+  }
+
+  const size_t level = *maybeLevel;
+
+  std::optional<std::pair<int32_t, int32_t>> block;
+  size_t pageIndex = 0;
+  for (; pageIndex < this->_pages.size(); ++pageIndex) {
+    Page* pPage = this->_pages[pageIndex].get();
+    if (pPage && pPage->channels == channels &&
+        pPage->bytesPerChannel == bytesPerChannel) {
+      block = this->allocateBlock(*pPage, level);
+      if (block) {
+        break;
+      }
+    }
+  }
+
+  if (!block) {
+    void* pRendererResources =
+        this->_pPrepareRendererResources->createRasterAtlasPage(
+            this->_pageSize,
+            this->_pageSize,
+            channels,
+            bytesPerChannel,
+            this->_rendererOptions);
+    if (!pRendererResources) {
+      return std::nullopt;
+    }
+
+    auto pPage = std::make_unique<Page>();
+    pPage->pRendererResources = pRendererResources;
+    pPage->channels = channels;
+    pPage->bytesPerChannel = bytesPerChannel;
+    pPage->freeBlocks.resize(this->_levels);
+    pPage->freeBlocks[0].emplace(0, 0);
+    block = this->allocateBlock(*pPage, level);
+    assert(block);
+
+    auto emptySlot =
+        std::find(this->_pages.begin(), this->_pages.end(), nullptr);
+    pageIndex = size_t(emptySlot - this->_pages.begin());
+    if (emptySlot == this->_pages.end()) {
+      this->_pages.emplace_back(std::move(pPage));
+    } else {
+      *emptySlot = std::move(pPage);
+    }
+  }
+
+  const double pageSize = double(this->_pageSize);
+
+  RasterOverlayAtlasRegion region;
+  region.pageIndex = pageIndex;
+  region.x = block->first + borderPixels;
+  region.y = block->second + borderPixels;
+  region.width = width;
+  region.height = height;
+  region.textureCoordinates = CesiumGeometry::Rectangle(
+      double(region.x) / pageSize,
+      double(region.y) / pageSize,
+      double(region.x + width) / pageSize,
+      double(region.y + height) / pageSize);
+  return region;
+}
+
+void RasterOverlayTextureAtlas::free(
+    const RasterOverlayAtlasRegion& region) noexcept {
+  if (region.pageIndex >= this->_pages.size()) {
+    return;
+  }
+
+  std::unique_ptr<Page>& pPage = this->_pages[region.pageIndex];
+  const std::optional<size_t> maybeLevel =
+      this->findLevel(region.width, region.height);
+  if (!pPage || !maybeLevel) {
+    return;
+  }
+
+  size_t level = *maybeLevel;
+  int32_t x = region.x - borderPixels;
+  int32_t y = region.y - borderPixels;
+  pPage->freeBlocks[level].emplace(x, y);
+
+  // Merge the block with its siblings while they are all free.
+  while (level > 0) {
+    std::set<std::pair<int32_t, int32_t>>& freeBlocks =
+        pPage->freeBlocks[level];
+    const int32_t blockSize = this->_pageSize >> level;
+    const int32_t parentX = x - x % (2 * blockSize);
+    const int32_t parentY = y - y % (2 * blockSize);
+    const std::pair<int32_t, int32_t> siblings[] = {
+        {parentX, parentY},
+        {parentX + blockSize, parentY},
+        {parentX, parentY + blockSize},
+        {parentX + blockSize, parentY + blockSize}};
+    if (!std::all_of(
+            std::begin(siblings),
+            std::end(siblings),
+            [&freeBlocks](const std::pair<int32_t, int32_t>& sibling) {
+              return freeBlocks.find(sibling) != freeBlocks.end();
+            })) {
+      break;
+    }
+
+    for (const std::pair<int32_t, int32_t>& sibling : siblings) {
+      freeBlocks.erase(sibling);
+    }
+
+    --level;
+    x = parentX;
+    y = parentY;
+    pPage->freeBlocks[level].emplace(x, y);
+  }
+
+  if (level == 0) {
+    // The whole page is free.
+    if (this->_pPrepareRendererResources) {
+      this->_pPrepareRendererResources->freeRasterAtlasPage(
+          pPage->pRendererResources);
+    }
+    pPage.reset();
+  }
+}
+
+void* RasterOverlayTextureAtlas::getPageRendererResources(
+    size_t pageIndex) const noexcept {
+  if (pageIndex >= this->_pages.size() || !this->_pages[pageIndex]) {
+    return nullptr;
+  }
+  return this->_pages[pageIndex]->pRendererResources;
+}
+
+size_t RasterOverlayTextureAtlas::getPageCount() const noexcept {
+  return size_t(std::count_if(
+      this->_pages.begin(),
+      this->_pages.end(),
+      [](const std::unique_ptr<Page>& pPage) { return pPage != nullptr; }));
+}
+
+std::optional<size_t> RasterOverlayTextureAtlas::findLevel(
+    int32_t width,
+    int32_t height) const noexcept {
+  if (width <= 0 || height <= 0) {
+    return std::nullopt;
+  }
+
+  const int32_t requiredSize = std::max(width, height) + 2 * borderPixels;
+  if (requiredSize > this->_pageSize) {
+    return std::nullopt;
+  }
+
+  // The deepest level whose blocks are large enough.
+  size_t level = 0;
+  while (level + 1 < this->_levels &&
+         (this->_pageSize >> (level + 1)) >= requiredSize) {
+    ++level;
+  }
+  return level;
+}
+
+std::optional<std::pair<int32_t, int32_t>>
+RasterOverlayTextureAtlas::allocateBlock(Page& page, size_t level) {
+  // Find the smallest free block that is large enough.
+  size_t freeLevel = level + 1;
+  while (freeLevel > 0 && page.freeBlocks[freeLevel - 1].empty()) {
+    --freeLevel;
+  }
+  if (freeLevel == 0) {
+    return std::nullopt;
+  }
+  --freeLevel;
+
+  std::set<std::pair<int32_t, int32_t>>& freeBlocks =
+      page.freeBlocks[freeLevel];
+  std::pair<int32_t, int32_t> block = *freeBlocks.begin();
+  freeBlocks.erase(freeBlocks.begin());
+
+  // Split it until it is the right size, keeping its first quarter each time.
+  while (freeLevel < level) {
+    ++freeLevel;
+    const int32_t blockSize = this->_pageSize >> freeLevel;
+    std::set<std::pair<int32_t, int32_t>>& childBlocks =
+        page.freeBlocks[freeLevel];
+    childBlocks.emplace(block.first + blockSize, block.second);
+    childBlocks.emplace(block.first, block.second + blockSize);
+    childBlocks.emplace(block.first + blockSize, block.second + blockSize);
+  }
+
+  return block;
+}
+
+} // namespace CesiumRasterOverlays
@@ -2,6 +2,7 @@
 #include <CesiumAsync/ITaskProcessor.h>
 #include <CesiumRasterOverlays/IPrepareRasterOverlayRendererResources.h>
 #include <CesiumRasterOverlays/RasterOverlay.h>
+#include <CesiumRasterOverlays/RasterOverlayTextureAtlas.h>
 #include <CesiumRasterOverlays/RasterOverlayTile.h>
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
 #include <CesiumUtility/joinToString.h>
@@ -19,6 +20,7 @@ RasterOverlayTile::RasterOverlayTile(
       _state(LoadState::Placeholder),
       _image(),
       _pRendererResources(nullptr),
+      _atlasRegion(),
       _moreDetailAvailable(MoreDetailAvailable::Unknown) {}
 
 RasterOverlayTile::RasterOverlayTile(
@@ -32,6 +34,7 @@ RasterOverlayTile::RasterOverlayTile(
       _state(LoadState::Unloaded),
       _image(),
       _pRendererResources(nullptr),
+      _atlasRegion(),
       _moreDetailAvailable(MoreDetailAvailable::Unknown) {}
 
 RasterOverlayTile::~RasterOverlayTile() {
@@ -57,6 +60,11 @@ RasterOverlayTile::~RasterOverlayTile() {
         pLoadThreadResult,
         pMainThreadResult);
   }
+
+  RasterOverlayTextureAtlas* pAtlas = tileProvider.getTextureAtlas();
+  if (this->_atlasRegion && pAtlas) {
+    pAtlas->free(*this->_atlasRegion);
+  }
 }
 
 RasterOverlay& RasterOverlayTile::getOverlay() noexcept {
@@ -77,10 +85,34 @@ void RasterOverlayTile::loadInMainThread() {
 
   // Do the final main thread raster loading
   RasterOverlayTileProvider& tileProvider = *this->_pTileProvider;
-  this->_pRendererResources =
-      tileProvider.getPrepareRendererResources()->prepareRasterInMainThread(
-          *this,
-          this->_pRendererResources);
+  const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+      pPrepareRendererResources = tileProvider.getPrepareRendererResources();
+
+  // Atlas pages hold uncompressed pixels.
+  RasterOverlayTextureAtlas* pAtlas = tileProvider.getTextureAtlas();
+  if (pAtlas && this->_image.compressedPixelFormat ==
+                    CesiumGltf::GpuCompressedPixelFormat::NONE) {
+    this->_atlasRegion = pAtlas->allocate(
+        this->_image.width,
+        this->_image.height,
+        this->_image.channels,
+        this->_image.bytesPerChannel);
+  }
+
+  if (this->_atlasRegion) {
+    this->_pRendererResources =
+        pPrepareRendererResources->prepareRasterInAtlasPage(
+            *this,
+            this->_pRendererResources,
+            pAtlas->getPageRendererResources(this->_atlasRegion->pageIndex),
+            *this->_atlasRegion);
+  } else {
+    // Images that don't fit in a page get their own renderer resources.
+    this->_pRendererResources =
+        pPrepareRendererResources->prepareRasterInMainThread(
+            *this,
+            this->_pRendererResources);
+  }
 
   this->setState(LoadState::Done);
 }
@@ -1,7 +1,10 @@
+#include "ImageBlockCompression.h"
+
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumGltfReader/GltfReader.h>
 #include <CesiumRasterOverlays/IPrepareRasterOverlayRendererResources.h>
 #include <CesiumRasterOverlays/RasterOverlay.h>
+#include <CesiumRasterOverlays/RasterOverlayTextureAtlas.h>
 #include <CesiumRasterOverlays/RasterOverlayTile.h>
 #include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
 #include <CesiumUtility/Tracing.h>
@@ -9,6 +12,9 @@
 
 #include <spdlog/fwd.h>
 
+#include <algorithm>
+#include <chrono>
+
 using namespace CesiumAsync;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -35,9 +41,12 @@ RasterOverlayTileProvider::RasterOverlayTileProvider(
       _coverageRectangle(CesiumGeospatial::GeographicProjection::
                              computeMaximumProjectedRectangle()),
       _pPlaceholder(),
+      _pTextureAtlas(nullptr),
       _tileDataBytes(0),
       _totalTilesCurrentlyLoading(0),
-      _throttledTilesCurrentlyLoading(0) {
+      _throttledTilesCurrentlyLoading(0),
+      _pLoadConcurrency(nullptr),
+      _queuedTileLoads() {
   this->_pPlaceholder = new RasterOverlayTile(*this);
 }
 
@@ -60,9 +69,25 @@ RasterOverlayTileProvider::RasterOverlayTileProvider(
       _projection(projection),
       _coverageRectangle(coverageRectangle),
       _pPlaceholder(nullptr),
+      _pTextureAtlas(nullptr),
       _tileDataBytes(0),
       _totalTilesCurrentlyLoading(0),
-      _throttledTilesCurrentlyLoading(0) {}
+      _throttledTilesCurrentlyLoading(0),
+      _pLoadConcurrency(nullptr),
+      _queuedTileLoads() {
+  const RasterOverlayOptions& options = this->_pOwner->getOptions();
+  if (options.adaptiveLoadConcurrency) {
+    this->_pLoadConcurrency = std::make_shared<AdaptiveConcurrencyLimit>(
+        uint32_t(std::max(options.maximumSimultaneousTileLoads, 0)),
+        *options.adaptiveLoadConcurrency);
+  }
+  if (options.useTextureAtlas && pPrepareRendererResources) {
+    this->_pTextureAtlas = std::make_unique<RasterOverlayTextureAtlas>(
+        options.textureAtlasPageSize,
+        pPrepareRendererResources,
+        options.rendererOptions);
+  }
+}
 
 RasterOverlayTileProvider::~RasterOverlayTileProvider() noexcept {
   // Explicitly release the placeholder first, because RasterOverlayTiles must
@@ -111,7 +136,7 @@ bool RasterOverlayTileProvider::loadTileThrottled(RasterOverlayTile& tile) {
   }
 
   if (this->_throttledTilesCurrentlyLoading >=
-      this->getOwner().getOptions().maximumSimultaneousTileLoads) {
+      this->getMaximumSimultaneousTileLoads()) {
     return false;
   }
 
@@ -119,14 +144,70 @@ bool RasterOverlayTileProvider::loadTileThrottled(RasterOverlayTile& tile) {
   return true;
 }
 
+void RasterOverlayTileProvider::queueTileLoad(
+    RasterOverlayTile& tile,
+    const TaskPriority& priority) {
+  if (this->_pPlaceholder ||
+      tile.getState() != RasterOverlayTile::LoadState::Unloaded) {
+    return;
+  }
+
+  this->_queuedTileLoads.emplace_back(QueuedTileLoad{&tile, priority});
+}
+
+void RasterOverlayTileProvider::loadQueuedTiles() {
+  CESIUM_TRACE("RasterOverlayTileProvider::loadQueuedTiles");
+
+  std::stable_sort(
+      this->_queuedTileLoads.begin(),
+      this->_queuedTileLoads.end(),
+      [](const QueuedTileLoad& lhs, const QueuedTileLoad& rhs) noexcept {
+        return lhs.priority.runsBefore(rhs.priority);
+      });
+
+  const int32_t maximumSimultaneousTileLoads =
+      this->getMaximumSimultaneousTileLoads();
+  for (const QueuedTileLoad& queued : this->_queuedTileLoads) {
+    if (this->_throttledTilesCurrentlyLoading >=
+        maximumSimultaneousTileLoads) {
+      break;
+    }
+
+    TaskPriorityScope priorityScope(queued.priority);
+    this->doLoad(*queued.pTile, true);
+  }
+
+  this->_queuedTileLoads.clear();
+}
+
+int32_t RasterOverlayTileProvider::getMaximumSimultaneousTileLoads()
+    const noexcept {
+  if (this->_pLoadConcurrency) {
+    return int32_t(this->_pLoadConcurrency->getLimit());
+  }
+  return this->getOwner().getOptions().maximumSimultaneousTileLoads;
+}
+
 CesiumAsync::Future<LoadedRasterOverlayImage>
 RasterOverlayTileProvider::loadTileImageFromUrl(
     const std::string& url,
     const std::vector<IAssetAccessor::THeader>& headers,
     LoadTileImageFromUrlOptions&& options) const {
-
+  const std::chrono::steady_clock::time_point requestTime =
+      std::chrono::steady_clock::now();
   return this->getAssetAccessor()
       ->get(this->getAsyncSystem(), url, headers)
+      .thenImmediately(
+          [pLoadConcurrency = this->_pLoadConcurrency,
+           requestTime](std::shared_ptr<IAssetRequest>&& pRequest) {
+            if (pLoadConcurrency) {
+              pLoadConcurrency->recordResponse(
+                  *pRequest,
+                  requestTime,
+                  std::chrono::steady_clock::now());
+            }
+            return std::move(pRequest);
+          })
       .thenInWorkerThread(
           [options = std::move(options),
            Ktx2TranscodeTargets =
@@ -239,7 +320,9 @@ static LoadResult createLoadResultFromLoadedImage(
         pPrepareRendererResources,
     const std::shared_ptr<spdlog::logger>& pLogger,
     LoadedRasterOverlayImage&& loadedImage,
-    const std::any& rendererOptions) {
+    const std::any& rendererOptions,
+    const CesiumGltf::SupportedGpuCompressedPixelFormats&
+        imageCompressionFormats) {
   if (!loadedImage.image.has_value()) {
     SPDLOG_LOGGER_ERROR(
         pLogger,
@@ -263,9 +346,13 @@ static LoadResult createLoadResultFromLoadedImage(
 
   CesiumGltf::ImageCesium& image = loadedImage.image.value();
 
+  // Images transcoded from KTX2 to a GPU compressed pixel format are smaller
+  // than their channels suggest.
   const int32_t bytesPerPixel = image.channels * image.bytesPerChannel;
   const int64_t requiredBytes =
-      static_cast<int64_t>(image.width) * image.height * bytesPerPixel;
+      image.compressedPixelFormat != CesiumGltf::GpuCompressedPixelFormat::NONE
+          ? 1
+          : static_cast<int64_t>(image.width) * image.height * bytesPerPixel;
   if (image.width > 0 && image.height > 0 &&
       image.pixelData.size() >= static_cast<size_t>(requiredBytes)) {
     CESIUM_TRACE(
@@ -273,6 +360,12 @@ static LoadResult createLoadResultFromLoadedImage(
         std::to_string(image.height) + "x" + std::to_string(image.channels) +
         "x" + std::to_string(image.bytesPerChannel));
 
+    const CesiumGltf::GpuCompressedPixelFormat compressedPixelFormat =
+        ImageBlockCompression::selectFormat(image, imageCompressionFormats);
+    if (compressedPixelFormat != CesiumGltf::GpuCompressedPixelFormat::NONE) {
+      ImageBlockCompression::compress(image, compressedPixelFormat);
+    }
+
     void* pRendererResources = nullptr;
     if (pPrepareRendererResources) {
       pRendererResources = pPrepareRendererResources->prepareRasterInLoadThread(
@@ -315,7 +408,8 @@ CesiumAsync::Future<TileProviderAndTile> RasterOverlayTileProvider::doLoad(
   this->beginTileLoad(isThrottledLoad);
 
   // Keep the tile and tile provider alive while the async operation is in
-  // progress.
+  // progress. Only one of the two continuations below runs, so the second one
+  // takes over these references, and each hands its own on to the result.
   IntrusivePointer<RasterOverlayTile> pTile = &tile;
   IntrusivePointer<RasterOverlayTileProvider> thiz = this;
 
@@ -323,16 +417,20 @@ CesiumAsync::Future<TileProviderAndTile> RasterOverlayTileProvider::doLoad(
       .thenInWorkerThread(
           [pPrepareRendererResources = this->getPrepareRendererResources(),
            pLogger = this->getLogger(),
-           rendererOptions = this->_pOwner->getOptions().rendererOptions](
+           rendererOptions = this->_pOwner->getOptions().rendererOptions,
+           imageCompressionFormats =
+               this->_pOwner->getOptions().imageCompressionFormats](
               LoadedRasterOverlayImage&& loadedImage) {
             return createLoadResultFromLoadedImage(
                 pPrepareRendererResources,
                 pLogger,
                 std::move(loadedImage),
-                rendererOptions);
+                rendererOptions,
+                imageCompressionFormats);
           })
       .thenInMainThread(
-          [thiz, pTile, isThrottledLoad](LoadResult&& result) noexcept {
+          [thiz, pTile, isThrottledLoad](
+              LoadResult&& result) mutable noexcept {
             pTile->_rectangle = result.rectangle;
             pTile->_pRendererResources = result.pRendererResources;
             pTile->_image = std::move(result.image);
@@ -357,10 +455,11 @@ CesiumAsync::Future<TileProviderAndTile> RasterOverlayTileProvider::doLoad(
 
             thiz->finalizeTileLoad(isThrottledLoad);
 
-            return TileProviderAndTile{thiz, pTile};
+            return TileProviderAndTile{std::move(thiz), std::move(pTile)};
           })
       .catchInMainThread(
-          [thiz, pTile, isThrottledLoad](const std::exception& /*e*/) {
+          [thiz = std::move(thiz), pTile = std::move(pTile), isThrottledLoad](
+              const std::exception& /*e*/) mutable {
             pTile->_pRendererResources = nullptr;
             pTile->_image = {};
             pTile->_tileCredits = {};
@@ -370,7 +469,7 @@ CesiumAsync::Future<TileProviderAndTile> RasterOverlayTileProvider::doLoad(
 
             thiz->finalizeTileLoad(isThrottledLoad);
 
-            return TileProviderAndTile{thiz, pTile};
+            return TileProviderAndTile{std::move(thiz), std::move(pTile)};
           });
 }
 
@@ -1,5 +1,6 @@
 #include <CesiumGeometry/clipTriangleAtAxisAlignedThreshold.h>
 #include <CesiumGeospatial/BoundingRegionBuilder.h>
+#include <CesiumGltf/AccessorUtility.h>
 #include <CesiumGltf/AccessorWriter.h>
 #include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
 #include <CesiumGltf/Model.h>
@@ -10,6 +11,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <variant>
 
 using namespace CesiumGltf;
 using namespace CesiumGltfContent;
@@ -129,13 +131,19 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
         bufferViews.reserve(bufferViews.size() + projections.size());
         accessors.reserve(accessors.size() + projections.size());
 
-        const CesiumGltf::AccessorView<glm::vec3> positionView(
-            gltf,
-            positionAccessorIndex);
-        if (positionView.status() != CesiumGltf::AccessorViewStatus::Valid) {
+        const CesiumGltf::QuantizedPositionAccessorType positionView =
+            CesiumGltf::getQuantizedPositionAccessorView(gltf, primitive);
+        if (std::visit(CesiumGltf::StatusFromAccessor{}, positionView) !=
+            CesiumGltf::AccessorViewStatus::Valid) {
           return;
         }
 
+        const int64_t positionCount =
+            std::visit(CesiumGltf::CountFromAccessor{}, positionView);
+        const CesiumGltf::AccessorDequantization dequantization =
+            CesiumGltf::getAccessorDequantization(
+                gltf.accessors[static_cast<size_t>(positionAccessorIndex)]);
+
         std::optional<SkirtMeshMetadata> skirtMeshMetadata =
             SkirtMeshMetadata::parseFromGltfExtras(primitive.extras);
         int64_t vertexBegin, vertexEnd;
@@ -145,7 +153,7 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
                       skirtMeshMetadata->noSkirtVerticesCount;
         } else {
           vertexBegin = 0;
-          vertexEnd = positionView.size();
+          vertexEnd = positionCount;
         }
 
         for (size_t i = 0; i < projections.size(); ++i) {
@@ -159,7 +167,7 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
           accessors.emplace_back();
 
           uvBuffer.cesium.data.resize(
-              size_t(positionView.size()) * 2 * sizeof(float));
+              size_t(positionCount) * 2 * sizeof(float));
 
           uvBuffer.byteLength = int64_t(uvBuffer.cesium.data.size());
 
@@ -176,7 +184,7 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
           uvAccessor.bufferView = uvBufferViewId;
           uvAccessor.byteOffset = 0;
           uvAccessor.componentType = CesiumGltf::Accessor::ComponentType::FLOAT;
-          uvAccessor.count = int64_t(positionView.size());
+          uvAccessor.count = positionCount;
           uvAccessor.type = CesiumGltf::Accessor::Type::VEC2;
           uvAccessor.min = {1.0, 1.0};
           uvAccessor.max = {0.0, 0.0};
@@ -194,41 +202,78 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
           maxs.emplace_back(&uvAccessor.max);
         }
 
-        // Generate texture coordinates for each position.
-        for (int64_t positionIndex = 0; positionIndex < positionView.size();
+        // Convert each position to cartographic once, and then project all of
+        // them at once with each projection. The approximate conversion is
+        // well within a texel, even for the highest levels of detail.
+        std::vector<glm::dvec3> positionsEcef(size_t(positionCount));
+        for (int64_t positionIndex = 0; positionIndex < positionCount;
              ++positionIndex) {
-          // Get the ECEF position
-          const glm::vec3 position = positionView[positionIndex];
-          const glm::dvec3 positionEcef =
+          const glm::dvec3 position =
+              std::visit(
+                  CesiumGltf::QuantizedPositionFromAccessor{
+                      positionIndex,
+                      dequantization},
+                  positionView)
+                  .value_or(glm::dvec3(0.0));
+          positionsEcef[size_t(positionIndex)] =
               glm::dvec3(fullTransform * glm::dvec4(position, 1.0));
+        }
 
-          // Convert it to cartographic
-          const std::optional<CesiumGeospatial::Cartographic> cartographic =
-              CesiumGeospatial::Ellipsoid::WGS84.cartesianToCartographic(
-                  positionEcef);
-          if (!cartographic) {
-            for (CesiumGltf::AccessorWriter<glm::vec2>& uvWriter : uvWriters) {
-              uvWriter[positionIndex] = glm::dvec2(0.0, 0.0);
-            }
+        std::vector<std::optional<CesiumGeospatial::Cartographic>>
+            cartographics(positionsEcef.size());
+        CesiumGeospatial::Ellipsoid::WGS84.cartesianToCartographicApproximate(
+            positionsEcef,
+            cartographics);
+
+        std::vector<CesiumGeospatial::Cartographic> positionsCartographic(
+            cartographics.size(),
+            CesiumGeospatial::Cartographic(0.0, 0.0, 0.0));
+        for (size_t i = 0; i < cartographics.size(); ++i) {
+          if (!cartographics[i]) {
             continue;
           }
 
+          positionsCartographic[i] = *cartographics[i];
+
           // exclude skirt vertices from bounds
+          const int64_t positionIndex = int64_t(i);
           if (positionIndex >= vertexBegin && positionIndex < vertexEnd) {
-            computedBounds.expandToIncludePosition(*cartographic);
+            computedBounds.expandToIncludePosition(*cartographics[i]);
           }
+        }
 
-          // Generate texture coordinates at this position for each projection
-          for (size_t projectionIndex = 0; projectionIndex < projections.size();
-               ++projectionIndex) {
-            const CesiumGeospatial::Projection& projection =
-                projections[projectionIndex];
-            const CesiumGeometry::Rectangle& rectangle =
-                rectangles[projectionIndex];
+        std::vector<glm::dvec3> projectedPositions(
+            positionsCartographic.size());
+
+        // Generate texture coordinates at each position for each projection
+        for (size_t projectionIndex = 0; projectionIndex < projections.size();
+             ++projectionIndex) {
+          const CesiumGeospatial::Projection& projection =
+              projections[projectionIndex];
+          const CesiumGeometry::Rectangle& rectangle =
+              rectangles[projectionIndex];
+          CesiumGltf::AccessorWriter<glm::vec2>& uvWriter =
+              uvWriters[projectionIndex];
+          std::vector<double>& min = *mins[projectionIndex];
+          std::vector<double>& max = *maxs[projectionIndex];
+
+          // Project them with the raster overlay's projection
+          projectPositions(
+              projection,
+              positionsCartographic,
+              projectedPositions);
+
+          for (int64_t positionIndex = 0; positionIndex < positionCount;
+               ++positionIndex) {
+            const std::optional<CesiumGeospatial::Cartographic>& cartographic =
+                cartographics[size_t(positionIndex)];
+            if (!cartographic) {
+              uvWriter[positionIndex] = glm::dvec2(0.0, 0.0);
+              continue;
+            }
 
-            // Project it with the raster overlay's projection
             glm::dvec3 projectedPosition =
-                projectPosition(projection, cartographic.value());
+                projectedPositions[size_t(positionIndex)];
 
             double longitude = cartographic.value().longitude;
             const double latitude = cartographic.value().latitude;
@@ -287,15 +332,11 @@ RasterOverlayUtilities::createRasterOverlayTextureCoordinates(
               uv.y = 1.0f - uv.y;
             }
 
-            mins[projectionIndex]->at(0) =
-                glm::min(mins[projectionIndex]->at(0), double(uv.x));
-            mins[projectionIndex]->at(1) =
-                glm::min(mins[projectionIndex]->at(1), double(uv.y));
-            maxs[projectionIndex]->at(0) =
-                glm::max(maxs[projectionIndex]->at(0), double(uv.x));
-            maxs[projectionIndex]->at(1) =
-                glm::max(maxs[projectionIndex]->at(1), double(uv.y));
-            uvWriters[projectionIndex][positionIndex] = uv;
+            min[0] = glm::min(min[0], double(uv.x));
+            min[1] = glm::min(min[1], double(uv.y));
+            max[0] = glm::max(max[0], double(uv.x));
+            max[1] = glm::max(max[1], double(uv.y));
+            uvWriter[positionIndex] = uv;
           }
         }
       };
@@ -332,7 +373,7 @@ bool upsamplePrimitiveForRasterOverlays(
     int32_t textureCoordinateIndex);
 
 struct FloatVertexAttribute {
-  const std::vector<std::byte>& buffer;
+  const CesiumUtility::ByteVector& buffer;
   int64_t offset;
   int64_t stride;
   int64_t numberOfFloatsPerVertex;
@@ -909,6 +950,13 @@ bool upsamplePrimitiveForRasterOverlays(
     indicesCount = parentSkirtMeshMetadata->noSkirtIndicesCount;
   }
 
+  // The indices are read without a check per index below.
+  if (indicesBegin + indicesCount > indicesView.size()) {
+    return false;
+  }
+  const typename AccessorView<TIndex>::const_iterator indicesIt =
+      indicesView.begin();
+
   std::vector<uint32_t> clipVertexToIndices;
   std::vector<CesiumGeometry::TriangleClipVertex> clippedA;
   std::vector<CesiumGeometry::TriangleClipVertex> clippedB;
@@ -926,10 +974,86 @@ bool upsamplePrimitiveForRasterOverlays(
   std::vector<uint32_t> indices;
   EdgeIndices edgeIndices;
 
-  for (int64_t i = indicesBegin; i < indicesBegin + indicesCount; i += 3) {
-    TIndex i0 = indicesView[i];
-    TIndex i1 = indicesView[i + 1];
-    TIndex i2 = indicesView[i + 2];
+  const bool keepAboveVInTextureCoordinates =
+      hasInvertedVCoordinate ? !keepAboveV : keepAboveV;
+
+  // Classify each vertex once against both clipping lines, so that most
+  // triangles are discarded or kept whole without clipping them. These are
+  // exactly the cases in which clipTriangleAtAxisAlignedThreshold would
+  // return nothing or the whole triangle.
+  constexpr uint8_t behindU = 1;
+  constexpr uint8_t behindV = 2;
+  std::vector<uint8_t> vertexClassification(size_t(uvView.size()));
+  for (int64_t i = 0; i < uvView.size(); ++i) {
+    const glm::vec2 uv = uvView[i];
+    const bool isBehindU = keepAboveU ? uv.x < 0.5 : uv.x > 0.5;
+    const bool isBehindV =
+        keepAboveVInTextureCoordinates ? uv.y < 0.5 : uv.y > 0.5;
+    vertexClassification[size_t(i)] =
+        uint8_t((isBehindU ? behindU : 0) | (isBehindV ? behindV : 0));
+  }
+
+  const auto addClippedPolygonAndEdge = [&]() {
+    addClippedPolygon(
+        newVertexFloats,
+        indices,
+        attributes,
+        vertexMap,
+        clipVertexToIndices,
+        clippedA,
+        clippedB);
+    if (hasSkirt) {
+      addEdge(
+          edgeIndices,
+          0.5,
+          0.5,
+          keepAboveU,
+          keepAboveV,
+          hasInvertedVCoordinate,
+          uvView,
+          clipVertexToIndices,
+          clippedA,
+          clippedB);
+    }
+  };
+
+  for (int64_t i = indicesBegin; i + 2 < indicesBegin + indicesCount; i += 3) {
+    TIndex i0 = indicesIt[i];
+    TIndex i1 = indicesIt[i + 1];
+    TIndex i2 = indicesIt[i + 2];
+
+    // Invalid indices are left to the AccessorView below.
+    if (size_t(i0) < vertexClassification.size() &&
+        size_t(i1) < vertexClassification.size() &&
+        size_t(i2) < vertexClassification.size()) {
+      const uint8_t c0 = vertexClassification[size_t(i0)];
+      const uint8_t c1 = vertexClassification[size_t(i1)];
+      const uint8_t c2 = vertexClassification[size_t(i2)];
+      const uint8_t all = c0 & c1 & c2;
+      const uint8_t any = c0 | c1 | c2;
+      if ((all & behindU) != 0) {
+        continue;
+      }
+      if ((any & behindU) == 0) {
+        if ((all & behindV) != 0) {
+          continue;
+        }
+        if ((any & behindV) == 0) {
+          // The whole triangle is inside the target tile.
+          clippedA.clear();
+          clippedA.emplace_back(static_cast<int>(i0));
+          clippedA.emplace_back(static_cast<int>(i1));
+          clippedA.emplace_back(static_cast<int>(i2));
+          clipVertexToIndices.clear();
+          clippedB.clear();
+          clippedB.emplace_back(~0);
+          clippedB.emplace_back(~1);
+          clippedB.emplace_back(~2);
+          addClippedPolygonAndEdge();
+          continue;
+        }
+      }
+    }
 
     const glm::vec2 uv0 = uvView[i0];
     const glm::vec2 uv1 = uvView[i1];
@@ -958,7 +1082,7 @@ bool upsamplePrimitiveForRasterOverlays(
     clippedB.clear();
     clipTriangleAtAxisAlignedThreshold(
         0.5,
-        hasInvertedVCoordinate ? !keepAboveV : keepAboveV,
+        keepAboveVInTextureCoordinates,
         ~0,
         ~1,
         ~2,
@@ -968,27 +1092,7 @@ bool upsamplePrimitiveForRasterOverlays(
         clippedB);
 
     // Add the clipped triangle or quad, if any
-    addClippedPolygon(
-        newVertexFloats,
-        indices,
-        attributes,
-        vertexMap,
-        clipVertexToIndices,
-        clippedA,
-        clippedB);
-    if (hasSkirt) {
-      addEdge(
-          edgeIndices,
-          0.5,
-          0.5,
-          keepAboveU,
-          keepAboveV,
-          hasInvertedVCoordinate,
-          uvView,
-          clipVertexToIndices,
-          clippedA,
-          clippedB);
-    }
+    addClippedPolygonAndEdge();
 
     // If the East-West clip yielded a quad (rather than a triangle), clip the
     // second triangle of the quad, too.
@@ -997,7 +1101,7 @@ bool upsamplePrimitiveForRasterOverlays(
       clippedB.clear();
       clipTriangleAtAxisAlignedThreshold(
           0.5,
-          hasInvertedVCoordinate ? !keepAboveV : keepAboveV,
+          keepAboveVInTextureCoordinates,
           ~0,
           ~2,
           ~3,
@@ -1007,27 +1111,7 @@ bool upsamplePrimitiveForRasterOverlays(
           clippedB);
 
       // Add the clipped triangle or quad, if any
-      addClippedPolygon(
-          newVertexFloats,
-          indices,
-          attributes,
-          vertexMap,
-          clipVertexToIndices,
-          clippedA,
-          clippedB);
-      if (hasSkirt) {
-        addEdge(
-            edgeIndices,
-            0.5,
-            0.5,
-            keepAboveU,
-            keepAboveV,
-            hasInvertedVCoordinate,
-            uvView,
-            clipVertexToIndices,
-            clippedA,
-            clippedB);
-      }
+      addClippedPolygonAndEdge();
     }
   }
 
@@ -1042,6 +1126,7 @@ bool upsamplePrimitiveForRasterOverlays(
     skirtMeshMetadata->noSkirtVerticesCount =
         uint32_t(newVertexFloats.size() / size_t(vertexSizeFloats));
     skirtMeshMetadata->meshCenter = parentSkirtMeshMetadata->meshCenter;
+    skirtMeshMetadata->hasBakedSkirts = parentSkirtMeshMetadata->hasBakedSkirts;
     addSkirts(
         newVertexFloats,
         indices,
@@ -1425,15 +1510,19 @@ void addSkirts(
       edgeIndices.west.end(),
       sortEdgeIndices.begin(),
       [](const EdgeVertex& v) { return v.index; });
-  addSkirt(
-      output,
-      indices,
-      attributes,
-      sortEdgeIndices,
-      center,
-      currentSkirt.skirtWestHeight,
-      vertexSizeFloats,
-      positionAttributeIndex);
+  if (currentSkirt.hasBakedSkirts) {
+    addSkirt(
+        output,
+        indices,
+        attributes,
+        sortEdgeIndices,
+        center,
+        currentSkirt.skirtWestHeight,
+        vertexSizeFloats,
+        positionAttributeIndex);
+  } else {
+    currentSkirt.westEdgeIndices = sortEdgeIndices;
+  }
 
   // south
   if (isSouthChild(childID)) {
@@ -1463,15 +1552,19 @@ void addSkirts(
         [](const EdgeVertex& v) { return v.index; });
   }
 
-  addSkirt(
-      output,
-      indices,
-      attributes,
-      sortEdgeIndices,
-      center,
-      currentSkirt.skirtSouthHeight,
-      vertexSizeFloats,
-      positionAttributeIndex);
+  if (currentSkirt.hasBakedSkirts) {
+    addSkirt(
+        output,
+        indices,
+        attributes,
+        sortEdgeIndices,
+        center,
+        currentSkirt.skirtSouthHeight,
+        vertexSizeFloats,
+        positionAttributeIndex);
+  } else {
+    currentSkirt.southEdgeIndices = sortEdgeIndices;
+  }
 
   // east
   if (!isWestChild(childID)) {
@@ -1492,15 +1585,19 @@ void addSkirts(
       edgeIndices.east.end(),
       sortEdgeIndices.begin(),
       [](const EdgeVertex& v) { return v.index; });
-  addSkirt(
-      output,
-      indices,
-      attributes,
-      sortEdgeIndices,
-      center,
-      currentSkirt.skirtEastHeight,
-      vertexSizeFloats,
-      positionAttributeIndex);
+  if (currentSkirt.hasBakedSkirts) {
+    addSkirt(
+        output,
+        indices,
+        attributes,
+        sortEdgeIndices,
+        center,
+        currentSkirt.skirtEastHeight,
+        vertexSizeFloats,
+        positionAttributeIndex);
+  } else {
+    currentSkirt.eastEdgeIndices = sortEdgeIndices;
+  }
 
   // north
   if (!isSouthChild(childID)) {
@@ -1530,15 +1627,19 @@ void addSkirts(
         [](const EdgeVertex& v) { return v.index; });
   }
 
-  addSkirt(
-      output,
-      indices,
-      attributes,
-      sortEdgeIndices,
-      center,
-      currentSkirt.skirtNorthHeight,
-      vertexSizeFloats,
-      positionAttributeIndex);
+  if (currentSkirt.hasBakedSkirts) {
+    addSkirt(
+        output,
+        indices,
+        attributes,
+        sortEdgeIndices,
+        center,
+        currentSkirt.skirtNorthHeight,
+        vertexSizeFloats,
+        positionAttributeIndex);
+  } else {
+    currentSkirt.northEdgeIndices = sortEdgeIndices;
+  }
 }
 
 bool upsamplePrimitiveForRasterOverlays(
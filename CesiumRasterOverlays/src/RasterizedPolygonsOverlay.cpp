@@ -8,8 +8,16 @@
 
 #include <spdlog/fwd.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -17,11 +25,140 @@ using namespace CesiumUtility;
 
 namespace CesiumRasterOverlays {
 namespace {
+// A grid over the bounding rectangles of a list of polygons, so that a tile
+// only has to consider the polygons near it.
+class PolygonGrid {
+public:
+  explicit PolygonGrid(const std::vector<CartographicPolygon>& polygons)
+      : _west(0.0),
+        _south(0.0),
+        _east(0.0),
+        _north(0.0),
+        _columns(0),
+        _rows(0),
+        _cells() {
+    std::vector<std::pair<size_t, GlobeRectangle>> parts;
+    for (size_t i = 0; i < polygons.size(); ++i) {
+      const std::optional<GlobeRectangle>& boundingRectangle =
+          polygons[i].getBoundingRectangle();
+      if (!boundingRectangle) {
+        continue;
+      }
+
+      const std::pair<GlobeRectangle, std::optional<GlobeRectangle>> split =
+          boundingRectangle->splitAtAntiMeridian();
+      parts.emplace_back(i, split.first);
+      if (split.second) {
+        parts.emplace_back(i, *split.second);
+      }
+    }
+
+    if (parts.empty()) {
+      return;
+    }
+
+    this->_west = std::numeric_limits<double>::max();
+    this->_south = std::numeric_limits<double>::max();
+    this->_east = std::numeric_limits<double>::lowest();
+    this->_north = std::numeric_limits<double>::lowest();
+    for (const auto& [index, rectangle] : parts) {
+      this->_west = std::min(this->_west, rectangle.getWest());
+      this->_south = std::min(this->_south, rectangle.getSouth());
+      this->_east = std::max(this->_east, rectangle.getEast());
+      this->_north = std::max(this->_north, rectangle.getNorth());
+    }
+
+    // About one polygon per cell, if they're spread evenly.
+    const size_t cellsPerSide = std::clamp(
+        size_t(std::ceil(std::sqrt(double(polygons.size())))),
+        size_t(1),
+        size_t(256));
+    this->_columns = cellsPerSide;
+    this->_rows = cellsPerSide;
+    this->_cells.resize(this->_columns * this->_rows);
+
+    for (const auto& [index, rectangle] : parts) {
+      this->forEachCell(rectangle, [this, index = index](size_t cell) {
+        this->_cells[cell].emplace_back(index);
+      });
+    }
+  }
+
+  // Finds the polygons whose bounding rectangles may intersect a rectangle,
+  // in order and without duplicates.
+  void findPolygons(
+      const GlobeRectangle& rectangle,
+      std::vector<size_t>& result) const {
+    result.clear();
+    const std::pair<GlobeRectangle, std::optional<GlobeRectangle>> split =
+        rectangle.splitAtAntiMeridian();
+    const auto addPolygons = [this, &result](size_t cell) {
+      result.insert(
+          result.end(),
+          this->_cells[cell].begin(),
+          this->_cells[cell].end());
+    };
+    this->forEachCell(split.first, addPolygons);
+    if (split.second) {
+      this->forEachCell(*split.second, addPolygons);
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+  }
+
+private:
+  template <typename Callback>
+  void forEachCell(const GlobeRectangle& rectangle, Callback&& callback) const {
+    if (this->_cells.empty() || rectangle.getEast() < this->_west ||
+        rectangle.getWest() > this->_east ||
+        rectangle.getNorth() < this->_south ||
+        rectangle.getSouth() > this->_north) {
+      return;
+    }
+
+    const size_t firstColumn = this->columnIndex(rectangle.getWest());
+    const size_t lastColumn = this->columnIndex(rectangle.getEast());
+    const size_t firstRow = this->rowIndex(rectangle.getSouth());
+    const size_t lastRow = this->rowIndex(rectangle.getNorth());
+    for (size_t row = firstRow; row <= lastRow; ++row) {
+      for (size_t column = firstColumn; column <= lastColumn; ++column) {
+        callback(row * this->_columns + column);
+      }
+    }
+  }
+
+  size_t columnIndex(double longitude) const {
+    return cellIndex(longitude, this->_west, this->_east, this->_columns);
+  }
+
+  size_t rowIndex(double latitude) const {
+    return cellIndex(latitude, this->_south, this->_north, this->_rows);
+  }
+
+  static size_t
+  cellIndex(double value, double minimum, double maximum, size_t count) {
+    const double size =
+        std::max(maximum - minimum, std::numeric_limits<double>::min());
+    const double cell = (value - minimum) / size * double(count);
+    return size_t(std::clamp(cell, 0.0, double(count - 1)));
+  }
+
+  double _west;
+  double _south;
+  double _east;
+  double _north;
+  size_t _columns;
+  size_t _rows;
+  std::vector<std::vector<size_t>> _cells;
+};
+
 void rasterizePolygons(
     LoadedRasterOverlayImage& loaded,
     const CesiumGeospatial::GlobeRectangle& rectangle,
     const glm::dvec2& textureSize,
     const std::vector<CartographicPolygon>& cartographicPolygons,
+    const PolygonGrid& polygonGrid,
     bool invertSelection) {
 
   CesiumGltf::ImageCesium& image = loaded.image.emplace();
@@ -37,10 +174,29 @@ void rasterizePolygons(
     outsideColor = static_cast<std::byte>(0);
   }
 
+  // Only the polygons whose bounding rectangles intersect the tile matter.
+  std::vector<size_t> polygons;
+  polygonGrid.findPolygons(rectangle, polygons);
+  polygons.erase(
+      std::remove_if(
+          polygons.begin(),
+          polygons.end(),
+          [&rectangle, &cartographicPolygons](size_t i) {
+            const std::optional<CesiumGeospatial::GlobeRectangle>&
+                boundingRectangle =
+                    cartographicPolygons[i].getBoundingRectangle();
+            return !boundingRectangle ||
+                   !rectangle.computeIntersection(*boundingRectangle);
+          }),
+      polygons.end());
+
   // create a 1x1 mask if the rectangle is completely inside a polygon
-  if (CartographicPolygon::rectangleIsWithinPolygons(
-          rectangle,
-          cartographicPolygons)) {
+  if (std::any_of(
+          polygons.begin(),
+          polygons.end(),
+          [&rectangle, &cartographicPolygons](size_t i) {
+            return cartographicPolygons[i].containsRectangle(rectangle);
+          })) {
     loaded.moreDetailAvailable = false;
     image.width = 1;
     image.height = 1;
@@ -50,20 +206,8 @@ void rasterizePolygons(
     return;
   }
 
-  bool completelyOutsidePolygons = true;
-  for (const CartographicPolygon& selection : cartographicPolygons) {
-    const std::optional<CesiumGeospatial::GlobeRectangle>& boundingRectangle =
-        selection.getBoundingRectangle();
-
-    if (boundingRectangle &&
-        rectangle.computeIntersection(*boundingRectangle)) {
-      completelyOutsidePolygons = false;
-      break;
-    }
-  }
-
   // create a 1x1 mask if the rectangle is completely outside all polygons
-  if (completelyOutsidePolygons) {
+  if (polygons.empty()) {
     loaded.moreDetailAvailable = false;
     image.width = 1;
     image.height = 1;
@@ -84,70 +228,83 @@ void rasterizePolygons(
   image.bytesPerChannel = 1;
   image.pixelData.resize(size_t(image.width * image.height), outsideColor);
 
-  // TODO: this is naive approach, use line-triangle
-  // intersections to rasterize one row at a time
-  // NOTE: also completely ignores antimeridian (really these
+  const double width = double(image.width);
+  const double height = double(image.height);
+
+  // Rasterize each triangle one row at a time: the pixels of a row whose
+  // centers are between the crossings of the triangle's edges are inside.
+  // NOTE: this completely ignores the antimeridian (really these
   // calculations should be normalized to the first vertex)
-  for (const CartographicPolygon& polygon : cartographicPolygons) {
+  for (size_t polygonIndex : polygons) {
+    const CartographicPolygon& polygon = cartographicPolygons[polygonIndex];
     const std::vector<glm::dvec2>& vertices = polygon.getVertices();
     const std::vector<uint32_t>& indices = polygon.getIndices();
     for (size_t triangle = 0; triangle < indices.size() / 3; ++triangle) {
-      const glm::dvec2& a = vertices[indices[3 * triangle]];
-      const glm::dvec2& b = vertices[indices[3 * triangle + 1]];
-      const glm::dvec2& c = vertices[indices[3 * triangle + 2]];
-
-      // TODO: deal with the corner cases here
-      const double minX = glm::min(a.x, glm::min(b.x, c.x));
-      const double minY = glm::min(a.y, glm::min(b.y, c.y));
-      const double maxX = glm::max(a.x, glm::max(b.x, c.x));
-      const double maxY = glm::max(a.y, glm::max(b.y, c.y));
-
-      const CesiumGeospatial::GlobeRectangle triangleBounds(
-          minX,
-          minY,
-          maxX,
-          maxY);
-
-      // skip this triangle if it is entirely outside the tile bounds
-      if (!rectangle.computeIntersection(triangleBounds)) {
-        continue;
-      }
-
-      const glm::dvec2 ab = b - a;
-      const glm::dvec2 ab_perp(-ab.y, ab.x);
-      const glm::dvec2 bc = c - b;
-      const glm::dvec2 bc_perp(-bc.y, bc.x);
-      const glm::dvec2 ca = a - c;
-      const glm::dvec2 ca_perp(-ca.y, ca.x);
-
-      size_t width = size_t(image.width);
-      size_t height = size_t(image.height);
-
-      for (size_t j = 0; j < height; ++j) {
+      const std::array<glm::dvec2, 3> corners{
+          vertices[indices[3 * triangle]],
+          vertices[indices[3 * triangle + 1]],
+          vertices[indices[3 * triangle + 2]]};
+
+      const double minY =
+          glm::min(corners[0].y, glm::min(corners[1].y, corners[2].y));
+      const double maxY =
+          glm::max(corners[0].y, glm::max(corners[1].y, corners[2].y));
+
+      // The rows whose pixel centers are within the latitudes of the
+      // triangle.
+      const double firstRow = glm::max(
+          glm::ceil(
+              height * (rectangle.getNorth() - maxY) / rectangleHeight - 0.5),
+          0.0);
+      const double lastRow = glm::min(
+          glm::floor(
+              height * (rectangle.getNorth() - minY) / rectangleHeight - 0.5),
+          height - 1.0);
+
+      for (double row = firstRow; row <= lastRow; row += 1.0) {
         const double pixelY =
             rectangle.getSouth() +
-            rectangleHeight * (1.0 - (double(j) + 0.5) / double(height));
-        for (size_t i = 0; i < width; ++i) {
-          const double pixelX = rectangle.getWest() + rectangleWidth *
-                                                          (double(i) + 0.5) /
-                                                          double(width);
-          const glm::dvec2 v(pixelX, pixelY);
-
-          const glm::dvec2 av = v - a;
-          const glm::dvec2 cv = v - c;
-
-          const double v_proj_ab_perp = glm::dot(av, ab_perp);
-          const double v_proj_bc_perp = glm::dot(cv, bc_perp);
-          const double v_proj_ca_perp = glm::dot(cv, ca_perp);
-
-          // will determine in or out, irrespective of winding
-          if ((v_proj_ab_perp >= 0.0 && v_proj_ca_perp >= 0.0 &&
-               v_proj_bc_perp >= 0.0) ||
-              (v_proj_ab_perp <= 0.0 && v_proj_ca_perp <= 0.0 &&
-               v_proj_bc_perp <= 0.0)) {
-            image.pixelData[width * j + i] = insideColor;
+            rectangleHeight * (1.0 - (row + 0.5) / height);
+
+        double left = std::numeric_limits<double>::max();
+        double right = std::numeric_limits<double>::lowest();
+        for (size_t k = 0; k < 3; ++k) {
+          const glm::dvec2& p = corners[k];
+          const glm::dvec2& q = corners[(k + 1) % 3];
+          if ((p.y < pixelY && q.y < pixelY) ||
+              (p.y > pixelY && q.y > pixelY)) {
+            continue;
+          }
+
+          if (p.y == q.y) {
+            left = glm::min(left, glm::min(p.x, q.x));
+            right = glm::max(right, glm::max(p.x, q.x));
+          } else {
+            const double x = p.x + (pixelY - p.y) * (q.x - p.x) / (q.y - p.y);
+            left = glm::min(left, x);
+            right = glm::max(right, x);
           }
         }
+
+        const double firstColumn = glm::max(
+            glm::ceil(
+                width * (left - rectangle.getWest()) / rectangleWidth - 0.5),
+            0.0);
+        const double lastColumn = glm::min(
+            glm::floor(
+                width * (right - rectangle.getWest()) / rectangleWidth - 0.5),
+            width - 1.0);
+        if (firstColumn > lastColumn) {
+          continue;
+        }
+
+        const auto rowBegin =
+            image.pixelData.begin() +
+            static_cast<std::ptrdiff_t>(size_t(row) * size_t(image.width));
+        std::fill(
+            rowBegin + static_cast<std::ptrdiff_t>(firstColumn),
+            rowBegin + static_cast<std::ptrdiff_t>(lastColumn) + 1,
+            insideColor);
       }
     }
   }
@@ -159,6 +316,7 @@ class CESIUMRASTEROVERLAYS_API RasterizedPolygonsTileProvider final
 
 private:
   std::vector<CartographicPolygon> _polygons;
+  PolygonGrid _polygonGrid;
   bool _invertSelection;
 
 public:
@@ -185,6 +343,7 @@ public:
                 projection,
                 CesiumGeospatial::GlobeRectangle::MAXIMUM)),
         _polygons(polygons),
+        _polygonGrid(this->_polygons),
         _invertSelection(invertSelection) {}
 
   virtual CesiumAsync::Future<LoadedRasterOverlayImage>
@@ -198,6 +357,7 @@ public:
 
     return this->getAsyncSystem().runInWorkerThread(
         [&polygons = this->_polygons,
+         &polygonGrid = this->_polygonGrid,
          invertSelection = this->_invertSelection,
          projection = this->getProjection(),
          rectangle = overlayTile.getRectangle(),
@@ -213,6 +373,7 @@ public:
               tileRectangle,
               textureSize,
               polygons,
+              polygonGrid,
               invertSelection);
 
           return result;
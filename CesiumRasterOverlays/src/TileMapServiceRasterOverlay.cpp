@@ -81,11 +81,13 @@ protected:
 
     if (level < _tileSets.size()) {
       const TileMapServiceTileset& tileset = _tileSets[level];
-      std::string url = CesiumUtility::Uri::resolve(
-          this->_url,
-          tileset.url + "/" + std::to_string(tileID.x) + "/" +
-              std::to_string(tileID.y) + this->_fileExtension,
-          true);
+      std::string relative = tileset.url;
+      relative += '/';
+      relative += std::to_string(tileID.x);
+      relative += '/';
+      relative += std::to_string(tileID.y);
+      relative += this->_fileExtension;
+      std::string url = this->_url.resolve(relative, true);
       return this->loadTileImageFromUrl(
           url,
           this->_headers,
@@ -103,7 +105,7 @@ protected:
   }
 
 private:
-  std::string _url;
+  BaseUri _url;
   std::vector<IAssetAccessor::THeader> _headers;
   std::string _fileExtension;
   std::vector<TileMapServiceTileset> _tileSets;
@@ -0,0 +1,250 @@
+#include "VectorTile.h"
+
+#include <CesiumUtility/Gunzip.h>
+
+#include <limits>
+
+using namespace CesiumUtility;
+
+namespace CesiumRasterOverlays {
+
+namespace {
+// The wire types of the protocol buffer encoding.
+enum class WireType : uint32_t {
+  Varint = 0,
+  Fixed64 = 1,
+  LengthDelimited = 2,
+  Fixed32 = 5
+};
+
+// Reads the fields of a protocol buffer message one at a time.
+class ProtobufReader {
+public:
+  explicit ProtobufReader(const gsl::span<const std::byte>& data)
+      : _data(data), _position(0) {}
+
+  bool atEnd() const noexcept { return this->_position >= this->_data.size(); }
+
+  bool readVarint(uint64_t& value) noexcept {
+    value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+      if (this->atEnd()) {
+        return false;
+      }
+      const uint64_t byte = uint64_t(this->_data[this->_position++]);
+      value |= (byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool readKey(uint32_t& field, WireType& wireType) noexcept {
+    uint64_t key;
+    if (!this->readVarint(key)) {
+      return false;
+    }
+    field = uint32_t(key >> 3);
+    wireType = WireType(key & 0x7);
+    return true;
+  }
+
+  bool readBytes(gsl::span<const std::byte>& bytes) noexcept {
+    uint64_t length;
+    if (!this->readVarint(length) ||
+        length > this->_data.size() - this->_position) {
+      return false;
+    }
+    bytes = this->_data.subspan(this->_position, size_t(length));
+    this->_position += size_t(length);
+    return true;
+  }
+
+  bool skip(WireType wireType) noexcept {
+    switch (wireType) {
+    case WireType::Varint: {
+      uint64_t unused;
+      return this->readVarint(unused);
+    }
+    case WireType::Fixed64:
+      return this->skipBytes(8);
+    case WireType::LengthDelimited: {
+      gsl::span<const std::byte> unused;
+      return this->readBytes(unused);
+    }
+    case WireType::Fixed32:
+      return this->skipBytes(4);
+    default:
+      return false;
+    }
+  }
+
+private:
+  bool skipBytes(size_t count) noexcept {
+    if (count > this->_data.size() - this->_position) {
+      return false;
+    }
+    this->_position += count;
+    return true;
+  }
+
+  gsl::span<const std::byte> _data;
+  size_t _position;
+};
+
+// The commands of a feature's geometry.
+constexpr uint32_t moveTo = 1;
+constexpr uint32_t lineTo = 2;
+constexpr uint32_t closePath = 7;
+
+int64_t decodeZigZag(uint64_t value) noexcept {
+  return int64_t(value >> 1) ^ -int64_t(value & 1);
+}
+
+bool decodeGeometry(
+    const gsl::span<const std::byte>& data,
+    VectorTileFeature& feature) {
+  ProtobufReader reader(data);
+  glm::dvec2 cursor(0.0);
+  while (!reader.atEnd()) {
+    uint64_t commandInteger;
+    if (!reader.readVarint(commandInteger)) {
+      return false;
+    }
+
+    const uint32_t command = uint32_t(commandInteger & 0x7);
+    const uint64_t count = commandInteger >> 3;
+    if (command == closePath) {
+      // The ring is closed implicitly.
+      continue;
+    }
+    if (command != moveTo && command != lineTo) {
+      return false;
+    }
+
+    for (uint64_t i = 0; i < count; ++i) {
+      uint64_t dx;
+      uint64_t dy;
+      if (!reader.readVarint(dx) || !reader.readVarint(dy)) {
+        return false;
+      }
+      cursor += glm::dvec2(double(decodeZigZag(dx)), double(decodeZigZag(dy)));
+
+      // Each point of a multi-point is a part of its own.
+      if (command == moveTo) {
+        feature.parts.emplace_back();
+      } else if (feature.parts.empty()) {
+        return false;
+      }
+      feature.parts.back().emplace_back(cursor);
+    }
+  }
+  return true;
+}
+
+bool decodeFeature(
+    const gsl::span<const std::byte>& data,
+    VectorTileFeature& feature) {
+  ProtobufReader reader(data);
+  while (!reader.atEnd()) {
+    uint32_t field;
+    WireType wireType;
+    if (!reader.readKey(field, wireType)) {
+      return false;
+    }
+
+    if (field == 3 && wireType == WireType::Varint) {
+      uint64_t type;
+      if (!reader.readVarint(type)) {
+        return false;
+      }
+      feature.type = type <= 3 ? VectorTileFeature::Type(type)
+                               : VectorTileFeature::Type::Unknown;
+    } else if (field == 4 && wireType == WireType::LengthDelimited) {
+      gsl::span<const std::byte> geometry;
+      if (!reader.readBytes(geometry) || !decodeGeometry(geometry, feature)) {
+        return false;
+      }
+    } else if (!reader.skip(wireType)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool decodeLayer(
+    const gsl::span<const std::byte>& data,
+    VectorTileLayer& layer) {
+  ProtobufReader reader(data);
+  while (!reader.atEnd()) {
+    uint32_t field;
+    WireType wireType;
+    if (!reader.readKey(field, wireType)) {
+      return false;
+    }
+
+    if (field == 1 && wireType == WireType::LengthDelimited) {
+      gsl::span<const std::byte> name;
+      if (!reader.readBytes(name)) {
+        return false;
+      }
+      layer.name.assign(
+          reinterpret_cast<const char*>(name.data()),
+          name.size());
+    } else if (field == 2 && wireType == WireType::LengthDelimited) {
+      gsl::span<const std::byte> feature;
+      if (!reader.readBytes(feature) ||
+          !decodeFeature(feature, layer.features.emplace_back())) {
+        return false;
+      }
+    } else if (field == 5 && wireType == WireType::Varint) {
+      uint64_t extent;
+      if (!reader.readVarint(extent) || extent == 0 ||
+          extent > std::numeric_limits<uint32_t>::max()) {
+        return false;
+      }
+      layer.extent = uint32_t(extent);
+    } else if (!reader.skip(wireType)) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+/*static*/ std::optional<VectorTile>
+VectorTile::decode(const gsl::span<const std::byte>& data) {
+  std::vector<std::byte> inflated;
+  gsl::span<const std::byte> encoded = data;
+  if (isGzip(data)) {
+    if (!gunzip(data, inflated)) {
+      return std::nullopt;
+    }
+    encoded = gsl::span<const std::byte>(inflated);
+  }
+
+  VectorTile tile;
+  ProtobufReader reader(encoded);
+  while (!reader.atEnd()) {
+    uint32_t field;
+    WireType wireType;
+    if (!reader.readKey(field, wireType)) {
+      return std::nullopt;
+    }
+
+    if (field == 3 && wireType == WireType::LengthDelimited) {
+      gsl::span<const std::byte> layer;
+      if (!reader.readBytes(layer) ||
+          !decodeLayer(layer, tile.layers.emplace_back())) {
+        return std::nullopt;
+      }
+    } else if (!reader.skip(wireType)) {
+      return std::nullopt;
+    }
+  }
+
+  return tile;
+}
+
+} // namespace CesiumRasterOverlays
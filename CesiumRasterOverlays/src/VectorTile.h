@@ -0,0 +1,80 @@
+#pragma once
+
+#include <glm/vec2.hpp>
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumRasterOverlays {
+
+/**
+ * @brief A feature of a {@link VectorTileLayer}.
+ */
+struct VectorTileFeature {
+  /**
+   * @brief The type of the geometry of a feature.
+   */
+  enum class Type { Unknown = 0, Point = 1, LineString = 2, Polygon = 3 };
+
+  /**
+   * @brief The type of the geometry.
+   */
+  Type type = Type::Unknown;
+
+  /**
+   * @brief The parts of the geometry, in the coordinates of the tile.
+   *
+   * These are the points of a `Point` feature, the lines of a `LineString`
+   * feature, and the rings of a `Polygon` feature. The first point of a ring
+   * isn't repeated at its end. The coordinates run from 0 to the extent of
+   * the layer, with y increasing downward.
+   */
+  std::vector<std::vector<glm::dvec2>> parts;
+};
+
+/**
+ * @brief A layer of a {@link VectorTile}.
+ */
+struct VectorTileLayer {
+  /**
+   * @brief The name of the layer.
+   */
+  std::string name;
+
+  /**
+   * @brief The size of the tile in the coordinates of its features.
+   */
+  uint32_t extent = 4096;
+
+  /**
+   * @brief The features of the layer.
+   */
+  std::vector<VectorTileFeature> features;
+};
+
+/**
+ * @brief The geometry of a Mapbox Vector Tile.
+ *
+ * Only the geometry of the features is decoded; their tags are skipped.
+ */
+struct VectorTile {
+  /**
+   * @brief The layers of the tile.
+   */
+  std::vector<VectorTileLayer> layers;
+
+  /**
+   * @brief Decodes a tile from its protocol buffer encoding.
+   *
+   * @param data The encoded tile, which may be gzipped.
+   * @return The tile, or `std::nullopt` if the data is not a valid tile.
+   */
+  static std::optional<VectorTile>
+  decode(const gsl::span<const std::byte>& data);
+};
+
+} // namespace CesiumRasterOverlays
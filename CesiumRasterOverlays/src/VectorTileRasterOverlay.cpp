@@ -0,0 +1,393 @@
+#include "VectorTile.h"
+
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumGeospatial/WebMercatorProjection.h>
+#include <CesiumRasterOverlays/QuadtreeRasterOverlayTileProvider.h>
+#include <CesiumRasterOverlays/RasterOverlayTile.h>
+#include <CesiumRasterOverlays/VectorTileRasterOverlay.h>
+#include <CesiumUtility/CreditSystem.h>
+#include <CesiumUtility/Tracing.h>
+#include <CesiumUtility/Uri.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace CesiumRasterOverlays {
+
+namespace {
+// The pixels of an image that are covered by the shapes drawn in it.
+class CoverageMask {
+public:
+  CoverageMask(int32_t width, int32_t height)
+      : _width(width),
+        _height(height),
+        _covered(size_t(width * height), false),
+        _crossings() {}
+
+  bool isCovered(size_t pixel) const noexcept { return this->_covered[pixel]; }
+
+  // Covers the pixels whose centers are inside the rings, in pixel
+  // coordinates, with the even-odd rule.
+  void fillRings(const std::vector<std::vector<glm::dvec2>>& rings) {
+    double minY = std::numeric_limits<double>::max();
+    double maxY = std::numeric_limits<double>::lowest();
+    for (const std::vector<glm::dvec2>& ring : rings) {
+      for (const glm::dvec2& point : ring) {
+        minY = std::min(minY, point.y);
+        maxY = std::max(maxY, point.y);
+      }
+    }
+
+    const double firstRow = std::max(std::ceil(minY - 0.5), 0.0);
+    const double lastRow =
+        std::min(std::floor(maxY - 0.5), double(this->_height - 1));
+    for (double row = firstRow; row <= lastRow; row += 1.0) {
+      const double y = row + 0.5;
+
+      // Each edge crosses the row if one end is above its center and the
+      // other isn't, which counts a crossing at a vertex only once.
+      this->_crossings.clear();
+      for (const std::vector<glm::dvec2>& ring : rings) {
+        for (size_t i = 0; i < ring.size(); ++i) {
+          const glm::dvec2& p = ring[i];
+          const glm::dvec2& q = ring[(i + 1) % ring.size()];
+          if ((p.y <= y) != (q.y <= y)) {
+            this->_crossings.emplace_back(
+                p.x + (y - p.y) * (q.x - p.x) / (q.y - p.y));
+          }
+        }
+      }
+      std::sort(this->_crossings.begin(), this->_crossings.end());
+
+      const size_t rowStart = size_t(row) * size_t(this->_width);
+      for (size_t i = 1; i < this->_crossings.size(); i += 2) {
+        const double firstColumn =
+            std::max(std::ceil(this->_crossings[i - 1] - 0.5), 0.0);
+        const double endColumn = std::min(
+            std::ceil(this->_crossings[i] - 0.5),
+            double(this->_width));
+        for (double column = firstColumn; column < endColumn; column += 1.0) {
+          this->_covered[rowStart + size_t(column)] = true;
+        }
+      }
+    }
+  }
+
+  // Covers the pixels of a line of a width, in pixel coordinates. Each
+  // segment is drawn as a rectangle that extends past its ends by half the
+  // width, so that the segments of a line join without gaps.
+  void strokeLine(const std::vector<glm::dvec2>& line, double width) {
+    const double halfWidth = 0.5 * width;
+    std::vector<std::vector<glm::dvec2>> rectangle(1);
+    for (size_t i = 1; i < line.size(); ++i) {
+      const glm::dvec2& a = line[i - 1];
+      const glm::dvec2& b = line[i];
+      const double length = glm::distance(a, b);
+      const glm::dvec2 along =
+          length > 0.0 ? (b - a) * (halfWidth / length)
+                       : glm::dvec2(halfWidth, 0.0);
+      const glm::dvec2 across(-along.y, along.x);
+      rectangle[0] = {
+          a - along + across,
+          b + along + across,
+          b + along - across,
+          a - along - across};
+      this->fillRings(rectangle);
+    }
+  }
+
+private:
+  int32_t _width;
+  int32_t _height;
+  std::vector<bool> _covered;
+  std::vector<double> _crossings;
+};
+
+// Draws a color over the covered pixels of an RGBA image.
+void blend(
+    ImageCesium& image,
+    const CoverageMask& mask,
+    const glm::u8vec4& color) {
+  const double sourceAlpha = double(color.a) / 255.0;
+  if (sourceAlpha <= 0.0) {
+    return;
+  }
+
+  const size_t pixels = size_t(image.width * image.height);
+  for (size_t i = 0; i < pixels; ++i) {
+    if (!mask.isCovered(i)) {
+      continue;
+    }
+
+    std::byte* pPixel = &image.pixelData[4 * i];
+    const double destinationAlpha = double(uint8_t(pPixel[3])) / 255.0;
+    const double remainingAlpha = destinationAlpha * (1.0 - sourceAlpha);
+    const double alpha = sourceAlpha + remainingAlpha;
+    for (glm::length_t c = 0; c < 3; ++c) {
+      const double value = (double(color[c]) * sourceAlpha +
+                            double(uint8_t(pPixel[c])) * remainingAlpha) /
+                           alpha;
+      pPixel[c] = std::byte(uint8_t(std::round(value)));
+    }
+    pPixel[3] = std::byte(uint8_t(std::round(alpha * 255.0)));
+  }
+}
+
+// Rasterizes the lines and polygons of a vector tile, or of a square part of
+// it for a tile of a higher level. The part is the square at `offset`, in
+// units of its size, of a tile divided into `divisions` squares on each side.
+ImageCesium rasterizeVectorTile(
+    const VectorTile& vectorTile,
+    const VectorTileRasterOverlayOptions& options,
+    const glm::dvec2& offset,
+    double divisions) {
+  CESIUM_TRACE("rasterize vector tile");
+
+  ImageCesium image;
+  image.width = int32_t(options.tileSize);
+  image.height = int32_t(options.tileSize);
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(size_t(image.width * image.height * 4), std::byte(0));
+
+  CoverageMask fills(image.width, image.height);
+  CoverageMask lines(image.width, image.height);
+  const double lineWidth = std::max(options.lineWidth, 1.0);
+  const double tileSize = double(options.tileSize);
+
+  std::vector<std::vector<glm::dvec2>> parts;
+  for (const VectorTileLayer& layer : vectorTile.layers) {
+    if (!options.layers.empty() &&
+        std::find(options.layers.begin(), options.layers.end(), layer.name) ==
+            options.layers.end()) {
+      continue;
+    }
+
+    const double scale = tileSize * divisions / double(layer.extent);
+    const glm::dvec2 origin = offset * tileSize;
+
+    for (const VectorTileFeature& feature : layer.features) {
+      if (feature.type != VectorTileFeature::Type::LineString &&
+          feature.type != VectorTileFeature::Type::Polygon) {
+        continue;
+      }
+
+      parts = feature.parts;
+      for (std::vector<glm::dvec2>& part : parts) {
+        for (glm::dvec2& point : part) {
+          point = point * scale - origin;
+        }
+      }
+
+      if (feature.type == VectorTileFeature::Type::Polygon) {
+        fills.fillRings(parts);
+      } else {
+        for (const std::vector<glm::dvec2>& line : parts) {
+          lines.strokeLine(line, lineWidth);
+        }
+      }
+    }
+  }
+
+  blend(image, fills, options.fillColor);
+  blend(image, lines, options.lineColor);
+  return image;
+}
+} // namespace
+
+class VectorTileRasterOverlayTileProvider final
+    : public QuadtreeRasterOverlayTileProvider {
+public:
+  VectorTileRasterOverlayTileProvider(
+      const IntrusivePointer<const RasterOverlay>& pOwner,
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::shared_ptr<IAssetAccessor>& pAssetAccessor,
+      std::optional<Credit> credit,
+      const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+          pPrepareRendererResources,
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const CesiumGeospatial::Projection& projection,
+      const CesiumGeometry::QuadtreeTilingScheme& tilingScheme,
+      const CesiumGeometry::Rectangle& coverageRectangle,
+      const std::string& url,
+      const std::vector<IAssetAccessor::THeader>& headers,
+      const VectorTileRasterOverlayOptions& options,
+      uint32_t maximumRasterizedLevel)
+      : QuadtreeRasterOverlayTileProvider(
+            pOwner,
+            asyncSystem,
+            pAssetAccessor,
+            credit,
+            pPrepareRendererResources,
+            pLogger,
+            projection,
+            tilingScheme,
+            coverageRectangle,
+            options.minimumLevel,
+            maximumRasterizedLevel,
+            options.tileSize,
+            options.tileSize),
+        _url(url),
+        _headers(headers),
+        _options(options) {}
+
+  virtual ~VectorTileRasterOverlayTileProvider() {}
+
+protected:
+  virtual CesiumAsync::Future<LoadedRasterOverlayImage> loadQuadtreeTileImage(
+      const CesiumGeometry::QuadtreeTileID& tileID) const override {
+    // Above the maximum level of the server, rasterize the part of the
+    // ancestor at that level that covers the tile.
+    const uint32_t sourceLevel =
+        std::min(tileID.level, this->_options.maximumLevel);
+    const uint32_t levelsAbove = tileID.level - sourceLevel;
+    const uint32_t column = tileID.x;
+    const uint32_t row = (1u << tileID.level) - tileID.y - 1u;
+    const uint32_t sourceColumn = column >> levelsAbove;
+    const uint32_t sourceRow = row >> levelsAbove;
+    const glm::dvec2 offset(
+        double(column - (sourceColumn << levelsAbove)),
+        double(row - (sourceRow << levelsAbove)));
+    const double divisions = double(1u << levelsAbove);
+
+    const std::string url = CesiumUtility::Uri::substituteTemplateParameters(
+        this->_url,
+        [sourceLevel, sourceColumn, sourceRow](const std::string& placeholder) {
+          if (placeholder == "z") {
+            return std::to_string(sourceLevel);
+          }
+          if (placeholder == "x") {
+            return std::to_string(sourceColumn);
+          }
+          if (placeholder == "y") {
+            return std::to_string(sourceRow);
+          }
+          return "{" + placeholder + "}";
+        });
+
+    return this->getAssetAccessor()
+        ->get(this->getAsyncSystem(), url, this->_headers)
+        .thenInWorkerThread(
+            [rectangle = this->getTilingScheme().tileToRectangle(tileID),
+             moreDetailAvailable = tileID.level < this->getMaximumLevel(),
+             options = this->_options,
+             offset,
+             divisions](std::shared_ptr<IAssetRequest>&& pRequest) {
+              LoadedRasterOverlayImage result;
+              result.rectangle = rectangle;
+              result.moreDetailAvailable = moreDetailAvailable;
+
+              const IAssetResponse* pResponse = pRequest->response();
+              if (pResponse == nullptr) {
+                result.errors.emplace_back(
+                    "Vector tile request for " + pRequest->url() + " failed.");
+                return result;
+              }
+
+              if (pResponse->statusCode() != 0 &&
+                  (pResponse->statusCode() < 200 ||
+                   pResponse->statusCode() >= 300)) {
+                result.errors.emplace_back(
+                    "Vector tile response code " +
+                    std::to_string(pResponse->statusCode()) + " for " +
+                    pRequest->url());
+                return result;
+              }
+
+              // An empty response is a tile without any features.
+              const std::optional<VectorTile> maybeVectorTile =
+                  VectorTile::decode(pResponse->data());
+              if (!maybeVectorTile) {
+                result.errors.emplace_back(
+                    "Vector tile response for " + pRequest->url() +
+                    " is not a valid vector tile.");
+                return result;
+              }
+
+              result.image = rasterizeVectorTile(
+                  *maybeVectorTile,
+                  options,
+                  offset,
+                  divisions);
+              return result;
+            });
+  }
+
+private:
+  std::string _url;
+  std::vector<IAssetAccessor::THeader> _headers;
+  VectorTileRasterOverlayOptions _options;
+};
+
+VectorTileRasterOverlay::VectorTileRasterOverlay(
+    const std::string& name,
+    const std::string& url,
+    const std::vector<IAssetAccessor::THeader>& headers,
+    const VectorTileRasterOverlayOptions& vectorTileOptions,
+    const RasterOverlayOptions& overlayOptions)
+    : RasterOverlay(name, overlayOptions),
+      _url(url),
+      _headers(headers),
+      _options(vectorTileOptions) {}
+
+VectorTileRasterOverlay::~VectorTileRasterOverlay() {}
+
+Future<RasterOverlay::CreateTileProviderResult>
+VectorTileRasterOverlay::createTileProvider(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CesiumUtility::CreditSystem>& pCreditSystem,
+    const std::shared_ptr<IPrepareRasterOverlayRendererResources>&
+        pPrepareRendererResources,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    CesiumUtility::IntrusivePointer<const RasterOverlay> pOwner) const {
+
+  pOwner = pOwner ? pOwner : this;
+
+  const std::optional<Credit> credit =
+      this->_options.credit ? std::make_optional(pCreditSystem->createCredit(
+                                  this->_options.credit.value(),
+                                  pOwner->getOptions().showCreditsOnScreen))
+                            : std::nullopt;
+
+  const WebMercatorProjection projection(this->_options.ellipsoid);
+  const CesiumGeometry::Rectangle coverageRectangle =
+      WebMercatorProjection::computeMaximumProjectedRectangle(
+          this->_options.ellipsoid);
+  const QuadtreeTilingScheme tilingScheme(coverageRectangle, 1, 1);
+  const uint32_t maximumRasterizedLevel = std::max(
+      this->_options.maximumRasterizedLevel.value_or(
+          this->_options.maximumLevel + 5),
+      this->_options.maximumLevel);
+
+  return asyncSystem
+      .createResolvedFuture<RasterOverlay::CreateTileProviderResult>(
+          new VectorTileRasterOverlayTileProvider(
+              pOwner,
+              asyncSystem,
+              pAssetAccessor,
+              credit,
+              pPrepareRendererResources,
+              pLogger,
+              projection,
+              tilingScheme,
+              coverageRectangle,
+              this->_url,
+              this->_headers,
+              this->_options,
+              maximumRasterizedLevel));
+}
+
+} // namespace CesiumRasterOverlays
@@ -12,6 +12,7 @@
 
 #include <tinyxml2.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <sstream>
 
@@ -44,7 +45,8 @@ public:
       uint32_t width,
       uint32_t height,
       uint32_t minimumLevel,
-      uint32_t maximumLevel)
+      uint32_t maximumLevel,
+      uint32_t metaTileSize)
       : QuadtreeRasterOverlayTileProvider(
             pOwner,
             asyncSystem,
@@ -58,7 +60,8 @@ public:
             minimumLevel,
             maximumLevel,
             width,
-            height),
+            height,
+            metaTileSize),
         _url(url),
         _headers(headers),
         _version(version),
@@ -75,10 +78,48 @@ protected:
     options.rectangle = this->getTilingScheme().tileToRectangle(tileID);
     options.moreDetailAvailable = tileID.level < this->getMaximumLevel();
 
+    std::string url = this->createGetMapUrl(
+        options.rectangle,
+        this->getWidth(),
+        this->getHeight());
+
+    return this->loadTileImageFromUrl(url, this->_headers, std::move(options));
+  }
+
+  virtual CesiumAsync::Future<LoadedRasterOverlayImage>
+  loadQuadtreeMetaTileImage(
+      const CesiumGeometry::QuadtreeTileID& firstTileID,
+      uint32_t tilesX,
+      uint32_t tilesY) const override {
+    const QuadtreeTilingScheme& tilingScheme = this->getTilingScheme();
+    const QuadtreeTileID lastTileID(
+        firstTileID.level,
+        firstTileID.x + tilesX - 1,
+        firstTileID.y + tilesY - 1);
+
+    LoadTileImageFromUrlOptions options;
+    options.rectangle =
+        tilingScheme.tileToRectangle(firstTileID)
+            .computeUnion(tilingScheme.tileToRectangle(lastTileID));
+    options.moreDetailAvailable = firstTileID.level < this->getMaximumLevel();
+
+    std::string url = this->createGetMapUrl(
+        options.rectangle,
+        tilesX * this->getWidth(),
+        tilesY * this->getHeight());
+
+    return this->loadTileImageFromUrl(url, this->_headers, std::move(options));
+  }
+
+private:
+  std::string createGetMapUrl(
+      const CesiumGeometry::Rectangle& rectangle,
+      uint32_t width,
+      uint32_t height) const {
     const CesiumGeospatial::GlobeRectangle tileRectangle =
         CesiumGeospatial::unprojectRectangleSimple(
             this->getProjection(),
-            options.rectangle);
+            rectangle);
 
     std::string queryString = "?";
 
@@ -106,21 +147,18 @@ protected:
         {"miny", radiansToDegrees(tileRectangle.getWest())},
         {"layers", this->_layers},
         {"format", this->_format},
-        {"width", std::to_string(this->getWidth())},
-        {"height", std::to_string(this->getHeight())}};
+        {"width", std::to_string(width)},
+        {"height", std::to_string(height)}};
 
-    std::string url = CesiumUtility::Uri::substituteTemplateParameters(
+    return CesiumUtility::Uri::substituteTemplateParameters(
         urlTemplate,
         [&map = urlTemplateMap](const std::string& placeholder) {
           auto it = map.find(placeholder);
           return it == map.end() ? "{" + placeholder + "}"
                                  : Uri::escape(it->second);
         });
-
-    return this->loadTileImageFromUrl(url, this->_headers, std::move(options));
   }
 
-private:
   std::string _url;
   std::vector<IAssetAccessor::THeader> _headers;
   std::string _version;
@@ -144,7 +182,8 @@ WebMapServiceRasterOverlay::~WebMapServiceRasterOverlay() {}
 static bool validateCapabilities(
     tinyxml2::XMLElement* pRoot,
     const WebMapServiceRasterOverlayOptions& options,
-    std::string& error) {
+    std::string& error,
+    int32_t& metaTileSize) {
   tinyxml2::XMLElement* pService = pRoot->FirstChildElement("Service");
   if (!pService) {
     error = "Web map service XML document does not have a Service "
@@ -175,6 +214,9 @@ static bool validateCapabilities(
             maxWidth);
         return false;
       }
+      if (optionalTileWidth > 0) {
+        metaTileSize = std::min(metaTileSize, maxWidth / optionalTileWidth);
+      }
     } catch (std::invalid_argument&) {
       error = "Invalid web map service XML document";
       return false;
@@ -197,6 +239,9 @@ static bool validateCapabilities(
             maxHeight);
         return false;
       }
+      if (optionalTileHeight > 0) {
+        metaTileSize = std::min(metaTileSize, maxHeight / optionalTileHeight);
+      }
     } catch (std::invalid_argument&) {
       error = "Invalid web map service XML document";
       return false;
@@ -319,7 +364,12 @@ WebMapServiceRasterOverlay::createTileProvider(
             }
 
             std::string validationError;
-            if (!validateCapabilities(pRoot, options, validationError)) {
+            int32_t metaTileSize = options.metaTileSize;
+            if (!validateCapabilities(
+                    pRoot,
+                    options,
+                    validationError,
+                    metaTileSize)) {
               return nonstd::make_unexpected(RasterOverlayLoadFailureDetails{
                   RasterOverlayLoadType::TileProvider,
                   std::move(pRequest),
@@ -359,7 +409,8 @@ WebMapServiceRasterOverlay::createTileProvider(
                 options.tileWidth < 1 ? 1 : uint32_t(options.tileWidth),
                 options.tileHeight < 1 ? 1 : uint32_t(options.tileHeight),
                 options.minimumLevel < 0 ? 0 : uint32_t(options.minimumLevel),
-                options.maximumLevel < 0 ? 0 : uint32_t(options.maximumLevel));
+                options.maximumLevel < 0 ? 0 : uint32_t(options.maximumLevel),
+                metaTileSize < 1 ? 1 : uint32_t(metaTileSize));
           });
 }
 
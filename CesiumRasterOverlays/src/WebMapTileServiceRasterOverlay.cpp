@@ -59,16 +59,60 @@ public:
             maximumLevel,
             width,
             height),
-        _url(url),
         _headers(headers),
         _useKVP(useKVP),
-        _format(format),
-        _layer(layer),
-        _style(style),
-        _tileMatrixSetID(_tileMatrixSetID),
-        _labels(tileMatrixLabels),
-        _staticDimensions(dimensions),
-        _subdomains(subdomains) {}
+        _labels(),
+        _subdomains(),
+        _subdomainIsDimension(false),
+        _urlTemplate(),
+        _staticValues() {
+    std::string urlTemplate = url;
+    if (useKVP) {
+      urlTemplate += url.find('?') != std::string::npos ? '&' : '?';
+      urlTemplate +=
+          "request=GetTile&version=1.0.0&service=WMTS&"
+          "format={format}&layer={layer}&style={style}&"
+          "tilematrixset={tilematrixset}&"
+          "tilematrix={tilematrix}&tilerow={tilerow}&tilecol={tilecol}";
+    }
+    this->_urlTemplate = UriTemplate(urlTemplate);
+
+    // The values that are the same for every tile are escaped only once. The
+    // parameters of the service take precedence over the dimensions.
+    if (!useKVP) {
+      this->_staticValues.insert(
+          {{"Layer", Uri::escape(layer)},
+           {"Style", Uri::escape(style)},
+           {"TileMatrixSet", Uri::escape(_tileMatrixSetID)}});
+    } else {
+      this->_staticValues.insert(
+          {{"layer", Uri::escape(layer)},
+           {"style", Uri::escape(style)},
+           {"tilematrixset", Uri::escape(_tileMatrixSetID)},
+           {"format", Uri::escape(format)}}); // !! These are query parameters
+    }
+    if (dimensions) {
+      for (const auto& [key, value] : *dimensions) {
+        this->_staticValues.emplace(key, Uri::escape(value));
+      }
+
+      // With KVP, a dimension named "s" takes precedence over the subdomains.
+      this->_subdomainIsDimension =
+          useKVP && dimensions->find("s") != dimensions->end();
+    }
+
+    if (tileMatrixLabels) {
+      this->_labels.reserve(tileMatrixLabels->size());
+      for (const std::string& label : *tileMatrixLabels) {
+        this->_labels.emplace_back(Uri::escape(label));
+      }
+    }
+
+    this->_subdomains.reserve(subdomains.size());
+    for (const std::string& subdomain : subdomains) {
+      this->_subdomains.emplace_back(Uri::escape(subdomain));
+    }
+  }
 
   virtual ~WebMapTileServiceTileProvider() {}
 
@@ -84,88 +128,41 @@ protected:
     uint32_t col = tileID.x;
     uint32_t row = (1u << level) - tileID.y - 1u;
 
-    std::map<std::string, std::string> urlTemplateMap;
-    std::string tileMatrix;
-    if (_labels && level < _labels.value().size()) {
-      tileMatrix = _labels.value()[level];
-    } else {
-      tileMatrix = std::to_string(level);
-    }
-
-    std::string queryString = "?";
-    if (this->_url.find(queryString) != std::string::npos) {
-      queryString = "&";
-    }
-    std::string urlTemplate = _url;
-
-    if (!_useKVP) {
-      urlTemplateMap.insert(
-          {{"Layer", _layer},
-           {"Style", _style},
-           {"TileMatrix", tileMatrix},
-           {"TileRow", std::to_string(row)},
-           {"TileCol", std::to_string(col)},
-           {"TileMatrixSet", _tileMatrixSetID}});
-      if (_subdomains.size() > 0) {
-        urlTemplateMap.emplace(
-            "s",
-            _subdomains[(col + row + level) % _subdomains.size()]);
-      }
-      if (_staticDimensions) {
-        urlTemplateMap.insert(
-            _staticDimensions->begin(),
-            _staticDimensions->end());
-      }
-    } else {
-      urlTemplateMap.insert(
-          {{"layer", _layer},
-           {"style", _style},
-           {"tilematrix", tileMatrix},
-           {"tilerow", std::to_string(row)},
-           {"tilecol", std::to_string(col)},
-           {"tilematrixset", _tileMatrixSetID},
-           {"format", _format}}); // !! These are query parameters
-      if (_staticDimensions) {
-        urlTemplateMap.insert(
-            _staticDimensions->begin(),
-            _staticDimensions->end());
-      }
-      if (_subdomains.size() > 0) {
-        urlTemplateMap.emplace(
-            "s",
-            _subdomains[(col + row + level) % _subdomains.size()]);
-      }
-
-      urlTemplate +=
-          queryString +
-          "request=GetTile&version=1.0.0&service=WMTS&"
-          "format={format}&layer={layer}&style={style}&"
-          "tilematrixset={tilematrixset}&"
-          "tilematrix={tilematrix}&tilerow={tilerow}&tilecol={tilecol}";
-    }
+    const bool useKVP = this->_useKVP;
+    std::string url = this->_urlTemplate.substitute(
+        [this, useKVP, level, col, row](const std::string& placeholder) {
+          if (placeholder == (useKVP ? "tilematrix" : "TileMatrix")) {
+            return level < this->_labels.size() ? this->_labels[level]
+                                                : std::to_string(level);
+          }
+          if (placeholder == (useKVP ? "tilerow" : "TileRow")) {
+            return std::to_string(row);
+          }
+          if (placeholder == (useKVP ? "tilecol" : "TileCol")) {
+            return std::to_string(col);
+          }
+          if (placeholder == "s" && !this->_subdomains.empty() &&
+              !this->_subdomainIsDimension) {
+            return this->_subdomains
+                [(col + row + level) % this->_subdomains.size()];
+          }
 
-    std::string url = CesiumUtility::Uri::substituteTemplateParameters(
-        urlTemplate,
-        [&map = urlTemplateMap](const std::string& placeholder) {
-          auto it = map.find(placeholder);
-          return it == map.end() ? "{" + placeholder + "}"
-                                 : CesiumUtility::Uri::escape(it->second);
+          auto it = this->_staticValues.find(placeholder);
+          return it == this->_staticValues.end() ? "{" + placeholder + "}"
+                                                 : it->second;
         });
 
     return this->loadTileImageFromUrl(url, this->_headers, std::move(options));
   }
 
 private:
-  std::string _url;
   std::vector<IAssetAccessor::THeader> _headers;
   bool _useKVP;
-  std::string _format;
-  std::string _layer;
-  std::string _style;
-  std::string _tileMatrixSetID;
-  std::optional<std::vector<std::string>> _labels;
-  std::optional<std::map<std::string, std::string>> _staticDimensions;
+  std::vector<std::string> _labels;
   std::vector<std::string> _subdomains;
+  bool _subdomainIsDimension;
+  UriTemplate _urlTemplate;
+  std::map<std::string, std::string> _staticValues;
 };
 
 WebMapTileServiceRasterOverlay::WebMapTileServiceRasterOverlay(
@@ -0,0 +1,182 @@
+#include "ImageBlockCompression.h"
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace CesiumRasterOverlays;
+
+namespace {
+ImageCesium createImage(int32_t width, int32_t height, bool transparent) {
+  ImageCesium image;
+  image.width = width;
+  image.height = height;
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(size_t(width * height * 4));
+  for (int32_t y = 0; y < height; ++y) {
+    for (int32_t x = 0; x < width; ++x) {
+      std::byte* pPixel = &image.pixelData[size_t((y * width + x) * 4)];
+      // The colors of each block lie on a line, as BC1 expects.
+      const int32_t value = (x + y) * 8;
+      pPixel[0] = std::byte(value);
+      pPixel[1] = std::byte(255 - value);
+      pPixel[2] = std::byte(128);
+      pPixel[3] = std::byte(transparent ? value : 255);
+    }
+  }
+  return image;
+}
+
+std::array<int32_t, 3> fromRgb565(int32_t color) {
+  const int32_t r = (color >> 11) & 31;
+  const int32_t g = (color >> 5) & 63;
+  const int32_t b = color & 31;
+  return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+// Decodes a pixel of a block with the four-color mode of BC1.
+std::array<int32_t, 3> decodeColor(const std::byte* pBlock, size_t i) {
+  const int32_t color0 = int32_t(pBlock[0]) | (int32_t(pBlock[1]) << 8);
+  const int32_t color1 = int32_t(pBlock[2]) | (int32_t(pBlock[3]) << 8);
+  const uint32_t indices = uint32_t(pBlock[4]) | (uint32_t(pBlock[5]) << 8) |
+                           (uint32_t(pBlock[6]) << 16) |
+                           (uint32_t(pBlock[7]) << 24);
+  const std::array<int32_t, 3> c0 = fromRgb565(color0);
+  const std::array<int32_t, 3> c1 = fromRgb565(color1);
+  const uint32_t index = (indices >> (2 * i)) & 3;
+  std::array<int32_t, 3> result;
+  for (size_t c = 0; c < 3; ++c) {
+    const int32_t weights[] = {3, 0, 2, 1};
+    result[c] =
+        (weights[index] * c0[c] + (3 - weights[index]) * c1[c] + 1) / 3;
+  }
+  return result;
+}
+
+int32_t decodeAlpha(const std::byte* pBlock, size_t i) {
+  const int32_t alpha0 = int32_t(pBlock[0]);
+  const int32_t alpha1 = int32_t(pBlock[1]);
+  uint64_t indices = 0;
+  for (size_t b = 0; b < 6; ++b) {
+    indices |= uint64_t(pBlock[2 + b]) << (8 * b);
+  }
+  const int32_t index = int32_t((indices >> (3 * i)) & 7);
+  if (index == 0) {
+    return alpha0;
+  }
+  if (index == 1) {
+    return alpha1;
+  }
+  return ((8 - index) * alpha0 + (index - 1) * alpha1) / 7;
+}
+} // namespace
+
+TEST_CASE("ImageBlockCompression") {
+  SupportedGpuCompressedPixelFormats supported;
+  supported.BC1_RGB = true;
+  supported.BC3_RGBA = true;
+
+  SECTION("selects a format the image can be compressed to") {
+    const ImageCesium opaque = createImage(16, 8, false);
+    const ImageCesium transparent = createImage(16, 8, true);
+    CHECK(
+        ImageBlockCompression::selectFormat(opaque, supported) ==
+        GpuCompressedPixelFormat::BC1_RGB);
+    CHECK(
+        ImageBlockCompression::selectFormat(transparent, supported) ==
+        GpuCompressedPixelFormat::BC3_RGBA);
+
+    SupportedGpuCompressedPixelFormats onlyBC1;
+    onlyBC1.BC1_RGB = true;
+    CHECK(
+        ImageBlockCompression::selectFormat(transparent, onlyBC1) ==
+        GpuCompressedPixelFormat::NONE);
+    CHECK(
+        ImageBlockCompression::selectFormat(
+            opaque,
+            SupportedGpuCompressedPixelFormats()) ==
+        GpuCompressedPixelFormat::NONE);
+
+    // The width and height must be multiples of the size of a block.
+    CHECK(
+        ImageBlockCompression::selectFormat(
+            createImage(18, 8, false),
+            supported) == GpuCompressedPixelFormat::NONE);
+  }
+
+  SECTION("compresses an opaque image and its mipmaps to BC1") {
+    const ImageCesium original = createImage(16, 8, false);
+    ImageCesium image = original;
+    REQUIRE(ImageBlockCompression::compress(
+        image,
+        GpuCompressedPixelFormat::BC1_RGB));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::BC1_RGB);
+
+    // 16x8, 8x4, 4x2, 2x1 and 1x1, with 8 bytes per block of 4x4 pixels.
+    const std::vector<size_t> blocks{8, 2, 1, 1, 1};
+    REQUIRE(image.mipPositions.size() == blocks.size());
+    size_t byteOffset = 0;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+      CHECK(image.mipPositions[i].byteOffset == byteOffset);
+      CHECK(image.mipPositions[i].byteSize == blocks[i] * 8);
+      byteOffset += blocks[i] * 8;
+    }
+    CHECK(image.pixelData.size() == byteOffset);
+
+    for (int32_t y = 0; y < original.height; ++y) {
+      for (int32_t x = 0; x < original.width; ++x) {
+        const std::byte* pBlock =
+            &image.pixelData[size_t((y / 4) * 4 + x / 4) * 8];
+        const std::array<int32_t, 3> decoded =
+            decodeColor(pBlock, size_t((y % 4) * 4 + x % 4));
+        const std::byte* pPixel =
+            &original.pixelData[size_t((y * original.width + x) * 4)];
+        for (size_t c = 0; c < 3; ++c) {
+          CHECK(std::abs(decoded[c] - int32_t(pPixel[c])) <= 16);
+        }
+      }
+    }
+  }
+
+  SECTION("compresses a transparent image to BC3") {
+    const ImageCesium original = createImage(8, 8, true);
+    ImageCesium image = original;
+    REQUIRE(ImageBlockCompression::compress(
+        image,
+        GpuCompressedPixelFormat::BC3_RGBA));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::BC3_RGBA);
+    REQUIRE(!image.mipPositions.empty());
+    CHECK(image.mipPositions[0].byteSize == 4 * 16);
+
+    for (int32_t y = 0; y < original.height; ++y) {
+      for (int32_t x = 0; x < original.width; ++x) {
+        const std::byte* pBlock =
+            &image.pixelData[size_t((y / 4) * 2 + x / 4) * 16];
+        const size_t i = size_t((y % 4) * 4 + x % 4);
+        const std::byte* pPixel =
+            &original.pixelData[size_t((y * original.width + x) * 4)];
+        CHECK(std::abs(decodeAlpha(pBlock, i) - int32_t(pPixel[3])) <= 6);
+        const std::array<int32_t, 3> decoded = decodeColor(pBlock + 8, i);
+        for (size_t c = 0; c < 3; ++c) {
+          CHECK(std::abs(decoded[c] - int32_t(pPixel[c])) <= 16);
+        }
+      }
+    }
+  }
+
+  SECTION("leaves images in formats it can't encode as they are") {
+    ImageCesium image = createImage(8, 8, false);
+    const CesiumUtility::ByteVector pixelData = image.pixelData;
+    CHECK(!ImageBlockCompression::compress(
+        image,
+        GpuCompressedPixelFormat::ASTC_4x4_RGBA));
+    CHECK(image.compressedPixelFormat == GpuCompressedPixelFormat::NONE);
+    CHECK(image.pixelData == pixelData);
+  }
+}
@@ -2,11 +2,14 @@
 #include "CesiumRasterOverlays/RasterOverlay.h"
 #include "CesiumRasterOverlays/RasterOverlayTile.h"
 
+#include <CesiumAsync/TaskPriority.h>
 #include <CesiumGeospatial/WebMercatorProjection.h>
 #include <CesiumNativeTests/SimpleAssetAccessor.h>
 
 #include <catch2/catch.hpp>
 
+#include <atomic>
+
 using namespace CesiumAsync;
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
@@ -33,7 +36,8 @@ public:
       uint32_t minimumLevel,
       uint32_t maximumLevel,
       uint32_t imageWidth,
-      uint32_t imageHeight) noexcept
+      uint32_t imageHeight,
+      uint32_t metaTileSize) noexcept
       : QuadtreeRasterOverlayTileProvider(
             pOwner,
             asyncSystem,
@@ -47,13 +51,21 @@ public:
             minimumLevel,
             maximumLevel,
             imageWidth,
-            imageHeight) {}
+            imageHeight,
+            metaTileSize) {}
 
   // The tiles that will return an error from loadQuadtreeTileImage.
   std::vector<QuadtreeTileID> errorTiles;
 
+  // The number of calls to loadQuadtreeTileImage and
+  // loadQuadtreeMetaTileImage.
+  mutable std::atomic<int32_t> tileLoads{0};
+  mutable std::atomic<int32_t> metaTileLoads{0};
+
   virtual CesiumAsync::Future<LoadedRasterOverlayImage>
   loadQuadtreeTileImage(const QuadtreeTileID& tileID) const {
+    ++this->tileLoads;
+
     LoadedRasterOverlayImage result;
     result.rectangle = this->getTilingScheme().tileToRectangle(tileID);
 
@@ -75,6 +87,36 @@ public:
 
     return this->getAsyncSystem().createResolvedFuture(std::move(result));
   }
+
+  virtual CesiumAsync::Future<LoadedRasterOverlayImage>
+  loadQuadtreeMetaTileImage(
+      const QuadtreeTileID& firstTileID,
+      uint32_t tilesX,
+      uint32_t tilesY) const {
+    ++this->metaTileLoads;
+
+    const QuadtreeTileID lastTileID(
+        firstTileID.level,
+        firstTileID.x + tilesX - 1,
+        firstTileID.y + tilesY - 1);
+
+    // Return an image of all the tiles where every component of every pixel
+    // is equal to the tile level.
+    LoadedRasterOverlayImage result;
+    result.rectangle =
+        this->getTilingScheme().tileToRectangle(firstTileID).computeUnion(
+            this->getTilingScheme().tileToRectangle(lastTileID));
+    result.image.emplace();
+    result.image->width = int32_t(tilesX * this->getWidth());
+    result.image->height = int32_t(tilesY * this->getHeight());
+    result.image->bytesPerChannel = 1;
+    result.image->channels = 4;
+    result.image->pixelData.resize(
+        size_t(result.image->width * result.image->height * 4),
+        std::byte(firstTileID.level));
+
+    return this->getAsyncSystem().createResolvedFuture(std::move(result));
+  }
 };
 
 class TestRasterOverlay : public RasterOverlay {
@@ -84,6 +126,8 @@ public:
       const RasterOverlayOptions& options = RasterOverlayOptions())
       : RasterOverlay(name, options) {}
 
+  uint32_t metaTileSize = 1;
+
   virtual CesiumAsync::Future<CreateTileProviderResult> createTileProvider(
       const CesiumAsync::AsyncSystem& asyncSystem,
       const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
@@ -114,7 +158,8 @@ public:
             0,
             10,
             256,
-            256));
+            256,
+            this->metaTileSize));
   }
 };
 
@@ -240,4 +285,140 @@ TEST_CASE("QuadtreeRasterOverlayTileProvider getTile") {
         image.pixelData.end(),
         [](std::byte b) { return b == std::byte(8); }));
   }
+
+  SECTION("loads queued tiles in order of priority") {
+    pOverlay->getOptions().maximumSimultaneousTileLoads = 2;
+
+    Rectangle rectangle =
+        GeographicProjection::computeMaximumProjectedRectangle();
+    std::vector<IntrusivePointer<RasterOverlayTile>> tiles;
+    for (size_t i = 0; i < 4; ++i) {
+      tiles.emplace_back(pProvider->getTile(rectangle, glm::dvec2(256)));
+    }
+
+    pProvider->queueTileLoad(*tiles[0], TaskPriority{0, 3.0});
+    pProvider->queueTileLoad(*tiles[1], TaskPriority{0, 1.0});
+    pProvider->queueTileLoad(*tiles[2], TaskPriority{1, 5.0});
+    pProvider->queueTileLoad(*tiles[3], TaskPriority{0, 2.0});
+    pProvider->loadQueuedTiles();
+
+    // A higher group comes first, then the lower values within a group.
+    CHECK(tiles[2]->getState() == RasterOverlayTile::LoadState::Loading);
+    CHECK(tiles[1]->getState() == RasterOverlayTile::LoadState::Loading);
+    CHECK(tiles[3]->getState() == RasterOverlayTile::LoadState::Unloaded);
+    CHECK(tiles[0]->getState() == RasterOverlayTile::LoadState::Unloaded);
+
+    while (pProvider->getNumberOfTilesLoading() > 0) {
+      asyncSystem.dispatchMainThreadTasks();
+    }
+
+    // The loads that didn't start were dropped from the queue.
+    pProvider->loadQueuedTiles();
+    CHECK(tiles[3]->getState() == RasterOverlayTile::LoadState::Unloaded);
+    CHECK(tiles[0]->getState() == RasterOverlayTile::LoadState::Unloaded);
+  }
+}
+
+TEST_CASE("QuadtreeRasterOverlayTileProvider loads meta-tiles") {
+  auto pTaskProcessor = std::make_shared<MockTaskProcessor>();
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>());
+
+  AsyncSystem asyncSystem(pTaskProcessor);
+  IntrusivePointer<TestRasterOverlay> pOverlay = new TestRasterOverlay("Test");
+  pOverlay->metaTileSize = 2;
+
+  IntrusivePointer<RasterOverlayTileProvider> pProvider = nullptr;
+
+  pOverlay
+      ->createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          nullptr,
+          nullptr,
+          spdlog::default_logger(),
+          nullptr)
+      .thenInMainThread(
+          [&pProvider](RasterOverlay::CreateTileProviderResult&& created) {
+            CHECK(created);
+            pProvider = *created;
+          });
+
+  asyncSystem.dispatchMainThreadTasks();
+
+  REQUIRE(pProvider);
+  TestTileProvider* pTestProvider =
+      static_cast<TestTileProvider*>(pProvider.get());
+  CHECK(pTestProvider->getMetaTileSize() == 2);
+
+  // Select a rectangle slightly inside the four tiles of a meta-tile at level
+  // 8.
+  const uint32_t expectedLevel = 8;
+  const QuadtreeTilingScheme& tilingScheme = pTestProvider->getTilingScheme();
+  std::optional<QuadtreeTileID> centerTileID =
+      tilingScheme.positionToTile(glm::dvec2(0.1, 0.2), expectedLevel);
+  REQUIRE(centerTileID);
+
+  const QuadtreeTileID firstTileID(
+      expectedLevel,
+      centerTileID->x / 2 * 2,
+      centerTileID->y / 2 * 2);
+  const QuadtreeTileID lastTileID(
+      expectedLevel,
+      firstTileID.x + 1,
+      firstTileID.y + 1);
+  const Rectangle firstRectangle = tilingScheme.tileToRectangle(firstTileID);
+  const Rectangle lastRectangle = tilingScheme.tileToRectangle(lastTileID);
+  const double marginX = firstRectangle.computeWidth() * 0.01;
+  const double marginY = firstRectangle.computeHeight() * 0.01;
+  const Rectangle tileRectangle(
+      firstRectangle.minimumX + marginX,
+      firstRectangle.minimumY + marginY,
+      lastRectangle.maximumX - marginX,
+      lastRectangle.maximumY - marginY);
+
+  const uint32_t rasterSSE = 2;
+  IntrusivePointer<RasterOverlayTile> pTile = pProvider->getTile(
+      tileRectangle,
+      glm::dvec2(
+          pTestProvider->getWidth() * 2 * rasterSSE,
+          pTestProvider->getHeight() * 2 * rasterSSE));
+  pProvider->loadTile(*pTile);
+
+  while (pTile->getState() != RasterOverlayTile::LoadState::Loaded) {
+    asyncSystem.dispatchMainThreadTasks();
+  }
+
+  // All four tiles came from one image.
+  CHECK(pTestProvider->metaTileLoads == 1);
+  CHECK(pTestProvider->tileLoads == 0);
+
+  const ImageCesium& image = pTile->getImage();
+  CHECK(image.width > 0);
+  CHECK(image.height > 0);
+  CHECK(std::all_of(
+      image.pixelData.begin(),
+      image.pixelData.end(),
+      [](std::byte b) { return b == std::byte(8); }));
+
+  SECTION("caches the tiles of a meta-tile") {
+    // A raster tile over a single tile of the meta-tile doesn't load it again.
+    IntrusivePointer<RasterOverlayTile> pSingleTile = pProvider->getTile(
+        Rectangle(
+            lastRectangle.minimumX + marginX,
+            lastRectangle.minimumY + marginY,
+            lastRectangle.maximumX - marginX,
+            lastRectangle.maximumY - marginY),
+        glm::dvec2(
+            pTestProvider->getWidth() * rasterSSE,
+            pTestProvider->getHeight() * rasterSSE));
+    pProvider->loadTile(*pSingleTile);
+
+    while (pSingleTile->getState() != RasterOverlayTile::LoadState::Loaded) {
+      asyncSystem.dispatchMainThreadTasks();
+    }
+
+    CHECK(pTestProvider->metaTileLoads == 1);
+    CHECK(pTestProvider->tileLoads == 0);
+  }
 }
@@ -0,0 +1,155 @@
+#include <CesiumRasterOverlays/IPrepareRasterOverlayRendererResources.h>
+#include <CesiumRasterOverlays/RasterOverlayTextureAtlas.h>
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+using namespace CesiumRasterOverlays;
+
+namespace {
+class MockPrepareRasterOverlayRendererResources
+    : public IPrepareRasterOverlayRendererResources {
+public:
+  void* prepareRasterInLoadThread(
+      CesiumGltf::ImageCesium& /*image*/,
+      const std::any& /*rendererOptions*/) override {
+    return nullptr;
+  }
+
+  void* prepareRasterInMainThread(
+      RasterOverlayTile& /*rasterTile*/,
+      void* /*pLoadThreadResult*/) override {
+    return nullptr;
+  }
+
+  void freeRaster(
+      const RasterOverlayTile& /*rasterTile*/,
+      void* /*pLoadThreadResult*/,
+      void* /*pMainThreadResult*/) noexcept override {}
+
+  void* createRasterAtlasPage(
+      int32_t width,
+      int32_t height,
+      int32_t /*channels*/,
+      int32_t /*bytesPerChannel*/,
+      const std::any& /*rendererOptions*/) override {
+    CHECK(width == height);
+    ++this->pagesCreated;
+    return new int(this->pagesCreated);
+  }
+
+  void freeRasterAtlasPage(void* pAtlasPage) noexcept override {
+    ++this->pagesFreed;
+    delete static_cast<int*>(pAtlasPage);
+  }
+
+  int pagesCreated = 0;
+  int pagesFreed = 0;
+};
+
+bool overlap(
+    const RasterOverlayAtlasRegion& a,
+    const RasterOverlayAtlasRegion& b) {
+  // Include the border of one pixel around each region.
+  return a.pageIndex == b.pageIndex && a.x - 1 < b.x + b.width + 1 &&
+         b.x - 1 < a.x + a.width + 1 && a.y - 1 < b.y + b.height + 1 &&
+         b.y - 1 < a.y + a.height + 1;
+}
+} // namespace
+
+TEST_CASE("RasterOverlayTextureAtlas") {
+  auto pResources =
+      std::make_shared<MockPrepareRasterOverlayRendererResources>();
+  std::optional<RasterOverlayTextureAtlas> atlas;
+  atlas.emplace(1000, pResources, std::any());
+  REQUIRE(atlas->getPageSize() == 1024);
+
+  SECTION("packs images without overlapping their borders") {
+    std::vector<RasterOverlayAtlasRegion> regions;
+    for (int32_t i = 0; i < 16; ++i) {
+      std::optional<RasterOverlayAtlasRegion> region =
+          atlas->allocate(200 + i, 250 - i, 4, 1);
+      REQUIRE(region);
+      CHECK(region->width == 200 + i);
+      CHECK(region->height == 250 - i);
+      CHECK(region->x >= 1);
+      CHECK(region->y >= 1);
+      CHECK(region->x + region->width + 1 <= 1024);
+      CHECK(region->y + region->height + 1 <= 1024);
+      for (const RasterOverlayAtlasRegion& other : regions) {
+        CHECK(!overlap(*region, other));
+      }
+      regions.emplace_back(*region);
+    }
+
+    // 16 blocks of 256x256 fill one page.
+    CHECK(pResources->pagesCreated == 1);
+    CHECK(atlas->getPageCount() == 1);
+
+    const RasterOverlayAtlasRegion& region = regions[5];
+    CHECK(region.textureCoordinates.minimumX == region.x / 1024.0);
+    CHECK(region.textureCoordinates.minimumY == region.y / 1024.0);
+    CHECK(
+        region.textureCoordinates.computeWidth() ==
+        Approx(region.width / 1024.0));
+    CHECK(
+        region.textureCoordinates.computeHeight() ==
+        Approx(region.height / 1024.0));
+
+    std::optional<RasterOverlayAtlasRegion> next =
+        atlas->allocate(10, 10, 4, 1);
+    REQUIRE(next);
+    CHECK(next->pageIndex == 1);
+    CHECK(pResources->pagesCreated == 2);
+    CHECK(atlas->getPageRendererResources(1) != nullptr);
+
+    // A freed block is reused.
+    atlas->free(regions[3]);
+    std::optional<RasterOverlayAtlasRegion> reused =
+        atlas->allocate(254, 100, 4, 1);
+    REQUIRE(reused);
+    CHECK(reused->pageIndex == regions[3].pageIndex);
+    CHECK(reused->x == regions[3].x);
+    CHECK(reused->y == regions[3].y);
+    regions[3] = *reused;
+
+    // Freeing all of the regions of a page frees the page.
+    for (const RasterOverlayAtlasRegion& freed : regions) {
+      atlas->free(freed);
+    }
+    CHECK(pResources->pagesFreed == 1);
+    CHECK(atlas->getPageCount() == 1);
+    CHECK(atlas->getPageRendererResources(0) == nullptr);
+
+    atlas->free(*next);
+    CHECK(pResources->pagesFreed == 2);
+    CHECK(atlas->getPageCount() == 0);
+  }
+
+  SECTION("uses separate pages for separate pixel formats") {
+    std::optional<RasterOverlayAtlasRegion> rgba =
+        atlas->allocate(64, 64, 4, 1);
+    std::optional<RasterOverlayAtlasRegion> rgb = atlas->allocate(64, 64, 3, 1);
+    REQUIRE(rgba);
+    REQUIRE(rgb);
+    CHECK(rgba->pageIndex != rgb->pageIndex);
+    CHECK(atlas->getPageCount() == 2);
+  }
+
+  SECTION("doesn't pack images that are too large") {
+    CHECK(!atlas->allocate(1023, 16, 4, 1));
+    CHECK(!atlas->allocate(0, 16, 4, 1));
+    CHECK(atlas->allocate(1022, 16, 4, 1));
+  }
+
+  SECTION("frees the remaining pages when it is destroyed") {
+    CHECK(atlas->allocate(64, 64, 4, 1));
+    CHECK(atlas->allocate(64, 64, 1, 1));
+    atlas.reset();
+    CHECK(pResources->pagesCreated == 2);
+    CHECK(pResources->pagesFreed == 2);
+  }
+}
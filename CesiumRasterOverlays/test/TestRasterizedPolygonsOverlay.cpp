@@ -0,0 +1,186 @@
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumGeometry/IntersectionTests.h>
+#include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/GeographicProjection.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumRasterOverlays/RasterOverlayTile.h>
+#include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
+#include <CesiumRasterOverlays/RasterizedPolygonsOverlay.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumNativeTests;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace {
+class MockTaskProcessor : public ITaskProcessor {
+public:
+  virtual void startTask(std::function<void()> f) { std::thread(f).detach(); }
+};
+
+CartographicPolygon createPolygon(const std::vector<glm::dvec2>& degrees) {
+  std::vector<glm::dvec2> radians;
+  for (const glm::dvec2& vertex : degrees) {
+    radians.emplace_back(
+        Math::degreesToRadians(vertex.x),
+        Math::degreesToRadians(vertex.y));
+  }
+  return CartographicPolygon(radians);
+}
+
+// Whether the center of a pixel of a tile is inside any of the polygons.
+bool isPixelInside(
+    const GlobeRectangle& rectangle,
+    const ImageCesium& image,
+    int32_t x,
+    int32_t y,
+    const std::vector<CartographicPolygon>& polygons) {
+  const glm::dvec2 center(
+      rectangle.getWest() + rectangle.computeWidth() * (double(x) + 0.5) /
+                                double(image.width),
+      rectangle.getSouth() +
+          rectangle.computeHeight() *
+              (1.0 - (double(y) + 0.5) / double(image.height)));
+  for (const CartographicPolygon& polygon : polygons) {
+    const std::vector<glm::dvec2>& vertices = polygon.getVertices();
+    const std::vector<uint32_t>& indices = polygon.getIndices();
+    for (size_t i = 2; i < indices.size(); i += 3) {
+      if (IntersectionTests::pointInTriangle(
+              center,
+              vertices[indices[i - 2]],
+              vertices[indices[i - 1]],
+              vertices[indices[i]])) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+} // namespace
+
+TEST_CASE("RasterizedPolygonsOverlay") {
+  auto pTaskProcessor = std::make_shared<MockTaskProcessor>();
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>());
+  AsyncSystem asyncSystem(pTaskProcessor);
+
+  // A concave polygon and a triangle, far from each other.
+  const std::vector<CartographicPolygon> polygons{
+      createPolygon(
+          {glm::dvec2(10.0, 10.0),
+           glm::dvec2(30.0, 12.0),
+           glm::dvec2(20.0, 20.0),
+           glm::dvec2(28.0, 31.0),
+           glm::dvec2(11.0, 27.0)}),
+      createPolygon(
+          {glm::dvec2(-120.0, -40.0),
+           glm::dvec2(-100.0, -45.0),
+           glm::dvec2(-110.0, -20.0)})};
+
+  const bool invertSelection = GENERATE(false, true);
+  const std::byte insideColor = invertSelection ? std::byte(0) : std::byte(255);
+  const std::byte outsideColor =
+      invertSelection ? std::byte(255) : std::byte(0);
+
+  IntrusivePointer<RasterizedPolygonsOverlay> pOverlay =
+      new RasterizedPolygonsOverlay(
+          "Test",
+          polygons,
+          invertSelection,
+          Ellipsoid::WGS84,
+          GeographicProjection());
+
+  IntrusivePointer<RasterOverlayTileProvider> pProvider = nullptr;
+  pOverlay
+      ->createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          nullptr,
+          nullptr,
+          spdlog::default_logger(),
+          nullptr)
+      .thenInMainThread(
+          [&pProvider](RasterOverlay::CreateTileProviderResult&& created) {
+            CHECK(created);
+            pProvider = *created;
+          });
+  asyncSystem.dispatchMainThreadTasks();
+  REQUIRE(pProvider);
+
+  const auto loadTile = [&](const GlobeRectangle& rectangle) {
+    IntrusivePointer<RasterOverlayTile> pTile = pProvider->getTile(
+        projectRectangleSimple(pProvider->getProjection(), rectangle),
+        glm::dvec2(128.0));
+    pProvider->loadTile(*pTile);
+    while (pTile->getState() != RasterOverlayTile::LoadState::Loaded) {
+      asyncSystem.dispatchMainThreadTasks();
+    }
+    return pTile;
+  };
+
+  SECTION("fills the pixels whose centers are inside the polygons") {
+    const GlobeRectangle rectangle =
+        GlobeRectangle::fromDegrees(-130.0, -50.0, 40.0, 40.0);
+    IntrusivePointer<RasterOverlayTile> pTile = loadTile(rectangle);
+    const ImageCesium& image = pTile->getImage();
+    REQUIRE(image.width == 64);
+    REQUIRE(image.height == 64);
+    CHECK(
+        pTile->isMoreDetailAvailable() ==
+        RasterOverlayTile::MoreDetailAvailable::Yes);
+
+    size_t insidePixels = 0;
+    for (int32_t y = 0; y < image.height; ++y) {
+      for (int32_t x = 0; x < image.width; ++x) {
+        const std::byte expected =
+            isPixelInside(rectangle, image, x, y, polygons) ? insideColor
+                                                            : outsideColor;
+        const std::byte actual = image.pixelData[size_t(y * image.width + x)];
+        CHECK(actual == expected);
+        if (actual == insideColor) {
+          ++insidePixels;
+        }
+      }
+    }
+
+    // Both polygons were drawn.
+    CHECK(insidePixels > 50);
+  }
+
+  SECTION("uses a single pixel for a tile inside a polygon") {
+    IntrusivePointer<RasterOverlayTile> pTile =
+        loadTile(GlobeRectangle::fromDegrees(14.0, 14.0, 16.0, 16.0));
+    const ImageCesium& image = pTile->getImage();
+    REQUIRE(image.width == 1);
+    REQUIRE(image.height == 1);
+    CHECK(image.pixelData[0] == insideColor);
+    CHECK(
+        pTile->isMoreDetailAvailable() ==
+        RasterOverlayTile::MoreDetailAvailable::No);
+  }
+
+  SECTION("uses a single pixel for a tile outside all polygons") {
+    IntrusivePointer<RasterOverlayTile> pTile =
+        loadTile(GlobeRectangle::fromDegrees(60.0, -30.0, 70.0, -20.0));
+    const ImageCesium& image = pTile->getImage();
+    REQUIRE(image.width == 1);
+    REQUIRE(image.height == 1);
+    CHECK(image.pixelData[0] == outsideColor);
+    CHECK(
+        pTile->isMoreDetailAvailable() ==
+        RasterOverlayTile::MoreDetailAvailable::No);
+  }
+}
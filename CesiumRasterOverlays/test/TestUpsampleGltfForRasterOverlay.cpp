@@ -10,6 +10,8 @@
 #include <glm/trigonometric.hpp>
 
 #include <cstring>
+#include <optional>
+#include <string>
 #include <vector>
 
 using namespace CesiumUtility;
@@ -689,6 +691,54 @@ TEST_CASE("upsampleGltfForRasterOverlay with UNSIGNED_SHORT indices") {
           skirtHeight * 0.5);
     }
 
+    SECTION("Check bottom left edges without baked skirts") {
+      skirtMeshMetadata.hasBakedSkirts = false;
+      primitive.extras = SkirtMeshMetadata::createGltfExtras(skirtMeshMetadata);
+
+      Model upsampledModel =
+          *RasterOverlayUtilities::upsampleGltfForRasterOverlays(
+              model,
+              lowerLeft,
+              false);
+
+      REQUIRE(upsampledModel.meshes.size() == 1);
+      const Mesh& upsampledMesh = upsampledModel.meshes.back();
+
+      REQUIRE(upsampledMesh.primitives.size() == 1);
+      const MeshPrimitive& upsampledPrimitive = upsampledMesh.primitives.back();
+
+      // only the clipped vertices, without any skirt
+      AccessorView<glm::vec3> upsampledPosition(
+          upsampledModel,
+          upsampledPrimitive.attributes.at("POSITION"));
+      REQUIRE(upsampledPosition.size() == 7);
+
+      std::optional<SkirtMeshMetadata> upsampledSkirtMeshMetadata =
+          SkirtMeshMetadata::parseFromGltfExtras(upsampledPrimitive.extras);
+      REQUIRE(upsampledSkirtMeshMetadata);
+      REQUIRE(!upsampledSkirtMeshMetadata->hasBakedSkirts);
+      REQUIRE(
+          upsampledSkirtMeshMetadata->westEdgeIndices ==
+          std::vector<uint32_t>{0, 3});
+      REQUIRE(
+          upsampledSkirtMeshMetadata->southEdgeIndices ==
+          std::vector<uint32_t>{1, 4, 0});
+      REQUIRE(
+          upsampledSkirtMeshMetadata->eastEdgeIndices ==
+          std::vector<uint32_t>{5, 1, 4});
+      REQUIRE(
+          upsampledSkirtMeshMetadata->northEdgeIndices ==
+          std::vector<uint32_t>{3, 2, 6, 5});
+      REQUIRE(Math::equalsEpsilon(
+          upsampledSkirtMeshMetadata->skirtWestHeight,
+          skirtHeight,
+          Math::Epsilon7));
+      REQUIRE(Math::equalsEpsilon(
+          upsampledSkirtMeshMetadata->skirtEastHeight,
+          skirtHeight * 0.5,
+          Math::Epsilon7));
+    }
+
     SECTION("Check upper left skirt") {
       Model upsampledModel =
           *RasterOverlayUtilities::upsampleGltfForRasterOverlays(
@@ -1273,3 +1323,116 @@ TEST_CASE("upsampleGltfForRasterOverlay with UNSIGNED_BYTE indices") {
           (upsampledPosition[4] + positions[1]) * 0.5f,
           glm::vec3(static_cast<float>(Math::Epsilon7))) == glm::bvec3(true));
 }
+
+TEST_CASE("upsampleGltfForRasterOverlay keeps triangles inside a child whole") {
+  // A 4x4 grid of quads, none of which crosses the middle of the tile.
+  constexpr uint32_t cells = 4;
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec2> uvs;
+  for (uint32_t y = 0; y <= cells; ++y) {
+    for (uint32_t x = 0; x <= cells; ++x) {
+      const glm::vec2 uv(float(x) / float(cells), float(y) / float(cells));
+      positions.emplace_back(uv, 0.0f);
+      uvs.emplace_back(uv);
+    }
+  }
+
+  std::vector<uint32_t> indices;
+  for (uint32_t y = 0; y < cells; ++y) {
+    for (uint32_t x = 0; x < cells; ++x) {
+      const uint32_t i = y * (cells + 1) + x;
+      indices.insert(
+          indices.end(),
+          {i, i + 1, i + cells + 1, i + 1, i + cells + 2, i + cells + 1});
+    }
+  }
+
+  Model model;
+  Buffer& buffer = model.buffers.emplace_back();
+  const size_t positionsSize = positions.size() * sizeof(glm::vec3);
+  const size_t uvsSize = uvs.size() * sizeof(glm::vec2);
+  const size_t indicesSize = indices.size() * sizeof(uint32_t);
+  buffer.cesium.data.resize(positionsSize + uvsSize + indicesSize);
+  std::memcpy(buffer.cesium.data.data(), positions.data(), positionsSize);
+  std::memcpy(buffer.cesium.data.data() + positionsSize, uvs.data(), uvsSize);
+  std::memcpy(
+      buffer.cesium.data.data() + positionsSize + uvsSize,
+      indices.data(),
+      indicesSize);
+  buffer.byteLength = int64_t(buffer.cesium.data.size());
+
+  const auto addAccessor = [&model](
+                               size_t offset,
+                               size_t size,
+                               int64_t count,
+                               int32_t componentType,
+                               const std::string& type) {
+    BufferView& bufferView = model.bufferViews.emplace_back();
+    bufferView.buffer = 0;
+    bufferView.byteOffset = int64_t(offset);
+    bufferView.byteLength = int64_t(size);
+
+    Accessor& accessor = model.accessors.emplace_back();
+    accessor.bufferView = int32_t(model.bufferViews.size() - 1);
+    accessor.count = count;
+    accessor.componentType = componentType;
+    accessor.type = type;
+    return int32_t(model.accessors.size() - 1);
+  };
+
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = addAccessor(
+      0,
+      positionsSize,
+      int64_t(positions.size()),
+      Accessor::ComponentType::FLOAT,
+      Accessor::Type::VEC3);
+  primitive.attributes["_CESIUMOVERLAY_0"] = addAccessor(
+      positionsSize,
+      uvsSize,
+      int64_t(uvs.size()),
+      Accessor::ComponentType::FLOAT,
+      Accessor::Type::VEC2);
+  primitive.indices = addAccessor(
+      positionsSize + uvsSize,
+      indicesSize,
+      int64_t(indices.size()),
+      Accessor::ComponentType::UNSIGNED_INT,
+      Accessor::Type::SCALAR);
+  model.nodes.emplace_back().mesh = 0;
+
+  for (uint32_t childX = 0; childX < 2; ++childX) {
+    for (uint32_t childY = 0; childY < 2; ++childY) {
+      const CesiumGeometry::UpsampledQuadtreeNode childID{
+          CesiumGeometry::QuadtreeTileID(1, childX, childY)};
+      std::optional<Model> upsampledModel =
+          RasterOverlayUtilities::upsampleGltfForRasterOverlays(
+              model,
+              childID);
+      REQUIRE(upsampledModel);
+
+      const MeshPrimitive& upsampledPrimitive =
+          upsampledModel->meshes[0].primitives[0];
+      AccessorView<glm::vec3> upsampledPositions(
+          *upsampledModel,
+          upsampledPrimitive.attributes.at("POSITION"));
+      AccessorView<uint32_t> upsampledIndices(
+          *upsampledModel,
+          upsampledPrimitive.indices);
+
+      // The four quads of the child, with no new vertices.
+      CHECK(upsampledIndices.size() == 24);
+      CHECK(upsampledPositions.size() == 9);
+
+      const glm::vec2 minimum(0.5f * float(childX), 0.5f * float(childY));
+      for (int64_t i = 0; i < upsampledPositions.size(); ++i) {
+        const glm::vec3 position = upsampledPositions[i];
+        CHECK(position.x >= minimum.x);
+        CHECK(position.x <= minimum.x + 0.5f);
+        CHECK(position.y >= minimum.y);
+        CHECK(position.y <= minimum.y + 0.5f);
+      }
+    }
+  }
+}
@@ -0,0 +1,288 @@
+#include "VectorTile.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumGeospatial/WebMercatorProjection.h>
+#include <CesiumNativeTests/SimpleAssetAccessor.h>
+#include <CesiumNativeTests/SimpleAssetRequest.h>
+#include <CesiumNativeTests/SimpleAssetResponse.h>
+#include <CesiumNativeTests/SimpleTaskProcessor.h>
+#include <CesiumRasterOverlays/RasterOverlayTile.h>
+#include <CesiumRasterOverlays/RasterOverlayTileProvider.h>
+#include <CesiumRasterOverlays/VectorTileRasterOverlay.h>
+#include <CesiumUtility/CreditSystem.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumNativeTests;
+using namespace CesiumRasterOverlays;
+using namespace CesiumUtility;
+
+namespace {
+void writeVarint(std::vector<std::byte>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.emplace_back(std::byte((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.emplace_back(std::byte(value));
+}
+
+void writeMessage(
+    std::vector<std::byte>& out,
+    uint32_t field,
+    const std::vector<std::byte>& message) {
+  writeVarint(out, (field << 3) | 2);
+  writeVarint(out, message.size());
+  out.insert(out.end(), message.begin(), message.end());
+}
+
+void writeUint(std::vector<std::byte>& out, uint32_t field, uint64_t value) {
+  writeVarint(out, field << 3);
+  writeVarint(out, value);
+}
+
+uint64_t encodeZigZag(int64_t value) {
+  return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+}
+
+// Encodes the geometry of a feature, with each part closed if it is a ring.
+std::vector<std::byte> encodeGeometry(
+    const std::vector<std::vector<glm::ivec2>>& parts,
+    bool closeParts) {
+  std::vector<std::byte> geometry;
+  glm::ivec2 cursor(0);
+  for (const std::vector<glm::ivec2>& part : parts) {
+    for (size_t i = 0; i < part.size(); ++i) {
+      if (i == 0) {
+        writeVarint(geometry, (1 << 3) | 1);
+      } else if (i == 1) {
+        writeVarint(geometry, ((part.size() - 1) << 3) | 2);
+      }
+      writeVarint(geometry, encodeZigZag(part[i].x - cursor.x));
+      writeVarint(geometry, encodeZigZag(part[i].y - cursor.y));
+      cursor = part[i];
+    }
+    if (closeParts) {
+      writeVarint(geometry, (1 << 3) | 7);
+    }
+  }
+  return geometry;
+}
+
+std::vector<std::byte> encodeFeature(
+    VectorTileFeature::Type type,
+    const std::vector<std::vector<glm::ivec2>>& parts) {
+  std::vector<std::byte> feature;
+  writeUint(feature, 1, 1);
+  writeUint(feature, 3, uint64_t(type));
+  writeMessage(
+      feature,
+      4,
+      encodeGeometry(parts, type == VectorTileFeature::Type::Polygon));
+  return feature;
+}
+
+std::vector<std::byte> encodeLayer(
+    const std::string& name,
+    const std::vector<std::vector<std::byte>>& features) {
+  std::vector<std::byte> layer;
+  writeUint(layer, 15, 2);
+  std::vector<std::byte> nameBytes;
+  for (char c : name) {
+    nameBytes.emplace_back(std::byte(c));
+  }
+  writeMessage(layer, 1, nameBytes);
+  for (const std::vector<std::byte>& feature : features) {
+    writeMessage(layer, 2, feature);
+  }
+  writeUint(layer, 5, 4096);
+  return layer;
+}
+
+// A square with a square hole, and a vertical line to the west of it.
+std::vector<std::byte> createVectorTile() {
+  std::vector<std::byte> tile;
+  writeMessage(
+      tile,
+      3,
+      encodeLayer(
+          "water",
+          {encodeFeature(
+              VectorTileFeature::Type::Polygon,
+              {{glm::ivec2(512, 512),
+                glm::ivec2(3584, 512),
+                glm::ivec2(3584, 3584),
+                glm::ivec2(512, 3584)},
+               {glm::ivec2(1536, 1536),
+                glm::ivec2(1536, 2560),
+                glm::ivec2(2560, 2560),
+                glm::ivec2(2560, 1536)}})}));
+  writeMessage(
+      tile,
+      3,
+      encodeLayer(
+          "roads",
+          {encodeFeature(
+              VectorTileFeature::Type::LineString,
+              {{glm::ivec2(256, 0), glm::ivec2(256, 4096)}})}));
+  return tile;
+}
+
+glm::u8vec4 getPixel(const ImageCesium& image, double u, double v) {
+  const size_t x = size_t(u * image.width);
+  const size_t y = size_t(v * image.height);
+  const std::byte* pPixel =
+      &image.pixelData[4 * (y * size_t(image.width) + x)];
+  return glm::u8vec4(
+      uint8_t(pPixel[0]),
+      uint8_t(pPixel[1]),
+      uint8_t(pPixel[2]),
+      uint8_t(pPixel[3]));
+}
+} // namespace
+
+TEST_CASE("VectorTile") {
+  SECTION("decodes the geometry of the features") {
+    const std::vector<std::byte> data = createVectorTile();
+    std::optional<VectorTile> maybeTile = VectorTile::decode(data);
+    REQUIRE(maybeTile);
+    REQUIRE(maybeTile->layers.size() == 2);
+
+    const VectorTileLayer& water = maybeTile->layers[0];
+    CHECK(water.name == "water");
+    CHECK(water.extent == 4096);
+    REQUIRE(water.features.size() == 1);
+    CHECK(water.features[0].type == VectorTileFeature::Type::Polygon);
+    REQUIRE(water.features[0].parts.size() == 2);
+    CHECK(water.features[0].parts[0].size() == 4);
+    CHECK(water.features[0].parts[1][2] == glm::dvec2(2560.0, 2560.0));
+
+    const VectorTileLayer& roads = maybeTile->layers[1];
+    CHECK(roads.name == "roads");
+    REQUIRE(roads.features.size() == 1);
+    CHECK(roads.features[0].type == VectorTileFeature::Type::LineString);
+    REQUIRE(roads.features[0].parts.size() == 1);
+    CHECK(
+        roads.features[0].parts[0] ==
+        std::vector<glm::dvec2>{
+            glm::dvec2(256.0, 0.0),
+            glm::dvec2(256.0, 4096.0)});
+  }
+
+  SECTION("decodes an empty tile") {
+    std::optional<VectorTile> maybeTile = VectorTile::decode({});
+    REQUIRE(maybeTile);
+    CHECK(maybeTile->layers.empty());
+  }
+
+  SECTION("rejects truncated data") {
+    std::vector<std::byte> data = createVectorTile();
+    data.resize(data.size() - 3);
+    CHECK(!VectorTile::decode(data));
+  }
+}
+
+TEST_CASE("VectorTileRasterOverlay") {
+  AsyncSystem asyncSystem{std::make_shared<SimpleTaskProcessor>()};
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> requests;
+  requests.emplace(
+      "tiles/0/0/0.mvt",
+      std::make_shared<SimpleAssetRequest>(
+          "GET",
+          "tiles/0/0/0.mvt",
+          HttpHeaders(),
+          std::make_unique<SimpleAssetResponse>(
+              uint16_t(200),
+              "application/vnd.mapbox-vector-tile",
+              HttpHeaders(),
+              createVectorTile())));
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(requests);
+
+  VectorTileRasterOverlayOptions options;
+  options.maximumLevel = 0;
+  options.fillColor = glm::u8vec4(0, 0, 255, 255);
+  options.lineColor = glm::u8vec4(255, 0, 0, 255);
+  options.lineWidth = 4.0;
+
+  IntrusivePointer<VectorTileRasterOverlay> pOverlay =
+      new VectorTileRasterOverlay("Test", "tiles/{z}/{x}/{y}.mvt", {}, options);
+
+  IntrusivePointer<RasterOverlayTileProvider> pProvider = nullptr;
+  pOverlay
+      ->createTileProvider(
+          asyncSystem,
+          pAssetAccessor,
+          std::make_shared<CreditSystem>(),
+          nullptr,
+          spdlog::default_logger(),
+          nullptr)
+      .thenInMainThread(
+          [&pProvider](RasterOverlay::CreateTileProviderResult&& created) {
+            CHECK(created);
+            pProvider = *created;
+          });
+  asyncSystem.dispatchMainThreadTasks();
+  REQUIRE(pProvider);
+
+  const auto loadTile = [&](const Rectangle& rectangle) {
+    IntrusivePointer<RasterOverlayTile> pTile =
+        pProvider->getTile(rectangle, glm::dvec2(512.0));
+    pProvider->loadTile(*pTile);
+    while (pTile->getState() != RasterOverlayTile::LoadState::Loaded &&
+           pTile->getState() != RasterOverlayTile::LoadState::Failed) {
+      asyncSystem.dispatchMainThreadTasks();
+    }
+    REQUIRE(pTile->getState() == RasterOverlayTile::LoadState::Loaded);
+    return pTile;
+  };
+
+  const glm::u8vec4 fill(0, 0, 255, 255);
+  const glm::u8vec4 line(255, 0, 0, 255);
+  const glm::u8vec4 empty(0, 0, 0, 0);
+
+  SECTION("rasterizes the lines and polygons of a tile") {
+    IntrusivePointer<RasterOverlayTile> pTile =
+        loadTile(WebMercatorProjection::computeMaximumProjectedRectangle());
+    const ImageCesium& image = pTile->getImage();
+    REQUIRE(image.width == 256);
+    REQUIRE(image.height == 256);
+    REQUIRE(image.channels == 4);
+
+    CHECK(getPixel(image, 0.2, 0.2) == fill);
+    CHECK(getPixel(image, 0.8, 0.3) == fill);
+    CHECK(getPixel(image, 0.5, 0.5) == empty);
+    CHECK(getPixel(image, 0.9, 0.95) == empty);
+    CHECK(getPixel(image, 256.0 / 4096.0, 0.5) == line);
+  }
+
+  SECTION("rasterizes part of a tile above the maximum level") {
+    const Rectangle maximum =
+        WebMercatorProjection::computeMaximumProjectedRectangle();
+
+    // The northwest quarter of the tile of level 0.
+    IntrusivePointer<RasterOverlayTile> pTile = loadTile(Rectangle(
+        maximum.minimumX,
+        0.0,
+        0.0,
+        maximum.maximumY));
+    const ImageCesium& image = pTile->getImage();
+    REQUIRE(image.width == 256);
+    REQUIRE(image.height == 256);
+
+    CHECK(getPixel(image, 0.4, 0.4) == fill);
+    CHECK(getPixel(image, 0.9, 0.9) == empty);
+    CHECK(getPixel(image, 0.05, 0.05) == empty);
+    CHECK(getPixel(image, 512.0 / 4096.0, 0.05) == line);
+  }
+}
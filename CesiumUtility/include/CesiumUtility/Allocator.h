@@ -0,0 +1,280 @@
+#pragma once
+
+#include "CesiumUtility/Library.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace CesiumUtility {
+
+/**
+ * @brief The kinds of large buffers that are allocated with an
+ * {@link Allocator}, so that the memory they use can be accounted for
+ * separately.
+ */
+enum class AllocationCategory : uint8_t {
+  /**
+   * @brief Buffers that don't belong to any of the other categories.
+   */
+  Other,
+
+  /**
+   * @brief The data of glTF buffers.
+   */
+  GltfBuffer,
+
+  /**
+   * @brief The decoded pixels of images.
+   */
+  ImagePixels,
+
+  /**
+   * @brief Response data that has been decompressed.
+   */
+  DecompressedResponse,
+
+  /**
+   * @brief glTF buffers that are decoded from Draco-compressed meshes and
+   * point clouds.
+   */
+  DracoOutput,
+};
+
+/**
+ * @brief The number of values of {@link AllocationCategory}.
+ */
+constexpr size_t AllocationCategoryCount = 5;
+
+/**
+ * @brief An interface to the heap that large buffers are allocated from.
+ *
+ * The allocator is used by all threads at once, so it must be thread-safe.
+ *
+ * @see setAllocator
+ */
+class CESIUMUTILITY_API IAllocator {
+public:
+  virtual ~IAllocator() = default;
+
+  /**
+   * @brief Allocates memory, throwing `std::bad_alloc` if it can't.
+   *
+   * @param size The number of bytes to allocate, which is never zero.
+   * @param alignment The alignment of the memory, which is a power of two.
+   * @param category The category of the buffer that the memory is for.
+   * @return The allocated memory.
+   */
+  virtual void*
+  allocate(size_t size, size_t alignment, AllocationCategory category) = 0;
+
+  /**
+   * @brief Frees memory that was allocated by {@link allocate}, which is given
+   * the same size, alignment, and category that it was allocated with.
+   *
+   * @param pMemory The memory to free.
+   * @param size The number of bytes that were allocated.
+   * @param alignment The alignment of the memory.
+   * @param category The category of the buffer that the memory was for.
+   */
+  virtual void deallocate(
+      void* pMemory,
+      size_t size,
+      size_t alignment,
+      AllocationCategory category) noexcept = 0;
+};
+
+/**
+ * @brief The memory that is allocated for a category of buffers.
+ */
+struct CESIUMUTILITY_API AllocationStatistics {
+  /**
+   * @brief The number of bytes that are allocated now.
+   */
+  size_t allocatedBytes = 0;
+
+  /**
+   * @brief The largest number of bytes that were allocated at once.
+   */
+  size_t peakAllocatedBytes = 0;
+
+  /**
+   * @brief The number of allocations that haven't been freed yet.
+   */
+  size_t allocationCount = 0;
+
+  /**
+   * @brief The number of allocations that were ever made.
+   */
+  size_t totalAllocationCount = 0;
+};
+
+/**
+ * @brief Sets the allocator that large buffers are allocated from, or
+ * restores the default one, which uses the global `operator new`, if the
+ * given allocator is `nullptr`.
+ *
+ * The allocator is global, and buffers must be freed by the allocator that
+ * allocated them, so it should only be set while no buffers are allocated,
+ * such as before the first tileset or raster overlay is created.
+ *
+ * @param pAllocator The new allocator.
+ */
+CESIUMUTILITY_API void
+setAllocator(const std::shared_ptr<IAllocator>& pAllocator);
+
+/**
+ * @brief Gets the allocator that large buffers are allocated from.
+ */
+CESIUMUTILITY_API IAllocator& getAllocator() noexcept;
+
+/**
+ * @brief Gets the memory that is allocated for a category of buffers.
+ *
+ * The statistics are kept for whichever allocator is set, including the
+ * default one.
+ *
+ * @param category The category.
+ */
+CESIUMUTILITY_API AllocationStatistics
+getAllocationStatistics(AllocationCategory category) noexcept;
+
+/**
+ * @brief Allocates memory for a buffer of the given category from the
+ * {@link getAllocator}, and accounts for it in the category's
+ * {@link AllocationStatistics}.
+ *
+ * @param size The number of bytes to allocate, which may be zero.
+ * @param alignment The alignment of the memory, which is a power of two.
+ * @param category The category of the buffer.
+ * @return The allocated memory.
+ */
+CESIUMUTILITY_API void* allocateBytes(
+    size_t size,
+    size_t alignment,
+    AllocationCategory category);
+
+/**
+ * @brief Frees memory that was allocated by {@link allocateBytes}, which is
+ * given the same size, alignment, and category that it was allocated with.
+ *
+ * @param pMemory The memory to free.
+ * @param size The number of bytes that were allocated.
+ * @param alignment The alignment of the memory.
+ * @param category The category of the buffer.
+ */
+CESIUMUTILITY_API void deallocateBytes(
+    void* pMemory,
+    size_t size,
+    size_t alignment,
+    AllocationCategory category) noexcept;
+
+/**
+ * @brief A standard allocator that allocates from the {@link getAllocator}
+ * and tags its allocations with a category.
+ *
+ * The category goes along with the allocator when a container is copied,
+ * moved, or swapped, so that memory is always freed with the category that it
+ * was allocated with.
+ *
+ * @tparam T The type of the elements that are allocated.
+ */
+template <typename T> class Allocator {
+public:
+  /**
+   * @brief The type of the elements that are allocated.
+   */
+  using value_type = T;
+
+  /** @brief The category goes along with a copied container. */
+  using propagate_on_container_copy_assignment = std::true_type;
+
+  /** @brief The category goes along with a moved container. */
+  using propagate_on_container_move_assignment = std::true_type;
+
+  /** @brief The category goes along with a swapped container. */
+  using propagate_on_container_swap = std::true_type;
+
+  /** @brief Allocators with different categories are not equal. */
+  using is_always_equal = std::false_type;
+
+  /**
+   * @brief Creates an allocator for buffers of the given category.
+   *
+   * @param category The category.
+   */
+  Allocator(AllocationCategory category = AllocationCategory::Other) noexcept
+      : _category(category) {}
+
+  /**
+   * @brief Creates an allocator with the same category as another one.
+   *
+   * @param other The other allocator.
+   */
+  template <typename U>
+  Allocator(const Allocator<U>& other) noexcept
+      : _category(other.getCategory()) {}
+
+  /**
+   * @brief Gets the category of the buffers that this allocator is for.
+   */
+  AllocationCategory getCategory() const noexcept { return this->_category; }
+
+  /**
+   * @brief Allocates memory for the given number of elements.
+   *
+   * @param count The number of elements.
+   * @return The allocated memory.
+   */
+  T* allocate(size_t count) {
+    if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(
+        allocateBytes(count * sizeof(T), alignof(T), this->_category));
+  }
+
+  /**
+   * @brief Frees memory that was allocated by {@link allocate}.
+   *
+   * @param pElements The memory to free.
+   * @param count The number of elements that it was allocated for.
+   */
+  void deallocate(T* pElements, size_t count) noexcept {
+    deallocateBytes(pElements, count * sizeof(T), alignof(T), this->_category);
+  }
+
+  /**
+   * @brief Checks if two allocators can free each other's memory, which they
+   * can if they have the same category.
+   */
+  template <typename U>
+  bool operator==(const Allocator<U>& other) const noexcept {
+    return this->_category == other.getCategory();
+  }
+
+  /**
+   * @brief Checks if two allocators can't free each other's memory.
+   */
+  template <typename U>
+  bool operator!=(const Allocator<U>& other) const noexcept {
+    return this->_category != other.getCategory();
+  }
+
+private:
+  AllocationCategory _category;
+};
+
+/**
+ * @brief A vector of bytes that are allocated with an {@link Allocator}.
+ *
+ * The category of the bytes is given when the vector is created, such as with
+ * `ByteVector data(size, AllocationCategory::GltfBuffer)`.
+ */
+using ByteVector = std::vector<std::byte, Allocator<std::byte>>;
+
+} // namespace CesiumUtility
@@ -4,6 +4,7 @@
 #include "Math.h"
 
 #include <glm/glm.hpp>
+#include <gsl/span>
 
 namespace CesiumUtility {
 /**
@@ -77,6 +78,36 @@ public:
 
     return glm::dvec3(red * normalize5, green * normalize6, blue * normalize5);
   };
+
+  /**
+   * @brief Decodes many unit-length vectors in 2 byte 'oct' encoding to
+   * normalized 3-component vectors, like {@link octDecode} does for each of
+   * them.
+   *
+   * This computes in single precision and without branches, so that the
+   * compiler can vectorize the loop. The results differ from those of
+   * {@link octDecode} only by float rounding.
+   *
+   * @param encoded The oct-encoded unit length vectors.
+   * @param result The decoded and normalized vectors. This must be at least as
+   * large as `encoded`.
+   */
+  static void octDecode(
+      const gsl::span<const glm::u8vec2>& encoded,
+      const gsl::span<glm::vec3>& result) noexcept;
+
+  /**
+   * @brief Decodes many RGB565-encoded colors to 3-component vectors
+   * containing the normalized RGB values, like {@link decodeRGB565} does for
+   * each of them.
+   *
+   * @param encoded The RGB565-encoded values.
+   * @param result The normalized RGB values. This must be at least as large as
+   * `encoded`.
+   */
+  static void decodeRGB565(
+      const gsl::span<const uint16_t>& encoded,
+      const gsl::span<glm::vec3>& result) noexcept;
 };
 
 } // namespace CesiumUtility
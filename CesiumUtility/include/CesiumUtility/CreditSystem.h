@@ -2,6 +2,9 @@
 
 #include "Library.h"
 
+#include <gsl/span>
+
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -74,6 +77,12 @@ public:
    */
   void addCreditToFrame(Credit credit);
 
+  /**
+   * @brief Adds each of the Credits to the set of credits to show this frame,
+   * as if by calling {@link addCreditToFrame} for each one.
+   */
+  void addCreditsToFrame(const gsl::span<const Credit>& credits);
+
   /**
    * @brief Notifies this CreditSystem to start tracking the credits to show for
    * the next frame.
@@ -90,9 +99,7 @@ public:
    * shown.
    */
   const std::vector<Credit>&
-  getCreditsToNoLongerShowThisFrame() const noexcept {
-    return _creditsToNoLongerShowThisFrame;
-  }
+  getCreditsToNoLongerShowThisFrame() const noexcept;
 
 private:
   const std::string INVALID_CREDIT_MESSAGE =
@@ -106,9 +113,15 @@ private:
   };
 
   std::vector<HtmlAndLastFrameNumber> _credits;
+  std::unordered_map<std::string, size_t> _creditIdsByHtml;
 
   int32_t _currentFrameNumber = 0;
   std::vector<Credit> _creditsToShowThisFrame;
-  std::vector<Credit> _creditsToNoLongerShowThisFrame;
+
+  // The credits that were shown last frame. Those that are added to this frame
+  // again are only removed once the list is requested, so that adding a credit
+  // doesn't need to search it.
+  mutable std::vector<Credit> _creditsToNoLongerShowThisFrame;
+  mutable bool _creditsToNoLongerShowThisFrameAreStale = false;
 };
 } // namespace CesiumUtility
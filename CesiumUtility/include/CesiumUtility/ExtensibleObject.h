@@ -1,9 +1,12 @@
 #pragma once
 
+#include "FlatMap.h"
 #include "JsonValue.h"
 #include "Library.h"
 
 #include <any>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -20,8 +23,7 @@ struct CESIUMUTILITY_API ExtensibleObject {
    * @return A boolean indicating whether the extension exists.
    */
   template <typename T> bool hasExtension() const noexcept {
-    auto it = this->extensions.find(T::ExtensionName);
-    return it != this->extensions.end();
+    return this->extensions.contains(getExtensionName<T>());
   }
 
   /**
@@ -32,7 +34,7 @@ struct CESIUMUTILITY_API ExtensibleObject {
    * attached to this object.
    */
   template <typename T> const T* getExtension() const noexcept {
-    auto it = this->extensions.find(T::ExtensionName);
+    auto it = this->extensions.find(getExtensionName<T>());
     if (it == this->extensions.end()) {
       return nullptr;
     }
@@ -72,7 +74,8 @@ struct CESIUMUTILITY_API ExtensibleObject {
    */
   template <typename T> T& addExtension() {
     std::any& extension =
-        extensions.try_emplace(T::ExtensionName, std::make_any<T>())
+        this->extensions
+            .try_emplace(getExtensionName<T>(), std::in_place_type<T>)
             .first->second;
     return std::any_cast<T&>(extension);
   }
@@ -83,7 +86,7 @@ struct CESIUMUTILITY_API ExtensibleObject {
    * @tparam T The type of the extension to remove.
    */
   template <typename T> void removeExtension() {
-    extensions.erase(T::ExtensionName);
+    this->extensions.erase(getExtensionName<T>());
   }
 
   /**
@@ -92,8 +95,13 @@ struct CESIUMUTILITY_API ExtensibleObject {
    * Use {@link getExtension} to get the extension with a particular static
    * type. Use {@link getGenericExtension} to get unknown extensions as a
    * generic {@link CesiumUtility::JsonValue}.
+   *
+   * Most objects have no extensions, and the ones that do have only a few,
+   * so they are kept in a {@link FlatMap}, which allocates nothing while it
+   * is empty. Adding or removing an extension may move the generic
+   * extensions of this object, which invalidates pointers to them.
    */
-  std::unordered_map<std::string, std::any> extensions;
+  FlatMap<std::string, std::any> extensions;
 
   /**
    * @brief Application-specific data.
@@ -113,5 +121,12 @@ struct CESIUMUTILITY_API ExtensibleObject {
    * experimental, or next-version properties.
    */
   JsonValue::Object unknownProperties;
+
+private:
+  // The extension names are known at compile time, so looking up a
+  // statically-typed extension neither hashes the name nor creates a string.
+  template <typename T> static constexpr std::string_view getExtensionName() {
+    return T::ExtensionName;
+  }
 };
 } // namespace CesiumUtility
@@ -0,0 +1,377 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace CesiumUtility {
+
+/**
+ * @brief A map that keeps its entries in a vector, sorted by their keys.
+ *
+ * It has the same interface as `std::map` for looking up, iterating, and
+ * adding entries, but all of the entries are stored in one allocation rather
+ * than in a tree node each. That makes it smaller and faster to iterate and
+ * to look up in, at the cost of adding entries in the middle, which moves
+ * the entries after them. Adding entries in the order of their keys, as when
+ * copying another map, only appends.
+ *
+ * Unlike the ones of `std::map`, iterators and references to the entries are
+ * invalidated when entries are added or removed. The keys of the entries must
+ * not be changed through an iterator.
+ *
+ * @tparam Key The type of the keys.
+ * @tparam T The type of the values.
+ * @tparam Compare The ordering of the keys. The default one allows looking up
+ * keys of other types that can be compared to `Key`, such as
+ * `std::string_view` for `std::string` keys.
+ */
+template <typename Key, typename T, typename Compare = std::less<>>
+class FlatMap {
+public:
+  /** @brief The type of the keys. */
+  using key_type = Key;
+  /** @brief The type of the values. */
+  using mapped_type = T;
+  /** @brief The type of the entries. */
+  using value_type = std::pair<Key, T>;
+  /** @brief The type of sizes. */
+  using size_type = size_t;
+  /** @brief The ordering of the keys. */
+  using key_compare = Compare;
+  /** @brief An iterator over the entries, in the order of their keys. */
+  using iterator = typename std::vector<value_type>::iterator;
+  /** @brief A const iterator over the entries, in the order of their keys. */
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  /**
+   * @brief Creates an empty map.
+   */
+  FlatMap() = default;
+
+  /**
+   * @brief Creates a map with the given entries. If a key appears more than
+   * once, the first entry with that key is kept, as with `std::map`.
+   */
+  template <typename InputIt> FlatMap(InputIt first, InputIt last) {
+    this->insert(first, last);
+  }
+
+  /** @copydoc FlatMap(InputIt, InputIt) */
+  FlatMap(std::initializer_list<value_type> entries)
+      : FlatMap(entries.begin(), entries.end()) {}
+
+  /** @brief Gets an iterator to the first entry. */
+  iterator begin() noexcept { return this->_entries.begin(); }
+  /** @copydoc begin */
+  const_iterator begin() const noexcept { return this->_entries.begin(); }
+  /** @copydoc begin */
+  const_iterator cbegin() const noexcept { return this->_entries.cbegin(); }
+
+  /** @brief Gets an iterator past the last entry. */
+  iterator end() noexcept { return this->_entries.end(); }
+  /** @copydoc end */
+  const_iterator end() const noexcept { return this->_entries.end(); }
+  /** @copydoc end */
+  const_iterator cend() const noexcept { return this->_entries.cend(); }
+
+  /** @brief Returns whether the map has no entries. */
+  bool empty() const noexcept { return this->_entries.empty(); }
+
+  /** @brief Gets the number of entries. */
+  size_type size() const noexcept { return this->_entries.size(); }
+
+  /**
+   * @brief Gets the number of entries that the map can hold before it needs
+   * to allocate more memory.
+   */
+  size_type capacity() const noexcept { return this->_entries.capacity(); }
+
+  /**
+   * @brief Allocates memory for at least the given number of entries.
+   */
+  void reserve(size_type count) { this->_entries.reserve(count); }
+
+  /**
+   * @brief Frees the memory that was allocated for more entries than the map
+   * has.
+   */
+  void shrink_to_fit() { this->_entries.shrink_to_fit(); }
+
+  /** @brief Removes all entries. */
+  void clear() noexcept { this->_entries.clear(); }
+
+  /**
+   * @brief Finds the entry with the given key.
+   *
+   * @return An iterator to the entry, or {@link end} if there is none.
+   */
+  template <typename K> iterator find(const K& key) {
+    const iterator it = this->lower_bound(key);
+    return it != this->end() && !less(key, it->first) ? it : this->end();
+  }
+
+  /** @copydoc find */
+  template <typename K> const_iterator find(const K& key) const {
+    const const_iterator it = this->lower_bound(key);
+    return it != this->end() && !less(key, it->first) ? it : this->end();
+  }
+
+  /** @brief Gets the number of entries with the given key, zero or one. */
+  template <typename K> size_type count(const K& key) const {
+    return this->find(key) != this->end() ? 1 : 0;
+  }
+
+  /** @brief Returns whether there is an entry with the given key. */
+  template <typename K> bool contains(const K& key) const {
+    return this->find(key) != this->end();
+  }
+
+  /**
+   * @brief Gets an iterator to the first entry whose key isn't less than the
+   * given one.
+   */
+  template <typename K> iterator lower_bound(const K& key) {
+    return std::lower_bound(
+        this->begin(),
+        this->end(),
+        key,
+        [](const value_type& entry, const K& value) {
+          return less(entry.first, value);
+        });
+  }
+
+  /** @copydoc lower_bound */
+  template <typename K> const_iterator lower_bound(const K& key) const {
+    return std::lower_bound(
+        this->begin(),
+        this->end(),
+        key,
+        [](const value_type& entry, const K& value) {
+          return less(entry.first, value);
+        });
+  }
+
+  /**
+   * @brief Gets the value with the given key.
+   *
+   * @throws std::out_of_range If there is no entry with the key.
+   */
+  template <typename K> T& at(const K& key) {
+    const iterator it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("The key is not present in the FlatMap.");
+    }
+    return it->second;
+  }
+
+  /** @copydoc at */
+  template <typename K> const T& at(const K& key) const {
+    const const_iterator it = this->find(key);
+    if (it == this->end()) {
+      throw std::out_of_range("The key is not present in the FlatMap.");
+    }
+    return it->second;
+  }
+
+  /**
+   * @brief Gets the value with the given key, adding a default-constructed
+   * one if there is none.
+   */
+  T& operator[](const Key& key) {
+    return this->try_emplace(key).first->second;
+  }
+
+  /** @copydoc operator[] */
+  T& operator[](Key&& key) {
+    return this->try_emplace(std::move(key)).first->second;
+  }
+
+  /**
+   * @brief Adds an entry with the given key and a value constructed from the
+   * given arguments, unless there already is an entry with that key.
+   *
+   * The value is not constructed if there already is an entry with the key.
+   *
+   * @return An iterator to the entry with the key, and whether it was added.
+   */
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+    const iterator it = this->lower_bound(key);
+    if (it != this->end() && !less(key, it->first)) {
+      return {it, false};
+    }
+    return {
+        this->_entries.emplace(
+            it,
+            std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...)),
+        true};
+  }
+
+  /**
+   * @brief Adds an entry constructed from the given arguments, unless there
+   * already is an entry with its key.
+   *
+   * @return An iterator to the entry with the key, and whether it was added.
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return this->insert(value_type(std::forward<Args>(args)...));
+  }
+
+  /**
+   * @brief Adds an entry, unless there already is an entry with its key.
+   *
+   * @return An iterator to the entry with the key, and whether it was added.
+   */
+  std::pair<iterator, bool> insert(value_type&& entry) {
+    const iterator it = this->lower_bound(entry.first);
+    if (it != this->end() && !less(entry.first, it->first)) {
+      return {it, false};
+    }
+    return {this->_entries.insert(it, std::move(entry)), true};
+  }
+
+  /** @copydoc insert(value_type&&) */
+  std::pair<iterator, bool> insert(const value_type& entry) {
+    return this->insert(value_type(entry));
+  }
+
+  /**
+   * @brief Adds the given entries, except the ones whose keys are already in
+   * the map. If a new key appears more than once, the first entry with that
+   * key is added.
+   */
+  template <typename InputIt> void insert(InputIt first, InputIt last) {
+    const size_type oldSize = this->size();
+    this->_entries.insert(this->_entries.end(), first, last);
+
+    // Sorting the new entries on their own and merging them keeps the cost
+    // from growing with the square of their number.
+    auto keyLess = [](const value_type& lhs, const value_type& rhs) {
+      return less(lhs.first, rhs.first);
+    };
+    const iterator middle =
+        this->begin() + static_cast<std::ptrdiff_t>(oldSize);
+
+    // Entries that are already in order after the existing ones, as when
+    // copying another map, need nothing more.
+    auto notLess = [](const value_type& lhs, const value_type& rhs) {
+      return !less(lhs.first, rhs.first);
+    };
+    if (std::adjacent_find(middle, this->end(), notLess) == this->end() &&
+        (middle == this->begin() || middle == this->end() ||
+         less(std::prev(middle)->first, middle->first))) {
+      return;
+    }
+
+    std::stable_sort(middle, this->end(), keyLess);
+    std::inplace_merge(this->begin(), middle, this->end(), keyLess);
+
+    // The stable sort and merge keep the entry that came first in front, so
+    // removing the later duplicates keeps the existing and first entries.
+    auto keyEqual = [](const value_type& lhs, const value_type& rhs) {
+      return !less(lhs.first, rhs.first) && !less(rhs.first, lhs.first);
+    };
+    this->_entries.erase(
+        std::unique(this->begin(), this->end(), keyEqual),
+        this->end());
+  }
+
+  /** @copydoc insert(InputIt, InputIt) */
+  void insert(std::initializer_list<value_type> entries) {
+    this->insert(entries.begin(), entries.end());
+  }
+
+  /**
+   * @brief Sets the value with the given key, adding an entry if there is
+   * none.
+   *
+   * @return An iterator to the entry with the key, and whether it was added.
+   */
+  template <typename K, typename V>
+  std::pair<iterator, bool> insert_or_assign(K&& key, V&& value) {
+    const iterator it = this->lower_bound(key);
+    if (it != this->end() && !less(key, it->first)) {
+      it->second = std::forward<V>(value);
+      return {it, false};
+    }
+    return {
+        this->_entries.emplace(
+            it,
+            std::forward<K>(key),
+            std::forward<V>(value)),
+        true};
+  }
+
+  /**
+   * @brief Removes an entry.
+   *
+   * @return An iterator to the entry after the removed one.
+   */
+  iterator erase(const_iterator position) {
+    return this->_entries.erase(position);
+  }
+
+  /** @copydoc erase(const_iterator) */
+  iterator erase(iterator position) { return this->_entries.erase(position); }
+
+  /**
+   * @brief Removes a range of entries.
+   *
+   * @return An iterator to the entry after the removed ones.
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    return this->_entries.erase(first, last);
+  }
+
+  /**
+   * @brief Removes the entry with the given key, if there is one.
+   *
+   * @return The number of removed entries, zero or one.
+   */
+  template <
+      typename K,
+      typename = std::enable_if_t<
+          !std::is_convertible_v<const K&, const_iterator> &&
+          !std::is_convertible_v<const K&, iterator>>>
+  size_type erase(const K& key) {
+    const iterator it = this->find(key);
+    if (it == this->end()) {
+      return 0;
+    }
+    this->_entries.erase(it);
+    return 1;
+  }
+
+  /** @brief Swaps the entries of two maps. */
+  void swap(FlatMap& other) noexcept { this->_entries.swap(other._entries); }
+
+  /** @brief Compares the entries of two maps. */
+  bool operator==(const FlatMap& rhs) const {
+    return this->_entries == rhs._entries;
+  }
+
+  /** @brief Compares the entries of two maps. */
+  bool operator!=(const FlatMap& rhs) const { return !(*this == rhs); }
+
+private:
+  // The ordering isn't stored, so that it doesn't make the map larger.
+  template <typename A, typename B>
+  static bool less(const A& lhs, const B& rhs) {
+    return Compare()(lhs, rhs);
+  }
+
+  std::vector<value_type> _entries;
+};
+
+} // namespace CesiumUtility
@@ -1,14 +1,43 @@
 #pragma once
+#include "CesiumUtility/Allocator.h"
+
 #include <gsl/span>
 
+#include <cstddef>
 #include <vector>
 
 namespace CesiumUtility {
 extern bool isGzip(const gsl::span<const std::byte>& data);
 /**
  * Gunzip data. If successful, it will return true and the result will be in the
- * provided vector.
+ * provided vector. The data is inflated into a vector of the size given by its
+ * gzip trailer, so that most data is inflated in one step.
  */
 extern bool
 gunzip(const gsl::span<const std::byte>& data, std::vector<std::byte>& out);
+/**
+ * Gunzip data into a {@link ByteVector}, which keeps the allocation category
+ * that it was created with.
+ */
+extern bool gunzip(const gsl::span<const std::byte>& data, ByteVector& out);
+/**
+ * Inflate raw deflate data, which has no gzip or zlib header, such as the
+ * compressed files in a zip archive. If successful, it will return true and
+ * the result will be in the provided vector. If the size of the inflated data
+ * is known, such as from the header of a file in a zip archive, giving it
+ * allows the data to be inflated in one step.
+ */
+extern bool inflateRaw(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out,
+    size_t inflatedSize = 0);
+/**
+ * Gzip data, with a compression level from 1 (the fastest) to 9 (the
+ * smallest). If successful, it will return true and the result will be in the
+ * provided vector.
+ */
+extern bool gzip(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out,
+    int level = 1);
 } // namespace CesiumUtility
@@ -103,15 +103,42 @@ public:
 
   /**
    * @brief Move assignment operator.
+   *
+   * The reference of `rhs` is taken over without changing the reference
+   * count, and `rhs` is left empty.
    */
   IntrusivePointer& operator=(IntrusivePointer&& rhs) noexcept {
-    if (this->_p != rhs._p) {
-      std::swap(this->_p, rhs._p);
+    T* pOld = std::exchange(this->_p, std::exchange(rhs._p, nullptr));
+    if (pOld) {
+      pOld->releaseReference();
     }
 
     return *this;
   }
 
+  /**
+   * @brief Move assignment from a pointer to a derived (or otherwise
+   * convertible) type.
+   *
+   * The reference of `rhs` is taken over without changing the reference
+   * count, and `rhs` is left empty.
+   */
+  template <class U>
+  IntrusivePointer& operator=(IntrusivePointer<U>&& rhs) noexcept {
+    T* pOld = std::exchange(this->_p, std::exchange(rhs._p, nullptr));
+    if (pOld) {
+      pOld->releaseReference();
+    }
+
+    return *this;
+  }
+
+  /**
+   * @brief Exchanges the objects controlled by this pointer and another one,
+   * without changing their reference counts.
+   */
+  void swap(IntrusivePointer& rhs) noexcept { std::swap(this->_p, rhs._p); }
+
   /**
    * @brief Assignment operator.
    */
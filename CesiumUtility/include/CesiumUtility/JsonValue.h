@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FlatMap.h"
 #include "Library.h"
 
 #include <gsl/narrow>
@@ -83,8 +84,12 @@ public:
 
   /**
    * @brief The type to represent an `Object` JSON value.
+   *
+   * The properties are kept in a single allocation, sorted by their names,
+   * rather than in a tree node each. The names may be looked up as a
+   * `std::string_view` or a string literal without creating a `std::string`.
    */
-  using Object = std::map<std::string, JsonValue>;
+  using Object = FlatMap<std::string, JsonValue>;
 
   /**
    * @brief The type to represent an `Array` JSON value.
@@ -183,12 +188,18 @@ public:
   /**
    * @brief Creates an `Object` JSON value with the given properties.
    */
-  JsonValue(const std::map<std::string, JsonValue>& v) : value(v) {}
+  JsonValue(const Object& v) : value(v) {}
+
+  /**
+   * @brief Creates an `Object` JSON value with the given properties.
+   */
+  JsonValue(Object&& v) noexcept : value(std::move(v)) {}
 
   /**
    * @brief Creates an `Object` JSON value with the given properties.
    */
-  JsonValue(std::map<std::string, JsonValue>&& v) : value(std::move(v)) {}
+  JsonValue(const std::map<std::string, JsonValue>& v)
+      : value(Object(v.begin(), v.end())) {}
 
   /**
    * @brief Creates an `Array` JSON value with the given elements.
@@ -210,7 +221,7 @@ public:
    * @brief Creates an JSON value from the given initializer list.
    */
   JsonValue(std::initializer_list<std::pair<const std::string, JsonValue>> v)
-      : value(std::map<std::string, JsonValue>(v)) {}
+      : value(Object(v.begin(), v.end())) {}
 
   [[nodiscard]] const JsonValue*
   getValuePtrForKey(const std::string& key) const;
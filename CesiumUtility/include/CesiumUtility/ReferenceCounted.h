@@ -51,7 +51,7 @@ class ReferenceCounted
 {
 public:
   ReferenceCounted() noexcept {}
-  ~ReferenceCounted() noexcept { assert(this->_referenceCount == 0); }
+  ~ReferenceCounted() noexcept { assert(this->getReferenceCount() == 0); }
 
   /**
    * @brief Adds a counted reference to this object. Use
@@ -65,7 +65,13 @@ public:
     }
 #endif
 
-    ++this->_referenceCount;
+    if constexpr (isThreadSafe) {
+      // Taking a reference needs no ordering, because whoever hands out the
+      // reference already holds one, so the object can't go away meanwhile.
+      this->_referenceCount.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      ++this->_referenceCount;
+    }
   }
 
   /**
@@ -81,10 +87,19 @@ public:
     }
 #endif
 
-    assert(this->_referenceCount > 0);
-    const int32_t references = --this->_referenceCount;
-    if (references == 0) {
-      delete static_cast<const T*>(this);
+    assert(this->getReferenceCount() > 0);
+    if constexpr (isThreadSafe) {
+      // Releasing a reference publishes the writes made through it, and the
+      // thread that releases the last one acquires them all before deleting.
+      if (this->_referenceCount.fetch_sub(1, std::memory_order_release) == 1) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        delete static_cast<const T*>(this);
+      }
+    } else {
+      const int32_t references = --this->_referenceCount;
+      if (references == 0) {
+        delete static_cast<const T*>(this);
+      }
     }
   }
 
@@ -92,7 +107,11 @@ public:
    * @brief Returns the current reference count of this instance.
    */
   std::int32_t getReferenceCount() const noexcept {
-    return this->_referenceCount;
+    if constexpr (isThreadSafe) {
+      return this->_referenceCount.load(std::memory_order_relaxed);
+    } else {
+      return this->_referenceCount;
+    }
   }
 
 private:
@@ -12,6 +12,8 @@
 
 #define CESIUM_TRACE_INIT(filename)
 #define CESIUM_TRACE_SHUTDOWN()
+#define CESIUM_TRACE_SET_ENABLED(enabled)
+#define CESIUM_TRACE_FLUSH()
 #define CESIUM_TRACE(name)
 #define CESIUM_TRACE_BEGIN(name)
 #define CESIUM_TRACE_END(name)
@@ -27,10 +29,12 @@
 #include <atomic>
 #include <cassert>
 #include <chrono>
+#include <cstdint>
+#include <exception>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <string>
-#include <thread>
 #include <vector>
 
 // helper macros to avoid shadowing variables
@@ -41,17 +45,45 @@
  * @brief Initializes the tracing framework and begins recording to a given JSON
  * filename.
  *
+ * Each thread records its events into its own fixed-size ring buffer without
+ * taking a lock, so only the most recent events of each thread are kept until
+ * they are written to the file by {@link CESIUM_TRACE_FLUSH} or
+ * {@link CESIUM_TRACE_SHUTDOWN}. The buffered events are also written if the
+ * process ends with `std::terminate`. The file uses the Chrome trace event
+ * format, which can be opened in Perfetto (https://ui.perfetto.dev) or
+ * imported into Tracy with its `import-chrome` tool.
+ *
  * @param filename The path and named of the file in which to record traces.
  */
 #define CESIUM_TRACE_INIT(filename)                                            \
   CesiumUtility::CesiumImpl::Tracer::instance().startTracing(filename)
 
 /**
- * @brief Shuts down tracing and closes the JSON tracing file.
+ * @brief Shuts down tracing, writes the buffered events, and closes the JSON
+ * tracing file.
  */
 #define CESIUM_TRACE_SHUTDOWN()                                                \
   CesiumUtility::CesiumImpl::Tracer::instance().endTracing()
 
+/**
+ * @brief Pauses or resumes recording events.
+ *
+ * Recording starts with {@link CESIUM_TRACE_INIT}. While it is paused, the
+ * tracing macros only check whether recording is enabled, so tracing may be
+ * left in a build and enabled when a problem needs to be investigated.
+ *
+ * @param enabled Whether to record events.
+ */
+#define CESIUM_TRACE_SET_ENABLED(enabled)                                      \
+  CesiumUtility::CesiumImpl::Tracer::instance().setEnabled(enabled)
+
+/**
+ * @brief Writes the events that were recorded since the last flush to the JSON
+ * tracing file, and removes them from the ring buffers.
+ */
+#define CESIUM_TRACE_FLUSH()                                                   \
+  CesiumUtility::CesiumImpl::Tracer::instance().flush()
+
 /**
  * @brief Measures and records the time spent in the current scope.
  *
@@ -204,13 +236,6 @@ namespace CesiumImpl {
 // The following are internal classes used by the tracing framework, do not use
 // directly.
 
-struct Trace {
-  std::string name;
-  int64_t start;
-  int64_t duration;
-  std::thread::id threadID;
-};
-
 class TrackReference;
 
 class Tracer {
@@ -222,7 +247,14 @@ public:
   void startTracing(const std::string& filePath = "trace.json");
   void endTracing();
 
-  void writeCompleteEvent(const Trace& trace);
+  void setEnabled(bool enabled) noexcept;
+  bool isEnabled() const noexcept {
+    return this->_enabled.load(std::memory_order_relaxed);
+  }
+
+  void flush();
+
+  void writeCompleteEvent(const char* name, int64_t start, int64_t duration);
   void writeAsyncEventBegin(const char* name, int64_t id);
   void writeAsyncEventBegin(const char* name);
   void writeAsyncEventEnd(const char* name, int64_t id);
@@ -231,23 +263,40 @@ public:
   int64_t allocateTrackID();
 
 private:
+  struct ThreadBuffer;
+
   Tracer();
 
   int64_t getCurrentThreadTrackID() const;
-  void writeAsyncEvent(
-      const char* category,
+  ThreadBuffer& getCurrentThreadBuffer();
+  void writeAsyncEvent(const char* name, char type, int64_t id);
+  void writeEvent(
       const char* name,
       char type,
+      int64_t timestamp,
+      int64_t duration,
       int64_t id);
+  void writeBufferedEvents();
+  void closeOutput();
+
+  static void onTerminate();
 
   std::ofstream _output;
   uint32_t _numTraces;
   std::mutex _lock;
+  std::atomic<bool> _enabled;
+  std::mutex _buffersLock;
+  std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+  uint32_t _lastThreadIndex;
+  std::terminate_handler _previousTerminateHandler;
   std::atomic<int64_t> _lastAllocatedID;
+
+  static thread_local std::shared_ptr<ThreadBuffer> _pThreadBuffer;
 };
 
 class ScopedTrace {
 public:
+  explicit ScopedTrace(const char* message);
   explicit ScopedTrace(const std::string& message);
   ~ScopedTrace();
 
@@ -261,7 +310,6 @@ public:
 private:
   std::string _name;
   std::chrono::steady_clock::time_point _startTime;
-  std::thread::id _threadId;
   bool _reset;
 };
 
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace CesiumUtility {
 class Uri final {
@@ -144,4 +145,137 @@ public:
   static std::string
   setPath(const std::string& uri, const std::string& newPath);
 };
+
+/**
+ * @brief A base URI that is parsed once, so that many relative URIs can be
+ * resolved against it quickly.
+ *
+ * Resolving gives the same result as {@link Uri::resolve}. Relative paths
+ * made of plain path characters, with an optional query, are appended to the
+ * directory of an already normalized base without parsing either of them.
+ * Other URIs, such as absolute ones or ones with dot segments or
+ * percent-encoded characters, are resolved with {@link Uri::resolve}.
+ */
+class BaseUri final {
+public:
+  /**
+   * @brief Creates an empty base URI.
+   */
+  BaseUri() = default;
+
+  /**
+   * @brief Parses a base URI.
+   *
+   * @param base The base URI.
+   * @param assumeHttpsDefault Whether protocol-relative URIs use https, as in
+   * {@link Uri::resolve}.
+   */
+  explicit BaseUri(const std::string& base, bool assumeHttpsDefault = true);
+
+  /**
+   * @brief Returns the base URI that this was created with.
+   */
+  const std::string& getUri() const noexcept { return this->_base; }
+
+  /**
+   * @brief Resolves a URI against this base.
+   *
+   * @param relative The URI to resolve.
+   * @param useBaseQuery Whether to append the query of the base URI, as in
+   * {@link Uri::resolve}.
+   * @return The resolved URI.
+   */
+  std::string
+  resolve(const std::string& relative, bool useBaseQuery = false) const;
+
+  /**
+   * @brief Resolves a URI against this base into a string, replacing its
+   * contents, so that its memory can be reused for many URIs.
+   *
+   * @param relative The URI to resolve.
+   * @param result The string that receives the resolved URI.
+   * @param useBaseQuery Whether to append the query of the base URI, as in
+   * {@link Uri::resolve}.
+   */
+  void resolve(
+      const std::string& relative,
+      std::string& result,
+      bool useBaseQuery = false) const;
+
+private:
+  std::string _base;
+  bool _assumeHttpsDefault = true;
+  // The part of the base up to and including the last slash of its path, if
+  // relative paths can simply be appended to it. Otherwise, this is empty.
+  std::string _directory;
+  std::string _query;
+};
+
+/**
+ * @brief A URI template, like the ones given to
+ * {@link Uri::substituteTemplateParameters}, that is split into its literal
+ * parts and placeholders once, so that it can be filled in for many URIs
+ * without searching it again.
+ */
+class UriTemplate final {
+public:
+  /**
+   * @brief Creates an empty template.
+   */
+  UriTemplate() = default;
+
+  /**
+   * @brief Splits a URI template into its literal parts and placeholders.
+   *
+   * @param templateUri The template, where each placeholder is enclosed in
+   * curly braces.
+   */
+  explicit UriTemplate(const std::string& templateUri);
+
+  /**
+   * @brief Returns the template that this was created from.
+   */
+  const std::string& getTemplate() const noexcept { return this->_template; }
+
+  /**
+   * @brief A function that appends the value of a placeholder to the URI
+   * that is being filled in.
+   */
+  typedef void
+  AppendCallbackSignature(const std::string& placeholder, std::string& result);
+
+  /**
+   * @brief Fills in the placeholders of this template into a string,
+   * replacing its contents, so that its memory can be reused for many URIs.
+   *
+   * @param appendCallback The function that appends the value of each
+   * placeholder to the string.
+   * @param result The string that receives the URI.
+   * @throws std::runtime_error If a placeholder of the template isn't closed.
+   */
+  void substitute(
+      const std::function<AppendCallbackSignature>& appendCallback,
+      std::string& result) const;
+
+  /**
+   * @brief Fills in the placeholders of this template, like
+   * {@link Uri::substituteTemplateParameters} does.
+   *
+   * @param substitutionCallback The function that returns the value of each
+   * placeholder.
+   * @return The URI.
+   * @throws std::runtime_error If a placeholder of the template isn't closed.
+   */
+  std::string
+  substitute(const std::function<Uri::SubstitutionCallbackSignature>&
+                 substitutionCallback) const;
+
+private:
+  std::string _template;
+  // The literal parts, one more than there are placeholders. Placeholder i is
+  // between literal parts i and i + 1.
+  std::vector<std::string> _literals{std::string()};
+  std::vector<std::string> _placeholders;
+  bool _hasUnclosedPlaceholder = false;
+};
 } // namespace CesiumUtility
@@ -0,0 +1,115 @@
+#include "CesiumUtility/Allocator.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace CesiumUtility {
+
+namespace {
+class DefaultAllocator : public IAllocator {
+public:
+  void* allocate(
+      size_t size,
+      size_t alignment,
+      AllocationCategory /* category */) override {
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      return ::operator new(size, std::align_val_t(alignment));
+    }
+    return ::operator new(size);
+  }
+
+  void deallocate(
+      void* pMemory,
+      size_t size,
+      size_t alignment,
+      AllocationCategory /* category */) noexcept override {
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      ::operator delete(pMemory, size, std::align_val_t(alignment));
+    } else {
+      ::operator delete(pMemory, size);
+    }
+  }
+};
+
+struct CategoryStatistics {
+  std::atomic<size_t> allocatedBytes{0};
+  std::atomic<size_t> peakAllocatedBytes{0};
+  std::atomic<size_t> allocationCount{0};
+  std::atomic<size_t> totalAllocationCount{0};
+};
+
+DefaultAllocator defaultAllocator;
+
+// The allocator that is set is kept alive here, and used through the atomic
+// pointer, so that allocating doesn't need to take the mutex.
+std::mutex allocatorMutex;
+std::shared_ptr<IAllocator> pCurrentAllocator;
+std::atomic<IAllocator*> pAllocator{&defaultAllocator};
+
+CategoryStatistics statistics[AllocationCategoryCount];
+
+CategoryStatistics& getStatistics(AllocationCategory category) noexcept {
+  return statistics[static_cast<size_t>(category)];
+}
+} // namespace
+
+void setAllocator(const std::shared_ptr<IAllocator>& pNewAllocator) {
+  std::lock_guard<std::mutex> lock(allocatorMutex);
+  pCurrentAllocator = pNewAllocator;
+  pAllocator = pNewAllocator ? pNewAllocator.get() : &defaultAllocator;
+}
+
+IAllocator& getAllocator() noexcept { return *pAllocator; }
+
+AllocationStatistics
+getAllocationStatistics(AllocationCategory category) noexcept {
+  const CategoryStatistics& categoryStatistics = getStatistics(category);
+  AllocationStatistics result;
+  result.allocatedBytes = categoryStatistics.allocatedBytes;
+  result.peakAllocatedBytes = categoryStatistics.peakAllocatedBytes;
+  result.allocationCount = categoryStatistics.allocationCount;
+  result.totalAllocationCount = categoryStatistics.totalAllocationCount;
+  return result;
+}
+
+void* allocateBytes(
+    size_t size,
+    size_t alignment,
+    AllocationCategory category) {
+  // The allocator is never asked for zero bytes, because what it returns for
+  // them varies between heaps.
+  void* pMemory =
+      getAllocator().allocate(size > 0 ? size : 1, alignment, category);
+
+  CategoryStatistics& categoryStatistics = getStatistics(category);
+  const size_t allocatedBytes =
+      categoryStatistics.allocatedBytes.fetch_add(size) + size;
+  size_t peakAllocatedBytes = categoryStatistics.peakAllocatedBytes;
+  while (allocatedBytes > peakAllocatedBytes &&
+         !categoryStatistics.peakAllocatedBytes.compare_exchange_weak(
+             peakAllocatedBytes,
+             allocatedBytes)) {
+  }
+  ++categoryStatistics.allocationCount;
+  ++categoryStatistics.totalAllocationCount;
+
+  return pMemory;
+}
+
+void deallocateBytes(
+    void* pMemory,
+    size_t size,
+    size_t alignment,
+    AllocationCategory category) noexcept {
+  if (!pMemory) {
+    return;
+  }
+
+  getAllocator().deallocate(pMemory, size > 0 ? size : 1, alignment, category);
+
+  CategoryStatistics& categoryStatistics = getStatistics(category);
+  categoryStatistics.allocatedBytes -= size;
+  --categoryStatistics.allocationCount;
+}
+
+} // namespace CesiumUtility
@@ -0,0 +1,61 @@
+#include "CesiumUtility/AttributeCompression.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace CesiumUtility {
+
+void AttributeCompression::octDecode(
+    const gsl::span<const glm::u8vec2>& encoded,
+    const gsl::span<glm::vec3>& result) noexcept {
+  assert(result.size() >= encoded.size());
+
+  constexpr float fromSNorm = 2.0f / 255.0f;
+  const glm::u8vec2* pEncoded = encoded.data();
+  glm::vec3* pResult = result.data();
+  const size_t count = encoded.size();
+
+  for (size_t i = 0; i < count; ++i) {
+    // 8-bit values are always in the SNORM range, so they don't need to be
+    // clamped like Math::fromSNorm does.
+    float x = static_cast<float>(pEncoded[i].x) * fromSNorm - 1.0f;
+    float y = static_cast<float>(pEncoded[i].y) * fromSNorm - 1.0f;
+    const float z = 1.0f - (std::abs(x) + std::abs(y));
+
+    // Fold the lower hemisphere like octDecodeInRange does, but with selects
+    // instead of a branch. When z < 0, moving x and y towards zero by -z gives
+    // (1 - |y|) * signNotZero(x) and (1 - |x|) * signNotZero(y).
+    const float t = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+
+    const float inverseLength = 1.0f / std::sqrt(x * x + y * y + z * z);
+    pResult[i] = glm::vec3(x, y, z) * inverseLength;
+  }
+}
+
+void AttributeCompression::decodeRGB565(
+    const gsl::span<const uint16_t>& encoded,
+    const gsl::span<glm::vec3>& result) noexcept {
+  assert(result.size() >= encoded.size());
+
+  constexpr uint16_t mask5 = (1 << 5) - 1;
+  constexpr uint16_t mask6 = (1 << 6) - 1;
+  constexpr float normalize5 = 1.0f / 31.0f; // normalize [0, 31] to [0, 1]
+  constexpr float normalize6 = 1.0f / 63.0f; // normalize [0, 63] to [0, 1]
+
+  const uint16_t* pEncoded = encoded.data();
+  glm::vec3* pResult = result.data();
+  const size_t count = encoded.size();
+
+  for (size_t i = 0; i < count; ++i) {
+    const uint16_t value = pEncoded[i];
+    pResult[i] = glm::vec3(
+        static_cast<float>(value >> 11) * normalize5,
+        static_cast<float>((value >> 5) & mask6) * normalize6,
+        static_cast<float>(value & mask5) * normalize5);
+  }
+}
+
+} // namespace CesiumUtility
@@ -10,17 +10,18 @@ Credit CreditSystem::createCredit(const std::string& html, bool showOnScreen) {
 
 Credit CreditSystem::createCredit(std::string&& html, bool showOnScreen) {
   // if this credit already exists, return a Credit handle to it
-  for (size_t id = 0; id < _credits.size(); ++id) {
-    if (_credits[id].html == html) {
-      // Override the existing credit's showOnScreen value.
-      _credits[id].showOnScreen = showOnScreen;
-      return Credit(id);
-    }
+  auto idIt = _creditIdsByHtml.find(html);
+  if (idIt != _creditIdsByHtml.end()) {
+    // Override the existing credit's showOnScreen value.
+    _credits[idIt->second].showOnScreen = showOnScreen;
+    return Credit(idIt->second);
   }
 
+  const size_t id = _credits.size();
+  _creditIdsByHtml.emplace(html, id);
   _credits.push_back({std::move(html), showOnScreen, -1, 0});
 
-  return Credit(_credits.size() - 1);
+  return Credit(id);
 }
 
 bool CreditSystem::shouldBeShownOnScreen(Credit credit) const noexcept {
@@ -54,23 +55,25 @@ void CreditSystem::addCreditToFrame(Credit credit) {
   // add the credit to this frame
   _creditsToShowThisFrame.push_back(credit);
 
-  // if the credit was shown last frame, remove it from
+  // if the credit was shown last frame, it has to be removed from
   // _creditsToNoLongerShowThisFrame since it will still be shown
   if (_credits[credit.id].lastFrameNumber == _currentFrameNumber - 1) {
-    _creditsToNoLongerShowThisFrame.erase(
-        std::remove(
-            _creditsToNoLongerShowThisFrame.begin(),
-            _creditsToNoLongerShowThisFrame.end(),
-            credit),
-        _creditsToNoLongerShowThisFrame.end());
+    _creditsToNoLongerShowThisFrameAreStale = true;
   }
 
   // update the last frame this credit was shown
   _credits[credit.id].lastFrameNumber = _currentFrameNumber;
 }
 
+void CreditSystem::addCreditsToFrame(const gsl::span<const Credit>& credits) {
+  for (const Credit& credit : credits) {
+    this->addCreditToFrame(credit);
+  }
+}
+
 void CreditSystem::startNextFrame() noexcept {
   _creditsToNoLongerShowThisFrame.swap(_creditsToShowThisFrame);
+  _creditsToNoLongerShowThisFrameAreStale = false;
   _creditsToShowThisFrame.clear();
   _currentFrameNumber++;
   for (const auto& credit : _creditsToNoLongerShowThisFrame) {
@@ -78,6 +81,24 @@ void CreditSystem::startNextFrame() noexcept {
   }
 }
 
+const std::vector<Credit>&
+CreditSystem::getCreditsToNoLongerShowThisFrame() const noexcept {
+  // remove the credits that have been added to this frame again
+  if (_creditsToNoLongerShowThisFrameAreStale) {
+    _creditsToNoLongerShowThisFrame.erase(
+        std::remove_if(
+            _creditsToNoLongerShowThisFrame.begin(),
+            _creditsToNoLongerShowThisFrame.end(),
+            [this](const Credit& credit) {
+              return _credits[credit.id].lastFrameNumber ==
+                     _currentFrameNumber;
+            }),
+        _creditsToNoLongerShowThisFrame.end());
+    _creditsToNoLongerShowThisFrameAreStale = false;
+  }
+  return _creditsToNoLongerShowThisFrame;
+}
+
 const std::vector<Credit>& CreditSystem::getCreditsToShowThisFrame() noexcept {
   // sort credits based on the number of occurrences
   if (_creditsToShowThisFrame.size() < 2) {
@@ -2,6 +2,10 @@
 #define ZLIB_CONST
 #include "zlib.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
 #define CHUNK 65536
 
 bool CesiumUtility::isGzip(const gsl::span<const std::byte>& data) {
@@ -11,18 +15,28 @@ bool CesiumUtility::isGzip(const gsl::span<const std::byte>& data) {
   return data[0] == std::byte{31} && data[1] == std::byte{139};
 }
 
-bool CesiumUtility::gunzip(
+namespace {
+// The largest ratio of inflated to deflated size that deflate can achieve.
+const size_t maximumDeflateRatio = 1032;
+
+template <typename TVector>
+bool inflateWithWindowBits(
     const gsl::span<const std::byte>& data,
-    std::vector<std::byte>& out) {
+    TVector& out,
+    int windowBits,
+    size_t expectedSize) {
+  if (data.size() > std::numeric_limits<uInt>::max()) {
+    return false;
+  }
+
   int ret;
-  unsigned int index = 0;
   z_stream strm;
   strm.zalloc = Z_NULL;
   strm.zfree = Z_NULL;
   strm.opaque = Z_NULL;
   strm.avail_in = 0;
   strm.next_in = Z_NULL;
-  ret = inflateInit2(&strm, 16 + MAX_WBITS);
+  ret = inflateInit2(&strm, windowBits);
   if (ret != Z_OK) {
     return false;
   }
@@ -30,10 +44,26 @@ bool CesiumUtility::gunzip(
   strm.avail_in = static_cast<uInt>(data.size());
   strm.next_in = reinterpret_cast<const Bytef*>(data.data());
 
+  // Inflate into a buffer of the expected size, so that the data is usually
+  // inflated in one step. The expected size comes from the data, so it is
+  // limited to what the data could really inflate to, and the buffer grows
+  // if it turns out to be too small.
+  const size_t maximumSize =
+      data.size() > std::numeric_limits<size_t>::max() / maximumDeflateRatio
+          ? std::numeric_limits<size_t>::max()
+          : data.size() * maximumDeflateRatio;
+  size_t index = 0;
+  out.resize(expectedSize > 0 ? std::min(expectedSize, maximumSize) : CHUNK);
+
   do {
-    out.resize(index + CHUNK);
+    if (index == out.size()) {
+      out.resize(index + CHUNK);
+    }
+    const uInt available = static_cast<uInt>(std::min<size_t>(
+        out.size() - index,
+        std::numeric_limits<uInt>::max()));
     strm.next_out = reinterpret_cast<Bytef*>(&out[index]);
-    strm.avail_out = CHUNK;
+    strm.avail_out = available;
     ret = inflate(&strm, Z_NO_FLUSH);
     switch (ret) {
     case Z_NEED_DICT:
@@ -41,11 +71,98 @@ bool CesiumUtility::gunzip(
     case Z_MEM_ERROR:
       inflateEnd(&strm);
       return false;
+    case Z_BUF_ERROR:
+      // The data ended before the end of the stream.
+      if (strm.avail_in == 0) {
+        inflateEnd(&strm);
+        return false;
+      }
+      break;
     }
-    index += CHUNK - strm.avail_out;
+    index += available - strm.avail_out;
   } while (ret != Z_STREAM_END);
 
   inflateEnd(&strm);
   out.resize(index);
   return true;
 }
+
+size_t getGzipInflatedSize(const gsl::span<const std::byte>& data) {
+  // The gzip trailer ends with the inflated size, modulo 2^32.
+  size_t expectedSize = 0;
+  if (data.size() >= 18) {
+    const size_t end = data.size();
+    expectedSize = std::to_integer<size_t>(data[end - 4]) |
+                   std::to_integer<size_t>(data[end - 3]) << 8 |
+                   std::to_integer<size_t>(data[end - 2]) << 16 |
+                   std::to_integer<size_t>(data[end - 1]) << 24;
+  }
+  return expectedSize;
+}
+} // namespace
+
+bool CesiumUtility::gunzip(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out) {
+  return inflateWithWindowBits(
+      data,
+      out,
+      16 + MAX_WBITS,
+      getGzipInflatedSize(data));
+}
+
+bool CesiumUtility::gunzip(
+    const gsl::span<const std::byte>& data,
+    ByteVector& out) {
+  return inflateWithWindowBits(
+      data,
+      out,
+      16 + MAX_WBITS,
+      getGzipInflatedSize(data));
+}
+
+bool CesiumUtility::inflateRaw(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out,
+    size_t inflatedSize) {
+  return inflateWithWindowBits(data, out, -MAX_WBITS, inflatedSize);
+}
+
+bool CesiumUtility::gzip(
+    const gsl::span<const std::byte>& data,
+    std::vector<std::byte>& out,
+    int level) {
+  if (data.size() > std::numeric_limits<uInt>::max()) {
+    return false;
+  }
+
+  z_stream strm;
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+  int ret = deflateInit2(
+      &strm,
+      level,
+      Z_DEFLATED,
+      16 + MAX_WBITS,
+      8,
+      Z_DEFAULT_STRATEGY);
+  if (ret != Z_OK) {
+    return false;
+  }
+
+  // Compress in one step, into a buffer that is large enough for any result.
+  out.resize(deflateBound(&strm, static_cast<uLong>(data.size())));
+  strm.avail_in = static_cast<uInt>(data.size());
+  strm.next_in = reinterpret_cast<const Bytef*>(data.data());
+  strm.avail_out = static_cast<uInt>(out.size());
+  strm.next_out = reinterpret_cast<Bytef*>(out.data());
+  ret = deflate(&strm, Z_FINISH);
+  deflateEnd(&strm);
+  if (ret != Z_STREAM_END) {
+    return false;
+  }
+
+  out.resize(strm.total_out);
+  return true;
+}
@@ -5,12 +5,72 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <ostream>
 
 #if CESIUM_TRACING_ENABLED
 
 namespace CesiumUtility {
 namespace CesiumImpl {
 
+namespace {
+// The number of events that each thread keeps until they are flushed. When a
+// thread records more events than this, its oldest events are dropped.
+constexpr size_t eventsPerThread = 8192;
+
+// Longer names are truncated, so that events can be stored without
+// allocating.
+constexpr size_t maximumNameLength = 63;
+
+int64_t getCurrentTime() {
+  return std::chrono::time_point_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now())
+      .time_since_epoch()
+      .count();
+}
+
+void writeJsonString(std::ostream& output, const char* value) {
+  output << '"';
+  for (const char* p = value; *p != '\0'; ++p) {
+    const char c = *p;
+    if (c == '"' || c == '\\') {
+      output << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      output << ' ';
+    } else {
+      output << c;
+    }
+  }
+  output << '"';
+}
+} // namespace
+
+struct Tracer::ThreadBuffer {
+  struct Event {
+    int64_t timestamp;
+    int64_t duration;
+    int64_t id;
+    char type;
+    char name[maximumNameLength + 1];
+  };
+
+  explicit ThreadBuffer(uint32_t threadIndex_)
+      : threadIndex(threadIndex_), events(eventsPerThread), head(0), tail(0) {}
+
+  uint32_t threadIndex;
+  std::vector<Event> events;
+
+  // The number of events that have ever been recorded in this buffer. Only
+  // the thread that owns the buffer changes it.
+  std::atomic<uint64_t> head;
+
+  // The number of events that have been flushed, guarded by Tracer::_lock.
+  uint64_t tail;
+};
+
+/*static*/ thread_local std::shared_ptr<Tracer::ThreadBuffer>
+    Tracer::_pThreadBuffer{};
+
 Tracer& Tracer::instance() {
   static Tracer instance;
   return instance;
@@ -19,72 +79,108 @@ Tracer& Tracer::instance() {
 Tracer::~Tracer() { endTracing(); }
 
 void Tracer::startTracing(const std::string& filePath) {
+  std::lock_guard<std::mutex> lock(this->_lock);
+  if (this->_output.is_open()) {
+    return;
+  }
+
   this->_output.open(filePath);
   this->_output << "{\"otherData\": {},\"traceEvents\":[";
+  this->_numTraces = 0;
+  this->_previousTerminateHandler = std::set_terminate(&Tracer::onTerminate);
+  this->setEnabled(true);
 }
 
 void Tracer::endTracing() {
-  this->_output << "]}";
-  this->_output.close();
-}
-
-void Tracer::writeCompleteEvent(const Trace& trace) {
-  std::lock_guard<std::mutex> lock(_lock);
-  if (!this->_output) {
+  std::lock_guard<std::mutex> lock(this->_lock);
+  if (!this->_output.is_open()) {
     return;
   }
 
-  // Chrome tracing wants the text like this
-  if (this->_numTraces++ > 0) {
-    this->_output << ",";
+  this->closeOutput();
+  std::set_terminate(this->_previousTerminateHandler);
+  this->_previousTerminateHandler = nullptr;
+}
+
+void Tracer::setEnabled(bool enabled) noexcept {
+  this->_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::flush() {
+  std::lock_guard<std::mutex> lock(this->_lock);
+  this->writeBufferedEvents();
+}
+
+void Tracer::writeCompleteEvent(
+    const char* name,
+    int64_t start,
+    int64_t duration) {
+  if (!this->isEnabled()) {
+    return;
   }
 
-  this->_output << "{";
-  this->_output << "\"cat\":\"cesium\",";
-  this->_output << "\"dur\":" << trace.duration << ',';
-  this->_output << "\"name\":\"" << trace.name << "\",";
-  this->_output << "\"ph\":\"X\",";
-  this->_output << "\"pid\":0,";
-  this->_output << "\"tid\":" << trace.threadID << ",";
-  this->_output << "\"ts\":" << trace.start;
-  this->_output << "}";
+  this->writeEvent(name, 'X', start, duration, -1);
 }
 
 void Tracer::writeAsyncEventBegin(const char* name, int64_t id) {
-  this->writeAsyncEvent("cesium", name, 'b', id);
+  this->writeAsyncEvent(name, 'b', id);
 }
 
 void Tracer::writeAsyncEventBegin(const char* name) {
+  if (!this->isEnabled()) {
+    return;
+  }
+
   this->writeAsyncEventBegin(name, this->getCurrentThreadTrackID());
 }
 
 void Tracer::writeAsyncEventEnd(const char* name, int64_t id) {
-  this->writeAsyncEvent("cesium", name, 'e', id);
+  this->writeAsyncEvent(name, 'e', id);
 }
 
 void Tracer::writeAsyncEventEnd(const char* name) {
+  if (!this->isEnabled()) {
+    return;
+  }
+
   this->writeAsyncEventEnd(name, this->getCurrentThreadTrackID());
 }
 
 int64_t Tracer::allocateTrackID() { return ++this->_lastAllocatedID; }
 
-Tracer::Tracer() : _output{}, _numTraces{0}, _lock{}, _lastAllocatedID(0) {}
+Tracer::Tracer()
+    : _output{},
+      _numTraces{0},
+      _lock{},
+      _enabled{false},
+      _buffersLock{},
+      _buffers{},
+      _lastThreadIndex{0},
+      _previousTerminateHandler{nullptr},
+      _lastAllocatedID(0) {}
 
 int64_t Tracer::getCurrentThreadTrackID() const {
   const TrackReference* pTrack = TrackReference::current();
   return pTrack->getTracingID();
 }
 
-void Tracer::writeAsyncEvent(
-    const char* category,
-    const char* name,
-    char type,
-    int64_t id) {
+Tracer::ThreadBuffer& Tracer::getCurrentThreadBuffer() {
+  if (!Tracer::_pThreadBuffer) {
+    std::lock_guard<std::mutex> lock(this->_buffersLock);
+    Tracer::_pThreadBuffer =
+        std::make_shared<ThreadBuffer>(++this->_lastThreadIndex);
+    this->_buffers.emplace_back(Tracer::_pThreadBuffer);
+  }
+  return *Tracer::_pThreadBuffer;
+}
+
+void Tracer::writeAsyncEvent(const char* name, char type, int64_t id) {
+  if (!this->isEnabled()) {
+    return;
+  }
 
-  bool isAsync = true;
   if (id < 0) {
     // Use a standard Duration event for slices without an async ID.
-    isAsync = false;
     if (type == 'b') {
       type = 'B';
     } else if (type == 'e') {
@@ -92,43 +188,146 @@ void Tracer::writeAsyncEvent(
     }
   }
 
-  std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
-  int64_t microseconds =
-      std::chrono::time_point_cast<std::chrono::microseconds>(time)
-          .time_since_epoch()
-          .count();
+  this->writeEvent(name, type, getCurrentTime(), 0, id);
+}
 
-  std::lock_guard<std::mutex> lock(_lock);
-  if (!this->_output) {
+void Tracer::writeEvent(
+    const char* name,
+    char type,
+    int64_t timestamp,
+    int64_t duration,
+    int64_t id) {
+  ThreadBuffer& buffer = this->getCurrentThreadBuffer();
+
+  // Only this thread writes to the buffer, so the event can be filled in
+  // place and then published by advancing the head.
+  const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+  ThreadBuffer::Event& event = buffer.events[head % eventsPerThread];
+  event.timestamp = timestamp;
+  event.duration = duration;
+  event.id = id;
+  event.type = type;
+
+  size_t length = 0;
+  while (length < maximumNameLength && name[length] != '\0') {
+    event.name[length] = name[length];
+    ++length;
+  }
+  event.name[length] = '\0';
+
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Tracer::writeBufferedEvents() {
+  if (!this->_output.is_open()) {
     return;
   }
 
-  // Chrome tracing wants the text like this
-  if (this->_numTraces++ > 0) {
-    this->_output << ",";
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lock(this->_buffersLock);
+    buffers = this->_buffers;
+
+    // Forget the buffers of threads that have exited once they are flushed.
+    this->_buffers.erase(
+        std::remove_if(
+            this->_buffers.begin(),
+            this->_buffers.end(),
+            [](const std::shared_ptr<ThreadBuffer>& pBuffer) {
+              return pBuffer.use_count() == 2;
+            }),
+        this->_buffers.end());
   }
-  this->_output << "{";
-  this->_output << "\"cat\":\"" << category << "\",";
-  if (isAsync) {
-    this->_output << "\"id\":" << id << ",";
-  } else {
-    this->_output << "\"tid\":" << std::this_thread::get_id() << ",";
+
+  std::vector<ThreadBuffer::Event> events;
+  for (const std::shared_ptr<ThreadBuffer>& pBuffer : buffers) {
+    ThreadBuffer& buffer = *pBuffer;
+    const uint64_t head = buffer.head.load(std::memory_order_acquire);
+    const uint64_t first = std::max(
+        buffer.tail,
+        head > eventsPerThread ? head - eventsPerThread : 0);
+
+    events.clear();
+    for (uint64_t i = first; i < head; ++i) {
+      events.emplace_back(buffer.events[i % eventsPerThread]);
+    }
+    buffer.tail = head;
+
+    // The owning thread may have overwritten the oldest of the copied events
+    // in the meantime, so skip those.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t newHead = buffer.head.load(std::memory_order_relaxed);
+    const uint64_t valid =
+        newHead >= eventsPerThread ? newHead - eventsPerThread + 1 : 0;
+    const size_t skip =
+        valid > first ? size_t(std::min(valid, head) - first) : 0;
+
+    for (size_t i = skip; i < events.size(); ++i) {
+      const ThreadBuffer::Event& event = events[i];
+
+      // Chrome tracing wants the text like this
+      if (this->_numTraces++ > 0) {
+        this->_output << ",";
+      }
+      this->_output << "{";
+      this->_output << "\"cat\":\"cesium\",";
+      if (event.type == 'X') {
+        this->_output << "\"dur\":" << event.duration << ',';
+      }
+      if (event.type == 'b' || event.type == 'e') {
+        this->_output << "\"id\":" << event.id << ",";
+      } else {
+        this->_output << "\"tid\":" << buffer.threadIndex << ",";
+      }
+      this->_output << "\"name\":";
+      writeJsonString(this->_output, event.name);
+      this->_output << ",";
+      this->_output << "\"ph\":\"" << event.type << "\",";
+      this->_output << "\"pid\":0,";
+      this->_output << "\"ts\":" << event.timestamp;
+      this->_output << "}";
+    }
   }
-  this->_output << "\"name\":\"" << name << "\",";
-  this->_output << "\"ph\":\"" << type << "\",";
-  this->_output << "\"pid\":0,";
-  this->_output << "\"ts\":" << microseconds;
-  this->_output << "}";
+
+  this->_output.flush();
 }
 
-ScopedTrace::ScopedTrace(const std::string& message)
-    : _name{message},
-      _startTime{std::chrono::steady_clock::now()},
-      _threadId{std::this_thread::get_id()},
-      _reset{false} {
-  CESIUM_TRACE_BEGIN_IN_TRACK(_name.c_str());
+void Tracer::closeOutput() {
+  this->setEnabled(false);
+  this->writeBufferedEvents();
+  this->_output << "]}";
+  this->_output.close();
+}
+
+/*static*/ void Tracer::onTerminate() {
+  Tracer& tracer = Tracer::instance();
+  const std::terminate_handler previousHandler =
+      tracer._previousTerminateHandler;
+
+  // Don't wait for a flush that may have been interrupted by the failure.
+  std::unique_lock<std::mutex> lock(tracer._lock, std::try_to_lock);
+  if (lock && tracer._output.is_open()) {
+    tracer.closeOutput();
+  }
+
+  if (previousHandler) {
+    previousHandler();
+  }
+  std::abort();
+}
+
+ScopedTrace::ScopedTrace(const char* message)
+    : _name{}, _startTime{}, _reset{!Tracer::instance().isEnabled()} {
+  if (!this->_reset) {
+    this->_name = message;
+    this->_startTime = std::chrono::steady_clock::now();
+    CESIUM_TRACE_BEGIN_IN_TRACK(_name.c_str());
+  }
 }
 
+ScopedTrace::ScopedTrace(const std::string& message)
+    : ScopedTrace(message.c_str()) {}
+
 ScopedTrace::~ScopedTrace() {
   if (!this->_reset) {
     this->reset();
@@ -151,7 +350,9 @@ void ScopedTrace::reset() {
             .time_since_epoch()
             .count();
     Tracer::instance().writeCompleteEvent(
-        {this->_name, start, end - start, this->_threadId});
+        this->_name.c_str(),
+        start,
+        end - start);
   }
 }
 
@@ -8,6 +8,7 @@
 #include <cstring>
 #include <filesystem>
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
 namespace CesiumUtility {
@@ -425,4 +426,194 @@ std::string Uri::setPath(const std::string& uri, const std::string& newPath) {
   return result;
 }
 
+namespace {
+bool isPlainPathCharacter(char c) noexcept {
+  if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+      (c >= '0' && c <= '9')) {
+    return true;
+  }
+
+  // The other unreserved characters and the sub-delimiters, along with the
+  // path and query separators. A colon is left out, because in the first
+  // segment it would end a scheme.
+  switch (c) {
+  case '-':
+  case '.':
+  case '_':
+  case '~':
+  case '!':
+  case '$':
+  case '&':
+  case '\'':
+  case '(':
+  case ')':
+  case '*':
+  case '+':
+  case ',':
+  case ';':
+  case '=':
+  case '@':
+  case '/':
+  case '?':
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Whether resolving the given relative URI against a normalized base only
+// appends it to the directory of the base. This is the case for relative paths
+// without dot segments, percent-encoded characters or a fragment.
+bool isPlainRelativePath(const std::string& relative) noexcept {
+  if (relative.empty() || relative[0] == '/' || relative[0] == '?') {
+    return false;
+  }
+
+  size_t pathEnd = relative.size();
+  for (size_t i = 0; i < relative.size(); ++i) {
+    const char c = relative[i];
+    if (!isPlainPathCharacter(c)) {
+      return false;
+    }
+    if (c == '?' && pathEnd == relative.size()) {
+      pathEnd = i;
+    }
+  }
+
+  size_t segmentStart = 0;
+  for (size_t i = 0; i <= pathEnd; ++i) {
+    if (i == pathEnd || relative[i] == '/') {
+      const std::string_view segment(
+          relative.data() + segmentStart,
+          i - segmentStart);
+      if (segment == "." || segment == "..") {
+        return false;
+      }
+      segmentStart = i + 1;
+    }
+  }
+
+  return true;
+}
+} // namespace
+
+BaseUri::BaseUri(const std::string& base, bool assumeHttpsDefault)
+    : _base(base), _assumeHttpsDefault(assumeHttpsDefault) {
+  // Resolving an empty reference gives the normalized base, without its
+  // fragment. Relative paths can only be appended to a base that is already
+  // normalized, because otherwise the normalization could change the base part
+  // of the result, too.
+  const std::string normalized =
+      Uri::resolve(base, "", false, assumeHttpsDefault);
+  const std::string conformedBase = cesiumConformUrl(base, assumeHttpsDefault);
+  if (normalized.empty() ||
+      normalized != conformedBase.substr(0, conformedBase.find('#'))) {
+    return;
+  }
+
+  // The directory must be in the path, after the authority.
+  const size_t queryStart = normalized.find('?');
+  const size_t authorityStart = normalized.find("://");
+  if (authorityStart == std::string::npos || authorityStart > queryStart) {
+    return;
+  }
+  const size_t pathStart = normalized.find('/', authorityStart + 3);
+  if (pathStart == std::string::npos || pathStart > queryStart) {
+    return;
+  }
+
+  const size_t lastSlash = normalized.rfind('/', queryStart);
+  this->_directory = normalized.substr(0, lastSlash + 1);
+  if (queryStart != std::string::npos) {
+    this->_query = normalized.substr(queryStart + 1);
+  }
+}
+
+std::string
+BaseUri::resolve(const std::string& relative, bool useBaseQuery) const {
+  std::string result;
+  this->resolve(relative, result, useBaseQuery);
+  return result;
+}
+
+void BaseUri::resolve(
+    const std::string& relative,
+    std::string& result,
+    bool useBaseQuery) const {
+  if (this->_directory.empty() || !isPlainRelativePath(relative)) {
+    result = Uri::resolve(
+        this->_base,
+        relative,
+        useBaseQuery,
+        this->_assumeHttpsDefault);
+    return;
+  }
+
+  result.assign(this->_directory);
+  result.append(relative);
+
+  if (useBaseQuery && !this->_query.empty()) {
+    result += relative.find('?') != std::string::npos ? '&' : '?';
+    result += this->_query;
+  }
+}
+
+UriTemplate::UriTemplate(const std::string& templateUri)
+    : _template(templateUri) {
+  size_t startPos = 0;
+  size_t nextPos;
+
+  // Find the start of a parameter
+  while ((nextPos = templateUri.find('{', startPos)) != std::string::npos) {
+    this->_literals.back().append(templateUri, startPos, nextPos - startPos);
+
+    // Find the end of this parameter
+    ++nextPos;
+    const size_t endPos = templateUri.find('}', nextPos);
+    if (endPos == std::string::npos) {
+      // Like Uri::substituteTemplateParameters, this is only reported when the
+      // template is filled in.
+      this->_hasUnclosedPlaceholder = true;
+      return;
+    }
+
+    this->_placeholders.emplace_back(
+        templateUri.substr(nextPos, endPos - nextPos));
+    this->_literals.emplace_back();
+
+    startPos = endPos + 1;
+  }
+
+  this->_literals.back().append(
+      templateUri,
+      startPos,
+      templateUri.length() - startPos);
+}
+
+void UriTemplate::substitute(
+    const std::function<AppendCallbackSignature>& appendCallback,
+    std::string& result) const {
+  if (this->_hasUnclosedPlaceholder) {
+    throw std::runtime_error("Unclosed template parameter");
+  }
+
+  result.assign(this->_literals[0]);
+  for (size_t i = 0; i < this->_placeholders.size(); ++i) {
+    appendCallback(this->_placeholders[i], result);
+    result.append(this->_literals[i + 1]);
+  }
+}
+
+std::string UriTemplate::substitute(
+    const std::function<Uri::SubstitutionCallbackSignature>&
+        substitutionCallback) const {
+  std::string result;
+  this->substitute(
+      [&substitutionCallback](
+          const std::string& placeholder,
+          std::string& uri) { uri.append(substitutionCallback(placeholder)); },
+      result);
+  return result;
+}
+
 } // namespace CesiumUtility
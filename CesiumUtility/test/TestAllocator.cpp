@@ -0,0 +1,100 @@
+#include <CesiumUtility/Allocator.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+using namespace CesiumUtility;
+
+namespace {
+class CountingAllocator : public IAllocator {
+public:
+  void* allocate(size_t size, size_t alignment, AllocationCategory category)
+      override {
+    ++this->allocations;
+    this->bytes += size;
+    this->lastCategory = category;
+    return getDefaultAllocator().allocate(size, alignment, category);
+  }
+
+  void deallocate(
+      void* pMemory,
+      size_t size,
+      size_t alignment,
+      AllocationCategory category) noexcept override {
+    --this->allocations;
+    this->bytes -= size;
+    getDefaultAllocator().deallocate(pMemory, size, alignment, category);
+  }
+
+  static IAllocator& getDefaultAllocator() {
+    static IAllocator& defaultAllocator = getAllocator();
+    return defaultAllocator;
+  }
+
+  int64_t allocations = 0;
+  size_t bytes = 0;
+  AllocationCategory lastCategory = AllocationCategory::Other;
+};
+} // namespace
+
+TEST_CASE("Allocator") {
+  SECTION("accounts for the bytes of each category") {
+    const AllocationStatistics before =
+        getAllocationStatistics(AllocationCategory::GltfBuffer);
+    {
+      ByteVector data(1000, AllocationCategory::GltfBuffer);
+      const AllocationStatistics during =
+          getAllocationStatistics(AllocationCategory::GltfBuffer);
+      CHECK(during.allocatedBytes == before.allocatedBytes + 1000);
+      CHECK(during.allocationCount == before.allocationCount + 1);
+      CHECK(during.totalAllocationCount == before.totalAllocationCount + 1);
+      CHECK(during.peakAllocatedBytes >= during.allocatedBytes);
+    }
+    const AllocationStatistics after =
+        getAllocationStatistics(AllocationCategory::GltfBuffer);
+    CHECK(after.allocatedBytes == before.allocatedBytes);
+    CHECK(after.allocationCount == before.allocationCount);
+    CHECK(after.totalAllocationCount == before.totalAllocationCount + 1);
+  }
+
+  SECTION("keeps the category of moved and copied vectors") {
+    ByteVector source(100, AllocationCategory::ImagePixels);
+    ByteVector target(AllocationCategory::GltfBuffer);
+
+    target = source;
+    CHECK(
+        target.get_allocator().getCategory() ==
+        AllocationCategory::ImagePixels);
+
+    ByteVector moved(AllocationCategory::GltfBuffer);
+    moved = std::move(source);
+    CHECK(
+        moved.get_allocator().getCategory() ==
+        AllocationCategory::ImagePixels);
+    CHECK(moved.size() == 100);
+  }
+
+  SECTION("allocates from the allocator that is set") {
+    std::shared_ptr<CountingAllocator> pCounting =
+        std::make_shared<CountingAllocator>();
+    CountingAllocator::getDefaultAllocator();
+    setAllocator(pCounting);
+
+    {
+      ByteVector data(256, AllocationCategory::DecompressedResponse);
+      CHECK(pCounting->allocations == 1);
+      CHECK(pCounting->bytes == 256);
+      CHECK(
+          pCounting->lastCategory == AllocationCategory::DecompressedResponse);
+    }
+    CHECK(pCounting->allocations == 0);
+    CHECK(pCounting->bytes == 0);
+
+    setAllocator(nullptr);
+    CHECK(&getAllocator() == &CountingAllocator::getDefaultAllocator());
+  }
+}
@@ -67,3 +67,40 @@ TEST_CASE("AttributeCompression::decodeRGB565") {
     CHECK(Math::equalsEpsilon(value, expected[i], Math::Epsilon6));
   }
 }
+
+TEST_CASE("AttributeCompression::octDecode for many vectors") {
+  std::vector<glm::u8vec2> input;
+  for (uint32_t x = 0; x <= 255; ++x) {
+    for (uint32_t y = 0; y <= 255; ++y) {
+      input.emplace_back(static_cast<uint8_t>(x), static_cast<uint8_t>(y));
+    }
+  }
+
+  std::vector<glm::vec3> result(input.size());
+  AttributeCompression::octDecode(input, result);
+
+  for (size_t i = 0; i < input.size(); i++) {
+    const glm::dvec3 expected =
+        AttributeCompression::octDecode(input[i].x, input[i].y);
+    REQUIRE(Math::equalsEpsilon(
+        glm::dvec3(result[i]),
+        expected,
+        Math::Epsilon6,
+        Math::Epsilon6));
+  }
+}
+
+TEST_CASE("AttributeCompression::decodeRGB565 for many colors") {
+  std::vector<uint16_t> input(65536);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = static_cast<uint16_t>(i);
+  }
+
+  std::vector<glm::vec3> result(input.size());
+  AttributeCompression::decodeRGB565(input, result);
+
+  for (size_t i = 0; i < input.size(); i++) {
+    REQUIRE(
+        result[i] == glm::vec3(AttributeCompression::decodeRGB565(input[i])));
+  }
+}
@@ -0,0 +1,62 @@
+#include <CesiumUtility/ExtensibleObject.h>
+#include <CesiumUtility/JsonValue.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace CesiumUtility;
+
+namespace {
+struct ExtensionA : public ExtensibleObject {
+  static inline constexpr const char* ExtensionName = "A";
+  int value = 1;
+};
+
+struct ExtensionB : public ExtensibleObject {
+  static inline constexpr const char* ExtensionName = "B";
+  std::string value = "b";
+};
+} // namespace
+
+TEST_CASE("ExtensibleObject") {
+  ExtensibleObject object;
+  CHECK(object.extensions.capacity() == 0);
+  CHECK(!object.hasExtension<ExtensionA>());
+  CHECK(object.getExtension<ExtensionA>() == nullptr);
+
+  SECTION("adds and gets statically-typed extensions") {
+    ExtensionB& b = object.addExtension<ExtensionB>();
+    b.value = "changed";
+    object.addExtension<ExtensionA>().value = 2;
+
+    CHECK(object.extensions.size() == 2);
+    CHECK(object.hasExtension<ExtensionA>());
+    REQUIRE(object.getExtension<ExtensionA>());
+    CHECK(object.getExtension<ExtensionA>()->value == 2);
+    REQUIRE(object.getExtension<ExtensionB>());
+    CHECK(object.getExtension<ExtensionB>()->value == "changed");
+
+    // Adding an extension that exists returns the existing one.
+    CHECK(object.addExtension<ExtensionA>().value == 2);
+    CHECK(object.extensions.size() == 2);
+
+    object.removeExtension<ExtensionA>();
+    CHECK(!object.hasExtension<ExtensionA>());
+    CHECK(object.hasExtension<ExtensionB>());
+  }
+
+  SECTION("keeps generic extensions apart from statically-typed ones") {
+    object.extensions.emplace("A", JsonValue(JsonValue::Object{{"x", 3}}));
+    CHECK(object.hasExtension<ExtensionA>());
+    CHECK(object.getExtension<ExtensionA>() == nullptr);
+
+    const JsonValue* pGeneric = object.getGenericExtension("A");
+    REQUIRE(pGeneric);
+    CHECK(pGeneric->getSafeNumericalValueForKey<int64_t>("x") == 3);
+
+    object.addExtension<ExtensionB>();
+    CHECK(object.getGenericExtension("B") == nullptr);
+  }
+}
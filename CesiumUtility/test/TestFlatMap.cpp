@@ -0,0 +1,95 @@
+#include <CesiumUtility/FlatMap.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace CesiumUtility;
+
+namespace {
+std::vector<std::string> getKeys(const FlatMap<std::string, int>& map) {
+  std::vector<std::string> keys;
+  for (const auto& [key, value] : map) {
+    keys.emplace_back(key);
+  }
+  return keys;
+}
+} // namespace
+
+TEST_CASE("FlatMap") {
+  SECTION("keeps its entries sorted by their keys") {
+    FlatMap<std::string, int> map;
+    CHECK(map.emplace("b", 2).second);
+    CHECK(map.emplace("d", 4).second);
+    CHECK(map.try_emplace("a", 1).second);
+    map["c"] = 3;
+    CHECK(getKeys(map) == std::vector<std::string>{"a", "b", "c", "d"});
+    CHECK(map.size() == 4);
+  }
+
+  SECTION("keeps the first entry with a key, like std::map") {
+    FlatMap<std::string, int> map{{"b", 1}, {"a", 2}, {"b", 3}};
+    CHECK(map.size() == 2);
+    CHECK(map.at("b") == 1);
+
+    const auto [it, inserted] = map.emplace("a", 4);
+    CHECK(!inserted);
+    CHECK(it->second == 2);
+
+    map.insert({{"c", 5}, {"a", 6}, {"c", 7}});
+    CHECK(getKeys(map) == std::vector<std::string>{"a", "b", "c"});
+    CHECK(map.at("a") == 2);
+    CHECK(map.at("c") == 5);
+
+    CHECK(!map.insert_or_assign("a", 8).second);
+    CHECK(map.at("a") == 8);
+    CHECK(map.insert_or_assign("d", 9).second);
+    CHECK(map.at("d") == 9);
+  }
+
+  SECTION("looks up keys of other types") {
+    const FlatMap<std::string, int> map{{"one", 1}, {"two", 2}};
+    CHECK(map.find(std::string_view("two"))->second == 2);
+    CHECK(map.find("three") == map.end());
+    CHECK(map.count("one") == 1);
+    CHECK(map.contains(std::string("one")));
+    CHECK(!map.contains("on"));
+    CHECK_THROWS_AS(map.at("three"), std::out_of_range);
+  }
+
+  SECTION("removes entries") {
+    FlatMap<std::string, int> map{{"a", 1}, {"b", 2}, {"c", 3}};
+    CHECK(map.erase("b") == 1);
+    CHECK(map.erase("b") == 0);
+    CHECK(map.erase(map.begin())->first == "c");
+    CHECK(getKeys(map) == std::vector<std::string>{"c"});
+    map.clear();
+    CHECK(map.empty());
+  }
+
+  SECTION("iterates in the same order as std::map") {
+    const std::map<std::string, int> expected{
+        {"zeta", 1},
+        {"Alpha", 2},
+        {"alpha", 3},
+        {"", 4},
+        {"beta", 5}};
+    const FlatMap<std::string, int> map(expected.rbegin(), expected.rend());
+    CHECK(std::equal(
+        map.begin(),
+        map.end(),
+        expected.begin(),
+        expected.end(),
+        [](const auto& lhs, const auto& rhs) {
+          return lhs.first == rhs.first && lhs.second == rhs.second;
+        }));
+    CHECK(map == FlatMap<std::string, int>(expected.begin(), expected.end()));
+    CHECK(map != FlatMap<std::string, int>{{"zeta", 1}});
+  }
+}
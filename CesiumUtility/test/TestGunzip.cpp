@@ -0,0 +1,84 @@
+#include "CesiumUtility/Gunzip.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace CesiumUtility;
+
+TEST_CASE("gzip") {
+  std::vector<std::byte> data;
+  for (size_t i = 0; i < 100000; ++i) {
+    data.emplace_back(std::byte(i % 7));
+  }
+
+  SECTION("compressed data can be gunzipped") {
+    std::vector<std::byte> compressed;
+    REQUIRE(gzip(data, compressed));
+    CHECK(isGzip(compressed));
+    CHECK(compressed.size() < data.size());
+
+    std::vector<std::byte> decompressed;
+    REQUIRE(gunzip(compressed, decompressed));
+    CHECK(decompressed == data);
+  }
+
+  SECTION("compressed data can be gunzipped into a ByteVector") {
+    std::vector<std::byte> compressed;
+    REQUIRE(gzip(data, compressed));
+
+    ByteVector decompressed(AllocationCategory::DecompressedResponse);
+    REQUIRE(gunzip(compressed, decompressed));
+    CHECK(std::equal(
+        decompressed.begin(),
+        decompressed.end(),
+        data.begin(),
+        data.end()));
+    CHECK(
+        decompressed.get_allocator().getCategory() ==
+        AllocationCategory::DecompressedResponse);
+  }
+
+  SECTION("empty data can be compressed") {
+    std::vector<std::byte> compressed;
+    REQUIRE(gzip(std::vector<std::byte>(), compressed));
+
+    std::vector<std::byte> decompressed;
+    REQUIRE(gunzip(compressed, decompressed));
+    CHECK(decompressed.empty());
+  }
+
+  SECTION("raw deflate data can be inflated") {
+    // Without its 10-byte header and 8-byte trailer, gzip data is raw
+    // deflate data.
+    std::vector<std::byte> compressed;
+    REQUIRE(gzip(data, compressed));
+    gsl::span<const std::byte> deflated =
+        gsl::span<const std::byte>(compressed).subspan(
+            10,
+            compressed.size() - 18);
+
+    std::vector<std::byte> decompressed;
+    REQUIRE(inflateRaw(deflated, decompressed));
+    CHECK(decompressed == data);
+
+    CHECK(!inflateRaw(deflated.first(deflated.size() / 2), decompressed));
+
+    // The inflated size is only a hint.
+    for (size_t inflatedSize : {size_t(1), data.size(), data.size() * 2}) {
+      REQUIRE(inflateRaw(deflated, decompressed, inflatedSize));
+      CHECK(decompressed == data);
+    }
+  }
+
+  SECTION("truncated data can't be gunzipped") {
+    std::vector<std::byte> compressed;
+    REQUIRE(gzip(data, compressed));
+    compressed.resize(compressed.size() - 4);
+
+    std::vector<std::byte> decompressed;
+    CHECK(!gunzip(compressed, decompressed));
+  }
+}
@@ -29,3 +29,42 @@ TEST_CASE("IntrusivePointer") {
   CHECK(pBase->_references == 1);
   CHECK(pBase != pDerived);
 }
+
+TEST_CASE("IntrusivePointer move assignment") {
+  IntrusivePointer<Derived> pFirst = new Derived();
+  IntrusivePointer<Derived> pSecond = new Derived();
+  Derived* pFirstObject = pFirst.get();
+  Derived* pSecondObject = pSecond.get();
+
+  SECTION("takes over the reference and releases the old one") {
+    pFirst = std::move(pSecond);
+    CHECK(pFirst == pSecondObject);
+    CHECK(pSecond == nullptr);
+    CHECK(pFirstObject->_references == 0);
+    CHECK(pSecondObject->_references == 1);
+  }
+
+  SECTION("converts to a base type") {
+    IntrusivePointer<Base> pBase = new Base();
+    Base* pBaseObject = pBase.get();
+    pBase = std::move(pFirst);
+    CHECK(pBase == pFirstObject);
+    CHECK(pFirst == nullptr);
+    CHECK(pBaseObject->_references == 0);
+    CHECK(pFirstObject->_references == 1);
+    delete pBaseObject;
+  }
+
+  SECTION("swaps without changing the reference counts") {
+    pFirst.swap(pSecond);
+    CHECK(pFirst == pSecondObject);
+    CHECK(pSecond == pFirstObject);
+    CHECK(pFirstObject->_references == 1);
+    CHECK(pSecondObject->_references == 1);
+  }
+
+  pFirst = nullptr;
+  pSecond = nullptr;
+  delete pFirstObject;
+  delete pSecondObject;
+}
@@ -0,0 +1,47 @@
+#include "CesiumUtility/IntrusivePointer.h"
+#include "CesiumUtility/ReferenceCounted.h"
+
+#include <catch2/catch.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace CesiumUtility;
+
+namespace {
+class Counted : public ReferenceCountedThreadSafe<Counted> {
+public:
+  explicit Counted(int& destroyed) : _destroyed(destroyed) {}
+  ~Counted() { ++this->_destroyed; }
+
+private:
+  int& _destroyed;
+};
+} // namespace
+
+TEST_CASE("ReferenceCountedThreadSafe") {
+  int destroyed = 0;
+  IntrusivePointer<Counted> pCounted = new Counted(destroyed);
+
+  // Add and remove references from several threads at once.
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([pCounted]() {
+      for (int j = 0; j < 10000; ++j) {
+        IntrusivePointer<Counted> pCopy = pCounted;
+        IntrusivePointer<Counted> pMoved = std::move(pCopy);
+      }
+    });
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  CHECK(pCounted->getReferenceCount() == 1);
+  CHECK(destroyed == 0);
+
+  pCounted = nullptr;
+  CHECK(destroyed == 1);
+}
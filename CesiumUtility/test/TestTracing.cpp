@@ -0,0 +1,72 @@
+#include "CesiumUtility/Tracing.h"
+
+#include <catch2/catch.hpp>
+
+#if CESIUM_TRACING_ENABLED
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+std::string readTrace(const std::string& path) {
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+size_t countOccurrences(const std::string& text, const std::string& value) {
+  size_t count = 0;
+  for (size_t i = text.find(value); i != std::string::npos;
+       i = text.find(value, i + value.size())) {
+    ++count;
+  }
+  return count;
+}
+} // namespace
+
+TEST_CASE("Tracing records events in ring buffers") {
+  const std::string path = "cesium-test-trace.json";
+  CESIUM_TRACE_INIT(path);
+
+  SECTION("writes the events when flushed") {
+    { CESIUM_TRACE("first \"event\""); }
+    CESIUM_TRACE_FLUSH();
+    CHECK(
+        countOccurrences(readTrace(path), "\"first \\\"event\\\"\"") == 1);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([]() { CESIUM_TRACE("thread event"); });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    CESIUM_TRACE_SHUTDOWN();
+    const std::string trace = readTrace(path);
+    CHECK(countOccurrences(trace, "\"first \\\"event\\\"\"") == 1);
+    CHECK(countOccurrences(trace, "\"thread event\"") == 4);
+    CHECK(trace.substr(trace.size() - 2) == "]}");
+  }
+
+  SECTION("doesn't record events while disabled") {
+    CESIUM_TRACE_SET_ENABLED(false);
+    { CESIUM_TRACE("disabled event"); }
+    CESIUM_TRACE_SET_ENABLED(true);
+    { CESIUM_TRACE("enabled event"); }
+
+    CESIUM_TRACE_SHUTDOWN();
+    const std::string trace = readTrace(path);
+    CHECK(countOccurrences(trace, "\"disabled event\"") == 0);
+    CHECK(countOccurrences(trace, "\"enabled event\"") == 1);
+  }
+
+  std::remove(path.c_str());
+}
+
+#endif // CESIUM_TRACING_ENABLED
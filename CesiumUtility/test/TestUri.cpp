@@ -2,6 +2,9 @@
 
 #include <catch2/catch.hpp>
 
+#include <string>
+#include <vector>
+
 using namespace CesiumUtility;
 
 TEST_CASE("Uri::getPath") {
@@ -158,3 +161,84 @@ TEST_CASE("Uri::uriPathToWindowsPath") {
       Uri::uriPathToWindowsPath("/notadriveletter:/file") ==
       "\\notadriveletter:\\file");
 }
+
+TEST_CASE("BaseUri::resolve") {
+  const std::vector<std::string> bases{
+      "https://example.com/tiles/tileset.json",
+      "https://example.com/tiles/tileset.json?key=value",
+      "https://example.com/tiles/",
+      "https://example.com",
+      "https://example.com/a/../tiles/./tileset.json",
+      "//example.com/tiles/tileset.json",
+      "file:///C:/tiles/tileset.json",
+      "tiles/tileset.json"};
+  const std::vector<std::string> relatives{
+      "content/0/0/0.glb",
+      "content/0/0/0.glb?foo=bar",
+      "../content.glb",
+      "./content.glb",
+      "/content.glb",
+      "?foo=bar",
+      "content%20with%20spaces.glb",
+      "content.glb#fragment",
+      "https://other.com/content.glb",
+      ""};
+
+  for (const std::string& base : bases) {
+    const BaseUri baseUri(base);
+    CHECK(baseUri.getUri() == base);
+    for (const std::string& relative : relatives) {
+      CAPTURE(base, relative);
+      CHECK(baseUri.resolve(relative) == Uri::resolve(base, relative));
+      CHECK(
+          baseUri.resolve(relative, true) ==
+          Uri::resolve(base, relative, true));
+    }
+  }
+
+  SECTION("reuses the result buffer") {
+    const BaseUri baseUri("https://example.com/tiles/tileset.json");
+    std::string result = "something that is replaced";
+    baseUri.resolve("0/0/0.glb", result);
+    CHECK(result == "https://example.com/tiles/0/0/0.glb");
+  }
+}
+
+TEST_CASE("UriTemplate::substitute") {
+  const auto callback = [](const std::string& placeholder) {
+    return placeholder == "x" ? std::string("1") : "<" + placeholder + ">";
+  };
+
+  for (const std::string& templateUri :
+       {"",
+        "no/placeholders",
+        "{x}",
+        "tiles/{level}/{x}/{y}.png",
+        "{x}{x}/{}/{y}?q={x}",
+        "outer{x{y}}"}) {
+    CAPTURE(templateUri);
+    const UriTemplate compiled(templateUri);
+    CHECK(compiled.getTemplate() == templateUri);
+    CHECK(
+        compiled.substitute(callback) ==
+        Uri::substituteTemplateParameters(templateUri, callback));
+  }
+
+  SECTION("appends to the result buffer") {
+    const UriTemplate compiled("a/{x}/b");
+    std::string result = "something that is replaced";
+    compiled.substitute(
+        [](const std::string& placeholder, std::string& uri) {
+          uri += placeholder;
+          uri += placeholder;
+        },
+        result);
+    CHECK(result == "a/xx/b");
+  }
+
+  SECTION("throws for an unclosed placeholder only when substituting") {
+    const UriTemplate compiled("a/{x");
+    CHECK_THROWS(compiled.substitute(callback));
+    CHECK_THROWS(Uri::substituteTemplateParameters("a/{x", callback));
+  }
+}